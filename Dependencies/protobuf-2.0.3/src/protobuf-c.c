@@ -1327,6 +1327,17 @@ setup_default_values (ProtobufCMessage *message)
       }
 }
 
+size_t
+protobuf_c_message_init           (const ProtobufCMessageDescriptor *desc,
+                                   ProtobufCMessage       *to_init)
+{
+  ASSERT_IS_MESSAGE_DESCRIPTOR (desc);
+  memset (to_init, 0, desc->sizeof_message);
+  to_init->descriptor = desc;
+  setup_default_values (to_init);
+  return desc->sizeof_message;
+}
+
 ProtobufCMessage *
 protobuf_c_message_unpack         (const ProtobufCMessageDescriptor *desc,
                                    ProtobufCAllocator  *allocator,
@@ -39,6 +39,16 @@
 #import "PLCrashReporter.h"
 #import "PLCrashReport.h"
 #import "PLCrashReportTextFormatter.h"
+#import "PLCrashReportJSONFormatter.h"
+#import "PLCrashReportHeader.h"
+#import "PLCrashReportSymbolicator.h"
+#import "PLCrashReportBundle.h"
+#import "PLCrashReportStatistics.h"
+#import "PLCrashPendingReportInfo.h"
+#import "PLCrashMonitor.h"
+#import "PLCrashResourceEvent.h"
+#import "PLCrashLiveReportSession.h"
+#import "PLCrashSymbolicationServer.h"
 
 /**
  * @defgroup functions Crash Reporter Functions Reference
@@ -103,6 +113,16 @@ typedef enum {
 #import "PLCrashReporter.h"
 #import "PLCrashReport.h"
 #import "PLCrashReportTextFormatter.h"
+#import "PLCrashReportJSONFormatter.h"
+#import "PLCrashReportHeader.h"
+#import "PLCrashReportSymbolicator.h"
+#import "PLCrashReportBundle.h"
+#import "PLCrashReportStatistics.h"
+#import "PLCrashPendingReportInfo.h"
+#import "PLCrashMonitor.h"
+#import "PLCrashResourceEvent.h"
+#import "PLCrashLiveReportSession.h"
+#import "PLCrashSymbolicationServer.h"
 
 /**
  * @mainpage Plausible Crash Reporter
@@ -26,6 +26,8 @@
 #include <inttypes.h>
 
 #include <mach-o/dyld.h>
+#include <mach/mach_time.h>
+#include <pthread.h>
 
 #include "PLCrashFrameWalker.h"
 
@@ -35,6 +37,8 @@
 
 #include "PLCrashFeatureConfig.h"
 
+#include "unwind_test_harness.h"
+
 extern void *unwind_tester_list_x86_64_disable_compact_frame[];
 extern void *unwind_tester_list_x86_64_frame[];
 extern void *unwind_tester_list_x86_64_frameless[];
@@ -269,3 +273,198 @@ void uwind_to_main () {
     }
 }
 
+
+
+/*
+ * Synthetic unwind benchmark.
+ *
+ * Each benchmark case recurses through one of the synthetic stack generators in unwind_bench_*.S, which reproduce
+ * the frame layouts of the regression tests above, and then times the unwinding of the synthetic frames with a
+ * single frame reader.
+ */
+
+#ifdef __x86_64__
+extern void unwind_bench_x86_64_frame (uint64_t depth, void (*callback)(void *), void *context);
+extern void unwind_bench_x86_64_frameless (uint64_t depth, void (*callback)(void *), void *context);
+extern void unwind_bench_x86_64_frameless_big (uint64_t depth, void (*callback)(void *), void *context);
+
+extern const uint64_t unwind_bench_x86_64_frame_length;
+extern const uint64_t unwind_bench_x86_64_frameless_length;
+extern const uint64_t unwind_bench_x86_64_frameless_big_length;
+#endif
+
+/** The stack size of the benchmark thread. The largest synthetic frames are roughly 4KB. */
+#define UNWIND_BENCH_STACK_SIZE (64 * 1024 * 1024)
+
+struct unwind_bench_case {
+    /** The frame layout and frame reader being measured. */
+    const char *name;
+
+    /** The synthetic stack generator. */
+    void (*generator)(uint64_t depth, void (*callback)(void *), void *context);
+
+    /** The length of @a generator, in bytes. */
+    const uint64_t *generator_length;
+
+    /** The frame reader to be measured. */
+    plframe_cursor_frame_reader_t **frame_readers;
+};
+
+static struct unwind_bench_case unwind_bench_cases[] = {
+#ifdef __x86_64__
+    { "frame, frame pointer",                   unwind_bench_x86_64_frame,          &unwind_bench_x86_64_frame_length,          frame_readers_frame },
+    { "frame, compact unwind",                  unwind_bench_x86_64_frame,          &unwind_bench_x86_64_frame_length,          frame_readers_compact },
+    { "frame, DWARF",                           unwind_bench_x86_64_frame,          &unwind_bench_x86_64_frame_length,          frame_readers_dwarf },
+    { "frameless, compact unwind",              unwind_bench_x86_64_frameless,      &unwind_bench_x86_64_frameless_length,      frame_readers_compact },
+    { "frameless, DWARF",                       unwind_bench_x86_64_frameless,      &unwind_bench_x86_64_frameless_length,      frame_readers_dwarf },
+    { "frameless (large frames), compact unwind", unwind_bench_x86_64_frameless_big, &unwind_bench_x86_64_frameless_big_length, frame_readers_compact },
+    { "frameless (large frames), DWARF",        unwind_bench_x86_64_frameless_big,  &unwind_bench_x86_64_frameless_big_length,  frame_readers_dwarf },
+#endif
+    { NULL, NULL, NULL, NULL }
+};
+
+/** Benchmark state, shared with the benchmark thread. */
+struct unwind_bench_state {
+    /** The case being measured. */
+    struct unwind_bench_case *bench_case;
+
+    /** The image list used to initialize each cursor. */
+    plcrash_async_image_list_t *image_list;
+
+    /** The number of synthetic frames to generate. */
+    size_t depth;
+
+    /** The number of times the synthetic stack is unwound. */
+    unsigned int iterations;
+
+    /** The results, and the number populated. */
+    unwind_bench_result_t *results;
+    size_t max_results;
+    size_t result_count;
+};
+
+/* Return true if the cursor's current frame is a synthetic frame of @a bench_case. */
+static bool unwind_bench_is_synthetic (plframe_cursor_t *cursor, struct unwind_bench_case *bench_case) {
+    plcrash_greg_t ip;
+    if (plframe_cursor_get_reg(cursor, PLCRASH_REG_IP, &ip) != PLFRAME_ESUCCESS)
+        return false;
+
+    uint64_t start = (uint64_t) (uintptr_t) bench_case->generator;
+    return ip > start && ip <= start + *bench_case->generator_length;
+}
+
+/*
+ * Called with the state of the innermost synthetic frame's callback. The non-synthetic frames are unwound with the
+ * default readers, and the synthetic frames with the benchmarked reader alone.
+ */
+static plcrash_error_t unwind_bench_measure (plcrash_async_thread_state_t *state, void *context) {
+    struct unwind_bench_state *bench = context;
+    struct unwind_bench_case *bench_case = bench->bench_case;
+    size_t reader_count = 0;
+    size_t frames = 0;
+    uint64_t elapsed = 0;
+
+    for (reader_count = 0; bench_case->frame_readers[reader_count] != NULL; reader_count++);
+
+    for (unsigned int iter = 0; iter < bench->iterations && reader_count > 0; iter++) {
+        plframe_cursor_t cursor;
+        size_t count = 0;
+
+        plframe_cursor_init(&cursor, mach_task_self(), state, bench->image_list);
+
+        /* Unwind to the innermost synthetic frame */
+        while (!unwind_bench_is_synthetic(&cursor, bench_case) && plframe_cursor_next(&cursor) == PLFRAME_ESUCCESS);
+
+        /* Time the synthetic frames */
+        if (unwind_bench_is_synthetic(&cursor, bench_case)) {
+            uint64_t start = mach_absolute_time();
+            while (plframe_cursor_next_with_readers(&cursor, bench_case->frame_readers, reader_count) == PLFRAME_ESUCCESS && unwind_bench_is_synthetic(&cursor, bench_case))
+                count++;
+            elapsed += mach_absolute_time() - start;
+        }
+
+        plframe_cursor_free(&cursor);
+
+        /* The reader must unwind the complete synthetic stack */
+        if (count < bench->depth) {
+            frames = 0;
+            break;
+        }
+        frames = count;
+    }
+
+    if (bench->result_count < bench->max_results) {
+        unwind_bench_result_t *result = &bench->results[bench->result_count++];
+        mach_timebase_info_data_t timebase;
+
+        result->name = bench_case->name;
+        result->frames = frames;
+        result->ns_per_frame = 0;
+
+        if (frames > 0 && mach_timebase_info(&timebase) == KERN_SUCCESS && timebase.denom != 0)
+            result->ns_per_frame = ((double) elapsed * timebase.numer / timebase.denom) / ((double) frames * bench->iterations);
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/* Invoked by the synthetic stack generators once the requested depth has been reached. */
+static void unwind_bench_callback (void *context) {
+    plcrash_async_thread_state_current(unwind_bench_measure, context);
+}
+
+/* Benchmark thread entry point. */
+static void *unwind_bench_thread (void *context) {
+    struct unwind_bench_state *bench = context;
+
+    for (struct unwind_bench_case *bc = unwind_bench_cases; bc->name != NULL; bc++) {
+        bench->bench_case = bc;
+        bc->generator(bench->depth, unwind_bench_callback, bench);
+    }
+
+    return NULL;
+}
+
+/**
+ * Generate synthetic stacks of @a depth frames from each of the regression test frame layouts, and time the
+ * unwinding of the synthetic frames with each applicable frame reader (frame pointer, compact unwind, and DWARF).
+ * The stacks are generated on a dedicated thread, and are identical across runs, allowing unwinder changes to be
+ * compared by their ns/frame results.
+ *
+ * @param depth The number of synthetic frames to generate for each case.
+ * @param iterations The number of times each synthetic stack is unwound.
+ * @param results On return, the benchmark results.
+ * @param max_results The maximum number of results to be returned.
+ *
+ * @return Returns the number of results populated. A result with a frame count of 0 indicates that the reader could not
+ * unwind the complete synthetic stack (for example, if the linker did not retain the DWARF unwind info).
+ */
+size_t unwind_bench_harness (size_t depth, unsigned int iterations, unwind_bench_result_t *results, size_t max_results) {
+    plcrash_async_image_list_t image_list;
+    struct unwind_bench_state bench = {
+        .image_list = &image_list,
+        .depth = depth,
+        .iterations = iterations,
+        .results = results,
+        .max_results = max_results,
+        .result_count = 0
+    };
+    pthread_attr_t attr;
+    pthread_t thread;
+
+    /* Initialize the image list */
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* Run the cases on a thread with sufficient stack for the synthetic frames */
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, UNWIND_BENCH_STACK_SIZE);
+    if (pthread_create(&thread, &attr, unwind_bench_thread, &bench) == 0)
+        pthread_join(thread, NULL);
+    pthread_attr_destroy(&attr);
+
+    plcrash_nasync_image_list_free(&image_list);
+
+    return bench.result_count;
+}
@@ -22,11 +22,29 @@
 #ifndef PLCRASH_UNWIND_TEST_HARNESS_H
 #define PLCRASH_UNWIND_TEST_HARNESS_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 bool unwind_test_harness (void);
+
+/**
+ * A single unwind benchmark result.
+ */
+typedef struct unwind_bench_result {
+    /** The frame layout and frame reader that were measured. */
+    const char *name;
+
+    /** The number of synthetic frames unwound per iteration, or 0 if the reader could not unwind the synthetic stack. */
+    size_t frames;
+
+    /** The mean time required to unwind a single synthetic frame, in nanoseconds. */
+    double ns_per_frame;
+} unwind_bench_result_t;
+
+size_t unwind_bench_harness (size_t depth, unsigned int iterations, unwind_bench_result_t *results, size_t max_results);
     
 #ifdef __cplusplus
 }
@@ -27,11 +27,15 @@
  */
 
 #import "PLCrashAsync.h"
+#import "PLCrashAsyncCompressor.h"
+#import "PLCrashAsyncMetrics.h"
 
 #import <stdint.h>
 #import <errno.h>
 #import <string.h>
 #import <inttypes.h>
+#import <sys/mman.h>
+#import <fcntl.h>
 
 /**
  * @internal
@@ -157,6 +161,9 @@ const char *plcrash_async_strerror (plcrash_error_t error) {
  * @deprecated New code should make use of plcrash_async_task_memcpy().
  */
 kern_return_t plcrash_async_read_addr (mach_port_t task, pl_vm_address_t source, void *dest, pl_vm_size_t len) {
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_VM_READ_COUNT, 1);
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_VM_READ_BYTES, len);
+
 #ifdef PL_HAVE_MACH_VM
     pl_vm_size_t read_size = len;
     return mach_vm_read_overwrite(task, source, len, (pointer_t) dest, &read_size);
@@ -226,6 +233,9 @@ plcrash_error_t plcrash_async_task_memcpy (mach_port_t task, pl_vm_address_t add
     if (!plcrash_async_address_apply_offset(address, offset, &target))
         return PLCRASH_ENOMEM;
 
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_VM_READ_COUNT, 1);
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_VM_READ_BYTES, len);
+
 #ifdef PL_HAVE_MACH_VM
     pl_vm_size_t read_size = len;
     kt = mach_vm_read_overwrite(task, target, len, (pointer_t) dest, &read_size);
@@ -253,6 +263,352 @@ plcrash_error_t plcrash_async_task_memcpy (mach_port_t task, pl_vm_address_t add
     }
 }
 
+/**
+ * Look up the readability of @a address in @a task via vm_region(), returning the containing range of uniform
+ * readability.
+ *
+ * If @a address is mapped, @a range is set to the containing VM region. If @a address is unmapped, @a range is set
+ * to the unreadable range extending from @a address to the next mapped region, or to the end of the address space.
+ *
+ * @param task The task to query.
+ * @param address The address to look up.
+ * @param[out] range On success, the range containing @a address.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINTERNAL if the lookup fails.
+ */
+plcrash_error_t plcrash_async_task_region_lookup (mach_port_t task, pl_vm_address_t address, plcrash_async_region_map_range_t *range) {
+    vm_region_basic_info_data_64_t info;
+    mach_msg_type_number_t count = VM_REGION_BASIC_INFO_COUNT_64;
+    mach_port_t object_name;
+    kern_return_t kt;
+
+#ifdef PL_HAVE_MACH_VM
+    mach_vm_address_t region_addr = address;
+    mach_vm_size_t region_size;
+    kt = mach_vm_region(task, &region_addr, &region_size, VM_REGION_BASIC_INFO_64, (vm_region_info_t) &info, &count, &object_name);
+#else
+    vm_address_t region_addr = address;
+    vm_size_t region_size;
+    kt = vm_region_64(task, &region_addr, &region_size, VM_REGION_BASIC_INFO_64, (vm_region_info_t) &info, &count, &object_name);
+#endif
+
+    /* No region exists at or above the address */
+    if (kt == KERN_INVALID_ADDRESS) {
+        range->start = address;
+        range->end = PL_VM_ADDRESS_MAX;
+        range->readable = false;
+        return PLCRASH_ESUCCESS;
+    } else if (kt != KERN_SUCCESS) {
+        return PLCRASH_EINTERNAL;
+    }
+
+    /* The returned region will be the next mapped region if the address itself is unmapped */
+    if (region_addr > address) {
+        range->start = address;
+        range->end = (pl_vm_address_t) region_addr;
+        range->readable = false;
+        return PLCRASH_ESUCCESS;
+    }
+
+    range->start = (pl_vm_address_t) region_addr;
+    range->end = (pl_vm_address_t) (region_addr + region_size);
+    range->readable = (info.protection & VM_PROT_READ) != 0;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Initialize an empty region map for @a task.
+ *
+ * @param map The map to initialize.
+ * @param task The task described by the map.
+ */
+void plcrash_async_region_map_init (plcrash_async_region_map_t *map, mach_port_t task) {
+    map->task = task;
+    map->count = 0;
+    map->finalized = true;
+}
+
+/**
+ * Record a range of known readability in @a map. The map must be finalized via plcrash_async_region_map_finalize()
+ * before it is used.
+ *
+ * @param map The map to which the range will be added.
+ * @param start The first address of the range.
+ * @param end The address immediately following the range.
+ * @param readable True if the range is readable, false if it is unmapped or unreadable.
+ *
+ * @return Returns true if the range was recorded, or false if the range is empty or the map is full.
+ */
+bool plcrash_async_region_map_add (plcrash_async_region_map_t *map, pl_vm_address_t start, pl_vm_address_t end, bool readable) {
+    if (start >= end || map->count >= PLCRASH_ASYNC_REGION_MAP_MAX)
+        return false;
+
+    plcrash_async_region_map_range_t *range = &map->ranges[map->count++];
+    range->start = start;
+    range->end = end;
+    range->readable = readable;
+    map->finalized = false;
+
+    return true;
+}
+
+/**
+ * Look up the readability of @a address via vm_region(), and record the containing range in @a map.
+ *
+ * @param map The map to which the range will be added.
+ * @param address The address to look up within the map's task.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOMEM if the map is full, or PLCRASH_EINTERNAL if the
+ * lookup fails.
+ */
+plcrash_error_t plcrash_async_region_map_add_region (plcrash_async_region_map_t *map, pl_vm_address_t address) {
+    plcrash_async_region_map_range_t range;
+    plcrash_error_t err;
+
+    if ((err = plcrash_async_task_region_lookup(map->task, address, &range)) != PLCRASH_ESUCCESS)
+        return err;
+
+    if (!plcrash_async_region_map_add(map, range.start, range.end, range.readable))
+        return PLCRASH_ENOMEM;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Sort the ranges of @a map, and resolve any overlap between them. Overlapping ranges of the same readability are
+ * merged; where a readable and an unreadable range overlap, the overlapping portion is treated as readable, such
+ * that an address is never incorrectly reported as unreadable.
+ *
+ * @param map The map to finalize.
+ */
+void plcrash_async_region_map_finalize (plcrash_async_region_map_t *map) {
+    plcrash_async_region_map_range_t *ranges = map->ranges;
+    uint32_t count = map->count;
+
+    if (map->finalized)
+        return;
+
+    /* Shell sort by start address; this requires no allocation or recursion */
+    for (uint32_t gap = count / 2; gap > 0; gap /= 2) {
+        for (uint32_t i = gap; i < count; i++) {
+            plcrash_async_region_map_range_t tmp = ranges[i];
+            uint32_t j = i;
+            for (; j >= gap && ranges[j - gap].start > tmp.start; j -= gap)
+                ranges[j] = ranges[j - gap];
+            ranges[j] = tmp;
+        }
+    }
+
+    /* Resolve overlapping ranges */
+    uint32_t result = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        plcrash_async_region_map_range_t cur = ranges[i];
+
+        while (result > 0 && cur.start < ranges[result - 1].end && cur.start < cur.end) {
+            plcrash_async_region_map_range_t *prev = &ranges[result - 1];
+
+            if (prev->readable == cur.readable) {
+                /* Merge */
+                if (cur.end > prev->end)
+                    prev->end = cur.end;
+                cur.end = cur.start;
+            } else if (prev->readable) {
+                /* Trim the unreadable range to follow the readable range */
+                cur.start = prev->end;
+            } else {
+                /* Trim the unreadable range to precede the readable range; any remainder beyond the readable range
+                 * is discarded */
+                prev->end = cur.start;
+                if (prev->end <= prev->start)
+                    result--;
+                break;
+            }
+        }
+
+        if (cur.start < cur.end)
+            ranges[result++] = cur;
+    }
+
+    map->count = result;
+    map->finalized = true;
+}
+
+/**
+ * Return the range of @a map containing @a address, or NULL if the address' readability is unknown.
+ *
+ * @param map A finalized region map.
+ * @param address The address to look up.
+ */
+const plcrash_async_region_map_range_t *plcrash_async_region_map_lookup (const plcrash_async_region_map_t *map, pl_vm_address_t address) {
+    if (!map->finalized)
+        return NULL;
+
+    /* Find the last range starting at or before the address */
+    uint32_t lo = 0;
+    uint32_t hi = map->count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (map->ranges[mid].start <= address) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0 || address >= map->ranges[lo - 1].end)
+        return NULL;
+
+    return &map->ranges[lo - 1];
+}
+
+/**
+ * Initialize an empty task read cache.
+ *
+ * @param cache The cache to be initialized.
+ */
+void plcrash_async_task_read_cache_init (plcrash_async_task_read_cache_t *cache) {
+    cache->task = MACH_PORT_NULL;
+    cache->valid = false;
+    cache->address = 0;
+    cache->region_map = NULL;
+    cache->unreadable_task = MACH_PORT_NULL;
+    cache->unreadable_count = 0;
+    cache->unreadable_next = 0;
+}
+
+/**
+ * Set the region map to be consulted by @a cache. Reads from the map's task that begin within a range the map
+ * describes as unreadable will fail without issuing a kernel call.
+ *
+ * @param cache The read cache to configure.
+ * @param map A finalized region map, or NULL. This is a borrowed reference, and must remain valid for the lifetime
+ * of @a cache.
+ */
+void plcrash_async_task_read_cache_set_region_map (plcrash_async_task_read_cache_t *cache, const plcrash_async_region_map_t *map) {
+    cache->region_map = map;
+}
+
+/**
+ * @internal
+ *
+ * Return the range of known readability containing @a address in @a task, consulting the ranges learned by
+ * @a cache before its region map, or NULL if the address' readability is unknown.
+ */
+static const plcrash_async_region_map_range_t *plcrash_async_task_read_cache_range (plcrash_async_task_read_cache_t *cache, mach_port_t task, pl_vm_address_t address) {
+    if (cache->unreadable_task == task) {
+        for (uint32_t i = 0; i < cache->unreadable_count; i++) {
+            if (address >= cache->unreadable[i].start && address < cache->unreadable[i].end)
+                return &cache->unreadable[i];
+        }
+    }
+
+    if (cache->region_map != NULL && cache->region_map->task == task)
+        return plcrash_async_region_map_lookup(cache->region_map, address);
+
+    return NULL;
+}
+
+/**
+ * @internal
+ *
+ * Record the unreadable range containing @a address, following a failed read of @a address from @a task. Subsequent
+ * reads within the range will fail without issuing a kernel call.
+ */
+static void plcrash_async_task_read_cache_learn (plcrash_async_task_read_cache_t *cache, mach_port_t task, pl_vm_address_t address) {
+    /* Reads of known-readable ranges may fail at their boundaries; there is nothing to learn */
+    if (plcrash_async_task_read_cache_range(cache, task, address) != NULL)
+        return;
+
+    plcrash_async_region_map_range_t range;
+    if (plcrash_async_task_region_lookup(task, address, &range) != PLCRASH_ESUCCESS || range.readable)
+        return;
+
+    if (cache->unreadable_task != task) {
+        cache->unreadable_task = task;
+        cache->unreadable_count = 0;
+        cache->unreadable_next = 0;
+    }
+
+    cache->unreadable[cache->unreadable_next] = range;
+    cache->unreadable_next = (cache->unreadable_next + 1) % PLCRASH_ASYNC_TASK_READ_CACHE_UNREADABLE_MAX;
+    if (cache->unreadable_count < PLCRASH_ASYNC_TASK_READ_CACHE_UNREADABLE_MAX)
+        cache->unreadable_count++;
+}
+
+/**
+ * @internal
+ *
+ * Perform an uncached read of @a len bytes from @a task at @a target, learning the unreadable range containing
+ * @a target on failure.
+ */
+static plcrash_error_t plcrash_async_task_read_cache_read_direct (plcrash_async_task_read_cache_t *cache, mach_port_t task, pl_vm_address_t target, void *dest, pl_vm_size_t len) {
+    plcrash_error_t err = plcrash_async_task_memcpy(task, target, 0, dest, len);
+    if (err == PLCRASH_ENOTFOUND || err == PLCRASH_EACCESS)
+        plcrash_async_task_read_cache_learn(cache, task, target);
+
+    return err;
+}
+
+/**
+ * Copy @a len bytes from @a task, at @a address + @a offset, storing in @a dest, using @a cache to satisfy
+ * the read where possible.
+ *
+ * Reads that fall entirely within a single cache block are served from @a cache, fetching the containing block
+ * from @a task if it is not already cached. Reads that span a block boundary, or that can not be satisfied by
+ * fetching the full containing block (eg, the block crosses into an unmapped page), fall back to an uncached
+ * plcrash_async_task_memcpy(), and will return identical results.
+ *
+ * Reads beginning within a range known to be unreadable, either via the cache's region map or from a previous
+ * failed read, fail with PLCRASH_ENOTFOUND without issuing a kernel call.
+ *
+ * @param cache The read cache to be used. If NULL, the read will be performed directly via plcrash_async_task_memcpy().
+ * @param task The task from which data from address @a source will be read.
+ * @param address The base address within @a task from which the data will be read.
+ * @param offset The offset from @a address at which data will be read.
+ * @param dest The destination address to which copied data will be written.
+ * @param len The number of bytes to be read.
+ *
+ * @return Returns the same values as plcrash_async_task_memcpy().
+ */
+plcrash_error_t plcrash_async_task_memcpy_cached (plcrash_async_task_read_cache_t *cache, mach_port_t task, pl_vm_address_t address, pl_vm_off_t offset, void *dest, pl_vm_size_t len) {
+    const pl_vm_address_t mask = ~((pl_vm_address_t) PLCRASH_ASYNC_TASK_READ_CACHE_SIZE - 1);
+    pl_vm_address_t target;
+    pl_vm_address_t block_addr;
+
+    if (cache == NULL)
+        return plcrash_async_task_memcpy(task, address, offset, dest, len);
+
+    /* Compute the target address and check for overflow */
+    if (!plcrash_async_address_apply_offset(address, offset, &target))
+        return PLCRASH_ENOMEM;
+
+    /* Fail reads of known-unreadable memory in user space */
+    const plcrash_async_region_map_range_t *range = plcrash_async_task_read_cache_range(cache, task, target);
+    if (range != NULL && !range->readable && len > 0)
+        return PLCRASH_ENOTFOUND;
+
+    /* Reads that are empty, or which span a block boundary, are not cached */
+    block_addr = target & mask;
+    if (len == 0 || len > PLCRASH_ASYNC_TASK_READ_CACHE_SIZE || ((target + len - 1) & mask) != block_addr)
+        return plcrash_async_task_read_cache_read_direct(cache, task, target, dest, len);
+
+    /* Fetch the containing block, if necessary */
+    if (!cache->valid || cache->task != task || cache->address != block_addr) {
+        cache->valid = false;
+        if (plcrash_async_task_memcpy(task, block_addr, 0, cache->block, sizeof(cache->block)) != PLCRASH_ESUCCESS) {
+            /* The block may include unreadable pages; let the direct read determine the result */
+            return plcrash_async_task_read_cache_read_direct(cache, task, target, dest, len);
+        }
+
+        cache->task = task;
+        cache->address = block_addr;
+        cache->valid = true;
+    }
+
+    plcrash_async_memcpy(dest, cache->block + (target - block_addr), len);
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * Read an 8-bit value from @a task, at @a address + @a offset, storing in @a dest. If the page(s) at the
  * given @a address + @a offset are unmapped or unreadable, no copy will be performed and an error will
@@ -343,27 +699,70 @@ plcrash_error_t plcrash_async_task_read_uint64 (task_t task, const plcrash_async
 }
 
 /**
- * An intentionally naive async-safe implementation of strcmp(). strcmp() itself is not declared to be async-safe,
+ * @internal
+ * Machine word type used by the word-at-a-time string functions. Declared may_alias, as the words are read from
+ * character data.
+ */
+typedef uintptr_t __attribute__((__may_alias__)) plcrash_async_word_t;
+
+/** @internal A word with each byte set to 0x01. */
+#define PL_WORD_ONES ((uintptr_t) -1 / 0xFF)
+
+/** @internal A word with each byte set to 0x80. */
+#define PL_WORD_HIGHS (PL_WORD_ONES * 0x80)
+
+/** @internal Evaluates to non-zero if any byte of the word @a w is zero. */
+#define PL_WORD_HAS_ZERO(w) (((w) - PL_WORD_ONES) & ~(w) & PL_WORD_HIGHS)
+
+/** @internal Evaluates to true if @a p is word-aligned. */
+#define PL_WORD_ALIGNED(p) (((uintptr_t) (p) & (sizeof(plcrash_async_word_t) - 1)) == 0)
+
+/**
+ * An async-safe implementation of strcmp(). strcmp() itself is not declared to be async-safe,
  * though in reality, it is.
  *
+ * If @a s1 and @a s2 share the same word alignment, the strings are compared a word at a time. Aligned words
+ * never span a page boundary, and so may be safely read beyond the terminating NUL.
+ *
  * @param s1 First string.
  * @param s2 Second string.
  * @return Return an integer greater than, equal to, or less than 0, according as the string @a s1 is greater than,
  * equal to, or less than the string @a s2.
  */
 int plcrash_async_strcmp(const char *s1, const char *s2) {
-    while (*s1 == *s2++) {
-        if (*s1++ == 0)
+    if (((uintptr_t) s1 & (sizeof(plcrash_async_word_t) - 1)) == ((uintptr_t) s2 & (sizeof(plcrash_async_word_t) - 1))) {
+        /* Compare up to the first aligned word */
+        for (; !PL_WORD_ALIGNED(s1); s1++, s2++) {
+            if (*s1 != *s2 || *s1 == 0)
+                return (*(const unsigned char *)s1 - *(const unsigned char *)s2);
+        }
+
+        /* Skip all identical words that do not contain a NUL; the remainder is resolved below */
+        const plcrash_async_word_t *w1 = (const plcrash_async_word_t *) s1;
+        const plcrash_async_word_t *w2 = (const plcrash_async_word_t *) s2;
+        while (*w1 == *w2 && !PL_WORD_HAS_ZERO(*w1)) {
+            w1++;
+            w2++;
+        }
+
+        s1 = (const char *) w1;
+        s2 = (const char *) w2;
+    }
+
+    for (; *s1 == *s2; s1++, s2++) {
+        if (*s1 == 0)
             return (0);
     }
-    
-    return (*(const unsigned char *)s1 - *(const unsigned char *)(s2 - 1));
+
+    return (*(const unsigned char *)s1 - *(const unsigned char *)s2);
 }
 
 /**
- * An intentionally naive async-safe implementation of strncmp(). strncmp() itself is not declared to be async-safe,
+ * An async-safe implementation of strncmp(). strncmp() itself is not declared to be async-safe,
  * though in reality, it is.
  *
+ * As with plcrash_async_strcmp(), strings that share the same word alignment are compared a word at a time.
+ *
  * @param s1 First string.
  * @param s2 Second string.
  * @param n No more than n characters will be compared.
@@ -371,15 +770,71 @@ int plcrash_async_strcmp(const char *s1, const char *s2) {
  * equal to, or less than the string @a s2.
  */
 int plcrash_async_strncmp(const char *s1, const char *s2, size_t n) {
-    while (*s1 == *s2++ && n-- > 0) {
-        if (*s1++ == 0)
+    if (((uintptr_t) s1 & (sizeof(plcrash_async_word_t) - 1)) == ((uintptr_t) s2 & (sizeof(plcrash_async_word_t) - 1))) {
+        /* Compare up to the first aligned word */
+        for (; n > 0 && !PL_WORD_ALIGNED(s1); n--, s1++, s2++) {
+            if (*s1 != *s2 || *s1 == 0)
+                return (*(const unsigned char *)s1 - *(const unsigned char *)s2);
+        }
+
+        /* Skip all identical whole words that do not contain a NUL */
+        const plcrash_async_word_t *w1 = (const plcrash_async_word_t *) s1;
+        const plcrash_async_word_t *w2 = (const plcrash_async_word_t *) s2;
+        while (n >= sizeof(plcrash_async_word_t) && *w1 == *w2 && !PL_WORD_HAS_ZERO(*w1)) {
+            w1++;
+            w2++;
+            n -= sizeof(plcrash_async_word_t);
+        }
+
+        s1 = (const char *) w1;
+        s2 = (const char *) w2;
+    }
+
+    for (; n > 0; n--, s1++, s2++) {
+        if (*s1 != *s2)
+            return (*(const unsigned char *)s1 - *(const unsigned char *)s2);
+
+        if (*s1 == 0)
             return (0);
     }
-    
-    if (n == 0)
-        return 0;
 
-    return (*(const unsigned char *)s1 - *(const unsigned char *)(s2 - 1));
+    return 0;
+}
+
+/**
+ * An async-safe implementation of strnlen(). strnlen() itself is not declared to be async-safe, though in reality,
+ * it is.
+ *
+ * The string is scanned a word at a time. No byte at or beyond @a s + @a maxlen is read, allowing this function to be
+ * used to find the length of a string within a bounded mapping, such as a plcrash_async_mobject_t.
+ *
+ * @param s The string to be measured.
+ * @param maxlen The maximum number of bytes to be examined.
+ * @return Returns the number of bytes preceding the terminating NUL, or @a maxlen if no NUL was found within the first
+ * @a maxlen bytes.
+ */
+size_t plcrash_async_strnlen (const char *s, size_t maxlen) {
+    const char *p = s;
+    const char *end = s + maxlen;
+
+    /* Scan up to the first aligned word */
+    for (; p < end && !PL_WORD_ALIGNED(p); p++) {
+        if (*p == 0)
+            return p - s;
+    }
+
+    /* Scan all whole words that fall within the bounds */
+    const plcrash_async_word_t *w = (const plcrash_async_word_t *) p;
+    while ((size_t) (end - (const char *) w) >= sizeof(plcrash_async_word_t) && !PL_WORD_HAS_ZERO(*w))
+        w++;
+
+    /* Locate the NUL within the final word, or scan the trailing bytes */
+    for (p = (const char *) w; p < end; p++) {
+        if (*p == 0)
+            return p - s;
+    }
+
+    return maxlen;
 }
 
 /**
@@ -417,6 +872,34 @@ void *plcrash_async_memset(void *dest, uint8_t value, size_t n) {
     return (void *) dest;
 }
 
+/**
+ * Fault in the pages backing the @a len bytes at @a addr, and optionally wire them into memory, such that a later
+ * access from the crash handler will not page fault. Each page is read, and its contents are left unmodified.
+ *
+ * @param addr The start of the range.
+ * @param len The length of the range, in bytes.
+ * @param wire If true, the pages are additionally wired via mlock().
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the pages could not be wired. The pages will have
+ * been faulted in regardless.
+ */
+plcrash_error_t plcrash_nasync_prefault (const void *addr, size_t len, bool wire) {
+    const volatile uint8_t *p = (const volatile uint8_t *) addr;
+    const volatile uint8_t *end = p + len;
+
+    while (p < end) {
+        (void) *p;
+        p = (const volatile uint8_t *) (trunc_page((vm_address_t) p) + PAGE_SIZE);
+    }
+
+    if (wire && len > 0 && mlock(addr, len) != 0) {
+        PLCF_DEBUG("Could not wire %zu bytes at %p: %d", len, addr, errno);
+        return PLCRASH_ENOMEM;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * @internal
  * @ingroup plcrash_async
@@ -455,9 +938,116 @@ ssize_t plcrash_async_writen (int fd, const void *data, size_t len) {
     return written;
 }
 
+/**
+ * Write all bytes described by the @a iovcnt entries of @a iov to @a fd, looping until all
+ * bytes are written or an error occurs. This allows multiple discontiguous buffers to be
+ * written with a single system call in the common case.
+ *
+ * @param fd Open file descriptor.
+ * @param iov The buffers to be written. The contents of this array will be modified to track
+ * partial writes, and its contents are undefined on return.
+ * @param iovcnt The number of entries in @a iov.
+ *
+ * @return Returns the number of bytes written by the final write, or -1 on error.
+ */
+ssize_t plcrash_async_writevn (int fd, struct iovec *iov, int iovcnt) {
+    ssize_t written = 0;
+
+    /* Skip any leading empty entries */
+    while (iovcnt > 0 && iov->iov_len == 0) {
+        iov++;
+        iovcnt--;
+    }
+
+    /* Loop until all bytes are written */
+    while (iovcnt > 0) {
+        if ((written = writev(fd, iov, iovcnt)) <= 0) {
+            if (errno == EINTR) {
+                // Try again
+                written = 0;
+            } else {
+                return -1;
+            }
+        }
+
+        /* Advance past the written bytes */
+        size_t left = written;
+        while (iovcnt > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+
+        if (iovcnt > 0) {
+            iov->iov_base = (uint8_t *) iov->iov_base + left;
+            iov->iov_len -= left;
+        }
+    }
+
+    return written;
+}
+
+
+/**
+ * Initialize @a checksum for a new stream.
+ */
+void plcrash_async_checksum_init (plcrash_async_checksum_t *checksum) {
+    checksum->sum = 0;
+    checksum->weighted = 0;
+    checksum->length = 0;
+}
+
+/**
+ * Append @a len bytes from @a data to the stream checksummed by @a checksum.
+ */
+void plcrash_async_checksum_update (plcrash_async_checksum_t *checksum, const void *data, size_t len) {
+    const uint8_t *p = data;
+    uint32_t sum = checksum->sum;
+    uint32_t weighted = checksum->weighted;
+    uint32_t position = (uint32_t) checksum->length;
+
+    for (size_t i = 0; i < len; i++) {
+        position++;
+        sum += p[i];
+        weighted += position * p[i];
+    }
+
+    checksum->sum = sum;
+    checksum->weighted = weighted;
+    checksum->length += len;
+}
 
 /**
- * Initialize the plcrash_async_file_t instance.
+ * Update @a checksum to reflect the replacement of @a len previously checksummed bytes at @a position.
+ *
+ * @param checksum The checksum to update.
+ * @param position The zero-based stream position of the first replaced byte.
+ * @param old_data The bytes being replaced.
+ * @param new_data The replacement bytes.
+ * @param len The number of bytes replaced.
+ */
+void plcrash_async_checksum_patch (plcrash_async_checksum_t *checksum, uint64_t position, const void *old_data, const void *new_data, size_t len) {
+    const uint8_t *old_p = old_data;
+    const uint8_t *new_p = new_data;
+
+    for (size_t i = 0; i < len; i++) {
+        uint32_t delta = (uint32_t) new_p[i] - (uint32_t) old_p[i];
+        checksum->sum += delta;
+        checksum->weighted += (uint32_t) (position + i + 1) * delta;
+    }
+}
+
+/**
+ * Return the 64-bit checksum value, with the weighted sum in the upper 32 bits and the byte sum in the lower 32 bits.
+ */
+uint64_t plcrash_async_checksum_value (const plcrash_async_checksum_t *checksum) {
+    return ((uint64_t) checksum->weighted << 32) | checksum->sum;
+}
+
+
+/**
+ * Initialize the plcrash_async_file_t instance, using the default inline output buffer of
+ * PLCRASH_ASYNC_FILE_DEFAULT_BUFFER_SIZE bytes.
  *
  * @param file File structure to initialize.
  * @param output_limit Maximum number of bytes that will be written to disk. Intended as a
@@ -466,18 +1056,133 @@ ssize_t plcrash_async_writen (int fd, const void *data, size_t len) {
  * @param fd Open file descriptor.
  */
 void plcrash_async_file_init (plcrash_async_file_t *file, int fd, off_t output_limit) {
+    plcrash_async_file_init_buffer(file, fd, output_limit, NULL, 0);
+}
+
+/**
+ * Initialize the plcrash_async_file_t instance, using @a buffer for output buffering.
+ *
+ * A larger buffer reduces the number of write() calls (and thus, kernel transitions) required
+ * while writing a report from within a crashed process. As allocation is not async-safe,
+ * the buffer should be allocated prior to its use in a signal handler.
+ *
+ * @param file File structure to initialize.
+ * @param fd Open file descriptor.
+ * @param output_limit Maximum number of bytes that will be written to disk, or 0 to disable
+ * any limits. See plcrash_async_file_init().
+ * @param buffer The output buffer to be used. The buffer must remain valid until the file has
+ * been closed. If NULL, the default inline buffer will be used.
+ * @param buffer_size The size of @a buffer, in bytes. If 0, the default inline buffer will be used.
+ */
+void plcrash_async_file_init_buffer (plcrash_async_file_t *file, int fd, off_t output_limit, void *buffer, size_t buffer_size) {
     file->fd = fd;
     file->buflen = 0;
     file->total_bytes = 0;
     file->limit_bytes = output_limit;
+    file->compressor = NULL;
+    file->sink = NULL;
+    file->sink_ctx = NULL;
+    file->position = 0;
+    plcrash_async_checksum_init(&file->checksum);
+
+    /* Positioned writes require a seekable descriptor, and are not honored for descriptors opened with O_APPEND. The
+     * replaced bytes are read back to update the checksum, and so the descriptor must also be readable. */
+    int flags = fd >= 0 ? fcntl(fd, F_GETFL) : -1;
+    file->seekable = flags != -1 && (flags & O_ACCMODE) == O_RDWR && !(flags & O_APPEND) && lseek(fd, 0, SEEK_CUR) != -1;
+
+    if (buffer != NULL && buffer_size > 0) {
+        file->buffer = buffer;
+        file->buffer_size = buffer_size;
+    } else {
+        file->buffer = file->default_buffer;
+        file->buffer_size = sizeof(file->default_buffer);
+    }
 }
 
 
 /**
- * Write all bytes from @a data to the file buffer. Returns true on success,
+ * Initialize the plcrash_async_file_t instance, passing all output to @a sink rather than to a file
+ * descriptor. This may be used to generate a report in memory; the async-safety of the resulting file
+ * is determined by that of @a sink.
+ *
+ * @param file File structure to initialize.
+ * @param sink The function to which all output will be passed.
+ * @param ctx Context value to be passed to @a sink.
+ * @param output_limit Maximum number of bytes that will be output. Specify 0 to disable any limits.
+ * @param buffer Output buffer to be used, or NULL to use the default inline buffer.
+ * @param buffer_size The size of @a buffer, in bytes.
+ */
+void plcrash_async_file_init_sink (plcrash_async_file_t *file, plcrash_async_file_sink_t sink, void *ctx, off_t output_limit, void *buffer, size_t buffer_size) {
+    plcrash_async_file_init_buffer(file, -1, output_limit, buffer, buffer_size);
+    file->sink = sink;
+    file->sink_ctx = ctx;
+}
+
+
+/* plcrash_async_file_sink_t implementation used by plcrash_async_file_init_memory() */
+static bool plcrash_async_file_memory_sink (const void *data, size_t len, void *ctx) {
+    plcrash_async_file_memory_t *memory = ctx;
+
+    if (len > memory->capacity - memory->length)
+        return false;
+
+    plcrash_async_memcpy(memory->data + memory->length, data, len);
+    memory->length += len;
+    return true;
+}
+
+/**
+ * Initialize the plcrash_async_file_t instance, writing all output to the caller-provided @a data buffer. Unlike
+ * plcrash_async_file_init_sink() with an allocating sink, this output target is async-safe, and a buffer allocated
+ * prior to a crash may be used to generate a report without any file I/O.
+ *
+ * Once the file has been flushed, the written output is available in @a data, and its length in
+ * plcrash_async_file_memory_t::length. Writes that would exceed @a capacity will fail.
+ *
+ * @param file File structure to initialize.
+ * @param memory The memory output state to be initialized. This must remain valid until the file has been closed.
+ * @param data The output storage. This must remain valid until the file has been closed.
+ * @param capacity The size of @a data, in bytes.
+ */
+void plcrash_async_file_init_memory (plcrash_async_file_t *file, plcrash_async_file_memory_t *memory, void *data, size_t capacity) {
+    memory->data = data;
+    memory->capacity = capacity;
+    memory->length = 0;
+
+    plcrash_async_file_init_sink(file, plcrash_async_file_memory_sink, memory, capacity, NULL, 0);
+}
+
+
+/**
+ * Write all @a iovcnt buffers to the file's sink or file descriptor. Returns true on success, or false if
+ * an error occurs.
+ */
+static bool plcrash_async_file_output (plcrash_async_file_t *file, struct iovec *iov, int iovcnt) {
+    uint64_t start = plcrash_async_metrics_time_begin();
+    bool result = true;
+
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_OUTPUT_COUNT, 1);
+
+    if (file->sink != NULL) {
+        for (int i = 0; i < iovcnt && result; i++) {
+            if (iov[i].iov_len > 0 && !file->sink(iov[i].iov_base, iov[i].iov_len, file->sink_ctx))
+                result = false;
+        }
+    } else if (plcrash_async_writevn(file->fd, iov, iovcnt) < 0) {
+        PLCF_DEBUG("Error occured writing to crash log: %s", strerror(errno));
+        result = false;
+    }
+
+    plcrash_async_metrics_time_end(PLCRASH_ASYNC_METRIC_OUTPUT_TIME, start);
+    return result;
+}
+
+
+/**
+ * Write all bytes from @a data to the file buffer, bypassing any compressor. Returns true on success,
  * or false if an error occurs.
  */
-bool plcrash_async_file_write (plcrash_async_file_t *file, const void *data, size_t len) {
+static bool plcrash_async_file_write_raw (plcrash_async_file_t *file, const void *data, size_t len) {
     /* Check and update output limit */
     if (file->limit_bytes != 0 && len + file->total_bytes > file->limit_bytes) {
         return false;
@@ -485,49 +1190,221 @@ bool plcrash_async_file_write (plcrash_async_file_t *file, const void *data, siz
         file->total_bytes += len;
     }
 
-    /* Check if the buffer will fill */
-    if (file->buflen + len > sizeof(file->buffer)) {
-        /* Flush the buffer */
-        if (plcrash_async_writen(file->fd, file->buffer, file->buflen) < 0) {
-            PLCF_DEBUG("Error occured writing to crash log: %s", strerror(errno));
-            return false;
-        }
-        
-        file->buflen = 0;
-    }
-    
+    file->position += len;
+
     /* Check if the new data fits within the buffer, if so, buffer it */
-    if (len + file->buflen <= sizeof(file->buffer)) {
+    if (file->buflen + len <= file->buffer_size) {
         plcrash_async_memcpy(file->buffer + file->buflen, data, len);
         file->buflen += len;
         
         return true;
-        
-    } else {
-        /* Won't fit in the buffer, just write it */
-        if (plcrash_async_writen(file->fd, data, len) < 0) {
-            PLCF_DEBUG("Error occured writing to crash log: %s", strerror(errno));
+    }
+
+    /* Won't fit in the buffer; write the buffered bytes and the new data with a single writev(),
+     * rather than flushing and copying (or separately writing) the new data. */
+    struct iovec iov[2] = {
+        { .iov_base = file->buffer, .iov_len = file->buflen },
+        { .iov_base = (void *) data, .iov_len = len }
+    };
+
+    if (!plcrash_async_file_output(file, iov, 2))
+        return false;
+
+    file->buflen = 0;
+    return true;
+}
+
+
+/**
+ * Compress and write any input pending in @a file's compressor as a single block.
+ */
+static bool plcrash_async_file_write_block (plcrash_async_file_t *file) {
+    size_t len = plcrash_async_compressor_encode_block(file->compressor);
+    if (len == 0)
+        return true;
+
+    return plcrash_async_file_write_raw(file, file->compressor->output, len);
+}
+
+/**
+ * Compress all further data written to @a file using @a compressor, writing the compressed stream header
+ * immediately. The output limit applies to the compressed bytes written.
+ *
+ * As all compression state is held by @a compressor, it should be allocated prior to its use in a signal
+ * handler. The compressor must remain valid until the file has been flushed, and may not be shared between
+ * files that are in use concurrently.
+ *
+ * @param file The file to which @a compressor will be attached. No data may have been written to @a file.
+ * @param compressor The compressor to be used.
+ *
+ * @return Returns true on success, or false if the stream header could not be written.
+ */
+bool plcrash_async_file_set_compressor (plcrash_async_file_t *file, plcrash_async_compressor_t *compressor) {
+    uint8_t header[PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1];
+    size_t len = plcrash_async_compressor_write_header(header);
+
+    if (!plcrash_async_file_write_raw(file, header, len))
+        return false;
+
+    plcrash_async_compressor_reset(compressor);
+    file->compressor = compressor;
+    return true;
+}
+
+/**
+ * Write all bytes from @a data to the file buffer, updating the file's checksum. Returns true on success,
+ * or false if an error occurs.
+ */
+bool plcrash_async_file_write (plcrash_async_file_t *file, const void *data, size_t len) {
+    plcrash_async_checksum_update(&file->checksum, data, len);
+
+    if (file->compressor == NULL)
+        return plcrash_async_file_write_raw(file, data, len);
+
+    const uint8_t *p = data;
+    while (len > 0) {
+        size_t consumed = plcrash_async_compressor_buffer(file->compressor, p, len);
+        p += consumed;
+        len -= consumed;
+
+        /* Block is full; emit it */
+        if (len > 0 && !plcrash_async_file_write_block(file))
+            return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Overwrite @a count bytes of output at @a position with pwrite(), given that @a output bytes have been written to
+ * the file's descriptor. Returns true on success, or false if an error occurs.
+ */
+static bool plcrash_async_file_pwrite_output (plcrash_async_file_t *file, const uint8_t *data, size_t count, off_t position, off_t output) {
+    /* The descriptor's offset follows the last output byte; derive the absolute offset of the patch from it */
+    off_t current = lseek(file->fd, 0, SEEK_CUR);
+    if (current == -1 || current < output)
+        return false;
+
+    off_t offset = current - (output - position);
+
+    /* Read back the replaced bytes to update the checksum */
+    for (size_t checked = 0; checked < count; ) {
+        uint8_t old_data[64];
+        size_t chunk = count - checked < sizeof(old_data) ? count - checked : sizeof(old_data);
+        ssize_t nread = pread(file->fd, old_data, chunk, offset + (off_t) checked);
+        if (nread < 0 && errno == EINTR)
+            continue;
+
+        if (nread <= 0) {
+            PLCF_DEBUG("Error occured reading crash log: %s", strerror(errno));
             return false;
         }
-        
-        return true;
-    } 
+
+        plcrash_async_checksum_patch(&file->checksum, (uint64_t) (position + (off_t) checked), old_data, data + checked, (size_t) nread);
+        checked += (size_t) nread;
+    }
+
+    while (count > 0) {
+        ssize_t written = pwrite(file->fd, data, count, offset);
+        if (written < 0 && errno == EINTR)
+            continue;
+
+        if (written <= 0) {
+            PLCF_DEBUG("Error occured patching crash log: %s", strerror(errno));
+            return false;
+        }
+
+        data += written;
+        offset += written;
+        count -= (size_t) written;
+    }
+
+    return true;
 }
 
+/**
+ * Return true if bytes previously written to @a file may be overwritten via plcrash_async_file_patch(). This requires
+ * that no compressor be attached, and that the file write either to a readable, seekable file descriptor, or to
+ * memory via plcrash_async_file_init_memory().
+ *
+ * @param file The file to query.
+ */
+bool plcrash_async_file_patchable (plcrash_async_file_t *file) {
+    if (file->compressor != NULL)
+        return false;
+
+    if (file->sink != NULL)
+        return file->sink == plcrash_async_file_memory_sink;
+
+    return file->seekable;
+}
 
 /**
- * Flush all buffered bytes from the file buffer.
+ * Overwrite @a len bytes previously written to @a file at @a position, as returned by plcrash_async_file_t::position
+ * prior to the original write. Bytes that are still buffered are updated in place; bytes that have already been
+ * output are overwritten with pwrite(), or directly within the memory output target. The replaced bytes are
+ * removed from the file's checksum.
+ *
+ * @param file The file to be patched. The file must be patchable, as per plcrash_async_file_patchable().
+ * @param position The position of the first byte to be overwritten.
+ * @param data The replacement data.
+ * @param len The number of bytes to overwrite. The range must have been fully written to @a file.
+ *
+ * @return Returns true on success, or false if the range is invalid, or the data could not be written.
+ */
+bool plcrash_async_file_patch (plcrash_async_file_t *file, off_t position, const void *data, size_t len) {
+    if (!plcrash_async_file_patchable(file) || position < 0 || (off_t) len > file->position - position)
+        return false;
+
+    /* Patch any portion that has already been output */
+    const uint8_t *p = data;
+    off_t output = file->position - (off_t) file->buflen;
+    if (position < output) {
+        size_t count = (off_t) len < output - position ? len : (size_t) (output - position);
+
+        if (file->sink != NULL) {
+            plcrash_async_file_memory_t *memory = file->sink_ctx;
+            plcrash_async_checksum_patch(&file->checksum, (uint64_t) position, memory->data + position, p, count);
+            plcrash_async_memcpy(memory->data + position, p, count);
+        } else if (!plcrash_async_file_pwrite_output(file, p, count, position, output)) {
+            return false;
+        }
+
+        p += count;
+        position += count;
+        len -= count;
+    }
+
+    /* Patch the remainder within the buffer */
+    if (len > 0) {
+        plcrash_async_checksum_patch(&file->checksum, (uint64_t) position, file->buffer + (position - output), p, len);
+        plcrash_async_memcpy(file->buffer + (position - output), p, len);
+    }
+
+    return true;
+}
+
+
+/**
+ * Flush all buffered bytes from the file buffer. If a compressor is attached, any pending input is first
+ * written as a complete compressed block.
  */
 bool plcrash_async_file_flush (plcrash_async_file_t *file) {
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_FLUSH_COUNT, 1);
+
+    /* Emit any pending compressed data as a complete block */
+    if (file->compressor != NULL && !plcrash_async_file_write_block(file))
+        return false;
+
     /* Anything to do? */
     if (file->buflen == 0)
         return true;
     
     /* Write remaining */
-    if (plcrash_async_writen(file->fd, file->buffer, file->buflen) < 0) {
-        PLCF_DEBUG("Error occured writing to crash log: %s", strerror(errno));
+    struct iovec iov = { .iov_base = file->buffer, .iov_len = file->buflen };
+    if (!plcrash_async_file_output(file, &iov, 1))
         return false;
-    }
     
     file->buflen = 0;
     
@@ -536,13 +1413,40 @@ bool plcrash_async_file_flush (plcrash_async_file_t *file) {
 
 
 /**
- * Close the backing file descriptor.
+ * Flush all buffered bytes from the file buffer, and then synchronize the file's data with the underlying storage
+ * device via fsync(), ensuring that the output written to this point survives a kernel panic or loss of power, and
+ * not merely the termination of the process. If the file was initialized with plcrash_async_file_init_sink(), this is
+ * equivalent to plcrash_async_file_flush().
+ */
+bool plcrash_async_file_sync (plcrash_async_file_t *file) {
+    if (!plcrash_async_file_flush(file))
+        return false;
+
+    if (file->sink != NULL)
+        return true;
+
+    if (fsync(file->fd) != 0) {
+        PLCF_DEBUG("Error synchronizing crash log: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Close the backing file descriptor. If the file was initialized with plcrash_async_file_init_sink(), pending
+ * data is flushed, and no file descriptor is closed.
  */
 bool plcrash_async_file_close (plcrash_async_file_t *file) {
     /* Flush any pending data */
     if (!plcrash_async_file_flush(file))
         return false;
 
+    /* Nothing to close */
+    if (file->sink != NULL)
+        return true;
+
     /* Close the file descriptor */
     if (close(file->fd) != 0) {
         PLCF_DEBUG("Error closing file: %s", strerror(errno));
@@ -38,6 +38,7 @@ extern "C" {
 #include <stdbool.h>
 #include <stddef.h>
 #include <assert.h>
+#include <sys/uio.h>
 
 #include <TargetConditionals.h>
 #include <mach/mach.h>
@@ -236,6 +237,126 @@ extern const plcrash_async_byteorder_t *plcrash_async_byteorder_big_endian (void
 
 plcrash_error_t plcrash_async_task_memcpy (mach_port_t task, pl_vm_address_t address, pl_vm_off_t offset, void *dest, pl_vm_size_t len);
 
+/**
+ * @internal
+ * @ingroup plcrash_async
+ *
+ * Maximum number of ranges that may be recorded in a plcrash_async_region_map_t.
+ */
+#define PLCRASH_ASYNC_REGION_MAP_MAX 1024
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ *
+ * An address range of known readability within a target task.
+ */
+typedef struct plcrash_async_region_map_range {
+    /** The first address of the range. */
+    pl_vm_address_t start;
+
+    /** The address immediately following the range. */
+    pl_vm_address_t end;
+
+    /** True if the range is readable, false if it is unmapped or unreadable. */
+    bool readable;
+} plcrash_async_region_map_range_t;
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ *
+ * A map of address ranges of known readability within a target task. The map is populated prior to reading
+ * (eg, with the task's image segments and with ranges derived from vm_region() lookups), and is then consulted by
+ * plcrash_async_task_memcpy_cached() to fail reads of known-unreadable memory without issuing a kernel call.
+ * Addresses that are not described by the map are read normally.
+ *
+ * Once populated and finalized via plcrash_async_region_map_finalize(), the map is read-only, and may be shared
+ * between concurrently executing readers.
+ */
+typedef struct plcrash_async_region_map {
+    /** The task described by the map. */
+    mach_port_t task;
+
+    /** The number of valid entries in @a ranges. */
+    uint32_t count;
+
+    /** If true, @a ranges are sorted by start address and do not overlap. */
+    bool finalized;
+
+    /** The recorded ranges. */
+    plcrash_async_region_map_range_t ranges[PLCRASH_ASYNC_REGION_MAP_MAX];
+} plcrash_async_region_map_t;
+
+void plcrash_async_region_map_init (plcrash_async_region_map_t *map, mach_port_t task);
+bool plcrash_async_region_map_add (plcrash_async_region_map_t *map, pl_vm_address_t start, pl_vm_address_t end, bool readable);
+plcrash_error_t plcrash_async_region_map_add_region (plcrash_async_region_map_t *map, pl_vm_address_t address);
+void plcrash_async_region_map_finalize (plcrash_async_region_map_t *map);
+const plcrash_async_region_map_range_t *plcrash_async_region_map_lookup (const plcrash_async_region_map_t *map, pl_vm_address_t address);
+
+plcrash_error_t plcrash_async_task_region_lookup (mach_port_t task, pl_vm_address_t address, plcrash_async_region_map_range_t *range);
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ *
+ * Number of unreadable ranges learned by a plcrash_async_task_read_cache_t from failed reads.
+ */
+#define PLCRASH_ASYNC_TASK_READ_CACHE_UNREADABLE_MAX 4
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ *
+ * Size of the block cached by a plcrash_async_task_read_cache_t, in bytes. This must be a power of two, and
+ * no larger than the smallest supported VM page size.
+ */
+#define PLCRASH_ASYNC_TASK_READ_CACHE_SIZE 2048
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ *
+ * A single-block read cache used to coalesce small, spatially local reads from a target task (such as
+ * those performed by the stack unwinders) into a single block-aligned vm_read_overwrite() call.
+ *
+ * The cache performs no locking, and must not be shared between concurrently executing readers. Cached
+ * data is not invalidated if the target task's memory changes; callers must only use the cache while the
+ * target's threads are suspended.
+ */
+typedef struct plcrash_async_task_read_cache {
+    /** The task from which the cached block was read. */
+    mach_port_t task;
+
+    /** True if @a block contains valid data. */
+    bool valid;
+
+    /** The block-aligned target address of @a block. */
+    pl_vm_address_t address;
+
+    /** The cached data. */
+    uint8_t block[PLCRASH_ASYNC_TASK_READ_CACHE_SIZE];
+
+    /** A shared map of known readable and unreadable ranges, or NULL. This is a borrowed reference. */
+    const plcrash_async_region_map_t *region_map;
+
+    /** The task from which the @a unreadable ranges were learned. */
+    mach_port_t unreadable_task;
+
+    /** Unreadable ranges learned from failed reads, replaced in round-robin order. */
+    plcrash_async_region_map_range_t unreadable[PLCRASH_ASYNC_TASK_READ_CACHE_UNREADABLE_MAX];
+
+    /** The number of valid entries in @a unreadable. */
+    uint32_t unreadable_count;
+
+    /** The index of the next @a unreadable entry to be replaced. */
+    uint32_t unreadable_next;
+} plcrash_async_task_read_cache_t;
+
+void plcrash_async_task_read_cache_init (plcrash_async_task_read_cache_t *cache);
+void plcrash_async_task_read_cache_set_region_map (plcrash_async_task_read_cache_t *cache, const plcrash_async_region_map_t *map);
+plcrash_error_t plcrash_async_task_memcpy_cached (plcrash_async_task_read_cache_t *cache, mach_port_t task, pl_vm_address_t address, pl_vm_off_t offset, void *dest, pl_vm_size_t len);
+
 plcrash_error_t plcrash_async_task_read_uint8 (task_t task, pl_vm_address_t address, pl_vm_off_t offset, uint8_t *result);
 
 plcrash_error_t plcrash_async_task_read_uint16 (task_t task, const plcrash_async_byteorder_t *byteorder,
@@ -249,10 +370,78 @@ plcrash_error_t plcrash_async_task_read_uint64 (task_t task, const plcrash_async
 
 int plcrash_async_strcmp(const char *s1, const char *s2);
 int plcrash_async_strncmp(const char *s1, const char *s2, size_t n);
+size_t plcrash_async_strnlen (const char *s, size_t maxlen);
 void *plcrash_async_memcpy(void *dest, const void *source, size_t n);
 void *plcrash_async_memset(void *dest, uint8_t value, size_t n);
+plcrash_error_t plcrash_nasync_prefault (const void *addr, size_t len, bool wire);
 
 ssize_t plcrash_async_writen (int fd, const void *data, size_t len);
+ssize_t plcrash_async_writevn (int fd, struct iovec *iov, int iovcnt);
+
+/**
+ * @internal
+ * @ingroup plcrash_async_bufio
+ *
+ * Incremental checksum over a byte stream. The checksum pairs the sum of all bytes with the sum of each byte
+ * weighted by its one-based position, both modulo 2^32; as each byte's contribution depends only on its own value
+ * and position, previously checksummed bytes may be replaced via plcrash_async_checksum_patch() without
+ * re-reading the stream.
+ */
+typedef struct plcrash_async_checksum {
+    /** The sum of all bytes. */
+    uint32_t sum;
+
+    /** The sum of each byte multiplied by its one-based position. */
+    uint32_t weighted;
+
+    /** The total number of bytes checksummed. */
+    uint64_t length;
+} plcrash_async_checksum_t;
+
+void plcrash_async_checksum_init (plcrash_async_checksum_t *checksum);
+void plcrash_async_checksum_update (plcrash_async_checksum_t *checksum, const void *data, size_t len);
+void plcrash_async_checksum_patch (plcrash_async_checksum_t *checksum, uint64_t position, const void *old_data, const void *new_data, size_t len);
+uint64_t plcrash_async_checksum_value (const plcrash_async_checksum_t *checksum);
+
+/**
+ * @internal
+ * @ingroup plcrash_async_bufio
+ *
+ * Size of the inline output buffer used by plcrash_async_file_t instances that were not
+ * supplied an external buffer via plcrash_async_file_init_buffer().
+ */
+#define PLCRASH_ASYNC_FILE_DEFAULT_BUFFER_SIZE 256
+
+/**
+ * @internal
+ * @ingroup plcrash_async_bufio
+ *
+ * Output function used in place of a file descriptor by plcrash_async_file_init_sink().
+ *
+ * @param data The data to be written.
+ * @param len The number of bytes to be written.
+ * @param ctx The context supplied to plcrash_async_file_init_sink().
+ *
+ * @return Returns true if all bytes were written, or false on error.
+ */
+typedef bool (*plcrash_async_file_sink_t)(const void *data, size_t len, void *ctx);
+
+/**
+ * @internal
+ * @ingroup plcrash_async_bufio
+ *
+ * A fixed-capacity, caller-provided memory output target. See plcrash_async_file_init_memory().
+ */
+typedef struct plcrash_async_file_memory {
+    /** The output storage. */
+    uint8_t *data;
+
+    /** The total size of @a data, in bytes. */
+    size_t capacity;
+
+    /** The number of bytes written to @a data. */
+    size_t length;
+} plcrash_async_file_memory_t;
 
 /**
  * @internal
@@ -274,14 +463,47 @@ typedef struct plcrash_async_file {
     /** Current length of data in buffer */
     size_t buflen;
 
-    /** Buffered output */
-    char buffer[256];
+    /** Buffered output. Points to either @a default_buffer, or a caller-supplied buffer. */
+    char *buffer;
+
+    /** Total size of @a buffer, in bytes. */
+    size_t buffer_size;
+
+    /** Inline output buffer, used when no external buffer is supplied. */
+    char default_buffer[PLCRASH_ASYNC_FILE_DEFAULT_BUFFER_SIZE];
+
+    /** If non-NULL, all written data is compressed via this compressor prior to output. */
+    struct plcrash_async_compressor *compressor;
+
+    /** If non-NULL, output is passed to this function rather than written to @a fd. */
+    plcrash_async_file_sink_t sink;
+
+    /** Context value supplied to @a sink. */
+    void *sink_ctx;
+
+    /** Total bytes accepted for output (including any buffered bytes), prior to compression. Unlike @a total_bytes,
+     * this is maintained whether or not an output limit is set. */
+    off_t position;
+
+    /** If true, the file descriptor supports positioned reads and writes, as required by plcrash_async_file_patch(). */
+    bool seekable;
+
+    /** Checksum of all data passed to plcrash_async_file_write(), prior to compression, including any data that
+     * was dropped due to the output limit or an error. Patched bytes are reflected in the checksum. */
+    plcrash_async_checksum_t checksum;
 } plcrash_async_file_t;
 
 
 void plcrash_async_file_init (plcrash_async_file_t *file, int fd, off_t output_limit);
+void plcrash_async_file_init_buffer (plcrash_async_file_t *file, int fd, off_t output_limit, void *buffer, size_t buffer_size);
+void plcrash_async_file_init_memory (plcrash_async_file_t *file, plcrash_async_file_memory_t *memory, void *data, size_t capacity);
+void plcrash_async_file_init_sink (plcrash_async_file_t *file, plcrash_async_file_sink_t sink, void *ctx, off_t output_limit, void *buffer, size_t buffer_size);
+bool plcrash_async_file_set_compressor (plcrash_async_file_t *file, struct plcrash_async_compressor *compressor);
 bool plcrash_async_file_write (plcrash_async_file_t *file, const void *data, size_t len);
+bool plcrash_async_file_patchable (plcrash_async_file_t *file);
+bool plcrash_async_file_patch (plcrash_async_file_t *file, off_t position, const void *data, size_t len);
 bool plcrash_async_file_flush (plcrash_async_file_t *file);
+bool plcrash_async_file_sync (plcrash_async_file_t *file);
 bool plcrash_async_file_close (plcrash_async_file_t *file);
     
 #ifdef __cplusplus
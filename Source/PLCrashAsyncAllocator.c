@@ -28,8 +28,10 @@
 
 #include "PLCrashAsyncAllocator.h"
 #include "PLCrashAsync.h"
+#include "PLCrashAsyncMetrics.h"
 
 #include <libkern/OSAtomic.h>
+#include <stddef.h>
 
 /* These assume 16-byte malloc() alignment, which is true for just about everything */
 #if defined(__arm__) || defined(__i386__) || defined(__x86_64__)
@@ -42,6 +44,21 @@
 #define PL_ROUNDDOWN_ALIGN(x)   ((x) & (~(PL_NATURAL_ALIGNMENT - 1)))
 #define PL_ROUNDUP_ALIGN(x)     PL_ROUNDDOWN_ALIGN((x) + (PL_NATURAL_ALIGNMENT - 1))
 
+/** The number of size classes for which free lists are maintained. Class N holds blocks of PL_NATURAL_ALIGNMENT << N bytes. */
+#define PL_SIZE_CLASS_COUNT 8
+
+/** The largest allocation size that will be served from (and returned to) a size-class free list. */
+#define PL_SIZE_CLASS_MAX (PL_NATURAL_ALIGNMENT << (PL_SIZE_CLASS_COUNT - 1))
+
+/**
+ * @internal
+ * A free block within a size-class free list.
+ */
+struct plcrash_async_allocator_free_block {
+    /** The next free block. Managed by OSAtomicEnqueue()/OSAtomicDequeue(). */
+    struct plcrash_async_allocator_free_block *next;
+};
+
 /**
  * @internal
  * An async-safe page-guarded and locking memory pool allocator. The allocator
@@ -66,8 +83,38 @@ struct plcrash_async_allocator {
 
     /** PLCrashAsyncAllocatorOptions used when creating the allocator. */
     uint32_t options;
+
+    /** Size-class free lists of plcrash_async_allocator_free_block entries. */
+    OSQueueHead free_lists[PL_SIZE_CLASS_COUNT];
+
+    /** The highest next_addr value reached. */
+    vm_address_t high_addr;
+
+    /** Total number of successful allocations. */
+    volatile int32_t alloc_count;
+
+    /** Number of allocations satisfied from a free list. */
+    volatile int32_t reuse_count;
+
+    /** Number of failed allocations. */
+    volatile int32_t failed_count;
 };
 
+/**
+ * Return the size class index for an allocation of @a size bytes, or -1 if @a size is too large to be
+ * served from a size-class free list.
+ */
+static int plcrash_async_allocator_size_class (size_t size) {
+    if (size > PL_SIZE_CLASS_MAX)
+        return -1;
+
+    int sclass = 0;
+    while ((size_t) (PL_NATURAL_ALIGNMENT << sclass) < size)
+        sclass++;
+
+    return sclass;
+}
+
 /**
  * Create and return a new allocator instance. The allocator will be allocated within the same mapping, ensuring
  * that the allocator metadata is itself guarded.
@@ -88,7 +135,13 @@ plcrash_error_t plcrash_async_allocator_new (plcrash_async_allocator_t **allocat
     alloc.total_size = round_page(size + sizeof(plcrash_async_allocator_t));
     alloc.usable_size = alloc.total_size;
     alloc.options = options;
-    fprintf(stderr, "allocated: %lu\n", (unsigned long) alloc.usable_size);
+    alloc.alloc_count = 0;
+    alloc.reuse_count = 0;
+    alloc.failed_count = 0;
+    for (size_t i = 0; i < PL_SIZE_CLASS_COUNT; i++) {
+        OSQueueHead head = OS_ATOMIC_QUEUE_INIT;
+        alloc.free_lists[i] = head;
+    }
 
     /* Adjust total size to account for guard pages */
     if (options & PLCrashAsyncGuardLowPage)
@@ -137,6 +190,7 @@ plcrash_error_t plcrash_async_allocator_new (plcrash_async_allocator_t **allocat
 
     /* Create a fake allocation for the allocator structure */
     alloc.next_addr = PL_ROUNDUP_ALIGN(alloc.next_addr + sizeof(alloc));
+    alloc.high_addr = alloc.next_addr;
     *((plcrash_async_allocator_t *) alloc.usable_page) = alloc;
     
 
@@ -149,6 +203,9 @@ plcrash_error_t plcrash_async_allocator_new (plcrash_async_allocator_t **allocat
  * Allocate @a size bytes from @a allocator. If insufficient space is available, an assertion will be thrown
  * unless @a no_assert is true, in which case NULL will be returned.
  *
+ * Allocations of up to PL_SIZE_CLASS_MAX bytes are rounded up to their size class, and will be satisfied
+ * from that class' free list if a block previously released via plcrash_async_allocator_dealloc() is available.
+ *
  * @param allocator The allocator from which pages should be allocated
  * @param size The amount of memory to allocate, in bytes.
  * @param no_assert If true, NULL will be returned if insufficient space is available.
@@ -159,10 +216,26 @@ void *plcrash_async_allocator_alloc (plcrash_async_allocator_t *allocator, size_
 
     PLCF_ASSERT((sizeof(allocator->next_addr)) == sizeof(void *));
 
+    /* Try the size class free list */
+    int sclass = plcrash_async_allocator_size_class(size);
+    if (sclass >= 0) {
+        void *block = OSAtomicDequeue(&allocator->free_lists[sclass], offsetof(struct plcrash_async_allocator_free_block, next));
+        if (block != NULL) {
+            OSAtomicIncrement32(&allocator->alloc_count);
+            OSAtomicIncrement32(&allocator->reuse_count);
+            plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_ALLOC_COUNT, 1);
+            plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_ALLOC_BYTES, PL_NATURAL_ALIGNMENT << sclass);
+            return block;
+        }
+
+        size = PL_NATURAL_ALIGNMENT << sclass;
+    }
+
     /* Atomically bump the next_addr value */
     do {
         /* Verify available space */
         if (allocator->usable_size - (allocator->next_addr - allocator->usable_page) < size) {
+            OSAtomicIncrement32(&allocator->failed_count);
             if (no_assert)
                 return NULL;
             __builtin_trap();
@@ -172,5 +245,251 @@ void *plcrash_async_allocator_alloc (plcrash_async_allocator_t *allocator, size_
         new_value = PL_ROUNDUP_ALIGN(allocator->next_addr + size);
     } while(!OSAtomicCompareAndSwapPtrBarrier((void *) old_value, (void *) new_value, (void **) &allocator->next_addr));
 
+    /* Update the high water mark */
+    vm_address_t high;
+    do {
+        high = allocator->high_addr;
+        if (new_value <= high)
+            break;
+    } while (!OSAtomicCompareAndSwapPtrBarrier((void *) high, (void *) new_value, (void **) &allocator->high_addr));
+
+    OSAtomicIncrement32(&allocator->alloc_count);
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_ALLOC_COUNT, 1);
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_ALLOC_BYTES, new_value - old_value);
     return (void *) old_value;
 }
+
+/**
+ * Return an allocation of @a size bytes to @a allocator, making it available for reuse by later allocations
+ * of the same size class. Allocations larger than PL_SIZE_CLASS_MAX are not reused, and will only be reclaimed
+ * by plcrash_async_allocator_release_to_mark() or plcrash_async_allocator_free().
+ *
+ * @param allocator The allocator from which @a ptr was allocated.
+ * @param ptr A pointer previously returned by plcrash_async_allocator_alloc(), or NULL.
+ * @param size The size originally passed to plcrash_async_allocator_alloc() when allocating @a ptr.
+ */
+void plcrash_async_allocator_dealloc (plcrash_async_allocator_t *allocator, void *ptr, size_t size) {
+    if (ptr == NULL)
+        return;
+
+    int sclass = plcrash_async_allocator_size_class(size);
+    if (sclass < 0)
+        return;
+
+    PLCF_ASSERT((vm_address_t) ptr >= allocator->usable_page && (vm_address_t) ptr < allocator->usable_page + allocator->usable_size);
+    OSAtomicEnqueue(&allocator->free_lists[sclass], ptr, offsetof(struct plcrash_async_allocator_free_block, next));
+}
+
+/**
+ * Fault in, and optionally wire, the allocator's usable pages. See plcrash_nasync_prefault().
+ *
+ * @param allocator The allocator to prepare.
+ * @param wire If true, the pages are additionally wired via mlock().
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the pages could not be wired.
+ */
+plcrash_error_t plcrash_async_allocator_prefault (plcrash_async_allocator_t *allocator, bool wire) {
+    return plcrash_nasync_prefault((const void *) allocator->usable_page, allocator->usable_size, wire);
+}
+
+/**
+ * Fetch the current usage statistics for @a allocator.
+ *
+ * @param allocator The allocator to query.
+ * @param[out] stats On return, the allocator's statistics.
+ */
+void plcrash_async_allocator_stats (plcrash_async_allocator_t *allocator, plcrash_async_allocator_stats_t *stats) {
+    OSMemoryBarrier();
+
+    /* The allocator's own metadata is not reported as used space */
+    stats->high_water_mark = allocator->high_addr - PL_ROUNDUP_ALIGN(allocator->usable_page + sizeof(*allocator));
+    stats->alloc_count = allocator->alloc_count;
+    stats->reuse_count = allocator->reuse_count;
+    stats->failed_count = allocator->failed_count;
+}
+
+/**
+ * Return the current allocation position of @a allocator. The returned mark may later be passed to
+ * plcrash_async_allocator_release_to_mark() to release all allocations made after the mark was taken.
+ *
+ * @param allocator The allocator to be marked.
+ */
+plcrash_async_allocator_mark_t plcrash_async_allocator_mark (plcrash_async_allocator_t *allocator) {
+    OSMemoryBarrier();
+    return allocator->next_addr;
+}
+
+/**
+ * Release all allocations made from @a allocator after @a mark was taken, in O(1) time. All pointers returned
+ * by plcrash_async_allocator_alloc() after @a mark was taken are invalidated.
+ *
+ * Marks must be released in LIFO order, and the caller must ensure that no other thread allocates from
+ * or deallocates to @a allocator between the mark and its release; any such allocations would also be released.
+ *
+ * @param allocator The allocator to be reset.
+ * @param mark A mark previously returned by plcrash_async_allocator_mark() for @a allocator.
+ */
+void plcrash_async_allocator_release_to_mark (plcrash_async_allocator_t *allocator, plcrash_async_allocator_mark_t mark) {
+    vm_address_t old_value;
+
+    do {
+        old_value = allocator->next_addr;
+
+        /* The mark must fall between the allocator's own metadata and the current allocation position */
+        PLCF_ASSERT(mark >= PL_ROUNDUP_ALIGN(allocator->usable_page + sizeof(*allocator)));
+        PLCF_ASSERT(mark <= old_value);
+    } while (!OSAtomicCompareAndSwapPtrBarrier((void *) old_value, (void *) mark, (void **) &allocator->next_addr));
+
+    /* Free blocks may reside above the mark; discard the free lists. Any free blocks below the mark
+     * are not reused until the allocator is freed. */
+    for (size_t i = 0; i < PL_SIZE_CLASS_COUNT; i++) {
+        OSQueueHead head = OS_ATOMIC_QUEUE_INIT;
+        allocator->free_lists[i] = head;
+    }
+    OSMemoryBarrier();
+}
+
+/**
+ * Free the allocator, as well as any memory allocated from it. All pointers returned by
+ * plcrash_async_allocator_alloc() are invalidated.
+ *
+ * @param allocator The allocator to be freed.
+ */
+void plcrash_async_allocator_free (plcrash_async_allocator_t *allocator) {
+    /* The allocator is self-referential; copy the metadata before the mapping is released */
+    vm_address_t base_page = allocator->base_page;
+    vm_size_t total_size = allocator->total_size;
+
+    kern_return_t kt = vm_deallocate(mach_task_self(), base_page, total_size);
+    if (kt != KERN_SUCCESS)
+        PLCF_DEBUG("vm_deallocate() failure: %d", kt);
+}
+
+
+/**
+ * Carve @a count sub-arenas of @a arena_size bytes each from a single allocation made from @a allocator. Each
+ * sub-arena may then be handed to a separate worker thread, which may allocate from it via
+ * plcrash_async_allocator_arena_alloc() without contending with the other workers.
+ *
+ * The sub-arenas are released via plcrash_async_allocator_arenas_release(), which releases @a allocator back to its
+ * position prior to this call. As with plcrash_async_allocator_release_to_mark(), no other allocations may be made from
+ * @a allocator while the set is live if the set is to be released or resized.
+ *
+ * @param allocator The allocator from which the sub-arenas will be carved.
+ * @param set The set to be initialized.
+ * @param count The number of sub-arenas. Must be between 1 and PLCRASH_ASYNC_ALLOCATOR_ARENA_MAX.
+ * @param arena_size The usable size of each sub-arena. Will be rounded up to PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a count is out of range, or PLCRASH_ENOMEM if
+ * @a allocator has insufficient space. On failure, @a allocator is left unmodified.
+ */
+plcrash_error_t plcrash_async_allocator_arenas_new (plcrash_async_allocator_t *allocator, plcrash_async_allocator_arena_set_t *set, uint32_t count, size_t arena_size) {
+    if (count == 0 || count > PLCRASH_ASYNC_ALLOCATOR_ARENA_MAX)
+        return PLCRASH_EINVAL;
+
+    /* Round each sub-arena up to a whole number of cache lines */
+    size_t aligned_size = (arena_size + (PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN - 1)) & ~((size_t) PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN - 1);
+    if (aligned_size < arena_size || aligned_size > (SIZE_MAX - PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN) / count)
+        return PLCRASH_ENOMEM;
+
+    /* Allocate the sub-arenas as a single block, with slack to align the first sub-arena */
+    plcrash_async_allocator_mark_t mark = plcrash_async_allocator_mark(allocator);
+    vm_address_t block = (vm_address_t) plcrash_async_allocator_alloc(allocator, (aligned_size * count) + PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN, true);
+    if (block == 0)
+        return PLCRASH_ENOMEM;
+
+    vm_address_t base = (block + (PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN - 1)) & ~((vm_address_t) PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN - 1);
+
+    set->allocator = allocator;
+    set->mark = mark;
+    set->count = count;
+    set->arena_size = aligned_size;
+    for (uint32_t i = 0; i < count; i++) {
+        plcrash_async_allocator_arena_t *arena = &set->arenas[i];
+        arena->base = base + (aligned_size * i);
+        arena->next = arena->base;
+        arena->end = arena->base + aligned_size;
+        arena->failed_count = 0;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Return the sub-arena at @a index within @a set.
+ *
+ * @param set The sub-arena set.
+ * @param index The sub-arena index. Must be less than the set's sub-arena count.
+ */
+plcrash_async_allocator_arena_t *plcrash_async_allocator_arenas_get (plcrash_async_allocator_arena_set_t *set, uint32_t index) {
+    PLCF_ASSERT(index < set->count);
+    return &set->arenas[index];
+}
+
+/**
+ * Release all allocations made from each of the sub-arenas in @a set, in O(n) time in the number of sub-arenas.
+ *
+ * The caller must ensure that no worker is allocating from any of the sub-arenas during the reset.
+ *
+ * @param set The sub-arena set to be reset.
+ */
+void plcrash_async_allocator_arenas_reset (plcrash_async_allocator_arena_set_t *set) {
+    for (uint32_t i = 0; i < set->count; i++) {
+        set->arenas[i].next = set->arenas[i].base;
+        set->arenas[i].failed_count = 0;
+    }
+
+    OSMemoryBarrier();
+}
+
+/**
+ * Release the sub-arenas of @a set, and carve @a count new sub-arenas of @a arena_size bytes each from the same
+ * allocator. All pointers returned by the previous sub-arenas are invalidated.
+ *
+ * @param set The sub-arena set to be resized.
+ * @param count The new number of sub-arenas.
+ * @param arena_size The new usable size of each sub-arena.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or one of the errors returned by plcrash_async_allocator_arenas_new().
+ * On failure, the set's previous sub-arenas have been released, and the set must not be used.
+ */
+plcrash_error_t plcrash_async_allocator_arenas_resize (plcrash_async_allocator_arena_set_t *set, uint32_t count, size_t arena_size) {
+    plcrash_async_allocator_t *allocator = set->allocator;
+
+    plcrash_async_allocator_arenas_release(set);
+    return plcrash_async_allocator_arenas_new(allocator, set, count, arena_size);
+}
+
+/**
+ * Release the sub-arenas of @a set back to the allocator from which they were carved. All pointers returned by the
+ * sub-arenas are invalidated.
+ *
+ * @param set The sub-arena set to be released.
+ */
+void plcrash_async_allocator_arenas_release (plcrash_async_allocator_arena_set_t *set) {
+    plcrash_async_allocator_release_to_mark(set->allocator, set->mark);
+    set->count = 0;
+}
+
+/**
+ * Allocate @a size bytes from @a arena. The allocation is a plain pointer bump; @a arena must only be allocated
+ * from by one thread at a time.
+ *
+ * @param arena The sub-arena from which memory should be allocated.
+ * @param size The amount of memory to allocate, in bytes.
+ *
+ * @return Returns a pointer to the allocation, aligned to the allocator's natural alignment, or NULL if
+ * insufficient space remains in @a arena.
+ */
+void *plcrash_async_allocator_arena_alloc (plcrash_async_allocator_arena_t *arena, size_t size) {
+    if ((size_t) (arena->end - arena->next) < size) {
+        arena->failed_count++;
+        return NULL;
+    }
+
+    vm_address_t addr = arena->next;
+    vm_address_t next = PL_ROUNDUP_ALIGN(addr + size);
+    arena->next = (next > arena->end) ? arena->end : next;
+
+    return (void *) addr;
+}
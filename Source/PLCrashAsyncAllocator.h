@@ -67,8 +67,98 @@ typedef enum {
 
 typedef struct plcrash_async_allocator plcrash_async_allocator_t;
 
+/**
+ * An opaque allocator position, as returned by plcrash_async_allocator_mark(). All allocations made after
+ * the mark was taken may be released via plcrash_async_allocator_release_to_mark().
+ */
+typedef vm_address_t plcrash_async_allocator_mark_t;
+
+/**
+ * Allocator usage statistics, as returned by plcrash_async_allocator_stats().
+ */
+typedef struct plcrash_async_allocator_stats {
+    /** The maximum number of bytes of the allocator's pool that have been in use at any one time. */
+    size_t high_water_mark;
+
+    /** The total number of successful allocations, including those satisfied from a size-class free list. */
+    uint32_t alloc_count;
+
+    /** The number of allocations that were satisfied from a size-class free list. */
+    uint32_t reuse_count;
+
+    /** The number of allocations that failed due to insufficient space. */
+    uint32_t failed_count;
+} plcrash_async_allocator_stats_t;
+
+/** The maximum number of sub-arenas that may be carved into a single plcrash_async_allocator_arena_set_t. */
+#define PLCRASH_ASYNC_ALLOCATOR_ARENA_MAX 8
+
+/** The alignment of each sub-arena's base address and size. Sub-arenas never share a cache line. */
+#define PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN 64
+
+/**
+ * A fixed-size sub-arena carved from a plcrash_async_allocator_t by plcrash_async_allocator_arenas_new(). Allocation
+ * within a sub-arena is a non-atomic pointer bump, and a sub-arena must only be allocated from by a single thread
+ * at a time; giving each worker thread its own sub-arena ensures that workers never contend.
+ *
+ * Allocations can not be individually returned to a sub-arena; all allocations are released together by
+ * plcrash_async_allocator_arenas_reset().
+ */
+typedef struct plcrash_async_allocator_arena {
+    /** The first usable address. */
+    vm_address_t base;
+
+    /** The next valid allocation address. */
+    vm_address_t next;
+
+    /** The address immediately following the last usable byte. */
+    vm_address_t end;
+
+    /** The number of allocations that failed due to insufficient space. */
+    uint32_t failed_count;
+
+    /** Pads each sub-arena's metadata to its own cache line, preventing false sharing between workers. */
+    uint8_t padding[PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN - (3 * sizeof(vm_address_t)) - sizeof(uint32_t)];
+} plcrash_async_allocator_arena_t;
+
+/**
+ * A set of equally sized sub-arenas carved from a single contiguous allocation. The set is released, reset, or
+ * resized as a unit.
+ */
+typedef struct plcrash_async_allocator_arena_set {
+    /** The allocator from which the sub-arenas were carved. */
+    plcrash_async_allocator_t *allocator;
+
+    /** The allocator position prior to carving the sub-arenas. */
+    plcrash_async_allocator_mark_t mark;
+
+    /** The number of sub-arenas. */
+    uint32_t count;
+
+    /** The usable size of each sub-arena, in bytes. */
+    size_t arena_size;
+
+    /** The sub-arenas. */
+    plcrash_async_allocator_arena_t arenas[PLCRASH_ASYNC_ALLOCATOR_ARENA_MAX];
+} plcrash_async_allocator_arena_set_t;
+
 plcrash_error_t plcrash_async_allocator_new (plcrash_async_allocator_t **allocator, size_t size, uint32_t options);
 void *plcrash_async_allocator_alloc (plcrash_async_allocator_t *allocator, size_t size, bool no_assert);
+void plcrash_async_allocator_dealloc (plcrash_async_allocator_t *allocator, void *ptr, size_t size);
+void plcrash_async_allocator_stats (plcrash_async_allocator_t *allocator, plcrash_async_allocator_stats_t *stats);
+plcrash_error_t plcrash_async_allocator_prefault (plcrash_async_allocator_t *allocator, bool wire);
+
+plcrash_async_allocator_mark_t plcrash_async_allocator_mark (plcrash_async_allocator_t *allocator);
+void plcrash_async_allocator_release_to_mark (plcrash_async_allocator_t *allocator, plcrash_async_allocator_mark_t mark);
+void plcrash_async_allocator_free (plcrash_async_allocator_t *allocator);
+
+plcrash_error_t plcrash_async_allocator_arenas_new (plcrash_async_allocator_t *allocator, plcrash_async_allocator_arena_set_t *set, uint32_t count, size_t arena_size);
+plcrash_async_allocator_arena_t *plcrash_async_allocator_arenas_get (plcrash_async_allocator_arena_set_t *set, uint32_t index);
+void plcrash_async_allocator_arenas_reset (plcrash_async_allocator_arena_set_t *set);
+plcrash_error_t plcrash_async_allocator_arenas_resize (plcrash_async_allocator_arena_set_t *set, uint32_t count, size_t arena_size);
+void plcrash_async_allocator_arenas_release (plcrash_async_allocator_arena_set_t *set);
+
+void *plcrash_async_allocator_arena_alloc (plcrash_async_allocator_arena_t *arena, size_t size);
 
 /**
  * @}
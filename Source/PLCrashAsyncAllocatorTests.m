@@ -49,8 +49,126 @@
 
     void *buffer = plcrash_async_allocator_alloc(alloc, PAGE_SIZE, true);
     STAssertNotNULL(buffer, @"Failed to allocate page");
-    // TODO
-    // XXX missing free();
+
+    plcrash_async_allocator_free(alloc);
+}
+
+/**
+ * Test releasing allocations back to a mark.
+ */
+- (void) testReleaseToMark {
+    plcrash_async_allocator_t *alloc;
+    plcrash_error_t err;
+
+    err = plcrash_async_allocator_new(&alloc, PAGE_SIZE, PLCrashAsyncGuardLowPage|PLCrashAsyncGuardHighPage);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to initialize allocator");
+
+    void *retained = plcrash_async_allocator_alloc(alloc, 32, true);
+    STAssertNotNULL(retained, @"Failed to allocate");
+
+    /* Allocations after the mark should be released, and their space re-used */
+    plcrash_async_allocator_mark_t mark = plcrash_async_allocator_mark(alloc);
+    void *scratch = plcrash_async_allocator_alloc(alloc, PAGE_SIZE / 2, true);
+    STAssertNotNULL(scratch, @"Failed to allocate");
+    STAssertTrue(scratch > retained, @"Scratch allocation overlaps the retained allocation");
+
+    plcrash_async_allocator_release_to_mark(alloc, mark);
+    STAssertEquals(mark, plcrash_async_allocator_mark(alloc), @"Allocator was not reset to the mark");
+
+    void *reused = plcrash_async_allocator_alloc(alloc, PAGE_SIZE / 2, true);
+    STAssertEquals(scratch, reused, @"Released space was not re-used");
+
+    plcrash_async_allocator_free(alloc);
+}
+
+/**
+ * Test reuse of deallocated blocks and statistics reporting.
+ */
+- (void) testSizeClassReuse {
+    plcrash_async_allocator_t *alloc;
+    plcrash_async_allocator_stats_t stats;
+    plcrash_error_t err;
+
+    err = plcrash_async_allocator_new(&alloc, PAGE_SIZE, PLCrashAsyncGuardLowPage|PLCrashAsyncGuardHighPage);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to initialize allocator");
+
+    /* A deallocated block should be reused by an allocation of the same size class */
+    void *first = plcrash_async_allocator_alloc(alloc, 40, true);
+    STAssertNotNULL(first, @"Failed to allocate");
+    plcrash_async_allocator_dealloc(alloc, first, 40);
+
+    void *second = plcrash_async_allocator_alloc(alloc, 64, true);
+    STAssertEquals(first, second, @"Deallocated block was not reused");
+
+    /* An allocation that can't be satisfied should be counted */
+    STAssertNULL(plcrash_async_allocator_alloc(alloc, PAGE_SIZE * 4, true), @"Allocation should have failed");
+
+    plcrash_async_allocator_stats(alloc, &stats);
+    STAssertEquals(stats.alloc_count, (uint32_t)2, @"Incorrect allocation count");
+    STAssertEquals(stats.reuse_count, (uint32_t)1, @"Incorrect reuse count");
+    STAssertEquals(stats.failed_count, (uint32_t)1, @"Incorrect failed allocation count");
+    STAssertEquals(stats.high_water_mark, (size_t)64, @"Incorrect high water mark");
+
+    plcrash_async_allocator_free(alloc);
+}
+
+/**
+ * Test carving, allocating from, resetting, and resizing per-worker sub-arenas.
+ */
+- (void) testSubArenas {
+    plcrash_async_allocator_t *alloc;
+    plcrash_async_allocator_arena_set_t set;
+    plcrash_error_t err;
+
+    err = plcrash_async_allocator_new(&alloc, PAGE_SIZE * 4, PLCrashAsyncGuardLowPage|PLCrashAsyncGuardHighPage);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to initialize allocator");
+
+    plcrash_async_allocator_mark_t mark = plcrash_async_allocator_mark(alloc);
+
+    /* Out of range counts and sizes must be rejected without modifying the allocator */
+    STAssertEquals(PLCRASH_EINVAL, plcrash_async_allocator_arenas_new(alloc, &set, 0, 128), @"Zero sub-arenas were accepted");
+    STAssertEquals(PLCRASH_EINVAL, plcrash_async_allocator_arenas_new(alloc, &set, PLCRASH_ASYNC_ALLOCATOR_ARENA_MAX + 1, 128), @"Too many sub-arenas were accepted");
+    STAssertEquals(PLCRASH_ENOMEM, plcrash_async_allocator_arenas_new(alloc, &set, 2, PAGE_SIZE * 4), @"Oversized sub-arenas were accepted");
+    STAssertEquals(mark, plcrash_async_allocator_mark(alloc), @"Failed carving modified the allocator");
+
+    /* Carve the sub-arenas; each must be aligned, and must not overlap its neighbors */
+    err = plcrash_async_allocator_arenas_new(alloc, &set, 4, 100);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to carve sub-arenas");
+
+    for (uint32_t i = 0; i < 4; i++) {
+        plcrash_async_allocator_arena_t *arena = plcrash_async_allocator_arenas_get(&set, i);
+        STAssertEquals((vm_address_t) 0, arena->base % PLCRASH_ASYNC_ALLOCATOR_ARENA_ALIGN, @"Sub-arena is misaligned");
+        STAssertEquals((vm_address_t) 128, arena->end - arena->base, @"Sub-arena size was not rounded to the alignment");
+        if (i > 0)
+            STAssertTrue(arena->base >= plcrash_async_allocator_arenas_get(&set, i - 1)->end, @"Sub-arenas overlap");
+    }
+
+    /* Allocate until a sub-arena is exhausted; the other sub-arenas must be unaffected */
+    plcrash_async_allocator_arena_t *first = plcrash_async_allocator_arenas_get(&set, 0);
+    void *a = plcrash_async_allocator_arena_alloc(first, 60);
+    void *b = plcrash_async_allocator_arena_alloc(first, 60);
+    STAssertNotNULL(a, @"Failed to allocate");
+    STAssertNotNULL(b, @"Failed to allocate");
+    STAssertNULL(plcrash_async_allocator_arena_alloc(first, 60), @"Allocation exceeded the sub-arena");
+    STAssertEquals((uint32_t) 1, first->failed_count, @"Failure was not counted");
+    STAssertNotNULL(plcrash_async_allocator_arena_alloc(plcrash_async_allocator_arenas_get(&set, 1), 128), @"Sub-arena exhaustion leaked into its neighbor");
+
+    /* Resetting the set must make the space available again */
+    plcrash_async_allocator_arenas_reset(&set);
+    STAssertEquals(a, plcrash_async_allocator_arena_alloc(first, 60), @"Reset space was not re-used");
+    STAssertEquals((uint32_t) 0, first->failed_count, @"Failure count was not reset");
+
+    /* Resizing must replace the sub-arenas within the same allocator */
+    err = plcrash_async_allocator_arenas_resize(&set, 2, PAGE_SIZE);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to resize sub-arenas");
+    STAssertEquals((uint32_t) 2, set.count, @"Incorrect sub-arena count");
+    STAssertNotNULL(plcrash_async_allocator_arena_alloc(plcrash_async_allocator_arenas_get(&set, 1), PAGE_SIZE), @"Failed to allocate from a resized sub-arena");
+
+    /* Releasing the set must return the allocator to its prior position */
+    plcrash_async_allocator_arenas_release(&set);
+    STAssertEquals(mark, plcrash_async_allocator_mark(alloc), @"Sub-arenas were not released");
+
+    plcrash_async_allocator_free(alloc);
 }
 
 @end
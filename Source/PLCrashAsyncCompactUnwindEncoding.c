@@ -32,6 +32,7 @@
 #include "PLCrashFeatureConfig.h"
 
 #include <inttypes.h>
+#include <libkern/OSAtomic.h>
 
 #if PLCRASH_FEATURE_UNWIND_COMPACT
 
@@ -62,11 +63,15 @@
 plcrash_error_t plcrash_async_cfe_reader_init (plcrash_async_cfe_reader_t *reader, plcrash_async_mobject_t *mobj, cpu_type_t cputype) {
     reader->mobj = mobj;
     reader->cpu_type = cputype;
+    reader->page_valid = false;
+    reader->entry_cache_valid = 0;
+    reader->index = NULL;
 
     /* Determine the expected encoding */
     switch (cputype) {
         case CPU_TYPE_X86:
         case CPU_TYPE_X86_64:
+        case CPU_TYPE_ARM64:
             reader->byteorder = plcrash_async_byteorder_little_endian();
             break;
 
@@ -140,51 +145,109 @@ plcrash_error_t plcrash_async_cfe_reader_init (plcrash_async_cfe_reader_t *reade
     } \
 } while (0)
 
+/**
+ * @internal
+ *
+ * Search a compressed second-level page's entries for the last entry whose function offset is less than or equal to
+ * @a offset, using a branchless lower bound. Each step of the search selects the next window via a conditional move
+ * rather than a branch, so the search takes a fixed log2(@a count) steps regardless of @a offset, and never
+ * mispredicts on the entry comparisons.
+ *
+ * @param entries The page's compressed entries.
+ * @param count The number of entries in @a entries. Must be non-zero.
+ * @param offset The target function offset, relative to the page's base function offset.
+ * @param byteorder The byte order of @a entries.
+ *
+ * @return Returns a pointer to the matching entry, or NULL if @a offset precedes the first entry.
+ */
+static const uint32_t *plcrash_async_cfe_compressed_search (const uint32_t *entries, uint32_t count, uint64_t offset, const plcrash_async_byteorder_t *byteorder) {
+    const uint32_t *base = entries;
+    uint32_t n = count;
+
+    if (byteorder == &plcrash_async_byteorder_direct) {
+        /* Native byte order; compare the masked entries directly */
+        while (n > 1) {
+            uint32_t half = n / 2;
+            base = (UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(base[half]) <= offset) ? base + half : base;
+            n -= half;
+        }
+    } else {
+        while (n > 1) {
+            uint32_t half = n / 2;
+            base = (UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(byteorder->swap32(base[half])) <= offset) ? base + half : base;
+            n -= half;
+        }
+    }
+
+    if (UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(byteorder->swap32(*base)) > offset)
+        return NULL;
+
+    return base;
+}
+
 /* Evaluates to true if the length of @a _ecount * @a sizof(_etype) can not be represented
  * by size_t. */
 #define VERIFY_SIZE_T(_etype, _ecount) (SIZE_MAX / sizeof(_etype) < _ecount)
 
 /**
- * Return the compact frame encoding entry for @a pc via @a encoding, if available.
+ * @internal
  *
- * @param reader The initialized CFE reader which will be searched for the entry.
+ * Search the first-level index of @a reader for the second-level page containing @a pc, and decode and validate the
+ * page's header. On success, the result will be memoized in @a reader's page_* fields.
+ *
+ * @param reader The initialized CFE reader which will be searched for the page.
  * @param pc The PC value to search for within the CFE data. Note that this value must be relative to
  * the target Mach-O image's __TEXT vmaddr.
- * @param function_base On success, will be populated with the base address of the function. This value is relative to
- * the image's load address, rather than the in-memory address of the loaded image.
- * @param encoding On success, will be populated with the compact frame encoding entry.
  *
  * @return Returns PLFRAME_ESUCCCESS on success, or one of the remaining error codes if a CFE parsing error occurs. If
- * the entry can not be found, PLFRAME_ENOTFOUND will be returned.
+ * the page can not be found, PLFRAME_ENOTFOUND will be returned.
  */
-plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *reader, pl_vm_address_t pc, pl_vm_address_t *function_base, uint32_t *encoding) {
+static plcrash_error_t plcrash_async_cfe_reader_load_page (plcrash_async_cfe_reader_t *reader, pl_vm_address_t pc) {
     const plcrash_async_byteorder_t *byteorder = reader->byteorder;
     const pl_vm_address_t base_addr = plcrash_async_mobject_base_address(reader->mobj);
 
-    /* Find and map the common encodings table */
-    uint32_t common_enc_count = byteorder->swap32(reader->header.commonEncodingsArrayCount);
-    uint32_t *common_enc;
-    {
-        if (VERIFY_SIZE_T(uint32_t, common_enc_count)) {
-            PLCF_DEBUG("CFE common encoding count extends beyond the range of size_t");
-            return PLCRASH_EINVAL;
+    reader->page_valid = false;
+
+    /* Find the first level entry, and record the range of PC values it covers */
+    uint32_t second_level_offset;
+    if (reader->index != NULL) {
+        /* Search the image's validated local copy of the index */
+        const plcrash_async_macho_cfe_index_t *index = reader->index;
+        const plcrash_async_macho_cfe_index_entry_t *first_level_entry = NULL;
+
+        if (index->count == 0) {
+            PLCF_DEBUG("CFE index contains no entries");
+            return PLCRASH_ENOTFOUND;
         }
 
-        size_t common_enc_len = common_enc_count * sizeof(uint32_t);
-        uint32_t common_enc_off = byteorder->swap32(reader->header.commonEncodingsArraySectionOffset);
-        common_enc = plcrash_async_mobject_remap_address(reader->mobj, base_addr, common_enc_off, common_enc_len);
-        if (common_enc == NULL) {
-            PLCF_DEBUG("The declared common table lies outside the mapped CFE range");
-            return PLCRASH_EINVAL;
+#define CFE_FUN_BINARY_SEARCH_ENTVAL(_tval) (_tval.function_offset)
+        CFE_FUN_BINARY_SEARCH(pc, index->entries, index->count, first_level_entry);
+#undef CFE_FUN_BINARY_SEARCH_ENTVAL
+
+        if (first_level_entry == NULL) {
+            PLCF_DEBUG("Could not find a first level CFE entry for pc=%" PRIx64, (uint64_t) pc);
+            return PLCRASH_ENOTFOUND;
         }
-    }
 
-    /* Find and load the first level entry */
-    struct unwind_info_section_header_index_entry *first_level_entry = NULL;
-    {
+        uint32_t first_level_idx = (uint32_t) (first_level_entry - index->entries);
+        reader->page_start = first_level_entry->function_offset;
+        if (first_level_idx + 1 < index->count) {
+            reader->page_end = index->entries[first_level_idx + 1].function_offset;
+            reader->page_last = false;
+        } else {
+            reader->page_end = 0;
+            reader->page_last = true;
+        }
+
+        second_level_offset = first_level_entry->page_offset;
+    } else {
+        struct unwind_info_section_header_index_entry *index_entries;
+        struct unwind_info_section_header_index_entry *first_level_entry = NULL;
+        uint32_t index_count;
+
         /* Find and map the index */
         uint32_t index_off = byteorder->swap32(reader->header.indexSectionOffset);
-        uint32_t index_count = byteorder->swap32(reader->header.indexCount);
+        index_count = byteorder->swap32(reader->header.indexCount);
         
         if (VERIFY_SIZE_T(sizeof(struct unwind_info_section_header_index_entry), index_count)) {
             PLCF_DEBUG("CFE index count extends beyond the range of size_t");
@@ -208,7 +271,7 @@ plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *re
         
         /* Load the index entries */
         size_t index_len = index_count * sizeof(struct unwind_info_section_header_index_entry);
-        struct unwind_info_section_header_index_entry *index_entries = plcrash_async_mobject_remap_address(reader->mobj, base_addr, index_off, index_len);
+        index_entries = plcrash_async_mobject_remap_address(reader->mobj, base_addr, index_off, index_len);
         if (index_entries == NULL) {
             PLCF_DEBUG("The declared entries table lies outside the mapped CFE range");
             return PLCRASH_EINVAL;
@@ -223,12 +286,29 @@ plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *re
             PLCF_DEBUG("Could not find a first level CFE entry for pc=%" PRIx64, (uint64_t) pc);
             return PLCRASH_ENOTFOUND;
         }
+
+        uint32_t first_level_idx = (uint32_t) (first_level_entry - index_entries);
+        reader->page_start = byteorder->swap32(first_level_entry->functionOffset);
+        if (first_level_idx + 1 < index_count) {
+            reader->page_end = byteorder->swap32(index_entries[first_level_idx + 1].functionOffset);
+            reader->page_last = false;
+        } else {
+            reader->page_end = 0;
+            reader->page_last = true;
+        }
+
+        second_level_offset = byteorder->swap32(first_level_entry->secondLevelPagesSectionOffset);
     }
 
-    /* Locate and decode the second-level entry */
-    uint32_t second_level_offset = byteorder->swap32(first_level_entry->secondLevelPagesSectionOffset);
+    /* Locate and decode the second-level page header */
     uint32_t *second_level_kind = plcrash_async_mobject_remap_address(reader->mobj, base_addr, second_level_offset, sizeof(uint32_t));
-    switch (byteorder->swap32(*second_level_kind)) {
+    if (second_level_kind == NULL) {
+        PLCF_DEBUG("The second-level page lies outside the mapped CFE range");
+        return PLCRASH_EINVAL;
+    }
+
+    reader->page_kind = byteorder->swap32(*second_level_kind);
+    switch (reader->page_kind) {
         case UNWIND_SECOND_LEVEL_REGULAR: {
             struct unwind_info_regular_second_level_page_header *header;
             header = plcrash_async_mobject_remap_address(reader->mobj, base_addr, second_level_offset, sizeof(*header));
@@ -250,23 +330,13 @@ plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *re
                 PLCF_DEBUG("CFE entries table lies outside the mapped CFE range");
                 return PLCRASH_EINVAL;
             }
-            
-            /* Binary search for the target entry */
-            struct unwind_info_regular_second_level_entry *entries = (struct unwind_info_regular_second_level_entry *) (((uintptr_t)header) + entries_offset);
-            struct unwind_info_regular_second_level_entry *entry = NULL;
-            
-#define CFE_FUN_BINARY_SEARCH_ENTVAL(_tval) (byteorder->swap32(_tval.functionOffset))
-            CFE_FUN_BINARY_SEARCH(pc, entries, entries_count, entry);
-#undef CFE_FUN_BINARY_SEARCH_ENTVAL
-            
-            if (entry == NULL) {
-                PLCF_DEBUG("Could not find a second level regular CFE entry for pc=%" PRIx64, (uint64_t) pc);
-                return PLCRASH_ENOTFOUND;
-            }
 
-            *encoding = byteorder->swap32(entry->encoding);
-            *function_base = byteorder->swap32(entry->functionOffset);
-            return PLCRASH_ESUCCESS;
+            reader->page_header = header;
+            reader->page_entries = (void *) (((uintptr_t)header) + entries_offset);
+            reader->page_entries_count = entries_count;
+            reader->page_encodings = NULL;
+            reader->page_encodings_count = 0;
+            break;
         }
 
         case UNWIND_SECOND_LEVEL_COMPRESSED: {
@@ -276,9 +346,6 @@ plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *re
                 PLCF_DEBUG("The second-level page header lies outside the mapped CFE range");
                 return PLCRASH_EINVAL;
             }
-            
-            /* Record the base offset */
-            uint32_t base_foffset = byteorder->swap32(first_level_entry->functionOffset);
 
             /* Find the entries array */
             uint32_t entries_offset = byteorder->swap16(header->entryPageOffset);
@@ -294,14 +361,140 @@ plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *re
                 return PLCRASH_EINVAL;
             }
 
-            /* Binary search for the target entry */
-            uint32_t *compressed_entries = (uint32_t *) (((uintptr_t)header) + entries_offset);
-            uint32_t *c_entry_ptr = NULL;
+            reader->page_header = header;
+            reader->page_entries = (void *) (((uintptr_t)header) + entries_offset);
+            reader->page_entries_count = entries_count;
+
+            /* Find the encodings table. An invalid table is only an error if a lookup requires a private encoding. */
+            uint32_t encodings_offset = byteorder->swap16(header->encodingsPageOffset);
+            uint32_t encodings_count = byteorder->swap16(header->encodingsCount);
+
+            if (VERIFY_SIZE_T(sizeof(uint32_t), encodings_count) ||
+                !plcrash_async_mobject_verify_local_pointer(reader->mobj, header, encodings_offset, encodings_count * sizeof(uint32_t)))
+            {
+                reader->page_encodings = NULL;
+                reader->page_encodings_count = 0;
+            } else {
+                reader->page_encodings = (uint32_t *) (((uintptr_t)header) + encodings_offset);
+                reader->page_encodings_count = encodings_count;
+            }
+            break;
+        }
+
+        default:
+            PLCF_DEBUG("Unsupported second-level CFE table kind: 0x%" PRIx32 " at 0x%" PRIx32, reader->page_kind, second_level_offset);
+            return PLCRASH_EINVAL;
+    }
+
+    reader->page_valid = true;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Return the compact frame encoding entry for @a pc via @a encoding, if available.
+ *
+ * The first-level entry and second-level page header from the most recent lookup are memoized by @a reader; lookups
+ * of PC values within the same second-level page will not re-search the first-level index.
+ *
+ * @param reader The initialized CFE reader which will be searched for the entry.
+ * @param pc The PC value to search for within the CFE data. Note that this value must be relative to
+ * the target Mach-O image's __TEXT vmaddr.
+ * @param function_base On success, will be populated with the base address of the function. This value is relative to
+ * the image's load address, rather than the in-memory address of the loaded image.
+ * @param encoding On success, will be populated with the compact frame encoding entry.
+ *
+ * @return Returns PLFRAME_ESUCCCESS on success, or one of the remaining error codes if a CFE parsing error occurs. If
+ * the entry can not be found, PLFRAME_ENOTFOUND will be returned.
+ */
+plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *reader, pl_vm_address_t pc, pl_vm_address_t *function_base, uint32_t *encoding) {
+    return plcrash_async_cfe_reader_find_pc_range(reader, pc, function_base, NULL, encoding);
+}
 
-#define CFE_FUN_BINARY_SEARCH_ENTVAL(_tval) (base_foffset + UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(byteorder->swap32(_tval)))
-            CFE_FUN_BINARY_SEARCH(pc, compressed_entries, entries_count, c_entry_ptr);
+/**
+ * Return the compact frame encoding entry for @a pc via @a encoding, if available, along with the range of PC values
+ * to which the entry applies.
+ *
+ * @param reader The initialized CFE reader which will be searched for the entry.
+ * @param pc The PC value to search for within the CFE data. Note that this value must be relative to
+ * the target Mach-O image's __TEXT vmaddr.
+ * @param function_base On success, will be populated with the base address of the function. This value is relative to
+ * the image's load address, rather than the in-memory address of the loaded image.
+ * @param function_end If non-NULL, will be populated on success with the address immediately following the
+ * function, relative to the image's load address. If the entry is the last entry in the final second-level page,
+ * the end of the function is unknown, and 0 will be returned.
+ * @param encoding On success, will be populated with the compact frame encoding entry.
+ *
+ * @return Returns PLFRAME_ESUCCCESS on success, or one of the remaining error codes if a CFE parsing error occurs. If
+ * the entry can not be found, PLFRAME_ENOTFOUND will be returned.
+ */
+plcrash_error_t plcrash_async_cfe_reader_find_pc_range (plcrash_async_cfe_reader_t *reader, pl_vm_address_t pc, pl_vm_address_t *function_base, pl_vm_address_t *function_end, uint32_t *encoding) {
+    const plcrash_async_byteorder_t *byteorder = reader->byteorder;
+    const pl_vm_address_t base_addr = plcrash_async_mobject_base_address(reader->mobj);
+    plcrash_error_t err;
+
+    /* Find and map the common encodings table */
+    uint32_t common_enc_count = byteorder->swap32(reader->header.commonEncodingsArrayCount);
+    uint32_t *common_enc;
+    {
+        if (VERIFY_SIZE_T(uint32_t, common_enc_count)) {
+            PLCF_DEBUG("CFE common encoding count extends beyond the range of size_t");
+            return PLCRASH_EINVAL;
+        }
+
+        size_t common_enc_len = common_enc_count * sizeof(uint32_t);
+        uint32_t common_enc_off = byteorder->swap32(reader->header.commonEncodingsArraySectionOffset);
+        common_enc = plcrash_async_mobject_remap_address(reader->mobj, base_addr, common_enc_off, common_enc_len);
+        if (common_enc == NULL) {
+            PLCF_DEBUG("The declared common table lies outside the mapped CFE range");
+            return PLCRASH_EINVAL;
+        }
+    }
+
+    /* Use the memoized second-level page if it covers the target PC; otherwise, search the first-level index */
+    if (!reader->page_valid || pc < reader->page_start || (!reader->page_last && pc >= reader->page_end)) {
+        if ((err = plcrash_async_cfe_reader_load_page(reader, pc)) != PLCRASH_ESUCCESS)
+            return err;
+    }
+
+    /* Search the second-level page */
+    switch (reader->page_kind) {
+        case UNWIND_SECOND_LEVEL_REGULAR: {
+            /* Binary search for the target entry */
+            struct unwind_info_regular_second_level_entry *entries = reader->page_entries;
+            struct unwind_info_regular_second_level_entry *entry = NULL;
+            
+#define CFE_FUN_BINARY_SEARCH_ENTVAL(_tval) (byteorder->swap32(_tval.functionOffset))
+            CFE_FUN_BINARY_SEARCH(pc, entries, reader->page_entries_count, entry);
 #undef CFE_FUN_BINARY_SEARCH_ENTVAL
             
+            if (entry == NULL) {
+                PLCF_DEBUG("Could not find a second level regular CFE entry for pc=%" PRIx64, (uint64_t) pc);
+                return PLCRASH_ENOTFOUND;
+            }
+
+            *encoding = byteorder->swap32(entry->encoding);
+            *function_base = byteorder->swap32(entry->functionOffset);
+
+            if (function_end != NULL) {
+                if ((size_t) (entry - entries) + 1 < reader->page_entries_count)
+                    *function_end = byteorder->swap32(entry[1].functionOffset);
+                else
+                    *function_end = reader->page_last ? 0 : reader->page_end;
+            }
+            return PLCRASH_ESUCCESS;
+        }
+
+        case UNWIND_SECOND_LEVEL_COMPRESSED: {
+            /* Record the base offset */
+            uint32_t base_foffset = (uint32_t) reader->page_start;
+
+            /* Search for the target entry; the page's entries were mapped when the page was loaded */
+            const uint32_t *compressed_entries = reader->page_entries;
+            const uint32_t *c_entry_ptr = NULL;
+
+            if (pc >= base_foffset && reader->page_entries_count > 0)
+                c_entry_ptr = plcrash_async_cfe_compressed_search(compressed_entries, reader->page_entries_count, pc - base_foffset, byteorder);
+
             if (c_entry_ptr == NULL) {
                 PLCF_DEBUG("Could not find a second level compressed CFE entry for pc=%" PRIx64, (uint64_t) pc);
                 return PLCRASH_ENOTFOUND;
@@ -312,7 +505,15 @@ plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *re
             uint8_t c_encoding_idx = UNWIND_INFO_COMPRESSED_ENTRY_ENCODING_INDEX(c_entry);
             
             /* Save the function base */
-            *function_base = base_foffset + UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(byteorder->swap32(c_entry));
+            *function_base = base_foffset + UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(c_entry);
+
+            /* Save the function end; this is the start of the next entry, or the end of the page */
+            if (function_end != NULL) {
+                if ((size_t) (c_entry_ptr - compressed_entries) + 1 < reader->page_entries_count)
+                    *function_end = base_foffset + UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(byteorder->swap32(c_entry_ptr[1]));
+                else
+                    *function_end = reader->page_last ? 0 : reader->page_end;
+            }
             
             /* Handle common table entries */
             if (c_encoding_idx < common_enc_count) {
@@ -322,37 +523,26 @@ plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *re
                 return PLCRASH_ESUCCESS;
             }
 
-            /* Map in the encodings table */
-            uint32_t encodings_offset = byteorder->swap16(header->encodingsPageOffset);
-            uint32_t encodings_count = byteorder->swap16(header->encodingsCount);
-            
-            if (VERIFY_SIZE_T(sizeof(uint32_t), encodings_count)) {
-                PLCF_DEBUG("CFE second level entry count extends beyond the range of size_t");
-                return PLCRASH_EINVAL;
-            }
-
-            if (!plcrash_async_mobject_verify_local_pointer(reader->mobj, header, encodings_offset, encodings_count * sizeof(uint32_t))) {
+            if (reader->page_encodings == NULL) {
                 PLCF_DEBUG("CFE compressed encodings table lies outside the mapped CFE range");
                 return PLCRASH_EINVAL;
             }
 
-            uint32_t *encodings = (uint32_t *) (((uintptr_t)header) + encodings_offset);
-
-            /* Verify that the entry is within range */
+            /* Verify that the entry is within range of the page's encodings table */
             c_encoding_idx -= common_enc_count;
-            if (c_encoding_idx >= encodings_count) {
+            if (c_encoding_idx >= reader->page_encodings_count) {
                 PLCF_DEBUG("Encoding index lies outside the second level encoding table");
                 return PLCRASH_EINVAL;
             }
 
             /* Save the results */
-            *encoding = byteorder->swap32(encodings[c_encoding_idx]);
+            *encoding = byteorder->swap32(reader->page_encodings[c_encoding_idx]);
             return PLCRASH_ESUCCESS;
         }
 
         default:
-            PLCF_DEBUG("Unsupported second-level CFE table kind: 0x%" PRIx32 " at 0x%" PRIx32, byteorder->swap32(*second_level_kind), second_level_offset);
-            return PLCRASH_EINVAL;
+            /* Unreachable; unsupported page kinds are rejected by plcrash_async_cfe_reader_load_page() */
+            break;
     }
 
     // Unreachable
@@ -360,6 +550,37 @@ plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *re
     return PLCRASH_ENOTFOUND;
 }
 
+/**
+ * Decode the CFE @a encoding for the reader's CPU type, as per plcrash_async_cfe_entry_init(). Successfully decoded
+ * entries are memoized by @a reader in a small direct-mapped cache; decoding of a repeated encoding is replaced by a
+ * copy of the previously decoded entry.
+ *
+ * @param reader The reader that returned @a encoding.
+ * @param encoding The CFE entry data, in the host's native byte order.
+ * @param entry The entry instance to initialize. The initialized instance must be freed via plcrash_async_cfe_entry_free().
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or one of the errors returned by plcrash_async_cfe_entry_init().
+ */
+plcrash_error_t plcrash_async_cfe_reader_entry_init (plcrash_async_cfe_reader_t *reader, uint32_t encoding, plcrash_async_cfe_entry_t *entry) {
+    /* Fibonacci hashing; encodings that differ only in their low stack size or register bits map to distinct slots */
+    uint32_t slot = (encoding * 2654435769U) >> (32 - __builtin_ctz(PLCRASH_ASYNC_CFE_ENTRY_CACHE_SIZE));
+
+    if ((reader->entry_cache_valid & (1U << slot)) && reader->entry_cache_keys[slot] == encoding) {
+        *entry = reader->entry_cache[slot];
+        return PLCRASH_ESUCCESS;
+    }
+
+    plcrash_error_t err = plcrash_async_cfe_entry_init(entry, reader->cpu_type, encoding);
+    if (err != PLCRASH_ESUCCESS)
+        return err;
+
+    reader->entry_cache[slot] = *entry;
+    reader->entry_cache_keys[slot] = encoding;
+    reader->entry_cache_valid |= (1U << slot);
+
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * Free all resources associated with @a reader.
  */
@@ -367,6 +588,127 @@ void plcrash_async_cfe_reader_free (plcrash_async_cfe_reader_t *reader) {
     // noop
 }
 
+/**
+ * Configure @a reader to search @a index, as built by plcrash_nasync_cfe_build_index() for the reader's
+ * __unwind_info data, in place of the section's first-level index.
+ *
+ * @param reader The reader to configure.
+ * @param index The index to be used, or NULL to search the section's first-level index directly. The index must
+ * remain valid for the lifetime of the reader.
+ */
+void plcrash_async_cfe_reader_set_index (plcrash_async_cfe_reader_t *reader, const plcrash_async_macho_cfe_index_t *index) {
+    reader->index = index;
+    reader->page_valid = false;
+}
+
+/**
+ * Build a validated, host byte order copy of @a image's __unwind_info first-level index, and attach it to
+ * @a image. The index will be freed by plcrash_nasync_macho_free(). If an index has already been built, no action
+ * is taken.
+ *
+ * The index entries are validated once here -- the entries must be sorted by function offset, and each second-level
+ * page offset must lie within the section -- allowing crash-time lookups to binary search a local array rather than
+ * mapping and byte-swapping the target's index.
+ *
+ * @param image The image for which an index should be built.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the image has no __unwind_info section, or another
+ * error result on failure.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_cfe_build_index (plcrash_async_macho_t *image) {
+    plcrash_async_mobject_t storage;
+    plcrash_async_mobject_t *unwind_info;
+    plcrash_async_allocator_t *allocator;
+    plcrash_async_macho_cfe_index_t *index;
+    plcrash_async_cfe_reader_t reader;
+    plcrash_error_t err;
+
+    if (image->cfe_index != NULL)
+        return PLCRASH_ESUCCESS;
+
+    if ((err = plcrash_async_macho_map_known_section_cached(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO, &storage, &unwind_info)) != PLCRASH_ESUCCESS)
+        return err;
+
+    if ((err = plcrash_async_cfe_reader_init(&reader, unwind_info, image->byteorder->swap32(image->header.cputype))) != PLCRASH_ESUCCESS)
+        goto cleanup;
+
+    const plcrash_async_byteorder_t *byteorder = reader.byteorder;
+    const pl_vm_address_t base_addr = plcrash_async_mobject_base_address(unwind_info);
+    const pl_vm_size_t section_len = plcrash_async_mobject_length(unwind_info);
+
+    /* Map the index, excluding the trailing sentinel entry (see plcrash_async_cfe_reader_load_page()) */
+    uint32_t index_off = byteorder->swap32(reader.header.indexSectionOffset);
+    uint32_t count = byteorder->swap32(reader.header.indexCount);
+    if (count == 0 || VERIFY_SIZE_T(sizeof(struct unwind_info_section_header_index_entry), count)) {
+        PLCF_DEBUG("Invalid CFE index count %" PRIu32 " in %s", count, image->name);
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+    count--;
+
+    struct unwind_info_section_header_index_entry *entries;
+    entries = plcrash_async_mobject_remap_address(unwind_info, base_addr, index_off, count * sizeof(*entries));
+    if (entries == NULL) {
+        PLCF_DEBUG("The declared CFE index lies outside the mapped CFE range in %s", image->name);
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    /* Allocate the index */
+    {
+        size_t index_size = sizeof(plcrash_async_macho_cfe_index_t) + (sizeof(plcrash_async_macho_cfe_index_entry_t) * count);
+
+        if ((err = plcrash_async_allocator_new(&allocator, index_size, 0)) != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("Could not allocate a %" PRIu32 " entry CFE index for %s: %d", count, image->name, err);
+            goto cleanup;
+        }
+
+        if ((index = plcrash_async_allocator_alloc(allocator, index_size, true)) == NULL) {
+            PLCF_DEBUG("Could not allocate a %" PRIu32 " entry CFE index for %s", count, image->name);
+            plcrash_async_allocator_free(allocator);
+            err = PLCRASH_ENOMEM;
+            goto cleanup;
+        }
+    }
+
+    index->allocator = allocator;
+    index->count = count;
+
+    /* Copy and validate the entries */
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t function_offset = byteorder->swap32(entries[i].functionOffset);
+        uint32_t page_offset = byteorder->swap32(entries[i].secondLevelPagesSectionOffset);
+
+        if (i > 0 && function_offset < index->entries[i - 1].function_offset) {
+            PLCF_DEBUG("CFE index entry %" PRIu32 " is out of order in %s", i, image->name);
+            err = PLCRASH_EINVAL;
+        } else if (page_offset > section_len || section_len - page_offset < sizeof(uint32_t)) {
+            PLCF_DEBUG("CFE index entry %" PRIu32 " references a page outside the section in %s", i, image->name);
+            err = PLCRASH_EINVAL;
+        }
+
+        if (err != PLCRASH_ESUCCESS) {
+            plcrash_async_allocator_free(allocator);
+            goto cleanup;
+        }
+
+        index->entries[i].function_offset = function_offset;
+        index->entries[i].page_offset = page_offset;
+    }
+
+    /* Publish the index. If another index was concurrently published, discard ours. */
+    if (!OSAtomicCompareAndSwapPtrBarrier(NULL, index, (void **) &image->cfe_index))
+        plcrash_async_allocator_free(allocator);
+
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    plcrash_async_macho_mapped_section_release(&storage, unwind_info);
+    return err;
+}
+
 #pragma mark CFE Entry
 
 
@@ -475,6 +817,9 @@ uint32_t plcrash_async_cfe_register_encode (const uint32_t registers[], uint32_t
  * @internal
  * Decode a ordered register list from the 10 bit register encoding as defined by the CFE format.
  *
+ * This is the reference implementation of the permutation decoding; CFE entry parsing uses the equivalent
+ * table-driven plcrash_async_cfe_register_lookup().
+ *
  * @param permutation The 10-bit encoded register list.
  * @param count The number of registers to decode from @a permutation.
  * @param registers On return, the ordered list of decoded register values. These values must correspond to the CFE
@@ -558,6 +903,238 @@ permutation -= (permunreg[pos]*factor); \
 	}
 }
 
+/*
+ * Pre-decoded register permutation tables, indexed by the 10-bit permutation value, for each supported register
+ * count. Each entry packs the ordered list of decoded CFE register values (1-6) into 3-bit fields, with position 0
+ * in the least significant bits.
+ *
+ * These tables were generated from -- and are verified against -- the reference implementation in
+ * plcrash_async_cfe_register_decode(). The 5 and 6 register encodings use identical positional factors, and the
+ * 6 register table is used for both.
+ */
+static const uint32_t cfe_register_table_1[6] = {
+    0x00001, 0x00002, 0x00003, 0x00004, 0x00005, 0x00006
+};
+
+static const uint32_t cfe_register_table_2[30] = {
+    0x00011, 0x00019, 0x00021, 0x00029, 0x00031, 0x0000a, 0x0001a, 0x00022,
+    0x0002a, 0x00032, 0x0000b, 0x00013, 0x00023, 0x0002b, 0x00033, 0x0000c,
+    0x00014, 0x0001c, 0x0002c, 0x00034, 0x0000d, 0x00015, 0x0001d, 0x00025,
+    0x00035, 0x0000e, 0x00016, 0x0001e, 0x00026, 0x0002e
+};
+
+static const uint32_t cfe_register_table_3[120] = {
+    0x000d1, 0x00111, 0x00151, 0x00191, 0x00099, 0x00119, 0x00159, 0x00199,
+    0x000a1, 0x000e1, 0x00161, 0x001a1, 0x000a9, 0x000e9, 0x00129, 0x001a9,
+    0x000b1, 0x000f1, 0x00131, 0x00171, 0x000ca, 0x0010a, 0x0014a, 0x0018a,
+    0x0005a, 0x0011a, 0x0015a, 0x0019a, 0x00062, 0x000e2, 0x00162, 0x001a2,
+    0x0006a, 0x000ea, 0x0012a, 0x001aa, 0x00072, 0x000f2, 0x00132, 0x00172,
+    0x0008b, 0x0010b, 0x0014b, 0x0018b, 0x00053, 0x00113, 0x00153, 0x00193,
+    0x00063, 0x000a3, 0x00163, 0x001a3, 0x0006b, 0x000ab, 0x0012b, 0x001ab,
+    0x00073, 0x000b3, 0x00133, 0x00173, 0x0008c, 0x000cc, 0x0014c, 0x0018c,
+    0x00054, 0x000d4, 0x00154, 0x00194, 0x0005c, 0x0009c, 0x0015c, 0x0019c,
+    0x0006c, 0x000ac, 0x000ec, 0x001ac, 0x00074, 0x000b4, 0x000f4, 0x00174,
+    0x0008d, 0x000cd, 0x0010d, 0x0018d, 0x00055, 0x000d5, 0x00115, 0x00195,
+    0x0005d, 0x0009d, 0x0011d, 0x0019d, 0x00065, 0x000a5, 0x000e5, 0x001a5,
+    0x00075, 0x000b5, 0x000f5, 0x00135, 0x0008e, 0x000ce, 0x0010e, 0x0014e,
+    0x00056, 0x000d6, 0x00116, 0x00156, 0x0005e, 0x0009e, 0x0011e, 0x0015e,
+    0x00066, 0x000a6, 0x000e6, 0x00166, 0x0006e, 0x000ae, 0x000ee, 0x0012e
+};
+
+static const uint32_t cfe_register_table_4[360] = {
+    0x008d1, 0x00ad1, 0x00cd1, 0x00711, 0x00b11, 0x00d11, 0x00751, 0x00951,
+    0x00d51, 0x00791, 0x00991, 0x00b91, 0x00899, 0x00a99, 0x00c99, 0x00519,
+    0x00b19, 0x00d19, 0x00559, 0x00959, 0x00d59, 0x00599, 0x00999, 0x00b99,
+    0x006a1, 0x00aa1, 0x00ca1, 0x004e1, 0x00ae1, 0x00ce1, 0x00561, 0x00761,
+    0x00d61, 0x005a1, 0x007a1, 0x00ba1, 0x006a9, 0x008a9, 0x00ca9, 0x004e9,
+    0x008e9, 0x00ce9, 0x00529, 0x00729, 0x00d29, 0x005a9, 0x007a9, 0x009a9,
+    0x006b1, 0x008b1, 0x00ab1, 0x004f1, 0x008f1, 0x00af1, 0x00531, 0x00731,
+    0x00b31, 0x00571, 0x00771, 0x00971, 0x008ca, 0x00aca, 0x00cca, 0x0070a,
+    0x00b0a, 0x00d0a, 0x0074a, 0x0094a, 0x00d4a, 0x0078a, 0x0098a, 0x00b8a,
+    0x0085a, 0x00a5a, 0x00c5a, 0x0031a, 0x00b1a, 0x00d1a, 0x0035a, 0x0095a,
+    0x00d5a, 0x0039a, 0x0099a, 0x00b9a, 0x00662, 0x00a62, 0x00c62, 0x002e2,
+    0x00ae2, 0x00ce2, 0x00362, 0x00762, 0x00d62, 0x003a2, 0x007a2, 0x00ba2,
+    0x0066a, 0x0086a, 0x00c6a, 0x002ea, 0x008ea, 0x00cea, 0x0032a, 0x0072a,
+    0x00d2a, 0x003aa, 0x007aa, 0x009aa, 0x00672, 0x00872, 0x00a72, 0x002f2,
+    0x008f2, 0x00af2, 0x00332, 0x00732, 0x00b32, 0x00372, 0x00772, 0x00972,
+    0x0088b, 0x00a8b, 0x00c8b, 0x0050b, 0x00b0b, 0x00d0b, 0x0054b, 0x0094b,
+    0x00d4b, 0x0058b, 0x0098b, 0x00b8b, 0x00853, 0x00a53, 0x00c53, 0x00313,
+    0x00b13, 0x00d13, 0x00353, 0x00953, 0x00d53, 0x00393, 0x00993, 0x00b93,
+    0x00463, 0x00a63, 0x00c63, 0x002a3, 0x00aa3, 0x00ca3, 0x00363, 0x00563,
+    0x00d63, 0x003a3, 0x005a3, 0x00ba3, 0x0046b, 0x0086b, 0x00c6b, 0x002ab,
+    0x008ab, 0x00cab, 0x0032b, 0x0052b, 0x00d2b, 0x003ab, 0x005ab, 0x009ab,
+    0x00473, 0x00873, 0x00a73, 0x002b3, 0x008b3, 0x00ab3, 0x00333, 0x00533,
+    0x00b33, 0x00373, 0x00573, 0x00973, 0x0068c, 0x00a8c, 0x00c8c, 0x004cc,
+    0x00acc, 0x00ccc, 0x0054c, 0x0074c, 0x00d4c, 0x0058c, 0x0078c, 0x00b8c,
+    0x00654, 0x00a54, 0x00c54, 0x002d4, 0x00ad4, 0x00cd4, 0x00354, 0x00754,
+    0x00d54, 0x00394, 0x00794, 0x00b94, 0x0045c, 0x00a5c, 0x00c5c, 0x0029c,
+    0x00a9c, 0x00c9c, 0x0035c, 0x0055c, 0x00d5c, 0x0039c, 0x0059c, 0x00b9c,
+    0x0046c, 0x0066c, 0x00c6c, 0x002ac, 0x006ac, 0x00cac, 0x002ec, 0x004ec,
+    0x00cec, 0x003ac, 0x005ac, 0x007ac, 0x00474, 0x00674, 0x00a74, 0x002b4,
+    0x006b4, 0x00ab4, 0x002f4, 0x004f4, 0x00af4, 0x00374, 0x00574, 0x00774,
+    0x0068d, 0x0088d, 0x00c8d, 0x004cd, 0x008cd, 0x00ccd, 0x0050d, 0x0070d,
+    0x00d0d, 0x0058d, 0x0078d, 0x0098d, 0x00655, 0x00855, 0x00c55, 0x002d5,
+    0x008d5, 0x00cd5, 0x00315, 0x00715, 0x00d15, 0x00395, 0x00795, 0x00995,
+    0x0045d, 0x0085d, 0x00c5d, 0x0029d, 0x0089d, 0x00c9d, 0x0031d, 0x0051d,
+    0x00d1d, 0x0039d, 0x0059d, 0x0099d, 0x00465, 0x00665, 0x00c65, 0x002a5,
+    0x006a5, 0x00ca5, 0x002e5, 0x004e5, 0x00ce5, 0x003a5, 0x005a5, 0x007a5,
+    0x00475, 0x00675, 0x00875, 0x002b5, 0x006b5, 0x008b5, 0x002f5, 0x004f5,
+    0x008f5, 0x00335, 0x00535, 0x00735, 0x0068e, 0x0088e, 0x00a8e, 0x004ce,
+    0x008ce, 0x00ace, 0x0050e, 0x0070e, 0x00b0e, 0x0054e, 0x0074e, 0x0094e,
+    0x00656, 0x00856, 0x00a56, 0x002d6, 0x008d6, 0x00ad6, 0x00316, 0x00716,
+    0x00b16, 0x00356, 0x00756, 0x00956, 0x0045e, 0x0085e, 0x00a5e, 0x0029e,
+    0x0089e, 0x00a9e, 0x0031e, 0x0051e, 0x00b1e, 0x0035e, 0x0055e, 0x0095e,
+    0x00466, 0x00666, 0x00a66, 0x002a6, 0x006a6, 0x00aa6, 0x002e6, 0x004e6,
+    0x00ae6, 0x00366, 0x00566, 0x00766, 0x0046e, 0x0066e, 0x0086e, 0x002ae,
+    0x006ae, 0x008ae, 0x002ee, 0x004ee, 0x008ee, 0x0032e, 0x0052e, 0x0072e
+};
+
+static const uint32_t cfe_register_table_6[720] = {
+    0x358d1, 0x2e8d1, 0x34ad1, 0x26ad1, 0x2ccd1, 0x25cd1, 0x35711, 0x2e711,
+    0x33b11, 0x1eb11, 0x2bd11, 0x1dd11, 0x34751, 0x26751, 0x33951, 0x1e951,
+    0x23d51, 0x1cd51, 0x2c791, 0x25791, 0x2b991, 0x1d991, 0x23b91, 0x1cb91,
+    0x35899, 0x2e899, 0x34a99, 0x26a99, 0x2cc99, 0x25c99, 0x35519, 0x2e519,
+    0x32b19, 0x16b19, 0x2ad19, 0x15d19, 0x34559, 0x26559, 0x32959, 0x16959,
+    0x22d59, 0x14d59, 0x2c599, 0x25599, 0x2a999, 0x15999, 0x22b99, 0x14b99,
+    0x356a1, 0x2e6a1, 0x33aa1, 0x1eaa1, 0x2bca1, 0x1dca1, 0x354e1, 0x2e4e1,
+    0x32ae1, 0x16ae1, 0x2ace1, 0x15ce1, 0x33561, 0x1e561, 0x32761, 0x16761,
+    0x1ad61, 0x13d61, 0x2b5a1, 0x1d5a1, 0x2a7a1, 0x157a1, 0x1aba1, 0x13ba1,
+    0x346a9, 0x266a9, 0x338a9, 0x1e8a9, 0x23ca9, 0x1cca9, 0x344e9, 0x264e9,
+    0x328e9, 0x168e9, 0x22ce9, 0x14ce9, 0x33529, 0x1e529, 0x32729, 0x16729,
+    0x1ad29, 0x13d29, 0x235a9, 0x1c5a9, 0x227a9, 0x147a9, 0x1a9a9, 0x139a9,
+    0x2c6b1, 0x256b1, 0x2b8b1, 0x1d8b1, 0x23ab1, 0x1cab1, 0x2c4f1, 0x254f1,
+    0x2a8f1, 0x158f1, 0x22af1, 0x14af1, 0x2b531, 0x1d531, 0x2a731, 0x15731,
+    0x1ab31, 0x13b31, 0x23571, 0x1c571, 0x22771, 0x14771, 0x1a971, 0x13971,
+    0x358ca, 0x2e8ca, 0x34aca, 0x26aca, 0x2ccca, 0x25cca, 0x3570a, 0x2e70a,
+    0x33b0a, 0x1eb0a, 0x2bd0a, 0x1dd0a, 0x3474a, 0x2674a, 0x3394a, 0x1e94a,
+    0x23d4a, 0x1cd4a, 0x2c78a, 0x2578a, 0x2b98a, 0x1d98a, 0x23b8a, 0x1cb8a,
+    0x3585a, 0x2e85a, 0x34a5a, 0x26a5a, 0x2cc5a, 0x25c5a, 0x3531a, 0x2e31a,
+    0x31b1a, 0x0eb1a, 0x29d1a, 0x0dd1a, 0x3435a, 0x2635a, 0x3195a, 0x0e95a,
+    0x21d5a, 0x0cd5a, 0x2c39a, 0x2539a, 0x2999a, 0x0d99a, 0x21b9a, 0x0cb9a,
+    0x35662, 0x2e662, 0x33a62, 0x1ea62, 0x2bc62, 0x1dc62, 0x352e2, 0x2e2e2,
+    0x31ae2, 0x0eae2, 0x29ce2, 0x0dce2, 0x33362, 0x1e362, 0x31762, 0x0e762,
+    0x19d62, 0x0bd62, 0x2b3a2, 0x1d3a2, 0x297a2, 0x0d7a2, 0x19ba2, 0x0bba2,
+    0x3466a, 0x2666a, 0x3386a, 0x1e86a, 0x23c6a, 0x1cc6a, 0x342ea, 0x262ea,
+    0x318ea, 0x0e8ea, 0x21cea, 0x0ccea, 0x3332a, 0x1e32a, 0x3172a, 0x0e72a,
+    0x19d2a, 0x0bd2a, 0x233aa, 0x1c3aa, 0x217aa, 0x0c7aa, 0x199aa, 0x0b9aa,
+    0x2c672, 0x25672, 0x2b872, 0x1d872, 0x23a72, 0x1ca72, 0x2c2f2, 0x252f2,
+    0x298f2, 0x0d8f2, 0x21af2, 0x0caf2, 0x2b332, 0x1d332, 0x29732, 0x0d732,
+    0x19b32, 0x0bb32, 0x23372, 0x1c372, 0x21772, 0x0c772, 0x19972, 0x0b972,
+    0x3588b, 0x2e88b, 0x34a8b, 0x26a8b, 0x2cc8b, 0x25c8b, 0x3550b, 0x2e50b,
+    0x32b0b, 0x16b0b, 0x2ad0b, 0x15d0b, 0x3454b, 0x2654b, 0x3294b, 0x1694b,
+    0x22d4b, 0x14d4b, 0x2c58b, 0x2558b, 0x2a98b, 0x1598b, 0x22b8b, 0x14b8b,
+    0x35853, 0x2e853, 0x34a53, 0x26a53, 0x2cc53, 0x25c53, 0x35313, 0x2e313,
+    0x31b13, 0x0eb13, 0x29d13, 0x0dd13, 0x34353, 0x26353, 0x31953, 0x0e953,
+    0x21d53, 0x0cd53, 0x2c393, 0x25393, 0x29993, 0x0d993, 0x21b93, 0x0cb93,
+    0x35463, 0x2e463, 0x32a63, 0x16a63, 0x2ac63, 0x15c63, 0x352a3, 0x2e2a3,
+    0x31aa3, 0x0eaa3, 0x29ca3, 0x0dca3, 0x32363, 0x16363, 0x31563, 0x0e563,
+    0x11d63, 0x0ad63, 0x2a3a3, 0x153a3, 0x295a3, 0x0d5a3, 0x11ba3, 0x0aba3,
+    0x3446b, 0x2646b, 0x3286b, 0x1686b, 0x22c6b, 0x14c6b, 0x342ab, 0x262ab,
+    0x318ab, 0x0e8ab, 0x21cab, 0x0ccab, 0x3232b, 0x1632b, 0x3152b, 0x0e52b,
+    0x11d2b, 0x0ad2b, 0x223ab, 0x143ab, 0x215ab, 0x0c5ab, 0x119ab, 0x0a9ab,
+    0x2c473, 0x25473, 0x2a873, 0x15873, 0x22a73, 0x14a73, 0x2c2b3, 0x252b3,
+    0x298b3, 0x0d8b3, 0x21ab3, 0x0cab3, 0x2a333, 0x15333, 0x29533, 0x0d533,
+    0x11b33, 0x0ab33, 0x22373, 0x14373, 0x21573, 0x0c573, 0x11973, 0x0a973,
+    0x3568c, 0x2e68c, 0x33a8c, 0x1ea8c, 0x2bc8c, 0x1dc8c, 0x354cc, 0x2e4cc,
+    0x32acc, 0x16acc, 0x2accc, 0x15ccc, 0x3354c, 0x1e54c, 0x3274c, 0x1674c,
+    0x1ad4c, 0x13d4c, 0x2b58c, 0x1d58c, 0x2a78c, 0x1578c, 0x1ab8c, 0x13b8c,
+    0x35654, 0x2e654, 0x33a54, 0x1ea54, 0x2bc54, 0x1dc54, 0x352d4, 0x2e2d4,
+    0x31ad4, 0x0ead4, 0x29cd4, 0x0dcd4, 0x33354, 0x1e354, 0x31754, 0x0e754,
+    0x19d54, 0x0bd54, 0x2b394, 0x1d394, 0x29794, 0x0d794, 0x19b94, 0x0bb94,
+    0x3545c, 0x2e45c, 0x32a5c, 0x16a5c, 0x2ac5c, 0x15c5c, 0x3529c, 0x2e29c,
+    0x31a9c, 0x0ea9c, 0x29c9c, 0x0dc9c, 0x3235c, 0x1635c, 0x3155c, 0x0e55c,
+    0x11d5c, 0x0ad5c, 0x2a39c, 0x1539c, 0x2959c, 0x0d59c, 0x11b9c, 0x0ab9c,
+    0x3346c, 0x1e46c, 0x3266c, 0x1666c, 0x1ac6c, 0x13c6c, 0x332ac, 0x1e2ac,
+    0x316ac, 0x0e6ac, 0x19cac, 0x0bcac, 0x322ec, 0x162ec, 0x314ec, 0x0e4ec,
+    0x11cec, 0x0acec, 0x1a3ac, 0x133ac, 0x195ac, 0x0b5ac, 0x117ac, 0x0a7ac,
+    0x2b474, 0x1d474, 0x2a674, 0x15674, 0x1aa74, 0x13a74, 0x2b2b4, 0x1d2b4,
+    0x296b4, 0x0d6b4, 0x19ab4, 0x0bab4, 0x2a2f4, 0x152f4, 0x294f4, 0x0d4f4,
+    0x11af4, 0x0aaf4, 0x1a374, 0x13374, 0x19574, 0x0b574, 0x11774, 0x0a774,
+    0x3468d, 0x2668d, 0x3388d, 0x1e88d, 0x23c8d, 0x1cc8d, 0x344cd, 0x264cd,
+    0x328cd, 0x168cd, 0x22ccd, 0x14ccd, 0x3350d, 0x1e50d, 0x3270d, 0x1670d,
+    0x1ad0d, 0x13d0d, 0x2358d, 0x1c58d, 0x2278d, 0x1478d, 0x1a98d, 0x1398d,
+    0x34655, 0x26655, 0x33855, 0x1e855, 0x23c55, 0x1cc55, 0x342d5, 0x262d5,
+    0x318d5, 0x0e8d5, 0x21cd5, 0x0ccd5, 0x33315, 0x1e315, 0x31715, 0x0e715,
+    0x19d15, 0x0bd15, 0x23395, 0x1c395, 0x21795, 0x0c795, 0x19995, 0x0b995,
+    0x3445d, 0x2645d, 0x3285d, 0x1685d, 0x22c5d, 0x14c5d, 0x3429d, 0x2629d,
+    0x3189d, 0x0e89d, 0x21c9d, 0x0cc9d, 0x3231d, 0x1631d, 0x3151d, 0x0e51d,
+    0x11d1d, 0x0ad1d, 0x2239d, 0x1439d, 0x2159d, 0x0c59d, 0x1199d, 0x0a99d,
+    0x33465, 0x1e465, 0x32665, 0x16665, 0x1ac65, 0x13c65, 0x332a5, 0x1e2a5,
+    0x316a5, 0x0e6a5, 0x19ca5, 0x0bca5, 0x322e5, 0x162e5, 0x314e5, 0x0e4e5,
+    0x11ce5, 0x0ace5, 0x1a3a5, 0x133a5, 0x195a5, 0x0b5a5, 0x117a5, 0x0a7a5,
+    0x23475, 0x1c475, 0x22675, 0x14675, 0x1a875, 0x13875, 0x232b5, 0x1c2b5,
+    0x216b5, 0x0c6b5, 0x198b5, 0x0b8b5, 0x222f5, 0x142f5, 0x214f5, 0x0c4f5,
+    0x118f5, 0x0a8f5, 0x1a335, 0x13335, 0x19535, 0x0b535, 0x11735, 0x0a735,
+    0x2c68e, 0x2568e, 0x2b88e, 0x1d88e, 0x23a8e, 0x1ca8e, 0x2c4ce, 0x254ce,
+    0x2a8ce, 0x158ce, 0x22ace, 0x14ace, 0x2b50e, 0x1d50e, 0x2a70e, 0x1570e,
+    0x1ab0e, 0x13b0e, 0x2354e, 0x1c54e, 0x2274e, 0x1474e, 0x1a94e, 0x1394e,
+    0x2c656, 0x25656, 0x2b856, 0x1d856, 0x23a56, 0x1ca56, 0x2c2d6, 0x252d6,
+    0x298d6, 0x0d8d6, 0x21ad6, 0x0cad6, 0x2b316, 0x1d316, 0x29716, 0x0d716,
+    0x19b16, 0x0bb16, 0x23356, 0x1c356, 0x21756, 0x0c756, 0x19956, 0x0b956,
+    0x2c45e, 0x2545e, 0x2a85e, 0x1585e, 0x22a5e, 0x14a5e, 0x2c29e, 0x2529e,
+    0x2989e, 0x0d89e, 0x21a9e, 0x0ca9e, 0x2a31e, 0x1531e, 0x2951e, 0x0d51e,
+    0x11b1e, 0x0ab1e, 0x2235e, 0x1435e, 0x2155e, 0x0c55e, 0x1195e, 0x0a95e,
+    0x2b466, 0x1d466, 0x2a666, 0x15666, 0x1aa66, 0x13a66, 0x2b2a6, 0x1d2a6,
+    0x296a6, 0x0d6a6, 0x19aa6, 0x0baa6, 0x2a2e6, 0x152e6, 0x294e6, 0x0d4e6,
+    0x11ae6, 0x0aae6, 0x1a366, 0x13366, 0x19566, 0x0b566, 0x11766, 0x0a766,
+    0x2346e, 0x1c46e, 0x2266e, 0x1466e, 0x1a86e, 0x1386e, 0x232ae, 0x1c2ae,
+    0x216ae, 0x0c6ae, 0x198ae, 0x0b8ae, 0x222ee, 0x142ee, 0x214ee, 0x0c4ee,
+    0x118ee, 0x0a8ee, 0x1a32e, 0x1332e, 0x1952e, 0x0b52e, 0x1172e, 0x0a72e
+};
+
+/** Number of bits used to represent a single register in the pre-decoded permutation tables. */
+#define CFE_REGISTER_TABLE_BITS 3
+
+/**
+ * @internal
+ * Pre-decoded register permutation tables, indexed by register count.
+ */
+static const struct {
+    /** The table, or NULL if no registers are encoded. */
+    const uint32_t *table;
+
+    /** The number of valid permutations in @a table. */
+    uint32_t count;
+} cfe_register_tables[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX+1] = {
+    { NULL, 0 },
+    { cfe_register_table_1, sizeof(cfe_register_table_1) / sizeof(cfe_register_table_1[0]) },
+    { cfe_register_table_2, sizeof(cfe_register_table_2) / sizeof(cfe_register_table_2[0]) },
+    { cfe_register_table_3, sizeof(cfe_register_table_3) / sizeof(cfe_register_table_3[0]) },
+    { cfe_register_table_4, sizeof(cfe_register_table_4) / sizeof(cfe_register_table_4[0]) },
+    { cfe_register_table_6, sizeof(cfe_register_table_6) / sizeof(cfe_register_table_6[0]) },
+    { cfe_register_table_6, sizeof(cfe_register_table_6) / sizeof(cfe_register_table_6[0]) }
+};
+
+/**
+ * @internal
+ * Decode a ordered register list from the 10 bit register encoding as defined by the CFE format, using the
+ * pre-decoded permutation tables. The results are identical to those of plcrash_async_cfe_register_decode(), which
+ * is retained as the reference implementation.
+ *
+ * @param permutation The 10-bit encoded register list.
+ * @param count The number of registers to decode from @a permutation.
+ * @param registers On return, the ordered list of decoded register values. These values must correspond to the CFE
+ * register values, <em>not</em> the register values as defined in the PLCrashReporter thread state APIs.
+ *
+ * @return Returns true on success, or false if @a count exceeds PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX, or @a permutation
+ * is not a valid encoding for @a count registers.
+ */
+bool plcrash_async_cfe_register_lookup (uint32_t permutation, uint32_t count, uint32_t registers[]) {
+    if (count == 0)
+        return true;
+
+    if (count > PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX || permutation >= cfe_register_tables[count].count)
+        return false;
+
+    uint32_t packed = cfe_register_tables[count].table[permutation];
+    for (uint32_t i = 0; i < count; i++) {
+        registers[i] = packed & ((1 << CFE_REGISTER_TABLE_BITS) - 1);
+        packed >>= CFE_REGISTER_TABLE_BITS;
+    }
+
+    return true;
+}
+
 /**
  * @internal
  *
@@ -634,6 +1211,55 @@ static plcrash_error_t plcrash_async_map_register_name (uint32_t orig_reg, plcra
     }
 }
 
+/**
+ * @internal
+ *
+ * Decode the register pairs saved by an ARM64 FRAME or FRAMELESS @a encoding, populating @a entry's register list.
+ *
+ * Register pairs are saved in a fixed order (x19/x20 through x27/x28, followed by d8/d9 through d14/d15), starting
+ * from the top of the frame and growing downwards. The register list is populated in ascending address order, with
+ * the floating point slots marked as PLCRASH_REG_INVALID, as they are not represented in the thread state.
+ *
+ * @param entry The entry to populate.
+ * @param encoding The CFE entry data, in the hosts' native byte order.
+ */
+static void plcrash_async_cfe_entry_arm64_registers (plcrash_async_cfe_entry_t *entry, uint32_t encoding) {
+    static const struct {
+        uint32_t flag;
+        plcrash_regnum_t regs[2];
+    } pairs[] = {
+        { UNWIND_ARM64_FRAME_X19_X20_PAIR, { PLCRASH_ARM64_X19, PLCRASH_ARM64_X20 } },
+        { UNWIND_ARM64_FRAME_X21_X22_PAIR, { PLCRASH_ARM64_X21, PLCRASH_ARM64_X22 } },
+        { UNWIND_ARM64_FRAME_X23_X24_PAIR, { PLCRASH_ARM64_X23, PLCRASH_ARM64_X24 } },
+        { UNWIND_ARM64_FRAME_X25_X26_PAIR, { PLCRASH_ARM64_X25, PLCRASH_ARM64_X26 } },
+        { UNWIND_ARM64_FRAME_X27_X28_PAIR, { PLCRASH_ARM64_X27, PLCRASH_ARM64_X28 } },
+        { UNWIND_ARM64_FRAME_D8_D9_PAIR,   { PLCRASH_REG_INVALID, PLCRASH_REG_INVALID } },
+        { UNWIND_ARM64_FRAME_D10_D11_PAIR, { PLCRASH_REG_INVALID, PLCRASH_REG_INVALID } },
+        { UNWIND_ARM64_FRAME_D12_D13_PAIR, { PLCRASH_REG_INVALID, PLCRASH_REG_INVALID } },
+        { UNWIND_ARM64_FRAME_D14_D15_PAIR, { PLCRASH_REG_INVALID, PLCRASH_REG_INVALID } },
+    };
+
+    /* Count the saved slots */
+    uint32_t count = 0;
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        if (encoding & pairs[i].flag)
+            count += 2;
+    }
+    PLCF_ASSERT(count <= PLCRASH_ASYNC_CFE_REGISTER_LIST_MAX);
+
+    /* Populate the list from the highest address (the end of the list) downwards */
+    uint32_t slot = count;
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        if ((encoding & pairs[i].flag) == 0)
+            continue;
+
+        entry->register_list[--slot] = pairs[i].regs[0];
+        entry->register_list[--slot] = pairs[i].regs[1];
+    }
+
+    entry->register_count = count;
+}
+
 /**
  * Initialize a new decoded CFE entry using the provided encoded CFE data. Any resources held by a successfully
  * initialized instance must be freed via plcrash_async_cfe_entry_free();
@@ -706,7 +1332,10 @@ plcrash_error_t plcrash_async_cfe_entry_init (plcrash_async_cfe_entry_t *entry,
                 uint32_t encoded_regs = EXTRACT_BITS(encoding, UNWIND_X86_FRAMELESS_STACK_REG_PERMUTATION);
                 uint32_t decoded_regs[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX];
                 
-                plcrash_async_cfe_register_decode(encoded_regs, entry->register_count, decoded_regs);
+                if (!plcrash_async_cfe_register_lookup(encoded_regs, entry->register_count, decoded_regs)) {
+                    PLCF_DEBUG("Invalid register permutation 0x%" PRIx32 " for %" PRIu32 " registers", encoded_regs, entry->register_count);
+                    return PLCRASH_EINVAL;
+                }
                 
                 /* Map to the correct PLCrashReporter register names */
                 for (uint32_t i = 0; i < entry->register_count; i++) {
@@ -797,7 +1426,10 @@ plcrash_error_t plcrash_async_cfe_entry_init (plcrash_async_cfe_entry_t *entry,
                 uint32_t encoded_regs = EXTRACT_BITS(encoding, UNWIND_X86_64_FRAMELESS_STACK_REG_PERMUTATION);
                 uint32_t decoded_regs[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX];
 
-                plcrash_async_cfe_register_decode(encoded_regs, entry->register_count, decoded_regs);
+                if (!plcrash_async_cfe_register_lookup(encoded_regs, entry->register_count, decoded_regs)) {
+                    PLCF_DEBUG("Invalid register permutation 0x%" PRIx32 " for %" PRIu32 " registers", encoded_regs, entry->register_count);
+                    return PLCRASH_EINVAL;
+                }
                 
                 /* Map to the correct PLCrashReporter register names */
                 for (uint32_t i = 0; i < entry->register_count; i++) {
@@ -833,6 +1465,49 @@ plcrash_error_t plcrash_async_cfe_entry_init (plcrash_async_cfe_entry_t *entry,
                 return PLCRASH_ENOTSUP;
         }
         
+        // Unreachable
+        __builtin_trap();
+        return PLCRASH_EINTERNAL;
+
+    } else if (cpu_type == CPU_TYPE_ARM64) {
+        uint32_t mode = encoding & UNWIND_ARM64_MODE_MASK;
+        switch (mode) {
+            case UNWIND_ARM64_MODE_FRAME:
+                entry->type = PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAME_PTR;
+
+                /* The saved registers immediately precede the saved frame pointer and link register */
+                plcrash_async_cfe_entry_arm64_registers(entry, encoding);
+                entry->stack_offset = -((intptr_t) (entry->register_count * sizeof(uint64_t)));
+                return PLCRASH_ESUCCESS;
+
+            case UNWIND_ARM64_MODE_FRAMELESS:
+                entry->type = PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAMELESS_IMMD;
+
+                /* The stack size is encoded in 16 byte units */
+                entry->stack_offset = EXTRACT_BITS(encoding, UNWIND_ARM64_FRAMELESS_STACK_SIZE_MASK) * 16;
+                plcrash_async_cfe_entry_arm64_registers(entry, encoding);
+                return PLCRASH_ESUCCESS;
+
+            case UNWIND_ARM64_MODE_DWARF:
+                entry->type = PLCRASH_ASYNC_CFE_ENTRY_TYPE_DWARF;
+
+                /* Extract the register frame offset */
+                entry->stack_offset = EXTRACT_BITS(encoding, UNWIND_ARM64_DWARF_SECTION_OFFSET);
+                entry->register_count = 0;
+                return PLCRASH_ESUCCESS;
+
+            case 0:
+                /* Handle a NULL encoding, as per the x86 implementations above. */
+                entry->type = PLCRASH_ASYNC_CFE_ENTRY_TYPE_NONE;
+                entry->stack_offset = 0;
+                entry->register_count = 0;
+                return PLCRASH_ESUCCESS;
+
+            default:
+                PLCF_DEBUG("Unexpected entry mode of %" PRIx32, mode);
+                return PLCRASH_ENOTSUP;
+        }
+
         // Unreachable
         __builtin_trap();
         return PLCRASH_EINTERNAL;
@@ -910,6 +1585,7 @@ void plcrash_async_cfe_entry_register_list (plcrash_async_cfe_entry_t *entry, pl
  * with the result.
  *
  * @param task The task containing any data referenced by @a thread_state.
+ * @param stack_cache A read cache to be used when reading stack data from @a task, or NULL to perform uncached reads.
  * @param function_address The task-relative in-memory address of the function containing @a entry. This may be computed
  * by adding the function_base returned by plcrash_async_cfe_reader_find_pc() to the base address of the loaded image.
  * @param thread_state The current thread state corresponding to @a entry.
@@ -921,6 +1597,7 @@ void plcrash_async_cfe_entry_register_list (plcrash_async_cfe_entry_t *entry, pl
  * @todo This implementation assumes downwards stack growth.
  */
 plcrash_error_t plcrash_async_cfe_entry_apply (task_t task,
+                                               plcrash_async_task_read_cache_t *stack_cache,
                                                pl_vm_address_t function_address,
                                                const plcrash_async_thread_state_t *thread_state,
                                                plcrash_async_cfe_entry_t *entry,
@@ -976,7 +1653,7 @@ plcrash_error_t plcrash_async_cfe_entry_apply (task_t task,
             plcrash_async_thread_state_set_reg(new_thread_state, PLCRASH_REG_SP, new_sp);
 
             /* Read the saved fp and retaddr */
-            err = plcrash_async_task_memcpy(task, (pl_vm_address_t) fp, 0, dest, greg_size * 2);
+            err = plcrash_async_task_memcpy_cached(stack_cache, task, (pl_vm_address_t) fp, 0, dest, greg_size * 2);
             if (err != PLCRASH_ESUCCESS) {
                 PLCF_DEBUG("Failed to read frame data at address 0x%" PRIx64 ": %d", (uint64_t) fp, err);
                 return err;
@@ -1023,8 +1700,23 @@ plcrash_error_t plcrash_async_cfe_entry_apply (task_t task,
                 stack_size = indirect + entry->stack_adjust;
             }
 
-            /* Compute the address of the saved registers */
             plcrash_greg_t sp = plcrash_async_thread_state_get_reg(thread_state, PLCRASH_REG_SP);
+
+            /* ARM64 frameless functions do not spill the return address; it remains in the link register, and the
+             * saved registers are found at the top of the frame. */
+            if (entry->cpu_type == CPU_TYPE_ARM64) {
+                if (!plcrash_async_thread_state_has_reg(thread_state, PLCRASH_ARM64_LR)) {
+                    PLCF_DEBUG("Can't apply ARM64 FRAMELESS unwind type without a valid link register");
+                    return PLCRASH_ENOTFOUND;
+                }
+
+                saved_reg_addr = sp + stack_size - (greg_size * entry->register_count);
+                plcrash_async_thread_state_set_reg(new_thread_state, PLCRASH_REG_SP, sp + stack_size);
+                plcrash_async_thread_state_set_reg(new_thread_state, PLCRASH_REG_IP, plcrash_async_thread_state_get_reg(thread_state, PLCRASH_ARM64_LR));
+                break;
+            }
+
+            /* Compute the address of the saved registers */
             pl_vm_address_t retaddr = sp + stack_size - greg_size;
             saved_reg_addr = retaddr - (greg_size * entry->register_count); /* retaddr - [saved registers] */
 
@@ -1032,7 +1724,7 @@ plcrash_error_t plcrash_async_cfe_entry_apply (task_t task,
             plcrash_async_thread_state_set_reg(new_thread_state, PLCRASH_REG_SP, retaddr + greg_size);
 
             /* Read the saved return address */
-            err = plcrash_async_task_memcpy(task, (pl_vm_address_t) retaddr, 0, dest, greg_size);
+            err = plcrash_async_task_memcpy_cached(stack_cache, task, (pl_vm_address_t) retaddr, 0, dest, greg_size);
             if (err != PLCRASH_ESUCCESS) {
                 PLCF_DEBUG("Failed to read return address from 0x%" PRIx64 ": %d", (uint64_t) retaddr, err);
                 return err;
@@ -1056,7 +1748,7 @@ plcrash_error_t plcrash_async_cfe_entry_apply (task_t task,
 
     /* Extract the saved registers */
     uint32_t register_count = plcrash_async_cfe_entry_register_count(entry);
-    plcrash_regnum_t register_list[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX];
+    plcrash_regnum_t register_list[PLCRASH_ASYNC_CFE_REGISTER_LIST_MAX];
     plcrash_async_cfe_entry_register_list(entry, register_list);
     for (uint32_t i = 0; i < register_count; i++) {
         /* The register list may be sparse */
@@ -1065,7 +1757,7 @@ plcrash_error_t plcrash_async_cfe_entry_apply (task_t task,
 
         /* Fetch and save register data */
         plcrash_error_t err;
-        err = plcrash_async_task_memcpy(task, (pl_vm_address_t) saved_reg_addr, i*greg_size, dest, greg_size);
+        err = plcrash_async_task_memcpy_cached(stack_cache, task, (pl_vm_address_t) saved_reg_addr, i*greg_size, dest, greg_size);
         if (err != PLCRASH_ESUCCESS) {
             PLCF_DEBUG("Failed to read register data for index %s: %d", plcrash_async_thread_state_get_reg_name(thread_state, register_list[i]), err);
             return err;
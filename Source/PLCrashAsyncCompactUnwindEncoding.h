@@ -28,13 +28,39 @@
 #define PLCRASH_ASYNC_COMPACT_UNWIND_ENCODING_H 1
 
 #include "PLCrashAsync.h"
-#include "PLCrashAsyncImageList.h"
+#include "PLCrashAsyncMObject.h"
+#include "PLCrashAsyncMachOImage.h"
 #include "PLCrashAsyncThread.h"
 
 #include "PLCrashFeatureConfig.h"
 
 #include <mach-o/compact_unwind_encoding.h>
 
+/* ARM64 definitions, as required when building against SDKs that predate ARM64 */
+#ifndef CPU_TYPE_ARM64
+#define CPU_TYPE_ARM64 (CPU_TYPE_ARM | CPU_ARCH_ABI64)
+#endif
+
+#ifndef UNWIND_ARM64_MODE_MASK
+#define UNWIND_ARM64_MODE_MASK                  0x0F000000
+#define UNWIND_ARM64_MODE_FRAMELESS             0x02000000
+#define UNWIND_ARM64_MODE_DWARF                 0x03000000
+#define UNWIND_ARM64_MODE_FRAME                 0x04000000
+
+#define UNWIND_ARM64_FRAME_X19_X20_PAIR         0x00000001
+#define UNWIND_ARM64_FRAME_X21_X22_PAIR         0x00000002
+#define UNWIND_ARM64_FRAME_X23_X24_PAIR         0x00000004
+#define UNWIND_ARM64_FRAME_X25_X26_PAIR         0x00000008
+#define UNWIND_ARM64_FRAME_X27_X28_PAIR         0x00000010
+#define UNWIND_ARM64_FRAME_D8_D9_PAIR           0x00000100
+#define UNWIND_ARM64_FRAME_D10_D11_PAIR         0x00000200
+#define UNWIND_ARM64_FRAME_D12_D13_PAIR         0x00000400
+#define UNWIND_ARM64_FRAME_D14_D15_PAIR         0x00000800
+
+#define UNWIND_ARM64_FRAMELESS_STACK_SIZE_MASK  0x00FFF000
+#define UNWIND_ARM64_DWARF_SECTION_OFFSET       0x00FFFFFF
+#endif /* UNWIND_ARM64_MODE_MASK */
+
 #if PLCRASH_FEATURE_UNWIND_COMPACT
 
 /**
@@ -43,24 +69,6 @@
  * @{
  */
 
-/**
- * @internal
- * A CFE reader instance. Performs CFE data parsing from a backing memory object.
- */
-typedef struct plcrash_async_cfe_reader {
-    /** A memory object containing the CFE data at the starting address. */
-    plcrash_async_mobject_t *mobj;
-
-    /** The target CPU type. */
-    cpu_type_t cpu_type;
-
-    /** The unwind info header. Note that the header values may require byte-swapping for the local process' use. */
-    struct unwind_info_section_header header;
-
-    /** The byte order of the encoded data (including the header). */
-    const plcrash_async_byteorder_t *byteorder;
-} plcrash_async_cfe_reader_t;
-
 /**
  * Supported CFE entry formats.
  */
@@ -113,9 +121,13 @@ typedef enum {
 } plcrash_async_cfe_entry_type_t;
 
 
-/** Maximum number of saved non-volatile registers that may be represented in a CFE entry */
+/** Maximum number of saved non-volatile registers that may be represented in an x86 or x86-64 CFE entry */
 #define PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX 6
 
+/** Maximum number of register slots in a decoded CFE entry. An ARM64 entry may save five general purpose and
+ * four floating point register pairs. */
+#define PLCRASH_ASYNC_CFE_REGISTER_LIST_MAX 18
+
 /**
  * @internal
  *
@@ -131,9 +143,11 @@ typedef struct plcrash_async_cfe_entry {
 
     /**
      * Encoded stack offset. Interpretation of this value depends on the CFE type:
-     * - PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAME_PTR: Unused.
+     * - PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAME_PTR: The offset from the frame pointer to the saved registers.
      * - PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAMELESS_IMMD: The return address may be found at ± offset from the stack
-     *   pointer (eg, esp/rsp), and is followed all non-volatile registers that need to be restored.
+     *   pointer (eg, esp/rsp), and is followed all non-volatile registers that need to be restored. On ARM64, the
+     *   return address is found in the link register, and the offset is the total stack size; the saved registers
+     *   are stored at the top of the frame.
      * - PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAMELESS_INDIRECT: The actual offset may be loaded from the target function's
      *   instruction prologue. The offset given here must be added to the start address of the function to determine
      *   the location of the actual stack size as encoded in the prologue.
@@ -163,19 +177,102 @@ typedef struct plcrash_async_cfe_entry {
 
     /**
      * The ordered list of register_count non-volatile registers that must be restored from the stack. These values are
-     * specific to the target platform, and are defined in the @a plcrash_async_thread API. @sa plcrash_x86_regnum_t
-     * and @sa plcrash_x86_64_regnum_t. Note that the list may be sparse; some entries may be set to a value of
-     * PLCRASH_REG_INVALID.
+     * specific to the target platform, and are defined in the @a plcrash_async_thread API. @sa plcrash_x86_regnum_t,
+     * @sa plcrash_x86_64_regnum_t and @sa plcrash_arm64_regnum_t. Note that the list may be sparse; some entries may
+     * be set to a value of PLCRASH_REG_INVALID.
      */
-    plcrash_regnum_t register_list[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX];
+    plcrash_regnum_t register_list[PLCRASH_ASYNC_CFE_REGISTER_LIST_MAX];
 } plcrash_async_cfe_entry_t;
 
+/**
+ * @internal
+ * The number of slots in a CFE reader's decoded entry cache. Must be a power of two. Each image's reader carries its own
+ * cache, so the cache is kept small; the frame and frameless layouts used by most functions share a handful of
+ * encodings.
+ */
+#define PLCRASH_ASYNC_CFE_ENTRY_CACHE_SIZE 4
+
+/**
+ * @internal
+ * A CFE reader instance. Performs CFE data parsing from a backing memory object.
+ */
+typedef struct plcrash_async_cfe_reader {
+    /** A memory object containing the CFE data at the starting address. */
+    plcrash_async_mobject_t *mobj;
+
+    /** The target CPU type. */
+    cpu_type_t cpu_type;
+
+    /** The unwind info header. Note that the header values may require byte-swapping for the local process' use. */
+    struct unwind_info_section_header header;
+
+    /** The byte order of the encoded data (including the header). */
+    const plcrash_async_byteorder_t *byteorder;
+
+    /**
+     * If true, the page_* fields contain the first-level entry and decoded second-level page header from the most
+     * recent successful first-level lookup, and may be used to satisfy lookups of PC values within
+     * [page_start, page_end) without re-searching the first-level index.
+     */
+    bool page_valid;
+
+    /** The first PC value (relative to the image's __TEXT vmaddr) covered by the memoized second-level page. */
+    pl_vm_address_t page_start;
+
+    /** The PC value at which the next second-level page begins. Ignored if @a page_last is true. */
+    pl_vm_address_t page_end;
+
+    /** If true, the memoized page is the final page in the index, and covers all PC values >= @a page_start. */
+    bool page_last;
+
+    /** The second-level page kind (UNWIND_SECOND_LEVEL_REGULAR or UNWIND_SECOND_LEVEL_COMPRESSED). */
+    uint32_t page_kind;
+
+    /** The mapped second-level page header. */
+    void *page_header;
+
+    /** The validated number of entries in the second-level page's entry table. */
+    uint32_t page_entries_count;
+
+    /** The validated entry table, within the mapped page. */
+    void *page_entries;
+
+    /** The validated number of encodings in a compressed page's encodings table. Unused for regular pages. */
+    uint32_t page_encodings_count;
+
+    /** The validated encodings table, within the mapped page, or NULL if the page is a regular page, or if the
+     * page's encodings table is invalid. */
+    uint32_t *page_encodings;
+
+    /** The image's validated first-level index, or NULL if the section's index should be searched directly.
+     * See plcrash_async_cfe_reader_set_index(). */
+    const plcrash_async_macho_cfe_index_t *index;
+
+    /** Bitmap of valid entry_cache slots. */
+    uint32_t entry_cache_valid;
+
+    /** The encodings of the decoded entries in entry_cache, indexed by slot. */
+    uint32_t entry_cache_keys[PLCRASH_ASYNC_CFE_ENTRY_CACHE_SIZE];
+
+    /**
+     * A direct-mapped cache of decoded entries, keyed by encoding. The reader's CPU type is fixed, so the encoding
+     * alone identifies an entry. See plcrash_async_cfe_reader_entry_init().
+     */
+    plcrash_async_cfe_entry_t entry_cache[PLCRASH_ASYNC_CFE_ENTRY_CACHE_SIZE];
+} plcrash_async_cfe_reader_t;
+
 plcrash_error_t plcrash_async_cfe_reader_init (plcrash_async_cfe_reader_t *reader, plcrash_async_mobject_t *mobj, cpu_type_t cputype);
 
 plcrash_error_t plcrash_async_cfe_reader_find_pc (plcrash_async_cfe_reader_t *reader, pl_vm_address_t pc, pl_vm_address_t *function_base, uint32_t *encoding);
+plcrash_error_t plcrash_async_cfe_reader_find_pc_range (plcrash_async_cfe_reader_t *reader, pl_vm_address_t pc, pl_vm_address_t *function_base, pl_vm_address_t *function_end, uint32_t *encoding);
+
+plcrash_error_t plcrash_async_cfe_reader_entry_init (plcrash_async_cfe_reader_t *reader, uint32_t encoding, plcrash_async_cfe_entry_t *entry);
 
 void plcrash_async_cfe_reader_free (plcrash_async_cfe_reader_t *reader);
 
+void plcrash_async_cfe_reader_set_index (plcrash_async_cfe_reader_t *reader, const plcrash_async_macho_cfe_index_t *index);
+plcrash_error_t plcrash_nasync_cfe_build_index (plcrash_async_macho_t *image);
+
 
 plcrash_error_t plcrash_async_cfe_entry_init (plcrash_async_cfe_entry_t *entry, cpu_type_t cpu_type, uint32_t encoding);
 
@@ -186,6 +283,7 @@ uint32_t plcrash_async_cfe_entry_register_count (plcrash_async_cfe_entry_t *entr
 void plcrash_async_cfe_entry_register_list (plcrash_async_cfe_entry_t *entry, plcrash_regnum_t register_list[]);
 
 plcrash_error_t plcrash_async_cfe_entry_apply (task_t task,
+                                               plcrash_async_task_read_cache_t *stack_cache,
                                                pl_vm_address_t function_address,
                                                const plcrash_async_thread_state_t *thread_state,
                                                plcrash_async_cfe_entry_t *entry,
@@ -195,6 +293,7 @@ void plcrash_async_cfe_entry_free (plcrash_async_cfe_entry_t *entry);
 
 uint32_t plcrash_async_cfe_register_encode (const uint32_t registers[], uint32_t count);
 void plcrash_async_cfe_register_decode (uint32_t permutation, uint32_t count, uint32_t registers[]);
+bool plcrash_async_cfe_register_lookup (uint32_t permutation, uint32_t count, uint32_t registers[]);
 
 /**
  * @} plcrash_async_cfe
@@ -535,6 +535,87 @@
     plcrash_async_cfe_entry_free(&entry);
 }
 
+/**
+ * Decode an ARM64 frame encoding.
+ */
+- (void) testARM64DecodeFrame {
+    /* Save x19/x20, d8/d9, and x27/x28; the floating point pair is saved below all general purpose pairs */
+    uint32_t encoding = UNWIND_ARM64_MODE_FRAME |
+        UNWIND_ARM64_FRAME_X19_X20_PAIR |
+        UNWIND_ARM64_FRAME_X27_X28_PAIR |
+        UNWIND_ARM64_FRAME_D8_D9_PAIR;
+
+    plcrash_async_cfe_entry_t entry;
+    plcrash_error_t res = plcrash_async_cfe_entry_init(&entry, CPU_TYPE_ARM64, encoding);
+    STAssertEquals(res, PLCRASH_ESUCCESS, @"Failed to decode entry");
+    STAssertEquals(PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAME_PTR, plcrash_async_cfe_entry_type(&entry), @"Incorrect entry type");
+
+    /* The registers are saved immediately below the frame pointer, in ascending address order */
+    uint32_t reg_count = plcrash_async_cfe_entry_register_count(&entry);
+    STAssertEquals(reg_count, (uint32_t) 6, @"Incorrect register count decoded");
+    STAssertEquals(plcrash_async_cfe_entry_stack_offset(&entry), (intptr_t) -(6 * 8), @"Incorrect register offset decoded");
+
+    plcrash_regnum_t reg[reg_count];
+    plcrash_async_cfe_entry_register_list(&entry, reg);
+
+    const plcrash_regnum_t expected_regs[] = {
+        PLCRASH_REG_INVALID, PLCRASH_REG_INVALID,
+        PLCRASH_ARM64_X28, PLCRASH_ARM64_X27,
+        PLCRASH_ARM64_X20, PLCRASH_ARM64_X19
+    };
+    for (uint32_t i = 0; i < reg_count; i++) {
+        STAssertEquals(reg[i], expected_regs[i], @"Incorrect register value extracted for position %" PRId32, i);
+    }
+
+    plcrash_async_cfe_entry_free(&entry);
+}
+
+/**
+ * Decode an ARM64 'frameless' encoding.
+ */
+- (void) testARM64DecodeFrameless {
+    const uint32_t encoded_stack_size = 48;
+    uint32_t encoding = UNWIND_ARM64_MODE_FRAMELESS |
+        INSERT_BITS(encoded_stack_size/16, UNWIND_ARM64_FRAMELESS_STACK_SIZE_MASK) |
+        UNWIND_ARM64_FRAME_X21_X22_PAIR;
+
+    plcrash_async_cfe_entry_t entry;
+    plcrash_error_t res = plcrash_async_cfe_entry_init(&entry, CPU_TYPE_ARM64, encoding);
+    STAssertEquals(res, PLCRASH_ESUCCESS, @"Failed to decode entry");
+    STAssertEquals(PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAMELESS_IMMD, plcrash_async_cfe_entry_type(&entry), @"Incorrect entry type");
+
+    uint32_t stack_size = plcrash_async_cfe_entry_stack_offset(&entry);
+    uint32_t reg_count = plcrash_async_cfe_entry_register_count(&entry);
+    STAssertEquals(stack_size, encoded_stack_size, @"Incorrect stack size decoded");
+    STAssertEquals(reg_count, (uint32_t) 2, @"Incorrect register count decoded");
+
+    plcrash_regnum_t reg[reg_count];
+    plcrash_async_cfe_entry_register_list(&entry, reg);
+    STAssertEquals(reg[0], (plcrash_regnum_t) PLCRASH_ARM64_X22, @"Incorrect register value extracted for position 0");
+    STAssertEquals(reg[1], (plcrash_regnum_t) PLCRASH_ARM64_X21, @"Incorrect register value extracted for position 1");
+
+    plcrash_async_cfe_entry_free(&entry);
+}
+
+/**
+ * Decode an ARM64 DWARF encoding.
+ */
+- (void) testARM64DecodeDWARF {
+    const uint32_t encoded_dwarf_offset = 1016;
+    uint32_t encoding = UNWIND_ARM64_MODE_DWARF |
+        INSERT_BITS(encoded_dwarf_offset, UNWIND_ARM64_DWARF_SECTION_OFFSET);
+
+    plcrash_async_cfe_entry_t entry;
+    plcrash_error_t res = plcrash_async_cfe_entry_init(&entry, CPU_TYPE_ARM64, encoding);
+    STAssertEquals(res, PLCRASH_ESUCCESS, @"Failed to decode entry");
+    STAssertEquals(PLCRASH_ASYNC_CFE_ENTRY_TYPE_DWARF, plcrash_async_cfe_entry_type(&entry), @"Incorrect entry type");
+
+    uint32_t dwarf_offset = plcrash_async_cfe_entry_stack_offset(&entry);
+    STAssertEquals(dwarf_offset, encoded_dwarf_offset, @"Incorrect dwarf offset decoded");
+
+    plcrash_async_cfe_entry_free(&entry);
+}
+
 /**
  * Test decoding of a single non-zero permuted register.
  *
@@ -620,6 +701,35 @@
 #undef PL_EXBIT
 }
 
+/**
+ * Verify that the table-driven register decoding matches the reference implementation for all supported
+ * (count, permutation) pairs, and rejects out-of-range permutations.
+ */
+- (void) testPermutedRegisterLookupTables {
+    /* The number of valid permutations for each register count, as determined by the encoding's positional factors */
+    const uint32_t permutation_counts[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX+1] = { 0, 6, 30, 120, 360, 720, 720 };
+
+    for (uint32_t count = 1; count <= PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX; count++) {
+        for (uint32_t permutation = 0; permutation < permutation_counts[count]; permutation++) {
+            uint32_t expected[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX];
+            uint32_t actual[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX];
+
+            plcrash_async_cfe_register_decode(permutation, count, expected);
+            STAssertTrue(plcrash_async_cfe_register_lookup(permutation, count, actual), @"Lookup failed for count %" PRIu32 ", permutation %" PRIu32, count, permutation);
+
+            for (uint32_t i = 0; i < count; i++)
+                STAssertEquals(actual[i], expected[i], @"Incorrect register for count %" PRIu32 ", permutation %" PRIu32 ", position %" PRIu32, count, permutation, i);
+        }
+
+        uint32_t regs[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX];
+        STAssertFalse(plcrash_async_cfe_register_lookup(permutation_counts[count], count, regs), @"Out-of-range permutation accepted for count %" PRIu32, count);
+    }
+
+    uint32_t regs[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX+1];
+    STAssertTrue(plcrash_async_cfe_register_lookup(0, 0, regs), @"Empty register list rejected");
+    STAssertFalse(plcrash_async_cfe_register_lookup(0, PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX+1, regs), @"Invalid register count accepted");
+}
+
 /**
  * Test reading of a PC, compressed, with a common encoding.
  */
@@ -648,6 +758,84 @@
     STAssertEquals(encoding, (uint32_t)PC_COMPACT_PRIVATE_ENCODING, @"Incorrect encoding returned");
 }
 
+/**
+ * Test that a compressed entry's function range ends at the following compressed entry.
+ */
+- (void) testReadCompressedEncodingRange {
+    pl_vm_address_t function_base;
+    pl_vm_address_t function_end;
+    plcrash_error_t err;
+
+    uint32_t encoding;
+    err = plcrash_async_cfe_reader_find_pc_range(&_reader, PC_COMPACT_COMMON, &function_base, &function_end, &encoding);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to locate CFE entry");
+    STAssertEquals(function_base, (pl_vm_address_t)PC_COMPACT_COMMON, @"Incorrect function base returned");
+    STAssertEquals(function_end, (pl_vm_address_t)PC_COMPACT_PRIVATE, @"Incorrect function end returned");
+    STAssertEquals(encoding, (uint32_t)PC_COMPACT_COMMON_ENCODING, @"Incorrect encoding returned");
+}
+
+/**
+ * Test that entries decoded via the reader's entry cache match directly decoded entries, including on a cache hit.
+ */
+- (void) testReaderEntryCache {
+    plcrash_async_cfe_entry_t direct;
+    plcrash_async_cfe_entry_t cached;
+    pl_vm_address_t function_base;
+    uint32_t encoding;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_cfe_reader_find_pc(&_reader, PC_COMPACT_PRIVATE, &function_base, &encoding), @"Failed to locate CFE entry");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_cfe_entry_init(&direct, _reader.cpu_type, encoding), @"Failed to decode entry");
+
+    STAssertEquals(_reader.entry_cache_valid, (uint32_t) 0, @"Newly initialized reader should not have cached entries");
+    for (int i = 0; i < 2; i++) {
+        memset(&cached, 0xFF, sizeof(cached));
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_cfe_reader_entry_init(&_reader, encoding, &cached), @"Failed to decode entry");
+        STAssertTrue(_reader.entry_cache_valid != 0, @"Decoded entry was not cached");
+
+        STAssertEquals(plcrash_async_cfe_entry_type(&cached), plcrash_async_cfe_entry_type(&direct), @"Incorrect entry type");
+        STAssertEquals(plcrash_async_cfe_entry_stack_offset(&cached), plcrash_async_cfe_entry_stack_offset(&direct), @"Incorrect stack offset");
+        STAssertEquals(plcrash_async_cfe_entry_register_count(&cached), plcrash_async_cfe_entry_register_count(&direct), @"Incorrect register count");
+
+        plcrash_async_cfe_entry_free(&cached);
+    }
+
+    plcrash_async_cfe_entry_free(&direct);
+}
+
+/**
+ * Test that lookups performed against an image's validated first-level index match lookups against the
+ * section's own index.
+ */
+- (void) testReadWithImageIndex {
+    pl_vm_address_t function_base;
+    uint32_t encoding;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_cfe_build_index(&_image), @"Failed to build CFE index");
+    STAssertNotNULL(_image.cfe_index, @"Index was not attached to the image");
+    STAssertTrue(_image.cfe_index->count > 0, @"Index contains no entries");
+    for (uint32_t i = 1; i < _image.cfe_index->count; i++)
+        STAssertTrue(_image.cfe_index->entries[i - 1].function_offset <= _image.cfe_index->entries[i].function_offset, @"Index is not sorted");
+
+    /* Rebuilding is a no-op */
+    plcrash_async_macho_cfe_index_t *index = _image.cfe_index;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_cfe_build_index(&_image), @"Failed to rebuild CFE index");
+    STAssertEquals(index, _image.cfe_index, @"Index was replaced");
+
+    plcrash_async_cfe_reader_set_index(&_reader, _image.cfe_index);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_cfe_reader_find_pc(&_reader, PC_REGULAR, &function_base, &encoding), @"Failed to locate CFE entry");
+    STAssertEquals(function_base, (pl_vm_address_t)PC_REGULAR, @"Incorrect function base returned");
+    STAssertEquals(encoding, (uint32_t)PC_REGULAR_ENCODING, @"Incorrect encoding returned");
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_cfe_reader_find_pc(&_reader, PC_COMPACT_COMMON, &function_base, &encoding), @"Failed to locate CFE entry");
+    STAssertEquals(function_base, (pl_vm_address_t)PC_COMPACT_COMMON, @"Incorrect function base returned");
+    STAssertEquals(encoding, (uint32_t)PC_COMPACT_COMMON_ENCODING, @"Incorrect encoding returned");
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_cfe_reader_find_pc(&_reader, PC_COMPACT_PRIVATE, &function_base, &encoding), @"Failed to locate CFE entry");
+    STAssertEquals(function_base, (pl_vm_address_t)PC_COMPACT_PRIVATE, @"Incorrect function base returned");
+    STAssertEquals(encoding, (uint32_t)PC_COMPACT_PRIVATE_ENCODING, @"Incorrect encoding returned");
+}
+
 /**
  * Test reading of a PC, regular, with a common encoding.
  */
@@ -662,6 +850,42 @@
     STAssertEquals(encoding, (uint32_t)PC_REGULAR_ENCODING, @"Incorrect encoding returned");
 }
 
+/**
+ * Test that repeated lookups against the memoized second-level page return the same results as
+ * a full first-level lookup, including when alternating between pages.
+ */
+- (void) testReadMemoizedPage {
+    pl_vm_address_t function_base;
+    plcrash_error_t err;
+    uint32_t encoding;
+
+    STAssertFalse(_reader.page_valid, @"Newly initialized reader should not have a memoized page");
+
+    /* Populate the memo */
+    err = plcrash_async_cfe_reader_find_pc(&_reader, PC_COMPACT_COMMON, &function_base, &encoding);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to locate CFE entry");
+    STAssertTrue(_reader.page_valid, @"Lookup did not memoize the second-level page");
+    STAssertTrue(_reader.page_start <= PC_COMPACT_COMMON, @"Memoized page does not cover the PC");
+
+    /* Repeat lookups, alternating between the compressed and regular entries */
+    for (int i = 0; i < 2; i++) {
+        err = plcrash_async_cfe_reader_find_pc(&_reader, PC_COMPACT_PRIVATE, &function_base, &encoding);
+        STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to locate CFE entry");
+        STAssertEquals(function_base, (pl_vm_address_t)PC_COMPACT_PRIVATE, @"Incorrect function base returned");
+        STAssertEquals(encoding, (uint32_t)PC_COMPACT_PRIVATE_ENCODING, @"Incorrect encoding returned");
+
+        err = plcrash_async_cfe_reader_find_pc(&_reader, PC_REGULAR, &function_base, &encoding);
+        STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to locate CFE entry");
+        STAssertEquals(function_base, (pl_vm_address_t)PC_REGULAR, @"Incorrect function base returned");
+        STAssertEquals(encoding, (uint32_t)PC_REGULAR_ENCODING, @"Incorrect encoding returned");
+
+        err = plcrash_async_cfe_reader_find_pc(&_reader, PC_COMPACT_COMMON, &function_base, &encoding);
+        STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to locate CFE entry");
+        STAssertEquals(function_base, (pl_vm_address_t)PC_COMPACT_COMMON, @"Incorrect function base returned");
+        STAssertEquals(encoding, (uint32_t)PC_COMPACT_COMMON_ENCODING, @"Incorrect encoding returned");
+    }
+}
+
 
 /*
  * CFE is only supported on x86/x86-64, and the iOS SDK does not provide the thread state APIs necessary
@@ -707,7 +931,7 @@
 
     /* Apply! */
     plcrash_async_thread_state_t nts;
-    plcrash_error_t err = plcrash_async_cfe_entry_apply(mach_task_self(), 0x0, &ts, &entry, &nts);
+    plcrash_error_t err = plcrash_async_cfe_entry_apply(mach_task_self(), NULL, 0x0, &ts, &entry, &nts);
     STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to apply state to thread");
     
     /* Verify! */
@@ -769,7 +993,7 @@
     
     /* Apply! */
     plcrash_async_thread_state_t nts;
-    plcrash_error_t err = plcrash_async_cfe_entry_apply(mach_task_self(), 0x0, &ts, &entry, &nts);
+    plcrash_error_t err = plcrash_async_cfe_entry_apply(mach_task_self(), NULL, 0x0, &ts, &entry, &nts);
     STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to apply state to thread");
     
     /* Verify! */
@@ -829,7 +1053,7 @@
 
     /* Apply */
     plcrash_async_thread_state_t nts;
-    plcrash_error_t err = plcrash_async_cfe_entry_apply(mach_task_self(), 0x0, &ts, &entry, &nts);
+    plcrash_error_t err = plcrash_async_cfe_entry_apply(mach_task_self(), NULL, 0x0, &ts, &entry, &nts);
     STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to apply state to thread");
     
     /* Verify */
@@ -896,7 +1120,7 @@
     
     /* Apply */
     plcrash_async_thread_state_t nts;
-    plcrash_error_t err = plcrash_async_cfe_entry_apply(mach_task_self(), function_address, &ts, &entry, &nts);
+    plcrash_error_t err = plcrash_async_cfe_entry_apply(mach_task_self(), NULL, function_address, &ts, &entry, &nts);
     STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to apply state to thread");
     
     /* Verify */
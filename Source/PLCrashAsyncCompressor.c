@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncCompressor.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_async_compressor
+ * @{
+ */
+
+/** The minimum match length supported by the LZ4 block format. */
+#define MIN_MATCH 4
+
+/** The LZ4 block format requires that the last LAST_LITERALS bytes of a block be encoded as literals. */
+#define LAST_LITERALS 5
+
+/** The LZ4 block format requires that the last match start at least MATCH_LIMIT bytes before the end of a block. */
+#define MATCH_LIMIT 12
+
+/** The maximum match offset representable in the LZ4 block format. */
+#define MAX_OFFSET 0xFFFF
+
+/** Flag set in a block's length word if the block is stored uncompressed. */
+#define BLOCK_STORED_FLAG 0x80000000U
+
+/* Positions are stored as uint16_t values in the hash table */
+#if PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE > UINT16_MAX + 1
+#error The compressor block size must not exceed the range of the hash table position values
+#endif
+
+static inline uint32_t read_u32 (const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void write_u32 (uint8_t *p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+static inline uint32_t hash_u32 (uint32_t v) {
+    return (v * 2654435761U) >> (32 - PLCRASH_ASYNC_COMPRESSOR_HASH_LOG);
+}
+
+/**
+ * Write an LZ4 extended length value. Returns false if @a dst_end would be exceeded.
+ */
+static inline bool write_length (uint8_t **op, const uint8_t *dst_end, size_t len) {
+    while (len >= 255) {
+        if (*op >= dst_end)
+            return false;
+        *(*op)++ = 255;
+        len -= 255;
+    }
+
+    if (*op >= dst_end)
+        return false;
+    *(*op)++ = (uint8_t) len;
+    return true;
+}
+
+/**
+ * Write a single LZ4 sequence. If @a match_len is 0, only the literals are written; this is used to terminate
+ * the block. Returns false if @a dst_end would be exceeded.
+ */
+static bool write_sequence (uint8_t **op, const uint8_t *dst_end, const uint8_t *literals, size_t literal_len, uint16_t offset, size_t match_len) {
+    if (*op >= dst_end)
+        return false;
+
+    uint8_t *token = (*op)++;
+    *token = 0;
+
+    /* Literal length and data */
+    if (literal_len >= 15) {
+        *token = 15 << 4;
+        if (!write_length(op, dst_end, literal_len - 15))
+            return false;
+    } else {
+        *token = (uint8_t) (literal_len << 4);
+    }
+
+    if ((size_t) (dst_end - *op) < literal_len)
+        return false;
+    plcrash_async_memcpy(*op, literals, literal_len);
+    *op += literal_len;
+
+    if (match_len == 0)
+        return true;
+
+    /* Match offset and length */
+    if (dst_end - *op < 2)
+        return false;
+    *(*op)++ = offset & 0xFF;
+    *(*op)++ = offset >> 8;
+
+    size_t ml = match_len - MIN_MATCH;
+    if (ml >= 15) {
+        *token |= 15;
+        if (!write_length(op, dst_end, ml - 15))
+            return false;
+    } else {
+        *token |= (uint8_t) ml;
+    }
+
+    return true;
+}
+
+/**
+ * Compress @a len bytes from @a src into @a dst using the LZ4 block format, writing no more than @a dst_size bytes.
+ *
+ * @return Returns the compressed size, or 0 if the compressed data would not fit within @a dst_size bytes.
+ */
+static size_t compress_block (uint16_t *table, const uint8_t *src, size_t len, uint8_t *dst, size_t dst_size) {
+    const uint8_t *dst_end = dst + dst_size;
+    uint8_t *op = dst;
+    size_t anchor = 0;
+    size_t ip = 0;
+
+    plcrash_async_memset(table, 0, sizeof(uint16_t) << PLCRASH_ASYNC_COMPRESSOR_HASH_LOG);
+
+    /* Blocks too short to contain a match are encoded as literals. */
+    if (len >= MATCH_LIMIT + 1) {
+        size_t match_limit = len - MATCH_LIMIT;
+
+        while (ip < match_limit) {
+            uint32_t seq = read_u32(src + ip);
+            uint32_t h = hash_u32(seq);
+            size_t ref = table[h];
+            table[h] = (uint16_t) ip;
+
+            /* The table may hold a stale or zero-initialized position; verify the match */
+            if (ref >= ip || ip - ref > MAX_OFFSET || read_u32(src + ref) != seq) {
+                ip++;
+                continue;
+            }
+
+            /* Extend the match, leaving the trailing literals in place */
+            size_t match_len = MIN_MATCH;
+            while (ip + match_len < len - LAST_LITERALS && src[ref + match_len] == src[ip + match_len])
+                match_len++;
+
+            if (!write_sequence(&op, dst_end, src + anchor, ip - anchor, (uint16_t) (ip - ref), match_len))
+                return 0;
+
+            ip += match_len;
+            anchor = ip;
+        }
+    }
+
+    /* Trailing literals */
+    if (!write_sequence(&op, dst_end, src + anchor, len - anchor, 0, 0))
+        return 0;
+
+    return op - dst;
+}
+
+/**
+ * Reset @a compressor, discarding any pending input.
+ *
+ * @param compressor The compressor to reset.
+ */
+void plcrash_async_compressor_reset (plcrash_async_compressor_t *compressor) {
+    compressor->input_len = 0;
+}
+
+/**
+ * Append up to @a len bytes from @a data to the compressor's pending input block.
+ *
+ * @param compressor The compressor.
+ * @param data The data to be buffered.
+ * @param len The number of bytes available in @a data.
+ *
+ * @return Returns the number of bytes consumed. If less than @a len, the pending block is full and must be
+ * encoded via plcrash_async_compressor_encode_block() before further data may be buffered.
+ */
+size_t plcrash_async_compressor_buffer (plcrash_async_compressor_t *compressor, const void *data, size_t len) {
+    size_t avail = sizeof(compressor->input) - compressor->input_len;
+    if (len > avail)
+        len = avail;
+
+    plcrash_async_memcpy(compressor->input + compressor->input_len, data, len);
+    compressor->input_len += len;
+    return len;
+}
+
+/**
+ * Encode all pending input as a single block, including the block header, into the compressor's output buffer.
+ * The pending input is discarded.
+ *
+ * @param compressor The compressor.
+ *
+ * @return Returns the number of bytes written to @a compressor->output, or 0 if no input was pending.
+ */
+size_t plcrash_async_compressor_encode_block (plcrash_async_compressor_t *compressor) {
+    size_t raw_len = compressor->input_len;
+    if (raw_len == 0)
+        return 0;
+
+    uint8_t *data = compressor->output + PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE;
+
+    /* Fall back on a stored block if compression would not reduce the size */
+    size_t block_len = compress_block(compressor->table, compressor->input, raw_len, data, raw_len - 1);
+    uint32_t len_word;
+    if (block_len == 0) {
+        plcrash_async_memcpy(data, compressor->input, raw_len);
+        block_len = raw_len;
+        len_word = (uint32_t) block_len | BLOCK_STORED_FLAG;
+    } else {
+        len_word = (uint32_t) block_len;
+    }
+
+    write_u32(compressor->output, len_word);
+    write_u32(compressor->output + 4, (uint32_t) raw_len);
+
+    compressor->input_len = 0;
+    return PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE + block_len;
+}
+
+/**
+ * Write the compressed stream header to @a header.
+ *
+ * @param header The destination buffer.
+ *
+ * @return Returns the number of bytes written.
+ */
+size_t plcrash_async_compressor_write_header (uint8_t header[PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1]) {
+    plcrash_async_memcpy(header, PLCRASH_ASYNC_COMPRESSOR_MAGIC, PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE);
+    header[PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE] = PLCRASH_ASYNC_COMPRESSOR_VERSION;
+    return PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1;
+}
+
+/**
+ * Return true if @a data begins with a compressed stream header.
+ *
+ * @param data The data to be checked.
+ * @param length The length of @a data, in bytes.
+ */
+bool plcrash_async_compressor_is_compressed (const void *data, size_t length) {
+    if (length < PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1)
+        return false;
+
+    return memcmp(data, PLCRASH_ASYNC_COMPRESSOR_MAGIC, PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE) == 0;
+}
+
+/**
+ * Decompress a single LZ4 block.
+ *
+ * @return Returns true on success, or false if the block is malformed.
+ */
+static bool decompress_block (const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_len) {
+    const uint8_t *ip = src;
+    const uint8_t *ip_end = src + src_len;
+    uint8_t *op = dst;
+    uint8_t *op_end = dst + dst_len;
+
+    while (ip < ip_end) {
+        uint8_t token = *ip++;
+
+        /* Literals */
+        size_t literal_len = token >> 4;
+        if (literal_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= ip_end)
+                    return false;
+                b = *ip++;
+                literal_len += b;
+            } while (b == 255);
+        }
+
+        if ((size_t) (ip_end - ip) < literal_len || (size_t) (op_end - op) < literal_len)
+            return false;
+        memcpy(op, ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+
+        /* The final sequence contains only literals */
+        if (ip == ip_end)
+            break;
+
+        /* Match */
+        if (ip_end - ip < 2)
+            return false;
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t) (op - dst))
+            return false;
+
+        size_t match_len = token & 0xF;
+        if (match_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= ip_end)
+                    return false;
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += MIN_MATCH;
+
+        if ((size_t) (op_end - op) < match_len)
+            return false;
+
+        /* Matches may overlap the output; copy byte-wise */
+        const uint8_t *ref = op - offset;
+        for (size_t i = 0; i < match_len; i++)
+            op[i] = ref[i];
+        op += match_len;
+    }
+
+    return op == op_end;
+}
+
+/**
+ * Decode a compressed stream. This function is not async-safe.
+ *
+ * If the stream is truncated, all complete blocks are decoded and the trailing partial block is discarded,
+ * allowing recovery of a report that was interrupted while being written.
+ *
+ * @param data The compressed stream, including its header.
+ * @param length The length of @a data, in bytes.
+ * @param output On success, will be set to a malloc-allocated buffer containing the decompressed data. The caller
+ * is responsible for free()ing this buffer.
+ * @param output_length On success, will be set to the length of @a output, in bytes.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if the stream header is invalid or a block is
+ * malformed, or PLCRASH_ENOMEM if allocation fails.
+ */
+plcrash_error_t plcrash_nasync_compressor_decode (const void *data, size_t length, uint8_t **output, size_t *output_length) {
+    const uint8_t *p = data;
+    const uint8_t *end = p + length;
+    uint8_t *result = NULL;
+    size_t result_len = 0;
+    size_t result_cap = 0;
+    plcrash_error_t err;
+
+    if (!plcrash_async_compressor_is_compressed(data, length)) {
+        PLCF_DEBUG("Missing compressed stream header");
+        return PLCRASH_EINVAL;
+    }
+
+    if (p[PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE] != PLCRASH_ASYNC_COMPRESSOR_VERSION) {
+        PLCF_DEBUG("Unsupported compressed stream version %u", p[PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE]);
+        return PLCRASH_EINVAL;
+    }
+    p += PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1;
+
+    while ((size_t) (end - p) >= PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE) {
+        uint32_t len_word = read_u32(p);
+        bool stored = (len_word & BLOCK_STORED_FLAG) != 0;
+        size_t block_len = len_word & ~BLOCK_STORED_FLAG;
+        size_t raw_len = read_u32(p + 4);
+
+        if (raw_len > PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE || (stored && block_len != raw_len)) {
+            PLCF_DEBUG("Invalid compressed block header");
+            err = PLCRASH_EINVAL;
+            goto cleanup;
+        }
+
+        /* A truncated trailing block is discarded */
+        if ((size_t) (end - p) - PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE < block_len) {
+            PLCF_DEBUG("Discarding truncated compressed block");
+            break;
+        }
+        p += PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE;
+
+        /* Grow the output buffer */
+        if (result_cap - result_len < raw_len) {
+            size_t new_cap = result_cap == 0 ? PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE : result_cap * 2;
+            while (new_cap - result_len < raw_len)
+                new_cap *= 2;
+
+            uint8_t *new_result = realloc(result, new_cap);
+            if (new_result == NULL) {
+                err = PLCRASH_ENOMEM;
+                goto cleanup;
+            }
+            result = new_result;
+            result_cap = new_cap;
+        }
+
+        if (stored) {
+            memcpy(result + result_len, p, raw_len);
+        } else if (!decompress_block(p, block_len, result + result_len, raw_len)) {
+            PLCF_DEBUG("Malformed compressed block");
+            err = PLCRASH_EINVAL;
+            goto cleanup;
+        }
+
+        result_len += raw_len;
+        p += block_len;
+    }
+
+    *output = result;
+    *output_length = result_len;
+    return PLCRASH_ESUCCESS;
+
+cleanup:
+    free(result);
+    return err;
+}
+
+/**
+ * @}
+ */
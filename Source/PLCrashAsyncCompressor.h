@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_COMPRESSOR_H
+#define PLCRASH_ASYNC_COMPRESSOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_async_compressor Async-safe Compression
+ * @ingroup plcrash_async
+ *
+ * Implements an async-safe streaming compressor that may be placed between the protobuf encoder and a
+ * plcrash_async_file_t instance.
+ *
+ * Output is split into independently compressed blocks of at most PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE
+ * input bytes, each encoded using the LZ4 block format. All state (including the hash table and the output
+ * buffer) is preallocated as part of the plcrash_async_compressor_t structure; no allocation is performed
+ * while compressing.
+ *
+ * The compressed stream is framed as follows (all integers are little-endian):
+ *
+ * - An 8 byte header, consisting of the 7 byte PLCRASH_ASYNC_COMPRESSOR_MAGIC value followed by the
+ *   PLCRASH_ASYNC_COMPRESSOR_VERSION byte.
+ * - Zero or more blocks, each consisting of:
+ *   - A uint32_t block length. The high bit is set if the block data is stored uncompressed.
+ *   - A uint32_t decompressed length.
+ *   - The block data.
+ *
+ * As each block is self-contained, a stream that was truncated while writing may be decoded up to the last
+ * complete block.
+ *
+ * @{
+ */
+
+/** The magic value written at the start of a compressed stream. */
+#define PLCRASH_ASYNC_COMPRESSOR_MAGIC "plcrlz4"
+
+/** The size of PLCRASH_ASYNC_COMPRESSOR_MAGIC, in bytes, excluding the trailing NUL. */
+#define PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE 7
+
+/** The compressed stream format version. */
+#define PLCRASH_ASYNC_COMPRESSOR_VERSION 1
+
+/** The maximum number of input bytes compressed into a single block. */
+#define PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE (64 * 1024)
+
+/** The size of a block header, in bytes. */
+#define PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE 8
+
+/** The size of the block hash table, as a power of two. */
+#define PLCRASH_ASYNC_COMPRESSOR_HASH_LOG 12
+
+/**
+ * The maximum size of a compressed block (including its header); an incompressible block is
+ * stored uncompressed, and can not exceed this size.
+ */
+#define PLCRASH_ASYNC_COMPRESSOR_MAX_BLOCK_SIZE (PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE + PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE)
+
+/**
+ * @internal
+ *
+ * Async-safe streaming compressor state.
+ */
+typedef struct plcrash_async_compressor {
+    /** The number of input bytes pending in @a input. */
+    size_t input_len;
+
+    /** Pending input, compressed once full or when the owning file is flushed. */
+    uint8_t input[PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE];
+
+    /** The encoded output block, including its header. */
+    uint8_t output[PLCRASH_ASYNC_COMPRESSOR_MAX_BLOCK_SIZE];
+
+    /** Match-finding hash table, mapping 4 byte sequences to their last position in @a input. */
+    uint16_t table[1 << PLCRASH_ASYNC_COMPRESSOR_HASH_LOG];
+} plcrash_async_compressor_t;
+
+void plcrash_async_compressor_reset (plcrash_async_compressor_t *compressor);
+size_t plcrash_async_compressor_buffer (plcrash_async_compressor_t *compressor, const void *data, size_t len);
+size_t plcrash_async_compressor_encode_block (plcrash_async_compressor_t *compressor);
+
+size_t plcrash_async_compressor_write_header (uint8_t header[PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1]);
+bool plcrash_async_compressor_is_compressed (const void *data, size_t length);
+
+plcrash_error_t plcrash_nasync_compressor_decode (const void *data, size_t length, uint8_t **output, size_t *output_length);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_COMPRESSOR_H */
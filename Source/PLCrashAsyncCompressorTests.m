@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashAsyncCompressor.h"
+
+#import <fcntl.h>
+
+@interface PLCrashAsyncCompressorTests : SenTestCase {
+@private
+    /** Compressor state. */
+    plcrash_async_compressor_t *_compressor;
+
+    /** Output path. */
+    NSString *_path;
+}
+@end
+
+@implementation PLCrashAsyncCompressorTests
+
+- (void) setUp {
+    _compressor = malloc(sizeof(*_compressor));
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _path error: NULL];
+    [_path release];
+    free(_compressor);
+}
+
+/**
+ * Compress @a input via a plcrash_async_file_t in chunks of @a chunk bytes, returning the compressed output.
+ */
+- (NSData *) compress: (NSData *) input chunkSize: (size_t) chunk {
+    plcrash_async_file_t file;
+
+    int fd = open([_path fileSystemRepresentation], O_RDWR|O_CREAT|O_TRUNC, 0644);
+    STAssertTrue(fd >= 0, @"Could not open output file");
+
+    plcrash_async_file_init(&file, fd, 0);
+    STAssertTrue(plcrash_async_file_set_compressor(&file, _compressor), @"Failed to attach compressor");
+
+    const uint8_t *bytes = [input bytes];
+    for (size_t off = 0; off < [input length]; off += chunk) {
+        size_t len = MIN(chunk, [input length] - off);
+        STAssertTrue(plcrash_async_file_write(&file, bytes + off, len), @"Write failed");
+    }
+
+    STAssertTrue(plcrash_async_file_flush(&file), @"Flush failed");
+    plcrash_async_file_close(&file);
+
+    return [NSData dataWithContentsOfFile: _path];
+}
+
+/**
+ * Decode @a data, returning nil on failure.
+ */
+- (NSData *) decompress: (NSData *) data {
+    uint8_t *output;
+    size_t output_len;
+
+    if (plcrash_nasync_compressor_decode([data bytes], [data length], &output, &output_len) != PLCRASH_ESUCCESS)
+        return nil;
+
+    return [NSData dataWithBytesNoCopy: output length: output_len freeWhenDone: YES];
+}
+
+/**
+ * Test round-tripping of compressible data spanning multiple blocks.
+ */
+- (void) testRoundTripCompressible {
+    NSMutableData *input = [NSMutableData data];
+    for (int i = 0; i < 20000; i++)
+        [input appendData: [[NSString stringWithFormat: @"frame %d: -[NSObject performSelector:] + %d\n", i % 64, i % 7] dataUsingEncoding: NSUTF8StringEncoding]];
+
+    NSData *compressed = [self compress: input chunkSize: 1000];
+    STAssertTrue(plcrash_async_compressor_is_compressed([compressed bytes], [compressed length]), @"Missing stream header");
+    STAssertTrue([compressed length] < [input length] / 4, @"Data was not compressed: %lu bytes", (unsigned long) [compressed length]);
+
+    STAssertEqualObjects(input, [self decompress: compressed], @"Round-tripped data does not match");
+}
+
+/**
+ * Test round-tripping of incompressible data, which must be written as stored blocks.
+ */
+- (void) testRoundTripIncompressible {
+    NSMutableData *input = [NSMutableData dataWithLength: PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE * 2 + 17];
+    uint8_t *bytes = [input mutableBytes];
+    for (size_t i = 0; i < [input length]; i++)
+        bytes[i] = arc4random() & 0xFF;
+
+    NSData *compressed = [self compress: input chunkSize: 4096];
+    STAssertTrue([compressed length] <= [input length] + (PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1) + 3 * PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE,
+                 @"Incompressible data was expanded beyond the framing overhead");
+
+    STAssertEqualObjects(input, [self decompress: compressed], @"Round-tripped data does not match");
+}
+
+/**
+ * Test that a truncated stream is decoded up to the last complete block.
+ */
+- (void) testTruncatedStream {
+    NSMutableData *input = [NSMutableData dataWithLength: PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE + 100];
+    memset([input mutableBytes], 'A', [input length]);
+
+    NSData *compressed = [self compress: input chunkSize: [input length]];
+    NSData *truncated = [compressed subdataWithRange: NSMakeRange(0, [compressed length] - 1)];
+
+    NSData *decoded = [self decompress: truncated];
+    STAssertNotNil(decoded, @"Failed to decode truncated stream");
+    STAssertEquals((NSUInteger) PLCRASH_ASYNC_COMPRESSOR_BLOCK_SIZE, [decoded length], @"Incorrect number of bytes recovered");
+}
+
+/**
+ * Test rejection of malformed block data.
+ */
+- (void) testMalformedStream {
+    NSMutableData *input = [NSMutableData dataWithLength: 4096];
+    memset([input mutableBytes], 'A', [input length]);
+
+    NSMutableData *compressed = [[[self compress: input chunkSize: [input length]] mutableCopy] autorelease];
+
+    /* Corrupt the first match offset, which follows the block header, token, and single literal */
+    uint8_t *bytes = [compressed mutableBytes];
+    size_t offset_pos = PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1 + PLCRASH_ASYNC_COMPRESSOR_BLOCK_HEADER_SIZE + 2;
+    bytes[offset_pos] = 0xFF;
+    bytes[offset_pos + 1] = 0xFF;
+
+    STAssertNil([self decompress: compressed], @"Malformed stream was accepted");
+}
+
+@end
@@ -40,8 +40,11 @@ using namespace plcrash::async;
  */
 
 /**
- * Push a state onto the state stack; all existing values will be saved on the stack, and registers
- * will be set to their default state.
+ * Push a state onto the state stack; all existing values will be saved on the stack, and remain in force in the new
+ * state until modified.
+ *
+ * The new state inherits the current CFA rule and register rules without copying them; only subsequent changes are
+ * recorded in the new state.
  *
  * @return Returns true on success, or false if insufficient space is available on the state
  * stack.
@@ -54,8 +57,10 @@ bool dwarf_cfa_state<machine_ptr, machine_ptr_s>::push_state (void) {
         return false;
     
     _table_depth++;
-    _register_count[_table_depth] = 0;
-    _cfa_value[_table_depth].set_undefined_rule();
+    _register_count[_table_depth] = _register_count[_table_depth-1];
+    _cfa_value[_table_depth] = _cfa_value[_table_depth-1];
+    _dense[_table_depth].defined = 0;
+    _dense[_table_depth].removed = 0;
 
     plcrash_async_memset(_table_stack[_table_depth], DWARF_CFA_STATE_INVALID_ENTRY_IDX, sizeof(_table_stack[0]));
     
@@ -63,8 +68,12 @@ bool dwarf_cfa_state<machine_ptr, machine_ptr_s>::push_state (void) {
 }
 
 /**
- * Pop a previously saved state from the state stack. All existing values will be discarded on the stack, and registers
- * will be reinitialized from the saved state.
+ * Pop a previously saved state from the state stack. All changes made since the matching push_state() are discarded,
+ * restoring the saved state.
+ *
+ * The discarded state's sparse register entries are returned to the shared entry pool; the cost of a pop scales
+ * with the number of sparse registers set or removed since the matching push_state(), and repeated push/pop pairs do
+ * not exhaust the pool.
  *
  * @return Returns true on success, or false if no states are available on the state stack.
  */
@@ -72,6 +81,19 @@ template <typename machine_ptr, typename machine_ptr_s>
 bool dwarf_cfa_state<machine_ptr, machine_ptr_s>::pop_state (void) {
     if (_table_depth == 0)
         return false;
+
+    /* Release the discarded state's sparse entries */
+    for (uint8_t bucket = 0; bucket < DWARF_CFA_STATE_BUCKET_COUNT; bucket++) {
+        uint8_t entry_idx = _table_stack[_table_depth][bucket];
+        while (entry_idx != DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
+            dwarf_cfa_reg_entry_t *entry = &_entries[entry_idx];
+            uint8_t next = entry->next;
+
+            entry->next = _free_list;
+            _free_list = entry_idx;
+            entry_idx = next;
+        }
+    }
     
     _table_depth--;
     return true;
@@ -83,20 +105,26 @@ bool dwarf_cfa_state<machine_ptr, machine_ptr_s>::pop_state (void) {
 template <typename machine_ptr, typename machine_ptr_s>
 dwarf_cfa_state<machine_ptr, machine_ptr_s>::dwarf_cfa_state (void) {
     /* The size must be smaller than the invalid entry index, which is used as a NULL flag */
-    PLCF_ASSERT_STATIC(max_size, DWARF_CFA_STATE_MAX_REGISTERS < DWARF_CFA_STATE_INVALID_ENTRY_IDX);
+    PLCF_ASSERT_STATIC(max_size, DWARF_CFA_STATE_SPARSE_REGISTERS < DWARF_CFA_STATE_INVALID_ENTRY_IDX);
+
+    /* The dense registers must be representable in the dense row bitmap */
+    PLCF_ASSERT_STATIC(dense_size, DWARF_CFA_STATE_DENSE_REGISTERS <= sizeof(_dense[0].defined) * 8);
+    PLCF_ASSERT_STATIC(sparse_size, DWARF_CFA_STATE_SPARSE_REGISTERS > 0);
     
     /* Initialize the free list */
-    for (uint8_t i = 0; i < DWARF_CFA_STATE_MAX_REGISTERS; i++)
+    for (uint8_t i = 0; i < DWARF_CFA_STATE_SPARSE_REGISTERS; i++)
         _entries[i].next = i+1;
     
     /* Set the terminator flag on the last entry */
-    _entries[DWARF_CFA_STATE_MAX_REGISTERS-1].next = DWARF_CFA_STATE_INVALID_ENTRY_IDX;
+    _entries[DWARF_CFA_STATE_SPARSE_REGISTERS-1].next = DWARF_CFA_STATE_INVALID_ENTRY_IDX;
     
     /* First free entry is _entries[0] */
     _free_list = 0;
     
     /* Initial register count */
     _register_count[0] = 0;
+    _dense[0].defined = 0;
+    _dense[0].removed = 0;
     
     /* Set up the table */
     _table_depth = 0;
@@ -106,6 +134,38 @@ dwarf_cfa_state<machine_ptr, machine_ptr_s>::dwarf_cfa_state (void) {
     _cfa_value[0].set_undefined_rule();
 }
 
+/**
+ * @internal
+ *
+ * Return the sparse entry for @a regnum recorded in the state at @a depth, including removal entries, or NULL if
+ * the state does not record @a regnum.
+ */
+template <typename machine_ptr, typename machine_ptr_s>
+typename dwarf_cfa_state<machine_ptr, machine_ptr_s>::dwarf_cfa_reg_entry_t *dwarf_cfa_state<machine_ptr, machine_ptr_s>::find_entry (uint8_t depth, dwarf_cfa_state_regnum_t regnum) {
+    unsigned int bucket = regnum % (sizeof(_table_stack[0]) / sizeof(_table_stack[0][0]));
+
+    for (uint8_t entry_idx = _table_stack[depth][bucket]; entry_idx != DWARF_CFA_STATE_INVALID_ENTRY_IDX; entry_idx = _entries[entry_idx].next) {
+        if (_entries[entry_idx].regnum == regnum)
+            return &_entries[entry_idx];
+    }
+
+    return NULL;
+}
+
+/**
+ * @internal
+ *
+ * Return the bitmap of densely stored registers with a rule defined in the current state, including inherited rules.
+ */
+template <typename machine_ptr, typename machine_ptr_s>
+uint32_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::dense_defined (void) {
+    uint32_t defined = 0;
+    for (uint8_t depth = 0; depth <= _table_depth; depth++)
+        defined = (defined & ~_dense[depth].removed) | _dense[depth].defined;
+
+    return defined;
+}
+
 /**
  * Add a new register.
  *
@@ -115,61 +175,59 @@ dwarf_cfa_state<machine_ptr, machine_ptr_s>::dwarf_cfa_state (void) {
  */
 template <typename machine_ptr, typename machine_ptr_s>
 bool dwarf_cfa_state<machine_ptr, machine_ptr_s>::set_register (dwarf_cfa_state_regnum_t regnum, plcrash_dwarf_cfa_reg_rule_t rule, machine_ptr value) {
-    PLCF_ASSERT(rule <= UINT8_MAX);
-    
-    /* Check for an existing entry, or find the target entry off which we'll chain our entry */
-    unsigned int bucket = regnum % (sizeof(_table_stack[0]) / sizeof(_table_stack[0][0]));
-    
-    dwarf_cfa_reg_entry_t *parent = NULL;
-    for (uint8_t parent_idx = _table_stack[_table_depth][bucket]; parent_idx != DWARF_CFA_STATE_INVALID_ENTRY_IDX; parent_idx = parent->next) {
-        parent = &_entries[parent_idx];
-        
-        /* If an existing entry is found, we can re-use it directly */
-        if (parent->regnum == regnum) {
-            parent->value = value;
-            parent->rule = rule;
-            return true;
-        }
-        
-        /* Otherwise, make sure we terminate with parent == last element */
-        if (parent->next == DWARF_CFA_STATE_INVALID_ENTRY_IDX)
-            break;
+    PLCF_ASSERT(rule < DWARF_CFA_STATE_REMOVED_RULE);
+
+    plcrash_dwarf_cfa_reg_rule_t existing_rule;
+    machine_ptr existing_value;
+    bool existing = get_register_rule(regnum, &existing_rule, &existing_value);
+
+    /* Handle densely stored registers */
+    if (regnum < DWARF_CFA_STATE_DENSE_REGISTERS) {
+        dwarf_cfa_dense_row_t *row = &_dense[_table_depth];
+        uint32_t bit = ((uint32_t) 1) << regnum;
+
+        row->defined |= bit;
+        row->removed &= ~bit;
+        row->rules[regnum] = rule;
+        row->values[regnum] = value;
+
+        if (!existing)
+            _register_count[_table_depth]++;
+        return true;
     }
-    
-    /* 'parent' now either points to the end of the list, or is NULL (in which case the table
-     * slot was empty */
-    dwarf_cfa_reg_entry *entry = NULL;
-    uint8_t entry_idx;
-    
-    /* Fetch a free entry */
-    if (_free_list == DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
-        /* No free entries */
-        return false;
+
+    /* If an existing entry is found in the current state, we can re-use it directly */
+    dwarf_cfa_reg_entry_t *entry = find_entry(_table_depth, regnum);
+    if (entry == NULL) {
+        /* Fetch a free entry */
+        if (_free_list == DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
+            /* No free entries */
+            return false;
+        }
+
+        uint8_t entry_idx = _free_list;
+        entry = &_entries[entry_idx];
+        _free_list = entry->next;
+
+        /* Insert at the head of the bucket chain */
+        unsigned int bucket = regnum % (sizeof(_table_stack[0]) / sizeof(_table_stack[0][0]));
+        entry->regnum = regnum;
+        entry->next = _table_stack[_table_depth][bucket];
+        _table_stack[_table_depth][bucket] = entry_idx;
     }
-    entry_idx = _free_list;
-    entry = &_entries[entry_idx];
-    _free_list = entry->next;
-    
-    /* Intialize the entry */
-    entry->regnum = regnum;
+
     entry->rule = rule;
     entry->value = value;
-    entry->next = DWARF_CFA_STATE_INVALID_ENTRY_IDX;
-    
-    /* Either insert in the parent, or insert as the first table element */
-    if (parent == NULL) {
-        _table_stack[_table_depth][bucket] = entry_idx;
-    } else {
-        parent->next = entry - _entries;
-    }
-    
-    _register_count[_table_depth]++;
+
+    if (!existing)
+        _register_count[_table_depth]++;
     return true;
 }
 
 /**
  * Fetch the register entry data for a given DWARF register number, returning
- * true on success, or false if no entry has been added for the register.
+ * true on success, or false if no entry has been added for the register. Rules inherited from saved states are
+ * returned unless they have been removed in the current state.
  *
  * @param regnum The DWARF register number.
  * @param[out] rule On success, the DWARF CFA rule for @a regnum.
@@ -177,21 +235,32 @@ bool dwarf_cfa_state<machine_ptr, machine_ptr_s>::set_register (dwarf_cfa_state_
  */
 template <typename machine_ptr, typename machine_ptr_s>
 bool dwarf_cfa_state<machine_ptr, machine_ptr_s>::get_register_rule (dwarf_cfa_state_regnum_t regnum, plcrash_dwarf_cfa_reg_rule_t *rule, machine_ptr *value) {
-    /* Search for the entry */
-    unsigned int bucket = regnum % (sizeof(_table_stack[0]) / sizeof(_table_stack[0][0]));
-    
-    dwarf_cfa_reg_entry_t *entry = NULL;
-    for (uint8_t entry_idx = _table_stack[_table_depth][bucket]; entry_idx != DWARF_CFA_STATE_INVALID_ENTRY_IDX; entry_idx = entry->next) {
-        entry = &_entries[entry_idx];
-        
-        if (entry->regnum != regnum) {
-            if (entry->next == DWARF_CFA_STATE_INVALID_ENTRY_IDX)
-                break;
-            
+    /* Search from the current state down to the initial state; the first state to record the register wins */
+    for (int depth = _table_depth; depth >= 0; depth--) {
+        /* Handle densely stored registers */
+        if (regnum < DWARF_CFA_STATE_DENSE_REGISTERS) {
+            dwarf_cfa_dense_row_t *row = &_dense[depth];
+            uint32_t bit = ((uint32_t) 1) << regnum;
+
+            if (row->defined & bit) {
+                *value = row->values[regnum];
+                *rule = (plcrash_dwarf_cfa_reg_rule_t) row->rules[regnum];
+                return true;
+            }
+
+            if (row->removed & bit)
+                return false;
+
             continue;
         }
-        
-        /* Existing entry found, we can re-use it directly */
+
+        dwarf_cfa_reg_entry_t *entry = find_entry(depth, regnum);
+        if (entry == NULL)
+            continue;
+
+        if (entry->rule == DWARF_CFA_STATE_REMOVED_RULE)
+            return false;
+
         *value = entry->value;
         *rule = (plcrash_dwarf_cfa_reg_rule_t) entry->rule;
         return true;
@@ -202,13 +271,40 @@ bool dwarf_cfa_state<machine_ptr, machine_ptr_s>::get_register_rule (dwarf_cfa_s
 }
 
 /**
- * Remove a register from the current state.
+ * Remove a register from the current state. A rule inherited from a saved state is hidden until the current state
+ * is popped.
  *
  * @param regnum The DWARF register number to be removed.
  */
 template <typename machine_ptr, typename machine_ptr_s>
 void dwarf_cfa_state<machine_ptr, machine_ptr_s>::remove_register (dwarf_cfa_state_regnum_t regnum) {
-    /* Search for the entry */
+    plcrash_dwarf_cfa_reg_rule_t rule;
+    machine_ptr value;
+    if (!get_register_rule(regnum, &rule, &value))
+        return;
+
+    /* Determine whether a rule would remain visible from the saved states */
+    bool inherited = false;
+    if (_table_depth > 0) {
+        _table_depth--;
+        inherited = get_register_rule(regnum, &rule, &value);
+        _table_depth++;
+    }
+
+    /* Handle densely stored registers */
+    if (regnum < DWARF_CFA_STATE_DENSE_REGISTERS) {
+        dwarf_cfa_dense_row_t *row = &_dense[_table_depth];
+        uint32_t bit = ((uint32_t) 1) << regnum;
+
+        row->defined &= ~bit;
+        if (inherited)
+            row->removed |= bit;
+
+        _register_count[_table_depth]--;
+        return;
+    }
+
+    /* Search for an entry in the current state */
     unsigned int bucket = regnum % (sizeof(_table_stack[0]) / sizeof(_table_stack[0][0]));
     
     dwarf_cfa_reg_entry *prev = NULL;
@@ -219,6 +315,14 @@ void dwarf_cfa_state<machine_ptr, machine_ptr_s>::remove_register (dwarf_cfa_sta
         
         if (entry->regnum != regnum)
             continue;
+
+        _register_count[_table_depth]--;
+
+        /* Hide the inherited rule */
+        if (inherited) {
+            entry->rule = DWARF_CFA_STATE_REMOVED_RULE;
+            return;
+        }
         
         /* Remove from the bucket chain */
         if (prev != NULL) {
@@ -230,10 +334,27 @@ void dwarf_cfa_state<machine_ptr, machine_ptr_s>::remove_register (dwarf_cfa_sta
         /* Re-insert in the free list */
         entry->next = _free_list;
         _free_list = entry_idx;
-        
-        /* Decrement the register count */
-        _register_count[_table_depth]--;
+        return;
     }
+
+    /* The rule is inherited, and must be hidden by a removal entry. If the entry pool is exhausted, the removal can
+     * not be recorded. */
+    if (_free_list == DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
+        PLCF_DEBUG("Could not record the removal of register %u; the entry pool is exhausted", (unsigned int) regnum);
+        return;
+    }
+
+    uint8_t entry_idx = _free_list;
+    entry = &_entries[entry_idx];
+    _free_list = entry->next;
+
+    entry->regnum = regnum;
+    entry->rule = DWARF_CFA_STATE_REMOVED_RULE;
+    entry->value = 0;
+    entry->next = _table_stack[_table_depth][bucket];
+    _table_stack[_table_depth][bucket] = entry_idx;
+
+    _register_count[_table_depth]--;
 }
 
 /**
@@ -295,6 +416,8 @@ dwarf_cfa_rule<machine_ptr, machine_ptr_s> dwarf_cfa_state<machine_ptr, machine_
 template <typename machine_ptr, typename machine_ptr_s>
 dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s>::dwarf_cfa_state_iterator(dwarf_cfa_state<machine_ptr, machine_ptr_s> *stack) {
     _stack = stack;
+    _dense_remaining = stack->dense_defined();
+    _depth = stack->_table_depth;
     _bucket_idx = 0;
     _cur_entry_idx = DWARF_CFA_STATE_INVALID_ENTRY_IDX;
 }
@@ -308,38 +431,66 @@ dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s>::dwarf_cfa_state_iterator(d
  */
 template <typename machine_ptr, typename machine_ptr_s>
 bool dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s>::next (dwarf_cfa_state_regnum_t *regnum, plcrash_dwarf_cfa_reg_rule_t *rule, machine_ptr *value) {
-    /* Fetch the next entry in the bucket chain */
-    if (_cur_entry_idx != DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
-        _cur_entry_idx = _stack->_entries[_cur_entry_idx].next;
-        
-        /* Advance to the next bucket if we've reached the end of the current chain */
-        if (_cur_entry_idx == DWARF_CFA_STATE_INVALID_ENTRY_IDX)
-            _bucket_idx++;
+    /* Enumerate the densely stored registers first, in ascending order */
+    if (_dense_remaining != 0) {
+        uint32_t dense_regnum = __builtin_ctz(_dense_remaining);
+        _dense_remaining &= _dense_remaining - 1;
+
+        *regnum = dense_regnum;
+        return _stack->get_register_rule(dense_regnum, rule, value);
     }
-    
-    /*
-     * On the first iteration, or after the end of a bucket chain has been reached, find the next valid bucket chain.
-     * Otherwise, we have a valid bucket chain and simply need the next entry.
-     */
-    if (_cur_entry_idx == DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
-        for (; _bucket_idx < DWARF_CFA_STATE_BUCKET_COUNT; _bucket_idx++) {
-            if (_stack->_table_stack[_stack->_table_depth][_bucket_idx] != DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
-                _cur_entry_idx = _stack->_table_stack[_stack->_table_depth][_bucket_idx];
-                break;
+
+    /* Enumerate the sparse entries of each state, from the current state down; entries that were removed, or that
+     * are shadowed by an entry in a later state, are skipped. */
+    while (true) {
+        /* Fetch the next entry in the bucket chain */
+        if (_cur_entry_idx != DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
+            _cur_entry_idx = _stack->_entries[_cur_entry_idx].next;
+
+            /* Advance to the next bucket if we've reached the end of the current chain */
+            if (_cur_entry_idx == DWARF_CFA_STATE_INVALID_ENTRY_IDX)
+                _bucket_idx++;
+        }
+
+        /*
+         * On the first iteration, or after the end of a bucket chain has been reached, find the next valid bucket
+         * chain, moving down to the next state once all of the current state's buckets have been enumerated.
+         */
+        while (_cur_entry_idx == DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
+            for (; _bucket_idx < DWARF_CFA_STATE_BUCKET_COUNT; _bucket_idx++) {
+                if (_stack->_table_stack[_depth][_bucket_idx] != DWARF_CFA_STATE_INVALID_ENTRY_IDX) {
+                    _cur_entry_idx = _stack->_table_stack[_depth][_bucket_idx];
+                    break;
+                }
             }
+
+            if (_cur_entry_idx != DWARF_CFA_STATE_INVALID_ENTRY_IDX)
+                break;
+
+            /* If we get here without a valid entry in the initial state, we've hit the end of all bucket chains. */
+            if (_depth == 0)
+                return false;
+
+            _depth--;
+            _bucket_idx = 0;
         }
-        
-        /* If we get here without a valid entry, we've hit the end of all bucket chains. */
-        if (_cur_entry_idx == DWARF_CFA_STATE_INVALID_ENTRY_IDX)
-            return false;
+
+        typename dwarf_cfa_state<machine_ptr, machine_ptr_s>::dwarf_cfa_reg_entry_t *entry = &_stack->_entries[_cur_entry_idx];
+        if (entry->rule == DWARF_CFA_STATE_REMOVED_RULE)
+            continue;
+
+        bool shadowed = false;
+        for (uint8_t depth = _depth + 1; depth <= _stack->_table_depth && !shadowed; depth++)
+            shadowed = (_stack->find_entry(depth, entry->regnum) != NULL);
+
+        if (shadowed)
+            continue;
+
+        *regnum = entry->regnum;
+        *value = entry->value;
+        *rule = (plcrash_dwarf_cfa_reg_rule_t) entry->rule;
+        return true;
     }
-    
-    
-    typename dwarf_cfa_state<machine_ptr, machine_ptr_s>::dwarf_cfa_reg_entry_t *entry = &_stack->_entries[_cur_entry_idx];
-    *regnum = entry->regnum;
-    *value = entry->value;
-    *rule = (plcrash_dwarf_cfa_reg_rule_t) entry->rule;
-    return true;
 }
 
 /* Provide explicit 32/64-bit instantiations */
@@ -50,9 +50,19 @@ namespace plcrash { namespace async {
 /* Maximum DWARF register number supported by dwarf_cfa_state and dwarf_cfa_state_regnum_t. */
 #define DWARF_CFA_STATE_REGNUM_MAX UINT32_MAX
 
-/* Consumes around 1.65k (on 32-bit and 64-bit systems). */
+/* Total number of registers that may be defined in a single state; registers numbered below
+ * DWARF_CFA_STATE_DENSE_REGISTERS are stored densely, and the remainder are allocated from a shared
+ * sparse entry pool. Consumes around 3k on 64-bit systems, and 2.2k on 32-bit systems. */
 #define DWARF_CFA_STATE_MAX_REGISTERS 100
 
+/* Number of low-numbered DWARF registers that are stored densely in each state. This covers the general purpose
+ * register numbering of all supported architectures (x86: 0-8, x86-64: 0-16, ARM: 0-15, ARM64: 0-31). Must
+ * not exceed the width of the dense register bitmap. */
+#define DWARF_CFA_STATE_DENSE_REGISTERS 32
+
+/* Number of entries in the shared sparse entry pool. */
+#define DWARF_CFA_STATE_SPARSE_REGISTERS (DWARF_CFA_STATE_MAX_REGISTERS - DWARF_CFA_STATE_DENSE_REGISTERS)
+
 template <typename machine_ptr, typename machine_ptr_s> class dwarf_cfa_state_iterator;
 
 /** DWARF CFA-defined register number .*/
@@ -234,17 +244,22 @@ public:
 /**
  * @internal
  *
- * Manages CFA register table row, using sparsely allocated register column entries. The class represents
- * a single address-based row within the CFA register table, and supports applying deltas to the row
- * register state as required for evaluation of a CFA opcode stream.
+ * Manages CFA register table row. The class represents a single address-based row within the CFA register
+ * table, and supports applying deltas to the row register state as required for evaluation of a CFA opcode stream.
  *
  * Register numbers are sparsely allocated in the architecture-specific extensions to the DWARF spec,
  * requiring a solution other than allocating arrays large enough to hold the largest possible register number.
  * For example, ARM allocates or has set aside register values up to 8192, with 8192–16383 reserved for additional
  * vendor co-processor allocations.
  *
- * The actual total number of supported, active registers is much smaller. This class is built to decrease the
- * total amount of fixed stack space to be allocated.
+ * In practice, nearly all register rules reference the general purpose registers, which are assigned the lowest
+ * DWARF register numbers on all supported architectures. Registers numbered below DWARF_CFA_STATE_DENSE_REGISTERS
+ * are stored in a dense, per-state array and bitmap; any higher-numbered registers are allocated from a
+ * shared pool of sparse register column entries.
+ *
+ * Saved states (DW_CFA_remember_state) are stored as deltas: a pushed state inherits the CFA rule and all register
+ * rules of the state below it, and records only the rules set or removed after the push. Register lookups fall
+ * through to the lower states until a rule, or a removal, is found; popping a state discards its deltas.
  *
  * @todo If we introduce our own async-safe heap allocator, it may be preferrable to use the heap for entries.
  */
@@ -256,6 +271,10 @@ private:
 #define DWARF_CFA_STATE_BUCKET_COUNT 14
 #define DWARF_CFA_STATE_INVALID_ENTRY_IDX UINT8_MAX
 
+/* Sparse entry rule value marking a register that was removed in a pushed state, hiding any rule inherited from the
+ * states below it. */
+#define DWARF_CFA_STATE_REMOVED_RULE UINT8_MAX
+
     /** A single register entry */
     typedef struct dwarf_cfa_reg_entry {
         /**
@@ -267,17 +286,38 @@ private:
         /** The DWARF register number */
         dwarf_cfa_state_regnum_t regnum;
 
-        /** DWARF register rule */
+        /** DWARF register rule, or DWARF_CFA_STATE_REMOVED_RULE if the register was removed in this state. */
         uint8_t rule;
         
         /** Next entry in the list, or NULL */
         uint8_t next;
     } dwarf_cfa_reg_entry_t;
     
+    /**
+     * Densely stored register state for registers numbered below DWARF_CFA_STATE_DENSE_REGISTERS. Only the rules
+     * set or removed within the row's state are recorded; all others are inherited from the states below.
+     */
+    typedef struct dwarf_cfa_dense_row {
+        /** Bitmap of registers with a rule set in this state; bit N corresponds to DWARF register N. */
+        uint32_t defined;
+
+        /** Bitmap of registers whose inherited rule was removed in this state. Never set in the initial state. */
+        uint32_t removed;
+
+        /** DWARF register rules, indexed by register number. Only valid if set in @a defined. */
+        uint8_t rules[DWARF_CFA_STATE_DENSE_REGISTERS];
+
+        /** Associated rule values, indexed by register number. Only valid if set in @a defined. */
+        machine_ptr values[DWARF_CFA_STATE_DENSE_REGISTERS];
+    } dwarf_cfa_dense_row_t;
+
     /** Current call frame value configuration. */
     dwarf_cfa_rule<machine_ptr,machine_ptr_s> _cfa_value[DWARF_CFA_STATE_MAX_STATES];
+
+    /** Dense register state for each saved state. */
+    dwarf_cfa_dense_row_t _dense[DWARF_CFA_STATE_MAX_STATES];
     
-    /** Current number of defined register entries */
+    /** Current number of defined register entries in each state, including inherited entries */
     uint8_t _register_count[DWARF_CFA_STATE_MAX_STATES];
 
     /**
@@ -300,11 +340,14 @@ private:
     uint8_t _free_list;
 
     /**
-     * Statically allocated set of entries; these will be inserted into the free
-     * list upon construction, and then moved into the entry table as registers
+     * Statically allocated set of entries for registers numbered DWARF_CFA_STATE_DENSE_REGISTERS and above; these
+     * will be inserted into the free list upon construction, and then moved into the entry table as registers
      * are set.
      */
-    dwarf_cfa_reg_entry_t _entries[DWARF_CFA_STATE_MAX_REGISTERS];
+    dwarf_cfa_reg_entry_t _entries[DWARF_CFA_STATE_SPARSE_REGISTERS];
+
+    dwarf_cfa_reg_entry_t *find_entry (uint8_t depth, dwarf_cfa_state_regnum_t regnum);
+    uint32_t dense_defined (void);
 
 public:
     dwarf_cfa_state (void);
@@ -317,13 +360,17 @@ public:
                                   const plcrash_async_byteorder_t *byteorder,
                                   pl_vm_address_t address,
                                   pl_vm_off_t offset,
-                                  pl_vm_size_t length);
+                                  pl_vm_size_t length,
+                                  bool *location_dependent = NULL,
+                                  machine_ptr *row_start = NULL,
+                                  machine_ptr *row_end = NULL);
     
     plcrash_error_t apply_state (task_t task,
                                  plcrash_async_dwarf_cie_info_t *cie_info,
                                  const plcrash_async_thread_state_t *thread_state,
                                  const plcrash_async_byteorder_t *byteorder,
-                                 plcrash_async_thread_state_t *new_thread_state);
+                                 plcrash_async_thread_state_t *new_thread_state,
+                                 plcrash_async_task_read_cache_t *stack_cache = NULL);
     
     bool set_register (dwarf_cfa_state_regnum_t regnum, plcrash_dwarf_cfa_reg_rule_t rule, machine_ptr value);
     bool get_register_rule (dwarf_cfa_state_regnum_t regnum, plcrash_dwarf_cfa_reg_rule_t *rule, machine_ptr *value);
@@ -351,6 +398,12 @@ public:
 template <typename machine_ptr, typename machine_ptr_s>
 class dwarf_cfa_state_iterator {
 private:
+    /** Dense registers that have not yet been enumerated. */
+    uint32_t _dense_remaining;
+
+    /** Current state index; sparse entries are enumerated from the current state down to the initial state */
+    uint8_t _depth;
+
     /** Current bucket index */
     uint8_t _bucket_idx;
     
@@ -27,6 +27,7 @@
 #include "PLCrashAsyncDwarfExpression.hpp"
 #include "PLCrashAsyncDwarfPrimitives.hpp"
 #include "PLCrashAsyncDwarfCFAState.hpp"
+#include "PLCrashAsyncThreadRegisters.hpp"
 
 #include "PLCrashFeatureConfig.h"
 
@@ -44,8 +45,18 @@
 
 using namespace plcrash::async;
 
-template <typename machine_ptr, typename machine_ptr_s>
+template <typename regs, typename machine_ptr, typename machine_ptr_s>
+static plcrash_error_t plcrash_async_dwarf_cfa_state_apply (dwarf_cfa_state<machine_ptr, machine_ptr_s> *cfa_state,
+                                                            task_t task,
+                                                            plcrash_async_dwarf_cie_info_t *cie_info,
+                                                            const plcrash_async_thread_state_t *thread_state,
+                                                            const plcrash_async_byteorder_t *byteorder,
+                                                            plcrash_async_thread_state_t *new_thread_state,
+                                                            plcrash_async_task_read_cache_t *stack_cache);
+
+template <typename regs, typename machine_ptr, typename machine_ptr_s>
 static plcrash_error_t plcrash_async_dwarf_cfa_state_apply_register (task_t task,
+                                                                     plcrash_async_task_read_cache_t *stack_cache,
                                                                      const plcrash_async_thread_state_t *thread_state,
                                                                      const plcrash_async_byteorder_t *byteorder,
                                                                      plcrash_async_thread_state_t *new_thread_state,
@@ -73,6 +84,17 @@ static plcrash_error_t plcrash_async_dwarf_cfa_state_apply_register (task_t task
  * @param address The task-relative address within @a mobj at which the opcodes will be fetched.
  * @param offset An offset to be applied to @a address.
  * @param length The total length of the opcodes readable at @a address + @a offset.
+ * @param[out] location_dependent If non-NULL, will be set to true if the program contained any location-modifying
+ * opcodes (eg, DW_CFA_advance_loc), in which case the result depends on @a pc and @a initial_pc_value. Otherwise,
+ * will be set to false.
+ * @param[out] row_start If non-NULL, will be set to the address of the first instruction of the row containing @a pc.
+ * The evaluated rules apply to all instructions within the row.
+ * @param[out] row_end If non-NULL, will be set to the address immediately following the row containing @a pc, or 0
+ * if the row extends to the end of the address range covered by the program.
+ *
+ * Evaluation terminates at the first row boundary following @a pc; the rules of later rows are neither read nor
+ * applied. If the row can not be determined (eg, @a pc is 0, or DW_CFA_set_loc moved the location backwards), the
+ * row will be reported as covering only @a pc.
  *
  * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t values
  * on failure. If an invalid opcode is detected, PLCRASH_ENOTSUP will be returned.
@@ -89,12 +111,22 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::eval_program (plcra
                                                                            const plcrash_async_byteorder_t *byteorder,
                                                                            pl_vm_address_t address,
                                                                            pl_vm_off_t offset,
-                                                                           pl_vm_size_t length)
+                                                                           pl_vm_size_t length,
+                                                                           bool *location_dependent,
+                                                                           machine_ptr *row_start,
+                                                                           machine_ptr *row_end)
 {
     plcrash::async::dwarf_opstream opstream;
     plcrash_error_t err;
     machine_ptr location = initial_pc_value;
 
+    /* The start of the current row, and whether the row locations have been monotonic */
+    machine_ptr row_location = initial_pc_value;
+    bool monotonic = true;
+
+    if (location_dependent != NULL)
+        *location_dependent = false;
+
     /* Save the initial state; this is needed for DW_CFA_restore, et al. */
     // TODO - It would be preferrable to only allocate the number of registers actually required here.
     dwarf_cfa_state<machine_ptr, machine_ptr_s> initial_state;
@@ -188,6 +220,11 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::eval_program (plcra
     while ((pc == 0 || location <= pc) && opstream.read_intU(&opcode)) {
         uint8_t const_operand = 0;
 
+        /* Track the start of the row containing pc */
+        if (location < row_location)
+            monotonic = false;
+        row_location = location;
+
         /* Check for opcodes encoded in the top two bits, with an operand
          * in the bottom 6 bits. */
         
@@ -198,6 +235,9 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::eval_program (plcra
         
         switch (opcode) {
             case DW_CFA_set_loc:
+                if (location_dependent != NULL)
+                    *location_dependent = true;
+
                 if (cie_info->segment_size != 0) {
                     PLCF_DEBUG("Segment support has not been implemented");
                     return PLCRASH_ENOTSUP;
@@ -211,18 +251,26 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::eval_program (plcra
                 break;
                 
             case DW_CFA_advance_loc:
+                if (location_dependent != NULL)
+                    *location_dependent = true;
                 location += const_operand * cie_info->code_alignment_factor;
                 break;
                 
             case DW_CFA_advance_loc1:
+                if (location_dependent != NULL)
+                    *location_dependent = true;
                 location += dw_expr_read_int(uint8_t) * cie_info->code_alignment_factor;
                 break;
                 
             case DW_CFA_advance_loc2:
+                if (location_dependent != NULL)
+                    *location_dependent = true;
                 location += dw_expr_read_int(uint16_t) * cie_info->code_alignment_factor;
                 break;
                 
             case DW_CFA_advance_loc4:
+                if (location_dependent != NULL)
+                    *location_dependent = true;
                 location += dw_expr_read_int(uint32_t) * cie_info->code_alignment_factor;
                 break;
                 
@@ -442,6 +490,32 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::eval_program (plcra
         }
     }
 
+    if (location < row_location)
+        monotonic = false;
+
+    /* Report the row containing pc. If we stopped at a row boundary, the row ends there; otherwise, the program was
+     * exhausted, and the final row extends to the end of the program's address range. */
+    if (row_start != NULL || row_end != NULL) {
+        machine_ptr start = pc;
+        machine_ptr end = pc + 1;
+
+        if (pc != 0 && monotonic) {
+            if (location > pc && row_location <= pc) {
+                start = row_location;
+                end = location;
+            } else if (location <= pc) {
+                start = location;
+                end = 0;
+            }
+        }
+
+        if (row_start != NULL)
+            *row_start = start;
+
+        if (row_end != NULL)
+            *row_end = end;
+    }
+
     return PLCRASH_ESUCCESS;
 }
 
@@ -454,6 +528,7 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::eval_program (plcra
  * @param thread_state The current thread state corresponding to @a entry.
  * @param byteorder The target's byte order.
  * @param new_thread_state The new thread state to be initialized.
+ * @param stack_cache A read cache to be used when reading stack data from @a task, or NULL to perform uncached reads.
  *
  * @return Returns PLCRASH_ESUCCESS on success, or a standard pclrash_error_t code if an error occurs.
  */
@@ -462,7 +537,45 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::apply_state (task_t
                                                                           plcrash_async_dwarf_cie_info_t *cie_info,
                                                                           const plcrash_async_thread_state_t *thread_state,
                                                                           const plcrash_async_byteorder_t *byteorder,
-                                                                          plcrash_async_thread_state_t *new_thread_state)
+                                                                          plcrash_async_thread_state_t *new_thread_state,
+                                                                          plcrash_async_task_read_cache_t *stack_cache)
+{
+    /* Determine the thread state's flavor once, and apply the state using the matching register accessors. */
+#if defined(__i386__) || defined(__x86_64__)
+    if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32)
+        return plcrash_async_dwarf_cfa_state_apply<thread_state_x86_32_regs>(this, task, cie_info, thread_state, byteorder, new_thread_state, stack_cache);
+    else
+        return plcrash_async_dwarf_cfa_state_apply<thread_state_x86_64_regs>(this, task, cie_info, thread_state, byteorder, new_thread_state, stack_cache);
+#elif defined(__arm__)
+    return plcrash_async_dwarf_cfa_state_apply<thread_state_arm_regs>(this, task, cie_info, thread_state, byteorder, new_thread_state, stack_cache);
+#else
+#error Add support for this platform
+#endif
+}
+
+/**
+ * Apply @a cfa_state to @a thread_state using the register accessors @a regs; the implementation of
+ * dwarf_cfa_state::apply_state().
+ *
+ * @tparam regs The register accessor type matching @a thread_state's flavor.
+ * @param cfa_state The CFA state to be applied.
+ * @param task The task containing any data referenced by @a thread_state.
+ * @param cie_info The CIE from which @a cfa_state was derived.
+ * @param thread_state The current thread state corresponding to @a entry.
+ * @param byteorder The target's byte order.
+ * @param new_thread_state The new thread state to be initialized.
+ * @param stack_cache A read cache to be used when reading stack data from @a task, or NULL to perform uncached reads.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or a standard pclrash_error_t code if an error occurs.
+ */
+template <typename regs, typename machine_ptr, typename machine_ptr_s>
+static plcrash_error_t plcrash_async_dwarf_cfa_state_apply (dwarf_cfa_state<machine_ptr, machine_ptr_s> *cfa_state,
+                                                            task_t task,
+                                                            plcrash_async_dwarf_cie_info_t *cie_info,
+                                                            const plcrash_async_thread_state_t *thread_state,
+                                                            const plcrash_async_byteorder_t *byteorder,
+                                                            plcrash_async_thread_state_t *new_thread_state,
+                                                            plcrash_async_task_read_cache_t *stack_cache)
 {
     plcrash_error_t err;
 
@@ -473,7 +586,7 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::apply_state (task_t
     /*
      * Restore the canonical frame address
      */
-    dwarf_cfa_rule<machine_ptr, machine_ptr_s> cfa_rule = get_cfa_rule();
+    dwarf_cfa_rule<machine_ptr, machine_ptr_s> cfa_rule = cfa_state->get_cfa_rule();
     machine_ptr cfa_val;
 
     switch (cfa_rule.type()) {
@@ -487,19 +600,19 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::apply_state (task_t
             plcrash_regnum_t regnum;
             
             /* Map to a plcrash register number */
-            if (!plcrash_async_thread_state_map_dwarf_to_reg(thread_state, cfa_rule.register_number(), &regnum)) {
+            if (!regs::map_dwarf_to_reg(thread_state, cfa_rule.register_number(), &regnum)) {
                 PLCF_DEBUG("CFA rule references an unsupported DWARF register: 0x%" PRIx32, cfa_rule.register_number());
                 return PLCRASH_ENOTSUP;
             }
             
             /* Verify that the requested register is available */
-            if (!plcrash_async_thread_state_has_reg(thread_state, regnum)) {
+            if (!regs::has_reg(thread_state, regnum)) {
                 PLCF_DEBUG("CFA rule references a register that is not available from the current thread state: %s", plcrash_async_thread_state_get_reg_name(thread_state, regnum));
                 return PLCRASH_ENOTFOUND;
             }
 
             /* Fetch the current value, apply the offset, and save as the new thread's CFA. */
-            cfa_val = plcrash_async_thread_state_get_reg(thread_state, regnum);
+            cfa_val = regs::get_reg(thread_state, regnum);
             if (cfa_rule.type() == DWARF_CFA_STATE_CFA_TYPE_REGISTER)
                 cfa_val += cfa_rule.register_offset();
             else
@@ -524,12 +637,12 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::apply_state (task_t
     }
     
     /* Apply the CFA to the new state */
-    plcrash_async_thread_state_set_reg(new_thread_state, PLCRASH_REG_SP, cfa_val);
+    regs::set_reg(new_thread_state, PLCRASH_REG_SP, cfa_val);
     
     /*
      * Restore register values
      */
-    dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s> iter = dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s>(this);
+    dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s> iter = dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s>(cfa_state);
     dwarf_cfa_state_regnum_t dw_regnum;
     plcrash_dwarf_cfa_reg_rule_t dw_rule;
     machine_ptr dw_value;
@@ -537,7 +650,7 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::apply_state (task_t
     while (iter.next(&dw_regnum, &dw_rule, &dw_value)) {
         /* Map the register number */
         plcrash_regnum_t pl_regnum;
-        if (!plcrash_async_thread_state_map_dwarf_to_reg(thread_state, dw_regnum, &pl_regnum)) {
+        if (!regs::map_dwarf_to_reg(thread_state, dw_regnum, &pl_regnum)) {
             /* Some DWARF ABIs (such as x86-64) define the return address using a pseudo-register. In that case, the
              * register will not have a vaid DWARF -> PLCrashReporter mapping; we simply target the IP in this case,
              * which results in the expected behavior of setting the IP in the new thread state. */
@@ -550,13 +663,13 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::apply_state (task_t
         }
         
         /* Apply the register rule */
-        if ((err = plcrash_async_dwarf_cfa_state_apply_register<machine_ptr, machine_ptr_s>(task, thread_state, byteorder, new_thread_state, cfa_val, pl_regnum, dw_rule, dw_value)) != PLCRASH_ESUCCESS)
+        if ((err = plcrash_async_dwarf_cfa_state_apply_register<regs, machine_ptr, machine_ptr_s>(task, stack_cache, thread_state, byteorder, new_thread_state, cfa_val, pl_regnum, dw_rule, dw_value)) != PLCRASH_ESUCCESS)
             return err;
         
         /* If the target register is defined as the return address (and is not already the IP), copy the value to the IP.  */
         if (cie_info->return_address_register == dw_regnum && pl_regnum != PLCRASH_REG_IP) {
-            PLCF_ASSERT(plcrash_async_thread_state_has_reg(new_thread_state, pl_regnum));
-            plcrash_async_thread_state_set_reg(new_thread_state, PLCRASH_REG_IP, plcrash_async_thread_state_get_reg(new_thread_state, pl_regnum));
+            PLCF_ASSERT(regs::has_reg(new_thread_state, pl_regnum));
+            regs::set_reg(new_thread_state, PLCRASH_REG_IP, regs::get_reg(new_thread_state, pl_regnum));
         }
     }
 
@@ -566,7 +679,9 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::apply_state (task_t
 /**
  * Apply a single register rule to @a new_thread_state.
  *
+ * @tparam regs The register accessor type matching @a thread_state's flavor.
  * @param task The task containing any data referenced by @a thread_state.
+ * @param stack_cache A read cache to be used when reading stack data from @a task, or NULL to perform uncached reads.
  * @param thread_state The current thread state corresponding to @a entry.
  * @param byteorder The target's byte order.
  * @param new_thread_state The new thread state to be initialized.
@@ -577,8 +692,9 @@ plcrash_error_t dwarf_cfa_state<machine_ptr, machine_ptr_s>::apply_state (task_t
  *
  * @return Returns PLCRASH_ESUCCESS on success, or a standard pclrash_error_t code if an error occurs.
  */
-template <typename machine_ptr, typename machine_ptr_s>
+template <typename regs, typename machine_ptr, typename machine_ptr_s>
 static plcrash_error_t plcrash_async_dwarf_cfa_state_apply_register (task_t task,
+                                                                     plcrash_async_task_read_cache_t *stack_cache,
                                                                      const plcrash_async_thread_state_t *thread_state,
                                                                      const plcrash_async_byteorder_t *byteorder,
                                                                      plcrash_async_thread_state_t *new_thread_state,
@@ -588,8 +704,8 @@ static plcrash_error_t plcrash_async_dwarf_cfa_state_apply_register (task_t task
                                                                      machine_ptr dw_value)
 {
     plcrash_error_t err;
-    uint8_t greg_size = plcrash_async_thread_state_get_greg_size(thread_state);
-    bool m64 = (greg_size == 8);
+    const uint8_t greg_size = regs::greg_size;
+    const bool m64 = (greg_size == 8);
     
     union {
         uint32_t v32;
@@ -600,38 +716,38 @@ static plcrash_error_t plcrash_async_dwarf_cfa_state_apply_register (task_t task
     /* Apply the rule */
     switch (dw_rule) {
         case PLCRASH_DWARF_CFA_REG_RULE_OFFSET: {
-            if ((err = plcrash_async_task_memcpy(task, cfa_val, (machine_ptr_s)dw_value, vptr, greg_size)) != PLCRASH_ESUCCESS) {
+            if ((err = plcrash_async_task_memcpy_cached(stack_cache, task, cfa_val, (machine_ptr_s)dw_value, vptr, greg_size)) != PLCRASH_ESUCCESS) {
                 PLCF_DEBUG("Failed to read offset(N) register value: %d", err);
                 return err;
             }
             
             if (m64) {
-                plcrash_async_thread_state_set_reg(new_thread_state, pl_regnum, rvalue.v64);
+                regs::set_reg(new_thread_state, pl_regnum, rvalue.v64);
             } else {
-                plcrash_async_thread_state_set_reg(new_thread_state, pl_regnum, rvalue.v32);
+                regs::set_reg(new_thread_state, pl_regnum, rvalue.v32);
             }
             
             break;
         }
             
         case PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET:
-            plcrash_async_thread_state_set_reg(new_thread_state, pl_regnum, cfa_val + ((machine_ptr_s) dw_value));
+            regs::set_reg(new_thread_state, pl_regnum, cfa_val + ((machine_ptr_s) dw_value));
             break;
             
         case PLCRASH_DWARF_CFA_REG_RULE_REGISTER: {
             /* The previous value of this register is stored in another register numbered R. */
             plcrash_regnum_t src_pl_regnum;
-            if (!plcrash_async_thread_state_map_dwarf_to_reg(thread_state, dw_value, &src_pl_regnum)) {
+            if (!regs::map_dwarf_to_reg(thread_state, dw_value, &src_pl_regnum)) {
                 PLCF_DEBUG("Register rule references an unsupported DWARF register: 0x%" PRIx64, (uint64_t) dw_value);
                 return PLCRASH_EINVAL;
             }
             
-            if (!plcrash_async_thread_state_has_reg(thread_state, src_pl_regnum)) {
+            if (!regs::has_reg(thread_state, src_pl_regnum)) {
                 PLCF_DEBUG("Register rule references a register that is not available from the current thread state: %s", plcrash_async_thread_state_get_reg_name(thread_state, src_pl_regnum));
                 return PLCRASH_ENOTFOUND;
             }
             
-            plcrash_async_thread_state_set_reg(new_thread_state, pl_regnum, plcrash_async_thread_state_get_reg(thread_state, src_pl_regnum));
+            regs::set_reg(new_thread_state, pl_regnum, regs::get_reg(thread_state, src_pl_regnum));
             break;
         }
             
@@ -698,7 +814,7 @@ static plcrash_error_t plcrash_async_dwarf_cfa_state_apply_register (task_t task
                 }
             }
             
-            plcrash_async_thread_state_set_reg(new_thread_state, pl_regnum, regval);
+            regs::set_reg(new_thread_state, pl_regnum, regval);
             break;
         }
             
@@ -708,13 +824,13 @@ static plcrash_error_t plcrash_async_dwarf_cfa_state_apply_register (task_t task
              *
              * The register's value may be found in the frame's thread state. For frames other than the first, the
              * register may not have been restored, and thus may be unavailable. */
-            if (!plcrash_async_thread_state_has_reg(thread_state, pl_regnum)) {
+            if (!regs::has_reg(thread_state, pl_regnum)) {
                 PLCF_DEBUG("Same-value rule references a register that is not available from the current thread state");
                 return PLCRASH_ENOTFOUND;
             }
             
             /* Copy the register value from the previous state */
-            plcrash_async_thread_state_set_reg(new_thread_state, pl_regnum, plcrash_async_thread_state_get_reg(thread_state, pl_regnum));
+            regs::set_reg(new_thread_state, pl_regnum, regs::get_reg(thread_state, pl_regnum));
             break;
     }
     
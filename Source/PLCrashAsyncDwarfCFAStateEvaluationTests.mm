@@ -169,6 +169,53 @@ using namespace plcrash::async;
     STAssertEquals((uint64_t)2, _stack.get_cfa_rule().register_offset(), @"Unexpected CFA offset");
 }
 
+/** Verify that location-dependent programs are reported as such */
+- (void) testLocationDependent {
+    plcrash_async_mobject_t mobj;
+    bool location_dependent;
+
+    /* A location-independent program */
+    uint8_t opcodes[] = { DW_CFA_def_cfa, 0x1, 0x2 };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&mobj, mach_task_self(), (pl_vm_address_t) &opcodes, sizeof(opcodes), true), @"Failed to initialize mobj");
+    STAssertEquals(PLCRASH_ESUCCESS, _stack.eval_program(&mobj, 0, 0, &_cie, _ptr_state, plcrash_async_byteorder_big_endian(), (pl_vm_address_t) &opcodes, 0, sizeof(opcodes), &location_dependent), @"Evaluation failed");
+    STAssertFalse(location_dependent, @"Program incorrectly reported as location dependent");
+    plcrash_async_mobject_free(&mobj);
+
+    /* A program that advances the location */
+    uint8_t loc_opcodes[] = { DW_CFA_def_cfa, 0x1, 0x2, DW_CFA_advance_loc|0x1, DW_CFA_def_cfa_offset, 0x4 };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&mobj, mach_task_self(), (pl_vm_address_t) &loc_opcodes, sizeof(loc_opcodes), true), @"Failed to initialize mobj");
+    STAssertEquals(PLCRASH_ESUCCESS, _stack.eval_program(&mobj, 0x10, 0, &_cie, _ptr_state, plcrash_async_byteorder_big_endian(), (pl_vm_address_t) &loc_opcodes, 0, sizeof(loc_opcodes), &location_dependent), @"Evaluation failed");
+    STAssertTrue(location_dependent, @"Program not reported as location dependent");
+    plcrash_async_mobject_free(&mobj);
+}
+
+/** Verify that the row containing the target PC is reported */
+- (void) testRowRange {
+    plcrash_async_mobject_t mobj;
+    uint64_t row_start;
+    uint64_t row_end;
+
+    uint8_t opcodes[] = { DW_CFA_def_cfa, 0x1, 0x2, DW_CFA_advance_loc|0x4, DW_CFA_def_cfa_offset, 0x4, DW_CFA_advance_loc|0x4, DW_CFA_def_cfa_offset, 0x8 };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&mobj, mach_task_self(), (pl_vm_address_t) &opcodes, sizeof(opcodes), true), @"Failed to initialize mobj");
+
+    /* First row */
+    STAssertEquals(PLCRASH_ESUCCESS, _stack.eval_program(&mobj, 0x12, 0x10, &_cie, _ptr_state, plcrash_async_byteorder_big_endian(), (pl_vm_address_t) &opcodes, 0, sizeof(opcodes), NULL, &row_start, &row_end), @"Evaluation failed");
+    STAssertEquals((uint64_t) 0x10, row_start, @"Incorrect row start");
+    STAssertEquals((uint64_t) 0x14, row_end, @"Incorrect row end");
+
+    /* Second row */
+    STAssertEquals(PLCRASH_ESUCCESS, _stack.eval_program(&mobj, 0x15, 0x10, &_cie, _ptr_state, plcrash_async_byteorder_big_endian(), (pl_vm_address_t) &opcodes, 0, sizeof(opcodes), NULL, &row_start, &row_end), @"Evaluation failed");
+    STAssertEquals((uint64_t) 0x14, row_start, @"Incorrect row start");
+    STAssertEquals((uint64_t) 0x18, row_end, @"Incorrect row end");
+
+    /* Final row, which extends to the end of the program's address range */
+    STAssertEquals(PLCRASH_ESUCCESS, _stack.eval_program(&mobj, 0x20, 0x10, &_cie, _ptr_state, plcrash_async_byteorder_big_endian(), (pl_vm_address_t) &opcodes, 0, sizeof(opcodes), NULL, &row_start, &row_end), @"Evaluation failed");
+    STAssertEquals((uint64_t) 0x18, row_start, @"Incorrect row start");
+    STAssertEquals((uint64_t) 0x0, row_end, @"Incorrect row end");
+
+    plcrash_async_mobject_free(&mobj);
+}
+
 /** Test evaluation of DW_CFA_def_cfa_sf */
 - (void) testDefineCFASF {
     /* An alignment factor to be applied to the second operand. */
@@ -396,6 +443,27 @@ using namespace plcrash::async;
     TEST_REGISTER_RESULT(0x4, PLCRASH_DWARF_CFA_REG_RULE_EXPRESSION, (uint64_t)0x20);
 }
 
+/** Test that a remembered state's rules remain in force, and may be modified, until DW_CFA_restore_state */
+- (void) testRememberStateInheritsRules {
+    uint8_t opcodes[] = { DW_CFA_def_cfa, 0x1, 0x2, DW_CFA_val_offset, 0x4, 0x8, DW_CFA_remember_state, DW_CFA_def_cfa_offset, 0x10, DW_CFA_advance_loc|0x1, DW_CFA_restore_state };
+
+    /* Terminate evaluation prior to DW_CFA_restore_state; the CFA offset is modified, and the register rule is inherited */
+    PERFORM_EVAL_TEST_WITH_INITIAL_PC(opcodes, 0x1, 0x1, PLCRASH_ESUCCESS);
+    STAssertEquals(DWARF_CFA_STATE_CFA_TYPE_REGISTER, _stack.get_cfa_rule().type(), @"Unexpected CFA type");
+    STAssertEquals((dwarf_cfa_state_regnum_t)1, _stack.get_cfa_rule().register_number(), @"Unexpected CFA register");
+    STAssertEquals((uint64_t)0x10, _stack.get_cfa_rule().register_offset(), @"Unexpected CFA offset");
+    TEST_REGISTER_RESULT(0x4, PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET, (uint64_t)0x8);
+    STAssertTrue(_stack.pop_state(), @"No new state was pushed");
+
+    /* Evaluate the full program; the remembered CFA offset is restored */
+    PERFORM_EVAL_TEST_WITH_INITIAL_PC(opcodes, 0x2, 0x1, PLCRASH_ESUCCESS);
+    STAssertEquals(DWARF_CFA_STATE_CFA_TYPE_REGISTER, _stack.get_cfa_rule().type(), @"Unexpected CFA type");
+    STAssertEquals((dwarf_cfa_state_regnum_t)1, _stack.get_cfa_rule().register_number(), @"Unexpected CFA register");
+    STAssertEquals((uint64_t)0x2, _stack.get_cfa_rule().register_offset(), @"Unexpected CFA offset");
+    TEST_REGISTER_RESULT(0x4, PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET, (uint64_t)0x8);
+    STAssertFalse(_stack.pop_state(), @"DW_CFA_restore_state did not pop the remembered state");
+}
+
 - (void) testBadOpcode {
     uint8_t opcodes[] = { DW_CFA_BAD_OPCODE };
     PERFORM_EVAL_TEST(opcodes, 0, PLCRASH_ENOTSUP);
@@ -148,6 +148,123 @@ using namespace plcrash::async;
     STAssertEquals(found_set, (uint32_t)0, @"Did not enumerate all 32 values: 0x%" PRIx32, found_set);
 }
 
+/**
+ * Test enumerating a mix of densely and sparsely stored registers in the current state.
+ */
+- (void) testEnumerateMixedRegisters {
+    dwarf_cfa_state<uint64_t, int64_t> stack;
+    const dwarf_cfa_state_regnum_t sparse_base = DWARF_CFA_STATE_DENSE_REGISTERS * 2;
+
+    /* Populate the low dense registers, and an equal number of higher-numbered sparse registers */
+    for (uint32_t i = 0; i < 16; i++) {
+        STAssertTrue(stack.set_register(i, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, i), @"Failed to add dense register");
+        STAssertTrue(stack.set_register(sparse_base + i, PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET, sparse_base + i), @"Failed to add sparse register");
+    }
+    STAssertEquals((uint8_t)32, stack.get_register_count(), @"Incorrect number of registers");
+
+    /* Enumerate */
+    dwarf_cfa_state_iterator<uint64_t, int64_t> iter = dwarf_cfa_state_iterator<uint64_t, int64_t>(&stack);
+    uint32_t dense_found = 0;
+    uint32_t sparse_found = 0;
+    dwarf_cfa_state_regnum_t regnum;
+    plcrash_dwarf_cfa_reg_rule_t rule;
+    uint64_t value;
+
+    for (int i = 0; i < 32; i++) {
+        STAssertTrue(iter.next(&regnum, &rule, &value), @"Iteration failed while additional registers remain");
+        STAssertEquals((uint64_t)regnum, value, @"Unexpected value");
+
+        if (regnum < DWARF_CFA_STATE_DENSE_REGISTERS) {
+            STAssertEquals(rule, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, @"Incorrect rule");
+            dense_found |= (1 << regnum);
+        } else {
+            STAssertEquals(rule, PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET, @"Incorrect rule");
+            sparse_found |= (1 << (regnum - sparse_base));
+        }
+    }
+
+    STAssertFalse(iter.next(&regnum, &rule, &value), @"Iteration succeeded after successfully iterating all registers (got regnum=%" PRIu32 ")", regnum);
+    STAssertEquals(dense_found, (uint32_t)0xFFFF, @"Did not enumerate all dense registers: 0x%" PRIx32, dense_found);
+    STAssertEquals(sparse_found, (uint32_t)0xFFFF, @"Did not enumerate all sparse registers: 0x%" PRIx32, sparse_found);
+
+    /* Verify that a pushed state inherits all registers */
+    STAssertTrue(stack.push_state(), @"Failed to push a new state");
+    STAssertTrue(stack.get_register_rule(0, &rule, &value), @"Dense register was not visible in a newly pushed state");
+    STAssertTrue(stack.get_register_rule(sparse_base, &rule, &value), @"Sparse register was not visible in a newly pushed state");
+
+    iter = dwarf_cfa_state_iterator<uint64_t, int64_t>(&stack);
+    dense_found = 0;
+    sparse_found = 0;
+    for (int i = 0; i < 32; i++) {
+        STAssertTrue(iter.next(&regnum, &rule, &value), @"Iteration failed while additional registers remain");
+        if (regnum < DWARF_CFA_STATE_DENSE_REGISTERS)
+            dense_found |= (1 << regnum);
+        else
+            sparse_found |= (1 << (regnum - sparse_base));
+    }
+    STAssertFalse(iter.next(&regnum, &rule, &value), @"Iteration succeeded after successfully iterating all registers (got regnum=%" PRIu32 ")", regnum);
+    STAssertEquals(dense_found, (uint32_t)0xFFFF, @"Did not enumerate all inherited dense registers: 0x%" PRIx32, dense_found);
+    STAssertEquals(sparse_found, (uint32_t)0xFFFF, @"Did not enumerate all inherited sparse registers: 0x%" PRIx32, sparse_found);
+}
+
+/**
+ * Test that modifications to a pushed state shadow, but do not alter, the inherited registers.
+ */
+- (void) testPushedStateDeltas {
+    dwarf_cfa_state<uint64_t, int64_t> stack;
+    const dwarf_cfa_state_regnum_t sparse_base = DWARF_CFA_STATE_DENSE_REGISTERS * 2;
+    dwarf_cfa_state_regnum_t regnum;
+    plcrash_dwarf_cfa_reg_rule_t rule;
+    uint64_t value;
+
+    /* Populate two dense and two sparse registers */
+    STAssertTrue(stack.set_register(1, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, 1), @"Failed to add register");
+    STAssertTrue(stack.set_register(2, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, 2), @"Failed to add register");
+    STAssertTrue(stack.set_register(sparse_base, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, sparse_base), @"Failed to add register");
+    STAssertTrue(stack.set_register(sparse_base+1, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, sparse_base+1), @"Failed to add register");
+
+    /* Override one register of each kind, and remove the other */
+    STAssertTrue(stack.push_state(), @"Failed to push a new state");
+    STAssertTrue(stack.set_register(1, PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET, 10), @"Failed to override register");
+    STAssertTrue(stack.set_register(sparse_base, PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET, 20), @"Failed to override register");
+    stack.remove_register(2);
+    stack.remove_register(sparse_base+1);
+    STAssertEquals((uint8_t)2, stack.get_register_count(), @"Incorrect number of registers");
+
+    STAssertTrue(stack.get_register_rule(1, &rule, &value), @"Failed to fetch overridden register");
+    STAssertEquals(rule, PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET, @"Incorrect rule");
+    STAssertEquals((uint64_t)10, value, @"Incorrect value");
+    STAssertFalse(stack.get_register_rule(2, &rule, &value), @"Removed register was visible");
+    STAssertFalse(stack.get_register_rule(sparse_base+1, &rule, &value), @"Removed register was visible");
+
+    /* Iteration returns only the overriding rules */
+    dwarf_cfa_state_iterator<uint64_t, int64_t> iter = dwarf_cfa_state_iterator<uint64_t, int64_t>(&stack);
+    for (int i = 0; i < 2; i++) {
+        STAssertTrue(iter.next(&regnum, &rule, &value), @"Iteration failed while additional registers remain");
+        STAssertTrue(regnum == 1 || regnum == sparse_base, @"Unexpected register %" PRIu32, regnum);
+        STAssertEquals(rule, PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET, @"Inherited rule was returned for an overridden register");
+    }
+    STAssertFalse(iter.next(&regnum, &rule, &value), @"Iteration succeeded after successfully iterating all registers (got regnum=%" PRIu32 ")", regnum);
+
+    /* Re-adding a removed register is counted */
+    STAssertTrue(stack.set_register(2, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, 30), @"Failed to re-add register");
+    STAssertEquals((uint8_t)3, stack.get_register_count(), @"Incorrect number of registers");
+
+    /* Popping restores the saved rules */
+    STAssertTrue(stack.pop_state(), @"Failed to pop state");
+    STAssertEquals((uint8_t)4, stack.get_register_count(), @"Incorrect number of registers");
+    for (dwarf_cfa_state_regnum_t r = 1; r <= 2; r++) {
+        STAssertTrue(stack.get_register_rule(r, &rule, &value), @"Failed to fetch restored register");
+        STAssertEquals(rule, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, @"Incorrect rule");
+        STAssertEquals((uint64_t)r, value, @"Incorrect value");
+    }
+    for (dwarf_cfa_state_regnum_t r = sparse_base; r <= sparse_base+1; r++) {
+        STAssertTrue(stack.get_register_rule(r, &rule, &value), @"Failed to fetch restored register");
+        STAssertEquals(rule, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, @"Incorrect rule");
+        STAssertEquals((uint64_t)r, value, @"Incorrect value");
+    }
+}
+
 /**
  * Test removing register values from the current state.
  */
@@ -207,6 +324,32 @@ using namespace plcrash::async;
     }
 }
 
+/**
+ * Test that popping a state releases its sparse register entries, allowing repeated push/pop pairs.
+ */
+- (void) testPopStateReleasesEntries {
+    dwarf_cfa_state<uint64_t, int64_t> stack;
+    plcrash_dwarf_cfa_reg_rule_t rule;
+    uint64_t value;
+
+    STAssertTrue(stack.set_register(DWARF_CFA_STATE_DENSE_REGISTERS, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, 1), @"Failed to add register");
+
+    /* Each iteration consumes every remaining sparse entry; without releasing them on pop, the second iteration
+     * would fail. */
+    for (int iteration = 0; iteration < 3; iteration++) {
+        STAssertTrue(stack.push_state(), @"Failed to push a new state");
+        for (int i = 0; i < DWARF_CFA_STATE_SPARSE_REGISTERS - 1; i++)
+            STAssertTrue(stack.set_register(DWARF_CFA_STATE_DENSE_REGISTERS + i, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, i), @"Failed to add register %d in iteration %d", i, iteration);
+
+        STAssertTrue(stack.pop_state(), @"Failed to pop state");
+    }
+
+    /* The original state is unchanged */
+    STAssertEquals((uint8_t)1, stack.get_register_count(), @"Incorrect number of registers");
+    STAssertTrue(stack.get_register_rule(DWARF_CFA_STATE_DENSE_REGISTERS, &rule, &value), @"Failed to fetch info for entry");
+    STAssertEquals((uint64_t)1, value, @"Incorrect value");
+}
+
 /**
  * Test pushing and popping of register state.
  */
@@ -229,14 +372,25 @@ using namespace plcrash::async;
     
     /* Try pushing and initializing new state */
     STAssertTrue(stack.push_state(), @"Failed to push a new state");
-    STAssertEquals((uint8_t)0, stack.get_register_count(), @"New state should have a register count of 0");
+    STAssertEquals((uint8_t)(DWARF_CFA_STATE_MAX_REGISTERS/4), stack.get_register_count(), @"New state should inherit the register count");
+
+    /* The saved rules remain in force in the new state */
+    STAssertEquals(DWARF_CFA_STATE_CFA_TYPE_REGISTER, stack.get_cfa_rule().type(), @"CFA rule was not inherited");
+    STAssertEquals((dwarf_cfa_state_regnum_t)10, stack.get_cfa_rule().register_number(), @"Unexpected CFA register");
+    STAssertEquals((uint64_t)20, stack.get_cfa_rule().register_offset(), @"Unexpected CFA offset");
 
     for (int i = 0; i < (DWARF_CFA_STATE_MAX_REGISTERS/4); i++) {
+        plcrash_dwarf_cfa_reg_rule_t rule;
+        uint64_t value;
+
+        STAssertTrue(stack.get_register_rule(i, &rule, &value), @"Register was not inherited");
+        STAssertEquals((uint64_t)(DWARF_CFA_STATE_MAX_REGISTERS-i), value, @"Incorrect value");
+
         STAssertTrue(stack.set_register(i, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, i), @"Failed to add register");
-        STAssertEquals((uint8_t)(i+1), stack.get_register_count(), @"Incorrect number of registers");
+        STAssertEquals((uint8_t)(DWARF_CFA_STATE_MAX_REGISTERS/4), stack.get_register_count(), @"Overriding an inherited register changed the register count");
     }
 
-    STAssertEquals(DWARF_CFA_STATE_CFA_TYPE_UNDEFINED, stack.get_cfa_rule().type(), @"Unexpected initial CFA value");
+    stack.set_cfa_register(11, 30);
     
     /* Pop the state, verify that our original state was saved */
     STAssertTrue(stack.pop_state(), @"Failed to pop current state");
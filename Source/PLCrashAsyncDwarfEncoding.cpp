@@ -28,6 +28,8 @@
 #include "PLCrashFeatureConfig.h"
 
 #include <inttypes.h>
+#include <stdlib.h>
+#include <libkern/OSAtomic.h>
 
 #if PLCRASH_FEATURE_UNWIND_DWARF
 
@@ -63,10 +65,441 @@ plcrash_error_t dwarf_frame_reader::init (plcrash_async_mobject_t *mobj,
     _byteorder = byteorder;
     _debug_frame = debug_frame;
     _m64 = m64;
+    _hdr_mobj = NULL;
+    _fde_index = NULL;
     
     return PLCRASH_ESUCCESS;
 }
 
+/**
+ * @internal
+ *
+ * Read a single pointer-encoded value from the eh_frame_hdr section. Only the fixed-size encodings,
+ * along with DW_EH_PE_absptr, DW_EH_PE_pcrel, and DW_EH_PE_datarel (relative to the eh_frame_hdr section)
+ * application are supported; these are the only encodings produced by the standard toolchains.
+ *
+ * @param location The target-relative address of the value.
+ * @param encoding The DW_EH_PE_t encoding of the value.
+ * @param[out] result On success, the decoded value.
+ * @param[out] size On success, the size of the encoded value, in bytes.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTSUP if the encoding is unsupported, or another plcrash_error_t
+ * value if the value can not be read.
+ */
+plcrash_error_t dwarf_frame_reader::read_hdr_value (pl_vm_address_t location, uint8_t encoding, uint64_t *result, pl_vm_size_t *size) {
+    plcrash_error_t err;
+    uint64_t value;
+
+    /* Indirect values are not emitted by the standard toolchains in eh_frame_hdr */
+    if (encoding & DW_EH_PE_indirect) {
+        PLCF_DEBUG("Unsupported indirect eh_frame_hdr value encoding 0x%" PRIx8, encoding);
+        return PLCRASH_ENOTSUP;
+    }
+
+    /* Read the base value */
+    switch (encoding & DW_EH_PE_MASK_ENCODING) {
+        case DW_EH_PE_absptr:
+            if (_m64) {
+                if ((err = plcrash_async_mobject_read_uint64(_hdr_mobj, _byteorder, location, 0, &value)) != PLCRASH_ESUCCESS)
+                    return err;
+                *size = sizeof(uint64_t);
+            } else {
+                uint32_t v32;
+                if ((err = plcrash_async_mobject_read_uint32(_hdr_mobj, _byteorder, location, 0, &v32)) != PLCRASH_ESUCCESS)
+                    return err;
+                value = v32;
+                *size = sizeof(uint32_t);
+            }
+            break;
+
+        case DW_EH_PE_udata4: {
+            uint32_t v32;
+            if ((err = plcrash_async_mobject_read_uint32(_hdr_mobj, _byteorder, location, 0, &v32)) != PLCRASH_ESUCCESS)
+                return err;
+            value = v32;
+            *size = sizeof(uint32_t);
+            break;
+        }
+
+        case DW_EH_PE_sdata4: {
+            uint32_t v32;
+            if ((err = plcrash_async_mobject_read_uint32(_hdr_mobj, _byteorder, location, 0, &v32)) != PLCRASH_ESUCCESS)
+                return err;
+            value = (uint64_t) (int64_t) (int32_t) v32;
+            *size = sizeof(uint32_t);
+            break;
+        }
+
+        case DW_EH_PE_udata8:
+        case DW_EH_PE_sdata8:
+            if ((err = plcrash_async_mobject_read_uint64(_hdr_mobj, _byteorder, location, 0, &value)) != PLCRASH_ESUCCESS)
+                return err;
+            *size = sizeof(uint64_t);
+            break;
+
+        default:
+            PLCF_DEBUG("Unsupported eh_frame_hdr value encoding 0x%" PRIx8, encoding);
+            return PLCRASH_ENOTSUP;
+    }
+
+    /* Apply the relative offset, if any */
+    switch (encoding & 0x70) {
+        case DW_EH_PE_absptr:
+            break;
+
+        case DW_EH_PE_pcrel:
+            value += location;
+            break;
+
+        case DW_EH_PE_datarel:
+            value += plcrash_async_mobject_base_address(_hdr_mobj);
+            break;
+
+        default:
+            PLCF_DEBUG("Unsupported eh_frame_hdr value application 0x%" PRIx8, encoding);
+            return PLCRASH_ENOTSUP;
+    }
+
+    /* Truncate to the target's pointer width */
+    if (!_m64)
+        value = (uint32_t) value;
+
+    *result = value;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Configure the reader to use the binary search table provided by the eh_frame_hdr section referenced by @a eh_frame_hdr.
+ * When configured, FDE lookups that do not provide an offset hint will perform a binary search of the table, rather
+ * than a linear walk of the eh_frame data.
+ *
+ * The search table is only supported for eh_frame data; this method must not be called on a reader configured
+ * for debug_frame data.
+ *
+ * @param eh_frame_hdr The memory object containing the eh_frame_hdr data at the start address. This instance must
+ * survive for the lifetime of the reader.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t value if the table is not available or
+ * can not be used. On failure the reader will continue to perform linear FDE lookups.
+ */
+plcrash_error_t dwarf_frame_reader::set_search_table (plcrash_async_mobject_t *eh_frame_hdr) {
+    const pl_vm_address_t base_addr = plcrash_async_mobject_base_address(eh_frame_hdr);
+    plcrash_error_t err;
+
+    PLCF_ASSERT(!_debug_frame);
+    _hdr_mobj = NULL;
+
+    /* Read the header: version, eh_frame_ptr_enc, fde_count_enc, table_enc */
+    uint8_t *header = (uint8_t *) plcrash_async_mobject_remap_address(eh_frame_hdr, base_addr, 0, 4);
+    if (header == NULL) {
+        PLCF_DEBUG("The eh_frame_hdr header lies outside the mapped range");
+        return PLCRASH_EINVAL;
+    }
+
+    uint8_t version = header[0];
+    uint8_t eh_frame_ptr_enc = header[1];
+    uint8_t fde_count_enc = header[2];
+    uint8_t table_enc = header[3];
+
+    if (version != 1) {
+        PLCF_DEBUG("Unsupported eh_frame_hdr version %" PRIu8, version);
+        return PLCRASH_ENOTSUP;
+    }
+
+    /* A table is only usable if both the count and the table are present. */
+    if (fde_count_enc == DW_EH_PE_omit || table_enc == DW_EH_PE_omit)
+        return PLCRASH_ENOTFOUND;
+
+    /* Binary search requires fixed-size entries */
+    pl_vm_size_t value_size;
+    switch (table_enc & DW_EH_PE_MASK_ENCODING) {
+        case DW_EH_PE_udata4:
+        case DW_EH_PE_sdata4:
+            value_size = sizeof(uint32_t);
+            break;
+        case DW_EH_PE_udata8:
+        case DW_EH_PE_sdata8:
+            value_size = sizeof(uint64_t);
+            break;
+        case DW_EH_PE_absptr:
+            value_size = _m64 ? sizeof(uint64_t) : sizeof(uint32_t);
+            break;
+        default:
+            PLCF_DEBUG("Unsupported eh_frame_hdr table encoding 0x%" PRIx8, table_enc);
+            return PLCRASH_ENOTSUP;
+    }
+
+    /* Configure the mobject for reading of the header values */
+    _hdr_mobj = eh_frame_hdr;
+
+    /* Skip the eh_frame_ptr value; FDE addresses are resolved relative to our eh_frame mapping. */
+    pl_vm_address_t cursor = base_addr + 4;
+    if (eh_frame_ptr_enc != DW_EH_PE_omit) {
+        uint64_t eh_frame_ptr;
+        pl_vm_size_t size;
+        if ((err = read_hdr_value(cursor, eh_frame_ptr_enc, &eh_frame_ptr, &size)) != PLCRASH_ESUCCESS) {
+            _hdr_mobj = NULL;
+            return err;
+        }
+        cursor += size;
+    }
+
+    /* Read the FDE count */
+    uint64_t fde_count;
+    pl_vm_size_t size;
+    if ((err = read_hdr_value(cursor, fde_count_enc, &fde_count, &size)) != PLCRASH_ESUCCESS) {
+        _hdr_mobj = NULL;
+        return err;
+    }
+    cursor += size;
+
+    /* Verify that the full table lies within the mapped range */
+    if (fde_count > 0 && plcrash_async_mobject_remap_address(eh_frame_hdr, cursor, 0, (size_t) (fde_count * value_size * 2)) == NULL) {
+        PLCF_DEBUG("The eh_frame_hdr search table lies outside the mapped range");
+        _hdr_mobj = NULL;
+        return PLCRASH_EINVAL;
+    }
+
+    _table_addr = cursor;
+    _table_count = fde_count;
+    _table_encoding = table_enc;
+    _table_value_size = value_size;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Locate the frame descriptor entry for @a pc using the eh_frame_hdr binary search table.
+ *
+ * @param pc The PC value to search for.
+ * @param fde_info If the FDE is found, PLFRAME_ESUCCESS will be returned and @a fde_info will be initialized with the
+ * FDE data.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if no entry covers @a pc, or another plcrash_error_t
+ * value if a parsing error occurs.
+ */
+plcrash_error_t dwarf_frame_reader::search_table_find_fde (pl_vm_address_t pc, plcrash_async_dwarf_fde_info_t *fde_info) {
+    const pl_vm_address_t eh_frame_base = plcrash_async_mobject_base_address(_mobj);
+    const pl_vm_size_t entry_size = _table_value_size * 2;
+    plcrash_error_t err;
+    pl_vm_size_t size;
+
+    /* Find the last entry with an initial location <= pc */
+    uint64_t low = 0;
+    uint64_t high = _table_count;
+    while (low < high) {
+        uint64_t mid = low + ((high - low) / 2);
+        uint64_t initial_loc;
+
+        if ((err = read_hdr_value(_table_addr + (mid * entry_size), _table_encoding, &initial_loc, &size)) != PLCRASH_ESUCCESS)
+            return err;
+
+        if (initial_loc <= pc) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == 0)
+        return PLCRASH_ENOTFOUND;
+
+    /* Fetch the FDE address */
+    uint64_t fde_addr;
+    if ((err = read_hdr_value(_table_addr + ((low - 1) * entry_size) + _table_value_size, _table_encoding, &fde_addr, &size)) != PLCRASH_ESUCCESS)
+        return err;
+
+    if (fde_addr < eh_frame_base || fde_addr >= eh_frame_base + plcrash_async_mobject_length(_mobj)) {
+        PLCF_DEBUG("The eh_frame_hdr FDE address 0x%" PRIx64 " falls outside the eh_frame section", fde_addr);
+        return PLCRASH_EINVAL;
+    }
+
+    /* Decode the FDE */
+    if (_m64)
+        err = plcrash_async_dwarf_fde_info_init<uint64_t>(fde_info, _mobj, _byteorder, (pl_vm_address_t) fde_addr, _debug_frame);
+    else
+        err = plcrash_async_dwarf_fde_info_init<uint32_t>(fde_info, _mobj, _byteorder, (pl_vm_address_t) fde_addr, _debug_frame);
+    if (err != PLCRASH_ESUCCESS)
+        return err;
+
+    /* The table only provides start addresses; verify that our PC is within range */
+    if (pc >= fde_info->pc_start && pc < fde_info->pc_end)
+        return PLCRASH_ESUCCESS;
+
+    plcrash_async_dwarf_fde_info_free(fde_info);
+    return PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Configure the reader to use @a index, as built by plcrash_nasync_dwarf_build_fde_index() for the reader's eh_frame data.
+ * When configured, FDE lookups that do not provide an offset hint will perform a binary search of the index, without
+ * parsing any frame data other than the matching FDE.
+ *
+ * @param index The FDE index. This instance must survive for the lifetime of the reader.
+ * @param pc_base The target-relative address to which the index's PC offsets are relative.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if the index can not be used with this reader.
+ */
+plcrash_error_t dwarf_frame_reader::set_fde_index (const plcrash_async_macho_fde_index_t *index, pl_vm_address_t pc_base) {
+    if (_debug_frame)
+        return PLCRASH_EINVAL;
+
+    _fde_index = index;
+    _fde_index_base = pc_base;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Locate the frame descriptor entry for @a pc using the prebuilt FDE index.
+ *
+ * @param pc The PC value to search for.
+ * @param fde_info If the FDE is found, PLFRAME_ESUCCESS will be returned and @a fde_info will be initialized with the
+ * FDE data.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if no entry covers @a pc, or another plcrash_error_t
+ * value if a parsing error occurs.
+ */
+plcrash_error_t dwarf_frame_reader::index_find_fde (pl_vm_address_t pc, plcrash_async_dwarf_fde_info_t *fde_info) {
+    const plcrash_async_macho_fde_index_t *index = _fde_index;
+    plcrash_error_t err;
+
+    if (pc < _fde_index_base || pc - _fde_index_base > UINT32_MAX)
+        return PLCRASH_ENOTFOUND;
+
+    uint32_t pc_offset = (uint32_t) (pc - _fde_index_base);
+
+    /* Find the last entry with a start offset <= pc_offset */
+    uint32_t low = 0;
+    uint32_t high = index->count;
+    while (low < high) {
+        uint32_t mid = low + ((high - low) / 2);
+        if (index->entries[mid].pc_offset <= pc_offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == 0)
+        return PLCRASH_ENOTFOUND;
+
+    const plcrash_async_macho_fde_index_entry_t *entry = &index->entries[low - 1];
+    if (pc_offset - entry->pc_offset >= entry->pc_length)
+        return PLCRASH_ENOTFOUND;
+
+    if (entry->fde_offset >= plcrash_async_mobject_length(_mobj)) {
+        PLCF_DEBUG("The indexed FDE offset 0x%" PRIx32 " falls outside the eh_frame section", entry->fde_offset);
+        return PLCRASH_EINVAL;
+    }
+
+    /* Decode the FDE */
+    pl_vm_address_t fde_addr = plcrash_async_mobject_base_address(_mobj) + entry->fde_offset;
+    if (_m64)
+        err = plcrash_async_dwarf_fde_info_init<uint64_t>(fde_info, _mobj, _byteorder, fde_addr, _debug_frame);
+    else
+        err = plcrash_async_dwarf_fde_info_init<uint32_t>(fde_info, _mobj, _byteorder, fde_addr, _debug_frame);
+    if (err != PLCRASH_ESUCCESS)
+        return err;
+
+    /* Verify that the FDE matches the index */
+    if (pc >= fde_info->pc_start && pc < fde_info->pc_end)
+        return PLCRASH_ESUCCESS;
+
+    plcrash_async_dwarf_fde_info_free(fde_info);
+    return PLCRASH_EINVAL;
+}
+
+/**
+ * @internal
+ *
+ * Read the header of the CFI entry at @a cfi_entry.
+ *
+ * @param cfi_entry The target-relative address of the entry.
+ * @param[out] next_entry On success, the target-relative address of the following entry.
+ * @param[out] is_fde On success, true if the entry is a FDE, or false if it is a CIE.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the entry is a terminator, or another
+ * plcrash_error_t value if the entry can not be read.
+ */
+plcrash_error_t dwarf_frame_reader::read_entry (pl_vm_address_t cfi_entry, pl_vm_address_t *next_entry, bool *is_fde) {
+    plcrash_error_t err;
+
+    /* Fetch the entry length (and determine wether it's 64-bit or 32-bit) */
+    uint64_t length;
+    pl_vm_size_t length_size;
+    uint8_t dwarf_word_size;
+    
+    {
+        uint32_t *length32 = (uint32_t *) plcrash_async_mobject_remap_address(_mobj, cfi_entry, 0x0, sizeof(uint32_t));
+        if (length32 == NULL) {
+            PLCF_DEBUG("The current CFI entry 0x%" PRIx64 " header lies outside the mapped range", (uint64_t) cfi_entry);
+            return PLCRASH_EINVAL;
+        }
+        
+        if (_byteorder->swap32(*length32) == UINT32_MAX) {
+            uint64_t *length64 = (uint64_t *) plcrash_async_mobject_remap_address(_mobj, cfi_entry, sizeof(uint32_t), sizeof(uint64_t));
+            if (length64 == NULL) {
+                PLCF_DEBUG("The current CFI entry 0x%" PRIx64 " header lies outside the mapped range", (uint64_t) cfi_entry);
+                return PLCRASH_EINVAL;
+            }
+            
+            length = _byteorder->swap64(*length64);
+            length_size = sizeof(uint64_t) + sizeof(uint32_t);
+            dwarf_word_size = 8; // 64-bit DWARF
+        } else {
+            length = _byteorder->swap32(*length32);
+            length_size = sizeof(uint32_t);
+            dwarf_word_size = 4; // 32-bit DWARF
+        }
+    }
+    
+    /*
+     * APPLE EXTENSION
+     * Check for end marker, as per Apple's libunwind-35.1. It's unclear if this is defined by the DWARF 3 or 4 specifications; I could not
+     * find a reference to it.
+     
+     * Section 7.2.2 defines 0xfffffff0 - 0xffffffff as being reserved for extensions to the length
+     * field relative to the DWARF 2 standard. There is no explicit reference to the use of an 0 value.
+     *
+     * In section 7.2.1, the value of 0 is defined as being reserved as an error value in the encodings for
+     * "attribute names, attribute forms, base type encodings, location operations, languages, line number program
+     * opcodes, macro information entries and tag names to represent an error condition or unknown value."
+     *
+     * Section 7.2.2 doesn't justify the usage of 0x0 as a termination marker, but given that Apple's code relies on it,
+     * we will also do so here.
+     */
+    if (length == 0x0)
+        return PLCRASH_ENOTFOUND;
+    
+    /* Calculate the next entry address; the length_size addition is known-safe, as we were able to successfully read the length from *cfi_entry */
+    if (!plcrash_async_address_apply_offset(cfi_entry+length_size, length, next_entry)) {
+        PLCF_DEBUG("Entry length size overflows the CFI address");
+        return PLCRASH_EINVAL;
+    }
+    
+    /* Fetch the entry id */
+    uint64_t cie_id;
+    
+    if ((err = plcrash_async_dwarf_read_uintmax64(_mobj, _byteorder, cfi_entry, length_size, dwarf_word_size, &cie_id)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("The current CFI entry 0x%" PRIx64 " cie_id lies outside the mapped range", (uint64_t) cfi_entry);
+        return PLCRASH_EINVAL;
+    }
+    
+    /* debug_frame uses UINT?_MAX to denote CIE entries; eh_frame uses a type of 0x0. */
+    bool is_cie;
+    if (_debug_frame)
+        is_cie = (dwarf_word_size == 8 && cie_id == UINT64_MAX) || (dwarf_word_size == 4 && cie_id == UINT32_MAX);
+    else
+        is_cie = (cie_id == 0x0);
+
+    *is_fde = !is_cie;
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * Locate the frame descriptor entry for @a pc, if available.
  *
@@ -81,16 +514,33 @@ plcrash_error_t dwarf_frame_reader::init (plcrash_async_mobject_t *mobj,
  *
  * @return Returns PLFRAME_ESUCCCESS on success, or one of the remaining error codes if a DWARF parsing error occurs. If
  * the entry can not be found, PLFRAME_ENOTFOUND will be returned.
+ *
+ * If a FDE index has been configured via set_fde_index() or a search table has been configured via set_search_table(), and
+ * @a offset is 0, the index or table will be used to perform a binary search; otherwise, the frame data will be walked linearly.
  */
 plcrash_error_t dwarf_frame_reader::find_fde (pl_vm_off_t offset,
                                               pl_vm_address_t pc,
                                               plcrash_async_dwarf_fde_info_t *fde_info)
 {
-    const plcrash_async_byteorder_t *byteorder = _byteorder;
     const pl_vm_address_t base_addr = plcrash_async_mobject_base_address(_mobj);
     const pl_vm_address_t end_addr = base_addr + plcrash_async_mobject_length(_mobj);
     
     plcrash_error_t err;
+
+    /* Prefer the prebuilt index, followed by the binary search table. If neither can be used, fall back on walking the frame data. */
+    if (_fde_index != NULL && offset == 0) {
+        err = index_find_fde(pc, fde_info);
+        if (err == PLCRASH_ESUCCESS || err == PLCRASH_ENOTFOUND)
+            return err;
+
+        PLCF_DEBUG("FDE index lookup failed, falling back on a linear FDE search: %d", err);
+    } else if (_hdr_mobj != NULL && offset == 0) {
+        err = search_table_find_fde(pc, fde_info);
+        if (err == PLCRASH_ESUCCESS || err == PLCRASH_ENOTFOUND)
+            return err;
+
+        PLCF_DEBUG("eh_frame_hdr lookup failed, falling back on a linear FDE search: %d", err);
+    }
     
     /* Apply the FDE offset */
     pl_vm_address_t cfi_entry = base_addr;
@@ -106,93 +556,23 @@ plcrash_error_t dwarf_frame_reader::find_fde (pl_vm_off_t offset,
     
     /* Iterate over table entries */
     while (cfi_entry < end_addr) {
-        /* Fetch the entry length (and determine wether it's 64-bit or 32-bit) */
-        uint64_t length;
-        pl_vm_size_t length_size;
-        uint8_t dwarf_word_size;
-        
-        {
-            uint32_t *length32 = (uint32_t *) plcrash_async_mobject_remap_address(_mobj, cfi_entry, 0x0, sizeof(uint32_t));
-            if (length32 == NULL) {
-                PLCF_DEBUG("The current CFI entry 0x%" PRIx64 " header lies outside the mapped range", (uint64_t) cfi_entry);
-                return PLCRASH_EINVAL;
-            }
-            
-            if (byteorder->swap32(*length32) == UINT32_MAX) {
-                uint64_t *length64 = (uint64_t *) plcrash_async_mobject_remap_address(_mobj, cfi_entry, sizeof(uint32_t), sizeof(uint64_t));
-                if (length64 == NULL) {
-                    PLCF_DEBUG("The current CFI entry 0x%" PRIx64 " header lies outside the mapped range", (uint64_t) cfi_entry);
-                    return PLCRASH_EINVAL;
-                }
-                
-                length = byteorder->swap64(*length64);
-                length_size = sizeof(uint64_t) + sizeof(uint32_t);
-                dwarf_word_size = 8; // 64-bit DWARF
-            } else {
-                length = byteorder->swap32(*length32);
-                length_size = sizeof(uint32_t);
-                dwarf_word_size = 4; // 32-bit DWARF
-            }
-        }
-        
-        /*
-         * APPLE EXTENSION
-         * Check for end marker, as per Apple's libunwind-35.1. It's unclear if this is defined by the DWARF 3 or 4 specifications; I could not
-         * find a reference to it.
-         
-         * Section 7.2.2 defines 0xfffffff0 - 0xffffffff as being reserved for extensions to the length
-         * field relative to the DWARF 2 standard. There is no explicit reference to the use of an 0 value.
-         *
-         * In section 7.2.1, the value of 0 is defined as being reserved as an error value in the encodings for
-         * "attribute names, attribute forms, base type encodings, location operations, languages, line number program
-         * opcodes, macro information entries and tag names to represent an error condition or unknown value."
-         *
-         * Section 7.2.2 doesn't justify the usage of 0x0 as a termination marker, but given that Apple's code relies on it,
-         * we will also do so here.
-         */
-        if (length == 0x0)
-            return PLCRASH_ENOTFOUND;
-        
-        /* Calculate the next entry address; the length_size addition is known-safe, as we were able to successfully read the length from *cfi_entry */
         pl_vm_address_t next_cfi_entry;
-        if (!plcrash_async_address_apply_offset(cfi_entry+length_size, length, &next_cfi_entry)) {
-            PLCF_DEBUG("Entry length size overflows the CFI address");
-            return PLCRASH_EINVAL;
-        }
-        
-        /* Fetch the entry id */
-        uint64_t cie_id;
-        
-        if ((err = plcrash_async_dwarf_read_uintmax64(_mobj, byteorder, cfi_entry, length_size, dwarf_word_size, &cie_id)) != PLCRASH_ESUCCESS) {
-            PLCF_DEBUG("The current CFI entry 0x%" PRIx64 " cie_id lies outside the mapped range", (uint64_t) cfi_entry);
-            return PLCRASH_EINVAL;
-        }
-        
-        /* Check for (and skip) CIE entries. */
-        {
-            bool is_cie = false;
-            
-            /* debug_frame uses UINT?_MAX to denote CIE entries. */
-            if (_debug_frame && ((dwarf_word_size == 8 && cie_id == UINT64_MAX) || (dwarf_word_size == 4 && cie_id == UINT32_MAX)))
-                is_cie = true;
-            
-            /* eh_frame uses a type of 0x0 to denote CIE entries. */
-            if (!_debug_frame && cie_id == 0x0)
-                is_cie = true;
-            
-            /* If not a FDE, skip */
-            if (is_cie) {
-                /* Not a FDE -- skip */
-                cfi_entry = next_cfi_entry;
-                continue;
-            }
+        bool is_fde;
+
+        if ((err = read_entry(cfi_entry, &next_cfi_entry, &is_fde)) != PLCRASH_ESUCCESS)
+            return err;
+
+        /* Not a FDE -- skip */
+        if (!is_fde) {
+            cfi_entry = next_cfi_entry;
+            continue;
         }
         
         /* Decode the FDE */
         if (_m64)
-            err = plcrash_async_dwarf_fde_info_init<uint64_t>(fde_info, _mobj, byteorder, cfi_entry, _debug_frame);
+            err = plcrash_async_dwarf_fde_info_init<uint64_t>(fde_info, _mobj, _byteorder, cfi_entry, _debug_frame);
         else
-            err = plcrash_async_dwarf_fde_info_init<uint32_t>(fde_info, _mobj, byteorder, cfi_entry, _debug_frame);
+            err = plcrash_async_dwarf_fde_info_init<uint32_t>(fde_info, _mobj, _byteorder, cfi_entry, _debug_frame);
         if (err != PLCRASH_ESUCCESS)
             return err;
         
@@ -207,6 +587,181 @@ plcrash_error_t dwarf_frame_reader::find_fde (pl_vm_off_t offset,
     return PLCRASH_ENOTFOUND;
 }
 
+/* plcrash_async_macho_fde_index_entry_t PC comparison function */
+static int plcrash_nasync_dwarf_fde_index_compare (const void *a, const void *b) {
+    const plcrash_async_macho_fde_index_entry_t *lhs = (const plcrash_async_macho_fde_index_entry_t *) a;
+    const plcrash_async_macho_fde_index_entry_t *rhs = (const plcrash_async_macho_fde_index_entry_t *) b;
+
+    if (lhs->pc_offset < rhs->pc_offset)
+        return -1;
+    else if (lhs->pc_offset > rhs->pc_offset)
+        return 1;
+    return 0;
+}
+
+/**
+ * Walk all entries in the reader's frame data, recording the PC range and section offset of each FDE.
+ *
+ * @param pc_base The target-relative address to which the recorded PC offsets will be relative.
+ * @param entries The array to which entries will be written, or NULL to only count the FDEs.
+ * @param capacity The number of entries that may be written to @a entries. Additional FDEs will be counted, but not
+ * recorded.
+ * @param[out] count On success, the total number of FDEs found.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTSUP if a FDE can not be represented relative to @a pc_base,
+ * or another plcrash_error_t value if the frame data can not be parsed.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t dwarf_frame_reader::build_fde_index (pl_vm_address_t pc_base,
+                                                     plcrash_async_macho_fde_index_entry_t *entries,
+                                                     uint32_t capacity,
+                                                     uint32_t *count)
+{
+    const pl_vm_address_t base_addr = plcrash_async_mobject_base_address(_mobj);
+    const pl_vm_address_t end_addr = base_addr + plcrash_async_mobject_length(_mobj);
+    pl_vm_address_t cfi_entry = base_addr;
+    plcrash_error_t err;
+
+    *count = 0;
+    while (cfi_entry < end_addr) {
+        pl_vm_address_t next_cfi_entry;
+        bool is_fde;
+
+        if ((err = read_entry(cfi_entry, &next_cfi_entry, &is_fde)) != PLCRASH_ESUCCESS) {
+            /* A terminator ends the frame data */
+            if (err == PLCRASH_ENOTFOUND)
+                break;
+            return err;
+        }
+
+        if (is_fde) {
+            plcrash_async_dwarf_fde_info_t fde_info;
+
+            if (_m64)
+                err = plcrash_async_dwarf_fde_info_init<uint64_t>(&fde_info, _mobj, _byteorder, cfi_entry, _debug_frame);
+            else
+                err = plcrash_async_dwarf_fde_info_init<uint32_t>(&fde_info, _mobj, _byteorder, cfi_entry, _debug_frame);
+            if (err != PLCRASH_ESUCCESS)
+                return err;
+
+            pl_vm_address_t pc_start = fde_info.pc_start;
+            pl_vm_address_t pc_end = fde_info.pc_end;
+            plcrash_async_dwarf_fde_info_free(&fde_info);
+
+            /* Empty FDEs can never match */
+            if (pc_end > pc_start) {
+                if (pc_start < pc_base || pc_end - pc_base > UINT32_MAX || cfi_entry - base_addr > UINT32_MAX) {
+                    PLCF_DEBUG("FDE at 0x%" PRIx64 " can not be represented in the FDE index", (uint64_t) cfi_entry);
+                    return PLCRASH_ENOTSUP;
+                }
+
+                if (entries != NULL && *count < capacity) {
+                    entries[*count].pc_offset = (uint32_t) (pc_start - pc_base);
+                    entries[*count].pc_length = (uint32_t) (pc_end - pc_start);
+                    entries[*count].fde_offset = (uint32_t) (cfi_entry - base_addr);
+                }
+
+                (*count)++;
+            }
+        }
+
+        cfi_entry = next_cfi_entry;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Build a PC-sorted index of the FDEs within the __eh_frame section of @a image, allowing the DWARF frame reader to
+ * perform a binary search rather than a linear walk of the section at crash time. Mach-O images do not provide an
+ * __eh_frame_hdr search table, and FDEs are otherwise only directly addressable when referenced by the image's
+ * compact unwind data. The index is allocated within a dedicated allocator, and will be released by
+ * plcrash_nasync_macho_free(). If an index has already been built, no action is taken.
+ *
+ * @param image The image for which an index should be built.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the image has no __eh_frame section, or another
+ * error result on failure.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_dwarf_build_fde_index (plcrash_async_macho_t *image) {
+    plcrash_async_mobject_t storage;
+    plcrash_async_mobject_t *eh_frame;
+    plcrash_async_allocator_t *allocator;
+    plcrash_async_macho_fde_index_t *index;
+    dwarf_frame_reader reader;
+    plcrash_error_t err;
+    uint32_t count;
+
+    if (image->fde_index != NULL)
+        return PLCRASH_ESUCCESS;
+
+    if ((err = plcrash_async_macho_map_known_section_cached(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_EH_FRAME, &storage, &eh_frame)) != PLCRASH_ESUCCESS)
+        return err;
+
+    if ((err = reader.init(eh_frame, image->byteorder, image->m64, false)) != PLCRASH_ESUCCESS)
+        goto cleanup;
+
+    /* Count the FDEs */
+    if ((err = reader.build_fde_index(image->header_addr, NULL, 0, &count)) != PLCRASH_ESUCCESS)
+        goto cleanup;
+
+    /* Allocate the index */
+    {
+        size_t index_size = sizeof(plcrash_async_macho_fde_index_t) + (sizeof(plcrash_async_macho_fde_index_entry_t) * count);
+
+        if ((err = plcrash_async_allocator_new(&allocator, index_size, 0)) != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("Could not allocate a %" PRIu32 " entry FDE index for %s: %d", count, image->name, err);
+            goto cleanup;
+        }
+
+        if ((index = (plcrash_async_macho_fde_index_t *) plcrash_async_allocator_alloc(allocator, index_size, true)) == NULL) {
+            PLCF_DEBUG("Could not allocate a %" PRIu32 " entry FDE index for %s", count, image->name);
+            plcrash_async_allocator_free(allocator);
+            err = PLCRASH_ENOMEM;
+            goto cleanup;
+        }
+    }
+
+    index->allocator = allocator;
+
+    /* Populate the index */
+    if ((err = reader.build_fde_index(image->header_addr, index->entries, count, &index->count)) != PLCRASH_ESUCCESS) {
+        plcrash_async_allocator_free(allocator);
+        goto cleanup;
+    }
+
+    if (index->count > count)
+        index->count = count;
+
+    /*
+     * Sort by PC. A stable sort is required; when multiple FDEs share a start address, the linear search
+     * returns the first such FDE, and we discard the remainder.
+     */
+    if (index->count > 0) {
+        mergesort(index->entries, index->count, sizeof(index->entries[0]), plcrash_nasync_dwarf_fde_index_compare);
+
+        uint32_t unique = 1;
+        for (uint32_t i = 1; i < index->count; i++) {
+            if (index->entries[i].pc_offset != index->entries[unique - 1].pc_offset)
+                index->entries[unique++] = index->entries[i];
+        }
+        index->count = unique;
+    }
+
+    /* Publish the index. If another index was concurrently published, discard ours. */
+    if (!OSAtomicCompareAndSwapPtrBarrier(NULL, index, (void **) &image->fde_index))
+        plcrash_async_allocator_free(allocator);
+
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    plcrash_async_macho_mapped_section_release(&storage, eh_frame);
+    return err;
+}
+
 /**
  * @}
  */
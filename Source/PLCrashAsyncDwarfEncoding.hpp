@@ -61,11 +61,24 @@ public:
                           bool m64,
                           bool debug_frame);
     
+    plcrash_error_t set_search_table (plcrash_async_mobject_t *eh_frame_hdr);
+    plcrash_error_t set_fde_index (const plcrash_async_macho_fde_index_t *index, pl_vm_address_t pc_base);
+
     plcrash_error_t find_fde (pl_vm_off_t offset,
                               pl_vm_address_t pc,
                               plcrash_async_dwarf_fde_info_t *fde_info);
 
+    plcrash_error_t build_fde_index (pl_vm_address_t pc_base,
+                                     plcrash_async_macho_fde_index_entry_t *entries,
+                                     uint32_t capacity,
+                                     uint32_t *count);
+
 private:
+    plcrash_error_t read_entry (pl_vm_address_t cfi_entry, pl_vm_address_t *next_entry, bool *is_fde);
+    plcrash_error_t read_hdr_value (pl_vm_address_t location, uint8_t encoding, uint64_t *result, pl_vm_size_t *size);
+    plcrash_error_t search_table_find_fde (pl_vm_address_t pc, plcrash_async_dwarf_fde_info_t *fde_info);
+    plcrash_error_t index_find_fde (pl_vm_address_t pc, plcrash_async_dwarf_fde_info_t *fde_info);
+
     /** A memory object containing the DWARF data at the starting address. */
     plcrash_async_mobject_t *_mobj;
     
@@ -77,10 +90,33 @@ private:
     
     /** True if this is a debug_frame section */
     bool _debug_frame;
+
+    /** A memory object containing the eh_frame_hdr data, or NULL if no binary search table is available. */
+    plcrash_async_mobject_t *_hdr_mobj;
+
+    /** The target-relative address of the first eh_frame_hdr search table entry. */
+    pl_vm_address_t _table_addr;
+
+    /** The number of entries in the eh_frame_hdr search table. */
+    uint64_t _table_count;
+
+    /** The DW_EH_PE_t encoding of the eh_frame_hdr search table entries. */
+    uint8_t _table_encoding;
+
+    /** The size, in bytes, of a single eh_frame_hdr search table value. Each entry contains two values. */
+    pl_vm_size_t _table_value_size;
+
+    /** The prebuilt FDE index, or NULL if unavailable. */
+    const plcrash_async_macho_fde_index_t *_fde_index;
+
+    /** The target-relative address to which the @a _fde_index PC offsets are relative. */
+    pl_vm_address_t _fde_index_base;
 };
     
 }}
 
+plcrash_error_t plcrash_nasync_dwarf_build_fde_index (plcrash_async_macho_t *image);
+
 /**
  * @}
  */
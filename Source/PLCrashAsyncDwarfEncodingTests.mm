@@ -154,6 +154,106 @@ using namespace plcrash::async;
     STAssertEquals(PLCRASH_ENOTFOUND, err, @"FDE should not have been found");
 }
 
+/**
+ * Test FDE lookup via an eh_frame_hdr binary search table.
+ */
+- (void) testFindEHFrameDescriptorEntryWithSearchTable {
+    const plcrash_async_byteorder_t *byteorder = plcrash_async_macho_byteorder(&_image);
+    plcrash_async_dwarf_fde_info_t fde_info;
+    plcrash_async_mobject_t hdr_mobj;
+    plcrash_error_t err;
+
+    /* Build a single-entry table referencing the second (FDE) entry in the eh_frame test data. */
+    struct __attribute__((packed)) {
+        uint8_t version;
+        uint8_t eh_frame_ptr_enc;
+        uint8_t fde_count_enc;
+        uint8_t table_enc;
+        uint32_t fde_count;
+        uint64_t initial_loc;
+        uint64_t fde_addr;
+    } hdr;
+
+    hdr.version = 1;
+    hdr.eh_frame_ptr_enc = DW_EH_PE_omit;
+    hdr.fde_count_enc = DW_EH_PE_udata4;
+    hdr.table_enc = DW_EH_PE_udata8;
+    hdr.fde_count = byteorder->swap32(1);
+    hdr.initial_loc = byteorder->swap64(PL_CFI_EH_FRAME_PC);
+    hdr.fde_addr = byteorder->swap64(plcrash_async_mobject_base_address(&_eh_frame) + sizeof(pl_cfi_entry));
+
+    err = plcrash_async_mobject_init(&hdr_mobj, mach_task_self(), (pl_vm_address_t) &hdr, sizeof(hdr), true);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to initialize mobj");
+
+    err = _eh_reader.set_search_table(&hdr_mobj);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to configure the search table");
+
+    err = _eh_reader.find_fde(0x0, PL_CFI_EH_FRAME_PC+PL_CFI_EH_FRAME_PC_RANGE-1, &fde_info);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"FDE search failed");
+
+    if (_m64) {
+        STAssertEquals(fde_info.fde_offset, (pl_vm_address_t) ((sizeof(pl_cfi_entry)) + PL_CFI_LEN_SIZE_64), @"Incorrect offset");
+    } else {
+        STAssertEquals(fde_info.fde_offset, (pl_vm_address_t) ((sizeof(pl_cfi_entry)) + PL_CFI_LEN_SIZE_32), @"Incorrect offset");
+    }
+    plcrash_async_dwarf_fde_info_free(&fde_info);
+
+    /* Verify that PC values outside of the table's range return ENOTFOUND */
+    err = _eh_reader.find_fde(0x0, PL_CFI_EH_FRAME_PC-1, &fde_info);
+    STAssertEquals(PLCRASH_ENOTFOUND, err, @"FDE should not have been found");
+
+    err = _eh_reader.find_fde(0x0, PL_CFI_EH_FRAME_PC+PL_CFI_EH_FRAME_PC_RANGE, &fde_info);
+    STAssertEquals(PLCRASH_ENOTFOUND, err, @"FDE should not have been found");
+
+    plcrash_async_mobject_free(&hdr_mobj);
+}
+
+/**
+ * Test FDE lookup via a prebuilt FDE index.
+ */
+- (void) testFindEHFrameDescriptorEntryWithIndex {
+    plcrash_async_dwarf_fde_info_t fde_info;
+    plcrash_error_t err;
+    uint32_t count;
+
+    /* Count the FDEs; the test PC values are absolute, and are indexed relative to 0x0 */
+    err = _eh_reader.build_fde_index(0x0, NULL, 0, &count);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to count FDEs");
+    STAssertTrue(count > 0, @"No FDEs found");
+
+    /* Build the index */
+    size_t index_size = sizeof(plcrash_async_macho_fde_index_t) + (sizeof(plcrash_async_macho_fde_index_entry_t) * count);
+    plcrash_async_macho_fde_index_t *index = (plcrash_async_macho_fde_index_t *) calloc(1, index_size);
+    err = _eh_reader.build_fde_index(0x0, index->entries, count, &index->count);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to build the FDE index");
+    STAssertEquals(index->count, count, @"Incorrect FDE count");
+
+    err = _eh_reader.set_fde_index(index, 0x0);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to configure the FDE index");
+
+    err = _eh_reader.find_fde(0x0, PL_CFI_EH_FRAME_PC+PL_CFI_EH_FRAME_PC_RANGE-1, &fde_info);
+    STAssertEquals(PLCRASH_ESUCCESS, err, @"FDE search failed");
+
+    if (_m64) {
+        STAssertEquals(fde_info.fde_offset, (pl_vm_address_t) ((sizeof(pl_cfi_entry)) + PL_CFI_LEN_SIZE_64), @"Incorrect offset");
+    } else {
+        STAssertEquals(fde_info.fde_offset, (pl_vm_address_t) ((sizeof(pl_cfi_entry)) + PL_CFI_LEN_SIZE_32), @"Incorrect offset");
+    }
+    plcrash_async_dwarf_fde_info_free(&fde_info);
+
+    /* Verify that PC values outside of the indexed range return ENOTFOUND */
+    err = _eh_reader.find_fde(0x0, PL_CFI_EH_FRAME_PC-1, &fde_info);
+    STAssertEquals(PLCRASH_ENOTFOUND, err, @"FDE should not have been found");
+
+    err = _eh_reader.find_fde(0x0, PL_CFI_EH_FRAME_PC+PL_CFI_EH_FRAME_PC_RANGE, &fde_info);
+    STAssertEquals(PLCRASH_ENOTFOUND, err, @"FDE should not have been found");
+
+    /* The index can not be used with debug_frame data */
+    STAssertEquals(PLCRASH_EINVAL, _debug_reader.set_fde_index(index, 0x0), @"Expected the index to be rejected");
+
+    free(index);
+}
+
 - (void) testFindDebugFrameDescriptorEntry {
     plcrash_error_t err;
     plcrash_async_dwarf_fde_info_t fde_info;
@@ -25,6 +25,7 @@
  */
 
 #include <inttypes.h>
+#include <libkern/OSAtomic.h>
 
 #include "dwarf_stack.hpp"
 #include "dwarf_opstream.hpp"
@@ -44,94 +45,78 @@ using namespace plcrash::async;
  * @{
  */
 
+/** The maximum number of operations supported in a compiled DWARF expression. */
+#define DWARF_EXPR_COMPILED_MAX_OPS 32
+
+/** The maximum opcode length, in bytes, of a DWARF expression that will be compiled and cached. */
+#define DWARF_EXPR_COMPILED_MAX_LENGTH 64
+
+/** The number of entries in each compiled DWARF expression cache. */
+#define DWARF_EXPR_CACHE_SIZE 8
+
 /**
- * Evaluate a DWARF expression, as defined in the DWARF 4 Specification, Section 2.5. This
- * internal implementation is templated to support 32-bit and 64-bit evaluation.
- *
- * @param mobj The memory object from which the expression opcodes will be read.
- * @param task The task from which any DWARF expression memory loads will be performed.
- * @param thread_state The thread state against which the expression will be evaluated.
- * @param byteorder The byte order of the data referenced by @a mobj and @a thread_state.
- * @param address The task-relative address within @a mobj at which the opcodes will be fetched.
- * @param offset An offset to be applied to @a address.
- * @param length The total length of the opcodes readable at @a address + @a offset.
- * @param initial_state Initial set of values to be pushed onto the evaluation stack. The values will be pushed
- * on their natural order; eg, the top of the stack will be the last value in this array. If the initial stack
- * state should be empty, this value may be NULL, and @a initial_count should be 0.
- * @param initial_count Number of values in the @a initial_state array.
- * @param result[out] On success, the evaluation result. As per DWARF 3 section 2.5.1, this will be
- * the top-most element on the evaluation stack. If the stack is empty, an error will be returned
- * and no value will be written to this parameter.
+ * @internal
  *
- * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t values
- * on failure. If an invalid opcode is detected, PLCRASH_ENOTSUP will be returned. If the stack
- * is empty upon termination of evaluation, PLCRASH_EINVAL will be returned.
+ * A single decoded DWARF expression operation, including any immediate operands.
  *
- * @todo Consider defining updated status codes or error handling to provide more structured
- * error data on failure.
+ * @tparam machine_ptr The native machine pointer type for the target data.
  */
-template <typename machine_ptr, typename machine_ptr_s>
-plcrash_error_t plcrash_async_dwarf_expression_eval (plcrash_async_mobject_t *mobj,
-                                                     task_t task,
-                                                     const plcrash_async_thread_state_t *thread_state,
-                                                     const plcrash_async_byteorder_t *byteorder,
-                                                     pl_vm_address_t address,
-                                                     pl_vm_off_t offset,
-                                                     pl_vm_size_t length,
-                                                     machine_ptr initial_state[],
-                                                     size_t initial_count,
-                                                     machine_ptr *result)
-{
-    // TODO: Review the use of an up-to-800 byte stack allocation; we may want to replace this with
-    // use of the new async-safe allocator.
-    dwarf_stack<machine_ptr, 100> stack;
-    dwarf_opstream opstream;
-    plcrash_error_t err;
+template <typename machine_ptr>
+struct dwarf_expr_op {
+    /** The DW_OP_t opcode. */
+    uint8_t opcode;
 
-    /* Configure the opstream */
-    if ((err = opstream.init(mobj, byteorder, address, offset, length)) != PLCRASH_ESUCCESS)
-        return err;
-    
-    /*
-     * Note that the below value macros all cast data to the appropriate target machine word size.
-     * This will result in overflows, as defined in the DWARF specification; the unsigned overflow
-     * behavior is defined, and as per DWARF and C, the signed overflow behavior is not.
+    /**
+     * The decoded immediate operands, cast to the target machine word size. For DW_OP_bregx, the first operand
+     * is the register number, and the second the offset. For DW_OP_skip and DW_OP_bra, the first operand is the
+     * signed 2-byte branch offset.
      */
-    
-    /* A position-advancing read macro that uses GCC/clang's compound statement value extension, returning PLCRASH_EINVAL
-     * if the read extends beyond the mapped range. */
+    machine_ptr operands[2];
+
+    /** For DW_OP_skip and DW_OP_bra within a compiled program, the index of the branch target operation. */
+    size_t target;
+};
+
+/*
+ * Note that the below value macros all cast data to the appropriate target machine word size.
+ * This will result in overflows, as defined in the DWARF specification; the unsigned overflow
+ * behavior is defined, and as per DWARF and C, the signed overflow behavior is not.
+ */
+
+/* A position-advancing read macro that uses GCC/clang's compound statement value extension, returning PLCRASH_EINVAL
+ * if the read extends beyond the mapped range. */
 #define dw_expr_read_int(_type) ({ \
     _type v; \
-    if (!opstream.read_intU<_type>(&v)) { \
+    if (!opstream->read_intU<_type>(&v)) { \
         PLCF_DEBUG("Read of size %zu exceeds mapped range", sizeof(v)); \
         return PLCRASH_EINVAL; \
     } \
     v; \
 })
-    
-    /* A position-advancing uleb128 read macro that uses GCC/clang's compound statement value extension, returning an error
-     * if the read fails. */
+
+/* A position-advancing uleb128 read macro that uses GCC/clang's compound statement value extension, returning an error
+ * if the read fails. */
 #define dw_expr_read_uleb128() ({ \
     uint64_t v; \
-    if (!opstream.read_uleb128(&v)) { \
+    if (!opstream->read_uleb128(&v)) { \
         PLCF_DEBUG("Read of ULEB128 value failed"); \
         return PLCRASH_EINVAL; \
     } \
     (machine_ptr) v; \
 })
 
-    /* A position-advancing sleb128 read macro that uses GCC/clang's compound statement value extension, returning an error
-     * if the read fails. */
+/* A position-advancing sleb128 read macro that uses GCC/clang's compound statement value extension, returning an error
+ * if the read fails. */
 #define dw_expr_read_sleb128() ({ \
     int64_t v; \
-    if (!opstream.read_sleb128(&v)) { \
+    if (!opstream->read_sleb128(&v)) { \
         PLCF_DEBUG("Read of SLEB128 value failed"); \
         return PLCRASH_EINVAL; \
     } \
     (machine_ptr_s) v; \
 })
 
-    /* Macro to fetch register valeus; handles unsupported register numbers and missing registers values */
+/* Macro to fetch register valeus; handles unsupported register numbers and missing registers values */
 #define dw_thread_regval(_dw_regnum) ({ \
     plcrash_regnum_t rn; \
     if (!plcrash_async_thread_state_map_dwarf_to_reg(thread_state, _dw_regnum, &rn)) { \
@@ -148,557 +133,1163 @@ plcrash_error_t plcrash_async_dwarf_expression_eval (plcrash_async_mobject_t *mo
     (machine_ptr) val; \
 })
 
-    /* A push macro that handles reporting of stack overflow errors */
-#define dw_expr_push(v) if (!stack.push(v)) { \
+/* A push macro that handles reporting of stack overflow errors */
+#define dw_expr_push(v) if (!stack->push(v)) { \
     PLCF_DEBUG("Hit stack limit; cannot push further values"); \
     return PLCRASH_EINTERNAL; \
 }
-    
-    /* A pop macro that handles reporting of stack underflow errors */
-#define dw_expr_pop(v) if (!stack.pop(v)) { \
+
+/* A pop macro that handles reporting of stack underflow errors */
+#define dw_expr_pop(v) if (!stack->pop(v)) { \
     PLCF_DEBUG("Pop on an empty stack"); \
     return PLCRASH_EINTERNAL; \
 }
-    
-    /* Populate the initial state */
-    for (size_t i = 0; i < initial_count; i++)
-        dw_expr_push(initial_state[i]);
 
-    uint8_t opcode;
-    while (opstream.read_intU(&opcode)) {
-        switch (opcode) {
-            case DW_OP_lit0:
-            case DW_OP_lit1:
-            case DW_OP_lit2:
-            case DW_OP_lit3:
-            case DW_OP_lit4:
-            case DW_OP_lit5:
-            case DW_OP_lit6:
-            case DW_OP_lit7:
-            case DW_OP_lit8:
-            case DW_OP_lit9:
-            case DW_OP_lit10:
-            case DW_OP_lit11:
-            case DW_OP_lit12:
-            case DW_OP_lit13:
-            case DW_OP_lit14:
-            case DW_OP_lit15:
-            case DW_OP_lit16:
-            case DW_OP_lit17:
-            case DW_OP_lit18:
-            case DW_OP_lit19:
-            case DW_OP_lit20:
-            case DW_OP_lit21:
-            case DW_OP_lit22:
-            case DW_OP_lit23:
-            case DW_OP_lit24:
-            case DW_OP_lit25:
-            case DW_OP_lit26:
-            case DW_OP_lit27:
-            case DW_OP_lit28:
-            case DW_OP_lit29:
-            case DW_OP_lit30:
-            case DW_OP_lit31:
-                dw_expr_push(opcode-DW_OP_lit0);
-                break;
-                
-            case DW_OP_const1u:
-                dw_expr_push(dw_expr_read_int(uint8_t));
-                break;
-
-            case DW_OP_const1s:
-                dw_expr_push(dw_expr_read_int(int8_t));
-                break;
-                
-            case DW_OP_const2u:
-                dw_expr_push(dw_expr_read_int(uint16_t));
-                break;
-                
-            case DW_OP_const2s:
-                dw_expr_push((int16_t)dw_expr_read_int(int16_t));
-                break;
-                
-            case DW_OP_const4u:
-                dw_expr_push(dw_expr_read_int(uint32_t));
-                break;
-                
-            case DW_OP_const4s:
-                dw_expr_push((int32_t) dw_expr_read_int(int32_t));
-                break;
-                
-            case DW_OP_const8u:
-                dw_expr_push(dw_expr_read_int(uint64_t));
-                break;
-                
-            case DW_OP_const8s:
-                dw_expr_push((int64_t) dw_expr_read_int(int64_t));
-                break;
-                
-            case DW_OP_constu:
-                dw_expr_push(dw_expr_read_uleb128());
-                break;
-                
-            case DW_OP_consts:
-                dw_expr_push(dw_expr_read_sleb128());
-                break;
-                
-            case DW_OP_breg0:
-			case DW_OP_breg1:
-			case DW_OP_breg2:
-			case DW_OP_breg3:
-			case DW_OP_breg4:
-			case DW_OP_breg5:
-			case DW_OP_breg6:
-			case DW_OP_breg7:
-			case DW_OP_breg8:
-			case DW_OP_breg9:
-			case DW_OP_breg10:
-			case DW_OP_breg11:
-			case DW_OP_breg12:
-			case DW_OP_breg13:
-			case DW_OP_breg14:
-			case DW_OP_breg15:
-			case DW_OP_breg16:
-			case DW_OP_breg17:
-			case DW_OP_breg18:
-			case DW_OP_breg19:
-			case DW_OP_breg20:
-			case DW_OP_breg21:
-			case DW_OP_breg22:
-			case DW_OP_breg23:
-			case DW_OP_breg24:
-			case DW_OP_breg25:
-			case DW_OP_breg26:
-			case DW_OP_breg27:
-			case DW_OP_breg28:
-			case DW_OP_breg29:
-			case DW_OP_breg30:
-			case DW_OP_breg31:
-                dw_expr_push(dw_thread_regval(opcode - DW_OP_breg0) + dw_expr_read_sleb128());
-                break;
-                
-            case DW_OP_bregx:
-                dw_expr_push(dw_thread_regval(dw_expr_read_sleb128()) + dw_expr_read_sleb128());
-                
-            case DW_OP_dup:
-                if (!stack.dup()) {
-                    PLCF_DEBUG("DW_OP_dup on an empty stack");
-                    return PLCRASH_EINVAL;
-                }
-                break;
-                
-            case DW_OP_drop: {
-                if (!stack.drop()) {
-                    PLCF_DEBUG("DW_OP_drop on an empty stack");
-                    return PLCRASH_EINVAL;
-                }
-                break;
-            }
-                
-            case DW_OP_pick:
-                if (!stack.pick(dw_expr_read_int(uint8_t))) {
-                    PLCF_DEBUG("DW_OP_pick on invalid index");
-                    return PLCRASH_EINVAL;
-                }
-                break;
+/**
+ * Decode the immediate operands of @a opcode from @a opstream.
+ *
+ * @param opstream The opcode stream, positioned immediately after @a opcode.
+ * @param opcode The opcode to be decoded.
+ * @param[out] op On success, the decoded operation.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if the operands could not be read, or PLCRASH_ENOTSUP
+ * if @a opcode is not supported.
+ */
+template <typename machine_ptr, typename machine_ptr_s>
+static plcrash_error_t dwarf_expr_decode_op (dwarf_opstream *opstream, uint8_t opcode, dwarf_expr_op<machine_ptr> *op) {
+    op->opcode = opcode;
+    op->operands[0] = 0;
+    op->operands[1] = 0;
+    op->target = 0;
 
-            case DW_OP_over:
-                if (!stack.pick(1)) {
-                    PLCF_DEBUG("DW_OP_over on stack with < 2 elements");
-                    return PLCRASH_EINVAL;
-                }
-                break;
-                
-            case DW_OP_swap:
-                if (!stack.swap()) {
-                    PLCF_DEBUG("DW_OP_swap on stack with < 2 elements");
-                    return PLCRASH_EINVAL;
-                }
-                break;
-                
-            case DW_OP_rot:
-                if (!stack.rotate()) {
-                    PLCF_DEBUG("DW_OP_rot on stack with < 3 elements");
-                    return PLCRASH_EINVAL;
-                }
-                break;
-            
-                
-            case DW_OP_xderef:
-                /* This is identical to deref, except that it consumes an additional stack value
-                 * containing the address space of the address. We don't support any systems with multiple
-                 * address spaces, so we simply excise this value from the stack and fall through to the
-                 * deref implementation */
-
-                /* Move the address space value to the top of the stack, and then drop it */
-                if (!stack.swap()) {
-                    PLCF_DEBUG("DW_OP_xderef on stack with < 2 elements");
-                    return PLCRASH_EINVAL;
-                }
-                
-                /* This can't fail after the swap suceeded */
-                stack.drop();
-                
-            case DW_OP_deref: {
-                machine_ptr addr;
-                machine_ptr value;
-
-                dw_expr_pop(&addr);
-                if ((err = plcrash_async_task_memcpy(task, addr, 0, &value, sizeof(value))) != PLCRASH_ESUCCESS) {
-                    PLCF_DEBUG("DW_OP_deref referenced an invalid target address 0x%" PRIx64, (uint64_t) addr);
-                    return err;
-                }
+    switch (opcode) {
+        case DW_OP_lit0:
+        case DW_OP_lit1:
+        case DW_OP_lit2:
+        case DW_OP_lit3:
+        case DW_OP_lit4:
+        case DW_OP_lit5:
+        case DW_OP_lit6:
+        case DW_OP_lit7:
+        case DW_OP_lit8:
+        case DW_OP_lit9:
+        case DW_OP_lit10:
+        case DW_OP_lit11:
+        case DW_OP_lit12:
+        case DW_OP_lit13:
+        case DW_OP_lit14:
+        case DW_OP_lit15:
+        case DW_OP_lit16:
+        case DW_OP_lit17:
+        case DW_OP_lit18:
+        case DW_OP_lit19:
+        case DW_OP_lit20:
+        case DW_OP_lit21:
+        case DW_OP_lit22:
+        case DW_OP_lit23:
+        case DW_OP_lit24:
+        case DW_OP_lit25:
+        case DW_OP_lit26:
+        case DW_OP_lit27:
+        case DW_OP_lit28:
+        case DW_OP_lit29:
+        case DW_OP_lit30:
+        case DW_OP_lit31:
+        case DW_OP_dup:
+        case DW_OP_drop:
+        case DW_OP_over:
+        case DW_OP_swap:
+        case DW_OP_rot:
+        case DW_OP_xderef:
+        case DW_OP_deref:
+        case DW_OP_abs:
+        case DW_OP_and:
+        case DW_OP_div:
+        case DW_OP_minus:
+        case DW_OP_mod:
+        case DW_OP_mul:
+        case DW_OP_neg:
+        case DW_OP_not:
+        case DW_OP_or:
+        case DW_OP_plus:
+        case DW_OP_shl:
+        case DW_OP_shr:
+        case DW_OP_shra:
+        case DW_OP_xor:
+        case DW_OP_le:
+        case DW_OP_ge:
+        case DW_OP_eq:
+        case DW_OP_lt:
+        case DW_OP_gt:
+        case DW_OP_ne:
+        case DW_OP_nop:
+            break;
 
-                dw_expr_push(value);
-                
-                break;
-            }
-            case DW_OP_xderef_size:
-                /* This is identical to deref_size, except that it consumes an additional stack value
-                 * containing the address space of the address. We don't support any systems with multiple
-                 * address spaces, so we simply excise this value from the stack and fall through to the
-                 * deref implementation */
-                
-                /* Move the address space value to the top of the stack, and then drop it */
-                if (!stack.swap()) {
-                    PLCF_DEBUG("DW_OP_xderef_size on stack with < 2 elements");
-                    return PLCRASH_EINVAL;
-                }
+        case DW_OP_const1u:
+            op->operands[0] = dw_expr_read_int(uint8_t);
+            break;
 
-                /* This can't fail after the swap suceeded */
-                stack.drop();
+        case DW_OP_const1s:
+            op->operands[0] = dw_expr_read_int(int8_t);
+            break;
 
-            case DW_OP_deref_size: {
-                /* Fetch the target size */
-                uint8_t size = dw_expr_read_int(uint8_t);
-                if (size > sizeof(machine_ptr)) {
-                    PLCF_DEBUG("DW_OP_deref_size specified a size larger than the native machine word");
-                    return PLCRASH_EINVAL;
-                }
-                
-                /* Pop the address from the stack */
-                machine_ptr addr;
-                dw_expr_pop(&addr);
-
-                /* Perform the read */
-                #define readval(_type) case sizeof(_type): { \
-                    _type r; \
-                    if ((err = plcrash_async_task_memcpy(task, (pl_vm_address_t)addr, 0, &r, sizeof(_type))) != PLCRASH_ESUCCESS) { \
-                        PLCF_DEBUG("DW_OP_deref_size referenced an invalid target address 0x%" PRIx64, (uint64_t) addr); \
-                        return err; \
-                    } \
-                    value = r; \
-                    break; \
-                }
-                machine_ptr value = 0;
-                switch (size) {
-                    readval(uint8_t);
-                    readval(uint16_t);
-                    readval(uint32_t);
-                    readval(uint64_t);
-
-                    default:
-                        PLCF_DEBUG("DW_OP_deref_size specified an unsupported size of %" PRIu8, size);
-                        return PLCRASH_EINVAL;
-                }
-                #undef readval
+        case DW_OP_const2u:
+            op->operands[0] = dw_expr_read_int(uint16_t);
+            break;
 
-                dw_expr_push(value);
-                
-                break;
-            }
-                
-            case DW_OP_abs: {
-                machine_ptr_s v;
-                dw_expr_pop((machine_ptr *)&v);
-                if (v < 0) {
-                    dw_expr_push(-v);
-                } else {
-                    dw_expr_push(v);
-                }
-                break;
-            }
+        case DW_OP_const2s:
+            op->operands[0] = (int16_t) dw_expr_read_int(int16_t);
+            break;
 
-            case DW_OP_and: {
-                machine_ptr v1, v2;
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);                
-                dw_expr_push(v1 & v2);
-                break;
-            }
-                
-            case DW_OP_div: {
-                machine_ptr_s divisor;
-                machine_ptr dividend;
-                
-                dw_expr_pop((machine_ptr *) &divisor);
-                dw_expr_pop(&dividend);
-                
-                if (divisor == 0) {
-                    PLCF_DEBUG("DW_OP_div attempted divide by zero");
-                    return PLCRASH_EINVAL;
-                }
-                
-                machine_ptr result = dividend / divisor;
-                dw_expr_push(result);
-                break;
-            }
-                
-            case DW_OP_minus: {
-                machine_ptr minuend, subtrahend;
-                
-                dw_expr_pop(&subtrahend);
-                dw_expr_pop(&minuend);
-                dw_expr_push(minuend - subtrahend);
-                break;
-            }
-                
-            case DW_OP_mod: {
-                machine_ptr divisor;
-                machine_ptr dividend;
-                
-                dw_expr_pop(&divisor);
-                dw_expr_pop(&dividend);
-                
-                if (divisor == 0) {
-                    PLCF_DEBUG("DW_OP_mod attempted divide by zero");
-                    return PLCRASH_EINVAL;
-                }
-                
-                machine_ptr result = dividend % divisor;
-                dw_expr_push(result);
-                break;
+        case DW_OP_const4u:
+            op->operands[0] = dw_expr_read_int(uint32_t);
+            break;
+
+        case DW_OP_const4s:
+            op->operands[0] = (int32_t) dw_expr_read_int(int32_t);
+            break;
+
+        case DW_OP_const8u:
+            op->operands[0] = dw_expr_read_int(uint64_t);
+            break;
+
+        case DW_OP_const8s:
+            op->operands[0] = (int64_t) dw_expr_read_int(int64_t);
+            break;
+
+        case DW_OP_constu:
+        case DW_OP_plus_uconst:
+            op->operands[0] = dw_expr_read_uleb128();
+            break;
+
+        case DW_OP_consts:
+        case DW_OP_breg0:
+        case DW_OP_breg1:
+        case DW_OP_breg2:
+        case DW_OP_breg3:
+        case DW_OP_breg4:
+        case DW_OP_breg5:
+        case DW_OP_breg6:
+        case DW_OP_breg7:
+        case DW_OP_breg8:
+        case DW_OP_breg9:
+        case DW_OP_breg10:
+        case DW_OP_breg11:
+        case DW_OP_breg12:
+        case DW_OP_breg13:
+        case DW_OP_breg14:
+        case DW_OP_breg15:
+        case DW_OP_breg16:
+        case DW_OP_breg17:
+        case DW_OP_breg18:
+        case DW_OP_breg19:
+        case DW_OP_breg20:
+        case DW_OP_breg21:
+        case DW_OP_breg22:
+        case DW_OP_breg23:
+        case DW_OP_breg24:
+        case DW_OP_breg25:
+        case DW_OP_breg26:
+        case DW_OP_breg27:
+        case DW_OP_breg28:
+        case DW_OP_breg29:
+        case DW_OP_breg30:
+        case DW_OP_breg31:
+            op->operands[0] = dw_expr_read_sleb128();
+            break;
+
+        case DW_OP_bregx:
+            op->operands[0] = dw_expr_read_sleb128();
+            op->operands[1] = dw_expr_read_sleb128();
+            break;
+
+        case DW_OP_pick:
+        case DW_OP_xderef_size:
+        case DW_OP_deref_size:
+            op->operands[0] = dw_expr_read_int(uint8_t);
+            break;
+
+        case DW_OP_skip:
+        case DW_OP_bra:
+            op->operands[0] = dw_expr_read_int(int16_t);
+            break;
+
+        // Not implemented -- fall through
+        case DW_OP_fbreg:
+            /* Unimplemented */
+
+        case DW_OP_call2:
+        case DW_OP_call4:
+        case DW_OP_call_ref:
+            /*
+             * As per DWARF 3, Section 6.4.2 Call Frame Instructions DW_OP_call2, DW_OP_call4 and DW_OP_call_ref operators
+             * are not meaningful in an operand of these instructions because there is no mapping from call frame information
+             * to any corresponding debugging compilation unit information, thus there is no way to interpret the call offset.
+             *
+             * If this implementation is further extended for use outside of CFI evaluation, this opcode should be implemented.
+            */
+
+        case DW_OP_push_object_address:
+            /*
+             * As per DWARF 3, Section 6.4.2 Call Frame Instructions, DW_OP_push_object_address is not meaningful in an operand of these
+             * instructions because there is no object context to provide a value to push.
+             *
+             * If this implementation is further extended for use outside of CFI evaluation, this opcode should be implemented.
+             */
+
+        case DW_OP_form_tls_address:
+            /* The structure of TLS data on Darwin is implementation private. */
+
+        case DW_OP_call_frame_cfa:
+            /*
+             * As per DWARF 3, Section 6.4.2 Call Frame Instructions, DW_OP_call_frame_cfa is not meaningful in an operand of these
+             * instructions because its use would be circular.
+             *
+             * If this implementation is further extended for use outside of CFI evaluation, this opcode should be implemented.
+             */
+
+        default:
+            PLCF_DEBUG("Unsupported opcode 0x%" PRIx8, opcode);
+            return PLCRASH_ENOTSUP;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Execute a single decoded DWARF expression operation.
+ *
+ * @param task The task from which any DWARF expression memory loads will be performed.
+ * @param thread_state The thread state against which the expression will be evaluated.
+ * @param stack The evaluation stack.
+ * @param op The operation to be executed.
+ * @param[out] branch Set to true if the operation is a DW_OP_skip or DW_OP_bra, and the branch should be taken; false otherwise.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t values on failure.
+ */
+template <typename machine_ptr, typename machine_ptr_s, size_t stack_depth>
+static plcrash_error_t dwarf_expr_exec_op (task_t task,
+                                           const plcrash_async_thread_state_t *thread_state,
+                                           dwarf_stack<machine_ptr, stack_depth> *stack,
+                                           const dwarf_expr_op<machine_ptr> *op,
+                                           bool *branch)
+{
+    plcrash_error_t err;
+    uint8_t opcode = op->opcode;
+
+    *branch = false;
+
+    switch (opcode) {
+        case DW_OP_lit0:
+        case DW_OP_lit1:
+        case DW_OP_lit2:
+        case DW_OP_lit3:
+        case DW_OP_lit4:
+        case DW_OP_lit5:
+        case DW_OP_lit6:
+        case DW_OP_lit7:
+        case DW_OP_lit8:
+        case DW_OP_lit9:
+        case DW_OP_lit10:
+        case DW_OP_lit11:
+        case DW_OP_lit12:
+        case DW_OP_lit13:
+        case DW_OP_lit14:
+        case DW_OP_lit15:
+        case DW_OP_lit16:
+        case DW_OP_lit17:
+        case DW_OP_lit18:
+        case DW_OP_lit19:
+        case DW_OP_lit20:
+        case DW_OP_lit21:
+        case DW_OP_lit22:
+        case DW_OP_lit23:
+        case DW_OP_lit24:
+        case DW_OP_lit25:
+        case DW_OP_lit26:
+        case DW_OP_lit27:
+        case DW_OP_lit28:
+        case DW_OP_lit29:
+        case DW_OP_lit30:
+        case DW_OP_lit31:
+            dw_expr_push(opcode-DW_OP_lit0);
+            break;
+
+        case DW_OP_const1u:
+        case DW_OP_const1s:
+        case DW_OP_const2u:
+        case DW_OP_const2s:
+        case DW_OP_const4u:
+        case DW_OP_const4s:
+        case DW_OP_const8u:
+        case DW_OP_const8s:
+        case DW_OP_constu:
+        case DW_OP_consts:
+            dw_expr_push(op->operands[0]);
+            break;
+
+        case DW_OP_breg0:
+        case DW_OP_breg1:
+        case DW_OP_breg2:
+        case DW_OP_breg3:
+        case DW_OP_breg4:
+        case DW_OP_breg5:
+        case DW_OP_breg6:
+        case DW_OP_breg7:
+        case DW_OP_breg8:
+        case DW_OP_breg9:
+        case DW_OP_breg10:
+        case DW_OP_breg11:
+        case DW_OP_breg12:
+        case DW_OP_breg13:
+        case DW_OP_breg14:
+        case DW_OP_breg15:
+        case DW_OP_breg16:
+        case DW_OP_breg17:
+        case DW_OP_breg18:
+        case DW_OP_breg19:
+        case DW_OP_breg20:
+        case DW_OP_breg21:
+        case DW_OP_breg22:
+        case DW_OP_breg23:
+        case DW_OP_breg24:
+        case DW_OP_breg25:
+        case DW_OP_breg26:
+        case DW_OP_breg27:
+        case DW_OP_breg28:
+        case DW_OP_breg29:
+        case DW_OP_breg30:
+        case DW_OP_breg31:
+            dw_expr_push(dw_thread_regval(opcode - DW_OP_breg0) + op->operands[0]);
+            break;
+
+        case DW_OP_bregx:
+            dw_expr_push(dw_thread_regval((machine_ptr_s) op->operands[0]) + op->operands[1]);
+
+        case DW_OP_dup:
+            if (!stack->dup()) {
+                PLCF_DEBUG("DW_OP_dup on an empty stack");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_mul: {
-                machine_ptr v1, v2;
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                dw_expr_push(v1 * v2);
-                break;
+            break;
+
+        case DW_OP_drop: {
+            if (!stack->drop()) {
+                PLCF_DEBUG("DW_OP_drop on an empty stack");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_neg: {
-                machine_ptr_s svalue;
-                dw_expr_pop((machine_ptr *) &svalue);
-                dw_expr_push(0 - svalue);
-                break;
+            break;
+        }
+
+        case DW_OP_pick:
+            if (!stack->pick(op->operands[0])) {
+                PLCF_DEBUG("DW_OP_pick on invalid index");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_not: {
-                machine_ptr v;
-                dw_expr_pop(&v);
-                dw_expr_push(~v);
-                break;
+            break;
+
+        case DW_OP_over:
+            if (!stack->pick(1)) {
+                PLCF_DEBUG("DW_OP_over on stack with < 2 elements");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_or: {
-                machine_ptr v1, v2;
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                dw_expr_push(v1 | v2);
-                break;
+            break;
+
+        case DW_OP_swap:
+            if (!stack->swap()) {
+                PLCF_DEBUG("DW_OP_swap on stack with < 2 elements");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_plus: {
-                machine_ptr v1, v2;
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                dw_expr_push(v1 + v2);
-                break;
+            break;
+
+        case DW_OP_rot:
+            if (!stack->rotate()) {
+                PLCF_DEBUG("DW_OP_rot on stack with < 3 elements");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_plus_uconst: {
-                machine_ptr v1 = dw_expr_read_uleb128();
-                machine_ptr v2;
-                
-                dw_expr_pop(&v2);
-                dw_expr_push(v1 + v2);
-                break;
+            break;
+
+
+        case DW_OP_xderef:
+            /* This is identical to deref, except that it consumes an additional stack value
+             * containing the address space of the address. We don't support any systems with multiple
+             * address spaces, so we simply excise this value from the stack and fall through to the
+             * deref implementation */
+
+            /* Move the address space value to the top of the stack, and then drop it */
+            if (!stack->swap()) {
+                PLCF_DEBUG("DW_OP_xderef on stack with < 2 elements");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_shl: {
-                machine_ptr shift;
-                machine_ptr value;
-                
-                dw_expr_pop(&shift);
-                dw_expr_pop(&value);
-                
-                dw_expr_push(value << shift);
-                break;
+
+            /* This can't fail after the swap suceeded */
+            stack->drop();
+
+        case DW_OP_deref: {
+            machine_ptr addr;
+            machine_ptr value;
+
+            dw_expr_pop(&addr);
+            if ((err = plcrash_async_task_memcpy(task, addr, 0, &value, sizeof(value))) != PLCRASH_ESUCCESS) {
+                PLCF_DEBUG("DW_OP_deref referenced an invalid target address 0x%" PRIx64, (uint64_t) addr);
+                return err;
             }
-                
-            case DW_OP_shr: {
-                machine_ptr shift;
-                machine_ptr value;
-                
-                dw_expr_pop(&shift);
-                dw_expr_pop(&value);
-                
-                dw_expr_push(value >> shift);
-                break;
+
+            dw_expr_push(value);
+
+            break;
+        }
+        case DW_OP_xderef_size:
+            /* This is identical to deref_size, except that it consumes an additional stack value
+             * containing the address space of the address. We don't support any systems with multiple
+             * address spaces, so we simply excise this value from the stack and fall through to the
+             * deref implementation */
+
+            /* Move the address space value to the top of the stack, and then drop it */
+            if (!stack->swap()) {
+                PLCF_DEBUG("DW_OP_xderef_size on stack with < 2 elements");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_shra: {
-                machine_ptr shift;
-                machine_ptr_s value;
-                
-                dw_expr_pop(&shift);
-                dw_expr_pop((machine_ptr *)&value);
-                
-                dw_expr_push(value >> shift);
-                break;
+
+            /* This can't fail after the swap suceeded */
+            stack->drop();
+
+        case DW_OP_deref_size: {
+            /* Fetch the target size */
+            uint8_t size = (uint8_t) op->operands[0];
+            if (size > sizeof(machine_ptr)) {
+                PLCF_DEBUG("DW_OP_deref_size specified a size larger than the native machine word");
+                return PLCRASH_EINVAL;
             }
-                
-            case DW_OP_xor: {
-                machine_ptr v1, v2;
-                
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                
-                dw_expr_push(v1 ^ v2);
-                break;
+
+            /* Pop the address from the stack */
+            machine_ptr addr;
+            dw_expr_pop(&addr);
+
+            /* Perform the read */
+            #define readval(_type) case sizeof(_type): { \
+                _type r; \
+                if ((err = plcrash_async_task_memcpy(task, (pl_vm_address_t)addr, 0, &r, sizeof(_type))) != PLCRASH_ESUCCESS) { \
+                    PLCF_DEBUG("DW_OP_deref_size referenced an invalid target address 0x%" PRIx64, (uint64_t) addr); \
+                    return err; \
+                } \
+                value = r; \
+                break; \
             }
-                
-            case DW_OP_le: {
-                machine_ptr v1, v2;
-                
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                
-                dw_expr_push((v2 <= v1));
-                break;
+            machine_ptr value = 0;
+            switch (size) {
+                readval(uint8_t);
+                readval(uint16_t);
+                readval(uint32_t);
+                readval(uint64_t);
+
+                default:
+                    PLCF_DEBUG("DW_OP_deref_size specified an unsupported size of %" PRIu8, size);
+                    return PLCRASH_EINVAL;
             }
+            #undef readval
+
+            dw_expr_push(value);
+
+            break;
+        }
 
-            case DW_OP_ge: {
-                machine_ptr v1, v2;
-                
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                
-                dw_expr_push((v2 >= v1));
-                break;
+        case DW_OP_abs: {
+            machine_ptr_s v;
+            dw_expr_pop((machine_ptr *)&v);
+            if (v < 0) {
+                dw_expr_push(-v);
+            } else {
+                dw_expr_push(v);
             }
-                
-            case DW_OP_eq: {
-                machine_ptr v1, v2;
-                
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                
-                dw_expr_push((v2 == v1));
-                break;
+            break;
+        }
+
+        case DW_OP_and: {
+            machine_ptr v1, v2;
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);                
+            dw_expr_push(v1 & v2);
+            break;
+        }
+            
+        case DW_OP_div: {
+            machine_ptr_s divisor;
+            machine_ptr dividend;
+            
+            dw_expr_pop((machine_ptr *) &divisor);
+            dw_expr_pop(&dividend);
+            
+            if (divisor == 0) {
+                PLCF_DEBUG("DW_OP_div attempted divide by zero");
+                return PLCRASH_EINVAL;
             }
-    
-            case DW_OP_lt: {
-                machine_ptr v1, v2;
-                
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                
-                dw_expr_push((v2 < v1));
-                break;
+            
+            machine_ptr result = dividend / divisor;
+            dw_expr_push(result);
+            break;
+        }
+            
+        case DW_OP_minus: {
+            machine_ptr minuend, subtrahend;
+            
+            dw_expr_pop(&subtrahend);
+            dw_expr_pop(&minuend);
+            dw_expr_push(minuend - subtrahend);
+            break;
+        }
+            
+        case DW_OP_mod: {
+            machine_ptr divisor;
+            machine_ptr dividend;
+            
+            dw_expr_pop(&divisor);
+            dw_expr_pop(&dividend);
+            
+            if (divisor == 0) {
+                PLCF_DEBUG("DW_OP_mod attempted divide by zero");
+                return PLCRASH_EINVAL;
             }
+            
+            machine_ptr result = dividend % divisor;
+            dw_expr_push(result);
+            break;
+        }
+            
+        case DW_OP_mul: {
+            machine_ptr v1, v2;
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            dw_expr_push(v1 * v2);
+            break;
+        }
+            
+        case DW_OP_neg: {
+            machine_ptr_s svalue;
+            dw_expr_pop((machine_ptr *) &svalue);
+            dw_expr_push(0 - svalue);
+            break;
+        }
+            
+        case DW_OP_not: {
+            machine_ptr v;
+            dw_expr_pop(&v);
+            dw_expr_push(~v);
+            break;
+        }
+            
+        case DW_OP_or: {
+            machine_ptr v1, v2;
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            dw_expr_push(v1 | v2);
+            break;
+        }
+            
+        case DW_OP_plus: {
+            machine_ptr v1, v2;
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            dw_expr_push(v1 + v2);
+            break;
+        }
+            
+        case DW_OP_plus_uconst: {
+            machine_ptr v1 = op->operands[0];
+            machine_ptr v2;
+            
+            dw_expr_pop(&v2);
+            dw_expr_push(v1 + v2);
+            break;
+        }
+            
+        case DW_OP_shl: {
+            machine_ptr shift;
+            machine_ptr value;
+            
+            dw_expr_pop(&shift);
+            dw_expr_pop(&value);
+            
+            dw_expr_push(value << shift);
+            break;
+        }
+            
+        case DW_OP_shr: {
+            machine_ptr shift;
+            machine_ptr value;
+            
+            dw_expr_pop(&shift);
+            dw_expr_pop(&value);
+            
+            dw_expr_push(value >> shift);
+            break;
+        }
+            
+        case DW_OP_shra: {
+            machine_ptr shift;
+            machine_ptr_s value;
+            
+            dw_expr_pop(&shift);
+            dw_expr_pop((machine_ptr *)&value);
+            
+            dw_expr_push(value >> shift);
+            break;
+        }
+            
+        case DW_OP_xor: {
+            machine_ptr v1, v2;
+            
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            
+            dw_expr_push(v1 ^ v2);
+            break;
+        }
+            
+        case DW_OP_le: {
+            machine_ptr v1, v2;
+            
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            
+            dw_expr_push((v2 <= v1));
+            break;
+        }
 
-            case DW_OP_gt: {
-                machine_ptr v1, v2;
-                
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                
-                dw_expr_push((v2 > v1));
-                break;
-            }
+        case DW_OP_ge: {
+            machine_ptr v1, v2;
+            
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            
+            dw_expr_push((v2 >= v1));
+            break;
+        }
+            
+        case DW_OP_eq: {
+            machine_ptr v1, v2;
+            
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            
+            dw_expr_push((v2 == v1));
+            break;
+        }
 
-            case DW_OP_ne: {
-                machine_ptr v1, v2;
-                
-                dw_expr_pop(&v1);
-                dw_expr_pop(&v2);
-                
-                dw_expr_push((v2 != v1));
-                break;
-            }
-                
-            case DW_OP_skip: {
-                int16_t offset = dw_expr_read_int(int16_t);
-                if (!opstream.skip(offset)) {
-                    PLCF_DEBUG("DW_OP_skip offset %" PRId16 " falls outside of opcode range", offset);
-                    return PLCRASH_EINVAL;
-                }
-                break;
+        case DW_OP_lt: {
+            machine_ptr v1, v2;
+            
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            
+            dw_expr_push((v2 < v1));
+            break;
+        }
+
+        case DW_OP_gt: {
+            machine_ptr v1, v2;
+            
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            
+            dw_expr_push((v2 > v1));
+            break;
+        }
+
+        case DW_OP_ne: {
+            machine_ptr v1, v2;
+            
+            dw_expr_pop(&v1);
+            dw_expr_pop(&v2);
+            
+            dw_expr_push((v2 != v1));
+            break;
+        }
+            
+        case DW_OP_skip:
+            *branch = true;
+            break;
+
+        case DW_OP_bra: {
+            machine_ptr cond;
+
+            dw_expr_pop(&cond);
+            if (cond != 0)
+                *branch = true;
+            break;
+        }
+
+        case DW_OP_nop: // no-op
+            break;
+
+        default:
+            PLCF_DEBUG("Unsupported opcode 0x%" PRIx8, opcode);
+            return PLCRASH_ENOTSUP;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * A DWARF expression that has been decoded into a fixed-size array of operations, with all immediate operands
+ * decoded and all branch offsets resolved to operation indices. Evaluation of a compiled expression requires
+ * no further access to the expression's opcode data.
+ *
+ * @tparam machine_ptr The native machine pointer type for the target data.
+ * @tparam machine_ptr_s The native machine signed pointer type for the target data.
+ */
+template <typename machine_ptr, typename machine_ptr_s>
+class dwarf_expr_program {
+public:
+    /**
+     * Compile the expression opcodes at @a address + @a offset.
+     *
+     * @param mobj The memory object from which the expression opcodes will be read.
+     * @param byteorder The byte order of the data referenced by @a mobj.
+     * @param address The task-relative address within @a mobj at which the opcodes will be fetched.
+     * @param offset An offset to be applied to @a address.
+     * @param length The total length of the opcodes readable at @a address + @a offset.
+     *
+     * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t value if the expression
+     * could not be compiled. On failure, the expression must be evaluated via plcrash_async_dwarf_expression_interpret().
+     */
+    plcrash_error_t compile (plcrash_async_mobject_t *mobj,
+                             const plcrash_async_byteorder_t *byteorder,
+                             pl_vm_address_t address,
+                             pl_vm_off_t offset,
+                             pl_vm_size_t length)
+    {
+        dwarf_opstream opstream;
+        uintptr_t starts[DWARF_EXPR_COMPILED_MAX_OPS];
+        pl_vm_off_t branch_targets[DWARF_EXPR_COMPILED_MAX_OPS];
+        plcrash_error_t err;
+        uint8_t opcode;
+
+        _count = 0;
+
+        if ((err = opstream.init(mobj, byteorder, address, offset, length)) != PLCRASH_ESUCCESS)
+            return err;
+
+        /* Decode all operations, recording their starting offsets */
+        while (opstream.read_intU(&opcode)) {
+            if (_count == DWARF_EXPR_COMPILED_MAX_OPS) {
+                PLCF_DEBUG("Expression exceeds the maximum compiled operation count");
+                return PLCRASH_ENOMEM;
             }
-                
-            case DW_OP_bra: {
-                int16_t offset = dw_expr_read_int(int16_t);
-                machine_ptr cond;
-
-                dw_expr_pop(&cond);
-                if (cond != 0) {
-                    if (!opstream.skip(offset)) {
-                        PLCF_DEBUG("DW_OP_bra offset %" PRId16 " falls outside of opcode range", offset);
-                        return PLCRASH_EINVAL;
+
+            dwarf_expr_op<machine_ptr> *op = &_ops[_count];
+            starts[_count] = opstream.get_position() - 1;
+
+            if ((err = dwarf_expr_decode_op<machine_ptr, machine_ptr_s>(&opstream, opcode, op)) != PLCRASH_ESUCCESS)
+                return err;
+
+            /* Branch offsets are relative to the end of the branch operation */
+            if (opcode == DW_OP_skip || opcode == DW_OP_bra)
+                branch_targets[_count] = (pl_vm_off_t) opstream.get_position() + (int16_t) op->operands[0];
+
+            _count++;
+        }
+
+        /* Resolve branch targets to operation indices. A branch to the end of the expression terminates evaluation. */
+        uintptr_t end = opstream.get_position();
+        for (size_t i = 0; i < _count; i++) {
+            if (_ops[i].opcode != DW_OP_skip && _ops[i].opcode != DW_OP_bra)
+                continue;
+
+            bool resolved = false;
+            if (branch_targets[i] == (pl_vm_off_t) end) {
+                _ops[i].target = _count;
+                resolved = true;
+            } else {
+                for (size_t t = 0; t < _count; t++) {
+                    if ((pl_vm_off_t) starts[t] == branch_targets[i]) {
+                        _ops[i].target = t;
+                        resolved = true;
+                        break;
                     }
                 }
-                break;
             }
 
-            case DW_OP_nop: // no-op
-                break;
-                
-            // Not implemented -- fall through
-            case DW_OP_fbreg:
-                /* Unimplemented */
-                
-            case DW_OP_call2:
-            case DW_OP_call4:
-            case DW_OP_call_ref:
-                /*
-                 * As per DWARF 3, Section 6.4.2 Call Frame Instructions DW_OP_call2, DW_OP_call4 and DW_OP_call_ref operators
-                 * are not meaningful in an operand of these instructions because there is no mapping from call frame information
-                 * to any corresponding debugging compilation unit information, thus there is no way to interpret the call offset.
-                 *
-                 * If this implementation is further extended for use outside of CFI evaluation, this opcode should be implemented.
-                */
-
-            case DW_OP_push_object_address:
-                /*
-                 * As per DWARF 3, Section 6.4.2 Call Frame Instructions, DW_OP_push_object_address is not meaningful in an operand of these
-                 * instructions because there is no object context to provide a value to push.
-                 *
-                 * If this implementation is further extended for use outside of CFI evaluation, this opcode should be implemented.
-                 */
-
-            case DW_OP_form_tls_address:
-                /* The structure of TLS data on Darwin is implementation private. */
-                
-            case DW_OP_call_frame_cfa:
-                /*
-                 * As per DWARF 3, Section 6.4.2 Call Frame Instructions, DW_OP_call_frame_cfa is not meaningful in an operand of these
-                 * instructions because its use would be circular.
-                 *
-                 * If this implementation is further extended for use outside of CFI evaluation, this opcode should be implemented.
-                 */
-                
-            default:
-                PLCF_DEBUG("Unsupported opcode 0x%" PRIx8, opcode);
-                return PLCRASH_ENOTSUP;
+            if (!resolved) {
+                PLCF_DEBUG("Branch target offset %" PRId64 " does not fall on an operation boundary", (int64_t) branch_targets[i]);
+                _count = 0;
+                return PLCRASH_EINVAL;
+            }
         }
+
+        return PLCRASH_ESUCCESS;
+    }
+
+    /**
+     * Evaluate the compiled expression.
+     *
+     * @param task The task from which any DWARF expression memory loads will be performed.
+     * @param thread_state The thread state against which the expression will be evaluated.
+     * @param stack The evaluation stack, populated with any initial state.
+     *
+     * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t values on failure.
+     */
+    template <size_t stack_depth>
+    plcrash_error_t eval (task_t task, const plcrash_async_thread_state_t *thread_state, dwarf_stack<machine_ptr, stack_depth> *stack) const {
+        plcrash_error_t err;
+        size_t pc = 0;
+
+        while (pc < _count) {
+            const dwarf_expr_op<machine_ptr> *op = &_ops[pc];
+            bool branch;
+
+            if ((err = dwarf_expr_exec_op<machine_ptr, machine_ptr_s, stack_depth>(task, thread_state, stack, op, &branch)) != PLCRASH_ESUCCESS)
+                return err;
+
+            pc = branch ? op->target : pc + 1;
+        }
+
+        return PLCRASH_ESUCCESS;
+    }
+
+private:
+    /** Number of valid operations in @a _ops. */
+    size_t _count;
+
+    /** The compiled operations. */
+    dwarf_expr_op<machine_ptr> _ops[DWARF_EXPR_COMPILED_MAX_OPS];
+};
+
+/**
+ * @internal
+ *
+ * A direct-mapped, async-safe cache of compiled DWARF expressions.
+ *
+ * Expression-based CFA and register rules (such as those used by signal trampolines) are re-evaluated for
+ * every unwound frame that references them; caching the compiled form avoids re-decoding the opcode stream
+ * on each evaluation. Entries are keyed by the expression's task, address, length, and byte order, and
+ * store a copy of the expression's opcode bytes; a lookup only succeeds if the opcode bytes are unchanged,
+ * which ensures that an unloaded and replaced image can never produce a stale result.
+ *
+ * Instances are statically allocated, and each entry is guarded by a spinlock that is only ever acquired via
+ * OSSpinLockTry(); if an entry is in use by another reader, the cache is simply bypassed.
+ *
+ * @tparam machine_ptr The native machine pointer type for the target data.
+ * @tparam machine_ptr_s The native machine signed pointer type for the target data.
+ */
+template <typename machine_ptr, typename machine_ptr_s>
+class dwarf_expr_cache {
+public:
+    /**
+     * Look up the compiled expression for the given opcode data.
+     *
+     * @param task The task containing the expression.
+     * @param byteorder The byte order of the expression.
+     * @param address The task-relative address of the expression.
+     * @param opcodes The locally mapped expression opcodes.
+     * @param length The length of @a opcodes, in bytes.
+     * @param[out] program On success, the compiled expression.
+     *
+     * @return Returns true if a matching entry was found, false otherwise.
+     */
+    bool lookup (task_t task, const plcrash_async_byteorder_t *byteorder, pl_vm_address_t address, const uint8_t *opcodes, pl_vm_size_t length, dwarf_expr_program<machine_ptr, machine_ptr_s> *program) {
+        entry *e = &_entries[slot(address)];
+        if (!OSSpinLockTry(&e->lock))
+            return false;
+
+        bool found = (e->valid && e->task == task && e->byteorder == byteorder && e->address == address && e->length == length);
+        for (pl_vm_size_t i = 0; found && i < length; i++) {
+            if (e->opcodes[i] != opcodes[i])
+                found = false;
+        }
+
+        if (found)
+            *program = e->program;
+
+        OSSpinLockUnlock(&e->lock);
+        return found;
+    }
+
+    /**
+     * Insert a compiled expression, replacing any existing entry.
+     *
+     * @param task The task containing the expression.
+     * @param byteorder The byte order of the expression.
+     * @param address The task-relative address of the expression.
+     * @param opcodes The locally mapped expression opcodes.
+     * @param length The length of @a opcodes, in bytes. Must not exceed DWARF_EXPR_COMPILED_MAX_LENGTH.
+     * @param program The compiled expression.
+     */
+    void insert (task_t task, const plcrash_async_byteorder_t *byteorder, pl_vm_address_t address, const uint8_t *opcodes, pl_vm_size_t length, const dwarf_expr_program<machine_ptr, machine_ptr_s> *program) {
+        PLCF_ASSERT(length <= DWARF_EXPR_COMPILED_MAX_LENGTH);
+
+        entry *e = &_entries[slot(address)];
+        if (!OSSpinLockTry(&e->lock))
+            return;
+
+        e->valid = true;
+        e->task = task;
+        e->byteorder = byteorder;
+        e->address = address;
+        e->length = length;
+        plcrash_async_memcpy(e->opcodes, opcodes, length);
+        e->program = *program;
+
+        OSSpinLockUnlock(&e->lock);
     }
 
+private:
+    /** A single cache entry. */
+    struct entry {
+        /** Entry lock. Zero-initialized (OS_SPINLOCK_INIT) by virtue of static allocation. */
+        OSSpinLock lock;
+
+        /** If true, the entry is populated. */
+        bool valid;
+
+        /** The task containing the expression. */
+        task_t task;
+
+        /** The byte order used to decode the expression. */
+        const plcrash_async_byteorder_t *byteorder;
+
+        /** The task-relative address of the expression. */
+        pl_vm_address_t address;
+
+        /** The length of the expression, in bytes. */
+        pl_vm_size_t length;
+
+        /** A copy of the expression opcodes. */
+        uint8_t opcodes[DWARF_EXPR_COMPILED_MAX_LENGTH];
+
+        /** The compiled expression. */
+        dwarf_expr_program<machine_ptr, machine_ptr_s> program;
+    };
+
+    /** Return the entry index for @a address. */
+    static size_t slot (pl_vm_address_t address) {
+        return (size_t) ((address ^ (address >> 8)) % DWARF_EXPR_CACHE_SIZE);
+    }
+
+    /** Cache entries. */
+    entry _entries[DWARF_EXPR_CACHE_SIZE];
+};
+
+/** 32-bit compiled expression cache */
+static dwarf_expr_cache<uint32_t, int32_t> dwarf_expr_cache_32;
+
+/** 64-bit compiled expression cache */
+static dwarf_expr_cache<uint64_t, int64_t> dwarf_expr_cache_64;
+
+/** Return the compiled expression cache for the given word size. */
+static dwarf_expr_cache<uint32_t, int32_t> *dwarf_expr_cache_get (uint32_t *) { return &dwarf_expr_cache_32; }
+
+/** Return the compiled expression cache for the given word size. */
+static dwarf_expr_cache<uint64_t, int64_t> *dwarf_expr_cache_get (uint64_t *) { return &dwarf_expr_cache_64; }
+
+/**
+ * Evaluate a DWARF expression directly from its opcode stream, decoding each operation as it is executed.
+ *
+ * This is used for expressions that can not be compiled; see plcrash_async_dwarf_expression_eval() for
+ * a description of the parameters.
+ */
+template <typename machine_ptr, typename machine_ptr_s, size_t stack_depth>
+static plcrash_error_t plcrash_async_dwarf_expression_interpret (plcrash_async_mobject_t *mobj,
+                                                                  task_t task,
+                                                                  const plcrash_async_thread_state_t *thread_state,
+                                                                  const plcrash_async_byteorder_t *byteorder,
+                                                                  pl_vm_address_t address,
+                                                                  pl_vm_off_t offset,
+                                                                  pl_vm_size_t length,
+                                                                  dwarf_stack<machine_ptr, stack_depth> *stack)
+{
+    dwarf_opstream opstream;
+    plcrash_error_t err;
+
+    /* Configure the opstream */
+    if ((err = opstream.init(mobj, byteorder, address, offset, length)) != PLCRASH_ESUCCESS)
+        return err;
+
+    uint8_t opcode;
+    while (opstream.read_intU(&opcode)) {
+        dwarf_expr_op<machine_ptr> op;
+        bool branch;
+
+        if ((err = dwarf_expr_decode_op<machine_ptr, machine_ptr_s>(&opstream, opcode, &op)) != PLCRASH_ESUCCESS)
+            return err;
+
+        if ((err = dwarf_expr_exec_op<machine_ptr, machine_ptr_s, stack_depth>(task, thread_state, stack, &op, &branch)) != PLCRASH_ESUCCESS)
+            return err;
+
+        if (branch) {
+            int16_t offset = (int16_t) op.operands[0];
+            if (!opstream.skip(offset)) {
+                PLCF_DEBUG("DW_OP_skip/DW_OP_bra offset %" PRId16 " falls outside of opcode range", offset);
+                return PLCRASH_EINVAL;
+            }
+        }
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ * Global evaluation stack statistics; see plcrash_async_dwarf_expression_stats_t.
+ */
+static struct {
+    volatile int32_t eval_count;
+    volatile int32_t max_depth;
+    volatile int32_t overflow_count;
+} dwarf_expr_stats;
+
+/**
+ * Record the final state of an evaluation stack in the global evaluation statistics.
+ *
+ * @param stack The evaluation stack.
+ */
+template <typename machine_ptr, size_t stack_depth>
+static void dwarf_expr_stats_record (const dwarf_stack<machine_ptr, stack_depth> *stack) {
+    int32_t depth = (int32_t) stack->max_depth();
+    int32_t current;
+
+    OSAtomicIncrement32Barrier(&dwarf_expr_stats.eval_count);
+
+    if (stack->overflowed())
+        OSAtomicIncrement32Barrier(&dwarf_expr_stats.overflow_count);
+
+    do {
+        current = dwarf_expr_stats.max_depth;
+        if (depth <= current)
+            break;
+    } while (!OSAtomicCompareAndSwap32Barrier(current, depth, &dwarf_expr_stats.max_depth));
+}
+
+/**
+ * Fetch the DWARF expression evaluation statistics recorded since the last call to
+ * plcrash_async_dwarf_expression_stats_reset().
+ *
+ * @param[out] stats On return, the current statistics.
+ */
+void plcrash_async_dwarf_expression_stats_get (plcrash_async_dwarf_expression_stats_t *stats) {
+    OSMemoryBarrier();
+    stats->eval_count = dwarf_expr_stats.eval_count;
+    stats->max_depth = dwarf_expr_stats.max_depth;
+    stats->overflow_count = dwarf_expr_stats.overflow_count;
+}
+
+/**
+ * Reset all DWARF expression evaluation statistics.
+ */
+void plcrash_async_dwarf_expression_stats_reset (void) {
+    dwarf_expr_stats.eval_count = 0;
+    dwarf_expr_stats.max_depth = 0;
+    dwarf_expr_stats.overflow_count = 0;
+    OSMemoryBarrier();
+}
+
+/**
+ * Evaluate a DWARF expression, as defined in the DWARF 4 Specification, Section 2.5. This
+ * internal implementation is templated to support 32-bit and 64-bit evaluation.
+ *
+ * Expressions are compiled to a decoded form and cached on first evaluation; later evaluations of
+ * an identical expression execute the cached operations without re-decoding the opcode stream.
+ *
+ * The evaluation stack's depth, and the final depth reached, are recorded in the statistics returned by
+ * plcrash_async_dwarf_expression_stats_get().
+ *
+ * @param mobj The memory object from which the expression opcodes will be read.
+ * @param task The task from which any DWARF expression memory loads will be performed.
+ * @param thread_state The thread state against which the expression will be evaluated.
+ * @param byteorder The byte order of the data referenced by @a mobj and @a thread_state.
+ * @param address The task-relative address within @a mobj at which the opcodes will be fetched.
+ * @param offset An offset to be applied to @a address.
+ * @param length The total length of the opcodes readable at @a address + @a offset.
+ * @param initial_state Initial set of values to be pushed onto the evaluation stack. The values will be pushed
+ * on their natural order; eg, the top of the stack will be the last value in this array. If the initial stack
+ * state should be empty, this value may be NULL, and @a initial_count should be 0.
+ * @param initial_count Number of values in the @a initial_state array.
+ * @param result[out] On success, the evaluation result. As per DWARF 3 section 2.5.1, this will be
+ * the top-most element on the evaluation stack. If the stack is empty, an error will be returned
+ * and no value will be written to this parameter.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t values
+ * on failure. If an invalid opcode is detected, PLCRASH_ENOTSUP will be returned. If the stack
+ * is empty upon termination of evaluation, PLCRASH_EINVAL will be returned.
+ *
+ * @tparam stack_depth The capacity of the evaluation stack.
+ *
+ * @todo Consider defining updated status codes or error handling to provide more structured
+ * error data on failure.
+ */
+template <typename machine_ptr, typename machine_ptr_s, size_t stack_depth>
+plcrash_error_t plcrash_async_dwarf_expression_eval (plcrash_async_mobject_t *mobj,
+                                                     task_t task,
+                                                     const plcrash_async_thread_state_t *thread_state,
+                                                     const plcrash_async_byteorder_t *byteorder,
+                                                     pl_vm_address_t address,
+                                                     pl_vm_off_t offset,
+                                                     pl_vm_size_t length,
+                                                     machine_ptr initial_state[],
+                                                     size_t initial_count,
+                                                     machine_ptr *result)
+{
+    // TODO: Review the use of an up-to-800 byte stack allocation; we may want to replace this with
+    // use of the new async-safe allocator.
+    dwarf_stack<machine_ptr, stack_depth> stack;
+    plcrash_error_t err;
+
+    /* Populate the initial state */
+    for (size_t i = 0; i < initial_count; i++) {
+        if (!stack.push(initial_state[i])) {
+            PLCF_DEBUG("Hit stack limit; cannot push further values");
+            dwarf_expr_stats_record(&stack);
+            return PLCRASH_EINTERNAL;
+        }
+    }
+
+    /* Try the compiled expression cache; expression data that can't be locally mapped or compiled is interpreted directly. */
+    dwarf_expr_cache<machine_ptr, machine_ptr_s> *cache = dwarf_expr_cache_get((machine_ptr *) NULL);
+    const uint8_t *opcodes = NULL;
+    pl_vm_address_t expr_address = 0;
+
+    if (length <= DWARF_EXPR_COMPILED_MAX_LENGTH && plcrash_async_address_apply_offset(address, offset, &expr_address))
+        opcodes = (const uint8_t *) plcrash_async_mobject_remap_address(mobj, address, offset, length);
+
+    if (opcodes != NULL) {
+        dwarf_expr_program<machine_ptr, machine_ptr_s> program;
+
+        if (cache->lookup(task, byteorder, expr_address, opcodes, length, &program)) {
+            err = program.eval(task, thread_state, &stack);
+        } else if (program.compile(mobj, byteorder, address, offset, length) == PLCRASH_ESUCCESS) {
+            cache->insert(task, byteorder, expr_address, opcodes, length, &program);
+            err = program.eval(task, thread_state, &stack);
+        } else {
+            err = plcrash_async_dwarf_expression_interpret<machine_ptr, machine_ptr_s, stack_depth>(mobj, task, thread_state, byteorder, address, offset, length, &stack);
+        }
+    } else {
+        err = plcrash_async_dwarf_expression_interpret<machine_ptr, machine_ptr_s, stack_depth>(mobj, task, thread_state, byteorder, address, offset, length, &stack);
+    }
+
+    dwarf_expr_stats_record(&stack);
+    if (err != PLCRASH_ESUCCESS)
+        return err;
+
     /* Provide the result */
     if (!stack.pop(result)) {
         PLCF_DEBUG("Expression did not provide a result value.");
         return PLCRASH_EINVAL;
     }
 
-#undef dw_expr_read
-#undef dw_expr_push
     return PLCRASH_ESUCCESS;
 }
 
+#undef dw_expr_read_int
+#undef dw_expr_read_uleb128
+#undef dw_expr_read_sleb128
+#undef dw_thread_regval
+#undef dw_expr_push
+#undef dw_expr_pop
+
 /* Provide explicit 32/64-bit instantiations */
-template plcrash_error_t plcrash_async_dwarf_expression_eval<uint32_t, int32_t> (plcrash_async_mobject_t *mobj,
+template plcrash_error_t plcrash_async_dwarf_expression_eval<uint32_t, int32_t, DWARF_EXPR_DEFAULT_STACK_DEPTH> (plcrash_async_mobject_t *mobj,
                                                                                  task_t task,
                                                                                  const plcrash_async_thread_state_t *thread_state,
                                                                                  const plcrash_async_byteorder_t *byteorder,
@@ -709,7 +1300,7 @@ template plcrash_error_t plcrash_async_dwarf_expression_eval<uint32_t, int32_t>
                                                                                  size_t initial_count,
                                                                                  uint32_t *result);
 
-template plcrash_error_t plcrash_async_dwarf_expression_eval<uint64_t, int64_t> (plcrash_async_mobject_t *mobj,
+template plcrash_error_t plcrash_async_dwarf_expression_eval<uint64_t, int64_t, DWARF_EXPR_DEFAULT_STACK_DEPTH> (plcrash_async_mobject_t *mobj,
                                                                                  task_t task,
                                                                                  const plcrash_async_thread_state_t *thread_state,
                                                                                  const plcrash_async_byteorder_t *byteorder,
@@ -557,7 +557,32 @@ typedef enum DW_OP {
     DW_OP_hi_user = 0xff,
 } DW_OP_t;
 
-template <typename machine_ptr, typename machine_ptr_s>
+/**
+ * The default depth of the DWARF expression evaluation stack. Other depths may be selected via the
+ * plcrash_async_dwarf_expression_eval() stack_depth template parameter, and must be explicitly instantiated
+ * in PLCrashAsyncDwarfExpression.cpp.
+ */
+#define DWARF_EXPR_DEFAULT_STACK_DEPTH 100
+
+/**
+ * DWARF expression evaluation stack statistics, as recorded across all evaluations since the statistics
+ * were last reset. These may be used to select an evaluation stack depth appropriate to real-world expressions.
+ */
+typedef struct plcrash_async_dwarf_expression_stats {
+    /** The number of completed expression evaluations. */
+    uint32_t eval_count;
+
+    /** The maximum evaluation stack depth observed. */
+    uint32_t max_depth;
+
+    /** The number of evaluations that exceeded the evaluation stack's capacity. */
+    uint32_t overflow_count;
+} plcrash_async_dwarf_expression_stats_t;
+
+void plcrash_async_dwarf_expression_stats_get (plcrash_async_dwarf_expression_stats_t *stats);
+void plcrash_async_dwarf_expression_stats_reset (void);
+
+template <typename machine_ptr, typename machine_ptr_s, size_t stack_depth = DWARF_EXPR_DEFAULT_STACK_DEPTH>
 plcrash_error_t plcrash_async_dwarf_expression_eval (plcrash_async_mobject_t *mobj,
                                                      task_t task,
                                                      const plcrash_async_thread_state_t *thread_state,
@@ -723,6 +723,45 @@
     PERFORM_EVAL_TEST_ERROR(opcodes, PLCRASH_EINVAL);
 }
 
+/** Test repeated evaluation of an expression, including modification of the expression data between evaluations. */
+- (void) testRepeatedEvaluation {
+    uint8_t opcodes[] = { DW_OP_lit5, DW_OP_lit1, DW_OP_minus, DW_OP_dup, DW_OP_bra, 0xFF, 0xFA /* -6; jump to decrement */, DW_OP_lit2, DW_OP_plus };
+
+    /* Evaluation of the cached expression must produce an identical result */
+    PERFORM_EVAL_TEST(opcodes, uint32_t, 0x2);
+    PERFORM_EVAL_TEST(opcodes, uint32_t, 0x2);
+
+    /* A modified expression at the same address must not be satisfied by the cached expression */
+    opcodes[0] = DW_OP_lit3;
+    opcodes[7] = DW_OP_lit7;
+    PERFORM_EVAL_TEST(opcodes, uint32_t, 0x7);
+}
+
+/** Test recording of evaluation stack statistics. */
+- (void) testStackStatistics {
+    plcrash_async_dwarf_expression_stats_t stats;
+
+    /* Record the maximum depth of a successful evaluation */
+    uint8_t opcodes[] = { DW_OP_lit1, DW_OP_lit2, DW_OP_lit3, DW_OP_plus, DW_OP_plus };
+    plcrash_async_dwarf_expression_stats_reset();
+    PERFORM_EVAL_TEST(opcodes, uint32_t, 6);
+
+    plcrash_async_dwarf_expression_stats_get(&stats);
+    STAssertEquals(stats.eval_count, (uint32_t)1, @"Incorrect evaluation count");
+    STAssertEquals(stats.max_depth, (uint32_t)3, @"Incorrect maximum depth");
+    STAssertEquals(stats.overflow_count, (uint32_t)0, @"Incorrect overflow count");
+
+    /* Record an overflow */
+    uint8_t overflow_opcodes[DWARF_EXPR_DEFAULT_STACK_DEPTH + 1];
+    memset(overflow_opcodes, DW_OP_lit0, sizeof(overflow_opcodes));
+    plcrash_async_dwarf_expression_stats_reset();
+    PERFORM_EVAL_TEST_ERROR(overflow_opcodes, PLCRASH_EINTERNAL);
+
+    plcrash_async_dwarf_expression_stats_get(&stats);
+    STAssertEquals(stats.max_depth, (uint32_t)DWARF_EXPR_DEFAULT_STACK_DEPTH, @"Incorrect maximum depth");
+    STAssertEquals(stats.overflow_count, (uint32_t)1, @"Incorrect overflow count");
+}
+
 /** Test basic evaluation of a NOP. */
 - (void) testNop {
     uint8_t opcodes[] = {
@@ -132,6 +132,20 @@ template <typename machine_ptr> plcrash_error_t gnu_ehptr_reader<machine_ptr>::r
         return PLCRASH_ENOTFOUND;
     }
     
+    /* Fast path for DW_EH_PE_pcrel|DW_EH_PE_sdata4, which is used by effectively all FDEs produced by the standard
+     * toolchains. */
+    if (encoding == (DW_EH_PE_pcrel|DW_EH_PE_sdata4)) {
+        int32_t sdata4;
+        if ((err = plcrash_async_mobject_read_uint32(mobj, _byteorder, location, offset, (uint32_t *) &sdata4)) != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("Failed to read sdata4 value at 0x%" PRIx64, (uint64_t) location);
+            return err;
+        }
+
+        *result = sdata4 + (machine_ptr) (location + offset);
+        *size = 4;
+        return PLCRASH_ESUCCESS;
+    }
+
     /* Initialize the output size; we apply offsets to this size to allow for aligning the
      * address prior to reading the pointer data, etc. */
     *size = 0;
@@ -446,13 +460,26 @@ plcrash_error_t plcrash::async::plcrash_async_dwarf_read_task_uleb128 (task_t ta
  */
 plcrash_error_t plcrash::async::plcrash_async_dwarf_read_uleb128 (plcrash_async_mobject_t *mobj, pl_vm_address_t location, pl_vm_off_t offset, uint64_t *result, pl_vm_size_t *size) {
     unsigned int shift = 0;
-    pl_vm_off_t position = 0;
+    size_t position = 0;
+    size_t available;
+    uint8_t byte = 0;
     *result = 0;
     
-    uint8_t *p;
-    while ((p = (uint8_t *) plcrash_async_mobject_remap_address(mobj, location, position + offset, 1)) != NULL) {
+    /* Validate the readable range once, and decode directly from the mapped bytes */
+    uint8_t *p = (uint8_t *) plcrash_async_mobject_remap_span(mobj, location, offset, 1, &available);
+    if (p == NULL) {
+        PLCF_DEBUG("ULEB128 value did not terminate within mapped memory range");
+        return PLCRASH_EINVAL;
+    }
+
+    while (true) {
+        if (position == available) {
+            PLCF_DEBUG("ULEB128 value did not terminate within mapped memory range");
+            return PLCRASH_EINVAL;
+        }
+
         /* LEB128 uses 7 bits for the number, the final bit to signal completion */
-        uint8_t byte = *p;
+        byte = p[position];
         *result |= ((uint64_t) (byte & 0x7f)) << shift;
         shift += 7;
         
@@ -471,11 +498,6 @@ plcrash_error_t plcrash::async::plcrash_async_dwarf_read_uleb128 (plcrash_async_
         }
     }
     
-    if (p == NULL) {
-        PLCF_DEBUG("ULEB128 value did not terminate within mapped memory range");
-        return PLCRASH_EINVAL;
-    }
-    
     *size = position;
     return PLCRASH_ESUCCESS;
 }
@@ -491,13 +513,26 @@ plcrash_error_t plcrash::async::plcrash_async_dwarf_read_uleb128 (plcrash_async_
  */
 plcrash_error_t plcrash::async::plcrash_async_dwarf_read_sleb128 (plcrash_async_mobject_t *mobj, pl_vm_address_t location, pl_vm_off_t offset, int64_t *result, pl_vm_size_t *size) {
     unsigned int shift = 0;
-    pl_vm_off_t position = 0;
+    size_t position = 0;
+    size_t available;
+    uint8_t byte = 0;
     *result = 0;
     
-    uint8_t *p;
-    while ((p = (uint8_t *) plcrash_async_mobject_remap_address(mobj, location, position + offset, 1)) != NULL) {
+    /* Validate the readable range once, and decode directly from the mapped bytes */
+    uint8_t *p = (uint8_t *) plcrash_async_mobject_remap_span(mobj, location, offset, 1, &available);
+    if (p == NULL) {
+        PLCF_DEBUG("ULEB128 value did not terminate within mapped memory range");
+        return PLCRASH_EINVAL;
+    }
+
+    while (true) {
+        if (position == available) {
+            PLCF_DEBUG("ULEB128 value did not terminate within mapped memory range");
+            return PLCRASH_EINVAL;
+        }
+
         /* LEB128 uses 7 bits for the number, the final bit to signal completion */
-        uint8_t byte = *p;
+        byte = p[position];
         *result |= ((uint64_t) (byte & 0x7f)) << shift;
         shift += 7;
         
@@ -516,13 +551,8 @@ plcrash_error_t plcrash::async::plcrash_async_dwarf_read_sleb128 (plcrash_async_
         }
     }
     
-    if (p == NULL) {
-        PLCF_DEBUG("ULEB128 value did not terminate within mapped memory range");
-        return PLCRASH_EINVAL;
-    }
-    
     /* Sign bit is 2nd high order bit */
-    if (shift < 64 && (*p & 0x40))
+    if (shift < 64 && (byte & 0x40))
         *result |= -(1ULL << shift);
     
     *size = position;
@@ -28,14 +28,101 @@
 
 #include "PLCrashAsync.h"
 #include "PLCrashAsyncImageList.h"
+#include "PLCrashAsyncObjCSection.h"
 #include "PLCrashAsyncLinkedList.hpp"
+#include "PLCrashAsyncDwarfEncoding.hpp"
 
 #include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include <assert.h>
+#include <sched.h>
+
+#ifdef __has_include
+#if __has_include(<pthread/qos.h>)
+#include <pthread/qos.h>
+#define PLCRASH_ASYNC_IMAGE_LIST_QOS 1
+#endif
+#endif
 
 using namespace plcrash::async;
 
+#ifndef MH_DYLIB_IN_CACHE
+/** The mach_header flag set on images that are part of the dyld shared cache. Not defined by older SDKs. */
+#define MH_DYLIB_IN_CACHE 0x80000000
+#endif
+
+/**
+ * @internal
+ *
+ * An immutable, address-sorted snapshot of a binary image list. Once published to readers, an index is
+ * never modified; changes to the image list are applied by building and atomically publishing a new index.
+ */
+struct plcrash_async_image_index {
+    /** The next retired index, or NULL. Only used by writers. */
+    struct plcrash_async_image_index *next_retired;
+
+    /** The number of images in @a images. */
+    size_t count;
+
+    /** The images, sorted by header address. */
+    plcrash_async_image_t *images[1];
+};
+
+/**
+ * @internal
+ *
+ * A single allocation backing the image records appended by plcrash_nasync_image_list_append_batch().
+ */
+struct plcrash_async_image_batch {
+    /** The next batch, or NULL. */
+    struct plcrash_async_image_batch *next;
+
+    /** The image records. */
+    plcrash_async_image_t images[1];
+};
+
+/**
+ * @internal
+ *
+ * An entry in the header address hash index of a plcrash_async_image_list_t.
+ */
+struct plcrash_async_image_header_entry {
+    /** The image's header address. */
+    pl_vm_address_t header;
+
+    /** The list node holding the image. */
+    async_list<plcrash_async_image_t *>::node *node;
+
+    /** The next entry in the same bucket, in append order, or NULL. */
+    struct plcrash_async_image_header_entry *next;
+};
+
+/** The initial number of buckets allocated for the header address hash index. */
+#define PLCRASH_ASYNC_IMAGE_HEADER_BUCKETS_INITIAL 64
+
+/**
+ * @internal
+ *
+ * A chunk of the append-only string arena holding the names of a plcrash_async_image_list_t's images.
+ */
+struct plcrash_async_image_name_chunk {
+    /** The previously allocated chunk, or NULL. */
+    struct plcrash_async_image_name_chunk *next;
+
+    /** The number of bytes of @a data in use. */
+    size_t used;
+
+    /** The total size of @a data, in bytes. */
+    size_t capacity;
+
+    /** The chunk's string data. The structure is allocated with space for @a capacity bytes. */
+    char data[1];
+};
+
+/** The default size of an image name arena chunk, in bytes. A typical process' image names fit in a few chunks. */
+#define PLCRASH_ASYNC_IMAGE_NAME_CHUNK_SIZE (16 * 1024)
+
 /**
  * @internal
  * @ingroup plcrash_async
@@ -47,9 +134,323 @@ using namespace plcrash::async;
  * Atomic compare and swap is used to ensure a consistent view of the list for readers. To simplify implementation, a
  * write mutex is held for all updates; the implementation is not designed for efficiency in the face of contention
  * between readers and writers, and it's assumed that no contention should realistically occur.
+ *
+ * To support O(log n) address lookups, an address-sorted index is rebuilt by every writer and atomically published
+ * for use by readers. Writers additionally maintain a private hash index of header addresses, allowing images to be
+ * found and removed without searching the list.
+ *
+ * Parsing an image's Mach-O headers on append may be deferred to a background thread via
+ * plcrash_nasync_image_list_set_deferred(), reducing the cost of appends performed from the dyld add-image
+ * callback during process launch.
+ *
+ * Image names are copied into a single append-only string arena owned by the list. Where memory is constrained,
+ * plcrash_nasync_image_list_set_compact() may additionally be used to release each image's mappings once parsed.
  * @{
  */
 
+/**
+ * @internal
+ *
+ * A queued image append, as enqueued by plcrash_nasync_image_list_append() when deferred parsing is enabled.
+ */
+struct plcrash_async_image_deferred {
+    /** The image's header address. */
+    pl_vm_address_t header;
+
+    /** The image's name. */
+    char *name;
+
+    /** The next queued image, or NULL. */
+    struct plcrash_async_image_deferred *next;
+};
+
+static void plcrash_nasync_image_encode (plcrash_async_image_t *image, plcrash_async_image_encoder_t encoder);
+static void plcrash_nasync_image_list_append_now (plcrash_async_image_list_t *list, pl_vm_address_t header, const char *name);
+static bool plcrash_nasync_image_list_prepare (plcrash_async_image_list_t *list, plcrash_async_image_t *image, pl_vm_address_t header, const char *name);
+static plcrash_async_mobject_t *plcrash_nasync_image_list_shared_cache (plcrash_async_image_list_t *list, pl_vm_address_t header);
+static bool plcrash_nasync_image_list_enqueue_deferred (plcrash_async_image_list_t *list, pl_vm_address_t header, const char *name);
+static void plcrash_nasync_image_list_start_deferred_worker (plcrash_async_image_list_t *list);
+static bool plcrash_nasync_image_list_load_next_deferred (plcrash_async_image_list_t *list);
+static plcrash_async_image_class_t plcrash_nasync_image_classify (plcrash_async_macho_t *image, bool shared_cache);
+static void plcrash_nasync_image_list_build_indexes (plcrash_async_image_list_t *list, plcrash_async_image_t *image);
+static bool plcrash_nasync_image_list_schedule_indexes (plcrash_async_image_list_t *list);
+static void plcrash_nasync_image_list_start_indexer (plcrash_async_image_list_t *list);
+static bool plcrash_nasync_image_list_build_next_index (plcrash_async_image_list_t *list);
+static void plcrash_nasync_image_list_header_insert (plcrash_async_image_list_t *list, async_list<plcrash_async_image_t *>::node *node);
+static async_list<plcrash_async_image_t *>::node *plcrash_nasync_image_list_header_find (plcrash_async_image_list_t *list, pl_vm_address_t header, bool remove);
+static void plcrash_nasync_image_list_header_free (plcrash_async_image_list_t *list);
+static char *plcrash_nasync_image_list_intern_name (plcrash_async_image_list_t *list, const char *name);
+
+/**
+ * @internal
+ * qsort() comparison function used to order images by header address.
+ */
+static int plcrash_nasync_image_compare (const void *a, const void *b) {
+    pl_vm_address_t lhs = (*(plcrash_async_image_t * const *) a)->macho_image.header_addr;
+    pl_vm_address_t rhs = (*(plcrash_async_image_t * const *) b)->macho_image.header_addr;
+
+    if (lhs < rhs)
+        return -1;
+    else if (lhs > rhs)
+        return 1;
+    return 0;
+}
+
+/**
+ * @internal
+ * Free @a index, along with all indexes reachable via its retired list.
+ *
+ * @warning This method is not async safe.
+ */
+static void plcrash_nasync_image_index_free (struct plcrash_async_image_index *index) {
+    while (index != NULL) {
+        struct plcrash_async_image_index *next = index->next_retired;
+        free(index);
+        index = next;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Rebuild and atomically publish the address-sorted index for @a list. If the index can not be allocated, readers
+ * will fall back to iterating the list.
+ *
+ * @param list The list for which an index should be built.
+ * @param removed If non-NULL, the only change to @a list since the current index was published is the removal of
+ * this image; the new index is derived from the current index, without re-sorting the list.
+ *
+ * @warning This method is not async safe.
+ */
+static void plcrash_nasync_image_list_update_index (plcrash_async_image_list_t *list, plcrash_async_image_t *removed) {
+    OSSpinLockLock(&list->_index_lock); {
+        struct plcrash_async_image_index *new_index = NULL;
+        struct plcrash_async_image_index *cur_index = list->_index;
+
+        if (removed != NULL && cur_index != NULL) {
+            /* Copy the current index, omitting the removed image; the result remains sorted. */
+            size_t count = cur_index->count;
+            new_index = (struct plcrash_async_image_index *) malloc(sizeof(*new_index) + (sizeof(new_index->images[0]) * count));
+            if (new_index != NULL) {
+                new_index->next_retired = NULL;
+                new_index->count = 0;
+
+                for (size_t i = 0; i < count; i++) {
+                    if (cur_index->images[i] != removed)
+                        new_index->images[new_index->count++] = cur_index->images[i];
+                }
+            } else {
+                PLCF_DEBUG("Could not allocate an image index for %zu images", count);
+            }
+        } else {
+            list->_list->set_reading(true); {
+                /* Count the images */
+                size_t count = 0;
+                async_list<plcrash_async_image_t *>::node *next = NULL;
+                while ((next = list->_list->next(next)) != NULL)
+                    count++;
+
+                /* Populate the new index */
+                new_index = (struct plcrash_async_image_index *) malloc(sizeof(*new_index) + (sizeof(new_index->images[0]) * count));
+                if (new_index != NULL) {
+                    new_index->next_retired = NULL;
+                    new_index->count = 0;
+
+                    while ((next = list->_list->next(next)) != NULL && new_index->count < count)
+                        new_index->images[new_index->count++] = next->value();
+
+                    qsort(new_index->images, new_index->count, sizeof(new_index->images[0]), plcrash_nasync_image_compare);
+                } else {
+                    PLCF_DEBUG("Could not allocate an image index for %zu images", count);
+                }
+            } list->_list->set_reading(false);
+        }
+
+        /* Issue a memory barrier to ensure a consistent view of the index, and then atomically publish it. */
+        OSMemoryBarrier();
+        struct plcrash_async_image_index *old_index = list->_index;
+        if (!OSAtomicCompareAndSwapPtrBarrier(old_index, new_index, (void **) &list->_index)) {
+            PLCF_DEBUG("Failed to update image index despite holding lock");
+        }
+
+        /* If a reader is active, retire the old index; otherwise, the old index is unreachable and no reader holds
+         * a reference to it, nor to any previously retired indexes. */
+        if (list->_refcount > 0) {
+            if (old_index != NULL) {
+                old_index->next_retired = list->_retired_index;
+                list->_retired_index = old_index;
+            }
+        } else {
+            plcrash_nasync_image_index_free(old_index);
+            plcrash_nasync_image_index_free(list->_retired_index);
+            list->_retired_index = NULL;
+        }
+    } OSSpinLockUnlock(&list->_index_lock);
+}
+
+
+/**
+ * @internal
+ *
+ * Return the header index bucket for @a header.
+ *
+ * @param header The image header address.
+ * @param bucket_count The number of buckets; must be a power of two.
+ */
+static inline size_t plcrash_nasync_image_header_bucket (pl_vm_address_t header, size_t bucket_count) {
+    /* Image headers are page aligned; a multiplicative hash spreads the significant bits */
+    uint64_t hash = (uint64_t) header * 0x9E3779B97F4A7C15ULL;
+    return (size_t) (hash >> 32) & (bucket_count - 1);
+}
+
+/**
+ * @internal
+ *
+ * Append @a entry to the tail of its bucket in @a buckets, preserving append order among entries sharing a header
+ * address.
+ */
+static void plcrash_nasync_image_header_link (struct plcrash_async_image_header_entry **buckets, size_t bucket_count, struct plcrash_async_image_header_entry *entry) {
+    struct plcrash_async_image_header_entry **tail = &buckets[plcrash_nasync_image_header_bucket(entry->header, bucket_count)];
+    while (*tail != NULL)
+        tail = &(*tail)->next;
+
+    entry->next = NULL;
+    *tail = entry;
+}
+
+/**
+ * @internal
+ *
+ * Free the header index of @a list. The caller must hold the list's deferred lock, or otherwise have exclusive access
+ * to the list.
+ *
+ * @param list The list whose header index should be freed.
+ */
+static void plcrash_nasync_image_list_header_free (plcrash_async_image_list_t *list) {
+    if (list->_header_buckets == NULL)
+        return;
+
+    for (size_t i = 0; i < list->_header_bucket_count; i++) {
+        struct plcrash_async_image_header_entry *entry = list->_header_buckets[i];
+        while (entry != NULL) {
+            struct plcrash_async_image_header_entry *next = entry->next;
+            free(entry);
+            entry = next;
+        }
+    }
+
+    free(list->_header_buckets);
+    list->_header_buckets = NULL;
+    list->_header_bucket_count = 0;
+    list->_header_count = 0;
+}
+
+/**
+ * @internal
+ *
+ * Record the newly appended @a node in the header index of @a list, growing the index as required. If an allocation
+ * fails, the index is discarded, and all further header lookups fall back on searching the list. The caller must hold
+ * the list's deferred lock.
+ *
+ * @param list The list to which @a node was appended.
+ * @param node The appended node.
+ */
+static void plcrash_nasync_image_list_header_insert (plcrash_async_image_list_t *list, async_list<plcrash_async_image_t *>::node *node) {
+    if (list->_header_index_failed)
+        return;
+
+    /* Grow the table once the load factor reaches 1 */
+    if (list->_header_count >= list->_header_bucket_count) {
+        size_t bucket_count = list->_header_bucket_count > 0 ? list->_header_bucket_count * 2 : PLCRASH_ASYNC_IMAGE_HEADER_BUCKETS_INITIAL;
+        struct plcrash_async_image_header_entry **buckets;
+        buckets = (struct plcrash_async_image_header_entry **) calloc(bucket_count, sizeof(buckets[0]));
+        if (buckets == NULL) {
+            PLCF_DEBUG("Could not allocate %zu image header buckets", bucket_count);
+            plcrash_nasync_image_list_header_free(list);
+            list->_header_index_failed = true;
+            return;
+        }
+
+        /* Rehash, preserving the order of each chain */
+        for (size_t i = 0; i < list->_header_bucket_count; i++) {
+            struct plcrash_async_image_header_entry *entry = list->_header_buckets[i];
+            while (entry != NULL) {
+                struct plcrash_async_image_header_entry *next = entry->next;
+                plcrash_nasync_image_header_link(buckets, bucket_count, entry);
+                entry = next;
+            }
+        }
+
+        free(list->_header_buckets);
+        list->_header_buckets = buckets;
+        list->_header_bucket_count = bucket_count;
+    }
+
+    struct plcrash_async_image_header_entry *entry;
+    entry = (struct plcrash_async_image_header_entry *) malloc(sizeof(*entry));
+    if (entry == NULL) {
+        PLCF_DEBUG("Could not allocate an image header entry");
+        plcrash_nasync_image_list_header_free(list);
+        list->_header_index_failed = true;
+        return;
+    }
+
+    entry->header = node->value()->macho_image.header_addr;
+    entry->node = node;
+    plcrash_nasync_image_header_link(list->_header_buckets, list->_header_bucket_count, entry);
+    list->_header_count++;
+}
+
+/**
+ * @internal
+ *
+ * Find the first node in @a list whose image has the given @a header address. The caller must hold the list's
+ * deferred lock.
+ *
+ * @param list The list to search.
+ * @param header The image header address to search for.
+ * @param remove If true, the returned node is dropped from the header index. The caller is responsible for removing
+ * it from the list.
+ *
+ * @return The matching node, or NULL if not found.
+ */
+static async_list<plcrash_async_image_t *>::node *plcrash_nasync_image_list_header_find (plcrash_async_image_list_t *list, pl_vm_address_t header, bool remove) {
+    /* Fall back on a linear search if the index is unavailable */
+    if (list->_header_index_failed) {
+        async_list<plcrash_async_image_t *>::node *found = NULL;
+        list->_list->set_reading(true); {
+            async_list<plcrash_async_image_t *>::node *next = NULL;
+            while ((next = list->_list->next(next)) != NULL) {
+                if (next->value()->macho_image.header_addr == header) {
+                    found = next;
+                    break;
+                }
+            }
+        } list->_list->set_reading(false);
+
+        return found;
+    }
+
+    if (list->_header_buckets == NULL)
+        return NULL;
+
+    struct plcrash_async_image_header_entry **prev = &list->_header_buckets[plcrash_nasync_image_header_bucket(header, list->_header_bucket_count)];
+    for (struct plcrash_async_image_header_entry *entry = *prev; entry != NULL; prev = &entry->next, entry = entry->next) {
+        if (entry->header != header)
+            continue;
+
+        async_list<plcrash_async_image_t *>::node *found = entry->node;
+        if (remove) {
+            *prev = entry->next;
+            free(entry);
+            list->_header_count--;
+        }
+
+        return found;
+    }
+
+    return NULL;
+}
 
 /**
  * Initialize a new binary image list and issue a memory barrier
@@ -63,6 +464,10 @@ void plcrash_nasync_image_list_init (plcrash_async_image_list_t *list, mach_port
     memset(list, 0, sizeof(*list));
 
     list->_list = new async_list<plcrash_async_image_t *>();
+    list->_index_lock = OS_SPINLOCK_INIT;
+    pthread_mutex_init(&list->_deferred_lock, NULL);
+    pthread_mutex_init(&list->_indexer_lock, NULL);
+    pthread_cond_init(&list->_indexer_cond, NULL);
     list->task = task;
     mach_port_mod_refs(mach_task_self(), list->task, MACH_PORT_RIGHT_SEND, 1);
 }
@@ -73,6 +478,41 @@ void plcrash_nasync_image_list_init (plcrash_async_image_list_t *list, mach_port
  * @warning This method is not async safe.
  */
 void plcrash_nasync_image_list_free (plcrash_async_image_list_t *list) {
+    /* Discard any deferred images, and wait for the background loader to exit */
+    while (true) {
+        pthread_mutex_lock(&list->_deferred_lock);
+        while (list->_deferred_head != NULL) {
+            struct plcrash_async_image_deferred *entry = list->_deferred_head;
+            list->_deferred_head = entry->next;
+            free(entry->name);
+            free(entry);
+        }
+        list->_deferred_tail = NULL;
+
+        bool running = list->_deferred_worker_running;
+        pthread_mutex_unlock(&list->_deferred_lock);
+
+        if (!running)
+            break;
+        sched_yield();
+    }
+    pthread_mutex_destroy(&list->_deferred_lock);
+
+    /* Wait for the background index builder to exit */
+    list->_indexer_cancelled = true;
+    OSMemoryBarrier();
+    while (true) {
+        pthread_mutex_lock(&list->_indexer_lock);
+        bool running = list->_indexer_running;
+        pthread_mutex_unlock(&list->_indexer_lock);
+
+        if (!running)
+            break;
+        sched_yield();
+    }
+    pthread_mutex_destroy(&list->_indexer_lock);
+    pthread_cond_destroy(&list->_indexer_cond);
+
     /* Clean up the image structures */
     list->_list->set_reading(true);
     async_list<plcrash_async_image_t *>::node *next = NULL;
@@ -81,21 +521,75 @@ void plcrash_nasync_image_list_free (plcrash_async_image_list_t *list) {
         
         /* Deallocate the Mach-O reference. */
         plcrash_nasync_macho_free(&image->macho_image);
+
+        /* Deallocate the pre-encoded image data */
+        if (image->_encoded != NULL)
+            free(image->_encoded);
         
         /* Deallocate the actual image value */
-        free(image);
+        if (!image->_batched)
+            free(image);
     }
     list->_list->set_reading(false);
 
-    /* Free the backing list */
+    /* Free the header index */
+    plcrash_nasync_image_list_header_free(list);
+
+    /* Free the name arena; this must follow the release of the images that reference it */
+    while (list->_names != NULL) {
+        struct plcrash_async_image_name_chunk *next_chunk = list->_names->next;
+        free(list->_names);
+        list->_names = next_chunk;
+    }
+
+    /* Free any batch allocations */
+    while (list->_batches != NULL) {
+        struct plcrash_async_image_batch *next_batch = list->_batches->next;
+        free(list->_batches);
+        list->_batches = next_batch;
+    }
+
+    /* Free the shared cache mapping; this must follow the release of the images that reference it */
+    if (list->_shared_cache_mapped)
+        plcrash_async_mobject_free(&list->_shared_cache);
+
+    /* Free the backing list and index */
     delete list->_list;
+    plcrash_nasync_image_index_free(list->_index);
+    plcrash_nasync_image_index_free(list->_retired_index);
     
     mach_port_mod_refs(mach_task_self(), list->task, MACH_PORT_RIGHT_SEND, -1);
 }
 
+/**
+ * @internal
+ *
+ * Background thread entry point; loads all queued deferred images, exiting once the queue is empty.
+ */
+static void *plcrash_nasync_image_list_deferred_worker (void *ctx) {
+    plcrash_async_image_list_t *list = (plcrash_async_image_list_t *) ctx;
+
+    while (true) {
+        while (plcrash_nasync_image_list_load_next_deferred(list));
+
+        /* Images may have been enqueued after our last dequeue; only exit once the queue is verifiably empty. */
+        pthread_mutex_lock(&list->_deferred_lock);
+        if (list->_deferred_head == NULL) {
+            list->_deferred_worker_running = false;
+            pthread_mutex_unlock(&list->_deferred_lock);
+            return NULL;
+        }
+        pthread_mutex_unlock(&list->_deferred_lock);
+    }
+}
+
 /**
  * Append a new binary image record to @a list.
  *
+ * If deferred parsing has been enabled via plcrash_nasync_image_list_set_deferred(), the image is queued and
+ * its Mach-O data is parsed by a background thread; the image will not be visible to readers of the list until
+ * parsing has completed.
+ *
  * @param list The list to which the image record should be appended.
  * @param header The image's header address.
  * @param name The image's name.
@@ -103,75 +597,1203 @@ void plcrash_nasync_image_list_free (plcrash_async_image_list_t *list) {
  * @warning This method is not async safe.
  */
 void plcrash_nasync_image_list_append (plcrash_async_image_list_t *list, pl_vm_address_t header, const char *name) {
-    plcrash_error_t ret;
+    if (!list->_deferred_enabled) {
+        pthread_mutex_lock(&list->_deferred_lock);
+        plcrash_nasync_image_list_append_now(list, header, name);
+        pthread_mutex_unlock(&list->_deferred_lock);
+        return;
+    }
 
-    /* Initialize the new entry. */
-    plcrash_async_image_t *new_entry = (plcrash_async_image_t *) calloc(1, sizeof(plcrash_async_image_t));
-    if ((ret = plcrash_nasync_macho_init(&new_entry->macho_image, list->task, name, header)) != PLCRASH_ESUCCESS) {
-        PLCF_DEBUG("Unexpected failure initializing Mach-O structure for %s: %d", name, ret);
-        free(new_entry);
+    /* Queue the image; on failure, fall back on parsing immediately */
+    if (!plcrash_nasync_image_list_enqueue_deferred(list, header, name)) {
+        pthread_mutex_lock(&list->_deferred_lock);
+        plcrash_nasync_image_list_append_now(list, header, name);
+        pthread_mutex_unlock(&list->_deferred_lock);
         return;
     }
 
-    /* Append */
-    list->_list->nasync_append(new_entry);
+    plcrash_nasync_image_list_start_deferred_worker(list);
 }
 
 /**
- * Remove a binary image record from @a list.
+ * Append @a count binary image records to @a list. This is equivalent to calling plcrash_nasync_image_list_append()
+ * for each image, but allocates all image records with a single allocation, and rebuilds the lookup index only once.
  *
- * @param header The header address of the record to be removed. The first record matching this address will be removed. If no matching
- * header is found, the request will be ignored.
+ * If deferred parsing has been enabled via plcrash_nasync_image_list_set_deferred(), the images are queued for
+ * parsing by the background thread, as per plcrash_nasync_image_list_append().
+ *
+ * @param list The list to which the image records should be appended.
+ * @param headers The images' header addresses.
+ * @param names The images' names.
+ * @param count The number of elements in @a headers and @a names.
  *
  * @warning This method is not async safe.
  */
-void plcrash_nasync_image_list_remove (plcrash_async_image_list_t *list, pl_vm_address_t header) {
-    list->_list->set_reading(true); {
-        /* Find a matching entry */
-        async_list<plcrash_async_image_t *>::node *found = NULL;
-        async_list<plcrash_async_image_t *>::node *next = NULL;
-        while ((next = list->_list->next(next)) != NULL) {
-            if (next->value()->macho_image.header_addr == header) {
-                found = next;
-                break;
+void plcrash_nasync_image_list_append_batch (plcrash_async_image_list_t *list, const pl_vm_address_t *headers, const char * const *names, size_t count) {
+    if (count == 0)
+        return;
+
+    /* Queue the images */
+    if (list->_deferred_enabled) {
+        for (size_t i = 0; i < count; i++) {
+            if (!plcrash_nasync_image_list_enqueue_deferred(list, headers[i], names[i])) {
+                pthread_mutex_lock(&list->_deferred_lock);
+                plcrash_nasync_image_list_append_now(list, headers[i], names[i]);
+                pthread_mutex_unlock(&list->_deferred_lock);
             }
         }
 
-        /* If not found, nothing to do */
-        if (found == NULL) {
-            PLCF_DEBUG("Can't find header addr=%llu in Mach-O image list.", (uint64_t)header);
+        plcrash_nasync_image_list_start_deferred_worker(list);
+        return;
+    }
+
+    /* Allocate all records at once */
+    struct plcrash_async_image_batch *batch;
+    batch = (struct plcrash_async_image_batch *) calloc(1, sizeof(*batch) + (sizeof(batch->images[0]) * (count - 1)));
+    if (batch == NULL) {
+        PLCF_DEBUG("Could not allocate a batch of %zu images", count);
+        for (size_t i = 0; i < count; i++)
+            plcrash_nasync_image_list_append(list, headers[i], names[i]);
+        return;
+    }
+
+    pthread_mutex_lock(&list->_deferred_lock); {
+        batch->next = list->_batches;
+        list->_batches = batch;
+
+        for (size_t i = 0; i < count; i++) {
+            plcrash_async_image_t *image = &batch->images[i];
+            image->_batched = true;
+
+            if (plcrash_nasync_image_list_prepare(list, image, headers[i], names[i]))
+                plcrash_nasync_image_list_header_insert(list, list->_list->nasync_append(image));
+        }
+
+        /* Update the lookup index */
+        plcrash_nasync_image_list_update_index(list, NULL);
+    } pthread_mutex_unlock(&list->_deferred_lock);
+
+    /* Index the published images in the background */
+    if (list->_background_index_enabled)
+        plcrash_nasync_image_list_start_indexer(list);
+}
+
+/**
+ * Return true if an image with @a header has been appended to @a list and not since removed, including images
+ * that are queued for deferred parsing.
+ *
+ * @param list The list to search.
+ * @param header The image header address to search for.
+ *
+ * @warning This method is not async safe.
+ */
+bool plcrash_nasync_image_list_contains (plcrash_async_image_list_t *list, pl_vm_address_t header) {
+    bool found = false;
+
+    /* All writers hold the deferred lock; while held, the list and its index can not be modified. */
+    pthread_mutex_lock(&list->_deferred_lock); {
+        for (struct plcrash_async_image_deferred *entry = list->_deferred_head; entry != NULL && !found; entry = entry->next) {
+            if (entry->header == header)
+                found = true;
+        }
+
+        struct plcrash_async_image_index *index = list->_index;
+        if (!found && index != NULL) {
+            /* Binary search of the address-sorted index */
+            size_t lo = 0;
+            size_t hi = index->count;
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                pl_vm_address_t addr = index->images[mid]->macho_image.header_addr;
+
+                if (addr == header) {
+                    found = true;
+                    break;
+                } else if (addr < header) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+        } else if (!found) {
+            /* No index is available; fall back on a linear search */
+            list->_list->set_reading(true);
+            async_list<plcrash_async_image_t *>::node *next = NULL;
+            while ((next = list->_list->next(next)) != NULL) {
+                if (next->value()->macho_image.header_addr == header) {
+                    found = true;
+                    break;
+                }
+            }
             list->_list->set_reading(false);
-            return;
         }
+    } pthread_mutex_unlock(&list->_deferred_lock);
 
-        /* Delete the entry */
-        list->_list->nasync_remove_node(found);
-    } list->_list->set_reading(false);
+    return found;
 }
 
 /**
- * Retain or release the list for reading. This method is async-safe.
+ * @internal
  *
- * This must be issued prior to attempting to iterate the list, and must called again once reads have completed.
+ * Queue an image for deferred parsing.
  *
- * @param list The list to be be retained or released for reading.
- * @param enable If true, the list will be retained. If false, released.
+ * @param list The list to which the image should be appended.
+ * @param header The image's header address.
+ * @param name The image's name.
+ *
+ * @return Returns true on success, or false if the deferred record could not be allocated.
+ *
+ * @warning This method is not async safe.
  */
-void plcrash_async_image_list_set_reading (plcrash_async_image_list_t *list, bool enable) {
-    list->_list->set_reading(enable);
+static bool plcrash_nasync_image_list_enqueue_deferred (plcrash_async_image_list_t *list, pl_vm_address_t header, const char *name) {
+    struct plcrash_async_image_deferred *entry = (struct plcrash_async_image_deferred *) malloc(sizeof(*entry));
+    if (entry == NULL || (entry->name = strdup(name)) == NULL) {
+        PLCF_DEBUG("Could not allocate a deferred image record for %s", name);
+        free(entry);
+        return false;
+    }
+    entry->header = header;
+    entry->next = NULL;
+
+    pthread_mutex_lock(&list->_deferred_lock); {
+        if (list->_deferred_tail != NULL) {
+            list->_deferred_tail->next = entry;
+        } else {
+            list->_deferred_head = entry;
+        }
+        list->_deferred_tail = entry;
+    } pthread_mutex_unlock(&list->_deferred_lock);
+
+    return true;
 }
 
 /**
- * Return the image containing the given @a address within its TEXT segment. This method is async-safe.
- * If image is found, NULL will be returned.
+ * @internal
  *
- * @param list The list to be iterated.
- * @param address The address to be searched for.
+ * Start the background loader thread for queued deferred images, if not already running. If the thread can not
+ * be started, all queued images are loaded synchronously.
  *
- * @warning The list must be retained for reading via plcrash_async_image_list_set_reading() before calling this function.
+ * @param list The list for which the loader should be started.
+ *
+ * @warning This method is not async safe.
  */
-plcrash_async_image_t *plcrash_async_image_containing_address (plcrash_async_image_list_t *list, pl_vm_address_t address) {
-    plcrash_async_image_t *image = NULL;
+static void plcrash_nasync_image_list_start_deferred_worker (plcrash_async_image_list_t *list) {
+    bool loader_available;
+
+    pthread_mutex_lock(&list->_deferred_lock); {
+        if (!list->_deferred_worker_running) {
+            pthread_attr_t attr;
+            pthread_t thr;
+
+            pthread_attr_init(&attr);
+            pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+            int err = pthread_create(&thr, &attr, plcrash_nasync_image_list_deferred_worker, list);
+            if (err == 0) {
+                list->_deferred_worker_running = true;
+            } else {
+                PLCF_DEBUG("Could not start the deferred image loader thread: %s", strerror(err));
+            }
+            pthread_attr_destroy(&attr);
+        }
+
+        loader_available = list->_deferred_worker_running;
+    } pthread_mutex_unlock(&list->_deferred_lock);
+
+    /* If no background loader is available, load the images synchronously */
+    if (!loader_available)
+        plcrash_nasync_image_list_load_deferred(list);
+}
+
+/**
+ * Enable use of a single shared mapping for the Mach-O headers of images within the dyld shared cache. The first
+ * appended image found within the shared cache triggers a mapping of the shared cache's text region; the headers
+ * and load commands of that image and all subsequently appended cached images are then referenced from that mapping,
+ * rather than each requiring a distinct mapping. The mapping is held until the list is freed.
+ *
+ * This applies only to images appended after this call.
+ *
+ * @param list The list to configure.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_enable_shared_cache (plcrash_async_image_list_t *list) {
+    list->_shared_cache_enabled = true;
+    OSMemoryBarrier();
+}
+
+/**
+ * Enable use of the dyld shared cache's precomputed Objective-C optimization data for the images in @a list. The
+ * cache's optimization header is read once, and applied to all current and subsequently appended images within the
+ * shared cache, allowing the shared cache's direct selector method lists to be parsed.
+ *
+ * This must be called prior to plcrash_nasync_image_list_enable_objc_index(); Objective-C indexes that have already
+ * been built will not be updated.
+ *
+ * @param list The list to configure.
+ * @param cache_base The task-relative address of the shared cache's header, as reported by the task's
+ * dyld_all_image_infos.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an error result if the cache's optimization data could not be
+ * read. On failure, the list is left unmodified. See plcrash_nasync_objc_shared_cache_init().
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_image_list_enable_objc_shared_cache (plcrash_async_image_list_t *list, pl_vm_address_t cache_base) {
+    plcrash_error_t err;
+
+    if (list->_objc_shared_cache_enabled)
+        return PLCRASH_ESUCCESS;
+
+    if ((err = plcrash_nasync_objc_shared_cache_init(&list->_objc_shared_cache, list->task, cache_base)) != PLCRASH_ESUCCESS)
+        return err;
+
+    OSMemoryBarrier();
+    list->_objc_shared_cache_enabled = true;
+    OSMemoryBarrier();
+
+    /* Apply to all existing images */
+    plcrash_async_image_list_set_reading(list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(list, image)) != NULL)
+        plcrash_async_objc_shared_cache_apply(&list->_objc_shared_cache, &image->macho_image);
+    plcrash_async_image_list_set_reading(list, false);
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Return the shared cache mapping to be used when parsing the image at @a header, mapping the shared cache's text
+ * region if @a header is the first image found within it. The caller must hold the list's deferred lock.
+ *
+ * @param list The list for which the mapping should be returned.
+ * @param header The header address of the image to be parsed.
+ *
+ * @return Returns the shared cache mapping, or NULL if shared cache mapping is disabled or unavailable. The returned
+ * mapping may not contain @a header; plcrash_nasync_macho_init_shared() will fall back on a distinct mapping.
+ *
+ * @warning This method is not async safe.
+ */
+static plcrash_async_mobject_t *plcrash_nasync_image_list_shared_cache (plcrash_async_image_list_t *list, pl_vm_address_t header) {
+    if (!list->_shared_cache_enabled || list->_shared_cache_failed)
+        return NULL;
+
+    if (list->_shared_cache_mapped)
+        return &list->_shared_cache;
+
+    /* Find the leaf region containing the header. The shared cache is mapped into every task via a nested submap;
+     * images outside of a submap are not part of the shared cache. */
+    vm_region_submap_info_data_64_t info;
+    mach_msg_type_number_t count;
+    natural_t depth = 0;
+    kern_return_t kt;
+
+#ifdef PL_HAVE_MACH_VM
+    mach_vm_address_t region_addr;
+    mach_vm_size_t region_size;
+#else
+    vm_address_t region_addr;
+    vm_size_t region_size;
+#endif
+
+    while (true) {
+        region_addr = header;
+        count = VM_REGION_SUBMAP_INFO_COUNT_64;
+#ifdef PL_HAVE_MACH_VM
+        kt = mach_vm_region_recurse(list->task, &region_addr, &region_size, &depth, (vm_region_recurse_info_t) &info, &count);
+#else
+        kt = vm_region_recurse_64(list->task, &region_addr, &region_size, &depth, (vm_region_recurse_info_t) &info, &count);
+#endif
+        if (kt != KERN_SUCCESS || !info.is_submap)
+            break;
+
+        depth++;
+    }
+
+    if (kt != KERN_SUCCESS || depth == 0 || region_addr > header || (info.protection & VM_PROT_READ) == 0)
+        return NULL;
+
+    /* Map the full region. Short mappings are permitted, in which case images beyond the mapped range will simply
+     * fall back on distinct mappings. */
+    if (plcrash_async_mobject_init_persistent(&list->_shared_cache, list->task, region_addr, region_size, false) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not map the shared cache region at 0x%" PRIx64, (uint64_t) region_addr);
+        list->_shared_cache_failed = true;
+        return NULL;
+    }
+
+    list->_shared_cache_mapped = true;
+    return &list->_shared_cache;
+}
+
+/**
+ * Enable or disable deferred parsing of appended images. When enabled, plcrash_nasync_image_list_append() only
+ * records the image's header address and name; the image's Mach-O data is parsed, and the image is made visible
+ * to readers, by a background thread.
+ *
+ * Images that have not yet been loaded will not be visible to readers of the list, including crash-time readers.
+ * Non-async-safe callers that require a complete view of the list may call plcrash_nasync_image_list_load_deferred().
+ *
+ * @param list The list to configure.
+ * @param enabled If true, image parsing will be deferred.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_set_deferred (plcrash_async_image_list_t *list, bool enabled) {
+    list->_deferred_enabled = enabled;
+    OSMemoryBarrier();
+}
+
+/**
+ * Enable or disable compact image storage. When enabled, each image's load command and section mappings are
+ * released once the image has been parsed and indexed, and are re-mapped on demand, including at crash time.
+ * Images within the shared cache mapping enabled via plcrash_nasync_image_list_enable_shared_cache() hold no
+ * load command mapping of their own.
+ *
+ * This reduces the steady-state footprint of the list, at the cost of additional mapping work at crash time.
+ * The setting applies to images parsed after this call; images that have already been published are unaffected.
+ *
+ * @param list The list to configure.
+ * @param enabled If true, image mappings will be released once parsed.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_set_compact (plcrash_async_image_list_t *list, bool enabled) {
+    list->_compact_enabled = enabled;
+    OSMemoryBarrier();
+}
+
+/**
+ * Synchronously load all images queued for deferred parsing.
+ *
+ * @param list The list for which all deferred images should be loaded.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_load_deferred (plcrash_async_image_list_t *list) {
+    while (plcrash_nasync_image_list_load_next_deferred(list));
+}
+
+/**
+ * @internal
+ *
+ * Dequeue and load the next deferred image, if any.
+ *
+ * @param list The list from which a deferred image should be loaded.
+ *
+ * @return Returns true if an image was dequeued, or false if the queue was empty.
+ *
+ * @warning This method is not async safe.
+ */
+static bool plcrash_nasync_image_list_load_next_deferred (plcrash_async_image_list_t *list) {
+    struct plcrash_async_image_deferred *entry;
+
+    /* The lock is held while appending, ensuring that a concurrent removal will find the image either in the
+     * queue, or in the list. */
+    pthread_mutex_lock(&list->_deferred_lock); {
+        entry = list->_deferred_head;
+        if (entry == NULL) {
+            pthread_mutex_unlock(&list->_deferred_lock);
+            return false;
+        }
+
+        list->_deferred_head = entry->next;
+        if (list->_deferred_head == NULL)
+            list->_deferred_tail = NULL;
+
+        plcrash_nasync_image_list_append_now(list, entry->header, entry->name);
+    } pthread_mutex_unlock(&list->_deferred_lock);
+
+    free(entry->name);
+    free(entry);
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Parse and append a new binary image record to @a list. The caller must hold the list's deferred lock.
+ *
+ * @param list The list to which the image record should be appended.
+ * @param header The image's header address.
+ * @param name The image's name.
+ *
+ * @warning This method is not async safe.
+ */
+static void plcrash_nasync_image_list_append_now (plcrash_async_image_list_t *list, pl_vm_address_t header, const char *name) {
+    /* Initialize the new entry. */
+    plcrash_async_image_t *new_entry = (plcrash_async_image_t *) calloc(1, sizeof(plcrash_async_image_t));
+    if (new_entry == NULL) {
+        PLCF_DEBUG("Could not allocate an image record for %s", name);
+        return;
+    }
+
+    if (!plcrash_nasync_image_list_prepare(list, new_entry, header, name)) {
+        free(new_entry);
+        return;
+    }
+
+    /* Append */
+    plcrash_nasync_image_list_header_insert(list, list->_list->nasync_append(new_entry));
+
+    /* Update the lookup index */
+    plcrash_nasync_image_list_update_index(list, NULL);
+
+    /* Index the published image in the background */
+    if (new_entry->_index_pending)
+        plcrash_nasync_image_list_start_indexer(list);
+}
+
+/**
+ * @internal
+ *
+ * Initialize the zero-initialized image record @a new_entry for publication in @a list, parsing its Mach-O data
+ * and building any enabled indexes.
+ *
+ * @param list The list to which the image record will be appended.
+ * @param new_entry The image record to initialize.
+ * @param header The image's header address.
+ * @param name The image's name.
+ *
+ * @return Returns true on success, or false if the image's Mach-O data could not be parsed.
+ *
+ * @warning This method is not async safe.
+ */
+static bool plcrash_nasync_image_list_prepare (plcrash_async_image_list_t *list, plcrash_async_image_t *new_entry, pl_vm_address_t header, const char *name) {
+    plcrash_error_t ret;
+
+    plcrash_async_mobject_t *shared_cache = plcrash_nasync_image_list_shared_cache(list, header);
+    if ((ret = plcrash_nasync_macho_init_shared(&new_entry->macho_image, list->task, name, header, shared_cache)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Unexpected failure initializing Mach-O structure for %s: %d", name, ret);
+        return false;
+    }
+
+    /* Move the name into the list's string arena. This is optional; on failure, the image retains its own copy. */
+    char *interned = plcrash_nasync_image_list_intern_name(list, name);
+    if (interned != NULL)
+        plcrash_nasync_macho_borrow_name(&new_entry->macho_image, interned);
+
+    /* Classify the image, allowing the writer to select a symbolication strategy without inspecting the image */
+    bool in_shared_cache = shared_cache != NULL && plcrash_async_mobject_remap_address(shared_cache, header, 0, 1) != NULL;
+    new_entry->_image_class = plcrash_nasync_image_classify(&new_entry->macho_image, in_shared_cache);
+
+    /* Apply the shared cache's Objective-C optimization data prior to building the image's Objective-C index */
+    if (list->_objc_shared_cache_enabled)
+        plcrash_async_objc_shared_cache_apply(&list->_objc_shared_cache, &new_entry->macho_image);
+
+    /* Record the absence of any unwind sections, allowing the frame walker to skip readers that can not succeed.
+     * This also populates the image's section cache. */
+    {
+        plcrash_async_mobject_t storage;
+        plcrash_async_mobject_t *mobj;
+
+        new_entry->_no_compact_unwind = true;
+        if ((ret = plcrash_async_macho_map_known_section_cached(&new_entry->macho_image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO, &storage, &mobj)) != PLCRASH_ENOTFOUND) {
+            new_entry->_no_compact_unwind = false;
+            if (ret == PLCRASH_ESUCCESS)
+                plcrash_async_macho_mapped_section_release(&storage, mobj);
+        }
+
+        new_entry->_no_dwarf_unwind = true;
+        if ((ret = plcrash_async_macho_map_known_section_cached(&new_entry->macho_image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_EH_FRAME, &storage, &mobj)) != PLCRASH_ENOTFOUND) {
+            new_entry->_no_dwarf_unwind = false;
+            if (ret == PLCRASH_ESUCCESS)
+                plcrash_async_macho_mapped_section_release(&storage, mobj);
+        } else if ((ret = plcrash_async_macho_map_known_section_cached(&new_entry->macho_image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_DEBUG_FRAME, &storage, &mobj)) != PLCRASH_ENOTFOUND) {
+            new_entry->_no_dwarf_unwind = false;
+            if (ret == PLCRASH_ESUCCESS)
+                plcrash_async_macho_mapped_section_release(&storage, mobj);
+        }
+    }
+
+    /* Build the enabled indexes prior to publishing the image, or mark the image for the background builder */
+    if (list->_background_index_enabled) {
+        new_entry->_index_pending = 1;
+    } else {
+        plcrash_nasync_image_list_build_indexes(list, new_entry);
+    }
+
+    /* Release the image's mappings; they will be re-mapped if required by the background builder or at crash time. */
+    if (list->_compact_enabled)
+        plcrash_nasync_macho_compact(&new_entry->macho_image);
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Build all enabled indexes for @a image, and pre-encode the image if encoding is enabled. Each index is optional;
+ * on failure, crash-time lookups will fall back on the image's unindexed data. Indexes that have already been built
+ * are left unmodified.
+ *
+ * @param list The list containing @a image.
+ * @param image The image to index.
+ *
+ * @warning This method is not async safe.
+ */
+static void plcrash_nasync_image_list_build_indexes (plcrash_async_image_list_t *list, plcrash_async_image_t *image) {
+    plcrash_async_macho_t *macho = &image->macho_image;
+    const char *name = macho->name;
+    plcrash_error_t ret;
+
+    /* Build the symbol index. On failure, symbol lookups will fall back to a linear search. */
+    if (list->_symbol_index_enabled) {
+        if ((ret = plcrash_nasync_macho_build_symbol_index(macho)) != PLCRASH_ESUCCESS)
+            PLCF_DEBUG("Could not build a symbol index for %s: %d", name, ret);
+
+        if ((ret = plcrash_nasync_macho_build_function_starts(macho)) != PLCRASH_ESUCCESS && ret != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("Could not build a function start table for %s: %d", name, ret);
+    }
+
+    /* Likewise for the Objective-C index; images without Objective-C data will simply not be indexed. */
+    if (list->_objc_index_enabled) {
+        if ((ret = plcrash_nasync_objc_build_imp_index(macho)) != PLCRASH_ESUCCESS && ret != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("Could not build an Objective-C index for %s: %d", name, ret);
+    }
+
+#if PLCRASH_FEATURE_UNWIND_DWARF
+    /* Likewise for the FDE index; images without an __eh_frame section will simply not be indexed. */
+    if (list->_fde_index_enabled) {
+        if ((ret = plcrash_nasync_dwarf_build_fde_index(macho)) != PLCRASH_ESUCCESS && ret != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("Could not build a FDE index for %s: %d", name, ret);
+    }
+#endif
+
+#if PLCRASH_FEATURE_UNWIND_COMPACT
+    /* Likewise for the CFE index; images without an __unwind_info section will simply not be indexed. */
+    if (list->_cfe_index_enabled) {
+        if ((ret = plcrash_nasync_cfe_build_index(macho)) != PLCRASH_ESUCCESS && ret != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("Could not build a CFE index for %s: %d", name, ret);
+    }
+#endif
+
+    /* Pre-encode the image; on failure, the image will be encoded at crash time. */
+    plcrash_async_image_encoder_t encoder = list->_image_encoder;
+    if (encoder != NULL)
+        plcrash_nasync_image_encode(image, encoder);
+}
+
+/**
+ * @internal
+ *
+ * Return the approximate number of bytes allocated for the indexes and pre-encoded representation of @a image.
+ *
+ * @param image The image to measure.
+ */
+static size_t plcrash_nasync_image_index_footprint (plcrash_async_image_t *image) {
+    plcrash_async_macho_t *macho = &image->macho_image;
+    size_t total = 0;
+
+    if (image->_encoded != NULL)
+        total += image->_encoded_length;
+
+    if (macho->symbol_index != NULL)
+        total += sizeof(*macho->symbol_index) + (sizeof(macho->symbol_index->entries[0]) * macho->symbol_index->count);
+
+    if (macho->function_starts != NULL)
+        total += sizeof(*macho->function_starts) + (sizeof(macho->function_starts->offsets[0]) * macho->function_starts->count);
+
+    if (macho->objc_index != NULL)
+        total += sizeof(*macho->objc_index) + (sizeof(macho->objc_index->entries[0]) * macho->objc_index->count);
+
+    if (macho->fde_index != NULL)
+        total += sizeof(*macho->fde_index) + (sizeof(macho->fde_index->entries[0]) * macho->fde_index->count);
+
+    if (macho->cfe_index != NULL)
+        total += sizeof(*macho->cfe_index) + (sizeof(macho->cfe_index->entries[0]) * macho->cfe_index->count);
+
+    return total;
+}
+
+/**
+ * Enable or disable background indexing. When enabled, the indexes enabled via the plcrash_nasync_image_list_enable_*()
+ * functions, as well as pre-encoded image data, are built by a low priority background thread once each image has
+ * been published, rather than synchronously by the appending or enabling thread. Each index is atomically published
+ * to its image once built, and is used by crash-time readers from that point on; until then, readers fall back on
+ * the image's unindexed data.
+ *
+ * Pending images are indexed in priority order: the main executable, followed by any other application images, and
+ * finally system images. Once the approximate memory allocated by background builds reaches @a memory_limit, no
+ * further images will be indexed; the image whose build crosses the limit is still indexed in full.
+ *
+ * The setting applies to images appended and indexes enabled after this call.
+ *
+ * @param list The list to configure.
+ * @param enabled If true, indexes will be built in the background.
+ * @param memory_limit The approximate number of bytes that may be allocated by background builds, or 0 if unlimited.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_set_background_indexing (plcrash_async_image_list_t *list, bool enabled, size_t memory_limit) {
+    pthread_mutex_lock(&list->_indexer_lock); {
+        list->_indexer_memory_limit = memory_limit;
+    } pthread_mutex_unlock(&list->_indexer_lock);
+
+    list->_background_index_enabled = enabled;
+    OSMemoryBarrier();
+}
+
+/**
+ * Synchronously build the indexes of all images pending background indexing, subject to the memory limit configured
+ * via plcrash_nasync_image_list_set_background_indexing(). This may be called concurrently with the background
+ * builder; each image is indexed only once.
+ *
+ * @param list The list for which all pending indexes should be built.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_build_pending_indexes (plcrash_async_image_list_t *list) {
+    while (plcrash_nasync_image_list_build_next_index(list));
+}
+
+/**
+ * @internal
+ *
+ * If background indexing is enabled, mark all images in @a list for indexing, and start the background builder.
+ *
+ * @param list The list to be indexed.
+ *
+ * @return Returns true if the images were scheduled for background indexing, or false if the caller should index
+ * the images synchronously.
+ *
+ * @warning This method is not async safe.
+ */
+static bool plcrash_nasync_image_list_schedule_indexes (plcrash_async_image_list_t *list) {
+    if (!list->_background_index_enabled)
+        return false;
+
+    /* Index builds are no-ops for indexes that already exist, so an image that is already pending or indexed may be
+     * safely re-marked. */
+    plcrash_async_image_list_set_reading(list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(list, image)) != NULL)
+        OSAtomicCompareAndSwap32Barrier(0, 1, &image->_index_pending);
+    plcrash_async_image_list_set_reading(list, false);
+
+    plcrash_nasync_image_list_start_indexer(list);
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Claim and index the highest priority image pending background indexing.
+ *
+ * @param list The list to be indexed.
+ *
+ * @return Returns true if indexing should continue, or false if no images are pending, the memory limit has been
+ * reached, or the list is being freed.
+ *
+ * @warning This method is not async safe.
+ */
+static bool plcrash_nasync_image_list_build_next_index (plcrash_async_image_list_t *list) {
+    if (list->_indexer_cancelled)
+        return false;
+
+    bool exhausted;
+    pthread_mutex_lock(&list->_indexer_lock); {
+        exhausted = list->_indexer_memory_limit != 0 && list->_indexer_memory_used >= list->_indexer_memory_limit;
+    } pthread_mutex_unlock(&list->_indexer_lock);
+
+    if (exhausted)
+        return false;
+
+    plcrash_async_image_list_set_reading(list, true);
+
+    /* Find the first pending image of the highest priority class; the classes are declared in priority order. */
+    plcrash_async_image_t *best = NULL;
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(list, image)) != NULL) {
+        if (!image->_index_pending)
+            continue;
+
+        if (best == NULL || image->_image_class < best->_image_class) {
+            best = image;
+            if (best->_image_class == PLCRASH_ASYNC_IMAGE_CLASS_MAIN_EXECUTABLE)
+                break;
+        }
+    }
+
+    if (best == NULL) {
+        plcrash_async_image_list_set_reading(list, false);
+        return false;
+    }
+
+    /* Claim the image; if another builder claimed it first, simply try again. The claim is made under the indexer lock,
+     * allowing plcrash_nasync_image_list_remove() to wait for the build to complete before the image is unmapped. An
+     * image that is being removed is never claimed. */
+    bool claimed = false;
+    pthread_mutex_lock(&list->_indexer_lock); {
+        if (!best->_index_removed && OSAtomicCompareAndSwap32Barrier(1, 0, &best->_index_pending)) {
+            best->_index_building = true;
+            claimed = true;
+        }
+    } pthread_mutex_unlock(&list->_indexer_lock);
+
+    if (claimed) {
+        size_t initial = plcrash_nasync_image_index_footprint(best);
+        plcrash_nasync_image_list_build_indexes(list, best);
+        size_t final = plcrash_nasync_image_index_footprint(best);
+
+        pthread_mutex_lock(&list->_indexer_lock); {
+            list->_indexer_memory_used += final - initial;
+            best->_index_building = false;
+            pthread_cond_broadcast(&list->_indexer_cond);
+        } pthread_mutex_unlock(&list->_indexer_lock);
+    }
+
+    plcrash_async_image_list_set_reading(list, false);
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Background thread entry point; indexes all pending images, exiting once no further images can be indexed.
+ */
+static void *plcrash_nasync_image_list_indexer (void *ctx) {
+    plcrash_async_image_list_t *list = (plcrash_async_image_list_t *) ctx;
+    uint32_t generation;
+
+    pthread_mutex_lock(&list->_indexer_lock); {
+        generation = list->_indexer_generation;
+    } pthread_mutex_unlock(&list->_indexer_lock);
+
+    while (true) {
+        while (plcrash_nasync_image_list_build_next_index(list));
+
+        /* Images may have been marked after our last scan; only exit once no images have been marked since. */
+        pthread_mutex_lock(&list->_indexer_lock);
+        if (list->_indexer_cancelled || list->_indexer_generation == generation) {
+            list->_indexer_running = false;
+            pthread_mutex_unlock(&list->_indexer_lock);
+            return NULL;
+        }
+        generation = list->_indexer_generation;
+        pthread_mutex_unlock(&list->_indexer_lock);
+    }
+}
+
+/**
+ * @internal
+ *
+ * Notify the background index builder of newly marked images, starting the builder if not already running. If the
+ * builder can not be started, all pending images are indexed synchronously.
+ *
+ * @param list The list for which the builder should be started.
+ *
+ * @warning This method is not async safe.
+ */
+static void plcrash_nasync_image_list_start_indexer (plcrash_async_image_list_t *list) {
+    bool indexer_available;
+
+    pthread_mutex_lock(&list->_indexer_lock); {
+        list->_indexer_generation++;
+
+        if (!list->_indexer_running) {
+            pthread_attr_t attr;
+            pthread_t thr;
+
+            pthread_attr_init(&attr);
+            pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+#if PLCRASH_ASYNC_IMAGE_LIST_QOS
+            /* Build at utility QoS where supported; the function is weakly linked on older deployment targets. */
+            if (&pthread_attr_set_qos_class_np != NULL)
+                pthread_attr_set_qos_class_np(&attr, QOS_CLASS_UTILITY, 0);
+#endif
+            int err = pthread_create(&thr, &attr, plcrash_nasync_image_list_indexer, list);
+            if (err == 0) {
+                list->_indexer_running = true;
+            } else {
+                PLCF_DEBUG("Could not start the background index builder thread: %s", strerror(err));
+            }
+            pthread_attr_destroy(&attr);
+        }
+
+        indexer_available = list->_indexer_running;
+    } pthread_mutex_unlock(&list->_indexer_lock);
+
+    /* If no background builder is available, index the images synchronously */
+    if (!indexer_available)
+        plcrash_nasync_image_list_build_pending_indexes(list);
+}
+
+/**
+ * @internal
+ *
+ * Copy @a name into the string arena of @a list. The caller must hold the list's deferred lock.
+ *
+ * @param list The list into whose arena @a name should be copied.
+ * @param name The NUL-terminated name to copy.
+ *
+ * @return Returns the copy, which remains valid until @a list is freed, or NULL if the arena could not be extended.
+ *
+ * @warning This method is not async safe.
+ */
+static char *plcrash_nasync_image_list_intern_name (plcrash_async_image_list_t *list, const char *name) {
+    size_t length = strlen(name) + 1;
+    struct plcrash_async_image_name_chunk *chunk = list->_names;
+
+    /* Start a new chunk if the current chunk is full. The remainder of the old chunk is abandoned. */
+    if (chunk == NULL || chunk->capacity - chunk->used < length) {
+        size_t capacity = length > PLCRASH_ASYNC_IMAGE_NAME_CHUNK_SIZE ? length : PLCRASH_ASYNC_IMAGE_NAME_CHUNK_SIZE;
+        chunk = (struct plcrash_async_image_name_chunk *) malloc(sizeof(*chunk) - sizeof(chunk->data) + capacity);
+        if (chunk == NULL) {
+            PLCF_DEBUG("Could not allocate a %zu byte image name chunk", capacity);
+            return NULL;
+        }
+
+        chunk->next = list->_names;
+        chunk->used = 0;
+        chunk->capacity = capacity;
+        list->_names = chunk;
+    }
+
+    char *copy = chunk->data + chunk->used;
+    memcpy(copy, name, length);
+    chunk->used += length;
+
+    return copy;
+}
+
+/**
+ * @internal
+ *
+ * Determine the class of @a image.
+ *
+ * @param image The image to be classified.
+ * @param shared_cache If true, the image's header is known to reside within the dyld shared cache.
+ *
+ * @warning This method is not async safe.
+ */
+static plcrash_async_image_class_t plcrash_nasync_image_classify (plcrash_async_macho_t *image, bool shared_cache) {
+    uint32_t filetype = image->byteorder->swap32(image->header.filetype);
+    uint32_t flags = image->byteorder->swap32(image->header.flags);
+
+    if (filetype == MH_EXECUTE)
+        return PLCRASH_ASYNC_IMAGE_CLASS_MAIN_EXECUTABLE;
+
+    if (shared_cache || (flags & MH_DYLIB_IN_CACHE) != 0)
+        return PLCRASH_ASYNC_IMAGE_CLASS_SYSTEM;
+
+    /* Fall back on the install path; system images outside of the shared cache (and all system images within the
+     * simulator runtime root) are only identifiable by their location. */
+    const char *name = image->name;
+    if (name != NULL) {
+        static const char *system_prefixes[] = { "/System/", "/usr/lib/", "/Library/Apple/" };
+        for (size_t i = 0; i < sizeof(system_prefixes) / sizeof(system_prefixes[0]); i++) {
+            if (strncmp(name, system_prefixes[i], strlen(system_prefixes[i])) == 0)
+                return PLCRASH_ASYNC_IMAGE_CLASS_SYSTEM;
+        }
+
+        if (strstr(name, "/RuntimeRoot/") != NULL)
+            return PLCRASH_ASYNC_IMAGE_CLASS_SYSTEM;
+    }
+
+    return PLCRASH_ASYNC_IMAGE_CLASS_APPLICATION;
+}
+
+/**
+ * Enable building of symbol indexes for the images in @a list. Indexes will be built for all current images, as
+ * well as any images appended after this call. Symbol indexes allow for symbol table lookups with a binary search,
+ * at the cost of additional (non-crash-time) memory and setup time. The images' LC_FUNCTION_STARTS tables are
+ * decoded at the same time, allowing symbols that do not belong to the function containing a PC to be rejected.
+ *
+ * @param list The list for which symbol indexes should be built.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_enable_symbol_index (plcrash_async_image_list_t *list) {
+    list->_symbol_index_enabled = true;
+    OSMemoryBarrier();
+
+    /* Defer to the background builder, if enabled */
+    if (plcrash_nasync_image_list_schedule_indexes(list))
+        return;
+
+    /* Index all existing images. Concurrently appended images may be visited twice; the second build is a no-op. */
+    plcrash_async_image_list_set_reading(list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(list, image)) != NULL) {
+        plcrash_error_t ret = plcrash_nasync_macho_build_symbol_index(&image->macho_image);
+        if (ret != PLCRASH_ESUCCESS)
+            PLCF_DEBUG("Could not build a symbol index for %s: %d", image->macho_image.name, ret);
+
+        ret = plcrash_nasync_macho_build_function_starts(&image->macho_image);
+        if (ret != PLCRASH_ESUCCESS && ret != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("Could not build a function start table for %s: %d", image->macho_image.name, ret);
+    }
+    plcrash_async_image_list_set_reading(list, false);
+}
+
+/**
+ * Enable building of Objective-C IMP indexes for the images in @a list. Indexes will be built for all current images,
+ * as well as any images appended after this call. IMP indexes allow for Objective-C method lookups with a binary search,
+ * rather than parsing all of an image's class data for each lookup, at the cost of additional (non-crash-time) memory
+ * and setup time.
+ *
+ * @param list The list for which Objective-C indexes should be built.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_enable_objc_index (plcrash_async_image_list_t *list) {
+    list->_objc_index_enabled = true;
+    OSMemoryBarrier();
+
+    /* Defer to the background builder, if enabled */
+    if (plcrash_nasync_image_list_schedule_indexes(list))
+        return;
+
+    /* Index all existing images. Concurrently appended images may be visited twice; the second build is a no-op. */
+    plcrash_async_image_list_set_reading(list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(list, image)) != NULL) {
+        plcrash_error_t ret = plcrash_nasync_objc_build_imp_index(&image->macho_image);
+        if (ret != PLCRASH_ESUCCESS && ret != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("Could not build an Objective-C index for %s: %d", image->macho_image.name, ret);
+    }
+    plcrash_async_image_list_set_reading(list, false);
+}
+
+/**
+ * Enable building of __eh_frame FDE indexes for the images in @a list. Indexes will be built for all current images,
+ * as well as any images appended after this call; if deferred parsing is enabled, appended images are indexed by the
+ * background loader. FDE indexes allow DWARF FDE lookups with a binary search, rather than a linear walk of the image's
+ * __eh_frame section, at the cost of additional (non-crash-time) memory and setup time.
+ *
+ * If DWARF unwinding is not supported, this function is a no-op.
+ *
+ * @param list The list for which FDE indexes should be built.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_enable_fde_index (plcrash_async_image_list_t *list) {
+#if PLCRASH_FEATURE_UNWIND_DWARF
+    list->_fde_index_enabled = true;
+    OSMemoryBarrier();
+
+    /* Defer to the background builder, if enabled */
+    if (plcrash_nasync_image_list_schedule_indexes(list))
+        return;
+
+    /* Index all existing images. Concurrently appended images may be visited twice; the second build is a no-op. */
+    plcrash_async_image_list_set_reading(list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(list, image)) != NULL) {
+        plcrash_error_t ret = plcrash_nasync_dwarf_build_fde_index(&image->macho_image);
+        if (ret != PLCRASH_ESUCCESS && ret != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("Could not build a FDE index for %s: %d", image->macho_image.name, ret);
+    }
+    plcrash_async_image_list_set_reading(list, false);
+#endif
+}
+
+/**
+ * Enable building of validated __unwind_info first-level indexes for the images in @a list. Indexes will be built for
+ * all current images, as well as any images appended after this call; if deferred parsing is enabled, appended images
+ * are indexed by the background loader. The index is copied and validated once, allowing crash-time compact unwind
+ * lookups to locate an image's second-level page without mapping or re-validating the image's first-level index.
+ *
+ * If compact unwinding is not supported, this function is a no-op.
+ *
+ * @param list The list for which CFE indexes should be built.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_enable_cfe_index (plcrash_async_image_list_t *list) {
+#if PLCRASH_FEATURE_UNWIND_COMPACT
+    list->_cfe_index_enabled = true;
+    OSMemoryBarrier();
+
+    /* Defer to the background builder, if enabled */
+    if (plcrash_nasync_image_list_schedule_indexes(list))
+        return;
+
+    /* Index all existing images. Concurrently appended images may be visited twice; the second build is a no-op. */
+    plcrash_async_image_list_set_reading(list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(list, image)) != NULL) {
+        plcrash_error_t ret = plcrash_nasync_cfe_build_index(&image->macho_image);
+        if (ret != PLCRASH_ESUCCESS && ret != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("Could not build a CFE index for %s: %d", image->macho_image.name, ret);
+    }
+    plcrash_async_image_list_set_reading(list, false);
+#endif
+}
+
+/**
+ * @internal
+ *
+ * Pre-encode @a image using @a encoder, if it has not already been encoded.
+ *
+ * @param image The image to encode.
+ * @param encoder The encoder to be used.
+ *
+ * @warning This method is not async safe.
+ */
+static void plcrash_nasync_image_encode (plcrash_async_image_t *image, plcrash_async_image_encoder_t encoder) {
+    void *data;
+    size_t length;
+    plcrash_error_t ret;
+
+    if (image->_encoded != NULL)
+        return;
+
+    if ((ret = encoder(&image->macho_image, &data, &length)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not pre-encode image %s: %d", image->macho_image.name, ret);
+        return;
+    }
+
+    /* The length must be visible before the data pointer is published. If the image was concurrently encoded,
+     * discard our copy. */
+    image->_encoded_length = length;
+    if (!OSAtomicCompareAndSwapPtrBarrier(NULL, data, (void * volatile *) &image->_encoded))
+        free(data);
+}
+
+/**
+ * Enable pre-encoding of the images in @a list. All current images will be encoded, as well as any images appended
+ * after this call. Pre-encoding allows an image's crash report representation to be emitted at crash time without
+ * re-reading the image's load commands from the target task.
+ *
+ * @param list The list for which images should be encoded.
+ * @param encoder The function to be used to encode each image.
+ *
+ * @warning This method is not async safe, and must not be called concurrently with itself.
+ */
+void plcrash_nasync_image_list_enable_image_encoding (plcrash_async_image_list_t *list, plcrash_async_image_encoder_t encoder) {
+    list->_image_encoder = encoder;
+    OSMemoryBarrier();
+
+    /* Defer to the background builder, if enabled */
+    if (plcrash_nasync_image_list_schedule_indexes(list))
+        return;
+
+    /* Encode all existing images. Concurrently appended images may be visited twice; the second encoding is a no-op. */
+    plcrash_async_image_list_set_reading(list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(list, image)) != NULL)
+        plcrash_nasync_image_encode(image, encoder);
+    plcrash_async_image_list_set_reading(list, false);
+}
+
+/**
+ * Remove a binary image record from @a list.
+ *
+ * @param header The header address of the record to be removed. The first record matching this address will be removed. If no matching
+ * header is found, the request will be ignored.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_image_list_remove (plcrash_async_image_list_t *list, pl_vm_address_t header) {
+    pthread_mutex_lock(&list->_deferred_lock);
+
+    /* If the image has not yet been loaded, simply drop it from the deferred queue */
+    struct plcrash_async_image_deferred *prev = NULL;
+    for (struct plcrash_async_image_deferred *entry = list->_deferred_head; entry != NULL; prev = entry, entry = entry->next) {
+        if (entry->header != header)
+            continue;
+
+        if (prev != NULL) {
+            prev->next = entry->next;
+        } else {
+            list->_deferred_head = entry->next;
+        }
+
+        if (list->_deferred_tail == entry)
+            list->_deferred_tail = prev;
+
+        pthread_mutex_unlock(&list->_deferred_lock);
+        free(entry->name);
+        free(entry);
+        return;
+    }
+
+    /* Find and unlink a matching entry */
+    async_list<plcrash_async_image_t *>::node *found = plcrash_nasync_image_list_header_find(list, header, true);
+
+    /* If not found, nothing to do */
+    if (found == NULL) {
+        PLCF_DEBUG("Can't find header addr=%llu in Mach-O image list.", (uint64_t)header);
+        pthread_mutex_unlock(&list->_deferred_lock);
+        return;
+    }
+
+    /* Prevent the image from being claimed by the background index builder, and wait for any in-progress build to
+     * complete; the image will be unmapped once we return. */
+    plcrash_async_image_t *image = found->value();
+    pthread_mutex_lock(&list->_indexer_lock); {
+        image->_index_removed = true;
+        while (image->_index_building)
+            pthread_cond_wait(&list->_indexer_cond, &list->_indexer_lock);
+    } pthread_mutex_unlock(&list->_indexer_lock);
+
+    /* Delete the entry; the node may be freed, and must not be referenced once removed. */
+    list->_list->nasync_remove_member_node(found);
+
+    /* Update the lookup index */
+    plcrash_nasync_image_list_update_index(list, image);
+    pthread_mutex_unlock(&list->_deferred_lock);
+}
+
+/**
+ * Retain or release the list for reading. This method is async-safe.
+ *
+ * This must be issued prior to attempting to iterate the list, and must called again once reads have completed.
+ *
+ * @param list The list to be be retained or released for reading.
+ * @param enable If true, the list will be retained. If false, released.
+ */
+void plcrash_async_image_list_set_reading (plcrash_async_image_list_t *list, bool enable) {
+    if (enable) {
+        /* Increment and issue a barrier. Once issued, no index will be deallocated while a reference is held. */
+        OSAtomicIncrement32Barrier(&list->_refcount);
+    } else {
+        OSAtomicDecrement32Barrier(&list->_refcount);
+    }
+
+    list->_list->set_reading(enable);
+}
+
+/**
+ * Return the image containing the given @a address within its TEXT segment. This method is async-safe.
+ * If image is found, NULL will be returned.
+ *
+ * @param list The list to be iterated.
+ * @param address The address to be searched for.
+ *
+ * @warning The list must be retained for reading via plcrash_async_image_list_set_reading() before calling this function.
+ */
+plcrash_async_image_t *plcrash_async_image_containing_address (plcrash_async_image_list_t *list, pl_vm_address_t address) {
+    plcrash_async_image_t *image = NULL;
+
+    /* Perform a binary search of the sorted index, if available */
+    struct plcrash_async_image_index *index = list->_index;
+    if (index != NULL) {
+        /* Find the last image with a header address <= address */
+        size_t low = 0;
+        size_t high = index->count;
+        while (low < high) {
+            size_t mid = low + ((high - low) / 2);
+            if (index->images[mid]->macho_image.header_addr <= address) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        if (low == 0)
+            return NULL;
+
+        image = index->images[low - 1];
+        if (address < image->macho_image.header_addr + image->macho_image.text_size)
+            return image;
+
+        return NULL;
+    }
+
+    /* Otherwise, fall back on iterating the list */
     while ((image = plcrash_async_image_list_next(list, image)) != NULL) {
         if (address >= image->macho_image.header_addr && address < image->macho_image.header_addr + image->macho_image.text_size) {
             return image;
@@ -36,8 +36,12 @@ extern "C" {
 #include <stdint.h>
 #include <libkern/OSAtomic.h>
 #include <stdbool.h>
+#include <pthread.h>
 
 #include "PLCrashAsyncMachOImage.h"
+#include "PLCrashAsyncCompactUnwindEncoding.h"
+#include "PLCrashAsyncObjCSection.h"
+#include "PLCrashFeatureConfig.h"
 
 /*
  * NOTE: We keep this code C-compatible for backwards-compatibility purposes. If the entirity
@@ -50,6 +54,42 @@ extern "C" {
     
 typedef struct plcrash_async_image plcrash_async_image_t;
 
+/**
+ * @internal
+ * @ingroup plcrash_async_image
+ *
+ * Binary image classes, as used to select a per-image symbolication strategy. An image's class is determined
+ * once, when the image is appended to a plcrash_async_image_list_t.
+ */
+typedef enum {
+    /** The main executable (MH_EXECUTE). */
+    PLCRASH_ASYNC_IMAGE_CLASS_MAIN_EXECUTABLE = 0,
+
+    /** Any non-system library or bundle, such as a framework embedded within the application. */
+    PLCRASH_ASYNC_IMAGE_CLASS_APPLICATION = 1,
+
+    /** A system library, either within the dyld shared cache or installed within a system path. */
+    PLCRASH_ASYNC_IMAGE_CLASS_SYSTEM = 2,
+} plcrash_async_image_class_t;
+
+/** The number of defined plcrash_async_image_class_t values. */
+#define PLCRASH_ASYNC_IMAGE_CLASS_COUNT 3
+
+/**
+ * @internal
+ * @ingroup plcrash_async_image
+ *
+ * A function that pre-encodes a binary image for crash-time output, as registered via
+ * plcrash_nasync_image_list_enable_image_encoding().
+ *
+ * @param image The image to be encoded.
+ * @param[out] data On success, a malloc()-allocated buffer containing the encoded image. Ownership is transfered to the caller.
+ * @param[out] length On success, the length of @a data, in bytes.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t value on failure.
+ */
+typedef plcrash_error_t (*plcrash_async_image_encoder_t) (plcrash_async_macho_t *image, void **data, size_t *length);
+
 /**
  * @internal
  * @ingroup plcrash_async_image
@@ -66,6 +106,51 @@ struct plcrash_async_image {
 #else
     void *_node;
 #endif
+#if PLCRASH_FEATURE_UNWIND_COMPACT
+    /** The claim state of @a _cfe_reader, as used by plframe_cursor_read_compact_unwind(). Must be updated atomically. */
+    volatile int32_t _cfe_reader_state;
+
+    /** A lazily initialized CFE reader for the image's cached __unwind_info mapping. The reader's memoized lookup
+     * state is retained across frames; it may only be used by the reader that has claimed it via @a _cfe_reader_state. */
+    plcrash_async_cfe_reader_t _cfe_reader;
+#endif
+
+    /** The image's pre-encoded crash report representation, or NULL if unavailable. Once set, the value is immutable
+     * for the lifetime of the image. */
+    void * volatile _encoded;
+
+    /** The length of @a _encoded, in bytes. */
+    size_t _encoded_length;
+
+    /** The frame reader that most recently unwound a frame within this image, as used by plframe_cursor_next() to
+     * order its readers, or NULL. May be updated atomically by any reader. */
+    void * volatile _preferred_reader;
+
+    /** If true, the image has no __unwind_info section, and compact unwinding should not be attempted. */
+    bool _no_compact_unwind;
+
+    /** If true, the image has neither an __eh_frame nor a __debug_frame section, and DWARF unwinding should not be
+     * attempted. */
+    bool _no_dwarf_unwind;
+
+    /** The image's class, as used to select the image's symbolication strategy. Immutable once the image has been
+     * published. */
+    plcrash_async_image_class_t _image_class;
+
+    /** If true, this record is owned by a batch allocation made by plcrash_nasync_image_list_append_batch(),
+     * and must not be individually deallocated. */
+    bool _batched;
+
+    /** If non-zero, the image's enabled indexes have not yet been built by the background index builder. See
+     * plcrash_nasync_image_list_set_background_indexing(). Must be updated atomically. */
+    volatile int32_t _index_pending;
+
+    /** If true, the image's indexes are currently being built. Guarded by the list's @a _indexer_lock. */
+    bool _index_building;
+
+    /** If true, the image is being removed from its list, and must not be claimed for indexing. Guarded by the
+     * list's @a _indexer_lock. */
+    bool _index_removed;
 };
 
 /**
@@ -85,12 +170,138 @@ typedef struct plcrash_async_image_list {
 #else
     void *_list;
 #endif
+
+    /** The address-sorted image index used for async-safe lookups, or NULL if no index is available. */
+    struct plcrash_async_image_index *_index;
+
+    /** Indexes replaced while readers were active. These are deallocated once no readers remain. */
+    struct plcrash_async_image_index *_retired_index;
+
+    /** The number of active readers. No index will be deallocated while the count is greater than 0. */
+    int32_t _refcount;
+
+    /** The lock used by writers when rebuilding the index. No lock is required for readers. */
+    OSSpinLock _index_lock;
+
+    /** If true, a symbol index will be built for each image as it is appended. */
+    volatile bool _symbol_index_enabled;
+
+    /** If true, an Objective-C IMP index will be built for each image as it is appended. */
+    volatile bool _objc_index_enabled;
+
+    /** If true, an __eh_frame FDE index will be built for each image as it is appended. */
+    volatile bool _fde_index_enabled;
+
+    /** If true, a validated __unwind_info first-level index will be built for each image as it is appended. */
+    volatile bool _cfe_index_enabled;
+
+    /** If non-NULL, the function used to pre-encode each image as it is appended. */
+    volatile plcrash_async_image_encoder_t _image_encoder;
+
+    /** If true, appended images are queued for parsing by a background thread, rather than parsed on append. */
+    volatile bool _deferred_enabled;
+
+    /** The lock used to serialize access to the deferred image queue, as well as the loading and removal of
+     * deferred images. */
+    pthread_mutex_t _deferred_lock;
+
+    /** The head of the deferred image queue (in append order), or NULL if empty. */
+    struct plcrash_async_image_deferred *_deferred_head;
+
+    /** The tail of the deferred image queue, or NULL if empty. */
+    struct plcrash_async_image_deferred *_deferred_tail;
+
+    /** If true, a background thread is currently loading deferred images. */
+    bool _deferred_worker_running;
+
+    /** A header address hash index of the list's nodes, used by writers to find and remove images in constant time.
+     * Guarded by @a _deferred_lock, and never accessed by readers. Lazily allocated; NULL if empty or unavailable. */
+    struct plcrash_async_image_header_entry **_header_buckets;
+
+    /** The number of buckets in @a _header_buckets. Always a power of two. */
+    size_t _header_bucket_count;
+
+    /** The number of entries in @a _header_buckets. */
+    size_t _header_count;
+
+    /** If true, an allocation required by the header index failed, and writers fall back on searching the list. */
+    bool _header_index_failed;
+
+    /** The append-only string arena backing the names of all parsed images, most recent chunk first. Guarded by
+     * @a _deferred_lock. Names are never freed prior to the list, and remain valid after their image is removed. */
+    struct plcrash_async_image_name_chunk *_names;
+
+    /** If true, each image's load command and section mappings are released once the image has been parsed, and
+     * are re-mapped on demand. See plcrash_nasync_image_list_set_compact(). */
+    volatile bool _compact_enabled;
+
+    /** All batch allocations made by plcrash_nasync_image_list_append_batch(). */
+    struct plcrash_async_image_batch *_batches;
+
+    /** If true, the headers of images within the dyld shared cache will be referenced from a single mapping of the
+     * shared cache's text region. */
+    volatile bool _shared_cache_enabled;
+
+    /** If true, @a _shared_cache has been initialized. */
+    bool _shared_cache_mapped;
+
+    /** If true, mapping of the shared cache failed, and will not be re-attempted. */
+    bool _shared_cache_failed;
+
+    /** The mapping of the shared cache's text region. Only valid if @a _shared_cache_mapped is true. */
+    plcrash_async_mobject_t _shared_cache;
+
+    /** If true, @a _objc_shared_cache has been initialized, and will be applied to each image as it is appended. */
+    volatile bool _objc_shared_cache_enabled;
+
+    /** The shared cache's Objective-C optimization data. Only valid if @a _objc_shared_cache_enabled is true. */
+    plcrash_async_objc_shared_cache_t _objc_shared_cache;
+
+    /** If true, enabled indexes are built by a background thread once each image has been published, rather than
+     * prior to publication. See plcrash_nasync_image_list_set_background_indexing(). */
+    volatile bool _background_index_enabled;
+
+    /** The lock used to serialize access to the background index builder's state and memory accounting. */
+    pthread_mutex_t _indexer_lock;
+
+    /** Broadcast whenever an image's index build completes. Used with @a _indexer_lock. */
+    pthread_cond_t _indexer_cond;
+
+    /** If true, a background thread is currently building indexes. Guarded by @a _indexer_lock. */
+    bool _indexer_running;
+
+    /** Incremented each time images are marked for background indexing. Guarded by @a _indexer_lock. */
+    uint32_t _indexer_generation;
+
+    /** If true, the list is being freed, and the background index builder should exit. */
+    volatile bool _indexer_cancelled;
+
+    /** The approximate number of bytes that may be allocated by background index builds, or 0 if unlimited. Guarded
+     * by @a _indexer_lock. */
+    size_t _indexer_memory_limit;
+
+    /** The approximate number of bytes allocated by background index builds. Guarded by @a _indexer_lock. */
+    size_t _indexer_memory_used;
 } plcrash_async_image_list_t;
 
 void plcrash_nasync_image_list_init (plcrash_async_image_list_t *list, mach_port_t task);
 void plcrash_nasync_image_list_free (plcrash_async_image_list_t *list);
 void plcrash_nasync_image_list_append (plcrash_async_image_list_t *list, pl_vm_address_t header, const char *name);
+void plcrash_nasync_image_list_append_batch (plcrash_async_image_list_t *list, const pl_vm_address_t *headers, const char * const *names, size_t count);
+bool plcrash_nasync_image_list_contains (plcrash_async_image_list_t *list, pl_vm_address_t header);
 void plcrash_nasync_image_list_remove (plcrash_async_image_list_t *list, pl_vm_address_t header);
+void plcrash_nasync_image_list_enable_symbol_index (plcrash_async_image_list_t *list);
+void plcrash_nasync_image_list_enable_objc_index (plcrash_async_image_list_t *list);
+void plcrash_nasync_image_list_enable_fde_index (plcrash_async_image_list_t *list);
+void plcrash_nasync_image_list_enable_cfe_index (plcrash_async_image_list_t *list);
+void plcrash_nasync_image_list_enable_image_encoding (plcrash_async_image_list_t *list, plcrash_async_image_encoder_t encoder);
+void plcrash_nasync_image_list_enable_shared_cache (plcrash_async_image_list_t *list);
+plcrash_error_t plcrash_nasync_image_list_enable_objc_shared_cache (plcrash_async_image_list_t *list, pl_vm_address_t cache_base);
+void plcrash_nasync_image_list_set_deferred (plcrash_async_image_list_t *list, bool enabled);
+void plcrash_nasync_image_list_set_compact (plcrash_async_image_list_t *list, bool enabled);
+void plcrash_nasync_image_list_load_deferred (plcrash_async_image_list_t *list);
+void plcrash_nasync_image_list_set_background_indexing (plcrash_async_image_list_t *list, bool enabled, size_t memory_limit);
+void plcrash_nasync_image_list_build_pending_indexes (plcrash_async_image_list_t *list);
 
 void plcrash_async_image_list_set_reading (plcrash_async_image_list_t *list, bool enable);
 
@@ -91,6 +91,201 @@
 
 }
 
+/* Trivial image encoder; encodes the image's header address. */
+static plcrash_error_t test_image_encoder (plcrash_async_macho_t *image, void **data, size_t *length) {
+    pl_vm_address_t *addr = malloc(sizeof(*addr));
+    *addr = image->header_addr;
+
+    *data = addr;
+    *length = sizeof(*addr);
+    return PLCRASH_ESUCCESS;
+}
+
+/* Test that images are pre-encoded both before and after encoding is enabled. */
+- (void) testImageEncoding {
+    STAssertTrue(_dyld_image_count() >= 2, @"We need at least two Mach-O images for this test.");
+
+    /* Appended prior to enabling encoding */
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(0), _dyld_get_image_name(0));
+    plcrash_nasync_image_list_enable_image_encoding(&_list, test_image_encoder);
+
+    /* Appended after enabling encoding */
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(1), _dyld_get_image_name(1));
+
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *item = NULL;
+    for (uint32_t i = 0; i < 2; i++) {
+        item = plcrash_async_image_list_next(&_list, item);
+        STAssertNotNULL(item, @"Item should not be NULL");
+        STAssertNotNULL(item->_encoded, @"Image was not encoded");
+        STAssertEquals(item->_encoded_length, sizeof(pl_vm_address_t), @"Incorrect encoded length");
+        STAssertEquals(*(pl_vm_address_t *) item->_encoded, (pl_vm_address_t) _dyld_get_image_header(i), @"Incorrect encoded value");
+    }
+    plcrash_async_image_list_set_reading(&_list, false);
+}
+
+/* Test deferred image loading, including removal of an image that may not yet have been loaded. */
+- (void) testDeferredAppend {
+    STAssertTrue(_dyld_image_count() >= 2, @"We need at least two Mach-O images for this test.");
+
+    plcrash_nasync_image_list_set_deferred(&_list, true);
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(0), _dyld_get_image_name(0));
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(1), _dyld_get_image_name(1));
+    plcrash_nasync_image_list_remove(&_list, (pl_vm_address_t) _dyld_get_image_header(1));
+    plcrash_nasync_image_list_load_deferred(&_list);
+
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *item = plcrash_async_image_list_next(&_list, NULL);
+    STAssertNotNULL(item, @"Deferred image was not loaded");
+    STAssertEquals((pl_vm_address_t) _dyld_get_image_header(0), item->macho_image.header_addr, @"Incorrect header value");
+    STAssertNULL(plcrash_async_image_list_next(&_list, item), @"Removed image should not be visible");
+    plcrash_async_image_list_set_reading(&_list, false);
+}
+
+/* Test background indexing, including priority ordering and the memory limit. */
+- (void) testBackgroundIndexing {
+    Dl_info info;
+    STAssertTrue(dladdr((void *) &malloc, &info) != 0, @"Could not find the image containing malloc()");
+
+    /* With a one byte limit, only the highest priority image may be indexed */
+    plcrash_nasync_image_list_set_background_indexing(&_list, true, 1);
+    plcrash_nasync_image_list_enable_image_encoding(&_list, test_image_encoder);
+
+    pl_vm_address_t headers[] = { (pl_vm_address_t) info.dli_fbase, (pl_vm_address_t) _dyld_get_image_header(0) };
+    const char *names[] = { info.dli_fname, _dyld_get_image_name(0) };
+    plcrash_nasync_image_list_append_batch(&_list, headers, names, 2);
+
+    /* Wait for the background builder to exit */
+    while (true) {
+        pthread_mutex_lock(&_list._indexer_lock);
+        bool running = _list._indexer_running;
+        pthread_mutex_unlock(&_list._indexer_lock);
+
+        if (!running)
+            break;
+        sched_yield();
+    }
+
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *systemImage = plcrash_async_image_list_next(&_list, NULL);
+    plcrash_async_image_t *executable = plcrash_async_image_list_next(&_list, systemImage);
+    STAssertNotNULL(executable, @"Images were not appended");
+
+    STAssertNotNULL(executable->_encoded, @"The main executable was not indexed first");
+    STAssertNULL(systemImage->_encoded, @"The system image was indexed beyond the memory limit");
+    STAssertTrue(systemImage->_index_pending, @"The system image is no longer pending");
+
+    /* Lift the limit, and index the remaining image synchronously */
+    plcrash_nasync_image_list_set_background_indexing(&_list, true, 0);
+    plcrash_nasync_image_list_build_pending_indexes(&_list);
+    STAssertNotNULL(systemImage->_encoded, @"The system image was not indexed");
+    STAssertEquals(*(pl_vm_address_t *) systemImage->_encoded, headers[0], @"Incorrect encoded value");
+    plcrash_async_image_list_set_reading(&_list, false);
+}
+
+/* Test that removing an image waits for an in-progress index build, and prevents the image from being claimed. */
+- (void) testRemoveDuringBackgroundIndexing {
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(0), _dyld_get_image_name(0));
+
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *image = plcrash_async_image_list_next(&_list, NULL);
+    STAssertNotNULL(image, @"Image was not appended");
+
+    /* Mark the image as pending, and simulate an in-progress build */
+    image->_index_pending = 1;
+    pthread_mutex_lock(&_list._indexer_lock);
+    image->_index_building = true;
+    pthread_mutex_unlock(&_list._indexer_lock);
+
+    dispatch_semaphore_t removed = dispatch_semaphore_create(0);
+    plcrash_async_image_list_t *list = &_list;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        plcrash_nasync_image_list_remove(list, (pl_vm_address_t) _dyld_get_image_header(0));
+        dispatch_semaphore_signal(removed);
+    });
+
+    /* The removal must not complete until the build has */
+    STAssertNotEquals(0L, dispatch_semaphore_wait(removed, dispatch_time(DISPATCH_TIME_NOW, 100 * NSEC_PER_MSEC)), @"Image was removed during an index build");
+
+    pthread_mutex_lock(&_list._indexer_lock);
+    image->_index_building = false;
+    pthread_cond_broadcast(&_list._indexer_cond);
+    pthread_mutex_unlock(&_list._indexer_lock);
+
+    STAssertEquals(0L, dispatch_semaphore_wait(removed, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC)), @"Image removal did not complete");
+    dispatch_release(removed);
+
+    /* The removed image must not be claimed by a builder */
+    STAssertTrue(image->_index_removed, @"Image was not marked as removed");
+    plcrash_async_image_list_set_reading(&_list, false);
+}
+
+/* Test referencing the headers of shared cache images from a single mapping. */
+- (void) testSharedCache {
+    Dl_info info;
+    STAssertTrue(dladdr((void *) &malloc, &info) != 0, @"Could not find the image containing malloc()");
+
+    plcrash_nasync_image_list_enable_shared_cache(&_list);
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) info.dli_fbase, info.dli_fname);
+    STAssertTrue(_list._shared_cache_mapped, @"The shared cache was not mapped");
+
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *item = plcrash_async_image_list_next(&_list, NULL);
+    STAssertNotNULL(item, @"Image was not appended");
+    STAssertTrue(item->macho_image.load_cmds.view, @"Load commands were not referenced from the shared cache mapping");
+    STAssertNotNULL(plcrash_async_macho_find_segment_cmd(&item->macho_image, SEG_TEXT), @"Could not read the load commands");
+    plcrash_async_image_list_set_reading(&_list, false);
+}
+
+/* Test classification of appended images. */
+- (void) testImageClass {
+    Dl_info info;
+    STAssertTrue(dladdr((void *) &malloc, &info) != 0, @"Could not find the image containing malloc()");
+
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(0), _dyld_get_image_name(0));
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) info.dli_fbase, info.dli_fname);
+
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *item = plcrash_async_image_list_next(&_list, NULL);
+    STAssertNotNULL(item, @"Image was not appended");
+    STAssertEquals(item->_image_class, PLCRASH_ASYNC_IMAGE_CLASS_MAIN_EXECUTABLE, @"The main executable was misclassified");
+
+    item = plcrash_async_image_list_next(&_list, item);
+    STAssertNotNULL(item, @"Image was not appended");
+    STAssertEquals(item->_image_class, PLCRASH_ASYNC_IMAGE_CLASS_SYSTEM, @"The system image was misclassified");
+    plcrash_async_image_list_set_reading(&_list, false);
+}
+
+/* Test batch appends and header lookups. */
+- (void) testAppendBatch {
+    STAssertTrue(_dyld_image_count() >= 3, @"We need at least three Mach-O images for this test.");
+
+    pl_vm_address_t headers[3];
+    const char *names[3];
+    for (uint32_t i = 0; i < 3; i++) {
+        headers[i] = (pl_vm_address_t) _dyld_get_image_header(i);
+        names[i] = _dyld_get_image_name(i);
+    }
+    plcrash_nasync_image_list_append_batch(&_list, headers, names, 3);
+
+    /* Verify the appended elements, in order */
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *item = NULL;
+    for (uint32_t i = 0; i < 3; i++) {
+        item = plcrash_async_image_list_next(&_list, item);
+        STAssertNotNULL(item, @"Item should not be NULL");
+        STAssertEquals(headers[i], item->macho_image.header_addr, @"Incorrect header value");
+        STAssertEqualCStrings(names[i], item->macho_image.name, @"Incorrect name value");
+    }
+    STAssertNULL(plcrash_async_image_list_next(&_list, item), @"Unexpected additional item");
+    plcrash_async_image_list_set_reading(&_list, false);
+
+    /* Verify lookup, including after removal */
+    STAssertTrue(plcrash_nasync_image_list_contains(&_list, headers[1]), @"Image not found");
+    plcrash_nasync_image_list_remove(&_list, headers[1]);
+    STAssertFalse(plcrash_nasync_image_list_contains(&_list, headers[1]), @"Removed image found");
+    STAssertTrue(plcrash_nasync_image_list_contains(&_list, headers[2]), @"Image not found");
+}
 
 /* Test removing the last image in the list. */
 - (void) testRemoveLastImage {
@@ -102,6 +297,71 @@
     plcrash_async_image_list_set_reading(&_list, false);
 }
 
+/* Test interned image names and compact image storage. */
+- (void) testCompactImages {
+    STAssertTrue(_dyld_image_count() >= 2, @"We need at least two Mach-O images for this test.");
+
+    plcrash_nasync_image_list_set_compact(&_list, true);
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(0), _dyld_get_image_name(0));
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(1), _dyld_get_image_name(1));
+
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *item = NULL;
+    for (uint32_t i = 0; i < 2; i++) {
+        item = plcrash_async_image_list_next(&_list, item);
+        STAssertNotNULL(item, @"Image was not appended");
+        STAssertTrue(item->macho_image.name_borrowed, @"Name was not interned");
+        STAssertEqualCStrings(_dyld_get_image_name(i), item->macho_image.name, @"Incorrect name value");
+
+        /* Load commands must be re-mapped on demand */
+        STAssertNotNULL(plcrash_async_macho_find_segment_cmd(&item->macho_image, SEG_TEXT), @"Could not read the load commands");
+    }
+    plcrash_async_image_list_set_reading(&_list, false);
+}
+
+/* Test removal by header address across a header index that has been grown. */
+- (void) testRemoveManyImages {
+    uint32_t count = _dyld_image_count();
+    STAssertTrue(count >= 5, @"We need at least five Mach-O images for this test.");
+
+    /* Append every image several times over, forcing the header index to grow */
+    for (uint32_t pass = 0; pass < 32; pass++) {
+        for (uint32_t i = 0; i < count; i++)
+            plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+    }
+
+    /* Remove all but one copy of the odd images, and every copy of the even images, with a reader active */
+    plcrash_async_image_list_set_reading(&_list, true);
+    for (uint32_t pass = 0; pass < 32; pass++) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (i % 2 == 0 || pass > 0)
+                plcrash_nasync_image_list_remove(&_list, (pl_vm_address_t) _dyld_get_image_header(i));
+        }
+    }
+    plcrash_async_image_list_set_reading(&_list, false);
+
+    for (uint32_t i = 0; i < count; i++) {
+        pl_vm_address_t header = (pl_vm_address_t) _dyld_get_image_header(i);
+        if (i % 2 == 0) {
+            STAssertFalse(plcrash_nasync_image_list_contains(&_list, header), @"Removed image %u found", i);
+        } else {
+            STAssertTrue(plcrash_nasync_image_list_contains(&_list, header), @"Image %u not found", i);
+        }
+    }
+
+    /* Verify that exactly one copy of each odd image remains, in order */
+    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_t *item = NULL;
+    for (uint32_t i = 1; i < count; i += 2) {
+        item = plcrash_async_image_list_next(&_list, item);
+        STAssertNotNULL(item, @"Item should not be NULL");
+        STAssertEquals((pl_vm_address_t) _dyld_get_image_header(i), item->macho_image.header_addr, @"Incorrect header value for %u", i);
+        STAssertEquals(item, plcrash_async_image_containing_address(&_list, item->macho_image.header_addr), @"Index lookup failed for %u", i);
+    }
+    STAssertNULL(plcrash_async_image_list_next(&_list, item), @"Unexpected additional item");
+    plcrash_async_image_list_set_reading(&_list, false);
+}
+
 - (void) testRemoveImage {
     // XXX - This is required due to the tight coupling with the Mach-O parser
     uint32_t count = _dyld_image_count();
@@ -184,4 +444,39 @@
 
 }
 
+/* Verify address lookups against images appended out of address order, including after removal. */
+- (void) testFindImageForAddressUnordered {
+    // XXX - This is required due to the tight coupling with the Mach-O parser
+    uint32_t count = _dyld_image_count();
+    STAssertTrue(count >= 5, @"We need at least five Mach-O images for this test. This should not be a problem on a modern system.");
+
+    uint32_t order[] = { 4, 2, 0, 3, 1 };
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++)
+        plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(order[i]), _dyld_get_image_name(order[i]));
+
+    plcrash_async_image_list_set_reading(&_list, true); {
+        for (uint32_t i = 0; i < 5; i++) {
+            pl_vm_address_t header = (pl_vm_address_t) _dyld_get_image_header(i);
+            plcrash_async_image_t *image = plcrash_async_image_containing_address(&_list, header);
+            STAssertNotNULL(image, @"Failed to find image %u", i);
+            STAssertEquals(image->macho_image.header_addr, header, @"Incorrect image returned for %u", i);
+        }
+    } plcrash_async_image_list_set_reading(&_list, false);
+
+    /* Remove an entry, and verify that it is no longer returned */
+    plcrash_nasync_image_list_remove(&_list, (pl_vm_address_t) _dyld_get_image_header(2));
+
+    plcrash_async_image_list_set_reading(&_list, true); {
+        pl_vm_address_t header = (pl_vm_address_t) _dyld_get_image_header(2);
+        plcrash_async_image_t *image = plcrash_async_image_containing_address(&_list, header);
+        if (image != NULL)
+            STAssertNotEquals(image->macho_image.header_addr, header, @"Removed image was returned");
+
+        header = (pl_vm_address_t) _dyld_get_image_header(3);
+        image = plcrash_async_image_containing_address(&_list, header);
+        STAssertNotNULL(image, @"Failed to find image");
+        STAssertEquals(image->macho_image.header_addr, header, @"Incorrect image returned");
+    } plcrash_async_image_list_set_reading(&_list, false);
+}
+
 @end
@@ -114,9 +114,10 @@ public:
     ~async_list (void);
     
     void nasync_prepend (V value);
-    void nasync_append (V value);
+    node *nasync_append (V value);
     void nasync_remove_first_value (V value);
     void nasync_remove_node (node *deleted_node);
+    void nasync_remove_member_node (node *member_node);
     void set_reading (bool enable);
     node *next (node *current);
     
@@ -148,6 +149,7 @@ public:
 
 private:
     void free_list (node *next);
+    void unlink_node (node *item);
 
     /** The lock used by writers. No lock is required for readers. */
     OSSpinLock _write_lock;
@@ -249,14 +251,16 @@ template <typename V> void async_list<V>::nasync_prepend (V value) {
  *
  * @param value The value to be appended.
  *
+ * @return Returns the list node holding @a value. The node remains valid until it is removed from the list.
+ *
  * @warning This method is not async safe.
  */
-template <typename V> void async_list<V>::nasync_append (V value) {
-    
+template <typename V> typename async_list<V>::node *async_list<V>::nasync_append (V value) {
+    node *new_node;
+
     /* Lock the list from other writers. */
     OSSpinLockLock(&_write_lock); {
         /* Construct the new entry, or recycle an existing one. */
-        node *new_node;
         if (_free != NULL) {
             /* Fetch a node from the free list */
             new_node = _free;
@@ -297,6 +301,8 @@ template <typename V> void async_list<V>::nasync_append (V value) {
             _tail = new_node;
         }
     } OSSpinLockUnlock(&_write_lock);
+
+    return new_node;
 }
 
 /**
@@ -338,52 +344,73 @@ template <typename V> void async_list<V>::nasync_remove_node (node *deleted_node
             item = item->_next;
         }
         
-        /* If not found, nothing to do */
-        if (item == NULL) {
-            OSSpinLockUnlock(&_write_lock);
-            return;
-        }
-        
-        /*
-         * Atomically make the item unreachable by readers.
-         *
-         * This serves as a synchronization point -- after the CAS, the item is no longer reachable via the list.
-         */
-        if (item == _head) {
-            if (!OSAtomicCompareAndSwapPtrBarrier(item, item->_next, (void **) &_head)) {
-                PLCF_DEBUG("Failed to remove image list head despite holding lock");
-            }
-        } else {
-            /* There MUST be a non-NULL prev pointer, as this is not HEAD. */
-            if (!OSAtomicCompareAndSwapPtrBarrier(item, item->_next, (void **) &item->_prev->_next)) {
-                PLCF_DEBUG("Failed to remove image list item despite holding lock");
-            }
+        /* Unlink the record, if found */
+        if (item != NULL)
+            unlink_node(item);
+    } OSSpinLockUnlock(&_write_lock);
+}
+
+/**
+ * Remove a specific entry node from the list, without first verifying that the node is reachable from the list.
+ *
+ * @param member_node The node to be removed. This must be a node returned by nasync_append() that has not since been
+ * removed.
+ *
+ * @warning This method is not async safe.
+ */
+template <typename V> void async_list<V>::nasync_remove_member_node (node *member_node) {
+    OSSpinLockLock(&_write_lock); {
+        unlink_node(member_node);
+    } OSSpinLockUnlock(&_write_lock);
+}
+
+/**
+ * @internal
+ *
+ * Unlink @a item from the list, and either free it or move it to the free list. The caller must hold the write lock.
+ *
+ * @param item The node to be removed.
+ */
+template <typename V> void async_list<V>::unlink_node (node *item) {
+    /*
+     * Atomically make the item unreachable by readers.
+     *
+     * This serves as a synchronization point -- after the CAS, the item is no longer reachable via the list.
+     */
+    if (item == _head) {
+        if (!OSAtomicCompareAndSwapPtrBarrier(item, item->_next, (void **) &_head)) {
+            PLCF_DEBUG("Failed to remove image list head despite holding lock");
         }
-        
-        /* Now that the item is unreachable, update the prev/tail pointers. These are never accessed without a lock,
-         * and need not be updated atomically. */
-        if (item->_next != NULL) {
-            /* Item is not the tail (otherwise next would be NULL), so simply update the next item's prev pointer. */
-            item->_next->_prev = item->_prev;
-        } else {
-            /* Item is the tail (next is NULL). Simply update the tail record. */
-            _tail = item->_prev;
+    } else {
+        /* There MUST be a non-NULL prev pointer, as this is not HEAD. */
+        if (!OSAtomicCompareAndSwapPtrBarrier(item, item->_next, (void **) &item->_prev->_next)) {
+            PLCF_DEBUG("Failed to remove image list item despite holding lock");
         }
+    }
+    
+    /* Now that the item is unreachable, update the prev/tail pointers. These are never accessed without a lock,
+     * and need not be updated atomically. */
+    if (item->_next != NULL) {
+        /* Item is not the tail (otherwise next would be NULL), so simply update the next item's prev pointer. */
+        item->_next->_prev = item->_prev;
+    } else {
+        /* Item is the tail (next is NULL). Simply update the tail record. */
+        _tail = item->_prev;
+    }
+    
+    /* If a reader is active, place the node on the free list. The item is unreachable here when readers
+     * aren't active, so if we have a 0 refcount, we can safely delete the item, and be sure that no
+     * reader holds a reference to it. */
+    if (_refcount > 0) {
+        item->_prev = NULL;
+        item->_next = _free;
         
-        /* If a reader is active, place the node on the free list. The item is unreachable here when readers
-         * aren't active, so if we have a 0 refcount, we can safely delete the item, and be sure that no
-         * reader holds a reference to it. */
-        if (_refcount > 0) {
-            item->_prev = NULL;
-            item->_next = _free;
-            
-            if (_free != NULL)
-                _free->_prev = item;
-            _free = item;
-        } else {
-            delete item;
-        }
-    } OSSpinLockUnlock(&_write_lock);
+        if (_free != NULL)
+            _free->_prev = item;
+        _free = item;
+    } else {
+        delete item;
+    }
 }
 
 /**
@@ -27,10 +27,13 @@
  */
 
 #import "PLCrashAsyncMObject.h"
+#import "PLCrashAsyncMetrics.h"
 
 #import <stdint.h>
 #import <inttypes.h>
 
+#import <libkern/OSAtomic.h>
+
 /**
  * @internal
  * @ingroup plcrash_async
@@ -234,28 +237,138 @@ static plcrash_error_t plcrash_async_mobject_remap_pages_workaround (mach_port_t
 
 
 /**
- * Initialize a new memory object reference, mapping @a task_addr from @a task into the current process. The mapping
- * will be copy-on-write, and will be checked to ensure a minimum protection value of VM_PROT_READ.
+ * Verify that the pages starting at @a task_addr within the current task are mapped and readable, without creating
+ * any new mappings.
  *
- * @param mobj Memory object to be initialized.
- * @param task The task from which the memory will be mapped.
- * @param task_address The task-relative address of the memory to be mapped. This is not required to fall on a page boundry.
- * @param length The total size of the mapping to create.
- * @param require_full If false, short mappings will be permitted in the case where a memory object of the requested length
- * does not exist at the target address. It is the caller's responsibility to validate the resulting length of the
- * mapping, eg, using plcrash_async_mobject_remap_address() and similar. If true, and the entire requested page range is
- * not valid, the mapping request will fail.
+ * @param task_addr The address of the memory to be verified. This is not required to fall on a page boundry.
+ * @param length The total size of the range to verify.
+ * @param require_full If true, the entire requested page range must be readable. If false, the verified range may be
+ * shorter than @a length.
+ * @param result_length[out] The total size, in bytes, of the verified pages, starting at the page containing @a task_addr.
  *
- * @return On success, returns PLCRASH_ESUCCESS. On failure, one of the plcrash_error_t error values will be returned, and no
- * mapping will be performed.
+ * @return On success, returns PLCRASH_ESUCCESS. On failure, one of the plcrash_error_t error values will be returned.
  */
-plcrash_error_t plcrash_async_mobject_init (plcrash_async_mobject_t *mobj, mach_port_t task, pl_vm_address_t task_addr, pl_vm_size_t length, bool require_full) {
+static plcrash_error_t plcrash_async_mobject_verify_local_pages (pl_vm_address_t task_addr,
+                                                                 pl_vm_size_t length,
+                                                                 bool require_full,
+                                                                 pl_vm_size_t *result_length)
+{
+    pl_vm_address_t base_addr = mach_vm_trunc_page(task_addr);
+    pl_vm_size_t total_size = mach_vm_round_page(length + (task_addr - base_addr));
+    pl_vm_address_t cursor = base_addr;
+
+    /* Walk the regions covering the target range. Any gap or unreadable region terminates the verified range. */
+    while (cursor < base_addr + total_size) {
+        vm_region_submap_info_data_64_t info;
+        mach_msg_type_number_t count;
+        natural_t depth = 0;
+        kern_return_t kt;
+
+#ifdef PL_HAVE_MACH_VM
+        mach_vm_address_t region_addr;
+        mach_vm_size_t region_size;
+#else
+        vm_address_t region_addr;
+        vm_size_t region_size;
+#endif
+
+        /* Descend into any submaps (eg, the shared cache) to find the leaf region containing the cursor */
+        while (true) {
+            region_addr = cursor;
+            count = VM_REGION_SUBMAP_INFO_COUNT_64;
+#ifdef PL_HAVE_MACH_VM
+            kt = mach_vm_region_recurse(mach_task_self(), &region_addr, &region_size, &depth, (vm_region_recurse_info_t) &info, &count);
+#else
+            kt = vm_region_recurse_64(mach_task_self(), &region_addr, &region_size, &depth, (vm_region_recurse_info_t) &info, &count);
+#endif
+            if (kt != KERN_SUCCESS || !info.is_submap)
+                break;
+
+            depth++;
+        }
+
+        if (kt != KERN_SUCCESS || region_addr > cursor || (info.protection & VM_PROT_READ) == 0)
+            break;
+
+        cursor = region_addr + region_size;
+    }
+
+    /* Determine the verified length */
+    pl_vm_size_t verified_size = 0;
+    if (cursor > base_addr)
+        verified_size = cursor - base_addr;
+
+    if (verified_size > total_size)
+        verified_size = total_size;
+
+    if (verified_size == 0 || (require_full && verified_size < total_size))
+        return PLCRASH_ENOMEM;
+
+    *result_length = verified_size;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ * The number of open local reference scopes. See plcrash_async_mobject_local_references_begin().
+ */
+static volatile int32_t local_reference_scopes = 0;
+
+/**
+ * Open a local reference scope. While at least one scope is open, memory objects initialized via
+ * plcrash_async_mobject_init() for the current task will reference the target memory directly once the range has
+ * been verified as readable, rather than creating a new mapping.
+ *
+ * Local memory objects are not copy-on-write snapshots, and do not retain the target pages; if the target memory is
+ * unmapped (eg, by a concurrent dlclose()), any later access will fault. A scope must only be opened while every
+ * other thread that may modify the task's address space is suspended, and must be closed (via
+ * plcrash_async_mobject_local_references_end()) before those threads are resumed. Any local memory objects must be
+ * freed before the scope is closed.
+ *
+ * @note This function is async-safe.
+ */
+void plcrash_async_mobject_local_references_begin (void) {
+    OSAtomicIncrement32Barrier(&local_reference_scopes);
+}
+
+/**
+ * Close a local reference scope opened via plcrash_async_mobject_local_references_begin().
+ *
+ * @note This function is async-safe.
+ */
+void plcrash_async_mobject_local_references_end (void) {
+    OSAtomicDecrement32Barrier(&local_reference_scopes);
+}
+
+/**
+ * @internal
+ *
+ * Initialize @a mobj. If @a allow_local is true, and a local reference scope is open, memory of the current task
+ * will be referenced directly. See plcrash_async_mobject_init() for the remaining parameters.
+ */
+static plcrash_error_t plcrash_async_mobject_init_internal (plcrash_async_mobject_t *mobj, mach_port_t task, pl_vm_address_t task_addr, pl_vm_size_t length, bool require_full, bool allow_local) {
     plcrash_error_t err;
 
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_MOBJECT_COUNT, 1);
+
+    /* If the target is our own task and the task's other threads are suspended, simply verify the page range; this
+     * avoids the cost of creating a new mapping. If verification fails, we fall back on the mapping path, which will
+     * report the appropriate error. */
+    mobj->local = false;
+    mobj->view = false;
+    if (allow_local && local_reference_scopes > 0 && task == mach_task_self()) {
+        if (plcrash_async_mobject_verify_local_pages(task_addr, length, require_full, &mobj->vm_length) == PLCRASH_ESUCCESS) {
+            mobj->vm_address = mach_vm_trunc_page(task_addr);
+            mobj->local = true;
+        }
+    }
+
     /* Perform the page mapping */
-    err = plcrash_async_mobject_remap_pages_workaround(task, task_addr, length, require_full, &mobj->vm_address, &mobj->vm_length);
-    if (err != PLCRASH_ESUCCESS)
-        return err;
+    if (!mobj->local) {
+        err = plcrash_async_mobject_remap_pages_workaround(task, task_addr, length, require_full, &mobj->vm_address, &mobj->vm_length);
+        if (err != PLCRASH_ESUCCESS)
+            return err;
+    }
 
     /* Determine the offset and length of the actual data */
     mobj->address = mobj->vm_address + (task_addr - mach_vm_trunc_page(task_addr));
@@ -281,90 +394,104 @@ plcrash_error_t plcrash_async_mobject_init (plcrash_async_mobject_t *mobj, mach_
 }
 
 /**
- * Return the base (target process relative) address for this mapping.
+ * Initialize a new memory object reference, mapping @a task_addr from @a task into the current process. The mapping
+ * will be copy-on-write, and will be checked to ensure a minimum protection value of VM_PROT_READ.
  *
- * @param mobj An initialized memory object.
+ * @param mobj Memory object to be initialized.
+ * @param task The task from which the memory will be mapped.
+ * @param task_address The task-relative address of the memory to be mapped. This is not required to fall on a page boundry.
+ * @param length The total size of the mapping to create.
+ * @param require_full If false, short mappings will be permitted in the case where a memory object of the requested length
+ * does not exist at the target address. It is the caller's responsibility to validate the resulting length of the
+ * mapping, eg, using plcrash_async_mobject_remap_address() and similar. If true, and the entire requested page range is
+ * not valid, the mapping request will fail.
+ *
+ * If @a task is the current task and a local reference scope is open (see plcrash_async_mobject_local_references_begin()),
+ * the memory object will reference the target memory directly once the range has been verified as readable, rather
+ * than creating a new mapping. Reads are still bounds-checked via plcrash_async_mobject_remap_address() and similar.
+ * Memory objects that may outlive the scope must be initialized via plcrash_async_mobject_init_persistent().
+ *
+ * @return On success, returns PLCRASH_ESUCCESS. On failure, one of the plcrash_error_t error values will be returned, and no
+ * mapping will be performed.
  */
-pl_vm_address_t plcrash_async_mobject_base_address (plcrash_async_mobject_t *mobj) {
-    return mobj->task_address;
+plcrash_error_t plcrash_async_mobject_init (plcrash_async_mobject_t *mobj, mach_port_t task, pl_vm_address_t task_addr, pl_vm_size_t length, bool require_full) {
+    return plcrash_async_mobject_init_internal(mobj, task, task_addr, length, require_full, true);
 }
 
-
 /**
- * Return the length of this mapping.
+ * Initialize a new memory object reference, mapping @a task_addr from @a task into the current process. Unlike
+ * plcrash_async_mobject_init(), a new mapping is always created, even within a local reference scope; the mapping
+ * retains the target pages, and may safely be held after the scope is closed (eg, by a cache that persists across
+ * reports).
  *
- * @param mobj An initialized memory object.
+ * See plcrash_async_mobject_init() for a description of the parameters and return value.
  */
-pl_vm_address_t plcrash_async_mobject_length (plcrash_async_mobject_t *mobj) {
-    return mobj->length;
+plcrash_error_t plcrash_async_mobject_init_persistent (plcrash_async_mobject_t *mobj, mach_port_t task, pl_vm_address_t task_addr, pl_vm_size_t length, bool require_full) {
+    return plcrash_async_mobject_init_internal(mobj, task, task_addr, length, require_full, false);
 }
 
 /**
- * Return a borrowed reference to the backing task for this mapping.
+ * Initialize a new memory object as a view of @a length bytes at @a task_addr within @a parent's existing mapping.
+ * No new mapping is created; this allows many small memory objects (eg, the Mach-O headers of the images in the dyld
+ * shared cache) to share the cost of a single larger mapping.
  *
- * @param mobj An initialized memory object.
+ * @param mobj Memory object to be initialized.
+ * @param parent The memory object whose mapping will be referenced. The parent must not be freed while the view
+ * remains in use.
+ * @param task_addr The task-relative address of the view. This must fall within @a parent.
+ * @param length The total size of the view. The full range must fall within @a parent.
+ *
+ * @return On success, returns PLCRASH_ESUCCESS. If the requested range does not fall within @a parent,
+ * PLCRASH_ENOTFOUND will be returned.
  */
-task_t plcrash_async_mobject_task (plcrash_async_mobject_t *mobj) {
-    return mobj->task;
+plcrash_error_t plcrash_async_mobject_init_view (plcrash_async_mobject_t *mobj, plcrash_async_mobject_t *parent, pl_vm_address_t task_addr, pl_vm_size_t length) {
+    void *address = plcrash_async_mobject_remap_address(parent, task_addr, 0, length);
+    if (address == NULL)
+        return PLCRASH_ENOTFOUND;
+
+    plcrash_async_metrics_add(PLCRASH_ASYNC_METRIC_MOBJECT_COUNT, 1);
+
+    mobj->local = parent->local;
+    mobj->view = true;
+    mobj->address = (uintptr_t) address;
+    mobj->length = length;
+    mobj->vm_slide = parent->vm_slide;
+    mobj->vm_address = parent->vm_address;
+    mobj->vm_length = parent->vm_length;
+    mobj->task_address = task_addr;
+
+    mobj->task = parent->task;
+    mach_port_mod_refs(mach_task_self(), mobj->task, MACH_PORT_RIGHT_SEND, 1);
+
+    return PLCRASH_ESUCCESS;
 }
 
 /**
- * Verify that @a length bytes starting at local @a address is within @a mobj's mapped range.
+ * Return the base (target process relative) address for this mapping.
  *
  * @param mobj An initialized memory object.
- * @param address An address within the current task's memory space.
- * @param offset An offset to be applied to @a address prior to verifying the address range.
- * @param length The number of bytes that should be readable at @a address + @a offset.
  */
-bool plcrash_async_mobject_verify_local_pointer (plcrash_async_mobject_t *mobj, uintptr_t address, pl_vm_off_t offset, size_t length) {
-    /* Verify that the offset value won't overrun a native pointer */
-    if (offset > 0 && UINTPTR_MAX - offset < address) {
-        return false;
-    } else if (offset < 0 && (offset * -1) > address) {
-        return false;
-    }
-
-    /* Adjust the address using the verified offset */
-    address += offset;
-
-    /* Verify that the address starts within range */
-    if (address < mobj->address) {
-        // PLCF_DEBUG("Address %" PRIx64 " < base address %" PRIx64 "", (uint64_t) address, (uint64_t) mobj->address);
-        return false;
-    }
+pl_vm_address_t plcrash_async_mobject_base_address (plcrash_async_mobject_t *mobj) {
+    return mobj->task_address;
+}
 
-    /* Verify that the address value won't overrun */
-    if (UINTPTR_MAX - length < address)
-        return false;
-    
-    /* Check that the block ends within range */
-    if (mobj->address + mobj->length < address + length) {
-        // PLCF_DEBUG("Address %" PRIx64 " out of range %" PRIx64 " + %" PRIx64, (uint64_t) address, (uint64_t) mobj->address, (uint64_t) mobj->length);
-        return false;
-    }
 
-    return true;
+/**
+ * Return the length of this mapping.
+ *
+ * @param mobj An initialized memory object.
+ */
+pl_vm_address_t plcrash_async_mobject_length (plcrash_async_mobject_t *mobj) {
+    return mobj->length;
 }
 
 /**
- * Validate a target process' address pointer's availability via @a mobj, verifying that @a length bytes can be read
- * from @a mobj at @a address, and return the pointer from which a @a length read may be performed.
+ * Return a borrowed reference to the backing task for this mapping.
  *
  * @param mobj An initialized memory object.
- * @param address The base address to be read. This address should be relative to the target task's address space.
- * @param offset An offset to be applied to @a address prior to verifying the address range.
- * @param length The total number of bytes that should be readable at @a address.
- *
- * @return Returns the validated pointer, or NULL if the requested bytes are not within @a mobj's range.
  */
-void *plcrash_async_mobject_remap_address (plcrash_async_mobject_t *mobj, pl_vm_address_t address, pl_vm_off_t offset, size_t length) {
-    /* Map into our memory space */
-    pl_vm_address_t remapped = address - mobj->vm_slide;
-
-    if (!plcrash_async_mobject_verify_local_pointer(mobj, (uintptr_t) remapped, offset, length))
-        return NULL;
-
-    return (void *) remapped + offset;
+task_t plcrash_async_mobject_task (plcrash_async_mobject_t *mobj) {
+    return mobj->task;
 }
 
 /**
@@ -464,15 +591,19 @@ plcrash_error_t plcrash_async_mobject_read_uint64 (plcrash_async_mobject_t *mobj
  */
 void plcrash_async_mobject_free (plcrash_async_mobject_t *mobj) {
     kern_return_t kt;
-    
+
+    /* Local memory objects reference our own memory directly, and views borrow their parent's mapping; in either
+     * case, there's no mapping to deallocate */
+    if (!mobj->local && !mobj->view) {
 #ifdef PL_HAVE_MACH_VM
-    kt = mach_vm_deallocate(mach_task_self(), mobj->vm_address, mobj->vm_length);
+        kt = mach_vm_deallocate(mach_task_self(), mobj->vm_address, mobj->vm_length);
 #else
-    kt = vm_deallocate(mach_task_self(), mobj->vm_address, mobj->vm_length);
+        kt = vm_deallocate(mach_task_self(), mobj->vm_address, mobj->vm_length);
 #endif
     
-    if (kt != KERN_SUCCESS)
-        PLCF_DEBUG("vm_deallocate() failure: %d", kt);
+        if (kt != KERN_SUCCESS)
+            PLCF_DEBUG("vm_deallocate() failure: %d", kt);
+    }
 
     /* Decrement our task refcount */
     mach_port_mod_refs(mach_task_self(), mobj->task, MACH_PORT_RIGHT_SEND, -1);
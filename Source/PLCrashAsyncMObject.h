@@ -67,17 +67,95 @@ typedef struct plcrash_async_mobject {
     
     /** The actual mapping size. This may differ from the user-requested size, as the base address has been page-aligned */
     pl_vm_size_t vm_length;
+
+    /** If true, the memory object references the current task's memory directly, and no mapping was created. Only
+     * set within a local reference scope; see plcrash_async_mobject_local_references_begin(). */
+    bool local;
+
+    /** If true, the memory object is a view into the mapping of another memory object, and no mapping was created.
+     * The parent memory object must outlive the view. */
+    bool view;
 } plcrash_async_mobject_t;
 
 plcrash_error_t plcrash_async_mobject_init (plcrash_async_mobject_t *mobj, mach_port_t task, pl_vm_address_t task_addr, pl_vm_size_t length, bool require_full);
+plcrash_error_t plcrash_async_mobject_init_persistent (plcrash_async_mobject_t *mobj, mach_port_t task, pl_vm_address_t task_addr, pl_vm_size_t length, bool require_full);
+plcrash_error_t plcrash_async_mobject_init_view (plcrash_async_mobject_t *mobj, plcrash_async_mobject_t *parent, pl_vm_address_t task_addr, pl_vm_size_t length);
+
+void plcrash_async_mobject_local_references_begin (void);
+void plcrash_async_mobject_local_references_end (void);
 
 pl_vm_address_t plcrash_async_mobject_base_address (plcrash_async_mobject_t *mobj);
 pl_vm_address_t plcrash_async_mobject_length (plcrash_async_mobject_t *mobj);
 
 task_t plcrash_async_mobject_task (plcrash_async_mobject_t *mobj);
 
-bool plcrash_async_mobject_verify_local_pointer (plcrash_async_mobject_t *mobj, uintptr_t address, pl_vm_off_t offset, size_t length);
-void *plcrash_async_mobject_remap_address (plcrash_async_mobject_t *mobj, pl_vm_address_t address, pl_vm_off_t offset, size_t length);
+/**
+ * Verify that @a length bytes starting at local @a address is within @a mobj's mapped range.
+ *
+ * This function is called for nearly every read performed by the DWARF and CFE parsers, and is defined inline to
+ * avoid the cost of a function call.
+ *
+ * @param mobj An initialized memory object.
+ * @param address An address within the current task's memory space.
+ * @param offset An offset to be applied to @a address prior to verifying the address range.
+ * @param length The number of bytes that should be readable at @a address + @a offset.
+ */
+static inline bool plcrash_async_mobject_verify_local_pointer (plcrash_async_mobject_t *mobj, uintptr_t address, pl_vm_off_t offset, size_t length) {
+    /* Apply the offset, rejecting any result that overruns a native pointer */
+    uintptr_t target = address + (uintptr_t) offset;
+    if ((offset >= 0) != (target >= address))
+        return false;
+
+    /* Compare the mapping-relative offset; an address below the mapping wraps to a value that exceeds the
+     * mapping's length, allowing a single range check to cover both ends of the mapping. */
+    uintptr_t relative = target - mobj->address;
+    return relative <= mobj->length && length <= mobj->length - relative;
+}
+
+/**
+ * Validate a target process' address pointer's availability via @a mobj, verifying that @a length bytes can be read
+ * from @a mobj at @a address, and return the pointer from which a @a length read may be performed.
+ *
+ * @param mobj An initialized memory object.
+ * @param address The base address to be read. This address should be relative to the target task's address space.
+ * @param offset An offset to be applied to @a address prior to verifying the address range.
+ * @param length The total number of bytes that should be readable at @a address.
+ *
+ * @return Returns the validated pointer, or NULL if the requested bytes are not within @a mobj's range.
+ */
+static inline void *plcrash_async_mobject_remap_address (plcrash_async_mobject_t *mobj, pl_vm_address_t address, pl_vm_off_t offset, size_t length) {
+    /* Map into our memory space */
+    uintptr_t remapped = (uintptr_t) (address - mobj->vm_slide);
+
+    if (!plcrash_async_mobject_verify_local_pointer(mobj, remapped, offset, length))
+        return NULL;
+
+    return (void *) (remapped + offset);
+}
+
+/**
+ * Validate that at least @a min_length bytes may be read from @a mobj at @a address, and return the validated pointer
+ * along with the total number of bytes that may be read from it. This allows variable-length data (eg, LEB128 values)
+ * to be decoded directly from the returned pointer with a single range check, rather than validating each byte
+ * individually.
+ *
+ * @param mobj An initialized memory object.
+ * @param address The base address to be read. This address should be relative to the target task's address space.
+ * @param offset An offset to be applied to @a address prior to verifying the address range.
+ * @param min_length The minimum number of bytes that must be readable at @a address.
+ * @param available On success, the number of bytes that may be read from the returned pointer. This will be no less
+ * than @a min_length.
+ *
+ * @return Returns the validated pointer, or NULL if @a min_length bytes are not within @a mobj's range.
+ */
+static inline void *plcrash_async_mobject_remap_span (plcrash_async_mobject_t *mobj, pl_vm_address_t address, pl_vm_off_t offset, size_t min_length, size_t *available) {
+    uint8_t *p = (uint8_t *) plcrash_async_mobject_remap_address(mobj, address, offset, min_length);
+    if (p == NULL)
+        return NULL;
+
+    *available = (size_t) ((mobj->address + mobj->length) - (uintptr_t) p);
+    return p;
+}
 
 plcrash_error_t plcrash_async_mobject_read_uint8 (plcrash_async_mobject_t *mobj, pl_vm_address_t address, pl_vm_off_t offset, uint8_t *result);
 plcrash_error_t plcrash_async_mobject_read_uint16 (plcrash_async_mobject_t *mobj, const plcrash_async_byteorder_t *byteorder,
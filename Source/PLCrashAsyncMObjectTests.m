@@ -62,6 +62,96 @@
     plcrash_async_mobject_free(&mobj);
 }
 
+/**
+ * Verify that mappings of the current task reference the target memory directly within a local reference scope, and
+ * that unmapped ranges are rejected.
+ */
+- (void) testLocalMapping {
+    size_t size = vm_page_size+1;
+    uint8_t template[size];
+    memset_pattern4(template, (const uint8_t[]){ 0xC, 0xA, 0xF, 0xE }, size);
+
+    /* Map the memory; no new mapping should be created */
+    plcrash_async_mobject_t mobj;
+    plcrash_async_mobject_local_references_begin();
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&mobj, mach_task_self(), (pl_vm_address_t)template, size, true), @"Failed to initialize mapping");
+    STAssertTrue(mobj.local, @"Local mapping was not used");
+    STAssertEquals((uintptr_t)template, mobj.address, @"Local mapping does not reference the target memory");
+    STAssertEquals((int64_t)0, mobj.vm_slide, @"Incorrect slide value!");
+    STAssertEquals(mobj.length, (pl_vm_size_t)size, @"Incorrect length");
+
+    /* Reads must still be bounds checked */
+    STAssertNotNULL(plcrash_async_mobject_remap_address(&mobj, (pl_vm_address_t) template, 0, size), @"Failed to map valid range");
+    STAssertNULL(plcrash_async_mobject_remap_address(&mobj, (pl_vm_address_t) template, 0, size + 1), @"Mapped an out-of-range address");
+    plcrash_async_mobject_free(&mobj);
+
+    /* Verify that an unmapped range is rejected */
+    vm_address_t page;
+    STAssertEquals(KERN_SUCCESS, vm_allocate(mach_task_self(), &page, vm_page_size, VM_FLAGS_ANYWHERE), @"Failed to allocate page");
+    STAssertEquals(KERN_SUCCESS, vm_deallocate(mach_task_self(), page, vm_page_size), @"Failed to deallocate page");
+    STAssertNotEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&mobj, mach_task_self(), page, vm_page_size, true), @"Mapped an unmapped page");
+    plcrash_async_mobject_local_references_end();
+}
+
+/**
+ * Verify that a new mapping is created outside of a local reference scope, and for persistent memory objects.
+ */
+- (void) testMappingOutsideLocalScope {
+    size_t size = vm_page_size+1;
+    uint8_t template[size];
+    memset_pattern4(template, (const uint8_t[]){ 0xC, 0xA, 0xF, 0xE }, size);
+
+    /* Outside of a scope, the memory must be mapped */
+    plcrash_async_mobject_t mobj;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&mobj, mach_task_self(), (pl_vm_address_t)template, size, true), @"Failed to initialize mapping");
+    STAssertFalse(mobj.local, @"Local mapping was used outside of a local reference scope");
+    STAssertNotEquals((uintptr_t)template, mobj.address, @"Mapping references the target memory directly");
+    STAssertTrue(memcmp((void *) mobj.address, template, size) == 0, @"Mapped data does not match");
+    plcrash_async_mobject_free(&mobj);
+
+    /* Persistent memory objects must be mapped, even within a scope */
+    plcrash_async_mobject_local_references_begin();
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init_persistent(&mobj, mach_task_self(), (pl_vm_address_t)template, size, true), @"Failed to initialize mapping");
+    STAssertFalse(mobj.local, @"Local mapping was used for a persistent memory object");
+    STAssertTrue(memcmp((void *) mobj.address, template, size) == 0, @"Mapped data does not match");
+    plcrash_async_mobject_free(&mobj);
+    plcrash_async_mobject_local_references_end();
+}
+
+/**
+ * Verify that views reference their parent's mapping, and that out-of-range views are rejected.
+ */
+- (void) testViewMapping {
+    size_t size = vm_page_size+1;
+    uint8_t template[size];
+    memset_pattern4(template, (const uint8_t[]){ 0xC, 0xA, 0xF, 0xE }, size);
+
+    plcrash_async_mobject_t parent;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&parent, mach_task_self(), (pl_vm_address_t)template, size, true), @"Failed to initialize mapping");
+
+    /* Create a view of the second half of the mapping */
+    plcrash_async_mobject_t view;
+    pl_vm_address_t view_addr = (pl_vm_address_t) template + (size / 2);
+    pl_vm_size_t view_len = size - (size / 2);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init_view(&view, &parent, view_addr, view_len), @"Failed to initialize view");
+    STAssertTrue(view.view, @"View was not marked as such");
+    STAssertEquals(view_addr, plcrash_async_mobject_base_address(&view), @"Incorrect base address");
+    STAssertEquals(view_len, plcrash_async_mobject_length(&view), @"Incorrect length");
+    STAssertEquals(plcrash_async_mobject_remap_address(&parent, view_addr, 0, view_len), plcrash_async_mobject_remap_address(&view, view_addr, 0, view_len), @"View does not reference the parent's mapping");
+
+    /* Reads outside of the view must be rejected, even if within the parent */
+    STAssertNULL(plcrash_async_mobject_remap_address(&view, (pl_vm_address_t) template, 0, 1), @"Mapped an out-of-range address");
+    plcrash_async_mobject_free(&view);
+
+    /* The parent must remain valid after the view is freed */
+    STAssertTrue(memcmp(plcrash_async_mobject_remap_address(&parent, (pl_vm_address_t) template, 0, size), template, size) == 0, @"Parent mapping was modified");
+
+    /* Verify that views outside of the parent are rejected */
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_async_mobject_init_view(&view, &parent, view_addr, size), @"Created an out-of-range view");
+
+    plcrash_async_mobject_free(&parent);
+}
+
 - (void) testBaseAddress {
     size_t size = vm_page_size+1;
     uint8_t template[size];
@@ -165,6 +255,36 @@
     plcrash_async_mobject_free(&mobj);
 }
 
+/**
+ * Test validated span handling.
+ */
+- (void) testRemapSpan {
+    size_t size = vm_page_size+1;
+    uint8_t template[size];
+    size_t available;
+
+    /* Map the memory */
+    plcrash_async_mobject_t mobj;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&mobj, mach_task_self(), (pl_vm_address_t)template, size, true), @"Failed to initialize mapping");
+
+    /* The span should extend to the end of the mapping */
+    STAssertEquals((void *) mobj.address, plcrash_async_mobject_remap_span(&mobj, (pl_vm_address_t) template, 0, 1, &available), @"Mapped to incorrect address");
+    STAssertEquals(available, size, @"Incorrect available length");
+
+    STAssertEquals((void *) mobj.address+10, plcrash_async_mobject_remap_span(&mobj, (pl_vm_address_t) template, 10, size - 10, &available), @"Mapped to incorrect address");
+    STAssertEquals(available, size - 10, @"Incorrect available length");
+
+    /* Spans that can not satisfy the minimum length must be rejected */
+    STAssertNULL(plcrash_async_mobject_remap_span(&mobj, (pl_vm_address_t) template, 10, size - 9, &available), @"Returned a span that ends after our memory object");
+    STAssertNULL(plcrash_async_mobject_remap_span(&mobj, (pl_vm_address_t) template, -1, 1, &available), @"Returned a span that starts before our memory object");
+
+    /* Offsets that wrap around the address space must be rejected */
+    STAssertFalse(plcrash_async_mobject_verify_local_pointer(&mobj, mobj.address, (pl_vm_off_t) (UINTPTR_MAX - mobj.address + 2), 1), @"Returned true for an overflowing offset");
+
+    /* Clean up */
+    plcrash_async_mobject_free(&mobj);
+}
+
 /**
  * Test byte/multibyte read routines.
  */
@@ -27,6 +27,7 @@
  */
 
 #include "PLCrashAsyncMachOImage.h"
+#include "PLCrashAsyncObjCSection.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -34,6 +35,7 @@
 #include <assert.h>
 
 #include <mach-o/fat.h>
+#include <libkern/OSAtomic.h>
 
 /**
  * @internal
@@ -45,6 +47,192 @@
  * @{
  */
 
+static plcrash_error_t plcrash_async_macho_map_section_internal (plcrash_async_macho_t *image, const char *segname, const char *sectname, plcrash_async_mobject_t *mobj, bool persistent);
+static plcrash_error_t plcrash_async_macho_map_known_section_internal (plcrash_async_macho_t *image, plcrash_async_macho_known_section_t section, plcrash_async_mobject_t *mobj, bool persistent);
+
+/**
+ * @internal
+ *
+ * Read and cache the image's LC_UUID and OS version load commands. Malformed commands are ignored.
+ *
+ * @param image The image to be populated; the load commands must have been mapped.
+ */
+static void plcrash_nasync_macho_cache_load_commands (plcrash_async_macho_t *image) {
+    struct load_command *cmd = NULL;
+
+    image->has_uuid = false;
+    image->version_cmd = 0;
+    image->platform = 0;
+    image->min_version = 0;
+    image->sdk_version = 0;
+
+    while ((cmd = plcrash_async_macho_next_command(image, cmd)) != NULL) {
+        if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) cmd, 0, sizeof(*cmd)))
+            break;
+
+        uint32_t type = image->byteorder->swap32(cmd->cmd);
+        switch (type) {
+            case LC_UUID: {
+                struct uuid_command *uuid = (struct uuid_command *) cmd;
+                if (image->has_uuid || !plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) uuid, 0, sizeof(*uuid)))
+                    break;
+
+                plcrash_async_memcpy(image->uuid, uuid->uuid, sizeof(image->uuid));
+                image->has_uuid = true;
+                break;
+            }
+
+            case LC_VERSION_MIN_MACOSX:
+            case LC_VERSION_MIN_IPHONEOS:
+#ifdef LC_VERSION_MIN_TVOS
+            case LC_VERSION_MIN_TVOS:
+#endif
+#ifdef LC_VERSION_MIN_WATCHOS
+            case LC_VERSION_MIN_WATCHOS:
+#endif
+            {
+                struct version_min_command *version = (struct version_min_command *) cmd;
+                if (image->version_cmd != 0 || !plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) version, 0, sizeof(*version)))
+                    break;
+
+                image->version_cmd = type;
+                image->min_version = image->byteorder->swap32(version->version);
+                image->sdk_version = image->byteorder->swap32(version->sdk);
+                break;
+            }
+
+#ifdef LC_BUILD_VERSION
+            case LC_BUILD_VERSION: {
+                struct build_version_command *version = (struct build_version_command *) cmd;
+                if (image->version_cmd != 0 || !plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) version, 0, sizeof(*version)))
+                    break;
+
+                image->version_cmd = type;
+                image->platform = image->byteorder->swap32(version->platform);
+                image->min_version = image->byteorder->swap32(version->minos);
+                image->sdk_version = image->byteorder->swap32(version->sdk);
+                break;
+            }
+#endif
+
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @internal
+ *
+ * The (segment, section) names of each plcrash_async_macho_known_section_t, indexed by value.
+ */
+static const struct {
+    /** The segment name. */
+    const char *segname;
+
+    /** The section name. */
+    const char *sectname;
+} plcrash_async_macho_known_section_names[PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT] = {
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO]        = { SEG_TEXT,   "__unwind_info" },
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_EH_FRAME]           = { SEG_TEXT,   "__eh_frame" },
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_EH_FRAME_HDR]       = { SEG_TEXT,   "__eh_frame_hdr" },
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_DEBUG_FRAME]        = { "__DWARF",  "__debug_frame" },
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_CLASSLIST]     = { SEG_DATA,   "__objc_classlist" },
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_CONST]         = { SEG_DATA,   "__objc_const" },
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_DATA]          = { SEG_DATA,   "__objc_data" },
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_MODULE_INFO]   = { SEG_OBJC,   "__module_info" },
+    [PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_SELREFS]       = { SEG_DATA,   "__objc_selrefs" },
+};
+
+/**
+ * @internal
+ *
+ * Return the well-known section matching @a segname and @a sectname, or -1 if the section is not well-known.
+ *
+ * @param segname The segment name. Need not be NUL-terminated if 16 bytes in length.
+ * @param sectname The section name. Need not be NUL-terminated if 16 bytes in length.
+ */
+static int plcrash_async_macho_find_known_section (const char *segname, const char *sectname) {
+    for (int i = 0; i < PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT; i++) {
+        if (plcrash_async_strncmp(sectname, plcrash_async_macho_known_section_names[i].sectname, 16) != 0)
+            continue;
+
+        if (plcrash_async_strncmp(segname, plcrash_async_macho_known_section_names[i].segname, 16) != 0)
+            continue;
+
+        return i;
+    }
+
+    return -1;
+}
+
+/**
+ * @internal
+ *
+ * Walk the image's section headers once, recording the location of each well-known section. Malformed segment
+ * commands are ignored.
+ *
+ * @param image The image to be populated; the load commands must have been mapped.
+ */
+static void plcrash_nasync_macho_resolve_known_sections (plcrash_async_macho_t *image) {
+    plcrash_async_memset(image->known_sections, 0, sizeof(image->known_sections));
+
+    void *segment = NULL;
+    while ((segment = plcrash_async_macho_next_command_type(image, segment, image->m64 ? LC_SEGMENT_64 : LC_SEGMENT)) != NULL) {
+        struct segment_command *cmd_32 = segment;
+        struct segment_command_64 *cmd_64 = segment;
+        uint32_t nsects;
+        uintptr_t cursor = (uintptr_t) segment;
+
+        if (image->m64) {
+            if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, cursor, 0, sizeof(*cmd_64)))
+                break;
+            nsects = image->byteorder->swap32(cmd_64->nsects);
+            cursor += sizeof(*cmd_64);
+        } else {
+            if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, cursor, 0, sizeof(*cmd_32)))
+                break;
+            nsects = image->byteorder->swap32(cmd_32->nsects);
+            cursor += sizeof(*cmd_32);
+        }
+
+        for (uint32_t i = 0; i < nsects; i++) {
+            const char *sectname;
+            pl_vm_address_t addr;
+            pl_vm_size_t size;
+
+            if (image->m64) {
+                struct section_64 *sect_64 = (void *) cursor;
+                if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, cursor, 0, sizeof(*sect_64)))
+                    break;
+
+                sectname = sect_64->sectname;
+                addr = image->byteorder->swap64(sect_64->addr);
+                size = image->byteorder->swap64(sect_64->size);
+                cursor += sizeof(*sect_64);
+            } else {
+                struct section *sect_32 = (void *) cursor;
+                if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, cursor, 0, sizeof(*sect_32)))
+                    break;
+
+                sectname = sect_32->sectname;
+                addr = image->byteorder->swap32(sect_32->addr);
+                size = image->byteorder->swap32(sect_32->size);
+                cursor += sizeof(*sect_32);
+            }
+
+            /* Sections are matched by the name of their containing segment, as per plcrash_async_macho_map_section() */
+            int known = plcrash_async_macho_find_known_section(image->m64 ? cmd_64->segname : cmd_32->segname, sectname);
+            if (known < 0 || image->known_sections[known].found)
+                continue;
+
+            image->known_sections[known].found = true;
+            image->known_sections[known].addr = addr;
+            image->known_sections[known].size = size;
+        }
+    }
+}
+
 /**
  * Initialize a new Mach-O binary image parser.
  *
@@ -58,6 +246,29 @@
  * @warning This method is not async safe.
  */
 plcrash_error_t plcrash_nasync_macho_init (plcrash_async_macho_t *image, mach_port_t task, const char *name, pl_vm_address_t header) {
+    return plcrash_nasync_macho_init_shared(image, task, name, header, NULL);
+}
+
+/**
+ * Initialize a new Mach-O binary image parser, referencing the image's header and load commands from @a shared_mapping
+ * if contained within it.
+ *
+ * This is intended for use with images in the dyld shared cache; if the shared cache's text region is mapped once,
+ * the headers of all cached images may be read from that single mapping, rather than requiring a distinct mapping
+ * per-image. Images that do not fall within @a shared_mapping are mapped as per plcrash_nasync_macho_init().
+ *
+ * @param image The image structure to be initialized.
+ * @param name The file name or path for the Mach-O image.
+ * @param header The task-local address of the image's Mach-O header.
+ * @param shared_mapping A mapping of @a task from which the image's header and load commands should be referenced, or
+ * NULL. The mapping must not be freed prior to @a image.
+ *
+ * @return PLCRASH_ESUCCESS on success. PLCRASH_EINVAL will be returned in the Mach-O file can not be parsed,
+ * or PLCRASH_EINTERNAL if an error occurs reading from the target task.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_macho_init_shared (plcrash_async_macho_t *image, mach_port_t task, const char *name, pl_vm_address_t header, plcrash_async_mobject_t *shared_mapping) {
     plcrash_error_t ret;
 
     /* Defaults checked in the  error cleanup handler */
@@ -69,13 +280,32 @@ plcrash_error_t plcrash_nasync_macho_init (plcrash_async_macho_t *image, mach_po
     image->task = task;
     image->header_addr = header;
     image->name = strdup(name);
+    image->name_borrowed = false;
+    image->load_cmds_state = PLCRASH_ASYNC_MACHO_LOAD_CMDS_MAPPED;
+    plcrash_async_memset(image->section_cache, 0, sizeof(image->section_cache));
+    plcrash_async_memset(image->known_section_cache, 0, sizeof(image->known_section_cache));
+    image->symbol_index = NULL;
+    image->function_starts = NULL;
+    image->objc_index = NULL;
+    image->objc_imp_range_valid = false;
+    image->objc_imp_min = 0;
+    image->objc_imp_max = 0;
+    image->objc_selector_base = 0;
+    image->fde_index = NULL;
+    image->cfe_index = NULL;
 
     mach_port_mod_refs(mach_task_self(), image->task, MACH_PORT_RIGHT_SEND, 1);
     task_initialized = true;
 
-    /* Read in the Mach-O header */
+    /* Read in the Mach-O header, preferring the shared mapping */
     kern_return_t kt;
-    if ((kt = plcrash_async_read_addr(image->task, image->header_addr, &image->header, sizeof(image->header))) != KERN_SUCCESS) {
+    void *shared_header = NULL;
+    if (shared_mapping != NULL)
+        shared_header = plcrash_async_mobject_remap_address(shared_mapping, image->header_addr, 0, sizeof(image->header));
+
+    if (shared_header != NULL) {
+        plcrash_async_memcpy(&image->header, shared_header, sizeof(image->header));
+    } else if ((kt = plcrash_async_read_addr(image->task, image->header_addr, &image->header, sizeof(image->header))) != KERN_SUCCESS) {
         /* NOTE: The image struct must be fully initialized before returning here, as otherwise our _free() function
          * will crash */
         PLCF_DEBUG("Failed to read Mach-O header from 0x%" PRIx64 " for image %s, kern_error=%d", (uint64_t) image->header_addr, name, kt);
@@ -129,7 +359,13 @@ plcrash_error_t plcrash_nasync_macho_init (plcrash_async_macho_t *image, mach_po
     pl_vm_size_t cmd_offset = image->header_addr + image->header_size;
     image->ncmds = image->byteorder->swap32(image->header.ncmds);
 
-    ret = plcrash_async_mobject_init(&image->load_cmds, image->task, cmd_offset, cmd_len, true);
+    ret = PLCRASH_ENOTFOUND;
+    if (shared_header != NULL)
+        ret = plcrash_async_mobject_init_view(&image->load_cmds, shared_mapping, cmd_offset, cmd_len);
+
+    if (ret != PLCRASH_ESUCCESS)
+        ret = plcrash_async_mobject_init_persistent(&image->load_cmds, image->task, cmd_offset, cmd_len, true);
+
     if (ret != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Failed to map Mach-O load commands in image %s", image->name);
         goto error;
@@ -181,6 +417,13 @@ plcrash_error_t plcrash_nasync_macho_init (plcrash_async_macho_t *image, mach_po
         goto error;
     }
 
+    /* Cache the values written to crash reports, allowing them to be read at crash time without walking the load
+     * commands */
+    image->cpu_type = image->byteorder->swap32(image->header.cputype);
+    image->cpu_subtype = image->byteorder->swap32(image->header.cpusubtype);
+    plcrash_nasync_macho_cache_load_commands(image);
+    plcrash_nasync_macho_resolve_known_sections(image);
+
     /* Compute the vmaddr slide */
     if (image->text_vmaddr < header) {
         image->vmaddr_slide = header - image->text_vmaddr;
@@ -205,6 +448,100 @@ error:
     return ret;
 }
 
+/**
+ * Replace the name of @a image with @a name, freeing the image's own copy. This allows a single allocation to
+ * back the names of many images.
+ *
+ * @param image An initialized image.
+ * @param name A copy of the image's name. The storage must not be freed or modified prior to @a image.
+ *
+ * @warning This method is not async safe, and must not be called once @a image is visible to other threads.
+ */
+void plcrash_nasync_macho_borrow_name (plcrash_async_macho_t *image, char *name) {
+    if (image->name != NULL && !image->name_borrowed)
+        free(image->name);
+
+    image->name = name;
+    image->name_borrowed = true;
+}
+
+/**
+ * Release the mappings held by @a image: the load commands, unless referenced from a shared mapping, and any
+ * cached section mappings. The values cached by plcrash_nasync_macho_init() remain available; the load commands
+ * and sections will be re-mapped on first use, including at crash time.
+ *
+ * This reduces the image's steady-state footprint, at the cost of additional mapping work at crash time.
+ *
+ * @param image An initialized image.
+ *
+ * @warning This method is not async safe, and must not be called once @a image is visible to other threads.
+ */
+void plcrash_nasync_macho_compact (plcrash_async_macho_t *image) {
+    /* Views into a shared mapping hold no mapping of their own */
+    if (image->load_cmds_state == PLCRASH_ASYNC_MACHO_LOAD_CMDS_MAPPED && !image->load_cmds.view) {
+        plcrash_async_mobject_free(&image->load_cmds);
+        image->load_cmds_state = PLCRASH_ASYNC_MACHO_LOAD_CMDS_UNMAPPED;
+    }
+
+    /* Release the section mappings; absent sections remain cached */
+    for (size_t i = 0; i < PLCRASH_ASYNC_MACHO_SECTION_CACHE_SIZE; i++) {
+        if (image->section_cache[i].state == PLCRASH_ASYNC_MACHO_SECTION_MAPPED) {
+            plcrash_async_mobject_free(&image->section_cache[i].mobj);
+            image->section_cache[i].state = PLCRASH_ASYNC_MACHO_SECTION_EMPTY;
+        }
+    }
+
+    for (size_t i = 0; i < PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT; i++) {
+        if (image->known_section_cache[i].state == PLCRASH_ASYNC_MACHO_SECTION_MAPPED) {
+            plcrash_async_mobject_free(&image->known_section_cache[i].mobj);
+            image->known_section_cache[i].state = PLCRASH_ASYNC_MACHO_SECTION_EMPTY;
+        }
+    }
+
+    OSMemoryBarrier();
+}
+
+/**
+ * @internal
+ *
+ * Ensure that the load commands of @a image are mapped, re-mapping them if released by plcrash_nasync_macho_compact().
+ * Once mapped, the load commands remain mapped for the lifetime of the image.
+ *
+ * @param image The image whose load commands are required.
+ *
+ * @return Returns true if the load commands are mapped, or false if they could not be mapped. If another thread is
+ * concurrently mapping the load commands, false will be returned rather than waiting on a thread that may be
+ * suspended.
+ */
+static bool plcrash_async_macho_map_load_cmds (plcrash_async_macho_t *image) {
+    switch (image->load_cmds_state) {
+        case PLCRASH_ASYNC_MACHO_LOAD_CMDS_MAPPED:
+            OSMemoryBarrier();
+            return true;
+
+        case PLCRASH_ASYNC_MACHO_LOAD_CMDS_UNMAPPED:
+            if (OSAtomicCompareAndSwap32Barrier(PLCRASH_ASYNC_MACHO_LOAD_CMDS_UNMAPPED, PLCRASH_ASYNC_MACHO_LOAD_CMDS_BUSY, &image->load_cmds_state)) {
+                pl_vm_size_t cmd_len = image->byteorder->swap32(image->header.sizeofcmds);
+                plcrash_error_t err = plcrash_async_mobject_init_persistent(&image->load_cmds, image->task, image->header_addr + image->header_size, cmd_len, true);
+
+                /* Errors may be transient; release the state on failure */
+                OSMemoryBarrier();
+                if (err != PLCRASH_ESUCCESS) {
+                    PLCF_DEBUG("Failed to map Mach-O load commands in image %s", image->name);
+                    image->load_cmds_state = PLCRASH_ASYNC_MACHO_LOAD_CMDS_UNMAPPED;
+                    return false;
+                }
+
+                image->load_cmds_state = PLCRASH_ASYNC_MACHO_LOAD_CMDS_MAPPED;
+                return true;
+            }
+            return false;
+
+        default:
+            return false;
+    }
+}
+
 /**
  * Return a borrowed reference to the byte order functions to use when parsing data from
  * @a image.
@@ -278,6 +615,10 @@ void *plcrash_async_macho_next_command (plcrash_async_macho_t *image, void *prev
             return NULL;
         }
 
+        /* Map the load commands if they have been released */
+        if (!plcrash_async_macho_map_load_cmds(image))
+            return NULL;
+
         return plcrash_async_mobject_remap_address(&image->load_cmds, image->header_addr, image->header_size, sizeof(struct load_command));
     }
 
@@ -467,8 +808,24 @@ plcrash_error_t plcrash_async_macho_map_segment (plcrash_async_macho_t *image, c
  * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the section is not found, or an error result on failure.
  */
 plcrash_error_t plcrash_async_macho_map_section (plcrash_async_macho_t *image, const char *segname, const char *sectname, plcrash_async_mobject_t *mobj) {
+    return plcrash_async_macho_map_section_internal(image, segname, sectname, mobj, false);
+}
+
+/**
+ * @internal
+ *
+ * Find and map a named section within a named segment, initializing @a mobj. If @a persistent is true, the mapping
+ * will be created via plcrash_async_mobject_init_persistent(), and may be retained by @a image beyond the current
+ * local reference scope. See plcrash_async_macho_map_section() for the remaining parameters.
+ */
+static plcrash_error_t plcrash_async_macho_map_section_internal (plcrash_async_macho_t *image, const char *segname, const char *sectname, plcrash_async_mobject_t *mobj, bool persistent) {
     struct segment_command *cmd_32;
     struct segment_command_64 *cmd_64;
+
+    /* Well-known sections have already been resolved */
+    int known = plcrash_async_macho_find_known_section(segname, sectname);
+    if (known >= 0)
+        return plcrash_async_macho_map_known_section_internal(image, (plcrash_async_macho_known_section_t) known, mobj, persistent);
     
     void *segment =  plcrash_async_macho_find_segment_cmd(image, segname);
     if (segment == NULL)
@@ -517,7 +874,7 @@ plcrash_error_t plcrash_async_macho_map_section (plcrash_async_macho_t *image, c
             pl_vm_size_t sectsize;
             if (image->m64) {
                 sectaddr = image->byteorder->swap64(sect_64->addr) + image->vmaddr_slide;
-                sectsize = image->byteorder->swap32(sect_64->size);
+                sectsize = image->byteorder->swap64(sect_64->size);
             } else {
                 sectaddr = image->byteorder->swap32(sect_32->addr) + image->vmaddr_slide;
                 sectsize = image->byteorder->swap32(sect_32->size);
@@ -525,6 +882,9 @@ plcrash_error_t plcrash_async_macho_map_section (plcrash_async_macho_t *image, c
             
             
             /* Perform and return the mapping */
+            if (persistent)
+                return plcrash_async_mobject_init_persistent(mobj, image->task, sectaddr, sectsize, true);
+
             return plcrash_async_mobject_init(mobj, image->task, sectaddr, sectsize, true);
         }
     }
@@ -532,6 +892,229 @@ plcrash_error_t plcrash_async_macho_map_section (plcrash_async_macho_t *image, c
     return PLCRASH_ENOTFOUND;
 }
 
+/**
+ * Find and map a named section within a named segment, returning a borrowed reference to a mapping that is cached by
+ * @a image for its lifetime. Subsequent requests for the same section will return the cached mapping (or cached
+ * lookup failure) without additional Mach VM calls.
+ *
+ * If the section can not be cached (eg, the cache is full, or is concurrently being populated by another reader), the
+ * section will be mapped into the caller-supplied @a storage, and @a mobj will be set to @a storage.
+ *
+ * In either case, the mapping must be released via plcrash_async_macho_mapped_section_release().
+ *
+ * @param image The image to search for @a segname.
+ * @param segname The name of the segment to search.
+ * @param sectname The name of the section to map.
+ * @param storage Caller-supplied storage to be used if the section can not be cached.
+ * @param mobj On success, will be set to a borrowed reference to the mapped section.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the section is not found, or an error result on failure.
+ */
+plcrash_error_t plcrash_async_macho_map_section_cached (plcrash_async_macho_t *image, const char *segname, const char *sectname, plcrash_async_mobject_t *storage, plcrash_async_mobject_t **mobj) {
+    plcrash_async_macho_section_cache_entry_t *free_entry = NULL;
+    plcrash_error_t err;
+
+    /* Well-known sections are cached in their own fixed slots */
+    int known = plcrash_async_macho_find_known_section(segname, sectname);
+    if (known >= 0)
+        return plcrash_async_macho_map_known_section_cached(image, (plcrash_async_macho_known_section_t) known, storage, mobj);
+
+    /* Search for an existing entry */
+    for (size_t i = 0; i < PLCRASH_ASYNC_MACHO_SECTION_CACHE_SIZE; i++) {
+        plcrash_async_macho_section_cache_entry_t *entry = &image->section_cache[i];
+        int32_t state = entry->state;
+        
+        /* Claim the first free entry, to be used if no match is found */
+        if (state == PLCRASH_ASYNC_MACHO_SECTION_EMPTY) {
+            if (free_entry == NULL && OSAtomicCompareAndSwap32Barrier(PLCRASH_ASYNC_MACHO_SECTION_EMPTY, PLCRASH_ASYNC_MACHO_SECTION_BUSY, &entry->state))
+                free_entry = entry;
+            continue;
+        }
+
+        /* Busy entries can not yet be read */
+        if (state == PLCRASH_ASYNC_MACHO_SECTION_BUSY)
+            continue;
+
+        /* Issue a barrier to ensure a consistent view of the entry */
+        OSMemoryBarrier();
+        if (plcrash_async_strncmp(entry->segname, segname, sizeof(entry->segname)) != 0 || plcrash_async_strncmp(entry->sectname, sectname, sizeof(entry->sectname)) != 0)
+            continue;
+
+        /* Found; release any entry we may have claimed */
+        if (free_entry != NULL)
+            OSAtomicCompareAndSwap32Barrier(PLCRASH_ASYNC_MACHO_SECTION_BUSY, PLCRASH_ASYNC_MACHO_SECTION_EMPTY, &free_entry->state);
+
+        if (state == PLCRASH_ASYNC_MACHO_SECTION_NOTFOUND)
+            return PLCRASH_ENOTFOUND;
+
+        *mobj = &entry->mobj;
+        return PLCRASH_ESUCCESS;
+    }
+
+    /* If the cache is unavailable, map the section directly */
+    if (free_entry == NULL) {
+        if ((err = plcrash_async_macho_map_section(image, segname, sectname, storage)) != PLCRASH_ESUCCESS)
+            return err;
+
+        *mobj = storage;
+        return PLCRASH_ESUCCESS;
+    }
+
+    /* Populate the claimed entry */
+    size_t i;
+    for (i = 0; i < sizeof(free_entry->segname) && segname[i] != '\0'; i++)
+        free_entry->segname[i] = segname[i];
+    for (; i < sizeof(free_entry->segname); i++)
+        free_entry->segname[i] = '\0';
+
+    for (i = 0; i < sizeof(free_entry->sectname) && sectname[i] != '\0'; i++)
+        free_entry->sectname[i] = sectname[i];
+    for (; i < sizeof(free_entry->sectname); i++)
+        free_entry->sectname[i] = '\0';
+
+    err = plcrash_async_macho_map_section_internal(image, segname, sectname, &free_entry->mobj, true);
+    if (err == PLCRASH_ESUCCESS) {
+        OSMemoryBarrier();
+        free_entry->state = PLCRASH_ASYNC_MACHO_SECTION_MAPPED;
+
+        *mobj = &free_entry->mobj;
+        return PLCRASH_ESUCCESS;
+    } else if (err == PLCRASH_ENOTFOUND) {
+        /* Cache the negative result */
+        OSMemoryBarrier();
+        free_entry->state = PLCRASH_ASYNC_MACHO_SECTION_NOTFOUND;
+        return err;
+    }
+
+    /* Other errors may be transient; release the entry */
+    OSMemoryBarrier();
+    free_entry->state = PLCRASH_ASYNC_MACHO_SECTION_EMPTY;
+    return err;
+}
+
+/**
+ * Map a well-known section, initializing @a mobj. The section's location was resolved when @a image was initialized;
+ * no load commands are read. It is the caller's responsibility to dealloc @a mobj after a successful initialization.
+ *
+ * @param image The image in which @a section should be found.
+ * @param section The section to map.
+ * @param mobj The mobject to be initialized with a mapping of the section's data.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the section is not found, or an error result on failure.
+ */
+plcrash_error_t plcrash_async_macho_map_known_section (plcrash_async_macho_t *image, plcrash_async_macho_known_section_t section, plcrash_async_mobject_t *mobj) {
+    return plcrash_async_macho_map_known_section_internal(image, section, mobj, false);
+}
+
+/**
+ * Map a well-known section, initializing @a mobj. Unlike plcrash_async_macho_map_known_section(), the mapping is created
+ * via plcrash_async_mobject_init_persistent(), and may be retained by the caller beyond the current local reference
+ * scope (eg, by a cache that is reused across reports). It is the caller's responsibility to dealloc @a mobj after a
+ * successful initialization.
+ *
+ * @param image The image in which @a section should be found.
+ * @param section The section to map.
+ * @param mobj The mobject to be initialized with a mapping of the section's data.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the section is not found, or an error result on failure.
+ */
+plcrash_error_t plcrash_async_macho_map_known_section_persistent (plcrash_async_macho_t *image, plcrash_async_macho_known_section_t section, plcrash_async_mobject_t *mobj) {
+    return plcrash_async_macho_map_known_section_internal(image, section, mobj, true);
+}
+
+/**
+ * @internal
+ *
+ * Map a well-known section, initializing @a mobj. If @a persistent is true, the mapping will be created via
+ * plcrash_async_mobject_init_persistent(), and may be retained by @a image beyond the current local reference scope.
+ */
+static plcrash_error_t plcrash_async_macho_map_known_section_internal (plcrash_async_macho_t *image, plcrash_async_macho_known_section_t section, plcrash_async_mobject_t *mobj, bool persistent) {
+    PLCF_ASSERT(section < PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT);
+
+    plcrash_async_macho_known_section_info_t *info = &image->known_sections[section];
+    if (!info->found)
+        return PLCRASH_ENOTFOUND;
+
+    if (persistent)
+        return plcrash_async_mobject_init_persistent(mobj, image->task, info->addr + image->vmaddr_slide, info->size, true);
+
+    return plcrash_async_mobject_init(mobj, image->task, info->addr + image->vmaddr_slide, info->size, true);
+}
+
+/**
+ * Map a well-known section, returning a borrowed reference to a mapping that is cached by @a image for its lifetime.
+ * Unlike plcrash_async_macho_map_section_cached(), the cached mapping is found in constant time.
+ *
+ * If the section's cache entry is concurrently being populated by another reader, the section will be mapped into the
+ * caller-supplied @a storage, and @a mobj will be set to @a storage. In either case, the mapping must be released via
+ * plcrash_async_macho_mapped_section_release().
+ *
+ * @param image The image in which @a section should be found.
+ * @param section The section to map.
+ * @param storage Caller-supplied storage to be used if the section can not be cached.
+ * @param mobj On success, will be set to a borrowed reference to the mapped section.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the section is not found, or an error result on failure.
+ */
+plcrash_error_t plcrash_async_macho_map_known_section_cached (plcrash_async_macho_t *image, plcrash_async_macho_known_section_t section, plcrash_async_mobject_t *storage, plcrash_async_mobject_t **mobj) {
+    PLCF_ASSERT(section < PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT);
+
+    plcrash_async_macho_section_cache_entry_t *entry = &image->known_section_cache[section];
+    plcrash_error_t err;
+
+    if (!image->known_sections[section].found)
+        return PLCRASH_ENOTFOUND;
+
+    switch (entry->state) {
+        case PLCRASH_ASYNC_MACHO_SECTION_MAPPED:
+            /* Issue a barrier to ensure a consistent view of the entry */
+            OSMemoryBarrier();
+            *mobj = &entry->mobj;
+            return PLCRASH_ESUCCESS;
+
+        case PLCRASH_ASYNC_MACHO_SECTION_EMPTY:
+            if (OSAtomicCompareAndSwap32Barrier(PLCRASH_ASYNC_MACHO_SECTION_EMPTY, PLCRASH_ASYNC_MACHO_SECTION_BUSY, &entry->state)) {
+                if ((err = plcrash_async_macho_map_known_section_internal(image, section, &entry->mobj, true)) != PLCRASH_ESUCCESS) {
+                    /* Errors may be transient; release the entry */
+                    OSMemoryBarrier();
+                    entry->state = PLCRASH_ASYNC_MACHO_SECTION_EMPTY;
+                    return err;
+                }
+
+                OSMemoryBarrier();
+                entry->state = PLCRASH_ASYNC_MACHO_SECTION_MAPPED;
+
+                *mobj = &entry->mobj;
+                return PLCRASH_ESUCCESS;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    /* The entry is busy; map the section directly */
+    if ((err = plcrash_async_macho_map_known_section(image, section, storage)) != PLCRASH_ESUCCESS)
+        return err;
+
+    *mobj = storage;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Release a section mapping returned by plcrash_async_macho_map_section_cached(). Cached mappings are retained
+ * by their image; uncached mappings are freed.
+ *
+ * @param storage The caller-supplied storage that was provided to plcrash_async_macho_map_section_cached().
+ * @param mobj The mapping returned by plcrash_async_macho_map_section_cached().
+ *
+ * @note Unlike most free() functions in this API, this function is async-safe.
+ */
+void plcrash_async_macho_mapped_section_release (plcrash_async_mobject_t *storage, plcrash_async_mobject_t *mobj) {
+    if (mobj == storage)
+        plcrash_async_mobject_free(storage);
+}
+
 /**
  * @internal
  * Common wrapper of nlist/nlist_64. We verify that this union is valid for our purposes in pl_async_macho_find_symtab_symbol().
@@ -541,6 +1124,191 @@ typedef union {
     struct nlist n32;
 } pl_nlist_common;
 
+/*
+ * Read a ULEB128 value from @a data at @a pos, advancing @a pos past the value.
+ *
+ * @param data The data to read.
+ * @param size The size of @a data, in bytes.
+ * @param pos The offset of the value within @a data. On success, will be set to the offset of the following byte.
+ * @param result On success, will be set to the decoded value.
+ *
+ * @return Returns true on success, or false if the value is truncated or exceeds 64 bits.
+ */
+static bool plcrash_async_macho_read_uleb128 (const uint8_t *data, size_t size, size_t *pos, uint64_t *result) {
+    uint64_t value = 0;
+    uint32_t shift = 0;
+
+    while (*pos < size && shift < 64) {
+        uint8_t byte = data[(*pos)++];
+        value |= ((uint64_t) (byte & 0x7F)) << shift;
+        shift += 7;
+
+        if ((byte & 0x80) == 0) {
+            *result = value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Attempt to locate the address of the exported @a symbol within @a image, using the image's export trie
+ * (LC_DYLD_INFO, LC_DYLD_INFO_ONLY or LC_DYLD_EXPORTS_TRIE). The lookup is performed in O(symbol length), and remains
+ * available for images whose symbol tables have been stripped of all but their exports.
+ *
+ * @param image The Mach-O image to search for @a symbol
+ * @param symbol The symbol name to search for.
+ * @param address On success, will be set to the address of the symbol. As with the address returned by
+ * plcrash_async_macho_find_symbol_by_name(), this will include any required bit flags, such as the ARM thumb bit.
+ *
+ * @return Returns PLCRASH_ESUCCESS if the symbol is found, PLCRASH_ENOTFOUND if the image has no export trie or the
+ * symbol is not exported (or is re-exported from another image), or PLCRASH_EINVAL if the trie is malformed.
+ */
+plcrash_error_t plcrash_async_macho_find_export (plcrash_async_macho_t *image, const char *symbol, pl_vm_address_t *address) {
+    pl_async_macho_mapped_segment_t linkedit;
+    uint32_t trie_off;
+    uint32_t trie_size;
+    plcrash_error_t err;
+
+    /* Locate the trie */
+    struct dyld_info_command *dyld_info = plcrash_async_macho_find_command(image, LC_DYLD_INFO_ONLY);
+    if (dyld_info == NULL)
+        dyld_info = plcrash_async_macho_find_command(image, LC_DYLD_INFO);
+
+    if (dyld_info != NULL) {
+        if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) dyld_info, 0, sizeof(*dyld_info)))
+            return PLCRASH_EINVAL;
+
+        trie_off = image->byteorder->swap32(dyld_info->export_off);
+        trie_size = image->byteorder->swap32(dyld_info->export_size);
+    } else {
+#ifdef LC_DYLD_EXPORTS_TRIE
+        struct linkedit_data_command *exports = plcrash_async_macho_find_command(image, LC_DYLD_EXPORTS_TRIE);
+        if (exports == NULL)
+            return PLCRASH_ENOTFOUND;
+
+        if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) exports, 0, sizeof(*exports)))
+            return PLCRASH_EINVAL;
+
+        trie_off = image->byteorder->swap32(exports->dataoff);
+        trie_size = image->byteorder->swap32(exports->datasize);
+#else
+        return PLCRASH_ENOTFOUND;
+#endif
+    }
+
+    if (trie_size == 0)
+        return PLCRASH_ENOTFOUND;
+
+    /* Map in the __LINKEDIT segment, which includes the trie */
+    if ((err = plcrash_async_macho_map_segment(image, "__LINKEDIT", &linkedit)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("plcrash_async_macho_map_segment() failure: %d in %s", err, image->name);
+        return err;
+    }
+
+    const uint8_t *trie = plcrash_async_mobject_remap_address(&linkedit.mobj, linkedit.mobj.task_address, trie_off - linkedit.fileoff, trie_size);
+    if (trie == NULL) {
+        PLCF_DEBUG("Export trie falls outside of __LINKEDIT in %s", image->name);
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    /* Walk the trie, consuming the symbol name one edge at a time */
+    const char *remaining = symbol;
+    size_t node = 0;
+    while (true) {
+        size_t pos = node;
+        uint64_t terminal_size;
+        if (!plcrash_async_macho_read_uleb128(trie, trie_size, &pos, &terminal_size)) {
+            err = PLCRASH_EINVAL;
+            goto cleanup;
+        }
+
+        /* If the full name has been consumed, this node must describe the symbol */
+        if (*remaining == '\0') {
+            uint64_t flags;
+            uint64_t value;
+
+            if (terminal_size == 0) {
+                err = PLCRASH_ENOTFOUND;
+                goto cleanup;
+            }
+
+            if (!plcrash_async_macho_read_uleb128(trie, trie_size, &pos, &flags) || !plcrash_async_macho_read_uleb128(trie, trie_size, &pos, &value)) {
+                err = PLCRASH_EINVAL;
+                goto cleanup;
+            }
+
+            /* Re-exported symbols are defined by another image */
+            if (flags & EXPORT_SYMBOL_FLAGS_REEXPORT) {
+                err = PLCRASH_ENOTFOUND;
+                goto cleanup;
+            }
+
+#ifdef EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE
+            if ((flags & EXPORT_SYMBOL_FLAGS_KIND_MASK) == EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE) {
+                *address = (pl_vm_address_t) value;
+                err = PLCRASH_ESUCCESS;
+                goto cleanup;
+            }
+#endif
+
+            /* Other addresses are relative to the image's header */
+            *address = image->header_addr + (pl_vm_address_t) value;
+            err = PLCRASH_ESUCCESS;
+            goto cleanup;
+        }
+
+        /* Skip the terminal data */
+        if (terminal_size >= trie_size - pos) {
+            err = PLCRASH_EINVAL;
+            goto cleanup;
+        }
+        pos += terminal_size;
+
+        /* Find the child edge matching the remaining name */
+        uint8_t child_count = trie[pos++];
+        bool found = false;
+        for (uint8_t i = 0; i < child_count && !found; i++) {
+            const char *edge_match = remaining;
+            bool match = true;
+
+            while (pos < trie_size && trie[pos] != '\0') {
+                if (match && *edge_match == (char) trie[pos])
+                    edge_match++;
+                else
+                    match = false;
+                pos++;
+            }
+
+            /* Skip the terminating NUL and read the child offset */
+            uint64_t child;
+            pos++;
+            if (pos >= trie_size || !plcrash_async_macho_read_uleb128(trie, trie_size, &pos, &child) || child >= trie_size) {
+                err = PLCRASH_EINVAL;
+                goto cleanup;
+            }
+
+            /* Every edge must consume at least one character; this guarantees termination on malformed tries. */
+            if (match && edge_match != remaining) {
+                remaining = edge_match;
+                node = (size_t) child;
+                found = true;
+            }
+        }
+
+        if (!found) {
+            err = PLCRASH_ENOTFOUND;
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    plcrash_async_macho_mapped_segment_free(&linkedit);
+    return err;
+}
+
 /**
  * Attempt to locate a symbol address for @a symbol name within @a image.
  *
@@ -556,10 +1324,15 @@ typedef union {
  * @todo Migrate this API to use the plcrash_async_macho_symtab_reader types when returning symbol data.
  */
 plcrash_error_t plcrash_async_macho_find_symbol_by_name (plcrash_async_macho_t *image, const char *symbol, pl_vm_address_t *pc) {
-    /* Now walk the Mach-O table ourselves */
     plcrash_async_macho_symtab_reader_t reader;
     plcrash_error_t ret;
 
+    /* Prefer the export trie, which avoids a linear walk of the symbol table */
+    if (plcrash_async_macho_find_export(image, symbol, pc) == PLCRASH_ESUCCESS)
+        return PLCRASH_ESUCCESS;
+
+    /* Otherwise, walk the Mach-O table ourselves */
+
     /* Initialize the reader */
     ret = plcrash_async_macho_symtab_reader_init(&reader, image);
     if (ret != PLCRASH_ESUCCESS)
@@ -839,6 +1612,344 @@ static void plcrash_async_macho_find_best_symbol (plcrash_async_macho_symtab_rea
     }
 }
 
+/*
+ * Append all symbol index candidates from @a symtab to @a entries, returning the number of candidate entries.
+ * If @a entries is NULL, the candidates will only be counted.
+ *
+ * @param reader The Mach-O symbol table reader.
+ * @param symtab The symtab to read.
+ * @param nsyms The number of nlist entries available via @a symtab.
+ * @param entries The array to which entries will be appended, or NULL.
+ */
+static uint32_t plcrash_nasync_macho_symbol_index_add (plcrash_async_macho_symtab_reader_t *reader,
+                                                       pl_nlist_common *symtab, uint32_t nsyms,
+                                                       plcrash_async_macho_symbol_index_entry_t *entries)
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < nsyms; i++) {
+        plcrash_async_macho_symtab_entry_t entry = plcrash_async_macho_symtab_reader_read(reader, symtab, i);
+
+        /* Symbol must be within a section, and must not be a debugging entry; this matches plcrash_async_macho_find_best_symbol(). */
+        if ((entry.n_type & N_TYPE) != N_SECT || ((entry.n_type & N_STAB) != 0))
+            continue;
+
+        if (entries != NULL) {
+            entries[count].n_value = entry.n_value;
+            entries[count].n_strx = entry.n_strx;
+            entries[count].n_desc = entry.n_desc;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/* plcrash_async_macho_symbol_index_entry_t address comparison function */
+static int plcrash_nasync_macho_symbol_index_compare (const void *a, const void *b) {
+    const plcrash_async_macho_symbol_index_entry_t *lhs = a;
+    const plcrash_async_macho_symbol_index_entry_t *rhs = b;
+
+    if (lhs->n_value < rhs->n_value)
+        return -1;
+    else if (lhs->n_value > rhs->n_value)
+        return 1;
+    return 0;
+}
+
+/**
+ * Build an address-sorted index of the symbol table of @a image, allowing plcrash_async_macho_find_symbol_by_pc() to perform
+ * a binary search rather than a linear search of the symbol table. The index is allocated within a dedicated allocator, and
+ * will be released by plcrash_nasync_macho_free(). If an index has already been built, no action is taken.
+ *
+ * @param image The image for which an index should be built.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an error result on failure.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_macho_build_symbol_index (plcrash_async_macho_t *image) {
+    plcrash_async_macho_symtab_reader_t reader;
+    plcrash_async_allocator_t *allocator;
+    plcrash_async_macho_symbol_index_t *index;
+    plcrash_error_t err;
+
+    if (image->symbol_index != NULL)
+        return PLCRASH_ESUCCESS;
+
+    if ((err = plcrash_async_macho_symtab_reader_init(&reader, image)) != PLCRASH_ESUCCESS)
+        return err;
+
+    /* Determine the candidate tables. The ordering (global, then local) matches plcrash_async_macho_find_symbol_by_pc(). */
+    pl_nlist_common *tables[2];
+    uint32_t table_nsyms[2];
+    size_t table_count;
+
+    if (reader.symtab_global != NULL && reader.symtab_local != NULL) {
+        tables[0] = reader.symtab_global;
+        table_nsyms[0] = reader.nsyms_global;
+        tables[1] = reader.symtab_local;
+        table_nsyms[1] = reader.nsyms_local;
+        table_count = 2;
+    } else {
+        tables[0] = reader.symtab;
+        table_nsyms[0] = reader.nsyms;
+        table_count = 1;
+    }
+
+    /* Count the candidate symbols */
+    uint32_t count = 0;
+    for (size_t i = 0; i < table_count; i++)
+        count += plcrash_nasync_macho_symbol_index_add(&reader, tables[i], table_nsyms[i], NULL);
+
+    /* Allocate the index */
+    size_t index_size = sizeof(plcrash_async_macho_symbol_index_t) + (sizeof(plcrash_async_macho_symbol_index_entry_t) * count);
+
+    if ((err = plcrash_async_allocator_new(&allocator, index_size, 0)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not allocate a %" PRIu32 " entry symbol index for %s: %d", count, image->name, err);
+        goto cleanup;
+    }
+
+    if ((index = plcrash_async_allocator_alloc(allocator, index_size, true)) == NULL) {
+        PLCF_DEBUG("Could not allocate a %" PRIu32 " entry symbol index for %s", count, image->name);
+        plcrash_async_allocator_free(allocator);
+        err = PLCRASH_ENOMEM;
+        goto cleanup;
+    }
+
+    index->allocator = allocator;
+
+    /* Populate the index */
+    index->count = 0;
+    for (size_t i = 0; i < table_count; i++)
+        index->count += plcrash_nasync_macho_symbol_index_add(&reader, tables[i], table_nsyms[i], &index->entries[index->count]);
+
+    /*
+     * Sort by address. A stable sort is required; when multiple symbols share an address, the linear search
+     * returns the first such symbol, and we discard the remainder.
+     */
+    if (index->count > 0) {
+        mergesort(index->entries, index->count, sizeof(index->entries[0]), plcrash_nasync_macho_symbol_index_compare);
+
+        uint32_t unique = 1;
+        for (uint32_t i = 1; i < index->count; i++) {
+            if (index->entries[i].n_value != index->entries[unique - 1].n_value)
+                index->entries[unique++] = index->entries[i];
+        }
+        index->count = unique;
+    }
+
+    /* Publish the index. If another index was concurrently published, discard ours. */
+    if (!OSAtomicCompareAndSwapPtrBarrier(NULL, index, (void **) &image->symbol_index))
+        plcrash_async_allocator_free(allocator);
+
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    plcrash_async_macho_symtab_reader_free(&reader);
+    return err;
+}
+
+/*
+ * Decode the ULEB128-encoded LC_FUNCTION_STARTS deltas in @a data, returning the number of function starts. If
+ * @a offsets is NULL, the entries will only be counted. Decoding stops at the first zero delta, or at the first
+ * malformed or out-of-range value.
+ *
+ * @param data The function start data.
+ * @param size The size of @a data, in bytes.
+ * @param offsets The array to which the decoded __TEXT-relative offsets will be written, or NULL.
+ */
+static uint32_t plcrash_nasync_macho_function_starts_decode (const uint8_t *data, size_t size, uint32_t *offsets) {
+    uint64_t offset = 0;
+    uint32_t count = 0;
+    size_t pos = 0;
+
+    while (pos < size) {
+        /* Read the next delta. A zero delta terminates the table. */
+        uint64_t delta;
+        if (!plcrash_async_macho_read_uleb128(data, size, &pos, &delta) || delta == 0)
+            break;
+
+        offset += delta;
+        if (offset > UINT32_MAX)
+            break;
+
+        /* Discard the Thumb bit, if any */
+        if (offsets != NULL)
+            offsets[count] = ((uint32_t) offset) & ~1U;
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Decode the LC_FUNCTION_STARTS table of @a image into an address-sorted array of function start addresses, allowing
+ * plcrash_async_macho_find_function_start() to find the exact start of the function containing a PC with a binary
+ * search. The table is allocated within a dedicated allocator, and will be released by plcrash_nasync_macho_free().
+ * If a table has already been built, no action is taken.
+ *
+ * When available, plcrash_async_macho_find_symbol_by_pc() uses the table to reject symbols that precede the containing
+ * function, as occurs when the function has no symbol table entry (eg, in a stripped binary).
+ *
+ * @param image The image for which the table should be built.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the image has no LC_FUNCTION_STARTS command, or
+ * an error result on failure.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_macho_build_function_starts (plcrash_async_macho_t *image) {
+    pl_async_macho_mapped_segment_t linkedit;
+    plcrash_async_allocator_t *allocator;
+    plcrash_async_macho_function_starts_t *table;
+    plcrash_error_t err;
+
+    if (image->function_starts != NULL)
+        return PLCRASH_ESUCCESS;
+
+    struct linkedit_data_command *cmd = plcrash_async_macho_find_command(image, LC_FUNCTION_STARTS);
+    if (cmd == NULL)
+        return PLCRASH_ENOTFOUND;
+
+    if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) cmd, 0, sizeof(*cmd))) {
+        PLCF_DEBUG("LC_FUNCTION_STARTS command was too short");
+        return PLCRASH_EINVAL;
+    }
+
+    /* Map in the __LINKEDIT segment, which includes the function start data */
+    if ((err = plcrash_async_macho_map_segment(image, "__LINKEDIT", &linkedit)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("plcrash_async_macho_map_segment() failure: %d in %s", err, image->name);
+        return err;
+    }
+
+    uint32_t dataoff = image->byteorder->swap32(cmd->dataoff);
+    uint32_t datasize = image->byteorder->swap32(cmd->datasize);
+    const uint8_t *data = plcrash_async_mobject_remap_address(&linkedit.mobj, linkedit.mobj.task_address, dataoff - linkedit.fileoff, datasize);
+    if (data == NULL) {
+        PLCF_DEBUG("LC_FUNCTION_STARTS data falls outside of __LINKEDIT in %s", image->name);
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    /* Allocate the table */
+    uint32_t count = plcrash_nasync_macho_function_starts_decode(data, datasize, NULL);
+    size_t table_size = sizeof(plcrash_async_macho_function_starts_t) + (sizeof(uint32_t) * count);
+
+    if ((err = plcrash_async_allocator_new(&allocator, table_size, 0)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not allocate a %" PRIu32 " entry function start table for %s: %d", count, image->name, err);
+        goto cleanup;
+    }
+
+    if ((table = plcrash_async_allocator_alloc(allocator, table_size, true)) == NULL) {
+        PLCF_DEBUG("Could not allocate a %" PRIu32 " entry function start table for %s", count, image->name);
+        plcrash_async_allocator_free(allocator);
+        err = PLCRASH_ENOMEM;
+        goto cleanup;
+    }
+
+    /* Populate the table. The deltas are unsigned, and the decoded offsets are thus already sorted. */
+    table->allocator = allocator;
+    table->count = plcrash_nasync_macho_function_starts_decode(data, datasize, table->offsets);
+
+    /* Publish the table. If another table was concurrently published, discard ours. */
+    if (!OSAtomicCompareAndSwapPtrBarrier(NULL, table, (void **) &image->function_starts))
+        plcrash_async_allocator_free(allocator);
+
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    plcrash_async_macho_mapped_segment_free(&linkedit);
+    return err;
+}
+
+/**
+ * Find the start address of the function containing @a pc, using the table built by
+ * plcrash_nasync_macho_build_function_starts().
+ *
+ * @param image The Mach-O image to search for @a pc.
+ * @param pc The PC value within the target process.
+ * @param function_start On success, will be set to the task-relative start address of the function containing @a pc.
+ *
+ * @return Returns true if the function start was found, or false if no function start table is available, or
+ * @a pc precedes the image's first function.
+ *
+ * @note This function is async-safe.
+ */
+bool plcrash_async_macho_find_function_start (plcrash_async_macho_t *image, pl_vm_address_t pc, pl_vm_address_t *function_start) {
+    plcrash_async_macho_function_starts_t *table = image->function_starts;
+    if (table == NULL)
+        return false;
+
+    /* Compute the __TEXT-relative offset */
+    pl_vm_address_t slide_pc = pc - image->vmaddr_slide;
+    if (slide_pc < image->text_vmaddr || slide_pc - image->text_vmaddr > UINT32_MAX)
+        return false;
+    uint32_t offset = (uint32_t) (slide_pc - image->text_vmaddr);
+
+    /* Find the first entry with an offset greater than the PC */
+    uint32_t lower = 0;
+    uint32_t upper = table->count;
+    while (lower < upper) {
+        uint32_t mid = lower + ((upper - lower) / 2);
+        if (table->offsets[mid] <= offset)
+            lower = mid + 1;
+        else
+            upper = mid;
+    }
+
+    if (lower == 0)
+        return false;
+
+    *function_start = image->text_vmaddr + table->offsets[lower - 1] + image->vmaddr_slide;
+    return true;
+}
+
+/*
+ * Locate a symtab entry for @a slide_pc within @a index, using a binary search.
+ *
+ * @param index The symbol index to search.
+ * @param slide_pc The PC value within the target process for which symbol information should be found. The VM slide
+ * address should have already been applied to this value.
+ * @param found_symbol On success, will be set to the discovered symbol value.
+ *
+ * @return Returns true if a symbol was found, false otherwise.
+ */
+static bool plcrash_async_macho_find_indexed_symbol (plcrash_async_macho_symbol_index_t *index,
+                                                     pl_vm_address_t slide_pc,
+                                                     plcrash_async_macho_symtab_entry_t *found_symbol)
+{
+    /* Find the first entry with an address greater than slide_pc */
+    uint32_t lower = 0;
+    uint32_t upper = index->count;
+    while (lower < upper) {
+        uint32_t mid = lower + ((upper - lower) / 2);
+        if (index->entries[mid].n_value <= slide_pc)
+            lower = mid + 1;
+        else
+            upper = mid;
+    }
+
+    /* The preceding entry (if any) is the closest symbol occuring before PC */
+    if (lower == 0)
+        return false;
+
+    plcrash_async_macho_symbol_index_entry_t *entry = &index->entries[lower - 1];
+    found_symbol->n_strx = entry->n_strx;
+    found_symbol->n_type = N_SECT;
+    found_symbol->n_sect = NO_SECT;
+    found_symbol->n_desc = entry->n_desc;
+    found_symbol->n_value = entry->n_value;
+
+    /* Normalize the symbol address, as per plcrash_async_macho_symtab_reader_read() */
+    if (entry->n_desc & N_ARM_THUMB_DEF)
+        found_symbol->normalized_value = (entry->n_value|1);
+    else
+        found_symbol->normalized_value = entry->n_value;
+
+    return true;
+}
+
 /**
  * Attempt to locate a symbol address and name for @a pc within @a image. This is performed using best-guess heuristics, and may
  * be incorrect.
@@ -868,8 +1979,12 @@ plcrash_error_t plcrash_async_macho_find_symbol_by_pc (plcrash_async_macho_t *im
     /* Walk the symbol table. */
     plcrash_async_macho_symtab_entry_t found_symbol;
     bool did_find_symbol;
+    plcrash_async_macho_symbol_index_t *index = image->symbol_index;
 
-    if (reader.symtab_global != NULL && reader.symtab_local != NULL) {
+    if (index != NULL) {
+        /* A symbol index is available; perform a binary search. */
+        did_find_symbol = plcrash_async_macho_find_indexed_symbol(index, slide_pc, &found_symbol);
+    } else if (reader.symtab_global != NULL && reader.symtab_local != NULL) {
         /* dysymtab is available; use it to constrain our symbol search to the global and local sections of the symbol table. */
         plcrash_async_macho_find_best_symbol(&reader, slide_pc, reader.symtab_global, reader.nsyms_global, &found_symbol, NULL, &did_find_symbol);
         plcrash_async_macho_find_best_symbol(&reader, slide_pc, reader.symtab_local, reader.nsyms_local, &found_symbol, &found_symbol, &did_find_symbol);
@@ -878,6 +1993,15 @@ plcrash_error_t plcrash_async_macho_find_symbol_by_pc (plcrash_async_macho_t *im
         plcrash_async_macho_find_best_symbol(&reader, slide_pc, reader.symtab, reader.nsyms, &found_symbol, NULL, &did_find_symbol);
     }
 
+    /* If function boundaries are available, reject any symbol preceding the start of the function containing the
+     * PC; the function has no symbol table entry (eg, in a stripped binary), and the symbol belongs to an earlier
+     * function. */
+    pl_vm_address_t function_start;
+    if (did_find_symbol && plcrash_async_macho_find_function_start(image, pc, &function_start)) {
+        if (found_symbol.n_value + image->vmaddr_slide < function_start)
+            did_find_symbol = false;
+    }
+
     /* No symbol found. */
     if (!did_find_symbol) {
         retval = PLCRASH_ENOTFOUND;
@@ -918,10 +2042,42 @@ void plcrash_async_macho_mapped_segment_free (pl_async_macho_mapped_segment_t *s
  * @warning This method is not async safe.
  */
 void plcrash_nasync_macho_free (plcrash_async_macho_t *image) {
-    if (image->name != NULL)
+    if (image->name != NULL && !image->name_borrowed)
         free(image->name);
     
-    plcrash_async_mobject_free(&image->load_cmds);
+    if (image->load_cmds_state == PLCRASH_ASYNC_MACHO_LOAD_CMDS_MAPPED)
+        plcrash_async_mobject_free(&image->load_cmds);
+
+    /* Free any cached section mappings */
+    for (size_t i = 0; i < PLCRASH_ASYNC_MACHO_SECTION_CACHE_SIZE; i++) {
+        if (image->section_cache[i].state == PLCRASH_ASYNC_MACHO_SECTION_MAPPED)
+            plcrash_async_mobject_free(&image->section_cache[i].mobj);
+    }
+
+    for (size_t i = 0; i < PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT; i++) {
+        if (image->known_section_cache[i].state == PLCRASH_ASYNC_MACHO_SECTION_MAPPED)
+            plcrash_async_mobject_free(&image->known_section_cache[i].mobj);
+    }
+
+    /* Free the symbol index */
+    if (image->symbol_index != NULL)
+        plcrash_async_allocator_free(image->symbol_index->allocator);
+
+    /* Free the function start table */
+    if (image->function_starts != NULL)
+        plcrash_async_allocator_free(image->function_starts->allocator);
+
+    /* Free the Objective-C IMP index */
+    if (image->objc_index != NULL)
+        plcrash_async_allocator_free(image->objc_index->allocator);
+
+    /* Free the FDE index */
+    if (image->fde_index != NULL)
+        plcrash_async_allocator_free(image->fde_index->allocator);
+
+    /* Free the CFE index */
+    if (image->cfe_index != NULL)
+        plcrash_async_allocator_free(image->cfe_index->allocator);
 
     mach_port_mod_refs(mach_task_self(), image->task, MACH_PORT_RIGHT_SEND, -1);
 }
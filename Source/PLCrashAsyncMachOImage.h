@@ -38,6 +38,8 @@ extern "C" {
 #include <mach-o/loader.h>
 #include <mach-o/nlist.h>
 
+#include "PLCrashAsyncAllocator.h"
+
 #include "PLCrashAsyncMObject.h"
 
 /**
@@ -46,6 +48,236 @@ extern "C" {
  * @{
  */
 
+/** Maximum number of mapped sections that will be cached by a plcrash_async_macho_t instance. */
+#define PLCRASH_ASYNC_MACHO_SECTION_CACHE_SIZE 8
+
+/**
+ * @internal
+ *
+ * Section cache entry states.
+ */
+typedef enum {
+    /** The entry is unused. */
+    PLCRASH_ASYNC_MACHO_SECTION_EMPTY = 0,
+
+    /** The entry is being populated, and may not yet be read. */
+    PLCRASH_ASYNC_MACHO_SECTION_BUSY = 1,
+
+    /** The entry contains a valid section mapping. */
+    PLCRASH_ASYNC_MACHO_SECTION_MAPPED = 2,
+
+    /** The section was not found in the image. */
+    PLCRASH_ASYNC_MACHO_SECTION_NOTFOUND = 3
+} plcrash_async_macho_section_state_t;
+
+/**
+ * @internal
+ *
+ * Load command mapping states. See plcrash_nasync_macho_compact().
+ */
+typedef enum {
+    /** The load commands are mapped. */
+    PLCRASH_ASYNC_MACHO_LOAD_CMDS_MAPPED = 0,
+
+    /** The load commands have been released, and will be re-mapped on first use. */
+    PLCRASH_ASYNC_MACHO_LOAD_CMDS_UNMAPPED = 1,
+
+    /** The load commands are being mapped, and may not yet be read. */
+    PLCRASH_ASYNC_MACHO_LOAD_CMDS_BUSY = 2
+} plcrash_async_macho_load_cmds_state_t;
+
+/**
+ * @internal
+ *
+ * A cached section mapping.
+ */
+typedef struct plcrash_async_macho_section_cache_entry {
+    /** The entry state (a plcrash_async_macho_section_state_t value). Must be updated atomically. */
+    volatile int32_t state;
+
+    /** The section's segment name. */
+    char segname[16];
+
+    /** The section name. */
+    char sectname[16];
+
+    /** The mapped section. Only valid if @a state is PLCRASH_ASYNC_MACHO_SECTION_MAPPED. */
+    plcrash_async_mobject_t mobj;
+} plcrash_async_macho_section_cache_entry_t;
+
+/**
+ * @internal
+ *
+ * Well-known sections. The location of each is resolved once, when the image is initialized, allowing these sections
+ * to be found without walking the image's load commands. See plcrash_async_macho_map_known_section().
+ */
+typedef enum {
+    /** The __TEXT,__unwind_info compact unwind section. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO = 0,
+
+    /** The __TEXT,__eh_frame DWARF unwind section. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_EH_FRAME = 1,
+
+    /** The __TEXT,__eh_frame_hdr DWARF unwind search table. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_EH_FRAME_HDR = 2,
+
+    /** The __DWARF,__debug_frame DWARF unwind section. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_DEBUG_FRAME = 3,
+
+    /** The __DATA,__objc_classlist ObjC2 class list. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_CLASSLIST = 4,
+
+    /** The __DATA,__objc_const ObjC2 constant data. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_CONST = 5,
+
+    /** The __DATA,__objc_data ObjC2 class data. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_DATA = 6,
+
+    /** The __OBJC,__module_info ObjC1 module list. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_MODULE_INFO = 7,
+
+    /** The __DATA,__objc_selrefs ObjC2 selector references. */
+    PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_SELREFS = 8,
+} plcrash_async_macho_known_section_t;
+
+/** The number of defined plcrash_async_macho_known_section_t values. */
+#define PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT 9
+
+/**
+ * @internal
+ *
+ * The resolved location of a well-known section.
+ */
+typedef struct plcrash_async_macho_known_section_info {
+    /** If true, the section was found in the image. */
+    bool found;
+
+    /** The section's unslid address, as defined by its section header. Only valid if @a found is true. */
+    pl_vm_address_t addr;
+
+    /** The section's size, in bytes. Only valid if @a found is true. */
+    pl_vm_size_t size;
+} plcrash_async_macho_known_section_info_t;
+
+/* Forward declaration; see PLCrashAsyncObjCSection.h */
+struct plcrash_async_objc_imp_index;
+
+/**
+ * @internal
+ *
+ * A symbol index entry, as returned by plcrash_nasync_macho_build_symbol_index(). The values are in host byte order.
+ */
+typedef struct plcrash_async_macho_symbol_index_entry {
+    /** The symbol's unslid address. */
+    pl_vm_address_t n_value;
+
+    /** Index into the string table. */
+    uint32_t n_strx;
+
+    /** Description (see <mach-o/stab.h>). */
+    uint16_t n_desc;
+} plcrash_async_macho_symbol_index_entry_t;
+
+/**
+ * @internal
+ *
+ * A decoded LC_FUNCTION_STARTS table, as built by plcrash_nasync_macho_build_function_starts().
+ */
+typedef struct plcrash_async_macho_function_starts {
+    /** The allocator backing this table (including this structure). */
+    plcrash_async_allocator_t *allocator;
+
+    /** The number of entries in @a offsets. */
+    uint32_t count;
+
+    /** Function start offsets, relative to the image's unslid __TEXT vmaddr, sorted by address. The array is
+     * allocated with space for all entries. */
+    uint32_t offsets[1];
+} plcrash_async_macho_function_starts_t;
+
+/**
+ * @internal
+ *
+ * An address-sorted index of an image's symbol table, used to avoid a linear symbol table search
+ * at crash time.
+ */
+typedef struct plcrash_async_macho_symbol_index {
+    /** The allocator backing this index (including this structure). */
+    plcrash_async_allocator_t *allocator;
+
+    /** The number of entries in @a entries. */
+    uint32_t count;
+
+    /** Index entries, sorted by address. Each address is unique. The array is allocated with
+     * space for all entries. */
+    plcrash_async_macho_symbol_index_entry_t entries[1];
+} plcrash_async_macho_symbol_index_t;
+
+/**
+ * @internal
+ *
+ * A FDE index entry, as built by plcrash_nasync_dwarf_build_fde_index(). All values are in host byte order.
+ */
+typedef struct plcrash_async_macho_fde_index_entry {
+    /** The address of the first instruction covered by the FDE, relative to the image's header address. */
+    uint32_t pc_offset;
+
+    /** The number of bytes of instructions covered by the FDE. */
+    uint32_t pc_length;
+
+    /** The offset of the FDE within the image's __eh_frame section. */
+    uint32_t fde_offset;
+} plcrash_async_macho_fde_index_entry_t;
+
+/**
+ * @internal
+ *
+ * A PC-sorted index of the FDEs within an image's __eh_frame section, used to avoid a linear walk of the
+ * section at crash time.
+ */
+typedef struct plcrash_async_macho_fde_index {
+    /** The allocator backing this index (including this structure). */
+    plcrash_async_allocator_t *allocator;
+
+    /** The number of entries in @a entries. */
+    uint32_t count;
+
+    /** Index entries, sorted by @a pc_offset. Each offset is unique. The array is allocated with space for
+     * all entries. */
+    plcrash_async_macho_fde_index_entry_t entries[1];
+} plcrash_async_macho_fde_index_t;
+
+/**
+ * @internal
+ *
+ * A compact unwind first-level index entry, as built by plcrash_nasync_cfe_build_index(). All values are in host
+ * byte order.
+ */
+typedef struct plcrash_async_macho_cfe_index_entry {
+    /** The first function offset covered by the second-level page, relative to the image's header address. */
+    uint32_t function_offset;
+
+    /** The offset of the second-level page within the image's __unwind_info section. */
+    uint32_t page_offset;
+} plcrash_async_macho_cfe_index_entry_t;
+
+/**
+ * @internal
+ *
+ * A validated, host byte order copy of an image's __unwind_info first-level index, used to locate second-level
+ * pages at crash time without mapping or re-validating the target's index.
+ */
+typedef struct plcrash_async_macho_cfe_index {
+    /** The allocator backing this index (including this structure). */
+    plcrash_async_allocator_t *allocator;
+
+    /** The number of entries in @a entries, excluding the trailing sentinel entry emitted by the linker. */
+    uint32_t count;
+
+    /** Index entries, sorted by @a function_offset. The array is allocated with space for all entries. */
+    plcrash_async_macho_cfe_index_entry_t entries[1];
+} plcrash_async_macho_cfe_index_t;
+
 /**
  * @internal
  *
@@ -64,6 +296,10 @@ typedef struct plcrash_async_macho {
     /** The binary image's name/path. */
     char *name;
 
+    /** If true, @a name is borrowed from storage that outlives the image, and will not be freed with the image. See
+     * plcrash_nasync_macho_borrow_name(). */
+    bool name_borrowed;
+
     /** The Mach-O header. For our purposes, the 32-bit and 64-bit headers are identical. Note that the header
      * values may require byte-swapping for the local process' use. */
     struct mach_header header;
@@ -75,20 +311,94 @@ typedef struct plcrash_async_macho {
     /** Number of load commands */
     uint32_t ncmds;
 
-    /** Mapped Mach-O load commands */
+    /** Mapped Mach-O load commands. Only valid if @a load_cmds_state is PLCRASH_ASYNC_MACHO_LOAD_CMDS_MAPPED. */
     plcrash_async_mobject_t load_cmds;
 
+    /** The load command mapping state (a plcrash_async_macho_load_cmds_state_t value). Must be updated atomically. */
+    volatile int32_t load_cmds_state;
+
     /** The Mach-O image's __TEXT segment, as defined by the LC_SEGMENT/LC_SEGMENT_64 load command. */
     pl_vm_address_t text_vmaddr;
 
     /** Total size, in bytes, of the Mach-O image's __TEXT segment, as defined by the LC_SEGMENT/LC_SEGMENT_64 load command. */
     pl_vm_size_t text_size;
 
+    /** If true, @a uuid contains the image's LC_UUID value. */
+    bool has_uuid;
+
+    /** The image's 128-bit LC_UUID value. Only valid if @a has_uuid is true. */
+    uint8_t uuid[16];
+
+    /** The image's CPU type, in host byte order. */
+    cpu_type_t cpu_type;
+
+    /** The image's CPU subtype, in host byte order. */
+    cpu_subtype_t cpu_subtype;
+
+    /** The load command from which @a min_version and @a sdk_version were read (LC_BUILD_VERSION, or one of the
+     * LC_VERSION_MIN_* commands), or 0 if the image has no version load command. */
+    uint32_t version_cmd;
+
+    /** The image's PLATFORM_* value, if read from LC_BUILD_VERSION, or 0. */
+    uint32_t platform;
+
+    /** The minimum supported OS version, encoded as X.Y.Z in nibbles xxxx.yy.zz. Only valid if @a version_cmd is non-zero. */
+    uint32_t min_version;
+
+    /** The SDK version, encoded as X.Y.Z in nibbles xxxx.yy.zz. Only valid if @a version_cmd is non-zero. */
+    uint32_t sdk_version;
+
     /** If true, the image is 64-bit Mach-O. If false, it is a 32-bit Mach-O image. */
     bool m64;
 
     /** The byte order functions to use for this image */
     const plcrash_async_byteorder_t *byteorder;
+
+    /** Lazily populated section mappings, as returned by plcrash_async_macho_map_section_cached(). */
+    plcrash_async_macho_section_cache_entry_t section_cache[PLCRASH_ASYNC_MACHO_SECTION_CACHE_SIZE];
+
+    /** The locations of the well-known sections, indexed by plcrash_async_macho_known_section_t. Immutable once the
+     * image has been initialized. */
+    plcrash_async_macho_known_section_info_t known_sections[PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT];
+
+    /** Lazily populated mappings of the well-known sections, indexed by plcrash_async_macho_known_section_t, as
+     * returned by plcrash_async_macho_map_known_section_cached(). The entries' names are unused. */
+    plcrash_async_macho_section_cache_entry_t known_section_cache[PLCRASH_ASYNC_MACHO_KNOWN_SECT_COUNT];
+
+    /** The symbol index, or NULL if no index has been built. If set, the index is immutable and will remain valid
+     * for the lifetime of the image. */
+    plcrash_async_macho_symbol_index_t * volatile symbol_index;
+
+    /** The decoded LC_FUNCTION_STARTS table, or NULL if no table has been built. If set, the table is immutable and
+     * will remain valid for the lifetime of the image. */
+    plcrash_async_macho_function_starts_t * volatile function_starts;
+
+    /** The Objective-C IMP index, or NULL if no index has been built. If set, the index is immutable and will
+     * remain valid for the lifetime of the image. See plcrash_nasync_objc_build_imp_index(). */
+    struct plcrash_async_objc_imp_index * volatile objc_index;
+
+    /** If true, @a objc_imp_min and @a objc_imp_max have been populated. See plcrash_async_objc_imp_range(). */
+    volatile bool objc_imp_range_valid;
+
+    /** The lowest Objective-C method IMP found within the image. If the image contains no methods, this will be
+     * greater than @a objc_imp_max. Only valid if @a objc_imp_range_valid is true. */
+    pl_vm_address_t objc_imp_min;
+
+    /** The highest Objective-C method IMP found within the image. Only valid if @a objc_imp_range_valid is true. */
+    pl_vm_address_t objc_imp_max;
+
+    /** The address of the dyld shared cache's relative method selector base, against which the direct selector
+     * offsets of the image's relative method lists are resolved, or 0 if unavailable. See
+     * plcrash_nasync_objc_shared_cache_init(). */
+    pl_vm_address_t objc_selector_base;
+
+    /** The __eh_frame FDE index, or NULL if no index has been built. If set, the index is immutable and will remain
+     * valid for the lifetime of the image. See plcrash_nasync_dwarf_build_fde_index(). */
+    plcrash_async_macho_fde_index_t * volatile fde_index;
+
+    /** The __unwind_info first-level index, or NULL if no index has been built. If set, the index is immutable and
+     * will remain valid for the lifetime of the image. See plcrash_nasync_cfe_build_index(). */
+    plcrash_async_macho_cfe_index_t * volatile cfe_index;
 } plcrash_async_macho_t;
 
 /**
@@ -187,6 +497,12 @@ typedef struct plcrash_async_macho_symtab_reader {
 typedef void (*pl_async_macho_found_symbol_cb)(pl_vm_address_t address, const char *name, void *ctx);
 
 plcrash_error_t plcrash_nasync_macho_init (plcrash_async_macho_t *image, mach_port_t task, const char *name, pl_vm_address_t header);
+plcrash_error_t plcrash_nasync_macho_init_shared (plcrash_async_macho_t *image, mach_port_t task, const char *name, pl_vm_address_t header, plcrash_async_mobject_t *shared_mapping);
+void plcrash_nasync_macho_borrow_name (plcrash_async_macho_t *image, char *name);
+void plcrash_nasync_macho_compact (plcrash_async_macho_t *image);
+plcrash_error_t plcrash_nasync_macho_build_symbol_index (plcrash_async_macho_t *image);
+plcrash_error_t plcrash_nasync_macho_build_function_starts (plcrash_async_macho_t *image);
+bool plcrash_async_macho_find_function_start (plcrash_async_macho_t *image, pl_vm_address_t pc, pl_vm_address_t *function_start);
 
 const plcrash_async_byteorder_t *plcrash_async_macho_byteorder (plcrash_async_macho_t *image);
 const struct mach_header *plcrash_async_macho_header (plcrash_async_macho_t *image);
@@ -202,9 +518,15 @@ void *plcrash_async_macho_find_segment_cmd (plcrash_async_macho_t *image, const
 
 plcrash_error_t plcrash_async_macho_map_segment (plcrash_async_macho_t *image, const char *segname, pl_async_macho_mapped_segment_t *seg);
 plcrash_error_t plcrash_async_macho_map_section (plcrash_async_macho_t *image, const char *segname, const char *sectname, plcrash_async_mobject_t *mobj);
+plcrash_error_t plcrash_async_macho_map_section_cached (plcrash_async_macho_t *image, const char *segname, const char *sectname, plcrash_async_mobject_t *storage, plcrash_async_mobject_t **mobj);
+plcrash_error_t plcrash_async_macho_map_known_section (plcrash_async_macho_t *image, plcrash_async_macho_known_section_t section, plcrash_async_mobject_t *mobj);
+plcrash_error_t plcrash_async_macho_map_known_section_persistent (plcrash_async_macho_t *image, plcrash_async_macho_known_section_t section, plcrash_async_mobject_t *mobj);
+plcrash_error_t plcrash_async_macho_map_known_section_cached (plcrash_async_macho_t *image, plcrash_async_macho_known_section_t section, plcrash_async_mobject_t *storage, plcrash_async_mobject_t **mobj);
+void plcrash_async_macho_mapped_section_release (plcrash_async_mobject_t *storage, plcrash_async_mobject_t *mobj);
 
 plcrash_error_t plcrash_async_macho_find_symbol_by_pc (plcrash_async_macho_t *image, pl_vm_address_t pc, pl_async_macho_found_symbol_cb symbol_cb, void *context);
 plcrash_error_t plcrash_async_macho_find_symbol_by_name (plcrash_async_macho_t *image, const char *symbol, pl_vm_address_t *pc);
+plcrash_error_t plcrash_async_macho_find_export (plcrash_async_macho_t *image, const char *symbol, pl_vm_address_t *address);
 
 plcrash_error_t plcrash_async_macho_symtab_reader_init (plcrash_async_macho_symtab_reader_t *reader, plcrash_async_macho_t *image);
 plcrash_async_macho_symtab_entry_t plcrash_async_macho_symtab_reader_read (plcrash_async_macho_symtab_reader_t *reader, void *symtab, uint32_t index);
@@ -193,6 +193,48 @@
     STAssertNULL(cmd, @"Should not have found the requested load command");
 }
 
+/**
+ * Test the load command values cached by plcrash_nasync_macho_init().
+ */
+- (void) testCachedLoadCommands {
+    struct uuid_command *uuid = plcrash_async_macho_find_command(&_image, LC_UUID);
+    STAssertNotNULL(uuid, @"Failed to find LC_UUID");
+    STAssertTrue(_image.has_uuid, @"UUID was not cached");
+    STAssertTrue(memcmp(uuid->uuid, _image.uuid, sizeof(_image.uuid)) == 0, @"Incorrect cached UUID");
+
+    STAssertEquals(plcrash_async_macho_cpu_type(&_image), _image.cpu_type, @"Incorrect cached CPU type");
+    STAssertEquals(plcrash_async_macho_cpu_subtype(&_image), _image.cpu_subtype, @"Incorrect cached CPU subtype");
+
+    /* All supported deployment targets emit a version load command */
+    STAssertTrue(_image.version_cmd != 0, @"No version load command was cached");
+    STAssertTrue(_image.min_version != 0, @"Incorrect cached minimum OS version");
+}
+
+/**
+ * Test that load commands and sections released by plcrash_nasync_macho_compact() are re-mapped on demand.
+ */
+- (void) testCompact {
+    plcrash_async_mobject_t storage;
+    plcrash_async_mobject_t *mobj;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_map_known_section_cached(&_image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO, &storage, &mobj), @"Failed to map section");
+    plcrash_async_macho_mapped_section_release(&storage, mobj);
+
+    plcrash_nasync_macho_compact(&_image);
+    STAssertEquals(_image.load_cmds_state, (int32_t) PLCRASH_ASYNC_MACHO_LOAD_CMDS_UNMAPPED, @"Load commands were not released");
+    STAssertEquals(_image.known_section_cache[PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO].state, (int32_t) PLCRASH_ASYNC_MACHO_SECTION_EMPTY, @"Section mapping was not released");
+    STAssertTrue(_image.has_uuid, @"Cached values should be retained");
+
+    struct uuid_command *uuid = plcrash_async_macho_find_command(&_image, LC_UUID);
+    STAssertNotNULL(uuid, @"Failed to find LC_UUID");
+    STAssertEquals(_image.load_cmds_state, (int32_t) PLCRASH_ASYNC_MACHO_LOAD_CMDS_MAPPED, @"Load commands were not re-mapped");
+    STAssertTrue(memcmp(uuid->uuid, _image.uuid, sizeof(_image.uuid)) == 0, @"Incorrect UUID");
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_map_known_section_cached(&_image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO, &storage, &mobj), @"Failed to re-map section");
+    STAssertNotEquals(mobj, &storage, @"Mapping should have been cached by the image");
+    plcrash_async_macho_mapped_section_release(&storage, mobj);
+}
+
 /**
  * Test memory mapping of a Mach-O segment
  */
@@ -273,6 +315,68 @@
     STAssertEquals(PLCRASH_ENOTFOUND, plcrash_async_macho_map_section(&_image, "__DATA", "__NO_SUCH_SECT", &mobj), @"Should have failed to map the section");
 }
 
+/**
+ * Test cached memory mapping of a Mach-O section
+ */
+- (void) testMapSectionCached {
+    plcrash_async_mobject_t storage;
+    plcrash_async_mobject_t *mobj;
+    plcrash_async_mobject_t *cached;
+
+    /* Map the section */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_map_section_cached(&_image, "__DATA", "__const", &storage, &mobj), @"Failed to map section");
+    STAssertNotEquals(mobj, &storage, @"Mapping should have been cached by the image");
+
+    /* Verify the mapping against the section data */
+    unsigned long sectsize = 0;
+    uint8_t *data = getsectiondata((void *)_image.header_addr, "__DATA", "__const", &sectsize);
+    STAssertNotNULL(data, @"Could not fetch section data");
+    STAssertEquals((pl_vm_address_t)data, (pl_vm_address_t) (mobj->address + mobj->vm_slide), @"Addresses do not match");
+    STAssertEquals((pl_vm_size_t)sectsize, mobj->length, @"Sizes do not match");
+
+    /* A second request should return the same cached mapping */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_map_section_cached(&_image, "__DATA", "__const", &storage, &cached), @"Failed to map section");
+    STAssertEquals(mobj, cached, @"Did not return the cached mapping");
+
+    plcrash_async_macho_mapped_section_release(&storage, cached);
+    plcrash_async_macho_mapped_section_release(&storage, mobj);
+
+    /* Missing sections should consistently return ENOTFOUND */
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_async_macho_map_section_cached(&_image, "__DATA", "__NO_SUCH_SECT", &storage, &mobj), @"Should have failed to map the section");
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_async_macho_map_section_cached(&_image, "__DATA", "__NO_SUCH_SECT", &storage, &mobj), @"Should have failed to map the section");
+}
+
+
+/**
+ * Test mapping of a well-known Mach-O section via the image's precomputed section table.
+ */
+- (void) testMapKnownSection {
+    plcrash_async_mobject_t storage;
+    plcrash_async_mobject_t *mobj;
+    plcrash_async_mobject_t *cached;
+
+    unsigned long sectsize = 0;
+    uint8_t *data = getsectiondata((void *)_image.header_addr, "__TEXT", "__unwind_info", &sectsize);
+    STAssertNotNULL(data, @"Could not fetch section data");
+
+    /* Map the section, and verify the mapping against the section data */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_map_known_section_cached(&_image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO, &storage, &mobj), @"Failed to map section");
+    STAssertNotEquals(mobj, &storage, @"Mapping should have been cached by the image");
+    STAssertEquals((pl_vm_address_t)data, (pl_vm_address_t) (mobj->address + mobj->vm_slide), @"Addresses do not match");
+    STAssertEquals((pl_vm_size_t)sectsize, mobj->length, @"Sizes do not match");
+
+    /* Name-based requests should be routed to the same cached mapping */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_map_section_cached(&_image, "__TEXT", "__unwind_info", &storage, &cached), @"Failed to map section");
+    STAssertEquals(mobj, cached, @"Did not return the cached mapping");
+
+    plcrash_async_macho_mapped_section_release(&storage, cached);
+    plcrash_async_macho_mapped_section_release(&storage, mobj);
+
+    /* Sections absent from the image should not be found */
+    if (getsectiondata((void *)_image.header_addr, SEG_OBJC, "__module_info", &sectsize) == NULL) {
+        STAssertEquals(PLCRASH_ENOTFOUND, plcrash_async_macho_map_known_section(&_image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_MODULE_INFO, &storage), @"Should have failed to map the section");
+    }
+}
 
 /**
  * Test memory mapping of a missing Mach-O segment
@@ -397,6 +501,78 @@ static void testFindSymbol_cb (pl_vm_address_t address, const char *name, void *
     STAssertEquals(dli.dli_saddr, (void *) ctx.addr, @"Returned incorrect symbol address with slide %" PRId64, (int64_t) _image.vmaddr_slide);
 }
 
+/**
+ * Test symbol lookup using the symbol index.
+ */
+- (void) testFindSymbolIndexed {
+    /* Fetch our current PC, to be used for symbol lookup */
+    void *callstack[1];
+    int frames = backtrace(callstack, 1);
+    STAssertEquals(1, frames, @"Could not fetch our PC");
+
+    /* Perform a linear lookup for comparison */
+    struct testFindSymbol_cb_ctx linear_ctx;
+    plcrash_error_t res = plcrash_async_macho_find_symbol_by_pc(&_image, (pl_vm_address_t) callstack[0], testFindSymbol_cb, &linear_ctx);
+    STAssertEquals(res, PLCRASH_ESUCCESS, @"Failed to locate symbol");
+    if (res != PLCRASH_ESUCCESS)
+        return;
+
+    /* Build the index */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_macho_build_symbol_index(&_image), @"Failed to build symbol index");
+    STAssertNotNULL(_image.symbol_index, @"No symbol index was published");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_macho_build_symbol_index(&_image), @"Rebuilding the index should be a no-op");
+
+    /* Verify the index ordering */
+    for (uint32_t i = 1; i < _image.symbol_index->count; i++)
+        STAssertTrue(_image.symbol_index->entries[i-1].n_value < _image.symbol_index->entries[i].n_value, @"Index is not sorted");
+
+    /* Perform the indexed lookup */
+    struct testFindSymbol_cb_ctx ctx;
+    res = plcrash_async_macho_find_symbol_by_pc(&_image, (pl_vm_address_t) callstack[0], testFindSymbol_cb, &ctx);
+    STAssertEquals(res, PLCRASH_ESUCCESS, @"Failed to locate symbol");
+    if (res != PLCRASH_ESUCCESS)
+        return;
+
+    /* Compare the results */
+    STAssertEqualCStrings(linear_ctx.name, ctx.name, @"Returned incorrect symbol name");
+    STAssertEquals(linear_ctx.addr, ctx.addr, @"Returned incorrect symbol address");
+
+    free(linear_ctx.name);
+    free(ctx.name);
+}
+
+/**
+ * Test function start lookup via LC_FUNCTION_STARTS.
+ */
+- (void) testFindFunctionStart {
+    IMP localIMP = class_getMethodImplementation([self class], _cmd);
+    pl_vm_address_t imp_addr = ((pl_vm_address_t) localIMP) & ~((pl_vm_address_t) 1);
+
+    /* No table is available until built */
+    pl_vm_address_t start;
+    STAssertFalse(plcrash_async_macho_find_function_start(&_image, imp_addr, &start), @"Function start found without a table");
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_macho_build_function_starts(&_image), @"Failed to build function start table");
+    STAssertNotNULL(_image.function_starts, @"No function start table was published");
+    STAssertTrue(_image.function_starts->count > 0, @"Function start table is empty");
+
+    for (uint32_t i = 1; i < _image.function_starts->count; i++)
+        STAssertTrue(_image.function_starts->offsets[i-1] < _image.function_starts->offsets[i], @"Table is not sorted");
+
+    /* Any PC within our implementation must resolve to the exact start of the function */
+    STAssertTrue(plcrash_async_macho_find_function_start(&_image, imp_addr, &start), @"Function start not found");
+    STAssertEquals(imp_addr, start, @"Incorrect function start");
+
+    STAssertTrue(plcrash_async_macho_find_function_start(&_image, imp_addr + 2, &start), @"Function start not found");
+    STAssertEquals(imp_addr, start, @"Incorrect function start");
+
+    /* Symbol lookups must continue to succeed */
+    struct testFindSymbol_cb_ctx ctx;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_find_symbol_by_pc(&_image, imp_addr + 2, testFindSymbol_cb, &ctx), @"Failed to locate symbol");
+    STAssertEquals((pl_vm_address_t) localIMP, ctx.addr, @"Returned incorrect symbol address");
+    free(ctx.name);
+}
+
 /**
  * Test lookup of symbols by name.
  */
@@ -415,4 +591,22 @@ static void testFindSymbol_cb (pl_vm_address_t address, const char *name, void *
     STAssertEquals((pl_vm_address_t) localIMP, pc, @"Returned incorrect symbol address");
 }
 
+/**
+ * Test lookup of exported symbols via the export trie.
+ */
+- (void) testFindExport {
+    /* Our class is exported from the test image */
+    char symbol[256];
+    snprintf(symbol, sizeof(symbol), "_OBJC_CLASS_$_%s", class_getName([self class]));
+
+    pl_vm_address_t addr;
+    plcrash_error_t res = plcrash_async_macho_find_export(&_image, symbol, &addr);
+    STAssertEquals(res, PLCRASH_ESUCCESS, @"Failed to locate exported symbol %s", symbol);
+    STAssertEquals((pl_vm_address_t) [self class], addr, @"Returned incorrect symbol address");
+
+    /* Prefixes of exported symbols, and unknown symbols, must not be found */
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_async_macho_find_export(&_image, "_OBJC_CLASS_$_", &addr), @"Found a non-terminal node");
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_async_macho_find_export(&_image, "_plcrash_no_such_symbol", &addr), @"Found an unknown symbol");
+}
+
 @end
@@ -59,8 +59,6 @@ static plcrash_error_t plcrash_async_macho_string_read (plcrash_async_macho_stri
     if (string->mobjIsInitialized)
         return PLCRASH_ESUCCESS;
     
-    pl_vm_address_t cursor = string->address;
-
     /* Map in the page containing the string, +1 up to one additional page. Short reads are permitted, as the next page
      * may not be readable. */
     size_t page_count = 1;
@@ -68,31 +66,39 @@ static plcrash_error_t plcrash_async_macho_string_read (plcrash_async_macho_stri
     if (err != PLCRASH_ESUCCESS)
         return err;
 
-    char c;
-    do {
-        char *p = plcrash_async_mobject_remap_address(&string->mobj, cursor, 0, 1);
+    while (true) {
+        /* Validate the mapped range once, and then scan it for the terminating NUL a word at a time */
+        const char *p = plcrash_async_mobject_remap_address(&string->mobj, string->address, 0, 1);
         if (p == NULL) {
-            /* This should pretty much never happen */
-            PLCF_DEBUG("Mapped a string larger than one page! Remapping ...");
-            page_count++;
+            PLCF_DEBUG("Failed to remap the string's address");
             plcrash_async_mobject_free(&string->mobj);
-            err = plcrash_async_mobject_init(&string->mobj, string->image->task, string->address, page_count*PAGE_SIZE, false);
-            if (err != PLCRASH_ESUCCESS)
-                return err;
-            
-            p = plcrash_async_mobject_remap_address(&string->mobj, cursor, 0, 1);
-            if (p == NULL) {
-                PLCF_DEBUG("Failed to remap additional space ...");
-                return PLCRASH_EINVAL;
-            }
+            return PLCRASH_EINVAL;
+        }
+
+        size_t avail = (size_t) ((string->mobj.address + string->mobj.length) - (uintptr_t) p);
+        size_t length = plcrash_async_strnlen(p, avail);
+        if (length < avail) {
+            string->length = length;
+            break;
         }
 
-        c = *p;
-        cursor++;
-    } while(c != '\0');
+        /* No NUL was found within the mapping. This should pretty much never happen */
+        PLCF_DEBUG("Mapped a string larger than one page! Remapping ...");
+        pl_vm_size_t previous_length = string->mobj.length;
+        page_count++;
+        plcrash_async_mobject_free(&string->mobj);
+        err = plcrash_async_mobject_init(&string->mobj, string->image->task, string->address, page_count*PAGE_SIZE, false);
+        if (err != PLCRASH_ESUCCESS)
+            return err;
+
+        /* A short mapping that could not be extended will never contain the NUL */
+        if (string->mobj.length <= previous_length) {
+            PLCF_DEBUG("Failed to remap additional space ...");
+            plcrash_async_mobject_free(&string->mobj);
+            return PLCRASH_EINVAL;
+        }
+    }
 
-    /* Compute the length of the string data and make a new memory object. */
-    string->length = cursor - string->address - 1;
     string->mobjIsInitialized = true;
     return PLCRASH_ESUCCESS;
 }
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncMetrics.h"
+
+#include <libkern/OSAtomic.h>
+#include <mach/mach_time.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_async_metrics
+ * @{
+ */
+
+/** The number of outstanding plcrash_nasync_metrics_enable() calls. */
+static volatile int32_t metrics_enable_count = 0;
+
+/** The timebase used to convert timing metrics to nanoseconds; fetched by plcrash_nasync_metrics_enable(). */
+static mach_timebase_info_data_t metrics_timebase = { 0, 0 };
+
+/** Process-wide metric values. */
+static volatile int64_t metrics_values[PLCRASH_ASYNC_METRIC_COUNT];
+
+/**
+ * Enable metric recording. Each call must be balanced by a call to plcrash_nasync_metrics_disable().
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_metrics_enable (void) {
+    if (metrics_timebase.denom == 0)
+        mach_timebase_info(&metrics_timebase);
+
+    OSAtomicIncrement32Barrier(&metrics_enable_count);
+}
+
+/**
+ * Balance a previous call to plcrash_nasync_metrics_enable(). Metric recording is disabled once all
+ * callers have disabled recording.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_metrics_disable (void) {
+    OSAtomicDecrement32Barrier(&metrics_enable_count);
+}
+
+/**
+ * Return true if metric recording is enabled.
+ */
+bool plcrash_async_metrics_enabled (void) {
+    return metrics_enable_count > 0;
+}
+
+/**
+ * Add @a value to @a metric, if recording is enabled.
+ *
+ * @param metric The metric to be updated.
+ * @param value The value to be added.
+ */
+void plcrash_async_metrics_add (plcrash_async_metric_t metric, uint64_t value) {
+    if (metrics_enable_count <= 0)
+        return;
+
+    OSAtomicAdd64((int64_t) value, &metrics_values[metric]);
+}
+
+/**
+ * Begin timing an operation. The returned value must be passed to plcrash_async_metrics_time_end().
+ *
+ * @return Returns the current mach_absolute_time(), or 0 if recording is disabled.
+ */
+uint64_t plcrash_async_metrics_time_begin (void) {
+    if (metrics_enable_count <= 0)
+        return 0;
+
+    return mach_absolute_time();
+}
+
+/**
+ * Add the time elapsed since @a start to @a metric.
+ *
+ * @param metric The timing metric to be updated.
+ * @param start The value returned by plcrash_async_metrics_time_begin(). If 0, no time will be recorded.
+ */
+void plcrash_async_metrics_time_end (plcrash_async_metric_t metric, uint64_t start) {
+    if (start == 0)
+        return;
+
+    plcrash_async_metrics_add(metric, mach_absolute_time() - start);
+}
+
+/**
+ * Copy the current value of all metrics to @a metrics.
+ *
+ * @param metrics The snapshot to be populated.
+ */
+void plcrash_async_metrics_snapshot (plcrash_async_metrics_t *metrics) {
+    for (int i = 0; i < PLCRASH_ASYNC_METRIC_COUNT; i++)
+        metrics->values[i] = (uint64_t) OSAtomicAdd64Barrier(0, &metrics_values[i]);
+}
+
+/**
+ * Convert a mach_absolute_time() interval to nanoseconds. If recording has never been enabled, the
+ * interval will be returned unmodified.
+ *
+ * @param abs_time The interval to be converted.
+ */
+uint64_t plcrash_async_metrics_to_ns (uint64_t abs_time) {
+    if (metrics_timebase.denom == 0)
+        return abs_time;
+
+    return abs_time * metrics_timebase.numer / metrics_timebase.denom;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_METRICS_H
+#define PLCRASH_ASYNC_METRICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @internal
+ * @defgroup plcrash_async_metrics Async-safe Instrumentation Counters
+ * @ingroup plcrash_async
+ *
+ * Process-wide, async-safe timing and event counters used to instrument crash report generation. Counting is
+ * disabled by default; while disabled, recording a metric costs a single load and branch.
+ *
+ * Counters are only ever incremented. A writer measures the cost of a single report by taking a snapshot via
+ * plcrash_async_metrics_snapshot() before and after writing, and recording the difference. Reports that are
+ * written concurrently will include each other's events.
+ *
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * Instrumentation metrics. Timing metrics are recorded in mach_absolute_time() units.
+ */
+typedef enum {
+    /** Time spent unwinding thread stacks. */
+    PLCRASH_ASYNC_METRIC_UNWIND_TIME = 0,
+
+    /** Time spent performing symbol table lookups. */
+    PLCRASH_ASYNC_METRIC_SYMTAB_TIME,
+
+    /** Time spent performing Objective-C metadata lookups. */
+    PLCRASH_ASYNC_METRIC_OBJC_TIME,
+
+    /** Time spent writing to the output file descriptor or sink. */
+    PLCRASH_ASYNC_METRIC_OUTPUT_TIME,
+
+    /** The number of writes to the output file descriptor or sink. */
+    PLCRASH_ASYNC_METRIC_OUTPUT_COUNT,
+
+    /** The number of memory objects initialized. */
+    PLCRASH_ASYNC_METRIC_MOBJECT_COUNT,
+
+    /** The number of vm_read_overwrite() calls. */
+    PLCRASH_ASYNC_METRIC_VM_READ_COUNT,
+
+    /** The number of bytes requested via vm_read_overwrite(). */
+    PLCRASH_ASYNC_METRIC_VM_READ_BYTES,
+
+    /** The number of plcrash_async_file_flush() calls. */
+    PLCRASH_ASYNC_METRIC_FLUSH_COUNT,
+
+    /** The number of successful plcrash_async_allocator_alloc() calls. */
+    PLCRASH_ASYNC_METRIC_ALLOC_COUNT,
+
+    /** The number of bytes allocated via plcrash_async_allocator_alloc(), after rounding to the allocation's size class. */
+    PLCRASH_ASYNC_METRIC_ALLOC_BYTES,
+
+    /** The number of defined metrics. */
+    PLCRASH_ASYNC_METRIC_COUNT
+} plcrash_async_metric_t;
+
+/**
+ * @internal
+ *
+ * A snapshot of all metric values.
+ */
+typedef struct plcrash_async_metrics {
+    /** Metric values, indexed by plcrash_async_metric_t. */
+    uint64_t values[PLCRASH_ASYNC_METRIC_COUNT];
+} plcrash_async_metrics_t;
+
+void plcrash_nasync_metrics_enable (void);
+void plcrash_nasync_metrics_disable (void);
+bool plcrash_async_metrics_enabled (void);
+
+void plcrash_async_metrics_add (plcrash_async_metric_t metric, uint64_t value);
+uint64_t plcrash_async_metrics_time_begin (void);
+void plcrash_async_metrics_time_end (plcrash_async_metric_t metric, uint64_t start);
+
+void plcrash_async_metrics_snapshot (plcrash_async_metrics_t *metrics);
+uint64_t plcrash_async_metrics_to_ns (uint64_t abs_time);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_METRICS_H */
@@ -28,6 +28,11 @@
 
 #include "PLCrashAsyncObjCSection.h"
 #include <mach/mach_time.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include <string.h>
+#include <libkern/OSAtomic.h>
 
 /**
  * @internal
@@ -65,6 +70,27 @@ static const uint32_t RW_REALIZED = (1<<31);
  */
 static const uint32_t RW_COPIED_RO = (1<<27);
 
+/**
+ * Method list entsizeAndFlags bits that are not part of the entry size.
+ */
+static const uint32_t METHOD_LIST_FLAGS_MASK = 0xffff0003;
+
+/**
+ * Method list flag: the list uses the relative (pl_objc2_method_relative) entry layout.
+ */
+static const uint32_t METHOD_LIST_IS_RELATIVE = 0x80000000;
+
+/**
+ * Method list flag: the relative name offsets are relative to the shared cache's selector base, rather than
+ * referencing a selector reference.
+ */
+static const uint32_t METHOD_LIST_DIRECT_SELECTORS = 0x40000000;
+
+/**
+ * The minimum size of the class cache, in entries. Must be a power of two.
+ */
+static const size_t kClassCacheMinimumSize = 1024;
+
 struct pl_objc1_module {
     uint32_t version;
     uint32_t size;
@@ -170,6 +196,14 @@ struct pl_objc2_method_64 {
     uint64_t imp;
 };
 
+/* Each field is a signed offset from the field's own address. The name offset references a selector reference,
+ * which in turn points to the selector's name. */
+struct pl_objc2_method_relative {
+    int32_t name;
+    int32_t types;
+    int32_t imp;
+};
+
 struct pl_objc2_list_header {
     uint32_t entsize;
     uint32_t count;
@@ -177,7 +211,7 @@ struct pl_objc2_list_header {
 
 
 /**
- * Get the index into the context's cache for the given key. Must only be called
+ * Get the initial probe index into the context's cache for the given key. Must only be called
  * if the cache size has been set.
  *
  * @param context The context.
@@ -185,17 +219,18 @@ struct pl_objc2_list_header {
  * @return The index.
  */
 static size_t cache_index (plcrash_async_objc_cache_t *context, pl_vm_address_t key) {
-    return (key >> 2) % context->classCacheSize;
+    /* The cache size is always a power of two */
+    return (key >> 2) & (context->classCacheSize - 1);
 }
 
 /**
- * Get the context's cache's total memory allocation size, including both keys and values.
+ * Get the total memory allocation size for a cache of @a size entries, including both keys and values.
  *
  * @param context The context.
- * @return The total number of bytes allocated for the cache.
+ * @param size The number of cache entries.
+ * @return The total number of bytes required for the cache.
  */
-static size_t cache_allocation_size (plcrash_async_objc_cache_t *context) {
-    size_t size = context->classCacheSize;
+static size_t cache_allocation_size (plcrash_async_objc_cache_t *context, size_t size) {
     return size * sizeof(*context->classCacheKeys) + size * sizeof(*context->classCacheValues);
 }
 
@@ -208,75 +243,149 @@ static size_t cache_allocation_size (plcrash_async_objc_cache_t *context) {
  */
 static pl_vm_address_t cache_lookup (plcrash_async_objc_cache_t *context, pl_vm_address_t key) {
     if (context->classCacheSize > 0) {
+        /* Linear probe until we find the key, or an empty bucket. */
+        size_t mask = context->classCacheSize - 1;
         size_t index = cache_index(context, key);
-        if (context->classCacheKeys[index] == key) {
-            return context->classCacheValues[index];
+        for (size_t i = 0; i < context->classCacheSize; i++) {
+            pl_vm_address_t probe = context->classCacheKeys[(index + i) & mask];
+            if (probe == key) {
+                context->classCacheHits++;
+                return context->classCacheValues[(index + i) & mask];
+            } else if (probe == 0) {
+                break;
+            }
         }
     }
+
+    context->classCacheMisses++;
     return 0;
 }
 
 /**
  * Store a key/value pair in the cache. The cache is not guaranteed storage so storing may
- * silently fail, and the association can be evicted at any time. It's a CACHE.
+ * silently fail if the cache is full or was never allocated. It's a CACHE.
  *
  * @param context The context.
  * @param key The key to store.
  * @param value The value to store.
  */
 static void cache_set (plcrash_async_objc_cache_t *context, pl_vm_address_t key, pl_vm_address_t value) {
-    /* If nothing has used the cache yet, allocate the memory. */
-    if (context->classCacheKeys == NULL) {
-        size_t size = 1024;
-        context->classCacheSize = size;
-        
-        size_t allocationSize = cache_allocation_size(context);
-        
-        vm_address_t addr;
-        kern_return_t err = vm_allocate(mach_task_self_, &addr, allocationSize, VM_FLAGS_ANYWHERE);
-        /* If it fails, just bail out. We don't need the cache for correct operation. */
-        if (err != KERN_SUCCESS) {
-            PLCF_DEBUG("vm_allocate failed with error %x, the class cache could not be initialized and ObjC parsing will be substantially slower", err);
-            context->classCacheSize = 0;
+    if (context->classCacheSize == 0)
+        return;
+
+    /* Don't allow the load factor to exceed 3/4; past that point, probe sequences become unreasonably long. */
+    if (context->classCacheCount >= (context->classCacheSize / 4) * 3)
+        return;
+
+    /* Linear probe for an empty bucket. If the key is already present, the existing entry wins. */
+    size_t mask = context->classCacheSize - 1;
+    size_t index = cache_index(context, key);
+    for (size_t i = 0; i < context->classCacheSize; i++) {
+        size_t bucket = (index + i) & mask;
+        if (context->classCacheKeys[bucket] == key) {
+            return;
+        } else if (context->classCacheKeys[bucket] == 0) {
+            context->classCacheKeys[bucket] = key;
+            context->classCacheValues[bucket] = value;
+            context->classCacheCount++;
             return;
         }
-        
-        context->classCacheKeys = (void *)addr;
-        context->classCacheValues = (void *)(context->classCacheKeys + size);
-    }
-    
-    /* Treat the cache as a simple hash table with no chaining whatsoever. If the bucket is already
-     * occupied, then don't do anything. The existing entry wins. */
-    size_t index = cache_index(context, key);
-    if (context->classCacheKeys[index] == 0) {
-        context->classCacheKeys[index] = key;
-        context->classCacheValues[index] = value;
     }
 }
 
 /**
- * Free any initialized memory objects in an ObjC context object.
+ * Ensure that the cache has capacity for @a count additional entries while remaining at or below a 1/2 load factor,
+ * growing (and rehashing) the cache if necessary.
  *
  * @param context The context.
+ * @param count The number of additional entries required.
+ * @return An error code. On failure, the existing cache contents (if any) remain valid.
+ */
+static plcrash_error_t cache_reserve (plcrash_async_objc_cache_t *context, size_t count) {
+    size_t required = (context->classCacheCount + count) * 2;
+    if (required <= context->classCacheSize)
+        return PLCRASH_ESUCCESS;
+
+    /* Compute the new (power of two) size */
+    size_t size = context->classCacheSize > kClassCacheMinimumSize ? context->classCacheSize : kClassCacheMinimumSize;
+    while (size < required)
+        size <<= 1;
+
+    /* Allocate the new table */
+    plcrash_async_allocator_t *allocator;
+    size_t allocationSize = cache_allocation_size(context, size);
+    plcrash_error_t err = plcrash_async_allocator_new(&allocator, allocationSize, 0);
+    if (err != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Failed to allocate a %zu entry class cache: %d", size, err);
+        return err;
+    }
+
+    pl_vm_address_t *keys = plcrash_async_allocator_alloc(allocator, allocationSize, true);
+    if (keys == NULL) {
+        PLCF_DEBUG("Failed to allocate a %zu entry class cache", size);
+        plcrash_async_allocator_free(allocator);
+        return PLCRASH_ENOMEM;
+    }
+    plcrash_async_memset(keys, 0, allocationSize);
+
+    /* Swap in the new table, and then rehash the old entries */
+    plcrash_async_allocator_t *oldAllocator = context->classCacheAllocator;
+    pl_vm_address_t *oldKeys = context->classCacheKeys;
+    pl_vm_address_t *oldValues = context->classCacheValues;
+    size_t oldSize = context->classCacheSize;
+
+    context->classCacheAllocator = allocator;
+    context->classCacheKeys = keys;
+    context->classCacheValues = keys + size;
+    context->classCacheSize = size;
+    context->classCacheCount = 0;
+
+    for (size_t i = 0; i < oldSize; i++) {
+        if (oldKeys[i] != 0)
+            cache_set(context, oldKeys[i], oldValues[i]);
+    }
+
+    if (oldAllocator != NULL)
+        plcrash_async_allocator_free(oldAllocator);
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Free any initialized memory objects in a cached image entry, and mark the entry as unused.
+ *
+ * @param entry The cached image entry.
  */
-static void free_mapped_sections (plcrash_async_objc_cache_t *context) {
-    if (context->objcConstMobjInitialized) {
-        plcrash_async_mobject_free(&context->objcConstMobj);
-        context->objcConstMobjInitialized = false;
+static void free_mapped_sections (plcrash_async_objc_cache_image_t *entry) {
+    if (entry->objcConstMobjInitialized) {
+        plcrash_async_mobject_free(&entry->objcConstMobj);
+        entry->objcConstMobjInitialized = false;
+    }
+    if (entry->classMobjInitialized) {
+        plcrash_async_mobject_free(&entry->classMobj);
+        entry->classMobjInitialized = false;
     }
-    if (context->classMobjInitialized) {
-        plcrash_async_mobject_free(&context->classMobj);
-        context->classMobjInitialized = false;
+    if (entry->objcDataMobjInitialized) {
+        plcrash_async_mobject_free(&entry->objcDataMobj);
+        entry->objcDataMobjInitialized = false;
     }
-    if (context->objcDataMobjInitialized) {
-        plcrash_async_mobject_free(&context->objcDataMobj);
-        context->objcDataMobjInitialized = false;
+    if (entry->selrefsMobjInitialized) {
+        plcrash_async_mobject_free(&entry->selrefsMobj);
+        entry->selrefsMobjInitialized = false;
     }
+
+    entry->image = NULL;
+    entry->notFound = false;
 }
 
 /**
  * Set up the memory objects in an ObjC context object for the given image. This will
- * map the memory objects in the context to the appropriate sections in the image.
+ * map the memory objects in the context to the appropriate sections in the image, and set
+ * the context's current image entry.
+ *
+ * Mappings are retained for the PLCRASH_ASYNC_OBJC_CACHE_IMAGE_COUNT most recently used images, so that
+ * stacks that alternate between images do not repeatedly remap the same sections. As the cache may be reused across
+ * reports, the sections are always mapped via plcrash_async_macho_map_known_section_persistent().
  *
  * @param image The MachO image to map.
  * @param context The context.
@@ -286,47 +395,89 @@ static plcrash_error_t map_sections (plcrash_async_macho_t *image, plcrash_async
     if (image == context->lastImage)
         return PLCRASH_ESUCCESS;
     
-    /* Clean up the info from the previous image. Free the memory objects and reset the
-     * image pointer. The image pointer is reset so that it's not stale in case we return
+    /* Reset the current image. This is reset so that it's not stale in case we return
      * early due to an error. */
-    free_mapped_sections(context);
     context->lastImage = NULL;
+    context->current = NULL;
+
+    /* Check for an existing entry, while finding the least recently used entry as an eviction candidate */
+    plcrash_async_objc_cache_image_t *entry = NULL;
+    for (size_t i = 0; i < PLCRASH_ASYNC_OBJC_CACHE_IMAGE_COUNT; i++) {
+        plcrash_async_objc_cache_image_t *candidate = &context->images[i];
+
+        if (candidate->image == image) {
+            candidate->lastUsed = ++context->imageUseCounter;
+            if (candidate->notFound)
+                return PLCRASH_ENOTFOUND;
+
+            context->current = candidate;
+            context->lastImage = image;
+            return PLCRASH_ESUCCESS;
+        }
+
+        if (entry == NULL || candidate->image == NULL || (entry->image != NULL && candidate->lastUsed < entry->lastUsed))
+            entry = candidate;
+    }
+
+    /* Evict the selected entry */
+    free_mapped_sections(entry);
     
     plcrash_error_t err;
     
     /* Map in the __objc_const section, which is where all the read-only class data lives. */
-    err = plcrash_async_macho_map_section(image, kDataSegmentName, kObjCConstSectionName, &context->objcConstMobj);
+    err = plcrash_async_macho_map_known_section_persistent(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_CONST, &entry->objcConstMobj);
     if (err != PLCRASH_ESUCCESS) {
         if (err != PLCRASH_ENOTFOUND)
-            PLCF_DEBUG("pl_async_macho_map_section(%p, %s, %s, %p) failure %d", image, kDataSegmentName, kObjCConstSectionName, &context->objcConstMobj, err);
+            PLCF_DEBUG("pl_async_macho_map_section(%p, %s, %s, %p) failure %d", image, kDataSegmentName, kObjCConstSectionName, &entry->objcConstMobj, err);
         goto cleanup;
     }
-    context->objcConstMobjInitialized = true;
+    entry->objcConstMobjInitialized = true;
     
     /* Map in the class list section.  */
-    err = plcrash_async_macho_map_section(image, kDataSegmentName, kClassListSectionName, &context->classMobj);
+    err = plcrash_async_macho_map_known_section_persistent(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_CLASSLIST, &entry->classMobj);
     if (err != PLCRASH_ESUCCESS) {
         if (err != PLCRASH_ENOTFOUND)
-            PLCF_DEBUG("pl_async_macho_map_section(%s, %s, %s, %p) failure %d", image->name, kDataSegmentName, kClassListSectionName, &context->classMobj, err);
+            PLCF_DEBUG("pl_async_macho_map_section(%s, %s, %s, %p) failure %d", image->name, kDataSegmentName, kClassListSectionName, &entry->classMobj, err);
         goto cleanup;
     }
-    context->classMobjInitialized = true;
+    entry->classMobjInitialized = true;
+
+    /* Size the class cache for this image's classes and their metaclasses. The cache is an optimization;
+     * on failure, we simply proceed with the existing (possibly empty) cache. */
+    size_t classCount = entry->classMobj.length / (image->m64 ? sizeof(uint64_t) : sizeof(uint32_t));
+    cache_reserve(context, classCount * 2);
     
     /* Map in the __objc_data section, which is where the actual classes live. */
-    err = plcrash_async_macho_map_section(image, kDataSegmentName, kObjCDataSectionName, &context->objcDataMobj);
+    err = plcrash_async_macho_map_known_section_persistent(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_DATA, &entry->objcDataMobj);
     if (err != PLCRASH_ESUCCESS) {
         /* If the class list was found, the data section must also be found */
-        PLCF_DEBUG("pl_async_macho_map_section(%s, %s, %s, %p) failure %d", image->name, kDataSegmentName, kObjCDataSectionName, &context->objcDataMobj, err);
+        PLCF_DEBUG("pl_async_macho_map_section(%s, %s, %s, %p) failure %d", image->name, kDataSegmentName, kObjCDataSectionName, &entry->objcDataMobj, err);
         goto cleanup;
     }
-    context->objcDataMobjInitialized = true;
+    entry->objcDataMobjInitialized = true;
+
+    /* Map in the __objc_selrefs section, if any, which is referenced by relative method lists. Relative method
+     * lists fall back to reading the references directly if unavailable. */
+    if (plcrash_async_macho_map_known_section_persistent(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_SELREFS, &entry->selrefsMobj) == PLCRASH_ESUCCESS)
+        entry->selrefsMobjInitialized = true;
     
-    /* Only after all mappings succeed do we set the image. If any failed, the image won't be set,
-     * and any mappings that DO succeed will be cleaned up on the next call (or when freeing the
-     * context. */
+    /* Only after all mappings succeed do we set the image. */
+    entry->image = image;
+    entry->lastUsed = ++context->imageUseCounter;
+    context->current = entry;
     context->lastImage = image;
     
 cleanup:
+    if (err != PLCRASH_ESUCCESS) {
+        /* Release any partial mappings. If the sections simply don't exist, cache the negative result. */
+        free_mapped_sections(entry);
+        if (err == PLCRASH_ENOTFOUND) {
+            entry->image = image;
+            entry->notFound = true;
+            entry->lastUsed = ++context->imageUseCounter;
+        }
+    }
+
     return err;
 }
 
@@ -458,7 +609,7 @@ static plcrash_error_t pl_async_objc_parse_from_module_info (plcrash_async_macho
     /* Map the __module_info section. */
     bool moduleMobjInitialized = false;
     plcrash_async_mobject_t moduleMobj;
-    err = plcrash_async_macho_map_section(image, kObjCSegmentName, kObjCModuleInfoSectionName, &moduleMobj);
+    err = plcrash_async_macho_map_known_section(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_OBJC_MODULE_INFO, &moduleMobj);
     if (err != PLCRASH_ESUCCESS) {
         if (err != PLCRASH_ENOTFOUND)
             PLCF_DEBUG("pl_async_macho_map_section(%p, %s, %s, %p) failure %d", image, kObjCSegmentName, kObjCModuleInfoSectionName, &moduleMobj, err);
@@ -544,6 +695,127 @@ cleanup:
     return err;
 }
 
+/**
+ * Resolve the target of a relative method list's selector reference.
+ *
+ * @param image The Mach-O image containing the method list.
+ * @param objcContext An ObjC context object.
+ * @param selrefPtr The address of the selector reference.
+ * @param[out] methodNamePtr On success, the address of the selector's name.
+ * @return An error code.
+ */
+static plcrash_error_t pl_async_objc_read_selref (plcrash_async_macho_t *image, plcrash_async_objc_cache_t *objcContext, pl_vm_address_t selrefPtr, pl_vm_address_t *methodNamePtr) {
+    union {
+        uint32_t v32;
+        uint64_t v64;
+    } selref;
+    pl_vm_size_t selrefSize = (image->m64 ? sizeof(selref.v64) : sizeof(selref.v32));
+    const void *mapped = NULL;
+    plcrash_error_t err;
+
+    /* Try the mapped __objc_selrefs section first, falling back on a direct read */
+    if (objcContext->current->selrefsMobjInitialized)
+        mapped = plcrash_async_mobject_remap_address(&objcContext->current->selrefsMobj, selrefPtr, 0, selrefSize);
+
+    if (mapped != NULL) {
+        plcrash_async_memcpy(&selref, mapped, selrefSize);
+    } else if ((err = plcrash_async_task_memcpy(image->task, selrefPtr, 0, &selref, selrefSize)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Failed to read selector reference at 0x%llx: %d", (long long)selrefPtr, err);
+        return err;
+    }
+
+    *methodNamePtr = (image->m64 ? image->byteorder->swap64(selref.v64) : image->byteorder->swap32(selref.v32));
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Parse a run of ObjC2 method list entries, invoking a callback for each method found.
+ *
+ * @param image The Mach-O image containing the method list.
+ * @param objcContext An ObjC context object.
+ * @param className The name of the class to which the methods belong.
+ * @param isMetaClass Whether the methods belong to a metaclass (ie, are class methods).
+ * @param entries The local address of the first entry.
+ * @param entriesAddress The task address of the first entry. Relative entries are resolved against this address.
+ * @param entsize The size of each entry, as specified by the method list header.
+ * @param count The number of entries at @a entries.
+ * @param relative If true, the entries use the relative method layout.
+ * @param selectorBase If non-zero, the relative entries' name offsets are direct selector offsets, relative to this
+ * address, rather than offsets to a selector reference. Ignored if @a relative is false.
+ * @param callback The callback to invoke for each method found.
+ * @param ctx A context pointer to pass to the callback.
+ * @return An error code.
+ */
+static plcrash_error_t pl_async_objc_parse_objc2_method_entries (plcrash_async_macho_t *image, plcrash_async_objc_cache_t *objcContext, plcrash_async_macho_string_t *className, bool isMetaClass,
+                                                                 const char *entries, pl_vm_address_t entriesAddress, uint32_t entsize, uint32_t count, bool relative,
+                                                                 pl_vm_address_t selectorBase, plcrash_async_objc_found_method_cb callback, void *ctx)
+{
+    plcrash_error_t err;
+    const char *cursor = entries;
+
+    for (uint32_t i = 0; i < count; i++) {
+        pl_vm_address_t methodNamePtr;
+        pl_vm_address_t imp;
+
+        if (relative) {
+            /* Resolve the entry's offsets against the entry's task address */
+            const struct pl_objc2_method_relative *method_rel = (void *)cursor;
+            pl_vm_address_t entryAddress = entriesAddress + (pl_vm_address_t)entsize * i;
+
+            int32_t nameOffset = (int32_t) image->byteorder->swap32(method_rel->name);
+            int32_t impOffset = (int32_t) image->byteorder->swap32(method_rel->imp);
+
+            if (selectorBase != 0) {
+                /* Direct selector offsets reference the selector name itself */
+                methodNamePtr = selectorBase + (pl_vm_address_t)(int64_t)nameOffset;
+            } else {
+                /* An unreadable selector reference only prevents naming this method; skip it */
+                pl_vm_address_t selrefPtr = entryAddress + offsetof(struct pl_objc2_method_relative, name) + (pl_vm_address_t)(int64_t)nameOffset;
+                if (pl_async_objc_read_selref(image, objcContext, selrefPtr, &methodNamePtr) != PLCRASH_ESUCCESS) {
+                    cursor += entsize;
+                    continue;
+                }
+            }
+
+            imp = entryAddress + offsetof(struct pl_objc2_method_relative, imp) + (pl_vm_address_t)(int64_t)impOffset;
+        } else {
+            /* Read an architecture-appropriate method structure from the
+             * current cursor. */
+            const struct pl_objc2_method_32 *method_32 = (void *)cursor;
+            const struct pl_objc2_method_64 *method_64 = (void *)cursor;
+            
+            /* Extract the method name pointer. */
+            methodNamePtr = (image->m64
+                             ? image->byteorder->swap64(method_64->name)
+                             : image->byteorder->swap32(method_32->name));
+
+            /* Extract the method IMP. */
+            imp = (image->m64
+                   ? image->byteorder->swap64(method_64->imp)
+                   : image->byteorder->swap32(method_32->imp));
+        }
+        
+        /* Read the method name. */
+        plcrash_async_macho_string_t methodName;
+        err = plcrash_async_macho_string_init(&methodName, image, methodNamePtr);
+        if (err != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("plcrash_async_macho_string_init at 0x%llx error %d", (long long)methodNamePtr, err);
+            return err;
+        }
+        
+        /* Call the callback. */
+        callback(isMetaClass, className, &methodName, imp, ctx);
+        
+        /* Clean up the method name. */
+        plcrash_async_macho_string_free(&methodName);
+        
+        /* Increment the cursor by the entry size for the next iteration of the loop. */
+        cursor += entsize;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * Parse a single class from ObjC2 class data.
  *
@@ -628,7 +900,7 @@ static plcrash_error_t pl_async_objc_parse_objc2_class(plcrash_async_macho_t *im
             classDataRO_32 = &cls_copied_ro.cls32;
             classDataRO_64 = &cls_copied_ro.cls64;
         } else {
-            void *classDataROPtr = plcrash_async_mobject_remap_address(&objcContext->objcConstMobj, cached_data_ro_addr, 0, class_ro_length);
+            void *classDataROPtr = plcrash_async_mobject_remap_address(&objcContext->current->objcConstMobj, cached_data_ro_addr, 0, class_ro_length);
             if (classDataROPtr == NULL) {
                 PLCF_DEBUG("plcrash_async_mobject_remap_address at 0x%llx returned NULL", (long long)cached_data_ro_addr);
                 goto cleanup;
@@ -644,7 +916,7 @@ static plcrash_error_t pl_async_objc_parse_objc2_class(plcrash_async_macho_t *im
         /* We know that the address is valid (it wouldn't be in the cache otherwise). We try the cheaper memory mapping first,
          * and then fall back to a memory copy. */
         void *classDataROPtr;
-        if ((classDataROPtr = plcrash_async_mobject_remap_address(&objcContext->objcConstMobj, cached_data_ro_addr, 0, class_ro_length)) != NULL) {
+        if ((classDataROPtr = plcrash_async_mobject_remap_address(&objcContext->current->objcConstMobj, cached_data_ro_addr, 0, class_ro_length)) != NULL) {
             classDataRO_32 = classDataROPtr;
             classDataRO_64 = classDataROPtr;
         } else if (plcrash_async_read_addr(image->task, cached_data_ro_addr, &cls_copied_ro, class_ro_length) == PLCRASH_ESUCCESS) {
@@ -673,61 +945,77 @@ static plcrash_error_t pl_async_objc_parse_objc2_class(plcrash_async_macho_t *im
     if (methodsPtr == 0)
         goto cleanup;
     
-    /* Read the method list header. */
+    /* Read the method list header. Method lists are normally found within __objc_const; if not, fetch them directly
+     * from the task. */
+    struct pl_objc2_list_header header_copy;
     struct pl_objc2_list_header *header;
-    header = plcrash_async_mobject_remap_address(&objcContext->objcConstMobj, methodsPtr, 0, sizeof(*header));
+    header = plcrash_async_mobject_remap_address(&objcContext->current->objcConstMobj, methodsPtr, 0, sizeof(*header));
     if (header == NULL) {
-        PLCF_DEBUG("plcrash_async_mobject_remap_address in objCConstMobj failed to map methods pointer 0x%llx", (long long)methodsPtr);
-        goto cleanup;
+        plcrash_error_t readErr;
+        if ((readErr = plcrash_async_task_memcpy(image->task, methodsPtr, 0, &header_copy, sizeof(header_copy))) != PLCRASH_ESUCCESS) {
+            /* Skip the class */
+            PLCF_DEBUG("Failed to read method list header at 0x%llx: %d", (long long)methodsPtr, readErr);
+            goto cleanup;
+        }
+        header = &header_copy;
     }
     
-    /* Extract the entry size and count from the list header. */
-    uint32_t entsize = image->byteorder->swap32(header->entsize) & ~(uint32_t)3;
+    /* Extract the entry size, flags, and count from the list header. */
+    uint32_t entsizeAndFlags = image->byteorder->swap32(header->entsize);
+    uint32_t entsize = entsizeAndFlags & ~METHOD_LIST_FLAGS_MASK;
     uint32_t count = image->byteorder->swap32(header->count);
+    bool relative = (entsizeAndFlags & METHOD_LIST_IS_RELATIVE) != 0;
+
+    /* Selector offsets relative to the shared cache's selector base can only be resolved if the base is known; see
+     * plcrash_nasync_objc_shared_cache_init(). Otherwise, skip the list. */
+    pl_vm_address_t selectorBase = 0;
+    if (relative && (entsizeAndFlags & METHOD_LIST_DIRECT_SELECTORS) != 0) {
+        selectorBase = image->objc_selector_base;
+        if (selectorBase == 0) {
+            PLCF_DEBUG("Skipping method list with direct selector offsets at 0x%llx", (long long)methodsPtr);
+            goto cleanup;
+        }
+    }
+
+    /* Validate the entry size. */
+    pl_vm_size_t methodSize;
+    if (relative)
+        methodSize = sizeof(struct pl_objc2_method_relative);
+    else
+        methodSize = (image->m64 ? sizeof(struct pl_objc2_method_64) : sizeof(struct pl_objc2_method_32));
+
+    if (entsize < methodSize || entsize > sizeof(objcContext->methodScratch)) {
+        /* Skip the class */
+        PLCF_DEBUG("Unsupported method entry size %" PRIu32 " for method list at 0x%llx", entsize, (long long)methodsPtr);
+        goto cleanup;
+    }
     
     /* Compute the method list start position and length. */
     pl_vm_address_t methodListStart = methodsPtr + sizeof(*header);
     pl_vm_size_t methodListLength = (pl_vm_size_t)entsize * count;
 
-    const char *cursor = plcrash_async_mobject_remap_address(&objcContext->objcConstMobj, methodListStart, 0, methodListLength);
-    if (cursor == NULL) {
-        PLCF_DEBUG("plcrash_async_mobject_remap_address at 0x%llx length %llu returned NULL", (long long)methodListStart, (unsigned long long)methodListLength);
+    const char *cursor = plcrash_async_mobject_remap_address(&objcContext->current->objcConstMobj, methodListStart, 0, methodListLength);
+    if (cursor != NULL) {
+        err = pl_async_objc_parse_objc2_method_entries(image, objcContext, &className, isMetaClass, cursor, methodListStart, entsize, count, relative, selectorBase, callback, ctx);
         goto cleanup;
     }
-    
-    /* Extract methods from the list. */
-    for (uint32_t i = 0; i < count; i++) {
-        /* Read an architecture-appropriate method structure from the
-         * current cursor. */
-        const struct pl_objc2_method_32 *method_32 = (void *)cursor;
-        const struct pl_objc2_method_64 *method_64 = (void *)cursor;
-        
-        /* Extract the method name pointer. */
-        pl_vm_address_t methodNamePtr = (image->m64
-                                         ? image->byteorder->swap64(method_64->name)
-                                         : image->byteorder->swap32(method_32->name));
-        
-        /* Read the method name. */
-        plcrash_async_macho_string_t methodName;
-        err = plcrash_async_macho_string_init(&methodName, image, methodNamePtr);
-        if (err != PLCRASH_ESUCCESS) {
-            PLCF_DEBUG("plcrash_async_macho_string_init at 0x%llx error %d", (long long)methodNamePtr, err);
+
+    /* The list could not be mapped; copy the entries into the scratch buffer in bulk, as many as will fit at a time. */
+    uint32_t chunkCount = (uint32_t) (sizeof(objcContext->methodScratch) / entsize);
+    for (uint32_t i = 0; i < count; i += chunkCount) {
+        uint32_t n = count - i < chunkCount ? count - i : chunkCount;
+        pl_vm_address_t chunkStart = methodListStart + (pl_vm_address_t)entsize * i;
+
+        plcrash_error_t readErr;
+        if ((readErr = plcrash_async_task_memcpy(image->task, chunkStart, 0, objcContext->methodScratch, (pl_vm_size_t)entsize * n)) != PLCRASH_ESUCCESS) {
+            /* Skip the remainder of the class */
+            PLCF_DEBUG("Failed to read method list entries at 0x%llx: %d", (long long)chunkStart, readErr);
             goto cleanup;
         }
-        
-        /* Extract the method IMP. */
-        pl_vm_address_t imp = (image->m64
-                               ? image->byteorder->swap64(method_64->imp)
-                               : image->byteorder->swap32(method_32->imp));
-        
-        /* Call the callback. */
-        callback(isMetaClass, &className, &methodName, imp, ctx);
-        
-        /* Clean up the method name. */
-        plcrash_async_macho_string_free(&methodName);
-        
-        /* Increment the cursor by the entry size for the next iteration of the loop. */
-        cursor += entsize;
+
+        err = pl_async_objc_parse_objc2_method_entries(image, objcContext, &className, isMetaClass, (const char *) objcContext->methodScratch, chunkStart, entsize, n, relative, selectorBase, callback, ctx);
+        if (err != PLCRASH_ESUCCESS)
+            goto cleanup;
     }
     
 cleanup:
@@ -760,9 +1048,9 @@ static plcrash_error_t pl_async_objc_parse_from_data_section (plcrash_async_mach
     }
     
     /* Get a pointer out of the mapped class list. */
-    void *classPtrs = plcrash_async_mobject_remap_address(&objcContext->classMobj, objcContext->classMobj.task_address, 0, objcContext->classMobj.length);
+    void *classPtrs = plcrash_async_mobject_remap_address(&objcContext->current->classMobj, objcContext->current->classMobj.task_address, 0, objcContext->current->classMobj.length);
     if (classPtrs == NULL) {
-        PLCF_DEBUG("plcrash_async_mobject_remap_address in objcConstMobj for pointer %llx returned NULL", (long long)objcContext->classMobj.address);
+        PLCF_DEBUG("plcrash_async_mobject_remap_address in objcConstMobj for pointer %llx returned NULL", (long long)objcContext->current->classMobj.address);
         goto cleanup;
     }
     
@@ -773,7 +1061,7 @@ static plcrash_error_t pl_async_objc_parse_from_data_section (plcrash_async_mach
     
     /* Figure out how many classes are in the class list based on its length and
      * the size of a pointer in the image. */
-    unsigned classCount = objcContext->classMobj.length / (image->m64 ? sizeof(*classPtrs_64) : sizeof(*classPtrs_32));
+    unsigned classCount = objcContext->current->classMobj.length / (image->m64 ? sizeof(*classPtrs_64) : sizeof(*classPtrs_32));
     
     /* Iterate over all classes. */
     for(unsigned i = 0; i < classCount; i++) {
@@ -785,7 +1073,7 @@ static plcrash_error_t pl_async_objc_parse_from_data_section (plcrash_async_mach
         /* Read an architecture-appropriate class structure. */
         struct pl_objc2_class_32 *class_32;
         struct pl_objc2_class_64 *class_64;
-        void *classPtr = plcrash_async_mobject_remap_address(&objcContext->objcDataMobj, ptr, 0, image->m64 ? sizeof(*class_64) : sizeof(*class_32));
+        void *classPtr = plcrash_async_mobject_remap_address(&objcContext->current->objcDataMobj, ptr, 0, image->m64 ? sizeof(*class_64) : sizeof(*class_32));
         if (classPtr == NULL) {
             PLCF_DEBUG("plcrash_async_mobject_remap_address in objcDataMobj for pointer %llx returned NULL", (long long)ptr);
             goto cleanup;
@@ -807,7 +1095,7 @@ static plcrash_error_t pl_async_objc_parse_from_data_section (plcrash_async_mach
                                : image->byteorder->swap32(class_32->isa));
         struct pl_objc2_class_32 *metaclass_32;
         struct pl_objc2_class_64 *metaclass_64;
-        void *metaclassPtr = plcrash_async_mobject_remap_address(&objcContext->objcDataMobj, isa, 0, image->m64 ? sizeof(*class_64) : sizeof(*class_32));
+        void *metaclassPtr = plcrash_async_mobject_remap_address(&objcContext->current->objcDataMobj, isa, 0, image->m64 ? sizeof(*class_64) : sizeof(*class_32));
         if (metaclassPtr == NULL) {
             PLCF_DEBUG("plcrash_async_mobject_remap_address in objcDataMobj for pointer %llx returned NULL", (long long)isa);
             goto cleanup;
@@ -837,12 +1125,16 @@ cleanup:
 plcrash_error_t plcrash_async_objc_cache_init (plcrash_async_objc_cache_t *cache) {
     cache->gotObjC2Info = false;
     cache->lastImage = NULL;
-    cache->objcConstMobjInitialized = false;
-    cache->classMobjInitialized = false;
-    cache->objcDataMobjInitialized = false;
+    cache->current = NULL;
+    cache->imageUseCounter = 0;
+    plcrash_async_memset(cache->images, 0, sizeof(cache->images));
+    cache->classCacheAllocator = NULL;
     cache->classCacheSize = 0;
+    cache->classCacheCount = 0;
     cache->classCacheKeys = NULL;
     cache->classCacheValues = NULL;
+    cache->classCacheHits = 0;
+    cache->classCacheMisses = 0;
     return PLCRASH_ESUCCESS;
 }
 
@@ -852,10 +1144,11 @@ plcrash_error_t plcrash_async_objc_cache_init (plcrash_async_objc_cache_t *cache
  * @param cache A pointer to the cache object to free.
  */
 void plcrash_async_objc_cache_free (plcrash_async_objc_cache_t *cache) {
-    free_mapped_sections(cache);
+    for (size_t i = 0; i < PLCRASH_ASYNC_OBJC_CACHE_IMAGE_COUNT; i++)
+        free_mapped_sections(&cache->images[i]);
 
-    if (cache->classCacheKeys != NULL)
-        vm_deallocate(mach_task_self(), (vm_address_t)cache->classCacheKeys, cache_allocation_size(cache));
+    if (cache->classCacheAllocator != NULL)
+        plcrash_async_allocator_free(cache->classCacheAllocator);
 }
 
 /**
@@ -900,12 +1193,21 @@ static plcrash_error_t plcrash_async_objc_parse (plcrash_async_macho_t *image, p
 struct pl_async_objc_find_method_search_context {
     pl_vm_address_t searchIMP;
     pl_vm_address_t bestIMP;
-};
 
-struct pl_async_objc_find_method_call_context {
-    pl_vm_address_t searchIMP;
-    plcrash_async_objc_found_method_cb outerCallback;
-    void *outerCallbackCtx;
+    /** The lowest non-NULL IMP found. Should be initialized to PL_VM_ADDRESS_MAX. */
+    pl_vm_address_t minIMP;
+
+    /** The highest IMP found. Should be initialized to 0. */
+    pl_vm_address_t maxIMP;
+
+    /** Whether the best match is a class method. */
+    bool bestIsClassMethod;
+
+    /** The address of the best match's class name. */
+    pl_vm_address_t bestClassNameAddress;
+
+    /** The address of the best match's method name. */
+    pl_vm_address_t bestMethodNameAddress;
 };
 
 /**
@@ -913,30 +1215,134 @@ struct pl_async_objc_find_method_call_context {
  * The context pointer is a pointer to pl_async_objc_find_method_search_context.
  * The searchIMP field should be set to the IMP to search for. The bestIMP field
  * should be initialized to 0, and will be updated with the best-matching IMP
- * found.
+ * found, along with the addresses of the best match's class and method names.
+ * The minIMP and maxIMP fields will be updated with the range of all IMPs found.
+ *
+ * If multiple methods share the best-matching IMP, the first method found is used.
  */
 static void pl_async_objc_find_method_search_callback (bool isClassMethod, plcrash_async_macho_string_t *className, plcrash_async_macho_string_t *methodName, pl_vm_address_t imp, void *ctx) {
     struct pl_async_objc_find_method_search_context *ctxStruct = ctx;
+
+    if (imp != 0) {
+        if (imp < ctxStruct->minIMP)
+            ctxStruct->minIMP = imp;
+        if (imp > ctxStruct->maxIMP)
+            ctxStruct->maxIMP = imp;
+    }
     
-    if (imp >= ctxStruct->bestIMP && imp <= ctxStruct->searchIMP) {
+    if (imp > ctxStruct->bestIMP && imp <= ctxStruct->searchIMP) {
         ctxStruct->bestIMP = imp;
+        ctxStruct->bestIsClassMethod = isClassMethod;
+        ctxStruct->bestClassNameAddress = className->address;
+        ctxStruct->bestMethodNameAddress = methodName->address;
+    }
+}
+
+/**
+ * Report a method to @a callback, constructing the class and method name strings from their addresses.
+ *
+ * @param image The image containing the method.
+ * @param isClassMethod If true, the method is a class (rather than an instance) method.
+ * @param classNameAddress The address of the method's class name.
+ * @param methodNameAddress The address of the method's name.
+ * @param imp The method's IMP.
+ * @param callback The callback to invoke, or NULL.
+ * @param ctx The context pointer to pass to the callback.
+ * @return An error code.
+ */
+static plcrash_error_t pl_async_objc_find_method_report (plcrash_async_macho_t *image, bool isClassMethod, pl_vm_address_t classNameAddress,
+                                                         pl_vm_address_t methodNameAddress, pl_vm_address_t imp,
+                                                         plcrash_async_objc_found_method_cb callback, void *ctx)
+{
+    plcrash_async_macho_string_t className;
+    plcrash_async_macho_string_t methodName;
+    plcrash_error_t err;
+
+    if (callback == NULL)
+        return PLCRASH_ESUCCESS;
+
+    err = plcrash_async_macho_string_init(&className, image, classNameAddress);
+    if (err != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("plcrash_async_macho_string_init at 0x%llx error %d", (long long)classNameAddress, err);
+        return err;
+    }
+
+    err = plcrash_async_macho_string_init(&methodName, image, methodNameAddress);
+    if (err != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("plcrash_async_macho_string_init at 0x%llx error %d", (long long)methodNameAddress, err);
+        plcrash_async_macho_string_free(&className);
+        return err;
+    }
+
+    callback(isClassMethod, &className, &methodName, imp, ctx);
+
+    plcrash_async_macho_string_free(&methodName);
+    plcrash_async_macho_string_free(&className);
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Locate the method that best matches @a imp within @a index, using a binary search.
+ *
+ * @param index The IMP index to search.
+ * @param imp The address to search for.
+ *
+ * @return Returns the best matching entry, or NULL if no method precedes @a imp.
+ */
+static plcrash_async_objc_imp_index_entry_t *pl_async_objc_find_indexed_method (plcrash_async_objc_imp_index_t *index, pl_vm_address_t imp) {
+    /* Find the first entry with an IMP greater than imp */
+    uint32_t lower = 0;
+    uint32_t upper = index->count;
+    while (lower < upper) {
+        uint32_t mid = lower + ((upper - lower) / 2);
+        if (index->entries[mid].imp <= imp)
+            lower = mid + 1;
+        else
+            upper = mid;
     }
+
+    /* The preceding entry (if any) is the closest method occuring before imp */
+    if (lower == 0)
+        return NULL;
+
+    return &index->entries[lower - 1];
 }
 
 /**
- * Callback used to find the method that precisely matches a search target.
- * The context pointer is a pointer to pl_async_objc_find_method_call_context.
- * The searchIMP field should be set to the IMP to search for. The outerCallback
- * will be invoked, passing outerCalblackCtx and the method data for a precise
- * match, if any is found.
+ * Fetch the range of Objective-C method IMPs found within @a image. The range is available once the image's IMP
+ * index has been built, or once plcrash_async_objc_find_method() has parsed the image's class data.
+ *
+ * No method of @a image may be matched by plcrash_async_objc_find_method() for an address below @a min_imp, and
+ * no match will be greater than @a max_imp; this allows callers to skip Objective-C lookups that can not produce
+ * a (better) result.
+ *
+ * @param image The image.
+ * @param[out] min_imp On success, the lowest IMP. If the image contains no methods, this will be greater than @a max_imp.
+ * @param[out] max_imp On success, the highest IMP.
+ *
+ * @return Returns true if the range is known, or false if the image's methods have not yet been parsed.
  */
-static void pl_async_objc_find_method_call_callback (bool isClassMethod, plcrash_async_macho_string_t *className, plcrash_async_macho_string_t *methodName, pl_vm_address_t imp, void *ctx) {
-    struct pl_async_objc_find_method_call_context *ctxStruct = ctx;
-    
-    if (imp == ctxStruct->searchIMP && ctxStruct->outerCallback != NULL) {
-        ctxStruct->outerCallback(isClassMethod, className, methodName, imp, ctxStruct->outerCallbackCtx);
-        ctxStruct->outerCallback = NULL;
+bool plcrash_async_objc_imp_range (plcrash_async_macho_t *image, pl_vm_address_t *min_imp, pl_vm_address_t *max_imp) {
+    plcrash_async_objc_imp_index_t *index = image->objc_index;
+    if (index != NULL) {
+        if (index->count == 0) {
+            *min_imp = PL_VM_ADDRESS_MAX;
+            *max_imp = 0;
+        } else {
+            *min_imp = index->entries[0].imp;
+            *max_imp = index->entries[index->count - 1].imp;
+        }
+        return true;
     }
+
+    if (!image->objc_imp_range_valid)
+        return false;
+
+    OSMemoryBarrier();
+    *min_imp = image->objc_imp_min;
+    *max_imp = image->objc_imp_max;
+    return true;
 }
 
 /**
@@ -950,11 +1356,39 @@ static void pl_async_objc_find_method_call_callback (bool isClassMethod, plcrash
  * @return An error code.
  */
 plcrash_error_t plcrash_async_objc_find_method (plcrash_async_macho_t *image, plcrash_async_objc_cache_t *objcContext, pl_vm_address_t imp, plcrash_async_objc_found_method_cb callback, void *ctx) {
+    /* Use the IMP index, if available */
+    plcrash_async_objc_imp_index_t *index = image->objc_index;
+    if (index != NULL) {
+        plcrash_async_objc_imp_index_entry_t *entry = pl_async_objc_find_indexed_method(index, imp);
+        if (entry == NULL)
+            return PLCRASH_ENOTFOUND;
+
+        return pl_async_objc_find_method_report(image, entry->isClassMethod, entry->classNameAddress, entry->methodNameAddress, entry->imp, callback, ctx);
+    }
+
+    /* Skip the parse entirely if imp precedes all of the image's methods */
+    if (image->objc_imp_range_valid) {
+        OSMemoryBarrier();
+        if (imp < image->objc_imp_min)
+            return PLCRASH_ENOTFOUND;
+    }
+
     struct pl_async_objc_find_method_search_context searchCtx = {
-        .searchIMP = imp
+        .searchIMP = imp,
+        .minIMP = PL_VM_ADDRESS_MAX,
+        .maxIMP = 0
     };
 
     plcrash_error_t err = plcrash_async_objc_parse(image, objcContext, pl_async_objc_find_method_search_callback, &searchCtx);
+
+    /* Record the image's IMP range for use by later lookups. An image without ObjC data has an empty range. */
+    if (err == PLCRASH_ESUCCESS || err == PLCRASH_ENOTFOUND) {
+        image->objc_imp_min = searchCtx.minIMP;
+        image->objc_imp_max = searchCtx.maxIMP;
+        OSMemoryBarrier();
+        image->objc_imp_range_valid = true;
+    }
+
     if (err != PLCRASH_ESUCCESS) {
         /* Don't log an error if ObjC data was simply not found */
         if (err != PLCRASH_ENOTFOUND)
@@ -965,12 +1399,279 @@ plcrash_error_t plcrash_async_objc_find_method (plcrash_async_macho_t *image, pl
     if (searchCtx.bestIMP == 0)
         return PLCRASH_ENOTFOUND;
     
-    struct pl_async_objc_find_method_call_context callCtx = {
-        .searchIMP = searchCtx.bestIMP,
-        .outerCallback = callback,
-        .outerCallbackCtx = ctx
+    /* Report the best match from the retained string addresses, rather than re-parsing the image's
+     * classes to find the matching method. */
+    return pl_async_objc_find_method_report(image, searchCtx.bestIsClassMethod, searchCtx.bestClassNameAddress, searchCtx.bestMethodNameAddress,
+                                            searchCtx.bestIMP, callback, ctx);
+}
+
+struct pl_async_objc_imp_index_build_context {
+    /** The index to be populated, or NULL if methods should only be counted. */
+    plcrash_async_objc_imp_index_t *index;
+
+    /** The number of entries available in @a index. */
+    uint32_t capacity;
+
+    /** The total number of methods found. */
+    uint32_t count;
+};
+
+/**
+ * Callback used to populate an IMP index. The context pointer is a pointer to pl_async_objc_imp_index_build_context.
+ * If the index field is NULL, methods are only counted. Otherwise, methods are appended to the index, up to the
+ * provided capacity.
+ */
+static void pl_async_objc_imp_index_build_callback (bool isClassMethod, plcrash_async_macho_string_t *className, plcrash_async_macho_string_t *methodName, pl_vm_address_t imp, void *ctx) {
+    struct pl_async_objc_imp_index_build_context *ctxStruct = ctx;
+
+    /* A NULL IMP can never be matched by plcrash_async_objc_find_method() */
+    if (imp == 0)
+        return;
+
+    ctxStruct->count++;
+    if (ctxStruct->index == NULL || ctxStruct->index->count >= ctxStruct->capacity)
+        return;
+
+    plcrash_async_objc_imp_index_entry_t *entry = &ctxStruct->index->entries[ctxStruct->index->count++];
+    entry->imp = imp;
+    entry->classNameAddress = className->address;
+    entry->methodNameAddress = methodName->address;
+    entry->isClassMethod = isClassMethod;
+}
+
+/* plcrash_async_objc_imp_index_entry_t IMP comparison function */
+static int pl_async_objc_imp_index_compare (const void *a, const void *b) {
+    const plcrash_async_objc_imp_index_entry_t *lhs = a;
+    const plcrash_async_objc_imp_index_entry_t *rhs = b;
+
+    if (lhs->imp < rhs->imp)
+        return -1;
+    else if (lhs->imp > rhs->imp)
+        return 1;
+    return 0;
+}
+
+/**
+ * Build an IMP-sorted index of the Objective-C methods of @a image, allowing plcrash_async_objc_find_method() to perform
+ * a binary search rather than parsing all of the image's class data. The index is allocated within a dedicated allocator,
+ * and will be released by plcrash_nasync_macho_free(). If an index has already been built, no action is taken.
+ *
+ * The index reflects the image's class data at the time it is built; methods added to the image's classes at runtime
+ * after the index is built will not be found.
+ *
+ * @param image The image for which an index should be built.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the image contains no Objective-C data, or another
+ * error result on failure.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_objc_build_imp_index (plcrash_async_macho_t *image) {
+    plcrash_async_objc_cache_t cache;
+    plcrash_async_allocator_t *allocator;
+    plcrash_async_objc_imp_index_t *index;
+    plcrash_error_t err;
+
+    if (image->objc_index != NULL)
+        return PLCRASH_ESUCCESS;
+
+    if ((err = plcrash_async_objc_cache_init(&cache)) != PLCRASH_ESUCCESS)
+        return err;
+
+    /* Count the methods */
+    struct pl_async_objc_imp_index_build_context buildCtx = {
+        .index = NULL,
+        .capacity = 0,
+        .count = 0
     };
-    
-    return plcrash_async_objc_parse(image, objcContext, pl_async_objc_find_method_call_callback, &callCtx);
+
+    if ((err = plcrash_async_objc_parse(image, &cache, pl_async_objc_imp_index_build_callback, &buildCtx)) != PLCRASH_ESUCCESS) {
+        if (err != PLCRASH_ENOTFOUND)
+            PLCF_DEBUG("pl_async_objc_parse(%p) failure %d", image, err);
+        goto cleanup;
+    }
+
+    /* Allocate the index */
+    size_t index_size = sizeof(plcrash_async_objc_imp_index_t) + (sizeof(plcrash_async_objc_imp_index_entry_t) * buildCtx.count);
+
+    if ((err = plcrash_async_allocator_new(&allocator, index_size, 0)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not allocate a %" PRIu32 " entry Objective-C index for %s: %d", buildCtx.count, image->name, err);
+        goto cleanup;
+    }
+
+    if ((index = plcrash_async_allocator_alloc(allocator, index_size, true)) == NULL) {
+        PLCF_DEBUG("Could not allocate a %" PRIu32 " entry Objective-C index for %s", buildCtx.count, image->name);
+        plcrash_async_allocator_free(allocator);
+        err = PLCRASH_ENOMEM;
+        goto cleanup;
+    }
+
+    index->allocator = allocator;
+    index->count = 0;
+
+    /* Populate the index. Methods added concurrently to the class data (eg, by category attachment) are dropped if
+     * they exceed the counted capacity. */
+    buildCtx.index = index;
+    buildCtx.capacity = buildCtx.count;
+    buildCtx.count = 0;
+
+    if ((err = plcrash_async_objc_parse(image, &cache, pl_async_objc_imp_index_build_callback, &buildCtx)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("pl_async_objc_parse(%p) failure %d", image, err);
+        plcrash_async_allocator_free(allocator);
+        goto cleanup;
+    }
+
+    /*
+     * Sort by IMP. A stable sort is required; when multiple methods share an IMP, the linear search
+     * reports the first such method, and we discard the remainder.
+     */
+    if (index->count > 0) {
+        mergesort(index->entries, index->count, sizeof(index->entries[0]), pl_async_objc_imp_index_compare);
+
+        uint32_t unique = 1;
+        for (uint32_t i = 1; i < index->count; i++) {
+            if (index->entries[i].imp != index->entries[unique - 1].imp)
+                index->entries[unique++] = index->entries[i];
+        }
+        index->count = unique;
+    }
+
+    /* Publish the index. If another index was concurrently published, discard ours. */
+    if (!OSAtomicCompareAndSwapPtrBarrier(NULL, index, (void **) &image->objc_index))
+        plcrash_async_allocator_free(allocator);
+
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    plcrash_async_objc_cache_free(&cache);
+    return err;
+}
+
+
+/**
+ * @internal
+ *
+ * The subset of the dyld shared cache header required to locate the cache's Objective-C optimization header.
+ * The optimization header offset is only present in caches whose header (which ends at the cache's mapping table)
+ * extends beyond @a objcOptsOffset.
+ */
+struct pl_dyld_cache_header_objc {
+    /** The cache magic, beginning with "dyld_v1". */
+    char magic[16];
+
+    /** The offset of the cache's mapping table, which immediately follows the header. */
+    uint32_t mappingOffset;
+};
+
+#ifndef MH_DYLIB_IN_CACHE
+/** The mach_header flag set on images that are part of the dyld shared cache. Not defined by older SDKs. */
+#define MH_DYLIB_IN_CACHE 0x80000000
+#endif
+
+/** Offset of the objcOptsOffset and objcOptsSize fields within the dyld shared cache header. */
+#define PL_DYLD_CACHE_HEADER_OBJC_OPTS_OFFSET 0x1D0
+
+/**
+ * @internal
+ *
+ * The dyld shared cache's Objective-C optimization header. All offsets are relative to the start of the cache.
+ */
+struct pl_objc_opt_header {
+    uint32_t version;
+    uint32_t flags;
+    uint64_t headerInfoROCacheOffset;
+    uint64_t headerInfoRWCacheOffset;
+    uint64_t selectorHashTableCacheOffset;
+    uint64_t classHashTableCacheOffset;
+    uint64_t protocolHashTableCacheOffset;
+    uint64_t relativeMethodSelectorBaseAddressOffset;
+};
+
+/** The supported pl_objc_opt_header version. */
+#define PL_OBJC_OPT_HEADER_VERSION 1
+
+/**
+ * Read the precomputed Objective-C optimization header of the dyld shared cache mapped at @a cache_base within
+ * @a task. The header is read once for the whole cache; the resulting @a cache may then be applied to each of the
+ * cache's images via plcrash_async_objc_shared_cache_apply(), allowing their relative method lists' direct selector
+ * offsets to be resolved without reference to each image's selector references.
+ *
+ * Only the optimization header referenced by the dyld cache header (as produced by macOS 13, iOS 16, and later) is
+ * supported. Older caches will return PLCRASH_ENOTSUP; their method lists are parsed as before.
+ *
+ * @param cache The reader to initialize.
+ * @param task The task in which the shared cache is mapped.
+ * @param cache_base The task-relative address of the shared cache's header, as reported by dyld_all_image_infos.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTSUP if the cache does not provide a supported optimization
+ * header, or another error result if the cache could not be read.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_objc_shared_cache_init (plcrash_async_objc_shared_cache_t *cache, task_t task, pl_vm_address_t cache_base) {
+    struct pl_dyld_cache_header_objc header;
+    struct pl_objc_opt_header opt;
+    uint64_t opt_location[2];
+    plcrash_error_t err;
+
+    memset(cache, 0, sizeof(*cache));
+
+    /* Read and validate the cache header */
+    if ((err = plcrash_async_task_memcpy(task, cache_base, 0, &header, sizeof(header))) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not read the shared cache header at 0x%" PRIx64 ": %d", (uint64_t) cache_base, err);
+        return err;
+    }
+
+    if (strncmp(header.magic, "dyld_v1", strlen("dyld_v1")) != 0) {
+        PLCF_DEBUG("Invalid shared cache magic at 0x%" PRIx64, (uint64_t) cache_base);
+        return PLCRASH_EINVAL;
+    }
+
+    if (header.mappingOffset < PL_DYLD_CACHE_HEADER_OBJC_OPTS_OFFSET + sizeof(opt_location))
+        return PLCRASH_ENOTSUP;
+
+    /* Locate and read the optimization header */
+    if ((err = plcrash_async_task_memcpy(task, cache_base, PL_DYLD_CACHE_HEADER_OBJC_OPTS_OFFSET, opt_location, sizeof(opt_location))) != PLCRASH_ESUCCESS)
+        return err;
+
+    if (opt_location[0] == 0 || opt_location[1] < sizeof(opt))
+        return PLCRASH_ENOTSUP;
+
+    if ((err = plcrash_async_task_memcpy(task, cache_base, (pl_vm_off_t) opt_location[0], &opt, sizeof(opt))) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not read the shared cache's Objective-C optimization header: %d", err);
+        return err;
+    }
+
+    if (opt.version != PL_OBJC_OPT_HEADER_VERSION) {
+        PLCF_DEBUG("Unsupported Objective-C optimization header version %" PRIu32, opt.version);
+        return PLCRASH_ENOTSUP;
+    }
+
+    if (opt.relativeMethodSelectorBaseAddressOffset == 0)
+        return PLCRASH_ENOTSUP;
+
+    cache->selector_base = cache_base + opt.relativeMethodSelectorBaseAddressOffset;
+    return PLCRASH_ESUCCESS;
 }
 
+/**
+ * Apply the shared cache optimization data read via plcrash_nasync_objc_shared_cache_init() to @a image. Images
+ * outside of the shared cache are left unmodified.
+ *
+ * This must be called prior to building the image's Objective-C index via plcrash_nasync_objc_build_imp_index(); any
+ * existing index will not include methods found via the shared cache's selector base.
+ *
+ * @param cache An initialized shared cache reader.
+ * @param image The image to which the optimization data should be applied.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_async_objc_shared_cache_apply (const plcrash_async_objc_shared_cache_t *cache, plcrash_async_macho_t *image) {
+    if (cache->selector_base == 0)
+        return;
+
+    if ((image->byteorder->swap32(image->header.flags) & MH_DYLIB_IN_CACHE) == 0)
+        return;
+
+    image->objc_selector_base = cache->selector_base;
+}
@@ -35,6 +35,7 @@ extern "C" {
 
 #include "PLCrashAsyncMachOImage.h"
 #include "PLCrashAsyncMachOString.h"
+#include "PLCrashAsyncAllocator.h"
     
 /**
  * @internal
@@ -46,24 +47,33 @@ extern "C" {
 /**
  * @internal
  *
- * Caches Objective-C data across API calls.
+ * The number of images for which Objective-C section mappings will be retained by a plcrash_async_objc_cache_t.
+ */
+#define PLCRASH_ASYNC_OBJC_CACHE_IMAGE_COUNT 4
+
+/**
+ * @internal
  *
- * This is used to speed up ObjC parsing.
+ * The size, in bytes, of the scratch buffer used to copy method lists that can not be mapped from an image's
+ * __objc_const section. Larger lists are copied in multiple chunks.
+ */
+#define PLCRASH_ASYNC_OBJC_METHOD_SCRATCH_SIZE 1536
+
+/**
+ * @internal
  *
- * @warning It is invalid to reuse this context for multiple Mach tasks.
- * @warning Any plcrash_async_macho_t pointers passed in must be valid across all
- * calls using this context.
+ * Objective-C section mappings for a single image, as cached by plcrash_async_objc_cache_t.
  */
-typedef struct plcrash_async_objc_cache {
-    /**
-     * Whether any ObjC info has ever been successfully obtained. If it has, then
-     * ObjC1 info can be skipped.
-     */
-    bool gotObjC2Info;
-    
-    /** The last MachO image seen. The image for which the memory objects below are valid. */
-    plcrash_async_macho_t *lastImage;
-    
+typedef struct plcrash_async_objc_cache_image {
+    /** The image for which the memory objects below are valid, or NULL if this entry is unused. */
+    plcrash_async_macho_t *image;
+
+    /** If true, the image was found to contain no ObjC2 section data, and no memory objects are initialized. */
+    bool notFound;
+
+    /** Value of the owning cache's use counter at the time of this entry's last use. Used for LRU eviction. */
+    uint64_t lastUsed;
+
     /** Whether the objcConst object is initialized. */
     bool objcConstMobjInitialized;
     
@@ -81,17 +91,105 @@ typedef struct plcrash_async_objc_cache {
     
     /** A memory object for the __objc_data section. */
     plcrash_async_mobject_t objcDataMobj;
+
+    /** Whether the selrefs object is initialized. The section is optional; relative method lists reference it. */
+    bool selrefsMobjInitialized;
+
+    /** A memory object for the __objc_selrefs section. */
+    plcrash_async_mobject_t selrefsMobj;
+} plcrash_async_objc_cache_image_t;
+
+/**
+ * @internal
+ *
+ * Caches Objective-C data across API calls.
+ *
+ * This is used to speed up ObjC parsing.
+ *
+ * @warning It is invalid to reuse this context for multiple Mach tasks.
+ * @warning Any plcrash_async_macho_t pointers passed in must be valid across all
+ * calls using this context.
+ */
+typedef struct plcrash_async_objc_cache {
+    /**
+     * Whether any ObjC info has ever been successfully obtained. If it has, then
+     * ObjC1 info can be skipped.
+     */
+    bool gotObjC2Info;
+    
+    /** The last MachO image seen. The image for which the @a current section mappings are valid. */
+    plcrash_async_macho_t *lastImage;
+
+    /** The section mappings for @a lastImage, or NULL if @a lastImage is NULL. */
+    plcrash_async_objc_cache_image_t *current;
+
+    /** Section mappings for the most recently used images. */
+    plcrash_async_objc_cache_image_t images[PLCRASH_ASYNC_OBJC_CACHE_IMAGE_COUNT];
+
+    /** Monotonically increasing counter used to order @a images by last use. */
+    uint64_t imageUseCounter;
     
-    /** The size of the class cache, in entries. */
+    /** The allocator backing the class cache, or NULL if the cache has not been allocated. */
+    plcrash_async_allocator_t *classCacheAllocator;
+
+    /** The size of the class cache, in entries. This is always zero or a power of two. */
     size_t classCacheSize;
+
+    /** The number of entries currently stored in the class cache. */
+    size_t classCacheCount;
     
-    /** Array of class cache keys. These are class data pointers. */
+    /** Open-addressed (linear probing) array of class cache keys. These are class data pointers; empty buckets are 0. */
     pl_vm_address_t *classCacheKeys;
     
-    /** Array of class cache values. These are pointers to class_ro data. */
+    /** Array of class cache values, indexed identically to @a classCacheKeys. These are pointers to class_ro data. */
     pl_vm_address_t *classCacheValues;
+
+    /** The number of class cache lookups that found a cached value. */
+    size_t classCacheHits;
+
+    /** The number of class cache lookups that did not find a cached value. */
+    size_t classCacheMisses;
+
+    /** Scratch buffer into which method list entries are copied when they can not be mapped from __objc_const. */
+    uint8_t methodScratch[PLCRASH_ASYNC_OBJC_METHOD_SCRATCH_SIZE];
 } plcrash_async_objc_cache_t;
 
+/**
+ * @internal
+ *
+ * An Objective-C IMP index entry, as returned by plcrash_nasync_objc_build_imp_index().
+ */
+typedef struct plcrash_async_objc_imp_index_entry {
+    /** The method's IMP. */
+    pl_vm_address_t imp;
+
+    /** The address of the method's class name. */
+    pl_vm_address_t classNameAddress;
+
+    /** The address of the method's name. */
+    pl_vm_address_t methodNameAddress;
+
+    /** If true, the method is a class (rather than an instance) method. */
+    bool isClassMethod;
+} plcrash_async_objc_imp_index_entry_t;
+
+/**
+ * @internal
+ *
+ * An IMP-sorted index of an image's Objective-C methods, used to avoid a linear search of the image's
+ * Objective-C class data at crash time.
+ */
+typedef struct plcrash_async_objc_imp_index {
+    /** The allocator backing this index (including this structure). */
+    plcrash_async_allocator_t *allocator;
+
+    /** The number of entries in @a entries. */
+    uint32_t count;
+
+    /** Index entries, sorted by IMP. Each IMP is unique. The array is allocated with space for all entries. */
+    plcrash_async_objc_imp_index_entry_t entries[1];
+} plcrash_async_objc_imp_index_t;
+
 plcrash_error_t plcrash_async_objc_cache_init (plcrash_async_objc_cache_t *context);
 void plcrash_async_objc_cache_free (plcrash_async_objc_cache_t *context);
 
@@ -107,6 +205,24 @@ void plcrash_async_objc_cache_free (plcrash_async_objc_cache_t *context);
 typedef void (*plcrash_async_objc_found_method_cb)(bool isClassMethod, plcrash_async_macho_string_t *className, plcrash_async_macho_string_t *methodName, pl_vm_address_t imp, void *ctx);
 
 plcrash_error_t plcrash_async_objc_find_method (plcrash_async_macho_t *image, plcrash_async_objc_cache_t *cache, pl_vm_address_t imp, plcrash_async_objc_found_method_cb callback, void *ctx);
+
+bool plcrash_async_objc_imp_range (plcrash_async_macho_t *image, pl_vm_address_t *min_imp, pl_vm_address_t *max_imp);
+
+plcrash_error_t plcrash_nasync_objc_build_imp_index (plcrash_async_macho_t *image);
+
+/**
+ * @internal
+ *
+ * The dyld shared cache's precomputed Objective-C optimization data, as read by
+ * plcrash_nasync_objc_shared_cache_init().
+ */
+typedef struct plcrash_async_objc_shared_cache {
+    /** The task-relative address of the cache's relative method selector base, or 0 if unavailable. */
+    pl_vm_address_t selector_base;
+} plcrash_async_objc_shared_cache_t;
+
+plcrash_error_t plcrash_nasync_objc_shared_cache_init (plcrash_async_objc_shared_cache_t *cache, task_t task, pl_vm_address_t cache_base);
+void plcrash_async_objc_shared_cache_apply (const plcrash_async_objc_shared_cache_t *cache, plcrash_async_macho_t *image);
     
 /**
  * @}
@@ -31,6 +31,7 @@
 #import <dlfcn.h>
 #import <mach-o/dyld.h>
 #import <mach-o/getsect.h>
+#import <mach-o/dyld_images.h>
 
 #include "PLCrashAsyncObjCSection.h"
 
@@ -242,6 +243,210 @@ static void ParseCallbackTrampoline(bool isClassMethod, plcrash_async_macho_stri
     plcrash_async_objc_cache_free(&objCContext);
 }
 
+/**
+ * Verify that the class cache is sized from the class list, and that repeated lookups are served from the cache.
+ */
+- (void) testClassCache {
+    plcrash_async_objc_cache_t objCContext;
+    STAssertEquals(plcrash_async_objc_cache_init(&objCContext), PLCRASH_ESUCCESS, @"pl_async_objc_context_init failed");
+
+    /* Perform an initial lookup; this should populate the cache */
+    pl_vm_address_t pc = [self addressInCategory];
+    STAssertEquals(plcrash_async_objc_find_method(&_image, &objCContext, pc, NULL, NULL), PLCRASH_ESUCCESS, @"ObjC parse failed");
+
+    STAssertTrue(objCContext.classCacheSize > 0, @"Class cache was not allocated");
+    STAssertEquals((size_t)0, objCContext.classCacheSize & (objCContext.classCacheSize - 1), @"Class cache size is not a power of two");
+    STAssertTrue(objCContext.classCacheCount > 0, @"Class cache was not populated");
+    STAssertTrue(objCContext.classCacheCount <= objCContext.classCacheSize / 2, @"Class cache was not sized for the image's classes");
+    STAssertTrue(objCContext.classCacheMisses > 0, @"Initial lookups should miss");
+
+    /* A second lookup should be served from the cache */
+    size_t hits = objCContext.classCacheHits;
+    size_t misses = objCContext.classCacheMisses;
+    size_t count = objCContext.classCacheCount;
+    STAssertEquals(plcrash_async_objc_find_method(&_image, &objCContext, pc, NULL, NULL), PLCRASH_ESUCCESS, @"ObjC parse failed");
+    STAssertEquals(count, objCContext.classCacheHits - hits, @"All cached classes should have been hit");
+    STAssertTrue(objCContext.classCacheMisses - misses <= misses, @"Cached classes were missed");
+
+    plcrash_async_objc_cache_free(&objCContext);
+}
+
+/**
+ * Verify that section mappings are retained when lookups alternate between images.
+ */
+- (void) testSectionMappingCache {
+    plcrash_async_objc_cache_t objCContext;
+    plcrash_async_macho_t otherImage;
+    Dl_info info;
+
+    STAssertEquals(plcrash_async_objc_cache_init(&objCContext), PLCRASH_ESUCCESS, @"pl_async_objc_context_init failed");
+
+    /* Use Foundation as our second image */
+    STAssertTrue(dladdr([NSString class], &info) > 0, @"Could not fetch dyld info for %p", [NSString class]);
+    STAssertEquals(plcrash_nasync_macho_init(&otherImage, mach_task_self(), info.dli_fname, (pl_vm_address_t) info.dli_fbase), PLCRASH_ESUCCESS, @"Failed to initialize image");
+
+    /* Map our image, and record its cache entry */
+    pl_vm_address_t pc = [self addressInCategory];
+    STAssertEquals(plcrash_async_objc_find_method(&_image, &objCContext, pc, NULL, NULL), PLCRASH_ESUCCESS, @"ObjC parse failed");
+    plcrash_async_objc_cache_image_t *entry = objCContext.current;
+    STAssertNotNULL(entry, @"No current image entry");
+    STAssertEquals(entry->image, &_image, @"Incorrect current image");
+    pl_vm_address_t mappedAddress = entry->objcConstMobj.address;
+
+    /* Switch to an alternate image, and then back again. The original mappings should be reused. */
+    plcrash_async_objc_find_method(&otherImage, &objCContext, (pl_vm_address_t) [NSString instanceMethodForSelector: @selector(length)], NULL, NULL);
+    STAssertEquals(plcrash_async_objc_find_method(&_image, &objCContext, pc, NULL, NULL), PLCRASH_ESUCCESS, @"ObjC parse failed");
+    STAssertEquals(objCContext.current, entry, @"Image entry was not retained");
+    STAssertEquals(entry->objcConstMobj.address, mappedAddress, @"Section was remapped");
+
+    plcrash_async_objc_cache_free(&objCContext);
+    plcrash_nasync_macho_free(&otherImage);
+}
+
+/**
+ * Test method lookup via an IMP index.
+ */
+- (void) testFindMethodIndexed {
+    plcrash_error_t err;
+
+    plcrash_async_objc_cache_t objCContext;
+    err = plcrash_async_objc_cache_init(&objCContext);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"pl_async_objc_context_init failed");
+
+    /* Build the index */
+    STAssertEquals(plcrash_nasync_objc_build_imp_index(&_image), PLCRASH_ESUCCESS, @"Failed to build IMP index");
+    STAssertNotNULL(_image.objc_index, @"IMP index was not published");
+    STAssertTrue(_image.objc_index->count > 0, @"IMP index is empty");
+
+    /* Verify that the index is sorted and free of duplicates */
+    for (uint32_t i = 1; i < _image.objc_index->count; i++)
+        STAssertTrue(_image.objc_index->entries[i-1].imp < _image.objc_index->entries[i].imp, @"IMP index is not sorted");
+
+    /* Look up an instance method and a class method; these must match the results of the non-indexed search */
+    struct {
+        pl_vm_address_t pc;
+        pl_vm_address_t imp;
+        NSString *methodName;
+        bool isClassMethod;
+    } lookups[] = {
+        { [self addressInCategory], (pl_vm_address_t) [self methodForSelector: @selector(addressInCategory)], @"addressInCategory", false },
+        { [[self class] addressInClassMethod], (pl_vm_address_t) [[self class] methodForSelector: @selector(addressInClassMethod)], @"addressInClassMethod", true }
+    };
+
+    for (size_t i = 0; i < sizeof(lookups) / sizeof(lookups[0]); i++) {
+        __block BOOL didCall = NO;
+        err = plcrash_async_objc_find_method(&_image, &objCContext, lookups[i].pc, ParseCallbackTrampoline, ^(bool isClassMethod, plcrash_async_macho_string_t *className, plcrash_async_macho_string_t *methodName, pl_vm_address_t imp, void *ctx) {
+            didCall = YES;
+
+            pl_vm_size_t methodNameLength;
+            const char *methodNamePtr;
+            STAssertEquals(plcrash_async_macho_string_get_length(methodName, &methodNameLength), PLCRASH_ESUCCESS, @"Failed to get length");
+            STAssertEquals(plcrash_async_macho_string_get_pointer(methodName, &methodNamePtr), PLCRASH_ESUCCESS, @"Failed to get pointer");
+
+            NSString *methodNameNS = [NSString stringWithFormat: @"%.*s", (int)methodNameLength, methodNamePtr];
+            STAssertEquals(isClassMethod, lookups[i].isClassMethod, @"Incorrect method type");
+            STAssertEqualObjects(methodNameNS, lookups[i].methodName, @"Method names don't match");
+            STAssertEquals(imp, lookups[i].imp, @"Method IMPs don't match");
+        });
+        STAssertTrue(didCall, @"Method find callback never got called");
+        STAssertEquals(err, PLCRASH_ESUCCESS, @"Indexed ObjC lookup failed");
+    }
+
+    plcrash_async_objc_cache_free(&objCContext);
+}
+
+/**
+ * Test recording of the image's IMP range.
+ */
+- (void) testIMPRange {
+    plcrash_async_objc_cache_t objCContext;
+    pl_vm_address_t min_imp;
+    pl_vm_address_t max_imp;
+
+    STAssertEquals(plcrash_async_objc_cache_init(&objCContext), PLCRASH_ESUCCESS, @"pl_async_objc_context_init failed");
+
+    /* The range is unknown until the image has been parsed */
+    STAssertFalse(plcrash_async_objc_imp_range(&_image, &min_imp, &max_imp), @"IMP range reported prior to parsing");
+
+    pl_vm_address_t pc = [self addressInCategory];
+    plcrash_error_t err = plcrash_async_objc_find_method(&_image, &objCContext, pc, ParseCallbackTrampoline, ^(bool isClassMethod, plcrash_async_macho_string_t *className, plcrash_async_macho_string_t *methodName, pl_vm_address_t imp, void *ctx) {});
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"ObjC lookup failed");
+
+    /* The range must contain the matched method */
+    STAssertTrue(plcrash_async_objc_imp_range(&_image, &min_imp, &max_imp), @"IMP range not recorded");
+    pl_vm_address_t imp = (pl_vm_address_t) [self methodForSelector: @selector(addressInCategory)];
+    STAssertTrue(min_imp <= imp && imp <= max_imp, @"IMP range does not include a known method");
+
+    /* Addresses below the range can not match */
+    if (min_imp > 0) {
+        err = plcrash_async_objc_find_method(&_image, &objCContext, min_imp - 1, ParseCallbackTrampoline, ^(bool isClassMethod, plcrash_async_macho_string_t *className, plcrash_async_macho_string_t *methodName, pl_vm_address_t imp, void *ctx) {
+            STFail(@"Unexpected match below the IMP range");
+        });
+        STAssertEquals(err, PLCRASH_ENOTFOUND, @"Lookup below the IMP range did not fail");
+    }
+
+    plcrash_async_objc_cache_free(&objCContext);
+}
+
+/**
+ * Test reading of the shared cache's Objective-C optimization data, and its use in resolving the direct selectors of
+ * a system image's method lists.
+ */
+- (void) testSharedCacheSelectors {
+    struct task_dyld_info dyld_info;
+    mach_msg_type_number_t count = TASK_DYLD_INFO_COUNT;
+    STAssertEquals(task_info(mach_task_self(), TASK_DYLD_INFO, (task_info_t) &dyld_info, &count), KERN_SUCCESS, @"Failed to fetch dyld info");
+
+    const struct dyld_all_image_infos *infos = (const struct dyld_all_image_infos *) (uintptr_t) dyld_info.all_image_info_addr;
+    if (infos->version < 15 || infos->sharedCacheBaseAddress == 0)
+        return;
+
+    /* Older caches do not provide a supported optimization header */
+    plcrash_async_objc_shared_cache_t cache;
+    plcrash_error_t err = plcrash_nasync_objc_shared_cache_init(&cache, mach_task_self(), (pl_vm_address_t) infos->sharedCacheBaseAddress);
+    if (err == PLCRASH_ENOTSUP)
+        return;
+
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to read the shared cache's optimization data");
+    STAssertTrue(cache.selector_base != 0, @"No selector base was found");
+
+    /* Images outside of the shared cache are not modified */
+    plcrash_async_objc_shared_cache_apply(&cache, &_image);
+    STAssertEquals(_image.objc_selector_base, (pl_vm_address_t) 0, @"Selector base applied to an image outside the shared cache");
+
+    /* Look up a method implemented by libobjc */
+    pl_vm_address_t imp = (pl_vm_address_t) [NSObject instanceMethodForSelector: @selector(isProxy)];
+    Dl_info info;
+    STAssertTrue(dladdr((void *) (uintptr_t) imp, &info) > 0, @"Could not find the image containing -[NSObject isProxy]");
+
+    plcrash_async_macho_t image;
+    STAssertEquals(plcrash_nasync_macho_init(&image, mach_task_self(), info.dli_fname, (pl_vm_address_t) info.dli_fbase), PLCRASH_ESUCCESS, @"Failed to initialize Mach-O image");
+
+    plcrash_async_objc_shared_cache_apply(&cache, &image);
+    if (image.objc_selector_base != 0) {
+        plcrash_async_objc_cache_t objCContext;
+        STAssertEquals(plcrash_async_objc_cache_init(&objCContext), PLCRASH_ESUCCESS, @"pl_async_objc_context_init failed");
+
+        __block BOOL didCall = NO;
+        err = plcrash_async_objc_find_method(&image, &objCContext, imp, ParseCallbackTrampoline, ^(bool isClassMethod, plcrash_async_macho_string_t *className, plcrash_async_macho_string_t *methodName, pl_vm_address_t foundIMP, void *ctx) {
+            pl_vm_size_t methodNameLength;
+            const char *methodNamePtr;
+            STAssertEquals(plcrash_async_macho_string_get_length(methodName, &methodNameLength), PLCRASH_ESUCCESS, @"Failed to get length");
+            STAssertEquals(plcrash_async_macho_string_get_pointer(methodName, &methodNamePtr), PLCRASH_ESUCCESS, @"Failed to get pointer");
+
+            STAssertEqualObjects([NSString stringWithFormat: @"%.*s", (int)methodNameLength, methodNamePtr], @"isProxy", @"Incorrect method name");
+            STAssertEquals(foundIMP, imp, @"Method IMPs don't match");
+            didCall = YES;
+        });
+        STAssertEquals(err, PLCRASH_ESUCCESS, @"ObjC lookup failed");
+        STAssertTrue(didCall, @"Method find callback never got called");
+
+        plcrash_async_objc_cache_free(&objCContext);
+    }
+
+    plcrash_nasync_macho_free(&image);
+}
+
 @end
 
 @implementation PLCrashAsyncObjCSectionTests (Category)
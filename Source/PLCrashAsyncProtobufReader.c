@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncProtobufReader.h"
+
+#include <string.h>
+#include <libkern/OSByteOrder.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_async_pb_reader
+ * @{
+ */
+
+/** The crash log file magic; see PLCRASH_REPORT_FILE_MAGIC. */
+#define REPORT_FILE_MAGIC "plcrash"
+
+/** The size of the crash log file header (magic and version byte); see struct PLCrashReportFileHeader. */
+#define REPORT_FILE_HEADER_SIZE 8
+
+/**
+ * Initialize @a reader to iterate the fields of the encoded message @a data.
+ *
+ * @param reader The reader to initialize.
+ * @param data The encoded message. This buffer must remain valid for the lifetime of the reader, and of any values
+ * returned by the reader.
+ * @param length The length of @a data.
+ *
+ * @warning This method is async-safe.
+ */
+void plcrash_async_pb_reader_init (plcrash_async_pb_reader_t *reader, const void *data, size_t length) {
+    reader->p = data;
+    reader->end = reader->p + length;
+}
+
+/**
+ * Initialize @a reader to iterate the top-level fields of the uncompressed crash log @a data, validating and
+ * skipping the crash log file header.
+ *
+ * @param reader The reader to initialize.
+ * @param data The crash log data, including the crash log file header.
+ * @param length The length of @a data.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if @a data does not begin with a valid crash log
+ * file header.
+ *
+ * @warning This method is async-safe.
+ */
+plcrash_error_t plcrash_async_pb_reader_init_report (plcrash_async_pb_reader_t *reader, const void *data, size_t length) {
+    if (length < REPORT_FILE_HEADER_SIZE || memcmp(data, REPORT_FILE_MAGIC, strlen(REPORT_FILE_MAGIC)) != 0) {
+        PLCF_DEBUG("Invalid crash report header");
+        return PLCRASH_EINVAL;
+    }
+
+    plcrash_async_pb_reader_init(reader, (const uint8_t *) data + REPORT_FILE_HEADER_SIZE, length - REPORT_FILE_HEADER_SIZE);
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Read a varint from @a reader. Returns false if the encoding is invalid or truncated.
+ */
+static bool read_varint (plcrash_async_pb_reader_t *reader, uint64_t *value) {
+    uint64_t result = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        if (reader->p >= reader->end)
+            return false;
+
+        uint8_t b = *reader->p++;
+        result |= (uint64_t) (b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Read a varint of at most eight bytes from @a reader, which must have at least eight bytes remaining. The eight
+ * bytes are loaded as a single word, the terminating byte is located from the word's continuation bits, and the
+ * 7-bit groups are compacted with a fixed sequence of masks and shifts. Returns false if the varint is longer than
+ * eight bytes, in which case the reader is not advanced.
+ */
+static inline bool read_varint_word (plcrash_async_pb_reader_t *reader, uint64_t *value) {
+    uint64_t word;
+    memcpy(&word, reader->p, sizeof(word));
+    word = OSSwapLittleToHostInt64(word);
+
+    /* The lowest clear continuation bit marks the final byte; stop ^ (stop - 1) masks all bits up to and including
+     * that byte */
+    uint64_t stop = ~word & 0x8080808080808080ULL;
+    if (stop == 0)
+        return false;
+
+    uint64_t x = word & (stop ^ (stop - 1)) & 0x7F7F7F7F7F7F7F7FULL;
+    x = (x & 0x007F007F007F007FULL) | ((x & 0x7F007F007F007F00ULL) >> 1);
+    x = (x & 0x00003FFF00003FFFULL) | ((x & 0x3FFF00003FFF0000ULL) >> 2);
+    x = (x & 0x000000000FFFFFFFULL) | ((x & 0x0FFFFFFF00000000ULL) >> 4);
+
+    reader->p += (__builtin_ctzll(stop) >> 3) + 1;
+    *value = x;
+    return true;
+}
+
+/**
+ * Read a little-endian fixed-width value of @a size bytes from @a reader.
+ */
+static bool read_fixed (plcrash_async_pb_reader_t *reader, size_t size, uint64_t *value) {
+    if ((size_t) (reader->end - reader->p) < size)
+        return false;
+
+    uint64_t result = 0;
+    for (size_t i = 0; i < size; i++)
+        result |= (uint64_t) reader->p[i] << (i * 8);
+
+    reader->p += size;
+    *value = result;
+    return true;
+}
+
+/**
+ * Read the next field from @a reader. If the field is length-prefixed, its data is skipped, and returned via
+ * @a field as a new reader.
+ *
+ * @param reader The reader from which the field will be read.
+ * @param field On success, the decoded field.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if no further fields remain, or PLCRASH_EINVAL if the
+ * encoded data is invalid or truncated.
+ *
+ * @warning This method is async-safe.
+ */
+plcrash_error_t plcrash_async_pb_reader_next (plcrash_async_pb_reader_t *reader, plcrash_async_pb_field_t *field) {
+    uint64_t key;
+
+    if (reader->p >= reader->end)
+        return PLCRASH_ENOTFOUND;
+
+    if (!read_varint(reader, &key))
+        return PLCRASH_EINVAL;
+
+    field->id = (uint32_t) (key >> 3);
+    field->wire_type = (plcrash_pb_wire_type_t) (key & 0x7);
+    field->value = 0;
+    field->data.p = field->data.end = NULL;
+
+    switch (field->wire_type) {
+        case PLCRASH_PB_WIRE_TYPE_VARINT:
+            return read_varint(reader, &field->value) ? PLCRASH_ESUCCESS : PLCRASH_EINVAL;
+
+        case PLCRASH_PB_WIRE_TYPE_64BIT:
+            return read_fixed(reader, 8, &field->value) ? PLCRASH_ESUCCESS : PLCRASH_EINVAL;
+
+        case PLCRASH_PB_WIRE_TYPE_32BIT:
+            return read_fixed(reader, 4, &field->value) ? PLCRASH_ESUCCESS : PLCRASH_EINVAL;
+
+        case PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED: {
+            uint64_t len;
+            if (!read_varint(reader, &len) || len > (uint64_t) (reader->end - reader->p))
+                return PLCRASH_EINVAL;
+
+            field->data.p = reader->p;
+            field->data.end = reader->p + len;
+            reader->p += len;
+            return PLCRASH_ESUCCESS;
+        }
+
+        default:
+            /* Groups are not used by the report format */
+            PLCF_DEBUG("Unsupported protobuf wire type %u", (unsigned int) field->wire_type);
+            return PLCRASH_EINVAL;
+    }
+}
+
+/**
+ * Read the next varint from @a reader. This may be used to iterate the elements of a packed repeated varint field,
+ * given a reader over the field's data.
+ *
+ * @param reader The reader from which the value will be read.
+ * @param value On success, the decoded value.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if no further values remain, or PLCRASH_EINVAL if
+ * the encoded data is invalid or truncated.
+ *
+ * @warning This method is async-safe.
+ */
+plcrash_error_t plcrash_async_pb_reader_next_varint (plcrash_async_pb_reader_t *reader, uint64_t *value) {
+    if (reader->p >= reader->end)
+        return PLCRASH_ENOTFOUND;
+
+    return read_varint(reader, value) ? PLCRASH_ESUCCESS : PLCRASH_EINVAL;
+}
+
+/**
+ * Read up to @a capacity consecutive varints from @a reader, as used to decode the elements of a packed repeated
+ * varint field in bulk. Values of up to 56 bits that are followed by at least eight bytes of data are decoded a word
+ * at a time; the remainder are decoded bytewise.
+ *
+ * @param reader The reader from which the values will be read.
+ * @param values On success, the decoded values.
+ * @param capacity The capacity of @a values. Must be non-zero.
+ * @param count On success, the number of values written to @a values.
+ *
+ * @return Returns PLCRASH_ESUCCESS if at least one value was read, PLCRASH_ENOTFOUND if no further values remain, or
+ * PLCRASH_EINVAL if the encoded data is invalid or truncated.
+ *
+ * @warning This method is async-safe.
+ */
+plcrash_error_t plcrash_async_pb_reader_next_varints (plcrash_async_pb_reader_t *reader, uint64_t *values, size_t capacity, size_t *count) {
+    size_t n = 0;
+
+    if (reader->p >= reader->end)
+        return PLCRASH_ENOTFOUND;
+
+    while (n < capacity && reader->p < reader->end) {
+        if (reader->end - reader->p >= (ptrdiff_t) sizeof(uint64_t) && read_varint_word(reader, &values[n])) {
+            n++;
+            continue;
+        }
+
+        if (!read_varint(reader, &values[n]))
+            return PLCRASH_EINVAL;
+        n++;
+    }
+
+    *count = n;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @}
+ */
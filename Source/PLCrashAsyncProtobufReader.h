@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_PROTOBUF_READER_H
+#define PLCRASH_ASYNC_PROTOBUF_READER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_async_pb_reader Protobuf Field Reader
+ * @ingroup plcrash_async
+ *
+ * A pull-style reader over the protobuf wire format, used to inspect encoded reports without
+ * decoding them in their entirety.
+ *
+ * Each call to plcrash_async_pb_reader_next() returns the next field of the current message. Length-prefixed
+ * fields (strings, bytes, and submessages) are returned as a reader over the field's data, which may be used to
+ * iterate a submessage's fields; a field that is not of interest is skipped by length, without examining its
+ * contents. No memory is allocated, and all returned string and bytes values reference the encoded data.
+ *
+ * @{
+ */
+
+/** Protobuf wire types. */
+typedef enum {
+    /** A varint-encoded integer, boolean, or enum value. */
+    PLCRASH_PB_WIRE_TYPE_VARINT = 0,
+
+    /** A fixed 64-bit value. */
+    PLCRASH_PB_WIRE_TYPE_64BIT = 1,
+
+    /** A length-prefixed string, bytes, or submessage value. */
+    PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED = 2,
+
+    /** A fixed 32-bit value. */
+    PLCRASH_PB_WIRE_TYPE_32BIT = 5
+} plcrash_pb_wire_type_t;
+
+/**
+ * @internal
+ *
+ * A reader over a single encoded protobuf message.
+ */
+typedef struct plcrash_async_pb_reader {
+    /** The next byte to be read. */
+    const uint8_t *p;
+
+    /** The end of the message. */
+    const uint8_t *end;
+} plcrash_async_pb_reader_t;
+
+/**
+ * @internal
+ *
+ * A single protobuf field, as returned by plcrash_async_pb_reader_next().
+ */
+typedef struct plcrash_async_pb_field {
+    /** The field number. */
+    uint32_t id;
+
+    /** The field's wire type. */
+    plcrash_pb_wire_type_t wire_type;
+
+    /** The field value, if the wire type is not PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED. Fixed-width values are
+     * returned in host byte order. */
+    uint64_t value;
+
+    /** The field data, if the wire type is PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED. */
+    plcrash_async_pb_reader_t data;
+} plcrash_async_pb_field_t;
+
+void plcrash_async_pb_reader_init (plcrash_async_pb_reader_t *reader, const void *data, size_t length);
+plcrash_error_t plcrash_async_pb_reader_init_report (plcrash_async_pb_reader_t *reader, const void *data, size_t length);
+plcrash_error_t plcrash_async_pb_reader_next (plcrash_async_pb_reader_t *reader, plcrash_async_pb_field_t *field);
+plcrash_error_t plcrash_async_pb_reader_next_varint (plcrash_async_pb_reader_t *reader, uint64_t *value);
+plcrash_error_t plcrash_async_pb_reader_next_varints (plcrash_async_pb_reader_t *reader, uint64_t *values, size_t capacity, size_t *count);
+
+/**
+ * Return the length of the data referenced by @a reader, in bytes.
+ */
+static inline size_t plcrash_async_pb_reader_length (const plcrash_async_pb_reader_t *reader) {
+    return (size_t) (reader->end - reader->p);
+}
+
+/**
+ * Decode the zigzag-encoded signed value @a value, as used by sint64 fields.
+ */
+static inline int64_t plcrash_async_pb_zigzag_decode (uint64_t value) {
+    return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_PROTOBUF_READER_H */
@@ -27,6 +27,7 @@
  */
 
 #include "PLCrashAsyncSymbolication.h"
+#include "PLCrashAsyncMetrics.h"
 
 #include <inttypes.h>
 
@@ -37,7 +38,10 @@
  */
 
 /* Maximum symbol name size */
-#define SYMBOL_NAME_BUFLEN 256
+#define SYMBOL_NAME_BUFLEN PLCRASH_ASYNC_SYMBOL_NAME_BUFLEN
+
+/* Maximum number of slots probed in the per-PC result cache before giving up */
+#define PC_CACHE_MAX_PROBE 8
 
 struct symbol_lookup_ctx {
     /** Buffer to which the symbol name should be written. */
@@ -60,9 +64,103 @@ static void objc_symbol_callback (bool isClassMethod, plcrash_async_macho_string
  * @return An error code.
  */
 plcrash_error_t plcrash_async_symbol_cache_init (plcrash_async_symbol_cache_t *cache) {
+    cache->pc_cache = NULL;
+    cache->pc_cache_count = 0;
+
     return plcrash_async_objc_cache_init(&cache->objc_cache);
 }
 
+/**
+ * Attach (or detach) preallocated storage for a per-PC symbol result cache. Once attached, the results of
+ * plcrash_async_find_symbol() -- including failed look-ups -- are recorded by PC, and repeated look-ups of the same
+ * PC (such as the mach_msg_trap return address shared by most idle threads) are answered without re-reading the
+ * image's symbol table or Objective-C metadata.
+ *
+ * Symbol names are copied into the entries, as the string table mappings used to find them do not outlive the
+ * look-up.
+ *
+ * @param cache The cache to configure.
+ * @param entries The entry storage, or NULL to disable the per-PC cache. The storage will be cleared, and must remain
+ * valid until it is detached or @a cache is freed.
+ * @param count The number of entries in @a entries. Must be a power of two.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if @a count is not a power of two.
+ */
+plcrash_error_t plcrash_async_symbol_cache_set_pc_cache (plcrash_async_symbol_cache_t *cache, plcrash_async_symbol_cache_entry_t *entries, size_t count) {
+    if (entries == NULL || count == 0) {
+        cache->pc_cache = NULL;
+        cache->pc_cache_count = 0;
+        return PLCRASH_ESUCCESS;
+    }
+
+    if ((count & (count - 1)) != 0) {
+        PLCF_DEBUG("Symbol PC cache size %zu is not a power of two", count);
+        return PLCRASH_EINVAL;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        entries[i].pc = 0x0;
+
+    cache->pc_cache = entries;
+    cache->pc_cache_count = count;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Return the initial per-PC cache slot for @a pc.
+ */
+static inline size_t pc_cache_slot (plcrash_async_symbol_cache_t *cache, pl_vm_address_t pc) {
+    /* Fibonacci hashing; PCs are frequently aligned and clustered, which would otherwise collide heavily */
+    uint64_t hash = ((uint64_t) pc) * 0x9E3779B97F4A7C15ULL;
+    return (size_t) (hash >> 32) & (cache->pc_cache_count - 1);
+}
+
+/**
+ * @internal
+ *
+ * Look up @a pc in the per-PC cache, returning the matching entry, or NULL if not found.
+ */
+static plcrash_async_symbol_cache_entry_t *pc_cache_lookup (plcrash_async_symbol_cache_t *cache, plcrash_async_macho_t *image, plcrash_async_symbol_strategy_t strategy, pl_vm_address_t pc) {
+    size_t slot = pc_cache_slot(cache, pc);
+
+    for (size_t i = 0; i < PC_CACHE_MAX_PROBE && i < cache->pc_cache_count; i++) {
+        plcrash_async_symbol_cache_entry_t *entry = &cache->pc_cache[(slot + i) & (cache->pc_cache_count - 1)];
+        if (entry->pc == 0x0)
+            return NULL;
+
+        if (entry->pc == pc && entry->image == image && entry->strategy == strategy)
+            return entry;
+    }
+
+    return NULL;
+}
+
+/**
+ * @internal
+ *
+ * Record the result of looking up @a pc. If all probed slots are in use, the result is not recorded.
+ */
+static void pc_cache_insert (plcrash_async_symbol_cache_t *cache, plcrash_async_macho_t *image, plcrash_async_symbol_strategy_t strategy, pl_vm_address_t pc, struct symbol_lookup_ctx *lookup_ctx) {
+    size_t slot = pc_cache_slot(cache, pc);
+
+    for (size_t i = 0; i < PC_CACHE_MAX_PROBE && i < cache->pc_cache_count; i++) {
+        plcrash_async_symbol_cache_entry_t *entry = &cache->pc_cache[(slot + i) & (cache->pc_cache_count - 1)];
+        if (entry->pc != 0x0)
+            continue;
+
+        entry->image = image;
+        entry->strategy = strategy;
+        entry->found = lookup_ctx->found;
+        entry->symbol_address = lookup_ctx->symbol_address;
+        if (lookup_ctx->found)
+            plcrash_async_memcpy(entry->name, lookup_ctx->buffer, sizeof(entry->name));
+        entry->pc = pc;
+        return;
+    }
+}
+
 /**
  * Free a symbol-finding context object.
  *
@@ -96,20 +194,50 @@ plcrash_error_t plcrash_async_find_symbol (plcrash_async_macho_t *image,
     plcrash_error_t machoErr = PLCRASH_ENOTFOUND;
     plcrash_error_t objcErr = PLCRASH_ENOTFOUND;
 
+    /* Check for a previously recorded result */
+    if (pc != 0x0 && cache->pc_cache != NULL) {
+        plcrash_async_symbol_cache_entry_t *entry = pc_cache_lookup(cache, image, strategy, pc);
+        if (entry != NULL) {
+            if (!entry->found)
+                return PLCRASH_ENOTFOUND;
+
+            callback(entry->symbol_address, entry->name, ctx);
+            return PLCRASH_ESUCCESS;
+        }
+    }
+
     lookup_ctx.symbol_address = 0x0;
     lookup_ctx.found = false;
 
     /* Perform lookups; our callbacks will only update the lookup_ctx if they find a better match than the
      * previously run callbacks */
-    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE)
+    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE) {
+        uint64_t start = plcrash_async_metrics_time_begin();
         machoErr = plcrash_async_macho_find_symbol_by_pc(image, pc, macho_symbol_callback, &lookup_ctx);
+        plcrash_async_metrics_time_end(PLCRASH_ASYNC_METRIC_SYMTAB_TIME, start);
+    }
     
-    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC)
-        objcErr = plcrash_async_objc_find_method(image, &cache->objc_cache, pc, objc_symbol_callback, &lookup_ctx);
+    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC) {
+        /* Skip the ObjC lookup if no method can match pc, or if no method could improve on the symbol table's match. */
+        pl_vm_address_t min_imp;
+        pl_vm_address_t max_imp;
+        bool skip = plcrash_async_objc_imp_range(image, &min_imp, &max_imp) && (pc < min_imp || (lookup_ctx.found && lookup_ctx.symbol_address > max_imp));
+
+        if (!skip) {
+            uint64_t start = plcrash_async_metrics_time_begin();
+            objcErr = plcrash_async_objc_find_method(image, &cache->objc_cache, pc, objc_symbol_callback, &lookup_ctx);
+            plcrash_async_metrics_time_end(PLCRASH_ASYNC_METRIC_OBJC_TIME, start);
+        }
+    }
 
     if (machoErr != PLCRASH_ESUCCESS && objcErr != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Could not find symbol for PC %" PRIx64 " image %p", (uint64_t) pc, image);
         PLCF_DEBUG("pl_async_macho_find_symbol error %d, pl_async_objc_find_method error %d", machoErr, objcErr);
+
+        /* Record the failure; a missing symbol will not appear on a second look-up */
+        if (pc != 0x0 && cache->pc_cache != NULL && machoErr == PLCRASH_ENOTFOUND && objcErr == PLCRASH_ENOTFOUND)
+            pc_cache_insert(cache, image, strategy, pc, &lookup_ctx);
+
         return machoErr;
     }
 
@@ -120,6 +248,9 @@ plcrash_error_t plcrash_async_find_symbol (plcrash_async_macho_t *image,
         return PLCRASH_EINTERNAL;
     }
 
+    if (pc != 0x0 && cache->pc_cache != NULL)
+        pc_cache_insert(cache, image, strategy, pc, &lookup_ctx);
+
     callback(lookup_ctx.symbol_address, lookup_ctx.buffer, ctx);
     return PLCRASH_ESUCCESS;
 }
@@ -78,6 +78,34 @@ typedef enum {
     PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL = (PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE|PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC)
 } plcrash_async_symbol_strategy_t;
 
+/** Maximum symbol name size, including the terminating NUL. Longer names are truncated. */
+#define PLCRASH_ASYNC_SYMBOL_NAME_BUFLEN 256
+
+/**
+ * @internal
+ *
+ * A single entry in the per-PC symbol result cache. See plcrash_async_symbol_cache_set_pc_cache().
+ */
+typedef struct plcrash_async_symbol_cache_entry {
+    /** The looked-up PC, or 0x0 if this entry is unused. */
+    pl_vm_address_t pc;
+
+    /** The image that was searched for @a pc. */
+    plcrash_async_macho_t *image;
+
+    /** The strategy used to perform the look-up. */
+    plcrash_async_symbol_strategy_t strategy;
+
+    /** If true, a symbol was found. If false, the look-up failed, and @a symbol_address and @a name are undefined. */
+    bool found;
+
+    /** Address of the discovered symbol. */
+    pl_vm_address_t symbol_address;
+
+    /** The NUL-terminated symbol name. */
+    char name[PLCRASH_ASYNC_SYMBOL_NAME_BUFLEN];
+} plcrash_async_symbol_cache_entry_t;
+
 /**
  * @internal
  *
@@ -90,9 +118,16 @@ typedef enum {
 typedef struct plcrash_async_symbol_cache {
     /** Objective-C look-up cache. */
     plcrash_async_objc_cache_t objc_cache;
+
+    /** Open-addressed per-PC result table, or NULL if disabled. The storage is owned by the caller. */
+    plcrash_async_symbol_cache_entry_t *pc_cache;
+
+    /** The number of entries in @a pc_cache. This is always a power of two. */
+    size_t pc_cache_count;
 } plcrash_async_symbol_cache_t;
 
 plcrash_error_t plcrash_async_symbol_cache_init (plcrash_async_symbol_cache_t *cache);
+plcrash_error_t plcrash_async_symbol_cache_set_pc_cache (plcrash_async_symbol_cache_t *cache, plcrash_async_symbol_cache_entry_t *entries, size_t count);
 void plcrash_async_symbol_cache_free (plcrash_async_symbol_cache_t *cache);
 
 
@@ -144,4 +144,67 @@ void PLCrashAsyncLocalSymbolicationTestsDummyFunction(void) {}
     STAssertEqualCStrings(ctx.name, "_PLCrashAsyncLocalSymbolicationTestsDummyFunction", @"Got wrong symbol name");
 }
 
+/**
+ * Verify that results are recorded in and returned from the per-PC cache.
+ */
+- (void) testPCCache {
+    struct testFindSymbol_cb_ctx ctx = {};
+    plcrash_async_symbol_cache_entry_t entries[4];
+    plcrash_error_t err;
+
+    plcrash_async_symbol_cache_t findContext;
+    err = plcrash_async_symbol_cache_init(&findContext);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to initialize symbol cache");
+
+    STAssertEquals(plcrash_async_symbol_cache_set_pc_cache(&findContext, entries, 3), PLCRASH_EINVAL, @"Accepted a non-power-of-two cache size");
+    err = plcrash_async_symbol_cache_set_pc_cache(&findContext, entries, 4);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to attach PC cache");
+
+    /* Populate the cache */
+    pl_vm_address_t pc = (pl_vm_address_t)PLCrashAsyncLocalSymbolicationTestsDummyFunction;
+    err = plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, &findContext, pc, testFindSymbol_cb, &ctx);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Got error trying to find symbol");
+    free(ctx.name);
+
+    plcrash_async_symbol_cache_entry_t *entry = NULL;
+    for (size_t i = 0; i < 4; i++) {
+        if (entries[i].pc == pc)
+            entry = &entries[i];
+    }
+    STAssertNotNULL(entry, @"Result was not recorded");
+    if (entry == NULL)
+        return;
+
+    STAssertTrue(entry->found, @"Result was not marked as found");
+    STAssertEqualCStrings(entry->name, "_PLCrashAsyncLocalSymbolicationTestsDummyFunction", @"Got wrong cached symbol name");
+
+    /* Modify the entry to verify that the second look-up is answered from the cache */
+    strlcpy(entry->name, "_cached", sizeof(entry->name));
+    err = plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, &findContext, pc, testFindSymbol_cb, &ctx);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Got error trying to find cached symbol");
+    STAssertEquals(ctx.addr, pc, @"Got bad cached address");
+    STAssertEqualCStrings(ctx.name, "_cached", @"Look-up was not answered from the cache");
+    free(ctx.name);
+
+    /* A different strategy must not match the cached entry */
+    err = plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, &findContext, pc, testFindSymbol_cb, &ctx);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Got error trying to find symbol");
+    STAssertEqualCStrings(ctx.name, "_PLCrashAsyncLocalSymbolicationTestsDummyFunction", @"Got wrong symbol name");
+    free(ctx.name);
+
+    /* Cached misses are reported as not found */
+    entry->found = false;
+    err = plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, &findContext, pc, testFindSymbol_cb, &ctx);
+    STAssertEquals(err, PLCRASH_ENOTFOUND, @"Cached miss was not returned");
+
+    /* Detaching the cache restores uncached look-ups */
+    plcrash_async_symbol_cache_set_pc_cache(&findContext, NULL, 0);
+    err = plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, &findContext, pc, testFindSymbol_cb, &ctx);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Got error trying to find symbol");
+    STAssertEqualCStrings(ctx.name, "_PLCrashAsyncLocalSymbolicationTestsDummyFunction", @"Got wrong symbol name");
+    free(ctx.name);
+
+    plcrash_async_symbol_cache_free(&findContext);
+}
+
 @end
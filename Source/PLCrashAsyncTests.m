@@ -28,6 +28,7 @@
 
 #import "GTMSenTestCase.h"
 #import "PLCrashAsync.h"
+#import "PLCrashAsyncMetrics.h"
 
 #import <fcntl.h>
 #import <sys/stat.h>
@@ -121,6 +122,132 @@
     STAssertEquals(PLCRASH_ENOMEM, plcrash_async_task_memcpy(mach_task_self(), PL_VM_ADDRESS_MAX, 1, dest, sizeof(bytes)), @"Bad read was performed");
 }
 
+- (void) testTaskMemcpyCached {
+    plcrash_async_task_read_cache_t cache;
+    uint8_t *bytes = malloc(PLCRASH_ASYNC_TASK_READ_CACHE_SIZE * 3);
+    uint8_t dest[PLCRASH_ASYNC_TASK_READ_CACHE_SIZE * 2];
+
+    for (size_t i = 0; i < PLCRASH_ASYNC_TASK_READ_CACHE_SIZE * 3; i++)
+        bytes[i] = (uint8_t) i;
+
+    plcrash_async_task_read_cache_init(&cache);
+
+    /* Find a block-aligned address within our buffer */
+    pl_vm_address_t base = ((pl_vm_address_t) bytes + PLCRASH_ASYNC_TASK_READ_CACHE_SIZE - 1) & ~((pl_vm_address_t) PLCRASH_ASYNC_TASK_READ_CACHE_SIZE - 1);
+    uint8_t *src = (uint8_t *) base;
+
+    // Verify that a read within a single block succeeds, and populates the cache
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_task_memcpy_cached(&cache, mach_task_self(), base, 16, dest, 8), @"Read failed");
+    STAssertTrue(memcmp(src + 16, dest, 8) == 0, @"Incorrect data returned");
+    STAssertTrue(cache.valid, @"Cache was not populated");
+    STAssertEquals(cache.address, base, @"Cache populated with incorrect block");
+
+    // Verify that a subsequent read in the same block is served from the cache
+    src[32] = 0xFF;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_task_memcpy_cached(&cache, mach_task_self(), base, 32, dest, 1), @"Read failed");
+    STAssertEquals((uint8_t) 32, dest[0], @"Read was not served from the cache");
+
+    // Verify that reads spanning a block boundary are performed directly
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_task_memcpy_cached(&cache, mach_task_self(), base, PLCRASH_ASYNC_TASK_READ_CACHE_SIZE - 4, dest, 8), @"Read failed");
+    STAssertTrue(memcmp(src + PLCRASH_ASYNC_TASK_READ_CACHE_SIZE - 4, dest, 8) == 0, @"Incorrect data returned");
+    STAssertEquals(cache.address, base, @"Spanning read replaced the cached block");
+
+    // Verify that a NULL cache performs a direct read
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_task_memcpy_cached(NULL, mach_task_self(), base, 32, dest, 1), @"Read failed");
+    STAssertEquals((uint8_t) 0xFF, dest[0], @"Incorrect data returned");
+
+    // Verify that bad reads and overflow are handled identically to plcrash_async_task_memcpy()
+    STAssertNotEquals(PLCRASH_ESUCCESS, plcrash_async_task_memcpy_cached(&cache, mach_task_self(), 0, 0, dest, 8), @"Bad read was performed");
+    STAssertEquals(PLCRASH_ENOMEM, plcrash_async_task_memcpy_cached(&cache, mach_task_self(), PL_VM_ADDRESS_MAX, 1, dest, 8), @"Bad read was performed");
+
+    free(bytes);
+}
+
+- (void) testRegionMap {
+    plcrash_async_region_map_t *map = calloc(1, sizeof(*map));
+    plcrash_async_region_map_init(map, mach_task_self());
+
+    /* Overlapping ranges of equal readability are merged; readable ranges take precedence over unreadable ranges */
+    STAssertTrue(plcrash_async_region_map_add(map, 0x4000, 0x5000, true), @"Failed to add range");
+    STAssertTrue(plcrash_async_region_map_add(map, 0x1000, 0x2000, false), @"Failed to add range");
+    STAssertTrue(plcrash_async_region_map_add(map, 0x1800, 0x3000, false), @"Failed to add range");
+    STAssertTrue(plcrash_async_region_map_add(map, 0x4800, 0x6000, false), @"Failed to add range");
+    STAssertFalse(plcrash_async_region_map_add(map, 0x7000, 0x7000, false), @"Empty range should not be added");
+    plcrash_async_region_map_finalize(map);
+
+    STAssertEquals(map->count, (uint32_t) 3, @"Incorrect range count");
+
+    const plcrash_async_region_map_range_t *range;
+    STAssertTrue(plcrash_async_region_map_lookup(map, 0x0FFF) == NULL, @"Unknown address should not be found");
+
+    range = plcrash_async_region_map_lookup(map, 0x2800);
+    STAssertTrue(range != NULL && !range->readable, @"Merged unreadable range not found");
+    STAssertEquals(range->start, (pl_vm_address_t) 0x1000, @"Incorrect merged range start");
+    STAssertEquals(range->end, (pl_vm_address_t) 0x3000, @"Incorrect merged range end");
+
+    STAssertTrue(plcrash_async_region_map_lookup(map, 0x3800) == NULL, @"Unknown address should not be found");
+
+    range = plcrash_async_region_map_lookup(map, 0x4900);
+    STAssertTrue(range != NULL && range->readable, @"Readable range should take precedence");
+
+    range = plcrash_async_region_map_lookup(map, 0x5000);
+    STAssertTrue(range != NULL && !range->readable, @"Trimmed unreadable range not found");
+
+    /* The NULL page is unreadable, and our own stack is readable */
+    uint8_t local = 0;
+    plcrash_async_region_map_init(map, mach_task_self());
+    STAssertEquals(plcrash_async_region_map_add_region(map, 0), PLCRASH_ESUCCESS, @"Failed to look up the NULL page");
+    STAssertEquals(plcrash_async_region_map_add_region(map, (pl_vm_address_t) &local), PLCRASH_ESUCCESS, @"Failed to look up the stack");
+    plcrash_async_region_map_finalize(map);
+
+    range = plcrash_async_region_map_lookup(map, 16);
+    STAssertTrue(range != NULL && !range->readable, @"NULL page should be unreadable");
+    range = plcrash_async_region_map_lookup(map, (pl_vm_address_t) &local);
+    STAssertTrue(range != NULL && range->readable, @"Stack should be readable");
+
+    /* Reads of unreadable ranges fail without a kernel call; readable ranges are read normally */
+    plcrash_async_task_read_cache_t cache;
+    uint8_t dest[8];
+    plcrash_async_task_read_cache_init(&cache);
+    plcrash_async_task_read_cache_set_region_map(&cache, map);
+
+    plcrash_async_metrics_t before;
+    plcrash_async_metrics_t after;
+    plcrash_nasync_metrics_enable();
+    plcrash_async_metrics_snapshot(&before);
+    STAssertEquals(plcrash_async_task_memcpy_cached(&cache, mach_task_self(), 16, 0, dest, sizeof(dest)), PLCRASH_ENOTFOUND, @"Bad read was performed");
+    plcrash_async_metrics_snapshot(&after);
+    plcrash_nasync_metrics_disable();
+    STAssertEquals(after.values[PLCRASH_ASYNC_METRIC_VM_READ_COUNT], before.values[PLCRASH_ASYNC_METRIC_VM_READ_COUNT], @"Read of an unreadable range was issued");
+
+    local = 0xAB;
+    STAssertEquals(plcrash_async_task_memcpy_cached(&cache, mach_task_self(), (pl_vm_address_t) &local, 0, dest, 1), PLCRASH_ESUCCESS, @"Read failed");
+    STAssertEquals(dest[0], (uint8_t) 0xAB, @"Incorrect data returned");
+
+    free(map);
+}
+
+- (void) testTaskMemcpyCachedLearnsUnreadable {
+    plcrash_async_task_read_cache_t cache;
+    uint8_t dest[8];
+
+    /* Reserve an unmapped address */
+    vm_address_t addr;
+    STAssertEquals(vm_allocate(mach_task_self(), &addr, PAGE_SIZE, VM_FLAGS_ANYWHERE), KERN_SUCCESS, @"Failed to allocate page");
+    STAssertEquals(vm_deallocate(mach_task_self(), addr, PAGE_SIZE), KERN_SUCCESS, @"Failed to deallocate page");
+
+    plcrash_async_task_read_cache_init(&cache);
+
+    /* The first failed read records the unmapped range */
+    STAssertNotEquals(plcrash_async_task_memcpy_cached(&cache, mach_task_self(), addr, 0, dest, sizeof(dest)), PLCRASH_ESUCCESS, @"Bad read was performed");
+    STAssertEquals(cache.unreadable_count, (uint32_t) 1, @"Unreadable range was not recorded");
+    STAssertFalse(cache.unreadable[0].readable, @"Recorded range should be unreadable");
+    STAssertTrue(addr >= cache.unreadable[0].start && addr < cache.unreadable[0].end, @"Recorded range does not contain the address");
+
+    /* Subsequent reads within the range fail without a kernel call */
+    STAssertEquals(plcrash_async_task_memcpy_cached(&cache, mach_task_self(), addr, 16, dest, sizeof(dest)), PLCRASH_ENOTFOUND, @"Bad read was performed");
+}
+
 - (void) testTaskReadInt {
     const plcrash_async_byteorder_t *byteorder = &plcrash_async_byteorder_swapped;
     union test_data {
@@ -172,6 +299,42 @@
     STAssertEquals(plcrash_async_strncmp("aaaaaaaaaa", "aaaaaaaaab", 9), 0, @"String prefixes should be equal");
 }
 
+/* Test word-at-a-time comparison of long strings, at every relative alignment. */
+- (void) testStrcmpLongStrings {
+    const char *base = "__objc_methname_and_some_further_padding";
+    char s1[64];
+    char s2[64];
+
+    for (size_t offset = 0; offset < sizeof(uintptr_t); offset++) {
+        strcpy(s1 + offset, base);
+        strcpy(s2, base);
+        STAssertEquals(0, plcrash_async_strcmp(s1 + offset, s2), @"Strings should be equal");
+        STAssertEquals(0, plcrash_async_strncmp(s1 + offset, s2, strlen(base)), @"Strings should be equal");
+
+        /* Differ within the final word */
+        s2[strlen(base) - 1] = 'z';
+        STAssertTrue(plcrash_async_strcmp(s1 + offset, s2) < 0, @"Strings compared incorrectly");
+        STAssertTrue(plcrash_async_strncmp(s1 + offset, s2, strlen(base)) < 0, @"Strings compared incorrectly");
+        STAssertEquals(0, plcrash_async_strncmp(s1 + offset, s2, strlen(base) - 1), @"String prefixes should be equal");
+
+        /* Differ in length */
+        s2[strlen(base) - 1] = '\0';
+        STAssertTrue(plcrash_async_strcmp(s1 + offset, s2) > 0, @"Strings compared incorrectly");
+    }
+}
+
+- (void) testStrnlen {
+    const char *base = "__objc_methname_and_some_further_padding";
+    char s[64];
+
+    for (size_t offset = 0; offset < sizeof(uintptr_t); offset++) {
+        strcpy(s + offset, base);
+        STAssertEquals(strlen(base), plcrash_async_strnlen(s + offset, sizeof(s) - offset), @"Incorrect length");
+        STAssertEquals((size_t) 5, plcrash_async_strnlen(s + offset, 5), @"Length should be limited to maxlen");
+        STAssertEquals((size_t) 0, plcrash_async_strnlen(s + offset, 0), @"Length should be limited to maxlen");
+    }
+}
+
 - (void) testMemcpy {
     size_t size = 1024;
     uint8_t template[size];
@@ -210,6 +373,27 @@
     STAssertTrue(dest[1024] == (uint8_t)0xB, @"Sentinal was overwritten (0x%" PRIX8 ")", dest[1024]);
 }
 
+- (void) testPrefault {
+    vm_size_t size = 4 * PAGE_SIZE;
+    vm_address_t addr;
+
+    STAssertEquals(KERN_SUCCESS, vm_allocate(mach_task_self(), &addr, size, VM_FLAGS_ANYWHERE), @"Failed to allocate test pages");
+    memset((void *) (addr + PAGE_SIZE), 0xAB, PAGE_SIZE);
+
+    /* Prefaulting an unaligned range must leave its contents unmodified */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_prefault((void *) (addr + 1), size - 2, false), @"Prefault failed");
+    STAssertEquals((uint8_t) 0x0, ((uint8_t *) addr)[1], @"Page contents were modified");
+    STAssertEquals((uint8_t) 0xAB, ((uint8_t *) addr)[PAGE_SIZE], @"Page contents were modified");
+
+    /* Wiring is subject to the process' limits; only the result's validity can be verified */
+    plcrash_error_t err = plcrash_nasync_prefault((void *) addr, size, true);
+    STAssertTrue(err == PLCRASH_ESUCCESS || err == PLCRASH_ENOMEM, @"Unexpected prefault result: %d", err);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_prefault(NULL, 0, true), @"Prefault of an empty range failed");
+
+    vm_deallocate(mach_task_self(), addr, size);
+}
+
 - (void) testWriteLimits {
     plcrash_async_file_t file;
     uint32_t data = 1;
@@ -232,6 +416,23 @@
     STAssertEquals((off_t)8, fs.st_size, @"File size is not 8 bytes");
 }
 
+- (void) testSync {
+    plcrash_async_file_t file;
+    uint32_t data = 1;
+
+    plcrash_async_file_init(&file, _testFd, 0);
+    STAssertTrue(plcrash_async_file_write(&file, &data, sizeof(data)), @"Write failed");
+
+    /* Buffered data must be written by the sync, prior to the file being closed */
+    STAssertTrue(plcrash_async_file_sync(&file), @"Sync failed");
+
+    struct stat fs;
+    stat([_outputFile UTF8String], &fs);
+    STAssertEquals((off_t)sizeof(data), fs.st_size, @"Buffered data was not written");
+
+    plcrash_async_file_close(&file);
+}
+
 /*
  * Read in the test file, verify that it matches the given data block. Returns the
  * total number of bytes read (which may be less than the data block, which will
@@ -257,7 +458,7 @@
     unsigned char data[100];
     size_t nread = 0;
     
-    STAssertTrue(sizeof(data) * write_iterations > sizeof(file.buffer), @"Test is invalid if our buffer is not larger");
+    STAssertTrue(sizeof(data) * write_iterations > sizeof(file.default_buffer), @"Test is invalid if our buffer is not larger");
 
     /* Initialize the file instance */
     plcrash_async_file_init(&file, _testFd, 0);
@@ -287,4 +488,132 @@
     [input close];
 }
 
+/**
+ * Verify buffered writes using a caller-supplied buffer, including writes that exceed the buffer's capacity
+ * and must be written directly alongside any pending buffered data.
+ */
+- (void) testBufferedWriteExternalBuffer {
+    plcrash_async_file_t file;
+    char buffer[64];
+    unsigned char data[100];
+    size_t lengths[] = { 10, 40, 100, 20, 64, 1, 100, 63 };
+    size_t nlengths = sizeof(lengths) / sizeof(lengths[0]);
+    size_t nread = 0;
+    size_t expected = 0;
+
+    /* Initialize the file instance */
+    plcrash_async_file_init_buffer(&file, _testFd, 0, buffer, sizeof(buffer));
+    STAssertEquals(file.buffer, buffer, @"External buffer was not used");
+    STAssertEquals(file.buffer_size, sizeof(buffer), @"Incorrect buffer size");
+
+    /* Create test data */
+    for (unsigned char i = 0; i < sizeof(data); i++)
+        data[i] = i;
+
+    /* Write out the test data */
+    for (size_t i = 0; i < nlengths; i++) {
+        STAssertTrue(plcrash_async_file_write(&file, data, lengths[i]), @"Failed to write to output buffer");
+        STAssertTrue(file.buflen <= file.buffer_size, @"Buffer overrun");
+        expected += lengths[i];
+    }
+
+    /* Flush pending data and close the file */
+    STAssertTrue(plcrash_async_file_close(&file), @"File not closed");
+
+    /* Validate the test file */
+    NSInputStream *input = [NSInputStream inputStreamWithFileAtPath: _outputFile];
+    [input open];
+    STAssertEquals((NSStreamStatus)NSStreamStatusOpen, [input streamStatus], @"Could not open input stream %@: %@", _outputFile, [input streamError]);
+
+    for (size_t i = 0; i < nlengths; i++)
+        nread += [self checkTestData: data bytes: lengths[i] inputStream: input];
+
+    STAssertEquals(nread, expected, @"Fewer than expected bytes were written (%zu < %zu)", nread, expected);
+
+    [input close];
+}
+
+/**
+ * Verify patching of previously written bytes, both while buffered and once output.
+ */
+- (void) testPatch {
+    plcrash_async_file_t file;
+    char buffer[16];
+    unsigned char data[40];
+    unsigned char patch[8];
+
+    /* Create test data */
+    for (unsigned char i = 0; i < sizeof(data); i++)
+        data[i] = i;
+    memset(patch, 0xFF, sizeof(patch));
+
+    /* Write the test data through a small buffer, patching a range that spans the output and buffered bytes */
+    plcrash_async_file_init_buffer(&file, _testFd, 0, buffer, sizeof(buffer));
+    STAssertTrue(plcrash_async_file_patchable(&file), @"File should be patchable");
+    STAssertTrue(plcrash_async_file_write(&file, data, 30), @"Failed to write to output buffer");
+    STAssertTrue(plcrash_async_file_write(&file, data + 30, 10), @"Failed to write to output buffer");
+    STAssertEquals(file.position, (off_t) sizeof(data), @"Incorrect position");
+
+    STAssertTrue(plcrash_async_file_patch(&file, 2, patch, 4), @"Failed to patch output bytes");
+    STAssertTrue(plcrash_async_file_patch(&file, 28, patch, 4), @"Failed to patch a spanning range");
+    STAssertTrue(plcrash_async_file_patch(&file, 36, patch, 4), @"Failed to patch buffered bytes");
+    STAssertFalse(plcrash_async_file_patch(&file, 38, patch, 4), @"Patched beyond the written bytes");
+    STAssertTrue(plcrash_async_file_close(&file), @"File not closed");
+
+    memset(data + 2, 0xFF, 4);
+    memset(data + 28, 0xFF, 4);
+    memset(data + 36, 0xFF, 4);
+
+    NSData *output = [NSData dataWithContentsOfFile: _outputFile];
+    STAssertEquals([output length], sizeof(data), @"Incorrect output length");
+    STAssertTrue(memcmp([output bytes], data, sizeof(data)) == 0, @"Incorrect patched output");
+
+    /* The file's checksum must match that of the patched output */
+    plcrash_async_checksum_t checksum;
+    plcrash_async_checksum_init(&checksum);
+    plcrash_async_checksum_update(&checksum, data, sizeof(data));
+    STAssertEquals(plcrash_async_checksum_value(&file.checksum), plcrash_async_checksum_value(&checksum), @"Checksum does not reflect the patched output");
+
+    /* Memory output may also be patched */
+    plcrash_async_file_memory_t memory;
+    uint8_t memory_output[sizeof(data)];
+    plcrash_async_file_init_memory(&file, &memory, memory_output, sizeof(memory_output));
+    STAssertTrue(plcrash_async_file_write(&file, data, sizeof(data)), @"Failed to write to output buffer");
+    STAssertTrue(plcrash_async_file_flush(&file), @"File flush failed");
+    STAssertTrue(plcrash_async_file_patch(&file, 0, patch, 2), @"Failed to patch memory output");
+    STAssertEquals(memory_output[1], (uint8_t) 0xFF, @"Memory output was not patched");
+
+    plcrash_async_checksum_init(&checksum);
+    plcrash_async_checksum_update(&checksum, memory_output, sizeof(memory_output));
+    STAssertEquals(plcrash_async_checksum_value(&file.checksum), plcrash_async_checksum_value(&checksum), @"Checksum does not reflect the patched memory output");
+}
+
+/**
+ * Verify writes to a caller-provided memory buffer, including enforcement of the buffer's capacity.
+ */
+- (void) testMemoryOutput {
+    plcrash_async_file_t file;
+    plcrash_async_file_memory_t memory;
+    uint8_t output[600];
+    unsigned char data[100];
+
+    /* Create test data */
+    for (unsigned char i = 0; i < sizeof(data); i++)
+        data[i] = i;
+
+    /* Write out the test data; the total exceeds the default inline buffer, exercising the direct write path */
+    plcrash_async_file_init_memory(&file, &memory, output, sizeof(output));
+    for (size_t i = 0; i < 6; i++)
+        STAssertTrue(plcrash_async_file_write(&file, data, sizeof(data)), @"Failed to write to output buffer");
+
+    /* Any further writes exceed the capacity */
+    STAssertFalse(plcrash_async_file_write(&file, data, 1), @"Capacity not enforced");
+    STAssertTrue(plcrash_async_file_close(&file), @"File not closed");
+
+    /* Validate the output */
+    STAssertEquals(memory.length, sizeof(output), @"Incorrect output length");
+    for (size_t i = 0; i < 6; i++)
+        STAssertTrue(memcmp(output + (i * sizeof(data)), data, sizeof(data)) == 0, @"Incorrect data written");
+}
+
 @end
@@ -27,6 +27,7 @@
  */
 
 #include "PLCrashAsyncThread.h"
+#include "PLCrashAsyncTrace.h"
 
 /**
  * @internal
@@ -156,7 +157,7 @@ plcrash_error_t plcrash_async_thread_state_mach_thread_init (plcrash_async_threa
     state_count = ARM_THREAD_STATE_COUNT;
     kr = thread_get_state(thread, ARM_THREAD_STATE, (thread_state_t) &thread_state->arm_state.thread, &state_count);
     if (kr != KERN_SUCCESS) {
-        PLCF_DEBUG("Fetch of ARM thread state failed with Mach error: %d", kr);
+        PLCF_TRACE(PLCRASH_TRACE_THREAD_STATE_FAILED, kr);
         return PLCRASH_EINTERNAL;
     }
     
@@ -168,7 +169,7 @@ plcrash_error_t plcrash_async_thread_state_mach_thread_init (plcrash_async_threa
     state_count = x86_THREAD_STATE_COUNT;
     kr = thread_get_state(thread, x86_THREAD_STATE, (thread_state_t) &thread_state->x86_state.thread, &state_count);
     if (kr != KERN_SUCCESS) {
-        PLCF_DEBUG("Fetch of x86 thread state failed with Mach error: %d", kr);
+        PLCF_TRACE(PLCRASH_TRACE_THREAD_STATE_FAILED, kr);
         return PLCRASH_EINTERNAL;
     }
     
@@ -176,7 +177,7 @@ plcrash_error_t plcrash_async_thread_state_mach_thread_init (plcrash_async_threa
     state_count = x86_EXCEPTION_STATE_COUNT;
     kr = thread_get_state(thread, x86_EXCEPTION_STATE, (thread_state_t) &thread_state->x86_state.exception, &state_count);
     if (kr != KERN_SUCCESS) {
-        PLCF_DEBUG("Fetch of x86 exception state failed with Mach error: %d", kr);
+        PLCF_TRACE(PLCRASH_TRACE_THREAD_STATE_FAILED, kr);
         return PLCRASH_EINTERNAL;
     }
     
@@ -198,6 +199,125 @@ plcrash_error_t plcrash_async_thread_state_mach_thread_init (plcrash_async_threa
     return PLCRASH_ESUCCESS;
 }
 
+/**
+ * Initialize the @a thread_state using only the general purpose register state fetched from the given mach @a thread,
+ * via a single thread_get_state() call. This is sufficient for stack walking and reading the stack pointer, and
+ * should be preferred for threads whose full register state will not be reported. If the thread is not suspended,
+ * the fetched state may be inconsistent.
+ *
+ * On x86, the exception state is not fetched, and the exception registers will be marked as unavailable. On ARM,
+ * this is equivalent to plcrash_async_thread_state_mach_thread_init().
+ *
+ * @param thread_state The thread state to be initialized.
+ * @param thread The thread from which to fetch thread state.
+ *
+ * @return Returns PLFRAME_ESUCCESS on success, or standard plframe_error_t code if an error occurs.
+ */
+plcrash_error_t plcrash_async_thread_state_mach_thread_gpr_init (plcrash_async_thread_state_t *thread_state, thread_t thread) {
+#ifdef PLCRASH_ASYNC_THREAD_ARM_SUPPORT
+    /* The ARM thread state does not include a separately fetched exception state */
+    return plcrash_async_thread_state_mach_thread_init(thread_state, thread);
+#elif defined(PLCRASH_ASYNC_THREAD_X86_SUPPORT)
+    mach_msg_type_number_t state_count;
+    kern_return_t kr;
+
+    /* Fetch the thread state */
+    state_count = x86_THREAD_STATE_COUNT;
+    kr = thread_get_state(thread, x86_THREAD_STATE, (thread_state_t) &thread_state->x86_state.thread, &state_count);
+    if (kr != KERN_SUCCESS) {
+        PLCF_TRACE(PLCRASH_TRACE_THREAD_STATE_FAILED, kr);
+        return PLCRASH_EINTERNAL;
+    }
+
+    /* The exception state is not fetched */
+    memset(&thread_state->x86_state.exception, 0, sizeof(thread_state->x86_state.exception));
+
+    /* Platform meta-data */
+    thread_state->stack_direction = PLCRASH_ASYNC_THREAD_STACK_DIRECTION_DOWN;
+    if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE64) {
+        thread_state->greg_size = 8;
+    } else {
+        thread_state->greg_size = 4;
+    }
+
+    /* Mark all registers as available, excluding those sourced from the exception state */
+    memset(&thread_state->valid_regs, 0xFF, sizeof(thread_state->valid_regs));
+    if (thread_state->greg_size == 4)
+        plcrash_async_thread_state_clear_reg(thread_state, PLCRASH_X86_TRAPNO);
+
+    return PLCRASH_ESUCCESS;
+#else
+#error Add platform support
+#endif
+}
+
+/**
+ * Initialize the @a thread_state using machine thread state that has already been fetched for the given mach
+ * @a thread; for example, the thread state delivered with an EXCEPTION_STATE_IDENTITY exception message. This
+ * avoids fetching the thread's general purpose registers via thread_get_state().
+ *
+ * On x86, the thread's exception state is not included in @a state, and will be fetched from @a thread.
+ *
+ * All registers will be marked as available.
+ *
+ * @param thread_state The thread state to be initialized.
+ * @param thread The thread to which @a state belongs.
+ * @param flavor The flavor of @a state. This must be the target's MACHINE_THREAD_STATE flavor.
+ * @param state The thread state.
+ * @param state_count The number of natural_t values in @a state.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTSUP if @a flavor or @a state_count do not match the
+ * expected machine thread state, or standard plcrash_error_t code if an error occurs.
+ */
+plcrash_error_t plcrash_async_thread_state_mach_state_init (plcrash_async_thread_state_t *thread_state,
+                                                            thread_t thread,
+                                                            thread_state_flavor_t flavor,
+                                                            const natural_t *state,
+                                                            mach_msg_type_number_t state_count)
+{
+#ifdef PLCRASH_ASYNC_THREAD_ARM_SUPPORT
+    if (flavor != ARM_THREAD_STATE || state_count < ARM_THREAD_STATE_COUNT)
+        return PLCRASH_ENOTSUP;
+
+    plcrash_async_memcpy(&thread_state->arm_state.thread, state, ARM_THREAD_STATE_COUNT * sizeof(natural_t));
+
+    /* Platform meta-data */
+    thread_state->stack_direction = PLCRASH_ASYNC_THREAD_STACK_DIRECTION_DOWN;
+    thread_state->greg_size = 4;
+#elif defined(PLCRASH_ASYNC_THREAD_X86_SUPPORT)
+    mach_msg_type_number_t exc_state_count;
+    kern_return_t kr;
+
+    if (flavor != x86_THREAD_STATE || state_count < x86_THREAD_STATE_COUNT)
+        return PLCRASH_ENOTSUP;
+
+    plcrash_async_memcpy(&thread_state->x86_state.thread, state, x86_THREAD_STATE_COUNT * sizeof(natural_t));
+
+    /* Fetch the exception state */
+    exc_state_count = x86_EXCEPTION_STATE_COUNT;
+    kr = thread_get_state(thread, x86_EXCEPTION_STATE, (thread_state_t) &thread_state->x86_state.exception, &exc_state_count);
+    if (kr != KERN_SUCCESS) {
+        PLCF_TRACE(PLCRASH_TRACE_THREAD_STATE_FAILED, kr);
+        return PLCRASH_EINTERNAL;
+    }
+
+    /* Platform meta-data */
+    thread_state->stack_direction = PLCRASH_ASYNC_THREAD_STACK_DIRECTION_DOWN;
+    if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE64) {
+        thread_state->greg_size = 8;
+    } else {
+        thread_state->greg_size = 4;
+    }
+#else
+#error Add platform support
+#endif
+
+    /* Mark all registers as available */
+    memset(&thread_state->valid_regs, 0xFF, sizeof(thread_state->valid_regs));
+
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * Copy thread state @a source to @a dest.
  *
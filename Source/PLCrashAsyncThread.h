@@ -156,6 +156,12 @@ typedef plcrash_pdef_greg_t plcrash_greg_t;
 plcrash_error_t plcrash_async_thread_state_init (plcrash_async_thread_state_t *thread_state, cpu_type_t cpu_type);
 void plcrash_async_thread_state_mcontext_init (plcrash_async_thread_state_t *thread_state, pl_mcontext_t mctx);
 plcrash_error_t plcrash_async_thread_state_mach_thread_init (plcrash_async_thread_state_t *thread_state, thread_t thread);
+plcrash_error_t plcrash_async_thread_state_mach_thread_gpr_init (plcrash_async_thread_state_t *thread_state, thread_t thread);
+plcrash_error_t plcrash_async_thread_state_mach_state_init (plcrash_async_thread_state_t *thread_state,
+                                                            thread_t thread,
+                                                            thread_state_flavor_t flavor,
+                                                            const natural_t *state,
+                                                            mach_msg_type_number_t state_count);
 
 /**
  * Callback function called by plcrash_log_writer_write_curthread().
@@ -243,6 +249,21 @@ bool plcrash_async_thread_state_map_reg_to_dwarf (plcrash_async_thread_state_t *
  */
 bool plcrash_async_thread_state_map_dwarf_to_reg (const plcrash_async_thread_state_t *thread_state, uint64_t dwarf_reg, plcrash_regnum_t *regnum);
 
+#if defined(__i386__) || defined(__x86_64__)
+/*
+ * Flavor-specific implementations of the register accessors above. These allow callers that have already determined
+ * the thread state's flavor to bypass the per-call flavor dispatch; see PLCrashAsyncThreadRegisters.hpp.
+ */
+plcrash_greg_t plcrash_async_thread_state_get_reg_32 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum);
+plcrash_greg_t plcrash_async_thread_state_get_reg_64 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum);
+
+void plcrash_async_thread_state_set_reg_32 (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg);
+void plcrash_async_thread_state_set_reg_64 (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg);
+
+bool plcrash_async_thread_state_map_dwarf_to_reg_32 (uint64_t dwarf_reg, plcrash_regnum_t *regnum);
+bool plcrash_async_thread_state_map_dwarf_to_reg_64 (uint64_t dwarf_reg, plcrash_regnum_t *regnum);
+#endif
+
 /**
  * @}
  */
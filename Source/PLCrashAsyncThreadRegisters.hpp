@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_THREAD_REGISTERS_H
+#define PLCRASH_ASYNC_THREAD_REGISTERS_H 1
+
+#include "PLCrashAsyncThread.h"
+
+namespace plcrash { namespace async {
+
+/**
+ * @internal
+ * @ingroup plcrash_async_thread
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * Register accessors for a single thread state flavor.
+ *
+ * The generic plcrash_async_thread_state_t register API determines the thread state's flavor on every call. Code
+ * that performs many register operations against a single thread state (eg, applying unwind rules) may instead
+ * determine the flavor once, and then instantiate its implementation against the matching accessor type; each
+ * accessor resolves directly to the flavor's implementation at compile time.
+ *
+ * All accessor types provide the same static interface:
+ *
+ * - greg_size: The size of a general purpose register, in bytes.
+ * - has_reg(), get_reg(), set_reg(): Equivalent to the plcrash_async_thread_state_t functions of the same name.
+ * - map_dwarf_to_reg(): Equivalent to plcrash_async_thread_state_map_dwarf_to_reg().
+ *
+ * The caller is responsible for verifying that the thread state's flavor matches the accessor type.
+ */
+class thread_state_generic_regs {
+public:
+    static bool has_reg (const plcrash_async_thread_state_t *ts, plcrash_regnum_t regnum) {
+        return (ts->valid_regs & (1 << regnum)) != 0;
+    }
+
+    static plcrash_greg_t get_reg (const plcrash_async_thread_state_t *ts, plcrash_regnum_t regnum) {
+        return plcrash_async_thread_state_get_reg(ts, regnum);
+    }
+
+    static void set_reg (plcrash_async_thread_state_t *ts, plcrash_regnum_t regnum, plcrash_greg_t reg) {
+        plcrash_async_thread_state_set_reg(ts, regnum, reg);
+    }
+
+    static bool map_dwarf_to_reg (const plcrash_async_thread_state_t *ts, uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
+        return plcrash_async_thread_state_map_dwarf_to_reg(ts, dwarf_reg, regnum);
+    }
+};
+
+#if defined(__i386__) || defined(__x86_64__)
+
+/**
+ * @internal
+ * Register accessors for x86_THREAD_STATE32 thread states.
+ */
+class thread_state_x86_32_regs : public thread_state_generic_regs {
+public:
+    static const size_t greg_size = 4;
+
+    static plcrash_greg_t get_reg (const plcrash_async_thread_state_t *ts, plcrash_regnum_t regnum) {
+        return plcrash_async_thread_state_get_reg_32(ts, regnum);
+    }
+
+    static void set_reg (plcrash_async_thread_state_t *ts, plcrash_regnum_t regnum, plcrash_greg_t reg) {
+        plcrash_async_thread_state_set_reg_32(ts, regnum, reg);
+    }
+
+    static bool map_dwarf_to_reg (const plcrash_async_thread_state_t *ts, uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
+        return plcrash_async_thread_state_map_dwarf_to_reg_32(dwarf_reg, regnum);
+    }
+};
+
+/**
+ * @internal
+ * Register accessors for x86_THREAD_STATE64 thread states.
+ */
+class thread_state_x86_64_regs : public thread_state_generic_regs {
+public:
+    static const size_t greg_size = 8;
+
+    static plcrash_greg_t get_reg (const plcrash_async_thread_state_t *ts, plcrash_regnum_t regnum) {
+        return plcrash_async_thread_state_get_reg_64(ts, regnum);
+    }
+
+    static void set_reg (plcrash_async_thread_state_t *ts, plcrash_regnum_t regnum, plcrash_greg_t reg) {
+        plcrash_async_thread_state_set_reg_64(ts, regnum, reg);
+    }
+
+    static bool map_dwarf_to_reg (const plcrash_async_thread_state_t *ts, uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
+        return plcrash_async_thread_state_map_dwarf_to_reg_64(dwarf_reg, regnum);
+    }
+};
+
+#elif defined(__arm__)
+
+/**
+ * @internal
+ * Register accessors for ARM_THREAD_STATE thread states. The ARM implementation supports a single flavor, and
+ * performs no per-call dispatch.
+ */
+class thread_state_arm_regs : public thread_state_generic_regs {
+public:
+    static const size_t greg_size = 4;
+};
+
+#endif
+
+/**
+ * @}
+ */
+
+}}
+
+#endif /* PLCRASH_ASYNC_THREAD_REGISTERS_H */
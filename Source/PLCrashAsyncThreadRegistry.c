@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncThreadRegistry.h"
+
+#include <pthread/introspection.h>
+#include <libkern/OSAtomic.h>
+#include <stdlib.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_async_thread_registry
+ * @{
+ */
+
+/** The process-wide registry, or NULL if the registry has not been installed. */
+static plcrash_async_thread_registry_t *shared_registry = NULL;
+
+/** The introspection hook that was installed prior to the registry's hook, if any. */
+static pthread_introspection_hook_t previous_hook = NULL;
+
+/** Serializes all updates of the registry. Never acquired by readers. */
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Record @a thread in @a registry, if not already recorded. The registry lock must be held.
+ *
+ * @param registry The registry to update.
+ * @param thread The thread to record.
+ * @param port The thread's Mach thread port.
+ */
+static void registry_add_locked (plcrash_async_thread_registry_t *registry, pthread_t thread, thread_t port) {
+    plcrash_async_thread_registry_slot_t *free_slot = NULL;
+
+    for (uint32_t i = 0; i < registry->capacity; i++) {
+        plcrash_async_thread_registry_slot_t *slot = &registry->slots[i];
+        if (slot->active && slot->entry.pthread == thread)
+            return;
+
+        if (!slot->active && free_slot == NULL)
+            free_slot = slot;
+    }
+
+    if (free_slot == NULL) {
+        registry->overflowed = true;
+        return;
+    }
+
+    /* Mark the slot as being updated */
+    free_slot->version++;
+    OSMemoryBarrier();
+
+    plcrash_async_thread_registry_entry_t *entry = &free_slot->entry;
+    entry->pthread = thread;
+    entry->port = port;
+
+    pl_vm_address_t stack_top = (pl_vm_address_t) pthread_get_stackaddr_np(thread);
+    entry->stack_start = stack_top - pthread_get_stacksize_np(thread);
+    entry->stack_end = stack_top;
+
+    if (pthread_getname_np(thread, entry->name, sizeof(entry->name)) != 0)
+        entry->name[0] = '\0';
+
+    free_slot->active = true;
+
+    /* Publish the entry */
+    OSMemoryBarrier();
+    free_slot->version++;
+}
+
+/**
+ * Remove @a thread from @a registry, if recorded. The registry lock must be held.
+ */
+static void registry_remove_locked (plcrash_async_thread_registry_t *registry, pthread_t thread) {
+    for (uint32_t i = 0; i < registry->capacity; i++) {
+        plcrash_async_thread_registry_slot_t *slot = &registry->slots[i];
+        if (!slot->active || slot->entry.pthread != thread)
+            continue;
+
+        slot->version++;
+        OSMemoryBarrier();
+        slot->active = false;
+        OSMemoryBarrier();
+        slot->version++;
+        return;
+    }
+}
+
+/**
+ * The registry's pthread introspection hook. Threads are recorded once started, as their Mach thread port and
+ * stack are not available when the pthread is created, and are removed on termination or, for threads that were
+ * recorded at installation and so may already be terminating, on destruction.
+ */
+static void registry_hook (unsigned int event, pthread_t thread, void *addr, size_t size) {
+    plcrash_async_thread_registry_t *registry = shared_registry;
+
+    switch (event) {
+        case PTHREAD_INTROSPECTION_THREAD_START:
+            pthread_mutex_lock(&registry_lock);
+            registry_add_locked(registry, thread, pthread_mach_thread_np(thread));
+            pthread_mutex_unlock(&registry_lock);
+            break;
+
+        case PTHREAD_INTROSPECTION_THREAD_TERMINATE:
+        case PTHREAD_INTROSPECTION_THREAD_DESTROY:
+            pthread_mutex_lock(&registry_lock);
+            registry_remove_locked(registry, thread);
+            pthread_mutex_unlock(&registry_lock);
+            break;
+
+        default:
+            break;
+    }
+
+    if (previous_hook != NULL)
+        previous_hook(event, thread, addr, size);
+}
+
+/**
+ * Return the process-wide thread registry, installing it on first use. Once installed, the registry remains
+ * installed for the lifetime of the process; any introspection hook installed previously continues to be called.
+ *
+ * @param capacity The maximum number of threads that may be recorded. Ignored if the registry has already been
+ * installed.
+ * @param registry On success, the process-wide registry.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the registry could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_nasync_thread_registry_install (uint32_t capacity, plcrash_async_thread_registry_t **registry) {
+    pthread_mutex_lock(&registry_lock);
+
+    if (shared_registry == NULL) {
+        plcrash_async_thread_registry_t *r = calloc(1, sizeof(*r));
+        plcrash_async_thread_registry_slot_t *slots = calloc(capacity, sizeof(*slots));
+        if (r == NULL || slots == NULL || capacity == 0) {
+            free(r);
+            free(slots);
+            pthread_mutex_unlock(&registry_lock);
+            return PLCRASH_ENOMEM;
+        }
+
+        r->slots = slots;
+        r->capacity = capacity;
+
+        /* Publish the registry before installing the hook. Threads that start before the running threads have been
+         * recorded block on the registry lock, and are recorded only once. */
+        shared_registry = r;
+        OSMemoryBarrier();
+        previous_hook = pthread_introspection_hook_install(registry_hook);
+
+        /* Record the threads that are already running */
+        thread_act_array_t threads;
+        mach_msg_type_number_t thread_count;
+        if (task_threads(mach_task_self(), &threads, &thread_count) == KERN_SUCCESS) {
+            for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+                pthread_t thread = pthread_from_mach_thread_np(threads[i]);
+                if (thread != NULL)
+                    registry_add_locked(r, thread, threads[i]);
+
+                /* The port name remains valid; the thread's own reference is held by pthreads */
+                mach_port_deallocate(mach_task_self(), threads[i]);
+            }
+
+            vm_deallocate(mach_task_self(), (vm_address_t) threads, sizeof(thread_t) * thread_count);
+        } else {
+            r->overflowed = true;
+        }
+    }
+
+    *registry = shared_registry;
+    pthread_mutex_unlock(&registry_lock);
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Return true if every pthread started since the registry was installed, and every pthread running at
+ * installation, has been recorded.
+ *
+ * @param registry The registry to query.
+ */
+bool plcrash_async_thread_registry_complete (plcrash_async_thread_registry_t *registry) {
+    return !registry->overflowed;
+}
+
+/**
+ * Copy the slot's entry to @a entry if the slot is active and the entry was not modified while being copied.
+ */
+static bool registry_read_slot (plcrash_async_thread_registry_slot_t *slot, plcrash_async_thread_registry_entry_t *entry) {
+    uint32_t version = slot->version;
+    if (version & 1)
+        return false;
+
+    OSMemoryBarrier();
+    if (!slot->active)
+        return false;
+
+    plcrash_async_memcpy(entry, &slot->entry, sizeof(*entry));
+
+    OSMemoryBarrier();
+    return slot->version == version;
+}
+
+/**
+ * Copy the Mach thread ports of up to @a max_ports registered threads to @a ports. No port rights are acquired.
+ * Entries that are being updated are skipped; as any such update may never complete if the updating thread has
+ * been suspended, readers do not wait.
+ *
+ * @param registry The registry to read.
+ * @param ports The destination array.
+ * @param max_ports The number of entries available in @a ports.
+ *
+ * @return Returns the number of ports copied.
+ */
+uint32_t plcrash_async_thread_registry_copy_ports (plcrash_async_thread_registry_t *registry, thread_t *ports, uint32_t max_ports) {
+    plcrash_async_thread_registry_entry_t entry;
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < registry->capacity && count < max_ports; i++) {
+        if (registry_read_slot(&registry->slots[i], &entry))
+            ports[count++] = entry.port;
+    }
+
+    return count;
+}
+
+/**
+ * Look up the registered thread with Mach thread port @a port.
+ *
+ * @param registry The registry to read.
+ * @param port The thread's Mach thread port.
+ * @param entry On success, a copy of the thread's entry.
+ *
+ * @return Returns true if the thread was found, or false if it is not registered, or its entry is being updated.
+ */
+bool plcrash_async_thread_registry_lookup (plcrash_async_thread_registry_t *registry, thread_t port, plcrash_async_thread_registry_entry_t *entry) {
+    for (uint32_t i = 0; i < registry->capacity; i++) {
+        plcrash_async_thread_registry_slot_t *slot = &registry->slots[i];
+        if (slot->entry.port != port)
+            continue;
+
+        if (registry_read_slot(slot, entry) && entry->port == port)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @}
+ */
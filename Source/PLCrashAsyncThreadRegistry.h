@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_THREAD_REGISTRY_H
+#define PLCRASH_ASYNC_THREAD_REGISTRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <mach/mach.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_async_thread_registry Async-safe Thread Registry
+ * @ingroup plcrash_async
+ *
+ * A process-wide table of the process' threads, maintained via pthread_introspection_hook_install(). Each thread
+ * is recorded with its Mach thread port, stack range, and name as it starts, and removed as it terminates; threads
+ * that were already running when the registry was installed are recorded at installation.
+ *
+ * The table is preallocated, and may be read from within a signal handler without locks or system calls,
+ * allowing a crash report to enumerate the process' threads and bound their stacks without task_threads()
+ * or a VM region lookup per thread. Updates are serialized by a lock that is never acquired by readers.
+ *
+ * Threads that were not created via pthreads, and threads started after the table has filled, are not recorded;
+ * see plcrash_async_thread_registry_complete().
+ *
+ * @{
+ */
+
+/** The maximum length of a recorded thread name, including the trailing NUL. */
+#define PLCRASH_ASYNC_THREAD_REGISTRY_NAME_MAX 64
+
+/**
+ * @internal
+ *
+ * A registered thread.
+ */
+typedef struct plcrash_async_thread_registry_entry {
+    /** The thread's pthread handle. */
+    pthread_t pthread;
+
+    /** The thread's Mach thread port. */
+    thread_t port;
+
+    /** The lowest address of the thread's stack. */
+    pl_vm_address_t stack_start;
+
+    /** The address following the highest address of the thread's stack. */
+    pl_vm_address_t stack_end;
+
+    /** The thread's NUL-terminated name, as set when the thread was registered, or an empty string. */
+    char name[PLCRASH_ASYNC_THREAD_REGISTRY_NAME_MAX];
+} plcrash_async_thread_registry_entry_t;
+
+/**
+ * @internal
+ *
+ * A slot within the registry's table.
+ */
+typedef struct plcrash_async_thread_registry_slot {
+    /**
+     * The slot's version. Odd while the slot is being updated; advanced once before, and once after, each update.
+     * Readers retry, or skip the slot, if the version changes while the entry is copied.
+     */
+    volatile uint32_t version;
+
+    /** If true, @a entry describes a registered thread. */
+    volatile bool active;
+
+    /** The registered thread. */
+    plcrash_async_thread_registry_entry_t entry;
+} plcrash_async_thread_registry_slot_t;
+
+/**
+ * @internal
+ *
+ * A thread registry.
+ */
+typedef struct plcrash_async_thread_registry {
+    /** The registry's slots. */
+    plcrash_async_thread_registry_slot_t *slots;
+
+    /** The number of entries in @a slots. */
+    uint32_t capacity;
+
+    /** Set if a thread could not be recorded because all slots were in use. Never cleared. */
+    volatile bool overflowed;
+} plcrash_async_thread_registry_t;
+
+plcrash_error_t plcrash_nasync_thread_registry_install (uint32_t capacity, plcrash_async_thread_registry_t **registry);
+
+bool plcrash_async_thread_registry_complete (plcrash_async_thread_registry_t *registry);
+uint32_t plcrash_async_thread_registry_copy_ports (plcrash_async_thread_registry_t *registry, thread_t *ports, uint32_t max_ports);
+bool plcrash_async_thread_registry_lookup (plcrash_async_thread_registry_t *registry, thread_t port, plcrash_async_thread_registry_entry_t *entry);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_THREAD_REGISTRY_H */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashAsyncThreadRegistry.h"
+
+@interface PLCrashAsyncThreadRegistryTests : SenTestCase {
+@private
+}
+@end
+
+/* Thread body for testThreadLifecycle; signals @a arg once running, and waits to be released. */
+static void *registry_test_thread (void *arg) {
+    dispatch_semaphore_t *sems = arg;
+    dispatch_semaphore_signal(sems[0]);
+    dispatch_semaphore_wait(sems[1], DISPATCH_TIME_FOREVER);
+    return NULL;
+}
+
+@implementation PLCrashAsyncThreadRegistryTests
+
+/**
+ * Test that threads running at installation are recorded, with their stack and name.
+ */
+- (void) testRunningThreads {
+    plcrash_async_thread_registry_t *registry;
+    STAssertEquals(plcrash_nasync_thread_registry_install(128, &registry), PLCRASH_ESUCCESS, @"Failed to install registry");
+    STAssertTrue(plcrash_async_thread_registry_complete(registry), @"Registry should be complete");
+
+    /* The current thread must be registered */
+    plcrash_async_thread_registry_entry_t entry;
+    thread_t self = pthread_mach_thread_np(pthread_self());
+    STAssertTrue(plcrash_async_thread_registry_lookup(registry, self, &entry), @"Current thread was not registered");
+    STAssertEquals(entry.pthread, pthread_self(), @"Incorrect pthread");
+
+    pl_vm_address_t sp = (pl_vm_address_t) &entry;
+    STAssertTrue(sp >= entry.stack_start && sp < entry.stack_end, @"Stack range does not contain the current stack");
+
+    /* The copied ports must include the current thread */
+    thread_t ports[128];
+    uint32_t count = plcrash_async_thread_registry_copy_ports(registry, ports, 128);
+    bool found = false;
+    for (uint32_t i = 0; i < count; i++) {
+        if (ports[i] == self)
+            found = true;
+    }
+    STAssertTrue(found, @"Current thread was not copied");
+
+    /* Installation is idempotent */
+    plcrash_async_thread_registry_t *second;
+    STAssertEquals(plcrash_nasync_thread_registry_install(1, &second), PLCRASH_ESUCCESS, @"Failed to fetch registry");
+    STAssertEquals(second, registry, @"A second registry was installed");
+}
+
+/**
+ * Test that threads are recorded as they start, and removed as they terminate.
+ */
+- (void) testThreadLifecycle {
+    plcrash_async_thread_registry_t *registry;
+    STAssertEquals(plcrash_nasync_thread_registry_install(128, &registry), PLCRASH_ESUCCESS, @"Failed to install registry");
+
+    dispatch_semaphore_t sems[2] = { dispatch_semaphore_create(0), dispatch_semaphore_create(0) };
+    pthread_t thread;
+    STAssertEquals(pthread_create(&thread, NULL, registry_test_thread, sems), 0, @"Failed to create thread");
+    dispatch_semaphore_wait(sems[0], DISPATCH_TIME_FOREVER);
+
+    /* The thread is recorded once started */
+    plcrash_async_thread_registry_entry_t entry;
+    thread_t port = pthread_mach_thread_np(thread);
+    STAssertTrue(plcrash_async_thread_registry_lookup(registry, port, &entry), @"Thread was not registered");
+    STAssertEquals(entry.pthread, thread, @"Incorrect pthread");
+    STAssertEquals(entry.stack_end, (pl_vm_address_t) pthread_get_stackaddr_np(thread), @"Incorrect stack top");
+    STAssertEquals(entry.stack_end - entry.stack_start, (pl_vm_address_t) pthread_get_stacksize_np(thread), @"Incorrect stack size");
+
+    /* The thread is removed once terminated */
+    dispatch_semaphore_signal(sems[1]);
+    pthread_join(thread, NULL);
+    STAssertFalse(plcrash_async_thread_registry_lookup(registry, port, &entry), @"Thread was not removed");
+
+    dispatch_release(sems[0]);
+    dispatch_release(sems[1]);
+}
+
+@end
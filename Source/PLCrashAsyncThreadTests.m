@@ -228,6 +228,31 @@
 #undef CHECKREG
 }
 
+/**
+ * Test that unmapped and out-of-range registers are rejected by the DWARF register mappings.
+ */
+- (void) testMapUnknownDwarfRegister {
+    plcrash_async_thread_state_t ts;
+    plcrash_regnum_t regnum;
+    uint64_t dwarf_reg;
+
+#if PLCRASH_ASYNC_THREAD_X86_SUPPORT
+    STAssertEquals(plcrash_async_thread_state_init(&ts, CPU_TYPE_X86_64), PLCRASH_ESUCCESS, @"Failed to initialize thread state");
+    STAssertFalse(plcrash_async_thread_state_map_dwarf_to_reg(&ts, 20, &regnum), @"Mapped an unassigned DWARF register");
+    STAssertFalse(plcrash_async_thread_state_map_dwarf_to_reg(&ts, 56, &regnum), @"Mapped an out-of-range DWARF register");
+    STAssertFalse(plcrash_async_thread_state_map_dwarf_to_reg(&ts, UINT64_MAX, &regnum), @"Mapped an out-of-range DWARF register");
+    STAssertFalse(plcrash_async_thread_state_map_reg_to_dwarf(&ts, PLCRASH_X86_64_RIP, &dwarf_reg), @"Mapped a register with no DWARF number");
+    STAssertFalse(plcrash_async_thread_state_map_reg_to_dwarf(&ts, PLCRASH_REG_INVALID, &dwarf_reg), @"Mapped an invalid register");
+#endif /* PLCRASH_ASYNC_THREAD_X86_SUPPORT */
+
+#if PLCRASH_ASYNC_THREAD_ARM_SUPPORT
+    STAssertEquals(plcrash_async_thread_state_init(&ts, CPU_TYPE_ARM), PLCRASH_ESUCCESS, @"Failed to initialize thread state");
+    STAssertFalse(plcrash_async_thread_state_map_dwarf_to_reg(&ts, 16, &regnum), @"Mapped an out-of-range DWARF register");
+    STAssertFalse(plcrash_async_thread_state_map_reg_to_dwarf(&ts, PLCRASH_ARM_CPSR, &dwarf_reg), @"Mapped a register with no DWARF number");
+    STAssertFalse(plcrash_async_thread_state_map_reg_to_dwarf(&ts, PLCRASH_REG_INVALID, &dwarf_reg), @"Mapped an invalid register");
+#endif
+}
+
 /* Test plcrash_async_thread_state_init() */
 - (void) testEmptyInit {
     plcrash_async_thread_state_t ts;
@@ -376,6 +401,32 @@
     thread_resume(thr);
 }
 
+/* Test plcrash_async_thread_state_mach_thread_gpr_init() */
+- (void) testThreadStateThreadGPRInit {
+    plcrash_async_thread_state_t full_state;
+    plcrash_async_thread_state_t gpr_state;
+    thread_t thr;
+
+    thr = pthread_mach_thread_np(_thr_args.thread);
+    thread_suspend(thr);
+
+    STAssertEquals(plcrash_async_thread_state_mach_thread_init(&full_state, thr), PLCRASH_ESUCCESS, @"Failed to initialize thread state");
+    STAssertEquals(plcrash_async_thread_state_mach_thread_gpr_init(&gpr_state, thr), PLCRASH_ESUCCESS, @"Failed to initialize thread state");
+
+    /* The general purpose registers must match the full thread state */
+    STAssertEquals(plcrash_async_thread_state_get_greg_size(&gpr_state), plcrash_async_thread_state_get_greg_size(&full_state), @"Incorrect greg size");
+    STAssertEquals(plcrash_async_thread_state_get_stack_direction(&gpr_state), plcrash_async_thread_state_get_stack_direction(&full_state), @"Incorrect stack direction");
+
+    plcrash_regnum_t regs[] = { PLCRASH_REG_IP, PLCRASH_REG_FP, PLCRASH_REG_SP };
+    for (size_t i = 0; i < sizeof(regs) / sizeof(regs[0]); i++) {
+        STAssertTrue(plcrash_async_thread_state_has_reg(&gpr_state, regs[i]), @"Register should be marked as set");
+        STAssertEquals(plcrash_async_thread_state_get_reg(&gpr_state, regs[i]), plcrash_async_thread_state_get_reg(&full_state, regs[i]), @"Incorrect register value");
+    }
+
+    /* Clean up */
+    thread_resume(thr);
+}
+
 static uintptr_t getPC () {
     return (uintptr_t) __builtin_return_address(0);
 }
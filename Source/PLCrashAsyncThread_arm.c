@@ -45,14 +45,14 @@
     break; \
 }
 
-/* Mapping of DWARF register numbers to PLCrashReporter register numbers. */
-struct dwarf_register_table {
-    /** Standard register number. */
-    plcrash_regnum_t regnum;
-    
-    /** DWARF register number. */
-    uint64_t dwarf_value;
-};
+/*
+ * Dense DWARF register mapping tables. The mappings are declared once as a list of MAP(regnum, dwarf_value)
+ * entries, from which both a DWARF-indexed and a register-indexed lookup table are generated. Table entries
+ * hold the mapped value plus one; a zero entry marks an unmapped register.
+ */
+#define DWARF_TO_REG_ENTRY(regnum, dwarf_value) [dwarf_value] = (regnum) + 1,
+#define REG_TO_DWARF_ENTRY(regnum, dwarf_value) [regnum] = (dwarf_value) + 1,
+#define DWARF_TABLE_COUNT(table) (sizeof(table) / sizeof(table[0]))
 
 
 /*
@@ -80,24 +80,26 @@ static const plcrash_regnum_t arm_nonvolatile_registers[] = {
  *   considered unlikely that these will be needed for producing a stack back-trace in a
  *   debugger.
  */
-static const struct dwarf_register_table arm_dwarf_table [] = {
-    { PLCRASH_ARM_R0, 0 },
-    { PLCRASH_ARM_R1, 1 },
-    { PLCRASH_ARM_R2, 2 },
-    { PLCRASH_ARM_R3, 3 },
-    { PLCRASH_ARM_R4, 4 },
-    { PLCRASH_ARM_R5, 5 },
-    { PLCRASH_ARM_R6, 6 },
-    { PLCRASH_ARM_R7, 7 },
-    { PLCRASH_ARM_R8, 8 },
-    { PLCRASH_ARM_R9, 9 },
-    { PLCRASH_ARM_R10, 10 },
-    { PLCRASH_ARM_R11, 11 },
-    { PLCRASH_ARM_R12, 12 },
-    { PLCRASH_ARM_SP, 13 },
-    { PLCRASH_ARM_LR, 14 },
-    { PLCRASH_ARM_PC, 15 }
-};
+#define ARM_DWARF_REGISTERS(MAP) \
+    MAP(PLCRASH_ARM_R0, 0) \
+    MAP(PLCRASH_ARM_R1, 1) \
+    MAP(PLCRASH_ARM_R2, 2) \
+    MAP(PLCRASH_ARM_R3, 3) \
+    MAP(PLCRASH_ARM_R4, 4) \
+    MAP(PLCRASH_ARM_R5, 5) \
+    MAP(PLCRASH_ARM_R6, 6) \
+    MAP(PLCRASH_ARM_R7, 7) \
+    MAP(PLCRASH_ARM_R8, 8) \
+    MAP(PLCRASH_ARM_R9, 9) \
+    MAP(PLCRASH_ARM_R10, 10) \
+    MAP(PLCRASH_ARM_R11, 11) \
+    MAP(PLCRASH_ARM_R12, 12) \
+    MAP(PLCRASH_ARM_SP, 13) \
+    MAP(PLCRASH_ARM_LR, 14) \
+    MAP(PLCRASH_ARM_PC, 15)
+
+static const uint8_t arm_dwarf_to_reg[] = { ARM_DWARF_REGISTERS(DWARF_TO_REG_ENTRY) };
+static const uint8_t arm_reg_to_dwarf[PLCRASH_ARM_LAST_REG + 1] = { ARM_DWARF_REGISTERS(REG_TO_DWARF_ENTRY) };
 
 
 
@@ -310,28 +312,22 @@ void plcrash_async_thread_state_clear_volatile_regs (plcrash_async_thread_state_
 
 // PLCrashAsyncThread API
 bool plcrash_async_thread_state_map_reg_to_dwarf (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, uint64_t *dwarf_reg) {
-    for (size_t i = 0; i < sizeof(arm_dwarf_table) / sizeof(arm_dwarf_table[0]); i++) {
-        if (arm_dwarf_table[i].regnum == regnum) {
-            *dwarf_reg = arm_dwarf_table[i].dwarf_value;
-            return true;
-        }
-    }
-    
-    /* Unknown DWARF register.  */
-    return false;
+    /* Unknown register.  */
+    if (regnum >= DWARF_TABLE_COUNT(arm_reg_to_dwarf) || arm_reg_to_dwarf[regnum] == 0)
+        return false;
+
+    *dwarf_reg = arm_reg_to_dwarf[regnum] - 1;
+    return true;
 }
 
 // PLCrashAsyncThread API
 bool plcrash_async_thread_state_map_dwarf_to_reg (const plcrash_async_thread_state_t *thread_state, uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
-    for (size_t i = 0; i < sizeof(arm_dwarf_table) / sizeof(arm_dwarf_table[0]); i++) {
-        if (arm_dwarf_table[i].dwarf_value == dwarf_reg) {
-            *regnum = arm_dwarf_table[i].regnum;
-            return true;
-        }
-    }
-    
     /* Unknown DWARF register.  */
-    return false;
+    if (dwarf_reg >= DWARF_TABLE_COUNT(arm_dwarf_to_reg) || arm_dwarf_to_reg[dwarf_reg] == 0)
+        return false;
+
+    *regnum = arm_dwarf_to_reg[dwarf_reg] - 1;
+    return true;
 }
 
 #endif /* __arm__ */
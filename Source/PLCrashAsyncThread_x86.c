@@ -45,14 +45,14 @@
 
 #if defined(__i386__) || defined(__x86_64__)
 
-/* Mapping of DWARF register numbers to PLCrashReporter register numbers. */
-struct dwarf_register_table {
-    /** Standard register number. */
-    plcrash_regnum_t regnum;
-
-    /** DWARF register number. */
-    uint64_t dwarf_value;
-};
+/*
+ * Dense DWARF register mapping tables. Each architecture's mappings are declared once as a list of
+ * MAP(regnum, dwarf_value) entries, from which both a DWARF-indexed and a register-indexed lookup table
+ * are generated. Table entries hold the mapped value plus one; a zero entry marks an unmapped register.
+ */
+#define DWARF_TO_REG_ENTRY(regnum, dwarf_value) [dwarf_value] = (regnum) + 1,
+#define REG_TO_DWARF_ENTRY(regnum, dwarf_value) [regnum] = (dwarf_value) + 1,
+#define DWARF_TABLE_COUNT(table) (sizeof(table) / sizeof(table[0]))
 
 
 /*
@@ -95,17 +95,19 @@ static const plcrash_regnum_t x86_64_nonvolatile_registers[] = {
  *
  * @warning These mappings are not accurate for use in DWARF debug_frame.
  */
-static const struct dwarf_register_table x86_32_dwarf_table [] = {
-    { PLCRASH_X86_EAX, 0 },
-    { PLCRASH_X86_ECX, 1 },
-    { PLCRASH_X86_EDX, 2 },
-    { PLCRASH_X86_EBX, 3 },
-    { PLCRASH_X86_EBP, 4 },
-    { PLCRASH_X86_ESP, 5 },
-    { PLCRASH_X86_ESI, 6 },
-    { PLCRASH_X86_EDI, 7 },
-    { PLCRASH_X86_EIP, 8 }
-};
+#define X86_32_DWARF_REGISTERS(MAP) \
+    MAP(PLCRASH_X86_EAX, 0) \
+    MAP(PLCRASH_X86_ECX, 1) \
+    MAP(PLCRASH_X86_EDX, 2) \
+    MAP(PLCRASH_X86_EBX, 3) \
+    MAP(PLCRASH_X86_EBP, 4) \
+    MAP(PLCRASH_X86_ESP, 5) \
+    MAP(PLCRASH_X86_ESI, 6) \
+    MAP(PLCRASH_X86_EDI, 7) \
+    MAP(PLCRASH_X86_EIP, 8)
+
+static const uint8_t x86_32_dwarf_to_reg[] = { X86_32_DWARF_REGISTERS(DWARF_TO_REG_ENTRY) };
+static const uint8_t x86_32_reg_to_dwarf[PLCRASH_X86_LAST_REG + 1] = { X86_32_DWARF_REGISTERS(REG_TO_DWARF_ENTRY) };
 
 /*
  * x86-64 DWARF register mappings as defined in the System V Application Binary Interface,
@@ -114,44 +116,37 @@ static const struct dwarf_register_table x86_32_dwarf_table [] = {
  * Note that not all registers defined the AMD64 ABI are currently supported by our
  * thread-state API, and are not mapped.
  */
-static const struct dwarf_register_table x86_64_dwarf_table [] = {
-    { PLCRASH_X86_64_RAX,  0 },
-    { PLCRASH_X86_64_RDX,  1 },
-    { PLCRASH_X86_64_RCX,  2 },
-    { PLCRASH_X86_64_RBX,  3 },
-    { PLCRASH_X86_64_RSI,  4 },
-    { PLCRASH_X86_64_RDI,  5 },
-    { PLCRASH_X86_64_RBP,  6 },
-    { PLCRASH_X86_64_RSP,  7 },
-    
-    { PLCRASH_X86_64_R8,   8 },
-    { PLCRASH_X86_64_R9,   9 },
-    { PLCRASH_X86_64_R10, 10 },
-    { PLCRASH_X86_64_R11, 11 },
-    { PLCRASH_X86_64_R12, 12 },
-    { PLCRASH_X86_64_R13, 13 },
-    { PLCRASH_X86_64_R14, 14 },
-    { PLCRASH_X86_64_R15, 15 },
-    
-    { PLCRASH_X86_64_RFLAGS, 49 },
-    
-    { PLCRASH_X86_64_CS, 51 },
-    { PLCRASH_X86_64_FS, 54 },
-    { PLCRASH_X86_64_GS, 55 }
-};
-
-static plcrash_greg_t plcrash_async_thread_state_get_reg_32 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum);
-static plcrash_greg_t plcrash_async_thread_state_get_reg_64 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum);
-
-static void plcrash_async_thread_state_set_reg_32 (plcrash_async_thread_state_t *cursor, plcrash_regnum_t regnum, plcrash_greg_t reg);
-static void plcrash_async_thread_state_set_reg_64 (plcrash_async_thread_state_t *cursor, plcrash_regnum_t regnum, plcrash_greg_t reg);
+#define X86_64_DWARF_REGISTERS(MAP) \
+    MAP(PLCRASH_X86_64_RAX,  0) \
+    MAP(PLCRASH_X86_64_RDX,  1) \
+    MAP(PLCRASH_X86_64_RCX,  2) \
+    MAP(PLCRASH_X86_64_RBX,  3) \
+    MAP(PLCRASH_X86_64_RSI,  4) \
+    MAP(PLCRASH_X86_64_RDI,  5) \
+    MAP(PLCRASH_X86_64_RBP,  6) \
+    MAP(PLCRASH_X86_64_RSP,  7) \
+    \
+    MAP(PLCRASH_X86_64_R8,   8) \
+    MAP(PLCRASH_X86_64_R9,   9) \
+    MAP(PLCRASH_X86_64_R10, 10) \
+    MAP(PLCRASH_X86_64_R11, 11) \
+    MAP(PLCRASH_X86_64_R12, 12) \
+    MAP(PLCRASH_X86_64_R13, 13) \
+    MAP(PLCRASH_X86_64_R14, 14) \
+    MAP(PLCRASH_X86_64_R15, 15) \
+    \
+    MAP(PLCRASH_X86_64_RFLAGS, 49) \
+    \
+    MAP(PLCRASH_X86_64_CS, 51) \
+    MAP(PLCRASH_X86_64_FS, 54) \
+    MAP(PLCRASH_X86_64_GS, 55)
+
+static const uint8_t x86_64_dwarf_to_reg[] = { X86_64_DWARF_REGISTERS(DWARF_TO_REG_ENTRY) };
+static const uint8_t x86_64_reg_to_dwarf[PLCRASH_X86_64_LAST_REG + 1] = { X86_64_DWARF_REGISTERS(REG_TO_DWARF_ENTRY) };
 
 static const char *plcrash_async_thread_state_get_regname_32 (plcrash_regnum_t regnum);
 static const char *plcrash_async_thread_state_get_regname_64 (plcrash_regnum_t regnum);
 
-plcrash_regnum_t plcrash_async_thread_state_map_dwarf_reg_32 (uint64_t dwarf_reg, plcrash_regnum_t *regnum);
-plcrash_regnum_t plcrash_async_thread_state_map_dwarf_reg_64 (uint64_t dwarf_reg, plcrash_regnum_t *regnum);
-
 // PLCrashAsyncThread API
 plcrash_greg_t plcrash_async_thread_state_get_reg (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
     if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
@@ -225,57 +220,65 @@ void plcrash_async_thread_state_clear_volatile_regs (plcrash_async_thread_state_
 
 // PLCrashAsyncThread API
 bool plcrash_async_thread_state_map_dwarf_to_reg (const plcrash_async_thread_state_t *thread_state, uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
-    const struct dwarf_register_table *table;
-    size_t table_count = 0;
-
     if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
-        table = x86_32_dwarf_table;
-        table_count = sizeof(x86_32_dwarf_table) / sizeof(x86_32_dwarf_table[0]);
+        return plcrash_async_thread_state_map_dwarf_to_reg_32(dwarf_reg, regnum);
     } else {
-        table = x86_64_dwarf_table;
-        table_count = sizeof(x86_64_dwarf_table) / sizeof(x86_64_dwarf_table[0]);
-    }
-    
-    for (size_t i = 0; i < table_count; i++) {
-        if (table[i].dwarf_value == dwarf_reg) {
-            *regnum = table[i].regnum;
-            return true;
-        }
+        return plcrash_async_thread_state_map_dwarf_to_reg_64(dwarf_reg, regnum);
     }
+}
 
+/**
+ * @internal
+ * 32-bit implementation of plcrash_async_thread_state_map_dwarf_to_reg()
+ */
+bool plcrash_async_thread_state_map_dwarf_to_reg_32 (uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
+    /* Unknown DWARF register.  */
+    if (dwarf_reg >= DWARF_TABLE_COUNT(x86_32_dwarf_to_reg) || x86_32_dwarf_to_reg[dwarf_reg] == 0)
+        return false;
+
+    *regnum = x86_32_dwarf_to_reg[dwarf_reg] - 1;
+    return true;
+}
+
+/**
+ * @internal
+ * 64-bit implementation of plcrash_async_thread_state_map_dwarf_to_reg()
+ */
+bool plcrash_async_thread_state_map_dwarf_to_reg_64 (uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
     /* Unknown DWARF register.  */
-    return false;
+    if (dwarf_reg >= DWARF_TABLE_COUNT(x86_64_dwarf_to_reg) || x86_64_dwarf_to_reg[dwarf_reg] == 0)
+        return false;
+
+    *regnum = x86_64_dwarf_to_reg[dwarf_reg] - 1;
+    return true;
 }
 
 // PLCrashAsyncThread API
 bool plcrash_async_thread_state_map_reg_to_dwarf (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, uint64_t *dwarf_reg) {
-    const struct dwarf_register_table *table;
-    size_t table_count = 0;
-    
+    const uint8_t *table;
+    size_t table_count;
+
     if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
-        table = x86_32_dwarf_table;
-        table_count = sizeof(x86_32_dwarf_table) / sizeof(x86_32_dwarf_table[0]);
+        table = x86_32_reg_to_dwarf;
+        table_count = DWARF_TABLE_COUNT(x86_32_reg_to_dwarf);
     } else {
-        table = x86_64_dwarf_table;
-        table_count = sizeof(x86_64_dwarf_table) / sizeof(x86_64_dwarf_table[0]);
-    }
-    
-    for (size_t i = 0; i < table_count; i++) {
-        if (table[i].regnum == regnum) {
-            *dwarf_reg = table[i].dwarf_value;
-            return true;
-        }
+        table = x86_64_reg_to_dwarf;
+        table_count = DWARF_TABLE_COUNT(x86_64_reg_to_dwarf);
     }
 
     /* Unknown register.  */
-    return false;
+    if (regnum >= table_count || table[regnum] == 0)
+        return false;
+
+    *dwarf_reg = table[regnum] - 1;
+    return true;
 }
 
 /**
  * @internal
  * 32-bit implementation of plcrash_async_thread_state_get_reg()
  */
-static plcrash_greg_t plcrash_async_thread_state_get_reg_32 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
+plcrash_greg_t plcrash_async_thread_state_get_reg_32 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
     const plcrash_async_thread_state_t *ts = thread_state;
 
     /* All word-sized registers */
@@ -341,7 +344,7 @@ static plcrash_greg_t plcrash_async_thread_state_get_reg_32 (const plcrash_async
  * @internal
  * 64-bit implementation of plcrash_async_thread_state_get_reg()
  */
-static plcrash_greg_t plcrash_async_thread_state_get_reg_64 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
+plcrash_greg_t plcrash_async_thread_state_get_reg_64 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
     const plcrash_async_thread_state_t *ts = thread_state;
 
     switch (regnum) {
@@ -421,7 +424,7 @@ static plcrash_greg_t plcrash_async_thread_state_get_reg_64 (const plcrash_async
  * @internal
  * 32-bit implementation of plcrash_async_thread_state_set_reg()
  */
-static void plcrash_async_thread_state_set_reg_32 (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
+void plcrash_async_thread_state_set_reg_32 (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
     plcrash_async_thread_state_t *ts = thread_state;
     
     /* All word-sized registers */
@@ -484,7 +487,7 @@ static void plcrash_async_thread_state_set_reg_32 (plcrash_async_thread_state_t
  * @internal
  * 64-bit implementation of plcrash_async_thread_state_set_reg()
  */
-static void plcrash_async_thread_state_set_reg_64 (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
+void plcrash_async_thread_state_set_reg_64 (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
     plcrash_async_thread_state_t *ts = thread_state;
     
     switch (regnum) {
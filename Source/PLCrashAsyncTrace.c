@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncTrace.h"
+
+#include "PLCrashAsync.h"
+#include <libkern/OSAtomic.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_async_trace
+ * @{
+ */
+
+/** The trace buffer's entries. */
+static plcrash_async_trace_entry_t trace_entries[PLCRASH_ASYNC_TRACE_CAPACITY];
+
+/** The total number of events that have been recorded. */
+static volatile int64_t trace_count = 0;
+
+/** Event names, indexed by plcrash_async_trace_event_t. */
+static const char *trace_event_names[] = {
+    [PLCRASH_TRACE_THREAD_STATE_FAILED] = "thread_state_failed",
+    [PLCRASH_TRACE_STACK_WRONG_DIRECTION] = "stack_wrong_direction",
+    [PLCRASH_TRACE_STACK_READ_FAILED] = "stack_read_failed",
+    [PLCRASH_TRACE_CFE_NO_IMAGE] = "cfe_no_image",
+    [PLCRASH_TRACE_CFE_MAP_FAILED] = "cfe_map_failed",
+    [PLCRASH_TRACE_CFE_PARSE_FAILED] = "cfe_parse_failed",
+    [PLCRASH_TRACE_CFE_NOT_FOUND] = "cfe_not_found",
+    [PLCRASH_TRACE_CFE_DECODE_FAILED] = "cfe_decode_failed",
+    [PLCRASH_TRACE_CFE_APPLY_FAILED] = "cfe_apply_failed",
+    [PLCRASH_TRACE_DWARF_NO_IMAGE] = "dwarf_no_image",
+    [PLCRASH_TRACE_DWARF_PARSER_FAILED] = "dwarf_parser_failed",
+    [PLCRASH_TRACE_DWARF_CIE_FAILED] = "dwarf_cie_failed",
+    [PLCRASH_TRACE_DWARF_EVAL_FAILED] = "dwarf_eval_failed",
+    [PLCRASH_TRACE_DWARF_APPLY_FAILED] = "dwarf_apply_failed",
+    [PLCRASH_TRACE_STACK_OUT_OF_BOUNDS] = "stack_out_of_bounds",
+};
+
+/**
+ * Record a trace event. This is generally called via PLCF_TRACE(), which will supply @a argc and pad the
+ * unused arguments.
+ *
+ * @param event The event identifier.
+ * @param argc The number of valid arguments.
+ * @param a0 The first argument.
+ * @param a1 The second argument.
+ * @param a2 The third argument.
+ * @param a3 The fourth argument.
+ */
+void plcrash_async_trace_record (uint32_t event, uint32_t argc, uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3) {
+    /* Claim the next slot */
+    uint64_t seq = (uint64_t) OSAtomicIncrement64Barrier(&trace_count);
+    plcrash_async_trace_entry_t *entry = &trace_entries[(seq - 1) % PLCRASH_ASYNC_TRACE_CAPACITY];
+
+    /* Mark the entry as incomplete while it is populated */
+    entry->seq = 0;
+    OSMemoryBarrier();
+
+    entry->event = event;
+    entry->argc = argc;
+    entry->args[0] = a0;
+    entry->args[1] = a1;
+    entry->args[2] = a2;
+    entry->args[3] = a3;
+
+    OSMemoryBarrier();
+    entry->seq = seq;
+}
+
+/**
+ * Copy up to @a count of the most recently recorded events to @a entries, oldest first. Entries that are
+ * overwritten or are still being written while the snapshot is taken are skipped.
+ *
+ * @param entries The destination buffer.
+ * @param count The number of entries that may be written to @a entries.
+ *
+ * @return Returns the number of entries written to @a entries.
+ */
+size_t plcrash_async_trace_snapshot (plcrash_async_trace_entry_t *entries, size_t count) {
+    uint64_t end = (uint64_t) OSAtomicAdd64Barrier(0, &trace_count);
+
+    if (count > PLCRASH_ASYNC_TRACE_CAPACITY)
+        count = PLCRASH_ASYNC_TRACE_CAPACITY;
+
+    uint64_t start = 0;
+    if (end > count)
+        start = end - count;
+
+    size_t written = 0;
+    for (uint64_t seq = start + 1; seq <= end; seq++) {
+        plcrash_async_trace_entry_t *entry = &trace_entries[(seq - 1) % PLCRASH_ASYNC_TRACE_CAPACITY];
+        plcrash_async_trace_entry_t *dest = &entries[written];
+
+        if (entry->seq != seq)
+            continue;
+
+        OSMemoryBarrier();
+        dest->event = entry->event;
+        dest->argc = entry->argc;
+        plcrash_async_memcpy(dest->args, entry->args, sizeof(dest->args));
+        OSMemoryBarrier();
+
+        /* Discard the copy if the entry was reused while it was being read */
+        if (entry->seq != seq)
+            continue;
+
+        dest->seq = seq;
+        written++;
+    }
+
+    return written;
+}
+
+/**
+ * Return the name of @a event, or NULL if the event is unknown.
+ *
+ * @param event The event identifier.
+ */
+const char *plcrash_async_trace_event_name (uint32_t event) {
+    if (event >= sizeof(trace_event_names) / sizeof(trace_event_names[0]))
+        return NULL;
+
+    return trace_event_names[event];
+}
+
+/**
+ * @}
+ */
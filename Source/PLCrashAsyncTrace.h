@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_TRACE_H
+#define PLCRASH_ASYNC_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @internal
+ * @defgroup plcrash_async_trace Async-safe Diagnostic Trace Buffer
+ * @ingroup plcrash_async
+ *
+ * A process-wide ring buffer of compact binary diagnostic events. Each event consists of an event identifier
+ * and up to PLCRASH_ASYNC_TRACE_MAX_ARGS integer arguments; recording an event requires no formatting or system
+ * calls, and the buffer's storage is statically allocated. Unlike PLCF_DEBUG(), tracing remains enabled in release
+ * builds.
+ *
+ * When the buffer is full, the oldest events are overwritten. The most recent events are written to each crash
+ * report, and may be decoded via PLCrashReport or plcrashutil.
+ *
+ * @{
+ */
+
+/** The number of events retained by the trace buffer. */
+#define PLCRASH_ASYNC_TRACE_CAPACITY 256
+
+/** The maximum number of arguments that may be recorded with a single event. */
+#define PLCRASH_ASYNC_TRACE_MAX_ARGS 4
+
+/**
+ * @internal
+ *
+ * Trace event identifiers. These values are written to crash reports, and must not be renumbered.
+ */
+typedef enum {
+    /** Fetching a thread's state failed. Arguments: Mach error. */
+    PLCRASH_TRACE_THREAD_STATE_FAILED = 1,
+
+    /** The stack was found to grow in the wrong direction. Arguments: frame pointer, previous frame pointer. */
+    PLCRASH_TRACE_STACK_WRONG_DIRECTION = 2,
+
+    /** Reading a frame pointer's saved registers failed. Arguments: frame pointer, error. */
+    PLCRASH_TRACE_STACK_READ_FAILED = 3,
+
+    /** No image was found for a compact unwind lookup. Arguments: pc. */
+    PLCRASH_TRACE_CFE_NO_IMAGE = 4,
+
+    /** Mapping an image's compact unwind section failed. Arguments: image header address, error. */
+    PLCRASH_TRACE_CFE_MAP_FAILED = 5,
+
+    /** Parsing an image's compact unwind section failed. Arguments: image header address, error. */
+    PLCRASH_TRACE_CFE_PARSE_FAILED = 6,
+
+    /** No compact unwind entry was found. Arguments: pc, error. */
+    PLCRASH_TRACE_CFE_NOT_FOUND = 7,
+
+    /** Decoding a compact unwind entry failed. Arguments: pc, encoding, error. */
+    PLCRASH_TRACE_CFE_DECODE_FAILED = 8,
+
+    /** Applying a compact unwind entry failed. Arguments: pc, encoding, error. */
+    PLCRASH_TRACE_CFE_APPLY_FAILED = 9,
+
+    /** No image was found for a DWARF unwind lookup. Arguments: pc. */
+    PLCRASH_TRACE_DWARF_NO_IMAGE = 10,
+
+    /** Initializing a DWARF parser failed. Arguments: pc, 1 if debug_frame or 0 if eh_frame, error. */
+    PLCRASH_TRACE_DWARF_PARSER_FAILED = 11,
+
+    /** Parsing a DWARF CIE failed. Arguments: CIE offset, error. */
+    PLCRASH_TRACE_DWARF_CIE_FAILED = 12,
+
+    /** Evaluating a DWARF CFA program failed. Arguments: instruction offset, error. */
+    PLCRASH_TRACE_DWARF_EVAL_FAILED = 13,
+
+    /** Applying a DWARF CFA state failed. Arguments: pc, error. */
+    PLCRASH_TRACE_DWARF_APPLY_FAILED = 14,
+
+    /** A frame pointer was found outside of its thread's stack. Arguments: frame pointer, stack low address, stack high address. */
+    PLCRASH_TRACE_STACK_OUT_OF_BOUNDS = 15,
+} plcrash_async_trace_event_t;
+
+/**
+ * @internal
+ *
+ * A recorded trace event.
+ */
+typedef struct plcrash_async_trace_entry {
+    /** The entry's sequence number, starting at 1. A value of 0 marks an entry that is being written. */
+    volatile uint64_t seq;
+
+    /** The event identifier. */
+    uint32_t event;
+
+    /** The number of valid values in @a args. */
+    uint32_t argc;
+
+    /** The event's arguments. */
+    uint64_t args[PLCRASH_ASYNC_TRACE_MAX_ARGS];
+} plcrash_async_trace_entry_t;
+
+/**
+ * @internal
+ * @hideinitializer
+ *
+ * Record a trace event with between one and PLCRASH_ASYNC_TRACE_MAX_ARGS integer arguments.
+ *
+ * @param event The plcrash_async_trace_event_t identifier.
+ */
+#define PLCF_TRACE(event, ...) \
+    plcrash_async_trace_record((event), PLCF_TRACE_NARGS(__VA_ARGS__), PLCF_TRACE_ARGS(__VA_ARGS__, 0, 0, 0, 0))
+
+/** @internal Count the arguments supplied to PLCF_TRACE(). */
+#define PLCF_TRACE_NARGS(...) PLCF_TRACE_NARGS_(__VA_ARGS__, 4, 3, 2, 1, 0)
+#define PLCF_TRACE_NARGS_(a0, a1, a2, a3, n, ...) (n)
+
+/** @internal Pad the arguments supplied to PLCF_TRACE() to PLCRASH_ASYNC_TRACE_MAX_ARGS values. */
+#define PLCF_TRACE_ARGS(a0, a1, a2, a3, ...) (uint64_t) (a0), (uint64_t) (a1), (uint64_t) (a2), (uint64_t) (a3)
+
+void plcrash_async_trace_record (uint32_t event, uint32_t argc, uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3);
+size_t plcrash_async_trace_snapshot (plcrash_async_trace_entry_t *entries, size_t count);
+const char *plcrash_async_trace_event_name (uint32_t event);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_TRACE_H */
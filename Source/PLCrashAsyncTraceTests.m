@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashAsyncTrace.h"
+
+@interface PLCrashAsyncTraceTests : SenTestCase {
+@private
+}
+@end
+
+@implementation PLCrashAsyncTraceTests
+
+/**
+ * Test recording and reading back a trace event.
+ */
+- (void) testRecord {
+    plcrash_async_trace_entry_t entries[PLCRASH_ASYNC_TRACE_CAPACITY];
+
+    PLCF_TRACE(PLCRASH_TRACE_CFE_DECODE_FAILED, 0x1000, 0x2, 3);
+
+    size_t count = plcrash_async_trace_snapshot(entries, PLCRASH_ASYNC_TRACE_CAPACITY);
+    STAssertTrue(count > 0, @"No events returned");
+
+    plcrash_async_trace_entry_t *entry = &entries[count - 1];
+    STAssertEquals(entry->event, (uint32_t) PLCRASH_TRACE_CFE_DECODE_FAILED, @"Incorrect event");
+    STAssertEquals(entry->argc, (uint32_t) 3, @"Incorrect argument count");
+    STAssertEquals(entry->args[0], (uint64_t) 0x1000, @"Incorrect argument");
+    STAssertEquals(entry->args[1], (uint64_t) 0x2, @"Incorrect argument");
+    STAssertEquals(entry->args[2], (uint64_t) 3, @"Incorrect argument");
+    STAssertEquals(entry->args[3], (uint64_t) 0, @"Unused argument was not zeroed");
+
+    STAssertEqualCStrings(plcrash_async_trace_event_name(entry->event), "cfe_decode_failed", @"Incorrect event name");
+}
+
+/**
+ * Test that the oldest events are dropped once the buffer wraps, and that snapshots are returned in order.
+ */
+- (void) testWrap {
+    plcrash_async_trace_entry_t entries[PLCRASH_ASYNC_TRACE_CAPACITY];
+
+    for (uint64_t i = 0; i < PLCRASH_ASYNC_TRACE_CAPACITY + 10; i++)
+        PLCF_TRACE(PLCRASH_TRACE_STACK_READ_FAILED, i, 0);
+
+    size_t count = plcrash_async_trace_snapshot(entries, PLCRASH_ASYNC_TRACE_CAPACITY);
+    STAssertEquals(count, (size_t) PLCRASH_ASYNC_TRACE_CAPACITY, @"Incorrect event count");
+
+    for (size_t i = 0; i < count; i++) {
+        STAssertEquals(entries[i].args[0], (uint64_t) (i + 10), @"Events returned out of order");
+        if (i > 0)
+            STAssertEquals(entries[i].seq, entries[i - 1].seq + 1, @"Sequence numbers are not contiguous");
+    }
+
+    /* A smaller snapshot should return the most recent events */
+    count = plcrash_async_trace_snapshot(entries, 2);
+    STAssertEquals(count, (size_t) 2, @"Incorrect event count");
+    STAssertEquals(entries[1].args[0], (uint64_t) PLCRASH_ASYNC_TRACE_CAPACITY + 9, @"Incorrect most recent event");
+}
+
+@end
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashBreadcrumbRing.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <libkern/OSAtomic.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_breadcrumb_ring
+ * @{
+ */
+
+/**
+ * Initialize @a ring, mapping the ring persisted at @a path. If the file does not exist, or does not contain a valid
+ * ring of the requested size, a new empty ring is written; otherwise, the previously recorded breadcrumbs are
+ * retained, and may be read prior to calling plcrash_nasync_breadcrumb_ring_reset().
+ *
+ * @param ring The ring to initialize.
+ * @param path The path at which the ring is persisted.
+ * @param size The total size of the ring file, in bytes. This must be large enough to hold at least one slot.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a size is too small, or PLCRASH_EINTERNAL if the
+ * ring could not be mapped.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_breadcrumb_ring_init (plcrash_breadcrumb_ring_t *ring, const char *path, size_t size) {
+    ring->header = NULL;
+    ring->slots = NULL;
+    ring->slot_count = 0;
+    ring->mapping_size = 0;
+
+    if (size < sizeof(plcrash_breadcrumb_ring_header_t) + sizeof(plcrash_breadcrumb_slot_t))
+        return PLCRASH_EINVAL;
+
+    size_t slot_count = (size - sizeof(plcrash_breadcrumb_ring_header_t)) / sizeof(plcrash_breadcrumb_slot_t);
+    if (slot_count > UINT32_MAX)
+        return PLCRASH_EINVAL;
+
+    size_t mapping_size = sizeof(plcrash_breadcrumb_ring_header_t) + (slot_count * sizeof(plcrash_breadcrumb_slot_t));
+
+    int fd = open(path, O_RDWR|O_CREAT, 0644);
+    if (fd < 0) {
+        PLCF_DEBUG("Could not open the breadcrumb ring: %s", strerror(errno));
+        return PLCRASH_EINTERNAL;
+    }
+
+    /* Size the file to hold the ring; any previously persisted data within that range is preserved */
+    if (ftruncate(fd, mapping_size) != 0) {
+        PLCF_DEBUG("Could not size the breadcrumb ring: %s", strerror(errno));
+        close(fd);
+        return PLCRASH_EINTERNAL;
+    }
+
+    void *mapping = mmap(NULL, mapping_size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        PLCF_DEBUG("Could not map the breadcrumb ring: %s", strerror(errno));
+        return PLCRASH_EINTERNAL;
+    }
+
+    ring->header = mapping;
+    ring->slots = (plcrash_breadcrumb_slot_t *) (ring->header + 1);
+    ring->slot_count = (uint32_t) slot_count;
+    ring->mapping_size = mapping_size;
+
+    /* Discard an invalid, incompatible, or differently sized ring */
+    plcrash_breadcrumb_ring_header_t *header = ring->header;
+    if (memcmp(header->magic, PLCRASH_BREADCRUMB_RING_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PLCRASH_BREADCRUMB_RING_VERSION ||
+        header->slot_count != ring->slot_count)
+    {
+        memset(header, 0, mapping_size);
+        memcpy(header->magic, PLCRASH_BREADCRUMB_RING_MAGIC, sizeof(header->magic));
+        header->version = PLCRASH_BREADCRUMB_RING_VERSION;
+        header->slot_count = ring->slot_count;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Discard all breadcrumbs recorded in @a ring. This must not be called concurrently with
+ * plcrash_async_breadcrumb_ring_record().
+ *
+ * @param ring An initialized ring.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_breadcrumb_ring_reset (plcrash_breadcrumb_ring_t *ring) {
+    if (ring->header == NULL)
+        return;
+
+    memset(ring->slots, 0, ring->slot_count * sizeof(plcrash_breadcrumb_slot_t));
+    OSMemoryBarrier();
+    ring->header->count = 0;
+}
+
+/**
+ * Free all resources associated with @a ring. The ring remains persisted.
+ *
+ * @warning This method is not async safe.
+ */
+void plcrash_nasync_breadcrumb_ring_free (plcrash_breadcrumb_ring_t *ring) {
+    if (ring->header != NULL)
+        munmap(ring->header, ring->mapping_size);
+
+    ring->header = NULL;
+    ring->slots = NULL;
+    ring->slot_count = 0;
+}
+
+/**
+ * Record a breadcrumb in @a ring. Breadcrumbs longer than PLCRASH_BREADCRUMB_MAX_LENGTH are truncated.
+ *
+ * @param ring The ring to which the breadcrumb will be written.
+ * @param data The breadcrumb data.
+ * @param length The length of @a data, in bytes.
+ *
+ * @return Returns true if the breadcrumb was recorded, or false if @a ring is not initialized.
+ */
+bool plcrash_async_breadcrumb_ring_record (plcrash_breadcrumb_ring_t *ring, const void *data, size_t length) {
+    plcrash_breadcrumb_ring_header_t *header = ring->header;
+    if (header == NULL)
+        return false;
+
+    if (length > PLCRASH_BREADCRUMB_MAX_LENGTH)
+        length = PLCRASH_BREADCRUMB_MAX_LENGTH;
+
+    /* Claim the next slot */
+    uint64_t seq = (uint64_t) OSAtomicIncrement64Barrier(&header->count);
+    plcrash_breadcrumb_slot_t *slot = &ring->slots[(seq - 1) % ring->slot_count];
+
+    /* Mark the slot as incomplete while it is populated */
+    slot->seq = 0;
+    OSMemoryBarrier();
+
+    slot->length = (uint32_t) length;
+    plcrash_async_memcpy(slot->data, data, length);
+
+    OSMemoryBarrier();
+    slot->seq = seq;
+
+    return true;
+}
+
+/**
+ * Return the range of sequence numbers that may currently be read from @a ring.
+ *
+ * @param ring The ring to query.
+ * @param[out] end On return, the sequence number of the most recently claimed slot, or 0 if none.
+ *
+ * @return Returns the sequence number of the oldest breadcrumb that may still be retained. If greater than @a end, the
+ * ring is empty.
+ */
+uint64_t plcrash_async_breadcrumb_ring_first (plcrash_breadcrumb_ring_t *ring, uint64_t *end) {
+    *end = 0;
+    if (ring->header == NULL)
+        return 1;
+
+    *end = (uint64_t) OSAtomicAdd64Barrier(0, &ring->header->count);
+    if (*end > ring->slot_count)
+        return *end - ring->slot_count + 1;
+
+    return 1;
+}
+
+/**
+ * Copy the breadcrumb with sequence number @a seq from @a ring to @a dest. Breadcrumbs that have been overwritten or
+ * are still being written are not returned.
+ *
+ * @param ring The ring to read.
+ * @param seq The breadcrumb's sequence number.
+ * @param dest The destination slot.
+ *
+ * @return Returns true if the breadcrumb was copied to @a dest, or false if it is unavailable.
+ */
+bool plcrash_async_breadcrumb_ring_read (plcrash_breadcrumb_ring_t *ring, uint64_t seq, plcrash_breadcrumb_slot_t *dest) {
+    if (ring->header == NULL || seq == 0)
+        return false;
+
+    plcrash_breadcrumb_slot_t *slot = &ring->slots[(seq - 1) % ring->slot_count];
+    if (slot->seq != seq)
+        return false;
+
+    OSMemoryBarrier();
+    uint32_t length = slot->length;
+    if (length > PLCRASH_BREADCRUMB_MAX_LENGTH)
+        return false;
+
+    dest->length = length;
+    dest->reserved = 0;
+    plcrash_async_memcpy(dest->data, slot->data, length);
+    OSMemoryBarrier();
+
+    /* Discard the copy if the slot was reused while it was being read */
+    if (slot->seq != seq)
+        return false;
+
+    dest->seq = seq;
+    return true;
+}
+
+/**
+ * @}
+ */
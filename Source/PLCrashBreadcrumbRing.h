@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_BREADCRUMB_RING_H
+#define PLCRASH_BREADCRUMB_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_breadcrumb_ring Persistent Breadcrumb Ring
+ * @ingroup plcrash_internal
+ *
+ * A fixed-size ring of application-recorded breadcrumbs, memory-mapped from disk. Any number of threads may record
+ * breadcrumbs concurrently; recording a breadcrumb claims a slot with a single atomic increment and copies the
+ * breadcrumb's bytes into it, without locks or system calls. When the ring is full, the oldest breadcrumbs are
+ * overwritten.
+ *
+ * The ring's valid entries are written to each crash report. As the ring is a shared file mapping, its contents also
+ * survive the abrupt termination of the process, eg, by SIGKILL, and may be read on the next launch.
+ *
+ * @{
+ */
+
+/** The breadcrumb ring file magic. */
+#define PLCRASH_BREADCRUMB_RING_MAGIC "plcrumb"
+
+/** The breadcrumb ring file format version. */
+#define PLCRASH_BREADCRUMB_RING_VERSION 1
+
+/** The size of a single breadcrumb slot, in bytes. */
+#define PLCRASH_BREADCRUMB_SLOT_SIZE 128
+
+/** The maximum length of a breadcrumb, in bytes. Longer breadcrumbs are truncated. */
+#define PLCRASH_BREADCRUMB_MAX_LENGTH (PLCRASH_BREADCRUMB_SLOT_SIZE - 16)
+
+/**
+ * @internal
+ *
+ * A single breadcrumb slot.
+ */
+typedef struct plcrash_breadcrumb_slot {
+    /** The breadcrumb's sequence number, starting at 1. A value of 0 marks a slot that is unused or being written. */
+    volatile uint64_t seq;
+
+    /** The number of valid bytes in @a data. */
+    uint32_t length;
+
+    /** Reserved; must be zero. */
+    uint32_t reserved;
+
+    /** The breadcrumb data. */
+    uint8_t data[PLCRASH_BREADCRUMB_MAX_LENGTH];
+} plcrash_breadcrumb_slot_t;
+
+/**
+ * @internal
+ *
+ * The persisted breadcrumb ring header, followed by @a slot_count slots. All values are in host byte order.
+ */
+typedef struct plcrash_breadcrumb_ring_header {
+    /** The PLCRASH_BREADCRUMB_RING_MAGIC value, not NUL terminated. */
+    char magic[7];
+
+    /** The PLCRASH_BREADCRUMB_RING_VERSION value. */
+    uint8_t version;
+
+    /** The number of slots that follow the header. */
+    uint32_t slot_count;
+
+    /** Reserved; must be zero. */
+    uint32_t reserved;
+
+    /** The total number of breadcrumbs that have been recorded. Must be updated atomically. */
+    volatile int64_t count;
+
+    /** Reserved; must be zero. */
+    uint64_t reserved2;
+} plcrash_breadcrumb_ring_header_t;
+
+/**
+ * @internal
+ *
+ * Breadcrumb ring state.
+ */
+typedef struct plcrash_breadcrumb_ring {
+    /** The mapped ring, or NULL if the ring is not initialized. */
+    plcrash_breadcrumb_ring_header_t *header;
+
+    /** The ring's slots. */
+    plcrash_breadcrumb_slot_t *slots;
+
+    /** The number of entries in @a slots. */
+    uint32_t slot_count;
+
+    /** The size of the mapping, in bytes. */
+    size_t mapping_size;
+} plcrash_breadcrumb_ring_t;
+
+plcrash_error_t plcrash_nasync_breadcrumb_ring_init (plcrash_breadcrumb_ring_t *ring, const char *path, size_t size);
+void plcrash_nasync_breadcrumb_ring_reset (plcrash_breadcrumb_ring_t *ring);
+void plcrash_nasync_breadcrumb_ring_free (plcrash_breadcrumb_ring_t *ring);
+
+bool plcrash_async_breadcrumb_ring_record (plcrash_breadcrumb_ring_t *ring, const void *data, size_t length);
+uint64_t plcrash_async_breadcrumb_ring_first (plcrash_breadcrumb_ring_t *ring, uint64_t *end);
+bool plcrash_async_breadcrumb_ring_read (plcrash_breadcrumb_ring_t *ring, uint64_t seq, plcrash_breadcrumb_slot_t *dest);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_BREADCRUMB_RING_H */
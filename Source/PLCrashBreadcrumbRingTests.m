@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashBreadcrumbRing.h"
+
+/** Ring file size sufficient for four slots. */
+#define RING_SIZE (sizeof(plcrash_breadcrumb_ring_header_t) + (4 * sizeof(plcrash_breadcrumb_slot_t)))
+
+@interface PLCrashBreadcrumbRingTests : SenTestCase {
+@private
+    /** Ring path. */
+    NSString *_path;
+}
+@end
+
+@implementation PLCrashBreadcrumbRingTests
+
+- (void) setUp {
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _path error: NULL];
+    [_path release];
+}
+
+/**
+ * Verify that recorded breadcrumbs may be read back, and that the oldest breadcrumbs are overwritten once the ring is full.
+ */
+- (void) testRecordAndWrap {
+    plcrash_breadcrumb_ring_t ring;
+    plcrash_breadcrumb_slot_t slot;
+    uint64_t first, end;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_breadcrumb_ring_init(&ring, [_path fileSystemRepresentation], RING_SIZE), @"Failed to initialize ring");
+    STAssertEquals((uint32_t) 4, ring.slot_count, @"Incorrect slot count");
+
+    first = plcrash_async_breadcrumb_ring_first(&ring, &end);
+    STAssertTrue(first > end, @"A new ring must be empty");
+
+    for (int i = 0; i < 6; i++) {
+        char msg[16];
+        snprintf(msg, sizeof(msg), "crumb %d", i);
+        STAssertTrue(plcrash_async_breadcrumb_ring_record(&ring, msg, strlen(msg)), @"Failed to record breadcrumb");
+    }
+
+    first = plcrash_async_breadcrumb_ring_first(&ring, &end);
+    STAssertEquals((uint64_t) 3, first, @"Incorrect first sequence number");
+    STAssertEquals((uint64_t) 6, end, @"Incorrect last sequence number");
+
+    STAssertFalse(plcrash_async_breadcrumb_ring_read(&ring, 2, &slot), @"Overwritten breadcrumb must not be returned");
+    STAssertTrue(plcrash_async_breadcrumb_ring_read(&ring, 3, &slot), @"Failed to read breadcrumb");
+    STAssertEquals((uint64_t) 3, slot.seq, @"Incorrect sequence number");
+    STAssertEquals((uint32_t) strlen("crumb 2"), slot.length, @"Incorrect length");
+    STAssertTrue(memcmp(slot.data, "crumb 2", slot.length) == 0, @"Incorrect data");
+
+    STAssertTrue(plcrash_async_breadcrumb_ring_read(&ring, 6, &slot), @"Failed to read breadcrumb");
+    STAssertTrue(memcmp(slot.data, "crumb 5", slot.length) == 0, @"Incorrect data");
+
+    plcrash_nasync_breadcrumb_ring_free(&ring);
+}
+
+/**
+ * Verify that over-long breadcrumbs are truncated.
+ */
+- (void) testTruncation {
+    plcrash_breadcrumb_ring_t ring;
+    plcrash_breadcrumb_slot_t slot;
+    uint8_t data[PLCRASH_BREADCRUMB_MAX_LENGTH * 2];
+    memset(data, 'A', sizeof(data));
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_breadcrumb_ring_init(&ring, [_path fileSystemRepresentation], RING_SIZE), @"Failed to initialize ring");
+    STAssertTrue(plcrash_async_breadcrumb_ring_record(&ring, data, sizeof(data)), @"Failed to record breadcrumb");
+
+    STAssertTrue(plcrash_async_breadcrumb_ring_read(&ring, 1, &slot), @"Failed to read breadcrumb");
+    STAssertEquals((uint32_t) PLCRASH_BREADCRUMB_MAX_LENGTH, slot.length, @"Breadcrumb was not truncated");
+
+    plcrash_nasync_breadcrumb_ring_free(&ring);
+}
+
+/**
+ * Verify that the ring is persisted across mappings, is discarded if its size changes, and may be reset.
+ */
+- (void) testPersistence {
+    plcrash_breadcrumb_ring_t ring;
+    plcrash_breadcrumb_slot_t slot;
+    uint64_t first, end;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_breadcrumb_ring_init(&ring, [_path fileSystemRepresentation], RING_SIZE), @"Failed to initialize ring");
+    plcrash_async_breadcrumb_ring_record(&ring, "persisted", strlen("persisted"));
+    plcrash_nasync_breadcrumb_ring_free(&ring);
+
+    /* Remap the ring */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_breadcrumb_ring_init(&ring, [_path fileSystemRepresentation], RING_SIZE), @"Failed to initialize ring");
+    first = plcrash_async_breadcrumb_ring_first(&ring, &end);
+    STAssertEquals((uint64_t) 1, end, @"Breadcrumb was not persisted");
+    STAssertTrue(plcrash_async_breadcrumb_ring_read(&ring, 1, &slot), @"Failed to read persisted breadcrumb");
+    STAssertTrue(memcmp(slot.data, "persisted", slot.length) == 0, @"Incorrect data");
+
+    /* Reset the ring */
+    plcrash_nasync_breadcrumb_ring_reset(&ring);
+    first = plcrash_async_breadcrumb_ring_first(&ring, &end);
+    STAssertEquals((uint64_t) 0, end, @"Ring was not reset");
+    STAssertFalse(plcrash_async_breadcrumb_ring_read(&ring, 1, &slot), @"Reset breadcrumb must not be returned");
+
+    plcrash_async_breadcrumb_ring_record(&ring, "resized", strlen("resized"));
+    plcrash_nasync_breadcrumb_ring_free(&ring);
+
+    /* A differently sized ring must be discarded */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_breadcrumb_ring_init(&ring, [_path fileSystemRepresentation], RING_SIZE * 2), @"Failed to initialize ring");
+    first = plcrash_async_breadcrumb_ring_first(&ring, &end);
+    STAssertEquals((uint64_t) 0, end, @"Differently sized ring was not discarded");
+    plcrash_nasync_breadcrumb_ring_free(&ring);
+}
+
+/**
+ * Verify that an undersized ring is rejected.
+ */
+- (void) testInvalidSize {
+    plcrash_breadcrumb_ring_t ring;
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_breadcrumb_ring_init(&ring, [_path fileSystemRepresentation], sizeof(plcrash_breadcrumb_ring_header_t)), @"Undersized ring must be rejected");
+    STAssertFalse(plcrash_async_breadcrumb_ring_record(&ring, "x", 1), @"Uninitialized ring must not accept breadcrumbs");
+}
+
+@end
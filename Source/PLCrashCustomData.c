@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashCustomData.h"
+
+#include <string.h>
+#include <libkern/OSAtomic.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_custom_data
+ * @{
+ */
+
+/**
+ * Initialize @a registry as an empty registry.
+ *
+ * @param registry The registry to initialize.
+ *
+ * @warning This method is not async safe, and must not be called while the registry is in use.
+ */
+void plcrash_nasync_custom_data_registry_init (plcrash_custom_data_registry_t *registry) {
+    memset(registry, 0, sizeof(*registry));
+}
+
+/**
+ * Register an application-owned memory region with @a registry. The region's contents will be written to each report
+ * written while the region remains registered.
+ *
+ * @param registry The registry to which the region will be added.
+ * @param identifier The NUL-terminated region identifier. This value is copied.
+ * @param address The region's address. The region must remain valid until it has been unregistered.
+ * @param length The length of @a address, in bytes.
+ * @param version An application-owned version counter, or NULL. If non-NULL, the counter must remain valid until the
+ * region has been unregistered, and must be odd while the region is being modified.
+ * @param[out] handle On success, the handle to be passed to plcrash_nasync_custom_data_unregister().
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a identifier is NULL or too long, or PLCRASH_ENOMEM if
+ * PLCRASH_CUSTOM_DATA_MAX_REGIONS regions are already registered.
+ *
+ * @warning This method is not async safe. It may be called concurrently with any other registry function.
+ */
+plcrash_error_t plcrash_nasync_custom_data_register (plcrash_custom_data_registry_t *registry,
+                                                    const char *identifier,
+                                                    const void *address,
+                                                    size_t length,
+                                                    const volatile uint32_t *version,
+                                                    uint32_t *handle)
+{
+    if (identifier == NULL)
+        return PLCRASH_EINVAL;
+
+    size_t identifier_len = strlen(identifier);
+    if (identifier_len >= PLCRASH_CUSTOM_DATA_IDENTIFIER_MAX)
+        return PLCRASH_EINVAL;
+
+    for (uint32_t i = 0; i < PLCRASH_CUSTOM_DATA_MAX_REGIONS; i++) {
+        plcrash_custom_data_region_t *region = &registry->regions[i];
+
+        /* Claim a free slot */
+        if (!OSAtomicCompareAndSwap32Barrier(PLCRASH_CUSTOM_DATA_REGION_FREE, PLCRASH_CUSTOM_DATA_REGION_BUSY, &region->state))
+            continue;
+
+        memcpy(region->identifier, identifier, identifier_len + 1);
+        region->address = address;
+        region->length = length;
+        region->version = version;
+        OSAtomicIncrement32Barrier(&region->generation);
+
+        /* Publish the populated slot */
+        OSMemoryBarrier();
+        region->state = PLCRASH_CUSTOM_DATA_REGION_ACTIVE;
+
+        *handle = i;
+        return PLCRASH_ESUCCESS;
+    }
+
+    return PLCRASH_ENOMEM;
+}
+
+/**
+ * Unregister the region identified by @a handle. Once this function returns, the region will not be read by
+ * subsequently written reports; however, a report that is being written concurrently may still read the region.
+ *
+ * @param registry The registry from which the region will be removed.
+ * @param handle The handle returned by plcrash_nasync_custom_data_register().
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if @a handle does not identify a registered region.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_custom_data_unregister (plcrash_custom_data_registry_t *registry, uint32_t handle) {
+    if (handle >= PLCRASH_CUSTOM_DATA_MAX_REGIONS)
+        return PLCRASH_EINVAL;
+
+    plcrash_custom_data_region_t *region = &registry->regions[handle];
+    if (!OSAtomicCompareAndSwap32Barrier(PLCRASH_CUSTOM_DATA_REGION_ACTIVE, PLCRASH_CUSTOM_DATA_REGION_BUSY, &region->state))
+        return PLCRASH_EINVAL;
+
+    region->address = NULL;
+    region->length = 0;
+    region->version = NULL;
+
+    OSMemoryBarrier();
+    region->state = PLCRASH_CUSTOM_DATA_REGION_FREE;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Copy the descriptor of the region registered in slot @a index to @a dest. The region's contents are not copied.
+ *
+ * @param registry The registry to read.
+ * @param index The slot index, less than PLCRASH_CUSTOM_DATA_MAX_REGIONS.
+ * @param dest The destination descriptor.
+ *
+ * @return Returns true if a registered region was copied to @a dest, or false if the slot is unused, or was modified
+ * while it was being read.
+ */
+bool plcrash_async_custom_data_read (plcrash_custom_data_registry_t *registry, uint32_t index, plcrash_custom_data_region_t *dest) {
+    if (index >= PLCRASH_CUSTOM_DATA_MAX_REGIONS)
+        return false;
+
+    plcrash_custom_data_region_t *region = &registry->regions[index];
+    if (region->state != PLCRASH_CUSTOM_DATA_REGION_ACTIVE)
+        return false;
+
+    OSMemoryBarrier();
+    int32_t generation = region->generation;
+
+    plcrash_async_memcpy(dest->identifier, region->identifier, sizeof(dest->identifier));
+    dest->identifier[sizeof(dest->identifier) - 1] = '\0';
+    dest->address = region->address;
+    dest->length = region->length;
+    dest->version = region->version;
+
+    /* Discard the copy if the slot was unregistered or reused while it was being read */
+    OSMemoryBarrier();
+    if (region->state != PLCRASH_CUSTOM_DATA_REGION_ACTIVE || region->generation != generation)
+        return false;
+
+    dest->state = PLCRASH_CUSTOM_DATA_REGION_ACTIVE;
+    dest->generation = generation;
+    return true;
+}
+
+/**
+ * @}
+ */
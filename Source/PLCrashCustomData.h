@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_CUSTOM_DATA_H
+#define PLCRASH_CUSTOM_DATA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_custom_data Custom Data Regions
+ * @ingroup plcrash_internal
+ *
+ * A fixed-size registry of application-owned memory regions that are written, as-is, to each crash report. The
+ * region's bytes are never copied by the reporter prior to a crash; at crash time, they are passed directly from
+ * the application's memory to the report's output.
+ *
+ * As the application may be modifying a region while a report is written, each region may be paired with an
+ * application-owned version counter, which must be incremented to an odd value before the region is modified, and
+ * to an even value once the modification is complete. If the counter is odd, or changes while the region is being
+ * written, the written region is marked as torn.
+ *
+ * @{
+ */
+
+/** The maximum number of simultaneously registered regions. */
+#define PLCRASH_CUSTOM_DATA_MAX_REGIONS 16
+
+/** The maximum length of a region identifier, in bytes, including the NUL terminator. */
+#define PLCRASH_CUSTOM_DATA_IDENTIFIER_MAX 64
+
+/**
+ * @internal
+ *
+ * Custom data region slot states.
+ */
+typedef enum {
+    /** The slot is unused. */
+    PLCRASH_CUSTOM_DATA_REGION_FREE = 0,
+
+    /** The slot is being registered or unregistered, and must not be read. */
+    PLCRASH_CUSTOM_DATA_REGION_BUSY = 1,
+
+    /** The slot holds a registered region. */
+    PLCRASH_CUSTOM_DATA_REGION_ACTIVE = 2
+} plcrash_custom_data_region_state_t;
+
+/**
+ * @internal
+ *
+ * A registered custom data region.
+ */
+typedef struct plcrash_custom_data_region {
+    /** The slot's plcrash_custom_data_region_state_t. Must be updated atomically. */
+    volatile int32_t state;
+
+    /** Incremented each time the slot is registered; used to detect a slot's reuse while it is being read. */
+    volatile int32_t generation;
+
+    /** The NUL-terminated region identifier. */
+    char identifier[PLCRASH_CUSTOM_DATA_IDENTIFIER_MAX];
+
+    /** The application-owned region. */
+    const void *address;
+
+    /** The length of @a address, in bytes. */
+    size_t length;
+
+    /** The application-owned version counter, or NULL if torn writes are not detected. */
+    const volatile uint32_t *version;
+} plcrash_custom_data_region_t;
+
+/**
+ * @internal
+ *
+ * Custom data region registry. A zero-initialized registry is empty, and ready for use.
+ */
+typedef struct plcrash_custom_data_registry {
+    /** The registry's region slots. */
+    plcrash_custom_data_region_t regions[PLCRASH_CUSTOM_DATA_MAX_REGIONS];
+} plcrash_custom_data_registry_t;
+
+void plcrash_nasync_custom_data_registry_init (plcrash_custom_data_registry_t *registry);
+
+plcrash_error_t plcrash_nasync_custom_data_register (plcrash_custom_data_registry_t *registry,
+                                                    const char *identifier,
+                                                    const void *address,
+                                                    size_t length,
+                                                    const volatile uint32_t *version,
+                                                    uint32_t *handle);
+plcrash_error_t plcrash_nasync_custom_data_unregister (plcrash_custom_data_registry_t *registry, uint32_t handle);
+
+bool plcrash_async_custom_data_read (plcrash_custom_data_registry_t *registry, uint32_t index, plcrash_custom_data_region_t *dest);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_CUSTOM_DATA_H */
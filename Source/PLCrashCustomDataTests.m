@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashCustomData.h"
+
+@interface PLCrashCustomDataTests : SenTestCase @end
+
+@implementation PLCrashCustomDataTests
+
+/**
+ * Verify that registered regions may be read, and are no longer returned once unregistered.
+ */
+- (void) testRegister {
+    plcrash_custom_data_registry_t registry;
+    plcrash_custom_data_region_t region;
+    uint8_t bytes[32];
+    uint32_t version = 0;
+    uint32_t handle;
+
+    plcrash_nasync_custom_data_registry_init(&registry);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_custom_data_register(&registry, "state", bytes, sizeof(bytes), &version, &handle), @"Failed to register region");
+
+    STAssertTrue(plcrash_async_custom_data_read(&registry, handle, &region), @"Failed to read region");
+    STAssertEqualCStrings("state", region.identifier, @"Incorrect identifier");
+    STAssertEquals((const void *) bytes, region.address, @"Incorrect address");
+    STAssertEquals(sizeof(bytes), region.length, @"Incorrect length");
+    STAssertEquals((const volatile uint32_t *) &version, region.version, @"Incorrect version counter");
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_custom_data_unregister(&registry, handle), @"Failed to unregister region");
+    STAssertFalse(plcrash_async_custom_data_read(&registry, handle, &region), @"Unregistered region must not be returned");
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_custom_data_unregister(&registry, handle), @"Region must not be unregistered twice");
+}
+
+/**
+ * Verify that invalid identifiers and registrations beyond the registry's capacity are rejected.
+ */
+- (void) testLimits {
+    plcrash_custom_data_registry_t registry;
+    char identifier[PLCRASH_CUSTOM_DATA_IDENTIFIER_MAX + 1];
+    uint8_t bytes[4];
+    uint32_t handle;
+
+    plcrash_nasync_custom_data_registry_init(&registry);
+
+    memset(identifier, 'A', sizeof(identifier) - 1);
+    identifier[sizeof(identifier) - 1] = '\0';
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_custom_data_register(&registry, identifier, bytes, sizeof(bytes), NULL, &handle), @"Over-long identifier must be rejected");
+
+    for (uint32_t i = 0; i < PLCRASH_CUSTOM_DATA_MAX_REGIONS; i++)
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_custom_data_register(&registry, "region", bytes, sizeof(bytes), NULL, &handle), @"Failed to register region");
+
+    STAssertEquals(PLCRASH_ENOMEM, plcrash_nasync_custom_data_register(&registry, "region", bytes, sizeof(bytes), NULL, &handle), @"Registration beyond capacity must fail");
+
+    /* Freed slots must be reused */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_custom_data_unregister(&registry, 3), @"Failed to unregister region");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_custom_data_register(&registry, "region", bytes, sizeof(bytes), NULL, &handle), @"Failed to register region");
+    STAssertEquals((uint32_t) 3, handle, @"Freed slot was not reused");
+}
+
+@end
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashDemangleCache.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_demangle_cache
+ * @{
+ */
+
+/** The minimum number of entries held by each shard. */
+#define MIN_SHARD_ENTRIES 8
+
+/* The C++ ABI demangler, provided by libc++abi */
+extern char *__cxa_demangle (const char *mangled_name, char *output_buffer, size_t *length, int *status);
+
+/* The Swift runtime demangler. This is only available if the Swift runtime is loaded, and is resolved at runtime. */
+typedef char *(*swift_demangle_fn) (const char *mangled_name, size_t mangled_name_length, char *output_buffer, size_t *output_buffer_size, uint32_t flags);
+
+static pthread_once_t swift_demangle_once = PTHREAD_ONCE_INIT;
+static swift_demangle_fn swift_demangle_function = NULL;
+
+static void swift_demangle_resolve (void) {
+    swift_demangle_function = (swift_demangle_fn) dlsym(RTLD_DEFAULT, "swift_demangle");
+}
+
+/**
+ * Return the Itanium C++ ABI mangled name within @a symbol, skipping any Mach-O global symbol prefix, or NULL if
+ * @a symbol is not a mangled C++ name.
+ */
+static const char *demangle_cxx_name (const char *symbol) {
+    if (symbol[0] == '_' && symbol[1] == '_' && symbol[2] == 'Z')
+        return symbol + 1;
+
+    if (symbol[0] == '_' && symbol[1] == 'Z')
+        return symbol;
+
+    return NULL;
+}
+
+/**
+ * Return the Swift mangled name within @a symbol, skipping any Mach-O global symbol prefix, or NULL if @a symbol is
+ * not a mangled Swift name.
+ */
+static const char *demangle_swift_name (const char *symbol) {
+    const char *name = symbol[0] == '_' ? symbol + 1 : symbol;
+
+    /* Swift 5 and later ($s), Swift 4.x ($S), Embedded Swift ($e), and Swift 4.0 and earlier (_T0) */
+    if (name[0] == '$' && (name[1] == 's' || name[1] == 'S' || name[1] == 'e'))
+        return name;
+
+    if (name[0] == '_' && name[1] == 'T' && name[2] == '0')
+        return name;
+
+    return NULL;
+}
+
+/**
+ * Return true if @a symbol is a mangled C++ or Swift name. The symbol may include the Mach-O global symbol prefix.
+ *
+ * @param symbol The symbol name.
+ */
+bool plcrash_demangle_is_mangled (const char *symbol) {
+    return demangle_cxx_name(symbol) != NULL || demangle_swift_name(symbol) != NULL;
+}
+
+/**
+ * Demangle the C++ or Swift symbol @a symbol, without consulting any cache. Swift symbols may only be demangled if
+ * the Swift runtime is loaded.
+ *
+ * @param symbol The symbol name. The symbol may include the Mach-O global symbol prefix.
+ *
+ * @return Returns the demangled name, which must be freed by the caller via free(), or NULL if @a symbol could not
+ * be demangled.
+ */
+char *plcrash_demangle (const char *symbol) {
+    const char *name;
+
+    if ((name = demangle_cxx_name(symbol)) != NULL) {
+        int status = 0;
+        char *result = __cxa_demangle(name, NULL, NULL, &status);
+        if (status != 0) {
+            free(result);
+            return NULL;
+        }
+
+        return result;
+    }
+
+    if ((name = demangle_swift_name(symbol)) != NULL) {
+        pthread_once(&swift_demangle_once, swift_demangle_resolve);
+        if (swift_demangle_function == NULL)
+            return NULL;
+
+        return swift_demangle_function(name, strlen(name), NULL, NULL, 0);
+    }
+
+    return NULL;
+}
+
+/**
+ * Return the hash of @a symbol, using the 64-bit FNV-1a hash, followed by a final mixing step so that both the low
+ * bits (used to select a slot) and high bits (used to select a shard) are well distributed.
+ */
+static uint64_t demangle_hash (const char *symbol) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (const char *p = symbol; *p != '\0'; p++) {
+        hash ^= (uint8_t) *p;
+        hash *= 0x100000001b3ULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * Return the shard for @a hash.
+ */
+static inline plcrash_demangle_cache_shard_t *demangle_shard (plcrash_demangle_cache_t *cache, uint64_t hash) {
+    return &cache->shards[(hash >> 58) & (PLCRASH_DEMANGLE_CACHE_SHARDS - 1)];
+}
+
+/**
+ * Return the slot of @a shard containing @a symbol, or the empty slot at which it would be inserted. The shard must
+ * be locked, and its entry table allocated.
+ */
+static plcrash_demangle_cache_entry_t *demangle_slot (plcrash_demangle_cache_t *cache, plcrash_demangle_cache_shard_t *shard, uint64_t hash, const char *symbol) {
+    size_t mask = cache->shard_capacity - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        plcrash_demangle_cache_entry_t *entry = &shard->entries[i];
+        if (entry->mangled == NULL)
+            return entry;
+
+        if (entry->hash == hash && strcmp(entry->mangled, symbol) == 0)
+            return entry;
+    }
+}
+
+/**
+ * Free all entries of @a shard, which must be locked.
+ */
+static void demangle_shard_clear (plcrash_demangle_cache_t *cache, plcrash_demangle_cache_shard_t *shard) {
+    if (shard->entries == NULL)
+        return;
+
+    for (size_t i = 0; i < cache->shard_capacity; i++) {
+        free(shard->entries[i].mangled);
+        free(shard->entries[i].demangled);
+    }
+
+    memset(shard->entries, 0, cache->shard_capacity * sizeof(*shard->entries));
+    shard->count = 0;
+}
+
+/**
+ * Cache @a demangled as the demangling of @a symbol within @a shard, which must be locked. Failure to allocate the
+ * entry is ignored.
+ */
+static void demangle_insert (plcrash_demangle_cache_t *cache, plcrash_demangle_cache_shard_t *shard, uint64_t hash, const char *symbol, const char *demangled) {
+    if (shard->entries == NULL && (shard->entries = calloc(cache->shard_capacity, sizeof(*shard->entries))) == NULL)
+        return;
+
+    /* Keep the load factor at or below one half; a full shard is emptied, bounding the cache's size */
+    if ((shard->count + 1) * 2 > cache->shard_capacity)
+        demangle_shard_clear(cache, shard);
+
+    plcrash_demangle_cache_entry_t *entry = demangle_slot(cache, shard, hash, symbol);
+    if (entry->mangled != NULL)
+        return;
+
+    char *mangled_copy = strdup(symbol);
+    char *demangled_copy = demangled != NULL ? strdup(demangled) : NULL;
+    if (mangled_copy == NULL || (demangled != NULL && demangled_copy == NULL)) {
+        free(mangled_copy);
+        free(demangled_copy);
+        return;
+    }
+
+    entry->hash = hash;
+    entry->mangled = mangled_copy;
+    entry->demangled = demangled_copy;
+    shard->count++;
+}
+
+/**
+ * Initialize an empty cache.
+ *
+ * @param cache The cache to initialize.
+ * @param max_entries The maximum number of entries to be held by the cache. The cache's entry tables are allocated
+ * on first use.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINTERNAL if the shard locks could not be initialized.
+ */
+plcrash_error_t plcrash_demangle_cache_init (plcrash_demangle_cache_t *cache, size_t max_entries) {
+    memset(cache, 0, sizeof(*cache));
+
+    /* Each shard's table is sized for a load factor of one half at the shard's maximum entry count */
+    size_t shard_entries = max_entries / PLCRASH_DEMANGLE_CACHE_SHARDS;
+    if (shard_entries < MIN_SHARD_ENTRIES)
+        shard_entries = MIN_SHARD_ENTRIES;
+
+    cache->shard_capacity = 1;
+    while (cache->shard_capacity < shard_entries * 2)
+        cache->shard_capacity *= 2;
+
+    for (size_t i = 0; i < PLCRASH_DEMANGLE_CACHE_SHARDS; i++) {
+        if (pthread_mutex_init(&cache->shards[i].lock, NULL) != 0) {
+            while (i-- > 0)
+                pthread_mutex_destroy(&cache->shards[i].lock);
+            return PLCRASH_EINTERNAL;
+        }
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Demangle @a symbol, returning the cached result if the symbol has previously been demangled. This may be called
+ * concurrently from any thread.
+ *
+ * Symbols are demangled outside of the shard's lock; concurrent misses on the same symbol may each demangle it.
+ *
+ * @param cache The cache.
+ * @param symbol The symbol name. The symbol may include the Mach-O global symbol prefix.
+ *
+ * @return Returns the demangled name, which must be freed by the caller via free(), or NULL if @a symbol is not
+ * mangled, or could not be demangled.
+ */
+char *plcrash_demangle_cache_copy_demangled (plcrash_demangle_cache_t *cache, const char *symbol) {
+    if (!plcrash_demangle_is_mangled(symbol))
+        return NULL;
+
+    uint64_t hash = demangle_hash(symbol);
+    plcrash_demangle_cache_shard_t *shard = demangle_shard(cache, hash);
+
+    /* Check the cache */
+    pthread_mutex_lock(&shard->lock);
+    if (shard->entries != NULL) {
+        plcrash_demangle_cache_entry_t *entry = demangle_slot(cache, shard, hash, symbol);
+        if (entry->mangled != NULL) {
+            char *result = entry->demangled != NULL ? strdup(entry->demangled) : NULL;
+            pthread_mutex_unlock(&shard->lock);
+            return result;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    /* Demangle and cache the result */
+    char *demangled = plcrash_demangle(symbol);
+
+    pthread_mutex_lock(&shard->lock);
+    demangle_insert(cache, shard, hash, symbol, demangled);
+    pthread_mutex_unlock(&shard->lock);
+
+    return demangled;
+}
+
+static pthread_once_t shared_cache_once = PTHREAD_ONCE_INIT;
+static plcrash_demangle_cache_t shared_cache;
+static bool shared_cache_initialized = false;
+
+static void shared_cache_init (void) {
+    shared_cache_initialized = (plcrash_demangle_cache_init(&shared_cache, PLCRASH_DEMANGLE_CACHE_DEFAULT_ENTRIES) == PLCRASH_ESUCCESS);
+}
+
+/**
+ * Return the process-wide demangle cache, shared by all report formatters and symbolicators, such that each
+ * frequently occurring symbol is demangled once per process. The cache holds at most
+ * PLCRASH_DEMANGLE_CACHE_DEFAULT_ENTRIES entries, and is never freed.
+ *
+ * @return Returns the shared cache, or NULL if it could not be initialized.
+ */
+plcrash_demangle_cache_t *plcrash_demangle_cache_shared (void) {
+    pthread_once(&shared_cache_once, shared_cache_init);
+    return shared_cache_initialized ? &shared_cache : NULL;
+}
+
+/**
+ * Free all resources associated with @a cache.
+ *
+ * @param cache The cache to free.
+ */
+void plcrash_demangle_cache_free (plcrash_demangle_cache_t *cache) {
+    for (size_t i = 0; i < PLCRASH_DEMANGLE_CACHE_SHARDS; i++) {
+        plcrash_demangle_cache_shard_t *shard = &cache->shards[i];
+
+        demangle_shard_clear(cache, shard);
+        free(shard->entries);
+        shard->entries = NULL;
+        pthread_mutex_destroy(&shard->lock);
+    }
+}
+
+/**
+ * @}
+ */
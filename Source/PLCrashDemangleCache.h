@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_DEMANGLE_CACHE_H
+#define PLCRASH_DEMANGLE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_demangle_cache Symbol Demangle Cache
+ * @ingroup plcrash_internal
+ *
+ * A bounded, concurrent cache of demangled C++ and Swift symbol names, keyed by mangled name, used to demangle each
+ * distinct symbol once across a batch of reports.
+ *
+ * As with the symbol resolution cache, the cache is divided into independently locked shards, selected by the
+ * name's hash. Each shard holds a fixed number of entries; a shard that fills is emptied, and repopulated by
+ * subsequent lookups. Names that can not be demangled are also cached.
+ *
+ * @{
+ */
+
+/** The number of independently locked shards. Must be a power of two. */
+#define PLCRASH_DEMANGLE_CACHE_SHARDS 16
+
+/** The default maximum number of entries of the shared cache. */
+#define PLCRASH_DEMANGLE_CACHE_DEFAULT_ENTRIES 16384
+
+/**
+ * A cached demangling.
+ */
+typedef struct plcrash_demangle_cache_entry {
+    /** The hash of @a mangled. */
+    uint64_t hash;
+
+    /** The mangled name, or NULL if this slot is unoccupied. */
+    char *mangled;
+
+    /** The demangled name, or NULL if the name could not be demangled. */
+    char *demangled;
+} plcrash_demangle_cache_entry_t;
+
+/**
+ * A single independently locked cache shard.
+ */
+typedef struct plcrash_demangle_cache_shard {
+    /** Lock guarding all shard state. */
+    pthread_mutex_t lock;
+
+    /** Open-addressed entry table, or NULL if not yet allocated. */
+    plcrash_demangle_cache_entry_t *entries;
+
+    /** The number of occupied slots. */
+    size_t count;
+} plcrash_demangle_cache_shard_t;
+
+/**
+ * A sharded demangle cache.
+ */
+typedef struct plcrash_demangle_cache {
+    /** The cache shards. */
+    plcrash_demangle_cache_shard_t shards[PLCRASH_DEMANGLE_CACHE_SHARDS];
+
+    /** The number of slots of each shard's entry table; always a power of two. */
+    size_t shard_capacity;
+} plcrash_demangle_cache_t;
+
+bool plcrash_demangle_is_mangled (const char *symbol);
+char *plcrash_demangle (const char *symbol);
+
+plcrash_error_t plcrash_demangle_cache_init (plcrash_demangle_cache_t *cache, size_t max_entries);
+char *plcrash_demangle_cache_copy_demangled (plcrash_demangle_cache_t *cache, const char *symbol);
+plcrash_demangle_cache_t *plcrash_demangle_cache_shared (void);
+void plcrash_demangle_cache_free (plcrash_demangle_cache_t *cache);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_DEMANGLE_CACHE_H */
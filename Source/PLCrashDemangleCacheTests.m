@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashDemangleCache.h"
+
+#import <libkern/OSAtomic.h>
+
+@interface PLCrashDemangleCacheTests : SenTestCase {
+@private
+    /** The cache under test. */
+    plcrash_demangle_cache_t _cache;
+}
+@end
+
+@implementation PLCrashDemangleCacheTests
+
+- (void) setUp {
+    STAssertEquals(plcrash_demangle_cache_init(&_cache, 64), PLCRASH_ESUCCESS, @"Failed to initialize cache");
+}
+
+- (void) tearDown {
+    plcrash_demangle_cache_free(&_cache);
+}
+
+/**
+ * Test detection of mangled names, with and without the Mach-O global symbol prefix.
+ */
+- (void) testIsMangled {
+    STAssertTrue(plcrash_demangle_is_mangled("__ZN7Example6methodEv"), @"C++ symbol not detected");
+    STAssertTrue(plcrash_demangle_is_mangled("_ZN7Example6methodEv"), @"Unprefixed C++ symbol not detected");
+    STAssertTrue(plcrash_demangle_is_mangled("_$s4main3fooyyF"), @"Swift symbol not detected");
+    STAssertTrue(plcrash_demangle_is_mangled("$s4main3fooyyF"), @"Unprefixed Swift symbol not detected");
+    STAssertTrue(plcrash_demangle_is_mangled("__T04main3fooyyF"), @"Swift 4.0 symbol not detected");
+
+    STAssertFalse(plcrash_demangle_is_mangled("_main"), @"C symbol detected as mangled");
+    STAssertFalse(plcrash_demangle_is_mangled("-[Example method]"), @"Objective-C symbol detected as mangled");
+    STAssertFalse(plcrash_demangle_is_mangled(""), @"Empty symbol detected as mangled");
+}
+
+/**
+ * Test demangling of C++ symbols, and caching of the results.
+ */
+- (void) testDemangle {
+    char *demangled = plcrash_demangle_cache_copy_demangled(&_cache, "__ZN7Example6methodEv");
+    STAssertNotNULL(demangled, @"Failed to demangle symbol");
+    if (demangled != NULL)
+        STAssertTrue(strcmp(demangled, "Example::method()") == 0, @"Incorrect demangled name %s", demangled);
+    free(demangled);
+
+    /* The second lookup is served from the cache */
+    size_t total = 0;
+    for (size_t i = 0; i < PLCRASH_DEMANGLE_CACHE_SHARDS; i++)
+        total += _cache.shards[i].count;
+    STAssertEquals(total, (size_t) 1, @"Demangled name was not cached");
+
+    demangled = plcrash_demangle_cache_copy_demangled(&_cache, "__ZN7Example6methodEv");
+    STAssertNotNULL(demangled, @"Failed to return the cached name");
+    if (demangled != NULL)
+        STAssertTrue(strcmp(demangled, "Example::method()") == 0, @"Incorrect cached name %s", demangled);
+    free(demangled);
+
+    /* Names that are not mangled are returned as NULL, and names that fail to demangle are cached as such */
+    STAssertNULL(plcrash_demangle_cache_copy_demangled(&_cache, "_main"), @"Demangled a C symbol");
+    STAssertNULL(plcrash_demangle_cache_copy_demangled(&_cache, "__Z"), @"Demangled an invalid symbol");
+    STAssertNULL(plcrash_demangle_cache_copy_demangled(&_cache, "__Z"), @"Demangled a cached invalid symbol");
+}
+
+/**
+ * Test that the cache remains bounded, and correct, under concurrent access to more symbols than it can hold.
+ */
+- (void) testConcurrentAccess {
+    plcrash_demangle_cache_t *cache = &_cache;
+    __block volatile int32_t mismatches = 0;
+
+    dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t worker) {
+        for (int i = 0; i < 1000; i++) {
+            char symbol[64];
+            char expected[64];
+            snprintf(symbol, sizeof(symbol), "__Z7exampleILi%dEEvv", i);
+            snprintf(expected, sizeof(expected), "void example<%d>()", i);
+
+            char *demangled = plcrash_demangle_cache_copy_demangled(cache, symbol);
+            if (demangled == NULL || strcmp(demangled, expected) != 0)
+                OSAtomicIncrement32(&mismatches);
+            free(demangled);
+        }
+    });
+
+    STAssertEquals((int32_t) mismatches, (int32_t) 0, @"Lookups returned incorrect names");
+
+    for (size_t i = 0; i < PLCRASH_DEMANGLE_CACHE_SHARDS; i++)
+        STAssertTrue(_cache.shards[i].count * 2 <= _cache.shard_capacity, @"Shard exceeded its capacity");
+}
+
+/**
+ * Test that the shared cache is available.
+ */
+- (void) testSharedCache {
+    plcrash_demangle_cache_t *shared = plcrash_demangle_cache_shared();
+    STAssertNotNULL(shared, @"Shared cache is unavailable");
+    STAssertEquals(shared, plcrash_demangle_cache_shared(), @"Shared cache is not a singleton");
+}
+
+@end
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashDuplicateFilter.h"
+#include "PLCrashFrameWalker.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_duplicate_filter
+ * @{
+ */
+
+/** The FNV-1a 64-bit offset basis. */
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+
+/** The FNV-1a 64-bit prime. */
+#define FNV_PRIME 0x100000001b3ULL
+
+/**
+ * Initialize @a filter, mapping the table persisted at @a path. If the file does not exist, or does not contain a
+ * valid table, a new empty table is written.
+ *
+ * @param filter The filter to initialize.
+ * @param path The path at which the table is persisted.
+ * @param window The suppression window, in seconds.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an appropriate error value if the table could not be mapped.
+ */
+plcrash_error_t plcrash_nasync_duplicate_filter_init (plcrash_duplicate_filter_t *filter, const char *path, int64_t window) {
+    filter->table = NULL;
+    filter->window = window;
+
+    int fd = open(path, O_RDWR|O_CREAT, 0644);
+    if (fd < 0) {
+        PLCF_DEBUG("Could not open the duplicate filter table: %s", strerror(errno));
+        return PLCRASH_EINTERNAL;
+    }
+
+    /* Size the file to hold the table; any previously persisted data within that range is preserved */
+    if (ftruncate(fd, sizeof(plcrash_duplicate_filter_table_t)) != 0) {
+        PLCF_DEBUG("Could not size the duplicate filter table: %s", strerror(errno));
+        close(fd);
+        return PLCRASH_EINTERNAL;
+    }
+
+    void *mapping = mmap(NULL, sizeof(plcrash_duplicate_filter_table_t), PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        PLCF_DEBUG("Could not map the duplicate filter table: %s", strerror(errno));
+        return PLCRASH_EINTERNAL;
+    }
+
+    /* Discard an invalid or incompatible table */
+    plcrash_duplicate_filter_table_t *table = mapping;
+    if (memcmp(table->magic, PLCRASH_DUPLICATE_FILTER_MAGIC, sizeof(table->magic)) != 0 || table->version != PLCRASH_DUPLICATE_FILTER_VERSION) {
+        memset(table, 0, sizeof(*table));
+        memcpy(table->magic, PLCRASH_DUPLICATE_FILTER_MAGIC, sizeof(table->magic));
+        table->version = PLCRASH_DUPLICATE_FILTER_VERSION;
+    }
+
+    filter->table = table;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Free all resources associated with @a filter. The table remains persisted.
+ */
+void plcrash_nasync_duplicate_filter_free (plcrash_duplicate_filter_t *filter) {
+    if (filter->table != NULL)
+        munmap(filter->table, sizeof(plcrash_duplicate_filter_table_t));
+    filter->table = NULL;
+}
+
+/**
+ * Return the total number of suppressed crash repeats recorded by @a filter.
+ */
+uint32_t plcrash_nasync_duplicate_filter_repeat_count (plcrash_duplicate_filter_t *filter) {
+    uint32_t count = 0;
+    if (filter->table == NULL)
+        return 0;
+
+    for (size_t i = 0; i < PLCRASH_DUPLICATE_FILTER_SLOTS; i++)
+        count += filter->table->entries[i].repeat_count;
+
+    return count;
+}
+
+/**
+ * Reset the repeat counts of all entries in @a filter. The signatures themselves are retained, and
+ * repeats of recently reported crashes will continue to be suppressed.
+ */
+void plcrash_nasync_duplicate_filter_reset_repeat_counts (plcrash_duplicate_filter_t *filter) {
+    if (filter->table == NULL)
+        return;
+
+    for (size_t i = 0; i < PLCRASH_DUPLICATE_FILTER_SLOTS; i++)
+        filter->table->entries[i].repeat_count = 0;
+}
+
+/**
+ * Fold @a value into the FNV-1a hash @a hash, in little-endian byte order.
+ */
+static inline uint64_t fnv1a_u64 (uint64_t hash, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (uint8_t) (value >> (i * 8));
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Compute the crash-time signature of the thread described by @a thread_state, derived from its innermost
+ * PLCRASH_DUPLICATE_FILTER_FRAMES frames. Each frame is normalized to its containing image's path and its offset
+ * from the image's header, and is thus stable across launches of the same binaries.
+ *
+ * @param task The task containing the thread.
+ * @param thread_state The crashed thread's state.
+ * @param image_list The image list used to unwind the thread and normalize its frame addresses.
+ *
+ * @return Returns the computed signature. The value 0 is never returned.
+ *
+ * @warning This method is async-safe.
+ */
+uint64_t plcrash_async_duplicate_filter_signature (task_t task, plcrash_async_thread_state_t *thread_state, plcrash_async_image_list_t *image_list) {
+    plcrash_async_thread_state_t cursor_thr_state;
+    plframe_cursor_t cursor;
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    /* The cursor may modify the thread state */
+    plcrash_async_thread_state_copy(&cursor_thr_state, thread_state);
+    if (plframe_cursor_init(&cursor, task, &cursor_thr_state, image_list) != PLFRAME_ESUCCESS)
+        return hash;
+
+    plcrash_greg_t pcs[PLCRASH_DUPLICATE_FILTER_FRAMES];
+    size_t count;
+    plframe_cursor_walk(&cursor, pcs, NULL, NULL, PLCRASH_DUPLICATE_FILTER_FRAMES, &count, 0);
+
+    plcrash_async_image_list_set_reading(image_list, true);
+    for (size_t i = 0; i < count; i++) {
+        plcrash_greg_t pc = pcs[i];
+        plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, pc);
+        if (image != NULL && image->macho_image.name != NULL) {
+            for (const char *p = image->macho_image.name; *p != '\0'; p++) {
+                hash ^= (uint8_t) *p;
+                hash *= FNV_PRIME;
+            }
+            hash = fnv1a_u64(hash, pc - image->macho_image.header_addr);
+        } else {
+            hash = fnv1a_u64(hash, pc);
+        }
+    }
+    plcrash_async_image_list_set_reading(image_list, false);
+
+    plframe_cursor_free(&cursor);
+
+    /* Reserve 0 for unused table entries */
+    return hash != 0 ? hash : 1;
+}
+
+/**
+ * Check whether the crash with @a signature should be suppressed, and update the filter's table accordingly.
+ *
+ * If the crash was fully reported less than the filter's window before @a now, its repeat count is incremented
+ * and true is returned. Otherwise, the crash's report time is recorded (replacing the least recently reported table
+ * entry if necessary) and false is returned.
+ *
+ * @param filter The filter to check; if the filter was not successfully initialized, false is always returned.
+ * @param signature The crash signature, as returned by plcrash_async_duplicate_filter_signature().
+ * @param now The current time, as seconds since the UNIX epoch.
+ *
+ * @return Returns true if a full report should not be written for this crash.
+ *
+ * @warning This method is async-safe.
+ */
+bool plcrash_async_duplicate_filter_check (plcrash_duplicate_filter_t *filter, uint64_t signature, int64_t now) {
+    plcrash_duplicate_filter_table_t *table = filter->table;
+    if (table == NULL || signature == 0)
+        return false;
+
+    /* Look for an existing entry, tracking the least recently reported entry as a replacement candidate */
+    plcrash_duplicate_filter_entry_t *oldest = &table->entries[0];
+    for (size_t i = 0; i < PLCRASH_DUPLICATE_FILTER_SLOTS; i++) {
+        plcrash_duplicate_filter_entry_t *entry = &table->entries[i];
+
+        if (entry->signature == signature) {
+            /* A repeat within the window (allowing for clock adjustments that move time backwards) */
+            if (now >= entry->reported && now - entry->reported < filter->window) {
+                entry->repeat_count++;
+                return true;
+            }
+
+            entry->reported = now;
+            return false;
+        }
+
+        if (entry->signature == 0 || (oldest->signature != 0 && entry->reported < oldest->reported))
+            oldest = entry;
+    }
+
+    oldest->signature = signature;
+    oldest->reported = now;
+    oldest->repeat_count = 0;
+    return false;
+}
+
+/**
+ * @}
+ */
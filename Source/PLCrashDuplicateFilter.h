@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_DUPLICATE_FILTER_H
+#define PLCRASH_DUPLICATE_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <mach/mach.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncThread.h"
+#include "PLCrashAsyncImageList.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_duplicate_filter Duplicate Crash Filter
+ * @ingroup plcrash_internal
+ *
+ * Implements crash-time suppression of repeated crashes. The signatures of recently reported crashes are
+ * persisted in a small fixed-size table that is memory-mapped from disk when the crash reporter is enabled. At
+ * crash time, the crashed thread's signature is computed from its innermost frames and checked against the
+ * table; if the same crash was fully reported within the configured window, only the table entry's repeat count
+ * is updated. As the table is a shared file mapping, the update persists even though the process then terminates.
+ *
+ * @{
+ */
+
+/** The duplicate filter table file magic. */
+#define PLCRASH_DUPLICATE_FILTER_MAGIC "plcrdup"
+
+/** The duplicate filter table format version. */
+#define PLCRASH_DUPLICATE_FILTER_VERSION 1
+
+/** The number of crash signatures retained by the duplicate filter table. */
+#define PLCRASH_DUPLICATE_FILTER_SLOTS 16
+
+/** The number of innermost crashed thread frames included in a crash-time signature. */
+#define PLCRASH_DUPLICATE_FILTER_FRAMES 5
+
+/**
+ * @internal
+ *
+ * A single duplicate filter table entry.
+ */
+typedef struct plcrash_duplicate_filter_entry {
+    /** The crash signature, or 0 if the entry is unused. */
+    uint64_t signature;
+
+    /** The time at which this crash was last fully reported, as seconds since the UNIX epoch. */
+    int64_t reported;
+
+    /** The number of repeats of this crash that were suppressed since the table was last reset. */
+    uint32_t repeat_count;
+
+    /** Reserved; must be zero. */
+    uint32_t reserved;
+} plcrash_duplicate_filter_entry_t;
+
+/**
+ * @internal
+ *
+ * The persisted duplicate filter table. All values are in host byte order.
+ */
+typedef struct plcrash_duplicate_filter_table {
+    /** The PLCRASH_DUPLICATE_FILTER_MAGIC value, not NUL terminated. */
+    char magic[7];
+
+    /** The PLCRASH_DUPLICATE_FILTER_VERSION value. */
+    uint8_t version;
+
+    /** Table entries. */
+    plcrash_duplicate_filter_entry_t entries[PLCRASH_DUPLICATE_FILTER_SLOTS];
+} plcrash_duplicate_filter_table_t;
+
+/**
+ * @internal
+ *
+ * Duplicate crash filter state.
+ */
+typedef struct plcrash_duplicate_filter {
+    /** The mapped table, or NULL if the filter is not initialized. */
+    plcrash_duplicate_filter_table_t *table;
+
+    /** The suppression window, in seconds. */
+    int64_t window;
+} plcrash_duplicate_filter_t;
+
+plcrash_error_t plcrash_nasync_duplicate_filter_init (plcrash_duplicate_filter_t *filter, const char *path, int64_t window);
+void plcrash_nasync_duplicate_filter_free (plcrash_duplicate_filter_t *filter);
+
+uint32_t plcrash_nasync_duplicate_filter_repeat_count (plcrash_duplicate_filter_t *filter);
+void plcrash_nasync_duplicate_filter_reset_repeat_counts (plcrash_duplicate_filter_t *filter);
+
+uint64_t plcrash_async_duplicate_filter_signature (task_t task, plcrash_async_thread_state_t *thread_state, plcrash_async_image_list_t *image_list);
+bool plcrash_async_duplicate_filter_check (plcrash_duplicate_filter_t *filter, uint64_t signature, int64_t now);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_DUPLICATE_FILTER_H */
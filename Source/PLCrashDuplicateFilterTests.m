@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashDuplicateFilter.h"
+
+@interface PLCrashDuplicateFilterTests : SenTestCase {
+@private
+    /** Table path. */
+    NSString *_path;
+}
+@end
+
+@implementation PLCrashDuplicateFilterTests
+
+- (void) setUp {
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _path error: NULL];
+    [_path release];
+}
+
+/**
+ * Verify that repeats are only suppressed within the configured window.
+ */
+- (void) testWindow {
+    plcrash_duplicate_filter_t filter;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_duplicate_filter_init(&filter, [_path fileSystemRepresentation], 60), @"Failed to initialize filter");
+
+    STAssertFalse(plcrash_async_duplicate_filter_check(&filter, 0xABCD, 1000), @"First occurrence must be reported");
+    STAssertTrue(plcrash_async_duplicate_filter_check(&filter, 0xABCD, 1030), @"Repeat within the window must be suppressed");
+    STAssertFalse(plcrash_async_duplicate_filter_check(&filter, 0x1234, 1030), @"Distinct crash must be reported");
+    STAssertFalse(plcrash_async_duplicate_filter_check(&filter, 0xABCD, 1060), @"Repeat outside of the window must be reported");
+    STAssertTrue(plcrash_async_duplicate_filter_check(&filter, 0xABCD, 1090), @"The window must restart at the last report");
+
+    STAssertEquals((uint32_t) 2, plcrash_nasync_duplicate_filter_repeat_count(&filter), @"Incorrect repeat count");
+    plcrash_nasync_duplicate_filter_free(&filter);
+}
+
+/**
+ * Verify that the table is persisted, and that older entries are replaced once the table is full.
+ */
+- (void) testPersistence {
+    plcrash_duplicate_filter_t filter;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_duplicate_filter_init(&filter, [_path fileSystemRepresentation], 60), @"Failed to initialize filter");
+    STAssertFalse(plcrash_async_duplicate_filter_check(&filter, 1, 1000), @"First occurrence must be reported");
+    STAssertTrue(plcrash_async_duplicate_filter_check(&filter, 1, 1001), @"Repeat must be suppressed");
+    plcrash_nasync_duplicate_filter_free(&filter);
+
+    /* Reload the table */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_duplicate_filter_init(&filter, [_path fileSystemRepresentation], 60), @"Failed to initialize filter");
+    STAssertEquals((uint32_t) 1, plcrash_nasync_duplicate_filter_repeat_count(&filter), @"Repeat count was not persisted");
+    STAssertTrue(plcrash_async_duplicate_filter_check(&filter, 1, 1002), @"Persisted signature must be suppressed");
+
+    plcrash_nasync_duplicate_filter_reset_repeat_counts(&filter);
+    STAssertEquals((uint32_t) 0, plcrash_nasync_duplicate_filter_repeat_count(&filter), @"Repeat count was not reset");
+
+    /* Fill the table with newer entries; the oldest entry must be evicted */
+    for (uint64_t sig = 2; sig <= PLCRASH_DUPLICATE_FILTER_SLOTS + 1; sig++)
+        STAssertFalse(plcrash_async_duplicate_filter_check(&filter, sig, 1010), @"New signature must be reported");
+    STAssertFalse(plcrash_async_duplicate_filter_check(&filter, 1, 1011), @"Evicted signature must be reported");
+
+    plcrash_nasync_duplicate_filter_free(&filter);
+}
+
+@end
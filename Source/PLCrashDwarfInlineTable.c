@@ -0,0 +1,1135 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashDwarfInlineTable.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_dwarf_inline_table
+ * @{
+ */
+
+/* Tags */
+#define DW_TAG_inlined_subroutine   0x1d
+#define DW_TAG_compile_unit         0x11
+#define DW_TAG_partial_unit         0x3c
+
+/* Attributes */
+#define DW_AT_name                  0x03
+#define DW_AT_stmt_list             0x10
+#define DW_AT_low_pc                0x11
+#define DW_AT_high_pc               0x12
+#define DW_AT_abstract_origin       0x31
+#define DW_AT_specification         0x47
+#define DW_AT_ranges                0x55
+#define DW_AT_call_file             0x58
+#define DW_AT_call_line             0x59
+#define DW_AT_linkage_name          0x6e
+#define DW_AT_str_offsets_base      0x72
+#define DW_AT_addr_base             0x73
+#define DW_AT_rnglists_base         0x74
+#define DW_AT_MIPS_linkage_name     0x2007
+
+/* Forms */
+#define DW_FORM_addr                0x01
+#define DW_FORM_block2              0x03
+#define DW_FORM_block4              0x04
+#define DW_FORM_data2               0x05
+#define DW_FORM_data4               0x06
+#define DW_FORM_data8               0x07
+#define DW_FORM_string              0x08
+#define DW_FORM_block               0x09
+#define DW_FORM_block1              0x0a
+#define DW_FORM_data1               0x0b
+#define DW_FORM_flag                0x0c
+#define DW_FORM_sdata               0x0d
+#define DW_FORM_strp                0x0e
+#define DW_FORM_udata               0x0f
+#define DW_FORM_ref_addr            0x10
+#define DW_FORM_ref1                0x11
+#define DW_FORM_ref2                0x12
+#define DW_FORM_ref4                0x13
+#define DW_FORM_ref8                0x14
+#define DW_FORM_ref_udata           0x15
+#define DW_FORM_indirect            0x16
+#define DW_FORM_sec_offset          0x17
+#define DW_FORM_exprloc             0x18
+#define DW_FORM_flag_present        0x19
+#define DW_FORM_strx                0x1a
+#define DW_FORM_addrx               0x1b
+#define DW_FORM_ref_sup4            0x1c
+#define DW_FORM_strp_sup            0x1d
+#define DW_FORM_data16              0x1e
+#define DW_FORM_line_strp           0x1f
+#define DW_FORM_ref_sig8            0x20
+#define DW_FORM_implicit_const      0x21
+#define DW_FORM_loclistx            0x22
+#define DW_FORM_rnglistx            0x23
+#define DW_FORM_ref_sup8            0x24
+#define DW_FORM_strx1               0x25
+#define DW_FORM_strx2               0x26
+#define DW_FORM_strx3               0x27
+#define DW_FORM_strx4               0x28
+#define DW_FORM_addrx1              0x29
+#define DW_FORM_addrx2              0x2a
+#define DW_FORM_addrx3              0x2b
+#define DW_FORM_addrx4              0x2c
+#define DW_FORM_GNU_addr_index      0x1f01
+#define DW_FORM_GNU_str_index       0x1f02
+#define DW_FORM_GNU_ref_alt         0x1f20
+#define DW_FORM_GNU_strp_alt        0x1f21
+
+/* Unit types */
+#define DW_UT_compile               0x01
+#define DW_UT_partial               0x03
+
+/* Range list entries */
+#define DW_RLE_end_of_list          0x00
+#define DW_RLE_base_addressx        0x01
+#define DW_RLE_startx_endx          0x02
+#define DW_RLE_startx_length        0x03
+#define DW_RLE_offset_pair          0x04
+#define DW_RLE_base_address         0x05
+#define DW_RLE_start_end            0x06
+#define DW_RLE_start_length         0x07
+
+/** The maximum DIE nesting depth accepted within a unit. */
+#define MAX_DIE_DEPTH 256
+
+/** The maximum number of DW_AT_abstract_origin and DW_AT_specification references followed to resolve a name. */
+#define MAX_REFERENCE_DEPTH 8
+
+/**
+ * A bounds-checked cursor over section data. Once a read fails, @a valid is cleared, and all subsequent reads
+ * return zero.
+ */
+typedef struct info_cursor {
+    const uint8_t *p;
+    const uint8_t *end;
+    bool valid;
+} info_cursor_t;
+
+/**
+ * A single abbreviation attribute specification.
+ */
+typedef struct abbrev_spec {
+    uint64_t attr;
+    uint64_t form;
+    int64_t implicit_const;
+} abbrev_spec_t;
+
+/**
+ * A single abbreviation declaration. The declaration's attribute specifications are stored in the table's
+ * @a specs array.
+ */
+typedef struct abbrev {
+    uint64_t code;
+    uint64_t tag;
+    bool has_children;
+    size_t spec_index;
+    size_t spec_count;
+} abbrev_t;
+
+/**
+ * A decoded abbreviation table.
+ */
+typedef struct abbrev_table {
+    abbrev_t *abbrevs;
+    size_t count;
+    size_t capacity;
+
+    abbrev_spec_t *specs;
+    size_t spec_count;
+    size_t spec_capacity;
+} abbrev_table_t;
+
+/**
+ * A decoded unit header, along with the attributes of its unit DIE required to decode the unit's entries.
+ */
+typedef struct info_unit {
+    /** The offsets of the unit header, the unit's first DIE, and the end of the unit within __debug_info. */
+    uint64_t offset;
+    uint64_t die_offset;
+    uint64_t end;
+
+    uint16_t version;
+    bool dwarf64;
+    uint8_t address_size;
+
+    /** The unit's abbreviations. */
+    abbrev_table_t abbrevs;
+
+    /** The unit's base address, used by DWARF 2-4 range lists and DW_RLE_offset_pair entries. */
+    uint64_t base_address;
+
+    /** The DWARF 5 string offset, address and range list table bases. */
+    uint64_t str_offsets_base;
+    uint64_t addr_base;
+    uint64_t rnglists_base;
+
+    /** The unit's line table offset, if @a has_stmt_list is true. */
+    uint64_t stmt_list;
+    bool has_stmt_list;
+
+    /** The unit's line table file table, if @a files_loaded is true. */
+    plcrash_dwarf_line_file_table_t files;
+    bool files_loaded;
+} info_unit_t;
+
+/**
+ * A decoded attribute value. Reference values are converted to __debug_info offsets.
+ */
+typedef struct attr_value {
+    bool present;
+    uint64_t form;
+    uint64_t value;
+    const char *string;
+} attr_value_t;
+
+/**
+ * The attributes of a single DIE that are used to decode inlined subroutines.
+ */
+typedef struct info_die {
+    const abbrev_t *abbrev;
+
+    attr_value_t name;
+    attr_value_t linkage_name;
+    attr_value_t low_pc;
+    attr_value_t high_pc;
+    attr_value_t ranges;
+    attr_value_t abstract_origin;
+    attr_value_t specification;
+    attr_value_t call_file;
+    attr_value_t call_line;
+    attr_value_t stmt_list;
+    attr_value_t str_offsets_base;
+    attr_value_t addr_base;
+    attr_value_t rnglists_base;
+} info_die_t;
+
+/**
+ * Parser state.
+ */
+typedef struct info_parser {
+    const plcrash_dwarf_inline_sections_t *sections;
+
+    /** The offsets of all units within __debug_info, in ascending order, used to resolve cross-unit references. */
+    uint64_t *unit_offsets;
+    size_t unit_count;
+
+    /** The most recently loaded unit referenced from another unit, if @a has_foreign is true. */
+    info_unit_t foreign;
+    bool has_foreign;
+
+    plcrash_dwarf_inline_range_cb callback;
+    void *ctx;
+} info_parser_t;
+
+static bool cursor_need (info_cursor_t *c, uint64_t len) {
+    if (!c->valid || (uint64_t) (c->end - c->p) < len) {
+        c->valid = false;
+        return false;
+    }
+    return true;
+}
+
+static uint64_t read_fixed (info_cursor_t *c, size_t size) {
+    uint64_t value = 0;
+    if (!cursor_need(c, size))
+        return 0;
+
+    /* Values are read in host byte order; only little-endian hosts are supported */
+    memcpy(&value, c->p, size);
+    c->p += size;
+    return value;
+}
+
+static uint64_t read_uleb128 (info_cursor_t *c) {
+    uint64_t value = 0;
+    unsigned int shift = 0;
+
+    while (cursor_need(c, 1)) {
+        uint8_t byte = *c->p++;
+        if (shift < 64)
+            value |= ((uint64_t) (byte & 0x7f)) << shift;
+        shift += 7;
+
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+
+    return 0;
+}
+
+static int64_t read_sleb128 (info_cursor_t *c) {
+    uint64_t value = 0;
+    unsigned int shift = 0;
+
+    while (cursor_need(c, 1)) {
+        uint8_t byte = *c->p++;
+        if (shift < 64)
+            value |= ((uint64_t) (byte & 0x7f)) << shift;
+        shift += 7;
+
+        if ((byte & 0x80) == 0) {
+            if (shift < 64 && (byte & 0x40))
+                value |= ~(uint64_t) 0 << shift;
+            return (int64_t) value;
+        }
+    }
+
+    return 0;
+}
+
+static void skip (info_cursor_t *c, uint64_t len) {
+    if (cursor_need(c, len))
+        c->p += len;
+}
+
+/**
+ * Initialize @a c over @a size bytes of @a section, starting at @a offset.
+ */
+static void cursor_init (info_cursor_t *c, const uint8_t *section, uint64_t size, uint64_t offset) {
+    c->valid = section != NULL && offset <= size;
+    c->p = c->valid ? section + offset : NULL;
+    c->end = c->valid ? section + size : NULL;
+}
+
+/**
+ * Return the NUL-terminated string at @a offset within @a section, or NULL if invalid.
+ */
+static const char *section_string (const uint8_t *section, uint64_t size, uint64_t offset) {
+    if (section == NULL || offset >= size || memchr(section + offset, '\0', (size_t) (size - offset)) == NULL)
+        return NULL;
+
+    return (const char *) (section + offset);
+}
+
+/**
+ * Decode the abbreviation table at @a offset within __debug_abbrev.
+ */
+static bool read_abbrevs (const plcrash_dwarf_inline_sections_t *sections, uint64_t offset, abbrev_table_t *table) {
+    info_cursor_t c;
+
+    memset(table, 0, sizeof(*table));
+    cursor_init(&c, sections->debug_abbrev, sections->debug_abbrev_size, offset);
+
+    uint64_t code;
+    while ((code = read_uleb128(&c)) != 0 && c.valid) {
+        if (table->count == table->capacity) {
+            size_t capacity = table->capacity == 0 ? 64 : table->capacity * 2;
+            abbrev_t *abbrevs = realloc(table->abbrevs, capacity * sizeof(*abbrevs));
+            if (abbrevs == NULL)
+                return false;
+
+            table->abbrevs = abbrevs;
+            table->capacity = capacity;
+        }
+
+        abbrev_t *abbrev = &table->abbrevs[table->count++];
+        abbrev->code = code;
+        abbrev->tag = read_uleb128(&c);
+        abbrev->has_children = read_fixed(&c, 1) != 0;
+        abbrev->spec_index = table->spec_count;
+        abbrev->spec_count = 0;
+
+        while (c.valid) {
+            abbrev_spec_t spec;
+            spec.attr = read_uleb128(&c);
+            spec.form = read_uleb128(&c);
+            spec.implicit_const = spec.form == DW_FORM_implicit_const ? read_sleb128(&c) : 0;
+            if (spec.attr == 0 && spec.form == 0)
+                break;
+
+            if (table->spec_count == table->spec_capacity) {
+                size_t capacity = table->spec_capacity == 0 ? 256 : table->spec_capacity * 2;
+                abbrev_spec_t *specs = realloc(table->specs, capacity * sizeof(*specs));
+                if (specs == NULL)
+                    return false;
+
+                table->specs = specs;
+                table->spec_capacity = capacity;
+            }
+
+            table->specs[table->spec_count++] = spec;
+            abbrev->spec_count++;
+        }
+    }
+
+    return c.valid;
+}
+
+/**
+ * Return the abbreviation declaration for @a code, or NULL if undefined.
+ */
+static const abbrev_t *find_abbrev (const abbrev_table_t *table, uint64_t code) {
+    /* Codes are generally assigned sequentially from 1 */
+    if (code - 1 < table->count && table->abbrevs[code - 1].code == code)
+        return &table->abbrevs[code - 1];
+
+    for (size_t i = 0; i < table->count; i++) {
+        if (table->abbrevs[i].code == code)
+            return &table->abbrevs[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * Read an attribute value of the given @a form. Returns false if the form is unknown, in which case the remainder
+ * of the unit can not be decoded.
+ */
+static bool read_form (info_cursor_t *c, const info_unit_t *unit, uint64_t form, int64_t implicit_const, attr_value_t *value) {
+    size_t offset_size = unit->dwarf64 ? 8 : 4;
+
+    value->present = true;
+    value->form = form;
+    value->value = 0;
+    value->string = NULL;
+
+    switch (form) {
+        case DW_FORM_addr:
+            value->value = read_fixed(c, unit->address_size);
+            break;
+
+        case DW_FORM_data1:
+        case DW_FORM_ref1:
+        case DW_FORM_flag:
+        case DW_FORM_strx1:
+        case DW_FORM_addrx1:
+            value->value = read_fixed(c, 1);
+            break;
+
+        case DW_FORM_data2:
+        case DW_FORM_ref2:
+        case DW_FORM_strx2:
+        case DW_FORM_addrx2:
+            value->value = read_fixed(c, 2);
+            break;
+
+        case DW_FORM_strx3:
+        case DW_FORM_addrx3:
+            value->value = read_fixed(c, 3);
+            break;
+
+        case DW_FORM_data4:
+        case DW_FORM_ref4:
+        case DW_FORM_ref_sup4:
+        case DW_FORM_strx4:
+        case DW_FORM_addrx4:
+            value->value = read_fixed(c, 4);
+            break;
+
+        case DW_FORM_data8:
+        case DW_FORM_ref8:
+        case DW_FORM_ref_sig8:
+        case DW_FORM_ref_sup8:
+            value->value = read_fixed(c, 8);
+            break;
+
+        case DW_FORM_data16:
+            skip(c, 16);
+            break;
+
+        case DW_FORM_udata:
+        case DW_FORM_ref_udata:
+        case DW_FORM_strx:
+        case DW_FORM_addrx:
+        case DW_FORM_loclistx:
+        case DW_FORM_rnglistx:
+        case DW_FORM_GNU_addr_index:
+        case DW_FORM_GNU_str_index:
+            value->value = read_uleb128(c);
+            break;
+
+        case DW_FORM_sdata:
+            value->value = (uint64_t) read_sleb128(c);
+            break;
+
+        case DW_FORM_implicit_const:
+            value->value = (uint64_t) implicit_const;
+            break;
+
+        case DW_FORM_flag_present:
+            value->value = 1;
+            break;
+
+        case DW_FORM_strp:
+        case DW_FORM_line_strp:
+        case DW_FORM_sec_offset:
+        case DW_FORM_strp_sup:
+        case DW_FORM_GNU_ref_alt:
+        case DW_FORM_GNU_strp_alt:
+            value->value = read_fixed(c, offset_size);
+            break;
+
+        case DW_FORM_ref_addr:
+            /* DWARF 2 defines DW_FORM_ref_addr as address sized */
+            value->value = read_fixed(c, unit->version <= 2 ? unit->address_size : offset_size);
+            break;
+
+        case DW_FORM_string: {
+            const uint8_t *nul = c->valid ? memchr(c->p, '\0', (size_t) (c->end - c->p)) : NULL;
+            if (nul == NULL) {
+                c->valid = false;
+                break;
+            }
+
+            value->string = (const char *) c->p;
+            c->p = nul + 1;
+            break;
+        }
+
+        case DW_FORM_block1:
+            skip(c, read_fixed(c, 1));
+            break;
+
+        case DW_FORM_block2:
+            skip(c, read_fixed(c, 2));
+            break;
+
+        case DW_FORM_block4:
+            skip(c, read_fixed(c, 4));
+            break;
+
+        case DW_FORM_block:
+        case DW_FORM_exprloc:
+            skip(c, read_uleb128(c));
+            break;
+
+        case DW_FORM_indirect: {
+            uint64_t indirect_form = read_uleb128(c);
+            if (indirect_form == DW_FORM_indirect || indirect_form == DW_FORM_implicit_const)
+                return false;
+            return read_form(c, unit, indirect_form, 0, value);
+        }
+
+        default:
+            PLCF_DEBUG("Unsupported DWARF form 0x%" PRIx64, form);
+            return false;
+    }
+
+    /* Convert unit-relative references to section offsets */
+    switch (form) {
+        case DW_FORM_ref1:
+        case DW_FORM_ref2:
+        case DW_FORM_ref4:
+        case DW_FORM_ref8:
+        case DW_FORM_ref_udata:
+            value->value += unit->offset;
+            break;
+        default:
+            break;
+    }
+
+    return c->valid;
+}
+
+/**
+ * Return the location of the attribute value for @a attr within @a die, or NULL if the attribute is not used.
+ */
+static attr_value_t *die_attr (info_die_t *die, uint64_t attr) {
+    switch (attr) {
+        case DW_AT_name:                return &die->name;
+        case DW_AT_linkage_name:
+        case DW_AT_MIPS_linkage_name:   return &die->linkage_name;
+        case DW_AT_low_pc:              return &die->low_pc;
+        case DW_AT_high_pc:             return &die->high_pc;
+        case DW_AT_ranges:              return &die->ranges;
+        case DW_AT_abstract_origin:     return &die->abstract_origin;
+        case DW_AT_specification:       return &die->specification;
+        case DW_AT_call_file:           return &die->call_file;
+        case DW_AT_call_line:           return &die->call_line;
+        case DW_AT_stmt_list:           return &die->stmt_list;
+        case DW_AT_str_offsets_base:    return &die->str_offsets_base;
+        case DW_AT_addr_base:           return &die->addr_base;
+        case DW_AT_rnglists_base:       return &die->rnglists_base;
+        default:                        return NULL;
+    }
+}
+
+/**
+ * Read the DIE at @a c. On return, @a die->abbrev is NULL if the entry is a null entry, terminating a list of
+ * siblings. Returns false if the entry could not be decoded.
+ */
+static bool read_die (info_cursor_t *c, const info_unit_t *unit, info_die_t *die) {
+    memset(die, 0, sizeof(*die));
+
+    uint64_t code = read_uleb128(c);
+    if (!c->valid)
+        return false;
+
+    if (code == 0)
+        return true;
+
+    if ((die->abbrev = find_abbrev(&unit->abbrevs, code)) == NULL) {
+        PLCF_DEBUG("Undefined DWARF abbreviation code %" PRIu64, code);
+        return false;
+    }
+
+    for (size_t i = 0; i < die->abbrev->spec_count; i++) {
+        const abbrev_spec_t *spec = &unit->abbrevs.specs[die->abbrev->spec_index + i];
+        attr_value_t scratch;
+        attr_value_t *value = die_attr(die, spec->attr);
+
+        if (!read_form(c, unit, spec->form, spec->implicit_const, value != NULL ? value : &scratch))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Resolve a string attribute value, returning NULL if the value is not a supported string form.
+ */
+static const char *resolve_string (const info_parser_t *parser, const info_unit_t *unit, const attr_value_t *value) {
+    const plcrash_dwarf_inline_sections_t *sections = parser->sections;
+
+    if (!value->present)
+        return NULL;
+
+    switch (value->form) {
+        case DW_FORM_string:
+            return value->string;
+
+        case DW_FORM_strp:
+            return section_string(sections->line.debug_str, sections->line.debug_str_size, value->value);
+
+        case DW_FORM_line_strp:
+            return section_string(sections->line.debug_line_str, sections->line.debug_line_str_size, value->value);
+
+        case DW_FORM_strx:
+        case DW_FORM_strx1:
+        case DW_FORM_strx2:
+        case DW_FORM_strx3:
+        case DW_FORM_strx4:
+        case DW_FORM_GNU_str_index: {
+            size_t offset_size = unit->dwarf64 ? 8 : 4;
+            info_cursor_t c;
+
+            if (value->value > (UINT64_MAX - unit->str_offsets_base) / offset_size)
+                return NULL;
+
+            cursor_init(&c, sections->debug_str_offsets, sections->debug_str_offsets_size, unit->str_offsets_base + (value->value * offset_size));
+            uint64_t offset = read_fixed(&c, offset_size);
+            if (!c.valid)
+                return NULL;
+
+            return section_string(sections->line.debug_str, sections->line.debug_str_size, offset);
+        }
+
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * Read the address at @a index within the unit's __debug_addr table.
+ */
+static bool read_indexed_address (const info_parser_t *parser, const info_unit_t *unit, uint64_t index, uint64_t *address) {
+    info_cursor_t c;
+
+    if (index > (UINT64_MAX - unit->addr_base) / unit->address_size)
+        return false;
+
+    cursor_init(&c, parser->sections->debug_addr, parser->sections->debug_addr_size, unit->addr_base + (index * unit->address_size));
+    *address = read_fixed(&c, unit->address_size);
+    return c.valid;
+}
+
+/**
+ * Resolve an address attribute value. Returns false if the value is not a supported address form.
+ */
+static bool resolve_address (const info_parser_t *parser, const info_unit_t *unit, const attr_value_t *value, uint64_t *address) {
+    if (!value->present)
+        return false;
+
+    switch (value->form) {
+        case DW_FORM_addr:
+            *address = value->value;
+            return true;
+
+        case DW_FORM_addrx:
+        case DW_FORM_addrx1:
+        case DW_FORM_addrx2:
+        case DW_FORM_addrx3:
+        case DW_FORM_addrx4:
+        case DW_FORM_GNU_addr_index:
+            return read_indexed_address(parser, unit, value->value, address);
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * Free all resources associated with @a unit.
+ */
+static void free_unit (info_unit_t *unit) {
+    free(unit->abbrevs.abbrevs);
+    free(unit->abbrevs.specs);
+    if (unit->files_loaded)
+        plcrash_nasync_dwarf_line_file_table_free(&unit->files);
+}
+
+/**
+ * Read the header, abbreviations and unit DIE of the unit at @a offset. Returns false if the unit is malformed or
+ * unsupported, in which case @a unit need not be freed.
+ */
+static bool load_unit (const info_parser_t *parser, uint64_t offset, info_unit_t *unit) {
+    const plcrash_dwarf_inline_sections_t *sections = parser->sections;
+    info_cursor_t c;
+
+    memset(unit, 0, sizeof(*unit));
+    unit->offset = offset;
+    cursor_init(&c, sections->debug_info, sections->debug_info_size, offset);
+
+    uint64_t unit_length = read_fixed(&c, 4);
+    if (unit_length == 0xffffffff) {
+        unit->dwarf64 = true;
+        unit_length = read_fixed(&c, 8);
+    }
+
+    if (!cursor_need(&c, unit_length))
+        return false;
+
+    unit->end = (uint64_t) (c.p - sections->debug_info) + unit_length;
+    c.end = c.p + unit_length;
+
+    uint64_t abbrev_offset;
+    unit->version = (uint16_t) read_fixed(&c, 2);
+    if (unit->version >= 2 && unit->version <= 4) {
+        abbrev_offset = read_fixed(&c, unit->dwarf64 ? 8 : 4);
+        unit->address_size = (uint8_t) read_fixed(&c, 1);
+    } else if (unit->version == 5) {
+        uint8_t unit_type = (uint8_t) read_fixed(&c, 1);
+        unit->address_size = (uint8_t) read_fixed(&c, 1);
+        abbrev_offset = read_fixed(&c, unit->dwarf64 ? 8 : 4);
+        if (unit_type != DW_UT_compile && unit_type != DW_UT_partial)
+            return false;
+    } else {
+        PLCF_DEBUG("Skipping DWARF unit with unsupported version %u", unit->version);
+        return false;
+    }
+
+    if (!c.valid || (unit->address_size != 4 && unit->address_size != 8))
+        return false;
+
+    unit->die_offset = (uint64_t) (c.p - sections->debug_info);
+
+    if (!read_abbrevs(sections, abbrev_offset, &unit->abbrevs)) {
+        free_unit(unit);
+        return false;
+    }
+
+    /* Read the unit DIE */
+    info_die_t die;
+    if (!read_die(&c, unit, &die) || die.abbrev == NULL ||
+        (die.abbrev->tag != DW_TAG_compile_unit && die.abbrev->tag != DW_TAG_partial_unit))
+    {
+        free_unit(unit);
+        return false;
+    }
+
+    /* The bases default to the position of the first table following the section's first table header */
+    unit->str_offsets_base = die.str_offsets_base.present ? die.str_offsets_base.value : (unit->dwarf64 ? 16 : 8);
+    unit->addr_base = die.addr_base.present ? die.addr_base.value : (unit->dwarf64 ? 16 : 8);
+    unit->rnglists_base = die.rnglists_base.present ? die.rnglists_base.value : (unit->dwarf64 ? 20 : 12);
+
+    if (!resolve_address(parser, unit, &die.low_pc, &unit->base_address))
+        unit->base_address = 0;
+
+    if (die.stmt_list.present) {
+        unit->stmt_list = die.stmt_list.value;
+        unit->has_stmt_list = true;
+    }
+
+    return true;
+}
+
+/**
+ * Return the unit containing the DIE at @a offset, loading it if required, or NULL if the unit can not be found.
+ */
+static const info_unit_t *unit_for_offset (info_parser_t *parser, const info_unit_t *current, uint64_t offset) {
+    if (offset >= current->die_offset && offset < current->end)
+        return current;
+
+    if (parser->has_foreign && offset >= parser->foreign.die_offset && offset < parser->foreign.end)
+        return &parser->foreign;
+
+    /* Find the last unit starting at or before the offset */
+    size_t low = 0;
+    size_t high = parser->unit_count;
+    while (low < high) {
+        size_t mid = low + ((high - low) / 2);
+        if (parser->unit_offsets[mid] <= offset)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    if (low == 0)
+        return NULL;
+
+    if (parser->has_foreign) {
+        free_unit(&parser->foreign);
+        parser->has_foreign = false;
+    }
+
+    if (!load_unit(parser, parser->unit_offsets[low - 1], &parser->foreign))
+        return NULL;
+
+    parser->has_foreign = true;
+    if (offset < parser->foreign.die_offset || offset >= parser->foreign.end)
+        return NULL;
+
+    return &parser->foreign;
+}
+
+/**
+ * Resolve the name of @a die, preferring the linkage name, and following DW_AT_specification and
+ * DW_AT_abstract_origin references as required.
+ */
+static const char *resolve_name (info_parser_t *parser, const info_unit_t *unit, const info_die_t *die, unsigned int depth) {
+    const char *name;
+
+    if ((name = resolve_string(parser, unit, &die->linkage_name)) != NULL)
+        return name;
+
+    /* Resolve the fallback name before following a reference; doing so may replace the loaded foreign unit */
+    const char *fallback = resolve_string(parser, unit, &die->name);
+
+    const attr_value_t *reference = die->specification.present ? &die->specification : &die->abstract_origin;
+    if (reference->present && depth < MAX_REFERENCE_DEPTH && reference->form != DW_FORM_ref_sig8 &&
+        reference->form != DW_FORM_ref_sup4 && reference->form != DW_FORM_ref_sup8 && reference->form != DW_FORM_GNU_ref_alt)
+    {
+        const info_unit_t *target_unit = unit_for_offset(parser, unit, reference->value);
+        if (target_unit != NULL) {
+            info_cursor_t c;
+            info_die_t target;
+
+            cursor_init(&c, parser->sections->debug_info, target_unit->end, reference->value);
+            if (read_die(&c, target_unit, &target) && target.abbrev != NULL && (name = resolve_name(parser, target_unit, &target, depth + 1)) != NULL)
+                return name;
+        }
+    }
+
+    return fallback;
+}
+
+/**
+ * Report a single range of an inlined subroutine. Returns false if the callback requested termination.
+ */
+static bool emit_range (info_parser_t *parser, const plcrash_dwarf_inline_range_t *proto, uint64_t low, uint64_t high) {
+    if (low >= high)
+        return true;
+
+    plcrash_dwarf_inline_range_t range = *proto;
+    range.low = low;
+    range.high = high;
+    return parser->callback(&range, parser->ctx);
+}
+
+/**
+ * Report each range of the DWARF 2-4 range list at @a offset within __debug_ranges.
+ */
+static bool emit_ranges (info_parser_t *parser, const info_unit_t *unit, const plcrash_dwarf_inline_range_t *proto, uint64_t offset) {
+    info_cursor_t c;
+    uint64_t base = unit->base_address;
+    uint64_t max_address = unit->address_size == 4 ? UINT32_MAX : UINT64_MAX;
+
+    cursor_init(&c, parser->sections->debug_ranges, parser->sections->debug_ranges_size, offset);
+    while (c.valid) {
+        uint64_t begin = read_fixed(&c, unit->address_size);
+        uint64_t end = read_fixed(&c, unit->address_size);
+        if (!c.valid || (begin == 0 && end == 0))
+            break;
+
+        if (begin == max_address) {
+            base = end;
+            continue;
+        }
+
+        if (!emit_range(parser, proto, base + begin, base + end))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Report each range of the DWARF 5 range list at @a offset within __debug_rnglists.
+ */
+static bool emit_rnglist (info_parser_t *parser, const info_unit_t *unit, const plcrash_dwarf_inline_range_t *proto, uint64_t offset) {
+    info_cursor_t c;
+    uint64_t base = unit->base_address;
+
+    cursor_init(&c, parser->sections->debug_rnglists, parser->sections->debug_rnglists_size, offset);
+    while (c.valid) {
+        uint64_t begin = 0;
+        uint64_t end = 0;
+        bool has_range = true;
+
+        uint8_t kind = (uint8_t) read_fixed(&c, 1);
+        switch (kind) {
+            case DW_RLE_end_of_list:
+                return true;
+
+            case DW_RLE_base_addressx:
+                has_range = false;
+                if (!read_indexed_address(parser, unit, read_uleb128(&c), &base))
+                    return true;
+                break;
+
+            case DW_RLE_startx_endx:
+                if (!read_indexed_address(parser, unit, read_uleb128(&c), &begin) || !read_indexed_address(parser, unit, read_uleb128(&c), &end))
+                    return true;
+                break;
+
+            case DW_RLE_startx_length:
+                if (!read_indexed_address(parser, unit, read_uleb128(&c), &begin))
+                    return true;
+                end = begin + read_uleb128(&c);
+                break;
+
+            case DW_RLE_offset_pair:
+                begin = base + read_uleb128(&c);
+                end = base + read_uleb128(&c);
+                break;
+
+            case DW_RLE_base_address:
+                has_range = false;
+                base = read_fixed(&c, unit->address_size);
+                break;
+
+            case DW_RLE_start_end:
+                begin = read_fixed(&c, unit->address_size);
+                end = read_fixed(&c, unit->address_size);
+                break;
+
+            case DW_RLE_start_length:
+                begin = read_fixed(&c, unit->address_size);
+                end = begin + read_uleb128(&c);
+                break;
+
+            default:
+                PLCF_DEBUG("Unknown DWARF range list entry 0x%x", kind);
+                return true;
+        }
+
+        if (has_range && c.valid && !emit_range(parser, proto, begin, end))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Report the ranges of the inlined subroutine @a die. Returns false if the callback requested termination.
+ */
+static bool emit_inlined_subroutine (info_parser_t *parser, info_unit_t *unit, const info_die_t *die, uint32_t depth) {
+    plcrash_dwarf_inline_range_t proto;
+    memset(&proto, 0, sizeof(proto));
+    proto.depth = depth;
+
+    /* Resolve the call site */
+    if (die->call_line.present && die->call_line.value <= UINT32_MAX)
+        proto.call_line = (uint32_t) die->call_line.value;
+
+    if (die->call_file.present && unit->has_stmt_list) {
+        if (!unit->files_loaded && plcrash_nasync_dwarf_line_file_table_init(&unit->files, &parser->sections->line, unit->stmt_list) == PLCRASH_ESUCCESS)
+            unit->files_loaded = true;
+
+        if (!unit->files_loaded || !plcrash_nasync_dwarf_line_file_table_lookup(&unit->files, die->call_file.value, &proto.call_directory, &proto.call_file)) {
+            proto.call_directory = NULL;
+            proto.call_file = NULL;
+        }
+    }
+
+    proto.name = resolve_name(parser, unit, die, 0);
+
+    /* Report the ranges */
+    uint64_t low;
+    if (resolve_address(parser, unit, &die->low_pc, &low) && die->high_pc.present) {
+        uint64_t high;
+        if (!resolve_address(parser, unit, &die->high_pc, &high))
+            high = low + die->high_pc.value;
+
+        return emit_range(parser, &proto, low, high);
+    }
+
+    if (die->ranges.present) {
+        if (unit->version < 5)
+            return emit_ranges(parser, unit, &proto, die->ranges.value);
+
+        uint64_t offset = die->ranges.value;
+        if (die->ranges.form == DW_FORM_rnglistx) {
+            /* Indexed via the unit's offset table; offsets are relative to the table base */
+            size_t offset_size = unit->dwarf64 ? 8 : 4;
+            info_cursor_t c;
+
+            if (offset > (UINT64_MAX - unit->rnglists_base) / offset_size)
+                return true;
+
+            cursor_init(&c, parser->sections->debug_rnglists, parser->sections->debug_rnglists_size, unit->rnglists_base + (offset * offset_size));
+            offset = unit->rnglists_base + read_fixed(&c, offset_size);
+            if (!c.valid)
+                return true;
+        }
+
+        return emit_rnglist(parser, unit, &proto, offset);
+    }
+
+    return true;
+}
+
+/**
+ * Walk the DIEs of @a unit, reporting all inlined subroutines. Returns false if the callback requested termination.
+ */
+static bool parse_unit (info_parser_t *parser, info_unit_t *unit) {
+    uint32_t inline_depths[MAX_DIE_DEPTH];
+    size_t level = 0;
+    info_cursor_t c;
+
+    cursor_init(&c, parser->sections->debug_info, unit->end, unit->die_offset);
+    inline_depths[0] = 0;
+
+    while (c.valid && c.p < c.end) {
+        info_die_t die;
+        if (!read_die(&c, unit, &die)) {
+            PLCF_DEBUG("Skipping the remainder of a malformed DWARF unit at 0x%" PRIx64, unit->offset);
+            break;
+        }
+
+        /* A null entry terminates the current list of siblings */
+        if (die.abbrev == NULL) {
+            if (level == 0)
+                break;
+            level--;
+            continue;
+        }
+
+        bool is_inlined = die.abbrev->tag == DW_TAG_inlined_subroutine;
+        if (is_inlined && !emit_inlined_subroutine(parser, unit, &die, inline_depths[level]))
+            return false;
+
+        if (die.abbrev->has_children) {
+            if (level + 1 == MAX_DIE_DEPTH) {
+                PLCF_DEBUG("Skipping the remainder of a DWARF unit exceeding the maximum nesting depth");
+                break;
+            }
+
+            inline_depths[level + 1] = inline_depths[level] + (is_inlined ? 1 : 0);
+            level++;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Decode the inlined subroutines of all units within @a sections, reporting each of their address ranges via
+ * @a callback.
+ *
+ * Ranges are reported in the order in which their entries appear; they are not sorted. An inlined subroutine with
+ * multiple ranges is reported once per range. Units that are malformed, or use an unsupported DWARF version or unit
+ * type, are skipped.
+ *
+ * @param sections The DWARF sections to be read.
+ * @param callback The callback to be called for each range.
+ * @param ctx The context value to be passed to @a callback.
+ *
+ * @return Returns PLCRASH_ESUCCESS if all units were parsed, or if the callback requested termination,
+ * PLCRASH_EINVAL if the section's unit headers could not be walked, or PLCRASH_ENOMEM if memory could not be
+ * allocated.
+ */
+plcrash_error_t plcrash_nasync_dwarf_inline_table_parse (const plcrash_dwarf_inline_sections_t *sections, plcrash_dwarf_inline_range_cb callback, void *ctx) {
+    info_parser_t parser;
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+    size_t capacity = 0;
+    info_cursor_t c;
+
+    memset(&parser, 0, sizeof(parser));
+    parser.sections = sections;
+    parser.callback = callback;
+    parser.ctx = ctx;
+
+    /* Record the unit offsets, used to resolve cross-unit references */
+    cursor_init(&c, sections->debug_info, sections->debug_info_size, 0);
+    while (c.valid && c.p < c.end) {
+        uint64_t offset = (uint64_t) (c.p - sections->debug_info);
+        uint64_t unit_length = read_fixed(&c, 4);
+        if (unit_length == 0xffffffff) {
+            unit_length = read_fixed(&c, 8);
+        } else if (unit_length >= 0xfffffff0) {
+            c.valid = false;
+        }
+
+        if (!cursor_need(&c, unit_length)) {
+            PLCF_DEBUG("DWARF unit length at 0x%" PRIx64 " exceeds the section size", offset);
+            err = PLCRASH_EINVAL;
+            break;
+        }
+        c.p += unit_length;
+
+        if (parser.unit_count == capacity) {
+            capacity = capacity == 0 ? 256 : capacity * 2;
+            uint64_t *offsets = realloc(parser.unit_offsets, capacity * sizeof(*offsets));
+            if (offsets == NULL) {
+                free(parser.unit_offsets);
+                return PLCRASH_ENOMEM;
+            }
+            parser.unit_offsets = offsets;
+        }
+
+        parser.unit_offsets[parser.unit_count++] = offset;
+    }
+
+    /* Walk the units; any units preceding an invalid unit header are still reported */
+    for (size_t i = 0; i < parser.unit_count; i++) {
+        info_unit_t unit;
+        if (!load_unit(&parser, parser.unit_offsets[i], &unit))
+            continue;
+
+        bool proceed = parse_unit(&parser, &unit);
+        free_unit(&unit);
+        if (!proceed)
+            break;
+    }
+
+    if (parser.has_foreign)
+        free_unit(&parser.foreign);
+    free(parser.unit_offsets);
+    return err;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_DWARF_INLINE_TABLE_H
+#define PLCRASH_DWARF_INLINE_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashDwarfLineTable.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_dwarf_inline_table DWARF Inlined Subroutine Tables
+ * @ingroup plcrash_internal
+ *
+ * Decodes the address ranges of the DW_TAG_inlined_subroutine entries of a __debug_info section, as found in
+ * a dSYM, along with each inlined function's name and call site. Used to build the inline tables of offline
+ * symbol stores; the sections are read directly from a mapped file, and this implementation is not async-safe.
+ *
+ * DWARF versions 2 through 5 are supported, in host byte order, including the DWARF 5 string, address and range
+ * list index forms. Type units, split units and supplementary object files are not supported; their entries are
+ * skipped.
+ *
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * The DWARF sections referenced by the debugging information entries.
+ */
+typedef struct plcrash_dwarf_inline_sections {
+    /** The line table sections, used to resolve call site file indices. */
+    plcrash_dwarf_line_sections_t line;
+
+    /** The __debug_info section data, and its size. */
+    const uint8_t *debug_info;
+    uint64_t debug_info_size;
+
+    /** The __debug_abbrev section data, and its size. */
+    const uint8_t *debug_abbrev;
+    uint64_t debug_abbrev_size;
+
+    /** The __debug_ranges section data, or NULL if unavailable, and its size. Used by DWARF 2-4 units. */
+    const uint8_t *debug_ranges;
+    uint64_t debug_ranges_size;
+
+    /** The __debug_rnglists section data, or NULL if unavailable, and its size. Used by DWARF 5 units. */
+    const uint8_t *debug_rnglists;
+    uint64_t debug_rnglists_size;
+
+    /** The __debug_str_offs section data, or NULL if unavailable, and its size. Used by DWARF 5 units. */
+    const uint8_t *debug_str_offsets;
+    uint64_t debug_str_offsets_size;
+
+    /** The __debug_addr section data, or NULL if unavailable, and its size. Used by DWARF 5 units. */
+    const uint8_t *debug_addr;
+    uint64_t debug_addr_size;
+} plcrash_dwarf_inline_sections_t;
+
+/**
+ * @internal
+ *
+ * A single address range of an inlined subroutine.
+ */
+typedef struct plcrash_dwarf_inline_range {
+    /** The range's start address. */
+    uint64_t low;
+
+    /** The range's end address (exclusive). */
+    uint64_t high;
+
+    /** The number of inlined subroutines enclosing this subroutine within its concrete function. */
+    uint32_t depth;
+
+    /** The inlined function's linkage name, if available, or its name; NULL if unknown. */
+    const char *name;
+
+    /** The directory containing @a call_file, or NULL if @a call_file is absolute or the directory is unknown. */
+    const char *call_directory;
+
+    /** The source file of the call site, or NULL if unknown. */
+    const char *call_file;
+
+    /** The source line of the call site, or 0 if unknown. */
+    uint32_t call_line;
+} plcrash_dwarf_inline_range_t;
+
+/**
+ * Prototype of the callback used to report inlined subroutine ranges. The range's strings reference the sections'
+ * data, and remain valid for as long as the sections are mapped.
+ *
+ * @param range The decoded range.
+ * @param ctx The API client's supplied context value.
+ *
+ * @return Return false to stop parsing.
+ */
+typedef bool (*plcrash_dwarf_inline_range_cb)(const plcrash_dwarf_inline_range_t *range, void *ctx);
+
+plcrash_error_t plcrash_nasync_dwarf_inline_table_parse (const plcrash_dwarf_inline_sections_t *sections, plcrash_dwarf_inline_range_cb callback, void *ctx);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_DWARF_INLINE_TABLE_H */
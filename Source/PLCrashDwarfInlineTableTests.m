@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashDwarfInlineTable.h"
+
+@interface PLCrashDwarfInlineTableTests : SenTestCase @end
+
+/**
+ * A DWARF 4 line number program, used to resolve call site file indices. Defines the files:
+ *   1: src/a.c
+ *   2: /abs/b.c
+ */
+static const uint8_t line_program[] = {
+    /* unit_length, version, header_length */
+    0x4a, 0x00, 0x00, 0x00, 0x04, 0x00, 0x2b, 0x00, 0x00, 0x00,
+
+    /* minimum_instruction_length, maximum_operations_per_instruction, default_is_stmt, line_base (-5), line_range,
+     * opcode_base, standard_opcode_lengths */
+    0x01, 0x01, 0x01, 0xfb, 0x0e, 0x0d,
+    0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01,
+
+    /* include_directories: "src" */
+    's', 'r', 'c', 0x00, 0x00,
+
+    /* file_names: "a.c" (directory 1), "/abs/b.c" (directory 0) */
+    'a', '.', 'c', 0x00, 0x01, 0x00, 0x00,
+    '/', 'a', 'b', 's', '/', 'b', '.', 'c', 0x00, 0x00, 0x00, 0x00,
+    0x00,
+
+    /* DW_LNE_set_address 0x1000, DW_LNS_advance_line 9, DW_LNS_copy, special opcode */
+    0x00, 0x09, 0x02, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x09, 0x01,
+    0x4b,
+
+    /* DW_LNS_set_file 2, DW_LNS_advance_pc 4, DW_LNS_copy, DW_LNS_advance_pc 8, DW_LNE_end_sequence */
+    0x04, 0x02, 0x02, 0x04, 0x01,
+    0x02, 0x08, 0x00, 0x01, 0x01
+};
+
+/** Abbreviations referenced by debug_info. */
+static const uint8_t debug_abbrev[] = {
+    /* 1: DW_TAG_compile_unit, children: DW_AT_stmt_list/DW_FORM_sec_offset, DW_AT_low_pc/DW_FORM_addr */
+    0x01, 0x11, 0x01, 0x10, 0x17, 0x11, 0x01, 0x00, 0x00,
+
+    /* 2: DW_TAG_subprogram, no children: DW_AT_name/DW_FORM_string */
+    0x02, 0x2e, 0x00, 0x03, 0x08, 0x00, 0x00,
+
+    /* 3: DW_TAG_subprogram, children: DW_AT_name/DW_FORM_string, DW_AT_low_pc/DW_FORM_addr, DW_AT_high_pc/DW_FORM_data4 */
+    0x03, 0x2e, 0x01, 0x03, 0x08, 0x11, 0x01, 0x12, 0x06, 0x00, 0x00,
+
+    /* 4: DW_TAG_inlined_subroutine, children: DW_AT_abstract_origin/DW_FORM_ref4, DW_AT_low_pc/DW_FORM_addr,
+     * DW_AT_high_pc/DW_FORM_data4, DW_AT_call_file/DW_FORM_data1, DW_AT_call_line/DW_FORM_data1 */
+    0x04, 0x1d, 0x01, 0x31, 0x13, 0x11, 0x01, 0x12, 0x06, 0x58, 0x0b, 0x59, 0x0b, 0x00, 0x00,
+
+    0x00
+};
+
+/**
+ * A DWARF 4 unit, defining the function "outer" at 0x1000-0x1100, within which "inner" is inlined at
+ * 0x1010-0x1030 (called from src/a.c:12), and within that, inlined again at 0x1018-0x1020 (called from /abs/b.c:3).
+ */
+static const uint8_t debug_info[] = {
+    /* unit_length, version, debug_abbrev_offset, address_size */
+    0x58, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08,
+
+    /* 0x0b: DW_TAG_compile_unit */
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+
+    /* 0x18: DW_TAG_subprogram "inner" */
+    0x02, 'i', 'n', 'n', 'e', 'r', 0x00,
+
+    /* 0x1f: DW_TAG_subprogram "outer" */
+    0x03, 'o', 'u', 't', 'e', 'r', 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+
+    /* 0x32: DW_TAG_inlined_subroutine of 0x18 */
+    0x04, 0x18, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x01, 0x0c,
+
+    /* 0x45: DW_TAG_inlined_subroutine of 0x18 */
+    0x04, 0x18, 0x00, 0x00, 0x00, 0x18, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x02, 0x03,
+
+    /* Terminate the children of 0x45, 0x32, 0x1f and the unit DIE */
+    0x00, 0x00, 0x00, 0x00
+};
+
+/* Collected ranges */
+struct inline_ranges {
+    plcrash_dwarf_inline_range_t ranges[8];
+    size_t count;
+};
+
+static bool collect_ranges (const plcrash_dwarf_inline_range_t *range, void *ctx) {
+    struct inline_ranges *ranges = ctx;
+    if (ranges->count == sizeof(ranges->ranges) / sizeof(ranges->ranges[0]))
+        return false;
+
+    ranges->ranges[ranges->count++] = *range;
+    return true;
+}
+
+/**
+ * Populate @a sections with the test unit.
+ */
+static void init_sections (plcrash_dwarf_inline_sections_t *sections) {
+    memset(sections, 0, sizeof(*sections));
+    sections->line.debug_line = line_program;
+    sections->line.debug_line_size = sizeof(line_program);
+    sections->debug_info = debug_info;
+    sections->debug_info_size = sizeof(debug_info);
+    sections->debug_abbrev = debug_abbrev;
+    sections->debug_abbrev_size = sizeof(debug_abbrev);
+}
+
+@implementation PLCrashDwarfInlineTableTests
+
+/**
+ * Test decoding of nested inlined subroutines.
+ */
+- (void) testParse {
+    plcrash_dwarf_inline_sections_t sections;
+    struct inline_ranges ranges = { .count = 0 };
+
+    init_sections(&sections);
+    STAssertEquals(plcrash_nasync_dwarf_inline_table_parse(&sections, collect_ranges, &ranges), PLCRASH_ESUCCESS, @"Failed to parse debug info");
+    STAssertEquals(ranges.count, (size_t) 2, @"Incorrect range count");
+    if (ranges.count != 2)
+        return;
+
+    STAssertEquals(ranges.ranges[0].low, (uint64_t) 0x1010, @"Incorrect start address");
+    STAssertEquals(ranges.ranges[0].high, (uint64_t) 0x1030, @"Incorrect end address");
+    STAssertEquals(ranges.ranges[0].depth, (uint32_t) 0, @"Incorrect depth");
+    STAssertEqualCStrings(ranges.ranges[0].name, "inner", @"Name was not resolved via the abstract origin");
+    STAssertEqualCStrings(ranges.ranges[0].call_directory, "src", @"Incorrect call directory");
+    STAssertEqualCStrings(ranges.ranges[0].call_file, "a.c", @"Incorrect call file");
+    STAssertEquals(ranges.ranges[0].call_line, (uint32_t) 12, @"Incorrect call line");
+
+    STAssertEquals(ranges.ranges[1].low, (uint64_t) 0x1018, @"Incorrect start address");
+    STAssertEquals(ranges.ranges[1].high, (uint64_t) 0x1020, @"Incorrect end address");
+    STAssertEquals(ranges.ranges[1].depth, (uint32_t) 1, @"Incorrect depth");
+    STAssertEqualCStrings(ranges.ranges[1].name, "inner", @"Name was not resolved via the abstract origin");
+    STAssertNULL(ranges.ranges[1].call_directory, @"Absolute path returned a directory");
+    STAssertEqualCStrings(ranges.ranges[1].call_file, "/abs/b.c", @"Incorrect call file");
+    STAssertEquals(ranges.ranges[1].call_line, (uint32_t) 3, @"Incorrect call line");
+}
+
+/**
+ * Test that a unit length exceeding the section is rejected.
+ */
+- (void) testInvalidUnit {
+    plcrash_dwarf_inline_sections_t sections;
+    struct inline_ranges ranges = { .count = 0 };
+
+    init_sections(&sections);
+    sections.debug_info_size--;
+    STAssertEquals(plcrash_nasync_dwarf_inline_table_parse(&sections, collect_ranges, &ranges), PLCRASH_EINVAL, @"Truncated section was accepted");
+    STAssertEquals(ranges.count, (size_t) 0, @"Ranges were returned for an invalid unit");
+}
+
+@end
@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashDwarfLineTable.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_dwarf_line_table
+ * @{
+ */
+
+/* Standard opcodes */
+#define DW_LNS_copy                 0x01
+#define DW_LNS_advance_pc           0x02
+#define DW_LNS_advance_line         0x03
+#define DW_LNS_set_file             0x04
+#define DW_LNS_const_add_pc         0x08
+#define DW_LNS_fixed_advance_pc     0x09
+
+/* Extended opcodes */
+#define DW_LNE_end_sequence         0x01
+#define DW_LNE_set_address          0x02
+#define DW_LNE_define_file          0x03
+
+/* DWARF 5 entry content types */
+#define DW_LNCT_path                0x1
+#define DW_LNCT_directory_index     0x2
+
+/* DWARF 5 entry forms */
+#define DW_FORM_block               0x09
+#define DW_FORM_block1              0x0a
+#define DW_FORM_block2              0x03
+#define DW_FORM_block4              0x04
+#define DW_FORM_data1               0x0b
+#define DW_FORM_data2               0x05
+#define DW_FORM_data4               0x06
+#define DW_FORM_data8               0x07
+#define DW_FORM_data16              0x1e
+#define DW_FORM_string              0x08
+#define DW_FORM_strp                0x0e
+#define DW_FORM_udata               0x0f
+#define DW_FORM_line_strp           0x1f
+
+/** The maximum number of DWARF 5 entry format descriptions accepted per table. */
+#define MAX_ENTRY_FORMAT_COUNT 16
+
+/**
+ * A bounds-checked cursor over section data. Once a read fails, @a valid is cleared, and all subsequent reads
+ * return zero.
+ */
+typedef struct line_cursor {
+    const uint8_t *p;
+    const uint8_t *end;
+    bool valid;
+} line_cursor_t;
+
+/**
+ * The decoded header of a single line number program.
+ */
+typedef struct line_header {
+    uint16_t version;
+    bool dwarf64;
+    uint8_t min_inst_length;
+    int8_t line_base;
+    uint8_t line_range;
+    uint8_t opcode_base;
+    const uint8_t *standard_opcode_lengths;
+
+    /** The directory table. */
+    const char **directories;
+    uint64_t directory_count;
+
+    /** The file table. */
+    plcrash_dwarf_line_file_table_t files;
+    uint64_t file_capacity;
+} line_header_t;
+
+static bool cursor_need (line_cursor_t *c, uint64_t len) {
+    if (!c->valid || (uint64_t) (c->end - c->p) < len) {
+        c->valid = false;
+        return false;
+    }
+    return true;
+}
+
+static uint64_t read_fixed (line_cursor_t *c, size_t size) {
+    uint64_t value = 0;
+    if (!cursor_need(c, size))
+        return 0;
+
+    /* Values are read in host byte order; only little-endian hosts are supported */
+    memcpy(&value, c->p, size);
+    c->p += size;
+    return value;
+}
+
+static uint64_t read_uleb128 (line_cursor_t *c) {
+    uint64_t value = 0;
+    unsigned int shift = 0;
+
+    while (cursor_need(c, 1)) {
+        uint8_t byte = *c->p++;
+        if (shift < 64)
+            value |= ((uint64_t) (byte & 0x7f)) << shift;
+        shift += 7;
+
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+
+    return 0;
+}
+
+static int64_t read_sleb128 (line_cursor_t *c) {
+    uint64_t value = 0;
+    unsigned int shift = 0;
+
+    while (cursor_need(c, 1)) {
+        uint8_t byte = *c->p++;
+        if (shift < 64)
+            value |= ((uint64_t) (byte & 0x7f)) << shift;
+        shift += 7;
+
+        if ((byte & 0x80) == 0) {
+            if (shift < 64 && (byte & 0x40))
+                value |= ~(uint64_t) 0 << shift;
+            return (int64_t) value;
+        }
+    }
+
+    return 0;
+}
+
+static void skip (line_cursor_t *c, uint64_t len) {
+    if (cursor_need(c, len))
+        c->p += len;
+}
+
+/**
+ * Read an inline NUL-terminated string.
+ */
+static const char *read_string (line_cursor_t *c) {
+    if (!c->valid)
+        return NULL;
+
+    const uint8_t *nul = memchr(c->p, '\0', (size_t) (c->end - c->p));
+    if (nul == NULL) {
+        c->valid = false;
+        return NULL;
+    }
+
+    const char *result = (const char *) c->p;
+    c->p = nul + 1;
+    return result;
+}
+
+/**
+ * Return the NUL-terminated string at @a offset within @a section, or NULL if invalid.
+ */
+static const char *section_string (const uint8_t *section, uint64_t size, uint64_t offset) {
+    if (section == NULL || offset >= size || memchr(section + offset, '\0', (size_t) (size - offset)) == NULL)
+        return NULL;
+
+    return (const char *) (section + offset);
+}
+
+/**
+ * Append an entry to the header's file table.
+ */
+static bool append_file (line_header_t *header, const char *directory, const char *name) {
+    if (header->files.count == header->file_capacity) {
+        uint64_t capacity = header->file_capacity == 0 ? 32 : header->file_capacity * 2;
+        plcrash_dwarf_line_file_t *entries = realloc(header->files.entries, (size_t) capacity * sizeof(*entries));
+        if (entries == NULL)
+            return false;
+
+        header->files.entries = entries;
+        header->file_capacity = capacity;
+    }
+
+    header->files.entries[header->files.count].directory = directory;
+    header->files.entries[header->files.count].name = name;
+    header->files.count++;
+    return true;
+}
+
+/**
+ * Return the directory at @a index, or NULL if the directory is undefined. In DWARF 2-4 tables, index 0 refers to
+ * the compilation directory, which is not recorded in the line table.
+ */
+static const char *directory_at (const line_header_t *header, uint64_t index) {
+    if (header->version < 5) {
+        if (index == 0 || index > header->directory_count)
+            return NULL;
+        return header->directories[index - 1];
+    }
+
+    if (index >= header->directory_count)
+        return NULL;
+    return header->directories[index];
+}
+
+/**
+ * Read a single DWARF 5 entry attribute value of the given @a form, returning string values via @a string, and
+ * constant values via @a constant.
+ */
+static void read_entry_form (line_cursor_t *c, const plcrash_dwarf_line_sections_t *sections, const line_header_t *header,
+                             uint64_t form, const char **string, uint64_t *constant)
+{
+    size_t offset_size = header->dwarf64 ? 8 : 4;
+
+    *string = NULL;
+    *constant = 0;
+
+    switch (form) {
+        case DW_FORM_string:
+            *string = read_string(c);
+            break;
+        case DW_FORM_line_strp:
+            *string = section_string(sections->debug_line_str, sections->debug_line_str_size, read_fixed(c, offset_size));
+            break;
+        case DW_FORM_strp:
+            *string = section_string(sections->debug_str, sections->debug_str_size, read_fixed(c, offset_size));
+            break;
+        case DW_FORM_udata:
+            *constant = read_uleb128(c);
+            break;
+        case DW_FORM_data1:
+            *constant = read_fixed(c, 1);
+            break;
+        case DW_FORM_data2:
+            *constant = read_fixed(c, 2);
+            break;
+        case DW_FORM_data4:
+            *constant = read_fixed(c, 4);
+            break;
+        case DW_FORM_data8:
+            *constant = read_fixed(c, 8);
+            break;
+        case DW_FORM_data16:
+            skip(c, 16);
+            break;
+        case DW_FORM_block:
+            skip(c, read_uleb128(c));
+            break;
+        case DW_FORM_block1:
+            skip(c, read_fixed(c, 1));
+            break;
+        case DW_FORM_block2:
+            skip(c, read_fixed(c, 2));
+            break;
+        case DW_FORM_block4:
+            skip(c, read_fixed(c, 4));
+            break;
+        default:
+            /* Unsupported form (eg, the string offset table forms); the entry size is unknown */
+            PLCF_DEBUG("Unsupported DWARF line table entry form 0x%" PRIx64, form);
+            c->valid = false;
+            break;
+    }
+}
+
+/**
+ * Read a DWARF 5 directory or file name entry table. If @a files is true, entries are appended to the header's
+ * file table; otherwise, the directory table is populated.
+ */
+static bool read_entry_table (line_cursor_t *c, const plcrash_dwarf_line_sections_t *sections, line_header_t *header, bool files) {
+    uint64_t formats[MAX_ENTRY_FORMAT_COUNT][2];
+
+    uint8_t format_count = (uint8_t) read_fixed(c, 1);
+    if (format_count > MAX_ENTRY_FORMAT_COUNT)
+        return false;
+
+    for (uint8_t i = 0; i < format_count; i++) {
+        formats[i][0] = read_uleb128(c);
+        formats[i][1] = read_uleb128(c);
+    }
+
+    uint64_t count = read_uleb128(c);
+    if (!c->valid || count > (uint64_t) (c->end - c->p))
+        return false;
+
+    if (!files) {
+        if ((header->directories = calloc(count > 0 ? (size_t) count : 1, sizeof(*header->directories))) == NULL)
+            return false;
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        const char *path = NULL;
+        uint64_t directory_index = 0;
+
+        for (uint8_t f = 0; f < format_count; f++) {
+            const char *string;
+            uint64_t constant;
+
+            read_entry_form(c, sections, header, formats[f][1], &string, &constant);
+            if (formats[f][0] == DW_LNCT_path)
+                path = string;
+            else if (formats[f][0] == DW_LNCT_directory_index)
+                directory_index = constant;
+        }
+
+        if (!c->valid)
+            return false;
+
+        if (files) {
+            if (!append_file(header, directory_at(header, directory_index), path))
+                return false;
+        } else {
+            header->directories[header->directory_count++] = path;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Read the DWARF 2-4 include_directories and file_names tables.
+ */
+static bool read_legacy_tables (line_cursor_t *c, line_header_t *header) {
+    /* Count, and then record, the directory entries */
+    line_cursor_t start = *c;
+    uint64_t count = 0;
+    const char *dir;
+    while ((dir = read_string(c)) != NULL && *dir != '\0')
+        count++;
+
+    if (!c->valid)
+        return false;
+
+    if ((header->directories = calloc(count > 0 ? (size_t) count : 1, sizeof(*header->directories))) == NULL)
+        return false;
+
+    *c = start;
+    for (uint64_t i = 0; i < count; i++)
+        header->directories[header->directory_count++] = read_string(c);
+    read_string(c);
+
+    /* Read the file entries */
+    const char *name;
+    while ((name = read_string(c)) != NULL && *name != '\0') {
+        uint64_t directory_index = read_uleb128(c);
+        read_uleb128(c); /* modification time */
+        read_uleb128(c); /* length */
+
+        if (!c->valid || !append_file(header, directory_at(header, directory_index), name))
+            return false;
+    }
+
+    return c->valid;
+}
+
+/**
+ * Report a row for the given state, returning false if the callback requested termination.
+ */
+static bool emit_row (const line_header_t *header, uint64_t address, uint64_t file, uint64_t line, bool end_sequence,
+                      plcrash_dwarf_line_row_cb callback, void *ctx)
+{
+    plcrash_dwarf_line_row_t row;
+
+    row.address = address;
+    row.line = line > UINT32_MAX ? 0 : (uint32_t) line;
+    row.end_sequence = end_sequence;
+    if (!plcrash_nasync_dwarf_line_file_table_lookup(&header->files, file, &row.directory, &row.file)) {
+        row.directory = NULL;
+        row.file = NULL;
+    }
+
+    return callback(&row, ctx);
+}
+
+/**
+ * Execute the line number program within @a c, reporting rows via @a callback. Returns false if the callback
+ * requested termination.
+ */
+static bool run_program (line_cursor_t *c, line_header_t *header, plcrash_dwarf_line_row_cb callback, void *ctx) {
+    uint64_t address = 0;
+    uint64_t file = 1;
+    uint64_t line = 1;
+
+    while (c->valid && c->p < c->end) {
+        uint8_t opcode = (uint8_t) read_fixed(c, 1);
+
+        if (opcode >= header->opcode_base) {
+            /* Special opcode */
+            uint8_t adjusted = opcode - header->opcode_base;
+            address += (uint64_t) (adjusted / header->line_range) * header->min_inst_length;
+            line += (uint64_t) (int64_t) (header->line_base + (adjusted % header->line_range));
+
+            if (!emit_row(header, address, file, line, false, callback, ctx))
+                return false;
+            continue;
+        }
+
+        switch (opcode) {
+            case 0: {
+                /* Extended opcode */
+                uint64_t len = read_uleb128(c);
+                if (len == 0 || !cursor_need(c, len))
+                    break;
+
+                const uint8_t *next = c->p + len;
+                uint8_t sub_opcode = (uint8_t) read_fixed(c, 1);
+
+                switch (sub_opcode) {
+                    case DW_LNE_end_sequence:
+                        if (!emit_row(header, address, file, line, true, callback, ctx))
+                            return false;
+
+                        address = 0;
+                        file = 1;
+                        line = 1;
+                        break;
+
+                    case DW_LNE_set_address:
+                        if (len - 1 == 4 || len - 1 == 8)
+                            address = read_fixed(c, (size_t) (len - 1));
+                        break;
+
+                    case DW_LNE_define_file: {
+                        const char *name = read_string(c);
+                        uint64_t directory_index = read_uleb128(c);
+                        /* On allocation failure, rows referencing the entry will be reported without a file */
+                        if (c->valid)
+                            append_file(header, directory_at(header, directory_index), name);
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+
+                c->p = next;
+                break;
+            }
+
+            case DW_LNS_copy:
+                if (!emit_row(header, address, file, line, false, callback, ctx))
+                    return false;
+                break;
+
+            case DW_LNS_advance_pc:
+                address += read_uleb128(c) * header->min_inst_length;
+                break;
+
+            case DW_LNS_advance_line:
+                line += (uint64_t) read_sleb128(c);
+                break;
+
+            case DW_LNS_set_file:
+                file = read_uleb128(c);
+                break;
+
+            case DW_LNS_const_add_pc:
+                address += (uint64_t) ((255 - header->opcode_base) / header->line_range) * header->min_inst_length;
+                break;
+
+            case DW_LNS_fixed_advance_pc:
+                address += read_fixed(c, 2);
+                break;
+
+            default:
+                /* Skip the operands of any other standard opcode */
+                for (uint8_t i = 0; i < header->standard_opcode_lengths[opcode - 1]; i++)
+                    read_uleb128(c);
+                break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Read the header of the line number program unit within @a unit, including its directory and file tables. On
+ * success, returns true, and the unit's program is returned via @a program; the header must be released via
+ * free_unit_header(). Returns false if the unit is malformed or unsupported.
+ */
+static bool read_unit_header (line_cursor_t *unit, bool dwarf64, const plcrash_dwarf_line_sections_t *sections,
+                              line_header_t *header, line_cursor_t *program)
+{
+    memset(header, 0, sizeof(*header));
+    header->dwarf64 = dwarf64;
+    header->version = (uint16_t) read_fixed(unit, 2);
+    header->files.version = header->version;
+    if (header->version < 2 || header->version > 5) {
+        PLCF_DEBUG("Skipping DWARF line table with unsupported version %u", header->version);
+        return false;
+    }
+
+    if (header->version >= 5) {
+        uint8_t address_size = (uint8_t) read_fixed(unit, 1);
+        read_fixed(unit, 1); /* segment selector size */
+        if (address_size != 4 && address_size != 8)
+            return false;
+    }
+
+    uint64_t header_length = read_fixed(unit, dwarf64 ? 8 : 4);
+    if (!cursor_need(unit, header_length))
+        return false;
+
+    program->p = unit->p + header_length;
+    program->end = unit->end;
+    program->valid = true;
+
+    header->min_inst_length = (uint8_t) read_fixed(unit, 1);
+    if (header->version >= 4)
+        read_fixed(unit, 1); /* maximum operations per instruction */
+    read_fixed(unit, 1); /* default_is_stmt */
+    header->line_base = (int8_t) read_fixed(unit, 1);
+    header->line_range = (uint8_t) read_fixed(unit, 1);
+    header->opcode_base = (uint8_t) read_fixed(unit, 1);
+
+    if (!unit->valid || header->line_range == 0 || header->opcode_base == 0 || !cursor_need(unit, header->opcode_base - 1))
+        return false;
+
+    header->standard_opcode_lengths = unit->p;
+    unit->p += header->opcode_base - 1;
+
+    /* Restrict the header tables to the header's declared extent */
+    line_cursor_t tables = { unit->p, program->p, unit->p <= program->p };
+    bool tables_valid;
+    if (header->version >= 5) {
+        tables_valid = read_entry_table(&tables, sections, header, false) && read_entry_table(&tables, sections, header, true);
+    } else {
+        tables_valid = read_legacy_tables(&tables, header);
+    }
+
+    if (!tables_valid) {
+        PLCF_DEBUG("Skipping DWARF line table with invalid or unsupported file tables");
+        free(header->directories);
+        free(header->files.entries);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Release the tables allocated by read_unit_header().
+ */
+static void free_unit_header (line_header_t *header) {
+    free(header->directories);
+    free(header->files.entries);
+}
+
+/**
+ * Read the unit length at @a section's position, returning a cursor over the unit via @a unit, and advancing
+ * @a section past the unit. Returns false if the unit length is invalid.
+ */
+static bool read_unit (line_cursor_t *section, line_cursor_t *unit, bool *dwarf64) {
+    *dwarf64 = false;
+    uint64_t unit_length = read_fixed(section, 4);
+    if (unit_length == 0xffffffff) {
+        *dwarf64 = true;
+        unit_length = read_fixed(section, 8);
+    } else if (unit_length >= 0xfffffff0) {
+        PLCF_DEBUG("Reserved DWARF unit length 0x%" PRIx64, unit_length);
+        return false;
+    }
+
+    if (!cursor_need(section, unit_length)) {
+        PLCF_DEBUG("DWARF line table unit length 0x%" PRIx64 " exceeds the section size", unit_length);
+        return false;
+    }
+
+    unit->p = section->p;
+    unit->end = section->p + unit_length;
+    unit->valid = true;
+    section->p += unit_length;
+    return true;
+}
+
+/**
+ * Decode all line number programs within @a sections, reporting each row via @a callback.
+ *
+ * Rows are reported in the order defined by each line number program; they are not sorted, and may overlap
+ * across sequences. Units that are malformed, or use an unsupported DWARF version or form, are skipped.
+ *
+ * @param sections The DWARF sections to be read.
+ * @param callback The callback to be called for each row.
+ * @param ctx The context value to be passed to @a callback.
+ *
+ * @return Returns PLCRASH_ESUCCESS if all units were parsed, or if the callback requested termination, or
+ * PLCRASH_EINVAL if the section's unit headers could not be walked.
+ */
+plcrash_error_t plcrash_nasync_dwarf_line_table_parse (const plcrash_dwarf_line_sections_t *sections, plcrash_dwarf_line_row_cb callback, void *ctx) {
+    line_cursor_t section = { sections->debug_line, sections->debug_line + sections->debug_line_size, sections->debug_line != NULL };
+
+    while (section.valid && section.p < section.end) {
+        line_cursor_t unit;
+        line_cursor_t program;
+        line_header_t header;
+        bool dwarf64;
+
+        if (!read_unit(&section, &unit, &dwarf64))
+            return PLCRASH_EINVAL;
+
+        /* Malformed or unsupported units are skipped */
+        if (!read_unit_header(&unit, dwarf64, sections, &header, &program))
+            continue;
+
+        bool proceed = run_program(&program, &header, callback, ctx);
+        free_unit_header(&header);
+        if (!proceed)
+            break;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Read the file table of the line number program unit at @a offset within the __debug_line section, as referenced by
+ * a compilation unit's DW_AT_stmt_list attribute.
+ *
+ * @param table The table to initialize. On success, the table must be freed via
+ * plcrash_nasync_dwarf_line_file_table_free().
+ * @param sections The DWARF sections to be read.
+ * @param offset The offset of the line number program unit within @a sections' __debug_line section.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if the unit is malformed or unsupported.
+ */
+plcrash_error_t plcrash_nasync_dwarf_line_file_table_init (plcrash_dwarf_line_file_table_t *table, const plcrash_dwarf_line_sections_t *sections, uint64_t offset) {
+    line_cursor_t section = { sections->debug_line, sections->debug_line + sections->debug_line_size, sections->debug_line != NULL };
+    line_cursor_t unit;
+    line_cursor_t program;
+    line_header_t header;
+    bool dwarf64;
+
+    skip(&section, offset);
+    if (!read_unit(&section, &unit, &dwarf64) || !read_unit_header(&unit, dwarf64, sections, &header, &program))
+        return PLCRASH_EINVAL;
+
+    /* Hand the file table off to the caller */
+    *table = header.files;
+    free(header.directories);
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Look up the file at @a index, using the indexing of the table's DWARF version: indices are 1-based prior to
+ * DWARF 5, and 0-based thereafter.
+ *
+ * @param table The file table.
+ * @param index The file index, as used by the line number program and DW_AT_call_file attributes.
+ * @param directory On success, the directory containing @a file, or NULL if the file is absolute or the directory is
+ * unknown.
+ * @param file On success, the file name. May be NULL if the entry did not define a name.
+ *
+ * @return Returns true if @a index is defined.
+ */
+bool plcrash_nasync_dwarf_line_file_table_lookup (const plcrash_dwarf_line_file_table_t *table, uint64_t index, const char **directory, const char **file) {
+    if (table->version < 5) {
+        if (index == 0)
+            return false;
+        index--;
+    }
+
+    if (index >= table->count)
+        return false;
+
+    *file = table->entries[index].name;
+    *directory = (*file != NULL && (*file)[0] != '/') ? table->entries[index].directory : NULL;
+    return true;
+}
+
+/**
+ * Free a file table initialized via plcrash_nasync_dwarf_line_file_table_init().
+ *
+ * @param table The table to free.
+ */
+void plcrash_nasync_dwarf_line_file_table_free (plcrash_dwarf_line_file_table_t *table) {
+    free(table->entries);
+}
+
+/**
+ * @}
+ */
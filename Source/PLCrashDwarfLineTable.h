@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_DWARF_LINE_TABLE_H
+#define PLCRASH_DWARF_LINE_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_dwarf_line_table DWARF Line Tables
+ * @ingroup plcrash_internal
+ *
+ * Decodes the DWARF line number programs of a __debug_line section, as found in a dSYM, into the address to
+ * source file and line rows they describe. Used to build the line tables of offline symbol stores; the
+ * sections are read directly from a mapped file, and this implementation is not async-safe.
+ *
+ * DWARF versions 2 through 5 are supported, in host byte order. Units using an unsupported version or
+ * string form are skipped.
+ *
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * The DWARF sections referenced by a line table.
+ */
+typedef struct plcrash_dwarf_line_sections {
+    /** The __debug_line section data. */
+    const uint8_t *debug_line;
+
+    /** The size of @a debug_line, in bytes. */
+    uint64_t debug_line_size;
+
+    /** The __debug_line_str section data, or NULL if unavailable. Referenced by DWARF 5 line tables. */
+    const uint8_t *debug_line_str;
+
+    /** The size of @a debug_line_str, in bytes. */
+    uint64_t debug_line_str_size;
+
+    /** The __debug_str section data, or NULL if unavailable. Referenced by DWARF 5 line tables. */
+    const uint8_t *debug_str;
+
+    /** The size of @a debug_str, in bytes. */
+    uint64_t debug_str_size;
+} plcrash_dwarf_line_sections_t;
+
+/**
+ * @internal
+ *
+ * A single line table row.
+ */
+typedef struct plcrash_dwarf_line_row {
+    /** The row's address, as defined by the line program. */
+    uint64_t address;
+
+    /** The directory containing @a file, or NULL if @a file is absolute or the directory is unknown. */
+    const char *directory;
+
+    /** The source file name, or NULL if the row references an undefined file entry. */
+    const char *file;
+
+    /** The source line number, or 0 if the row is not attributable to a line. */
+    uint32_t line;
+
+    /** If true, this row marks the first address past the end of a sequence, and defines no source position. */
+    bool end_sequence;
+} plcrash_dwarf_line_row_t;
+
+/**
+ * Prototype of the callback used to report line table rows. The row's strings reference the sections' data,
+ * and remain valid for as long as the sections are mapped.
+ *
+ * @param row The decoded row.
+ * @param ctx The API client's supplied context value.
+ *
+ * @return Return false to stop parsing.
+ */
+typedef bool (*plcrash_dwarf_line_row_cb)(const plcrash_dwarf_line_row_t *row, void *ctx);
+
+/**
+ * @internal
+ *
+ * A line table file entry.
+ */
+typedef struct plcrash_dwarf_line_file {
+    /** The directory containing the file, or NULL if unknown. */
+    const char *directory;
+
+    /** The file name, or NULL if the entry did not define a name. */
+    const char *name;
+} plcrash_dwarf_line_file_t;
+
+/**
+ * @internal
+ *
+ * The file table of a single line number program.
+ */
+typedef struct plcrash_dwarf_line_file_table {
+    /** The line table's DWARF version, which defines the base of file indices. */
+    uint16_t version;
+
+    /** The file entries. */
+    plcrash_dwarf_line_file_t *entries;
+
+    /** The number of entries. */
+    uint64_t count;
+} plcrash_dwarf_line_file_table_t;
+
+plcrash_error_t plcrash_nasync_dwarf_line_table_parse (const plcrash_dwarf_line_sections_t *sections, plcrash_dwarf_line_row_cb callback, void *ctx);
+
+plcrash_error_t plcrash_nasync_dwarf_line_file_table_init (plcrash_dwarf_line_file_table_t *table, const plcrash_dwarf_line_sections_t *sections, uint64_t offset);
+bool plcrash_nasync_dwarf_line_file_table_lookup (const plcrash_dwarf_line_file_table_t *table, uint64_t index, const char **directory, const char **file);
+void plcrash_nasync_dwarf_line_file_table_free (plcrash_dwarf_line_file_table_t *table);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_DWARF_LINE_TABLE_H */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashDwarfLineTable.h"
+
+@interface PLCrashDwarfLineTableTests : SenTestCase @end
+
+/**
+ * A DWARF 4 line number program, defining the rows:
+ *   0x1000 src/a.c:10
+ *   0x1004 src/a.c:11
+ *   0x1008 /abs/b.c:11
+ *   0x1010 (end of sequence)
+ */
+static const uint8_t line_program[] = {
+    /* unit_length, version, header_length */
+    0x4a, 0x00, 0x00, 0x00, 0x04, 0x00, 0x2b, 0x00, 0x00, 0x00,
+
+    /* minimum_instruction_length, maximum_operations_per_instruction, default_is_stmt, line_base (-5), line_range,
+     * opcode_base, standard_opcode_lengths */
+    0x01, 0x01, 0x01, 0xfb, 0x0e, 0x0d,
+    0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01,
+
+    /* include_directories: "src" */
+    's', 'r', 'c', 0x00, 0x00,
+
+    /* file_names: "a.c" (directory 1), "/abs/b.c" (directory 0) */
+    'a', '.', 'c', 0x00, 0x01, 0x00, 0x00,
+    '/', 'a', 'b', 's', '/', 'b', '.', 'c', 0x00, 0x00, 0x00, 0x00,
+    0x00,
+
+    /* DW_LNE_set_address 0x1000 */
+    0x00, 0x09, 0x02, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+
+    /* DW_LNS_advance_line 9, DW_LNS_copy */
+    0x03, 0x09, 0x01,
+
+    /* Special opcode: address += 4, line += 1 */
+    0x4b,
+
+    /* DW_LNS_set_file 2, DW_LNS_advance_pc 4, DW_LNS_copy */
+    0x04, 0x02, 0x02, 0x04, 0x01,
+
+    /* DW_LNS_advance_pc 8, DW_LNE_end_sequence */
+    0x02, 0x08, 0x00, 0x01, 0x01
+};
+
+/* Collected rows */
+struct line_rows {
+    plcrash_dwarf_line_row_t rows[8];
+    size_t count;
+};
+
+static bool collect_rows (const plcrash_dwarf_line_row_t *row, void *ctx) {
+    struct line_rows *rows = ctx;
+    if (rows->count == sizeof(rows->rows) / sizeof(rows->rows[0]))
+        return false;
+
+    rows->rows[rows->count++] = *row;
+    return true;
+}
+
+@implementation PLCrashDwarfLineTableTests
+
+/**
+ * Test decoding of a DWARF 4 line number program.
+ */
+- (void) testParse {
+    plcrash_dwarf_line_sections_t sections = { line_program, sizeof(line_program), NULL, 0, NULL, 0 };
+    struct line_rows rows = { .count = 0 };
+
+    STAssertEquals(plcrash_nasync_dwarf_line_table_parse(&sections, collect_rows, &rows), PLCRASH_ESUCCESS, @"Failed to parse line table");
+    STAssertEquals(rows.count, (size_t) 4, @"Incorrect row count");
+    if (rows.count != 4)
+        return;
+
+    STAssertEquals(rows.rows[0].address, (uint64_t) 0x1000, @"Incorrect address");
+    STAssertEqualCStrings(rows.rows[0].directory, "src", @"Incorrect directory");
+    STAssertEqualCStrings(rows.rows[0].file, "a.c", @"Incorrect file");
+    STAssertEquals(rows.rows[0].line, (uint32_t) 10, @"Incorrect line");
+
+    STAssertEquals(rows.rows[1].address, (uint64_t) 0x1004, @"Incorrect address");
+    STAssertEquals(rows.rows[1].line, (uint32_t) 11, @"Incorrect line");
+
+    STAssertEquals(rows.rows[2].address, (uint64_t) 0x1008, @"Incorrect address");
+    STAssertNULL(rows.rows[2].directory, @"Absolute path returned a directory");
+    STAssertEqualCStrings(rows.rows[2].file, "/abs/b.c", @"Incorrect file");
+    STAssertFalse(rows.rows[2].end_sequence, @"Row incorrectly marked as the end of a sequence");
+
+    STAssertEquals(rows.rows[3].address, (uint64_t) 0x1010, @"Incorrect address");
+    STAssertTrue(rows.rows[3].end_sequence, @"Row not marked as the end of a sequence");
+}
+
+/**
+ * Test that a unit length exceeding the section is rejected, and that a truncated unit header is skipped.
+ */
+- (void) testInvalidUnit {
+    struct line_rows rows = { .count = 0 };
+
+    plcrash_dwarf_line_sections_t sections = { line_program, sizeof(line_program) - 1, NULL, 0, NULL, 0 };
+    STAssertEquals(plcrash_nasync_dwarf_line_table_parse(&sections, collect_rows, &rows), PLCRASH_EINVAL, @"Truncated section was accepted");
+
+    /* A unit containing only a version is skipped */
+    const uint8_t truncated[] = { 0x02, 0x00, 0x00, 0x00, 0x04, 0x00 };
+    plcrash_dwarf_line_sections_t truncated_sections = { truncated, sizeof(truncated), NULL, 0, NULL, 0 };
+    STAssertEquals(plcrash_nasync_dwarf_line_table_parse(&truncated_sections, collect_rows, &rows), PLCRASH_ESUCCESS, @"Truncated unit was not skipped");
+    STAssertEquals(rows.count, (size_t) 0, @"Rows were returned for invalid units");
+}
+
+@end
@@ -0,0 +1,647 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashDyldSharedCache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <mach-o/loader.h>
+#include <mach-o/nlist.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_dyld_shared_cache
+ * @{
+ */
+
+/** The prefix of the dyld_cache_header magic; the remainder names the cache's architecture. */
+#define CACHE_MAGIC_PREFIX "dyld_v1"
+
+/*
+ * dyld_cache_header field offsets. The header has grown over time; its size is given by mappingOffset, and a field
+ * is only present if it lies entirely below mappingOffset.
+ */
+#define HDR_MAPPING_OFFSET          16
+#define HDR_MAPPING_COUNT           20
+#define HDR_IMAGES_OFFSET_OLD       24
+#define HDR_IMAGES_COUNT_OLD        28
+#define HDR_LOCAL_SYMBOLS_OFFSET    72
+#define HDR_LOCAL_SYMBOLS_SIZE      80
+#define HDR_UUID                    88
+#define HDR_SUBCACHE_ARRAY_OFFSET   392
+#define HDR_SUBCACHE_ARRAY_COUNT    396
+#define HDR_SYMBOL_FILE_UUID        400
+#define HDR_IMAGES_OFFSET           448
+#define HDR_IMAGES_COUNT            452
+#define HDR_CACHE_SUB_TYPE          456
+
+/** The size of a dyld_cache_mapping_info record. */
+#define MAPPING_INFO_SIZE 32
+
+/** The size of a dyld_cache_image_info record. */
+#define IMAGE_INFO_SIZE 32
+
+/** The size of a dyld_subcache_entry_v1 record, used prior to the introduction of cacheSubType. */
+#define SUBCACHE_ENTRY_V1_SIZE 24
+
+/** The size of a dyld_subcache_entry record, and of its fileSuffix field. */
+#define SUBCACHE_ENTRY_SIZE 56
+#define SUBCACHE_SUFFIX_SIZE 32
+
+/** The size of a dyld_cache_local_symbols_info record. */
+#define LOCAL_SYMBOLS_INFO_SIZE 24
+
+/** The size of the 32-bit and 64-bit dyld_cache_local_symbols_entry records. */
+#define LOCAL_SYMBOLS_ENTRY_SIZE 12
+#define LOCAL_SYMBOLS_ENTRY_64_SIZE 16
+
+/** The name dyld substitutes for local symbols that have been stripped from the cache. */
+#define REDACTED_SYMBOL_NAME "<redacted>"
+
+/**
+ * Read a native-endian integer at @a offset within @a data.
+ */
+static inline uint32_t read32 (const uint8_t *data, size_t offset) {
+    uint32_t value;
+    memcpy(&value, data + offset, sizeof(value));
+    return value;
+}
+
+static inline uint64_t read64 (const uint8_t *data, size_t offset) {
+    uint64_t value;
+    memcpy(&value, data + offset, sizeof(value));
+    return value;
+}
+
+/**
+ * Return true if the header of @a file contains the @a size byte field at @a offset.
+ */
+static bool header_has_field (const plcrash_dyld_shared_cache_file_t *file, uint32_t offset, uint32_t size) {
+    return file->mapping_offset >= offset + size;
+}
+
+/**
+ * Return true if @a len bytes at @a offset lie within @a size.
+ */
+static bool range_valid (uint64_t size, uint64_t offset, uint64_t len) {
+    return offset <= size && len <= size - offset;
+}
+
+/**
+ * Map and validate the cache file at @a path, and append it to @a cache. If @a uuid is non-NULL, the file's
+ * header UUID must match.
+ */
+static plcrash_error_t add_file (plcrash_dyld_shared_cache_t *cache, const char *path, const uint8_t *uuid) {
+    struct stat sb;
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+
+    if (cache->file_count == PLCRASH_DYLD_SHARED_CACHE_MAX_FILES) {
+        PLCF_DEBUG("Too many sub-caches; ignoring %s", path);
+        return PLCRASH_EINVAL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        PLCF_DEBUG("Could not open %s: %s", path, strerror(errno));
+        return errno == ENOENT ? PLCRASH_ENOTFOUND : PLCRASH_EINTERNAL;
+    }
+
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode) || (uint64_t) sb.st_size < HDR_IMAGES_COUNT_OLD + 4) {
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    void *mapping = mmap(NULL, (size_t) sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        PLCF_DEBUG("Could not map %s: %s", path, strerror(errno));
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    plcrash_dyld_shared_cache_file_t *file = &cache->files[cache->file_count];
+    file->data = mapping;
+    file->size = (size_t) sb.st_size;
+    file->mapping_offset = read32(file->data, HDR_MAPPING_OFFSET);
+    file->mapping_count = read32(file->data, HDR_MAPPING_COUNT);
+
+    /* Validate the header and mappings */
+    if (memcmp(file->data, CACHE_MAGIC_PREFIX, strlen(CACHE_MAGIC_PREFIX)) != 0 ||
+        file->mapping_offset < HDR_IMAGES_COUNT_OLD + 4 ||
+        !range_valid(file->size, file->mapping_offset, (uint64_t) file->mapping_count * MAPPING_INFO_SIZE))
+    {
+        PLCF_DEBUG("%s is not a valid dyld shared cache", path);
+        err = PLCRASH_EINVAL;
+        goto invalid;
+    }
+
+    if (uuid != NULL && (!header_has_field(file, HDR_UUID, 16) || memcmp(file->data + HDR_UUID, uuid, 16) != 0)) {
+        PLCF_DEBUG("%s does not match its cache's UUID", path);
+        err = PLCRASH_EINVAL;
+        goto invalid;
+    }
+
+    cache->file_count++;
+    goto cleanup;
+
+invalid:
+    munmap(mapping, file->size);
+
+cleanup:
+    close(fd);
+    return err;
+}
+
+/**
+ * Return a pointer to the @a len bytes mapped at the unslid address @a address, or NULL if the address range is not
+ * mapped by any of the cache's files.
+ */
+static const uint8_t *resolve_address (const plcrash_dyld_shared_cache_t *cache, uint64_t address, uint64_t len) {
+    for (size_t i = 0; i < cache->file_count; i++) {
+        const plcrash_dyld_shared_cache_file_t *file = &cache->files[i];
+        for (uint32_t m = 0; m < file->mapping_count; m++) {
+            const uint8_t *info = file->data + file->mapping_offset + (size_t) m * MAPPING_INFO_SIZE;
+            uint64_t map_address = read64(info, 0);
+            uint64_t map_size = read64(info, 8);
+            uint64_t map_offset = read64(info, 16);
+
+            if (address < map_address || address - map_address >= map_size)
+                continue;
+
+            uint64_t delta = address - map_address;
+            if (len > map_size - delta || !range_valid(file->size, map_offset + delta, len))
+                return NULL;
+
+            return file->data + map_offset + delta;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Open the sub-caches named by the main cache's header.
+ */
+static plcrash_error_t open_subcaches (plcrash_dyld_shared_cache_t *cache, const char *path) {
+    const plcrash_dyld_shared_cache_file_t *main_file = &cache->files[0];
+    plcrash_error_t err;
+
+    if (!header_has_field(main_file, HDR_SUBCACHE_ARRAY_COUNT, 4))
+        return PLCRASH_ESUCCESS;
+
+    uint32_t offset = read32(main_file->data, HDR_SUBCACHE_ARRAY_OFFSET);
+    uint32_t count = read32(main_file->data, HDR_SUBCACHE_ARRAY_COUNT);
+    bool v2 = header_has_field(main_file, HDR_CACHE_SUB_TYPE, 4);
+    size_t entry_size = v2 ? SUBCACHE_ENTRY_SIZE : SUBCACHE_ENTRY_V1_SIZE;
+
+    if (!range_valid(main_file->size, offset, (uint64_t) count * entry_size)) {
+        PLCF_DEBUG("Invalid sub-cache array in %s", path);
+        return PLCRASH_EINVAL;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *entry = main_file->data + offset + (size_t) i * entry_size;
+        char *subcache_path;
+        int ret;
+
+        if (v2) {
+            char suffix[SUBCACHE_SUFFIX_SIZE + 1];
+            memcpy(suffix, entry + 24, SUBCACHE_SUFFIX_SIZE);
+            suffix[SUBCACHE_SUFFIX_SIZE] = '\0';
+            ret = asprintf(&subcache_path, "%s%s", path, suffix);
+        } else {
+            ret = asprintf(&subcache_path, "%s.%u", path, i + 1);
+        }
+
+        if (ret < 0)
+            return PLCRASH_ENOMEM;
+
+        err = add_file(cache, subcache_path, entry);
+        free(subcache_path);
+        if (err != PLCRASH_ESUCCESS)
+            return err;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Locate the cache's local symbols, either within the main cache file, or within its separate .symbols file.
+ */
+static plcrash_error_t open_local_symbols (plcrash_dyld_shared_cache_t *cache, const char *path) {
+    static const uint8_t zero_uuid[16] = { 0 };
+    const plcrash_dyld_shared_cache_file_t *main_file = &cache->files[0];
+    const plcrash_dyld_shared_cache_file_t *symbols_file = main_file;
+    plcrash_error_t err;
+
+    /* Newer caches record local symbols entries by VM offset, rather than file offset */
+    cache->local_symbols_64 = main_file->mapping_offset >= HDR_SYMBOL_FILE_UUID;
+
+    if (header_has_field(main_file, HDR_SYMBOL_FILE_UUID, 16) && memcmp(main_file->data + HDR_SYMBOL_FILE_UUID, zero_uuid, 16) != 0) {
+        char *symbols_path;
+        if (asprintf(&symbols_path, "%s.symbols", path) < 0)
+            return PLCRASH_ENOMEM;
+
+        err = add_file(cache, symbols_path, main_file->data + HDR_SYMBOL_FILE_UUID);
+        free(symbols_path);
+
+        /* A missing symbols file is not fatal; only the cache's exported symbols will be available */
+        if (err == PLCRASH_ENOTFOUND)
+            return PLCRASH_ESUCCESS;
+        else if (err != PLCRASH_ESUCCESS)
+            return err;
+
+        symbols_file = &cache->files[cache->file_count - 1];
+    }
+
+    if (!header_has_field(symbols_file, HDR_LOCAL_SYMBOLS_SIZE, 8))
+        return PLCRASH_ESUCCESS;
+
+    uint64_t offset = read64(symbols_file->data, HDR_LOCAL_SYMBOLS_OFFSET);
+    uint64_t size = read64(symbols_file->data, HDR_LOCAL_SYMBOLS_SIZE);
+    if (offset == 0 || size < LOCAL_SYMBOLS_INFO_SIZE)
+        return PLCRASH_ESUCCESS;
+
+    if (!range_valid(symbols_file->size, offset, size)) {
+        PLCF_DEBUG("Invalid local symbols range in %s", path);
+        return PLCRASH_EINVAL;
+    }
+
+    cache->local_symbols = symbols_file->data + offset;
+    cache->local_symbols_size = size;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Open the dyld shared cache at @a path, along with any sub-caches and symbols file that reside alongside it.
+ *
+ * @param cache The cache to initialize. On success, the cache must be closed via
+ * plcrash_nasync_dyld_shared_cache_close().
+ * @param path The path to the main cache file.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the cache or one of its sub-caches could not be
+ * found, PLCRASH_EINVAL if the file is not a valid dyld shared cache, or an error result on failure.
+ */
+plcrash_error_t plcrash_nasync_dyld_shared_cache_open (plcrash_dyld_shared_cache_t *cache, const char *path) {
+    plcrash_error_t err;
+
+    memset(cache, 0, sizeof(*cache));
+    if ((err = add_file(cache, path, NULL)) != PLCRASH_ESUCCESS)
+        return err;
+
+    const plcrash_dyld_shared_cache_file_t *main_file = &cache->files[0];
+    if (main_file->mapping_count == 0) {
+        PLCF_DEBUG("%s does not define any mappings", path);
+        err = PLCRASH_EINVAL;
+        goto failed;
+    }
+
+    cache->base_address = read64(main_file->data + main_file->mapping_offset, 0);
+
+    if ((err = open_subcaches(cache, path)) != PLCRASH_ESUCCESS)
+        goto failed;
+
+    if ((err = open_local_symbols(cache, path)) != PLCRASH_ESUCCESS)
+        goto failed;
+
+    return PLCRASH_ESUCCESS;
+
+failed:
+    plcrash_nasync_dyld_shared_cache_close(cache);
+    return err;
+}
+
+/**
+ * Parse the Mach-O header and load commands of the image at @a header_address, populating @a image. Returns false
+ * if the image is not mapped, or is not a valid native-endian Mach-O image.
+ */
+static bool parse_image (const plcrash_dyld_shared_cache_t *cache, uint64_t header_address, plcrash_dyld_shared_cache_image_t *image) {
+    const uint8_t *header = resolve_address(cache, header_address, sizeof(struct mach_header));
+    if (header == NULL)
+        return false;
+
+    struct mach_header mh;
+    memcpy(&mh, header, sizeof(mh));
+
+    size_t header_size;
+    if (mh.magic == MH_MAGIC_64) {
+        image->m64 = true;
+        header_size = sizeof(struct mach_header_64);
+    } else if (mh.magic == MH_MAGIC) {
+        image->m64 = false;
+        header_size = sizeof(struct mach_header);
+    } else {
+        return false;
+    }
+
+    if ((header = resolve_address(cache, header_address, header_size + (uint64_t) mh.sizeofcmds)) == NULL)
+        return false;
+
+    image->header_address = header_address;
+    image->has_uuid = false;
+    image->text_vmaddr = header_address;
+    image->symtab_address = 0;
+    image->nsyms = 0;
+    image->strtab_address = 0;
+    image->strsize = 0;
+
+    bool has_linkedit = false;
+    uint64_t linkedit_vmaddr = 0;
+    uint64_t linkedit_fileoff = 0;
+    bool has_symtab = false;
+    struct symtab_command symtab;
+
+    /* Walk the load commands */
+    size_t offset = header_size;
+    size_t end = header_size + mh.sizeofcmds;
+    for (uint32_t i = 0; i < mh.ncmds; i++) {
+        struct load_command lc;
+        if (end - offset < sizeof(lc))
+            return false;
+
+        memcpy(&lc, header + offset, sizeof(lc));
+        if (lc.cmdsize < sizeof(lc) || lc.cmdsize > end - offset)
+            return false;
+
+        const uint8_t *cmd = header + offset;
+        if (lc.cmd == LC_SEGMENT_64 && lc.cmdsize >= sizeof(struct segment_command_64)) {
+            struct segment_command_64 seg;
+            memcpy(&seg, cmd, sizeof(seg));
+            if (strncmp(seg.segname, SEG_TEXT, sizeof(seg.segname)) == 0) {
+                image->text_vmaddr = seg.vmaddr;
+            } else if (strncmp(seg.segname, SEG_LINKEDIT, sizeof(seg.segname)) == 0) {
+                has_linkedit = true;
+                linkedit_vmaddr = seg.vmaddr;
+                linkedit_fileoff = seg.fileoff;
+            }
+        } else if (lc.cmd == LC_SEGMENT && lc.cmdsize >= sizeof(struct segment_command)) {
+            struct segment_command seg;
+            memcpy(&seg, cmd, sizeof(seg));
+            if (strncmp(seg.segname, SEG_TEXT, sizeof(seg.segname)) == 0) {
+                image->text_vmaddr = seg.vmaddr;
+            } else if (strncmp(seg.segname, SEG_LINKEDIT, sizeof(seg.segname)) == 0) {
+                has_linkedit = true;
+                linkedit_vmaddr = seg.vmaddr;
+                linkedit_fileoff = seg.fileoff;
+            }
+        } else if (lc.cmd == LC_UUID && lc.cmdsize >= sizeof(struct uuid_command)) {
+            struct uuid_command uuid_cmd;
+            memcpy(&uuid_cmd, cmd, sizeof(uuid_cmd));
+            memcpy(image->uuid, uuid_cmd.uuid, sizeof(image->uuid));
+            image->has_uuid = true;
+        } else if (lc.cmd == LC_SYMTAB && lc.cmdsize >= sizeof(struct symtab_command)) {
+            memcpy(&symtab, cmd, sizeof(symtab));
+            has_symtab = true;
+        }
+
+        offset += lc.cmdsize;
+    }
+
+    /* The symbol table's file offsets are relative to the cache file containing __LINKEDIT; translate them to
+     * addresses via the __LINKEDIT segment */
+    if (has_symtab && has_linkedit && symtab.symoff >= linkedit_fileoff && symtab.stroff >= linkedit_fileoff) {
+        image->symtab_address = linkedit_vmaddr + (symtab.symoff - linkedit_fileoff);
+        image->nsyms = symtab.nsyms;
+        image->strtab_address = linkedit_vmaddr + (symtab.stroff - linkedit_fileoff);
+        image->strsize = symtab.strsize;
+    }
+
+    return true;
+}
+
+/**
+ * Enumerate the images within @a cache.
+ *
+ * @param cache The cache to enumerate.
+ * @param callback The callback to be called for each valid image.
+ * @param ctx The context to be passed to @a callback.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if the cache's image list is invalid.
+ */
+plcrash_error_t plcrash_nasync_dyld_shared_cache_images (plcrash_dyld_shared_cache_t *cache, plcrash_dyld_shared_cache_image_cb callback, void *ctx) {
+    const plcrash_dyld_shared_cache_file_t *main_file = &cache->files[0];
+    uint32_t offset = read32(main_file->data, HDR_IMAGES_OFFSET_OLD);
+    uint32_t count = read32(main_file->data, HDR_IMAGES_COUNT_OLD);
+
+    /* Newer caches moved the image list, leaving the old fields zeroed */
+    if (header_has_field(main_file, HDR_IMAGES_COUNT, 4) && read32(main_file->data, HDR_IMAGES_COUNT) != 0) {
+        offset = read32(main_file->data, HDR_IMAGES_OFFSET);
+        count = read32(main_file->data, HDR_IMAGES_COUNT);
+    }
+
+    if (!range_valid(main_file->size, offset, (uint64_t) count * IMAGE_INFO_SIZE)) {
+        PLCF_DEBUG("Invalid image list");
+        return PLCRASH_EINVAL;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *info = main_file->data + offset + (size_t) i * IMAGE_INFO_SIZE;
+        uint64_t address = read64(info, 0);
+        uint32_t path_offset = read32(info, 24);
+
+        if (path_offset >= main_file->size || memchr(main_file->data + path_offset, '\0', main_file->size - path_offset) == NULL) {
+            PLCF_DEBUG("Invalid path for image at 0x%llx", (unsigned long long) address);
+            continue;
+        }
+
+        plcrash_dyld_shared_cache_image_t image;
+        image.path = (const char *) main_file->data + path_offset;
+        if (!parse_image(cache, address, &image)) {
+            PLCF_DEBUG("Could not parse image %s", image.path);
+            continue;
+        }
+
+        callback(&image, ctx);
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Report the defined, non-debugging symbols of the @a count nlist entries at @a nlists, using the @a strsize byte
+ * string table at @a strings.
+ */
+static void report_nlists (const uint8_t *nlists, uint32_t count, bool m64, const uint8_t *strings, uint64_t strsize,
+                           plcrash_dyld_shared_cache_symbol_cb callback, void *ctx)
+{
+    size_t nlist_size = m64 ? sizeof(struct nlist_64) : sizeof(struct nlist);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *entry = nlists + (size_t) i * nlist_size;
+        uint32_t n_strx;
+        uint8_t n_type;
+        uint64_t n_value;
+
+        if (m64) {
+            struct nlist_64 nl;
+            memcpy(&nl, entry, sizeof(nl));
+            n_strx = nl.n_un.n_strx;
+            n_type = nl.n_type;
+            n_value = nl.n_value;
+        } else {
+            struct nlist nl;
+            memcpy(&nl, entry, sizeof(nl));
+            n_strx = nl.n_un.n_strx;
+            n_type = nl.n_type;
+            n_value = nl.n_value;
+        }
+
+        if ((n_type & N_STAB) != 0 || (n_type & N_TYPE) != N_SECT)
+            continue;
+
+        if (n_strx >= strsize || memchr(strings + n_strx, '\0', (size_t) (strsize - n_strx)) == NULL)
+            continue;
+
+        const char *name = (const char *) strings + n_strx;
+        if (*name == '\0' || strcmp(name, REDACTED_SYMBOL_NAME) == 0)
+            continue;
+
+        callback(n_value, name, ctx);
+    }
+}
+
+/**
+ * Report the local symbols of @a image, as found in the cache's local symbols info.
+ */
+static void report_local_symbols (plcrash_dyld_shared_cache_t *cache, const plcrash_dyld_shared_cache_image_t *image,
+                                  plcrash_dyld_shared_cache_symbol_cb callback, void *ctx)
+{
+    const uint8_t *info = cache->local_symbols;
+    uint64_t info_size = cache->local_symbols_size;
+    if (info == NULL)
+        return;
+
+    uint32_t nlist_offset = read32(info, 0);
+    uint32_t nlist_count = read32(info, 4);
+    uint32_t strings_offset = read32(info, 8);
+    uint32_t strings_size = read32(info, 12);
+    uint32_t entries_offset = read32(info, 16);
+    uint32_t entries_count = read32(info, 20);
+
+    size_t nlist_size = image->m64 ? sizeof(struct nlist_64) : sizeof(struct nlist);
+    size_t entry_size = cache->local_symbols_64 ? LOCAL_SYMBOLS_ENTRY_64_SIZE : LOCAL_SYMBOLS_ENTRY_SIZE;
+
+    if (!range_valid(info_size, nlist_offset, (uint64_t) nlist_count * nlist_size) ||
+        !range_valid(info_size, strings_offset, strings_size) ||
+        !range_valid(info_size, entries_offset, (uint64_t) entries_count * entry_size))
+    {
+        PLCF_DEBUG("Invalid local symbols info");
+        return;
+    }
+
+    /* Determine the key used by the image's entry; either its VM offset, or the main cache file offset of its header */
+    uint64_t dylib_offset;
+    if (cache->local_symbols_64) {
+        dylib_offset = image->header_address - cache->base_address;
+    } else {
+        const uint8_t *header = resolve_address(cache, image->header_address, 1);
+        const plcrash_dyld_shared_cache_file_t *main_file = &cache->files[0];
+        if (header == NULL || header < main_file->data || header >= main_file->data + main_file->size)
+            return;
+
+        dylib_offset = (uint64_t) (header - main_file->data);
+    }
+
+    for (uint32_t i = 0; i < entries_count; i++) {
+        const uint8_t *entry = info + entries_offset + (size_t) i * entry_size;
+        uint64_t entry_offset;
+        uint32_t start;
+        uint32_t count;
+
+        if (cache->local_symbols_64) {
+            entry_offset = read64(entry, 0);
+            start = read32(entry, 8);
+            count = read32(entry, 12);
+        } else {
+            entry_offset = read32(entry, 0);
+            start = read32(entry, 4);
+            count = read32(entry, 8);
+        }
+
+        if (entry_offset != dylib_offset)
+            continue;
+
+        if (start > nlist_count || count > nlist_count - start) {
+            PLCF_DEBUG("Invalid local symbols entry for %s", image->path);
+            return;
+        }
+
+        report_nlists(info + nlist_offset + (size_t) start * nlist_size, count, image->m64, info + strings_offset, strings_size, callback, ctx);
+        return;
+    }
+}
+
+/**
+ * Enumerate the symbols of @a image, including both the symbols of the image's own symbol table, and the local
+ * symbols that dyld moved out of the image when building the cache. Only symbols defined within a section are
+ * reported; undefined, absolute and debugging symbols, as well as redacted local symbols, are skipped. A symbol
+ * may be reported more than once.
+ *
+ * @param cache The cache containing @a image.
+ * @param image An image returned by plcrash_nasync_dyld_shared_cache_images().
+ * @param callback The callback to be called for each symbol.
+ * @param ctx The context to be passed to @a callback.
+ */
+void plcrash_nasync_dyld_shared_cache_image_symbols (plcrash_dyld_shared_cache_t *cache, const plcrash_dyld_shared_cache_image_t *image,
+                                                     plcrash_dyld_shared_cache_symbol_cb callback, void *ctx)
+{
+    size_t nlist_size = image->m64 ? sizeof(struct nlist_64) : sizeof(struct nlist);
+
+    if (image->nsyms > 0) {
+        const uint8_t *nlists = resolve_address(cache, image->symtab_address, (uint64_t) image->nsyms * nlist_size);
+        const uint8_t *strings = resolve_address(cache, image->strtab_address, image->strsize);
+        if (nlists != NULL && strings != NULL) {
+            report_nlists(nlists, image->nsyms, image->m64, strings, image->strsize, callback, ctx);
+        } else {
+            PLCF_DEBUG("Symbol table of %s is not mapped", image->path);
+        }
+    }
+
+    report_local_symbols(cache, image, callback, ctx);
+}
+
+/**
+ * Close @a cache, unmapping all of its files.
+ *
+ * @param cache The cache to close.
+ */
+void plcrash_nasync_dyld_shared_cache_close (plcrash_dyld_shared_cache_t *cache) {
+    for (size_t i = 0; i < cache->file_count; i++)
+        munmap((void *) cache->files[i].data, cache->files[i].size);
+
+    cache->file_count = 0;
+    cache->local_symbols = NULL;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_DYLD_SHARED_CACHE_H
+#define PLCRASH_DYLD_SHARED_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_dyld_shared_cache Dyld Shared Cache Reader
+ * @ingroup plcrash_internal
+ *
+ * Reads the images and symbol tables of a dyld shared cache file on disk, as extracted from a device or found in
+ * an OS installation, so that symbol stores may be built for the system libraries it contains. This implementation
+ * is not async-safe.
+ *
+ * Both single-file caches and split caches are supported. The sub-caches of a split cache, including the .symbols
+ * file containing the cache's unmapped local symbols, are expected to reside alongside the main cache file, using
+ * dyld's standard naming. Only caches in native byte order are supported.
+ *
+ * @{
+ */
+
+/** The maximum number of files (the main cache, its sub-caches, and its symbols file) accepted for a single cache. */
+#define PLCRASH_DYLD_SHARED_CACHE_MAX_FILES 64
+
+/**
+ * @internal
+ *
+ * A single mapped cache file.
+ */
+typedef struct plcrash_dyld_shared_cache_file {
+    /** The mapped file data. */
+    const uint8_t *data;
+
+    /** The size of @a data, in bytes. */
+    size_t size;
+
+    /** The offset and count of the file's dyld_cache_mapping_info records. */
+    uint32_t mapping_offset;
+    uint32_t mapping_count;
+} plcrash_dyld_shared_cache_file_t;
+
+/**
+ * @internal
+ *
+ * An open dyld shared cache.
+ */
+typedef struct plcrash_dyld_shared_cache {
+    /** The mapped cache files. The main cache file is always first. */
+    plcrash_dyld_shared_cache_file_t files[PLCRASH_DYLD_SHARED_CACHE_MAX_FILES];
+    size_t file_count;
+
+    /** The cache's unslid base address. */
+    uint64_t base_address;
+
+    /** The cache's local symbols info, or NULL if the cache's local symbols are unavailable, and its size. */
+    const uint8_t *local_symbols;
+    uint64_t local_symbols_size;
+
+    /** True if the local symbols entries use 64-bit VM offsets, rather than 32-bit file offsets. */
+    bool local_symbols_64;
+} plcrash_dyld_shared_cache_t;
+
+/**
+ * @internal
+ *
+ * A single image within a dyld shared cache.
+ */
+typedef struct plcrash_dyld_shared_cache_image {
+    /** The image's install path. References the cache's mapping, and is valid until the cache is closed. */
+    const char *path;
+
+    /** The image UUID, if @a has_uuid is true. */
+    uint8_t uuid[16];
+
+    /** True if the image defines an LC_UUID command. */
+    bool has_uuid;
+
+    /** The unslid address of the image's Mach-O header. */
+    uint64_t header_address;
+
+    /** The unslid address of the image's __TEXT segment. */
+    uint64_t text_vmaddr;
+
+    /** True if the image is a 64-bit image. */
+    bool m64;
+
+    /** The unslid addresses of the image's symbol and string tables, as found via LC_SYMTAB. */
+    uint64_t symtab_address;
+    uint32_t nsyms;
+    uint64_t strtab_address;
+    uint32_t strsize;
+} plcrash_dyld_shared_cache_image_t;
+
+/**
+ * Prototype of the callback used to report the images of a cache.
+ *
+ * @param image The image. The image record is only valid for the duration of the callback.
+ * @param ctx The API client's supplied context value.
+ */
+typedef void (*plcrash_dyld_shared_cache_image_cb)(const plcrash_dyld_shared_cache_image_t *image, void *ctx);
+
+/**
+ * Prototype of the callback used to report the symbols of a cache image.
+ *
+ * @param address The symbol's unslid address.
+ * @param name The symbol's NUL-terminated name, referencing the cache's mapping.
+ * @param ctx The API client's supplied context value.
+ */
+typedef void (*plcrash_dyld_shared_cache_symbol_cb)(uint64_t address, const char *name, void *ctx);
+
+plcrash_error_t plcrash_nasync_dyld_shared_cache_open (plcrash_dyld_shared_cache_t *cache, const char *path);
+plcrash_error_t plcrash_nasync_dyld_shared_cache_images (plcrash_dyld_shared_cache_t *cache, plcrash_dyld_shared_cache_image_cb callback, void *ctx);
+void plcrash_nasync_dyld_shared_cache_image_symbols (plcrash_dyld_shared_cache_t *cache, const plcrash_dyld_shared_cache_image_t *image,
+                                                     plcrash_dyld_shared_cache_symbol_cb callback, void *ctx);
+void plcrash_nasync_dyld_shared_cache_close (plcrash_dyld_shared_cache_t *cache);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_DYLD_SHARED_CACHE_H */
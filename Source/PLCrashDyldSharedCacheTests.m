@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashDyldSharedCache.h"
+
+#import <mach-o/loader.h>
+#import <mach-o/nlist.h>
+
+@interface PLCrashDyldSharedCacheTests : SenTestCase {
+@private
+    /** Main cache file path. The sub-cache and symbols file are written alongside it. */
+    NSString *_path;
+}
+@end
+
+static const uint8_t main_uuid[16] = { 0x1, 0x2, 0x3 };
+static const uint8_t subcache_uuid[16] = { 0x4, 0x5, 0x6 };
+static const uint8_t symbols_uuid[16] = { 0x7, 0x8, 0x9 };
+static const uint8_t image_uuid[16] = { 0xA, 0xB, 0xC };
+
+/** Cache header size; large enough to include the cacheSubType field. */
+#define TEST_HEADER_SIZE 512
+
+/** Write the native-endian value @a value at @a offset within @a data. */
+static void put32 (NSMutableData *data, size_t offset, uint32_t value) {
+    [data replaceBytesInRange: NSMakeRange(offset, sizeof(value)) withBytes: &value];
+}
+
+static void put64 (NSMutableData *data, size_t offset, uint64_t value) {
+    [data replaceBytesInRange: NSMakeRange(offset, sizeof(value)) withBytes: &value];
+}
+
+static void put_bytes (NSMutableData *data, size_t offset, const void *bytes, size_t len) {
+    [data replaceBytesInRange: NSMakeRange(offset, len) withBytes: bytes];
+}
+
+/** Populate a cache file header with a single mapping of @a size bytes at @a address, backed by @a file_offset. */
+static void put_header (NSMutableData *data, const uint8_t uuid[16], uint64_t address, uint64_t size, uint64_t file_offset) {
+    put_bytes(data, 0, "dyld_v1   arm64e", 16);
+    put32(data, 16, TEST_HEADER_SIZE);
+    put32(data, 20, size > 0 ? 1 : 0);
+    put_bytes(data, 88, uuid, 16);
+
+    if (size > 0) {
+        put64(data, TEST_HEADER_SIZE, address);
+        put64(data, TEST_HEADER_SIZE + 8, size);
+        put64(data, TEST_HEADER_SIZE + 16, file_offset);
+    }
+}
+
+/** Image enumeration context. */
+struct test_ctx {
+    /** The cache being enumerated. */
+    plcrash_dyld_shared_cache_t *cache;
+
+    /** Symbol addresses of the test image, keyed by name. */
+    NSMutableDictionary *symbols;
+
+    /** Number of images reported. */
+    NSUInteger image_count;
+};
+
+static void symbol_cb (uint64_t address, const char *name, void *ctx) {
+    struct test_ctx *tctx = ctx;
+    [tctx->symbols setObject: [NSNumber numberWithUnsignedLongLong: address] forKey: [NSString stringWithUTF8String: name]];
+}
+
+static void image_cb (const plcrash_dyld_shared_cache_image_t *image, void *ctx) {
+    struct test_ctx *tctx = ctx;
+
+    tctx->image_count++;
+    if (strcmp(image->path, "/usr/lib/libtest.dylib") != 0 || !image->has_uuid || memcmp(image->uuid, image_uuid, 16) != 0)
+        return;
+
+    [tctx->symbols setObject: [NSNumber numberWithUnsignedLongLong: image->text_vmaddr] forKey: @"__TEXT"];
+    plcrash_nasync_dyld_shared_cache_image_symbols(tctx->cache, image, symbol_cb, tctx);
+}
+
+@implementation PLCrashDyldSharedCacheTests
+
+- (void) setUp {
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+
+    /*
+     * Write a split cache: the main cache maps a single 64-bit image, the image's __LINKEDIT resides in a sub-cache,
+     * and its local symbols reside in a separate symbols file.
+     */
+    NSMutableData *cache = [NSMutableData dataWithLength: 0x2000];
+    put_header(cache, main_uuid, 0x180000000ULL, 0x2000, 0);
+    put32(cache, 392, 0x240);
+    put32(cache, 396, 1);
+    put_bytes(cache, 400, symbols_uuid, 16);
+    put32(cache, 448, 0x300);
+    put32(cache, 452, 1);
+
+    put_bytes(cache, 0x240, subcache_uuid, 16);
+    put64(cache, 0x240 + 16, 0x10000000);
+    put_bytes(cache, 0x240 + 24, ".01", 4);
+
+    put64(cache, 0x300, 0x180001000ULL);
+    put32(cache, 0x300 + 24, 0x380);
+    put_bytes(cache, 0x380, "/usr/lib/libtest.dylib", 23);
+
+    struct segment_command_64 text = { LC_SEGMENT_64, sizeof(text), SEG_TEXT, 0x180001000ULL, 0x1000, 0x1000, 0x1000, 0, 0, 0, 0 };
+    struct uuid_command uuid_cmd = { LC_UUID, sizeof(uuid_cmd), { 0 } };
+    struct symtab_command symtab = { LC_SYMTAB, sizeof(symtab), 0x1000, 2, 0x1100, 32 };
+    struct segment_command_64 linkedit = { LC_SEGMENT_64, sizeof(linkedit), SEG_LINKEDIT, 0x190000000ULL, 0x1000, 0x1000, 0x1000, 0, 0, 0, 0 };
+    memcpy(uuid_cmd.uuid, image_uuid, sizeof(uuid_cmd.uuid));
+
+    size_t offset = 0x1000 + sizeof(struct mach_header_64);
+    put_bytes(cache, offset, &text, sizeof(text)); offset += sizeof(text);
+    put_bytes(cache, offset, &uuid_cmd, sizeof(uuid_cmd)); offset += sizeof(uuid_cmd);
+    put_bytes(cache, offset, &symtab, sizeof(symtab)); offset += sizeof(symtab);
+    put_bytes(cache, offset, &linkedit, sizeof(linkedit)); offset += sizeof(linkedit);
+
+    struct mach_header_64 mh = { MH_MAGIC_64, 0, 0, MH_DYLIB, 4, (uint32_t) (offset - 0x1000 - sizeof(mh)), 0, 0 };
+    put_bytes(cache, 0x1000, &mh, sizeof(mh));
+
+    /* The sub-cache's __LINKEDIT contains one defined and one undefined symbol */
+    NSMutableData *subcache = [NSMutableData dataWithLength: 0x2000];
+    put_header(subcache, subcache_uuid, 0x190000000ULL, 0x1000, 0x1000);
+
+    struct nlist_64 nlists[] = {
+        { { 1 }, N_SECT|N_EXT, 1, 0, 0x180001100ULL },
+        { { 11 }, N_UNDF|N_EXT, 0, 0, 0 },
+    };
+    put_bytes(subcache, 0x1000, nlists, sizeof(nlists));
+    put_bytes(subcache, 0x1100, "\0_exported\0_undefined\0", 22);
+
+    /* The symbols file contains one local symbol, and one redacted symbol */
+    NSMutableData *symbols = [NSMutableData dataWithLength: 0x1000];
+    put_header(symbols, symbols_uuid, 0, 0, 0);
+    put64(symbols, 72, 0x200);
+    put64(symbols, 80, 0x100);
+
+    struct nlist_64 local_nlists[] = {
+        { { 1 }, N_SECT, 1, 0, 0x180001200ULL },
+        { { 8 }, N_SECT, 1, 0, 0x180001300ULL },
+    };
+    put32(symbols, 0x200 + 0, 24); // nlistOffset
+    put32(symbols, 0x200 + 4, 2); // nlistCount
+    put32(symbols, 0x200 + 8, 72); // stringsOffset
+    put32(symbols, 0x200 + 12, 20); // stringsSize
+    put32(symbols, 0x200 + 16, 56); // entriesOffset
+    put32(symbols, 0x200 + 20, 1); // entriesCount
+    put_bytes(symbols, 0x200 + 24, local_nlists, sizeof(local_nlists));
+    put64(symbols, 0x200 + 56, 0x1000); // dylibOffset
+    put32(symbols, 0x200 + 64, 0); // nlistStartIndex
+    put32(symbols, 0x200 + 68, 2); // nlistCount
+    put_bytes(symbols, 0x200 + 72, "\0_local\0<redacted>\0", 20);
+
+    [cache writeToFile: _path atomically: NO];
+    [subcache writeToFile: [_path stringByAppendingString: @".01"] atomically: NO];
+    [symbols writeToFile: [_path stringByAppendingString: @".symbols"] atomically: NO];
+}
+
+- (void) tearDown {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    [fm removeItemAtPath: _path error: NULL];
+    [fm removeItemAtPath: [_path stringByAppendingString: @".01"] error: NULL];
+    [fm removeItemAtPath: [_path stringByAppendingString: @".symbols"] error: NULL];
+
+    [_path release];
+}
+
+/**
+ * Verify that the images and symbols of a split cache are enumerated, including the local symbols within its
+ * symbols file.
+ */
+- (void) testImagesAndSymbols {
+    plcrash_dyld_shared_cache_t cache;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_dyld_shared_cache_open(&cache, [_path fileSystemRepresentation]), @"Failed to open cache");
+    STAssertEquals(cache.file_count, (size_t) 3, @"Sub-cache and symbols file were not opened");
+
+    struct test_ctx ctx = { &cache, [NSMutableDictionary dictionary], 0 };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_dyld_shared_cache_images(&cache, image_cb, &ctx), @"Failed to enumerate images");
+    plcrash_nasync_dyld_shared_cache_close(&cache);
+
+    NSDictionary *symbols = ctx.symbols;
+    STAssertEquals(ctx.image_count, (NSUInteger) 1, @"Incorrect image count");
+    STAssertEqualObjects([symbols objectForKey: @"__TEXT"], [NSNumber numberWithUnsignedLongLong: 0x180001000ULL], @"Incorrect __TEXT address");
+    STAssertEqualObjects([symbols objectForKey: @"_exported"], [NSNumber numberWithUnsignedLongLong: 0x180001100ULL], @"Exported symbol not found");
+    STAssertEqualObjects([symbols objectForKey: @"_local"], [NSNumber numberWithUnsignedLongLong: 0x180001200ULL], @"Local symbol not found");
+    STAssertNil([symbols objectForKey: @"_undefined"], @"Undefined symbol was reported");
+    STAssertNil([symbols objectForKey: @"<redacted>"], @"Redacted symbol was reported");
+}
+
+/**
+ * Verify that a sub-cache that does not match its cache is rejected.
+ */
+- (void) testSubcacheMismatch {
+    NSString *subcache_path = [_path stringByAppendingString: @".01"];
+    NSMutableData *subcache = [NSMutableData dataWithContentsOfFile: subcache_path];
+    put_bytes(subcache, 88, main_uuid, 16);
+    [subcache writeToFile: subcache_path atomically: NO];
+
+    plcrash_dyld_shared_cache_t cache;
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_dyld_shared_cache_open(&cache, [_path fileSystemRepresentation]), @"Mismatched sub-cache was accepted");
+}
+
+/**
+ * Verify that files that are not dyld shared caches are rejected.
+ */
+- (void) testNotCache {
+    [[NSMutableData dataWithLength: 0x1000] writeToFile: _path atomically: NO];
+
+    plcrash_dyld_shared_cache_t cache;
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_dyld_shared_cache_open(&cache, [_path fileSystemRepresentation]), @"Invalid cache was accepted");
+}
+
+@end
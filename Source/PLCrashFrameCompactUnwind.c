@@ -26,6 +26,8 @@
 
 
 #include "PLCrashFrameCompactUnwind.h"
+#include "PLCrashFrameUnwindPlan.h"
+#include "PLCrashAsyncTrace.h"
 #include "PLCrashAsyncCompactUnwindEncoding.h"
 #include "PLCrashFeatureConfig.h"
 
@@ -33,6 +35,167 @@
 
 #if PLCRASH_FEATURE_UNWIND_DWARF
 
+/**
+ * @internal
+ * Claim states of a plcrash_async_image_t's cached CFE reader.
+ */
+enum {
+    /** The cached reader has not been initialized. */
+    PLFRAME_CFE_READER_EMPTY = 0,
+
+    /** The cached reader is in use (or being initialized), and may not be claimed. */
+    PLFRAME_CFE_READER_BUSY = 1,
+
+    /** The cached reader is initialized and available. */
+    PLFRAME_CFE_READER_READY = 2
+};
+
+/**
+ * @internal
+ *
+ * Claim the CFE reader cached by @a image, initializing it if necessary. If the cached reader is unavailable (eg,
+ * @a unwind_mobj is not the image's cached mapping, or another thread holds the reader), a new reader is initialized
+ * in the caller-supplied @a storage.
+ *
+ * In either case, the reader must be released via plframe_cfe_reader_release().
+ *
+ * @param image The image containing the unwind data.
+ * @param unwind_mobj The image's mapped __unwind_info section.
+ * @param unwind_cached True if @a unwind_mobj is cached by @a image, and will remain valid for the image's lifetime.
+ * @param cputype The image's CPU type.
+ * @param storage Caller-supplied storage to be used if the cached reader is unavailable.
+ * @param reader On success, will be set to the claimed reader.
+ */
+static plcrash_error_t plframe_cfe_reader_acquire (plcrash_async_image_t *image, plcrash_async_mobject_t *unwind_mobj, bool unwind_cached,
+                                                   cpu_type_t cputype, plcrash_async_cfe_reader_t *storage, plcrash_async_cfe_reader_t **reader)
+{
+    plcrash_error_t err;
+
+    *reader = NULL;
+    if (unwind_cached) {
+        if (OSAtomicCompareAndSwap32Barrier(PLFRAME_CFE_READER_READY, PLFRAME_CFE_READER_BUSY, &image->_cfe_reader_state)) {
+            /* Claimed an already initialized reader */
+            *reader = &image->_cfe_reader;
+        } else if (OSAtomicCompareAndSwap32Barrier(PLFRAME_CFE_READER_EMPTY, PLFRAME_CFE_READER_BUSY, &image->_cfe_reader_state)) {
+            /* Claimed an empty reader; initialize it */
+            if ((err = plcrash_async_cfe_reader_init(&image->_cfe_reader, unwind_mobj, cputype)) != PLCRASH_ESUCCESS) {
+                OSMemoryBarrier();
+                image->_cfe_reader_state = PLFRAME_CFE_READER_EMPTY;
+                return err;
+            }
+
+            *reader = &image->_cfe_reader;
+        }
+    }
+
+    /* Fall back on a local reader */
+    if (*reader == NULL) {
+        if ((err = plcrash_async_cfe_reader_init(storage, unwind_mobj, cputype)) != PLCRASH_ESUCCESS)
+            return err;
+
+        *reader = storage;
+    }
+
+    /* Search the image's validated first-level index, if one has been built (including after the cached reader was
+     * initialized) */
+    if ((*reader)->index == NULL && image->macho_image.cfe_index != NULL)
+        plcrash_async_cfe_reader_set_index(*reader, image->macho_image.cfe_index);
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Release a reader claimed via plframe_cfe_reader_acquire().
+ *
+ * @param image The image from which the reader was claimed.
+ * @param storage The caller-supplied storage that was provided to plframe_cfe_reader_acquire().
+ * @param reader The reader returned by plframe_cfe_reader_acquire().
+ */
+static void plframe_cfe_reader_release (plcrash_async_image_t *image, plcrash_async_cfe_reader_t *storage, plcrash_async_cfe_reader_t *reader) {
+    if (reader == storage) {
+        plcrash_async_cfe_reader_free(storage);
+        return;
+    }
+
+    OSMemoryBarrier();
+    image->_cfe_reader_state = PLFRAME_CFE_READER_READY;
+}
+
+/**
+ * @internal
+ *
+ * Derive the unwind plan corresponding to @a entry. The plan is equivalent to plcrash_async_cfe_entry_apply(); any
+ * indirect stack size is resolved once, allowing the plan to be applied without further reference to @a entry.
+ *
+ * @param task The task containing the function.
+ * @param entry The decoded CFE entry.
+ * @param function_address The in-core address of the function described by @a entry.
+ * @param thread_state The thread state to which @a entry was applied.
+ * @param plan On success, the initialized plan.
+ *
+ * @return Returns true on success, or false if @a entry can not be represented as an unwind plan.
+ */
+static bool plframe_cfe_unwind_plan (task_t task, plcrash_async_cfe_entry_t *entry, pl_vm_address_t function_address,
+                                     const plcrash_async_thread_state_t *thread_state, plframe_unwind_plan_t *plan)
+{
+    int64_t greg_size = plcrash_async_thread_state_get_greg_size(thread_state);
+    uint32_t register_count = plcrash_async_cfe_entry_register_count(entry);
+    int64_t saved_reg_offset;
+
+    switch (plcrash_async_cfe_entry_type(entry)) {
+        case PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAME_PTR:
+            /* CFA = FP + saved FP + return address */
+            plframe_unwind_plan_init(plan, greg_size, PLCRASH_REG_FP, greg_size * 2);
+            plframe_unwind_plan_add_register(plan, PLCRASH_REG_FP, PLFRAME_UNWIND_PLAN_RULE_SAVED, -greg_size * 2);
+            plframe_unwind_plan_add_register(plan, PLCRASH_REG_IP, PLFRAME_UNWIND_PLAN_RULE_SAVED, -greg_size);
+            saved_reg_offset = -greg_size * 2 + plcrash_async_cfe_entry_stack_offset(entry);
+            break;
+
+        case PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAMELESS_IMMD:
+        case PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAMELESS_INDIRECT: {
+            int64_t stack_size = plcrash_async_cfe_entry_stack_offset(entry);
+            if (plcrash_async_cfe_entry_type(entry) == PLCRASH_ASYNC_CFE_ENTRY_TYPE_FRAMELESS_INDIRECT) {
+                uint32_t indirect;
+                if (plcrash_async_task_memcpy(task, function_address, (pl_vm_off_t) stack_size, &indirect, sizeof(indirect)) != PLCRASH_ESUCCESS)
+                    return false;
+
+                stack_size = (int64_t) indirect + plcrash_async_cfe_entry_stack_adjustment(entry);
+            }
+
+            plframe_unwind_plan_init(plan, greg_size, PLCRASH_REG_SP, stack_size);
+
+            /* ARM64 frameless functions leave the return address in the link register */
+            if (entry->cpu_type == CPU_TYPE_ARM64) {
+                plframe_unwind_plan_add_register(plan, PLCRASH_REG_IP, PLFRAME_UNWIND_PLAN_RULE_REGISTER, PLCRASH_ARM64_LR);
+                saved_reg_offset = -greg_size * register_count;
+                break;
+            }
+
+            plframe_unwind_plan_add_register(plan, PLCRASH_REG_IP, PLFRAME_UNWIND_PLAN_RULE_SAVED, -greg_size);
+            saved_reg_offset = -greg_size - greg_size * register_count;
+            break;
+        }
+
+        default:
+            return false;
+    }
+
+    /* Saved registers; the register list may be sparse */
+    plcrash_regnum_t register_list[PLCRASH_ASYNC_CFE_REGISTER_LIST_MAX];
+    plcrash_async_cfe_entry_register_list(entry, register_list);
+    for (uint32_t i = 0; i < register_count; i++) {
+        if (register_list[i] == PLCRASH_REG_INVALID)
+            continue;
+
+        if (!plframe_unwind_plan_add_register(plan, register_list[i], PLFRAME_UNWIND_PLAN_RULE_SAVED, saved_reg_offset + greg_size * i))
+            return false;
+    }
+
+    return true;
+}
+
 /**
  * Attempt to fetch next frame using compact frame unwinding data from @a image_list.
  *
@@ -40,6 +203,7 @@
  * @param image_list The list of images loaded in the target @a task.
  * @param current_frame The current stack frame.
  * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param stack_cache A read cache to be used when reading from @a task, or NULL to perform uncached reads.
  * @param next_frame The new frame to be initialized.
  *
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
@@ -48,11 +212,16 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
                                                     plcrash_async_image_list_t *image_list,
                                                     const plframe_stackframe_t *current_frame,
                                                     const plframe_stackframe_t *previous_frame,
+                                                    plcrash_async_task_read_cache_t *stack_cache,
                                                     plframe_stackframe_t *next_frame)
 {
     plframe_error_t result;
     plcrash_error_t err;
 
+    /* Mapped unwind section. This is cached by the image; the local storage is only used if the cache is unavailable. */
+    plcrash_async_mobject_t unwind_storage;
+    plcrash_async_mobject_t *unwind_mobj = NULL;
+
     /* Fetch the IP. It should always be available */
     if (!plcrash_async_thread_state_has_reg(&current_frame->thread_state, PLCRASH_REG_IP)) {
         PLCF_DEBUG("Frame is missing a valid IP register, skipping compact unwind encoding");
@@ -64,48 +233,51 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
     plcrash_async_image_list_set_reading(image_list, true);
     plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, pc);
     if (image == NULL) {
-        PLCF_DEBUG("Could not find a loaded image for the current frame pc: 0x%" PRIx64, (uint64_t) pc);
+        PLCF_TRACE(PLCRASH_TRACE_CFE_NO_IMAGE, pc);
         result = PLFRAME_ENOTSUP;
         goto cleanup;
     }
     
     /* Map the unwind section */
-    plcrash_async_mobject_t unwind_mobj;
-    err = plcrash_async_macho_map_section(&image->macho_image, SEG_TEXT, "__unwind_info", &unwind_mobj);
+    err = plcrash_async_macho_map_known_section_cached(&image->macho_image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_UNWIND_INFO, &unwind_storage, &unwind_mobj);
     if (err != PLCRASH_ESUCCESS) {
+        unwind_mobj = NULL;
         if (err != PLCRASH_ENOTFOUND)
-            PLCF_DEBUG("Could not map the compact unwind info section for image %s: %d", image->macho_image.name, err);
+            PLCF_TRACE(PLCRASH_TRACE_CFE_MAP_FAILED, image->macho_image.header_addr, err);
         result = PLFRAME_ENOTSUP;
         goto cleanup;
     }
 
-    /* Initialize the CFE reader. */
+    /* Fetch the CFE reader; the image's reader (and its memoized page lookup) is used if available. */
     cpu_type_t cputype = image->macho_image.byteorder->swap32(image->macho_image.header.cputype);
-    plcrash_async_cfe_reader_t reader;
+    plcrash_async_cfe_reader_t reader_storage;
+    plcrash_async_cfe_reader_t *reader;
 
-    err = plcrash_async_cfe_reader_init(&reader, &unwind_mobj, cputype);
+    err = plframe_cfe_reader_acquire(image, unwind_mobj, unwind_mobj != &unwind_storage, cputype, &reader_storage, &reader);
     if (err != PLCRASH_ESUCCESS) {
-        PLCF_DEBUG("Could not parse the compact unwind info section for image '%s': %d", image->macho_image.name, err);
+        PLCF_TRACE(PLCRASH_TRACE_CFE_PARSE_FAILED, image->macho_image.header_addr, err);
         result = PLFRAME_EINVAL;
         goto cleanup;
     }
 
-    /* Find the encoding entry (if any) and free the reader */
+    /* Find the encoding entry (if any) */
     pl_vm_address_t function_base;
+    pl_vm_address_t function_end;
     uint32_t encoding;
-    err = plcrash_async_cfe_reader_find_pc(&reader, pc - image->macho_image.header_addr, &function_base, &encoding);
-    plcrash_async_cfe_reader_free(&reader);
+    err = plcrash_async_cfe_reader_find_pc_range(reader, pc - image->macho_image.header_addr, &function_base, &function_end, &encoding);
     if (err != PLCRASH_ESUCCESS) {
-        PLCF_DEBUG("Did not find CFE entry for PC 0x%" PRIx64 ": %d", (uint64_t) pc, err);
+        plframe_cfe_reader_release(image, &reader_storage, reader);
+        PLCF_TRACE(PLCRASH_TRACE_CFE_NOT_FOUND, pc, err);
         result = PLFRAME_ENOTSUP;
         goto cleanup;
     }
     
-    /* Decode the entry */
+    /* Decode the entry via the reader's entry cache, and release the reader */
     plcrash_async_cfe_entry_t entry;
-    err = plcrash_async_cfe_entry_init(&entry, cputype, encoding);
+    err = plcrash_async_cfe_reader_entry_init(reader, encoding, &entry);
+    plframe_cfe_reader_release(image, &reader_storage, reader);
     if (err != PLCRASH_ESUCCESS) {
-        PLCF_DEBUG("Could not decode CFE encoding 0x%" PRIx32 " for PC 0x%" PRIx64 ": %d", encoding, (uint64_t) pc, err);
+        PLCF_TRACE(PLCRASH_TRACE_CFE_DECODE_FAILED, pc, encoding, err);
         result = PLFRAME_ENOTSUP;
         goto cleanup;
     }
@@ -130,16 +302,29 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
     }
 
     /* Apply the frame delta -- this may fail. */
-    if ((err = plcrash_async_cfe_entry_apply(task, function_address, &current_frame->thread_state, &entry, &next_frame->thread_state)) == PLCRASH_ESUCCESS) {
+    if ((err = plcrash_async_cfe_entry_apply(task, stack_cache, function_address, &current_frame->thread_state, &entry, &next_frame->thread_state)) == PLCRASH_ESUCCESS) {
         result = PLFRAME_ESUCCESS;
+
+        /* Save the equivalent unwind plan for use by any later frames within the same function. If the function's
+         * end is unknown, the plan is only cached for the current PC. */
+        plframe_unwind_plan_t plan;
+        pl_vm_address_t plan_end = pc + 1;
+        if (function_end > function_base)
+            plan_end = image->macho_image.header_addr + function_end;
+
+        if (plan_end > pc && plframe_cfe_unwind_plan(task, &entry, function_address, &current_frame->thread_state, &plan))
+            plframe_unwind_plan_cache_insert(&image->macho_image, function_address, plan_end, &plan);
     } else {
-        PLCF_DEBUG("Failed to apply CFE encoding 0x%" PRIx32 " for PC 0x%" PRIx64 ": %d", encoding, (uint64_t) pc, err);
+        PLCF_TRACE(PLCRASH_TRACE_CFE_APPLY_FAILED, pc, encoding, err);
         result = PLFRAME_ENOFRAME;
     }
 
     plcrash_async_cfe_entry_free(&entry);
 
 cleanup:
+    if (unwind_mobj != NULL)
+        plcrash_async_macho_mapped_section_release(&unwind_storage, unwind_mobj);
+
     plcrash_async_image_list_set_reading(image_list, false);
     return result;
 }
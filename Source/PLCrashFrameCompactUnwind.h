@@ -41,6 +41,7 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
                                                     plcrash_async_image_list_t *image_list,
                                                     const plframe_stackframe_t *current_frame,
                                                     const plframe_stackframe_t *previous_frame,
+                                                    plcrash_async_task_read_cache_t *stack_cache,
                                                     plframe_stackframe_t *next_frame);
     
 #ifdef __cplusplus
@@ -26,11 +26,14 @@
 
 
 #include "PLCrashFrameDWARFUnwind.h"
+#include "PLCrashFrameUnwindPlan.h"
+#include "PLCrashAsyncTrace.h"
 
 #include "PLCrashAsyncMachOImage.h"
 
 #include "PLCrashAsyncDwarfEncoding.hpp"
 #include "PLCrashAsyncDwarfCFAState.hpp"
+#include "PLCrashFrameDWARFUnwindCache.hpp"
 
 #include "PLCrashFeatureConfig.h"
 
@@ -42,6 +45,123 @@
 
 using namespace plcrash::async;
 
+/** 32-bit CFA cache */
+static dwarf_cfa_cache<uint32_t, int32_t> dwarf_cfa_cache_32;
+
+/** 64-bit CFA cache */
+static dwarf_cfa_cache<uint64_t, int64_t> dwarf_cfa_cache_64;
+
+/** 32-bit CIE cache */
+static dwarf_cie_cache<uint32_t, int32_t> dwarf_cie_cache_32;
+
+/** 64-bit CIE cache */
+static dwarf_cie_cache<uint64_t, int64_t> dwarf_cie_cache_64;
+
+/**
+ * @internal
+ *
+ * Derive the unwind plan corresponding to @a cfa_state. The plan is equivalent to dwarf_cfa_state::apply_state().
+ *
+ * @param cfa_state The evaluated CFA state.
+ * @param cie_info The CIE data associated with @a cfa_state.
+ * @param thread_state The thread state to which @a cfa_state will be applied.
+ * @param plan On success, the initialized plan.
+ *
+ * @tparam machine_ptr The native machine pointer type for the target data.
+ * @tparam machine_ptr_s The native machine signed pointer type for the target data.
+ *
+ * @return Returns true on success, or false if @a cfa_state can not be represented as an unwind plan; this is the
+ * case for CFA and register rules defined by DWARF expressions.
+ */
+template<typename machine_ptr, typename machine_ptr_s>
+static bool plframe_dwarf_unwind_plan (dwarf_cfa_state<machine_ptr, machine_ptr_s> *cfa_state,
+                                       plcrash_async_dwarf_cie_info_t *cie_info,
+                                       const plcrash_async_thread_state_t *thread_state,
+                                       plframe_unwind_plan_t *plan)
+{
+    /* Map the CFA rule */
+    dwarf_cfa_rule<machine_ptr, machine_ptr_s> cfa_rule = cfa_state->get_cfa_rule();
+    plcrash_regnum_t cfa_regnum;
+    int64_t cfa_offset;
+
+    switch (cfa_rule.type()) {
+        case DWARF_CFA_STATE_CFA_TYPE_REGISTER:
+            cfa_offset = (machine_ptr_s) cfa_rule.register_offset();
+            break;
+
+        case DWARF_CFA_STATE_CFA_TYPE_REGISTER_SIGNED:
+            cfa_offset = cfa_rule.register_offset_signed();
+            break;
+
+        default:
+            return false;
+    }
+
+    if (!plcrash_async_thread_state_map_dwarf_to_reg(thread_state, cfa_rule.register_number(), &cfa_regnum))
+        return false;
+
+    plframe_unwind_plan_init(plan, plcrash_async_thread_state_get_greg_size(thread_state), cfa_regnum, cfa_offset);
+
+    /* Map the register rules */
+    dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s> iter = dwarf_cfa_state_iterator<machine_ptr, machine_ptr_s>(cfa_state);
+    dwarf_cfa_state_regnum_t dw_regnum;
+    plcrash_dwarf_cfa_reg_rule_t dw_rule;
+    machine_ptr dw_value;
+
+    while (iter.next(&dw_regnum, &dw_rule, &dw_value)) {
+        /* A return address pseudo-register targets the IP directly */
+        plcrash_regnum_t pl_regnum;
+        if (!plcrash_async_thread_state_map_dwarf_to_reg(thread_state, dw_regnum, &pl_regnum)) {
+            if (cie_info->return_address_register != dw_regnum)
+                return false;
+            pl_regnum = PLCRASH_REG_IP;
+        }
+
+        plframe_unwind_plan_rule_t rule;
+        int64_t value;
+        switch (dw_rule) {
+            case PLCRASH_DWARF_CFA_REG_RULE_OFFSET:
+                rule = PLFRAME_UNWIND_PLAN_RULE_SAVED;
+                value = (machine_ptr_s) dw_value;
+                break;
+
+            case PLCRASH_DWARF_CFA_REG_RULE_VAL_OFFSET:
+                rule = PLFRAME_UNWIND_PLAN_RULE_VAL_OFFSET;
+                value = (machine_ptr_s) dw_value;
+                break;
+
+            case PLCRASH_DWARF_CFA_REG_RULE_REGISTER: {
+                plcrash_regnum_t src_regnum;
+                if (!plcrash_async_thread_state_map_dwarf_to_reg(thread_state, dw_value, &src_regnum))
+                    return false;
+                rule = PLFRAME_UNWIND_PLAN_RULE_REGISTER;
+                value = src_regnum;
+                break;
+            }
+
+            case PLCRASH_DWARF_CFA_REG_RULE_SAME_VALUE:
+                rule = PLFRAME_UNWIND_PLAN_RULE_REGISTER;
+                value = pl_regnum;
+                break;
+
+            default:
+                return false;
+        }
+
+        if (!plframe_unwind_plan_add_register(plan, pl_regnum, rule, value))
+            return false;
+
+        /* If the target register is defined as the return address (and is not already the IP), the IP is restored
+         * using the same rule. */
+        if (cie_info->return_address_register == dw_regnum && pl_regnum != PLCRASH_REG_IP) {
+            if (!plframe_unwind_plan_add_register(plan, PLCRASH_REG_IP, rule, value))
+                return false;
+        }
+    }
+
+    return true;
+}
+
 /**
  * @internal
  *
@@ -52,7 +172,10 @@ using namespace plcrash::async;
  * @param image The Mach-O image for the current stack frame.
  * @param current_frame The current stack frame.
  * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param stack_cache A read cache to be used when reading from @a task, or NULL to perform uncached reads.
  * @param next_frame The new frame to be initialized.
+ * @param cache The CFA cache to be used for lookups of previously evaluated PC values.
+ * @param cie_cache The CIE cache to be used for lookups of previously parsed CIEs.
  *
  * @tparam machine_ptr The native machine pointer type for the target data.
  * @tparam machine_ptr_s The native machine signed pointer type for the target data.
@@ -65,15 +188,24 @@ static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
                                                              plcrash_async_macho_t *image,
                                                              const plframe_stackframe_t *current_frame,
                                                              const plframe_stackframe_t *previous_frame,
-                                                             plframe_stackframe_t *next_frame)
+                                                             plcrash_async_task_read_cache_t *stack_cache,
+                                                             plframe_stackframe_t *next_frame,
+                                                             dwarf_cfa_cache<machine_ptr, machine_ptr_s> *cache,
+                                                             dwarf_cie_cache<machine_ptr, machine_ptr_s> *cie_cache)
 {
     gnu_ehptr_reader<machine_ptr> ptr_state(image->byteorder);
 
-    /* Mapped DWARF sections; only one of eh_frame/debug_frame will be mapped */
+    /* Mapped DWARF sections; only one of eh_frame/debug_frame will be mapped. The sections are
+     * cached by the image; the local storage is only used if the image cache is unavailable. */
     plcrash_async_mobject_t eh_frame;
     plcrash_async_mobject_t debug_frame;
+    plcrash_async_mobject_t *dwarf_storage = NULL;
     plcrash_async_mobject_t *dwarf_section = NULL;
     bool is_debug_frame = false;
+
+    /* Mapped eh_frame_hdr search table, if any */
+    plcrash_async_mobject_t eh_frame_hdr_storage;
+    plcrash_async_mobject_t *eh_frame_hdr = NULL;
     
     /* Reader state */
     dwarf_frame_reader reader;
@@ -82,29 +214,44 @@ static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
     bool did_init_fde = false;
     
     plcrash_async_dwarf_cie_info_t cie_info;
+    pl_vm_address_t cie_address;
     bool did_init_cie = false;
     
     /* CFA evaluation stack */
     plcrash::async::dwarf_cfa_state<machine_ptr, machine_ptr_s> cfa_state;
+
+    /* The CFA table row containing pc, as determined by FDE evaluation */
+    machine_ptr row_start;
+    machine_ptr row_end;
     
     plframe_error_t result;
     plcrash_error_t err;
+
+    /* Use the cached CFA state, if available */
+    if (cache->lookup(image, pc, &cie_info, &cfa_state)) {
+        did_init_cie = true;
+        goto apply;
+    }
         
     /*
      * Map the eh_frame or debug_frame DWARF sections. Apple doesn't seem to use debug_frame at all;
      * as such, we prefer eh_frame, but allow falling back on debug_frame.
      */
     {
-        err = plcrash_async_macho_map_section(image, "__TEXT", "__eh_frame", &eh_frame);
+        err = plcrash_async_macho_map_known_section_cached(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_EH_FRAME, &eh_frame, &dwarf_section);
         if (err == PLCRASH_ESUCCESS) {
-            dwarf_section = &eh_frame;
+            dwarf_storage = &eh_frame;
+        } else {
+            dwarf_section = NULL;
         }
         
         if (dwarf_section == NULL) {
-            err = plcrash_async_macho_map_section(image, "__DWARF", "__debug_frame", &debug_frame);
+            err = plcrash_async_macho_map_known_section_cached(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_DEBUG_FRAME, &debug_frame, &dwarf_section);
             if (err == PLCRASH_ESUCCESS) {
-                dwarf_section = &debug_frame;
+                dwarf_storage = &debug_frame;
                 is_debug_frame = true;
+            } else {
+                dwarf_section = NULL;
             }
         }
         
@@ -118,10 +265,20 @@ static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
     
     /* Initialize the reader. */
     if ((err = reader.init(dwarf_section, image->byteorder, image->m64, is_debug_frame)) != PLCRASH_ESUCCESS) {
-        PLCF_DEBUG("Could not initialize a %s DWARF parser for the current frame pc: 0x%" PRIx64 " %d", (is_debug_frame ? "debug_frame" : "eh_frame"), (uint64_t) pc, err);
+        PLCF_TRACE(PLCRASH_TRACE_DWARF_PARSER_FAILED, pc, is_debug_frame, err);
         result = PLFRAME_EINVAL;
         goto cleanup;
     }
+
+    /* Use the prebuilt FDE index or the eh_frame_hdr binary search table, if available. These are optional; if
+     * unavailable, the reader will perform a linear search of the eh_frame data. */
+    if (!is_debug_frame && image->fde_index != NULL) {
+        if ((err = reader.set_fde_index(image->fde_index, image->header_addr)) != PLCRASH_ESUCCESS)
+            PLCF_DEBUG("Could not use the FDE index for pc 0x%" PRIx64 ": %d", (uint64_t) pc, err);
+    } else if (!is_debug_frame && plcrash_async_macho_map_known_section_cached(image, PLCRASH_ASYNC_MACHO_KNOWN_SECT_EH_FRAME_HDR, &eh_frame_hdr_storage, &eh_frame_hdr) == PLCRASH_ESUCCESS) {
+        if ((err = reader.set_search_table(eh_frame_hdr)) != PLCRASH_ESUCCESS)
+            PLCF_DEBUG("Could not use the eh_frame_hdr search table for pc 0x%" PRIx64 ": %d", (uint64_t) pc, err);
+    }
     
     /* Find the FDE (if any) */
     {
@@ -138,48 +295,73 @@ static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
     {
         // TODO - configure the pointer state */
     }
-    
-    /* Parse CIE info */
-    {
-        err = plcrash_async_dwarf_cie_info_init(&cie_info, dwarf_section, image->byteorder, &ptr_state, plcrash_async_mobject_base_address(dwarf_section) + fde_info.cie_offset);
+
+    /* Assert that pc_start won't overflow machine_ptr. This could only occur if we were to use a 64-bit FDE parser with 32-bit CFA evaluation
+     * TODO: The FDE pc_start value should probably by typed for the target architecture. */
+    PLCF_ASSERT(fde_info.pc_start < std::numeric_limits<machine_ptr>::max());
+
+    /* Fetch the parsed CIE and initial CFA state from the cache, if available; otherwise, parse the CIE and evaluate the
+     * initial instructions. */
+    cie_address = plcrash_async_mobject_base_address(dwarf_section) + fde_info.cie_offset;
+    if (cie_cache->lookup(image, cie_address, &cie_info, &cfa_state)) {
+        did_init_cie = true;
+    } else {
+        err = plcrash_async_dwarf_cie_info_init(&cie_info, dwarf_section, image->byteorder, &ptr_state, cie_address);
         if (err != PLCRASH_ESUCCESS) {
-            PLCF_DEBUG("Failed to parse CIE at offset of 0x%" PRIx64 ": %d", (uint64_t) fde_info.cie_offset, err);
+            PLCF_TRACE(PLCRASH_TRACE_DWARF_CIE_FAILED, fde_info.cie_offset, err);
             result = PLFRAME_ENOTSUP;
-            
-            plcrash_async_dwarf_fde_info_free(&fde_info);
             goto cleanup;
         }
         did_init_cie = true;
-    }
-    
-    /* Evaluate the CFA instruction opcodes */
-    {
-        /* Assert that pc_start won't overflow machine_ptr. This could only occur if we were to use a 64-bit FDE parser with 32-bit CFA evaluation
-         * TODO: The FDE pc_start value should probably by typed for the target architecture. */
-        PLCF_ASSERT(fde_info.pc_start < std::numeric_limits<machine_ptr>::max());
 
         /* Initial instructions */
-        err = cfa_state.eval_program(dwarf_section, pc, fde_info.pc_start, &cie_info, &ptr_state, image->byteorder, plcrash_async_mobject_base_address(dwarf_section), cie_info.initial_instructions_offset, cie_info.initial_instructions_length);
+        bool location_dependent;
+        err = cfa_state.eval_program(dwarf_section, pc, fde_info.pc_start, &cie_info, &ptr_state, image->byteorder, plcrash_async_mobject_base_address(dwarf_section), cie_info.initial_instructions_offset, cie_info.initial_instructions_length, &location_dependent);
         if (err != PLCRASH_ESUCCESS) {
-            PLCF_DEBUG("Failed to evaluate CFA at offset of 0x%" PRIx64 ": %d", (uint64_t) fde_info.instructions_offset, err);
+            PLCF_TRACE(PLCRASH_TRACE_DWARF_EVAL_FAILED, cie_info.initial_instructions_offset, err);
             result = PLFRAME_ENOTSUP;
             goto cleanup;
         }
+
+        if (!location_dependent)
+            cie_cache->insert(image, cie_address, &cie_info, &cfa_state);
+    }
+
+    /* Evaluate the CFA instruction opcodes */
+    {
         
         /*  FDE instructions */
-        err = cfa_state.eval_program(dwarf_section, pc, fde_info.pc_start, &cie_info, &ptr_state, image->byteorder, plcrash_async_mobject_base_address(dwarf_section), fde_info.instructions_offset, fde_info.instructions_length);
+        err = cfa_state.eval_program(dwarf_section, pc, fde_info.pc_start, &cie_info, &ptr_state, image->byteorder, plcrash_async_mobject_base_address(dwarf_section), fde_info.instructions_offset, fde_info.instructions_length, NULL, &row_start, &row_end);
         if (err != PLCRASH_ESUCCESS) {
-            PLCF_DEBUG("Failed to evaluate CFA at offset of 0x%" PRIx64 ": %d", (uint64_t) fde_info.instructions_offset, err);
+            PLCF_TRACE(PLCRASH_TRACE_DWARF_EVAL_FAILED, fde_info.instructions_offset, err);
             result = PLFRAME_ENOTSUP;
             goto cleanup;
         }
     }
     
+    /* Save the evaluated state for use by any later frames within the same row. A row that extends to the end of the
+     * program ends with the FDE's address range. */
+    if (row_end == 0 || row_end > fde_info.pc_end)
+        row_end = (machine_ptr) fde_info.pc_end;
+    if (row_start < fde_info.pc_start || row_start > pc || row_end <= pc) {
+        row_start = pc;
+        row_end = pc + 1;
+    }
+    cache->insert(image, row_start, row_end, &cie_info, &cfa_state);
+
+    /* Save the equivalent unwind plan, if the row can be represented without DWARF expressions */
+    {
+        plframe_unwind_plan_t plan;
+        if (plframe_dwarf_unwind_plan(&cfa_state, &cie_info, &current_frame->thread_state, &plan))
+            plframe_unwind_plan_cache_insert(image, row_start, row_end, &plan);
+    }
+
+apply:
     /* Apply the frame delta -- this may fail. */
-    if ((err = cfa_state.apply_state(task, &cie_info, &current_frame->thread_state, image->byteorder, &next_frame->thread_state)) == PLCRASH_ESUCCESS) {
+    if ((err = cfa_state.apply_state(task, &cie_info, &current_frame->thread_state, image->byteorder, &next_frame->thread_state, stack_cache)) == PLCRASH_ESUCCESS) {
         result = PLFRAME_ESUCCESS;
     } else {
-        PLCF_DEBUG("Failed to apply CFA state for PC 0x%" PRIx64 ": %d", (uint64_t) pc, err);
+        PLCF_TRACE(PLCRASH_TRACE_DWARF_APPLY_FAILED, pc, err);
         result = PLFRAME_ENOFRAME;
     }
     
@@ -187,7 +369,10 @@ static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
     
 cleanup:
     if (dwarf_section != NULL)
-        plcrash_async_mobject_free(dwarf_section);
+        plcrash_async_macho_mapped_section_release(dwarf_storage, dwarf_section);
+
+    if (eh_frame_hdr != NULL)
+        plcrash_async_macho_mapped_section_release(&eh_frame_hdr_storage, eh_frame_hdr);
     
     if (did_init_cie)
         plcrash_async_dwarf_cie_info_free(&cie_info);
@@ -205,6 +390,7 @@ cleanup:
  * @param image_list The list of images loaded in the target @a task.
  * @param current_frame The current stack frame.
  * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param stack_cache A read cache to be used when reading from @a task, or NULL to perform uncached reads.
  * @param next_frame The new frame to be initialized.
  *
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
@@ -213,6 +399,7 @@ plframe_error_t plframe_cursor_read_dwarf_unwind (task_t task,
                                                   plcrash_async_image_list_t *image_list,
                                                   const plframe_stackframe_t *current_frame,
                                                   const plframe_stackframe_t *previous_frame,
+                                                  plcrash_async_task_read_cache_t *stack_cache,
                                                   plframe_stackframe_t *next_frame)
 {
     plframe_error_t ferr;
@@ -233,7 +420,7 @@ plframe_error_t plframe_cursor_read_dwarf_unwind (task_t task,
     /* Find the corresponding image */
     plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, pc);
     if (image == NULL) {
-        PLCF_DEBUG("Could not find a loaded image for the current frame pc: 0x%" PRIx64, (uint64_t) pc);
+        PLCF_TRACE(PLCRASH_TRACE_DWARF_NO_IMAGE, pc);
         plcrash_async_image_list_set_reading(image_list, false);
         return PLFRAME_ENOTSUP;
     }
@@ -243,12 +430,12 @@ plframe_error_t plframe_cursor_read_dwarf_unwind (task_t task,
         /* Could only happen due to programmer error; eg, an image that doesn't actually match our thread state */
         PLCF_ASSERT(pc <= UINT64_MAX);
 
-        ferr = plframe_cursor_read_dwarf_unwind_int<uint64_t, int64_t>(task, pc, &image->macho_image, current_frame, previous_frame, next_frame);
+        ferr = plframe_cursor_read_dwarf_unwind_int<uint64_t, int64_t>(task, pc, &image->macho_image, current_frame, previous_frame, stack_cache, next_frame, &dwarf_cfa_cache_64, &dwarf_cie_cache_64);
     } else {
         /* Could only happen due to programmer error; eg, an image that doesn't actually match our thread state */
         PLCF_ASSERT(pc <= UINT32_MAX);
 
-        ferr = plframe_cursor_read_dwarf_unwind_int<uint32_t, int32_t>(task, pc, &image->macho_image, current_frame, previous_frame, next_frame);
+        ferr = plframe_cursor_read_dwarf_unwind_int<uint32_t, int32_t>(task, pc, &image->macho_image, current_frame, previous_frame, stack_cache, next_frame, &dwarf_cfa_cache_32, &dwarf_cie_cache_32);
     }
     
     plcrash_async_image_list_set_reading(image_list, false);
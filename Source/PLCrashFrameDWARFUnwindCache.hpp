@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+#ifndef PLCRASH_FRAME_DWARF_UNWIND_CACHE_H
+#define PLCRASH_FRAME_DWARF_UNWIND_CACHE_H 1
+
+#include <libkern/OSAtomic.h>
+
+#include "PLCrashAsyncMachOImage.h"
+#include "PLCrashAsyncDwarfCIE.hpp"
+#include "PLCrashAsyncDwarfCFAState.hpp"
+
+#include "PLCrashFeatureConfig.h"
+
+#if PLCRASH_FEATURE_UNWIND_DWARF
+
+namespace plcrash { namespace async {
+
+/**
+ * @internal
+ *
+ * The identity of a binary image, as recorded by the DWARF unwind caches.
+ */
+struct dwarf_unwind_cache_image_key {
+    /** The Mach task in which the image is loaded. */
+    mach_port_t task;
+
+    /** The image's header address. */
+    pl_vm_address_t header_addr;
+
+    /** The size of the image's __TEXT segment. */
+    pl_vm_size_t text_size;
+
+    /** The image's LC_UUID value. */
+    uint8_t uuid[16];
+
+    /**
+     * Record the identity of @a image, which must have an LC_UUID.
+     *
+     * @param image The image to be recorded.
+     */
+    void init (plcrash_async_macho_t *image) {
+        PLCF_ASSERT(image->has_uuid);
+
+        task = image->task;
+        header_addr = image->header_addr;
+        text_size = image->text_size;
+        plcrash_async_memcpy(uuid, image->uuid, sizeof(uuid));
+    }
+
+    /**
+     * Return true if @a image matches the recorded identity.
+     *
+     * @param image The image to be compared.
+     */
+    bool matches (plcrash_async_macho_t *image) const {
+        if (!image->has_uuid || task != image->task || header_addr != image->header_addr || text_size != image->text_size)
+            return false;
+
+        for (size_t i = 0; i < sizeof(uuid); i++) {
+            if (uuid[i] != image->uuid[i])
+                return false;
+        }
+
+        return true;
+    }
+};
+
+/** The number of entries in each DWARF CFA cache. */
+#define DWARF_CFA_CACHE_SIZE 16
+
+/**
+ * @internal
+ *
+ * An async-safe cache of evaluated CFA state, keyed by CFA table row.
+ *
+ * When many threads are parked in the same system functions, the same PC values are unwound repeatedly; caching the
+ * evaluated CFA state allows us to skip mapping the DWARF sections, locating the FDE, parsing the CIE, and evaluating
+ * the CFA programs for any previously seen PC. The evaluated rules are identical for every instruction within a
+ * CFA table row, and each entry records its row's address range; a function body is typically covered by a single
+ * row, allowing distinct PCs within the same function to share an entry.
+ *
+ * Entries are keyed by the target task and by the identity of the image containing the row: its header address, text
+ * size, and LC_UUID. An image that is unloaded and replaced by a different image at the same address thus never
+ * matches a stale entry. Images without an LC_UUID can not be reliably distinguished, and are not cached.
+ *
+ * Instances are statically allocated, and thus require no allocation at crash time. Each entry is guarded
+ * by a spinlock that is only ever acquired via OSSpinLockTry(); if an entry is in use by another reader,
+ * the entry is simply skipped.
+ *
+ * @tparam machine_ptr The native machine pointer type for the target data.
+ * @tparam machine_ptr_s The native machine signed pointer type for the target data.
+ */
+template<typename machine_ptr, typename machine_ptr_s>
+class dwarf_cfa_cache {
+public:
+    /**
+     * Look up the cached CFA state for @a pc within @a image.
+     *
+     * @param image The image containing @a pc.
+     * @param pc The PC value.
+     * @param[out] cie_info On success, the CIE data associated with @a cfa_state.
+     * @param[out] cfa_state On success, the evaluated CFA state.
+     *
+     * @return Returns true if a matching entry was found, false otherwise.
+     */
+    bool lookup (plcrash_async_macho_t *image, machine_ptr pc, plcrash_async_dwarf_cie_info_t *cie_info, dwarf_cfa_state<machine_ptr, machine_ptr_s> *cfa_state) {
+        if (!image->has_uuid)
+            return false;
+
+        /* Rows are keyed by their start address, which is unknown until the CFA program has been evaluated; all
+         * entries must be searched. */
+        for (size_t i = 0; i < DWARF_CFA_CACHE_SIZE; i++) {
+            entry *e = &_entries[i];
+            if (!OSSpinLockTry(&e->lock))
+                continue;
+
+            bool found = (e->valid && pc >= e->row_start && pc < e->row_end && e->image.matches(image));
+            if (found) {
+                *cie_info = e->cie_info;
+                *cfa_state = e->cfa_state;
+            }
+
+            OSSpinLockUnlock(&e->lock);
+            if (found)
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Insert the evaluated CFA state for the row [@a row_start, @a row_end) within @a image, replacing any existing entry.
+     *
+     * @param image The image containing the row.
+     * @param row_start The address of the first instruction within the row.
+     * @param row_end The address immediately following the row.
+     * @param cie_info The CIE data associated with @a cfa_state.
+     * @param cfa_state The evaluated CFA state.
+     */
+    void insert (plcrash_async_macho_t *image, machine_ptr row_start, machine_ptr row_end, const plcrash_async_dwarf_cie_info_t *cie_info, const dwarf_cfa_state<machine_ptr, machine_ptr_s> *cfa_state) {
+        if (!image->has_uuid)
+            return;
+
+        entry *e = &_entries[slot(row_start)];
+        if (!OSSpinLockTry(&e->lock))
+            return;
+
+        e->valid = true;
+        e->row_start = row_start;
+        e->row_end = row_end;
+        e->image.init(image);
+        e->cie_info = *cie_info;
+        e->cfa_state = *cfa_state;
+
+        OSSpinLockUnlock(&e->lock);
+    }
+
+private:
+    /** A single cache entry. */
+    struct entry {
+        /** Entry lock. Zero-initialized (OS_SPINLOCK_INIT) by virtue of static allocation. */
+        OSSpinLock lock;
+
+        /** If true, the entry is populated. */
+        bool valid;
+
+        /** The address of the first instruction of the row for which this entry was evaluated. */
+        machine_ptr row_start;
+
+        /** The address immediately following the row for which this entry was evaluated. */
+        machine_ptr row_end;
+
+        /** The identity of the image containing the row. */
+        dwarf_unwind_cache_image_key image;
+
+        /** The CIE data used to evaluate @a cfa_state. */
+        plcrash_async_dwarf_cie_info_t cie_info;
+
+        /** The evaluated CFA state. */
+        dwarf_cfa_state<machine_ptr, machine_ptr_s> cfa_state;
+    };
+
+    /** Return the entry index for a row starting at @a row_start. */
+    static size_t slot (machine_ptr row_start) {
+        return (size_t) ((row_start ^ (row_start >> 12)) % DWARF_CFA_CACHE_SIZE);
+    }
+
+    /** Cache entries. */
+    entry _entries[DWARF_CFA_CACHE_SIZE];
+};
+
+/** The number of entries in each DWARF CIE cache. */
+#define DWARF_CIE_CACHE_SIZE 8
+
+/**
+ * @internal
+ *
+ * A direct-mapped, async-safe cache of parsed CIE data, keyed by the CIE's address.
+ *
+ * A typical eh_frame section contains only a handful of CIEs, each shared by a large number of FDEs. The cache
+ * saves both the parsed CIE and the CFA state produced by evaluating the CIE's initial instructions. Evaluation of
+ * an FDE can then begin from a copy of that state, without re-parsing the CIE.
+ *
+ * Only initial instruction programs that do not depend on the evaluation location are cached. This is the case for
+ * all CIEs emitted by Apple's toolchain.
+ *
+ * Instances are statically allocated, with the same per-entry OSSpinLockTry() locking and image keying as
+ * dwarf_cfa_cache.
+ *
+ * @tparam machine_ptr The native machine pointer type for the target data.
+ * @tparam machine_ptr_s The native machine signed pointer type for the target data.
+ */
+template<typename machine_ptr, typename machine_ptr_s>
+class dwarf_cie_cache {
+public:
+    /**
+     * Look up the cached CIE data for the CIE at @a cie_address within @a image.
+     *
+     * @param image The image containing the CIE.
+     * @param cie_address The task-relative address of the CIE.
+     * @param[out] cie_info On success, the parsed CIE data.
+     * @param[out] cfa_state On success, the CFA state resulting from evaluation of the CIE's initial instructions.
+     *
+     * @return Returns true if a matching entry was found, false otherwise.
+     */
+    bool lookup (plcrash_async_macho_t *image, pl_vm_address_t cie_address, plcrash_async_dwarf_cie_info_t *cie_info, dwarf_cfa_state<machine_ptr, machine_ptr_s> *cfa_state) {
+        if (!image->has_uuid)
+            return false;
+
+        entry *e = &_entries[slot(cie_address)];
+        if (!OSSpinLockTry(&e->lock))
+            return false;
+
+        bool found = (e->valid && e->cie_address == cie_address && e->image.matches(image));
+        if (found) {
+            *cie_info = e->cie_info;
+            *cfa_state = e->cfa_state;
+        }
+
+        OSSpinLockUnlock(&e->lock);
+        return found;
+    }
+
+    /**
+     * Insert the parsed CIE data for the CIE at @a cie_address within @a image, replacing any existing entry.
+     *
+     * @param image The image containing the CIE.
+     * @param cie_address The task-relative address of the CIE.
+     * @param cie_info The parsed CIE data.
+     * @param cfa_state The CFA state resulting from evaluation of the CIE's initial instructions.
+     */
+    void insert (plcrash_async_macho_t *image, pl_vm_address_t cie_address, const plcrash_async_dwarf_cie_info_t *cie_info, const dwarf_cfa_state<machine_ptr, machine_ptr_s> *cfa_state) {
+        if (!image->has_uuid)
+            return;
+
+        entry *e = &_entries[slot(cie_address)];
+        if (!OSSpinLockTry(&e->lock))
+            return;
+
+        e->valid = true;
+        e->cie_address = cie_address;
+        e->image.init(image);
+        e->cie_info = *cie_info;
+        e->cfa_state = *cfa_state;
+
+        OSSpinLockUnlock(&e->lock);
+    }
+
+private:
+    /** A single cache entry. */
+    struct entry {
+        /** Entry lock. Zero-initialized (OS_SPINLOCK_INIT) by virtue of static allocation. */
+        OSSpinLock lock;
+
+        /** If true, the entry is populated. */
+        bool valid;
+
+        /** The task-relative address of the CIE. */
+        pl_vm_address_t cie_address;
+
+        /** The identity of the image containing the CIE. */
+        dwarf_unwind_cache_image_key image;
+
+        /** The parsed CIE data. */
+        plcrash_async_dwarf_cie_info_t cie_info;
+
+        /** The CFA state resulting from evaluation of the CIE's initial instructions. */
+        dwarf_cfa_state<machine_ptr, machine_ptr_s> cfa_state;
+    };
+
+    /** Return the entry index for @a cie_address. */
+    static size_t slot (pl_vm_address_t cie_address) {
+        return (size_t) ((cie_address ^ (cie_address >> 8)) % DWARF_CIE_CACHE_SIZE);
+    }
+
+    /** Cache entries. */
+    entry _entries[DWARF_CIE_CACHE_SIZE];
+};
+
+}}
+
+#endif /* PLCRASH_FEATURE_UNWIND_DWARF */
+#endif /* PLCRASH_FRAME_DWARF_UNWIND_CACHE_H */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+#import "PLCrashTestCase.h"
+
+#include "PLCrashFrameDWARFUnwindCache.hpp"
+
+#include "PLCrashFeatureConfig.h"
+
+#if PLCRASH_FEATURE_UNWIND_DWARF
+
+using namespace plcrash::async;
+
+@interface PLCrashFrameDWARFUnwindCacheTests : PLCrashTestCase {
+@private
+    /** A fabricated image; only the fields used as cache keys are populated. */
+    plcrash_async_macho_t _image;
+
+    /** The CIE data inserted in the caches. */
+    plcrash_async_dwarf_cie_info_t _cie;
+
+    /** The CFA state inserted in the caches. */
+    dwarf_cfa_state<uint64_t, int64_t> _state;
+
+    /** A port name distinct from mach_task_self(), standing in for another task. */
+    mach_port_t _otherTask;
+}
+@end
+
+/**
+ * Tests the keying of the DWARF unwinder's CFA and CIE caches.
+ */
+@implementation PLCrashFrameDWARFUnwindCacheTests
+
+- (void) setUp {
+    memset(&_image, 0, sizeof(_image));
+    _image.task = mach_task_self();
+    _image.header_addr = 0x10000;
+    _image.text_size = 0x8000;
+    _image.has_uuid = true;
+    for (size_t i = 0; i < sizeof(_image.uuid); i++)
+        _image.uuid[i] = (uint8_t) i;
+
+    memset(&_cie, 0, sizeof(_cie));
+    _cie.return_address_register = 16;
+
+    _state.set_cfa_register(7, 16);
+    _state.set_register(16, PLCRASH_DWARF_CFA_REG_RULE_OFFSET, 8);
+
+    STAssertEquals(mach_port_allocate(mach_task_self(), MACH_PORT_RIGHT_RECEIVE, &_otherTask), KERN_SUCCESS, @"Failed to allocate port");
+}
+
+- (void) tearDown {
+    mach_port_mod_refs(mach_task_self(), _otherTask, MACH_PORT_RIGHT_RECEIVE, -1);
+}
+
+/* Verify that @a state matches the inserted state */
+- (void) assertCachedState: (dwarf_cfa_state<uint64_t, int64_t> *) state cie: (plcrash_async_dwarf_cie_info_t *) cie {
+    plcrash_dwarf_cfa_reg_rule_t rule;
+    uint64_t value;
+
+    STAssertEquals(DWARF_CFA_STATE_CFA_TYPE_REGISTER, state->get_cfa_rule().type(), @"Unexpected CFA type");
+    STAssertEquals((dwarf_cfa_state_regnum_t)7, state->get_cfa_rule().register_number(), @"Unexpected CFA register");
+    STAssertEquals((uint64_t)16, state->get_cfa_rule().register_offset(), @"Unexpected CFA offset");
+
+    STAssertTrue(state->get_register_rule(16, &rule, &value), @"Missing register rule");
+    STAssertEquals(PLCRASH_DWARF_CFA_REG_RULE_OFFSET, rule, @"Unexpected rule");
+    STAssertEquals((uint64_t)8, value, @"Unexpected value");
+
+    STAssertEquals((uint64_t)16, cie->return_address_register, @"Unexpected CIE data");
+}
+
+/**
+ * Test that a repeated PC, and a distinct PC within the same row, hit the CFA cache.
+ */
+- (void) testCFACacheHit {
+    dwarf_cfa_cache<uint64_t, int64_t> *cache = new dwarf_cfa_cache<uint64_t, int64_t>();
+    dwarf_cfa_state<uint64_t, int64_t> state;
+    plcrash_async_dwarf_cie_info_t cie;
+
+    cache->insert(&_image, 0x10100, 0x10140, &_cie, &_state);
+
+    /* Repeated PC */
+    STAssertTrue(cache->lookup(&_image, 0x10100, &cie, &state), @"Cache miss for the evaluated PC");
+    [self assertCachedState: &state cie: &cie];
+    STAssertTrue(cache->lookup(&_image, 0x10100, &cie, &state), @"Cache miss for a repeated PC");
+    [self assertCachedState: &state cie: &cie];
+
+    /* Different PC within the same row */
+    STAssertTrue(cache->lookup(&_image, 0x1013F, &cie, &state), @"Cache miss for a PC within the cached row");
+    [self assertCachedState: &state cie: &cie];
+
+    /* PCs outside of the row */
+    STAssertFalse(cache->lookup(&_image, 0x10140, &cie, &state), @"Cache hit for a PC following the cached row");
+    STAssertFalse(cache->lookup(&_image, 0x100FF, &cie, &state), @"Cache hit for a PC preceding the cached row");
+
+    delete cache;
+}
+
+/**
+ * Test that a different image loaded at the same address misses the CFA cache.
+ */
+- (void) testCFACacheMissForReplacedImage {
+    dwarf_cfa_cache<uint64_t, int64_t> *cache = new dwarf_cfa_cache<uint64_t, int64_t>();
+    dwarf_cfa_state<uint64_t, int64_t> state;
+    plcrash_async_dwarf_cie_info_t cie;
+
+    cache->insert(&_image, 0x10100, 0x10140, &_cie, &_state);
+
+    /* Same header address and text size, different UUID */
+    plcrash_async_macho_t replaced = _image;
+    replaced.uuid[0] ^= 0xFF;
+    STAssertFalse(cache->lookup(&replaced, 0x10100, &cie, &state), @"Cache hit for a different image at the same address");
+
+    /* Images without a UUID can not be distinguished, and are never cached */
+    replaced = _image;
+    replaced.has_uuid = false;
+    STAssertFalse(cache->lookup(&replaced, 0x10100, &cie, &state), @"Cache hit for an image without a UUID");
+
+    cache->insert(&replaced, 0x10200, 0x10240, &_cie, &_state);
+    STAssertFalse(cache->lookup(&replaced, 0x10200, &cie, &state), @"Cache hit for an image without a UUID");
+
+    /* The original entry remains valid */
+    STAssertTrue(cache->lookup(&_image, 0x10100, &cie, &state), @"Cache miss for the evaluated PC");
+
+    delete cache;
+}
+
+/**
+ * Test that the same image and PC in another task misses the CFA cache.
+ */
+- (void) testCFACacheMissInOtherTask {
+    dwarf_cfa_cache<uint64_t, int64_t> *cache = new dwarf_cfa_cache<uint64_t, int64_t>();
+    dwarf_cfa_state<uint64_t, int64_t> state;
+    plcrash_async_dwarf_cie_info_t cie;
+
+    cache->insert(&_image, 0x10100, 0x10140, &_cie, &_state);
+
+    plcrash_async_macho_t other = _image;
+    other.task = _otherTask;
+    STAssertFalse(cache->lookup(&other, 0x10100, &cie, &state), @"Cache hit for an image in another task");
+    STAssertTrue(cache->lookup(&_image, 0x10100, &cie, &state), @"Cache miss for the evaluated PC");
+
+    delete cache;
+}
+
+/**
+ * Test CIE cache hits, and misses for a different image at the same address and for another task.
+ */
+- (void) testCIECache {
+    dwarf_cie_cache<uint64_t, int64_t> *cache = new dwarf_cie_cache<uint64_t, int64_t>();
+    dwarf_cfa_state<uint64_t, int64_t> state;
+    plcrash_async_dwarf_cie_info_t cie;
+
+    cache->insert(&_image, 0x12000, &_cie, &_state);
+
+    STAssertTrue(cache->lookup(&_image, 0x12000, &cie, &state), @"Cache miss for the parsed CIE");
+    [self assertCachedState: &state cie: &cie];
+    STAssertTrue(cache->lookup(&_image, 0x12000, &cie, &state), @"Cache miss for a repeated CIE");
+    STAssertFalse(cache->lookup(&_image, 0x12010, &cie, &state), @"Cache hit for a different CIE");
+
+    plcrash_async_macho_t replaced = _image;
+    replaced.uuid[15] ^= 0xFF;
+    STAssertFalse(cache->lookup(&replaced, 0x12000, &cie, &state), @"Cache hit for a different image at the same address");
+
+    plcrash_async_macho_t other = _image;
+    other.task = _otherTask;
+    STAssertFalse(cache->lookup(&other, 0x12000, &cie, &state), @"Cache hit for an image in another task");
+
+    delete cache;
+}
+
+@end
+
+#endif /* PLCRASH_FEATURE_UNWIND_DWARF */
@@ -28,6 +28,7 @@
 
 #include "PLCrashFrameStackUnwind.h"
 #include "PLCrashAsync.h"
+#include "PLCrashAsyncTrace.h"
 
 /**
  * Fetch the next frame, assuming a valid frame pointer in @a cursor's current frame.
@@ -35,6 +36,7 @@
  * @param task The task containing the target frame stack.
  * @param current_frame The current stack frame.
  * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param stack_cache A read cache to be used when reading from @a task, or NULL to perform uncached reads.
  * @param next_frame The new frame to be initialized.
  *
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
@@ -43,6 +45,7 @@ plframe_error_t plframe_cursor_read_frame_ptr (task_t task,
                                                plcrash_async_image_list_t *image_list,
                                                const plframe_stackframe_t *current_frame,
                                                const plframe_stackframe_t *previous_frame,
+                                               plcrash_async_task_read_cache_t *stack_cache,
                                                plframe_stackframe_t *next_frame)
 {
     /* Determine the appropriate type width for the target thread */
@@ -74,6 +77,13 @@ plframe_error_t plframe_cursor_read_frame_ptr (task_t task,
     /* A NULL FP means a terminated frame */
     if (fp == 0x0)
         return PLFRAME_ENOFRAME;
+
+    /* A frame pointer outside of the thread's stack can not reference a valid frame; rather than following it through
+     * unrelated memory, terminate the walk. */
+    if (current_frame->stack_high != 0 && (fp < current_frame->stack_low || fp >= current_frame->stack_high || current_frame->stack_high - fp < len)) {
+        PLCF_TRACE(PLCRASH_TRACE_STACK_OUT_OF_BOUNDS, fp, current_frame->stack_low, current_frame->stack_high);
+        return PLFRAME_ENOFRAME;
+    }
     
     /* Verify that the stack is growing in the right direction. */
     if (previous_frame != NULL && plcrash_async_thread_state_has_reg(&previous_frame->thread_state, PLCRASH_REG_FP)) {
@@ -83,7 +93,7 @@ plframe_error_t plframe_cursor_read_frame_ptr (task_t task,
         if ((stack_direction == PLCRASH_ASYNC_THREAD_STACK_DIRECTION_DOWN && fp < prev_fp) ||
             (stack_direction == PLCRASH_ASYNC_THREAD_STACK_DIRECTION_UP && fp > prev_fp))
         {
-            PLCF_DEBUG("Stack growing in wrong direction, terminating stack walk");
+            PLCF_TRACE(PLCRASH_TRACE_STACK_WRONG_DIRECTION, fp, prev_fp);
             return PLFRAME_EBADFRAME;
         }
     }
@@ -91,13 +101,11 @@ plframe_error_t plframe_cursor_read_frame_ptr (task_t task,
     /* Read the registers off the stack via the frame pointer */
     plcrash_greg_t new_fp;
     plcrash_greg_t new_pc;
-    kern_return_t kr;
-    
-
+    plcrash_error_t err;
 
-    kr = plcrash_async_read_addr(task, (pl_vm_address_t) fp, dest, len);
-    if (kr != KERN_SUCCESS) {
-        PLCF_DEBUG("Failed to read frame: %d", kr);
+    err = plcrash_async_task_memcpy_cached(stack_cache, task, (pl_vm_address_t) fp, 0, dest, len);
+    if (err != PLCRASH_ESUCCESS) {
+        PLCF_TRACE(PLCRASH_TRACE_STACK_READ_FAILED, fp, err);
         return PLFRAME_EBADFRAME;
     }
 
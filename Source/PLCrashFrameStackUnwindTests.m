@@ -83,7 +83,7 @@ struct stack_frame {
     /* Try walking the stack */
     plframe_stackframe_t new_frame;
     plframe_stackframe_t prev_frame;
-    plframe_stackframe_t frame = cursor.frame;
+    plframe_stackframe_t frame = *plframe_cursor_get_frame(&cursor);
     for (int i = 0; i < frame_count; i++) {
         if (i > 0) {
             plframe_stackframe_t *has_prev_frame = NULL;
@@ -91,7 +91,7 @@ struct stack_frame {
                 has_prev_frame = &prev_frame;
 
             /* Fetch the next frame */
-            STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, has_prev_frame, &new_frame), PLFRAME_ESUCCESS, @"Failed to read next frame");
+            STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, has_prev_frame, NULL, &new_frame), PLFRAME_ESUCCESS, @"Failed to read next frame");
             prev_frame = frame;
             frame = new_frame;
         }
@@ -103,7 +103,7 @@ struct stack_frame {
     }
 
     /* Ensure that the final frame's NULL fp triggers an ENOFRAME */
-    STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, &prev_frame, &new_frame), PLFRAME_ENOFRAME, @"Expected to hit end of frames");
+    STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, &prev_frame, NULL, &new_frame), PLFRAME_ENOFRAME, @"Expected to hit end of frames");
 }
 
 /**
@@ -131,7 +131,7 @@ struct stack_frame {
     /* Try walking the stack */
     plframe_stackframe_t new_frame;
     plframe_stackframe_t prev_frame;
-    plframe_stackframe_t frame = cursor.frame;
+    plframe_stackframe_t frame = *plframe_cursor_get_frame(&cursor);
     
     for (size_t i = 0; i < frame_count; i++) {
         if (i > 0) {
@@ -140,7 +140,7 @@ struct stack_frame {
                 has_prev_frame = &prev_frame;
             
             /* Fetch the next frame */
-            STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, has_prev_frame, &new_frame), PLFRAME_ESUCCESS, @"Failed to read next frame");
+            STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, has_prev_frame, NULL, &new_frame), PLFRAME_ESUCCESS, @"Failed to read next frame");
             prev_frame = frame;
             frame = new_frame;
         }
@@ -152,7 +152,51 @@ struct stack_frame {
     }
 
     /* Ensure that the final frame's bad fp triggers an EBADFRAME */
-    STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, &prev_frame, &new_frame), PLFRAME_EBADFRAME, @"Expected to hit end of frames");
+    STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, &prev_frame, NULL, &new_frame), PLFRAME_EBADFRAME, @"Expected to hit end of frames");
+}
+
+
+/**
+ * Verify that walking terminates with a frame address outside of the frame's stack bounds.
+ */
+- (void) testStackBounds {
+    /* Set up test stack; the final frame lies outside of the stack bounds */
+    struct stack_frame frames[] = {
+        { .fp = &frames[1], .pc = 0x1 },
+        { .fp = &frames[2], .pc = 0x2 },
+        { .fp = 0x0,        .pc = 0x3 },
+    };
+
+    /* Configure thread state */
+    plcrash_async_thread_state_t state;
+    plcrash_async_thread_state_mach_thread_init(&state, pl_mach_thread_self());
+    plcrash_async_thread_state_set_reg(&state, PLCRASH_REG_FP, frames[0].fp);
+    plcrash_async_thread_state_set_reg(&state, PLCRASH_REG_IP, frames[0].pc);
+    plcrash_async_thread_state_set_reg(&state, PLCRASH_REG_SP, (plcrash_greg_t) &frames[0]);
+
+    /* Let the plframe cursor API initialize our first frame */
+    plframe_cursor_t cursor;
+    plframe_cursor_init(&cursor, mach_task_self(), &state, &_image_list);
+    plframe_cursor_set_stack_bounds(&cursor, (pl_vm_address_t) &frames[0], (pl_vm_address_t) &frames[2]);
+
+    plframe_stackframe_t frame = *plframe_cursor_get_frame(&cursor);
+    STAssertEquals(frame.stack_low, (pl_vm_address_t) &frames[0], @"Stack bounds not applied to the initial frame");
+    STAssertEquals(frame.stack_high, (pl_vm_address_t) &frames[2], @"Stack bounds not applied to the initial frame");
+
+    /* The second frame lies within the stack */
+    plframe_stackframe_t new_frame;
+    STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, NULL, NULL, &new_frame), PLFRAME_ESUCCESS, @"Failed to read next frame");
+    STAssertEquals(plcrash_async_thread_state_get_reg(&new_frame.thread_state, PLCRASH_REG_IP), (plcrash_greg_t) frames[1].pc, @"Incorrect IP");
+
+    /* The third frame does not */
+    plframe_stackframe_t prev_frame = frame;
+    frame = new_frame;
+    STAssertEquals(plframe_cursor_read_frame_ptr(cursor.task, &_image_list, &frame, &prev_frame, NULL, &new_frame), PLFRAME_ENOFRAME, @"Expected the out-of-bounds frame to terminate the walk");
+
+    /* Bounds that do not contain the stack pointer are ignored */
+    plframe_cursor_init(&cursor, mach_task_self(), &state, &_image_list);
+    plframe_cursor_set_stack_bounds(&cursor, (pl_vm_address_t) &frames[1], (pl_vm_address_t) &frames[2]);
+    STAssertEquals(plframe_cursor_get_frame(&cursor)->stack_high, (pl_vm_address_t) 0, @"Bounds excluding the stack pointer should be ignored");
 }
 
 @end
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "PLCrashFrameUnwindPlan.h"
+
+#include <inttypes.h>
+#include <libkern/OSAtomic.h>
+
+/**
+ * @internal
+ * @ingroup plframe_backtrace
+ * @{
+ */
+
+/**
+ * Initialize an empty unwind plan.
+ *
+ * @param plan The plan to initialize.
+ * @param greg_size The general purpose register size of the thread state for which the plan is produced.
+ * @param cfa_register The register from which the canonical frame address is computed.
+ * @param cfa_offset The offset applied to @a cfa_register to compute the canonical frame address.
+ */
+void plframe_unwind_plan_init (plframe_unwind_plan_t *plan, size_t greg_size, plcrash_regnum_t cfa_register, int64_t cfa_offset) {
+    plan->greg_size = greg_size;
+    plan->cfa_register = cfa_register;
+    plan->cfa_offset = cfa_offset;
+    plan->register_count = 0;
+}
+
+/**
+ * Append a register rule to @a plan.
+ *
+ * @param plan The plan to which the rule will be appended.
+ * @param regnum The register to be restored.
+ * @param rule The rule used to restore @a regnum.
+ * @param value The CFA-relative offset, or the source register for PLFRAME_UNWIND_PLAN_RULE_REGISTER rules.
+ *
+ * @return Returns true on success, or false if @a plan has no room for additional rules.
+ */
+bool plframe_unwind_plan_add_register (plframe_unwind_plan_t *plan, plcrash_regnum_t regnum, plframe_unwind_plan_rule_t rule, int64_t value) {
+    if (plan->register_count >= PLFRAME_UNWIND_PLAN_REGISTER_MAX)
+        return false;
+
+    plframe_unwind_plan_register_t *reg = &plan->registers[plan->register_count++];
+    reg->regnum = regnum;
+    reg->rule = rule;
+    reg->value = value;
+    return true;
+}
+
+/**
+ * Apply @a plan to @a thread_state, populating @a new_thread_state with the caller's frame.
+ *
+ * @param task The task containing the target frame stack.
+ * @param stack_cache A read cache to be used when reading stack data from @a task, or NULL to perform uncached reads.
+ * @param plan The plan to be applied.
+ * @param thread_state The current thread state.
+ * @param new_thread_state The new thread state to be initialized.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or a standard plcrash_error_t code if an error occurs. If the plan was
+ * produced for a thread state with a different register size, PLCRASH_EINVAL will be returned.
+ */
+plcrash_error_t plframe_unwind_plan_apply (task_t task,
+                                           plcrash_async_task_read_cache_t *stack_cache,
+                                           const plframe_unwind_plan_t *plan,
+                                           const plcrash_async_thread_state_t *thread_state,
+                                           plcrash_async_thread_state_t *new_thread_state)
+{
+    size_t greg_size = plcrash_async_thread_state_get_greg_size(thread_state);
+    union {
+        uint32_t v32;
+        uint64_t v64;
+    } rvalue;
+    plcrash_error_t err;
+
+    if (plan->greg_size != greg_size) {
+        PLCF_DEBUG("Unwind plan register size %zu does not match the thread state register size %zu", plan->greg_size, greg_size);
+        return PLCRASH_EINVAL;
+    }
+
+    /* Initialize the new thread state */
+    plcrash_async_thread_state_copy(new_thread_state, thread_state);
+    plcrash_async_thread_state_clear_volatile_regs(new_thread_state);
+
+    /* Compute the canonical frame address */
+    if (!plcrash_async_thread_state_has_reg(thread_state, plan->cfa_register)) {
+        PLCF_DEBUG("Unwind plan references a CFA register that is not available from the current thread state");
+        return PLCRASH_ENOTFOUND;
+    }
+
+    pl_vm_address_t cfa;
+    if (!plcrash_async_address_apply_offset(plcrash_async_thread_state_get_reg(thread_state, plan->cfa_register), (pl_vm_off_t) plan->cfa_offset, &cfa) ||
+        (greg_size == sizeof(uint32_t) && cfa > UINT32_MAX))
+    {
+        PLCF_DEBUG("The canonical frame address falls outside of addressable bounds");
+        return PLCRASH_EINVAL;
+    }
+
+    plcrash_async_thread_state_set_reg(new_thread_state, PLCRASH_REG_SP, cfa);
+
+    /* Restore the saved registers */
+    for (size_t i = 0; i < plan->register_count; i++) {
+        const plframe_unwind_plan_register_t *reg = &plan->registers[i];
+
+        switch (reg->rule) {
+            case PLFRAME_UNWIND_PLAN_RULE_SAVED:
+                err = plcrash_async_task_memcpy_cached(stack_cache, task, cfa, (pl_vm_off_t) reg->value, &rvalue, greg_size);
+                if (err != PLCRASH_ESUCCESS) {
+                    PLCF_DEBUG("Failed to read saved register value at 0x%" PRIx64 " + %" PRId64 ": %d", (uint64_t) cfa, reg->value, err);
+                    return err;
+                }
+
+                if (greg_size == sizeof(uint64_t)) {
+                    plcrash_async_thread_state_set_reg(new_thread_state, reg->regnum, rvalue.v64);
+                } else {
+                    plcrash_async_thread_state_set_reg(new_thread_state, reg->regnum, rvalue.v32);
+                }
+                break;
+
+            case PLFRAME_UNWIND_PLAN_RULE_VAL_OFFSET:
+                plcrash_async_thread_state_set_reg(new_thread_state, reg->regnum, cfa + reg->value);
+                break;
+
+            case PLFRAME_UNWIND_PLAN_RULE_REGISTER:
+                if (!plcrash_async_thread_state_has_reg(thread_state, (plcrash_regnum_t) reg->value)) {
+                    PLCF_DEBUG("Unwind plan references a register that is not available from the current thread state");
+                    return PLCRASH_ENOTFOUND;
+                }
+
+                plcrash_async_thread_state_set_reg(new_thread_state, reg->regnum, plcrash_async_thread_state_get_reg(thread_state, (plcrash_regnum_t) reg->value));
+                break;
+        }
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+#pragma mark Plan Cache
+
+/**
+ * A single unwind plan cache entry.
+ */
+typedef struct plframe_unwind_plan_cache_entry {
+    /** Entry lock. Zero-initialized (OS_SPINLOCK_INIT) by virtue of static allocation. */
+    OSSpinLock lock;
+
+    /** If true, the entry is populated. */
+    bool valid;
+
+    /** The first address to which the plan applies. */
+    pl_vm_address_t start;
+
+    /** The address immediately following the range to which the plan applies. */
+    pl_vm_address_t end;
+
+    /** The header address of the image containing the range. */
+    pl_vm_address_t header_addr;
+
+    /** The text size of the image containing the range. */
+    pl_vm_size_t text_size;
+
+    /** The cached plan. */
+    plframe_unwind_plan_t plan;
+} plframe_unwind_plan_cache_entry_t;
+
+/**
+ * The unwind plan cache, shared by all frame readers and all threads.
+ *
+ * When many threads are parked in the same functions, the same unwind plans are derived repeatedly; caching the
+ * plans allows later frames within a previously seen address range to skip both compact unwind decoding and DWARF
+ * evaluation. The cache is statically allocated, and thus requires no allocation at crash time. Each entry is guarded
+ * by a spinlock that is only ever acquired via OSSpinLockTry(); if an entry is in use by another reader, the entry is
+ * simply skipped.
+ */
+static plframe_unwind_plan_cache_entry_t plan_cache[PLFRAME_UNWIND_PLAN_CACHE_SIZE];
+
+/** Return the cache index for a range starting at @a start. */
+static size_t plframe_unwind_plan_cache_slot (pl_vm_address_t start) {
+    return (size_t) ((start ^ (start >> 12)) % PLFRAME_UNWIND_PLAN_CACHE_SIZE);
+}
+
+/**
+ * Look up the cached unwind plan for @a pc within @a image.
+ *
+ * @param image The image containing @a pc.
+ * @param pc The PC value.
+ * @param[out] plan On success, the cached plan.
+ *
+ * @return Returns true if a matching entry was found, false otherwise.
+ */
+bool plframe_unwind_plan_cache_lookup (plcrash_async_macho_t *image, pl_vm_address_t pc, plframe_unwind_plan_t *plan) {
+    /* Entries are keyed by the start of their range, which is unknown until the unwind data has been read; all
+     * entries must be searched. */
+    for (size_t i = 0; i < PLFRAME_UNWIND_PLAN_CACHE_SIZE; i++) {
+        plframe_unwind_plan_cache_entry_t *e = &plan_cache[i];
+        if (!OSSpinLockTry(&e->lock))
+            continue;
+
+        bool found = (e->valid && pc >= e->start && pc < e->end && e->header_addr == image->header_addr && e->text_size == image->text_size);
+        if (found)
+            *plan = e->plan;
+
+        OSSpinLockUnlock(&e->lock);
+        if (found)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Insert the unwind plan for the address range [@a start, @a end) within @a image, replacing any existing entry.
+ *
+ * @param image The image containing the range.
+ * @param start The first address to which @a plan applies.
+ * @param end The address immediately following the range to which @a plan applies.
+ * @param plan The plan to be cached.
+ */
+void plframe_unwind_plan_cache_insert (plcrash_async_macho_t *image, pl_vm_address_t start, pl_vm_address_t end, const plframe_unwind_plan_t *plan) {
+    if (start >= end)
+        return;
+
+    plframe_unwind_plan_cache_entry_t *e = &plan_cache[plframe_unwind_plan_cache_slot(start)];
+    if (!OSSpinLockTry(&e->lock))
+        return;
+
+    e->valid = true;
+    e->start = start;
+    e->end = end;
+    e->header_addr = image->header_addr;
+    e->text_size = image->text_size;
+    e->plan = *plan;
+
+    OSSpinLockUnlock(&e->lock);
+}
+
+/**
+ * Discard all cached unwind plans.
+ *
+ * @warning This function is not async-safe, and is primarily intended for use by unit tests.
+ */
+void plframe_unwind_plan_cache_flush (void) {
+    for (size_t i = 0; i < PLFRAME_UNWIND_PLAN_CACHE_SIZE; i++) {
+        plframe_unwind_plan_cache_entry_t *e = &plan_cache[i];
+        OSSpinLockLock(&e->lock);
+        e->valid = false;
+        OSSpinLockUnlock(&e->lock);
+    }
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef PLCRASH_FRAME_UNWINDPLAN_H
+#define PLCRASH_FRAME_UNWINDPLAN_H
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncThread.h"
+#include "PLCrashAsyncMachOImage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @internal
+ * @ingroup plframe_backtrace
+ * @{
+ */
+
+/** The maximum number of register rules that may be recorded in a single plframe_unwind_plan_t. */
+#define PLFRAME_UNWIND_PLAN_REGISTER_MAX 20
+
+/** The number of entries in the unwind plan cache. */
+#define PLFRAME_UNWIND_PLAN_CACHE_SIZE 32
+
+/**
+ * Unwind plan register rules.
+ */
+typedef enum {
+    /** The register's previous value is saved at the CFA plus the rule's offset. */
+    PLFRAME_UNWIND_PLAN_RULE_SAVED = 0,
+
+    /** The register's previous value is the CFA plus the rule's offset. */
+    PLFRAME_UNWIND_PLAN_RULE_VAL_OFFSET = 1,
+
+    /** The register's previous value is held in the rule's source register in the current frame. */
+    PLFRAME_UNWIND_PLAN_RULE_REGISTER = 2
+} plframe_unwind_plan_rule_t;
+
+/**
+ * A single unwind plan register rule.
+ */
+typedef struct plframe_unwind_plan_register {
+    /** The register to be restored. */
+    plcrash_regnum_t regnum;
+
+    /** The rule used to restore @a regnum. */
+    plframe_unwind_plan_rule_t rule;
+
+    /** The CFA-relative offset for PLFRAME_UNWIND_PLAN_RULE_SAVED and PLFRAME_UNWIND_PLAN_RULE_VAL_OFFSET rules, or
+     * the source register for PLFRAME_UNWIND_PLAN_RULE_REGISTER rules. */
+    int64_t value;
+} plframe_unwind_plan_register_t;
+
+/**
+ * A reader-independent description of how to unwind out of a function: the rule for computing the canonical frame
+ * address (CFA), and the location of each restored register relative to that CFA.
+ *
+ * Plans are produced by the compact unwind and DWARF frame readers, and may be applied without reference to the
+ * unwind data from which they were derived. The new frame's stack pointer is always set to the CFA.
+ */
+typedef struct plframe_unwind_plan {
+    /** The general purpose register size of the thread state for which the plan was produced. */
+    size_t greg_size;
+
+    /** The register from which the CFA is computed. */
+    plcrash_regnum_t cfa_register;
+
+    /** The offset applied to @a cfa_register to compute the CFA. */
+    int64_t cfa_offset;
+
+    /** The number of rules in @a registers. */
+    size_t register_count;
+
+    /** Register rules, applied in order. */
+    plframe_unwind_plan_register_t registers[PLFRAME_UNWIND_PLAN_REGISTER_MAX];
+} plframe_unwind_plan_t;
+
+void plframe_unwind_plan_init (plframe_unwind_plan_t *plan, size_t greg_size, plcrash_regnum_t cfa_register, int64_t cfa_offset);
+bool plframe_unwind_plan_add_register (plframe_unwind_plan_t *plan, plcrash_regnum_t regnum, plframe_unwind_plan_rule_t rule, int64_t value);
+
+plcrash_error_t plframe_unwind_plan_apply (task_t task,
+                                           plcrash_async_task_read_cache_t *stack_cache,
+                                           const plframe_unwind_plan_t *plan,
+                                           const plcrash_async_thread_state_t *thread_state,
+                                           plcrash_async_thread_state_t *new_thread_state);
+
+bool plframe_unwind_plan_cache_lookup (plcrash_async_macho_t *image, pl_vm_address_t pc, plframe_unwind_plan_t *plan);
+void plframe_unwind_plan_cache_insert (plcrash_async_macho_t *image, pl_vm_address_t start, pl_vm_address_t end, const plframe_unwind_plan_t *plan);
+void plframe_unwind_plan_cache_flush (void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_FRAME_UNWINDPLAN_H */
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashFrameUnwindPlan.h"
+
+@interface PLCrashFrameUnwindPlanTests : SenTestCase {
+@private
+}
+@end
+
+@implementation PLCrashFrameUnwindPlanTests
+
+- (void) tearDown {
+    plframe_unwind_plan_cache_flush();
+}
+
+#if PLCRASH_ASYNC_THREAD_X86_SUPPORT && defined(__LP64__)
+/**
+ * Test applying a frame pointer based plan.
+ */
+- (void) testApplyFramePointerPlan {
+    plcrash_async_thread_state_t ts;
+    plcrash_async_thread_state_t nts;
+    plframe_unwind_plan_t plan;
+
+    /* Set up a faux frame */
+    uint64_t stackframe[] = {
+        12, // r12
+        1,  // rbp
+        2,  // ret addr
+    };
+
+    plframe_unwind_plan_init(&plan, sizeof(uint64_t), PLCRASH_REG_FP, 16);
+    STAssertTrue(plframe_unwind_plan_add_register(&plan, PLCRASH_REG_FP, PLFRAME_UNWIND_PLAN_RULE_SAVED, -16), @"Failed to add rule");
+    STAssertTrue(plframe_unwind_plan_add_register(&plan, PLCRASH_REG_IP, PLFRAME_UNWIND_PLAN_RULE_SAVED, -8), @"Failed to add rule");
+    STAssertTrue(plframe_unwind_plan_add_register(&plan, PLCRASH_X86_64_R12, PLFRAME_UNWIND_PLAN_RULE_SAVED, -24), @"Failed to add rule");
+    STAssertTrue(plframe_unwind_plan_add_register(&plan, PLCRASH_X86_64_RBX, PLFRAME_UNWIND_PLAN_RULE_REGISTER, PLCRASH_X86_64_R13), @"Failed to add rule");
+
+    plcrash_greg_t stack_addr = (plcrash_greg_t) &stackframe[1]; // rbp
+    STAssertEquals(plcrash_async_thread_state_init(&ts, CPU_TYPE_X86_64), PLCRASH_ESUCCESS, @"Failed to initialize thread state");
+    plcrash_async_thread_state_set_reg(&ts, PLCRASH_REG_FP, stack_addr);
+    plcrash_async_thread_state_set_reg(&ts, PLCRASH_X86_64_R13, 13);
+
+    STAssertEquals(plframe_unwind_plan_apply(mach_task_self(), NULL, &plan, &ts, &nts), PLCRASH_ESUCCESS, @"Failed to apply plan");
+
+    STAssertEquals(plcrash_async_thread_state_get_reg(&nts, PLCRASH_X86_64_RSP), stack_addr + 16, @"Incorrect register value");
+    STAssertEquals(plcrash_async_thread_state_get_reg(&nts, PLCRASH_X86_64_RBP), (plcrash_greg_t) 1, @"Incorrect register value");
+    STAssertEquals(plcrash_async_thread_state_get_reg(&nts, PLCRASH_X86_64_RIP), (plcrash_greg_t) 2, @"Incorrect register value");
+    STAssertEquals(plcrash_async_thread_state_get_reg(&nts, PLCRASH_X86_64_R12), (plcrash_greg_t) 12, @"Incorrect register value");
+    STAssertEquals(plcrash_async_thread_state_get_reg(&nts, PLCRASH_X86_64_RBX), (plcrash_greg_t) 13, @"Incorrect register value");
+
+    /* A plan produced for a different register size must not be applied */
+    plan.greg_size = sizeof(uint32_t);
+    STAssertEquals(plframe_unwind_plan_apply(mach_task_self(), NULL, &plan, &ts, &nts), PLCRASH_EINVAL, @"Applied a plan with a mismatched register size");
+
+    /* A plan referencing an unavailable CFA register must fail */
+    plframe_unwind_plan_init(&plan, sizeof(uint64_t), PLCRASH_X86_64_R15, 16);
+    STAssertEquals(plframe_unwind_plan_apply(mach_task_self(), NULL, &plan, &ts, &nts), PLCRASH_ENOTFOUND, @"Applied a plan with an unavailable CFA register");
+}
+#endif
+
+/**
+ * Test that plans are only returned for the image and address range for which they were inserted.
+ */
+- (void) testCacheLookup {
+    plcrash_async_macho_t image;
+    plcrash_async_macho_t other_image;
+    plframe_unwind_plan_t plan;
+    plframe_unwind_plan_t result;
+
+    memset(&image, 0, sizeof(image));
+    image.header_addr = 0x100000;
+    image.text_size = 0x8000;
+
+    other_image = image;
+    other_image.header_addr = 0x200000;
+
+    plframe_unwind_plan_init(&plan, sizeof(uint64_t), PLCRASH_REG_FP, 16);
+    plframe_unwind_plan_add_register(&plan, PLCRASH_REG_IP, PLFRAME_UNWIND_PLAN_RULE_SAVED, -8);
+    plframe_unwind_plan_cache_insert(&image, 0x101000, 0x101040, &plan);
+
+    STAssertTrue(plframe_unwind_plan_cache_lookup(&image, 0x101000, &result), @"Plan not found at range start");
+    STAssertTrue(plframe_unwind_plan_cache_lookup(&image, 0x10103F, &result), @"Plan not found at range end");
+    STAssertEquals(result.cfa_register, (plcrash_regnum_t) PLCRASH_REG_FP, @"Incorrect CFA register");
+    STAssertEquals(result.cfa_offset, (int64_t) 16, @"Incorrect CFA offset");
+    STAssertEquals(result.register_count, (size_t) 1, @"Incorrect register count");
+    STAssertEquals(result.registers[0].value, (int64_t) -8, @"Incorrect register rule");
+
+    STAssertFalse(plframe_unwind_plan_cache_lookup(&image, 0x101040, &result), @"Plan returned outside of its range");
+    STAssertFalse(plframe_unwind_plan_cache_lookup(&image, 0x100FFF, &result), @"Plan returned outside of its range");
+    STAssertFalse(plframe_unwind_plan_cache_lookup(&other_image, 0x101000, &result), @"Plan returned for a different image");
+
+    plframe_unwind_plan_cache_flush();
+    STAssertFalse(plframe_unwind_plan_cache_lookup(&image, 0x101000, &result), @"Plan returned after flush");
+}
+
+@end
@@ -33,6 +33,7 @@
 #include "PLCrashFrameStackUnwind.h"
 #include "PLCrashFrameCompactUnwind.h"
 #include "PLCrashFrameDWARFUnwind.h"
+#include "PLCrashFrameUnwindPlan.h"
 
 #include "PLCrashFeatureConfig.h"
 
@@ -119,8 +120,14 @@ void plframe_test_thread_stop (plcrash_test_thread_t *args) {
  */
 static void plframe_cursor_internal_init (plframe_cursor_t *cursor, task_t task, plcrash_async_image_list_t *image_list) {
     cursor->depth = 0;
+    cursor->frame_index = 0;
+    cursor->stack_low = 0;
+    cursor->stack_high = 0;
+    cursor->frames[0].stack_low = 0;
+    cursor->frames[0].stack_high = 0;
     cursor->task = task;
     cursor->image_list = image_list;
+    plcrash_async_task_read_cache_init(&cursor->stack_cache);
     mach_port_mod_refs(mach_task_self(), cursor->task, MACH_PORT_RIGHT_SEND, 1);    
 }
 
@@ -140,7 +147,7 @@ static void plframe_cursor_internal_init (plframe_cursor_t *cursor, task_t task,
 plframe_error_t plframe_cursor_init (plframe_cursor_t *cursor, task_t task, plcrash_async_thread_state_t *thread_state, plcrash_async_image_list_t *image_list) {
     plframe_cursor_internal_init(cursor, task, image_list);
 
-    plcrash_async_memcpy(&cursor->frame.thread_state, thread_state, sizeof(cursor->frame.thread_state));
+    plcrash_async_memcpy(&plframe_cursor_get_frame(cursor)->thread_state, thread_state, sizeof(*thread_state));
 
     return PLFRAME_ESUCCESS;
 }
@@ -163,65 +170,183 @@ plframe_error_t plframe_cursor_thread_init (plframe_cursor_t *cursor, task_t tas
     /* Standard initialization */
     plframe_cursor_internal_init(cursor, task, image_list);
     
-    return plcrash_async_thread_state_mach_thread_init(&cursor->frame.thread_state, thread);
+    return plcrash_async_thread_state_mach_thread_init(&plframe_cursor_get_frame(cursor)->thread_state, thread);
 }
 
 /**
+ * Set the bounds of the stack walked by @a cursor. Once set, the frame pointer reader terminates the walk when a
+ * frame pointer falls outside of the stack, rather than following the frame pointer chain through unrelated memory.
+ *
+ * The bounds are ignored if the current frame's stack pointer does not fall within them; this may occur, for
+ * example, if the thread is executing on an alternate signal stack.
+ *
+ * @param cursor A cursor instance initialized with plframe_cursor_init(), which has not yet been stepped.
+ * @param stack_low The lowest address of the stack.
+ * @param stack_high The address immediately following the stack.
+ */
+void plframe_cursor_set_stack_bounds (plframe_cursor_t *cursor, pl_vm_address_t stack_low, pl_vm_address_t stack_high) {
+    plframe_stackframe_t *frame = plframe_cursor_get_frame(cursor);
+
+    if (stack_low >= stack_high || !plcrash_async_thread_state_has_reg(&frame->thread_state, PLCRASH_REG_SP))
+        return;
+
+    plcrash_greg_t sp = plcrash_async_thread_state_get_reg(&frame->thread_state, PLCRASH_REG_SP);
+    if (sp < stack_low || sp >= stack_high)
+        return;
+
+    cursor->stack_low = stack_low;
+    cursor->stack_high = stack_high;
+    frame->stack_low = stack_low;
+    frame->stack_high = stack_high;
+}
+
+/**
+ * @internal
+ *
+ * Return true if @a reader can not succeed for frames within @a image, and should be skipped.
+ */
+static bool plframe_cursor_reader_unavailable (plframe_cursor_frame_reader_t *reader, plcrash_async_image_t *image) {
+#if PLCRASH_FEATURE_UNWIND_COMPACT
+    if (reader == plframe_cursor_read_compact_unwind && image->_no_compact_unwind)
+        return true;
+#endif
+
+#if PLCRASH_FEATURE_UNWIND_DWARF
+    if (reader == plframe_cursor_read_dwarf_unwind && image->_no_dwarf_unwind)
+        return true;
+#endif
+
+    return false;
+}
+
+/**
+ * @internal
+ *
  * Fetch the next frame using the provided frame readers.
  *
  * @param cursor A cursor instance initialized with plframe_cursor_init();
- * @param readers Frame readers to be used to fetch the next frame. Each reader will be executed in the provided order until a valid frame is read.
- * @param reader_count The number of readers provided in @a readers.
- * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
+ * @param readers The ordered set of frame readers to use.
+ * @param reader_count The number of readers in @a readers.
+ * @param adaptive If true, readers that can not succeed for the current frame's image are skipped, and the reader that
+ * most recently succeeded within the image is tried first. The final reader in @a readers is treated as a heuristic
+ * fallback; it is never tried first.
  */
-plframe_error_t plframe_cursor_next_with_readers (plframe_cursor_t *cursor, plframe_cursor_frame_reader_t *readers[], size_t reader_count) {
+static plframe_error_t plframe_cursor_next_internal (plframe_cursor_t *cursor, plframe_cursor_frame_reader_t *readers[], size_t reader_count, bool adaptive) {
     /* The first frame is already available via existing thread state. */
     if (cursor->depth == 0) {
         cursor->depth++;
         return PLFRAME_ESUCCESS;
     }
     
+    /* The current, previous, and next frames occupy consecutive slots of the frame ring */
+    plframe_stackframe_t *current_frame = plframe_cursor_get_frame(cursor);
+    plframe_stackframe_t *frame = &cursor->frames[(cursor->frame_index + 1) % 3];
+
     /* A previous frame is only available if we're on the second frame */
     plframe_stackframe_t *prev_frame = NULL;
     if (cursor->depth >= 2)
-        prev_frame = &cursor->prev_frame;
+        prev_frame = &cursor->frames[(cursor->frame_index + 2) % 3];
     
-    /* Read in the next frame using the first successful frame reader. */
-    plframe_stackframe_t frame;
+    /* Find the current frame's image, if adaptive reader ordering is enabled */
+    plcrash_async_image_t *image = NULL;
+    plframe_cursor_frame_reader_t *preferred = NULL;
+    if (adaptive && cursor->image_list != NULL && plcrash_async_thread_state_has_reg(&current_frame->thread_state, PLCRASH_REG_IP)) {
+        plcrash_async_image_list_set_reading(cursor->image_list, true);
+        image = plcrash_async_image_containing_address(cursor->image_list, plcrash_async_thread_state_get_reg(&current_frame->thread_state, PLCRASH_REG_IP));
+        if (image != NULL) {
+            preferred = (plframe_cursor_frame_reader_t *) image->_preferred_reader;
+        } else {
+            plcrash_async_image_list_set_reading(cursor->image_list, false);
+        }
+    }
+
+    /* Read in the next frame using the first successful frame reader, starting with the image's preferred reader. */
     plframe_error_t ferr = PLFRAME_EINVAL; // default return value if reader_count is 0.
-    
-    for (size_t i = 0; i < reader_count; i++) {
-        ferr = readers[i](cursor->task, cursor->image_list, &cursor->frame, prev_frame, &frame);
+    plframe_cursor_frame_reader_t *used = NULL;
+    bool planned = false;
+
+    /* Use a previously derived unwind plan, if available; this skips both compact unwind decoding and DWARF evaluation. */
+    if (image != NULL) {
+        plframe_unwind_plan_t plan;
+        plcrash_greg_t pc = plcrash_async_thread_state_get_reg(&current_frame->thread_state, PLCRASH_REG_IP);
+        if (plframe_unwind_plan_cache_lookup(&image->macho_image, pc, &plan) &&
+            plframe_unwind_plan_apply(cursor->task, &cursor->stack_cache, &plan, &current_frame->thread_state, &frame->thread_state) == PLCRASH_ESUCCESS)
+        {
+            ferr = PLFRAME_ESUCCESS;
+            planned = true;
+        }
+    }
+
+    if (preferred != NULL && !planned) {
+        ferr = preferred(cursor->task, cursor->image_list, current_frame, prev_frame, &cursor->stack_cache, frame);
         if (ferr == PLFRAME_ESUCCESS)
-            break;
+            used = preferred;
     }
-    
+
+    for (size_t i = 0; i < reader_count && used == NULL && !planned; i++) {
+        if (readers[i] == preferred)
+            continue;
+
+        if (image != NULL && plframe_cursor_reader_unavailable(readers[i], image))
+            continue;
+
+        ferr = readers[i](cursor->task, cursor->image_list, current_frame, prev_frame, &cursor->stack_cache, frame);
+        if (ferr == PLFRAME_ESUCCESS) {
+            used = readers[i];
+
+            /* Record the successful reader; the final fallback reader is never preferred */
+            if (image != NULL && i + 1 < reader_count)
+                image->_preferred_reader = (void *) used;
+        }
+    }
+
+    if (image != NULL)
+        plcrash_async_image_list_set_reading(cursor->image_list, false);
+
     if (ferr != PLFRAME_ESUCCESS) {
         return ferr;
     }
 
     /* Check for completion */
-    if (!plcrash_async_thread_state_has_reg(&frame.thread_state, PLCRASH_REG_IP)) {
+    if (!plcrash_async_thread_state_has_reg(&frame->thread_state, PLCRASH_REG_IP)) {
         PLCF_DEBUG("Missing expected IP value in successfully read frame");
         return PLFRAME_ENOFRAME;
     }
     
     /* A pc within the NULL page is a terminating frame */
-    plcrash_greg_t ip = plcrash_async_thread_state_get_reg(&frame.thread_state, PLCRASH_REG_IP);
+    plcrash_greg_t ip = plcrash_async_thread_state_get_reg(&frame->thread_state, PLCRASH_REG_IP);
     if (ip <= PAGE_SIZE)
         return PLFRAME_ENOFRAME;
     
-    /* Save the newly fetched frame */
-    cursor->prev_frame = cursor->frame;
-    cursor->frame = frame;
+    /* All frames reside on the cursor's stack */
+    frame->stack_low = cursor->stack_low;
+    frame->stack_high = cursor->stack_high;
+
+    /* Advance to the newly fetched frame; the current frame becomes the previous frame */
+    cursor->frame_index = (cursor->frame_index + 1) % 3;
     cursor->depth++;
     
     return PLFRAME_ESUCCESS;
 }
 
+/**
+ * Fetch the next frame using the provided frame readers.
+ *
+ * @param cursor A cursor instance initialized with plframe_cursor_init();
+ * @param readers Frame readers to be used to fetch the next frame. Each reader will be executed in the provided order until a valid frame is read.
+ * @param reader_count The number of readers provided in @a readers.
+ * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
+ */
+plframe_error_t plframe_cursor_next_with_readers (plframe_cursor_t *cursor, plframe_cursor_frame_reader_t *readers[], size_t reader_count) {
+    return plframe_cursor_next_internal(cursor, readers, reader_count, false);
+}
+
 /**
  * Fetch the next frame.
  *
+ * Readers are ordered adaptively: readers that require unwind data absent from the current frame's image are
+ * skipped, and the reader that most recently succeeded within the image is tried first.
+ *
  * @param cursor A cursor instance initialized with plframe_cursor_init();
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
  */
@@ -239,7 +364,78 @@ plframe_error_t plframe_cursor_next (plframe_cursor_t *cursor) {
         plframe_cursor_read_frame_ptr
     };
 
-    return plframe_cursor_next_with_readers(cursor, readers, sizeof(readers)/sizeof(readers[0]));
+    return plframe_cursor_next_internal(cursor, readers, sizeof(readers)/sizeof(readers[0]), true);
+}
+
+/**
+ * Walk up to @a max frames from @a cursor, recording each frame's PC (and, optionally, stack and frame pointers) in
+ * the caller-supplied arrays.
+ *
+ * This is equivalent to repeatedly calling plframe_cursor_next() and plframe_cursor_get_reg(), but the image list is
+ * retained once for the duration of the walk, rather than once per frame. The cursor is left positioned on the last
+ * recorded frame, and a walk that filled @a max frames may be continued by calling plframe_cursor_walk() again.
+ *
+ * @param cursor A cursor instance initialized with plframe_cursor_init().
+ * @param pcs An array of at least @a max elements, to be populated with the PC value of each frame.
+ * @param sps An array of at least @a max elements, to be populated with the stack pointer of each frame, or NULL. If
+ * a frame's stack pointer is unavailable, 0 will be recorded.
+ * @param fps An array of at least @a max elements, to be populated with the frame pointer of each frame, or NULL. If
+ * a frame's frame pointer is unavailable, 0 will be recorded.
+ * @param max The maximum number of frames to be recorded.
+ * @param count On return, will be set to the number of frames recorded, even if an error occurs.
+ * @param flags A bitwise OR of plframe_walk_flags_t values.
+ *
+ * @return Returns PLFRAME_ENOFRAME if the end of the stack was reached, PLFRAME_ESUCCESS if @a max frames were
+ * recorded and additional frames may be available, or a standard plframe_error_t code if an error terminated the walk.
+ */
+plframe_error_t plframe_cursor_walk (plframe_cursor_t *cursor, plcrash_greg_t pcs[], plcrash_greg_t sps[], plcrash_greg_t fps[], size_t max, size_t *count, uint32_t flags) {
+    plframe_cursor_frame_reader_t *readers[] = { plframe_cursor_read_frame_ptr };
+    plframe_error_t ferr = PLFRAME_ESUCCESS;
+    size_t n = 0;
+
+    /* Retain the image list once for all frames; each reader's nested retain is then uncontended. */
+    if (cursor->image_list != NULL)
+        plcrash_async_image_list_set_reading(cursor->image_list, true);
+
+    while (n < max) {
+        if (flags & PLFRAME_WALK_FRAME_PTR_ONLY) {
+            ferr = plframe_cursor_next_internal(cursor, readers, sizeof(readers) / sizeof(readers[0]), false);
+        } else {
+            ferr = plframe_cursor_next(cursor);
+        }
+
+        if (ferr != PLFRAME_ESUCCESS)
+            break;
+
+        plcrash_async_thread_state_t *thread_state = &plframe_cursor_get_frame(cursor)->thread_state;
+        if (!plcrash_async_thread_state_has_reg(thread_state, PLCRASH_REG_IP)) {
+            ferr = PLFRAME_ENOTSUP;
+            break;
+        }
+
+        pcs[n] = plcrash_async_thread_state_get_reg(thread_state, PLCRASH_REG_IP);
+        if (sps != NULL) {
+            if (plcrash_async_thread_state_has_reg(thread_state, PLCRASH_REG_SP)) {
+                sps[n] = plcrash_async_thread_state_get_reg(thread_state, PLCRASH_REG_SP);
+            } else {
+                sps[n] = 0;
+            }
+        }
+        if (fps != NULL) {
+            if (plcrash_async_thread_state_has_reg(thread_state, PLCRASH_REG_FP)) {
+                fps[n] = plcrash_async_thread_state_get_reg(thread_state, PLCRASH_REG_FP);
+            } else {
+                fps[n] = 0;
+            }
+        }
+        n++;
+    }
+
+    if (cursor->image_list != NULL)
+        plcrash_async_image_list_set_reading(cursor->image_list, false);
+
+    *count = n;
+    return ferr;
 }
 
 
@@ -252,11 +448,11 @@ plframe_error_t plframe_cursor_next (plframe_cursor_t *cursor) {
  */
 plframe_error_t plframe_cursor_get_reg (plframe_cursor_t *cursor, plcrash_regnum_t regnum, plcrash_greg_t *reg) {
     /* Verify that the register is available */
-    if (!plcrash_async_thread_state_has_reg(&cursor->frame.thread_state, regnum))
+    if (!plcrash_async_thread_state_has_reg(&plframe_cursor_get_frame(cursor)->thread_state, regnum))
         return PLFRAME_ENOTSUP;
 
     /* Fetch from thread state */
-    *reg = plcrash_async_thread_state_get_reg(&cursor->frame.thread_state, regnum);
+    *reg = plcrash_async_thread_state_get_reg(&plframe_cursor_get_frame(cursor)->thread_state, regnum);
     return PLFRAME_ESUCCESS;
 }
 
@@ -267,7 +463,7 @@ plframe_error_t plframe_cursor_get_reg (plframe_cursor_t *cursor, plcrash_regnum
  * @param regnum The register number for which a name should be returned.
  */
 char const *plframe_cursor_get_regname (plframe_cursor_t *cursor, plcrash_regnum_t regnum) {
-    return plcrash_async_thread_state_get_reg_name(&cursor->frame.thread_state, regnum);
+    return plcrash_async_thread_state_get_reg_name(&plframe_cursor_get_frame(cursor)->thread_state, regnum);
 }
 
 /**
@@ -276,7 +472,7 @@ char const *plframe_cursor_get_regname (plframe_cursor_t *cursor, plcrash_regnum
  * @param cursor The target cursor.
  */
 size_t plframe_cursor_get_regcount (plframe_cursor_t *cursor) {
-    return plcrash_async_thread_state_get_reg_count(&cursor->frame.thread_state);
+    return plcrash_async_thread_state_get_reg_count(&plframe_cursor_get_frame(cursor)->thread_state);
 }
 
 /**
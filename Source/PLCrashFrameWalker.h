@@ -119,6 +119,13 @@ typedef enum  {
 typedef struct plframe_stackframe {
     /** Thread state */
     plcrash_async_thread_state_t thread_state;
+
+    /** The lowest address of the stack on which the frame resides, or 0 if the stack bounds are unknown. This is
+     * maintained by the frame cursor, and need not be initialized by frame readers. */
+    pl_vm_address_t stack_low;
+
+    /** The address immediately following the stack on which the frame resides, or 0 if the stack bounds are unknown. */
+    pl_vm_address_t stack_high;
 } plframe_stackframe_t;
 
 /**
@@ -136,11 +143,25 @@ typedef struct plframe_cursor {
      * structure should be considered uninitialized. */
     uint32_t depth;
     
-    /** The previous frame. This value is unitialized if no previous frame exists (eg, a depth of <= 1) */
-    plframe_stackframe_t prev_frame;
+    /**
+     * Frame storage. The previous, current, and next frames rotate through these slots as the cursor is stepped, such
+     * that stepping the cursor does not copy frame state; the next frame is read directly into its slot. The previous
+     * frame is unitialized if no previous frame exists (eg, a depth of <= 1). Use plframe_cursor_get_frame() to
+     * access the current frame.
+     */
+    plframe_stackframe_t frames[3];
+
+    /** The index of the current frame within @a frames. */
+    uint32_t frame_index;
+
+    /** The lowest address of the thread's stack, or 0 if unknown. See plframe_cursor_set_stack_bounds(). */
+    pl_vm_address_t stack_low;
 
-    /** The current stack frame data */
-    plframe_stackframe_t frame;
+    /** The address immediately following the thread's stack, or 0 if unknown. */
+    pl_vm_address_t stack_high;
+
+    /** Read cache used by the frame readers when fetching stack and register data from @a task. */
+    plcrash_async_task_read_cache_t stack_cache;
 } plframe_cursor_t;
 
 /**
@@ -150,6 +171,7 @@ typedef struct plframe_cursor {
  * @param image_list The list of images loaded in the target @a task.
  * @param current_frame The current stack frame.
  * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param stack_cache A read cache to be used when reading from @a task, or NULL to perform uncached reads.
  * @param next_frame The new frame to be initialized.
  *
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
@@ -158,19 +180,40 @@ typedef plframe_error_t plframe_cursor_frame_reader_t (task_t task,
                                                        plcrash_async_image_list_t *image_list,
                                                        const plframe_stackframe_t *current_frame,
                                                        const plframe_stackframe_t *previous_frame,
+                                                       plcrash_async_task_read_cache_t *stack_cache,
                                                        plframe_stackframe_t *next_frame);
 
+/**
+ * plframe_cursor_walk() flags.
+ */
+typedef enum {
+    /** Use only the frame pointer reader, skipping the compact unwind and DWARF readers. */
+    PLFRAME_WALK_FRAME_PTR_ONLY = 1 << 0
+} plframe_walk_flags_t;
+
+/**
+ * Return the current stack frame of @a cursor.
+ *
+ * @param cursor A cursor instance initialized with plframe_cursor_init().
+ */
+static inline plframe_stackframe_t *plframe_cursor_get_frame (plframe_cursor_t *cursor) {
+    return &cursor->frames[cursor->frame_index];
+}
+
 const char *plframe_strerror (plframe_error_t error);
 
 plframe_error_t plframe_cursor_init (plframe_cursor_t *cursor, task_t task, plcrash_async_thread_state_t *thread_state, plcrash_async_image_list_t *image_list);
 plframe_error_t plframe_cursor_thread_init (plframe_cursor_t *cursor, task_t task, thread_t thread, plcrash_async_image_list_t *image_list);
 
+void plframe_cursor_set_stack_bounds (plframe_cursor_t *cursor, pl_vm_address_t stack_low, pl_vm_address_t stack_high);
+
 char const *plframe_cursor_get_regname (plframe_cursor_t *cursor, plcrash_regnum_t regnum);
 size_t plframe_cursor_get_regcount (plframe_cursor_t *cursor);
 plframe_error_t plframe_cursor_get_reg (plframe_cursor_t *cursor, plcrash_regnum_t regnum, plcrash_greg_t *reg);
 
 plframe_error_t plframe_cursor_next (plframe_cursor_t *cursor);
 plframe_error_t plframe_cursor_next_with_readers (plframe_cursor_t *cursor, plframe_cursor_frame_reader_t *readers[], size_t reader_count);
+plframe_error_t plframe_cursor_walk (plframe_cursor_t *cursor, plcrash_greg_t pcs[], plcrash_greg_t sps[], plcrash_greg_t fps[], size_t max, size_t *count, uint32_t flags);
 
 void plframe_cursor_free(plframe_cursor_t *cursor);
 
@@ -35,6 +35,15 @@
 
 #import "unwind_test_harness.h"
 
+/** Number of synthetic frames generated for each unwind benchmark case. */
+#define UNWIND_BENCHMARK_DEPTH 2048
+
+/**
+ * Default number of times each synthetic stack is unwound. This may be overridden via the PLCRASH_BENCHMARK_ITERATIONS
+ * environment variable; the default favors a fast test run.
+ */
+#define UNWIND_BENCHMARK_DEFAULT_ITERATIONS 1
+
 @interface PLCrashFrameWalkerTests : SenTestCase {
 @private
     plcrash_test_thread_t _thr_args;
@@ -181,6 +190,7 @@ static plframe_error_t null_ip_reader (task_t task,
                                        plcrash_async_image_list_t *image_list,
                                        const plframe_stackframe_t *current_frame,
                                        const plframe_stackframe_t *previous_frame,
+                                       plcrash_async_task_read_cache_t *stack_cache,
                                        plframe_stackframe_t *next_frame)
 {
     plcrash_async_thread_state_copy(&next_frame->thread_state, &current_frame->thread_state);
@@ -192,6 +202,7 @@ static plframe_error_t esuccess_reader (task_t task,
                                         plcrash_async_image_list_t *image_list,
                                         const plframe_stackframe_t *current_frame,
                                         const plframe_stackframe_t *previous_frame,
+                                        plcrash_async_task_read_cache_t *stack_cache,
                                         plframe_stackframe_t *next_frame)
 {
     plcrash_async_thread_state_copy(&next_frame->thread_state, &current_frame->thread_state);
@@ -219,6 +230,67 @@ static plframe_error_t esuccess_reader (task_t task,
     
 }
 
+/**
+ * Verify that adaptive reader ordering does not change the frames returned by plframe_cursor_next().
+ */
+- (void) testAdaptiveReaderOrdering {
+    plcrash_greg_t ips[2][64];
+    size_t counts[2] = { 0, 0 };
+
+    /* Walk the test thread twice; the second walk will make use of the readers recorded by the first */
+    for (int pass = 0; pass < 2; pass++) {
+        plframe_cursor_t cursor;
+        STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_thread_init(&cursor, mach_task_self(), pthread_mach_thread_np(_thr_args.thread), &_image_list), @"Initialization failed");
+
+        while (counts[pass] < sizeof(ips[pass]) / sizeof(ips[pass][0]) && plframe_cursor_next(&cursor) == PLFRAME_ESUCCESS) {
+            STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &ips[pass][counts[pass]]), @"Could not fetch IP");
+            counts[pass]++;
+        }
+
+        plframe_cursor_free(&cursor);
+    }
+
+    STAssertEquals(counts[0], counts[1], @"Frame counts differ");
+    for (size_t i = 0; i < counts[0] && i < counts[1]; i++)
+        STAssertEquals(ips[0][i], ips[1][i], @"Frame %zu differs", i);
+}
+
+/**
+ * Verify that plframe_cursor_walk() returns the same frames as plframe_cursor_next(), and that a walk that fills
+ * its buffer may be resumed.
+ */
+- (void) testWalk {
+    plcrash_greg_t ips[64];
+    size_t ip_count = 0;
+    plframe_cursor_t cursor;
+
+    STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_thread_init(&cursor, mach_task_self(), pthread_mach_thread_np(_thr_args.thread), &_image_list), @"Initialization failed");
+    while (ip_count < sizeof(ips) / sizeof(ips[0]) && plframe_cursor_next(&cursor) == PLFRAME_ESUCCESS) {
+        STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &ips[ip_count]), @"Could not fetch IP");
+        ip_count++;
+    }
+    plframe_cursor_free(&cursor);
+    STAssertTrue(ip_count > 1, @"Too few frames walked");
+
+    /* Walk a single frame, and then the remainder */
+    plcrash_greg_t pcs[64];
+    plcrash_greg_t sps[64];
+    size_t count;
+    STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_thread_init(&cursor, mach_task_self(), pthread_mach_thread_np(_thr_args.thread), &_image_list), @"Initialization failed");
+    STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_walk(&cursor, pcs, sps, NULL, 1, &count, 0), @"Walk of a single frame failed");
+    STAssertEquals(count, (size_t) 1, @"Incorrect frame count");
+
+    size_t remaining;
+    plframe_cursor_walk(&cursor, pcs + 1, sps + 1, NULL, sizeof(pcs) / sizeof(pcs[0]) - 1, &remaining, 0);
+    plframe_cursor_free(&cursor);
+
+    STAssertEquals(count + remaining, ip_count, @"Frame counts differ");
+    for (size_t i = 0; i < ip_count && i < count + remaining; i++) {
+        STAssertEquals(pcs[i], ips[i], @"Frame %zu differs", i);
+        STAssertTrue(sps[i] != 0, @"Missing stack pointer for frame %zu", i);
+    }
+}
+
 /*
  * Perform stack walking regression tests.
  */
@@ -226,4 +298,28 @@ static plframe_error_t esuccess_reader (task_t task,
     STAssertTrue(unwind_test_harness(), @"Regression tests failed");
 }
 
+/*
+ * Benchmark each frame reader against synthetic stacks generated from the regression test frame layouts. Results are
+ * logged as ns/frame, rather than asserted, as they are highly dependent on the host; set PLCRASH_BENCHMARK_ITERATIONS
+ * to increase the number of iterations when comparing unwinder performance across revisions.
+ */
+- (void) testStackWalkerBenchmark {
+    unsigned int iterations = UNWIND_BENCHMARK_DEFAULT_ITERATIONS;
+    const char *value = getenv("PLCRASH_BENCHMARK_ITERATIONS");
+    if (value != NULL && atoi(value) > 0)
+        iterations = (unsigned int) atoi(value);
+
+    unwind_bench_result_t results[16];
+    size_t count = unwind_bench_harness(UNWIND_BENCHMARK_DEPTH, iterations, results, sizeof(results) / sizeof(results[0]));
+
+    for (size_t i = 0; i < count; i++) {
+        if (results[i].frames == 0) {
+            NSLog(@"[benchmark] unwind %s: synthetic stack could not be unwound", results[i].name);
+            continue;
+        }
+
+        NSLog(@"[benchmark] unwind %s: %.1f ns/frame (%zu frames, %u iterations)", results[i].name, results[i].ns_per_frame, results[i].frames, iterations);
+    }
+}
+
 @end
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_HANG_MONITOR_H
+#define PLCRASH_HANG_MONITOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <mach/mach.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncImageList.h"
+#include "PLCrashSampler.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_hang_monitor Main Thread Hang Monitor
+ * @ingroup plcrash_internal
+ *
+ * Implements a watchdog that detects stalls of the main thread's dispatch queue. A dedicated thread periodically
+ * enqueues a heartbeat on the main queue; if the heartbeat is not serviced within the configured threshold, the
+ * main thread's call stack is repeatedly sampled using the frame pointer fast path; each sample unwinds only the frames
+ * that changed since the previous sample. Once the main thread recovers, the buffered samples are written as a single
+ * HangReport message, as defined by profile_report.proto.
+ *
+ * No symbolication is performed when the report is written; the report carries the sampled PCs and the loaded
+ * binary images, deferring symbolication until the report is loaded.
+ *
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * Heartbeat state shared between the watchdog thread and the main queue. This is reference counted, as an
+ * outstanding heartbeat may be serviced after the monitor itself has been freed.
+ */
+typedef struct plcrash_hang_heartbeat {
+    /** Reference count. */
+    volatile int32_t refcount;
+
+    /** The sequence number of the most recently enqueued heartbeat. Only modified by the watchdog thread. */
+    volatile int64_t ping_seq;
+
+    /** The sequence number of the most recently serviced heartbeat. */
+    volatile int64_t ack_seq;
+
+    /** The mach_absolute_time() at which the most recent heartbeat was serviced. */
+    volatile uint64_t ack_time;
+} plcrash_hang_heartbeat_t;
+
+/**
+ * @internal
+ *
+ * Hang monitor state.
+ */
+typedef struct plcrash_hang_monitor {
+    /** The image list used to unwind the monitored thread. */
+    plcrash_async_image_list_t *image_list;
+
+    /** The monitored thread. */
+    thread_t thread;
+
+    /** The path to which hang reports will be written. */
+    char *path;
+
+    /** The stall duration after which the thread is considered hung, in microseconds. */
+    uint32_t threshold_usec;
+
+    /** The interval between watchdog checks, and between samples of a hung thread, in microseconds. */
+    uint32_t interval_usec;
+
+    /** The maximum number of samples recorded per hang. */
+    size_t max_samples;
+
+    /** Size of a single sample slot, in bytes. */
+    size_t _slot_size;
+
+    /** Sample storage; @a max_samples slots of @a _slot_size bytes. */
+    uint8_t *_slots;
+
+    /** The offset of each recorded sample from the start of the stall, in microseconds. */
+    uint64_t *_offsets;
+
+    /** The monitored thread's previous walk, against which each sample is captured incrementally. */
+    plcrash_sampler_history_t _history;
+
+    /** The number of samples recorded for the current hang. */
+    size_t _sample_count;
+
+    /** The heartbeat state shared with the main queue. */
+    plcrash_hang_heartbeat_t *_heartbeat;
+
+    /** The mach_absolute_time() at which the most recent heartbeat was enqueued. */
+    uint64_t _ping_time;
+
+    /** If true, a hang is in progress. */
+    bool _hung;
+
+    /** The number of hang reports written. */
+    volatile int64_t _report_count;
+
+    /** If true, the watchdog thread should continue running. */
+    volatile bool _running;
+
+    /** If true, @a _thread is valid. */
+    bool _thread_started;
+
+    /** The watchdog thread. */
+    pthread_t _thread;
+} plcrash_hang_monitor_t;
+
+plcrash_error_t plcrash_nasync_hang_monitor_init (plcrash_hang_monitor_t *monitor, plcrash_async_image_list_t *image_list, thread_t thread,
+                                                  const char *path, uint32_t threshold_usec, uint32_t interval_usec, size_t max_samples);
+plcrash_error_t plcrash_nasync_hang_monitor_start (plcrash_hang_monitor_t *monitor);
+void plcrash_nasync_hang_monitor_stop (plcrash_hang_monitor_t *monitor);
+void plcrash_nasync_hang_monitor_free (plcrash_hang_monitor_t *monitor);
+
+int64_t plcrash_hang_monitor_report_count (plcrash_hang_monitor_t *monitor);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_HANG_MONITOR_H */
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashHangMonitor.h"
+#import "PLCrashLogWriterEncoding.h"
+#import "PLCrashReportFieldIDs.h"
+
+#import <stdlib.h>
+#import <string.h>
+#import <unistd.h>
+#import <fcntl.h>
+#import <time.h>
+#import <libkern/OSAtomic.h>
+#import <mach/mach_time.h>
+#import <dispatch/dispatch.h>
+
+/**
+ * @ingroup plcrash_hang_monitor
+ * @{
+ */
+
+static void *plcrash_hang_monitor_thread (void *arg);
+
+/**
+ * @internal
+ *
+ * Release a reference to @a heartbeat, freeing it once the last reference is released.
+ */
+static void plcrash_hang_heartbeat_release (plcrash_hang_heartbeat_t *heartbeat) {
+    if (OSAtomicDecrement32Barrier(&heartbeat->refcount) == 0)
+        free(heartbeat);
+}
+
+/**
+ * @internal
+ *
+ * Heartbeat callback, executed on the main queue.
+ */
+static void plcrash_hang_heartbeat_ack (void *ctx) {
+    plcrash_hang_heartbeat_t *heartbeat = ctx;
+
+    heartbeat->ack_time = mach_absolute_time();
+    OSMemoryBarrier();
+    heartbeat->ack_seq = heartbeat->ping_seq;
+
+    plcrash_hang_heartbeat_release(heartbeat);
+}
+
+/**
+ * @internal
+ *
+ * Convert a mach_absolute_time() interval to microseconds.
+ */
+static uint64_t plcrash_hang_monitor_usec (uint64_t abs) {
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0)
+        mach_timebase_info(&timebase);
+
+    return (abs * timebase.numer) / (timebase.denom * NSEC_PER_USEC);
+}
+
+/**
+ * Initialize a new hang monitor. The monitor will not perform any checks until started via
+ * plcrash_nasync_hang_monitor_start().
+ *
+ * @param monitor The monitor to initialize.
+ * @param image_list The image list to be used when unwinding the monitored thread. This list must remain valid for
+ * the lifetime of the monitor.
+ * @param thread The thread to be sampled when a hang is detected. This must be the thread servicing the main
+ * dispatch queue.
+ * @param path The path to which hang reports will be written. Any existing report at this path will be replaced.
+ * @param threshold_usec The duration for which the main queue must be unresponsive before the thread is considered
+ * hung, in microseconds.
+ * @param interval_usec The interval between checks, and between samples of a hung thread, in microseconds.
+ * @param max_samples The maximum number of samples to record per hang. Once reached, the hang's duration continues
+ * to be tracked, but no further samples are recorded.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the sample storage can not be allocated.
+ *
+ * @warning This function is not async-safe.
+ */
+plcrash_error_t plcrash_nasync_hang_monitor_init (plcrash_hang_monitor_t *monitor, plcrash_async_image_list_t *image_list, thread_t thread,
+                                                  const char *path, uint32_t threshold_usec, uint32_t interval_usec, size_t max_samples)
+{
+    PLCF_ASSERT(interval_usec > 0);
+    PLCF_ASSERT(max_samples > 0);
+
+    memset(monitor, 0, sizeof(*monitor));
+    monitor->image_list = image_list;
+    monitor->thread = thread;
+    monitor->threshold_usec = threshold_usec;
+    monitor->interval_usec = interval_usec;
+    monitor->max_samples = max_samples;
+    monitor->_slot_size = plcrash_sampler_sample_size(PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH);
+
+    monitor->path = strdup(path);
+    monitor->_slots = calloc(max_samples, monitor->_slot_size);
+    monitor->_offsets = calloc(max_samples, sizeof(monitor->_offsets[0]));
+    monitor->_heartbeat = calloc(1, sizeof(*monitor->_heartbeat));
+    plcrash_error_t err = plcrash_nasync_sampler_history_init(&monitor->_history, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH);
+
+    if (monitor->path == NULL || monitor->_slots == NULL || monitor->_offsets == NULL || monitor->_heartbeat == NULL || err != PLCRASH_ESUCCESS) {
+        plcrash_nasync_hang_monitor_free(monitor);
+        return PLCRASH_ENOMEM;
+    }
+
+    monitor->_heartbeat->refcount = 1;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Start the watchdog thread.
+ *
+ * @param monitor The monitor to start.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if the monitor is already running, or
+ * PLCRASH_EINTERNAL if the thread could not be created.
+ *
+ * @warning This function is not async-safe, and must not be called concurrently with plcrash_nasync_hang_monitor_stop().
+ */
+plcrash_error_t plcrash_nasync_hang_monitor_start (plcrash_hang_monitor_t *monitor) {
+    if (monitor->_thread_started)
+        return PLCRASH_EINVAL;
+
+    /* A heartbeat left outstanding by a previous run must not be mistaken for a hang */
+    monitor->_ping_time = mach_absolute_time();
+    monitor->_running = true;
+    OSMemoryBarrier();
+
+    int err = pthread_create(&monitor->_thread, NULL, plcrash_hang_monitor_thread, monitor);
+    if (err != 0) {
+        PLCF_DEBUG("Could not start the hang monitor thread: %s", strerror(err));
+        monitor->_running = false;
+        return PLCRASH_EINTERNAL;
+    }
+
+    monitor->_thread_started = true;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Stop the watchdog thread, waiting for any in-progress check to complete. A hang that is in progress when the
+ * monitor is stopped will not be reported.
+ *
+ * @param monitor The monitor to stop.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_hang_monitor_stop (plcrash_hang_monitor_t *monitor) {
+    if (!monitor->_thread_started)
+        return;
+
+    monitor->_running = false;
+    OSMemoryBarrier();
+
+    pthread_join(monitor->_thread, NULL);
+    monitor->_thread_started = false;
+    monitor->_hung = false;
+}
+
+/**
+ * Stop the monitor, if running, and free all associated resources. An outstanding heartbeat retains its own
+ * reference to the shared heartbeat state, which will be freed once the heartbeat is serviced.
+ *
+ * @param monitor The monitor to free.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_hang_monitor_free (plcrash_hang_monitor_t *monitor) {
+    plcrash_nasync_hang_monitor_stop(monitor);
+
+    if (monitor->_heartbeat != NULL) {
+        plcrash_hang_heartbeat_release(monitor->_heartbeat);
+        monitor->_heartbeat = NULL;
+    }
+
+    free(monitor->path);
+    free(monitor->_slots);
+    free(monitor->_offsets);
+    plcrash_nasync_sampler_history_free(&monitor->_history);
+
+    monitor->path = NULL;
+    monitor->_slots = NULL;
+    monitor->_offsets = NULL;
+}
+
+/**
+ * Return the total number of hang reports written by @a monitor.
+ *
+ * @param monitor The monitor to query.
+ */
+int64_t plcrash_hang_monitor_report_count (plcrash_hang_monitor_t *monitor) {
+    OSMemoryBarrier();
+    return monitor->_report_count;
+}
+
+/**
+ * @internal
+ *
+ * Return the recorded sample at @a index.
+ */
+static plcrash_sampler_sample_t *plcrash_hang_monitor_slot (plcrash_hang_monitor_t *monitor, size_t index) {
+    return (plcrash_sampler_sample_t *) (monitor->_slots + (index * monitor->_slot_size));
+}
+
+/**
+ * @internal
+ *
+ * Write a HangReport.Sample message.
+ *
+ * @param file Output file, or NULL to compute the message size.
+ * @param sample The sample.
+ * @param offset The sample's offset from the start of the stall, in microseconds.
+ */
+static size_t plcrash_hang_monitor_write_sample (plcrash_async_file_t *file, const plcrash_sampler_sample_t *sample, uint64_t offset) {
+    size_t rv = 0;
+
+    for (uint32_t i = 0; i < sample->depth; i++)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_HANG_SAMPLE_PC_ID, PLPROTOBUF_C_TYPE_UINT64, &sample->pcs[i]);
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_HANG_SAMPLE_OFFSET_ID, PLPROTOBUF_C_TYPE_UINT64, &offset);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the samples recorded for the most recent hang to the monitor's report path. The report is written to a
+ * temporary file and then renamed into place, ensuring that a partially written report is never observed.
+ *
+ * @param monitor The monitor.
+ * @param duration_usec The total duration of the hang, in microseconds.
+ */
+static void plcrash_hang_monitor_write_report (plcrash_hang_monitor_t *monitor, uint64_t duration_usec) {
+    plcrash_async_file_t file;
+    char *tmp_path;
+
+    if (asprintf(&tmp_path, "%s.tmp", monitor->path) < 0) {
+        PLCF_DEBUG("Could not allocate the hang report path");
+        return;
+    }
+
+    int fd = open(tmp_path, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0) {
+        PLCF_DEBUG("Could not open hang report %s: %s", tmp_path, strerror(errno));
+        free(tmp_path);
+        return;
+    }
+
+    plcrash_async_file_init(&file, fd, 0);
+
+    /* Header fields */
+    uint64_t threshold = monitor->threshold_usec;
+    uint64_t timestamp = (uint64_t) time(NULL) - (duration_usec / USEC_PER_SEC);
+    plcrash_writer_pack(&file, PLCRASH_PROTO_HANG_DURATION_ID, PLPROTOBUF_C_TYPE_UINT64, &duration_usec);
+    plcrash_writer_pack(&file, PLCRASH_PROTO_HANG_THRESHOLD_ID, PLPROTOBUF_C_TYPE_UINT64, &threshold);
+    plcrash_writer_pack(&file, PLCRASH_PROTO_HANG_TIMESTAMP_ID, PLPROTOBUF_C_TYPE_UINT64, &timestamp);
+
+    /* Samples, in the order they were recorded */
+    for (size_t i = 0; i < monitor->_sample_count; i++) {
+        plcrash_sampler_sample_t *sample = plcrash_hang_monitor_slot(monitor, i);
+
+        uint32_t size = (uint32_t) plcrash_hang_monitor_write_sample(NULL, sample, monitor->_offsets[i]);
+        plcrash_writer_pack(&file, PLCRASH_PROTO_HANG_SAMPLES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_hang_monitor_write_sample(&file, sample, monitor->_offsets[i]);
+    }
+
+    /* Binary images */
+    plcrash_nasync_sampler_write_images(monitor->image_list, &file);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    if (rename(tmp_path, monitor->path) != 0) {
+        PLCF_DEBUG("Could not move hang report into place: %s", strerror(errno));
+        unlink(tmp_path);
+    } else {
+        OSAtomicIncrement64Barrier(&monitor->_report_count);
+    }
+
+    free(tmp_path);
+}
+
+/**
+ * @internal
+ *
+ * Perform a single watchdog check. If the outstanding heartbeat has not been serviced within the threshold, the
+ * monitored thread is sampled; otherwise, any completed hang is reported, and a new heartbeat is enqueued.
+ */
+static void plcrash_hang_monitor_check (plcrash_hang_monitor_t *monitor) {
+    plcrash_hang_heartbeat_t *heartbeat = monitor->_heartbeat;
+    uint64_t now = mach_absolute_time();
+
+    OSMemoryBarrier();
+    if (heartbeat->ack_seq != heartbeat->ping_seq) {
+        /* Heartbeat is outstanding */
+        uint64_t stalled = plcrash_hang_monitor_usec(now - monitor->_ping_time);
+        if (stalled < monitor->threshold_usec)
+            return;
+
+        if (!monitor->_hung) {
+            monitor->_hung = true;
+            monitor->_sample_count = 0;
+        }
+
+        /* Record the next sample, using only the frame pointer reader */
+        if (monitor->_sample_count < monitor->max_samples) {
+            plcrash_sampler_sample_t *sample = plcrash_hang_monitor_slot(monitor, monitor->_sample_count);
+            if (plcrash_sampler_sample_thread_incremental(monitor->image_list, monitor->thread, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, false, &monitor->_history, sample)) {
+                monitor->_offsets[monitor->_sample_count] = stalled;
+                monitor->_sample_count++;
+            }
+        }
+
+        return;
+    }
+
+    /* The heartbeat was serviced; report the hang, if any */
+    if (monitor->_hung) {
+        OSMemoryBarrier();
+        uint64_t duration = plcrash_hang_monitor_usec(heartbeat->ack_time - monitor->_ping_time);
+        plcrash_hang_monitor_write_report(monitor, duration);
+        monitor->_hung = false;
+    }
+
+    /* Enqueue the next heartbeat. The enqueued callback holds its own reference to the heartbeat state. */
+    monitor->_ping_time = now;
+    OSAtomicIncrement32(&heartbeat->refcount);
+    heartbeat->ping_seq++;
+    OSMemoryBarrier();
+
+    dispatch_async_f(dispatch_get_main_queue(), heartbeat, plcrash_hang_heartbeat_ack);
+}
+
+/**
+ * @internal
+ *
+ * Watchdog thread entry point.
+ */
+static void *plcrash_hang_monitor_thread (void *arg) {
+    plcrash_hang_monitor_t *monitor = arg;
+
+    while (monitor->_running) {
+        plcrash_hang_monitor_check(monitor);
+        usleep(monitor->interval_usec);
+    }
+
+    return NULL;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashHangMonitor.h"
+
+#import <mach-o/dyld.h>
+
+@interface PLCrashHangMonitorTests : SenTestCase {
+@private
+    /** The image list used for unwinding. */
+    plcrash_async_image_list_t _image_list;
+}
+@end
+
+@implementation PLCrashHangMonitorTests
+
+- (void) setUp {
+    plcrash_nasync_image_list_init(&_image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&_image_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+}
+
+- (void) tearDown {
+    plcrash_nasync_image_list_free(&_image_list);
+}
+
+/**
+ * Test that stalling the main thread produces a single hang report once the main thread recovers.
+ */
+- (void) testReportHang {
+    plcrash_hang_monitor_t monitor;
+
+    /* The heartbeat is serviced by the main queue */
+    if (![NSThread isMainThread]) {
+        NSLog(@"Skipping hang monitor test; tests are not running on the main thread");
+        return;
+    }
+
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]];
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_hang_monitor_init(&monitor, &_image_list, pl_mach_thread_self(), [path fileSystemRepresentation], 50000, 5000, 8), @"Failed to initialize monitor");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_hang_monitor_start(&monitor), @"Failed to start monitor");
+
+    /* Stall the main thread past the threshold */
+    usleep(200000);
+    STAssertEquals((int64_t) 0, plcrash_hang_monitor_report_count(&monitor), @"Report written before the hang ended");
+
+    /* Service the main queue until the report is written */
+    for (int i = 0; i < 200 && plcrash_hang_monitor_report_count(&monitor) == 0; i++)
+        [[NSRunLoop currentRunLoop] runUntilDate: [NSDate dateWithTimeIntervalSinceNow: 0.01]];
+
+    plcrash_nasync_hang_monitor_stop(&monitor);
+    STAssertEquals((int64_t) 1, plcrash_hang_monitor_report_count(&monitor), @"Hang was not reported");
+
+    NSData *data = [NSData dataWithContentsOfFile: path];
+    STAssertTrue([data length] > 0, @"No report data was written");
+
+    [[NSFileManager defaultManager] removeItemAtPath: path error: NULL];
+    plcrash_nasync_hang_monitor_free(&monitor);
+}
+
+@end
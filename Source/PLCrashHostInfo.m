@@ -97,11 +97,12 @@ error:
 
     /* Extract the Darwin version */
     {
-        /* This should never fail; if it does, either malloc failed, or 'kern.osrelease' disappeared. */
-        char *val = plcrash_sysctl_string("kern.osrelease");
-        NSAssert(val != NULL, @"Failed to fetch kern.osrelease value %d: %s", errno, strerror(errno));
+        /* This should never fail; if it does, either malloc failed, or 'kern.osrelease' disappeared. The value
+         * is fetched once per process, and is shared across all instances. */
+        const char *val = plcrash_sysctl_host_info()->os_release;
+        NSAssert(val != NULL, @"Failed to fetch kern.osrelease value");
 
-        NSString *osrelease = [[NSString alloc] initWithBytesNoCopy: val length: strlen(val) encoding: NSUTF8StringEncoding freeWhenDone: YES];
+        NSString *osrelease = [NSString stringWithUTF8String: val];
         parse_osrelease(osrelease, &_darwinVersion);
     }
 
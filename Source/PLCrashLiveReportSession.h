@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <mach/mach.h>
+
+@class PLCrashReport;
+
+@interface PLCrashLiveReportSession : NSObject {
+@private
+    /** The report writer, initialized once and reused for all reports. */
+    struct plcrash_log_writer *_writer;
+
+    /** The symbol cache shared by all reports written by @a _writer. */
+    struct plcrash_async_symbol_cache *_symbolCache;
+
+    /** The report compressor, or NULL if compression is disabled. */
+    struct plcrash_async_compressor *_compressor;
+
+    /** The image list used to write reports. Not owned by the session. */
+    struct plcrash_async_image_list *_imageList;
+
+    /** The async file output buffer. */
+    void *_outputBuffer;
+
+    /** The maximum report size, in bytes. */
+    off_t _outputLimit;
+
+    /** The growable in-memory report buffer, reused for each report. */
+    NSMutableData *_reportData;
+}
+
+- (NSData *) generateLiveReportWithThread: (thread_t) thread error: (NSError **) outError;
+- (NSData *) generateLiveReportAndReturnError: (NSError **) outError;
+- (NSData *) generateLiveReportForThreads: (const thread_t *) threads count: (mach_msg_type_number_t) count error: (NSError **) outError;
+
+- (PLCrashReport *) generateLiveCrashReportWithThread: (thread_t) thread error: (NSError **) outError;
+- (PLCrashReport *) generateLiveCrashReportAndReturnError: (NSError **) outError;
+
+@end
@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashLiveReportSession.h"
+#import "CrashReporter.h"
+
+#import "PLCrashAsync.h"
+#import "PLCrashAsyncCompressor.h"
+#import "PLCrashLogWriter.h"
+#import "PLCrashReporterNSError.h"
+
+/** Size of the async file output buffer used by each session. */
+#define PLCRASH_LIVE_REPORT_OUTPUT_BUFFER_SIZE (16 * 1024)
+
+/* Appends all output to the session's NSMutableData report buffer */
+static bool plcr_live_report_session_sink (const void *data, size_t len, void *ctx) {
+    NSMutableData *reportData = ctx;
+    [reportData appendBytes: data length: len];
+    return true;
+}
+
+/* State and callback used by -generateLiveReportWithThread:error: */
+struct plcr_live_report_session_context {
+    plcrash_log_writer_t *writer;
+    thread_t crashed_thread;
+    plcrash_async_image_list_t *image_list;
+    plcrash_async_file_t *file;
+    plcrash_log_signal_info_t *info;
+};
+static plcrash_error_t plcr_live_report_session_callback (plcrash_async_thread_state_t *state, void *ctx) {
+    struct plcr_live_report_session_context *plcr_ctx = ctx;
+    return plcrash_log_writer_write(plcr_ctx->writer, plcr_ctx->crashed_thread, plcr_ctx->image_list, plcr_ctx->file, plcr_ctx->info, state);
+}
+
+/**
+ * A reusable live report generator, as returned by PLCrashReporter::liveReportSessionAndReturnError:.
+ *
+ * The session's report writer, symbol cache, and report buffer are initialized once, and reused for each
+ * generated report; reports are written directly to memory. This avoids the setup cost and temporary file I/O
+ * otherwise incurred by every call to PLCrashReporter::generateLiveReportWithThread:error:, and is intended for use
+ * by clients that generate live reports repeatedly.
+ *
+ * The process and host information written to each report is fetched when the session is created. Reports may be
+ * generated from any thread; concurrent calls are serialized.
+ */
+@implementation PLCrashLiveReportSession
+
+/**
+ * @internal
+ *
+ * Initialize a new live report session.
+ *
+ * @param applicationIdentifier The application identifier to be written to reports.
+ * @param applicationVersion The application version to be written to reports.
+ * @param symbolStrategies The symbolication strategies to be used when writing reports, indexed by
+ * plcrash_async_image_class_t.
+ * @param configuration The reporter configuration.
+ * @param imageList The image list used to write reports. The list must remain valid for the lifetime of the session.
+ * @param outputLimit The maximum report size, in bytes.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the session could not be created.
+ */
+- (id) initWithApplicationIdentifier: (NSString *) applicationIdentifier
+                          appVersion: (NSString *) applicationVersion
+                    symbolStrategies: (const plcrash_async_symbol_strategy_t *) symbolStrategies
+                       configuration: (PLCrashReporterConfig *) configuration
+                           imageList: (plcrash_async_image_list_t *) imageList
+                         outputLimit: (off_t) outputLimit
+                               error: (NSError **) outError
+{
+    plcrash_error_t err;
+
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _imageList = imageList;
+    _outputLimit = outputLimit;
+    _reportData = [[NSMutableData alloc] init];
+
+    /* Set up the output buffer and shared symbol cache */
+    _outputBuffer = malloc(PLCRASH_LIVE_REPORT_OUTPUT_BUFFER_SIZE);
+    _symbolCache = malloc(sizeof(plcrash_async_symbol_cache_t));
+    if (_outputBuffer == NULL || _symbolCache == NULL) {
+        free(_symbolCache);
+        _symbolCache = NULL;
+
+        plcrash_populate_posix_error(outError, ENOMEM, @"Could not allocate the live report session");
+        goto error;
+    }
+
+    if ((err = plcrash_async_symbol_cache_init(_symbolCache)) != PLCRASH_ESUCCESS) {
+        free(_symbolCache);
+        _symbolCache = NULL;
+
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not initialize the symbol cache", nil);
+        goto error;
+    }
+
+    /* Initialize the writer */
+    _writer = malloc(sizeof(plcrash_log_writer_t));
+    if (_writer == NULL) {
+        plcrash_populate_posix_error(outError, ENOMEM, @"Could not allocate the live report session");
+        goto error;
+    }
+
+    if ((err = plcrash_log_writer_init(_writer, applicationIdentifier, applicationVersion, symbolStrategies[PLCRASH_ASYNC_IMAGE_CLASS_MAIN_EXECUTABLE], true)) != PLCRASH_ESUCCESS) {
+        plcrash_log_writer_free(_writer);
+        free(_writer);
+        _writer = NULL;
+
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not initialize the crash log writer", nil);
+        goto error;
+    }
+
+    plcrash_log_writer_set_symbol_cache(_writer, _symbolCache);
+    for (size_t i = 0; i < PLCRASH_ASYNC_IMAGE_CLASS_COUNT; i++)
+        plcrash_log_writer_set_image_symbol_strategy(_writer, (plcrash_async_image_class_t) i, symbolStrategies[i]);
+    plcrash_log_writer_enable_symbol_pc_cache(_writer, PLCRASH_LOG_WRITER_SYMBOL_PC_CACHE_DEFAULT_COUNT);
+    plcrash_log_writer_set_fast_capture(_writer, configuration.threadCaptureMode == PLCrashReporterThreadCaptureModeFramePointer);
+    if (configuration.reportFormat >= PLCrashReporterReportFormatSymbolTable)
+        plcrash_log_writer_enable_symbol_table(_writer);
+    if (configuration.reportFormat >= PLCrashReporterReportFormatPackedRegisters)
+        plcrash_log_writer_enable_packed_registers(_writer);
+    if (configuration.reportFormat >= PLCrashReporterReportFormatPackedFrames)
+        plcrash_log_writer_enable_packed_frames(_writer);
+    if (configuration.reportFormat >= PLCrashReporterReportFormatDeduplicatedThreads)
+        plcrash_log_writer_enable_thread_deduplication(_writer);
+    if (configuration.instrumentationEnabled)
+        plcrash_log_writer_enable_instrumentation(_writer);
+    if (configuration.stackMemoryCaptureSize > 0)
+        plcrash_log_writer_enable_stack_memory(_writer, configuration.stackMemoryCaptureSize, (uint32_t) configuration.stackMemoryThreadCount);
+    if (configuration.registerMemoryCaptureSize > 0)
+        plcrash_log_writer_enable_register_memory(_writer, configuration.registerMemoryCaptureSize);
+    if (configuration.vmRegionSummaryLimit > 0)
+        plcrash_log_writer_enable_vm_region_summary(_writer, (uint32_t) MIN(configuration.vmRegionSummaryLimit, UINT32_MAX), PLCRASH_LOG_WRITER_VM_REGION_SUMMARY_DEFAULT_BUDGET_NS);
+    if (configuration.threadRegistryCapacity > 0) {
+        plcrash_async_thread_registry_t *registry;
+        if (plcrash_nasync_thread_registry_install((uint32_t) MIN(configuration.threadRegistryCapacity, UINT32_MAX), &registry) == PLCRASH_ESUCCESS)
+            plcrash_log_writer_set_thread_registry(_writer, registry);
+    }
+    plcrash_log_writer_set_prioritized_output(_writer, configuration.prioritizedOutputEnabled);
+    plcrash_log_writer_set_max_threads(_writer, (uint32_t) MIN(configuration.maxThreadCount, UINT32_MAX));
+    if (configuration.maxThreadFrameCount > 0)
+        plcrash_log_writer_set_max_thread_frames(_writer, (uint32_t) MIN(configuration.maxThreadFrameCount, UINT32_MAX));
+    if (!configuration.fullImageListEnabled)
+        plcrash_log_writer_enable_referenced_images(_writer);
+    if (configuration.symbolicationPipelineEnabled)
+        plcrash_log_writer_enable_symbolication_pipeline(_writer);
+
+    /* Compression is best-effort */
+    if (configuration.reportCompression == PLCrashReporterReportCompressionLZ4)
+        _compressor = malloc(sizeof(plcrash_async_compressor_t));
+
+    return self;
+
+error:
+    [self release];
+    return nil;
+}
+
+/**
+ * @internal
+ *
+ * Set the breadcrumb ring whose contents will be included in the session's reports.
+ *
+ * @param ring The breadcrumb ring, or NULL. The ring must remain valid for the lifetime of the session.
+ */
+- (void) setBreadcrumbRing: (plcrash_breadcrumb_ring_t *) ring {
+    plcrash_log_writer_set_breadcrumbs(_writer, ring);
+}
+
+/**
+ * @internal
+ *
+ * Set the custom data registry whose regions will be included in the session's reports.
+ *
+ * @param registry The custom data registry, or NULL. The registry must remain valid for the lifetime of the session.
+ */
+- (void) setCustomDataRegistry: (plcrash_custom_data_registry_t *) registry {
+    plcrash_log_writer_set_custom_data(_writer, registry);
+}
+
+/**
+ * @internal
+ *
+ * Set the image manifest to be referenced by the session's reports.
+ *
+ * @param manifest The image manifest, or NULL. The manifest must remain valid for the lifetime of the session.
+ */
+- (void) setImageManifest: (plcrash_log_writer_image_manifest_t *) manifest {
+    plcrash_log_writer_set_image_manifest(_writer, manifest);
+}
+
+- (void) dealloc {
+    if (_writer != NULL) {
+        plcrash_log_writer_free(_writer);
+        free(_writer);
+    }
+
+    if (_symbolCache != NULL) {
+        plcrash_async_symbol_cache_free(_symbolCache);
+        free(_symbolCache);
+    }
+
+    free(_compressor);
+    free(_outputBuffer);
+    [_reportData release];
+
+    [super dealloc];
+}
+
+/**
+ * Write a live crash report for a given @a thread to the session's report buffer. The caller must hold the session's
+ * lock until it is finished with the buffer's contents.
+ *
+ * @param thread The thread which will be marked as the failing thread in the generated report.
+ * @param threads The threads to be written, or NULL to write all threads.
+ * @param count The number of entries in @a threads.
+ * @param compressed If YES, the report will be compressed if the session's configuration enables compression.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the crash report could not be generated.
+ *
+ * @return Returns YES on success, or NO if the report could not be generated.
+ */
+- (BOOL) writeLiveReportWithThread: (thread_t) thread
+                           threads: (const thread_t *) threads
+                             count: (mach_msg_type_number_t) count
+                        compressed: (BOOL) compressed
+                             error: (NSError **) outError
+{
+    plcrash_async_file_t file;
+    plcrash_error_t err;
+
+    /* Ensure that all images have been loaded */
+    plcrash_nasync_image_list_load_deferred(_imageList);
+
+    /* Reset the report buffer, retaining its allocated capacity */
+    [_reportData setLength: 0];
+    plcrash_async_file_init_sink(&file, plcr_live_report_session_sink, _reportData, _outputLimit, _outputBuffer, PLCRASH_LIVE_REPORT_OUTPUT_BUFFER_SIZE);
+    if (compressed && _compressor != NULL && !plcrash_async_file_set_compressor(&file, _compressor)) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to write the crash report header", nil);
+        return NO;
+    }
+
+    /* Mock up a SIGTRAP-based signal info */
+    plcrash_log_bsd_signal_info_t bsd_signal_info;
+    plcrash_log_signal_info_t signal_info;
+    bsd_signal_info.signo = SIGTRAP;
+    bsd_signal_info.code = TRAP_TRACE;
+    bsd_signal_info.address = __builtin_return_address(0);
+
+    signal_info.bsd_info = &bsd_signal_info;
+    signal_info.mach_info = NULL;
+
+    /* The current thread's state must be captured if it is marked as the failing thread, or is otherwise requested */
+    BOOL captureCurrentThread = (thread == pl_mach_thread_self());
+    for (mach_msg_type_number_t i = 0; i < count; i++) {
+        if (threads[i] == pl_mach_thread_self())
+            captureCurrentThread = YES;
+    }
+
+    /* Write the crash log using the session's writer */
+    plcrash_log_writer_set_thread_subset(_writer, threads, count);
+    if (captureCurrentThread) {
+        struct plcr_live_report_session_context ctx = {
+            .writer = _writer,
+            .crashed_thread = thread,
+            .image_list = _imageList,
+            .file = &file,
+            .info = &signal_info
+        };
+        err = plcrash_async_thread_state_current(plcr_live_report_session_callback, &ctx);
+    } else {
+        err = plcrash_log_writer_write(_writer, thread, _imageList, &file, &signal_info, NULL);
+    }
+    plcrash_log_writer_set_thread_subset(_writer, NULL, 0);
+    plcrash_log_writer_close(_writer);
+
+    /* Flush the data */
+    if (!plcrash_async_file_close(&file) && err == PLCRASH_ESUCCESS)
+        err = PLCRASH_OUTPUT_ERR;
+
+    if (err != PLCRASH_ESUCCESS) {
+        NSLog(@"Write failed with error %s", plcrash_async_strerror(err));
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to write the crash report", nil);
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ * Generate a live crash report for a given @a thread, without triggering an actual crash condition.
+ *
+ * @param thread The thread which will be marked as the failing thread in the generated report.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report data could not be generated.
+ */
+- (NSData *) generateLiveReportWithThread: (thread_t) thread error: (NSError **) outError {
+    @synchronized (self) {
+        if (![self writeLiveReportWithThread: thread threads: NULL count: 0 compressed: YES error: outError])
+            return nil;
+
+        /* The report buffer is reused; return a copy */
+        return [NSData dataWithData: _reportData];
+    }
+}
+
+/**
+ * Generate a live crash report containing only the given @a threads, without triggering an actual crash condition.
+ *
+ * Only the listed threads are suspended and walked, and only the images referenced by their frames (along with the
+ * main executable) are written; the cost of the report scales with the number of threads requested, rather than
+ * with the number of threads in the process. This may be used for targeted diagnostics, such as capturing a stuck
+ * worker thread.
+ *
+ * @param threads The threads to be written, in order. The first thread will be marked as the failing thread in the
+ * generated report. The current thread may be included.
+ * @param count The number of entries in @a threads. Must be non-zero.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report data could not be generated.
+ */
+- (NSData *) generateLiveReportForThreads: (const thread_t *) threads count: (mach_msg_type_number_t) count error: (NSError **) outError {
+    if (threads == NULL || count == 0) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"No threads were specified for the live report", nil);
+        return nil;
+    }
+
+    @synchronized (self) {
+        if (![self writeLiveReportWithThread: threads[0] threads: threads count: count compressed: YES error: outError])
+            return nil;
+
+        /* The report buffer is reused; return a copy */
+        return [NSData dataWithData: _reportData];
+    }
+}
+
+/**
+ * Generate a live crash report for a given @a thread, without triggering an actual crash condition, and return the
+ * decoded report.
+ *
+ * This is equivalent to decoding the result of PLCrashLiveReportSession::generateLiveReportWithThread:error:, but
+ * the report is decoded directly from the session's reused report buffer: the report is never compressed, and the
+ * encoded report is never copied.
+ *
+ * @param thread The thread which will be marked as the failing thread in the generated report.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report could not be generated.
+ */
+- (PLCrashReport *) generateLiveCrashReportWithThread: (thread_t) thread error: (NSError **) outError {
+    @synchronized (self) {
+        if (![self writeLiveReportWithThread: thread threads: NULL count: 0 compressed: NO error: outError])
+            return nil;
+
+        /* All decoded values are copied from the buffer; it may be reused once the report has been initialized */
+        return [[[PLCrashReport alloc] initWithData: _reportData error: outError] autorelease];
+    }
+}
+
+/**
+ * Generate a live crash report for the current thread, without triggering an actual crash condition.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report data could not be generated.
+ */
+- (NSData *) generateLiveReportAndReturnError: (NSError **) outError {
+    return [self generateLiveReportWithThread: pl_mach_thread_self() error: outError];
+}
+
+/**
+ * Generate a live crash report for the current thread, without triggering an actual crash condition, and return
+ * the decoded report. See PLCrashLiveReportSession::generateLiveCrashReportWithThread:error:.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report could not be generated.
+ */
+- (PLCrashReport *) generateLiveCrashReportAndReturnError: (NSError **) outError {
+    return [self generateLiveCrashReportWithThread: pl_mach_thread_self() error: outError];
+}
+
+@end
@@ -39,8 +39,12 @@ extern "C" {
 #import "PLCrashAsync.h"
 #import "PLCrashAsyncImageList.h"
 #import "PLCrashFrameWalker.h"
+#import "PLCrashAsyncAllocator.h"
     
 #import "PLCrashAsyncSymbolication.h"
+#import "PLCrashBreadcrumbRing.h"
+#import "PLCrashCustomData.h"
+#import "PLCrashAsyncThreadRegistry.h"
 
 #include <uuid/uuid.h>
 
@@ -70,15 +74,144 @@ typedef struct user_info_t {
     BOOL archive;
 } user_info_t;
 
+/**
+ * @internal
+ * Maximum number of worker threads supported by plcrash_log_writer_enable_parallel_capture().
+ */
+#define PLCRASH_LOG_WRITER_CAPTURE_WORKERS_MAX 4
+
+/**
+ * @internal
+ * Default number of entries in the per-PC symbol result cache. See plcrash_log_writer_enable_symbol_pc_cache().
+ */
+#define PLCRASH_LOG_WRITER_SYMBOL_PC_CACHE_DEFAULT_COUNT 256
+
+/**
+ * @internal
+ * Default time budget for VM region enumeration, in nanoseconds. See plcrash_log_writer_enable_vm_region_summary().
+ */
+#define PLCRASH_LOG_WRITER_VM_REGION_SUMMARY_DEFAULT_BUDGET_NS (10ULL * 1000 * 1000)
+
+/**
+ * @internal
+ *
+ * A VM region recorded by the VM region summary. See plcrash_log_writer_enable_vm_region_summary().
+ */
+typedef struct plcrash_log_writer_vm_region {
+    /** The region's start address. */
+    uint64_t address;
+
+    /** The region's size, in bytes. */
+    uint64_t size;
+
+    /** The region's protection, as (max_protection << 4) | protection. */
+    uint32_t protection;
+
+    /** The region's user tag (eg, VM_MEMORY_MALLOC). */
+    uint32_t user_tag;
+
+    /** The region's share mode (eg, SM_PRIVATE). */
+    uint32_t share_mode;
+} plcrash_log_writer_vm_region_t;
+
+/**
+ * @internal
+ * Maximum number of additional crashed threads that may be recorded via plcrash_log_writer_add_secondary_crash().
+ */
+#define PLCRASH_LOG_WRITER_SECONDARY_CRASH_MAX 8
+
+/**
+ * @internal
+ *
+ * A thread that crashed while the report for another crashed thread was being generated.
+ */
+typedef struct plcrash_log_writer_secondary_crash {
+    /** Non-zero once @a thread and @a thread_state have been populated. */
+    volatile int32_t ready;
+
+    /** The crashed thread. */
+    thread_t thread;
+
+    /** The thread's state at the time of its crash. */
+    plcrash_async_thread_state_t thread_state;
+} plcrash_log_writer_secondary_crash_t;
+
+/**
+ * @internal
+ *
+ * The maximum number of a manifest's images that may have been unloaded for a report to reference the manifest. If
+ * more images have been removed, all images are written to the report.
+ */
+#define PLCRASH_LOG_WRITER_MANIFEST_REMOVED_MAX 64
+
+/**
+ * @internal
+ *
+ * A binary image manifest, recording the images that were loaded when the manifest was generated. Reports written with
+ * a manifest reference it by identifier, and omit its images. See plcrash_log_writer_image_manifest_create().
+ */
+typedef struct plcrash_log_writer_image_manifest {
+    /** The manifest identifier; the FNV-1a hash of the manifest's encoded ImageManifest message. */
+    uint64_t identifier;
+
+    /** The number of entries in @a headers. */
+    size_t count;
+
+    /** The header addresses of the manifest's images, in ascending order. */
+    pl_vm_address_t *headers;
+} plcrash_log_writer_image_manifest_t;
+
+/**
+ * @internal
+ *
+ * Streaming report flush points. When streaming is enabled via plcrash_log_writer_set_streaming(), the
+ * output file will be flushed after each enabled point is reached, ensuring that all messages written
+ * prior to that point are recoverable if the process is terminated before the report is completed.
+ */
+typedef enum {
+    /** Flush after the report header, system, machine, application, process, exception and signal messages. */
+    PLCRASH_LOG_WRITER_FLUSH_HEADER = 1 << 0,
+
+    /** Flush after the crashed thread. */
+    PLCRASH_LOG_WRITER_FLUSH_CRASHED_THREAD = 1 << 1,
+
+    /** Flush after each non-crashed thread. */
+    PLCRASH_LOG_WRITER_FLUSH_THREAD = 1 << 2,
+
+    /** Flush after the binary images. */
+    PLCRASH_LOG_WRITER_FLUSH_IMAGES = 1 << 3,
+
+    /** Flush at all flush points. */
+    PLCRASH_LOG_WRITER_FLUSH_ALL = (PLCRASH_LOG_WRITER_FLUSH_HEADER|PLCRASH_LOG_WRITER_FLUSH_CRASHED_THREAD|
+                                    PLCRASH_LOG_WRITER_FLUSH_THREAD|PLCRASH_LOG_WRITER_FLUSH_IMAGES),
+
+    /**
+     * Not a flush point. If set, the output is also synchronized to the storage device via fsync() at each enabled
+     * flush point, so that the checkpointed messages survive a kernel panic or loss of power, rather than only the
+     * termination of the process.
+     */
+    PLCRASH_LOG_WRITER_FLUSH_SYNC = 1 << 4
+} plcrash_log_writer_flush_point_t;
+
 /**
  * @internal
  *
  * Crash log writer context.
  */
 typedef struct plcrash_log_writer {
+    /**
+     * The task for which reports are written. Defaults to the current task; see
+     * plcrash_log_writer_set_target_task().
+     */
+    task_t task;
+
     /** The strategy to use for symbolication */
     plcrash_async_symbol_strategy_t symbol_strategy;
 
+    /** The strategy to use for symbolication of each plcrash_async_image_class_t. Each defaults to
+     * @a symbol_strategy; see plcrash_log_writer_set_image_symbol_strategy(). */
+    plcrash_async_symbol_strategy_t image_symbol_strategy[PLCRASH_ASYNC_IMAGE_CLASS_COUNT];
+
     /** Report data */
     struct {
         /** If true, the report should be marked as a 'generated' user-requested report, rather than as a true crash
@@ -166,12 +299,255 @@ typedef struct plcrash_log_writer {
         /** Call stack frame count, or 0 if the call stack is unavailable */
         size_t callstack_count;
 
+        /**
+         * The call stack frames, symbolicated once per report prior to writing the exception message, or NULL if
+         * the call stack is unavailable or the buffer could not be allocated.
+         */
+        struct plcrash_log_writer_thread_buffer *frame_buffer;
+
         /** Fields for each key/value pair in the @a userInfo dictionary. */
         user_info_t *user_info;
 
         /** Number of @a userInfo dictionary pairs. */
         size_t user_info_size;
     } uncaught_exception;
+
+    /**
+     * Allocator backing @a thread_buffer, or NULL if the allocation failed. The allocation is performed
+     * by plcrash_log_writer_init(), as it is not async-safe.
+     */
+    plcrash_async_allocator_t *allocator;
+
+    /**
+     * Preallocated buffer used to unwind and symbolicate each thread exactly once when writing a report, or NULL
+     * if unavailable. If NULL, each thread will be unwound twice; once to determine the message size, and once more
+     * to serialize the message.
+     */
+    struct plcrash_log_writer_thread_buffer *thread_buffer;
+
+    /**
+     * The symbol name table, or NULL if disabled. If non-NULL, reports are written in the
+     * PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE format, with each symbol name written once per report.
+     */
+    struct plcrash_log_writer_symbol_table *symbol_table;
+
+    /**
+     * The set of images referenced by the current report's frames, or NULL if all images are written. See
+     * plcrash_log_writer_enable_referenced_images().
+     */
+    struct plcrash_log_writer_image_set *referenced_images;
+
+    /**
+     * Parallel thread capture pool, or NULL if parallel capture has not been enabled via
+     * plcrash_log_writer_enable_parallel_capture().
+     */
+    struct plcrash_log_writer_capture_pool *capture_pool;
+
+    /**
+     * Symbolication helper for live reports, or NULL if the pipeline has not been enabled via
+     * plcrash_log_writer_enable_symbolication_pipeline().
+     */
+    struct plcrash_log_writer_symbolication_pipeline *symbolication_pipeline;
+
+    /** The breadcrumb ring whose contents are written to each report, or NULL. See plcrash_log_writer_set_breadcrumbs(). */
+    plcrash_breadcrumb_ring_t *breadcrumbs;
+
+    /** The custom data regions written to each report, or NULL. See plcrash_log_writer_set_custom_data(). */
+    plcrash_custom_data_registry_t *custom_data;
+
+    /** The image manifest referenced by each report, or NULL. See plcrash_log_writer_set_image_manifest(). */
+    plcrash_log_writer_image_manifest_t * volatile image_manifest;
+
+    /**
+     * If true, the report will be written in streaming order: the header and termination messages, followed by the
+     * crashed thread, the remaining threads, and finally the binary images.
+     */
+    bool streaming;
+
+    /** The plcrash_log_writer_flush_point_t flush points to be used when @a streaming is enabled. */
+    uint32_t flush_points;
+
+    /**
+     * If true, non-crashed threads are unwound using only frame pointers, and their frames are written without
+     * symbols. The crashed thread is always fully unwound.
+     */
+    bool fast_capture;
+
+    /**
+     * If true, and the output file has a byte limit, sections are written in order of importance, and lower-priority
+     * threads and images are omitted to fit the limit. See plcrash_log_writer_set_prioritized_output().
+     */
+    bool prioritized_output;
+
+    /**
+     * The maximum number of frames written for a single thread. If a thread's stack exceeds this depth, the
+     * innermost and outermost frames are retained, and the frames between them are omitted.
+     */
+    uint32_t max_thread_frames;
+
+    /**
+     * The maximum number of threads written to a report, or 0 if unlimited. The crashed thread and the main thread are
+     * always written. See plcrash_log_writer_set_max_threads().
+     */
+    uint32_t max_threads;
+
+    /**
+     * If true, consecutive repeats of a cycle of frames are written as a single frame group with a repeat
+     * count, rather than as individual frames.
+     */
+    bool compress_frames;
+
+    /**
+     * The pre-encoded static report messages, or NULL if encoding failed. If NULL, the messages are encoded
+     * at crash time from the data above.
+     */
+    struct plcrash_log_writer_static_sections *static_sections;
+
+    /** The previously published static sections, retained until the next update may safely free them, or NULL. */
+    struct plcrash_log_writer_static_sections *retired_static_sections;
+
+    /**
+     * A caller-owned symbol cache to be reused across reports, or NULL. If NULL, a symbol cache is initialized
+     * and freed for each report. See plcrash_log_writer_set_symbol_cache().
+     */
+    plcrash_async_symbol_cache_t *symbol_cache;
+
+    /**
+     * Preallocated per-PC symbol result storage, or NULL if disabled. Attached to the report's symbol cache
+     * while each report is written. See plcrash_log_writer_enable_symbol_pc_cache().
+     */
+    plcrash_async_symbol_cache_entry_t *symbol_pc_cache;
+
+    /** The number of entries in @a symbol_pc_cache. */
+    size_t symbol_pc_cache_count;
+
+    /**
+     * Map of known readable and unreadable ranges of the target task, seeded while each report is written and
+     * consulted by the frame readers, or NULL if disabled. See plcrash_log_writer_enable_region_map().
+     */
+    plcrash_async_region_map_t *region_map;
+
+    /**
+     * If true, per-phase timing and event counts are recorded for each report, and written as the report's
+     * instrumentation message. See plcrash_log_writer_enable_instrumentation().
+     */
+    bool instrumentation;
+
+    /**
+     * If true, thread registers are written as a single packed array of values, rather than as individual named
+     * register messages. Reports are written with the PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS file version.
+     * See plcrash_log_writer_enable_packed_registers().
+     */
+    bool packed_registers;
+
+    /**
+     * The register set of the packed register values written to the current report, or 0 if none have been written.
+     * Reset at the start of each report.
+     */
+    uint32_t packed_register_set;
+
+    /**
+     * If true, the frames of threads written without symbols are written as a single packed array of delta-encoded
+     * PC values. Reports are written with the PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES file version. See
+     * plcrash_log_writer_enable_packed_frames().
+     */
+    bool packed_frames;
+
+    /**
+     * If true, embedded messages whose size is costly to compute are written once, preceded by a padded length
+     * placeholder that is backpatched once the message has been written, rather than being encoded twice. See
+     * plcrash_log_writer_enable_length_backpatching().
+     */
+    bool backpatch_lengths;
+
+    /**
+     * The table of stacks written to the current report, or NULL if thread deduplication is disabled. If non-NULL,
+     * reports are written in the PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS format. See
+     * plcrash_log_writer_enable_thread_deduplication().
+     */
+    struct plcrash_log_writer_stack_table *stack_table;
+
+    /** The maximum number of stack memory bytes captured per thread, or 0 if disabled. See plcrash_log_writer_enable_stack_memory(). */
+    size_t stack_memory_size;
+
+    /** The maximum number of threads, other than the crashed thread, for which stack memory is captured. */
+    uint32_t stack_memory_thread_count;
+
+    /** The stack memory capture buffer of @a stack_memory_size bytes, or NULL if disabled. */
+    uint8_t *stack_memory_buffer;
+
+    /** The maximum total number of register memory bytes captured, or 0 if disabled. See plcrash_log_writer_enable_register_memory(). */
+    size_t register_memory_size;
+
+    /** The register memory capture buffer of @a register_memory_size bytes, or NULL if disabled. */
+    uint8_t *register_memory_buffer;
+
+    /** The maximum number of VM regions recorded, or 0 if disabled. See plcrash_log_writer_enable_vm_region_summary(). */
+    uint32_t vm_region_max;
+
+    /** The time limit for VM region enumeration, in mach_absolute_time() units, or 0 if unlimited. */
+    uint64_t vm_region_time_limit;
+
+    /** The VM region table of @a vm_region_max entries, or NULL if disabled. */
+    plcrash_log_writer_vm_region_t *vm_regions;
+
+    /** The buffer into which the VM region table is encoded, or NULL if disabled. */
+    uint8_t *vm_region_buffer;
+
+    /**
+     * Additional crashed threads recorded via plcrash_log_writer_add_secondary_crash(). Only entries with a non-zero
+     * plcrash_log_writer_secondary_crash_t::ready value are valid.
+     */
+    plcrash_log_writer_secondary_crash_t secondary_crashes[PLCRASH_LOG_WRITER_SECONDARY_CRASH_MAX];
+
+    /** The number of @a secondary_crashes entries that have been claimed. May exceed the size of the array. */
+    volatile int32_t secondary_crash_count;
+
+    /**
+     * The time budget for writing each report, in mach_absolute_time() units, or 0 if unlimited. See
+     * plcrash_log_writer_set_deadline().
+     */
+    uint64_t deadline_budget;
+
+    /** The current report's deadline, in mach_absolute_time() units, or 0 if unlimited. Reset at the start of each report. */
+    uint64_t deadline;
+
+    /**
+     * If true, the current report's deadline has expired, and the remaining sections are written with reduced detail.
+     * Only updated by the thread writing the report, and only between sections. Reset at the start of each report.
+     */
+    volatile bool deadline_expired;
+
+    /**
+     * If true, @a referenced_images was allocated by plcrash_log_writer_set_deadline() or
+     * plcrash_log_writer_set_thread_subset(), and only limits the images written once the deadline has expired, or
+     * while a thread subset is set; otherwise, all images are written.
+     */
+    bool deadline_image_set;
+
+    /**
+     * The threads to be written in place of all threads of the task, or NULL. Not owned by the writer. See
+     * plcrash_log_writer_set_thread_subset().
+     */
+    const thread_t *thread_subset;
+
+    /** The number of entries in @a thread_subset. */
+    mach_msg_type_number_t thread_subset_count;
+
+    /**
+     * The thread registry consulted in place of the task's thread list, or NULL. Not owned by the writer. See
+     * plcrash_log_writer_set_thread_registry().
+     */
+    plcrash_async_thread_registry_t *thread_registry;
+
+    /** The preallocated thread list populated from @a thread_registry, or NULL if no registry is set. */
+    thread_t *thread_registry_threads;
+
+    /** If true, @a crashed_thread_state contains the crashed thread's state. See plcrash_log_writer_set_crashed_thread_state(). */
+    bool has_crashed_thread_state;
+
+    /** The crashed thread's state at the time of the crash, as supplied by the crash handler. */
+    plcrash_async_thread_state_t crashed_thread_state;
 } plcrash_log_writer_t;
 
 /**
@@ -229,6 +605,44 @@ typedef struct plcrash_log_signal_info {
     plcrash_log_mach_signal_info_t *mach_info;
 } plcrash_log_signal_info_t;
 
+/**
+ * @internal
+ *
+ * Report visitor callbacks, invoked by plcrash_log_writer_visit() as the crash state is walked. This allows a custom
+ * consumer to receive a report's data without an intermediate protobuf encoding.
+ *
+ * All callbacks are optional, and may be NULL. Each callback must be async-safe, and returns true to continue the
+ * walk, or false to abort it. All values supplied to a callback, including any strings, are only valid for the
+ * duration of the callback.
+ */
+typedef struct plcrash_log_writer_visitor {
+    /** The signal that triggered the report. */
+    bool (*signal) (const plcrash_log_signal_info_t *siginfo, void *ctx);
+
+    /** The uncaught exception, if any. Either value may be NULL. */
+    bool (*exception) (const char *name, const char *reason, void *ctx);
+
+    /** The start of a thread. Thread numbers are assigned in order, from zero. */
+    bool (*thread_begin) (uint32_t thread_number, thread_t thread, bool crashed, void *ctx);
+
+    /** A register value of the current thread's first frame. Only supplied for the crashed thread. */
+    bool (*thread_register) (const char *name, plcrash_greg_t value, void *ctx);
+
+    /**
+     * A stack frame of the current thread, innermost first. @a symbol_name is NULL if no symbol was found. Frame groups
+     * collapsed during capture are visited once.
+     */
+    bool (*frame) (uint32_t frame_number, uint64_t pc, const char *symbol_name, uint64_t symbol_start, void *ctx);
+
+    /** The end of the current thread. */
+    bool (*thread_end) (uint32_t thread_number, void *ctx);
+
+    /** A loaded binary image. */
+    bool (*image) (plcrash_async_macho_t *image, void *ctx);
+
+    /** The context value supplied to all callbacks. */
+    void *ctx;
+} plcrash_log_writer_visitor_t;
 
 plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
                                          NSString *app_identifier,
@@ -236,6 +650,50 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
                                          plcrash_async_symbol_strategy_t symbol_strategy,
                                          BOOL user_requested);
 void plcrash_log_writer_set_exception (plcrash_log_writer_t *writer, NSException *exception);
+plcrash_error_t plcrash_log_writer_set_target_task (plcrash_log_writer_t *writer, task_t task);
+void plcrash_log_writer_set_target_corpse (plcrash_log_writer_t *writer, task_t corpse);
+plcrash_error_t plcrash_log_writer_enable_parallel_capture (plcrash_log_writer_t *writer, uint32_t worker_count);
+plcrash_error_t plcrash_log_writer_enable_symbolication_pipeline (plcrash_log_writer_t *writer);
+void plcrash_log_writer_set_streaming (plcrash_log_writer_t *writer, bool enabled, uint32_t flush_points);
+void plcrash_log_writer_set_fast_capture (plcrash_log_writer_t *writer, bool enabled);
+void plcrash_log_writer_set_image_symbol_strategy (plcrash_log_writer_t *writer, plcrash_async_image_class_t image_class, plcrash_async_symbol_strategy_t symbol_strategy);
+void plcrash_log_writer_set_prioritized_output (plcrash_log_writer_t *writer, bool enabled);
+void plcrash_log_writer_set_max_thread_frames (plcrash_log_writer_t *writer, uint32_t max_frames);
+void plcrash_log_writer_set_max_threads (plcrash_log_writer_t *writer, uint32_t max_threads);
+plcrash_error_t plcrash_log_writer_set_thread_subset (plcrash_log_writer_t *writer, const thread_t *threads, mach_msg_type_number_t count);
+plcrash_error_t plcrash_log_writer_set_thread_registry (plcrash_log_writer_t *writer, plcrash_async_thread_registry_t *registry);
+void plcrash_log_writer_set_frame_compression (plcrash_log_writer_t *writer, bool enabled);
+void plcrash_log_writer_set_breadcrumbs (plcrash_log_writer_t *writer, plcrash_breadcrumb_ring_t *ring);
+void plcrash_log_writer_set_custom_data (plcrash_log_writer_t *writer, plcrash_custom_data_registry_t *registry);
+plcrash_error_t plcrash_log_writer_enable_symbol_table (plcrash_log_writer_t *writer);
+plcrash_error_t plcrash_log_writer_enable_referenced_images (plcrash_log_writer_t *writer);
+void plcrash_log_writer_set_symbol_cache (plcrash_log_writer_t *writer, plcrash_async_symbol_cache_t *cache);
+plcrash_error_t plcrash_log_writer_enable_symbol_pc_cache (plcrash_log_writer_t *writer, size_t count);
+plcrash_error_t plcrash_log_writer_enable_region_map (plcrash_log_writer_t *writer);
+void plcrash_log_writer_enable_instrumentation (plcrash_log_writer_t *writer);
+void plcrash_log_writer_enable_packed_registers (plcrash_log_writer_t *writer);
+void plcrash_log_writer_enable_packed_frames (plcrash_log_writer_t *writer);
+void plcrash_log_writer_enable_length_backpatching (plcrash_log_writer_t *writer);
+plcrash_error_t plcrash_log_writer_enable_thread_deduplication (plcrash_log_writer_t *writer);
+plcrash_error_t plcrash_log_writer_enable_stack_memory (plcrash_log_writer_t *writer, size_t size, uint32_t thread_count);
+plcrash_error_t plcrash_log_writer_enable_register_memory (plcrash_log_writer_t *writer, size_t size);
+plcrash_error_t plcrash_log_writer_enable_vm_region_summary (plcrash_log_writer_t *writer, uint32_t max_regions, uint64_t budget_ns);
+plcrash_error_t plcrash_log_writer_set_deadline (plcrash_log_writer_t *writer, uint64_t budget_ns);
+plcrash_error_t plcrash_log_writer_prefault (plcrash_log_writer_t *writer, bool wire);
+plcrash_error_t plcrash_log_writer_warm_current_thread (plcrash_log_writer_t *writer,
+                                                        plcrash_async_image_list_t *image_list,
+                                                        plcrash_async_thread_state_t *current_state);
+plcrash_error_t plcrash_log_writer_refresh_system_info (plcrash_log_writer_t *writer);
+plcrash_error_t plcrash_log_writer_encode_binary_image (plcrash_async_macho_t *image, void **data, size_t *length);
+plcrash_error_t plcrash_log_writer_image_manifest_create (plcrash_async_image_list_t *image_list,
+                                                         plcrash_log_writer_image_manifest_t **manifest,
+                                                         void **data,
+                                                         size_t *length);
+void plcrash_log_writer_image_manifest_free (plcrash_log_writer_image_manifest_t *manifest);
+uint64_t plcrash_log_writer_image_manifest_identifier (const void *data, size_t length);
+void plcrash_log_writer_set_image_manifest (plcrash_log_writer_t *writer, plcrash_log_writer_image_manifest_t *manifest);
+bool plcrash_log_writer_add_secondary_crash (plcrash_log_writer_t *writer, thread_t thread, const plcrash_async_thread_state_t *thread_state);
+void plcrash_log_writer_set_crashed_thread_state (plcrash_log_writer_t *writer, const plcrash_async_thread_state_t *thread_state);
 
 plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
                                           thread_t crashed_thread,
@@ -244,6 +702,13 @@ plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
                                           plcrash_log_signal_info_t *siginfo,
                                           plcrash_async_thread_state_t *current_state);
 
+plcrash_error_t plcrash_log_writer_visit (plcrash_log_writer_t *writer,
+                                          thread_t crashed_thread,
+                                          plcrash_async_image_list_t *image_list,
+                                          const plcrash_log_writer_visitor_t *visitor,
+                                          plcrash_log_signal_info_t *siginfo,
+                                          plcrash_async_thread_state_t *current_state);
+
 plcrash_error_t plcrash_log_writer_close (plcrash_log_writer_t *writer);
 void plcrash_log_writer_free (plcrash_log_writer_t *writer);
 
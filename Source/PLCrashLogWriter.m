@@ -39,12 +39,21 @@
 #import <mach-o/dyld.h>
 
 #import <libkern/OSAtomic.h>
+#import <libkern/OSByteOrder.h>
+#import <mach/semaphore.h>
+#import <mach/mach_time.h>
+#import <pthread.h>
 
 #import "PLCrashReport.h"
 #import "PLCrashLogWriter.h"
 #import "PLCrashLogWriterEncoding.h"
+#import "PLCrashReportFieldIDs.h"
 #import "PLCrashAsyncSignalInfo.h"
 #import "PLCrashAsyncSymbolication.h"
+#import "PLCrashAsyncMetrics.h"
+#import "PLCrashAsyncTrace.h"
+#import "PLCrashSignalHandler.h"
+#import "PLCrashFrameStackUnwind.h"
 
 #import "PLCrashSysctl.h"
 #import "PLCrashProcessInfo.h"
@@ -55,6 +64,7 @@
 
 #if TARGET_OS_MAC && !TARGET_OS_IPHONE && !TARGET_IPHONE_SIMULATOR
 #import <ExceptionHandling/ExceptionHandling.h>
+#import <libproc.h>
 #endif
 
 /**
@@ -66,206 +76,312 @@
 
 /**
  * @internal
- * Protobuf Field IDs, as defined in crashreport.proto
+ * Maximum number of frames that will be walked for a single thread when retaining the outermost frames of a
+ * stack that exceeds the writer's frame limit. Bounds the capture time of a thread with a corrupt frame chain.
  */
-enum {
-    /** CrashReport.system_info */
-    PLCRASH_PROTO_SYSTEM_INFO_ID = 1,
+#define MAX_THREAD_WALK_FRAMES (128 * 1024)
 
-    /** CrashReport.system_info.operating_system */
-    PLCRASH_PROTO_SYSTEM_INFO_OS_ID = 1,
+/**
+ * @internal
+ * The number of frames unwound per plframe_cursor_walk() call when capturing a thread.
+ */
+#define PLCRASH_LOG_WRITER_WALK_BATCH 64
 
-    /** CrashReport.system_info.os_version */
-    PLCRASH_PROTO_SYSTEM_INFO_OS_VERSION_ID = 2,
+/**
+ * @internal
+ * Maximum length of a cycle of frames that will be collapsed into a single repeated frame group.
+ */
+#define MAX_FRAME_CYCLE_LENGTH 8
 
-    /** CrashReport.system_info.architecture */
-    PLCRASH_PROTO_SYSTEM_INFO_ARCHITECTURE_TYPE_ID = 3,
+/**
+ * @internal
+ * Size of the per-thread symbol name pool maintained by plcrash_log_writer_thread_buffer_t. Symbol names that do
+ * not fit within the pool are resolved a second time at serialization time.
+ */
+#define THREAD_SYMBOL_POOL_SIZE (128 * 1024)
 
-    /** CrashReport.system_info.timestamp */
-    PLCRASH_PROTO_SYSTEM_INFO_TIMESTAMP_ID = 4,
+/**
+ * @internal
+ * Maximum number of unique symbol names that may be held by plcrash_log_writer_symbol_table_t. Symbols beyond this
+ * limit are written with an inline name.
+ */
+#define SYMBOL_TABLE_MAX_NAMES 4096
 
-    /** CrashReport.system_info.os_build */
-    PLCRASH_PROTO_SYSTEM_INFO_OS_BUILD_ID = 5,
+/**
+ * @internal
+ * Number of hash slots in plcrash_log_writer_symbol_table_t. Must be a power of two, and larger than
+ * SYMBOL_TABLE_MAX_NAMES.
+ */
+#define SYMBOL_TABLE_SLOTS (SYMBOL_TABLE_MAX_NAMES * 2)
 
-    /** CrashReport.app_info */
-    PLCRASH_PROTO_APP_INFO_ID = 2,
-    
-    /** CrashReport.app_info.app_identifier */
-    PLCRASH_PROTO_APP_INFO_APP_IDENTIFIER_ID = 1,
-    
-    /** CrashReport.app_info.app_version */
-    PLCRASH_PROTO_APP_INFO_APP_VERSION_ID = 2,
+/**
+ * @internal
+ * Size of the symbol name pool maintained by plcrash_log_writer_symbol_table_t.
+ */
+#define SYMBOL_TABLE_POOL_SIZE (256 * 1024)
 
+/**
+ * @internal
+ * Per-report symbol name table. Each unique symbol name is assigned an index at the time it is first written,
+ * and the names are written once, in index order, at the end of the report.
+ */
+typedef struct plcrash_log_writer_symbol_table {
+    /** The number of names in the table. */
+    uint32_t count;
 
-    /** CrashReport.symbol.name */
-    PLCRASH_PROTO_SYMBOL_NAME = 1,
+    /** Number of bytes of @a pool currently in use. */
+    size_t pool_used;
 
-    /** CrashReport.symbol.start_address */
-    PLCRASH_PROTO_SYMBOL_START_ADDRESS = 2,
-    
-    /** CrashReport.symbol.end_address */
-    PLCRASH_PROTO_SYMBOL_END_ADDRESS = 3,
+    /** Open addressing hash slots, holding the name's index plus one, or 0 if empty. */
+    uint32_t slots[SYMBOL_TABLE_SLOTS];
 
+    /** The table's names, in index order. Each name is allocated from @a pool. */
+    const char *names[SYMBOL_TABLE_MAX_NAMES];
 
-    /** CrashReport.threads */
-    PLCRASH_PROTO_THREADS_ID = 3,
-    
+    /** Symbol name storage. */
+    char pool[SYMBOL_TABLE_POOL_SIZE];
+} plcrash_log_writer_symbol_table_t;
 
-    /** CrashReports.thread.thread_number */
-    PLCRASH_PROTO_THREAD_THREAD_NUMBER_ID = 1,
+/**
+ * @internal
+ * Maximum number of images that may be held by plcrash_log_writer_image_set_t. If more images are referenced,
+ * all images are written.
+ */
+#define IMAGE_SET_MAX_IMAGES 1024
 
-    /** CrashReports.thread.frames */
-    PLCRASH_PROTO_THREAD_FRAMES_ID = 2,
+/**
+ * @internal
+ * Number of hash slots in plcrash_log_writer_image_set_t. Must be a power of two, and larger than
+ * IMAGE_SET_MAX_IMAGES.
+ */
+#define IMAGE_SET_SLOTS (IMAGE_SET_MAX_IMAGES * 2)
 
-    /** CrashReport.thread.crashed */
-    PLCRASH_PROTO_THREAD_CRASHED_ID = 3,
+/**
+ * @internal
+ * Per-report set of the binary images referenced by the frames written to the report, keyed by the images'
+ * header addresses.
+ */
+typedef struct plcrash_log_writer_image_set {
+    /** The number of images in the set. */
+    uint32_t count;
 
+    /** If true, more than IMAGE_SET_MAX_IMAGES images were referenced, and all images must be written. */
+    bool overflow;
 
-    /** CrashReport.thread.frame.pc */
-    PLCRASH_PROTO_THREAD_FRAME_PC_ID = 3,
-    
-    /** CrashReport.thread.frame.symbol */
-    PLCRASH_PROTO_THREAD_FRAME_SYMBOL_ID = 6,
+    /** Open addressing hash slots, holding an image header address, or 0 if empty. */
+    pl_vm_address_t slots[IMAGE_SET_SLOTS];
+} plcrash_log_writer_image_set_t;
 
+/**
+ * @internal
+ * Maximum number of unique stacks that may be held by plcrash_log_writer_stack_table_t. Threads with stacks beyond
+ * this limit are written in full.
+ */
+#define STACK_TABLE_MAX_STACKS 512
 
-    /** CrashReport.thread.registers */
-    PLCRASH_PROTO_THREAD_REGISTERS_ID = 4,
+/**
+ * @internal
+ * Number of hash slots in plcrash_log_writer_stack_table_t. Must be a power of two, and larger than
+ * STACK_TABLE_MAX_STACKS.
+ */
+#define STACK_TABLE_SLOTS (STACK_TABLE_MAX_STACKS * 2)
 
-    /** CrashReport.thread.register.name */
-    PLCRASH_PROTO_THREAD_REGISTER_NAME_ID = 1,
+/**
+ * @internal
+ * A single plcrash_log_writer_stack_table_t entry.
+ */
+typedef struct plcrash_log_writer_stack_entry {
+    /** The hash of the stack's frames. */
+    uint64_t hash;
 
-    /** CrashReport.thread.register.name */
-    PLCRASH_PROTO_THREAD_REGISTER_VALUE_ID = 2,
+    /** The number of frames in the stack. */
+    uint32_t frame_count;
 
+    /** The number of the thread with which the stack was written, plus one, or 0 if this slot is empty. */
+    uint32_t thread_number;
+} plcrash_log_writer_stack_entry_t;
 
-    /** CrashReport.images */
-    PLCRASH_PROTO_BINARY_IMAGES_ID = 4,
+/**
+ * @internal
+ * Per-report table of the captured stacks written in full, keyed by a hash of each stack's frames. A thread whose
+ * stack is found in the table is written as a reference to the thread that first wrote the stack.
+ */
+typedef struct plcrash_log_writer_stack_table {
+    /** The number of stacks in the table. */
+    uint32_t count;
 
-    /** CrashReport.BinaryImage.base_address */
-    PLCRASH_PROTO_BINARY_IMAGE_ADDR_ID = 1,
+    /** Open addressing hash slots. */
+    plcrash_log_writer_stack_entry_t slots[STACK_TABLE_SLOTS];
+} plcrash_log_writer_stack_table_t;
 
-    /** CrashReport.BinaryImage.size */
-    PLCRASH_PROTO_BINARY_IMAGE_SIZE_ID = 2,
+/**
+ * @internal
+ * A single unwound (and possibly symbolicated) stack frame, as recorded by plcrash_writer_capture_thread().
+ */
+typedef struct plcrash_log_writer_frame {
+    /** The frame's PC value. */
+    uint64_t pc;
 
-    /** CrashReport.BinaryImage.name */
-    PLCRASH_PROTO_BINARY_IMAGE_NAME_ID = 3,
-    
-    /** CrashReport.BinaryImage.uuid */
-    PLCRASH_PROTO_BINARY_IMAGE_UUID_ID = 4,
+    /** If true, a symbol was found for @a pc, and @a symbol_name and @a symbol_start are valid. */
+    bool has_symbol;
 
-    /** CrashReport.BinaryImage.code_type */
-    PLCRASH_PROTO_BINARY_IMAGE_CODE_TYPE_ID = 5,
+    /**
+     * If true, a symbol was found for @a pc, but the name could not be stored in the symbol pool; the
+     * symbol must be looked up again when the frame is serialized.
+     */
+    bool symbol_deferred;
 
-    
-    /** CrashReport.exception */
-    PLCRASH_PROTO_EXCEPTION_ID = 5,
+    /** The symbol's start address. */
+    uint64_t symbol_start;
 
-    /** CrashReport.exception.name */
-    PLCRASH_PROTO_EXCEPTION_NAME_ID = 1,
-    
-    /** CrashReport.exception.reason */
-    PLCRASH_PROTO_EXCEPTION_REASON_ID = 2,
-    
-    /** CrashReports.exception.frames */
-    PLCRASH_PROTO_EXCEPTION_FRAMES_ID = 3,
+    /** The NUL-terminated symbol name, allocated from the thread buffer's symbol pool. */
+    const char *symbol_name;
 
-    /** CrashReports.exception.user_info */
-    PLCRASH_PROTO_EXCEPTION_USER_INFO_ID = 4,
+    /**
+     * If greater than one, this frame begins a group of @a repeat_length frames that was observed @a repeat_count
+     * times in succession; only the first instance of the group is recorded.
+     */
+    uint32_t repeat_count;
 
+    /** The number of frames in the repeated group. Only valid if @a repeat_count is greater than one. */
+    uint32_t repeat_length;
 
-    /** CrashReport.exception.user_info.key */
-    PLCRASH_PROTO_EXCEPTION_USERINFO_KEY_ID = 1,
+    /** The number of frames omitted between the preceding frame and this frame. */
+    uint64_t omitted_count;
+} plcrash_log_writer_frame_t;
 
-    /** CrashReport.exception.user_info.serialized */
-    PLCRASH_PROTO_EXCEPTION_USERINFO_SERIALIZED_ID = 2,
+/**
+ * @internal
+ * Thread capture buffer. Holds the result of unwinding and symbolicating a single thread, allowing the
+ * thread message to be sized and serialized without walking the thread's stack a second time.
+ */
+typedef struct plcrash_log_writer_thread_buffer {
+    /** The captured frames. */
+    plcrash_log_writer_frame_t frames[MAX_THREAD_FRAMES];
 
-    /** CrashReport.exception.user_info.archive */
-    PLCRASH_PROTO_EXCEPTION_USERINFO_ARCHIVE_ID = 3,
+    /** The number of valid entries in @a frames. */
+    uint32_t frame_count;
 
+    /** If true, @a registers contains the thread state of the first frame. */
+    bool has_registers;
 
-    /** CrashReport.signal */
-    PLCRASH_PROTO_SIGNAL_ID = 6,
+    /** If true, the thread was recorded via plcrash_log_writer_add_secondary_crash(), and was unwound from its crash state. */
+    bool also_crashed;
 
-    /** CrashReport.signal.name */
-    PLCRASH_PROTO_SIGNAL_NAME_ID = 1,
+    /** If true, the frames have been passed through plcrash_writer_symbolicate_captured_thread(). */
+    bool symbolicated;
 
-    /** CrashReport.signal.code */
-    PLCRASH_PROTO_SIGNAL_CODE_ID = 2,
-    
-    /** CrashReport.signal.address */
-    PLCRASH_PROTO_SIGNAL_ADDRESS_ID = 3,
-    
-    /** CrashReport.signal.mach_exception */
-    PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_ID = 4,
-    
-    
-    /** CrashReport.signal.mach_exception.type */
-    PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_TYPE_ID = 1,
-    
-    /** CrashReport.signal.mach_exception.codes */
-    PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_CODES_ID = 2,
+    /** The thread's name, as recorded by the writer's thread registry, or an empty string. */
+    char name[PLCRASH_ASYNC_THREAD_REGISTRY_NAME_MAX];
 
+    /** The first frame's register state. Only valid if @a has_registers is true. */
+    plcrash_async_thread_state_t registers;
 
-    /** CrashReport.process_info */
-    PLCRASH_PROTO_PROCESS_INFO_ID = 7,
-    
-    /** CrashReport.process_info.process_name */
-    PLCRASH_PROTO_PROCESS_INFO_PROCESS_NAME_ID = 1,
-    
-    /** CrashReport.process_info.process_id */
-    PLCRASH_PROTO_PROCESS_INFO_PROCESS_ID_ID = 2,
-    
-    /** CrashReport.process_info.process_path */
-    PLCRASH_PROTO_PROCESS_INFO_PROCESS_PATH_ID = 3,
-    
-    /** CrashReport.process_info.parent_process_name */
-    PLCRASH_PROTO_PROCESS_INFO_PARENT_PROCESS_NAME_ID = 4,
-    
-    /** CrashReport.process_info.parent_process_id */
-    PLCRASH_PROTO_PROCESS_INFO_PARENT_PROCESS_ID_ID = 5,
-    
-    /** CrashReport.process_info.native */
-    PLCRASH_PROTO_PROCESS_INFO_NATIVE_ID = 6,
-    
-    /** CrashReport.process_info.start_time */
-    PLCRASH_PROTO_PROCESS_INFO_START_TIME_ID = 7,
+    /** Number of bytes of @a symbol_pool currently in use. */
+    size_t symbol_pool_used;
 
-    
-    /** CrashReport.Processor.encoding */
-    PLCRASH_PROTO_PROCESSOR_ENCODING_ID = 1,
-    
-    /** CrashReport.Processor.encoding */
-    PLCRASH_PROTO_PROCESSOR_TYPE_ID = 2,
-    
-    /** CrashReport.Processor.encoding */
-    PLCRASH_PROTO_PROCESSOR_SUBTYPE_ID = 3,
+    /** Symbol name storage. */
+    char symbol_pool[THREAD_SYMBOL_POOL_SIZE];
+} plcrash_log_writer_thread_buffer_t;
+
+/**
+ * @internal
+ * Number of seconds the writer will wait for a capture pool worker before unwinding the worker's threads itself.
+ */
+#define PLCRASH_LOG_WRITER_CAPTURE_TIMEOUT 2
 
+/**
+ * @internal
+ * Number of entries in the symbolication pipeline's queue. Must be a power of two. Threads unwound once the queue is
+ * full are symbolicated by the writer.
+ */
+#define PLCRASH_LOG_WRITER_PIPELINE_QUEUE_SIZE 256
 
-    /** CrashReport.machine_info */
-    PLCRASH_PROTO_MACHINE_INFO_ID = 8,
+struct plcrash_log_writer_capture_pool;
+static void plcrash_writer_capture_pool_free (struct plcrash_log_writer_capture_pool *pool);
+struct plcrash_log_writer_symbolication_pipeline;
+static void plcrash_writer_symbolication_pipeline_free (struct plcrash_log_writer_symbolication_pipeline *pipeline);
+static plcrash_error_t plcrash_writer_capture_pool_prefault (struct plcrash_log_writer_capture_pool *pool, bool wire);
 
-    /** CrashReport.machine_info.model */
-    PLCRASH_PROTO_MACHINE_INFO_MODEL_ID = 1,
+/**
+ * @internal
+ *
+ * Report messages that do not change after the writer has been initialized, encoded prior to a crash. This
+ * allows the messages to be emitted at crash time with a single buffered write.
+ */
+typedef struct plcrash_log_writer_static_sections {
+    /**
+     * The encoded system info fields, excluding the crash-time timestamp. As the timestamp is written within the
+     * system info message, the message's field tag and length are written at crash time.
+     */
+    uint8_t *system_info;
 
-    /** CrashReport.machine_info.processor */
-    PLCRASH_PROTO_MACHINE_INFO_PROCESSOR_ID = 2,
+    /** Length of @a system_info, in bytes. */
+    size_t system_info_len;
 
-    /** CrashReport.machine_info.processor_count */
-    PLCRASH_PROTO_MACHINE_INFO_PROCESSOR_COUNT_ID = 3,
+    /** The complete encoded machine info, app info, and process info messages, including their field tags and lengths. */
+    uint8_t *messages;
 
-    /** CrashReport.machine_info.logical_processor_count */
-    PLCRASH_PROTO_MACHINE_INFO_LOGICAL_PROCESSOR_COUNT_ID = 4,
+    /** Length of @a messages, in bytes. */
+    size_t messages_len;
 
+    /** Backing storage for @a system_info and @a messages. */
+    uint8_t data[];
+} plcrash_log_writer_static_sections_t;
 
-    /** CrashReport.report_info */
-    PLCRASH_PROTO_REPORT_INFO_ID = 9,
-    
-    /** CrashReport.report_info.crashed */
-    PLCRASH_PROTO_REPORT_INFO_USER_REQUESTED_ID = 1,
+static plcrash_error_t plcrash_writer_encode_static_sections (plcrash_log_writer_t *writer);
+static void plcrash_writer_static_sections_publish (plcrash_log_writer_t *writer, plcrash_log_writer_static_sections_t *sections);
+static plcrash_error_t plcrash_writer_fetch_os_version (char **version, char **build);
 
-    /** CrashReport.report_info.uuid */
-    PLCRASH_PROTO_REPORT_INFO_UUID_ID = 2,
-};
+/**
+ * @internal
+ *
+ * Fetch the host OS version and build strings. The caller is responsible for free()'ing the returned strings.
+ *
+ * @param[out] version On success, the OS version string.
+ * @param[out] build On success, the OS build string. This may be set to NULL if the build is unavailable.
+ *
+ * @warning This function is not async-safe.
+ */
+static plcrash_error_t plcrash_writer_fetch_os_version (char **version, char **build) {
+    *version = NULL;
+    *build = plcrash_sysctl_string("kern.osversion");
+    if (*build == NULL) {
+        PLCF_DEBUG("Could not retrive kern.osversion: %s", strerror(errno));
+    }
+
+#if TARGET_OS_IPHONE
+    /* iPhone OS */
+    *version = strdup([[[UIDevice currentDevice] systemVersion] UTF8String]);
+#elif TARGET_OS_MAC
+    /* Mac OS X */
+    {
+        SInt32 major, minor, bugfix;
+
+        /* Fetch the major, minor, and bugfix versions.
+         * Fetching the OS version should not fail. */
+        if (Gestalt(gestaltSystemVersionMajor, &major) != noErr) {
+            PLCF_DEBUG("Could not retreive system major version with Gestalt");
+            return PLCRASH_EINTERNAL;
+        }
+        if (Gestalt(gestaltSystemVersionMinor, &minor) != noErr) {
+            PLCF_DEBUG("Could not retreive system minor version with Gestalt");
+            return PLCRASH_EINTERNAL;
+        }
+        if (Gestalt(gestaltSystemVersionBugFix, &bugfix) != noErr) {
+            PLCF_DEBUG("Could not retreive system bugfix version with Gestalt");
+            return PLCRASH_EINTERNAL;
+        }
+
+        /* Compose the string */
+        asprintf(version, "%" PRId32 ".%" PRId32 ".%" PRId32, (int32_t)major, (int32_t)minor, (int32_t)bugfix);
+    }
+#else
+#error Unsupported Platform
+#endif
+
+    return PLCRASH_ESUCCESS;
+}
 
 /**
  * Initialize a new crash log writer instance and issue a memory barrier upon completion. This fetches all necessary
@@ -293,7 +409,12 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
     memset(writer, 0, sizeof(*writer));
 
     /* Initialize configuration */
+    writer->task = mach_task_self();
     writer->symbol_strategy = symbol_strategy;
+    for (size_t i = 0; i < PLCRASH_ASYNC_IMAGE_CLASS_COUNT; i++)
+        writer->image_symbol_strategy[i] = symbol_strategy;
+    writer->max_thread_frames = MAX_THREAD_FRAMES;
+    writer->compress_frames = true;
 
     /* Default to false */
     writer->report_info.user_requested = user_requested;
@@ -360,49 +481,41 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
         }
     }
 
-    /* Fetch the machine information */
+    /* Fetch the machine information. These values are immutable, and are shared across all writer instances. */
     {
+        const plcrash_sysctl_host_info_t *host_info = plcrash_sysctl_host_info();
+
         /* Model */
-#if TARGET_OS_IPHONE
-        /* On iOS, we want hw.machine (e.g. hw.machine = iPad2,1; hw.model = K93AP) */
-        writer->machine_info.model = plcrash_sysctl_string("hw.machine");
-#else
-        /* On Mac OS X, we want hw.model (e.g. hw.machine = x86_64; hw.model = Macmini5,3) */
-        writer->machine_info.model = plcrash_sysctl_string("hw.model");
-#endif
-        if (writer->machine_info.model == NULL) {
-            PLCF_DEBUG("Could not retrive hw.model: %s", strerror(errno));
+        if (host_info->model != NULL) {
+            writer->machine_info.model = strdup(host_info->model);
+        } else {
+            PLCF_DEBUG("Could not retrive hw.model");
         }
         
         /* CPU */
-        {
-            int retval;
+        if (host_info->has_cpu_type) {
+            writer->machine_info.cpu_type = host_info->cpu_type;
+        } else {
+            PLCF_DEBUG("Could not retrive hw.cputype");
+        }
 
-            /* Fetch the CPU types */
-            if (plcrash_sysctl_int("hw.cputype", &retval)) {
-                writer->machine_info.cpu_type = retval;
-            } else {
-                PLCF_DEBUG("Could not retrive hw.cputype: %s", strerror(errno));
-            }
-            
-            if (plcrash_sysctl_int("hw.cpusubtype", &retval)) {
-                writer->machine_info.cpu_subtype = retval;
-            } else {
-                PLCF_DEBUG("Could not retrive hw.cpusubtype: %s", strerror(errno));
-            }
+        if (host_info->has_cpu_subtype) {
+            writer->machine_info.cpu_subtype = host_info->cpu_subtype;
+        } else {
+            PLCF_DEBUG("Could not retrive hw.cpusubtype");
+        }
 
-            /* Processor count */
-            if (plcrash_sysctl_int("hw.physicalcpu_max", &retval)) {
-                writer->machine_info.processor_count = retval;
-            } else {
-                PLCF_DEBUG("Could not retrive hw.physicalcpu_max: %s", strerror(errno));
-            }
+        /* Processor count */
+        if (host_info->has_physical_cpu_count) {
+            writer->machine_info.processor_count = host_info->physical_cpu_count;
+        } else {
+            PLCF_DEBUG("Could not retrive hw.physicalcpu_max");
+        }
 
-            if (plcrash_sysctl_int("hw.logicalcpu_max", &retval)) {
-                writer->machine_info.logical_processor_count = retval;
-            } else {
-                PLCF_DEBUG("Could not retrive hw.logicalcpu_max: %s", strerror(errno));
-            }
+        if (host_info->has_logical_cpu_count) {
+            writer->machine_info.logical_processor_count = host_info->logical_cpu_count;
+        } else {
+            PLCF_DEBUG("Could not retrive hw.logicalcpu_max");
         }
         
         /*
@@ -410,58 +523,43 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
          * Second Edition:
          *
          * http://developer.apple.com/legacy/mac/library/documentation/MacOSX/Conceptual/universal_binary/universal_binary.pdf
+         *
+         * If the sysctl is not available, the process can be assumed to be native.
          */
-        {
-            int retval;
-
-            if (plcrash_sysctl_int("sysctl.proc_native", &retval)) {
-                if (retval == 0) {
-                    writer->process_info.native = false;
-                } else {
-                    writer->process_info.native = true;
-                }
-            } else {
-                /* If the sysctl is not available, the process can be assumed to be native. */
-                writer->process_info.native = true;
-            }
+        if (host_info->has_proc_native && host_info->proc_native == 0) {
+            writer->process_info.native = false;
+        } else {
+            writer->process_info.native = true;
         }
     }
 
-    /* Fetch the OS information */    
-    writer->system_info.build = plcrash_sysctl_string("kern.osversion");
-    if (writer->system_info.build == NULL) {
-        PLCF_DEBUG("Could not retrive kern.osversion: %s", strerror(errno));
+    /* Fetch the OS information */
+    {
+        plcrash_error_t err = plcrash_writer_fetch_os_version(&writer->system_info.version, &writer->system_info.build);
+        if (err != PLCRASH_ESUCCESS)
+            return err;
     }
 
-#if TARGET_OS_IPHONE
-    /* iPhone OS */
-    writer->system_info.version = strdup([[[UIDevice currentDevice] systemVersion] UTF8String]);
-#elif TARGET_OS_MAC
-    /* Mac OS X */
-    {
-        SInt32 major, minor, bugfix;
+    /* Pre-encode the static report messages. This is an optimization; if encoding fails, the messages will be
+     * encoded at crash time. */
+    if (plcrash_writer_encode_static_sections(writer) != PLCRASH_ESUCCESS)
+        PLCF_DEBUG("Could not pre-encode the static report messages");
 
-        /* Fetch the major, minor, and bugfix versions.
-         * Fetching the OS version should not fail. */
-        if (Gestalt(gestaltSystemVersionMajor, &major) != noErr) {
-            PLCF_DEBUG("Could not retreive system major version with Gestalt");
-            return PLCRASH_EINTERNAL;
-        }
-        if (Gestalt(gestaltSystemVersionMinor, &minor) != noErr) {
-            PLCF_DEBUG("Could not retreive system minor version with Gestalt");
-            return PLCRASH_EINTERNAL;
-        }
-        if (Gestalt(gestaltSystemVersionBugFix, &bugfix) != noErr) {
-            PLCF_DEBUG("Could not retreive system bugfix version with Gestalt");
-            return PLCRASH_EINTERNAL;
+    /* Allocate the thread capture buffer. This is an optimization; if allocation fails, we fall back
+     * on unwinding each thread twice. */
+    {
+        plcrash_error_t err;
+
+        err = plcrash_async_allocator_new(&writer->allocator, sizeof(plcrash_log_writer_thread_buffer_t), PLCrashAsyncGuardLowPage|PLCrashAsyncGuardHighPage);
+        if (err == PLCRASH_ESUCCESS) {
+            writer->thread_buffer = plcrash_async_allocator_alloc(writer->allocator, sizeof(plcrash_log_writer_thread_buffer_t), true);
+            if (writer->thread_buffer == NULL)
+                PLCF_DEBUG("Could not allocate the thread capture buffer");
+        } else {
+            writer->allocator = NULL;
+            PLCF_DEBUG("Could not create the thread capture allocator: %d", err);
         }
-
-        /* Compose the string */
-        asprintf(&writer->system_info.version, "%" PRId32 ".%" PRId32 ".%" PRId32, (int32_t)major, (int32_t)minor, (int32_t)bugfix);
     }
-#else
-#error Unsupported Platform
-#endif
 
     /* Ensure that any signal handler has a consistent view of the above initialization. */
     OSMemoryBarrier();
@@ -470,85 +568,1147 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
 }
 
 /**
- * Set the uncaught exception for this writer. Once set, this exception will be used to
- * provide exception data for the crash log output.
+ * Enable or disable streaming output for this writer.
+ *
+ * Crash reports are written as a sequence of length-delimited top-level messages. In streaming mode, the messages
+ * most valuable for diagnosis are written first (the header and termination messages, followed by the crashed
+ * thread, the remaining threads, and the binary images), and the output is flushed at each of the given
+ * @a flush_points. If the process is terminated part-way through writing the report (eg, by a watchdog), the
+ * messages written prior to the last flush point may be recovered by PLCrashReport.
+ *
+ * @param writer The writer to configure.
+ * @param enabled If true, streaming output will be enabled.
+ * @param flush_points The plcrash_log_writer_flush_point_t values at which the output should be flushed.
  *
  * @warning This function is not async safe, and must be called outside of a signal handler.
  */
-void plcrash_log_writer_set_exception (plcrash_log_writer_t *writer, NSException *exception) {
-    assert(writer->uncaught_exception.has_exception == false);
-
-    /* Save the exception data */
-    writer->uncaught_exception.has_exception = true;
-    writer->uncaught_exception.name = strdup([[exception name] UTF8String]);
-    writer->uncaught_exception.reason = strdup([[exception reason] UTF8String]);
-
-    /* Save the call stack, if available */
-    NSArray *callStackArray = [exception callStackReturnAddresses];
-#if TARGET_OS_MAC && !TARGET_OS_IPHONE && !TARGET_IPHONE_SIMULATOR
-    if (!callStackArray) {
-        NSArray *frames = [[[exception userInfo] objectForKey:NSStackTraceKey] componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
-        callStackArray = [[NSMutableArray alloc] initWithCapacity:[frames count]];
-        for (NSString *frame in frames) {
-            long address = strtol([frame cStringUsingEncoding:NSASCIIStringEncoding], NULL, 16);
-            [(NSMutableArray *)callStackArray addObject:[NSNumber numberWithLong:address]];
-        }
-    }
-#endif
-    if (callStackArray != nil && [callStackArray count] > 0) {
-        size_t count = [callStackArray count];
-        writer->uncaught_exception.callstack_count = count;
-        writer->uncaught_exception.callstack = malloc(sizeof(void *) * count);
-
-        size_t i = 0;
-        for (NSNumber *num in callStackArray) {
-            assert(i < count);
-            writer->uncaught_exception.callstack[i] = (void *)(uintptr_t)[num unsignedLongLongValue];
-            i++;
-        }
-    }
+void plcrash_log_writer_set_streaming (plcrash_log_writer_t *writer, bool enabled, uint32_t flush_points) {
+    writer->streaming = enabled;
+    writer->flush_points = flush_points;
 
-    writer->uncaught_exception.user_info_size = [[exception userInfo] count];
-    writer->uncaught_exception.user_info = malloc(sizeof(user_info_t) * [[exception userInfo] count]);
-    uint64_t index = 0;
-    for (NSString *key in [exception userInfo]) {
-        id object = [[exception userInfo] objectForKey:key];
-        writer->uncaught_exception.user_info[index].key = strdup([key UTF8String]);
-        if ([object conformsToProtocol:@protocol(NSCoding)]) {
-            NSMutableData *encoded = [[NSMutableData alloc] init];
-            NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initForWritingWithMutableData:encoded];
-            [archiver setOutputFormat:NSPropertyListXMLFormat_v1_0];
-            [archiver encodeRootObject:object];
-            [archiver finishEncoding];
-            [archiver release];
-            NSString *string = [[NSString alloc] initWithData:encoded encoding:NSUTF8StringEncoding];
-            [encoded release];
-            writer->uncaught_exception.user_info[index].serialized = strdup([string UTF8String]);
-            [string release];
-        } else
-            writer->uncaught_exception.user_info[index].serialized = strdup([[object description] UTF8String]);
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
 
-        index++;
-    }
+/**
+ * Enable or disable prioritized output. When enabled, and the output file has a byte limit, the report's sections are
+ * written in order of importance: the crashed thread, the exception and signal, the images referenced by the crashed
+ * thread's frames, the remaining threads, and then the remaining images. Each thread and image is sized before it is
+ * written, and is omitted if it would not fit within the limit; threads are omitted before any image. The number of
+ * omitted threads and images is recorded in the report.
+ *
+ * Without prioritized output, a report that exceeds the limit may lose the binary images required to symbolicate
+ * its crashed thread.
+ *
+ * @param writer The writer to configure.
+ * @param enabled If true, prioritized output will be enabled.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_prioritized_output (plcrash_log_writer_t *writer, bool enabled) {
+    writer->prioritized_output = enabled;
 
-    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
     OSMemoryBarrier();
 }
 
 /**
- * Close the plcrash_writer_t output.
+ * Enable or disable fast capture of non-crashed threads. When enabled, threads other than the crashed thread are
+ * unwound using only frame pointers, and their frames are written as PC values alone, without symbols or register
+ * state. This considerably reduces the cost of capturing all threads, at the cost of accuracy for functions that do
+ * not maintain a frame pointer.
  *
- * @param writer Writer instance to be closed.
+ * @param writer The writer to configure.
+ * @param enabled If true, fast capture will be enabled.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
  */
-plcrash_error_t plcrash_log_writer_close (plcrash_log_writer_t *writer) {
-    return PLCRASH_ESUCCESS;
+void plcrash_log_writer_set_fast_capture (plcrash_log_writer_t *writer, bool enabled) {
+    writer->fast_capture = enabled;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
 }
 
 /**
- * Free any crash log writer resources.
+ * Set the symbolication strategy to be used for frames within images of @a image_class, overriding the strategy
+ * supplied to plcrash_log_writer_init(). This allows crash-time symbolication to be limited to the images for which
+ * it is useful -- for example, symbolicating the application's own images while leaving system images, which are
+ * better symbolicated server-side, unsymbolicated.
  *
- * @warning This method is not async safe.
- */
+ * @param writer The writer to configure.
+ * @param image_class The image class to configure.
+ * @param symbol_strategy The strategy to use for images of @a image_class.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_image_symbol_strategy (plcrash_log_writer_t *writer, plcrash_async_image_class_t image_class, plcrash_async_symbol_strategy_t symbol_strategy) {
+    PLCF_ASSERT(image_class < PLCRASH_ASYNC_IMAGE_CLASS_COUNT);
+    writer->image_symbol_strategy[image_class] = symbol_strategy;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Set the maximum number of frames that will be written for a single thread. If a thread's stack exceeds
+ * this depth, the innermost and outermost halves of the limit are retained, and the frames between them are
+ * omitted; the number of omitted frames is recorded in the report.
+ *
+ * @param writer The writer to configure.
+ * @param max_frames The maximum number of frames. Values outside of the range 2 to 512 (the default) are clamped
+ * to that range.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_max_thread_frames (plcrash_log_writer_t *writer, uint32_t max_frames) {
+    if (max_frames < 2)
+        max_frames = 2;
+    else if (max_frames > MAX_THREAD_FRAMES)
+        max_frames = MAX_THREAD_FRAMES;
+
+    writer->max_thread_frames = max_frames;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Set the maximum number of threads to be written to a report. The crashed thread and the main thread (the first
+ * thread of the task) are always written; the remaining threads are written in task order until the limit is reached.
+ * Threads beyond the limit are neither suspended-state walked nor symbolicated, and their number is recorded in the
+ * report as elided threads.
+ *
+ * This bounds both the time spent writing a report and its size for processes that run many (mostly idle) threads.
+ *
+ * @param writer The writer to configure.
+ * @param max_threads The maximum number of threads, or 0 to write all threads.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_max_threads (plcrash_log_writer_t *writer, uint32_t max_threads) {
+    writer->max_threads = max_threads;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Restrict subsequent reports to the given @a threads, rather than all threads of the task. Only the listed threads
+ * are suspended, unwound, and written, and only the images referenced by their frames (along with the main
+ * executable) are written; the cost of a report scales with the number of threads requested, rather than with the
+ * number of threads in the task.
+ *
+ * Threads are written in the order given. As with a full report, the current thread may only be written if its state
+ * is supplied to plcrash_log_writer_write().
+ *
+ * If referenced image recording has not been enabled via plcrash_log_writer_enable_referenced_images(), it is
+ * enabled here, but only limits the written images while a subset is set.
+ *
+ * @param writer The writer to configure.
+ * @param threads The threads to be written, or NULL to write all threads. The array is not copied, and must remain
+ * valid until the subset is cleared.
+ * @param count The number of entries in @a threads.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the referenced image set could not be allocated.
+ * On failure to allocate the image set, the subset still applies to the report's threads.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_set_thread_subset (plcrash_log_writer_t *writer, const thread_t *threads, mach_msg_type_number_t count) {
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+
+    if (threads == NULL)
+        count = 0;
+
+    /* Record the referenced images, such that the remaining images may be omitted */
+    if (count > 0 && writer->referenced_images == NULL) {
+        plcrash_log_writer_image_set_t *set = calloc(1, sizeof(*set));
+        if (set != NULL) {
+            writer->referenced_images = set;
+            writer->deadline_image_set = true;
+        } else {
+            err = PLCRASH_ENOMEM;
+        }
+    }
+
+    writer->thread_subset = count > 0 ? threads : NULL;
+    writer->thread_subset_count = count;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return err;
+}
+
+/**
+ * Consult @a registry when writing reports of the current task, in place of task_threads() and a VM region lookup
+ * per thread. The registered threads are enumerated into a list preallocated here, and each thread's stack bounds
+ * and name are taken from its registry entry. Threads whose stack pointer lies outside of their registered stack,
+ * such as a thread executing on its signal stack, are bounded via a VM region lookup.
+ *
+ * The task's threads are enumerated via task_threads() if the registry may be incomplete, if the crashed thread is
+ * not registered, or while a thread subset is set via plcrash_log_writer_set_thread_subset().
+ *
+ * @param writer The writer to configure.
+ * @param registry The thread registry, as returned by plcrash_nasync_thread_registry_install(). The registry is not
+ * owned by the writer.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if a thread registry has already been set, or
+ * PLCRASH_ENOMEM if the thread list could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_set_thread_registry (plcrash_log_writer_t *writer, plcrash_async_thread_registry_t *registry) {
+    vm_address_t addr;
+
+    if (writer->thread_registry != NULL)
+        return PLCRASH_EINVAL;
+
+    if (vm_allocate(mach_task_self(), &addr, round_page(sizeof(thread_t) * registry->capacity), VM_FLAGS_ANYWHERE) != KERN_SUCCESS)
+        return PLCRASH_ENOMEM;
+
+    writer->thread_registry_threads = (thread_t *) addr;
+    writer->thread_registry = registry;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Set a time budget for writing each report, measured from the start of plcrash_log_writer_write(). Should the
+ * budget expire while the report is written, the remaining sections are written with reduced detail, in order of
+ * importance:
+ *
+ * - The crashed thread is always unwound and symbolicated in full.
+ * - The remaining threads are unwound using only frame pointers, and their frames are written without symbols.
+ * - Only the images referenced by the written frames, and the main executable, are written.
+ * - Stack and register memory are omitted.
+ *
+ * Reports written with reduced detail are marked as such in the report's truncation message.
+ *
+ * If referenced image recording has not been enabled via plcrash_log_writer_enable_referenced_images(), it is
+ * enabled here, but only limits the written images once the deadline has expired.
+ *
+ * @param writer The writer to configure.
+ * @param budget_ns The time budget in nanoseconds, or 0 to disable the deadline.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINTERNAL if the time base could not be determined, or
+ * PLCRASH_ENOMEM if the referenced image set could not be allocated. On failure to allocate the image set, the
+ * deadline still applies to the report's threads and memory.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_set_deadline (plcrash_log_writer_t *writer, uint64_t budget_ns) {
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+    mach_timebase_info_data_t timebase;
+
+    if (budget_ns == 0) {
+        writer->deadline_budget = 0;
+        OSMemoryBarrier();
+        return PLCRASH_ESUCCESS;
+    }
+
+    if (mach_timebase_info(&timebase) != KERN_SUCCESS || timebase.numer == 0)
+        return PLCRASH_EINTERNAL;
+
+    /* Record the referenced images, such that the remaining images may be omitted once the deadline has expired */
+    if (writer->referenced_images == NULL) {
+        plcrash_log_writer_image_set_t *set = calloc(1, sizeof(*set));
+        if (set != NULL) {
+            writer->referenced_images = set;
+            writer->deadline_image_set = true;
+        } else {
+            err = PLCRASH_ENOMEM;
+        }
+    }
+
+    writer->deadline_budget = MAX(budget_ns / timebase.numer * timebase.denom, 1);
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return err;
+}
+
+/**
+ * Set the breadcrumb ring whose contents will be included in written reports.
+ *
+ * @param writer The writer to configure.
+ * @param ring The breadcrumb ring, or NULL to omit breadcrumbs. The ring must remain valid for the lifetime of
+ * @a writer, or until replaced.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_breadcrumbs (plcrash_log_writer_t *writer, plcrash_breadcrumb_ring_t *ring) {
+    writer->breadcrumbs = ring;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Set the registry of application-owned memory regions whose contents will be included in written reports.
+ *
+ * @param writer The writer to configure.
+ * @param registry The custom data registry, or NULL to omit custom data. The registry must remain valid for the
+ * lifetime of @a writer, or until replaced.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_custom_data (plcrash_log_writer_t *writer, plcrash_custom_data_registry_t *registry) {
+    writer->custom_data = registry;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Set the image manifest to be referenced by written reports. The manifest's images will be omitted from each report,
+ * which will instead reference the manifest by its identifier.
+ *
+ * The manifest may be replaced while reports are being written; a report that is being written concurrently may
+ * continue to reference the previous manifest.
+ *
+ * @param writer The writer to configure.
+ * @param manifest The image manifest, or NULL to write all images. The manifest must remain valid for the lifetime
+ * of @a writer; a replaced manifest must not be freed while a report may still be written.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_image_manifest (plcrash_log_writer_t *writer, plcrash_log_writer_image_manifest_t *manifest) {
+    /* Ensure that the manifest's contents are visible prior to its publication */
+    OSMemoryBarrier();
+    writer->image_manifest = manifest;
+    OSMemoryBarrier();
+}
+
+/**
+ * Enable or disable compression of repeated frames. When enabled, consecutive repeats of a cycle of up to
+ * eight frames -- as produced by deep recursion -- are written as a single instance of the cycle along with
+ * a repeat count. Compression is enabled by default.
+ *
+ * @param writer The writer to configure.
+ * @param enabled If true, frame compression will be enabled.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_frame_compression (plcrash_log_writer_t *writer, bool enabled) {
+    writer->compress_frames = enabled;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Enable the per-report symbol name table. Once enabled, each unique symbol name is written only once per report,
+ * and symbol records reference the name by index. Reports are written with the
+ * #PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE file version, and can not be decoded by readers that predate the
+ * symbol table.
+ *
+ * @param writer The writer to configure.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the table could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_enable_symbol_table (plcrash_log_writer_t *writer) {
+    if (writer->symbol_table != NULL)
+        return PLCRASH_ESUCCESS;
+
+    plcrash_log_writer_symbol_table_t *table = calloc(1, sizeof(*table));
+    if (table == NULL)
+        return PLCRASH_ENOMEM;
+
+    writer->symbol_table = table;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Write only the binary images referenced by the frames written to each report, along with the main executable,
+ * rather than every loaded image. The referenced images are recorded as the report's threads and exception
+ * backtrace are written. Processes commonly have several hundred images loaded, of which only a few dozen are
+ * referenced by any frame.
+ *
+ * @param writer The writer to configure.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the image set could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_enable_referenced_images (plcrash_log_writer_t *writer) {
+    /* A set allocated for the deadline now limits the written images unconditionally */
+    if (writer->referenced_images != NULL) {
+        writer->deadline_image_set = false;
+        OSMemoryBarrier();
+        return PLCRASH_ESUCCESS;
+    }
+
+    plcrash_log_writer_image_set_t *set = calloc(1, sizeof(*set));
+    if (set == NULL)
+        return PLCRASH_ENOMEM;
+
+    writer->referenced_images = set;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Reuse @a cache for symbol lookups in all reports written by @a writer, rather than initializing and freeing a
+ * new symbol cache for each report. This allows the Objective-C metadata cache to remain warm across repeated
+ * live reports.
+ *
+ * @param writer The writer to configure.
+ * @param cache An initialized symbol cache, or NULL to use a per-report cache. The caller retains ownership of
+ * the cache, which must remain valid for the lifetime of the writer, and may not be shared by writers that are
+ * in use concurrently.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_symbol_cache (plcrash_log_writer_t *writer, plcrash_async_symbol_cache_t *cache) {
+    writer->symbol_cache = cache;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Record symbol look-up results by PC while writing each report, so that frames shared by many threads (such as
+ * the mach_msg_trap return address of idle run loop threads) are only symbolicated once per report. The results
+ * are discarded after each report, as the images they reference may be unloaded between reports.
+ *
+ * Each entry holds a copy of the symbol name, and requires roughly PLCRASH_ASYNC_SYMBOL_NAME_BUFLEN bytes.
+ *
+ * @param writer The writer to configure.
+ * @param count The number of cache entries. Must be a power of two.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a count is not a non-zero power of two, or
+ * PLCRASH_ENOMEM if the cache could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_enable_symbol_pc_cache (plcrash_log_writer_t *writer, size_t count) {
+    if (count == 0 || (count & (count - 1)) != 0)
+        return PLCRASH_EINVAL;
+
+    if (writer->symbol_pc_cache != NULL)
+        return PLCRASH_ESUCCESS;
+
+    plcrash_async_symbol_cache_entry_t *entries = calloc(count, sizeof(*entries));
+    if (entries == NULL)
+        return PLCRASH_ENOMEM;
+
+    writer->symbol_pc_cache = entries;
+    writer->symbol_pc_cache_count = count;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Seed a map of known readable and unreadable memory ranges while writing each report, allowing the frame readers
+ * to fail reads of invalid pointers (such as those found on corrupted stacks) without issuing a kernel call. The
+ * map is seeded with the loaded images' text segments, the NULL page, and the crashed thread's stack and guard
+ * regions.
+ *
+ * @param writer The writer to configure.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the map could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_enable_region_map (plcrash_log_writer_t *writer) {
+    if (writer->region_map != NULL)
+        return PLCRASH_ESUCCESS;
+
+    plcrash_async_region_map_t *map = calloc(1, sizeof(*map));
+    if (map == NULL)
+        return PLCRASH_ENOMEM;
+
+    plcrash_async_region_map_init(map, writer->task);
+    writer->region_map = map;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Record per-phase timing and event counts for each report written by @a writer, including thread suspension,
+ * unwinding, symbol lookup, and output time, and the number of memory objects mapped and task memory reads
+ * performed. The measurements are written as the report's instrumentation message.
+ *
+ * The event counters are process-wide; while any writer has instrumentation enabled, all async-safe memory reads
+ * and symbol lookups are counted.
+ *
+ * @param writer The writer to configure.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_enable_instrumentation (plcrash_log_writer_t *writer) {
+    if (writer->instrumentation)
+        return;
+
+    plcrash_nasync_metrics_enable();
+    writer->instrumentation = true;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Enable packed register encoding. Once enabled, each thread's registers are written as a single packed array of
+ * values, and the report records the register set once, from which readers derive the register names. Reports are
+ * written with the #PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS file version, and can not be decoded by readers
+ * that predate packed registers.
+ *
+ * @param writer The writer to configure.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_enable_packed_registers (plcrash_log_writer_t *writer) {
+    writer->packed_registers = true;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Record @a thread as having crashed while the report for another crashed thread is being generated. When the
+ * report is written, the thread is unwound from @a thread_state, rather than from its current state, and is marked
+ * as having also crashed.
+ *
+ * At most #PLCRASH_LOG_WRITER_SECONDARY_CRASH_MAX threads may be recorded. A thread recorded after the thread has
+ * already been written to the report is written without its crash state.
+ *
+ * @param writer The writer to which the thread will be added.
+ * @param thread The crashed thread.
+ * @param thread_state The thread's state at the time of its crash.
+ *
+ * @return Returns true if the thread was recorded, or false if no slots remain.
+ *
+ * @par Async Safety
+ * This function is async-safe, and may be called concurrently from multiple crashing threads.
+ */
+bool plcrash_log_writer_add_secondary_crash (plcrash_log_writer_t *writer, thread_t thread, const plcrash_async_thread_state_t *thread_state) {
+    int32_t idx = OSAtomicIncrement32Barrier(&writer->secondary_crash_count) - 1;
+    if (idx >= PLCRASH_LOG_WRITER_SECONDARY_CRASH_MAX)
+        return false;
+
+    plcrash_log_writer_secondary_crash_t *crash = &writer->secondary_crashes[idx];
+    crash->thread = thread;
+    plcrash_async_thread_state_copy(&crash->thread_state, thread_state);
+
+    /* Publish the entry only once it has been populated */
+    OSMemoryBarrier();
+    crash->ready = 1;
+
+    return true;
+}
+
+/**
+ * Set the state of the crashed thread at the time of its crash, as supplied to the crash handler; for example, the
+ * thread state delivered with a Mach exception message. When set, the crashed thread is unwound from @a thread_state,
+ * and its state is not fetched from the thread.
+ *
+ * @param writer The writer to configure.
+ * @param thread_state The crashed thread's state, or NULL to fetch the state from the crashed thread.
+ *
+ * @par Async Safety
+ * This function is async-safe, and must be called prior to plcrash_log_writer_write().
+ */
+void plcrash_log_writer_set_crashed_thread_state (plcrash_log_writer_t *writer, const plcrash_async_thread_state_t *thread_state) {
+    writer->has_crashed_thread_state = false;
+    OSMemoryBarrier();
+
+    if (thread_state == NULL)
+        return;
+
+    plcrash_async_thread_state_copy(&writer->crashed_thread_state, thread_state);
+    OSMemoryBarrier();
+    writer->has_crashed_thread_state = true;
+}
+
+/**
+ * @internal
+ *
+ * Return the crashed thread's state supplied via plcrash_log_writer_set_crashed_thread_state(), or NULL if none.
+ */
+static plcrash_async_thread_state_t *plcrash_writer_crashed_thread_state (plcrash_log_writer_t *writer) {
+    if (!writer->has_crashed_thread_state)
+        return NULL;
+
+    OSMemoryBarrier();
+    return &writer->crashed_thread_state;
+}
+
+/**
+ * @internal
+ *
+ * Return the crash state recorded for @a thread via plcrash_log_writer_add_secondary_crash(), or NULL if none.
+ */
+static plcrash_async_thread_state_t *plcrash_writer_secondary_crash_state (plcrash_log_writer_t *writer, thread_t thread) {
+    int32_t count = MIN(writer->secondary_crash_count, PLCRASH_LOG_WRITER_SECONDARY_CRASH_MAX);
+    for (int32_t i = 0; i < count; i++) {
+        plcrash_log_writer_secondary_crash_t *crash = &writer->secondary_crashes[i];
+        if (crash->ready && crash->thread == thread) {
+            OSMemoryBarrier();
+            return &crash->thread_state;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Enable packed frame encoding. Once enabled, the frames of captured threads that carry no symbol, repeat, or
+ * omission data are written as a single packed array of delta-encoded PC values, rather than as individual frame
+ * messages. Reports are written with the #PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES file version, and can not be
+ * decoded by readers that predate packed frames.
+ *
+ * Frames are only packed when written from the writer's thread capture buffers; threads that are streamed directly
+ * from the frame cursor are written as individual frame messages.
+ *
+ * @param writer The writer to configure.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_enable_packed_frames (plcrash_log_writer_t *writer) {
+    writer->packed_frames = true;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Enable length backpatching. Once enabled, thread and exception messages written without an output budget are
+ * encoded exactly once: a fixed-width PLPROTOBUF_C_PADDED_LENGTH_SIZE byte length placeholder is written in place of
+ * the message's length prefix, and is patched once the message body has been written, rather than first sizing the
+ * message with a separate encoding pass. This costs a few bytes of padding per message; the padded prefix remains a
+ * valid varint, and the report format is unchanged.
+ *
+ * Backpatching is only applied to output that may be patched, as per plcrash_async_file_patchable(); compressed
+ * output, and messages that must fit an output budget, continue to be sized prior to being written.
+ *
+ * @param writer The writer to configure.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_enable_length_backpatching (plcrash_log_writer_t *writer) {
+    writer->backpatch_lengths = true;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Enable thread deduplication. Once enabled, a thread whose captured stack frames are identical to those of a
+ * previously written thread (as is common for idle worker threads) is written with a reference to that thread in
+ * place of its frames; its registers, if any, are still written. Reports are written with the
+ * #PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS file version, and can not be decoded by readers that predate
+ * thread deduplication. PLCrashReport restores the frames of deduplicated threads when the report is decoded.
+ *
+ * The crashed thread is always written in full. Threads are only deduplicated when written from the writer's thread
+ * capture buffers; threads that are streamed directly from the frame cursor are always written in full.
+ *
+ * @param writer The writer to configure.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the stack table could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_enable_thread_deduplication (plcrash_log_writer_t *writer) {
+    if (writer->stack_table != NULL)
+        return PLCRASH_ESUCCESS;
+
+    plcrash_log_writer_stack_table_t *table = calloc(1, sizeof(*table));
+    if (table == NULL)
+        return PLCRASH_ENOMEM;
+
+    writer->stack_table = table;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Copy up to @a size bytes of the crashed thread's stack memory, beginning at its stack pointer, into each report
+ * written by @a writer. If the report's threads are suspended while it is written, the stack memory of up to
+ * @a thread_count additional threads is also captured. Runs of zero bytes are omitted from the report, and the
+ * captured memory is further bounded by the output file's remaining limit.
+ *
+ * @param writer The writer to configure.
+ * @param size The maximum number of bytes to capture per thread.
+ * @param thread_count The maximum number of threads, other than the crashed thread, to capture.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a size is 0 or stack memory capture has already
+ * been enabled, or PLCRASH_ENOMEM if the capture buffer could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_enable_stack_memory (plcrash_log_writer_t *writer, size_t size, uint32_t thread_count) {
+    vm_address_t addr;
+
+    if (writer->stack_memory_buffer != NULL || size == 0)
+        return PLCRASH_EINVAL;
+
+    size = round_page(size);
+    if (vm_allocate(mach_task_self(), &addr, size, VM_FLAGS_ANYWHERE) != KERN_SUCCESS)
+        return PLCRASH_ENOMEM;
+
+    writer->stack_memory_buffer = (uint8_t *) addr;
+    writer->stack_memory_size = size;
+    writer->stack_memory_thread_count = thread_count;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Copy the memory surrounding each register value of the crashed thread that points into readable memory into each
+ * report written by @a writer. Overlapping windows are merged, and at most @a size bytes are written in total.
+ *
+ * @param writer The writer to configure.
+ * @param size The maximum total number of bytes to capture.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a size is 0 or register memory capture has already
+ * been enabled, or PLCRASH_ENOMEM if the capture buffer could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_enable_register_memory (plcrash_log_writer_t *writer, size_t size) {
+    vm_address_t addr;
+
+    if (writer->register_memory_buffer != NULL || size == 0)
+        return PLCRASH_EINVAL;
+
+    if (vm_allocate(mach_task_self(), &addr, round_page(size), VM_FLAGS_ANYWHERE) != KERN_SUCCESS)
+        return PLCRASH_ENOMEM;
+
+    writer->register_memory_buffer = (uint8_t *) addr;
+    writer->register_memory_size = size;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * The maximum encoded size of a single VM region table entry; five varints of at most 10 bytes each.
+ */
+#define PLCRASH_WRITER_VM_REGION_ENCODED_MAX (5 * 10)
+
+/**
+ * @internal
+ *
+ * Return the size of the allocation backing a VM region summary of @a max_regions regions; the region table is
+ * followed by its encoding buffer.
+ */
+static size_t plcrash_writer_vm_region_alloc_size (uint32_t max_regions) {
+    return round_page((sizeof(plcrash_log_writer_vm_region_t) + PLCRASH_WRITER_VM_REGION_ENCODED_MAX) * (size_t) max_regions);
+}
+
+/**
+ * Write a summary of the target task's virtual memory layout to each report written by @a writer. Regions are
+ * enumerated via mach_vm_region_recurse() into a preallocated table, and adjacent regions with identical protection,
+ * user tag, and share mode are coalesced. Enumeration stops once @a max_regions coalesced regions have been recorded,
+ * or once @a budget_ns has elapsed, and the summary is marked as truncated.
+ *
+ * This is primarily useful in diagnosing memory-related crashes, such as EXC_RESOURCE memory limit exceptions and
+ * allocation failures.
+ *
+ * @param writer The writer to configure.
+ * @param max_regions The maximum number of regions to record.
+ * @param budget_ns The maximum time to spend enumerating regions, in nanoseconds, or 0 for no limit.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a max_regions is 0 or the VM region summary has
+ * already been enabled, PLCRASH_EINTERNAL if the timebase could not be determined, or PLCRASH_ENOMEM if the region
+ * table could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_enable_vm_region_summary (plcrash_log_writer_t *writer, uint32_t max_regions, uint64_t budget_ns) {
+    mach_timebase_info_data_t timebase;
+    vm_address_t addr;
+
+    if (writer->vm_regions != NULL || max_regions == 0)
+        return PLCRASH_EINVAL;
+
+    if (budget_ns != 0 && (mach_timebase_info(&timebase) != KERN_SUCCESS || timebase.numer == 0))
+        return PLCRASH_EINTERNAL;
+
+    if (vm_allocate(mach_task_self(), &addr, plcrash_writer_vm_region_alloc_size(max_regions), VM_FLAGS_ANYWHERE) != KERN_SUCCESS)
+        return PLCRASH_ENOMEM;
+
+    writer->vm_regions = (plcrash_log_writer_vm_region_t *) addr;
+    writer->vm_region_buffer = (uint8_t *) (addr + sizeof(plcrash_log_writer_vm_region_t) * max_regions);
+    writer->vm_region_max = max_regions;
+    writer->vm_region_time_limit = (budget_ns != 0) ? MAX(budget_ns / timebase.numer * timebase.denom, 1) : 0;
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Fault in each of the buffers preallocated by @a writer's configuration, and optionally wire them into memory,
+ * such that writing a report from a crash handler does not incur a page fault on the first access to each buffer.
+ * This should be called once the writer has been fully configured.
+ *
+ * @param writer The writer to prepare.
+ * @param wire If true, the buffers are additionally wired via mlock().
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if one or more buffers could not be wired. All
+ * buffers will have been faulted in regardless.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_prefault (plcrash_log_writer_t *writer, bool wire) {
+    plcrash_error_t result = PLCRASH_ESUCCESS;
+    plcrash_error_t err;
+
+#define PL_PREFAULT(_call) do { \
+    if ((err = (_call)) != PLCRASH_ESUCCESS) \
+        result = err; \
+} while (0)
+
+    if (writer->allocator != NULL)
+        PL_PREFAULT(plcrash_async_allocator_prefault(writer->allocator, wire));
+
+    if (writer->capture_pool != NULL)
+        PL_PREFAULT(plcrash_writer_capture_pool_prefault(writer->capture_pool, wire));
+
+    if (writer->symbol_table != NULL)
+        PL_PREFAULT(plcrash_nasync_prefault(writer->symbol_table, sizeof(*writer->symbol_table), wire));
+
+    if (writer->referenced_images != NULL)
+        PL_PREFAULT(plcrash_nasync_prefault(writer->referenced_images, sizeof(*writer->referenced_images), wire));
+
+    if (writer->stack_table != NULL)
+        PL_PREFAULT(plcrash_nasync_prefault(writer->stack_table, sizeof(*writer->stack_table), wire));
+
+    if (writer->symbol_pc_cache != NULL)
+        PL_PREFAULT(plcrash_nasync_prefault(writer->symbol_pc_cache, writer->symbol_pc_cache_count * sizeof(*writer->symbol_pc_cache), wire));
+
+    if (writer->region_map != NULL)
+        PL_PREFAULT(plcrash_nasync_prefault(writer->region_map, sizeof(*writer->region_map), wire));
+
+    if (writer->stack_memory_buffer != NULL)
+        PL_PREFAULT(plcrash_nasync_prefault(writer->stack_memory_buffer, writer->stack_memory_size, wire));
+
+    if (writer->register_memory_buffer != NULL)
+        PL_PREFAULT(plcrash_nasync_prefault(writer->register_memory_buffer, writer->register_memory_size, wire));
+
+    if (writer->vm_regions != NULL)
+        PL_PREFAULT(plcrash_nasync_prefault(writer->vm_regions, plcrash_writer_vm_region_alloc_size(writer->vm_region_max), wire));
+
+    if (writer->thread_registry != NULL) {
+        PL_PREFAULT(plcrash_nasync_prefault(writer->thread_registry_threads, sizeof(thread_t) * writer->thread_registry->capacity, wire));
+        PL_PREFAULT(plcrash_nasync_prefault(writer->thread_registry->slots, sizeof(*writer->thread_registry->slots) * writer->thread_registry->capacity, wire));
+    }
+
+#undef PL_PREFAULT
+
+    return result;
+}
+
+/**
+ * Re-fetch the host OS version and build, and if either has changed, re-encode the writer's static report messages.
+ *
+ * The OS data is otherwise fetched only once, by plcrash_log_writer_init(); this may be called if the host
+ * OS data is expected to have changed while the process was running (eg, following a system sleep/wake cycle).
+ *
+ * @param writer The writer to update.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t value if the OS data could not be
+ * fetched. On failure, the writer's existing data is left unmodified.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler. It must not be called
+ * concurrently with any other writer configuration function.
+ */
+plcrash_error_t plcrash_log_writer_refresh_system_info (plcrash_log_writer_t *writer) {
+    char *version;
+    char *build;
+    plcrash_error_t err;
+
+    if ((err = plcrash_writer_fetch_os_version(&version, &build)) != PLCRASH_ESUCCESS) {
+        if (build != NULL)
+            free(build);
+        return err;
+    }
+
+    /* Nothing to do if the data is unchanged */
+    bool version_changed = (version == NULL || writer->system_info.version == NULL || strcmp(version, writer->system_info.version) != 0);
+    bool build_changed = (build == NULL) != (writer->system_info.build == NULL) ||
+        (build != NULL && strcmp(build, writer->system_info.build) != 0);
+
+    if (!version_changed && !build_changed) {
+        free(version);
+        if (build != NULL)
+            free(build);
+        return PLCRASH_ESUCCESS;
+    }
+
+    /* Swap in the new strings. The strings are only referenced at crash time if pre-encoding fails; in that case,
+     * the old strings are leaked rather than freed, as a signal handler may be concurrently using them. */
+    char *old_version = writer->system_info.version;
+    char *old_build = writer->system_info.build;
+
+    writer->system_info.version = version;
+    writer->system_info.build = build;
+    OSMemoryBarrier();
+
+    if (plcrash_writer_encode_static_sections(writer) == PLCRASH_ESUCCESS) {
+        if (old_version != NULL)
+            free(old_version);
+        if (old_build != NULL)
+            free(old_build);
+    } else {
+        PLCF_DEBUG("Could not pre-encode the static report messages");
+        plcrash_writer_static_sections_publish(writer, NULL);
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Set the uncaught exception for this writer. Once set, this exception will be used to
+ * provide exception data for the crash log output.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_exception (plcrash_log_writer_t *writer, NSException *exception) {
+    assert(writer->uncaught_exception.has_exception == false);
+
+    /* Save the exception data */
+    writer->uncaught_exception.has_exception = true;
+    writer->uncaught_exception.name = strdup([[exception name] UTF8String]);
+    writer->uncaught_exception.reason = strdup([[exception reason] UTF8String]);
+
+    /* Save the call stack, if available */
+    NSArray *callStackArray = [exception callStackReturnAddresses];
+    if (callStackArray != nil && [callStackArray count] > 0) {
+        size_t count = [callStackArray count];
+        writer->uncaught_exception.callstack_count = count;
+        writer->uncaught_exception.callstack = malloc(sizeof(void *) * count);
+
+        size_t i = 0;
+        for (NSNumber *num in callStackArray) {
+            assert(i < count);
+            writer->uncaught_exception.callstack[i] = (void *)(uintptr_t)[num unsignedLongLongValue];
+            i++;
+        }
+    }
+#if TARGET_OS_MAC && !TARGET_OS_IPHONE && !TARGET_IPHONE_SIMULATOR
+    else {
+        /* Parse the addresses of the textual stack trace directly into the call stack */
+        NSArray *frames = [[[exception userInfo] objectForKey:NSStackTraceKey] componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        if ([frames count] > 0) {
+            writer->uncaught_exception.callstack = malloc(sizeof(void *) * [frames count]);
+
+            size_t count = 0;
+            for (NSString *frame in frames) {
+                unsigned long address = strtoul([frame cStringUsingEncoding:NSASCIIStringEncoding], NULL, 16);
+                writer->uncaught_exception.callstack[count++] = (void *)(uintptr_t) address;
+            }
+            writer->uncaught_exception.callstack_count = count;
+        }
+    }
+#endif
+
+    /* Record the call stack in a capture buffer, allowing its frames to be symbolicated once per report */
+    if (writer->uncaught_exception.callstack_count > 0) {
+        plcrash_log_writer_thread_buffer_t *buffer = calloc(1, sizeof(plcrash_log_writer_thread_buffer_t));
+        if (buffer != NULL) {
+            size_t count = MIN(writer->uncaught_exception.callstack_count, (size_t) MAX_THREAD_FRAMES);
+            for (size_t i = 0; i < count; i++)
+                buffer->frames[i].pc = (uint64_t)(uintptr_t) writer->uncaught_exception.callstack[i];
+            buffer->frame_count = (uint32_t) count;
+
+            writer->uncaught_exception.frame_buffer = buffer;
+        }
+    }
+
+    writer->uncaught_exception.user_info_size = [[exception userInfo] count];
+    writer->uncaught_exception.user_info = malloc(sizeof(user_info_t) * [[exception userInfo] count]);
+    uint64_t index = 0;
+    for (NSString *key in [exception userInfo]) {
+        id object = [[exception userInfo] objectForKey:key];
+        writer->uncaught_exception.user_info[index].key = strdup([key UTF8String]);
+        if ([object conformsToProtocol:@protocol(NSCoding)]) {
+            NSMutableData *encoded = [[NSMutableData alloc] init];
+            NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initForWritingWithMutableData:encoded];
+            [archiver setOutputFormat:NSPropertyListXMLFormat_v1_0];
+            [archiver encodeRootObject:object];
+            [archiver finishEncoding];
+            [archiver release];
+            NSString *string = [[NSString alloc] initWithData:encoded encoding:NSUTF8StringEncoding];
+            [encoded release];
+            writer->uncaught_exception.user_info[index].serialized = strdup([string UTF8String]);
+            [string release];
+        } else
+            writer->uncaught_exception.user_info[index].serialized = strdup([[object description] UTF8String]);
+
+        index++;
+    }
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Configure the writer to report on @a task, rather than the current task. The writer's process data is replaced
+ * with that of the target process, and all threads of @a task will be suspended, unwound, and written by
+ * plcrash_log_writer_write(). The image list supplied to plcrash_log_writer_write() must also have been initialized
+ * with @a task.
+ *
+ * This allows a separate monitor process, holding a send right to the target's task port, to write crash reports
+ * for the target out-of-process.
+ *
+ * @param writer The writer to configure.
+ * @param task The target task. The caller is responsible for retaining a send right to the task for the lifetime
+ * of the writer.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if the target's process information could not be
+ * fetched. On failure, the writer's existing target is left unmodified.
+ *
+ * @warning This function is not async safe, and must be called prior to making the writer available to a signal
+ * or exception handler.
+ */
+plcrash_error_t plcrash_log_writer_set_target_task (plcrash_log_writer_t *writer, task_t task) {
+    pid_t pid;
+    kern_return_t kr;
+
+    if (task == mach_task_self()) {
+        writer->task = task;
+        return PLCRASH_ESUCCESS;
+    }
+
+    if ((kr = pid_for_task(task, &pid)) != KERN_SUCCESS) {
+        PLCF_DEBUG("Could not determine the target task's pid: %d", kr);
+        return PLCRASH_EINVAL;
+    }
+
+    PLCrashProcessInfo *pinfo = [[[PLCrashProcessInfo alloc] initWithProcessID: pid] autorelease];
+    if (pinfo == nil) {
+        PLCF_DEBUG("Could not retreive process info for target: %s", strerror(errno));
+        return PLCRASH_EINVAL;
+    }
+
+    /* Replace the process info */
+    if (writer->process_info.process_name != NULL)
+        free(writer->process_info.process_name);
+    if (writer->process_info.process_path != NULL)
+        free(writer->process_info.process_path);
+    if (writer->process_info.parent_process_name != NULL)
+        free(writer->process_info.parent_process_name);
+
+    writer->process_info.process_id = pinfo.processID;
+    writer->process_info.process_name = strdup([pinfo.processName UTF8String]);
+    writer->process_info.start_time = pinfo.startTime.tv_sec;
+    writer->process_info.process_path = NULL;
+    writer->process_info.parent_process_name = NULL;
+
+#if TARGET_OS_MAC && !TARGET_OS_IPHONE && !TARGET_IPHONE_SIMULATOR
+    {
+        char path[PROC_PIDPATHINFO_MAXSIZE];
+        if (proc_pidpath(pid, path, sizeof(path)) > 0) {
+            writer->process_info.process_path = strdup(path);
+        } else {
+            PLCF_DEBUG("Could not retreive the target process path: %s", strerror(errno));
+        }
+    }
+#endif
+
+    writer->process_info.parent_process_id = pinfo.parentProcessID;
+    PLCrashProcessInfo *parentInfo = [[[PLCrashProcessInfo alloc] initWithProcessID: pinfo.parentProcessID] autorelease];
+    if (parentInfo != nil) {
+        writer->process_info.parent_process_name = strdup([parentInfo.processName UTF8String]);
+    } else {
+        PLCF_DEBUG("Could not retreive parent process name: %s", strerror(errno));
+    }
+
+    /* sysctl.proc_native describes only the calling process; check the target for translation directly. */
+#ifdef P_TRANSLATED
+    {
+        struct kinfo_proc kp;
+        size_t len = sizeof(kp);
+        int mib[] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, pid };
+
+        if (sysctl(mib, sizeof(mib) / sizeof(mib[0]), &kp, &len, NULL, 0) == 0 && len > 0)
+            writer->process_info.native = (kp.kp_proc.p_flag & P_TRANSLATED) == 0;
+    }
+#endif
+
+    writer->task = task;
+
+    /* Re-encode the static report messages with the target's process info */
+    if (plcrash_writer_encode_static_sections(writer) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not pre-encode the static report messages");
+        plcrash_writer_static_sections_publish(writer, NULL);
+    }
+
+    /* Ensure that any signal handler has a consistent view of the above configuration. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Configure the writer to read thread and memory state from @a corpse, a corpse task generated via
+ * task_generate_corpse() for the writer's current target task. The writer's process data is left unmodified;
+ * as a corpse has no associated process, the process data must first be populated via
+ * plcrash_log_writer_set_target_task() while the crashed task is still alive.
+ *
+ * This allows the crashed task to be released and terminated immediately, while its report is written from the
+ * corpse.
+ *
+ * @param writer The writer to configure.
+ * @param corpse The corpse task. The caller is responsible for retaining a send right to the corpse for the lifetime
+ * of the writer. The image list and crashed thread supplied to plcrash_log_writer_write() must also be those of
+ * @a corpse.
+ *
+ * @warning This function is not async safe.
+ */
+void plcrash_log_writer_set_target_corpse (plcrash_log_writer_t *writer, task_t corpse) {
+    writer->task = corpse;
+    OSMemoryBarrier();
+}
+
+/**
+ * Close the plcrash_writer_t output.
+ *
+ * @param writer Writer instance to be closed.
+ */
+plcrash_error_t plcrash_log_writer_close (plcrash_log_writer_t *writer) {
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Free any crash log writer resources.
+ *
+ * @warning This method is not async safe.
+ */
 void plcrash_log_writer_free (plcrash_log_writer_t *writer) {
     /* Free the app info */
     if (writer->application_info.app_identifier != NULL)
@@ -556,393 +1716,4169 @@ void plcrash_log_writer_free (plcrash_log_writer_t *writer) {
     if (writer->application_info.app_version != NULL)
         free(writer->application_info.app_version);
 
-    /* Free the process info */
-    if (writer->process_info.process_name != NULL) 
-        free(writer->process_info.process_name);
-    if (writer->process_info.process_path != NULL) 
-        free(writer->process_info.process_path);
-    if (writer->process_info.parent_process_name != NULL) 
-        free(writer->process_info.parent_process_name);
+    /* Free the process info */
+    if (writer->process_info.process_name != NULL) 
+        free(writer->process_info.process_name);
+    if (writer->process_info.process_path != NULL) 
+        free(writer->process_info.process_path);
+    if (writer->process_info.parent_process_name != NULL) 
+        free(writer->process_info.parent_process_name);
+    
+    /* Free the system info */
+    if (writer->system_info.version != NULL)
+        free(writer->system_info.version);
+    
+    if (writer->system_info.build != NULL)
+        free(writer->system_info.build);
+    
+    /* Free the machine info */
+    if (writer->machine_info.model != NULL)
+        free(writer->machine_info.model);
+
+    /* Free the exception data */
+    if (writer->uncaught_exception.has_exception) {
+        if (writer->uncaught_exception.name != NULL)
+            free(writer->uncaught_exception.name);
+
+        if (writer->uncaught_exception.reason != NULL)
+            free(writer->uncaught_exception.reason);
+        
+        if (writer->uncaught_exception.callstack != NULL)
+            free(writer->uncaught_exception.callstack);
+
+        if (writer->uncaught_exception.frame_buffer != NULL)
+            free(writer->uncaught_exception.frame_buffer);
+
+        if (writer->uncaught_exception.user_info != NULL) {
+            for (uint64_t i=0; i!=writer->uncaught_exception.user_info_size; i++) {
+                if (writer->uncaught_exception.user_info[i].key != NULL)
+                    free(writer->uncaught_exception.user_info[i].key);
+                if (writer->uncaught_exception.user_info[i].serialized != NULL)
+                    free(writer->uncaught_exception.user_info[i].serialized);
+            }
+            free(writer->uncaught_exception.user_info);
+        }
+    }
+
+    /* Release our instrumentation reference */
+    if (writer->instrumentation) {
+        plcrash_nasync_metrics_disable();
+        writer->instrumentation = false;
+    }
+
+    /* Stop the capture pool */
+    if (writer->capture_pool != NULL) {
+        plcrash_writer_capture_pool_free(writer->capture_pool);
+        writer->capture_pool = NULL;
+    }
+
+    /* Stop the symbolication helper */
+    if (writer->symbolication_pipeline != NULL) {
+        plcrash_writer_symbolication_pipeline_free(writer->symbolication_pipeline);
+        writer->symbolication_pipeline = NULL;
+    }
+
+    /* Free the thread capture buffer */
+    if (writer->allocator != NULL) {
+        plcrash_async_allocator_free(writer->allocator);
+        writer->allocator = NULL;
+        writer->thread_buffer = NULL;
+    }
+
+    /* Free the stack memory buffer */
+    if (writer->stack_memory_buffer != NULL) {
+        vm_deallocate(mach_task_self(), (vm_address_t) writer->stack_memory_buffer, writer->stack_memory_size);
+        writer->stack_memory_buffer = NULL;
+    }
+
+    /* Free the register memory buffer */
+    if (writer->register_memory_buffer != NULL) {
+        vm_deallocate(mach_task_self(), (vm_address_t) writer->register_memory_buffer, round_page(writer->register_memory_size));
+        writer->register_memory_buffer = NULL;
+    }
+
+    /* Free the VM region table */
+    if (writer->vm_regions != NULL) {
+        vm_deallocate(mach_task_self(), (vm_address_t) writer->vm_regions, plcrash_writer_vm_region_alloc_size(writer->vm_region_max));
+        writer->vm_regions = NULL;
+        writer->vm_region_buffer = NULL;
+    }
+
+    /* Free the registry thread list; the registry itself is not owned by the writer */
+    if (writer->thread_registry != NULL) {
+        vm_deallocate(mach_task_self(), (vm_address_t) writer->thread_registry_threads, round_page(sizeof(thread_t) * writer->thread_registry->capacity));
+        writer->thread_registry_threads = NULL;
+        writer->thread_registry = NULL;
+    }
+
+    /* Free the symbol table */
+    if (writer->symbol_table != NULL) {
+        free(writer->symbol_table);
+        writer->symbol_table = NULL;
+    }
+
+    /* Free the referenced image set */
+    if (writer->referenced_images != NULL) {
+        free(writer->referenced_images);
+        writer->referenced_images = NULL;
+    }
+
+    /* Free the stack table */
+    if (writer->stack_table != NULL) {
+        free(writer->stack_table);
+        writer->stack_table = NULL;
+    }
+
+    /* Free the per-PC symbol cache */
+    if (writer->symbol_pc_cache != NULL) {
+        free(writer->symbol_pc_cache);
+        writer->symbol_pc_cache = NULL;
+        writer->symbol_pc_cache_count = 0;
+    }
+
+    /* Free the region map */
+    if (writer->region_map != NULL) {
+        free(writer->region_map);
+        writer->region_map = NULL;
+    }
+
+    /* Free the pre-encoded messages */
+    if (writer->static_sections != NULL) {
+        free(writer->static_sections);
+        writer->static_sections = NULL;
+    }
+
+    if (writer->retired_static_sections != NULL) {
+        free(writer->retired_static_sections);
+        writer->retired_static_sections = NULL;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Write the static fields of the system info message; this includes all fields but the timestamp.
+ *
+ * @param file Output file
+ */
+static size_t plcrash_writer_write_system_info_static (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
+    size_t rv = 0;
+    uint32_t enumval;
+
+    /* OS */
+    enumval = PLCrashReportHostOperatingSystem;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_OS_ID, PLPROTOBUF_C_TYPE_ENUM, &enumval);
+
+    /* OS Version */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_OS_VERSION_ID, PLPROTOBUF_C_TYPE_STRING, writer->system_info.version);
+    
+    /* OS Build */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_OS_BUILD_ID, PLPROTOBUF_C_TYPE_STRING, writer->system_info.build);
+
+    /* Machine type */
+    enumval = PLCrashReportHostArchitecture;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_ARCHITECTURE_TYPE_ID, PLPROTOBUF_C_TYPE_ENUM, &enumval);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the system info message.
+ *
+ * @param file Output file
+ * @param timestamp Timestamp to use (seconds since epoch). Must be same across calls, as varint encoding.
+ */
+static size_t plcrash_writer_write_system_info (plcrash_async_file_t *file, plcrash_log_writer_t *writer, int64_t timestamp) {
+    size_t rv = 0;
+    plcrash_log_writer_static_sections_t *sections = writer->static_sections;
+
+    /* Static fields */
+    if (sections != NULL) {
+        if (file != NULL)
+            plcrash_async_file_write(file, sections->system_info, sections->system_info_len);
+        rv += sections->system_info_len;
+    } else {
+        rv += plcrash_writer_write_system_info_static(file, writer);
+    }
+
+    /* Timestamp */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_TIMESTAMP_ID, PLPROTOBUF_C_TYPE_INT64, &timestamp);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Processor info message storage, initialized by plcrash_writer_processor_message_init(). The message's fields refer
+ * to the values held by this structure, and it must not be copied once initialized.
+ */
+typedef struct plcrash_writer_processor_message {
+    /** CrashReport.Processor.encoding */
+    uint32_t encoding;
+
+    /** CrashReport.Processor.type */
+    uint64_t cpu_type;
+
+    /** CrashReport.Processor.subtype */
+    uint64_t cpu_subtype;
+
+    /** Field table. */
+    plcrash_writer_field_t fields[3];
+
+    /** The message. */
+    plcrash_writer_message_t message;
+} plcrash_writer_processor_message_t;
+
+/**
+ * @internal
+ *
+ * Initialize @a storage with a processor info message, and return the message.
+ *
+ * @param storage The message storage to initialize.
+ * @param cpu_type The Mach CPU type.
+ * @param cpu_subtype_t The Mach CPU subtype
+ */
+static plcrash_writer_message_t *plcrash_writer_processor_message_init (plcrash_writer_processor_message_t *storage, uint64_t cpu_type, uint64_t cpu_subtype) {
+    storage->encoding = PLCrashReportProcessorTypeEncodingMach;
+    storage->cpu_type = cpu_type;
+    storage->cpu_subtype = cpu_subtype;
+
+    plcrash_writer_field_t fields[] = {
+        { PLCRASH_PROTO_PROCESSOR_ENCODING_ID,  PLPROTOBUF_C_TYPE_ENUM,     &storage->encoding },
+        { PLCRASH_PROTO_PROCESSOR_TYPE_ID,      PLPROTOBUF_C_TYPE_UINT64,   &storage->cpu_type },
+        { PLCRASH_PROTO_PROCESSOR_SUBTYPE_ID,   PLPROTOBUF_C_TYPE_UINT64,   &storage->cpu_subtype },
+    };
+    memcpy(storage->fields, fields, sizeof(storage->fields));
+
+    plcrash_writer_message_t message = PLCRASH_WRITER_MESSAGE_INIT(storage->fields);
+    storage->message = message;
+    return &storage->message;
+}
+
+/**
+ * @internal
+ *
+ * Write the machine info message.
+ *
+ * @param file Output file
+ */
+static size_t plcrash_writer_write_machine_info (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
+    size_t rv = 0;
+    
+    /* Model */
+    if (writer->machine_info.model != NULL)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_MODEL_ID, PLPROTOBUF_C_TYPE_STRING, writer->machine_info.model);
+
+    /* Processor */
+    {
+        plcrash_writer_processor_message_t processor;
+        plcrash_writer_message_t *message = plcrash_writer_processor_message_init(&processor, writer->machine_info.cpu_type, writer->machine_info.cpu_subtype);
+        rv += plcrash_writer_pack_embedded_message(file, PLCRASH_PROTO_MACHINE_INFO_PROCESSOR_ID, message);
+    }
+
+    /* Physical Processor Count */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_PROCESSOR_COUNT_ID, PLPROTOBUF_C_TYPE_UINT32, &writer->machine_info.processor_count);
+    
+    /* Logical Processor Count */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_LOGICAL_PROCESSOR_COUNT_ID, PLPROTOBUF_C_TYPE_UINT32, &writer->machine_info.logical_processor_count);
+    
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the app info message.
+ *
+ * @param file Output file
+ * @param app_identifier Application identifier
+ * @param app_version Application version
+ */
+static size_t plcrash_writer_write_app_info (plcrash_async_file_t *file, const char *app_identifier, const char *app_version) {
+    size_t rv = 0;
+
+    /* App identifier */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_APP_INFO_APP_IDENTIFIER_ID, PLPROTOBUF_C_TYPE_STRING, app_identifier);
+    
+    /* App version */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_APP_INFO_APP_VERSION_ID, PLPROTOBUF_C_TYPE_STRING, app_version);
+    
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the process info message.
+ *
+ * @param file Output file
+ * @param process_name Process name
+ * @param process_id Process ID
+ * @param process_path Process path
+ * @param parent_process_name Parent process name
+ * @param parent_process_id Parent process ID
+ * @param native If false, process is running under emulation.
+ * @param start_time The start time of the process.
+ */
+static size_t plcrash_writer_write_process_info (plcrash_async_file_t *file, const char *process_name,
+                                                 const pid_t process_id, const char *process_path, 
+                                                 const char *parent_process_name, const pid_t parent_process_id,
+                                                 bool native, time_t start_time)
+{
+    size_t rv = 0;
+    uint64_t tval;
+
+    /*
+     * In the current crash reporter serialization format, pid values are serialized as unsigned 32-bit integers. This
+     * conforms with the actual implementation of pid_t on both 32-bit and 64-bit Darwin systems. To conform with
+     * SuSV3, however, the values should be encoded as signed integers; the actual width of the type being implementation
+     * defined.
+     *
+     * To maintain compatibility with existing report readers the values remain encoded as unsigned 32-bit integers,
+     * but should be updated to int64 values in future major revision of the data format.
+     */
+    uint32_t pidval;
+
+    /* Process name */
+    if (process_name != NULL)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PROCESS_NAME_ID, PLPROTOBUF_C_TYPE_STRING, process_name);
+
+    /* Process ID */
+    pidval = process_id;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PROCESS_ID_ID, PLPROTOBUF_C_TYPE_UINT32, &pidval);
+
+    /* Process path */
+    if (process_path != NULL)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PROCESS_PATH_ID, PLPROTOBUF_C_TYPE_STRING, process_path);
+    
+    /* Parent process name */
+    if (parent_process_name != NULL)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PARENT_PROCESS_NAME_ID, PLPROTOBUF_C_TYPE_STRING, parent_process_name);
+    
+
+    /* Parent process ID */
+    pidval = parent_process_id;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PARENT_PROCESS_ID_ID, PLPROTOBUF_C_TYPE_UINT32, &pidval);
+
+    /* Native process. */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_NATIVE_ID, PLPROTOBUF_C_TYPE_BOOL, &native);
+    
+    /* Start time */
+    tval = start_time;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_START_TIME_ID, PLPROTOBUF_C_TYPE_UINT64, &tval);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the complete machine info, app info, and process info top-level messages.
+ *
+ * @param file Output file
+ */
+static size_t plcrash_writer_write_static_messages (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
+    size_t rv = 0;
+
+    /* Machine Info */
+    {
+        uint32_t size;
+
+        /* Determine size */
+        size = plcrash_writer_write_machine_info(NULL, writer);
+
+        /* Write message */
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_write_machine_info(file, writer);
+    }
+
+    /* App info */
+    {
+        uint32_t size;
+
+        /* Determine size */
+        size = plcrash_writer_write_app_info(NULL, writer->application_info.app_identifier, writer->application_info.app_version);
+
+        /* Write message */
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_APP_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_write_app_info(file, writer->application_info.app_identifier, writer->application_info.app_version);
+    }
+
+    /* Process info */
+    {
+        uint32_t size;
+
+        /* Determine size */
+        size = plcrash_writer_write_process_info(NULL, writer->process_info.process_name, writer->process_info.process_id,
+                                                 writer->process_info.process_path, writer->process_info.parent_process_name,
+                                                 writer->process_info.parent_process_id, writer->process_info.native,
+                                                 writer->process_info.start_time);
+
+        /* Write message */
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_write_process_info(file, writer->process_info.process_name, writer->process_info.process_id,
+                                                writer->process_info.process_path, writer->process_info.parent_process_name,
+                                                writer->process_info.parent_process_id, writer->process_info.native,
+                                                writer->process_info.start_time);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Atomically publish @a sections as the writer's static sections, freeing any previously retired sections, and
+ * retiring the current sections. The current sections are not immediately freed, as they may be in use by a
+ * concurrently executing signal handler.
+ *
+ * @param writer The writer to update.
+ * @param sections The new sections, or NULL to disable use of pre-encoded messages.
+ *
+ * @warning This function is not async-safe.
+ */
+static void plcrash_writer_static_sections_publish (plcrash_log_writer_t *writer, plcrash_log_writer_static_sections_t *sections) {
+    plcrash_log_writer_static_sections_t *old_sections;
+
+    OSMemoryBarrier();
+    do {
+        old_sections = writer->static_sections;
+    } while (!OSAtomicCompareAndSwapPtrBarrier(old_sections, sections, (void **) &writer->static_sections));
+
+    if (writer->retired_static_sections != NULL)
+        free(writer->retired_static_sections);
+    writer->retired_static_sections = old_sections;
+}
+
+/**
+ * @internal
+ *
+ * Encode the writer's static report messages, and publish them for use by plcrash_log_writer_write().
+ *
+ * @param writer The writer for which the messages should be encoded.
+ *
+ * @warning This function is not async-safe.
+ */
+static plcrash_error_t plcrash_writer_encode_static_sections (plcrash_log_writer_t *writer) {
+    plcrash_log_writer_static_sections_t *sections;
+    plcrash_async_file_t file;
+
+    /* Determine the required sizes */
+    size_t system_info_len = plcrash_writer_write_system_info_static(NULL, writer);
+    size_t messages_len = plcrash_writer_write_static_messages(NULL, writer);
+
+    sections = malloc(sizeof(*sections) + system_info_len + messages_len);
+    if (sections == NULL)
+        return PLCRASH_ENOMEM;
+
+    sections->system_info = sections->data;
+    sections->system_info_len = system_info_len;
+    sections->messages = sections->data + system_info_len;
+    sections->messages_len = messages_len;
+
+    /* Encode directly to the backing buffer; as the buffer is exactly sized, it will never be flushed to the
+     * (invalid) file descriptor */
+    plcrash_async_file_init_buffer(&file, -1, 0, sections->data, system_info_len + messages_len);
+    if (plcrash_writer_write_system_info_static(&file, writer) != system_info_len ||
+        plcrash_writer_write_static_messages(&file, writer) != messages_len ||
+        file.buflen != system_info_len + messages_len)
+    {
+        PLCF_DEBUG("Static report message encoding did not match the expected size");
+        free(sections);
+        return PLCRASH_EINTERNAL;
+    }
+
+    plcrash_writer_static_sections_publish(writer, sections);
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Return the encoded size of the register message written by plcrash_writer_write_thread_register(). The message
+ * is of fixed shape, and its size is computed directly, without encoding the message's fields.
+ *
+ * @param regname The register name.
+ * @param regval The register value.
+ */
+static size_t plcrash_writer_thread_register_size (const char *regname, plcrash_greg_t regval) {
+    return PLPROTOBUF_C_TAG_SIZE(PLCRASH_PROTO_THREAD_REGISTER_NAME_ID) + plprotobuf_c_length_prefixed_size(strlen(regname)) +
+           PLPROTOBUF_C_TAG_SIZE(PLCRASH_PROTO_THREAD_REGISTER_VALUE_ID) + plprotobuf_c_varint_size(regval);
+}
+
+/**
+ * @internal
+ *
+ * Write a thread backtrace register
+ *
+ * @param file Output file
+ * @param cursor The cursor from which to acquire frame data.
+ */
+static size_t plcrash_writer_write_thread_register (plcrash_async_file_t *file, const char *regname, plcrash_greg_t regval) {
+    uint64_t uint64val;
+    size_t rv = 0;
+
+    if (file == NULL)
+        return plcrash_writer_thread_register_size(regname, regval);
+
+    /* Write the name */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_NAME_ID, PLPROTOBUF_C_TYPE_STRING, regname);
+
+    /* Write the value */
+    uint64val = regval;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_VALUE_ID, PLPROTOBUF_C_TYPE_UINT64, &uint64val);
+    
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Return the CrashReport.RegisterSet value identifying the registers of @a thread_state.
+ */
+static uint32_t plcrash_writer_register_set (const plcrash_async_thread_state_t *thread_state) {
+#if defined(PLCRASH_ASYNC_THREAD_X86_SUPPORT)
+    if (plcrash_async_thread_state_get_greg_size(thread_state) == 8)
+        return PLCRASH__CRASH_REPORT__REGISTER_SET__REGISTER_SET_X86_64;
+    else
+        return PLCRASH__CRASH_REPORT__REGISTER_SET__REGISTER_SET_X86_32;
+#elif defined(PLCRASH_ASYNC_THREAD_ARM_SUPPORT)
+    return PLCRASH__CRASH_REPORT__REGISTER_SET__REGISTER_SET_ARM;
+#else
+#error Add support for this platform
+#endif
+}
+
+/**
+ * @internal
+ *
+ * Write the thread's registers as a single packed field of little-endian 64-bit values, ordered by register number.
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param thread_state The thread state from which to acquire frame registers.
+ */
+static size_t plcrash_writer_write_packed_thread_registers (plcrash_async_file_t *file, plcrash_log_writer_t *writer, const plcrash_async_thread_state_t *thread_state) {
+    size_t regCount = plcrash_async_thread_state_get_reg_count(thread_state);
+    uint32_t length = (uint32_t) (regCount * sizeof(uint64_t));
+    size_t rv = 0;
+
+    /* The length-prefixed header is identical to that of an embedded message */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_VALUES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &length);
+    rv += length;
+
+    if (file == NULL)
+        return rv;
+
+    for (size_t i = 0; i < regCount; i++) {
+        uint64_t value = 0;
+        if (plcrash_async_thread_state_has_reg(thread_state, (plcrash_regnum_t) i))
+            value = plcrash_async_thread_state_get_reg(thread_state, (plcrash_regnum_t) i);
+
+        value = OSSwapHostToLittleInt64(value);
+        plcrash_async_file_write(file, &value, sizeof(value));
+    }
+
+    writer->packed_register_set = plcrash_writer_register_set(thread_state);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write all thread backtrace register messages
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param thread_state The thread state from which to acquire frame registers.
+ */
+static size_t plcrash_writer_write_thread_registers (plcrash_async_file_t *file, plcrash_log_writer_t *writer, const plcrash_async_thread_state_t *thread_state) {
+    size_t regCount = plcrash_async_thread_state_get_reg_count(thread_state);
+    size_t rv = 0;
+
+    if (writer->packed_registers)
+        return plcrash_writer_write_packed_thread_registers(file, writer, thread_state);
+    
+    /* Write out register messages */
+    for (int i = 0; i < regCount; i++) {
+        plcrash_greg_t regVal;
+        const char *regname;
+        uint32_t msgsize;
+
+        /* Fetch the register value */
+        if (plcrash_async_thread_state_has_reg(thread_state, i)) {
+            regVal = plcrash_async_thread_state_get_reg(thread_state, i);
+        } else {
+            // Should never happen
+            PLCF_DEBUG("Could not fetch register %i value: %s", i, plframe_strerror(PLFRAME_ENOTSUP));
+            regVal = 0;
+        }
+
+        /* Fetch the register name */
+        regname = plcrash_async_thread_state_get_reg_name(thread_state, i);
+
+        /* Get the register message size */
+        msgsize = (uint32_t) plcrash_writer_thread_register_size(regname, regVal);
+        
+        /* Write the header and message */
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTERS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &msgsize);
+        rv += plcrash_writer_write_thread_register(file, regname, regVal);
+    }
+    
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Look up @a name in @a table, adding it if not already present.
+ *
+ * @param table The symbol table.
+ * @param name The symbol name.
+ * @param index On success, the name's index within the table.
+ *
+ * @return Returns true on success, or false if the name is not present and the table is full.
+ */
+static bool plcrash_writer_symbol_table_intern (plcrash_log_writer_symbol_table_t *table, const char *name, uint32_t *index) {
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+    size_t len = 0;
+    for (const char *p = name; *p != '\0'; p++, len++) {
+        hash ^= (uint8_t) *p;
+        hash *= 16777619U;
+    }
+
+    for (uint32_t probe = 0; probe < SYMBOL_TABLE_SLOTS; probe++) {
+        uint32_t slot = (hash + probe) & (SYMBOL_TABLE_SLOTS - 1);
+        uint32_t entry = table->slots[slot];
+
+        /* Found an existing entry */
+        if (entry != 0) {
+            if (plcrash_async_strcmp(table->names[entry - 1], name) == 0) {
+                *index = entry - 1;
+                return true;
+            }
+
+            continue;
+        }
+
+        /* Insert a new entry, if space remains */
+        if (table->count == SYMBOL_TABLE_MAX_NAMES || len + 1 > sizeof(table->pool) - table->pool_used)
+            return false;
+
+        char *dest = table->pool + table->pool_used;
+        plcrash_async_memcpy(dest, name, len + 1);
+        table->pool_used += len + 1;
+
+        table->names[table->count] = dest;
+        table->slots[slot] = table->count + 1;
+        *index = table->count++;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @internal
+ *
+ * Write a symbol
+ *
+ * @param file Output file
+ * @param writer Writer instance. If the writer's symbol table is enabled, the name will be written as a table index.
+ * @param name The symbol name
+ * @param start_address The symbol start address
+ */
+static size_t plcrash_writer_write_symbol (plcrash_async_file_t *file, plcrash_log_writer_t *writer, const char *name, uint64_t start_address) {
+    size_t rv = 0;
+    uint32_t name_index;
+    
+    /* name, or its symbol table index */
+    if (writer->symbol_table != NULL && plcrash_writer_symbol_table_intern(writer->symbol_table, name, &name_index)) {
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYMBOL_NAME_INDEX, PLPROTOBUF_C_TYPE_UINT32, &name_index);
+    } else {
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYMBOL_NAME, PLPROTOBUF_C_TYPE_STRING, name);
+    }
+    
+    /* start_address */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYMBOL_START_ADDRESS, PLPROTOBUF_C_TYPE_UINT64, &start_address);
+    
+    return rv;
+}
+
+/**
+ * @internal
+ * Symbol lookup callback context
+ */
+struct pl_symbol_cb_ctx {
+    /** File to use for writing out a symbol entry. May be NULL. */
+    plcrash_async_file_t *file;
+
+    /** Writer instance. */
+    plcrash_log_writer_t *writer;
+
+    /** Size of the symbol entry, to be written by the callback function upon writing an entry. */
+    uint32_t msgsize;
+};
+
+/**
+ * @internal
+ *
+ * pl_async_macho_found_symbol_cb callback implementation. Writes the result to the file available via @a ctx,
+ * which must be a valid pl_symbol_cb_ctx structure.
+ */
+static void plcrash_writer_write_thread_frame_symbol_cb (pl_vm_address_t address, const char *name, void *ctx) {
+    struct pl_symbol_cb_ctx *cb_ctx = ctx;
+    cb_ctx->msgsize = plcrash_writer_write_symbol(cb_ctx->file, cb_ctx->writer, name, address);
+}
+
+/**
+ * @internal
+ *
+ * Update and return the expiry state of the current report's deadline. This may only be called by the thread
+ * writing the report, and only between sections; other threads read plcrash_log_writer_t::deadline_expired, such
+ * that the detail of a section does not change while it is written.
+ *
+ * @param writer Writer instance.
+ */
+static bool plcrash_writer_check_deadline (plcrash_log_writer_t *writer) {
+    if (!writer->deadline_expired && writer->deadline != 0 && mach_absolute_time() >= writer->deadline)
+        writer->deadline_expired = true;
+
+    return writer->deadline_expired;
+}
+
+/**
+ * @internal
+ *
+ * Return true if a thread's frames are to be unwound using only frame pointers and written without symbols: the
+ * thread is not the crashed thread, and either fast capture is enabled or the report's deadline has expired.
+ *
+ * @param writer Writer instance.
+ * @param crashed If true, the thread is the crashed thread.
+ */
+static inline bool plcrash_writer_fast_capture (plcrash_log_writer_t *writer, bool crashed) {
+    return !crashed && (writer->fast_capture || writer->deadline_expired);
+}
+
+/**
+ * @internal
+ *
+ * Advance @a cursor to the next frame, using only the frame pointer reader if the thread is fast captured; see
+ * plcrash_writer_fast_capture().
+ *
+ * @param writer Writer instance.
+ * @param cursor The cursor to advance.
+ * @param crashed If true, the cursor is walking the crashed thread.
+ */
+static plframe_error_t plcrash_writer_cursor_next (plcrash_log_writer_t *writer, plframe_cursor_t *cursor, bool crashed) {
+    if (plcrash_writer_fast_capture(writer, crashed)) {
+        plframe_cursor_frame_reader_t *readers[] = { plframe_cursor_read_frame_ptr };
+        return plframe_cursor_next_with_readers(cursor, readers, sizeof(readers) / sizeof(readers[0]));
+    }
+
+    return plframe_cursor_next(cursor);
+}
+
+/**
+ * @internal
+ *
+ * Record @a image as referenced by the current report, if the writer is recording referenced images.
+ *
+ * @param writer Writer instance.
+ * @param image The referenced image.
+ */
+static void plcrash_writer_reference_image (plcrash_log_writer_t *writer, plcrash_async_image_t *image) {
+    plcrash_log_writer_image_set_t *set = writer->referenced_images;
+    if (set == NULL || set->overflow)
+        return;
+
+    pl_vm_address_t addr = image->macho_image.header_addr;
+    uint32_t slot = (uint32_t) ((addr >> 12) * 2654435761U) & (IMAGE_SET_SLOTS - 1);
+
+    /* Probe for the image, or an empty slot */
+    while (set->slots[slot] != 0) {
+        if (set->slots[slot] == addr)
+            return;
+
+        slot = (slot + 1) & (IMAGE_SET_SLOTS - 1);
+    }
+
+    if (set->count == IMAGE_SET_MAX_IMAGES) {
+        set->overflow = true;
+        return;
+    }
+
+    set->slots[slot] = addr;
+    set->count++;
+}
+
+/**
+ * @internal
+ *
+ * Record the image containing @a address as referenced by the current report, if the writer is recording
+ * referenced images.
+ *
+ * @param writer Writer instance.
+ * @param image_list The Mach-O image list.
+ * @param address The referenced address.
+ */
+static void plcrash_writer_reference_address (plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list, uint64_t address) {
+    if (writer->referenced_images == NULL)
+        return;
+
+    plcrash_async_image_list_set_reading(image_list, true);
+    plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, (pl_vm_address_t) address);
+    if (image != NULL)
+        plcrash_writer_reference_image(writer, image);
+    plcrash_async_image_list_set_reading(image_list, false);
+}
+
+/**
+ * @internal
+ *
+ * Return true if @a image should be written to the current report: either all images are being written, the image
+ * was referenced by a written frame, or the image is the main executable.
+ *
+ * @param writer Writer instance.
+ * @param image The image to be checked.
+ */
+static bool plcrash_writer_should_write_image (plcrash_log_writer_t *writer, plcrash_async_image_t *image) {
+    plcrash_log_writer_image_set_t *set = writer->referenced_images;
+    if (set == NULL || set->overflow)
+        return true;
+
+    /* A set recorded for the deadline only applies once the deadline has expired, or to a thread subset */
+    if (writer->deadline_image_set && !writer->deadline_expired && writer->thread_subset == NULL)
+        return true;
+
+    pl_vm_address_t addr = image->macho_image.header_addr;
+    uint32_t slot = (uint32_t) ((addr >> 12) * 2654435761U) & (IMAGE_SET_SLOTS - 1);
+    while (set->slots[slot] != 0) {
+        if (set->slots[slot] == addr)
+            return true;
+
+        slot = (slot + 1) & (IMAGE_SET_SLOTS - 1);
+    }
+
+    return image->macho_image.byteorder->swap32(image->macho_image.header.filetype) == MH_EXECUTE;
+}
+
+/**
+ * @internal
+ *
+ * Return the symbolication strategy to be used for frames within @a image.
+ */
+static inline plcrash_async_symbol_strategy_t plcrash_writer_image_symbol_strategy (plcrash_log_writer_t *writer, plcrash_async_image_t *image) {
+    return writer->image_symbol_strategy[image->_image_class];
+}
+
+/**
+ * @internal
+ *
+ * Return true if a symbolication strategy is enabled for any image class.
+ */
+static bool plcrash_writer_symbolication_enabled (plcrash_log_writer_t *writer) {
+    for (size_t i = 0; i < PLCRASH_ASYNC_IMAGE_CLASS_COUNT; i++) {
+        if (writer->image_symbol_strategy[i] != PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @internal
+ *
+ * Write a thread backtrace frame
+ *
+ * @param file Output file
+ * @param pcval The frame PC value.
+ */
+static size_t plcrash_writer_write_thread_frame (plcrash_async_file_t *file, plcrash_log_writer_t *writer, uint64_t pcval, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext) {
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_PC_ID, PLPROTOBUF_C_TYPE_UINT64, &pcval);
+    
+    plcrash_async_image_list_set_reading(image_list, true);
+    plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, (pl_vm_address_t) pcval);
+    if (image != NULL && file != NULL)
+        plcrash_writer_reference_image(writer, image);
+    
+    plcrash_async_symbol_strategy_t strategy = image != NULL ? plcrash_writer_image_symbol_strategy(writer, image) : PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE;
+    if (strategy != PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE) {
+        struct pl_symbol_cb_ctx ctx;
+        plcrash_error_t ret;
+        
+        /* Get the symbol message size. If the symbol can not be found, our callback will not be called. If the symbol is found,
+         * our callback is called and PLCRASH_ESUCCESS is returned. */
+        ctx.file = NULL;
+        ctx.writer = writer;
+        ctx.msgsize = 0x0;
+        ret = plcrash_async_find_symbol(&image->macho_image, strategy, findContext, (pl_vm_address_t) pcval, plcrash_writer_write_thread_frame_symbol_cb, &ctx);
+        if (ret == PLCRASH_ESUCCESS) {
+            /* Write the header and message */
+            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_SYMBOL_ID, PLPROTOBUF_C_TYPE_MESSAGE, &ctx.msgsize);
+
+            ctx.file = file;
+            ret = plcrash_async_find_symbol(&image->macho_image, strategy, findContext, (pl_vm_address_t) pcval, plcrash_writer_write_thread_frame_symbol_cb, &ctx);
+            if (ret == PLCRASH_ESUCCESS) {
+                rv += ctx.msgsize;
+            } else {
+                /* This should not happen, but it would be very confusing if it did and nothing was logged. */
+                PLCF_DEBUG("Fetching the symbol unexpectedly failed during the second call");
+            }
+        }
+    }
+
+    plcrash_async_image_list_set_reading(image_list, false);
+
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write a thread backtrace frame previously captured by plcrash_writer_capture_thread().
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param frame The captured frame.
+ * @param image_list The Mach-O image list. Used to resolve symbols that could not be captured.
+ * @param findContext Symbol lookup cache.
+ */
+static size_t plcrash_writer_write_captured_thread_frame (plcrash_async_file_t *file, plcrash_log_writer_t *writer, plcrash_log_writer_frame_t *frame,
+                                                          plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext)
+{
+    size_t rv = 0;
+
+    if (frame->symbol_deferred) {
+        /* If the symbol name could not be captured, fall back on a full lookup */
+        rv += plcrash_writer_write_thread_frame(file, writer, frame->pc, image_list, findContext);
+    } else {
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_PC_ID, PLPROTOBUF_C_TYPE_UINT64, &frame->pc);
+
+        if (frame->has_symbol) {
+            uint32_t msgsize = plcrash_writer_write_symbol(NULL, writer, frame->symbol_name, frame->symbol_start);
+
+            /* Write the header and message */
+            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_SYMBOL_ID, PLPROTOBUF_C_TYPE_MESSAGE, &msgsize);
+            rv += plcrash_writer_write_symbol(file, writer, frame->symbol_name, frame->symbol_start);
+        }
+    }
+
+    /* Repeated frame group */
+    if (frame->repeat_count > 1) {
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_REPEAT_COUNT_ID, PLPROTOBUF_C_TYPE_UINT32, &frame->repeat_count);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_REPEAT_LENGTH_ID, PLPROTOBUF_C_TYPE_UINT32, &frame->repeat_length);
+    }
+
+    /* Omitted frames */
+    if (frame->omitted_count > 0)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_OMITTED_FRAME_COUNT_ID, PLPROTOBUF_C_TYPE_UINT64, &frame->omitted_count);
+
+    return rv;
+}
+
+/**
+ * @internal
+ * Symbol capture callback context
+ */
+struct pl_symbol_capture_ctx {
+    /** The thread buffer providing symbol name storage. */
+    plcrash_log_writer_thread_buffer_t *buffer;
+
+    /** The frame to be populated. */
+    plcrash_log_writer_frame_t *frame;
+};
+
+/**
+ * @internal
+ *
+ * pl_async_macho_found_symbol_cb callback implementation. Copies the symbol into the frame available via @a ctx,
+ * which must be a valid pl_symbol_capture_ctx structure.
+ */
+static void plcrash_writer_capture_thread_frame_symbol_cb (pl_vm_address_t address, const char *name, void *ctx) {
+    struct pl_symbol_capture_ctx *cb_ctx = ctx;
+    plcrash_log_writer_thread_buffer_t *buffer = cb_ctx->buffer;
+    size_t len = strlen(name) + 1;
+
+    /* If the pool is exhausted, defer the lookup until serialization */
+    if (len > sizeof(buffer->symbol_pool) - buffer->symbol_pool_used) {
+        cb_ctx->frame->symbol_deferred = true;
+        return;
+    }
+
+    char *dest = buffer->symbol_pool + buffer->symbol_pool_used;
+    plcrash_async_memcpy(dest, name, len);
+    buffer->symbol_pool_used += len;
+
+    cb_ctx->frame->has_symbol = true;
+    cb_ctx->frame->symbol_start = address;
+    cb_ctx->frame->symbol_name = dest;
+}
+
+/**
+ * @internal
+ *
+ * Reverse the order of @a count frames.
+ */
+static void plcrash_writer_reverse_frames (plcrash_log_writer_frame_t *frames, uint32_t count) {
+    for (uint32_t i = 0; i < count / 2; i++) {
+        plcrash_log_writer_frame_t tmp = frames[i];
+        frames[i] = frames[count - i - 1];
+        frames[count - i - 1] = tmp;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Return true if the @a length frames at @a lhs and @a rhs have identical PC values.
+ */
+static bool plcrash_writer_frames_equal (const plcrash_log_writer_frame_t *lhs, const plcrash_log_writer_frame_t *rhs, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        if (lhs[i].pc != rhs[i].pc)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Collapse consecutive repeats of a cycle of up to MAX_FRAME_CYCLE_LENGTH frames in place, retaining the first
+ * instance of each cycle and recording the number of repeats in the cycle's first frame. Where cycles of multiple
+ * lengths are found at the same position, the cycle covering the largest number of frames is used.
+ *
+ * @param frames The frames to compress.
+ * @param count The number of frames in @a frames.
+ *
+ * @return Returns the number of frames remaining in @a frames.
+ */
+static uint32_t plcrash_writer_compress_frames (plcrash_log_writer_frame_t *frames, uint32_t count) {
+    uint32_t out = 0;
+    uint32_t i = 0;
+
+    while (i < count) {
+        uint32_t best_length = 0;
+        uint32_t best_count = 0;
+
+        /* Find the cycle starting at i that covers the most frames */
+        for (uint32_t length = 1; length <= MAX_FRAME_CYCLE_LENGTH && i + (length * 2) <= count; length++) {
+            uint32_t repeats = 1;
+            while (i + ((repeats + 1) * length) <= count && plcrash_writer_frames_equal(&frames[i], &frames[i + (repeats * length)], length))
+                repeats++;
+
+            if (repeats > 1 && repeats * length > best_count * best_length) {
+                best_length = length;
+                best_count = repeats;
+            }
+        }
+
+        /* No cycle; copy the frame as-is */
+        if (best_length == 0) {
+            frames[out++] = frames[i++];
+            continue;
+        }
+
+        /* Retain the first instance of the cycle. As out <= i, each frame is read before it may be overwritten. */
+        for (uint32_t j = 0; j < best_length; j++)
+            frames[out + j] = frames[i + j];
+
+        frames[out].repeat_count = best_count;
+        frames[out].repeat_length = best_length;
+
+        out += best_length;
+        i += best_count * best_length;
+    }
+
+    return out;
+}
+
+/**
+ * @internal
+ *
+ * Look up @a thread in the writer's thread registry, if any.
+ *
+ * @param writer Writer instance.
+ * @param task The task in which @a thread is executing. The registry only records threads of the current task.
+ * @param thread The thread to look up.
+ * @param entry On success, the thread's registry entry.
+ *
+ * @return Returns true if the thread is registered.
+ */
+static bool plcrash_writer_lookup_registered_thread (plcrash_log_writer_t *writer, task_t task, thread_t thread, plcrash_async_thread_registry_entry_t *entry) {
+    if (writer->thread_registry == NULL || task != mach_task_self())
+        return false;
+
+    if (!plcrash_async_thread_registry_lookup(writer->thread_registry, thread, entry))
+        return false;
+
+    entry->name[sizeof(entry->name) - 1] = '\0';
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Bound @a cursor's frame pointer walk to the stack containing its initial stack pointer.
+ *
+ * The stack recorded by the thread registry is used if it contains the stack pointer. Otherwise, as for a thread
+ * executing on its signal stack, the stack is located via the VM region containing the stack pointer; the pthread
+ * stack accessors acquire the thread list lock, and may not be used from within a crash handler.
+ *
+ * @param cursor A cursor instance initialized with plframe_cursor_init(), which has not yet been stepped.
+ * @param task The task in which the cursor's thread is executing.
+ * @param registered The thread's registry entry, or NULL if the thread is not registered.
+ */
+static void plcrash_writer_set_stack_bounds (plframe_cursor_t *cursor, task_t task, const plcrash_async_thread_registry_entry_t *registered) {
+    plcrash_async_thread_state_t *state = &plframe_cursor_get_frame(cursor)->thread_state;
+    if (!plcrash_async_thread_state_has_reg(state, PLCRASH_REG_SP))
+        return;
+
+    pl_vm_address_t sp = (pl_vm_address_t) plcrash_async_thread_state_get_reg(state, PLCRASH_REG_SP);
+    if (registered != NULL && sp >= registered->stack_start && sp < registered->stack_end) {
+        plframe_cursor_set_stack_bounds(cursor, registered->stack_start, registered->stack_end);
+        return;
+    }
+
+    plcrash_async_region_map_range_t range;
+    if (plcrash_async_task_region_lookup(task, sp, &range) != PLCRASH_ESUCCESS || !range.readable)
+        return;
+
+    plframe_cursor_set_stack_bounds(cursor, range.start, range.end);
+}
+
+/**
+ * @internal
+ *
+ * Unwind @a thread, recording its frames in @a buffer without symbols. Any existing contents of @a buffer
+ * are discarded. The frames may be symbolicated via plcrash_writer_symbolicate_captured_thread(), which does
+ * not require that @a thread remain suspended.
+ *
+ * @param buffer The buffer to be populated.
+ * @param writer Writer instance.
+ * @param task The task in which @a thread is executing.
+ * @param thread Thread to be unwound.
+ * @param thread_ctx Thread state to use for stack walking. If NULL, the thread state will be fetched from @a thread. If
+ * @a thread is the currently executing thread, <em>must</em> be non-NULL.
+ * @param image_list The Mach-O image list.
+ * @param crashed If true, the first frame's registers will be recorded.
+ */
+static void plcrash_writer_unwind_thread (plcrash_log_writer_thread_buffer_t *buffer,
+                                          plcrash_log_writer_t *writer,
+                                          task_t task,
+                                          thread_t thread,
+                                          plcrash_async_thread_state_t *thread_ctx,
+                                          plcrash_async_image_list_t *image_list,
+                                          bool crashed)
+{
+    plframe_cursor_t cursor;
+    plframe_error_t ferr;
+    uint64_t start = plcrash_async_metrics_time_begin();
+
+    /* A context must be supplied when walking the current thread */
+    PLCF_ASSERT(task != mach_task_self() || thread_ctx != NULL || thread != pl_mach_thread_self());
+
+    /* Reset the buffer */
+    buffer->frame_count = 0;
+    buffer->has_registers = false;
+    buffer->also_crashed = false;
+    buffer->symbolicated = false;
+    buffer->symbol_pool_used = 0;
+    buffer->name[0] = '\0';
+
+    /* Record the thread's name and stack from the thread registry, if any */
+    plcrash_async_thread_registry_entry_t registered;
+    bool has_registered = plcrash_writer_lookup_registered_thread(writer, task, thread, &registered);
+    if (has_registered)
+        plcrash_async_memcpy(buffer->name, registered.name, sizeof(buffer->name));
+
+    /* A thread that also crashed is unwound from the state at its crash, rather than from within its crash handler */
+    if (thread_ctx == NULL && !crashed && (thread_ctx = plcrash_writer_secondary_crash_state(writer, thread)) != NULL)
+        buffer->also_crashed = true;
+
+    /* Prefer the crashed thread's state as supplied by the crash handler */
+    if (thread_ctx == NULL && crashed)
+        thread_ctx = plcrash_writer_crashed_thread_state(writer);
+
+    /* Set up the frame cursor. */
+    {
+        /* Use the provided context if available, otherwise initialize a new thread context
+         * from the target thread's state. */
+        plcrash_async_thread_state_t cursor_thr_state;
+        if (thread_ctx) {
+            cursor_thr_state = *thread_ctx;
+        } else if (crashed) {
+            plcrash_async_thread_state_mach_thread_init(&cursor_thr_state, thread);
+        } else {
+            /* Registers are only reported for the crashed thread; walking the stack requires only the GPRs */
+            plcrash_async_thread_state_mach_thread_gpr_init(&cursor_thr_state, thread);
+        }
+
+        /* Initialize the cursor */
+        ferr = plframe_cursor_init(&cursor, task, &cursor_thr_state, image_list);
+        if (ferr != PLFRAME_ESUCCESS) {
+            PLCF_DEBUG("An error occured initializing the frame cursor: %s", plframe_strerror(ferr));
+            plcrash_async_metrics_time_end(PLCRASH_ASYNC_METRIC_UNWIND_TIME, start);
+            return;
+        }
+
+        if (writer->region_map != NULL)
+            plcrash_async_task_read_cache_set_region_map(&cursor.stack_cache, writer->region_map);
+
+        plcrash_writer_set_stack_bounds(&cursor, task, has_registered ? &registered : NULL);
+    }
+
+    /* The innermost head frames are recorded in order; the remaining frames are recorded in a ring of tail frames,
+     * retaining the outermost frames of a stack that exceeds the frame limit. */
+    uint32_t max_frames = writer->max_thread_frames;
+    uint32_t head = (max_frames + 1) / 2;
+    uint32_t tail = max_frames - head;
+    uint64_t walked = 0;
+
+    /* Save the first frame's registers for the crashed thread */
+    if (crashed) {
+        plcrash_async_thread_state_copy(&buffer->registers, &plframe_cursor_get_frame(&cursor)->thread_state);
+        buffer->has_registers = true;
+    }
+
+    /* Walk the stack in batches, limiting the total number of frames that are walked. */
+    uint32_t walk_flags = plcrash_writer_fast_capture(writer, crashed) ? PLFRAME_WALK_FRAME_PTR_ONLY : 0;
+    plcrash_greg_t pcs[PLCRASH_LOG_WRITER_WALK_BATCH];
+    do {
+        size_t count;
+        size_t max = (size_t) MIN(MAX_THREAD_WALK_FRAMES - walked, (uint64_t) PLCRASH_LOG_WRITER_WALK_BATCH);
+
+        ferr = plframe_cursor_walk(&cursor, pcs, NULL, NULL, max, &count, walk_flags);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t idx;
+            if (walked < head)
+                idx = (uint32_t) walked;
+            else
+                idx = head + (uint32_t) ((walked - head) % tail);
+
+            plcrash_log_writer_frame_t *frame = &buffer->frames[idx];
+            frame->pc = pcs[i];
+            frame->has_symbol = false;
+            frame->symbol_deferred = false;
+            frame->repeat_count = 0;
+            frame->repeat_length = 0;
+            frame->omitted_count = 0;
+
+            walked++;
+        }
+    } while (ferr == PLFRAME_ESUCCESS && walked < MAX_THREAD_WALK_FRAMES);
+
+    /* Did we reach the end successfully? */
+    if (ferr != PLFRAME_ENOFRAME) {
+        /* This is non-fatal, and in some circumstances -could- be caused by reaching the end of the stack if the
+         * final frame pointer is not NULL. */
+        PLCF_DEBUG("Terminated stack walking early: %s", plframe_strerror(ferr));
+    }
+
+    plframe_cursor_free(&cursor);
+
+    /* If the ring wrapped, rotate the oldest tail frame into place, and note the omitted frames */
+    uint32_t split = (uint32_t) walked;
+    if (walked > max_frames) {
+        uint32_t oldest = (uint32_t) ((walked - head) % tail);
+        plcrash_log_writer_frame_t *ring = &buffer->frames[head];
+
+        plcrash_writer_reverse_frames(ring, oldest);
+        plcrash_writer_reverse_frames(ring + oldest, tail - oldest);
+        plcrash_writer_reverse_frames(ring, tail);
+
+        ring->omitted_count = walked - max_frames;
+        split = head;
+        buffer->frame_count = max_frames;
+    } else {
+        buffer->frame_count = (uint32_t) walked;
+    }
+
+    /* Collapse recursion; the head and tail are compressed independently, as they are not contiguous */
+    if (writer->compress_frames) {
+        uint32_t head_count = plcrash_writer_compress_frames(buffer->frames, split);
+        uint32_t tail_count = plcrash_writer_compress_frames(&buffer->frames[split], buffer->frame_count - split);
+
+        for (uint32_t i = 0; i < tail_count; i++)
+            buffer->frames[head_count + i] = buffer->frames[split + i];
+
+        buffer->frame_count = head_count + tail_count;
+    }
+
+    plcrash_async_metrics_time_end(PLCRASH_ASYNC_METRIC_UNWIND_TIME, start);
+}
+
+/**
+ * @internal
+ *
+ * Look up the symbols of the frames previously recorded in @a buffer by plcrash_writer_unwind_thread(). Buffers
+ * that have already been symbolicated are left unmodified.
+ *
+ * @param buffer The buffer to be symbolicated.
+ * @param writer Writer instance.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param crashed If true, the thread is the crashed thread, and is symbolicated even if fast capture is enabled.
+ */
+static void plcrash_writer_symbolicate_captured_thread (plcrash_log_writer_thread_buffer_t *buffer,
+                                                        plcrash_log_writer_t *writer,
+                                                        plcrash_async_image_list_t *image_list,
+                                                        plcrash_async_symbol_cache_t *findContext,
+                                                        bool crashed)
+{
+    if (buffer->symbolicated)
+        return;
+
+    /* Frames of fast-captured threads are recorded without symbols */
+    bool symbolicate = !plcrash_writer_fast_capture(writer, crashed) && plcrash_writer_symbolication_enabled(writer);
+
+    /* Look up the symbols of the retained frames */
+    if (symbolicate) {
+        plcrash_async_image_list_set_reading(image_list, true);
+        for (uint32_t i = 0; i < buffer->frame_count; i++) {
+            plcrash_log_writer_frame_t *frame = &buffer->frames[i];
+            plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, (pl_vm_address_t) frame->pc);
+            if (image == NULL)
+                continue;
+
+            plcrash_async_symbol_strategy_t strategy = plcrash_writer_image_symbol_strategy(writer, image);
+            if (strategy == PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE)
+                continue;
+
+            struct pl_symbol_capture_ctx ctx;
+            ctx.buffer = buffer;
+            ctx.frame = frame;
+
+            /* If the symbol can not be found, our callback will not be called, and the frame will be left unsymbolicated. */
+            plcrash_async_find_symbol(&image->macho_image, strategy, findContext, (pl_vm_address_t) frame->pc, plcrash_writer_capture_thread_frame_symbol_cb, &ctx);
+        }
+        plcrash_async_image_list_set_reading(image_list, false);
+    }
+
+    buffer->symbolicated = true;
+}
+
+/**
+ * @internal
+ *
+ * Unwind and symbolicate @a thread, recording the results in @a buffer. Any existing contents of @a buffer
+ * are discarded.
+ *
+ * @param buffer The buffer to be populated.
+ * @param writer Writer instance.
+ * @param task The task in which @a thread is executing.
+ * @param thread Thread to be captured.
+ * @param thread_ctx Thread state to use for stack walking. If NULL, the thread state will be fetched from @a thread. If
+ * @a thread is the currently executing thread, <em>must</em> be non-NULL.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param crashed If true, the first frame's registers will be recorded.
+ */
+static void plcrash_writer_capture_thread (plcrash_log_writer_thread_buffer_t *buffer,
+                                           plcrash_log_writer_t *writer,
+                                           task_t task,
+                                           thread_t thread,
+                                           plcrash_async_thread_state_t *thread_ctx,
+                                           plcrash_async_image_list_t *image_list,
+                                           plcrash_async_symbol_cache_t *findContext,
+                                           bool crashed)
+{
+    plcrash_writer_unwind_thread(buffer, writer, task, thread, thread_ctx, image_list, crashed);
+    plcrash_writer_symbolicate_captured_thread(buffer, writer, image_list, findContext, crashed);
+}
+
+/**
+ * @internal
+ *
+ * Return true if the frames captured in @a buffer may be written as packed PC values; this requires that packed
+ * frames be enabled, and that none of the frames carry symbol, repeat, or omission data.
+ */
+static bool plcrash_writer_can_pack_frames (plcrash_log_writer_t *writer, plcrash_log_writer_thread_buffer_t *buffer) {
+    if (!writer->packed_frames)
+        return false;
+
+    for (uint32_t i = 0; i < buffer->frame_count; i++) {
+        plcrash_log_writer_frame_t *frame = &buffer->frames[i];
+        if (frame->has_symbol || frame->symbol_deferred || frame->repeat_count > 1 || frame->omitted_count > 0)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * The number of frame PCs encoded per call to plcrash_writer_pack_sint64_delta_elements() when writing packed frames.
+ */
+#define PLCRASH_WRITER_PACKED_FRAME_CHUNK 32
+
+/**
+ * @internal
+ *
+ * Copy up to PLCRASH_WRITER_PACKED_FRAME_CHUNK frame PCs from @a buffer, starting at frame @a first, into @a pcs.
+ * Returns the number of PCs copied.
+ */
+static size_t plcrash_writer_gather_frame_pcs (plcrash_log_writer_thread_buffer_t *buffer, uint32_t first, uint64_t *pcs) {
+    size_t count = buffer->frame_count - first;
+    if (count > PLCRASH_WRITER_PACKED_FRAME_CHUNK)
+        count = PLCRASH_WRITER_PACKED_FRAME_CHUNK;
+
+    for (size_t i = 0; i < count; i++)
+        pcs[i] = buffer->frames[first + i].pc;
+
+    return count;
+}
+
+/**
+ * @internal
+ *
+ * Write the frames captured in @a buffer as a single packed field of zigzag-encoded PC deltas.
+ *
+ * @param file Output file
+ * @param buffer The captured thread data.
+ */
+static size_t plcrash_writer_write_packed_thread_frames (plcrash_async_file_t *file, plcrash_log_writer_thread_buffer_t *buffer) {
+    uint64_t pcs[PLCRASH_WRITER_PACKED_FRAME_CHUNK];
+    uint8_t scratch[PLCRASH_WRITER_PACKED_FRAME_CHUNK * PLPROTOBUF_C_VARINT_MAX_SIZE];
+    uint32_t length = 0;
+    uint64_t prev;
+    size_t rv = 0;
+
+    /* Determine the size */
+    prev = 0;
+    for (uint32_t i = 0; i < buffer->frame_count; i += PLCRASH_WRITER_PACKED_FRAME_CHUNK) {
+        size_t count = plcrash_writer_gather_frame_pcs(buffer, i, pcs);
+        length += (uint32_t) plcrash_writer_pack_sint64_delta_elements(NULL, pcs, count, &prev);
+    }
+
+    /* The length-prefixed header is identical to that of an embedded message */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_PCS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &length);
+    rv += length;
+
+    if (file == NULL)
+        return rv;
+
+    prev = 0;
+    for (uint32_t i = 0; i < buffer->frame_count; i += PLCRASH_WRITER_PACKED_FRAME_CHUNK) {
+        size_t count = plcrash_writer_gather_frame_pcs(buffer, i, pcs);
+        size_t encoded = plcrash_writer_pack_sint64_delta_elements(scratch, pcs, count, &prev);
+        plcrash_async_file_write(file, scratch, encoded);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Compute the hash of the frames captured in @a buffer, as used to key plcrash_log_writer_stack_table_t. Symbol data
+ * is derived from the frame PCs, and is not included.
+ */
+static uint64_t plcrash_writer_stack_hash (plcrash_log_writer_thread_buffer_t *buffer) {
+    /* FNV-1a, applied to each 64-bit value as a single unit */
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint32_t i = 0; i < buffer->frame_count; i++) {
+        const plcrash_log_writer_frame_t *frame = &buffer->frames[i];
+        uint64_t values[] = { frame->pc, ((uint64_t) frame->repeat_count << 32) | frame->repeat_length, frame->omitted_count };
+
+        for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+            hash ^= values[v];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * @internal
+ *
+ * Look up a stack in @a table, optionally adding it if not already present.
+ *
+ * @param table The stack table.
+ * @param hash The stack's hash, as returned by plcrash_writer_stack_hash().
+ * @param frame_count The number of frames in the stack.
+ * @param thread_number The number of the thread being written. If @a insert is true and the stack is not present,
+ * the stack will be recorded as written by this thread.
+ * @param insert If true, add the stack to the table if not already present.
+ * @param original On success, the number of the thread that first wrote the stack.
+ *
+ * @return Returns true if the stack was previously written by another thread, or false otherwise.
+ */
+static bool plcrash_writer_stack_table_lookup (plcrash_log_writer_stack_table_t *table, uint64_t hash, uint32_t frame_count,
+                                               uint32_t thread_number, bool insert, uint32_t *original)
+{
+    for (uint32_t probe = 0; probe < STACK_TABLE_SLOTS; probe++) {
+        plcrash_log_writer_stack_entry_t *entry = &table->slots[(hash + probe) & (STACK_TABLE_SLOTS - 1)];
+
+        /* Found an existing entry */
+        if (entry->thread_number != 0) {
+            if (entry->hash == hash && entry->frame_count == frame_count) {
+                if (entry->thread_number - 1 == thread_number)
+                    return false;
+
+                *original = entry->thread_number - 1;
+                return true;
+            }
+
+            continue;
+        }
+
+        /* Insert a new entry, if space remains */
+        if (insert && table->count < STACK_TABLE_MAX_STACKS) {
+            entry->hash = hash;
+            entry->frame_count = frame_count;
+            entry->thread_number = thread_number + 1;
+            table->count++;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+/**
+ * @internal
+ *
+ * Write a thread message from the data previously captured by plcrash_writer_capture_thread().
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param buffer The captured thread data.
+ * @param thread_number The thread's index number.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param crashed If true, mark this as a crashed thread.
+ */
+static size_t plcrash_writer_write_captured_thread (plcrash_async_file_t *file,
+                                                    plcrash_log_writer_t *writer,
+                                                    plcrash_log_writer_thread_buffer_t *buffer,
+                                                    uint32_t thread_number,
+                                                    plcrash_async_image_list_t *image_list,
+                                                    plcrash_async_symbol_cache_t *findContext,
+                                                    bool crashed)
+{
+    size_t rv = 0;
+
+    /* Write the thread ID */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_THREAD_NUMBER_ID, PLPROTOBUF_C_TYPE_UINT32, &thread_number);
+
+    /* Note crashed status */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_CRASHED_ID, PLPROTOBUF_C_TYPE_BOOL, &crashed);
+    if (buffer->also_crashed) {
+        bool also_crashed = true;
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_ALSO_CRASHED_ID, PLPROTOBUF_C_TYPE_BOOL, &also_crashed);
+    }
+
+    /* Write the thread's registered name */
+    if (buffer->name[0] != '\0')
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_NAME_ID, PLPROTOBUF_C_TYPE_STRING, buffer->name);
+
+    /* Dump registers for the crashed thread */
+    if (buffer->has_registers)
+        rv += plcrash_writer_write_thread_registers(file, writer, &buffer->registers);
+
+    /* If an identical stack has already been written, reference it in place of the frames. The crashed thread is always
+     * written in full. The stack is only recorded once the message is actually written, and not while sizing. */
+    if (writer->stack_table != NULL && buffer->frame_count > 0) {
+        uint32_t original;
+        uint64_t hash = plcrash_writer_stack_hash(buffer);
+        if (plcrash_writer_stack_table_lookup(writer->stack_table, hash, buffer->frame_count, thread_number, file != NULL, &original) && !crashed && !buffer->also_crashed)
+            return rv + plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_DUPLICATE_OF_THREAD_ID, PLPROTOBUF_C_TYPE_UINT32, &original);
+    }
+
+    /* Record the images referenced by the written frames */
+    if (file != NULL && writer->referenced_images != NULL) {
+        for (uint32_t i = 0; i < buffer->frame_count; i++)
+            plcrash_writer_reference_address(writer, image_list, buffer->frames[i].pc);
+    }
+
+    /* Write out the stack frames, packing them if they carry no per-frame data beyond the PC */
+    if (buffer->frame_count > 0 && plcrash_writer_can_pack_frames(writer, buffer))
+        return rv + plcrash_writer_write_packed_thread_frames(file, buffer);
+
+    for (uint32_t i = 0; i < buffer->frame_count; i++) {
+        plcrash_log_writer_frame_t *frame = &buffer->frames[i];
+        uint32_t frame_size;
+
+        /* Determine the size */
+        frame_size = plcrash_writer_write_captured_thread_frame(NULL, writer, frame, image_list, findContext);
+
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
+        rv += plcrash_writer_write_captured_thread_frame(file, writer, frame, image_list, findContext);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write an exception userInfo entry
+ *
+ * @param file Output file
+ * @param userInfo The userInfo dictionary entry.
+ */
+static size_t plcrash_writer_write_user_info_pair (plcrash_async_file_t *file, user_info_t userInfo) {
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_USERINFO_KEY_ID, PLPROTOBUF_C_TYPE_STRING, userInfo.key);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_USERINFO_SERIALIZED_ID, PLPROTOBUF_C_TYPE_STRING, userInfo.serialized);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_USERINFO_ARCHIVE_ID, PLPROTOBUF_C_TYPE_BOOL, &userInfo.archive);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write a thread message
+ *
+ * @param file Output file
+ * @param task The task in which @a thread is executing.
+ * @param thread Thread for which we'll output data.
+ * @param thread_number The thread's index number.
+ * @param thread_ctx Thread state to use for stack walking. If NULL, the thread state will be fetched from @a thread. If
+ * @a thread is the currently executing thread, <em>must</em> be non-NULL.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param crashed If true, mark this as a crashed thread.
+ */
+static size_t plcrash_writer_write_thread (plcrash_async_file_t *file,
+                                           plcrash_log_writer_t *writer,
+                                           task_t task,
+                                           thread_t thread,
+                                           uint32_t thread_number,
+                                           plcrash_async_thread_state_t *thread_ctx,
+                                           plcrash_async_image_list_t *image_list,
+                                           plcrash_async_symbol_cache_t *findContext,
+                                           bool crashed)
+{
+    size_t rv = 0;
+    plframe_cursor_t cursor;
+    plframe_error_t ferr;
+
+    /* A context must be supplied when walking the current thread */
+    PLCF_ASSERT(task != mach_task_self() || thread_ctx != NULL || thread != pl_mach_thread_self());
+
+    /* A thread that also crashed is unwound from the state at its crash, rather than from within its crash handler */
+    bool also_crashed = false;
+    if (thread_ctx == NULL && !crashed && (thread_ctx = plcrash_writer_secondary_crash_state(writer, thread)) != NULL)
+        also_crashed = true;
+
+    /* Prefer the crashed thread's state as supplied by the crash handler */
+    if (thread_ctx == NULL && crashed)
+        thread_ctx = plcrash_writer_crashed_thread_state(writer);
+
+    /* Fetch the thread's name and stack from the thread registry, if any */
+    plcrash_async_thread_registry_entry_t registered;
+    bool has_registered = plcrash_writer_lookup_registered_thread(writer, task, thread, &registered);
+
+    /* Write the required elements first; fatal errors may occur below, in which case we need to have
+     * written out required elements before returning. */
+    {
+        /* Write the thread ID */
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_THREAD_NUMBER_ID, PLPROTOBUF_C_TYPE_UINT32, &thread_number);
+
+        /* Note crashed status */
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_CRASHED_ID, PLPROTOBUF_C_TYPE_BOOL, &crashed);
+        if (also_crashed)
+            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_ALSO_CRASHED_ID, PLPROTOBUF_C_TYPE_BOOL, &also_crashed);
+
+        /* Write the thread's registered name */
+        if (has_registered && registered.name[0] != '\0')
+            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_NAME_ID, PLPROTOBUF_C_TYPE_STRING, registered.name);
+    }
+
+
+    /* Write out the stack frames. */
+    {
+        /* Set up the frame cursor. */
+        {            
+            /* Use the provided context if available, otherwise initialize a new thread context
+             * from the target thread's state. */
+            plcrash_async_thread_state_t cursor_thr_state;
+            if (thread_ctx) {
+                cursor_thr_state = *thread_ctx;
+            } else if (crashed) {
+                plcrash_async_thread_state_mach_thread_init(&cursor_thr_state, thread);
+            } else {
+                /* Registers are only reported for the crashed thread; walking the stack requires only the GPRs */
+                plcrash_async_thread_state_mach_thread_gpr_init(&cursor_thr_state, thread);
+            }
+
+            /* Initialize the cursor */
+            ferr = plframe_cursor_init(&cursor, task, &cursor_thr_state, image_list);
+            if (ferr != PLFRAME_ESUCCESS) {
+                PLCF_DEBUG("An error occured initializing the frame cursor: %s", plframe_strerror(ferr));
+                return rv;
+            }
+
+            if (writer->region_map != NULL)
+                plcrash_async_task_read_cache_set_region_map(&cursor.stack_cache, writer->region_map);
+
+            plcrash_writer_set_stack_bounds(&cursor, task, has_registered ? &registered : NULL);
+        }
+
+        /* Walk the stack, limiting the total number of frames that are output. Without a thread buffer, the frames
+         * beyond the limit can not be retained, and are discarded. */
+        uint32_t frame_count = 0;
+        while ((ferr = plcrash_writer_cursor_next(writer, &cursor, crashed)) == PLFRAME_ESUCCESS && frame_count < writer->max_thread_frames) {
+            uint32_t frame_size;
+            
+            /* On the first frame, dump registers for the crashed thread */
+            if (frame_count == 0 && crashed) {
+                rv += plcrash_writer_write_thread_registers(file, writer, &plframe_cursor_get_frame(&cursor)->thread_state);
+            }
+
+            /* Fetch the PC value */
+            plcrash_greg_t pc = 0;
+            if ((ferr = plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &pc)) != PLFRAME_ESUCCESS) {
+                PLCF_DEBUG("Could not retrieve frame PC register: %s", plframe_strerror(ferr));
+                break;
+            }
+
+            /* Frames of fast-captured threads are written without symbols */
+            if (plcrash_writer_fast_capture(writer, crashed)) {
+                uint64_t pcval = pc;
+                frame_size = plcrash_writer_pack(NULL, PLCRASH_PROTO_THREAD_FRAME_PC_ID, PLPROTOBUF_C_TYPE_UINT64, &pcval);
+
+                rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
+                rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_PC_ID, PLPROTOBUF_C_TYPE_UINT64, &pcval);
+                if (file != NULL)
+                    plcrash_writer_reference_address(writer, image_list, pcval);
+                frame_count++;
+                continue;
+            }
+
+            /* Determine the size */
+            frame_size = plcrash_writer_write_thread_frame(NULL, writer, pc, image_list, findContext);
+            
+            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
+            rv += plcrash_writer_write_thread_frame(file, writer, pc, image_list, findContext);
+            frame_count++;
+        }
+
+        /* Did we reach the end successfully? */
+        if (ferr != PLFRAME_ENOFRAME) {
+            /* This is non-fatal, and in some circumstances -could- be caused by reaching the end of the stack if the
+             * final frame pointer is not NULL. */
+            PLCF_DEBUG("Terminated stack walking early: %s", plframe_strerror(ferr));
+        }
+    }
+
+    plframe_cursor_free(&cursor);
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Flush @a file if @a writer is in streaming mode and @a point is an enabled flush point. If
+ * PLCRASH_LOG_WRITER_FLUSH_SYNC is set, the file is also synchronized to storage.
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param point The flush point that has been reached.
+ */
+static void plcrash_writer_flush_point (plcrash_async_file_t *file, plcrash_log_writer_t *writer, plcrash_log_writer_flush_point_t point) {
+    if (!writer->streaming || !(writer->flush_points & point))
+        return;
+
+    if (writer->flush_points & PLCRASH_LOG_WRITER_FLUSH_SYNC)
+        plcrash_async_file_sync(file);
+    else
+        plcrash_async_file_flush(file);
+}
+
+/**
+ * @internal
+ *
+ * Return true if a message may be written to @a file preceded by a length placeholder that is backpatched once the
+ * message has been written, rather than being sized prior to being written. See
+ * plcrash_log_writer_enable_length_backpatching().
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ */
+static inline bool plcrash_writer_backpatch_available (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
+    return writer->backpatch_lengths && plcrash_async_file_patchable(file);
+}
+
+/**
+ * @internal
+ *
+ * Complete the length placeholder written at @a position via plcrash_writer_pack_length_placeholder(), once @a size
+ * bytes of the message have been written.
+ *
+ * @param file Output file
+ * @param position The position of the placeholder.
+ * @param size The size of the written message.
+ */
+static void plcrash_writer_finish_backpatch (plcrash_async_file_t *file, off_t position, size_t size) {
+    if (!plcrash_writer_patch_length(file, position, (uint32_t) size))
+        PLCF_DEBUG("Could not patch the length of the message at %" PRId64, (int64_t) position);
+}
+
+/**
+ * @internal
+ *
+ * Write a thread message, including the message's field header, from the data previously captured by
+ * plcrash_writer_capture_thread().
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param buffer The captured thread data.
+ * @param thread_number The thread's index number.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param crashed If true, mark this as a crashed thread.
+ * @param max_size The maximum number of bytes that may be written, including the message's field header, or
+ * SIZE_MAX if unbounded.
+ *
+ * @return Returns true if the message was written, or false if it was larger than @a max_size.
+ */
+static bool plcrash_writer_write_captured_thread_message (plcrash_async_file_t *file,
+                                                          plcrash_log_writer_t *writer,
+                                                          plcrash_log_writer_thread_buffer_t *buffer,
+                                                          uint32_t thread_number,
+                                                          plcrash_async_image_list_t *image_list,
+                                                          plcrash_async_symbol_cache_t *findContext,
+                                                          bool crashed,
+                                                          size_t max_size)
+{
+    /* Write the message once, and backpatch its length */
+    if (max_size == SIZE_MAX && plcrash_writer_backpatch_available(file, writer)) {
+        off_t position;
+        plcrash_writer_pack_length_placeholder(file, PLCRASH_PROTO_THREADS_ID, &position);
+        size_t size = plcrash_writer_write_captured_thread(file, writer, buffer, thread_number, image_list, findContext, crashed);
+        plcrash_writer_finish_backpatch(file, position, size);
+        return true;
+    }
+
+    uint32_t size = (uint32_t) plcrash_writer_write_captured_thread(NULL, writer, buffer, thread_number, image_list, findContext, crashed);
+    if (plcrash_writer_pack(NULL, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size) + size > max_size)
+        return false;
+
+    /* Write message */
+    plcrash_writer_pack(file, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    plcrash_writer_write_captured_thread(file, writer, buffer, thread_number, image_list, findContext, crashed);
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Write a thread message, including the message's field header, unwinding the thread with the preallocated
+ * thread buffer if available.
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param thread Thread for which we'll output data.
+ * @param thread_number The thread's index number.
+ * @param thread_ctx Thread state to use for stack walking. If NULL, the thread state will be fetched from @a thread. If
+ * @a thread is the currently executing thread, <em>must</em> be non-NULL.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param crashed If true, mark this as a crashed thread.
+ * @param max_size The maximum number of bytes that may be written, including the message's field header, or
+ * SIZE_MAX if unbounded.
+ *
+ * @return Returns true if the message was written, or false if it was larger than @a max_size.
+ */
+static bool plcrash_writer_write_thread_message (plcrash_async_file_t *file,
+                                                 plcrash_log_writer_t *writer,
+                                                 thread_t thread,
+                                                 uint32_t thread_number,
+                                                 plcrash_async_thread_state_t *thread_ctx,
+                                                 plcrash_async_image_list_t *image_list,
+                                                 plcrash_async_symbol_cache_t *findContext,
+                                                 bool crashed,
+                                                 size_t max_size)
+{
+    uint32_t size;
+
+    if (writer->thread_buffer != NULL) {
+        /* Unwind and symbolicate the thread once, and then size and serialize it from the captured data */
+        plcrash_writer_capture_thread(writer->thread_buffer, writer, writer->task, thread, thread_ctx, image_list, findContext, crashed);
+        return plcrash_writer_write_captured_thread_message(file, writer, writer->thread_buffer, thread_number, image_list, findContext, crashed, max_size);
+    }
+
+    /* Unwind the thread once, writing the message directly and backpatching its length */
+    if (max_size == SIZE_MAX && plcrash_writer_backpatch_available(file, writer)) {
+        off_t position;
+        plcrash_writer_pack_length_placeholder(file, PLCRASH_PROTO_THREADS_ID, &position);
+        size = (uint32_t) plcrash_writer_write_thread(file, writer, writer->task, thread, thread_number, thread_ctx, image_list, findContext, crashed);
+        plcrash_writer_finish_backpatch(file, position, size);
+        return true;
+    }
+
+    /* Determine the size */
+    size = plcrash_writer_write_thread(NULL, writer, writer->task, thread, thread_number, thread_ctx, image_list, findContext, crashed);
+    if (plcrash_writer_pack(NULL, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size) + size > max_size)
+        return false;
+
+    /* Write message */
+    plcrash_writer_pack(file, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    plcrash_writer_write_thread(file, writer, writer->task, thread, thread_number, thread_ctx, image_list, findContext, crashed);
+    return true;
+}
+
+/**
+ * @internal
+ * A parallel capture job, describing the set of threads to be captured by the capture pool workers.
+ */
+typedef struct plcrash_log_writer_capture_job {
+    /** The writer instance. */
+    plcrash_log_writer_t *writer;
+
+    /** All threads in the current task. */
+    thread_act_array_t threads;
+
+    /** The number of entries in @a threads. */
+    mach_msg_type_number_t thread_count;
+
+    /** The thread executing plcrash_log_writer_write(). */
+    thread_t writer_thread;
+
+    /** The thread state to use when walking @a writer_thread, or NULL if @a writer_thread should not be walked. */
+    plcrash_async_thread_state_t *current_state;
+
+    /** The crashed thread. */
+    thread_t crashed_thread;
+
+    /** A thread that has already been written, and must be skipped (but still numbered), or MACH_PORT_NULL. */
+    thread_t skip_thread;
+
+    /** The Mach-O image list. */
+    plcrash_async_image_list_t *image_list;
+
+    /** The index of @a crashed_thread within @a threads, or @a thread_count if not found. */
+    mach_msg_type_number_t crashed_index;
+
+    /** The maximum number of threads to be written, or 0 if unlimited. */
+    uint32_t max_threads;
+} plcrash_log_writer_capture_job_t;
+
+/**
+ * @internal
+ * A single capture pool worker thread, and its preallocated capture slab.
+ */
+typedef struct plcrash_log_writer_capture_worker {
+    /** The owning pool. */
+    struct plcrash_log_writer_capture_pool *pool;
+
+    /** This worker's index within the pool. The worker captures every @a index + (n * worker_count) thread. */
+    uint32_t index;
+
+    /** The worker's pthread. */
+    pthread_t pthread;
+
+    /** The worker's Mach thread. */
+    thread_t thread;
+
+    /** Signaled by the writer when a new job is available (or the pool is shutting down). */
+    semaphore_t start_sem;
+
+    /** Signaled by the worker when @a buffer has been populated. */
+    semaphore_t ready_sem;
+
+    /** Signaled by the writer when @a buffer has been serialized, and may be reused. */
+    semaphore_t consumed_sem;
+
+    /** If true, the worker could not capture the thread in @a buffer, and the writer must unwind the thread itself. */
+    volatile bool capture_failed;
+
+    /** The worker's capture slab. */
+    plcrash_log_writer_thread_buffer_t *buffer;
+} plcrash_log_writer_capture_worker_t;
+
+/**
+ * @internal
+ * A pool of parked worker threads that may be used to unwind and symbolicate suspended threads in parallel.
+ */
+typedef struct plcrash_log_writer_capture_pool {
+    /** Allocator backing this pool and the worker capture slabs. */
+    plcrash_async_allocator_t *allocator;
+
+    /** The number of started workers. */
+    uint32_t worker_count;
+
+    /** The pool workers. */
+    plcrash_log_writer_capture_worker_t workers[PLCRASH_LOG_WRITER_CAPTURE_WORKERS_MAX];
+
+    /** The current job. Only valid while @a busy is non-zero. */
+    plcrash_log_writer_capture_job_t job;
+
+    /** Non-zero if a job is currently executing, or if a previous job failed to complete. Must be updated atomically. */
+    volatile int32_t busy;
+
+    /** If true, the workers should terminate. */
+    volatile bool shutdown;
+} plcrash_log_writer_capture_pool_t;
+
+/**
+ * @internal
+ * A parked helper thread that symbolicates live report capture buffers as they are unwound by the writer. Unwound
+ * threads are handed off via a single-producer, single-consumer queue of capture buffer indices.
+ */
+typedef struct plcrash_log_writer_symbolication_pipeline {
+    /** The helper's pthread. */
+    pthread_t pthread;
+
+    /** The helper's Mach thread. */
+    thread_t thread;
+
+    /** Signaled by the writer when a new job is available (or the pipeline is shutting down). */
+    semaphore_t start_sem;
+
+    /** Signaled by the writer once for each queued buffer, and once when the queue is closed. */
+    semaphore_t queued_sem;
+
+    /** Signaled by the helper once the closed queue has been drained. */
+    semaphore_t done_sem;
+
+    /** The current job. Only valid while @a busy is non-zero. */
+    plcrash_log_writer_capture_job_t job;
+
+    /** The current job's capture buffers, indexed as plcrash_log_writer_capture_job_t::threads. */
+    plcrash_log_writer_thread_buffer_t *buffers;
+
+    /** The helper's symbol lookup cache. */
+    plcrash_async_symbol_cache_t findContext;
+
+    /** If true, @a findContext has been initialized. */
+    bool has_cache;
+
+    /** The index of the next free queue entry. Only written by the writer. */
+    volatile uint32_t head;
+
+    /** The index of the next queued entry. Only written by the helper. */
+    volatile uint32_t tail;
+
+    /** If true, no further buffers will be queued for the current job. */
+    volatile bool closed;
+
+    /** Queued capture buffer indices. */
+    mach_msg_type_number_t queue[PLCRASH_LOG_WRITER_PIPELINE_QUEUE_SIZE];
+
+    /** Non-zero if a job is currently executing, or if a previous job failed to complete. Must be updated atomically. */
+    volatile int32_t busy;
+
+    /** If true, the helper should terminate. */
+    volatile bool shutdown;
+} plcrash_log_writer_symbolication_pipeline_t;
+
+/**
+ * @internal
+ *
+ * Return true if @a thread is a capture pool worker thread. Workers are never suspended or reported.
+ *
+ * @param pool The capture pool, or NULL.
+ * @param thread The thread to check.
+ */
+static bool plcrash_writer_is_capture_worker (plcrash_log_writer_capture_pool_t *pool, thread_t thread) {
+    if (pool == NULL)
+        return false;
+
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        if (pool->workers[i].thread == thread)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @internal
+ *
+ * Return true if @a thread is a capture pool worker or the symbolication pipeline's helper thread. These threads are
+ * never suspended or reported.
+ *
+ * @param writer Writer instance.
+ * @param thread The thread to check.
+ */
+static bool plcrash_writer_is_helper_thread (plcrash_log_writer_t *writer, thread_t thread) {
+    if (plcrash_writer_is_capture_worker(writer->capture_pool, thread))
+        return true;
+
+    return writer->symbolication_pipeline != NULL && writer->symbolication_pipeline->thread == thread;
+}
+
+/**
+ * @internal
+ *
+ * Return the number of threads, beginning with the main thread, that are always written regardless of
+ * @a job's thread limit.
+ */
+static uint32_t plcrash_writer_capture_job_reserved_threads (plcrash_log_writer_capture_job_t *job) {
+    if (job->thread_count == 0)
+        return 0;
+
+    /* The main thread, and the crashed thread if distinct */
+    return (job->crashed_index != 0 && job->crashed_index < job->thread_count) ? 2 : 1;
+}
+
+/**
+ * @internal
+ *
+ * Return the number of threads omitted from @a job by its thread limit.
+ */
+static uint32_t plcrash_writer_capture_job_limited_count (plcrash_log_writer_capture_job_t *job) {
+    uint32_t reserved = plcrash_writer_capture_job_reserved_threads(job);
+    if (job->max_threads == 0 || job->thread_count <= job->max_threads || job->thread_count <= reserved)
+        return 0;
+
+    uint32_t permitted = job->max_threads > reserved ? job->max_threads - reserved : 0;
+    return (job->thread_count - reserved) - permitted;
+}
+
+/**
+ * @internal
+ *
+ * Return true if the thread at @a index should be written to the report for @a job. Both the workers and the writer
+ * must use this function to derive the same thread ordering.
+ */
+static bool plcrash_writer_capture_job_includes_thread (plcrash_log_writer_capture_pool_t *pool, plcrash_log_writer_capture_job_t *job, mach_msg_type_number_t index) {
+    thread_t thread = job->threads[index];
+
+    /* Can't log a report for the current thread without a valid context. */
+    if (thread == job->writer_thread && job->current_state == NULL)
+        return false;
+
+    if (plcrash_writer_is_capture_worker(pool, thread) || plcrash_writer_is_helper_thread(job->writer, thread))
+        return false;
+
+    /* Apply the thread limit; the main and crashed threads are always included, followed by the other threads in
+     * task order. */
+    if (job->max_threads == 0 || index == 0 || index == job->crashed_index)
+        return true;
+
+    uint32_t reserved = plcrash_writer_capture_job_reserved_threads(job);
+    uint32_t rank = index - 1;
+    if (job->crashed_index != 0 && job->crashed_index < index)
+        rank--;
+
+    return job->max_threads > reserved && rank < job->max_threads - reserved;
+}
+
+/**
+ * @internal
+ *
+ * Wait on @a sem, retrying if the wait is interrupted.
+ */
+static kern_return_t plcrash_writer_semaphore_wait (semaphore_t sem) {
+    kern_return_t kr;
+    while ((kr = semaphore_wait(sem)) == KERN_ABORTED);
+    return kr;
+}
+
+/**
+ * @internal
+ *
+ * Capture pool worker thread. Parks until a job is available, and then captures every worker_count'th
+ * thread into the worker's slab, waiting for the writer to consume each capture before proceeding to
+ * the next.
+ *
+ * This code must be async-safe once a job has been received, as the state of the process' threads is
+ * entirely unknown.
+ */
+static void *plcrash_writer_capture_worker_thread (void *arg) {
+    plcrash_log_writer_capture_worker_t *worker = arg;
+    plcrash_log_writer_capture_pool_t *pool = worker->pool;
+
+    while (true) {
+        if (plcrash_writer_semaphore_wait(worker->start_sem) != KERN_SUCCESS)
+            break;
+
+        /* Ensure a consistent view of the job */
+        OSMemoryBarrier();
+        if (pool->shutdown)
+            break;
+
+        plcrash_log_writer_capture_job_t *job = &pool->job;
+        plcrash_async_symbol_cache_t findContext;
+        bool have_cache = (plcrash_async_symbol_cache_init(&findContext) == PLCRASH_ESUCCESS);
+
+        uint32_t report_index = 0;
+        for (mach_msg_type_number_t i = 0; i < job->thread_count; i++) {
+            thread_t thread = job->threads[i];
+
+            if (!plcrash_writer_capture_job_includes_thread(pool, job, i))
+                continue;
+
+            /* Skip threads assigned to other workers, or already written */
+            if (report_index++ % pool->worker_count != worker->index || thread == job->skip_thread)
+                continue;
+
+            /* Capture the thread. If we can't symbolicate, leave the work to the writer. */
+            if (have_cache) {
+                plcrash_async_thread_state_t *thr_ctx = (thread == job->writer_thread) ? job->current_state : NULL;
+                plcrash_writer_capture_thread(worker->buffer, job->writer, job->writer->task, thread, thr_ctx, job->image_list, &findContext, thread == job->crashed_thread);
+                worker->capture_failed = false;
+            } else {
+                worker->capture_failed = true;
+            }
+
+            /* Hand off the slab, and wait for it to be consumed */
+            OSMemoryBarrier();
+            semaphore_signal(worker->ready_sem);
+            plcrash_writer_semaphore_wait(worker->consumed_sem);
+        }
+
+        if (have_cache)
+            plcrash_async_symbol_cache_free(&findContext);
+    }
+
+    return NULL;
+}
+
+/**
+ * @internal
+ *
+ * Terminate all workers and release all resources associated with @a pool.
+ *
+ * @warning This method is not async safe.
+ */
+static void plcrash_writer_capture_pool_free (plcrash_log_writer_capture_pool_t *pool) {
+    /* Stop the workers */
+    pool->shutdown = true;
+    OSMemoryBarrier();
+
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        semaphore_signal(pool->workers[i].start_sem);
+        pthread_join(pool->workers[i].pthread, NULL);
+    }
+
+    /* Release the semaphores */
+    for (uint32_t i = 0; i < PLCRASH_LOG_WRITER_CAPTURE_WORKERS_MAX; i++) {
+        plcrash_log_writer_capture_worker_t *worker = &pool->workers[i];
+
+        if (worker->start_sem != SEMAPHORE_NULL)
+            semaphore_destroy(mach_task_self(), worker->start_sem);
+
+        if (worker->ready_sem != SEMAPHORE_NULL)
+            semaphore_destroy(mach_task_self(), worker->ready_sem);
+
+        if (worker->consumed_sem != SEMAPHORE_NULL)
+            semaphore_destroy(mach_task_self(), worker->consumed_sem);
+    }
+
+    /* Release the pool itself */
+    plcrash_async_allocator_free(pool->allocator);
+}
+
+/**
+ * @internal
+ *
+ * Fault in, and optionally wire, the pool and its worker capture slabs. See plcrash_log_writer_prefault().
+ */
+static plcrash_error_t plcrash_writer_capture_pool_prefault (plcrash_log_writer_capture_pool_t *pool, bool wire) {
+    return plcrash_async_allocator_prefault(pool->allocator, wire);
+}
+
+/**
+ * Enable parallel thread capture for @a writer. The given number of worker threads will be started and parked; when
+ * a report is written, the workers will unwind and symbolicate disjoint subsets of the suspended threads into
+ * preallocated per-worker slabs, while the writer serializes the results in thread order. This reduces the amount
+ * of time during which the target process' threads are suspended.
+ *
+ * The worker threads are never suspended by the writer, and are excluded from the written report.
+ *
+ * @param writer The writer for which parallel capture should be enabled.
+ * @param worker_count The number of worker threads to start. Must be greater than zero, and will be clamped to
+ * PLCRASH_LOG_WRITER_CAPTURE_WORKERS_MAX.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an error result if the workers could not be started. On failure,
+ * the writer will continue to capture threads serially.
+ *
+ * @warning This method is not async safe, and must be called prior to plcrash_log_writer_write().
+ */
+plcrash_error_t plcrash_log_writer_enable_parallel_capture (plcrash_log_writer_t *writer, uint32_t worker_count) {
+    plcrash_log_writer_capture_pool_t *pool;
+    plcrash_async_allocator_t *allocator;
+    plcrash_error_t err;
+
+    if (worker_count == 0)
+        return PLCRASH_EINVAL;
+
+    if (worker_count > PLCRASH_LOG_WRITER_CAPTURE_WORKERS_MAX)
+        worker_count = PLCRASH_LOG_WRITER_CAPTURE_WORKERS_MAX;
+
+    /* Already enabled */
+    if (writer->capture_pool != NULL)
+        return PLCRASH_ESUCCESS;
+
+    /* Allocate the pool and slabs. We pad each allocation to account for allocator alignment. */
+    size_t slab_size = sizeof(plcrash_log_writer_thread_buffer_t) + 16;
+    err = plcrash_async_allocator_new(&allocator, sizeof(*pool) + 16 + (slab_size * worker_count), PLCrashAsyncGuardLowPage|PLCrashAsyncGuardHighPage);
+    if (err != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not create the capture pool allocator: %d", err);
+        return err;
+    }
+
+    pool = plcrash_async_allocator_alloc(allocator, sizeof(*pool), true);
+    if (pool == NULL) {
+        plcrash_async_allocator_free(allocator);
+        return PLCRASH_ENOMEM;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->allocator = allocator;
+
+    /* Start the workers */
+    for (uint32_t i = 0; i < worker_count; i++) {
+        plcrash_log_writer_capture_worker_t *worker = &pool->workers[i];
+        kern_return_t kr;
+
+        worker->pool = pool;
+        worker->index = i;
+
+        worker->buffer = plcrash_async_allocator_alloc(allocator, sizeof(plcrash_log_writer_thread_buffer_t), true);
+        if (worker->buffer == NULL) {
+            err = PLCRASH_ENOMEM;
+            goto error;
+        }
+
+        if ((kr = semaphore_create(mach_task_self(), &worker->start_sem, SYNC_POLICY_FIFO, 0)) != KERN_SUCCESS ||
+            (kr = semaphore_create(mach_task_self(), &worker->ready_sem, SYNC_POLICY_FIFO, 0)) != KERN_SUCCESS ||
+            (kr = semaphore_create(mach_task_self(), &worker->consumed_sem, SYNC_POLICY_FIFO, 0)) != KERN_SUCCESS)
+        {
+            PLCF_DEBUG("semaphore_create() failure: %d", kr);
+            err = PLCRASH_EINTERNAL;
+            goto error;
+        }
+
+        if (pthread_create(&worker->pthread, NULL, plcrash_writer_capture_worker_thread, worker) != 0) {
+            PLCF_DEBUG("Could not create capture worker thread: %s", strerror(errno));
+            err = PLCRASH_EINTERNAL;
+            goto error;
+        }
+
+        worker->thread = pthread_mach_thread_np(worker->pthread);
+        pool->worker_count++;
+    }
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+    writer->capture_pool = pool;
+
+    return PLCRASH_ESUCCESS;
+
+error:
+    plcrash_writer_capture_pool_free(pool);
+    return err;
+}
+
+/**
+ * @internal
+ *
+ * Write all thread messages for @a job using the capture pool workers. Threads are written in the same
+ * order as the serial path; threads that a worker could not capture in time are unwound by the writer.
+ *
+ * @param file Output file
+ * @param pool The capture pool. The caller must have acquired the pool's busy flag.
+ * @param job The capture job to execute.
+ * @param findContext Symbol lookup cache.
+ *
+ * @return Returns true if the job completed, or false if a worker failed to respond, in which case the pool
+ * must not be reused.
+ */
+static bool plcrash_writer_write_threads_parallel (plcrash_async_file_t *file,
+                                                   plcrash_log_writer_capture_pool_t *pool,
+                                                   plcrash_log_writer_capture_job_t *job,
+                                                   plcrash_async_symbol_cache_t *findContext)
+{
+    plcrash_log_writer_t *writer = job->writer;
+    bool worker_failed[PLCRASH_LOG_WRITER_CAPTURE_WORKERS_MAX] = { false };
+    bool completed = true;
+
+    /* Publish the job and wake the workers */
+    pool->job = *job;
+    OSMemoryBarrier();
+    for (uint32_t i = 0; i < pool->worker_count; i++)
+        semaphore_signal(pool->workers[i].start_sem);
+
+    /* Serialize the captured threads in order */
+    uint32_t thread_number = 0;
+    for (mach_msg_type_number_t i = 0; i < job->thread_count; i++) {
+        thread_t thread = job->threads[i];
+        plcrash_async_thread_state_t *thr_ctx = (thread == job->writer_thread) ? job->current_state : NULL;
+        bool crashed = (thread == job->crashed_thread);
+
+        if (!plcrash_writer_capture_job_includes_thread(pool, job, i))
+            continue;
+
+        /* Skip threads that have already been written, preserving their thread number */
+        if (thread == job->skip_thread) {
+            thread_number++;
+            continue;
+        }
+
+        /* Workers that have not yet unwound their threads observe the latched deadline */
+        plcrash_writer_check_deadline(writer);
+
+        plcrash_log_writer_capture_worker_t *worker = &pool->workers[thread_number % pool->worker_count];
+
+        /* Wait for the worker's capture. If the worker does not respond (eg, it has itself crashed), fall back on
+         * unwinding the remainder of its threads directly. */
+        if (!worker_failed[worker->index]) {
+            mach_timespec_t timeout = { .tv_sec = PLCRASH_LOG_WRITER_CAPTURE_TIMEOUT, .tv_nsec = 0 };
+            kern_return_t kr;
+
+            while ((kr = semaphore_timedwait(worker->ready_sem, timeout)) == KERN_ABORTED);
+            if (kr != KERN_SUCCESS) {
+                PLCF_DEBUG("Capture worker %" PRIu32 " did not respond: %d", worker->index, kr);
+                worker_failed[worker->index] = true;
+                completed = false;
+            }
+        }
+
+        if (worker_failed[worker->index] || worker->capture_failed) {
+            plcrash_writer_write_thread_message(file, writer, thread, thread_number, thr_ctx, job->image_list, findContext, crashed, SIZE_MAX);
+        } else {
+            /* Ensure a consistent view of the slab */
+            OSMemoryBarrier();
+
+            uint32_t size = plcrash_writer_write_captured_thread(NULL, writer, worker->buffer, thread_number, job->image_list, findContext, crashed);
+            plcrash_writer_pack(file, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+            plcrash_writer_write_captured_thread(file, writer, worker->buffer, thread_number, job->image_list, findContext, crashed);
+        }
+
+        /* Release the slab */
+        if (!worker_failed[worker->index])
+            semaphore_signal(worker->consumed_sem);
+
+        plcrash_writer_flush_point(file, writer, PLCRASH_LOG_WRITER_FLUSH_THREAD);
+        thread_number++;
+    }
+
+    return completed;
+}
+
+/**
+ * @internal
+ *
+ * Symbolication pipeline helper thread. Parks until a job is available, and then symbolicates each queued capture
+ * buffer, until the queue has been closed and drained.
+ *
+ * This code must be async-safe once a job has been received, as the state of the process' threads is
+ * entirely unknown.
+ */
+static void *plcrash_writer_symbolication_pipeline_thread (void *arg) {
+    plcrash_log_writer_symbolication_pipeline_t *pipeline = arg;
+
+    while (true) {
+        if (plcrash_writer_semaphore_wait(pipeline->start_sem) != KERN_SUCCESS)
+            break;
+
+        /* Ensure a consistent view of the job */
+        OSMemoryBarrier();
+        if (pipeline->shutdown)
+            break;
+
+        plcrash_log_writer_capture_job_t *job = &pipeline->job;
+
+        /* Each wake corresponds to either a queued buffer or the closing of the queue */
+        while (plcrash_writer_semaphore_wait(pipeline->queued_sem) == KERN_SUCCESS) {
+            uint32_t tail = pipeline->tail;
+            if (tail == pipeline->head) {
+                if (pipeline->closed)
+                    break;
+                continue;
+            }
+
+            /* Ensure a consistent view of the queued entry and its buffer */
+            OSMemoryBarrier();
+            mach_msg_type_number_t index = pipeline->queue[tail & (PLCRASH_LOG_WRITER_PIPELINE_QUEUE_SIZE - 1)];
+            plcrash_writer_symbolicate_captured_thread(&pipeline->buffers[index], job->writer, job->image_list, &pipeline->findContext, job->threads[index] == job->crashed_thread);
+
+            /* Publish the results before releasing the entry */
+            OSMemoryBarrier();
+            pipeline->tail = tail + 1;
+        }
+
+        OSMemoryBarrier();
+        semaphore_signal(pipeline->done_sem);
+    }
+
+    return NULL;
+}
+
+/**
+ * @internal
+ *
+ * Terminate the helper thread and release all resources associated with @a pipeline.
+ *
+ * @warning This method is not async safe.
+ */
+static void plcrash_writer_symbolication_pipeline_free (plcrash_log_writer_symbolication_pipeline_t *pipeline) {
+    /* Stop the helper */
+    if (pipeline->thread != MACH_PORT_NULL) {
+        pipeline->shutdown = true;
+        OSMemoryBarrier();
+
+        semaphore_signal(pipeline->start_sem);
+        pthread_join(pipeline->pthread, NULL);
+    }
+
+    if (pipeline->start_sem != SEMAPHORE_NULL)
+        semaphore_destroy(mach_task_self(), pipeline->start_sem);
+
+    if (pipeline->queued_sem != SEMAPHORE_NULL)
+        semaphore_destroy(mach_task_self(), pipeline->queued_sem);
+
+    if (pipeline->done_sem != SEMAPHORE_NULL)
+        semaphore_destroy(mach_task_self(), pipeline->done_sem);
+
+    if (pipeline->has_cache)
+        plcrash_async_symbol_cache_free(&pipeline->findContext);
+
+    free(pipeline);
+}
+
+/**
+ * Enable pipelined symbolication of live reports for @a writer. A helper thread will be started and parked; when a
+ * live report is written, the helper symbolicates each thread's captured frames while the writer proceeds with
+ * unwinding the remaining threads. Encoding begins once both have completed.
+ *
+ * Reports written at crash time are unaffected; see plcrash_log_writer_enable_parallel_capture().
+ *
+ * The helper thread is never suspended by the writer, and is excluded from the written report.
+ *
+ * @param writer The writer for which pipelined symbolication should be enabled.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an error result if the helper could not be started. On failure,
+ * the writer will continue to symbolicate threads serially.
+ *
+ * @warning This method is not async safe, and must be called prior to plcrash_log_writer_write().
+ */
+plcrash_error_t plcrash_log_writer_enable_symbolication_pipeline (plcrash_log_writer_t *writer) {
+    plcrash_log_writer_symbolication_pipeline_t *pipeline;
+    kern_return_t kr;
+
+    /* Already enabled */
+    if (writer->symbolication_pipeline != NULL)
+        return PLCRASH_ESUCCESS;
+
+    pipeline = calloc(1, sizeof(*pipeline));
+    if (pipeline == NULL)
+        return PLCRASH_ENOMEM;
+
+    /* The helper maintains its own symbol cache, as the writer's cache is not thread-safe */
+    plcrash_error_t err = plcrash_async_symbol_cache_init(&pipeline->findContext);
+    if (err != PLCRASH_ESUCCESS) {
+        free(pipeline);
+        return err;
+    }
+    pipeline->has_cache = true;
+
+    if ((kr = semaphore_create(mach_task_self(), &pipeline->start_sem, SYNC_POLICY_FIFO, 0)) != KERN_SUCCESS ||
+        (kr = semaphore_create(mach_task_self(), &pipeline->queued_sem, SYNC_POLICY_FIFO, 0)) != KERN_SUCCESS ||
+        (kr = semaphore_create(mach_task_self(), &pipeline->done_sem, SYNC_POLICY_FIFO, 0)) != KERN_SUCCESS)
+    {
+        PLCF_DEBUG("semaphore_create() failure: %d", kr);
+        plcrash_writer_symbolication_pipeline_free(pipeline);
+        return PLCRASH_EINTERNAL;
+    }
+
+    if (pthread_create(&pipeline->pthread, NULL, plcrash_writer_symbolication_pipeline_thread, pipeline) != 0) {
+        PLCF_DEBUG("Could not create symbolication helper thread: %s", strerror(errno));
+        plcrash_writer_symbolication_pipeline_free(pipeline);
+        return PLCRASH_EINTERNAL;
+    }
+
+    pipeline->thread = pthread_mach_thread_np(pipeline->pthread);
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+    writer->symbolication_pipeline = pipeline;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Start a symbolication job for @a job's capture @a buffers. Queued buffers must not be accessed by the writer until
+ * plcrash_writer_symbolication_pipeline_finish() has returned.
+ *
+ * @param pipeline The pipeline, or NULL.
+ * @param job The capture job.
+ * @param buffers The job's capture buffers.
+ *
+ * @return Returns true if the job was started, or false if the pipeline is unavailable.
+ */
+static bool plcrash_writer_symbolication_pipeline_start (plcrash_log_writer_symbolication_pipeline_t *pipeline,
+                                                         plcrash_log_writer_capture_job_t *job,
+                                                         plcrash_log_writer_thread_buffer_t *buffers)
+{
+    if (pipeline == NULL || !OSAtomicCompareAndSwap32Barrier(0, 1, &pipeline->busy))
+        return false;
+
+    pipeline->job = *job;
+    pipeline->buffers = buffers;
+    pipeline->head = 0;
+    pipeline->tail = 0;
+    pipeline->closed = false;
+
+    /* Ensure a consistent view of the job */
+    OSMemoryBarrier();
+    semaphore_signal(pipeline->start_sem);
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Queue the capture buffer at @a index for symbolication by the helper.
+ *
+ * @return Returns true if the buffer was queued, or false if the queue is full, in which case the buffer must be
+ * symbolicated by the writer.
+ */
+static bool plcrash_writer_symbolication_pipeline_enqueue (plcrash_log_writer_symbolication_pipeline_t *pipeline, mach_msg_type_number_t index) {
+    uint32_t head = pipeline->head;
+    if (head - pipeline->tail == PLCRASH_LOG_WRITER_PIPELINE_QUEUE_SIZE)
+        return false;
+
+    pipeline->queue[head & (PLCRASH_LOG_WRITER_PIPELINE_QUEUE_SIZE - 1)] = index;
+
+    /* Publish the entry and its buffer */
+    OSMemoryBarrier();
+    pipeline->head = head + 1;
+    semaphore_signal(pipeline->queued_sem);
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Close the pipeline's queue, and wait for the helper to symbolicate the queued buffers.
+ *
+ * @return Returns true if the job completed, or false if the helper failed to respond, in which case neither the
+ * pipeline nor the job's capture buffers may be reused, as the helper may still access them.
+ */
+static bool plcrash_writer_symbolication_pipeline_finish (plcrash_log_writer_symbolication_pipeline_t *pipeline) {
+    mach_timespec_t timeout = { .tv_sec = PLCRASH_LOG_WRITER_CAPTURE_TIMEOUT, .tv_nsec = 0 };
+    kern_return_t kr;
+
+    pipeline->closed = true;
+    OSMemoryBarrier();
+    semaphore_signal(pipeline->queued_sem);
+
+    while ((kr = semaphore_timedwait(pipeline->done_sem, timeout)) == KERN_ABORTED);
+    if (kr != KERN_SUCCESS) {
+        PLCF_DEBUG("Symbolication helper did not respond: %d", kr);
+        return false;
+    }
+
+    /* Ensure a consistent view of the symbolicated buffers */
+    OSMemoryBarrier();
+    OSAtomicCompareAndSwap32Barrier(1, 0, &pipeline->busy);
+
+    return true;
+}
+
+
+/**
+ * @internal
+ *
+ * Binary image message storage, initialized by plcrash_writer_binary_image_message_init(). The message's fields
+ * refer to the values held by this structure, and it must not be copied once initialized.
+ */
+typedef struct plcrash_writer_binary_image_message {
+    /** CrashReport.BinaryImage.size */
+    uint64_t size;
+
+    /** CrashReport.BinaryImage.base_address */
+    uint64_t base_address;
+
+    /** CrashReport.BinaryImage.uuid */
+    PLProtobufCBinaryData uuid;
+
+    /** CrashReport.BinaryImage.code_type */
+    plcrash_writer_processor_message_t code_type;
+
+    /** Field table. */
+    plcrash_writer_field_t fields[5];
+
+    /** The message. */
+    plcrash_writer_message_t message;
+} plcrash_writer_binary_image_message_t;
+
+/**
+ * @internal
+ *
+ * Initialize @a storage with a binary image message, and return the message. The message's size is computed once,
+ * on first use, and is then reused when the message is written.
+ *
+ * @param storage The message storage to initialize.
+ * @param image The Mach-O image. The image must remain valid until the message has been written.
+ */
+static plcrash_writer_message_t *plcrash_writer_binary_image_message_init (plcrash_writer_binary_image_message_t *storage, plcrash_async_macho_t *image) {
+    /* Fetch the CPU types, as cached by plcrash_nasync_macho_init(). Note that the wire format represents these as
+     * 64-bit unsigned integers. We explicitly cast to an equivalently sized unsigned type to prevent improper sign
+     * extension. */
+    uint64_t cpu_type = (uint32_t) image->cpu_type;
+    uint64_t cpu_subtype = (uint32_t) image->cpu_subtype;
+
+    /* Text segment size and base address */
+    storage->size = image->text_size;
+    storage->base_address = (uintptr_t) image->header_addr;
+
+    /* 128-bit UUID, as cached by plcrash_nasync_macho_init() */
+    storage->uuid.len = sizeof(image->uuid);
+    storage->uuid.data = image->uuid;
+
+    plcrash_writer_field_t fields[] = {
+        { PLCRASH_PROTO_BINARY_IMAGE_SIZE_ID,       PLPROTOBUF_C_TYPE_UINT64,   &storage->size },
+        { PLCRASH_PROTO_BINARY_IMAGE_ADDR_ID,       PLPROTOBUF_C_TYPE_UINT64,   &storage->base_address },
+        { PLCRASH_PROTO_BINARY_IMAGE_NAME_ID,       PLPROTOBUF_C_TYPE_STRING,   image->name },
+        { PLCRASH_PROTO_BINARY_IMAGE_UUID_ID,       PLPROTOBUF_C_TYPE_BYTES,    image->has_uuid ? &storage->uuid : NULL },
+        { PLCRASH_PROTO_BINARY_IMAGE_CODE_TYPE_ID,  PLPROTOBUF_C_TYPE_MESSAGE,  plcrash_writer_processor_message_init(&storage->code_type, cpu_type, cpu_subtype) },
+    };
+    memcpy(storage->fields, fields, sizeof(storage->fields));
+
+    plcrash_writer_message_t message = PLCRASH_WRITER_MESSAGE_INIT(storage->fields);
+    storage->message = message;
+    return &storage->message;
+}
+
+
+/**
+ * Encode @a image as a complete binary image report message, including the message's field tag and length. The result
+ * may be registered with an image list via plcrash_nasync_image_list_enable_image_encoding(), allowing the binary
+ * images to be written at crash time without re-reading each image's load commands.
+ *
+ * @param image The image to encode.
+ * @param[out] data On success, a malloc()-allocated buffer containing the encoded message. The caller is responsible
+ * for freeing this buffer.
+ * @param[out] length On success, the length of @a data, in bytes.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t value on failure.
+ *
+ * @warning This function is not async safe.
+ */
+plcrash_error_t plcrash_log_writer_encode_binary_image (plcrash_async_macho_t *image, void **data, size_t *length) {
+    plcrash_writer_binary_image_message_t storage;
+    plcrash_writer_message_t *message;
+    plcrash_async_file_t file;
+    size_t total;
+    void *buffer;
+
+    /* Determine the total encoded size */
+    message = plcrash_writer_binary_image_message_init(&storage, image);
+    total = plcrash_writer_pack_embedded_message(NULL, PLCRASH_PROTO_BINARY_IMAGES_ID, message);
+
+    if ((buffer = malloc(total)) == NULL)
+        return PLCRASH_ENOMEM;
+
+    /* Encode directly to the exactly-sized buffer; it will never be flushed to the (invalid) file descriptor. The
+     * image name is re-read here, so we verify that the encoded length matches our size calculation. */
+    plcrash_async_file_init_buffer(&file, -1, 0, buffer, total);
+    plcrash_writer_pack_embedded_message(&file, PLCRASH_PROTO_BINARY_IMAGES_ID, message);
+
+    if (file.buflen != total) {
+        PLCF_DEBUG("Binary image encoding for %s did not match the expected size", image->name);
+        free(buffer);
+        return PLCRASH_EINTERNAL;
+    }
+
+    *data = buffer;
+    *length = total;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Return the identifier of the encoded image manifest @a data: its 64-bit FNV-1a hash.
+ *
+ * @param data The encoded ImageManifest message.
+ * @param length The length of @a data, in bytes.
+ */
+uint64_t plcrash_log_writer_image_manifest_identifier (const void *data, size_t length) {
+    const uint8_t *bytes = data;
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/* qsort() comparator for pl_vm_address_t values */
+static int plcrash_writer_address_compare (const void *a, const void *b) {
+    pl_vm_address_t lhs = *(const pl_vm_address_t *) a;
+    pl_vm_address_t rhs = *(const pl_vm_address_t *) b;
+
+    if (lhs < rhs)
+        return -1;
+    else if (lhs > rhs)
+        return 1;
+
+    return 0;
+}
+
+/**
+ * Generate an image manifest describing all images currently registered with @a image_list, along with the
+ * manifest's encoded ImageManifest message. The message is identical for an identical set of loaded images, and its
+ * identifier may be used to persist each distinct manifest once.
+ *
+ * Any images queued for deferred parsing are not included; the caller should load them prior to generating the
+ * manifest via plcrash_nasync_image_list_load_deferred().
+ *
+ * @param image_list The image list to be described.
+ * @param[out] manifest On success, the newly allocated manifest. The caller is responsible for freeing the manifest
+ * via plcrash_log_writer_image_manifest_free().
+ * @param[out] data On success, a malloc()-allocated buffer containing the encoded manifest. The caller is responsible
+ * for freeing this buffer.
+ * @param[out] length On success, the length of @a data, in bytes.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an appropriate plcrash_error_t value on failure.
+ *
+ * @warning This function is not async safe.
+ */
+plcrash_error_t plcrash_log_writer_image_manifest_create (plcrash_async_image_list_t *image_list,
+                                                         plcrash_log_writer_image_manifest_t **manifest,
+                                                         void **data,
+                                                         size_t *length)
+{
+    plcrash_log_writer_image_manifest_t *result;
+    uint8_t *buffer = NULL;
+    size_t buffer_len = 0;
+    size_t buffer_capacity = 0;
+    size_t header_capacity = 0;
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+
+    if ((result = calloc(1, sizeof(*result))) == NULL)
+        return PLCRASH_ENOMEM;
+
+    plcrash_async_image_list_set_reading(image_list, true);
+
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
+        /* Use the pre-encoded message, if available */
+        void *encoded = image->_encoded;
+        size_t encoded_len = image->_encoded_length;
+        void *allocated = NULL;
+
+        if (encoded == NULL) {
+            if ((err = plcrash_log_writer_encode_binary_image(&image->macho_image, &allocated, &encoded_len)) != PLCRASH_ESUCCESS)
+                break;
+            encoded = allocated;
+        }
+
+        /* Append the encoded image */
+        if (buffer_len + encoded_len > buffer_capacity) {
+            size_t capacity = MAX(buffer_capacity * 2, buffer_len + encoded_len);
+            uint8_t *resized = realloc(buffer, capacity);
+            if (resized == NULL) {
+                free(allocated);
+                err = PLCRASH_ENOMEM;
+                break;
+            }
+
+            buffer = resized;
+            buffer_capacity = capacity;
+        }
+
+        memcpy(buffer + buffer_len, encoded, encoded_len);
+        buffer_len += encoded_len;
+        free(allocated);
+
+        /* Record the header address */
+        if (result->count == header_capacity) {
+            size_t capacity = MAX(header_capacity * 2, 64);
+            pl_vm_address_t *resized = realloc(result->headers, capacity * sizeof(result->headers[0]));
+            if (resized == NULL) {
+                err = PLCRASH_ENOMEM;
+                break;
+            }
+
+            result->headers = resized;
+            header_capacity = capacity;
+        }
+
+        result->headers[result->count++] = image->macho_image.header_addr;
+    }
+
+    plcrash_async_image_list_set_reading(image_list, false);
+
+    if (err != PLCRASH_ESUCCESS) {
+        free(buffer);
+        plcrash_log_writer_image_manifest_free(result);
+        return err;
+    }
+
+    qsort(result->headers, result->count, sizeof(result->headers[0]), plcrash_writer_address_compare);
+    result->identifier = plcrash_log_writer_image_manifest_identifier(buffer, buffer_len);
+
+    *manifest = result;
+    *data = buffer;
+    *length = buffer_len;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Free an image manifest allocated by plcrash_log_writer_image_manifest_create().
+ *
+ * @param manifest The manifest to free.
+ *
+ * @warning This function is not async safe.
+ */
+void plcrash_log_writer_image_manifest_free (plcrash_log_writer_image_manifest_t *manifest) {
+    if (manifest == NULL)
+        return;
+
+    free(manifest->headers);
+    free(manifest);
+}
+
+/**
+ * @internal
+ *
+ * Symbolicate the uncaught exception's call stack frames. This is performed once per report, prior to writing the
+ * exception message, rather than each time the message is sized or written; as the exception's call stack commonly
+ * overlaps with that of the crashed thread, the results are also shared with the crashed thread via the symbol cache.
+ *
+ * @param writer Writer containing exception data.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ */
+static void plcrash_writer_symbolicate_exception (plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext) {
+    plcrash_log_writer_thread_buffer_t *buffer = writer->uncaught_exception.frame_buffer;
+
+    /* Discard the results of any previous report */
+    buffer->symbolicated = false;
+    buffer->symbol_pool_used = 0;
+    for (uint32_t i = 0; i < buffer->frame_count; i++) {
+        buffer->frames[i].has_symbol = false;
+        buffer->frames[i].symbol_deferred = false;
+    }
+
+    plcrash_writer_symbolicate_captured_thread(buffer, writer, image_list, findContext, true);
+}
+
+/**
+ * @internal
+ *
+ * Write the crash Exception message
+ *
+ * @param file Output file
+ * @param writer Writer containing exception data
+ */
+static size_t plcrash_writer_write_exception (plcrash_async_file_t *file, plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext) {
+    size_t rv = 0;
+
+    /* Write the name and reason */
+    assert(writer->uncaught_exception.has_exception);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_NAME_ID, PLPROTOBUF_C_TYPE_STRING, writer->uncaught_exception.name);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_REASON_ID, PLPROTOBUF_C_TYPE_STRING, writer->uncaught_exception.reason);
+    
+    /* Write the stack frames, if any, using the symbols previously resolved by plcrash_writer_symbolicate_exception() */
+    plcrash_log_writer_thread_buffer_t *buffer = writer->uncaught_exception.frame_buffer;
+    if (buffer != NULL) {
+        for (uint32_t i = 0; i < buffer->frame_count; i++) {
+            plcrash_log_writer_frame_t *frame = &buffer->frames[i];
+
+            /* Determine the size */
+            uint32_t frame_size = plcrash_writer_write_captured_thread_frame(NULL, writer, frame, image_list, findContext);
+
+            rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
+            rv += plcrash_writer_write_captured_thread_frame(file, writer, frame, image_list, findContext);
+        }
+    }
+
+    /* Otherwise, look up each frame's symbol as it is written */
+    uint32_t frame_count = 0;
+    for (size_t i = 0; buffer == NULL && i < writer->uncaught_exception.callstack_count && frame_count < MAX_THREAD_FRAMES; i++) {
+        uint64_t pc = (uint64_t)(uintptr_t) writer->uncaught_exception.callstack[i];
+        
+        /* Determine the size */
+        uint32_t frame_size = plcrash_writer_write_thread_frame(NULL, writer, pc, image_list, findContext);
+        
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
+        rv += plcrash_writer_write_thread_frame(file, writer, pc, image_list, findContext);
+        frame_count++;
+    }
+
+    /* Write the user info */
+    for (size_t i = 0; i < writer->uncaught_exception.user_info_size; i++) {
+        user_info_t pair = writer->uncaught_exception.user_info[i];
+
+        /* Determine the size */
+        uint32_t pair_size = plcrash_writer_write_user_info_pair(NULL, pair);
+
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_USER_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &pair_size);
+        rv += plcrash_writer_write_user_info_pair(file, pair);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the crash signal message, including the message's field header.
+ *
+ * @param file Output file
+ * @param siginfo The signal information
+ */
+static size_t plcrash_writer_write_signal (plcrash_async_file_t *file, plcrash_log_signal_info_t *siginfo) {
+    /* BSD signal info is always required in the current report format; this restriction will be lifted
+     * once we switch to the 2.0 format. */
+    PLCF_ASSERT(siginfo->bsd_info != NULL);
+    
+    /* Fetch the signal name */
+    char name_buf[10];
+    const char *name;
+    if ((name = plcrash_async_signal_signame(siginfo->bsd_info->signo)) == NULL) {
+        PLCF_DEBUG("Warning -- unhandled signal number (signo=%d). This is a bug.", siginfo->bsd_info->signo);
+        snprintf(name_buf, sizeof(name_buf), "#%d", siginfo->bsd_info->signo);
+        name = name_buf;
+    }
+
+    /* Fetch the signal code string */
+    char code_buf[10];
+    const char *code;
+    if ((code = plcrash_async_signal_sigcode(siginfo->bsd_info->signo, siginfo->bsd_info->code)) == NULL) {
+        PLCF_DEBUG("Warning -- unhandled signal sicode (signo=%d, code=%d). This is a bug.", siginfo->bsd_info->signo, siginfo->bsd_info->code);
+        snprintf(code_buf, sizeof(code_buf), "#%d", siginfo->bsd_info->code);
+        code = code_buf;
+    }
     
-    /* Free the system info */
-    if (writer->system_info.version != NULL)
-        free(writer->system_info.version);
+    /* Address value */
+    uint64_t addr = (uintptr_t) siginfo->bsd_info->address;
+
+    /* Mach exception info; the 64-bit exception codes are written as-is, as unsigned values. */
+    mach_msg_type_number_t code_count = siginfo->mach_info != NULL ? siginfo->mach_info->code_count : 0;
+    plcrash_writer_field_t mach_fields[1 + code_count];
+    plcrash_writer_message_t mach_message = PLCRASH_WRITER_MESSAGE_INIT(mach_fields);
+    uint64_t mach_type = 0;
+
+    if (siginfo->mach_info != NULL) {
+        mach_type = siginfo->mach_info->type;
+        mach_fields[0] = (plcrash_writer_field_t) { PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_TYPE_ID, PLPROTOBUF_C_TYPE_UINT64, &mach_type };
+
+        for (mach_msg_type_number_t i = 0; i < code_count; i++)
+            mach_fields[1 + i] = (plcrash_writer_field_t) { PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_CODES_ID, PLPROTOBUF_C_TYPE_UINT64, &siginfo->mach_info->code[i] };
+    }
+
+    plcrash_writer_field_t fields[] = {
+        { PLCRASH_PROTO_SIGNAL_NAME_ID,             PLPROTOBUF_C_TYPE_STRING,   name },
+        { PLCRASH_PROTO_SIGNAL_CODE_ID,             PLPROTOBUF_C_TYPE_STRING,   code },
+        { PLCRASH_PROTO_SIGNAL_ADDRESS_ID,          PLPROTOBUF_C_TYPE_UINT64,   &addr },
+        { PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_ID,   PLPROTOBUF_C_TYPE_MESSAGE,  siginfo->mach_info != NULL ? &mach_message : NULL },
+    };
+    plcrash_writer_message_t message = PLCRASH_WRITER_MESSAGE_INIT(fields);
+
+    /* Write it out; the message sizes are computed once, and reused for the length prefixes */
+    return plcrash_writer_pack_embedded_message(file, PLCRASH_PROTO_SIGNAL_ID, &message);
+}
+
+/**
+ * @internal
+ *
+ * Write the report info message
+ *
+ * @param file Output file
+ * @param writer Writer containing report data
+ * @param suspend_duration The measured thread suspension time, in nanoseconds, or NULL if not measured.
+ */
+static size_t plcrash_writer_write_report_info (plcrash_async_file_t *file, plcrash_log_writer_t *writer, const uint64_t *suspend_duration) {
+    size_t rv = 0;
+
+    /* Note crashed status */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_REPORT_INFO_USER_REQUESTED_ID, PLPROTOBUF_C_TYPE_BOOL, &writer->report_info.user_requested);
     
-    if (writer->system_info.build != NULL)
-        free(writer->system_info.build);
+    /* Write the 128-bit UUID */
+    PLProtobufCBinaryData uuid_bin;
     
-    /* Free the machine info */
-    if (writer->machine_info.model != NULL)
-        free(writer->machine_info.model);
+    uuid_bin.len = sizeof(writer->report_info.uuid_bytes);
+    uuid_bin.data = &writer->report_info.uuid_bytes;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_REPORT_INFO_UUID_ID, PLPROTOBUF_C_TYPE_BYTES, &uuid_bin);
 
-    /* Free the exception data */
-    if (writer->uncaught_exception.has_exception) {
-        if (writer->uncaught_exception.name != NULL)
-            free(writer->uncaught_exception.name);
+    /* Thread suspension time */
+    if (suspend_duration != NULL)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_REPORT_INFO_THREAD_SUSPEND_DURATION_ID, PLPROTOBUF_C_TYPE_UINT64, suspend_duration);
 
-        if (writer->uncaught_exception.reason != NULL)
-            free(writer->uncaught_exception.reason);
-        
-        if (writer->uncaught_exception.callstack != NULL)
-            free(writer->uncaught_exception.callstack);
+    return rv;
+}
 
-        if (writer->uncaught_exception.user_info != NULL) {
-            for (uint64_t i=0; i!=writer->uncaught_exception.user_info_size; i++) {
-                if (writer->uncaught_exception.user_info[i].key != NULL)
-                    free(writer->uncaught_exception.user_info[i].key);
-                if (writer->uncaught_exception.user_info[i].serialized != NULL)
-                    free(writer->uncaught_exception.user_info[i].serialized);
+/**
+ * @internal
+ *
+ * Report generation measurements, as written by plcrash_writer_write_instrumentation(). All times are in nanoseconds.
+ */
+typedef struct plcrash_log_writer_instrumentation {
+    /** Time for which the process' threads were suspended. */
+    uint64_t thread_suspend_time;
+
+    /** Time spent unwinding thread stacks. */
+    uint64_t unwind_time;
+
+    /** Time spent performing symbol table lookups. */
+    uint64_t symtab_lookup_time;
+
+    /** Time spent performing Objective-C metadata lookups. */
+    uint64_t objc_lookup_time;
+
+    /** Time spent writing the binary image messages. */
+    uint64_t image_write_time;
+
+    /** Time spent writing buffered output. */
+    uint64_t output_time;
+
+    /** The number of output writes. */
+    uint64_t output_count;
+
+    /** The number of memory objects mapped. */
+    uint64_t mobject_count;
+
+    /** The number of task memory reads. */
+    uint64_t vm_read_count;
+
+    /** The maximum number of bytes in use by the writer's allocators. */
+    uint64_t allocator_high_water_mark;
+
+    /** The size of the alternate signal stack, or 0 if no signal stack is installed. */
+    uint64_t signal_stack_size;
+
+    /** The maximum number of bytes of the alternate signal stack in use. */
+    uint64_t signal_stack_high_water_mark;
+} plcrash_log_writer_instrumentation_t;
+
+/**
+ * @internal
+ *
+ * Write the instrumentation message
+ *
+ * @param file Output file
+ * @param info The measurements to be written.
+ */
+static size_t plcrash_writer_write_instrumentation (plcrash_async_file_t *file, const plcrash_log_writer_instrumentation_t *info) {
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_THREAD_SUSPEND_TIME_ID, PLPROTOBUF_C_TYPE_UINT64, &info->thread_suspend_time);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_UNWIND_TIME_ID, PLPROTOBUF_C_TYPE_UINT64, &info->unwind_time);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_SYMTAB_LOOKUP_TIME_ID, PLPROTOBUF_C_TYPE_UINT64, &info->symtab_lookup_time);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_OBJC_LOOKUP_TIME_ID, PLPROTOBUF_C_TYPE_UINT64, &info->objc_lookup_time);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_IMAGE_WRITE_TIME_ID, PLPROTOBUF_C_TYPE_UINT64, &info->image_write_time);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_OUTPUT_TIME_ID, PLPROTOBUF_C_TYPE_UINT64, &info->output_time);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_OUTPUT_COUNT_ID, PLPROTOBUF_C_TYPE_UINT64, &info->output_count);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_MOBJECT_COUNT_ID, PLPROTOBUF_C_TYPE_UINT64, &info->mobject_count);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_VM_READ_COUNT_ID, PLPROTOBUF_C_TYPE_UINT64, &info->vm_read_count);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_ALLOCATOR_HIGH_WATER_MARK_ID, PLPROTOBUF_C_TYPE_UINT64, &info->allocator_high_water_mark);
+
+    if (info->signal_stack_size != 0) {
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_SIGNAL_STACK_SIZE_ID, PLPROTOBUF_C_TYPE_UINT64, &info->signal_stack_size);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_SIGNAL_STACK_HIGH_WATER_MARK_ID, PLPROTOBUF_C_TYPE_UINT64, &info->signal_stack_high_water_mark);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write a trace event message
+ *
+ * @param file Output file
+ * @param entry The trace entry to be written.
+ */
+static size_t plcrash_writer_write_trace_event (plcrash_async_file_t *file, const plcrash_async_trace_entry_t *entry) {
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_TRACE_EVENT_SEQUENCE_ID, PLPROTOBUF_C_TYPE_UINT64, (const uint64_t *) &entry->seq);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_TRACE_EVENT_EVENT_ID, PLPROTOBUF_C_TYPE_UINT32, &entry->event);
+    for (uint32_t i = 0; i < entry->argc && i < PLCRASH_ASYNC_TRACE_MAX_ARGS; i++)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_TRACE_EVENT_ARGS_ID, PLPROTOBUF_C_TYPE_UINT64, &entry->args[i]);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write a breadcrumb message
+ *
+ * @param file Output file
+ * @param slot The breadcrumb to be written.
+ */
+static size_t plcrash_writer_write_breadcrumb (plcrash_async_file_t *file, const plcrash_breadcrumb_slot_t *slot) {
+    PLProtobufCBinaryData binary;
+    size_t rv = 0;
+
+    binary.len = slot->length;
+    binary.data = (uint8_t *) slot->data;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_BREADCRUMB_SEQUENCE_ID, PLPROTOBUF_C_TYPE_UINT64, (const uint64_t *) &slot->seq);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_BREADCRUMB_DATA_ID, PLPROTOBUF_C_TYPE_BYTES, &binary);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the valid breadcrumbs of @a ring, oldest first. Each breadcrumb is copied to the stack before it is written,
+ * allowing breadcrumbs recorded concurrently by other threads to be detected and skipped.
+ *
+ * @param file Output file
+ * @param ring The breadcrumb ring.
+ */
+static void plcrash_writer_write_breadcrumbs (plcrash_async_file_t *file, plcrash_breadcrumb_ring_t *ring) {
+    plcrash_breadcrumb_slot_t slot;
+    uint64_t end;
+
+    for (uint64_t seq = plcrash_async_breadcrumb_ring_first(ring, &end); seq <= end; seq++) {
+        if (!plcrash_async_breadcrumb_ring_read(ring, seq, &slot))
+            continue;
+
+        uint32_t size = (uint32_t) plcrash_writer_write_breadcrumb(NULL, &slot);
+        plcrash_writer_pack(file, PLCRASH_PROTO_BREADCRUMBS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_breadcrumb(file, &slot);
+    }
+}
+
+/**
+ * @internal
+ *
+ * Write a custom data message. The region's contents are written directly from the application's memory.
+ *
+ * @param file Output file
+ * @param region The region to be written.
+ * @param version The value of the region's version counter, read prior to writing the region. Ignored if the region
+ * has no version counter.
+ */
+static size_t plcrash_writer_write_custom_data_region (plcrash_async_file_t *file, const plcrash_custom_data_region_t *region, uint32_t version) {
+    PLProtobufCBinaryData binary;
+    size_t rv = 0;
+
+    binary.len = region->length;
+    binary.data = (uint8_t *) region->address;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_CUSTOM_DATA_IDENTIFIER_ID, PLPROTOBUF_C_TYPE_STRING, region->identifier);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_CUSTOM_DATA_DATA_ID, PLPROTOBUF_C_TYPE_BYTES, &binary);
+
+    if (region->version != NULL) {
+        /* The region is torn if it was being modified when we started, or if the counter has since changed. The
+         * counter can only be re-read once the data has been written; as the field's size is fixed, the
+         * message size computed prior to writing remains valid. */
+        OSMemoryBarrier();
+        bool torn = (version & 1) != 0 || *region->version != version;
+
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_CUSTOM_DATA_VERSION_ID, PLPROTOBUF_C_TYPE_UINT32, &version);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_CUSTOM_DATA_TORN_ID, PLPROTOBUF_C_TYPE_BOOL, &torn);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write all regions registered with @a registry.
+ *
+ * @param file Output file
+ * @param registry The custom data registry.
+ */
+static void plcrash_writer_write_custom_data (plcrash_async_file_t *file, plcrash_custom_data_registry_t *registry) {
+    plcrash_custom_data_region_t region;
+
+    for (uint32_t i = 0; i < PLCRASH_CUSTOM_DATA_MAX_REGIONS; i++) {
+        if (!plcrash_async_custom_data_read(registry, i, &region))
+            continue;
+
+        uint32_t version = 0;
+        if (region.version != NULL) {
+            version = *region.version;
+            OSMemoryBarrier();
+        }
+
+        uint32_t size = (uint32_t) plcrash_writer_write_custom_data_region(NULL, &region, version);
+        plcrash_writer_pack(file, PLCRASH_PROTO_CUSTOM_DATA_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_custom_data_region(file, &region, version);
+    }
+}
+
+/**
+ * @internal
+ *
+ * Write the most recently recorded trace events. The snapshot buffer is allocated from the writer's allocator; if it
+ * is unavailable, no events will be written.
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ */
+static void plcrash_writer_write_trace_events (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
+    const size_t buffer_size = sizeof(plcrash_async_trace_entry_t) * PLCRASH_ASYNC_TRACE_CAPACITY;
+    plcrash_async_trace_entry_t *entries;
+
+    if (writer->allocator == NULL)
+        return;
+
+    entries = plcrash_async_allocator_alloc(writer->allocator, buffer_size, true);
+    if (entries == NULL) {
+        PLCF_DEBUG("Could not allocate the trace event buffer");
+        return;
+    }
+
+    size_t count = plcrash_async_trace_snapshot(entries, PLCRASH_ASYNC_TRACE_CAPACITY);
+    for (size_t i = 0; i < count; i++) {
+        uint32_t size = (uint32_t) plcrash_writer_write_trace_event(NULL, &entries[i]);
+        plcrash_writer_pack(file, PLCRASH_PROTO_TRACE_EVENTS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_trace_event(file, &entries[i]);
+    }
+
+    plcrash_async_allocator_dealloc(writer->allocator, entries, buffer_size);
+}
+
+/**
+ * @internal
+ *
+ * The number of output bytes reserved for the sections that follow captured memory. Stack and register memory are
+ * only written if they fit within the file's output limit less this reserve.
+ */
+#define PLCRASH_WRITER_MEMORY_RESERVE (128 * 1024)
+
+/**
+ * @internal
+ *
+ * Return the number of bytes of captured memory that may be written to @a file, up to @a size bytes, while leaving
+ * PLCRASH_WRITER_MEMORY_RESERVE bytes of the file's output limit available.
+ *
+ * @param file Output file
+ * @param size The maximum number of bytes to be written.
+ */
+static size_t plcrash_writer_memory_budget (plcrash_async_file_t *file, size_t size) {
+    if (file->limit_bytes == 0)
+        return size;
+
+    off_t remaining = file->limit_bytes - file->total_bytes - PLCRASH_WRITER_MEMORY_RESERVE;
+    if (remaining <= 0)
+        return 0;
+
+    return MIN(size, (size_t) remaining);
+}
+
+/**
+ * @internal
+ *
+ * The block size at which captured stack memory is scanned for runs of zero bytes.
+ */
+#define PLCRASH_WRITER_STACK_MEMORY_BLOCK_SIZE 16
+
+/**
+ * @internal
+ *
+ * The minimum length of a run of zero bytes that is omitted from captured stack memory.
+ */
+#define PLCRASH_WRITER_STACK_MEMORY_ZERO_RUN 64
+
+/**
+ * @internal
+ *
+ * Find the next chunk of @a data that is not part of a suppressed run of zero bytes.
+ *
+ * @param data The captured memory.
+ * @param length The length of @a data.
+ * @param offset On input, the offset at which to begin scanning. On return, the offset of the chunk.
+ * @param chunk_length On return, the length of the chunk.
+ *
+ * @return Returns true if a chunk was found, or false if only zero bytes remain.
+ */
+static bool plcrash_writer_next_stack_memory_chunk (const uint8_t *data, size_t length, size_t *offset, size_t *chunk_length) {
+    size_t start = SIZE_MAX;
+    size_t end = 0;
+
+    for (size_t pos = *offset; pos < length; pos += PLCRASH_WRITER_STACK_MEMORY_BLOCK_SIZE) {
+        size_t block_len = MIN((size_t) PLCRASH_WRITER_STACK_MEMORY_BLOCK_SIZE, length - pos);
+
+        bool zero = true;
+        for (size_t i = 0; i < block_len; i++) {
+            if (data[pos + i] != 0) {
+                zero = false;
+                break;
             }
-            free(writer->uncaught_exception.user_info);
         }
+
+        if (!zero) {
+            if (start == SIZE_MAX)
+                start = pos;
+            end = pos + block_len;
+        } else if (start != SIZE_MAX && pos + block_len - end >= PLCRASH_WRITER_STACK_MEMORY_ZERO_RUN) {
+            break;
+        }
+    }
+
+    if (start == SIZE_MAX)
+        return false;
+
+    *offset = start;
+    *chunk_length = end - start;
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Write a stack memory message. Runs of zero bytes are omitted, and are restored by the reader from the
+ * region's length.
+ *
+ * @param file Output file
+ * @param thread_number The thread's index number.
+ * @param address The address at which the memory was read.
+ * @param data The captured memory.
+ * @param length The length of @a data.
+ */
+static size_t plcrash_writer_write_stack_memory (plcrash_async_file_t *file, uint32_t thread_number, uint64_t address, const uint8_t *data, size_t length) {
+    uint64_t length64 = length;
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_STACK_MEMORY_THREAD_NUMBER_ID, PLPROTOBUF_C_TYPE_UINT32, &thread_number);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_STACK_MEMORY_ADDRESS_ID, PLPROTOBUF_C_TYPE_UINT64, &address);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_STACK_MEMORY_LENGTH_ID, PLPROTOBUF_C_TYPE_UINT64, &length64);
+
+    size_t offset = 0;
+    size_t chunk_length;
+    while (plcrash_writer_next_stack_memory_chunk(data, length, &offset, &chunk_length)) {
+        uint64_t chunk_offset = offset;
+        PLProtobufCBinaryData binary;
+        binary.len = chunk_length;
+        binary.data = (uint8_t *) data + offset;
+
+        uint32_t size = (uint32_t) plcrash_writer_pack(NULL, PLCRASH_PROTO_STACK_MEMORY_CHUNK_OFFSET_ID, PLPROTOBUF_C_TYPE_UINT64, &chunk_offset);
+        size += plcrash_writer_pack(NULL, PLCRASH_PROTO_STACK_MEMORY_CHUNK_DATA_ID, PLPROTOBUF_C_TYPE_BYTES, &binary);
+
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_STACK_MEMORY_CHUNKS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_STACK_MEMORY_CHUNK_OFFSET_ID, PLPROTOBUF_C_TYPE_UINT64, &chunk_offset);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_STACK_MEMORY_CHUNK_DATA_ID, PLPROTOBUF_C_TYPE_BYTES, &binary);
+
+        offset += chunk_length;
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Copy and write the stack memory of @a thread, beginning at its stack pointer. Memory is read a page at a time,
+ * and the copy stops at the first page that can not be read, or once @a budget bytes have been copied.
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param thread The thread to capture.
+ * @param thread_number The thread's index number.
+ * @param thread_state The thread's state, or NULL to fetch the state of @a thread.
+ * @param budget The maximum number of bytes to copy.
+ *
+ * @return Returns the number of bytes copied.
+ */
+static size_t plcrash_writer_capture_stack_memory (plcrash_async_file_t *file,
+                                                   plcrash_log_writer_t *writer,
+                                                   thread_t thread,
+                                                   uint32_t thread_number,
+                                                   plcrash_async_thread_state_t *thread_state,
+                                                   size_t budget)
+{
+    plcrash_async_thread_state_t state;
+
+    /* Only the stack pointer is required */
+    if (thread_state == NULL) {
+        if (plcrash_async_thread_state_mach_thread_gpr_init(&state, thread) != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("Could not fetch the thread state of thread %" PRIu32, thread_number);
+            return 0;
+        }
+        thread_state = &state;
+    }
+
+    pl_vm_address_t sp = (pl_vm_address_t) plcrash_async_thread_state_get_reg(thread_state, PLCRASH_REG_SP);
+    size_t copied = 0;
+
+    /* Read up to each page boundary in turn, stopping at the first unmapped page */
+    while (copied < budget) {
+        pl_vm_address_t addr = sp + copied;
+        size_t len = MIN(budget - copied, vm_page_size - (addr & (vm_page_size - 1)));
+
+        if (plcrash_async_task_memcpy(writer->task, addr, 0, writer->stack_memory_buffer + copied, len) != PLCRASH_ESUCCESS)
+            break;
+
+        copied += len;
+    }
+
+    if (copied == 0)
+        return 0;
+
+    uint32_t size = (uint32_t) plcrash_writer_write_stack_memory(NULL, thread_number, sp, writer->stack_memory_buffer, copied);
+    plcrash_writer_pack(file, PLCRASH_PROTO_STACK_MEMORY_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    plcrash_writer_write_stack_memory(file, thread_number, sp, writer->stack_memory_buffer, copied);
+
+    return copied;
+}
+
+/**
+ * @internal
+ *
+ * Write the stack memory of the crashed thread and, if @a threads_suspended, of up to the writer's configured
+ * number of additional threads. Threads are numbered as in the report's thread list. The memory written is bounded
+ * by the writer's stack memory size, and by the file's remaining output limit.
+ *
+ * @param file Output file
+ * @param writer Writer instance.
+ * @param capture_pool The capture pool, or NULL.
+ * @param job The capture job describing the report's threads.
+ * @param threads_suspended If true, the report's threads are still suspended.
+ */
+static void plcrash_writer_write_stack_memory_section (plcrash_async_file_t *file,
+                                                       plcrash_log_writer_t *writer,
+                                                       plcrash_log_writer_capture_pool_t *capture_pool,
+                                                       plcrash_log_writer_capture_job_t *job,
+                                                       bool threads_suspended)
+{
+    if (writer->stack_memory_buffer == NULL)
+        return;
+
+    uint32_t thread_number = 0;
+    uint32_t other_count = 0;
+    for (mach_msg_type_number_t i = 0; i < job->thread_count; i++) {
+        thread_t thread = job->threads[i];
+        bool crashed = (thread == job->crashed_thread);
+
+        if (!plcrash_writer_capture_job_includes_thread(capture_pool, job, i))
+            continue;
+
+        /* Other threads may only be read while they remain suspended */
+        bool capture = crashed || (threads_suspended && other_count < writer->stack_memory_thread_count);
+
+        /* The writer thread can only be read from the supplied state */
+        plcrash_async_thread_state_t *thr_ctx = NULL;
+        if (thread == job->writer_thread) {
+            thr_ctx = job->current_state;
+            if (thr_ctx == NULL)
+                capture = false;
+        } else if (crashed) {
+            thr_ctx = plcrash_writer_crashed_thread_state(writer);
+        }
+
+        if (capture) {
+            size_t budget = plcrash_writer_memory_budget(file, writer->stack_memory_size);
+            if (budget == 0)
+                return;
+
+            if (plcrash_writer_capture_stack_memory(file, writer, thread, thread_number, thr_ctx, budget) > 0 && !crashed)
+                other_count++;
+        }
+
+        thread_number++;
     }
 }
 
 /**
  * @internal
  *
- * Write the system info message.
+ * The number of bytes captured around each register value, centered on the value.
+ */
+#define PLCRASH_WRITER_REGISTER_MEMORY_WINDOW 256
+
+/**
+ * @internal
  *
- * @param file Output file
- * @param timestamp Timestamp to use (seconds since epoch). Must be same across calls, as varint encoding.
+ * The maximum number of register windows captured from a single thread.
  */
-static size_t plcrash_writer_write_system_info (plcrash_async_file_t *file, plcrash_log_writer_t *writer, int64_t timestamp) {
-    size_t rv = 0;
-    uint32_t enumval;
+#define PLCRASH_WRITER_REGISTER_MEMORY_MAX_WINDOWS 64
 
-    /* OS */
-    enumval = PLCrashReportHostOperatingSystem;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_OS_ID, PLPROTOBUF_C_TYPE_ENUM, &enumval);
+/**
+ * @internal
+ *
+ * A range of task memory, [start, end).
+ */
+typedef struct plcrash_writer_memory_range {
+    /** The first address of the range. */
+    pl_vm_address_t start;
 
-    /* OS Version */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_OS_VERSION_ID, PLPROTOBUF_C_TYPE_STRING, writer->system_info.version);
-    
-    /* OS Build */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_OS_BUILD_ID, PLPROTOBUF_C_TYPE_STRING, writer->system_info.build);
+    /** The address immediately following the range. */
+    pl_vm_address_t end;
+} plcrash_writer_memory_range_t;
 
-    /* Machine type */
-    enumval = PLCrashReportHostArchitecture;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_ARCHITECTURE_TYPE_ID, PLPROTOBUF_C_TYPE_ENUM, &enumval);
+/**
+ * @internal
+ *
+ * Clamp @a range to the readable VM region containing @a address.
+ *
+ * @param task The task in which @a address resides.
+ * @param address An address within @a range.
+ * @param range The range to be clamped.
+ *
+ * @return Returns true if @a address falls within a readable region, or false if it is unmapped or unreadable.
+ */
+static bool plcrash_writer_clamp_readable_range (task_t task, pl_vm_address_t address, plcrash_writer_memory_range_t *range) {
+    vm_region_basic_info_data_64_t info;
+    mach_msg_type_number_t count = VM_REGION_BASIC_INFO_COUNT_64;
+    mach_port_t object_name;
+    kern_return_t kt;
+
+#ifdef PL_HAVE_MACH_VM
+    mach_vm_address_t region_addr = address;
+    mach_vm_size_t region_size;
+    kt = mach_vm_region(task, &region_addr, &region_size, VM_REGION_BASIC_INFO_64, (vm_region_info_t) &info, &count, &object_name);
+#else
+    vm_address_t region_addr = address;
+    vm_size_t region_size;
+    kt = vm_region_64(task, &region_addr, &region_size, VM_REGION_BASIC_INFO_64, (vm_region_info_t) &info, &count, &object_name);
+#endif
 
-    /* Timestamp */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_TIMESTAMP_ID, PLPROTOBUF_C_TYPE_INT64, &timestamp);
+    if (kt != KERN_SUCCESS)
+        return false;
 
-    return rv;
+    /* The returned region will be the next mapped region if the address itself is unmapped */
+    if (region_addr > address || (info.protection & VM_PROT_READ) == 0)
+        return false;
+
+    range->start = MAX(range->start, (pl_vm_address_t) region_addr);
+    range->end = MIN(range->end, (pl_vm_address_t) (region_addr + region_size));
+    return true;
 }
 
 /**
  * @internal
  *
- * Write the processor info message.
+ * Write a register memory message.
  *
  * @param file Output file
- * @param cpu_type The Mach CPU type.
- * @param cpu_subtype_t The Mach CPU subtype
+ * @param thread_number The thread's index number.
+ * @param address The address at which the memory was read.
+ * @param data The captured memory.
+ * @param length The length of @a data.
  */
-static size_t plcrash_writer_write_processor_info (plcrash_async_file_t *file, uint64_t cpu_type, uint64_t cpu_subtype) {
+static size_t plcrash_writer_write_register_memory (plcrash_async_file_t *file, uint32_t thread_number, uint64_t address, const uint8_t *data, size_t length) {
+    PLProtobufCBinaryData binary;
     size_t rv = 0;
-    uint32_t enumval;
-    
-    /* Encoding */
-    enumval = PLCrashReportProcessorTypeEncodingMach;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESSOR_ENCODING_ID, PLPROTOBUF_C_TYPE_ENUM, &enumval);
 
-    /* Type */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESSOR_TYPE_ID, PLPROTOBUF_C_TYPE_UINT64, &cpu_type);
+    binary.len = length;
+    binary.data = (uint8_t *) data;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_REGISTER_MEMORY_THREAD_NUMBER_ID, PLPROTOBUF_C_TYPE_UINT32, &thread_number);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_REGISTER_MEMORY_ADDRESS_ID, PLPROTOBUF_C_TYPE_UINT64, &address);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_REGISTER_MEMORY_DATA_ID, PLPROTOBUF_C_TYPE_BYTES, &binary);
 
-    /* Subtype */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESSOR_SUBTYPE_ID, PLPROTOBUF_C_TYPE_UINT64, &cpu_subtype);
-    
     return rv;
 }
 
 /**
  * @internal
  *
- * Write the machine info message.
+ * Write the memory surrounding each register value of the crashed thread that points into readable memory. Windows
+ * are clamped to their containing VM region, and overlapping or adjacent windows are merged before being read, such
+ * that no byte is written more than once. The total memory written is bounded by the writer's register memory
+ * size, and by the file's remaining output limit.
  *
  * @param file Output file
+ * @param writer Writer instance.
+ * @param capture_pool The capture pool, or NULL.
+ * @param job The capture job describing the report's threads.
  */
-static size_t plcrash_writer_write_machine_info (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
-    size_t rv = 0;
-    
-    /* Model */
-    if (writer->machine_info.model != NULL)
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_MODEL_ID, PLPROTOBUF_C_TYPE_STRING, writer->machine_info.model);
+static void plcrash_writer_write_register_memory_section (plcrash_async_file_t *file,
+                                                          plcrash_log_writer_t *writer,
+                                                          plcrash_log_writer_capture_pool_t *capture_pool,
+                                                          plcrash_log_writer_capture_job_t *job)
+{
+    plcrash_async_thread_state_t state;
+    plcrash_async_thread_state_t *thread_state = NULL;
+    uint32_t thread_number = 0;
+    bool found = false;
 
-    /* Processor */
-    {
-        uint32_t size;
+    if (writer->register_memory_buffer == NULL)
+        return;
 
-        /* Determine size */
-        size = plcrash_writer_write_processor_info(NULL, writer->machine_info.cpu_type, writer->machine_info.cpu_subtype);
+    /* Find the crashed thread's number */
+    for (mach_msg_type_number_t i = 0; i < job->thread_count; i++) {
+        thread_t thread = job->threads[i];
 
-        /* Write message */
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_PROCESSOR_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        rv += plcrash_writer_write_processor_info(file, writer->machine_info.cpu_type, writer->machine_info.cpu_subtype);
+        if (!plcrash_writer_capture_job_includes_thread(capture_pool, job, i))
+            continue;
+
+        if (thread == job->crashed_thread) {
+            found = true;
+            break;
+        }
+
+        thread_number++;
     }
 
-    /* Physical Processor Count */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_PROCESSOR_COUNT_ID, PLPROTOBUF_C_TYPE_UINT32, &writer->machine_info.processor_count);
-    
-    /* Logical Processor Count */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_LOGICAL_PROCESSOR_COUNT_ID, PLPROTOBUF_C_TYPE_UINT32, &writer->machine_info.logical_processor_count);
-    
-    return rv;
+    if (!found)
+        return;
+
+    /* The writer thread can only be read from the supplied state */
+    if (job->crashed_thread == job->writer_thread) {
+        thread_state = job->current_state;
+    } else if ((thread_state = plcrash_writer_crashed_thread_state(writer)) != NULL) {
+        /* Supplied by the crash handler */
+    } else if (plcrash_async_thread_state_mach_thread_init(&state, job->crashed_thread) == PLCRASH_ESUCCESS) {
+        thread_state = &state;
+    }
+
+    if (thread_state == NULL)
+        return;
+
+    /* Collect the readable windows, sorted by start address */
+    plcrash_writer_memory_range_t ranges[PLCRASH_WRITER_REGISTER_MEMORY_MAX_WINDOWS];
+    size_t range_count = 0;
+
+    size_t reg_count = MIN(plcrash_async_thread_state_get_reg_count(thread_state), (size_t) PLCRASH_WRITER_REGISTER_MEMORY_MAX_WINDOWS);
+    for (size_t i = 0; i < reg_count; i++) {
+        if (!plcrash_async_thread_state_has_reg(thread_state, (plcrash_regnum_t) i))
+            continue;
+
+        pl_vm_address_t value = (pl_vm_address_t) plcrash_async_thread_state_get_reg(thread_state, (plcrash_regnum_t) i);
+        plcrash_writer_memory_range_t range;
+        range.start = value - MIN(value, (pl_vm_address_t) (PLCRASH_WRITER_REGISTER_MEMORY_WINDOW / 2));
+        range.end = value + MIN(PL_VM_ADDRESS_MAX - value, (pl_vm_address_t) (PLCRASH_WRITER_REGISTER_MEMORY_WINDOW / 2));
+
+        if (!plcrash_writer_clamp_readable_range(writer->task, value, &range) || range.end <= range.start)
+            continue;
+
+        size_t pos = range_count;
+        while (pos > 0 && ranges[pos - 1].start > range.start) {
+            ranges[pos] = ranges[pos - 1];
+            pos--;
+        }
+        ranges[pos] = range;
+        range_count++;
+    }
+
+    /* Merge overlapping and adjacent windows */
+    size_t merged_count = 0;
+    for (size_t i = 0; i < range_count; i++) {
+        if (merged_count > 0 && ranges[i].start <= ranges[merged_count - 1].end) {
+            ranges[merged_count - 1].end = MAX(ranges[merged_count - 1].end, ranges[i].end);
+            continue;
+        }
+
+        ranges[merged_count++] = ranges[i];
+    }
+
+    /* Read and write each window, up to the total budget */
+    size_t budget = plcrash_writer_memory_budget(file, writer->register_memory_size);
+    size_t used = 0;
+    for (size_t i = 0; i < merged_count && used < budget; i++) {
+        size_t length = MIN((size_t) (ranges[i].end - ranges[i].start), budget - used);
+        uint8_t *data = writer->register_memory_buffer + used;
+
+        if (plcrash_async_task_memcpy(writer->task, ranges[i].start, 0, data, length) != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("Could not read register memory at 0x%" PRIx64, (uint64_t) ranges[i].start);
+            continue;
+        }
+
+        uint32_t size = (uint32_t) plcrash_writer_write_register_memory(NULL, thread_number, ranges[i].start, data, length);
+        plcrash_writer_pack(file, PLCRASH_PROTO_REGISTER_MEMORY_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_register_memory(file, thread_number, ranges[i].start, data, length);
+
+        used += length;
+    }
 }
 
 /**
  * @internal
  *
- * Write the app info message.
+ * Write a VM region summary message.
  *
  * @param file Output file
- * @param app_identifier Application identifier
- * @param app_version Application version
+ * @param data The encoded region table.
+ * @param length The length of @a data.
+ * @param region_count The number of regions encoded in @a data.
+ * @param truncated If true, region enumeration stopped early.
  */
-static size_t plcrash_writer_write_app_info (plcrash_async_file_t *file, const char *app_identifier, const char *app_version) {
+static size_t plcrash_writer_write_vm_region_summary (plcrash_async_file_t *file, const uint8_t *data, size_t length, uint32_t region_count, bool truncated) {
+    PLProtobufCBinaryData binary;
     size_t rv = 0;
 
-    /* App identifier */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_APP_INFO_APP_IDENTIFIER_ID, PLPROTOBUF_C_TYPE_STRING, app_identifier);
-    
-    /* App version */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_APP_INFO_APP_VERSION_ID, PLPROTOBUF_C_TYPE_STRING, app_version);
-    
+    binary.len = length;
+    binary.data = (uint8_t *) data;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_VM_REGION_SUMMARY_REGIONS_ID, PLPROTOBUF_C_TYPE_BYTES, &binary);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_VM_REGION_SUMMARY_REGION_COUNT_ID, PLPROTOBUF_C_TYPE_UINT32, &region_count);
+    if (truncated)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_VM_REGION_SUMMARY_TRUNCATED_ID, PLPROTOBUF_C_TYPE_BOOL, &truncated);
+
     return rv;
 }
 
 /**
  * @internal
  *
- * Write the process info message.
+ * Enumerate the target task's VM regions into the writer's preallocated region table, coalescing adjacent regions
+ * with identical attributes, and write the resulting VM region summary. Enumeration is bounded by the writer's region
+ * count and time limits, and the encoded table by the file's remaining output limit.
  *
  * @param file Output file
- * @param process_name Process name
- * @param process_id Process ID
- * @param process_path Process path
- * @param parent_process_name Parent process name
- * @param parent_process_id Parent process ID
- * @param native If false, process is running under emulation.
- * @param start_time The start time of the process.
+ * @param writer Writer instance.
  */
-static size_t plcrash_writer_write_process_info (plcrash_async_file_t *file, const char *process_name,
-                                                 const pid_t process_id, const char *process_path, 
-                                                 const char *parent_process_name, const pid_t parent_process_id,
-                                                 bool native, time_t start_time)
-{
-    size_t rv = 0;
-    uint64_t tval;
+static void plcrash_writer_write_vm_region_summary_section (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
+    plcrash_log_writer_vm_region_t *regions = writer->vm_regions;
+    uint32_t count = 0;
+    bool truncated = false;
+    natural_t depth = 0;
+    kern_return_t kt;
 
-    /*
-     * In the current crash reporter serialization format, pid values are serialized as unsigned 32-bit integers. This
-     * conforms with the actual implementation of pid_t on both 32-bit and 64-bit Darwin systems. To conform with
-     * SuSV3, however, the values should be encoded as signed integers; the actual width of the type being implementation
-     * defined.
-     *
-     * To maintain compatibility with existing report readers the values remain encoded as unsigned 32-bit integers,
-     * but should be updated to int64 values in future major revision of the data format.
-     */
-    uint32_t pidval;
+    if (regions == NULL)
+        return;
 
-    /* Process name */
-    if (process_name != NULL)
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PROCESS_NAME_ID, PLPROTOBUF_C_TYPE_STRING, process_name);
+    uint64_t deadline = (writer->vm_region_time_limit != 0) ? mach_absolute_time() + writer->vm_region_time_limit : 0;
 
-    /* Process ID */
-    pidval = process_id;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PROCESS_ID_ID, PLPROTOBUF_C_TYPE_UINT32, &pidval);
+#ifdef PL_HAVE_MACH_VM
+    mach_vm_address_t address = 0;
+    mach_vm_size_t size;
+#else
+    vm_address_t address = 0;
+    vm_size_t size;
+#endif
 
-    /* Process path */
-    if (process_path != NULL)
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PROCESS_PATH_ID, PLPROTOBUF_C_TYPE_STRING, process_path);
-    
-    /* Parent process name */
-    if (parent_process_name != NULL)
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PARENT_PROCESS_NAME_ID, PLPROTOBUF_C_TYPE_STRING, parent_process_name);
-    
+    while (true) {
+        vm_region_submap_short_info_data_64_t info;
+        mach_msg_type_number_t info_count = VM_REGION_SUBMAP_SHORT_INFO_COUNT_64;
 
-    /* Parent process ID */
-    pidval = parent_process_id;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_PARENT_PROCESS_ID_ID, PLPROTOBUF_C_TYPE_UINT32, &pidval);
+#ifdef PL_HAVE_MACH_VM
+        kt = mach_vm_region_recurse(writer->task, &address, &size, &depth, (vm_region_recurse_info_t) &info, &info_count);
+#else
+        kt = vm_region_recurse_64(writer->task, &address, &size, &depth, (vm_region_recurse_info_64_t) &info, &info_count);
+#endif
 
-    /* Native process. */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_NATIVE_ID, PLPROTOBUF_C_TYPE_BOOL, &native);
-    
-    /* Start time */
-    tval = start_time;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_START_TIME_ID, PLPROTOBUF_C_TYPE_UINT64, &tval);
+        /* KERN_INVALID_ADDRESS is returned once the end of the address space has been reached */
+        if (kt != KERN_SUCCESS)
+            break;
 
-    return rv;
+        /* Descend into submaps, such as the shared region, to report their constituent regions */
+        if (info.is_submap) {
+            depth++;
+            continue;
+        }
+
+        uint32_t protection = (uint32_t) ((info.max_protection << 4) | info.protection);
+        plcrash_log_writer_vm_region_t *prev = (count > 0) ? &regions[count - 1] : NULL;
+        if (prev != NULL && prev->address + prev->size == address && prev->protection == protection &&
+            prev->user_tag == info.user_tag && prev->share_mode == info.share_mode)
+        {
+            prev->size += size;
+        } else if (count == writer->vm_region_max) {
+            truncated = true;
+            break;
+        } else {
+            regions[count].address = address;
+            regions[count].size = size;
+            regions[count].protection = protection;
+            regions[count].user_tag = info.user_tag;
+            regions[count].share_mode = info.share_mode;
+            count++;
+        }
+
+        /* Terminate at the top of the address space */
+        if (address + size <= address)
+            break;
+        address += size;
+
+        if (deadline != 0 && mach_absolute_time() >= deadline) {
+            truncated = true;
+            break;
+        }
+    }
+
+    /* Encode the table, up to the remaining output limit */
+    size_t budget = plcrash_writer_memory_budget(file, PLCRASH_WRITER_VM_REGION_ENCODED_MAX * (size_t) count);
+    uint8_t *buffer = writer->vm_region_buffer;
+    size_t length = 0;
+    uint32_t written = 0;
+    uint64_t prev_end = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        plcrash_log_writer_vm_region_t *region = &regions[i];
+        uint64_t values[] = { region->address - prev_end, region->size, region->protection, region->user_tag, region->share_mode };
+
+        size_t entry_length = 0;
+        for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); v++)
+            entry_length += plcrash_writer_pack_uint64_element(NULL, values[v]);
+
+        if (length + entry_length > budget) {
+            truncated = true;
+            break;
+        }
+
+        for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); v++)
+            length += plcrash_writer_pack_uint64_element(buffer + length, values[v]);
+
+        prev_end = region->address + region->size;
+        written++;
+    }
+
+    if (written == 0)
+        return;
+
+    uint32_t msg_size = (uint32_t) plcrash_writer_write_vm_region_summary(NULL, buffer, length, written, truncated);
+    plcrash_writer_pack(file, PLCRASH_PROTO_VM_REGION_SUMMARY_ID, PLPROTOBUF_C_TYPE_MESSAGE, &msg_size);
+    plcrash_writer_write_vm_region_summary(file, buffer, length, written, truncated);
 }
 
 /**
  * @internal
  *
- * Write a thread backtrace register
+ * The number of output bytes reserved for the sections written after all threads and images, when prioritizing
+ * output. The space required by the report's symbol names is reserved separately.
+ */
+#define PLCRASH_WRITER_TRAILER_RESERVE (8 * 1024)
+
+/**
+ * @internal
+ *
+ * The maximum number of images recorded as required to symbolicate the crashed thread.
+ */
+#define PLCRASH_WRITER_PRIORITY_IMAGE_MAX 32
+
+/**
+ * @internal
+ *
+ * Return the number of bytes that may be written to @a file while leaving @a reserve bytes, and the space required
+ * by the report's trailing sections, available within the file's output limit.
  *
  * @param file Output file
- * @param cursor The cursor from which to acquire frame data.
+ * @param writer Writer instance.
+ * @param reserve The number of bytes to be reserved for later, higher-priority sections.
  */
-static size_t plcrash_writer_write_thread_register (plcrash_async_file_t *file, const char *regname, plcrash_greg_t regval) {
-    uint64_t uint64val;
-    size_t rv = 0;
+static size_t plcrash_writer_output_budget (plcrash_async_file_t *file, plcrash_log_writer_t *writer, size_t reserve) {
+    if (file->limit_bytes == 0)
+        return SIZE_MAX;
 
-    /* Write the name */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_NAME_ID, PLPROTOBUF_C_TYPE_STRING, regname);
+    /* Each name is written with a field header of at most four bytes */
+    off_t trailer = PLCRASH_WRITER_TRAILER_RESERVE;
+    if (writer->symbol_table != NULL)
+        trailer += writer->symbol_table->pool_used + (off_t) writer->symbol_table->count * 4;
 
-    /* Write the value */
-    uint64val = regval;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_VALUE_ID, PLPROTOBUF_C_TYPE_UINT64, &uint64val);
-    
-    return rv;
+    off_t remaining = file->limit_bytes - file->total_bytes - trailer - (off_t) reserve;
+    if (remaining <= 0)
+        return 0;
+
+    return (size_t) remaining;
 }
 
 /**
  * @internal
  *
- * Write all thread backtrace register messages
+ * Return the size of @a image's binary image message, including the message's field header.
+ *
+ * @param image The image to be sized.
+ */
+static size_t plcrash_writer_image_message_size (plcrash_async_image_t *image) {
+    if (image->_encoded != NULL)
+        return image->_encoded_length;
+
+    plcrash_writer_binary_image_message_t storage;
+    plcrash_writer_message_t *message = plcrash_writer_binary_image_message_init(&storage, &image->macho_image);
+    return plcrash_writer_pack_embedded_message(NULL, PLCRASH_PROTO_BINARY_IMAGES_ID, message);
+}
+
+/**
+ * @internal
+ *
+ * Write a binary image message, including the message's field header, using the image's pre-encoded message if
+ * available.
  *
  * @param file Output file
- * @param task The task from which @a uap was derived. All memory accesses will be mapped from this task.
- * @param cursor The cursor from which to acquire frame registers.
+ * @param image The image to be written.
+ * @param max_size The maximum number of bytes that may be written, or SIZE_MAX if unbounded.
+ *
+ * @return Returns true if the message was written, or false if it was larger than @a max_size.
  */
-static size_t plcrash_writer_write_thread_registers (plcrash_async_file_t *file, task_t task, plframe_cursor_t *cursor) {
-    plframe_error_t frame_err;
-    uint32_t regCount = plframe_cursor_get_regcount(cursor);
-    size_t rv = 0;
-    
-    /* Write out register messages */
-    for (int i = 0; i < regCount; i++) {
-        plcrash_greg_t regVal;
-        const char *regname;
-        uint32_t msgsize;
+static bool plcrash_writer_write_image_message (plcrash_async_file_t *file, plcrash_async_image_t *image, size_t max_size) {
+    /* Use the pre-encoded message, if available */
+    void *encoded = image->_encoded;
+    if (encoded != NULL) {
+        if (image->_encoded_length > max_size)
+            return false;
+
+        plcrash_async_file_write(file, encoded, image->_encoded_length);
+        return true;
+    }
 
-        /* Fetch the register value */
-        if ((frame_err = plframe_cursor_get_reg(cursor, i, &regVal)) != PLFRAME_ESUCCESS) {
-            // Should never happen
-            PLCF_DEBUG("Could not fetch register %i value: %s", i, plframe_strerror(frame_err));
-            regVal = 0;
-        }
+    /* Calculate the message size; this is cached, and reused when writing the message's length prefix */
+    plcrash_writer_binary_image_message_t storage;
+    plcrash_writer_message_t *message = plcrash_writer_binary_image_message_init(&storage, &image->macho_image);
+    if (plcrash_writer_pack_embedded_message(NULL, PLCRASH_PROTO_BINARY_IMAGES_ID, message) > max_size)
+        return false;
 
-        /* Fetch the register name */
-        regname = plframe_cursor_get_regname(cursor, i);
+    plcrash_writer_pack_embedded_message(file, PLCRASH_PROTO_BINARY_IMAGES_ID, message);
+    return true;
+}
 
-        /* Get the register message size */
-        msgsize = plcrash_writer_write_thread_register(NULL, regname, regVal);
-        
-        /* Write the header and message */
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTERS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &msgsize);
-        rv += plcrash_writer_write_thread_register(file, regname, regVal);
+/**
+ * @internal
+ *
+ * Return true if @a image's header address is one of the @a count entries in @a images.
+ */
+static bool plcrash_writer_contains_image (const pl_vm_address_t *images, size_t count, plcrash_async_image_t *image) {
+    for (size_t i = 0; i < count; i++) {
+        if (images[i] == image->macho_image.header_addr)
+            return true;
     }
-    
-    return rv;
+
+    return false;
 }
 
 /**
  * @internal
  *
- * Write a symbol
+ * Return true if @a image is listed in @a manifest.
  *
- * @param file Output file
- * @param name The symbol name
- * @param start_address The symbol start address
+ * @param manifest The image manifest, or NULL.
+ * @param image The image to look up.
  */
-static size_t plcrash_writer_write_symbol (plcrash_async_file_t *file, const char *name, uint64_t start_address) {
-    size_t rv = 0;
-    
-    /* name */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYMBOL_NAME, PLPROTOBUF_C_TYPE_STRING, name);
-    
-    /* start_address */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYMBOL_START_ADDRESS, PLPROTOBUF_C_TYPE_UINT64, &start_address);
-    
-    return rv;
+static bool plcrash_writer_manifest_contains (plcrash_log_writer_image_manifest_t *manifest, plcrash_async_image_t *image) {
+    if (manifest == NULL)
+        return false;
+
+    pl_vm_address_t header = image->macho_image.header_addr;
+    size_t low = 0;
+    size_t high = manifest->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (manifest->headers[mid] < header) {
+            low = mid + 1;
+        } else if (manifest->headers[mid] > header) {
+            high = mid;
+        } else {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 /**
  * @internal
- * Symbol lookup callback context
+ *
+ * Record the header addresses of the images listed in @a manifest that are no longer registered with @a image_list.
+ *
+ * @param manifest The image manifest.
+ * @param image_list The current list of loaded binary images.
+ * @param removed On return, the header addresses of the removed images.
+ * @param removed_count On return, the number of entries in @a removed.
+ *
+ * @return Returns true on success, or false if more than PLCRASH_LOG_WRITER_MANIFEST_REMOVED_MAX of the manifest's images
+ * have been removed.
  */
-struct pl_symbol_cb_ctx {
-    /** File to use for writing out a symbol entry. May be NULL. */
-    plcrash_async_file_t *file;
+static bool plcrash_writer_manifest_find_removed (plcrash_log_writer_image_manifest_t *manifest,
+                                                  plcrash_async_image_list_t *image_list,
+                                                  pl_vm_address_t removed[PLCRASH_LOG_WRITER_MANIFEST_REMOVED_MAX],
+                                                  size_t *removed_count)
+{
+    bool result = true;
+    *removed_count = 0;
+
+    plcrash_async_image_list_set_reading(image_list, true);
+    for (size_t i = 0; i < manifest->count; i++) {
+        plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, manifest->headers[i]);
+        if (image != NULL && image->macho_image.header_addr == manifest->headers[i])
+            continue;
+
+        if (*removed_count == PLCRASH_LOG_WRITER_MANIFEST_REMOVED_MAX) {
+            result = false;
+            break;
+        }
 
-    /** Size of the symbol entry, to be written by the callback function upon writing an entry. */
-    uint32_t msgsize;
-};
+        removed[(*removed_count)++] = manifest->headers[i];
+    }
+    plcrash_async_image_list_set_reading(image_list, false);
+
+    return result;
+}
 
 /**
  * @internal
  *
- * pl_async_macho_found_symbol_cb callback implementation. Writes the result to the file available via @a ctx,
- * which must be a valid pl_symbol_cb_ctx structure.
+ * Write the image manifest reference message.
+ *
+ * @param file Output file
+ * @param manifest The referenced manifest.
+ * @param removed The header addresses of the manifest's images that are no longer loaded.
+ * @param removed_count The number of entries in @a removed.
  */
-static void plcrash_writer_write_thread_frame_symbol_cb (pl_vm_address_t address, const char *name, void *ctx) {
-    struct pl_symbol_cb_ctx *cb_ctx = ctx;
-    cb_ctx->msgsize = plcrash_writer_write_symbol(cb_ctx->file, name, address);
+static size_t plcrash_writer_write_image_manifest_reference (plcrash_async_file_t *file,
+                                                             plcrash_log_writer_image_manifest_t *manifest,
+                                                             const pl_vm_address_t *removed,
+                                                             size_t removed_count)
+{
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_IMAGE_MANIFEST_IDENTIFIER_ID, PLPROTOBUF_C_TYPE_UINT64, &manifest->identifier);
+    for (size_t i = 0; i < removed_count; i++) {
+        uint64_t addr = removed[i];
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_IMAGE_MANIFEST_REMOVED_IMAGES_ID, PLPROTOBUF_C_TYPE_UINT64, &addr);
+    }
+
+    return rv;
 }
 
 /**
  * @internal
  *
- * Write a thread backtrace frame
+ * Record the header addresses of the images containing the frame PCs of @a buffer.
  *
- * @param file Output file
- * @param pcval The frame PC value.
+ * @param buffer The captured thread data.
+ * @param image_list The Mach-O image list.
+ * @param images On return, the header addresses of up to @a max_images unique images.
+ * @param max_images The maximum number of images to record.
+ *
+ * @return Returns the number of images recorded.
  */
-static size_t plcrash_writer_write_thread_frame (plcrash_async_file_t *file, plcrash_log_writer_t *writer, uint64_t pcval, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext) {
-    size_t rv = 0;
+static size_t plcrash_writer_find_frame_images (plcrash_log_writer_thread_buffer_t *buffer,
+                                                plcrash_async_image_list_t *image_list,
+                                                pl_vm_address_t *images,
+                                                size_t max_images)
+{
+    size_t count = 0;
 
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_PC_ID, PLPROTOBUF_C_TYPE_UINT64, &pcval);
-    
     plcrash_async_image_list_set_reading(image_list, true);
-    plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, (pl_vm_address_t) pcval);
-    
-    if (image != NULL && writer->symbol_strategy != PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE) {
-        struct pl_symbol_cb_ctx ctx;
-        plcrash_error_t ret;
-        
-        /* Get the symbol message size. If the symbol can not be found, our callback will not be called. If the symbol is found,
-         * our callback is called and PLCRASH_ESUCCESS is returned. */
-        ctx.file = NULL;
-        ctx.msgsize = 0x0;
-        ret = plcrash_async_find_symbol(&image->macho_image, writer->symbol_strategy, findContext, (pl_vm_address_t) pcval, plcrash_writer_write_thread_frame_symbol_cb, &ctx);
-        if (ret == PLCRASH_ESUCCESS) {
-            /* Write the header and message */
-            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_SYMBOL_ID, PLPROTOBUF_C_TYPE_MESSAGE, &ctx.msgsize);
+    for (uint32_t i = 0; i < buffer->frame_count && count < max_images; i++) {
+        plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, (pl_vm_address_t) buffer->frames[i].pc);
+        if (image == NULL || plcrash_writer_contains_image(images, count, image))
+            continue;
 
-            ctx.file = file;
-            ret = plcrash_async_find_symbol(&image->macho_image, writer->symbol_strategy, findContext, (pl_vm_address_t) pcval, plcrash_writer_write_thread_frame_symbol_cb, &ctx);
-            if (ret == PLCRASH_ESUCCESS) {
-                rv += ctx.msgsize;
-            } else {
-                /* This should not happen, but it would be very confusing if it did and nothing was logged. */
-                PLCF_DEBUG("Fetching the symbol unexpectedly failed during the second call");
-            }
-        }
+        images[count++] = image->macho_image.header_addr;
     }
-
     plcrash_async_image_list_set_reading(image_list, false);
 
-
-    return rv;
+    return count;
 }
 
 /**
  * @internal
  *
- * Write an exception userInfo entry
+ * Write the truncation message, recording the sections omitted to fit the file's output limit.
  *
  * @param file Output file
- * @param userInfo The userInfo dictionary entry.
+ * @param elided_thread_count The number of threads omitted.
+ * @param elided_image_count The number of binary images omitted.
+ * @param deadline_expired If true, the report's deadline expired, and its later sections were written with reduced detail.
  */
-static size_t plcrash_writer_write_user_info_pair (plcrash_async_file_t *file, user_info_t userInfo) {
+static size_t plcrash_writer_write_truncation_info (plcrash_async_file_t *file, uint32_t elided_thread_count, uint32_t elided_image_count, bool deadline_expired) {
     size_t rv = 0;
 
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_USERINFO_KEY_ID, PLPROTOBUF_C_TYPE_STRING, userInfo.key);
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_USERINFO_SERIALIZED_ID, PLPROTOBUF_C_TYPE_STRING, userInfo.serialized);
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_USERINFO_ARCHIVE_ID, PLPROTOBUF_C_TYPE_BOOL, &userInfo.archive);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_TRUNCATION_ELIDED_THREAD_COUNT_ID, PLPROTOBUF_C_TYPE_UINT32, &elided_thread_count);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_TRUNCATION_ELIDED_IMAGE_COUNT_ID, PLPROTOBUF_C_TYPE_UINT32, &elided_image_count);
+    if (deadline_expired)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_TRUNCATION_DEADLINE_EXPIRED_ID, PLPROTOBUF_C_TYPE_BOOL, &deadline_expired);
 
     return rv;
 }
@@ -950,307 +5886,382 @@ static size_t plcrash_writer_write_user_info_pair (plcrash_async_file_t *file, u
 /**
  * @internal
  *
- * Write a thread message
+ * Write the integrity message, recording the length and checksum of all data previously written to @a file. As the
+ * message covers all preceding output, it must be the last message written.
  *
  * @param file Output file
- * @param task The task in which @a thread is executing.
- * @param thread Thread for which we'll output data.
- * @param thread_number The thread's index number.
- * @param thread_ctx Thread state to use for stack walking. If NULL, the thread state will be fetched from @a thread. If
- * @a thread is the currently executing thread, <em>must</em> be non-NULL.
- * @param image_list The Mach-O image list.
- * @param findContext Symbol lookup cache.
- * @param crashed If true, mark this as a crashed thread.
  */
-static size_t plcrash_writer_write_thread (plcrash_async_file_t *file,
-                                           plcrash_log_writer_t *writer,
-                                           task_t task,
-                                           thread_t thread,
-                                           uint32_t thread_number,
-                                           plcrash_async_thread_state_t *thread_ctx,
-                                           plcrash_async_image_list_t *image_list,
-                                           plcrash_async_symbol_cache_t *findContext,
-                                           bool crashed)
-{
-    size_t rv = 0;
-    plframe_cursor_t cursor;
-    plframe_error_t ferr;
+static void plcrash_writer_write_integrity (plcrash_async_file_t *file) {
+    uint64_t length = file->checksum.length;
+    uint64_t checksum = plcrash_async_checksum_value(&file->checksum);
+    uint32_t size = 0;
 
-    /* A context must be supplied when walking the current thread */
-    PLCF_ASSERT(task != mach_task_self() || thread_ctx != NULL || thread != pl_mach_thread_self());
+    size += plcrash_writer_pack(NULL, PLCRASH_PROTO_INTEGRITY_LENGTH_ID, PLPROTOBUF_C_TYPE_FIXED64, &length);
+    size += plcrash_writer_pack(NULL, PLCRASH_PROTO_INTEGRITY_CHECKSUM_ID, PLPROTOBUF_C_TYPE_FIXED64, &checksum);
 
-    /* Write the required elements first; fatal errors may occur below, in which case we need to have
-     * written out required elements before returning. */
-    {
-        /* Write the thread ID */
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_THREAD_NUMBER_ID, PLPROTOBUF_C_TYPE_UINT32, &thread_number);
+    plcrash_writer_pack(file, PLCRASH_PROTO_INTEGRITY_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    plcrash_writer_pack(file, PLCRASH_PROTO_INTEGRITY_LENGTH_ID, PLPROTOBUF_C_TYPE_FIXED64, &length);
+    plcrash_writer_pack(file, PLCRASH_PROTO_INTEGRITY_CHECKSUM_ID, PLPROTOBUF_C_TYPE_FIXED64, &checksum);
+}
 
-        /* Note crashed status */
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_CRASHED_ID, PLPROTOBUF_C_TYPE_BOOL, &crashed);
+/**
+ * @internal
+ *
+ * Populate @a info from the metrics recorded since @a start was taken.
+ *
+ * @param writer Writer instance.
+ * @param start The metrics snapshot taken when the report was started.
+ * @param suspend_time The measured thread suspension time, in nanoseconds.
+ * @param image_write_time The measured binary image write time, in mach_absolute_time() units.
+ * @param info The measurements to be populated.
+ */
+static void plcrash_writer_collect_instrumentation (plcrash_log_writer_t *writer,
+                                                    const plcrash_async_metrics_t *start,
+                                                    uint64_t suspend_time,
+                                                    uint64_t image_write_time,
+                                                    plcrash_log_writer_instrumentation_t *info)
+{
+    plcrash_async_metrics_t end;
+    plcrash_async_metrics_snapshot(&end);
+
+    uint64_t delta[PLCRASH_ASYNC_METRIC_COUNT];
+    for (int i = 0; i < PLCRASH_ASYNC_METRIC_COUNT; i++)
+        delta[i] = end.values[i] - start->values[i];
+
+    info->thread_suspend_time = suspend_time;
+    info->unwind_time = plcrash_async_metrics_to_ns(delta[PLCRASH_ASYNC_METRIC_UNWIND_TIME]);
+    info->symtab_lookup_time = plcrash_async_metrics_to_ns(delta[PLCRASH_ASYNC_METRIC_SYMTAB_TIME]);
+    info->objc_lookup_time = plcrash_async_metrics_to_ns(delta[PLCRASH_ASYNC_METRIC_OBJC_TIME]);
+    info->image_write_time = plcrash_async_metrics_to_ns(image_write_time);
+    info->output_time = plcrash_async_metrics_to_ns(delta[PLCRASH_ASYNC_METRIC_OUTPUT_TIME]);
+    info->output_count = delta[PLCRASH_ASYNC_METRIC_OUTPUT_COUNT];
+    info->mobject_count = delta[PLCRASH_ASYNC_METRIC_MOBJECT_COUNT];
+    info->vm_read_count = delta[PLCRASH_ASYNC_METRIC_VM_READ_COUNT];
+
+    /* Allocator usage */
+    info->allocator_high_water_mark = 0;
+    if (writer->allocator != NULL) {
+        plcrash_async_allocator_stats_t stats;
+        plcrash_async_allocator_stats(writer->allocator, &stats);
+        info->allocator_high_water_mark += stats.high_water_mark;
     }
 
+    if (writer->capture_pool != NULL) {
+        plcrash_async_allocator_stats_t stats;
+        plcrash_async_allocator_stats(writer->capture_pool->allocator, &stats);
+        info->allocator_high_water_mark += stats.high_water_mark;
+    }
 
-    /* Write out the stack frames. */
-    {
-        /* Set up the frame cursor. */
-        {            
-            /* Use the provided context if available, otherwise initialize a new thread context
-             * from the target thread's state. */
-            plcrash_async_thread_state_t cursor_thr_state;
-            if (thread_ctx) {
-                cursor_thr_state = *thread_ctx;
-            } else {
-                plcrash_async_thread_state_mach_thread_init(&cursor_thr_state, thread);
-            }
-
-            /* Initialize the cursor */
-            ferr = plframe_cursor_init(&cursor, task, &cursor_thr_state, image_list);
-            if (ferr != PLFRAME_ESUCCESS) {
-                PLCF_DEBUG("An error occured initializing the frame cursor: %s", plframe_strerror(ferr));
-                return rv;
-            }
-        }
-
-        /* Walk the stack, limiting the total number of frames that are output. */
-        uint32_t frame_count = 0;
-        while ((ferr = plframe_cursor_next(&cursor)) == PLFRAME_ESUCCESS && frame_count < MAX_THREAD_FRAMES) {
-            uint32_t frame_size;
-            
-            /* On the first frame, dump registers for the crashed thread */
-            if (frame_count == 0 && crashed) {
-                rv += plcrash_writer_write_thread_registers(file, task, &cursor);
-            }
-
-            /* Fetch the PC value */
-            plcrash_greg_t pc = 0;
-            if ((ferr = plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &pc)) != PLFRAME_ESUCCESS) {
-                PLCF_DEBUG("Could not retrieve frame PC register: %s", plframe_strerror(ferr));
-                break;
-            }
+    /* Signal stack usage. This is measured last, after the report's deepest call paths have run. */
+    info->signal_stack_size = plcrash_signal_handler_stack_size();
+    info->signal_stack_high_water_mark = plcrash_signal_handler_stack_high_water_mark();
+}
 
-            /* Determine the size */
-            frame_size = plcrash_writer_write_thread_frame(NULL, writer, pc, image_list, findContext);
-            
-            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
-            rv += plcrash_writer_write_thread_frame(file, writer, pc, image_list, findContext);
-            frame_count++;
-        }
+/**
+ * @internal
+ *
+ * Fetch the registered threads of the current task into the writer's preallocated thread list, taking a send right
+ * to each. Fails if the registry may be incomplete, or if @a crashed_thread is not registered.
+ */
+static bool plcrash_writer_fetch_registry_threads (plcrash_log_writer_t *writer, thread_t crashed_thread, thread_act_array_t *threads, mach_msg_type_number_t *thread_count) {
+    plcrash_async_thread_registry_t *registry = writer->thread_registry;
+    if (registry == NULL || writer->task != mach_task_self() || !plcrash_async_thread_registry_complete(registry))
+        return false;
+
+    thread_t *ports = writer->thread_registry_threads;
+    uint32_t port_count = plcrash_async_thread_registry_copy_ports(registry, ports, registry->capacity);
+
+    /* Threads that have since terminated are dropped */
+    mach_msg_type_number_t count = 0;
+    bool found_crashed = false;
+    for (uint32_t i = 0; i < port_count; i++) {
+        if (mach_port_mod_refs(mach_task_self(), ports[i], MACH_PORT_RIGHT_SEND, 1) != KERN_SUCCESS)
+            continue;
+
+        if (ports[i] == crashed_thread)
+            found_crashed = true;
+        ports[count++] = ports[i];
+    }
 
-        /* Did we reach the end successfully? */
-        if (ferr != PLFRAME_ENOFRAME) {
-            /* This is non-fatal, and in some circumstances -could- be caused by reaching the end of the stack if the
-             * final frame pointer is not NULL. */
-            PLCF_DEBUG("Terminated stack walking early: %s", plframe_strerror(ferr));
-        }
+    /* The crashed thread must be written; it may not have been created via pthreads */
+    if (!found_crashed) {
+        for (mach_msg_type_number_t i = 0; i < count; i++)
+            mach_port_deallocate(mach_task_self(), ports[i]);
+        return false;
     }
 
-    plframe_cursor_free(&cursor);
-    return rv;
+    *threads = ports;
+    *thread_count = count;
+    return true;
 }
 
-
 /**
  * @internal
  *
- * Write a binary image frame
+ * Fetch the threads to be written: either the writer's thread subset, the threads recorded by the writer's thread
+ * registry, or all threads of the target task. As with task_threads(), the caller owns a send right to each returned
+ * thread; both must be released via plcrash_writer_release_threads().
  *
- * @param file Output file
- * @param name binary image path (or name).
- * @param image_base Mach-O image base.
+ * @param writer The writer context.
+ * @param crashed_thread The crashed thread, which must be included in the returned threads.
+ * @param threads On success, the thread array.
+ * @param thread_count On success, the number of entries in @a threads.
+ * @param all_threads On success, set to true if @a threads is known to contain every thread of the target task.
+ *
+ * @return Returns true on success, or false if the threads could not be fetched.
  */
-static size_t plcrash_writer_write_binary_image (plcrash_async_file_t *file, plcrash_async_macho_t *image) {
-    size_t rv = 0;
+static bool plcrash_writer_fetch_threads (plcrash_log_writer_t *writer, thread_t crashed_thread, thread_act_array_t *threads, mach_msg_type_number_t *thread_count, bool *all_threads) {
+    *all_threads = false;
 
-    /* Fetch the CPU types. Note that the wire format represents these as 64-bit unsigned integers.
-     * We explicitly cast to an equivalently sized unsigned type to prevent improper sign extension. */
-    uint64_t cpu_type = (uint32_t) image->byteorder->swap32(image->header.cputype);
-    uint64_t cpu_subtype = (uint32_t) image->byteorder->swap32(image->header.cpusubtype);
+    if (writer->thread_subset == NULL) {
+        /* The registry only records pthreads */
+        if (plcrash_writer_fetch_registry_threads(writer, crashed_thread, threads, thread_count))
+            return true;
 
-    /* Text segment size */
-    uint64_t mach_size = image->text_size;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_BINARY_IMAGE_SIZE_ID, PLPROTOBUF_C_TYPE_UINT64, &mach_size);
-    
-    /* Base address */
-    {
-        uintptr_t base_addr;
-        uint64_t u64;
+        if (task_threads(writer->task, threads, thread_count) != KERN_SUCCESS)
+            return false;
 
-        base_addr = (uintptr_t) image->header_addr;
-        u64 = base_addr;
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_BINARY_IMAGE_ADDR_ID, PLPROTOBUF_C_TYPE_UINT64, &u64);
+        *all_threads = true;
+        return true;
     }
 
-    /* Name */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_BINARY_IMAGE_NAME_ID, PLPROTOBUF_C_TYPE_STRING, image->name);
+    vm_address_t addr;
+    if (vm_allocate(mach_task_self(), &addr, sizeof(thread_t) * writer->thread_subset_count, VM_FLAGS_ANYWHERE) != KERN_SUCCESS)
+        return false;
+
+    /* Take an additional send right to each thread, matching the rights returned by task_threads(). Threads that
+     * have since terminated are dropped. */
+    thread_t *copy = (thread_t *) addr;
+    mach_msg_type_number_t count = 0;
+    for (mach_msg_type_number_t i = 0; i < writer->thread_subset_count; i++) {
+        if (mach_port_mod_refs(mach_task_self(), writer->thread_subset[i], MACH_PORT_RIGHT_SEND, 1) == KERN_SUCCESS)
+            copy[count++] = writer->thread_subset[i];
+    }
 
-    /* UUID */
-    struct uuid_command *uuid;
-    uuid = plcrash_async_macho_find_command(image, LC_UUID);
-    if (uuid != NULL) {
-        PLProtobufCBinaryData binary;
-    
-        /* Write the 128-bit UUID */
-        binary.len = sizeof(uuid->uuid);
-        binary.data = uuid->uuid;
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_BINARY_IMAGE_UUID_ID, PLPROTOBUF_C_TYPE_BYTES, &binary);
+    if (count == 0) {
+        vm_deallocate(mach_task_self(), addr, sizeof(thread_t) * writer->thread_subset_count);
+        copy = NULL;
     }
-    
-    /* Get the processor message size */
-    uint32_t msgsize = plcrash_writer_write_processor_info(NULL, cpu_type, cpu_subtype);
 
-    /* Write the header and message */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_BINARY_IMAGE_CODE_TYPE_ID, PLPROTOBUF_C_TYPE_MESSAGE, &msgsize);
-    rv += plcrash_writer_write_processor_info(file, cpu_type, cpu_subtype);
+    *threads = copy;
+    *thread_count = count;
+    return true;
+}
 
-    return rv;
+/**
+ * @internal
+ *
+ * Release the send rights and thread array returned by plcrash_writer_fetch_threads().
+ */
+static void plcrash_writer_release_threads (plcrash_log_writer_t *writer, thread_act_array_t threads, mach_msg_type_number_t thread_count) {
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++)
+        mach_port_deallocate(mach_task_self(), threads[i]);
+
+    /* The registry's thread list is preallocated, and reused by each report */
+    if (threads != writer->thread_registry_threads)
+        vm_deallocate(mach_task_self(), (vm_address_t) threads, sizeof(thread_t) * thread_count);
 }
 
+/**
+ * @internal
+ *
+ * Suspend all of @a threads, other than the current thread and the writer's helper threads.
+ *
+ * If @a all_threads is true, no other thread can modify the target task's address space until the threads are
+ * resumed, and a local memory object reference scope is opened (see plcrash_async_mobject_local_references_begin());
+ * the scope is closed by plcrash_writer_resume_threads().
+ *
+ * @param writer The writer context.
+ * @param threads The threads to suspend, as returned by plcrash_writer_fetch_threads().
+ * @param thread_count The number of entries in @a threads.
+ * @param all_threads If true, @a threads contains every thread of the target task.
+ */
+static void plcrash_writer_suspend_threads (plcrash_log_writer_t *writer, thread_act_array_t threads, mach_msg_type_number_t thread_count, bool all_threads) {
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+        if (threads[i] != pl_mach_thread_self() && !plcrash_writer_is_helper_thread(writer, threads[i]))
+            thread_suspend(threads[i]);
+    }
+
+    if (all_threads)
+        plcrash_async_mobject_local_references_begin();
+}
 
 /**
  * @internal
  *
- * Write the crash Exception message
+ * Resume all of @a threads that were suspended by plcrash_writer_suspend_threads(), closing the local memory object
+ * reference scope if one was opened. Any local memory objects must have been freed.
  *
- * @param file Output file
- * @param writer Writer containing exception data
+ * @param writer The writer context.
+ * @param threads The threads to resume.
+ * @param thread_count The number of entries in @a threads.
+ * @param all_threads The value that was passed to plcrash_writer_suspend_threads().
  */
-static size_t plcrash_writer_write_exception (plcrash_async_file_t *file, plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext) {
-    size_t rv = 0;
+static void plcrash_writer_resume_threads (plcrash_log_writer_t *writer, thread_act_array_t threads, mach_msg_type_number_t thread_count, bool all_threads) {
+    if (all_threads)
+        plcrash_async_mobject_local_references_end();
 
-    /* Write the name and reason */
-    assert(writer->uncaught_exception.has_exception);
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_NAME_ID, PLPROTOBUF_C_TYPE_STRING, writer->uncaught_exception.name);
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_REASON_ID, PLPROTOBUF_C_TYPE_STRING, writer->uncaught_exception.reason);
-    
-    /* Write the stack frames, if any */
-    uint32_t frame_count = 0;
-    for (size_t i = 0; i < writer->uncaught_exception.callstack_count && frame_count < MAX_THREAD_FRAMES; i++) {
-        uint64_t pc = (uint64_t)(uintptr_t) writer->uncaught_exception.callstack[i];
-        
-        /* Determine the size */
-        uint32_t frame_size = plcrash_writer_write_thread_frame(NULL, writer, pc, image_list, findContext);
-        
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
-        rv += plcrash_writer_write_thread_frame(file, writer, pc, image_list, findContext);
-        frame_count++;
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+        if (threads[i] != pl_mach_thread_self() && !plcrash_writer_is_helper_thread(writer, threads[i]))
+            thread_resume(threads[i]);
     }
+}
 
-    /* Write the user info */
-    for (size_t i = 0; i < writer->uncaught_exception.user_info_size; i++) {
-        user_info_t pair = writer->uncaught_exception.user_info[i];
+/**
+ * @internal
+ *
+ * Unwind all threads included in @a job into @a buffers, without symbolication. The buffer for each entry of
+ * plcrash_log_writer_capture_job_t::threads is found at the same index in @a buffers. If @a pipeline is non-NULL,
+ * each buffer is queued for symbolication once unwound.
+ */
+static void plcrash_writer_unwind_threads (plcrash_log_writer_thread_buffer_t *buffers,
+                                           plcrash_log_writer_capture_pool_t *pool,
+                                           plcrash_log_writer_symbolication_pipeline_t *pipeline,
+                                           plcrash_log_writer_capture_job_t *job)
+{
+    for (mach_msg_type_number_t i = 0; i < job->thread_count; i++) {
+        thread_t thread = job->threads[i];
 
-        /* Determine the size */
-        uint32_t pair_size = plcrash_writer_write_user_info_pair(NULL, pair);
+        if (!plcrash_writer_capture_job_includes_thread(pool, job, i))
+            continue;
 
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_USER_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &pair_size);
-        rv += plcrash_writer_write_user_info_pair(file, pair);
-    }
+        /* If executing on the target thread, we need to a valid context to walk */
+        plcrash_async_thread_state_t *thr_ctx = (thread == job->writer_thread) ? job->current_state : NULL;
+        plcrash_writer_unwind_thread(&buffers[i], job->writer, job->writer->task, thread, thr_ctx, job->image_list, thread == job->crashed_thread);
 
-    return rv;
+        /* If the queue is full, the buffer is left to be symbolicated by the writer */
+        if (pipeline != NULL)
+            plcrash_writer_symbolication_pipeline_enqueue(pipeline, i);
+    }
 }
 
 /**
  * @internal
  *
- * Write the crash signal's mach exception info.
+ * Write the exception (if any) and signal messages.
  *
  * @param file Output file
- * @param siginfo The signal information
+ * @param writer Writer instance.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param siginfo Signal information, or NULL.
  */
-static size_t plcrash_writer_write_mach_signal (plcrash_async_file_t *file, plcrash_log_mach_signal_info_t *siginfo) {
-    size_t rv = 0;
+static void plcrash_writer_write_termination_info (plcrash_async_file_t *file,
+                                                   plcrash_log_writer_t *writer,
+                                                   plcrash_async_image_list_t *image_list,
+                                                   plcrash_async_symbol_cache_t *findContext,
+                                                   plcrash_log_signal_info_t *siginfo)
+{
+    /* Exception */
+    if (writer->uncaught_exception.has_exception) {
+        uint32_t size;
 
-    /* Type */
-    uint64_t type = siginfo->type;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_TYPE_ID, PLPROTOBUF_C_TYPE_UINT64, &type);
-    
-    /* Code(s) */
-    for (mach_msg_type_number_t i = 0; i < siginfo->code_count; i++) {
-        uint64_t code = siginfo->code[i];
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_CODES_ID, PLPROTOBUF_C_TYPE_UINT64, &code);
+        /* Write the message once, and backpatch its length */
+        if (plcrash_writer_backpatch_available(file, writer)) {
+            off_t position;
+            plcrash_writer_pack_length_placeholder(file, PLCRASH_PROTO_EXCEPTION_ID, &position);
+            size = (uint32_t) plcrash_writer_write_exception(file, writer, image_list, findContext);
+            plcrash_writer_finish_backpatch(file, position, size);
+        } else {
+            /* Calculate the message size */
+            size = plcrash_writer_write_exception(NULL, writer, image_list, findContext);
+            plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+            plcrash_writer_write_exception(file, writer, image_list, findContext);
+        }
     }
 
-    return rv;
+    /* Signal */
+    if (siginfo)
+        plcrash_writer_write_signal(file, siginfo);
 }
 
 /**
  * @internal
  *
- * Write the crash signal message
+ * Seed the writer's region map for a new report, recording the text segments of the images in @a image_list, the
+ * NULL page, and the stack and stack guard regions of the crashed thread.
  *
- * @param file Output file
- * @param siginfo The signal information
+ * @param writer Writer instance.
+ * @param image_list The task's image list.
+ * @param crashed_state The crashed thread's state, or NULL if unavailable.
  */
-static size_t plcrash_writer_write_signal (plcrash_async_file_t *file, plcrash_log_signal_info_t *siginfo) {
-    size_t rv = 0;
-    
-    /* BSD signal info is always required in the current report format; this restriction will be lifted
-     * once we switch to the 2.0 format. */
-    PLCF_ASSERT(siginfo->bsd_info != NULL);
-    
-    /* Fetch the signal name */
-    char name_buf[10];
-    const char *name;
-    if ((name = plcrash_async_signal_signame(siginfo->bsd_info->signo)) == NULL) {
-        PLCF_DEBUG("Warning -- unhandled signal number (signo=%d). This is a bug.", siginfo->bsd_info->signo);
-        snprintf(name_buf, sizeof(name_buf), "#%d", siginfo->bsd_info->signo);
-        name = name_buf;
-    }
+static void plcrash_writer_seed_region_map (plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list, plcrash_async_thread_state_t *crashed_state) {
+    plcrash_async_region_map_t *map = writer->region_map;
 
-    /* Fetch the signal code string */
-    char code_buf[10];
-    const char *code;
-    if ((code = plcrash_async_signal_sigcode(siginfo->bsd_info->signo, siginfo->bsd_info->code)) == NULL) {
-        PLCF_DEBUG("Warning -- unhandled signal sicode (signo=%d, code=%d). This is a bug.", siginfo->bsd_info->signo, siginfo->bsd_info->code);
-        snprintf(code_buf, sizeof(code_buf), "#%d", siginfo->bsd_info->code);
-        code = code_buf;
+    plcrash_async_region_map_init(map, writer->task);
+
+    /* The NULL page, or the __PAGEZERO segment that extends it */
+    plcrash_async_region_map_add_region(map, 0);
+
+    /* The image text segments */
+    plcrash_async_image_list_set_reading(image_list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
+        pl_vm_address_t start = image->macho_image.header_addr;
+        plcrash_async_region_map_add(map, start, start + image->macho_image.text_size, true);
     }
-    
-    /* Address value */
-    uint64_t addr = (uintptr_t) siginfo->bsd_info->address;
+    plcrash_async_image_list_set_reading(image_list, false);
 
-    /* Write it out */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_NAME_ID, PLPROTOBUF_C_TYPE_STRING, name);
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_CODE_ID, PLPROTOBUF_C_TYPE_STRING, code);
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_ADDRESS_ID, PLPROTOBUF_C_TYPE_UINT64, &addr);
-    
-    /* Mach exception info */
-    if (siginfo->mach_info != NULL) {
-        uint32_t size;
-        
-        /* Determine size */
-        size = plcrash_writer_write_mach_signal(NULL, siginfo->mach_info);
-        
-        /* Write message */
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        rv += plcrash_writer_write_mach_signal(file, siginfo->mach_info);
+    /* The crashed thread's stack, and the guard region below it */
+    if (crashed_state != NULL && plcrash_async_thread_state_has_reg(crashed_state, PLCRASH_REG_SP)) {
+        plcrash_async_region_map_range_t stack;
+        pl_vm_address_t sp = (pl_vm_address_t) plcrash_async_thread_state_get_reg(crashed_state, PLCRASH_REG_SP);
+
+        if (plcrash_async_task_region_lookup(writer->task, sp, &stack) == PLCRASH_ESUCCESS) {
+            plcrash_async_region_map_add(map, stack.start, stack.end, stack.readable);
+            if (stack.readable && stack.start > 0)
+                plcrash_async_region_map_add_region(map, stack.start - 1);
+        }
     }
 
-    return rv;
+    plcrash_async_region_map_finalize(map);
 }
 
 /**
- * @internal
+ * Unwind and symbolicate the calling thread into @a writer's preallocated buffers, discarding the result. No report
+ * is written, and no other threads are suspended.
  *
- * Write the report info message
+ * This faults in the unwinder and symbolication code, along with the image, unwind, and symbol data read for the
+ * calling thread's frames, so that a crash handler running under memory pressure is less likely to stall on page-ins.
  *
- * @param file Output file
- * @param writer Writer containing report data
+ * @param writer The writer whose buffers will be used.
+ * @param image_list The current list of loaded binary images.
+ * @param current_state The calling thread's state, eg, as generated by plcrash_async_thread_state_current(). The state
+ * must remain valid until this function returns.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the writer's thread buffer is unavailable.
+ *
+ * @warning This function is not async safe, and must not be called concurrently with any other use of @a writer.
  */
-static size_t plcrash_writer_write_report_info (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
-    size_t rv = 0;
+plcrash_error_t plcrash_log_writer_warm_current_thread (plcrash_log_writer_t *writer,
+                                                        plcrash_async_image_list_t *image_list,
+                                                        plcrash_async_thread_state_t *current_state)
+{
+    if (writer->thread_buffer == NULL)
+        return PLCRASH_ENOMEM;
+
+    /* Use the writer's reusable symbol cache, if any */
+    plcrash_async_symbol_cache_t localCache;
+    plcrash_async_symbol_cache_t *findContext = writer->symbol_cache;
+    if (findContext == NULL) {
+        plcrash_error_t err = plcrash_async_symbol_cache_init(&localCache);
+        if (err != PLCRASH_ESUCCESS)
+            return err;
+
+        findContext = &localCache;
+    }
 
-    /* Note crashed status */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_REPORT_INFO_USER_REQUESTED_ID, PLPROTOBUF_C_TYPE_BOOL, &writer->report_info.user_requested);
-    
-    /* Write the 128-bit UUID */
-    PLProtobufCBinaryData uuid_bin;
-    
-    uuid_bin.len = sizeof(writer->report_info.uuid_bytes);
-    uuid_bin.data = &writer->report_info.uuid_bytes;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_REPORT_INFO_UUID_ID, PLPROTOBUF_C_TYPE_BYTES, &uuid_bin);
+    /* The frame readers consult the region map, if enabled */
+    if (writer->region_map != NULL)
+        plcrash_writer_seed_region_map(writer, image_list, current_state);
 
-    return rv;
+    writer->deadline_expired = false;
+    plcrash_writer_capture_thread(writer->thread_buffer, writer, writer->task, pl_mach_thread_self(), current_state, image_list, findContext, true);
+
+    if (findContext == &localCache)
+        plcrash_async_symbol_cache_free(&localCache);
+
+    return PLCRASH_ESUCCESS;
 }
 
 /**
@@ -1274,37 +6285,168 @@ plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
                                           plcrash_log_signal_info_t *siginfo,
                                           plcrash_async_thread_state_t *current_state)
 {
-    thread_act_array_t threads;
-    mach_msg_type_number_t thread_count;
+    thread_act_array_t threads = NULL;
+    mach_msg_type_number_t thread_count = 0;
+    uint64_t suspend_start = 0;
+    bool all_threads = false;
+
+    /* Snapshot the instrumentation counters; the report's measurements are the difference at completion */
+    plcrash_async_metrics_t metrics_start;
+    uint64_t image_write_time = 0;
+    if (writer->instrumentation)
+        plcrash_async_metrics_snapshot(&metrics_start);
+
+    /* Start the report's deadline */
+    writer->deadline_expired = false;
+    writer->deadline = (writer->deadline_budget != 0) ? mach_absolute_time() + writer->deadline_budget : 0;
 
     /* A context must be supplied if the current thread is marked as the crashed thread; otherwise,
      * the thread's stack can not be safely walked. */
     BOOL include_stack = (pl_mach_thread_self() != crashed_thread || current_state != NULL);
 
-    plcrash_async_symbol_cache_t findContext;
+    /* The capture pool workers must not be suspended */
+    plcrash_log_writer_capture_pool_t *capture_pool = writer->capture_pool;
+
+    plcrash_async_symbol_cache_t localCache;
+    plcrash_async_symbol_cache_t *findContext = writer->symbol_cache;
     if (include_stack) {
-        /* Get a list of all threads */
-        if (task_threads(mach_task_self(), &threads, &thread_count) != KERN_SUCCESS) {
+        /* Get the list of threads to be written */
+        if (!plcrash_writer_fetch_threads(writer, crashed_thread, &threads, &thread_count, &all_threads)) {
             PLCF_DEBUG("Fetching thread list failed");
             thread_count = 0;
         }
     
-        /* Suspend all but the current thread. */
-        for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
-            if (threads[i] != pl_mach_thread_self())
-                thread_suspend(threads[i]);
+        /* Suspend all but the current thread and the helper threads. */
+        suspend_start = mach_absolute_time();
+        plcrash_writer_suspend_threads(writer, threads, thread_count, all_threads);
+    }
+
+    /* Set up a symbol-finding context, unless a reusable cache was supplied. */
+    if (findContext == NULL) {
+        plcrash_error_t err = plcrash_async_symbol_cache_init(&localCache);
+        /* Abort if it failed, although that should never actually happen, ever. */
+        if (err != PLCRASH_ESUCCESS)
+            return err;
+
+        findContext = &localCache;
+    }
+
+    /* Record look-up results for the duration of this report */
+    if (writer->symbol_pc_cache != NULL)
+        plcrash_async_symbol_cache_set_pc_cache(findContext, writer->symbol_pc_cache, writer->symbol_pc_cache_count);
+
+    /* Symbolicate the exception backtrace once, ahead of the overlapping frames of the crashed thread */
+    if (writer->uncaught_exception.has_exception && writer->uncaught_exception.frame_buffer != NULL)
+        plcrash_writer_symbolicate_exception(writer, image_list, findContext);
+
+    /* Seed the map of readable memory consulted by the frame readers */
+    if (writer->region_map != NULL && include_stack) {
+        plcrash_async_thread_state_t *crashed_state = plcrash_writer_crashed_thread_state(writer);
+        if (crashed_thread == pl_mach_thread_self())
+            crashed_state = current_state;
+
+        plcrash_writer_seed_region_map(writer, image_list, crashed_state);
+    }
+
+    plcrash_log_writer_capture_job_t job = {
+        .writer = writer,
+        .threads = threads,
+        .thread_count = thread_count,
+        .writer_thread = pl_mach_thread_self(),
+        .current_state = current_state,
+        .crashed_thread = crashed_thread,
+        .skip_thread = MACH_PORT_NULL,
+        .image_list = image_list,
+        .crashed_index = thread_count,
+        .max_threads = writer->max_threads
+    };
+
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+        if (threads[i] == crashed_thread) {
+            job.crashed_index = i;
+            break;
         }
     }
 
-    /* Set up a symbol-finding context. */
-    plcrash_error_t err = plcrash_async_symbol_cache_init(&findContext);
-    /* Abort if it failed, although that should never actually happen, ever. */
-    if (err != PLCRASH_ESUCCESS)
-        return err;
+    /*
+     * Live reports are unwound in full before any output is written, allowing the suspended threads to be resumed
+     * prior to symbolication and encoding. The capture buffers are allocated on demand; if allocation fails, the
+     * threads remain suspended until the report has been written.
+     */
+    plcrash_log_writer_thread_buffer_t *live_buffers = NULL;
+    vm_size_t live_buffers_size = 0;
+    bool live_buffers_retained = false;
+    bool threads_suspended = include_stack;
+    uint64_t suspend_duration = 0;
+    bool has_suspend_duration = false;
+
+    if (include_stack && writer->report_info.user_requested && !writer->streaming && thread_count > 0) {
+        vm_address_t addr;
+        live_buffers_size = round_page(sizeof(plcrash_log_writer_thread_buffer_t) * thread_count);
+        if (vm_allocate(mach_task_self(), &addr, live_buffers_size, VM_FLAGS_ANYWHERE) == KERN_SUCCESS) {
+            live_buffers = (plcrash_log_writer_thread_buffer_t *) addr;
+
+            /* If available, symbolicate each thread on the helper while the remaining threads are unwound */
+            plcrash_log_writer_symbolication_pipeline_t *pipeline = writer->symbolication_pipeline;
+            bool pipelined = plcrash_writer_symbolication_pipeline_start(pipeline, &job, live_buffers);
+            plcrash_writer_unwind_threads(live_buffers, capture_pool, pipelined ? pipeline : NULL, &job);
+
+            plcrash_writer_resume_threads(writer, threads, thread_count, all_threads);
+            threads_suspended = false;
+
+            /* Record the time for which the threads were suspended */
+            mach_timebase_info_data_t timebase;
+            if (mach_timebase_info(&timebase) == KERN_SUCCESS && timebase.denom != 0) {
+                suspend_duration = (mach_absolute_time() - suspend_start) * timebase.numer / timebase.denom;
+                has_suspend_duration = true;
+            }
+
+            /* Wait for the helper before encoding. If it fails to respond, the buffers must not be released, as the
+             * helper may still access them; any buffers it did not complete are symbolicated by the writer. */
+            if (pipelined && !plcrash_writer_symbolication_pipeline_finish(pipeline))
+                live_buffers_retained = true;
+        } else {
+            PLCF_DEBUG("Could not allocate live capture buffers; threads will remain suspended until the report is written");
+        }
+    }
+
+    /* Reset the register set; it is recorded as packed registers are written */
+    writer->packed_register_set = 0;
+
+    /* Reset the referenced image set */
+    plcrash_log_writer_image_set_t *referenced_images = writer->referenced_images;
+    if (referenced_images != NULL) {
+        referenced_images->count = 0;
+        referenced_images->overflow = false;
+        plcrash_async_memset(referenced_images->slots, 0, sizeof(referenced_images->slots));
+    }
+
+    /* Reset the stack table; threads may only reference stacks within a single report */
+    plcrash_log_writer_stack_table_t *stack_table = writer->stack_table;
+    if (stack_table != NULL) {
+        stack_table->count = 0;
+        plcrash_async_memset(stack_table->slots, 0, sizeof(stack_table->slots));
+    }
+
+    /* Reset the symbol table; names are only shared within a single report */
+    plcrash_log_writer_symbol_table_t *symbol_table = writer->symbol_table;
+    if (symbol_table != NULL) {
+        symbol_table->count = 0;
+        symbol_table->pool_used = 0;
+        plcrash_async_memset(symbol_table->slots, 0, sizeof(symbol_table->slots));
+    }
 
     /* Write the file header */
     {
         uint8_t version = PLCRASH_REPORT_FILE_VERSION;
+        if (stack_table != NULL)
+            version = PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS;
+        else if (writer->packed_frames)
+            version = PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES;
+        else if (writer->packed_registers)
+            version = PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS;
+        else if (symbol_table != NULL)
+            version = PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE;
 
         /* Write the magic string (with no trailing NULL) and the version number */
         plcrash_async_file_write(file, PLCRASH_REPORT_FILE_MAGIC, strlen(PLCRASH_REPORT_FILE_MAGIC));
@@ -1317,11 +6459,11 @@ plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
         uint32_t size;
         
         /* Determine size */
-        size = plcrash_writer_write_report_info(NULL, writer);
+        size = plcrash_writer_write_report_info(NULL, writer, has_suspend_duration ? &suspend_duration : NULL);
         
         /* Write message */
         plcrash_writer_pack(file, PLCRASH_PROTO_REPORT_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_report_info(file, writer);
+        plcrash_writer_write_report_info(file, writer, has_suspend_duration ? &suspend_duration : NULL);
     }
 
     /* System Info */
@@ -1343,139 +6485,493 @@ plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
         plcrash_writer_write_system_info(file, writer, timestamp);
     }
     
-    /* Machine Info */
+    /* Machine, app, and process info. These are written from the pre-encoded messages if available. */
     {
-        uint32_t size;
-
-        /* Determine size */
-        size = plcrash_writer_write_machine_info(NULL, writer);
-
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_machine_info(file, writer);
+        plcrash_log_writer_static_sections_t *sections = writer->static_sections;
+        if (sections != NULL) {
+            plcrash_async_file_write(file, sections->messages, sections->messages_len);
+        } else {
+            plcrash_writer_write_static_messages(file, writer);
+        }
     }
 
-    /* App info */
-    {
-        uint32_t size;
+    /* When prioritizing output, sections are written in order of importance, and lower-priority threads and images are
+     * omitted as required to fit the report within the file's output limit. */
+    bool prioritized = writer->prioritized_output && file->limit_bytes != 0;
+    uint32_t elided_thread_count = include_stack ? plcrash_writer_capture_job_limited_count(&job) : 0;
+    uint32_t elided_image_count = 0;
 
-        /* Determine size */
-        size = plcrash_writer_write_app_info(NULL, writer->application_info.app_identifier, writer->application_info.app_version);
-        
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_APP_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_app_info(file, writer->application_info.app_identifier, writer->application_info.app_version);
-    }
-    
-    /* Process info */
-    {
-        uint32_t size;
-        
-        /* Determine size */
-        size = plcrash_writer_write_process_info(NULL, writer->process_info.process_name, writer->process_info.process_id, 
-                                                 writer->process_info.process_path, writer->process_info.parent_process_name,
-                                                 writer->process_info.parent_process_id, writer->process_info.native,
-                                                 writer->process_info.start_time);
-        
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_process_info(file, writer->process_info.process_name, writer->process_info.process_id, 
-                                          writer->process_info.process_path, writer->process_info.parent_process_name, 
-                                          writer->process_info.parent_process_id, writer->process_info.native,
-                                          writer->process_info.start_time);
+    /* When streaming, the small termination messages are written first, so that a truncated report still includes them */
+    if (writer->streaming) {
+        plcrash_writer_write_termination_info(file, writer, image_list, findContext, siginfo);
+        plcrash_writer_flush_point(file, writer, PLCRASH_LOG_WRITER_FLUSH_HEADER);
     }
 
     if (include_stack) {
-        /* Threads */
-        uint32_t thread_number = 0;
-        for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
-            thread_t thread = threads[i];
-            plcrash_async_thread_state_t *thr_ctx = NULL;
-            bool crashed = false;
-            uint32_t size;
+        pl_vm_address_t priority_images[PLCRASH_WRITER_PRIORITY_IMAGE_MAX];
+        size_t priority_image_count = 0;
+
+        /* If the report references an image manifest, the manifest's images are omitted. If too many of its images
+         * have since been unloaded, the manifest is ignored and all images are written. */
+        plcrash_log_writer_image_manifest_t *manifest = writer->image_manifest;
+        pl_vm_address_t manifest_removed[PLCRASH_LOG_WRITER_MANIFEST_REMOVED_MAX];
+        size_t manifest_removed_count = 0;
+        if (manifest != NULL && !plcrash_writer_manifest_find_removed(manifest, image_list, manifest_removed, &manifest_removed_count))
+            manifest = NULL;
+
+        /* When streaming or prioritizing, write the crashed thread ahead of all others. Its thread number is unchanged. */
+        if (writer->streaming || prioritized) {
+            uint32_t thread_number = 0;
+            for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+                thread_t thread = threads[i];
+
+                if (!plcrash_writer_capture_job_includes_thread(capture_pool, &job, i))
+                    continue;
 
-            /* If executing on the target thread, we need to a valid context to walk */
-            if (pl_mach_thread_self() == thread) {
-                /* Can't log a report for the current thread without a valid context. */
-                if (current_state == NULL)
+                if (thread == crashed_thread) {
+                    plcrash_log_writer_thread_buffer_t *buffer;
+
+                    if (live_buffers != NULL) {
+                        buffer = &live_buffers[i];
+                        plcrash_writer_symbolicate_captured_thread(buffer, writer, image_list, findContext, true);
+                        plcrash_writer_write_captured_thread_message(file, writer, buffer, thread_number, image_list, findContext, true, SIZE_MAX);
+                    } else {
+                        plcrash_async_thread_state_t *thr_ctx = (thread == job.writer_thread) ? current_state : NULL;
+                        plcrash_writer_write_thread_message(file, writer, thread, thread_number, thr_ctx, image_list, findContext, true, SIZE_MAX);
+                        buffer = writer->thread_buffer;
+                    }
+                    plcrash_writer_flush_point(file, writer, PLCRASH_LOG_WRITER_FLUSH_CRASHED_THREAD);
+
+                    /* Record the images required to symbolicate the crashed thread */
+                    if (prioritized && buffer != NULL)
+                        priority_image_count = plcrash_writer_find_frame_images(buffer, image_list, priority_images, PLCRASH_WRITER_PRIORITY_IMAGE_MAX);
+
+                    job.skip_thread = crashed_thread;
+                    break;
+                }
+
+                thread_number++;
+            }
+        }
+
+        /* When prioritizing, write the termination messages and the crashed thread's images next, and determine the
+         * space required for the remaining images. */
+        size_t image_reserve = 0;
+        if (prioritized) {
+            if (!writer->streaming)
+                plcrash_writer_write_termination_info(file, writer, image_list, findContext, siginfo);
+
+            plcrash_async_image_list_set_reading(image_list, true);
+
+            plcrash_async_image_t *image = NULL;
+            while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
+                if (plcrash_writer_manifest_contains(manifest, image))
                     continue;
-        
-                thr_ctx = current_state;
+
+                if (!plcrash_writer_contains_image(priority_images, priority_image_count, image)) {
+                    image_reserve += plcrash_writer_image_message_size(image);
+                    continue;
+                }
+
+                if (!plcrash_writer_write_image_message(file, image, plcrash_writer_output_budget(file, writer, 0)))
+                    elided_image_count++;
             }
-        
-            /* Check if this is the crashed thread */
-            if (crashed_thread == thread) {
-                crashed = true;
+
+            plcrash_async_image_list_set_reading(image_list, false);
+        }
+
+        /* Threads. Live reports are symbolicated and written from the capture buffers populated above. The capture
+         * pool may only be used by one writer at a time; if it's unavailable, the threads are unwound serially.
+         * Prioritized reports are always written serially, as each thread must be sized against the remaining
+         * output limit before it is written. */
+        if (live_buffers != NULL) {
+            uint32_t thread_number = 0;
+            for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+                thread_t thread = threads[i];
+                bool crashed = (crashed_thread == thread);
+
+                if (!plcrash_writer_capture_job_includes_thread(capture_pool, &job, i))
+                    continue;
+
+                /* Skip threads that have already been written, preserving their thread number */
+                if (thread == job.skip_thread) {
+                    thread_number++;
+                    continue;
+                }
+
+                plcrash_writer_check_deadline(writer);
+                plcrash_writer_symbolicate_captured_thread(&live_buffers[i], writer, image_list, findContext, crashed);
+                size_t max_size = prioritized ? plcrash_writer_output_budget(file, writer, image_reserve) : SIZE_MAX;
+                if (!plcrash_writer_write_captured_thread_message(file, writer, &live_buffers[i], thread_number, image_list, findContext, crashed, max_size))
+                    elided_thread_count++;
+
+                plcrash_writer_flush_point(file, writer, PLCRASH_LOG_WRITER_FLUSH_THREAD);
+                thread_number++;
             }
+        } else if (!prioritized && capture_pool != NULL && OSAtomicCompareAndSwap32Barrier(0, 1, &capture_pool->busy)) {
+            /* If a worker failed to respond, it may still hold its slab; the pool is left busy and will not be reused. */
+            if (plcrash_writer_write_threads_parallel(file, capture_pool, &job, findContext))
+                OSAtomicCompareAndSwap32Barrier(1, 0, &capture_pool->busy);
+        } else {
+            uint32_t thread_number = 0;
+            for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+                thread_t thread = threads[i];
+
+                /* Skip threads that can't be walked, as well as the (unsuspended) capture workers */
+                if (!plcrash_writer_capture_job_includes_thread(capture_pool, &job, i))
+                    continue;
 
-            /* Determine the size */
-            size = plcrash_writer_write_thread(NULL, writer, mach_task_self(), thread, thread_number, thr_ctx, image_list, &findContext, crashed);
+                /* Skip threads that have already been written, preserving their thread number */
+                if (thread == job.skip_thread) {
+                    thread_number++;
+                    continue;
+                }
 
-            /* Write message */
-            plcrash_writer_pack(file, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-            plcrash_writer_write_thread(file, writer, mach_task_self(), thread, thread_number, thr_ctx, image_list, &findContext, crashed);
+                /* If executing on the target thread, we need to a valid context to walk */
+                plcrash_async_thread_state_t *thr_ctx = (thread == job.writer_thread) ? current_state : NULL;
 
-            /* Write message */
-            plcrash_writer_pack(file, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-            plcrash_writer_write_thread(file, writer, mach_task_self(), thread, thread_number, thr_ctx, image_list, &findContext, crashed);
+                plcrash_writer_check_deadline(writer);
+                size_t max_size = prioritized ? plcrash_writer_output_budget(file, writer, image_reserve) : SIZE_MAX;
+                if (!plcrash_writer_write_thread_message(file, writer, thread, thread_number, thr_ctx, image_list, findContext, crashed_thread == thread, max_size))
+                    elided_thread_count++;
 
-            thread_number++;
+                plcrash_writer_flush_point(file, writer, PLCRASH_LOG_WRITER_FLUSH_THREAD);
+                thread_number++;
+            }
+        }
+
+        /* Binary Images. If only referenced images are written, the exception backtrace must be recorded beforehand,
+         * as it may be written after the images. */
+        if (referenced_images != NULL && writer->uncaught_exception.has_exception) {
+            for (size_t i = 0; i < writer->uncaught_exception.callstack_count && i < MAX_THREAD_FRAMES; i++)
+                plcrash_writer_reference_address(writer, image_list, (uint64_t)(uintptr_t) writer->uncaught_exception.callstack[i]);
+        }
+
+        uint64_t images_start = plcrash_async_metrics_time_begin();
+
+        /* The manifest reference, if any */
+        if (manifest != NULL) {
+            uint32_t size = (uint32_t) plcrash_writer_write_image_manifest_reference(NULL, manifest, manifest_removed, manifest_removed_count);
+            plcrash_writer_pack(file, PLCRASH_PROTO_IMAGE_MANIFEST_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+            plcrash_writer_write_image_manifest_reference(file, manifest, manifest_removed, manifest_removed_count);
         }
 
-        /* Binary Images */
         plcrash_async_image_list_set_reading(image_list, true);
 
         plcrash_async_image_t *image = NULL;
         while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
-            uint32_t size;
+            /* Images listed in the manifest are not written */
+            if (plcrash_writer_manifest_contains(manifest, image))
+                continue;
+
+            /* Images omitted only due to the deadline are recorded as elided */
+            plcrash_writer_check_deadline(writer);
+            if (!plcrash_writer_should_write_image(writer, image)) {
+                if (writer->deadline_image_set && writer->deadline_expired)
+                    elided_image_count++;
+                continue;
+            }
 
-            /* Calculate the message size */
-            size = plcrash_writer_write_binary_image(NULL, &image->macho_image);
-            plcrash_writer_pack(file, PLCRASH_PROTO_BINARY_IMAGES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-            plcrash_writer_write_binary_image(file, &image->macho_image);
+            if (!prioritized) {
+                plcrash_writer_write_image_message(file, image, SIZE_MAX);
+                continue;
+            }
+
+            /* Skip the images that have already been written */
+            if (plcrash_writer_contains_image(priority_images, priority_image_count, image))
+                continue;
+
+            if (!plcrash_writer_write_image_message(file, image, plcrash_writer_output_budget(file, writer, 0)))
+                elided_image_count++;
         }
 
         plcrash_async_image_list_set_reading(image_list, false);
+        if (images_start != 0)
+            image_write_time = mach_absolute_time() - images_start;
+
+        plcrash_writer_flush_point(file, writer, PLCRASH_LOG_WRITER_FLUSH_IMAGES);
+
+        /* Stack memory. This is bounded by the remaining output limit, and so follows the higher-priority sections.
+         * Captured memory is omitted once the deadline has expired. */
+        if (!plcrash_writer_check_deadline(writer))
+            plcrash_writer_write_stack_memory_section(file, writer, capture_pool, &job, threads_suspended);
+
+        /* Register-referenced memory */
+        if (!plcrash_writer_check_deadline(writer))
+            plcrash_writer_write_register_memory_section(file, writer, capture_pool, &job);
+
+        /* VM region summary */
+        if (!plcrash_writer_check_deadline(writer))
+            plcrash_writer_write_vm_region_summary_section(file, writer);
     }
 
-    /* Exception */
-    if (writer->uncaught_exception.has_exception) {
-        uint32_t size;
+    /* Exception and signal */
+    if (!writer->streaming && !(prioritized && include_stack))
+        plcrash_writer_write_termination_info(file, writer, image_list, findContext, siginfo);
+
+    /* Record the sections omitted to fit the output limit or the thread limit, and any reduction in detail due to the
+     * deadline */
+    bool deadline_expired = writer->deadline_expired;
+    if (prioritized || elided_thread_count > 0 || deadline_expired) {
+        uint32_t size = (uint32_t) plcrash_writer_write_truncation_info(NULL, elided_thread_count, elided_image_count, deadline_expired);
+        plcrash_writer_pack(file, PLCRASH_PROTO_TRUNCATION_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_truncation_info(file, elided_thread_count, elided_image_count, deadline_expired);
+    }
 
-        /* Calculate the message size */
-        size = plcrash_writer_write_exception(NULL, writer, image_list, &findContext);
-        plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_exception(file, writer, image_list, &findContext);
+    /* Symbol names. These must follow all symbol records, as names are added to the table as they are written. */
+    if (symbol_table != NULL) {
+        for (uint32_t i = 0; i < symbol_table->count; i++)
+            plcrash_writer_pack(file, PLCRASH_PROTO_SYMBOL_NAMES_ID, PLPROTOBUF_C_TYPE_STRING, symbol_table->names[i]);
     }
 
-    /* Signal */
-    if (siginfo) {
+    /* Register set. This must follow all threads, as it is recorded as packed registers are written. */
+    if (writer->packed_register_set != 0)
+        plcrash_writer_pack(file, PLCRASH_PROTO_REGISTER_SET_ID, PLPROTOBUF_C_TYPE_ENUM, &writer->packed_register_set);
+
+    /* Diagnostic trace events */
+    plcrash_writer_write_trace_events(file, writer);
+
+    /* Application breadcrumbs */
+    if (writer->breadcrumbs != NULL)
+        plcrash_writer_write_breadcrumbs(file, writer->breadcrumbs);
+
+    /* Application custom data */
+    if (writer->custom_data != NULL)
+        plcrash_writer_write_custom_data(file, writer->custom_data);
+
+    /* Instrumentation. This follows all other sections, to include as much of the report's generation as possible. */
+    if (writer->instrumentation) {
+        plcrash_log_writer_instrumentation_t info;
         uint32_t size;
-        
-        /* Calculate the message size */
-        size = plcrash_writer_write_signal(NULL, siginfo);
-        plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_signal(file, siginfo);
+
+        /* If the threads have not yet been resumed, they have been suspended for the entire report */
+        uint64_t suspend_time = suspend_duration;
+        if (threads_suspended)
+            suspend_time = plcrash_async_metrics_to_ns(mach_absolute_time() - suspend_start);
+
+        plcrash_writer_collect_instrumentation(writer, &metrics_start, suspend_time, image_write_time, &info);
+
+        size = plcrash_writer_write_instrumentation(NULL, &info);
+        plcrash_writer_pack(file, PLCRASH_PROTO_INSTRUMENTATION_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_instrumentation(file, &info);
     }
+
+    /* Integrity trailer. This must follow all other output. */
+    plcrash_writer_write_integrity(file);
     
+    plcrash_async_symbol_cache_set_pc_cache(findContext, NULL, 0);
+
     if (include_stack) {
-        plcrash_async_symbol_cache_free(&findContext);
+        if (findContext == &localCache)
+            plcrash_async_symbol_cache_free(&localCache);
     
-        /* Clean up the thread array */
-        for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
-            if (threads[i] != pl_mach_thread_self())
-                thread_resume(threads[i]);
+        /* Resume any threads that are still suspended, and clean up the thread array */
+        if (threads_suspended)
+            plcrash_writer_resume_threads(writer, threads, thread_count, all_threads);
 
-            mach_port_deallocate(mach_task_self(), threads[i]);
-        }
+        if (live_buffers != NULL && !live_buffers_retained)
+            vm_deallocate(mach_task_self(), (vm_address_t) live_buffers, live_buffers_size);
 
-        vm_deallocate(mach_task_self(), (vm_address_t)threads, sizeof(thread_t) * thread_count);
+        plcrash_writer_release_threads(writer, threads, thread_count);
     }
     
     return PLCRASH_ESUCCESS;
 }
 
 
+/**
+ * @internal
+ * Deferred symbol lookup context used by plcrash_writer_visit_frame().
+ */
+struct plcrash_writer_visit_symbol_ctx {
+    const plcrash_log_writer_visitor_t *visitor;
+    uint32_t frame_number;
+    uint64_t pc;
+    bool found;
+    bool result;
+};
+
+/* Forward a deferred symbol lookup result to the visitor */
+static void plcrash_writer_visit_symbol_cb (pl_vm_address_t address, const char *name, void *ctx) {
+    struct plcrash_writer_visit_symbol_ctx *visit_ctx = ctx;
+    visit_ctx->found = true;
+    visit_ctx->result = visit_ctx->visitor->frame(visit_ctx->frame_number, visit_ctx->pc, name, address, visit_ctx->visitor->ctx);
+}
+
+/**
+ * @internal
+ *
+ * Pass a captured frame to @a visitor. If the frame's symbol name could not be stored during capture, the symbol is
+ * looked up again, and its name passed directly from the lookup.
+ */
+static bool plcrash_writer_visit_frame (plcrash_log_writer_t *writer, const plcrash_log_writer_visitor_t *visitor, uint32_t frame_number,
+                                        plcrash_log_writer_frame_t *frame, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext)
+{
+    if (frame->symbol_deferred) {
+        struct plcrash_writer_visit_symbol_ctx ctx = { .visitor = visitor, .frame_number = frame_number, .pc = frame->pc, .found = false, .result = true };
+
+        plcrash_async_image_list_set_reading(image_list, true);
+        plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, (pl_vm_address_t) frame->pc);
+        if (image != NULL)
+            plcrash_async_find_symbol(&image->macho_image, plcrash_writer_image_symbol_strategy(writer, image), findContext, (pl_vm_address_t) frame->pc, plcrash_writer_visit_symbol_cb, &ctx);
+        plcrash_async_image_list_set_reading(image_list, false);
+
+        if (ctx.found)
+            return ctx.result;
+    }
+
+    if (frame->has_symbol && !frame->symbol_deferred)
+        return visitor->frame(frame_number, frame->pc, frame->symbol_name, frame->symbol_start, visitor->ctx);
+
+    return visitor->frame(frame_number, frame->pc, NULL, 0, visitor->ctx);
+}
+
+/**
+ * @internal
+ *
+ * Pass the captured thread in @a buffer to @a visitor.
+ */
+static bool plcrash_writer_visit_thread (plcrash_log_writer_t *writer, const plcrash_log_writer_visitor_t *visitor, plcrash_log_writer_thread_buffer_t *buffer,
+                                         thread_t thread, uint32_t thread_number, bool crashed, plcrash_async_image_list_t *image_list,
+                                         plcrash_async_symbol_cache_t *findContext)
+{
+    if (visitor->thread_begin != NULL && !visitor->thread_begin(thread_number, thread, crashed, visitor->ctx))
+        return false;
+
+    if (visitor->thread_register != NULL && buffer->has_registers) {
+        size_t reg_count = plcrash_async_thread_state_get_reg_count(&buffer->registers);
+        for (size_t i = 0; i < reg_count; i++) {
+            plcrash_greg_t value = plcrash_async_thread_state_has_reg(&buffer->registers, (plcrash_regnum_t) i) ? plcrash_async_thread_state_get_reg(&buffer->registers, (plcrash_regnum_t) i) : 0;
+            if (!visitor->thread_register(plcrash_async_thread_state_get_reg_name(&buffer->registers, (plcrash_regnum_t) i), value, visitor->ctx))
+                return false;
+        }
+    }
+
+    if (visitor->frame != NULL) {
+        for (uint32_t i = 0; i < buffer->frame_count; i++) {
+            if (!plcrash_writer_visit_frame(writer, visitor, i, &buffer->frames[i], image_list, findContext))
+                return false;
+        }
+    }
+
+    if (visitor->thread_end != NULL && !visitor->thread_end(thread_number, visitor->ctx))
+        return false;
+
+    return true;
+}
+
+/**
+ * Walk the crash state, passing the report's data to @a visitor rather than encoding a report. All other running
+ * threads are suspended for the duration of the walk.
+ *
+ * The signal and exception are visited first, followed by each thread (unwound and symbolicated as configured on
+ * @a writer, via the writer's preallocated thread buffer), and finally the loaded images. Output-specific writer
+ * options, such as packed encodings, prioritized output, and the capture pool, do not apply.
+ *
+ * @param writer The writer context.
+ * @param crashed_thread The crashed thread.
+ * @param image_list The current list of loaded binary images.
+ * @param visitor The visitor callbacks.
+ * @param siginfo Signal information.
+ * @param current_state If non-NULL, the given thread state will be used when walking the current thread. As with
+ * plcrash_log_writer_write(), this value <em>must</em> be provided if @a crashed_thread is the current thread, and the
+ * current thread is otherwise not visited.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOMEM if the writer's thread buffer is unavailable, or
+ * PLCRASH_EINTERNAL if the walk was aborted by the visitor.
+ */
+plcrash_error_t plcrash_log_writer_visit (plcrash_log_writer_t *writer,
+                                          thread_t crashed_thread,
+                                          plcrash_async_image_list_t *image_list,
+                                          const plcrash_log_writer_visitor_t *visitor,
+                                          plcrash_log_signal_info_t *siginfo,
+                                          plcrash_async_thread_state_t *current_state)
+{
+    thread_act_array_t threads = NULL;
+    mach_msg_type_number_t thread_count = 0;
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+
+    plcrash_log_writer_thread_buffer_t *buffer = writer->thread_buffer;
+    if (buffer == NULL)
+        return PLCRASH_ENOMEM;
+
+    /* Termination data */
+    if (visitor->signal != NULL && !visitor->signal(siginfo, visitor->ctx))
+        return PLCRASH_EINTERNAL;
+
+    if (visitor->exception != NULL && writer->uncaught_exception.has_exception) {
+        if (!visitor->exception(writer->uncaught_exception.name, writer->uncaught_exception.reason, visitor->ctx))
+            return PLCRASH_EINTERNAL;
+    }
+
+    /* Set up a symbol-finding context, unless a reusable cache was supplied. */
+    plcrash_async_symbol_cache_t localCache;
+    plcrash_async_symbol_cache_t *findContext = writer->symbol_cache;
+    if (findContext == NULL) {
+        if ((err = plcrash_async_symbol_cache_init(&localCache)) != PLCRASH_ESUCCESS)
+            return err;
+
+        findContext = &localCache;
+    }
+
+    /* Threads. As when writing a report, the current thread may only be walked if its state was supplied. */
+    bool include_stack = (pl_mach_thread_self() != crashed_thread || current_state != NULL);
+    if (include_stack && (visitor->thread_begin != NULL || visitor->thread_register != NULL || visitor->frame != NULL || visitor->thread_end != NULL)) {
+        bool all_threads = false;
+        if (!plcrash_writer_fetch_threads(writer, crashed_thread, &threads, &thread_count, &all_threads)) {
+            PLCF_DEBUG("Fetching thread list failed");
+            thread_count = 0;
+        }
+
+        plcrash_writer_suspend_threads(writer, threads, thread_count, all_threads);
+
+        uint32_t thread_number = 0;
+        for (mach_msg_type_number_t i = 0; i < thread_count && err == PLCRASH_ESUCCESS; i++) {
+            thread_t thread = threads[i];
+            bool crashed = (thread == crashed_thread);
+
+            if (plcrash_writer_is_helper_thread(writer, thread))
+                continue;
+
+            plcrash_async_thread_state_t *thr_ctx = NULL;
+            if (thread == pl_mach_thread_self()) {
+                if (current_state == NULL)
+                    continue;
+                thr_ctx = current_state;
+            }
+
+            plcrash_writer_capture_thread(buffer, writer, writer->task, thread, thr_ctx, image_list, findContext, crashed);
+            if (!plcrash_writer_visit_thread(writer, visitor, buffer, thread, thread_number, crashed, image_list, findContext))
+                err = PLCRASH_EINTERNAL;
+
+            thread_number++;
+        }
+
+        plcrash_writer_resume_threads(writer, threads, thread_count, all_threads);
+        plcrash_writer_release_threads(writer, threads, thread_count);
+    }
+
+    /* Images */
+    if (err == PLCRASH_ESUCCESS && visitor->image != NULL) {
+        plcrash_async_image_list_set_reading(image_list, true);
+
+        plcrash_async_image_t *image = NULL;
+        while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
+            if (!visitor->image(&image->macho_image, visitor->ctx)) {
+                err = PLCRASH_EINTERNAL;
+                break;
+            }
+        }
+
+        plcrash_async_image_list_set_reading(image_list, false);
+    }
+
+    if (findContext == &localCache)
+        plcrash_async_symbol_cache_free(&localCache);
+
+    return err;
+}
+
 /**
  * @} plcrash_log_writer
  */
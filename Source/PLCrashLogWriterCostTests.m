@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReport.h"
+#import "PLCrashLogWriter.h"
+#import "PLCrashAsyncImageList.h"
+#import "PLCrashAsyncMetrics.h"
+#import "PLCrashTestThread.h"
+
+#import <fcntl.h>
+#import <mach-o/dyld.h>
+
+/** Number of test threads spawned for each measurement. */
+#define COST_THREAD_COUNT 4
+
+/** Stack depth of the test threads in the shallow measurement. */
+#define COST_SHALLOW_DEPTH 8
+
+/** Stack depth of the test threads in the deep measurement. */
+#define COST_DEEP_DEPTH 64
+
+/*
+ * Upper bounds on the marginal crash-time cost of each additional frame and each additional thread. These are
+ * deliberately loose; they exist to catch order-of-magnitude regressions, such as a per-frame image scan or a
+ * per-frame write, rather than to track small changes.
+ */
+
+/** Maximum Mach traps per additional frame. */
+#define COST_FRAME_MAX_MACH_TRAPS 16
+
+/** Maximum memory reads per additional frame. */
+#define COST_FRAME_MAX_VM_READS 8
+
+/** Maximum memory objects mapped per additional frame. */
+#define COST_FRAME_MAX_MOBJECTS 1
+
+/** Maximum output writes per additional frame. */
+#define COST_FRAME_MAX_WRITES 1
+
+/** Maximum bytes allocated per additional frame. */
+#define COST_FRAME_MAX_ALLOC_BYTES 256
+
+/** Maximum Mach traps per additional thread. */
+#define COST_THREAD_MAX_MACH_TRAPS 128
+
+/** Maximum memory reads per additional thread. */
+#define COST_THREAD_MAX_VM_READS 64
+
+/** Maximum output writes per additional thread. */
+#define COST_THREAD_MAX_WRITES 4
+
+/** Maximum bytes allocated per additional thread. */
+#define COST_THREAD_MAX_ALLOC_BYTES 4096
+
+/**
+ * The measured cost of writing a single report.
+ */
+typedef struct crash_path_cost {
+    /** Task-wide Mach traps. */
+    int64_t mach_traps;
+
+    /** Memory reads, and the bytes requested. */
+    int64_t vm_reads;
+    int64_t vm_read_bytes;
+
+    /** Memory objects mapped. */
+    int64_t mobjects;
+
+    /** Output writes and flushes. */
+    int64_t writes;
+    int64_t flushes;
+
+    /** Allocations from async allocators, and the bytes allocated. */
+    int64_t allocs;
+    int64_t alloc_bytes;
+
+    /** The number of threads and frames in the written report. */
+    int64_t threads;
+    int64_t frames;
+} crash_path_cost_t;
+
+/* Fetch the current task's Mach trap count. */
+static integer_t cost_mach_traps (void) {
+    task_events_info_data_t info;
+    mach_msg_type_number_t count = TASK_EVENTS_INFO_COUNT;
+
+    if (task_info(mach_task_self(), TASK_EVENTS_INFO, (task_info_t) &info, &count) != KERN_SUCCESS)
+        return 0;
+
+    return info.syscalls_mach;
+}
+
+struct cost_report_context {
+    plcrash_log_writer_t *writer;
+    plcrash_async_file_t *file;
+    plcrash_async_image_list_t *images;
+    plcrash_log_signal_info_t *info;
+};
+
+static plcrash_error_t cost_report_callback (plcrash_async_thread_state_t *state, void *ctx) {
+    struct cost_report_context *cost_ctx = ctx;
+    return plcrash_log_writer_write(cost_ctx->writer, pl_mach_thread_self(), cost_ctx->images, cost_ctx->file, cost_ctx->info, state);
+}
+
+/**
+ * Verifies that the crash-time cost of writing a report, as measured by the async-safe instrumentation counters,
+ * grows no faster than a fixed bound per frame and per thread.
+ */
+@interface PLCrashLogWriterCostTests : SenTestCase {
+@private
+    /** Report path. */
+    NSString *_logPath;
+
+    /** Image list. */
+    plcrash_async_image_list_t _imageList;
+}
+@end
+
+@implementation PLCrashLogWriterCostTests
+
+- (void) setUp {
+    _logPath = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+
+    plcrash_nasync_image_list_init(&_imageList, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&_imageList, (uintptr_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    plcrash_nasync_metrics_enable();
+}
+
+- (void) tearDown {
+    plcrash_nasync_metrics_disable();
+    plcrash_nasync_image_list_free(&_imageList);
+
+    [[NSFileManager defaultManager] removeItemAtPath: _logPath error: NULL];
+    [_logPath release];
+}
+
+/**
+ * Write a report with @a threadCount test threads of @a depth additional frames each, populating @a cost with the
+ * counters accrued while writing it. Only plcrash_log_writer_write() and the final flush are measured; writer
+ * initialization and thread creation are excluded.
+ */
+- (void) measureReportWithThreads: (NSUInteger) threadCount depth: (unsigned int) depth cost: (crash_path_cost_t *) cost {
+    plcrash_test_thread_t threads[COST_THREAD_COUNT * 2];
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_metrics_t before, after;
+    NSError *error = nil;
+
+    STAssertTrue(threadCount <= sizeof(threads) / sizeof(threads[0]), @"Too many threads");
+
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    bsd_info.address = (void *) 0x42;
+    bsd_info.code = SEGV_MAPERR;
+    bsd_info.signo = SIGSEGV;
+    info.mach_info = NULL;
+    info.bsd_info = &bsd_info;
+
+    for (NSUInteger i = 0; i < threadCount; i++)
+        plcrash_test_thread_spawn_depth(&threads[i], depth);
+
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_TRUNC, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE, false), @"Initialization failed");
+
+    struct cost_report_context ctx = {
+        .writer = &writer,
+        .file = &file,
+        .images = &_imageList,
+        .info = &info
+    };
+
+    integer_t traps = cost_mach_traps();
+    plcrash_async_metrics_snapshot(&before);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_thread_state_current(cost_report_callback, &ctx), @"Writing crash log failed");
+    plcrash_async_file_flush(&file);
+
+    plcrash_async_metrics_snapshot(&after);
+    cost->mach_traps = cost_mach_traps() - traps;
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_async_file_close(&file);
+
+    for (NSUInteger i = 0; i < threadCount; i++)
+        plcrash_test_thread_stop(&threads[i]);
+
+#define COST_DELTA(_metric) ((int64_t) (after.values[_metric] - before.values[_metric]))
+    cost->vm_reads = COST_DELTA(PLCRASH_ASYNC_METRIC_VM_READ_COUNT);
+    cost->vm_read_bytes = COST_DELTA(PLCRASH_ASYNC_METRIC_VM_READ_BYTES);
+    cost->mobjects = COST_DELTA(PLCRASH_ASYNC_METRIC_MOBJECT_COUNT);
+    cost->writes = COST_DELTA(PLCRASH_ASYNC_METRIC_OUTPUT_COUNT);
+    cost->flushes = COST_DELTA(PLCRASH_ASYNC_METRIC_FLUSH_COUNT);
+    cost->allocs = COST_DELTA(PLCRASH_ASYNC_METRIC_ALLOC_COUNT);
+    cost->alloc_bytes = COST_DELTA(PLCRASH_ASYNC_METRIC_ALLOC_BYTES);
+#undef COST_DELTA
+
+    /* Count the threads and frames that were actually written */
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithContentsOfFile: _logPath error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+
+    cost->threads = 0;
+    cost->frames = 0;
+    for (PLCrashReportThreadInfo *thread in report.threads) {
+        cost->threads++;
+        cost->frames += [thread.stackFrames count];
+    }
+}
+
+/* Log the marginal cost of each counter between @a base and @a cost, per unit of @a units. */
+static void log_marginal_cost (NSString *name, const crash_path_cost_t *base, const crash_path_cost_t *cost, int64_t units) {
+    NSLog(@"[cost] per %@: %.1f mach traps, %.1f reads (%.0f bytes), %.2f mobjects, %.2f writes, %.2f flushes, %.2f allocations (%.0f bytes)",
+          name,
+          (double) (cost->mach_traps - base->mach_traps) / units,
+          (double) (cost->vm_reads - base->vm_reads) / units,
+          (double) (cost->vm_read_bytes - base->vm_read_bytes) / units,
+          (double) (cost->mobjects - base->mobjects) / units,
+          (double) (cost->writes - base->writes) / units,
+          (double) (cost->flushes - base->flushes) / units,
+          (double) (cost->allocs - base->allocs) / units,
+          (double) (cost->alloc_bytes - base->alloc_bytes) / units);
+}
+
+/**
+ * Verify that the cost of each additional frame is bounded.
+ */
+- (void) testPerFrameCost {
+    crash_path_cost_t shallow, deep;
+
+    [self measureReportWithThreads: COST_THREAD_COUNT depth: COST_SHALLOW_DEPTH cost: &shallow];
+    [self measureReportWithThreads: COST_THREAD_COUNT depth: COST_DEEP_DEPTH cost: &deep];
+
+    int64_t frames = deep.frames - shallow.frames;
+    STAssertTrue(frames >= (int64_t) (COST_THREAD_COUNT * (COST_DEEP_DEPTH - COST_SHALLOW_DEPTH)), @"Deep threads were not fully unwound (%lld additional frames)", (long long) frames);
+    if (frames <= 0)
+        return;
+
+    log_marginal_cost(@"frame", &shallow, &deep, frames);
+
+    STAssertTrue(deep.mach_traps - shallow.mach_traps <= COST_FRAME_MAX_MACH_TRAPS * frames, @"Mach traps per frame exceed the bound");
+    STAssertTrue(deep.vm_reads - shallow.vm_reads <= COST_FRAME_MAX_VM_READS * frames, @"Memory reads per frame exceed the bound");
+    STAssertTrue(deep.mobjects - shallow.mobjects <= COST_FRAME_MAX_MOBJECTS * frames, @"Memory objects per frame exceed the bound");
+    STAssertTrue(deep.writes - shallow.writes <= COST_FRAME_MAX_WRITES * frames, @"Writes per frame exceed the bound");
+    STAssertTrue(deep.alloc_bytes - shallow.alloc_bytes <= COST_FRAME_MAX_ALLOC_BYTES * frames, @"Bytes allocated per frame exceed the bound");
+}
+
+/**
+ * Verify that the cost of each additional thread is bounded.
+ */
+- (void) testPerThreadCost {
+    crash_path_cost_t few, many;
+
+    [self measureReportWithThreads: COST_THREAD_COUNT depth: COST_SHALLOW_DEPTH cost: &few];
+    [self measureReportWithThreads: COST_THREAD_COUNT * 2 depth: COST_SHALLOW_DEPTH cost: &many];
+
+    int64_t threads = many.threads - few.threads;
+    STAssertEquals(threads, (int64_t) COST_THREAD_COUNT, @"Incorrect number of additional threads written");
+    if (threads <= 0)
+        return;
+
+    /* The bounds below include each thread's frames */
+    int64_t frames_per_thread = (many.frames - few.frames) / threads;
+
+    log_marginal_cost(@"thread", &few, &many, threads);
+
+    STAssertTrue(many.mach_traps - few.mach_traps <= (COST_THREAD_MAX_MACH_TRAPS + COST_FRAME_MAX_MACH_TRAPS * frames_per_thread) * threads, @"Mach traps per thread exceed the bound");
+    STAssertTrue(many.vm_reads - few.vm_reads <= (COST_THREAD_MAX_VM_READS + COST_FRAME_MAX_VM_READS * frames_per_thread) * threads, @"Memory reads per thread exceed the bound");
+    STAssertTrue(many.writes - few.writes <= COST_THREAD_MAX_WRITES * threads, @"Writes per thread exceed the bound");
+    STAssertTrue(many.alloc_bytes - few.alloc_bytes <= (COST_THREAD_MAX_ALLOC_BYTES + COST_FRAME_MAX_ALLOC_BYTES * frames_per_thread) * threads, @"Bytes allocated per thread exceed the bound");
+}
+
+@end
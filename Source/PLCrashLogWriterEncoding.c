@@ -40,50 +40,23 @@ typedef enum {
 } PLProtobufCWireType;
 
 /* === get_packed_size() === */
+/* The size helpers are branch-free, and are used to compute message sizes without encoding the values; see
+ * plcrash_writer_pack_size(). */
 static inline size_t
 get_tag_size (unsigned number)
 {
-    if (number < (1<<4))
-        return 1;
-    else if (number < (1<<11))
-        return 2;
-    else if (number < (1<<18))
-        return 3;
-    else if (number < (1<<25))
-        return 4;
-    else
-        return 5;
+    return plprotobuf_c_varint_size (((uint64_t) number) << 3);
 }
 static inline size_t
 uint32_size (uint32_t v)
 {
-    if (v < (1<<7))
-        return 1;
-    else if (v < (1<<14))
-        return 2;
-    else if (v < (1<<21))
-        return 3;
-    else if (v < (1<<28))
-        return 4;
-    else
-        return 5;
+    return plprotobuf_c_varint_size (v);
 }
 static inline size_t
 int32_size (int32_t v)
 {
-    if (v < 0)
-        return 10;
-    else
-        if (v < (1<<7))
-            return 1;
-        else if (v < (1<<14))
-            return 2;
-        else if (v < (1<<21))
-            return 3;
-        else if (v < (1<<28))
-            return 4;
-        else
-            return 5;
+    /* Negative values are sign-extended to 64 bits */
+    return plprotobuf_c_varint_size ((uint64_t) (int64_t) v);
 }
 static inline uint32_t
 zigzag32 (int32_t v)
@@ -101,21 +74,7 @@ sint32_size (int32_t v)
 static inline size_t
 uint64_size (uint64_t v)
 {
-    uint32_t upper_v = (v>>32);
-    if (upper_v == 0)
-        return uint32_size ((uint32_t)v);
-    else if (upper_v < (1<<3))
-        return 5;
-    else if (upper_v < (1<<10))
-        return 6;
-    else if (upper_v < (1<<17))
-        return 7;
-    else if (upper_v < (1<<24))
-        return 8;
-    else if (upper_v < (1U<<31))
-        return 9;
-    else
-        return 10;
+    return plprotobuf_c_varint_size (v);
 }
 static inline uint64_t
 zigzag64 (int64_t v)
@@ -217,6 +176,19 @@ static inline size_t sint64_pack (int64_t value, uint8_t *out)
 {
     return uint64_pack (zigzag64 (value), out);
 }
+/* Encode value into out, which must provide MAX_UINT64_ENCODED_SIZE bytes. All ten bytes are written regardless of
+ * the encoded length, and the final byte's continuation bit is then cleared; the only data-dependent operation is
+ * the clz-based length computation, which keeps tight loops over many values free of unpredictable branches */
+static inline size_t
+uint64_pack_unchecked (uint64_t value, uint8_t *out)
+{
+    size_t rv = uint64_size (value);
+    for (unsigned i = 0; i < MAX_UINT64_ENCODED_SIZE - 1; i++)
+        out[i] = (uint8_t) (value >> (7 * i)) | 0x80;
+    out[MAX_UINT64_ENCODED_SIZE - 1] = (uint8_t) (value >> 63);
+    out[rv - 1] &= 0x7F;
+    return rv;
+}
 static inline size_t fixed32_pack (uint32_t value, uint8_t *out)
 {
 #if __LITTLE_ENDIAN__
@@ -252,6 +224,17 @@ static inline size_t string_pack (const char * str, uint8_t *out)
     return rv + len;
 }
 
+/* Encode value as a varint of exactly PLPROTOBUF_C_PADDED_LENGTH_SIZE bytes */
+static inline size_t padded_length_pack (uint32_t value, uint8_t *out)
+{
+    for (size_t i = 0; i < PLPROTOBUF_C_PADDED_LENGTH_SIZE - 1; i++) {
+        out[i] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    out[PLPROTOBUF_C_PADDED_LENGTH_SIZE - 1] = (uint8_t) value;
+    return PLPROTOBUF_C_PADDED_LENGTH_SIZE;
+}
+
 /* wire-type will be added in required_field_pack() */
 static size_t tag_pack (uint32_t id, uint8_t *out)
 {
@@ -261,11 +244,56 @@ static size_t tag_pack (uint32_t id, uint8_t *out)
         return uint64_pack (((uint64_t)id) << 3, out);
 }
 
+/* === get_packed_size() === */
+// Return the encoded size of the field, without encoding the value
+size_t plcrash_writer_pack_size (uint32_t field_id, PLProtobufCType field_type, const void *value) {
+    size_t rv = get_tag_size (field_id);
+    switch (field_type)
+    {
+        case PLPROTOBUF_C_TYPE_SINT32:
+            return rv + sint32_size (*(const int32_t *) value);
+        case PLPROTOBUF_C_TYPE_INT32:
+            return rv + int32_size (*(const int32_t *) value);
+        case PLPROTOBUF_C_TYPE_UINT32:
+        case PLPROTOBUF_C_TYPE_ENUM:
+            return rv + uint32_size (*(const uint32_t *) value);
+        case PLPROTOBUF_C_TYPE_SINT64:
+            return rv + sint64_size (*(const int64_t *) value);
+        case PLPROTOBUF_C_TYPE_INT64:
+        case PLPROTOBUF_C_TYPE_UINT64:
+            return rv + uint64_size (*(const uint64_t *) value);
+        case PLPROTOBUF_C_TYPE_SFIXED32:
+        case PLPROTOBUF_C_TYPE_FIXED32:
+        case PLPROTOBUF_C_TYPE_FLOAT:
+            return rv + 4;
+        case PLPROTOBUF_C_TYPE_SFIXED64:
+        case PLPROTOBUF_C_TYPE_FIXED64:
+        case PLPROTOBUF_C_TYPE_DOUBLE:
+            return rv + 8;
+        case PLPROTOBUF_C_TYPE_BOOL:
+            return rv + 1;
+        case PLPROTOBUF_C_TYPE_STRING:
+            return rv + plprotobuf_c_length_prefixed_size (strlen (value));
+        case PLPROTOBUF_C_TYPE_BYTES:
+            return rv + plprotobuf_c_length_prefixed_size (((const PLProtobufCBinaryData *) value)->len);
+        case PLPROTOBUF_C_TYPE_MESSAGE:
+            /* Only the header is written by plcrash_writer_pack() */
+            return rv + uint32_size (*(const uint32_t *) value);
+        default:
+            PLCF_DEBUG("Unhandled field type %d", field_type);
+            abort();
+    }
+}
+
 /* === pack_to_buffer() === */
-// file argument may be NULL
+// file argument may be NULL, in which case only the size is computed
 size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLProtobufCType field_type, const void *value) {
     size_t rv;
     uint8_t scratch[MAX_UINT64_ENCODED_SIZE * 2];
+
+    if (file == NULL)
+        return plcrash_writer_pack_size (field_id, field_type, value);
+
     rv = tag_pack (field_id, scratch);
     switch (field_type)
     {
@@ -366,3 +394,150 @@ size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLPro
     }
     return rv;
 }
+
+/* Return the encoded size of the fields of message, excluding any tag and length prefix. The size, and that of
+ * any embedded messages, is computed once and cached in the message */
+size_t plcrash_writer_message_size (plcrash_writer_message_t *message) {
+    if (message->sized)
+        return message->size;
+
+    size_t rv = 0;
+    for (size_t i = 0; i < message->field_count; i++) {
+        plcrash_writer_field_t *field = &message->fields[i];
+        if (field->value == NULL)
+            continue;
+
+        if (field->type == PLPROTOBUF_C_TYPE_MESSAGE) {
+            size_t size = plcrash_writer_message_size ((plcrash_writer_message_t *) field->value);
+            rv += get_tag_size (field->id) + plprotobuf_c_length_prefixed_size (size);
+        } else {
+            rv += plcrash_writer_pack_size (field->id, field->type, field->value);
+        }
+    }
+
+    message->size = rv;
+    message->sized = true;
+    return rv;
+}
+
+/* Write the fields of message, excluding any tag and length prefix.
+ * file argument may be NULL, in which case only the size is computed */
+size_t plcrash_writer_pack_message (plcrash_async_file_t *file, plcrash_writer_message_t *message) {
+    if (file == NULL)
+        return plcrash_writer_message_size (message);
+
+    size_t rv = 0;
+    for (size_t i = 0; i < message->field_count; i++) {
+        plcrash_writer_field_t *field = &message->fields[i];
+        if (field->value == NULL)
+            continue;
+
+        if (field->type == PLPROTOBUF_C_TYPE_MESSAGE) {
+            rv += plcrash_writer_pack_embedded_message (file, field->id, (plcrash_writer_message_t *) field->value);
+        } else {
+            rv += plcrash_writer_pack (file, field->id, field->type, field->value);
+        }
+    }
+
+    return rv;
+}
+
+/* Write message as the embedded message field field_id, using its cached size as the length prefix.
+ * file argument may be NULL, in which case only the size is computed */
+size_t plcrash_writer_pack_embedded_message (plcrash_async_file_t *file, uint32_t field_id, plcrash_writer_message_t *message) {
+    uint32_t size = (uint32_t) plcrash_writer_message_size (message);
+    size_t rv = plcrash_writer_pack (file, field_id, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+
+    if (file == NULL)
+        return rv + size;
+
+    return rv + plcrash_writer_pack_message (file, message);
+}
+
+/* Write a single zigzag-encoded element of a packed repeated sint64 field, without a field tag.
+ * file argument may be NULL */
+size_t plcrash_writer_pack_sint64_element (plcrash_async_file_t *file, int64_t value) {
+    uint8_t scratch[MAX_UINT64_ENCODED_SIZE];
+    if (file == NULL)
+        return sint64_size (value);
+
+    size_t rv = sint64_pack (value, scratch);
+    if (file != NULL)
+        plcrash_async_file_write(file, scratch, rv);
+    return rv;
+}
+
+/* Write the tag of the embedded message field field_id, followed by a zero-valued length prefix of
+ * PLPROTOBUF_C_PADDED_LENGTH_SIZE bytes. Once the message has been written, the prefix must be completed via
+ * plcrash_writer_patch_length(), allowing a message to be written without first being sized. The file must be
+ * patchable, as per plcrash_async_file_patchable(); the prefix's position is returned via position */
+size_t plcrash_writer_pack_length_placeholder (plcrash_async_file_t *file, uint32_t field_id, off_t *position) {
+    uint8_t scratch[MAX_UINT64_ENCODED_SIZE + PLPROTOBUF_C_PADDED_LENGTH_SIZE];
+
+    size_t rv = tag_pack (field_id, scratch);
+    scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED;
+    *position = file->position + rv;
+
+    rv += padded_length_pack (0, scratch + rv);
+    plcrash_async_file_write(file, scratch, rv);
+    return rv;
+}
+
+/* Complete a length prefix written by plcrash_writer_pack_length_placeholder() at position with length. Returns
+ * false if the file could not be patched */
+bool plcrash_writer_patch_length (plcrash_async_file_t *file, off_t position, uint32_t length) {
+    uint8_t scratch[PLPROTOBUF_C_PADDED_LENGTH_SIZE];
+
+    padded_length_pack (length, scratch);
+    return plcrash_async_file_patch (file, position, scratch, sizeof(scratch));
+}
+
+/* Encode a single varint element of a packed repeated uint64 field, without a field tag, into buffer. At most
+ * 10 bytes are written. buffer argument may be NULL, in which case only the size is computed */
+size_t plcrash_writer_pack_uint64_element (uint8_t *buffer, uint64_t value) {
+    if (buffer == NULL)
+        return uint64_size (value);
+
+    return uint64_pack (value, buffer);
+}
+
+/* Encode count values as consecutive elements of a packed repeated uint64 field, without a field tag, into buffer.
+ * buffer must provide count * PLPROTOBUF_C_VARINT_MAX_SIZE bytes; bytes beyond the returned length are scratch.
+ * buffer argument may be NULL, in which case only the size is computed */
+size_t plcrash_writer_pack_uint64_elements (uint8_t *buffer, const uint64_t *values, size_t count) {
+    size_t rv = 0;
+
+    if (buffer == NULL) {
+        for (size_t i = 0; i < count; i++)
+            rv += uint64_size (values[i]);
+        return rv;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        rv += uint64_pack_unchecked (values[i], buffer + rv);
+    return rv;
+}
+
+/* Encode count values as consecutive zigzag-encoded elements of a packed repeated sint64 field, each element being
+ * the difference from its predecessor; the first is relative to *prev, and *prev is updated to the final value, so
+ * that a sequence may be encoded in chunks. buffer must provide count * PLPROTOBUF_C_VARINT_MAX_SIZE bytes. buffer
+ * argument may be NULL, in which case only the size is computed */
+size_t plcrash_writer_pack_sint64_delta_elements (uint8_t *buffer, const uint64_t *values, size_t count, uint64_t *prev) {
+    uint64_t last = *prev;
+    size_t rv = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        /* Branch-free zigzag encoding */
+        int64_t delta = (int64_t) (values[i] - last);
+        uint64_t encoded = ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63);
+        last = values[i];
+
+        if (buffer == NULL)
+            rv += uint64_size (encoded);
+        else
+            rv += uint64_pack_unchecked (encoded, buffer + rv);
+    }
+
+    *prev = last;
+    return rv;
+}
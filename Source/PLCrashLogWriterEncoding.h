@@ -49,7 +49,93 @@ typedef struct PLProtobufCBinaryData {
     void *data;
 } PLProtobufCBinaryData;
 
+/**
+ * Return the encoded size of the varint @a v. This is branch-free; each encoded byte carries 7 bits of the value,
+ * and (bits * 9 + 64) / 64 is equal to ceil(bits / 7) for all bit counts from 1 through 64.
+ */
+static inline size_t plprotobuf_c_varint_size (uint64_t v) {
+    size_t bits = 64 - __builtin_clzll(v | 1);
+    return (bits * 9 + 64) / 64;
+}
+
+/**
+ * Return the encoded size of a length-prefixed value of @a len bytes, excluding the field tag.
+ */
+static inline size_t plprotobuf_c_length_prefixed_size (size_t len) {
+    return plprotobuf_c_varint_size(len) + len;
+}
+
+/**
+ * The maximum encoded size of a single varint. Buffers passed to plcrash_writer_pack_uint64_elements() and
+ * plcrash_writer_pack_sint64_delta_elements() must provide this many bytes per element.
+ */
+#define PLPROTOBUF_C_VARINT_MAX_SIZE 10
+
+/**
+ * The size of a padded length prefix, as written by plcrash_writer_pack_length_placeholder(). Any 32-bit length may be
+ * encoded as a varint of this size by setting the continuation bit of all but the final byte.
+ */
+#define PLPROTOBUF_C_PADDED_LENGTH_SIZE 5
+
+/**
+ * Return the encoded size of the tag of field @a id. This is a constant expression, and may be used to compute the
+ * size of fixed-shape messages at compile time.
+ */
+#define PLPROTOBUF_C_TAG_SIZE(id) ((id) < (1 << 4) ? 1 : (id) < (1 << 11) ? 2 : (id) < (1 << 18) ? 3 : (id) < (1 << 25) ? 4 : 5)
+
+/**
+ * A single field of a message described by a plcrash_writer_message_t.
+ */
+typedef struct plcrash_writer_field {
+    /** The field's tag number. */
+    uint32_t id;
+
+    /** The field's wire type. */
+    PLProtobufCType type;
+
+    /** The field value, in the form accepted by plcrash_writer_pack(), or NULL if the field is not present. For
+     * PLPROTOBUF_C_TYPE_MESSAGE fields, this must instead be a pointer to the plcrash_writer_message_t describing the
+     * embedded message. */
+    const void *value;
+} plcrash_writer_field_t;
+
+/**
+ * A message described as a table of its fields. The message's encoded size is computed from the table at most
+ * once, and is then reused both for its length prefix and by any enclosing message.
+ *
+ * The table and any field values are owned by the caller, and must remain valid until the message has been written.
+ * No allocation is performed, and a message may be sized and written from a signal handler.
+ */
+typedef struct plcrash_writer_message {
+    /** The message's fields, in the order in which they will be written. */
+    plcrash_writer_field_t *fields;
+
+    /** The number of entries in @a fields. */
+    size_t field_count;
+
+    /** The encoded size of the message's fields; valid only if @a sized is true. */
+    size_t size;
+
+    /** If true, @a size has been computed. */
+    bool sized;
+} plcrash_writer_message_t;
+
+/**
+ * Initialize a plcrash_writer_message_t with the fields defined by the array @a fields.
+ */
+#define PLCRASH_WRITER_MESSAGE_INIT(fields) { (fields), sizeof(fields) / sizeof((fields)[0]), 0, false }
+
+size_t plcrash_writer_pack_size (uint32_t field_id, PLProtobufCType field_type, const void *value);
 size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLProtobufCType field_type, const void *value);
+size_t plcrash_writer_message_size (plcrash_writer_message_t *message);
+size_t plcrash_writer_pack_message (plcrash_async_file_t *file, plcrash_writer_message_t *message);
+size_t plcrash_writer_pack_embedded_message (plcrash_async_file_t *file, uint32_t field_id, plcrash_writer_message_t *message);
+size_t plcrash_writer_pack_sint64_element (plcrash_async_file_t *file, int64_t value);
+size_t plcrash_writer_pack_uint64_element (uint8_t *buffer, uint64_t value);
+size_t plcrash_writer_pack_uint64_elements (uint8_t *buffer, const uint64_t *values, size_t count);
+size_t plcrash_writer_pack_sint64_delta_elements (uint8_t *buffer, const uint64_t *values, size_t count, uint64_t *prev);
+size_t plcrash_writer_pack_length_placeholder (plcrash_async_file_t *file, uint32_t field_id, off_t *position);
+bool plcrash_writer_patch_length (plcrash_async_file_t *file, off_t position, uint32_t length);
     
 #ifdef __cplusplus
 }
@@ -29,6 +29,7 @@
 #import "GTMSenTestCase.h"
 #import "PLCrashAsync.h"
 #import "PLCrashLogWriterEncoding.h"
+#import "PLCrashAsyncProtobufReader.h"
 
 #import "protobuf-c.h"
 #import "PLCrashLogWriterEncodingTests.pb-c.h"
@@ -134,6 +135,44 @@ TEST_PACK(EncoderTest__Enum, enum_, enum, ENCODER_TEST__ENUM__Value2, 14, PLPROT
     STAssertTrue((memcmp(et->bytes.data, bytes, sizeof(bytes)) == 0), @"Did not encode correct value");
 }
 
+/* Verify that the computed sizes match the encoded sizes across the varint length boundaries */
+- (void) testPackSize {
+    uint8_t buffer[64];
+    plcrash_async_file_t file;
+
+    for (unsigned int bit = 0; bit < 64; bit++) {
+        uint64_t values[] = { (1ULL << bit) - 1, 1ULL << bit };
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            uint64_t u64 = values[i];
+            int64_t s64 = -(int64_t) values[i];
+            uint32_t u32 = (uint32_t) values[i];
+            int32_t s32 = (int32_t) -values[i];
+
+            #define CHECK_SIZE(id, type, value) do { \
+                plcrash_async_file_init_buffer(&file, -1, 0, buffer, sizeof(buffer)); \
+                size_t written = plcrash_writer_pack(&file, id, type, value); \
+                STAssertEquals(written, file.buflen, @"Incorrect returned size for " # type); \
+                STAssertEquals(plcrash_writer_pack_size(id, type, value), file.buflen, @"Incorrect computed size for " # type); \
+                STAssertEquals(plcrash_writer_pack(NULL, id, type, value), file.buflen, @"Incorrect sizing pass for " # type); \
+            } while (0)
+
+            CHECK_SIZE(1, PLPROTOBUF_C_TYPE_UINT64, &u64);
+            CHECK_SIZE(2, PLPROTOBUF_C_TYPE_SINT64, &s64);
+            CHECK_SIZE(3, PLPROTOBUF_C_TYPE_INT32, &s32);
+            CHECK_SIZE(16, PLPROTOBUF_C_TYPE_UINT32, &u32);
+            CHECK_SIZE(2048, PLPROTOBUF_C_TYPE_SINT32, &s32);
+            CHECK_SIZE(1 << 20, PLPROTOBUF_C_TYPE_FIXED64, &u64);
+
+            #undef CHECK_SIZE
+
+            STAssertEquals(plprotobuf_c_varint_size(u64), plcrash_writer_pack_size(1, PLPROTOBUF_C_TYPE_UINT64, &u64) - 1, @"Incorrect varint size");
+        }
+    }
+
+    STAssertEquals((size_t) 1, (size_t) PLPROTOBUF_C_TAG_SIZE(15), @"Incorrect tag size");
+    STAssertEquals((size_t) 2, (size_t) PLPROTOBUF_C_TAG_SIZE(16), @"Incorrect tag size");
+}
+
 - (void) testPackString {
     const char *str = "cafe";
     plcrash_writer_pack(&_file, 16, PLPROTOBUF_C_TYPE_STRING, str);
@@ -153,4 +192,135 @@ TEST_PACK(EncoderTest__Enum, enum_, enum, ENCODER_TEST__ENUM__Value2, 14, PLPROT
     STAssertTrue(strcmp(et->string, str) == 0, @"Did not encode correct value");
 }
 
+/* Verify that table-described messages are written as their individual fields, and that an embedded message's
+ * cached size matches its encoded length. */
+- (void) testPackMessage {
+    uint64_t u64 = 0xCAFEF00D;
+    int32_t s32 = -42;
+    const char *str = "cafe";
+
+    plcrash_writer_field_t inner_fields[] = {
+        { 7, PLPROTOBUF_C_TYPE_UINT64, &u64 },
+        { 3, PLPROTOBUF_C_TYPE_SINT32, &s32 },
+        { 2, PLPROTOBUF_C_TYPE_UINT32, NULL },
+    };
+    plcrash_writer_message_t inner = PLCRASH_WRITER_MESSAGE_INIT(inner_fields);
+
+    /* The embedded message is encoded in the bytes field, which shares its wire type */
+    plcrash_writer_field_t outer_fields[] = {
+        { 16, PLPROTOBUF_C_TYPE_STRING, str },
+        { 15, PLPROTOBUF_C_TYPE_MESSAGE, &inner },
+    };
+    plcrash_writer_message_t outer = PLCRASH_WRITER_MESSAGE_INIT(outer_fields);
+
+    size_t size = plcrash_writer_pack_message(NULL, &outer);
+    STAssertEquals(plcrash_writer_pack_message(&_file, &outer), size, @"Incorrect returned size");
+    STAssertTrue(plcrash_async_file_flush(&_file), @"Failed to flush file");
+
+    NSData *data = [NSData dataWithContentsOfFile: _filePath];
+    STAssertNotNil(data, @"Failed to load encoded data");
+    if (data == nil)
+        return;
+    STAssertEquals([data length], size, @"Computed size does not match the encoded length");
+
+    EncoderTest *et = encoder_test__unpack(&protobuf_c_system_allocator, [data length], [data bytes]);
+    STAssertNotNULL(et, @"Failed to decode test data");
+    if (et == NULL)
+        return;
+
+    STAssertTrue(et->string != NULL && strcmp(et->string, str) == 0, @"Did not encode correct string value");
+    STAssertTrue(et->has_bytes, @"Did not encode the embedded message");
+    STAssertEquals(et->bytes.len, plcrash_writer_message_size(&inner), @"Incorrect embedded message length");
+
+    EncoderTest *embedded = encoder_test__unpack(&protobuf_c_system_allocator, et->bytes.len, et->bytes.data);
+    STAssertNotNULL(embedded, @"Failed to decode embedded message");
+    if (embedded == NULL) {
+        protobuf_c_message_free_unpacked((ProtobufCMessage *) et, &protobuf_c_system_allocator);
+        return;
+    }
+
+    STAssertTrue(embedded->has_uint64 && embedded->uint64 == u64, @"Did not encode correct uint64 value");
+    STAssertTrue(embedded->has_sint32 && embedded->sint32 == s32, @"Did not encode correct sint32 value");
+    STAssertFalse(embedded->has_uint32, @"Encoded an absent field");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) embedded, &protobuf_c_system_allocator);
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) et, &protobuf_c_system_allocator);
+}
+
+/* Verify that the bulk varint kernels match the single-element encoding, and round-trip through the bulk decoder */
+- (void) testPackVarintElements {
+    uint64_t values[130];
+    uint8_t expected[sizeof(values) / sizeof(values[0]) * PLPROTOBUF_C_VARINT_MAX_SIZE];
+    uint8_t encoded[sizeof(expected)];
+    size_t count = sizeof(values) / sizeof(values[0]);
+
+    /* Cover every varint length boundary, in both directions for the delta encoding */
+    for (unsigned int bit = 0; bit < 64; bit++) {
+        values[bit * 2] = (1ULL << bit) - 1;
+        values[bit * 2 + 1] = 1ULL << bit;
+    }
+    values[128] = UINT64_MAX;
+    values[129] = 0;
+
+    size_t expected_length = 0;
+    for (size_t i = 0; i < count; i++)
+        expected_length += plcrash_writer_pack_uint64_element(expected + expected_length, values[i]);
+
+    STAssertEquals(plcrash_writer_pack_uint64_elements(NULL, values, count), expected_length, @"Incorrect computed size");
+    STAssertEquals(plcrash_writer_pack_uint64_elements(encoded, values, count), expected_length, @"Incorrect encoded size");
+    STAssertTrue(memcmp(encoded, expected, expected_length) == 0, @"Bulk encoding does not match the element encoding");
+
+    /* Decode in chunks that do not align with the varint boundaries */
+    plcrash_async_pb_reader_t reader;
+    uint64_t decoded[7];
+    size_t decoded_count;
+    size_t total = 0;
+    plcrash_error_t err;
+
+    plcrash_async_pb_reader_init(&reader, encoded, expected_length);
+    while ((err = plcrash_async_pb_reader_next_varints(&reader, decoded, sizeof(decoded) / sizeof(decoded[0]), &decoded_count)) == PLCRASH_ESUCCESS) {
+        for (size_t i = 0; i < decoded_count && total + i < count; i++)
+            STAssertEquals(decoded[i], values[total + i], @"Incorrect decoded value at %zu", total + i);
+        total += decoded_count;
+    }
+    STAssertEquals(err, PLCRASH_ENOTFOUND, @"Decoding failed");
+    STAssertEquals(total, count, @"Incorrect decoded count");
+
+    /* Zigzag delta encoding, split across calls */
+    uint64_t prev = 0;
+    expected_length = 0;
+    for (size_t i = 0; i < count; i++) {
+        expected_length += plcrash_writer_pack_sint64_element(NULL, (int64_t) (values[i] - prev));
+        prev = values[i];
+    }
+
+    prev = 0;
+    size_t length = plcrash_writer_pack_sint64_delta_elements(encoded, values, 50, &prev);
+    STAssertEquals(prev, values[49], @"Previous value not updated");
+    length += plcrash_writer_pack_sint64_delta_elements(encoded + length, values + 50, count - 50, &prev);
+    STAssertEquals(length, expected_length, @"Incorrect delta encoded size");
+
+    uint64_t pc = 0;
+    total = 0;
+    plcrash_async_pb_reader_init(&reader, encoded, length);
+    while ((err = plcrash_async_pb_reader_next_varints(&reader, decoded, sizeof(decoded) / sizeof(decoded[0]), &decoded_count)) == PLCRASH_ESUCCESS) {
+        for (size_t i = 0; i < decoded_count && total + i < count; i++) {
+            pc += (uint64_t) plcrash_async_pb_zigzag_decode(decoded[i]);
+            STAssertEquals(pc, values[total + i], @"Incorrect delta decoded value at %zu", total + i);
+        }
+        total += decoded_count;
+    }
+    STAssertEquals(err, PLCRASH_ENOTFOUND, @"Delta decoding failed");
+    STAssertEquals(total, count, @"Incorrect delta decoded count");
+
+    /* Truncated data must be rejected */
+    uint64_t max = UINT64_MAX;
+    length = plcrash_writer_pack_uint64_elements(encoded, &max, 1);
+    plcrash_async_pb_reader_init(&reader, encoded, length - 1);
+    while ((err = plcrash_async_pb_reader_next_varints(&reader, decoded, sizeof(decoded) / sizeof(decoded[0]), &decoded_count)) == PLCRASH_ESUCCESS)
+        continue;
+    STAssertEquals(err, PLCRASH_EINVAL, @"Truncated data was not rejected");
+}
+
 @end
+
@@ -32,6 +32,7 @@
 #import "PLCrashFrameWalker.h"
 #import "PLCrashAsyncImageList.h"
 #import "PLCrashReport.h"
+#import "PLCrashReportIntegrity.h"
 
 #import <sys/stat.h>
 #import <sys/mman.h>
@@ -46,6 +47,231 @@
 
 #import "PLCrashSysctl.h"
 
+#import "PLCrashFrameCompactUnwind.h"
+#import "PLCrashFrameDWARFUnwind.h"
+#import "PLCrashFrameStackUnwind.h"
+
+#import <mach/mach_time.h>
+
+/** Number of benchmark test threads to spawn. */
+#define BENCHMARK_THREAD_COUNT 8
+
+/** Minimum number of stack frames to be pushed by each benchmark test thread. */
+#define BENCHMARK_STACK_DEPTH 32
+
+/**
+ * Default number of iterations for each benchmark. This may be overridden via the PLCRASH_BENCHMARK_ITERATIONS
+ * environment variable when measuring report generation latency; the default favors a fast test run.
+ */
+#define BENCHMARK_DEFAULT_ITERATIONS 1
+
+/**
+ * Default maximum number of synthetic images loaded by the image count scaling benchmark. This may be overridden via the
+ * PLCRASH_BENCHMARK_MAX_IMAGES environment variable; the default favors a fast test run.
+ */
+#define BENCHMARK_DEFAULT_MAX_IMAGES 100
+
+/** Number of image lookups performed per image count by the image count scaling benchmark. */
+#define BENCHMARK_IMAGE_LOOKUPS 10000
+
+/**
+ * Benchmark measurement sample.
+ */
+typedef struct benchmark_sample {
+    /** Wall time at the start of the sample, in mach_absolute_time() units. */
+    uint64_t start_time;
+
+    /** Total task Mach syscall count at the start of the sample. */
+    integer_t start_mach_syscalls;
+
+    /** Total task Unix syscall count at the start of the sample. */
+    integer_t start_unix_syscalls;
+} benchmark_sample_t;
+
+/* Fetch the current task's syscall counts. */
+static void benchmark_syscall_counts (integer_t *mach_syscalls, integer_t *unix_syscalls) {
+    task_events_info_data_t info;
+    mach_msg_type_number_t count = TASK_EVENTS_INFO_COUNT;
+
+    if (task_info(mach_task_self(), TASK_EVENTS_INFO, (task_info_t) &info, &count) != KERN_SUCCESS) {
+        *mach_syscalls = 0;
+        *unix_syscalls = 0;
+        return;
+    }
+
+    *mach_syscalls = info.syscalls_mach;
+    *unix_syscalls = info.syscalls_unix;
+}
+
+/* Begin a benchmark sample */
+static void benchmark_begin (benchmark_sample_t *sample) {
+    benchmark_syscall_counts(&sample->start_mach_syscalls, &sample->start_unix_syscalls);
+    sample->start_time = mach_absolute_time();
+}
+
+/* Complete a benchmark sample, logging the per-iteration results. */
+static void benchmark_end (benchmark_sample_t *sample, NSString *name, NSUInteger iterations, off_t bytes) {
+    uint64_t end_time = mach_absolute_time();
+    integer_t mach_syscalls;
+    integer_t unix_syscalls;
+    benchmark_syscall_counts(&mach_syscalls, &unix_syscalls);
+
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    uint64_t nsec = ((end_time - sample->start_time) * timebase.numer) / timebase.denom;
+
+    /* Note that syscall counts are task-wide, and will include any concurrent activity within the test process */
+    NSLog(@"[benchmark] %@: %.1f us/iteration, %.1f mach syscalls/iteration, %.1f unix syscalls/iteration, %lld bytes/iteration (%lu iterations)",
+          name,
+          (double) nsec / 1000.0 / iterations,
+          (double) (mach_syscalls - sample->start_mach_syscalls) / iterations,
+          (double) (unix_syscalls - sample->start_unix_syscalls) / iterations,
+          (long long) bytes / (long long) iterations,
+          (unsigned long) iterations);
+}
+
+/* Return the mach_absolute_time() interval from @a start to now, in nanoseconds. */
+static uint64_t benchmark_elapsed_ns (uint64_t start) {
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    return ((mach_absolute_time() - start) * timebase.numer) / timebase.denom;
+}
+
+/**
+ * Return the total in-memory size of the loaded image at @a header, measured from the start of its __TEXT segment to
+ * the end of its final segment, and the size of its __TEXT segment in @a text_size.
+ */
+static vm_size_t benchmark_image_span (const struct mach_header *header, vm_size_t *text_size) {
+#ifdef __LP64__
+    typedef struct segment_command_64 segment_t;
+    const uint32_t segment_cmd = LC_SEGMENT_64;
+    const struct load_command *cmd = (const struct load_command *) (((const struct mach_header_64 *) header) + 1);
+#else
+    typedef struct segment_command segment_t;
+    const uint32_t segment_cmd = LC_SEGMENT;
+    const struct load_command *cmd = (const struct load_command *) (header + 1);
+#endif
+    uint64_t text_vmaddr = 0;
+    uint64_t end = 0;
+
+    *text_size = 0;
+    for (uint32_t i = 0; i < header->ncmds; i++, cmd = (const struct load_command *) ((const uint8_t *) cmd + cmd->cmdsize)) {
+        if (cmd->cmd != segment_cmd)
+            continue;
+
+        const segment_t *segment = (const segment_t *) cmd;
+        if (strcmp(segment->segname, SEG_TEXT) == 0) {
+            text_vmaddr = segment->vmaddr;
+            *text_size = (vm_size_t) segment->vmsize;
+        }
+
+        if (segment->vmsize > 0 && segment->vmaddr + segment->vmsize > end)
+            end = segment->vmaddr + segment->vmsize;
+    }
+
+    return (vm_size_t) (end - text_vmaddr);
+}
+
+/**
+ * Report visitor counts, as recorded by the visitor_* callbacks.
+ */
+typedef struct visitor_counts {
+    uint32_t signals;
+    uint32_t threads;
+    uint32_t crashed_threads;
+    uint32_t open_threads;
+    uint32_t frames;
+    uint32_t registers;
+    uint32_t images;
+} visitor_counts_t;
+
+static bool visitor_signal (const plcrash_log_signal_info_t *siginfo, void *ctx) {
+    ((visitor_counts_t *) ctx)->signals++;
+    return true;
+}
+
+static bool visitor_thread_begin (uint32_t thread_number, thread_t thread, bool crashed, void *ctx) {
+    visitor_counts_t *counts = ctx;
+    counts->threads++;
+    counts->open_threads++;
+    if (crashed)
+        counts->crashed_threads++;
+    return true;
+}
+
+static bool visitor_thread_register (const char *name, plcrash_greg_t value, void *ctx) {
+    ((visitor_counts_t *) ctx)->registers++;
+    return true;
+}
+
+static bool visitor_frame (uint32_t frame_number, uint64_t pc, const char *symbol_name, uint64_t symbol_start, void *ctx) {
+    ((visitor_counts_t *) ctx)->frames++;
+    return true;
+}
+
+static bool visitor_thread_end (uint32_t thread_number, void *ctx) {
+    ((visitor_counts_t *) ctx)->open_threads--;
+    return true;
+}
+
+static bool visitor_image (plcrash_async_macho_t *image, void *ctx) {
+    ((visitor_counts_t *) ctx)->images++;
+    return true;
+}
+
+/* Abort the walk at the first image */
+static bool visitor_image_abort (plcrash_async_macho_t *image, void *ctx) {
+    return false;
+}
+
+/**
+ * Faux crash data, reporting a thread as having crashed with SIGSEGV/EXC_BAD_ACCESS at 0x42.
+ */
+typedef struct faux_crash {
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    plcrash_log_mach_signal_info_t mach_info;
+    mach_exception_data_type_t mach_codes[2];
+
+    /** The crashed thread. */
+    thread_t thread;
+
+    /** The crashed thread's state. */
+    plcrash_async_thread_state_t thread_state;
+} faux_crash_t;
+
+/* Initialize faux crash data for @a thread */
+static void faux_crash_init (faux_crash_t *crash, thread_t thread) {
+    crash->bsd_info.address = (void *) 0x42;
+    crash->bsd_info.code = SEGV_MAPERR;
+    crash->bsd_info.signo = SIGSEGV;
+
+    crash->mach_info.type = EXC_BAD_ACCESS;
+    crash->mach_info.code = crash->mach_codes;
+    crash->mach_info.code_count = sizeof(crash->mach_codes) / sizeof(crash->mach_codes[0]);
+    crash->mach_codes[0] = KERN_PROTECTION_FAILURE;
+    crash->mach_codes[1] = 0x42;
+
+    crash->info.mach_info = &crash->mach_info;
+    crash->info.bsd_info = &crash->bsd_info;
+
+    /* Steal the thread's stack for iteration */
+    crash->thread = thread;
+    plcrash_async_thread_state_mach_thread_init(&crash->thread_state, thread);
+}
+
+/* Initialize @a image_list with all images currently loaded by dyld */
+static void image_list_init_loaded (plcrash_async_image_list_t *image_list) {
+    plcrash_nasync_image_list_init(image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
+}
+
+/**
+ * Writer configuration block, called with the initialized writer and image list prior to writing a report.
+ */
+typedef void (^writer_config_t)(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list);
+
 @interface PLCrashLogWriterTests : SenTestCase {
 @private
     /* Path to crash log */
@@ -208,6 +434,12 @@
              * first created -- its initial state is 0, and it has a suspend count of 1. */
             if (j > 0)
                 STAssertNotEquals((uint64_t)0, f->pc, @"Backtrace includes NULL pc");
+
+            /* Symbols are captured separately from the frame PC; verify that they were correctly associated */
+            if (f->symbol != NULL) {
+                STAssertNotNULL(f->symbol->name, @"Symbol is missing a name");
+                STAssertTrue(f->symbol->start_address <= f->pc, @"Symbol start address is greater than the frame PC");
+            }
         }
     }
 
@@ -266,7 +498,7 @@
     STAssertTrue([data length] > sizeof(struct PLCrashReportFileHeader), @"File is too small for magic + version + data");
     // verifies correct byte ordering of the file magic
     STAssertTrue(memcmp(header->magic, PLCRASH_REPORT_FILE_MAGIC, strlen(PLCRASH_REPORT_FILE_MAGIC)) == 0, @"File header is not 'plcrash', is: '%s'", (const char *) &header->magic);
-    STAssertEquals(header->version, (uint8_t) PLCRASH_REPORT_FILE_VERSION, @"File version is not equal to 0");
+    STAssertTrue(header->version >= PLCRASH_REPORT_FILE_VERSION && header->version <= PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS, @"Unsupported file version %u", header->version);
     
     /* Try to read the crash report */
     Plcrash__CrashReport *crashReport;
@@ -278,52 +510,82 @@
     return crashReport;
 }
 
-
-- (void) testWriteReport {
-    plframe_cursor_t cursor;
+/**
+ * Write a report for the faux crash of @a thread to _logPath, returning the decoded report, or NULL on failure. The
+ * returned report must be freed by the caller.
+ *
+ * @param thread The thread to be reported as crashed.
+ * @param file The output file, opened on _logPath, or NULL to write to _logPath without an output limit. The file will
+ * be closed prior to returning.
+ * @param strategy The symbolication strategy to be used by the writer.
+ * @param userRequested If true, the report will be marked as a user requested (live) report.
+ * @param configure If non-nil, called with the initialized writer and image list prior to writing the report.
+ */
+- (Plcrash__CrashReport *) writeReportForThread: (thread_t) thread
+                                           file: (plcrash_async_file_t *) file
+                                       strategy: (plcrash_async_symbol_strategy_t) strategy
+                                  userRequested: (BOOL) userRequested
+                                  configuration: (writer_config_t) configure
+{
     plcrash_log_writer_t writer;
-    plcrash_async_file_t file;
+    plcrash_async_file_t default_file;
     plcrash_async_image_list_t image_list;
-    plcrash_async_thread_state_t thread_state;
-    thread_t thread;
+    faux_crash_t crash;
 
-    /* Initialize the image list */
-    plcrash_nasync_image_list_init(&image_list, mach_task_self());
-    for (uint32_t i = 0; i < _dyld_image_count(); i++)
-        plcrash_nasync_image_list_append(&image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
+    image_list_init_loaded(&image_list);
+    faux_crash_init(&crash, thread);
 
-    /* Initialze faux crash data */
-    plcrash_log_signal_info_t info;
-    plcrash_log_bsd_signal_info_t bsd_info;
-    plcrash_log_mach_signal_info_t mach_info;
-    mach_exception_data_type_t mach_codes[2];
-    {
-        bsd_info.address = (void *) 0x42;
-        bsd_info.code = SEGV_MAPERR;
-        bsd_info.signo = SIGSEGV;
-        
-        mach_info.type = EXC_BAD_ACCESS;
-        mach_info.code = mach_codes;
-        mach_info.code_count = sizeof(mach_codes) / sizeof(mach_codes[0]);
-        mach_codes[0] = KERN_PROTECTION_FAILURE;
-        mach_codes[1] = 0x42;
-    
-        info.mach_info = &mach_info;
-        info.bsd_info = &bsd_info;
-        
-        /* Steal the test thread's stack for iteration */
-        thread = pthread_mach_thread_np(_thr_args.thread);
-        plframe_cursor_thread_init(&cursor, mach_task_self(), thread, &image_list);
-        plcrash_async_thread_state_mach_thread_init(&thread_state, thread);
+    /* Open the output file */
+    if (file == NULL) {
+        [[NSFileManager defaultManager] removeItemAtPath: _logPath error: NULL];
+        int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+        plcrash_async_file_init(&default_file, fd, 0);
+        file = &default_file;
     }
 
-    /* Open the output file */
-    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
-    plcrash_async_file_init(&file, fd, 0);
+    /* Initialize and configure the writer */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", strategy, userRequested), @"Initialization failed");
+    if (configure != nil)
+        configure(&writer, &image_list);
+
+    /* Write the crash report */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crash.thread, &image_list, file, &crash.info, &crash.thread_state), @"Crash log failed");
+
+    /* Close it */
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+
+    /* Flush the output */
+    plcrash_async_file_flush(file);
+    plcrash_async_file_close(file);
+
+    return [self loadReport];
+}
+
+/* Write a report for the faux crash of the test thread with the given symbolication strategy; see
+ * -writeReportForThread:file:strategy:userRequested:configuration:. */
+- (Plcrash__CrashReport *) writeReportWithStrategy: (plcrash_async_symbol_strategy_t) strategy configuration: (writer_config_t) configure {
+    return [self writeReportForThread: pthread_mach_thread_np(_thr_args.thread) file: NULL strategy: strategy userRequested: NO configuration: configure];
+}
+
+
+/* Verify that the static report messages are pre-encoded at initialization, and survive a refresh. */
+- (void) testStaticSections {
+    plcrash_log_writer_t writer;
 
-    /* Initialize a writer */
     STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+    STAssertNotNULL(writer.static_sections, @"Static messages were not pre-encoded");
 
+    /* The OS data is unchanged; the refresh should be a no-op */
+    void *sections = writer.static_sections;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_refresh_system_info(&writer), @"Refresh failed");
+    STAssertEquals(sections, (void *) writer.static_sections, @"Sections were re-encoded despite unchanged OS data");
+
+    plcrash_log_writer_free(&writer);
+}
+
+- (void) testWriteReport {
     /* Set an exception with a valid return address call stack. */
     NSException *e;
     @try {
@@ -332,22 +594,10 @@
     @catch (NSException *exception) {
         e = exception;
     }
-    plcrash_log_writer_set_exception(&writer, e);
-
-    /* Write the crash report */
-    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, thread, &image_list, &file, &info, &thread_state), @"Crash log failed");
-
-    /* Close it */
-    plcrash_log_writer_close(&writer);
-    plcrash_log_writer_free(&writer);
-    plcrash_nasync_image_list_free(&image_list);
 
-    /* Flush the output */
-    plcrash_async_file_flush(&file);
-    plcrash_async_file_close(&file);
-
-    /* Load and validate the written report */
-    Plcrash__CrashReport *crashReport = [self loadReport];
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        plcrash_log_writer_set_exception(writer, e);
+    }];
     STAssertNotNULL(crashReport, @"Failed to load report");
     if (crashReport == NULL)
         return;
@@ -384,17 +634,12 @@
     STAssertEquals((uint64_t) 0x42, crashReport->signal->mach_exception->codes[1], @"code[1] incorrect");
 
 
-    /* Validate the 'crashed' flag is on a thread with the expected PC. */
-    uint64_t expectedPC;
-#if __x86_64__
-    expectedPC = cursor.frame.thread_state.x86_state.thread.uts.ts64.__rip;
-#elif __i386__
-    expectedPC = cursor.frame.thread_state.x86_state.thread.uts.ts32.__eip;
-#elif __arm__
-    expectedPC = cursor.frame.thread_state.arm_state.thread.__pc;
-#else
-#error Unsupported Platform
-#endif
+    /* Validate the 'crashed' flag is on a thread with the expected PC. The test thread is parked, and its state
+     * is unchanged since the report was written. */
+    plcrash_async_thread_state_t thread_state;
+    plcrash_async_thread_state_mach_thread_init(&thread_state, pthread_mach_thread_np(_thr_args.thread));
+    uint64_t expectedPC = plcrash_async_thread_state_get_reg(&thread_state, PLCRASH_REG_IP);
+
     BOOL foundCrashed = NO;
     for (int i = 0; i < crashReport->n_threads; i++) {
         Plcrash__CrashReport__Thread *thread = crashReport->threads[i];        
@@ -415,8 +660,1174 @@
     STAssertTrue(foundCrashed, @"No thread marked as crashed");
  
     /* Clean up */
-    plframe_cursor_free(&cursor);
     protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
 }
 
+/**
+ * Test writing a report with parallel thread capture enabled.
+ */
+- (void) testWriteReportParallelCapture {
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_parallel_capture(writer, 2), @"Failed to enable parallel capture");
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    [self checkThreads: crashReport];
+
+    /* Verify thread ordering and crashed status */
+    BOOL foundCrashed = NO;
+    for (int i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        STAssertEquals((uint32_t) i, t->thread_number, @"Threads were not written in order");
+
+        if (t->crashed)
+            foundCrashed = YES;
+    }
+    STAssertTrue(foundCrashed, @"No thread marked as crashed");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/**
+ * Test writing a live report with pipelined symbolication enabled.
+ */
+- (void) testWriteReportSymbolicationPipeline {
+    Plcrash__CrashReport *crashReport = [self writeReportForThread: pthread_mach_thread_np(_thr_args.thread)
+                                                              file: NULL
+                                                          strategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL
+                                                     userRequested: YES
+                                                     configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list)
+    {
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_symbolication_pipeline(writer), @"Failed to enable the symbolication pipeline");
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    [self checkThreads: crashReport];
+
+    /* The crashed thread's frames must have been symbolicated */
+    BOOL foundSymbol = NO;
+    for (int i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        if (!t->crashed)
+            continue;
+
+        for (size_t j = 0; j < t->n_frames; j++) {
+            if (t->frames[j]->symbol != NULL)
+                foundSymbol = YES;
+        }
+    }
+    STAssertTrue(foundSymbol, @"The crashed thread was not symbolicated");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/**
+ * Test writing a report with fast capture of non-crashed threads enabled.
+ */
+- (void) testWriteReportFastCapture {
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        plcrash_log_writer_set_fast_capture(writer, true);
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* Only the crashed thread may include registers or symbols */
+    BOOL foundCrashed = NO;
+    for (int i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        if (t->crashed) {
+            foundCrashed = YES;
+            STAssertNotEquals((size_t) 0, t->n_registers, @"Crashed thread is missing registers");
+            continue;
+        }
+
+        STAssertEquals((size_t) 0, t->n_registers, @"Non-crashed thread includes registers");
+        for (size_t j = 0; j < t->n_frames; j++)
+            STAssertNULL(t->frames[j]->symbol, @"Fast-captured frame was symbolicated");
+    }
+    STAssertTrue(foundCrashed, @"No thread marked as crashed");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/**
+ * Test that enabling instrumentation writes the report's generation measurements.
+ */
+- (void) testWriteReportInstrumentation {
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        plcrash_log_writer_enable_instrumentation(writer);
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    Plcrash__CrashReport__Instrumentation *instrumentation = crashReport->instrumentation;
+    STAssertNotNULL(instrumentation, @"Missing instrumentation");
+    if (instrumentation != NULL) {
+        STAssertTrue(instrumentation->unwind_time > 0, @"Unwinding was not timed");
+        STAssertTrue(instrumentation->symtab_lookup_time > 0, @"Symbol lookup was not timed");
+        STAssertTrue(instrumentation->vm_read_count > 0, @"Memory reads were not counted");
+        STAssertTrue(instrumentation->output_count > 0, @"Output writes were not counted");
+    }
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/* Write a report for a thread of @a depth recursive frames with the given frame configuration, returning the decoded
+ * thread, or NULL on failure. The returned report must be freed by the caller. */
+- (Plcrash__CrashReport *) writeRecursiveReportWithDepth: (unsigned int) depth
+                                               maxFrames: (uint32_t) maxFrames
+                                                compress: (bool) compress
+                                                  thread: (Plcrash__CrashReport__Thread **) outThread
+{
+    plcrash_test_thread_t recursive;
+
+    /* Spawn a thread with a deep recursive stack, and mark it as crashed */
+    plcrash_test_thread_spawn_depth(&recursive, depth);
+
+    Plcrash__CrashReport *crashReport = [self writeReportForThread: pthread_mach_thread_np(recursive.thread)
+                                                              file: NULL
+                                                          strategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL
+                                                     userRequested: NO
+                                                     configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list)
+    {
+        plcrash_log_writer_set_max_thread_frames(writer, maxFrames);
+        plcrash_log_writer_set_frame_compression(writer, compress);
+    }];
+
+    plcrash_test_thread_stop(&recursive);
+
+    /* Find the crashed thread */
+    *outThread = NULL;
+    if (crashReport == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        if (crashReport->threads[i]->crashed)
+            *outThread = crashReport->threads[i];
+    }
+    STAssertNotNULL(*outThread, @"No thread marked as crashed");
+
+    return crashReport;
+}
+
+/**
+ * Test that recursive frames are collapsed into a repeated frame group, and that stacks exceeding the frame limit
+ * retain their innermost and outermost frames.
+ */
+- (void) testWriteReportRecursion {
+    Plcrash__CrashReport *crashReport;
+    Plcrash__CrashReport__Thread *thread;
+
+    /* Compressed; the recursion must be collapsed to a single group */
+    crashReport = [self writeRecursiveReportWithDepth: 200 maxFrames: 512 compress: true thread: &thread];
+    if (thread != NULL) {
+        STAssertTrue(thread->n_frames < 200, @"Recursive frames were not collapsed (%lu frames)", (unsigned long) thread->n_frames);
+
+        BOOL foundGroup = NO;
+        for (size_t i = 0; i < thread->n_frames; i++) {
+            Plcrash__CrashReport__Thread__StackFrame *frame = thread->frames[i];
+            if (frame->has_repeat_count && frame->repeat_count > 1) {
+                foundGroup = YES;
+                STAssertTrue(frame->has_repeat_length && frame->repeat_length > 0, @"Repeated group is missing its length");
+            }
+        }
+        STAssertTrue(foundGroup, @"No repeated frame group was written");
+    }
+    if (crashReport != NULL)
+        protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* Uncompressed and truncated; the gap must be recorded */
+    crashReport = [self writeRecursiveReportWithDepth: 200 maxFrames: 32 compress: false thread: &thread];
+    if (thread != NULL) {
+        STAssertEquals((size_t) 32, thread->n_frames, @"Frame limit was not applied");
+
+        uint64_t omitted = 0;
+        for (size_t i = 0; i < thread->n_frames; i++) {
+            if (thread->frames[i]->has_omitted_frame_count) {
+                STAssertEquals((size_t) 16, i, @"Omitted frames were not recorded between the innermost and outermost frames");
+                omitted = thread->frames[i]->omitted_frame_count;
+            }
+        }
+        STAssertTrue(omitted >= 200 - 32, @"Omitted frame count was not recorded");
+    }
+    if (crashReport != NULL)
+        protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/**
+ * Test writing a report with the symbol name table enabled.
+ */
+- (void) testWriteReportSymbolTable {
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_symbol_table(writer), @"Failed to enable the symbol table");
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* Validate the file version */
+    NSData *data = [NSData dataWithContentsOfFile: _logPath];
+    const struct PLCrashReportFileHeader *header = [data bytes];
+    STAssertEquals((uint8_t) PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE, header->version, @"Incorrect file version");
+
+    /* Symbols must reference unique table entries */
+    STAssertTrue(crashReport->n_symbol_names > 0, @"No symbol names were written");
+    for (size_t i = 0; i < crashReport->n_symbol_names; i++) {
+        for (size_t j = i + 1; j < crashReport->n_symbol_names; j++)
+            STAssertTrue(strcmp(crashReport->symbol_names[i], crashReport->symbol_names[j]) != 0, @"Duplicate symbol name %s", crashReport->symbol_names[i]);
+    }
+
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        for (size_t j = 0; j < t->n_frames; j++) {
+            Plcrash__CrashReport__Symbol *symbol = t->frames[j]->symbol;
+            if (symbol == NULL)
+                continue;
+
+            STAssertNULL(symbol->name, @"Symbol name written inline");
+            STAssertTrue(symbol->has_name_index && symbol->name_index < crashReport->n_symbol_names, @"Invalid symbol name index");
+        }
+    }
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* The names must be resolved when decoded */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+
+    BOOL foundSymbol = NO;
+    for (PLCrashReportThreadInfo *threadInfo in report.threads) {
+        for (PLCrashReportStackFrameInfo *frameInfo in threadInfo.stackFrames) {
+            if (frameInfo.symbolInfo != nil) {
+                foundSymbol = YES;
+                STAssertNotNil(frameInfo.symbolInfo.symbolName, @"Symbol name was not resolved");
+            }
+        }
+    }
+    STAssertTrue(foundSymbol, @"No symbolicated frames were decoded");
+}
+
+- (void) testWriteReportPackedRegisters {
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        plcrash_log_writer_enable_packed_registers(writer);
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* Validate the file version */
+    NSData *data = [NSData dataWithContentsOfFile: _logPath];
+    const struct PLCrashReportFileHeader *header = [data bytes];
+    STAssertEquals((uint8_t) PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS, header->version, @"Incorrect file version");
+
+    /* Registers must be packed, and the register set recorded */
+    STAssertTrue(crashReport->has_register_set, @"Register set was not written");
+
+    plcrash_async_thread_state_t thread_state;
+    plcrash_async_thread_state_mach_thread_init(&thread_state, pthread_mach_thread_np(_thr_args.thread));
+
+    size_t regCount = plcrash_async_thread_state_get_reg_count(&thread_state);
+    BOOL foundCrashed = NO;
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        STAssertEquals((size_t) 0, t->n_registers, @"Named registers were written");
+
+        if (!t->crashed)
+            continue;
+
+        foundCrashed = YES;
+        STAssertTrue(t->has_register_values, @"Crashed thread register values were not written");
+        STAssertEquals(regCount * sizeof(uint64_t), t->register_values.len, @"Incorrect packed register length");
+    }
+    STAssertTrue(foundCrashed, @"No crashed thread was written");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* The register names must be resolved when decoded */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+
+    for (PLCrashReportThreadInfo *threadInfo in report.threads) {
+        if (!threadInfo.crashed)
+            continue;
+
+        STAssertEquals(regCount, (size_t) [threadInfo.registers count], @"Incorrect decoded register count");
+        for (size_t i = 0; i < [threadInfo.registers count]; i++) {
+            PLCrashReportRegisterInfo *regInfo = [threadInfo.registers objectAtIndex: i];
+            const char *name = plcrash_async_thread_state_get_reg_name(&thread_state, (plcrash_regnum_t) i);
+            STAssertEqualStrings([NSString stringWithUTF8String: name], regInfo.registerName, @"Incorrect register name");
+        }
+    }
+}
+
+- (void) testWriteReportPackedFrames {
+    /* Use a non-symbolicating writer */
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        plcrash_log_writer_enable_packed_frames(writer);
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* Validate the file version */
+    NSData *data = [NSData dataWithContentsOfFile: _logPath];
+    const struct PLCrashReportFileHeader *header = [data bytes];
+    STAssertEquals((uint8_t) PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES, header->version, @"Incorrect file version");
+
+    /* The crashed thread's frames must be packed */
+    BOOL foundCrashed = NO;
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        if (!t->crashed)
+            continue;
+
+        foundCrashed = YES;
+        STAssertTrue(t->has_frame_pcs && t->frame_pcs.len > 0, @"Crashed thread frames were not packed");
+        STAssertEquals((size_t) 0, t->n_frames, @"Frame messages were written");
+    }
+    STAssertTrue(foundCrashed, @"No crashed thread was written");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* The frames must be expanded when decoded, starting at the crashed thread's PC */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+
+    plcrash_async_thread_state_t thread_state;
+    plcrash_async_thread_state_mach_thread_init(&thread_state, pthread_mach_thread_np(_thr_args.thread));
+
+    for (PLCrashReportThreadInfo *threadInfo in report.threads) {
+        if (!threadInfo.crashed)
+            continue;
+
+        STAssertTrue([threadInfo.stackFrames count] > 0, @"No frames were decoded");
+        PLCrashReportStackFrameInfo *frameInfo = [threadInfo.stackFrames objectAtIndex: 0];
+        STAssertEquals((uint64_t) plcrash_async_thread_state_get_reg(&thread_state, PLCRASH_REG_IP), frameInfo.instructionPointer, @"Incorrect first frame PC");
+        STAssertNil(frameInfo.symbolInfo, @"Packed frames must not be symbolicated");
+    }
+}
+
+/* Test that reports written with backpatched length prefixes decode normally, including prefixes patched after
+ * their bytes have been flushed to disk */
+- (void) testWriteReportLengthBackpatching {
+    plcrash_async_file_t file;
+    char buffer[64];
+
+    /* Open the output file; the small buffer ensures that most placeholders are flushed prior to being patched */
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+    plcrash_async_file_init_buffer(&file, fd, 0, buffer, sizeof(buffer));
+    STAssertTrue(plcrash_async_file_patchable(&file), @"The output file should be patchable");
+
+    Plcrash__CrashReport *crashReport = [self writeReportForThread: pthread_mach_thread_np(_thr_args.thread)
+                                                              file: &file
+                                                          strategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL
+                                                     userRequested: NO
+                                                     configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list)
+    {
+        plcrash_log_writer_enable_length_backpatching(writer);
+    }];
+
+    /* All threads must decode, including the crashed thread's frames */
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    STAssertTrue(crashReport->n_threads > 0, @"No threads were written");
+
+    BOOL foundCrashed = NO;
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        if (!t->crashed)
+            continue;
+
+        foundCrashed = YES;
+        STAssertTrue(t->n_frames > 0, @"No frames were written for the crashed thread");
+    }
+    STAssertTrue(foundCrashed, @"No crashed thread was written");
+    STAssertNotNULL(crashReport->signal, @"No signal was written following the threads");
+    STAssertNotNULL(crashReport->system_info, @"No system info was written");
+
+    /* The integrity trailer must reflect the patched lengths */
+    STAssertNotNULL(crashReport->integrity, @"No integrity trailer was written");
+    NSData *data = [NSData dataWithContentsOfFile: _logPath];
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_report_verify_integrity([data bytes], [data length], true), @"Integrity verification failed");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/* Test that threads with identical stacks are written as references, and restored when decoded */
+- (void) testWriteReportThreadDeduplication {
+    /* Spawn two additional threads that will be parked with identical stacks */
+    plcrash_test_thread_t idle_threads[2];
+    for (size_t i = 0; i < sizeof(idle_threads) / sizeof(idle_threads[0]); i++)
+        plcrash_test_thread_spawn(&idle_threads[i]);
+
+    /* Use a non-symbolicating writer */
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_thread_deduplication(writer), @"Could not enable thread deduplication");
+    }];
+
+    for (size_t i = 0; i < sizeof(idle_threads) / sizeof(idle_threads[0]); i++)
+        plcrash_test_thread_stop(&idle_threads[i]);
+
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* Validate the file version */
+    NSData *data = [NSData dataWithContentsOfFile: _logPath];
+    const struct PLCrashReportFileHeader *header = [data bytes];
+    STAssertEquals((uint8_t) PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS, header->version, @"Incorrect file version");
+
+    /* At least one of the idle threads must reference an earlier thread, and the crashed thread must be written in full */
+    NSMutableDictionary *duplicates = [NSMutableDictionary dictionary];
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        if (t->crashed)
+            STAssertFalse(t->has_duplicate_of_thread, @"The crashed thread was deduplicated");
+
+        if (t->has_duplicate_of_thread) {
+            STAssertEquals((size_t) 0, t->n_frames, @"Frames were written for a deduplicated thread");
+            [duplicates setObject: [NSNumber numberWithUnsignedInt: t->duplicate_of_thread] forKey: [NSNumber numberWithUnsignedInt: t->thread_number]];
+        }
+    }
+    STAssertTrue([duplicates count] > 0, @"No threads were deduplicated");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* The frames must be restored when decoded */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+
+    NSMutableDictionary *threadsByNumber = [NSMutableDictionary dictionary];
+    for (PLCrashReportThreadInfo *threadInfo in report.threads)
+        [threadsByNumber setObject: threadInfo forKey: [NSNumber numberWithInteger: threadInfo.threadNumber]];
+
+    for (NSNumber *number in duplicates) {
+        PLCrashReportThreadInfo *duplicate = [threadsByNumber objectForKey: number];
+        PLCrashReportThreadInfo *original = [threadsByNumber objectForKey: [duplicates objectForKey: number]];
+        STAssertNotNil(original, @"Deduplicated thread references a missing thread");
+
+        STAssertTrue([duplicate.stackFrames count] > 0, @"No frames were restored");
+        STAssertEquals([original.stackFrames count], [duplicate.stackFrames count], @"Incorrect frame count");
+        for (NSUInteger i = 0; i < [duplicate.stackFrames count]; i++) {
+            STAssertEquals([[original.stackFrames objectAtIndex: i] instructionPointer], [[duplicate.stackFrames objectAtIndex: i] instructionPointer], @"Incorrect frame PC");
+        }
+    }
+}
+
+/* Test writing of threads recorded as having also crashed */
+- (void) testWriteReportSecondaryCrash {
+    /* Spawn an additional thread to be recorded as having also crashed */
+    plcrash_test_thread_t secondary_thread;
+    plcrash_test_thread_spawn(&secondary_thread);
+
+    thread_t secondary = pthread_mach_thread_np(secondary_thread.thread);
+    plcrash_async_thread_state_t secondary_state;
+    plcrash_async_thread_state_mach_thread_init(&secondary_state, secondary);
+
+    /* Record the secondary crash */
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertTrue(plcrash_log_writer_add_secondary_crash(writer, secondary, &secondary_state), @"Could not record the secondary crash");
+    }];
+
+    plcrash_test_thread_stop(&secondary_thread);
+
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport != NULL)
+        protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* Exactly one thread, other than the crashed thread, must be marked as having also crashed */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: [NSData dataWithContentsOfFile: _logPath] error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+
+    NSUInteger alsoCrashed = 0;
+    for (PLCrashReportThreadInfo *threadInfo in report.threads) {
+        if (!threadInfo.alsoCrashed)
+            continue;
+
+        alsoCrashed++;
+        STAssertFalse(threadInfo.crashed, @"The crashed thread was marked as having also crashed");
+        STAssertTrue([threadInfo.stackFrames count] > 0, @"No frames were written for the secondary crashed thread");
+    }
+    STAssertEquals((NSUInteger) 1, alsoCrashed, @"Incorrect number of secondary crashed threads");
+}
+
+/* Test walking the crash state via plcrash_log_writer_visit() */
+- (void) testVisit {
+    plcrash_log_writer_t writer;
+    plcrash_async_image_list_t image_list;
+    faux_crash_t crash;
+
+    image_list_init_loaded(&image_list);
+    faux_crash_init(&crash, pthread_mach_thread_np(_thr_args.thread));
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE, false), @"Initialization failed");
+
+    /* Walk the crash state */
+    visitor_counts_t counts;
+    memset(&counts, 0, sizeof(counts));
+
+    plcrash_log_writer_visitor_t visitor = {
+        .signal = visitor_signal,
+        .thread_begin = visitor_thread_begin,
+        .thread_register = visitor_thread_register,
+        .frame = visitor_frame,
+        .thread_end = visitor_thread_end,
+        .image = visitor_image,
+        .ctx = &counts
+    };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_visit(&writer, crash.thread, &image_list, &visitor, &crash.info, &crash.thread_state), @"Visit failed");
+
+    STAssertEquals(counts.signals, (uint32_t) 1, @"Signal was not visited exactly once");
+    STAssertTrue(counts.threads > 0, @"No threads were visited");
+    STAssertEquals(counts.crashed_threads, (uint32_t) 1, @"Crashed thread was not visited exactly once");
+    STAssertEquals(counts.open_threads, (uint32_t) 0, @"Thread begin and end callbacks were not balanced");
+    STAssertTrue(counts.frames >= counts.threads, @"Missing frames");
+    STAssertTrue(counts.registers > 0, @"No registers were visited");
+    STAssertEquals(counts.images, (uint32_t) _dyld_image_count(), @"Incorrect image count");
+
+    /* Verify that a visitor may abort the walk */
+    plcrash_log_writer_visitor_t abort_visitor = { .image = visitor_image_abort, .ctx = NULL };
+    STAssertEquals(PLCRASH_EINTERNAL, plcrash_log_writer_visit(&writer, crash.thread, &image_list, &abort_visitor, &crash.info, &crash.thread_state), @"Visit was not aborted");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+}
+
+/* Test writing of the crashed thread's stack memory */
+- (void) testWriteReportStackMemory {
+    /* Capture only the crashed thread's stack memory */
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_stack_memory(writer, 4096, 0), @"Could not enable stack memory capture");
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    plcrash_async_thread_state_t thread_state;
+    plcrash_async_thread_state_mach_thread_init(&thread_state, pthread_mach_thread_np(_thr_args.thread));
+
+    /* Only the crashed thread's memory is written */
+    STAssertEquals((size_t) 1, crashReport->n_stack_memory, @"Incorrect stack memory count");
+    if (crashReport->n_stack_memory == 1) {
+        Plcrash__CrashReport__StackMemory *memory = crashReport->stack_memory[0];
+        STAssertEquals((uint64_t) plcrash_async_thread_state_get_reg(&thread_state, PLCRASH_REG_SP), memory->address, @"Incorrect stack memory address");
+        STAssertTrue(memory->length > 0 && memory->length <= 4096, @"Incorrect stack memory length");
+        STAssertTrue(memory->thread_number < crashReport->n_threads && crashReport->threads[memory->thread_number]->crashed, @"Stack memory was not captured from the crashed thread");
+    }
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* The suppressed zero runs must be restored when decoded */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: [NSData dataWithContentsOfFile: _logPath] error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+    STAssertEquals((NSUInteger) 1, [report.stackMemory count], @"Incorrect stack memory count");
+
+    PLCrashReportStackMemoryInfo *memoryInfo = [report.stackMemory lastObject];
+    STAssertTrue([memoryInfo.data length] > 0 && [memoryInfo.data length] <= 4096, @"Incorrect stack memory length");
+}
+
+/* Test writing of the memory referenced by the crashed thread's registers */
+- (void) testWriteReportRegisterMemory {
+    const size_t budget = 2048;
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_register_memory(writer, budget), @"Could not enable register memory capture");
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* The stack pointer always references readable memory */
+    STAssertTrue(crashReport->n_register_memory > 0, @"No register memory was written");
+
+    /* Regions must be sorted, must not overlap, and must fit within the budget */
+    uint64_t prev_end = 0;
+    size_t total = 0;
+    for (size_t i = 0; i < crashReport->n_register_memory; i++) {
+        Plcrash__CrashReport__MemoryRegion *region = crashReport->register_memory[i];
+        STAssertTrue(region->address >= prev_end, @"Register memory regions overlap");
+        STAssertTrue(region->data.len > 0, @"Empty register memory region");
+
+        prev_end = region->address + region->data.len;
+        total += region->data.len;
+    }
+    STAssertTrue(total <= budget, @"Register memory exceeds the budget");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* Verify decoding */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: [NSData dataWithContentsOfFile: _logPath] error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+    STAssertTrue([report.registerMemory count] > 0, @"No register memory was decoded");
+}
+
+/* Test writing of a bounded VM region summary */
+- (void) testWriteReportVMRegionSummary {
+    /* Use a region limit small enough to be reached by any process */
+    const uint32_t max_regions = 4;
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertEquals(PLCRASH_EINVAL, plcrash_log_writer_enable_vm_region_summary(writer, 0, 0), @"A zero region limit was accepted");
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_vm_region_summary(writer, max_regions, 0), @"Could not enable the VM region summary");
+        STAssertEquals(PLCRASH_EINVAL, plcrash_log_writer_enable_vm_region_summary(writer, max_regions, 0), @"The VM region summary was enabled twice");
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    STAssertNotNULL(crashReport->vm_region_summary, @"No VM region summary was written");
+    if (crashReport->vm_region_summary != NULL) {
+        STAssertEquals(crashReport->vm_region_summary->region_count, max_regions, @"Incorrect region count");
+        STAssertTrue(crashReport->vm_region_summary->truncated, @"The region limit was reached, but the summary is not marked as truncated");
+    }
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* Verify decoding; regions must be sorted, non-empty, and must not overlap */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: [NSData dataWithContentsOfFile: _logPath] error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+    STAssertEquals([report.vmRegions count], (NSUInteger) max_regions, @"Incorrect number of decoded regions");
+    STAssertTrue(report.vmRegionSummaryTruncated, @"Truncation was not decoded");
+
+    uint64_t prev_end = 0;
+    for (PLCrashReportVMRegionInfo *region in report.vmRegions) {
+        STAssertTrue(region.address >= prev_end, @"VM regions overlap");
+        STAssertTrue(region.size > 0, @"Empty VM region");
+        STAssertEquals(region.protection & ~region.maxProtection, (uint32_t) 0, @"Protection exceeds the maximum protection");
+        prev_end = region.address + region.size;
+    }
+}
+
+/* Test writing of registered custom data regions */
+- (void) testWriteReportCustomData {
+    __block plcrash_custom_data_registry_t registry;
+
+    /* Register a large, consistent region, and a region that is mid-update */
+    static uint8_t state[64 * 1024];
+    memset(state, 0xAB, sizeof(state));
+    uint32_t state_version = 2;
+
+    const char *pending = "pending";
+    uint32_t pending_version = 3;
+
+    uint32_t handle;
+    plcrash_nasync_custom_data_registry_init(&registry);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_custom_data_register(&registry, "state", state, sizeof(state), &state_version, &handle), @"Failed to register region");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_custom_data_register(&registry, "pending", pending, strlen(pending), &pending_version, &handle), @"Failed to register region");
+
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        plcrash_log_writer_set_custom_data(writer, &registry);
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport != NULL)
+        protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* Verify decoding */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: [NSData dataWithContentsOfFile: _logPath] error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+    STAssertEquals((NSUInteger) 2, [report.customData count], @"Incorrect custom data count");
+    if ([report.customData count] != 2)
+        return;
+
+    PLCrashReportCustomData *stateData = [report.customData objectAtIndex: 0];
+    STAssertEqualStrings(@"state", stateData.identifier, @"Incorrect identifier");
+    STAssertEqualObjects([NSData dataWithBytes: state length: sizeof(state)], stateData.data, @"Incorrect data");
+    STAssertTrue(stateData.hasVersion, @"Version was not written");
+    STAssertEquals((uint32_t) 2, stateData.version, @"Incorrect version");
+    STAssertFalse(stateData.torn, @"Consistent region must not be marked as torn");
+
+    PLCrashReportCustomData *pendingData = [report.customData objectAtIndex: 1];
+    STAssertEqualStrings(@"pending", pendingData.identifier, @"Incorrect identifier");
+    STAssertTrue(pendingData.torn, @"Region with an odd version must be marked as torn");
+}
+
+/* Test that reports written with an image manifest omit the manifest's images, and record any removed images */
+- (void) testWriteReportImageManifest {
+    __block plcrash_log_writer_image_manifest_t *manifest = NULL;
+    __block void *manifest_data = NULL;
+    __block size_t manifest_length = 0;
+    __block pl_vm_address_t removed = 0;
+
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        /* Generate the manifest; the same images must always produce the same manifest */
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_image_manifest_create(image_list, &manifest, &manifest_data, &manifest_length), @"Failed to create manifest");
+        STAssertEquals((size_t) _dyld_image_count(), manifest->count, @"Incorrect manifest image count");
+        STAssertEquals(manifest->identifier, plcrash_log_writer_image_manifest_identifier(manifest_data, manifest_length), @"Incorrect manifest identifier");
+
+        {
+            plcrash_log_writer_image_manifest_t *repeat;
+            void *repeat_data;
+            size_t repeat_length;
+            STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_image_manifest_create(image_list, &repeat, &repeat_data, &repeat_length), @"Failed to create manifest");
+            STAssertEquals(manifest->identifier, repeat->identifier, @"Manifest identifier is not stable");
+            plcrash_log_writer_image_manifest_free(repeat);
+            free(repeat_data);
+        }
+
+        /* Unload an image after the manifest was generated */
+        removed = (pl_vm_address_t) _dyld_get_image_header(_dyld_image_count() - 1);
+        plcrash_nasync_image_list_remove(image_list, removed);
+
+        plcrash_log_writer_set_image_manifest(writer, manifest);
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* All images were listed in the manifest */
+    STAssertEquals((size_t) 0, crashReport->n_binary_images, @"Manifest images must not be written");
+    STAssertNotNULL(crashReport->image_manifest, @"Manifest reference was not written");
+    if (crashReport->image_manifest != NULL) {
+        STAssertEquals(manifest->identifier, crashReport->image_manifest->identifier, @"Incorrect manifest identifier");
+        STAssertEquals((size_t) 1, crashReport->image_manifest->n_removed_images, @"Incorrect removed image count");
+        if (crashReport->image_manifest->n_removed_images == 1)
+            STAssertEquals((uint64_t) removed, crashReport->image_manifest->removed_images[0], @"Incorrect removed image");
+    }
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+
+    /* The manifest's remaining images must be restored when decoded with the manifest */
+    NSError *error = nil;
+    NSData *reportData = [NSData dataWithContentsOfFile: _logPath];
+    NSData *manifestData = [NSData dataWithBytesNoCopy: manifest_data length: manifest_length freeWhenDone: YES];
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: reportData imageManifest: manifestData error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash report: %@", error);
+    STAssertEqualStrings([NSString stringWithFormat: @"%016llx", (unsigned long long) manifest->identifier], report.imageManifestIdentifier, @"Incorrect manifest identifier");
+    STAssertEquals((NSUInteger) manifest->count - 1, [report.images count], @"Incorrect image count");
+    for (PLCrashReportBinaryImageInfo *imageInfo in report.images)
+        STAssertTrue(imageInfo.imageBaseAddress != removed, @"Removed image must not be restored");
+
+    /* A mismatched manifest must be rejected */
+    NSData *invalid = [manifestData subdataWithRange: NSMakeRange(0, [manifestData length] / 2)];
+    STAssertNil([[[PLCrashReport alloc] initWithData: reportData imageManifest: invalid error: NULL] autorelease], @"Mismatched manifest must be rejected");
+
+    plcrash_log_writer_image_manifest_free(manifest);
+}
+
+/* Test that prioritized output fits the report within the output limit, retaining the crashed thread's images */
+- (void) testWriteReportPrioritizedOutput {
+    plcrash_async_file_t file;
+
+    /* Open the output file, with a limit too small to hold all images */
+    const off_t limit = 16 * 1024;
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+    plcrash_async_file_init(&file, fd, limit);
+
+    Plcrash__CrashReport *crashReport = [self writeReportForThread: pthread_mach_thread_np(_thr_args.thread)
+                                                              file: &file
+                                                          strategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE
+                                                     userRequested: NO
+                                                     configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list)
+    {
+        plcrash_log_writer_set_prioritized_output(writer, true);
+    }];
+
+    /* Find the image containing the crashed thread's PC */
+    plcrash_async_image_list_t image_list;
+    plcrash_async_thread_state_t thread_state;
+    image_list_init_loaded(&image_list);
+    plcrash_async_thread_state_mach_thread_init(&thread_state, pthread_mach_thread_np(_thr_args.thread));
+
+    plcrash_async_image_list_set_reading(&image_list, true);
+    plcrash_async_image_t *pc_image = plcrash_async_image_containing_address(&image_list, (pl_vm_address_t) plcrash_async_thread_state_get_reg(&thread_state, PLCRASH_REG_IP));
+    uint64_t pc_image_addr = pc_image != NULL ? pc_image->macho_image.header_addr : 0;
+    plcrash_async_image_list_set_reading(&image_list, false);
+    plcrash_nasync_image_list_free(&image_list);
+    STAssertNotEquals((uint64_t) 0, pc_image_addr, @"Could not find the crashed thread's image");
+
+    /* The report must be complete, and within the limit */
+    NSData *data = [NSData dataWithContentsOfFile: _logPath];
+    STAssertTrue((off_t) [data length] <= limit, @"Report exceeds the output limit");
+
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    STAssertNotNULL(crashReport->signal, @"No signal info was written");
+    STAssertNotNULL(crashReport->truncation, @"No truncation info was written");
+    STAssertTrue(crashReport->truncation->elided_image_count > 0, @"No images were elided");
+
+    BOOL foundCrashed = NO;
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        if (crashReport->threads[i]->crashed)
+            foundCrashed = YES;
+    }
+    STAssertTrue(foundCrashed, @"No crashed thread was written");
+
+    BOOL foundImage = NO;
+    for (size_t i = 0; i < crashReport->n_binary_images; i++) {
+        if (crashReport->binary_images[i]->base_address == pc_image_addr)
+            foundImage = YES;
+    }
+    STAssertTrue(foundImage, @"The crashed thread's image was elided");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/* Test that the thread limit is applied, always retaining the crashed thread */
+- (void) testWriteReportMaxThreads {
+    /* Determine the number of threads; the main thread, the test thread, and the current thread must all exist */
+    thread_act_array_t threads;
+    mach_msg_type_number_t thread_count;
+    STAssertEquals(KERN_SUCCESS, task_threads(mach_task_self(), &threads, &thread_count), @"Could not fetch threads");
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++)
+        mach_port_deallocate(mach_task_self(), threads[i]);
+    vm_deallocate(mach_task_self(), (vm_address_t) threads, sizeof(thread_t) * thread_count);
+    STAssertTrue(thread_count > 2, @"Too few threads for this test");
+
+    /* Limit the report to two threads */
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        plcrash_log_writer_set_max_threads(writer, 2);
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    STAssertTrue(crashReport->n_threads <= 2, @"The thread limit was exceeded");
+    STAssertNotNULL(crashReport->truncation, @"No truncation info was written");
+    if (crashReport->truncation != NULL)
+        STAssertTrue(crashReport->truncation->elided_thread_count > 0, @"No threads were elided");
+
+    BOOL foundCrashed = NO;
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        if (crashReport->threads[i]->crashed)
+            foundCrashed = YES;
+    }
+    STAssertTrue(foundCrashed, @"The crashed thread was omitted");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/* Test that an expired deadline reduces the report's detail, while still writing the crashed thread */
+- (void) testWriteReportDeadline {
+    /* Use a deadline that will have expired before the first thread is written */
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_deadline(writer, 1), @"Failed to set the deadline");
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_stack_memory(writer, 4096, 0), @"Could not enable stack memory capture");
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    STAssertNotNULL(crashReport->truncation, @"No truncation info was written");
+    if (crashReport->truncation != NULL) {
+        STAssertTrue(crashReport->truncation->has_deadline_expired && crashReport->truncation->deadline_expired, @"The deadline was not marked as expired");
+        STAssertTrue(crashReport->truncation->elided_image_count > 0, @"No images were elided");
+    }
+
+    STAssertTrue(crashReport->n_binary_images < _dyld_image_count(), @"Unreferenced images were written");
+    STAssertEquals((size_t) 0, crashReport->n_stack_memory, @"Stack memory was written");
+
+    BOOL foundCrashed = NO;
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        if (crashReport->threads[i]->crashed) {
+            foundCrashed = YES;
+            STAssertTrue(crashReport->threads[i]->n_frames > 0, @"The crashed thread's frames were not written");
+        }
+    }
+    STAssertTrue(foundCrashed, @"The crashed thread was omitted");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/* Test that only the referenced images and the main executable are written */
+- (void) testWriteReportReferencedImages {
+    Plcrash__CrashReport *crashReport = [self writeReportWithStrategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE configuration: ^(plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list) {
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_enable_referenced_images(writer), @"Could not enable referenced images");
+    }];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    STAssertTrue(crashReport->n_binary_images > 0, @"No images were written");
+    STAssertTrue(crashReport->n_binary_images < _dyld_image_count(), @"Unreferenced images were written");
+
+    /* Every frame must be symbolicatable from the written images */
+    plcrash_async_image_list_t image_list;
+    image_list_init_loaded(&image_list);
+
+    plcrash_async_image_list_set_reading(&image_list, true);
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *t = crashReport->threads[i];
+        for (size_t j = 0; j < t->n_frames; j++) {
+            plcrash_async_image_t *image = plcrash_async_image_containing_address(&image_list, (pl_vm_address_t) t->frames[j]->pc);
+            if (image == NULL)
+                continue;
+
+            BOOL found = NO;
+            for (size_t k = 0; k < crashReport->n_binary_images; k++) {
+                if (crashReport->binary_images[k]->base_address == image->macho_image.header_addr)
+                    found = YES;
+            }
+            STAssertTrue(found, @"The image for frame PC 0x%" PRIx64 " was not written", t->frames[j]->pc);
+        }
+    }
+    plcrash_async_image_list_set_reading(&image_list, false);
+
+    plcrash_nasync_image_list_free(&image_list);
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, &protobuf_c_system_allocator);
+}
+
+/* Return the number of benchmark iterations to be run */
+- (NSUInteger) benchmarkIterations {
+    const char *value = getenv("PLCRASH_BENCHMARK_ITERATIONS");
+    if (value == NULL || atoi(value) <= 0)
+        return BENCHMARK_DEFAULT_ITERATIONS;
+
+    return (NSUInteger) atoi(value);
+}
+
+/* Return the maximum number of synthetic images to be loaded by the image count scaling benchmark */
+- (NSUInteger) benchmarkMaxImages {
+    const char *value = getenv("PLCRASH_BENCHMARK_MAX_IMAGES");
+    if (value == NULL || atoi(value) <= 0)
+        return BENCHMARK_DEFAULT_MAX_IMAGES;
+
+    return (NSUInteger) atoi(value);
+}
+
+/* Walk all frames of @a threads using only the provided frame readers, returning the total number of frames read. */
+- (size_t) walkThreads: (plcrash_test_thread_t *) threads
+                 count: (size_t) count
+             imageList: (plcrash_async_image_list_t *) image_list
+               readers: (plframe_cursor_frame_reader_t **) readers
+           readerCount: (size_t) reader_count
+{
+    size_t frames = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        plframe_cursor_t cursor;
+        thread_t thread = pthread_mach_thread_np(threads[i].thread);
+
+        STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_thread_init(&cursor, mach_task_self(), thread, image_list), @"Failed to initialize cursor");
+        while (plframe_cursor_next_with_readers(&cursor, readers, reader_count) == PLFRAME_ESUCCESS)
+            frames++;
+
+        plframe_cursor_free(&cursor);
+    }
+
+    return frames;
+}
+
+/**
+ * Benchmark report generation across BENCHMARK_THREAD_COUNT threads of BENCHMARK_STACK_DEPTH frames, measuring
+ * wall time, syscall counts, and bytes written for each unwinder and symbolication strategy.
+ *
+ * Results are logged, rather than asserted, as they are highly dependent on the host; set PLCRASH_BENCHMARK_ITERATIONS
+ * to increase the number of iterations when comparing report generation latency across revisions.
+ */
+- (void) testBenchmarkWriteReport {
+    NSUInteger iterations = [self benchmarkIterations];
+    plcrash_test_thread_t threads[BENCHMARK_THREAD_COUNT];
+    plcrash_async_image_list_t image_list;
+    benchmark_sample_t sample;
+
+    /* Initialize the image list */
+    image_list_init_loaded(&image_list);
+
+    /* Spawn our benchmark threads */
+    for (size_t i = 0; i < BENCHMARK_THREAD_COUNT; i++)
+        plcrash_test_thread_spawn_depth(&threads[i], BENCHMARK_STACK_DEPTH);
+
+    /* Benchmark the individual unwinders */
+    struct {
+        NSString *name;
+        plframe_cursor_frame_reader_t *reader;
+    } unwinders[] = {
+#if PLCRASH_FEATURE_UNWIND_COMPACT
+        { @"compact unwind walk", plframe_cursor_read_compact_unwind },
+#endif
+#if PLCRASH_FEATURE_UNWIND_DWARF
+        { @"DWARF walk", plframe_cursor_read_dwarf_unwind },
+#endif
+        { @"frame pointer walk", plframe_cursor_read_frame_ptr }
+    };
+
+    for (size_t i = 0; i < sizeof(unwinders) / sizeof(unwinders[0]); i++) {
+        plframe_cursor_frame_reader_t *readers[] = { unwinders[i].reader };
+        size_t frames = 0;
+
+        benchmark_begin(&sample);
+        for (NSUInteger iter = 0; iter < iterations; iter++)
+            frames += [self walkThreads: threads count: BENCHMARK_THREAD_COUNT imageList: &image_list readers: readers readerCount: 1];
+        benchmark_end(&sample, [NSString stringWithFormat: @"%@ (%zu frames)", unwinders[i].name, frames / iterations], iterations, 0);
+    }
+
+    /* Benchmark complete report generation with and without Objective-C symbolication */
+    struct {
+        NSString *name;
+        plcrash_async_symbol_strategy_t strategy;
+    } strategies[] = {
+        { @"report, no symbolication", PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE },
+        { @"report, symbol table", PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE },
+        { @"report, symbol table + objc", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL }
+    };
+
+    plcrash_async_thread_state_t thread_state;
+    thread_t crashed_thread = pthread_mach_thread_np(threads[0].thread);
+    plcrash_async_thread_state_mach_thread_init(&thread_state, crashed_thread);
+
+    for (size_t i = 0; i < sizeof(strategies) / sizeof(strategies[0]); i++) {
+        plcrash_log_writer_t writer;
+        plcrash_async_file_t file;
+        off_t bytes = 0;
+
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", strategies[i].strategy, false), @"Initialization failed");
+
+        benchmark_begin(&sample);
+        for (NSUInteger iter = 0; iter < iterations; iter++) {
+            int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_TRUNC, 0644);
+            STAssertTrue(fd >= 0, @"Failed to open output file");
+            plcrash_async_file_init(&file, fd, 0);
+
+            STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed_thread, &image_list, &file, NULL, &thread_state), @"Crash log failed");
+            plcrash_async_file_flush(&file);
+            bytes += lseek(fd, 0, SEEK_CUR);
+
+            plcrash_async_file_close(&file);
+        }
+        benchmark_end(&sample, strategies[i].name, iterations, bytes);
+
+        plcrash_log_writer_close(&writer);
+        plcrash_log_writer_free(&writer);
+    }
+
+    /* Clean up */
+    for (size_t i = 0; i < BENCHMARK_THREAD_COUNT; i++)
+        plcrash_test_thread_stop(&threads[i]);
+
+    plcrash_nasync_image_list_free(&image_list);
+}
+
+/**
+ * Benchmark image list and report generation costs as the number of loaded images grows, over 10 to
+ * PLCRASH_BENCHMARK_MAX_IMAGES synthetic images. Each synthetic image is a copy of this test bundle's loaded image,
+ * including its __unwind_info, __eh_frame and Objective-C data, relocated to a new address; this exercises the same
+ * parsing and indexing paths as a distinct dylib, without requiring a compiler at test time.
+ *
+ * For each image count, the per-image append cost (with the indexes enabled by PLCrashReporter), the
+ * plcrash_async_image_containing_address() latency, and the complete report generation time are logged as a
+ * comma-separated row, suitable for plotting scaling curves. Results are logged, rather than asserted, as they are
+ * highly dependent on the host.
+ */
+- (void) testBenchmarkImageCountScaling {
+    static const NSUInteger image_counts[] = { 10, 30, 100, 300, 600, 1000 };
+    NSUInteger max_images = [self benchmarkMaxImages];
+    NSUInteger iterations = [self benchmarkIterations];
+
+    /* Determine the layout of our own image, from which the synthetic images will be copied */
+    Dl_info info;
+    STAssertTrue(dladdr((void *) [self class], &info) > 0, @"Could not fetch dyld info for %p", [self class]);
+
+    const struct mach_header *template_header = info.dli_fbase;
+    vm_size_t text_size;
+    vm_size_t span = round_page(benchmark_image_span(template_header, &text_size));
+    STAssertTrue(span > 0 && text_size > 0, @"Could not determine the image layout");
+
+    /* Spawn a thread to be reported as crashed */
+    plcrash_test_thread_t thread;
+    plcrash_test_thread_spawn_depth(&thread, BENCHMARK_STACK_DEPTH);
+    thread_t crashed_thread = pthread_mach_thread_np(thread.thread);
+
+    plcrash_async_thread_state_t thread_state;
+    plcrash_async_thread_state_mach_thread_init(&thread_state, crashed_thread);
+
+    NSLog(@"[benchmark] image scaling: images, append us/image, lookup ns/lookup, report us/report, report bytes");
+    for (size_t c = 0; c < sizeof(image_counts) / sizeof(image_counts[0]) && image_counts[c] <= max_images; c++) {
+        NSUInteger count = image_counts[c];
+        vm_address_t *copies = calloc(count, sizeof(vm_address_t));
+        plcrash_async_image_list_t image_list;
+
+        /* Create the synthetic images */
+        for (NSUInteger i = 0; i < count; i++) {
+            STAssertEquals(KERN_SUCCESS, vm_allocate(mach_task_self(), &copies[i], span, VM_FLAGS_ANYWHERE), @"Failed to allocate image copy");
+            STAssertEquals(KERN_SUCCESS, vm_copy(mach_task_self(), (vm_address_t) template_header, span, copies[i]), @"Failed to copy image");
+        }
+
+        /* Configure the image list as PLCrashReporter does, and load the process' real images */
+        plcrash_nasync_image_list_init(&image_list, mach_task_self());
+        plcrash_nasync_image_list_enable_symbol_index(&image_list);
+        plcrash_nasync_image_list_enable_objc_index(&image_list);
+        plcrash_nasync_image_list_enable_fde_index(&image_list);
+        plcrash_nasync_image_list_enable_cfe_index(&image_list);
+        plcrash_nasync_image_list_enable_image_encoding(&image_list, plcrash_log_writer_encode_binary_image);
+
+        for (uint32_t i = 0; i < _dyld_image_count(); i++)
+            plcrash_nasync_image_list_append(&image_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+        /* Measure the append cost of the synthetic images */
+        uint64_t start = mach_absolute_time();
+        for (NSUInteger i = 0; i < count; i++)
+            plcrash_nasync_image_list_append(&image_list, copies[i], info.dli_fname);
+        uint64_t append_ns = benchmark_elapsed_ns(start);
+
+        /* Measure image lookup latency across the synthetic images */
+        plcrash_async_image_list_set_reading(&image_list, true);
+        NSUInteger found = 0;
+        start = mach_absolute_time();
+        for (NSUInteger i = 0; i < BENCHMARK_IMAGE_LOOKUPS; i++) {
+            pl_vm_address_t pc = copies[i % count] + ((i * 4093) % text_size);
+            if (plcrash_async_image_containing_address(&image_list, pc) != NULL)
+                found++;
+        }
+        uint64_t lookup_ns = benchmark_elapsed_ns(start);
+        plcrash_async_image_list_set_reading(&image_list, false);
+        STAssertEquals(found, (NSUInteger) BENCHMARK_IMAGE_LOOKUPS, @"Failed to find a synthetic image");
+
+        /* Measure complete report generation */
+        plcrash_log_writer_t writer;
+        off_t bytes = 0;
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+
+        start = mach_absolute_time();
+        for (NSUInteger iter = 0; iter < iterations; iter++) {
+            plcrash_async_file_t file;
+            int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_TRUNC, 0644);
+            STAssertTrue(fd >= 0, @"Failed to open output file");
+            plcrash_async_file_init(&file, fd, 0);
+
+            STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed_thread, &image_list, &file, NULL, &thread_state), @"Crash log failed");
+            plcrash_async_file_flush(&file);
+            bytes += lseek(fd, 0, SEEK_CUR);
+
+            plcrash_async_file_close(&file);
+        }
+        uint64_t report_ns = benchmark_elapsed_ns(start);
+
+        plcrash_log_writer_close(&writer);
+        plcrash_log_writer_free(&writer);
+
+        NSLog(@"[benchmark] image scaling: %lu, %.1f, %.1f, %.1f, %lld",
+              (unsigned long) count,
+              (double) append_ns / 1000.0 / count,
+              (double) lookup_ns / BENCHMARK_IMAGE_LOOKUPS,
+              (double) report_ns / 1000.0 / iterations,
+              (long long) bytes / (long long) iterations);
+
+        /* Clean up; the image list must be freed before the images it references */
+        plcrash_nasync_image_list_free(&image_list);
+        for (NSUInteger i = 0; i < count; i++)
+            vm_deallocate(mach_task_self(), copies[i], span);
+        free(copies);
+    }
+
+    plcrash_test_thread_stop(&thread);
+}
+
 @end
@@ -64,12 +64,47 @@ typedef struct plcrash_mach_exception_port_set {
     thread_state_flavor_t flavors[EXC_TYPES_COUNT];
 } plcrash_mach_exception_port_set_t;
 
+/**
+ * @internal
+ *
+ * The forwarding target for a single exception type, resolved from a plcrash_mach_exception_port_set_t.
+ */
+typedef struct plcrash_mach_exception_forward_entry {
+    /** The target exception port, or MACH_PORT_NULL if no handler is registered for the exception type. */
+    mach_port_t port;
+
+    /** The target's exception behavior, with the MACH_EXCEPTION_CODES modifier stripped. */
+    exception_behavior_t behavior;
+
+    /** True if the target requested 64-bit exception codes (MACH_EXCEPTION_CODES). */
+    bool mach_exc_codes;
+
+    /** The target's thread state flavor. */
+    thread_state_flavor_t flavor;
+} plcrash_mach_exception_forward_entry_t;
+
+/**
+ * @internal
+ *
+ * A precomputed exception forwarding table, mapping each exception type directly to its forwarding target. This
+ * avoids matching the exception against each registered mask, and decoding the target's behavior, at crash time.
+ */
+typedef struct plcrash_mach_exception_forward_table {
+    /** Forwarding targets, indexed by exception type. */
+    plcrash_mach_exception_forward_entry_t entries[EXC_TYPES_COUNT];
+} plcrash_mach_exception_forward_table_t;
+
+void plcrash_mach_exception_forward_table_init (plcrash_mach_exception_forward_table_t *table, const plcrash_mach_exception_port_set_t *port_set);
+
 @interface PLCrashMachExceptionPortSet : NSObject <NSFastEnumeration> {
 @private
     /** Backing state set representation. */
     NSSet *_state_set;
     
     plcrash_mach_exception_port_set_t _asyncSafeRepresentation;
+
+    /** Forwarding table computed from _asyncSafeRepresentation. */
+    plcrash_mach_exception_forward_table_t _forwardTable;
 }
 
 - (id) initWithSet: (NSSet *) set;
@@ -81,6 +116,9 @@ typedef struct plcrash_mach_exception_port_set {
 /** The C representation of the port state set. May be used in async-safe code paths. */
 @property(nonatomic, readonly) plcrash_mach_exception_port_set_t asyncSafeRepresentation;
 
+/** The forwarding table for the port state set. May be used in async-safe code paths. */
+@property(nonatomic, readonly) plcrash_mach_exception_forward_table_t forwardTable;
+
 @end
 
 #import "PLCrashMachExceptionPort.h"
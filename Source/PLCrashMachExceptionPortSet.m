@@ -28,6 +28,40 @@
 
 #import "PLCrashMachExceptionPortSet.h"
 
+/**
+ * @internal
+ *
+ * Populate @a table from @a port_set. For each exception type, the first valid port whose mask includes the
+ * exception is selected, matching the order in which PLCrashMachExceptionForward() searches the port set.
+ *
+ * @param table The table to be initialized.
+ * @param port_set The port set from which the table will be computed. The table borrows the set's port references.
+ */
+void plcrash_mach_exception_forward_table_init (plcrash_mach_exception_forward_table_t *table, const plcrash_mach_exception_port_set_t *port_set) {
+    memset(table, 0, sizeof(*table));
+
+    for (exception_type_t type = 0; type < EXC_TYPES_COUNT; type++) {
+        plcrash_mach_exception_forward_entry_t *entry = &table->entries[type];
+        entry->port = MACH_PORT_NULL;
+
+        /* Exception masks follow the standard (1 << type) assignment; see exception_types.h */
+        exception_mask_t mask = (1 << type);
+        for (mach_msg_type_number_t i = 0; i < port_set->count; i++) {
+            if (!MACH_PORT_VALID(port_set->ports[i]))
+                continue;
+
+            if ((port_set->masks[i] & mask) == 0)
+                continue;
+
+            entry->port = port_set->ports[i];
+            entry->behavior = port_set->behaviors[i] & ~MACH_EXCEPTION_CODES;
+            entry->mach_exc_codes = (port_set->behaviors[i] & MACH_EXCEPTION_CODES) != 0;
+            entry->flavor = port_set->flavors[i];
+            break;
+        }
+    }
+}
+
 /**
  * @internal
  *
@@ -41,6 +75,7 @@
 @implementation PLCrashMachExceptionPortSet
 
 @synthesize asyncSafeRepresentation = _asyncSafeRepresentation;
+@synthesize forwardTable = _forwardTable;
 @synthesize set = _state_set;
 
 /**
@@ -69,6 +104,7 @@
         port_set.count++;
     }
     _asyncSafeRepresentation = port_set;
+    plcrash_mach_exception_forward_table_init(&_forwardTable, &_asyncSafeRepresentation);
     
     return self;
 }
@@ -105,6 +141,7 @@
 
     _state_set = [stateResult retain];
     _asyncSafeRepresentation = asyncSafeRepresentation;
+    plcrash_mach_exception_forward_table_init(&_forwardTable, &_asyncSafeRepresentation);
 
     return self;
 }
@@ -109,6 +109,39 @@
     STAssertEquals((NSUInteger)2, [stateSet.set count], @"Incorrect state count");
 }
 
+- (void) testForwardTable {
+    plcrash_mach_exception_port_set_t state_set;
+    state_set.count = 3;
+    state_set.masks[0] = EXC_MASK_BAD_ACCESS;
+    state_set.behaviors[0] = EXCEPTION_STATE | MACH_EXCEPTION_CODES;
+    state_set.ports[0] = MACH_PORT_NULL;
+    state_set.flavors[0] = MACHINE_THREAD_STATE;
+
+    state_set.masks[1] = EXC_MASK_BAD_ACCESS | EXC_MASK_BAD_INSTRUCTION;
+    state_set.behaviors[1] = EXCEPTION_STATE_IDENTITY | MACH_EXCEPTION_CODES;
+    state_set.ports[1] = 0x1234;
+    state_set.flavors[1] = MACHINE_THREAD_STATE;
+
+    state_set.masks[2] = EXC_MASK_BAD_INSTRUCTION;
+    state_set.behaviors[2] = EXCEPTION_DEFAULT;
+    state_set.ports[2] = 0x5678;
+    state_set.flavors[2] = THREAD_STATE_NONE;
+
+    plcrash_mach_exception_forward_table_t table;
+    plcrash_mach_exception_forward_table_init(&table, &state_set);
+
+    /* Invalid ports are skipped */
+    STAssertEquals(table.entries[EXC_BAD_ACCESS].port, (mach_port_t) 0x1234, @"Incorrect port");
+    STAssertEquals(table.entries[EXC_BAD_ACCESS].behavior, (exception_behavior_t) EXCEPTION_STATE_IDENTITY, @"MACH_EXCEPTION_CODES was not stripped");
+    STAssertTrue(table.entries[EXC_BAD_ACCESS].mach_exc_codes, @"Incorrect codes flag");
+
+    /* The first matching entry is used */
+    STAssertEquals(table.entries[EXC_BAD_INSTRUCTION].port, (mach_port_t) 0x1234, @"Incorrect port");
+
+    /* Unregistered types have no target */
+    STAssertEquals(table.entries[EXC_ARITHMETIC].port, (mach_port_t) MACH_PORT_NULL, @"Unexpected port");
+}
+
 - (void) testInitWithSet {
     PLCrashMachExceptionPort *firstState = [[[PLCrashMachExceptionPort alloc] initWithServerPort: MACH_PORT_DEAD
                                                                                                 mask: EXC_MASK_BAD_ACCESS
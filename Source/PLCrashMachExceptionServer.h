@@ -56,6 +56,45 @@ typedef kern_return_t (*PLCrashMachExceptionHandlerCallback) (task_t task,
                                                               mach_msg_type_number_t code_count,
                                                               void *context);
 
+/**
+ * @internal
+ * Exception handler callback, issued with the faulting thread's state as delivered in an EXCEPTION_STATE_IDENTITY
+ * exception message.
+ *
+ * @param task The task in which the exception occured.
+ * @param thread The thread on which the exception occured. The thread will be suspended when the callback is issued.
+ * @param exception_type Mach exception type.
+ * @param code Mach exception codes.
+ * @param code_count The number of codes provided.
+ * @param flavor The flavor of @a state.
+ * @param state The thread state of @a thread at the time of the exception, or NULL if the exception message did not
+ * include thread state.
+ * @param state_count The number of natural_t values in @a state.
+ * @param context The context supplied to PLCrashMachExceptionServer::initWithStateCallBack:context:error:
+ *
+ * @return Return KERN_SUCCESS if the exception has been handled. Return an appropriate failure code otherwise. If KERN_SUCCESS, the thread
+ * will be resumed with its current thread state.
+ */
+typedef kern_return_t (*PLCrashMachExceptionStateHandlerCallback) (task_t task,
+                                                                   thread_t thread,
+                                                                   exception_type_t exception_type,
+                                                                   mach_exception_data_t code,
+                                                                   mach_msg_type_number_t code_count,
+                                                                   thread_state_flavor_t flavor,
+                                                                   const natural_t *state,
+                                                                   mach_msg_type_number_t state_count,
+                                                                   void *context);
+
+/**
+ * Exception server latency instrumentation callback.
+ *
+ * @param dispatch_latency_ns The time, in nanoseconds, between the server's receipt of the exception message
+ * and the invocation of the exception handler callback.
+ * @param handler_duration_ns The time, in nanoseconds, spent in the exception handler callback.
+ * @param context The context supplied to PLCrashMachExceptionServer::setLatencyCallback:context:.
+ */
+typedef void (*PLCrashMachExceptionLatencyCallback) (uint64_t dispatch_latency_ns, uint64_t handler_duration_ns, void *context);
+
 kern_return_t PLCrashMachExceptionForward (task_t task,
                                            thread_t thread,
                                            exception_type_t exception_type,
@@ -63,6 +102,13 @@ kern_return_t PLCrashMachExceptionForward (task_t task,
                                            mach_msg_type_number_t code_count,
                                            plcrash_mach_exception_port_set_t *port_state);
 
+kern_return_t PLCrashMachExceptionForwardWithTable (task_t task,
+                                                    thread_t thread,
+                                                    exception_type_t exception_type,
+                                                    mach_exception_data_t code,
+                                                    mach_msg_type_number_t code_count,
+                                                    const plcrash_mach_exception_forward_table_t *table);
+
 @interface PLCrashMachExceptionServer : NSObject {
 @private
     /** Backing server context. This structure will not be allocated until the background
@@ -75,11 +121,27 @@ kern_return_t PLCrashMachExceptionForward (task_t task,
                 context: (void *) context
                   error: (NSError **) outError;
 
+- (id) initWithStateCallBack: (PLCrashMachExceptionStateHandlerCallback) callback
+                     context: (void *) context
+                       error: (NSError **) outError;
+
 - (mach_port_t) copySendRightForServerAndReturningError: (NSError **) outError;
 
 - (PLCrashMachExceptionPort *) exceptionPortWithMask: (exception_mask_t) mask error: (NSError **) outError;
 
-/** The Mach thread on which the exception server is running. This may be used to register
+- (PLCrashMachExceptionPort *) exceptionPortForTask: (task_t) task
+                                               mask: (exception_mask_t) mask
+                                           callBack: (PLCrashMachExceptionHandlerCallback) callback
+                                            context: (void *) context
+                                              error: (NSError **) outError;
+
+- (void) removeExceptionPortForTask: (task_t) task;
+
+- (BOOL) addServerThreads: (NSUInteger) count error: (NSError **) outError;
+
+- (void) setLatencyCallback: (PLCrashMachExceptionLatencyCallback) callback context: (void *) context;
+
+/** The primary Mach thread on which the exception server is running. This may be used to register
  * a thread-specific exception handler for the server itself. */
 @property(nonatomic, readonly) thread_t serverThread;
 
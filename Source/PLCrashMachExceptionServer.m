@@ -88,7 +88,9 @@
 #import "PLCrashAsync.h"
 
 #import <pthread.h>
+#import <sys/mman.h>
 #import <libkern/OSAtomic.h>
+#import <mach/mach_time.h>
 
 #import <mach/mach.h>
 #import <mach/exc.h>
@@ -108,18 +110,41 @@
 #error The allocated message identifiers conflict.
 #endif
 
+/*
+ * The msgh_id values of the exception_raise_state_identity messages. As with the reply id offsets, these are not
+ * available from the iOS headers; see the top-level file warning regarding use on iOS.
+ */
+#define PLCRASH_EXCEPTION_RAISE_STATE_IDENTITY_MSGH_ID 2403
+#define PLCRASH_MACH_EXCEPTION_RAISE_STATE_IDENTITY_MSGH_ID 2407
+
 #if USE_MACH64_CODES
 typedef __Request__mach_exception_raise_t PLRequest_exception_raise_t;
+typedef __Request__mach_exception_raise_state_identity_t PLRequest_exception_raise_state_identity_t;
 typedef __Reply__mach_exception_raise_t PLReply_exception_raise_t;
+typedef __Reply__mach_exception_raise_state_identity_t PLReply_exception_raise_state_identity_t;
 #define PLCRASH_DEFAULT_BEHAVIOR (EXCEPTION_DEFAULT | MACH_EXCEPTION_CODES)
+#define PLCRASH_STATE_IDENTITY_BEHAVIOR (EXCEPTION_STATE_IDENTITY | MACH_EXCEPTION_CODES)
+#define PLCRASH_STATE_IDENTITY_MSGH_ID PLCRASH_MACH_EXCEPTION_RAISE_STATE_IDENTITY_MSGH_ID
 #define PLCRASH_DEFAULT_THREAD_FLAVOR MACHINE_THREAD_STATE
 #else
 typedef __Request__exception_raise_t PLRequest_exception_raise_t;
+typedef __Request__exception_raise_state_identity_t PLRequest_exception_raise_state_identity_t;
 typedef __Reply__exception_raise_t PLReply_exception_raise_t;
+typedef __Reply__exception_raise_state_identity_t PLReply_exception_raise_state_identity_t;
 #define PLCRASH_DEFAULT_BEHAVIOR EXCEPTION_DEFAULT
+#define PLCRASH_STATE_IDENTITY_BEHAVIOR EXCEPTION_STATE_IDENTITY
+#define PLCRASH_STATE_IDENTITY_MSGH_ID PLCRASH_EXCEPTION_RAISE_STATE_IDENTITY_MSGH_ID
 #define PLCRASH_DEFAULT_THREAD_FLAVOR MACHINE_THREAD_STATE
 #endif
 
+/**
+ * @internal
+ * The receive buffer size. This is sufficient for the largest exception message that may be delivered
+ * to the server (mach_exception_raise_state_identity, with a maximal thread state), along with the largest
+ * receive trailer, and avoids reallocating the buffer at crash time.
+ */
+#define PLCRASH_REQUEST_BUFFER_SIZE round_page(MAX(sizeof(PLRequest_exception_raise_t), sizeof(PLRequest_exception_raise_state_identity_t)) + MAX_TRAILER_SIZE)
+
 /**
  * @internal
  * Map an exception type to its corresponding mask value.
@@ -139,6 +164,9 @@ static exception_mask_t exception_to_mask (exception_type_t exception) {
         EXM(MACH_SYSCALL);
         EXM(RPC_ALERT);
         EXM(CRASH);
+#ifdef EXC_RESOURCE
+        EXM(RESOURCE);
+#endif
 #ifdef EXC_GUARD
         EXM(GUARD);
 #endif
@@ -156,13 +184,39 @@ static exception_mask_t exception_to_mask (exception_type_t exception) {
 #endif
 }
 
+/**
+ * @internal
+ *
+ * A per-task exception port registration. Each registration owns a dedicated receive right in the server's
+ * port set, allowing exceptions from independently monitored tasks to be dispatched to their own handler.
+ */
+struct plcrash_exception_server_registration {
+    /** The registration's receive right. */
+    mach_port_t port;
+
+    /** The monitored task. The caller retains ownership of this right. */
+    task_t task;
+
+    /** The registration's exception callback. */
+    PLCrashMachExceptionHandlerCallback callback;
+
+    /** The registration's callback context. */
+    void *context;
+
+    /** The number of server threads currently executing @a callback. Protected by the server context lock. */
+    uint32_t active;
+
+    /** The next registration, or NULL. */
+    struct plcrash_exception_server_registration *next;
+};
+
 /**
  * @internal
  *
  * Exception handler context.
  */
 struct plcrash_exception_server_context {
-    /** The server's mach thread. */
+    /** The server's primary mach thread. */
     thread_t server_thread;
 
     /** Registered exception port. */
@@ -174,12 +228,28 @@ struct plcrash_exception_server_context {
     /** Listen port set */
     mach_port_t port_set;
 
-    /** User callback. */
+    /** User callback, or NULL if @a state_callback is used. */
     PLCrashMachExceptionHandlerCallback callback;
 
+    /** User state callback, or NULL if @a callback is used. If non-NULL, the server is registered with the
+     * EXCEPTION_STATE_IDENTITY behavior. */
+    PLCrashMachExceptionStateHandlerCallback state_callback;
+
     /** User callback context. */
     void *callback_context;
 
+    /** Per-task registrations, or NULL. Protected by @a lock. */
+    struct plcrash_exception_server_registration *registrations;
+
+    /** Latency instrumentation callback, or NULL. */
+    PLCrashMachExceptionLatencyCallback latency_callback;
+
+    /** Latency instrumentation callback context. */
+    void *latency_context;
+
+    /** The mach_absolute_time() timebase, used to convert latency values to nanoseconds. */
+    mach_timebase_info_data_t timebase;
+
     /** Lock used to signal waiting initialization thread. */
     pthread_mutex_t lock;
     
@@ -195,11 +265,17 @@ struct plcrash_exception_server_context {
      */
     uint32_t server_should_stop;
 
-    /** Intended to be observed by the waiting initialization thread. Informs
-     * the waiting thread that shutdown has completed . */
-    bool server_stop_done;
+    /** The number of running server threads. Intended to be observed by the waiting termination thread;
+     * each server thread decrements this value and signals @a server_cond on shutdown. Protected by @a lock. */
+    uint32_t server_thread_count;
 };
 
+static void *exception_server_thread (void *arg);
+
+@interface PLCrashMachExceptionServer (PrivateMethods)
+- (BOOL) spawnServerThread: (thread_t *) outThread error: (NSError **) outError;
+@end
+
 /***
  * @internal
  *
@@ -235,8 +311,8 @@ struct plcrash_exception_server_context {
  * recorded.
  *
  * This may be done by targeting the Mach exception server's thread with a thread-specific
- * crash handler. All callbacks will be issued on this thread, and it may be reliably targeted
- * to observe any crashes that occur within those callbacks.
+ * crash handler. Unless additional server threads have been spawned, all callbacks will be issued
+ * on this thread, and it may be reliably targeted to observe any crashes that occur within those callbacks.
  *
  * An example implementation might do the following:
  * - Before performing any other operations, create a cookie file on-disk that can be checked on
@@ -265,8 +341,39 @@ struct plcrash_exception_server_context {
                 context: (void *) context
                   error: (NSError **) outError
 {
-    pthread_attr_t attr;
-    pthread_t thr;
+    return [self initWithCallBack: callback stateCallBack: NULL context: context error: outError];
+}
+
+/**
+ * Initialize a new Mach exception server that is registered with the EXCEPTION_STATE_IDENTITY behavior. The
+ * faulting thread's state is delivered in the exception message itself, and is provided to @a callback; this
+ * avoids fetching the thread's state via thread_get_state() at crash time.
+ *
+ * @param callback Callback called upon receipt of an exception. The callback will execute
+ * on the exception server's thread, distinctly from the crashed thread.
+ * @param context Context to be passed to the callback. May be NULL.
+ * @param outError A pointer to an NSError object variable. If an error occurs initializing the exception server,
+ * this pointer will contain an error object in the NSMachErrorDomain or NSPOSIXErrorDomain indicating why the
+ * exception handler could not be registered. If no error occurs, this parameter will be left unmodified.
+ * You may specify NULL for this parameter, and no error information will be provided.
+ */
+- (id) initWithStateCallBack: (PLCrashMachExceptionStateHandlerCallback) callback
+                     context: (void *) context
+                       error: (NSError **) outError
+{
+    return [self initWithCallBack: NULL stateCallBack: callback context: context error: outError];
+}
+
+/**
+ * @internal
+ *
+ * Initialize a new Mach exception server. Exactly one of @a callback or @a stateCallback must be non-NULL.
+ */
+- (id) initWithCallBack: (PLCrashMachExceptionHandlerCallback) callback
+          stateCallBack: (PLCrashMachExceptionStateHandlerCallback) stateCallback
+                context: (void *) context
+                  error: (NSError **) outError
+{
     kern_return_t kr;
 
     if ((self = [super init]) == nil)
@@ -280,7 +387,18 @@ struct plcrash_exception_server_context {
     _serverContext->port_set = MACH_PORT_NULL;
     _serverContext->server_thread = MACH_PORT_NULL;
     _serverContext->callback = callback;
+    _serverContext->state_callback = stateCallback;
     _serverContext->callback_context = context;
+
+    if ((kr = mach_timebase_info(&_serverContext->timebase)) != KERN_SUCCESS) {
+        plcrash_populate_mach_error(outError, kr, @"Failed to fetch the mach timebase");
+
+        free(_serverContext);
+        _serverContext = NULL;
+
+        [self release];
+        return nil;
+    }
     
     if (pthread_mutex_init(&_serverContext->lock, NULL) != 0) {
         plcrash_populate_posix_error(outError, errno, @"Mutex initialization failed");
@@ -373,35 +491,98 @@ struct plcrash_exception_server_context {
 
     /* Spawn the server thread. */
     {
-        if (pthread_attr_init(&attr) != 0) {
-            plcrash_populate_posix_error(outError, errno, @"Failed to initialize pthread_attr");
-            
+        thread_t thr;
+        if (![self spawnServerThread: &thr error: outError]) {
             [self release];
             return nil;
         }
-        
-        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
-        // TODO - A custom stack should be specified, using high/low guard pages to help prevent overwriting the stack
-        // by crashing code.
-        // pthread_attr_setstack(&attr, sp, stacksize);
-        
-        if (pthread_create(&thr, &attr, &exception_server_thread, _serverContext) != 0) {
-            plcrash_populate_posix_error(outError, errno, @"Failed to create exception server thread");
-            pthread_attr_destroy(&attr);
-            
-            [self release];
-            return nil;
-        }
-        
-        pthread_attr_destroy(&attr);
-        
+
         /* Save the thread reference */
-        _serverContext->server_thread = pthread_mach_thread_np(thr);
+        pthread_mutex_lock(&_serverContext->lock); {
+            _serverContext->server_thread = thr;
+        } pthread_mutex_unlock(&_serverContext->lock);
     }
     
     return self;
 }
 
+/**
+ * @internal
+ *
+ * Spawn a new server thread receiving on the server's port set.
+ *
+ * @param outThread On success, will be set to the new thread's Mach thread port.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object in the NSPOSIXErrorDomain indicating why the thread could not be created.
+ */
+- (BOOL) spawnServerThread: (thread_t *) outThread error: (NSError **) outError {
+    pthread_attr_t attr;
+    pthread_t thr;
+    int err;
+
+    if ((err = pthread_attr_init(&attr)) != 0) {
+        plcrash_populate_posix_error(outError, err, @"Failed to initialize pthread_attr");
+        return NO;
+    }
+
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    // TODO - A custom stack should be specified, using high/low guard pages to help prevent overwriting the stack
+    // by crashing code.
+    // pthread_attr_setstack(&attr, sp, stacksize);
+
+    /* The thread must be accounted for prior to starting, as it will decrement the count on termination */
+    pthread_mutex_lock(&_serverContext->lock); {
+        _serverContext->server_thread_count++;
+    } pthread_mutex_unlock(&_serverContext->lock);
+
+    if ((err = pthread_create(&thr, &attr, &exception_server_thread, _serverContext)) != 0) {
+        plcrash_populate_posix_error(outError, err, @"Failed to create exception server thread");
+        pthread_attr_destroy(&attr);
+
+        pthread_mutex_lock(&_serverContext->lock); {
+            _serverContext->server_thread_count--;
+        } pthread_mutex_unlock(&_serverContext->lock);
+
+        return NO;
+    }
+
+    pthread_attr_destroy(&attr);
+
+    *outThread = pthread_mach_thread_np(thr);
+    return YES;
+}
+
+/**
+ * Spawn @a count additional server threads. All server threads receive from the same port set, and the
+ * kernel delivers each exception message to exactly one waiting thread; a slow exception callback will
+ * only occupy the thread on which it was dispatched, while the remaining threads continue to service
+ * exceptions raised by other monitored tasks.
+ *
+ * @param count The number of additional threads to spawn.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object in the NSPOSIXErrorDomain indicating why the threads could not be created. If no error occurs, this
+ * parameter will be left unmodified. You may specify NULL for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO if a thread could not be created. Any threads spawned prior to the failure
+ * will continue to service exception messages.
+ *
+ * @warning Once additional server threads have been spawned, exception callbacks may be issued concurrently, and on
+ * threads other than PLCrashMachExceptionServer::serverThread. When handling exceptions for the current task, a
+ * thread-specific crash handler registered for PLCrashMachExceptionServer::serverThread will no longer observe all
+ * crashes that occur within the callbacks.
+ */
+- (BOOL) addServerThreads: (NSUInteger) count error: (NSError **) outError {
+    NSAssert(_serverContext != NULL, @"No handler registered!");
+
+    for (NSUInteger i = 0; i < count; i++) {
+        thread_t thr;
+        if (![self spawnServerThread: &thr error: outError])
+            return NO;
+    }
+
+    return YES;
+}
+
 /**
  * Return the Mach thread on which the exception server is running.
  *
@@ -419,6 +600,33 @@ struct plcrash_exception_server_context {
     return result;
 }
 
+/**
+ * Set the latency instrumentation callback. The callback will be issued on the server thread after each exception
+ * message has been handled and replied to, and reports the time from the server's receipt of the message to the
+ * invocation of the exception callback, as well as the time spent in the exception callback.
+ *
+ * @param callback The callback to be invoked, or NULL to disable latency instrumentation.
+ * @param context Context to be passed to the callback. May be NULL.
+ *
+ * @note The callback is invoked after the exception has been handled, and must be async-safe if the server
+ * is handling exceptions for the current task.
+ */
+- (void) setLatencyCallback: (PLCrashMachExceptionLatencyCallback) callback context: (void *) context {
+    NSAssert(_serverContext != NULL, @"No handler registered!");
+
+    pthread_mutex_lock(&_serverContext->lock); {
+        /* Clear the callback before updating the context, as the server thread reads them without locking */
+        _serverContext->latency_callback = NULL;
+        OSMemoryBarrier();
+
+        _serverContext->latency_context = context;
+        OSMemoryBarrier();
+
+        _serverContext->latency_callback = callback;
+        OSMemoryBarrier();
+    } pthread_mutex_unlock(&_serverContext->lock);
+}
+
 /**
  * Create and return a new send right for the receiver's Mach exception server. The callee is responsible
  * for deallocating the send right via mach_port_deallocate or similar.
@@ -474,10 +682,11 @@ struct plcrash_exception_server_context {
         return nil;
 
     /* Create the port oject */
+    exception_behavior_t behavior = (_serverContext->state_callback != NULL) ? PLCRASH_STATE_IDENTITY_BEHAVIOR : PLCRASH_DEFAULT_BEHAVIOR;
     PLCrashMachExceptionPort *result;
     result = [[[PLCrashMachExceptionPort alloc] initWithServerPort: port
                                                               mask: mask
-                                                          behavior: PLCRASH_DEFAULT_BEHAVIOR
+                                                          behavior: behavior
                                                             flavor: PLCRASH_DEFAULT_THREAD_FLAVOR] autorelease];
 
     /* Drop our send right */
@@ -487,6 +696,140 @@ struct plcrash_exception_server_context {
 }
 
 
+/**
+ * Create and return a new exception port for monitoring @a task. Exceptions delivered to the returned port are
+ * dispatched to @a callback, independently of the receiver's primary callback and of any other task registrations.
+ *
+ * This is intended for out-of-process monitoring of multiple tasks; the caller is responsible for registering the
+ * returned port with @a task, eg, via PLCrashMachExceptionPort::registerForTask:previousPortSet:error:. To prevent
+ * one task's exception handling from stalling delivery of exceptions from other tasks, additional server threads may
+ * be spawned via PLCrashMachExceptionServer::addServerThreads:error:.
+ *
+ * @param task The task to be monitored. Only a single registration may exist for any given task.
+ * @param mask The exception mask to be used when registering the returned port.
+ * @param callback Callback called upon receipt of an exception raised by @a task.
+ * @param context Context to be passed to the callback. May be NULL.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object in the NSMachErrorDomain indicating why the port could not be created. If no error
+ * occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no error information
+ * will be provided.
+ * @return Returns a valid Mach port instance on success; on error, nil will be returned.
+ *
+ * @warning The registration's handler is located by acquiring a lock; the callback is not async-safe with regard
+ * to the current task, and registrations must not be used to monitor the process hosting the exception server.
+ */
+- (PLCrashMachExceptionPort *) exceptionPortForTask: (task_t) task
+                                               mask: (exception_mask_t) mask
+                                           callBack: (PLCrashMachExceptionHandlerCallback) callback
+                                            context: (void *) context
+                                              error: (NSError **) outError
+{
+    NSAssert(_serverContext != NULL, @"No handler registered!");
+
+    struct plcrash_exception_server_registration *reg;
+    mach_port_t port;
+    kern_return_t kr;
+
+    /* Allocate the registration's dedicated receive right */
+    kr = mach_port_allocate(mach_task_self(), MACH_PORT_RIGHT_RECEIVE, &port);
+    if (kr != KERN_SUCCESS) {
+        plcrash_populate_mach_error(outError, kr, @"Failed to allocate task exception port");
+        return nil;
+    }
+
+    kr = mach_port_insert_right(mach_task_self(), port, port, MACH_MSG_TYPE_MAKE_SEND);
+    if (kr != KERN_SUCCESS) {
+        plcrash_populate_mach_error(outError, kr, @"Failed to add send right to task exception port");
+        mach_port_mod_refs(mach_task_self(), port, MACH_PORT_RIGHT_RECEIVE, -1);
+        return nil;
+    }
+
+    reg = (struct plcrash_exception_server_registration *) calloc(1, sizeof(*reg));
+    reg->port = port;
+    reg->task = task;
+    reg->callback = callback;
+    reg->context = context;
+
+    pthread_mutex_lock(&_serverContext->lock); {
+        /* Refuse duplicate registrations */
+        for (struct plcrash_exception_server_registration *r = _serverContext->registrations; r != NULL; r = r->next) {
+            if (r->task == task) {
+                pthread_mutex_unlock(&_serverContext->lock);
+                plcrash_populate_mach_error(outError, KERN_NAME_EXISTS, @"An exception port is already registered for the task");
+
+                free(reg);
+                mach_port_deallocate(mach_task_self(), port);
+                mach_port_mod_refs(mach_task_self(), port, MACH_PORT_RIGHT_RECEIVE, -1);
+                return nil;
+            }
+        }
+
+        /* The registration must be visible prior to the port's insertion in the port set */
+        reg->next = _serverContext->registrations;
+        _serverContext->registrations = reg;
+
+        kr = mach_port_move_member(mach_task_self(), port, _serverContext->port_set);
+        if (kr != KERN_SUCCESS) {
+            _serverContext->registrations = reg->next;
+            pthread_mutex_unlock(&_serverContext->lock);
+            plcrash_populate_mach_error(outError, kr, @"Failed to add task exception port to port set");
+
+            free(reg);
+            mach_port_deallocate(mach_task_self(), port);
+            mach_port_mod_refs(mach_task_self(), port, MACH_PORT_RIGHT_RECEIVE, -1);
+            return nil;
+        }
+    } pthread_mutex_unlock(&_serverContext->lock);
+
+    /* Create the port object */
+    PLCrashMachExceptionPort *result;
+    result = [[[PLCrashMachExceptionPort alloc] initWithServerPort: port
+                                                              mask: mask
+                                                          behavior: PLCRASH_DEFAULT_BEHAVIOR
+                                                            flavor: PLCRASH_DEFAULT_THREAD_FLAVOR] autorelease];
+
+    /* Drop our send right */
+    mach_port_deallocate(mach_task_self(), port);
+
+    return result;
+}
+
+/**
+ * Remove the exception port registration for @a task, if any. Upon return, the registration's callback
+ * will not be executing on any server thread, and will not be called again. Any exception messages pending
+ * on the registration's port will be destroyed, and the kernel will fall back to the next available handler.
+ *
+ * @param task The task for which the registration should be removed.
+ *
+ * @warning This method must not be called from within the registration's own callback.
+ */
+- (void) removeExceptionPortForTask: (task_t) task {
+    NSAssert(_serverContext != NULL, @"No handler registered!");
+
+    struct plcrash_exception_server_registration *reg = NULL;
+
+    pthread_mutex_lock(&_serverContext->lock); {
+        struct plcrash_exception_server_registration **prev = &_serverContext->registrations;
+        for (reg = *prev; reg != NULL; prev = &reg->next, reg = reg->next) {
+            if (reg->task == task) {
+                *prev = reg->next;
+                break;
+            }
+        }
+
+        /* Wait for any in-flight callbacks to complete */
+        while (reg != NULL && reg->active > 0)
+            pthread_cond_wait(&_serverContext->server_cond, &_serverContext->lock);
+    } pthread_mutex_unlock(&_serverContext->lock);
+
+    if (reg == NULL)
+        return;
+
+    /* Destroying the receive right removes it from the port set */
+    mach_port_mod_refs(mach_task_self(), reg->port, MACH_PORT_RIGHT_RECEIVE, -1);
+    free(reg);
+}
+
 /**
  * Send a Mach exception reply for the given @a request and return the result.
  *
@@ -519,80 +862,120 @@ static mach_msg_return_t exception_server_reply (PLRequest_exception_raise_t *re
     return mach_msg(&reply.Head, MACH_SEND_MSG, reply.Head.msgh_size, 0, MACH_PORT_NULL, MACH_MSG_TIMEOUT_NONE, MACH_PORT_NULL);
 }
 
-
 /**
- * Forward a Mach exception to the given exception to the first matching handler in @a state, if any.
+ * Send a successful EXCEPTION_STATE_IDENTITY reply for the given @a request and return the result.
  *
- * @param task The task in which the exception occured.
- * @param thread The thread on which the exception occured. The thread will be suspended when the callback is issued, and may be resumed
- * by the callback using thread_resume().
- * @param exception_type Mach exception type.
- * @param code Mach exception codes.
- * @param code_count The number of codes provided.
- * @param port_state The set of exception handlers to which the message should be forwarded.
+ * The kernel applies the returned thread state to the thread when it is resumed. As the exception may have been
+ * handled by modifying the thread's state directly (eg, by a forwarded handler), the thread's current state is
+ * returned; the state supplied in @a request is only used if the current state can not be fetched.
  *
- * @return Returns KERN_SUCCESS if the exception was handled by a registered exception server, or an error
- * if the exception was not handled, or forwarding failed.
+ * @param request The request to which a reply should be sent.
+ * @param flavor The flavor of @a state.
+ * @param state The thread state supplied in @a request.
+ * @param state_count The number of natural_t values in @a state.
+ */
+static mach_msg_return_t exception_server_reply_state (PLRequest_exception_raise_t *request,
+                                                       thread_state_flavor_t flavor,
+                                                       const natural_t *state,
+                                                       mach_msg_type_number_t state_count)
+{
+    PLReply_exception_raise_state_identity_t reply;
+
+    /* Initialize the reply */
+    memset(&reply, 0, offsetof(PLReply_exception_raise_state_identity_t, new_state));
+    reply.Head.msgh_bits = MACH_MSGH_BITS(MACH_MSGH_BITS_REMOTE(request->Head.msgh_bits), 0);
+    reply.Head.msgh_local_port = MACH_PORT_NULL;
+    reply.Head.msgh_remote_port = request->Head.msgh_remote_port;
+    reply.NDR = NDR_record;
+    reply.RetCode = KERN_SUCCESS;
+    reply.flavor = flavor;
+
+    mach_msg_type_number_t reply_state_count = sizeof(reply.new_state) / sizeof(reply.new_state[0]);
+    if (thread_get_state(request->thread.name, flavor, (thread_state_t) reply.new_state, &reply_state_count) != KERN_SUCCESS) {
+        reply_state_count = state_count;
+        plcrash_async_memcpy(reply.new_state, state, state_count * sizeof(natural_t));
+    }
+    reply.new_stateCnt = reply_state_count;
+    reply.Head.msgh_size = (mach_msg_size_t) (offsetof(PLReply_exception_raise_state_identity_t, new_state) + reply_state_count * sizeof(natural_t));
+
+    /* See exception_server_reply() regarding the reply id offset */
+    reply.Head.msgh_id = request->Head.msgh_id + 100;
+
+    /* Dispatch the reply */
+    return mach_msg(&reply.Head, MACH_SEND_MSG, reply.Head.msgh_size, 0, MACH_PORT_NULL, MACH_MSG_TIMEOUT_NONE, MACH_PORT_NULL);
+}
+
+/**
+ * Locate the thread state supplied in an EXCEPTION_STATE_IDENTITY @a request.
  *
- * @par In-Process Operation
+ * The request's code array is variable-length; the fields that follow it are shifted towards the start of the
+ * message by any codes that were omitted by the sender.
  *
- * When operating in-process, handling the exception replies internally breaks external debuggers,
- * as they assume it is safe to leave our thread suspended. This results in the target thread never resuming,
- * as our thread never wakes up to reply to the message, or to handle future messages.
+ * @param request The exception_raise_state_identity request.
+ * @param[out] flavor On success, the flavor of the supplied thread state.
+ * @param[out] state On success, a pointer to the thread state within @a request.
+ * @param[out] state_count On success, the number of natural_t values in @a state.
  *
- * The recommended solution is to simply not register a Mach exception handler in the case where a debugger
- * is already attached.
+ * @return Returns true on success, or false if the message is malformed.
+ */
+static bool exception_server_request_state (PLRequest_exception_raise_t *request,
+                                            thread_state_flavor_t *flavor,
+                                            natural_t **state,
+                                            mach_msg_type_number_t *state_count)
+{
+    typedef PLRequest_exception_raise_state_identity_t req_t;
+    req_t *state_request = (req_t *) request;
+    const size_t max_codes = sizeof(state_request->code) / sizeof(state_request->code[0]);
+    const size_t max_state = sizeof(state_request->old_state) / sizeof(state_request->old_state[0]);
+
+    if (request->codeCnt > max_codes)
+        return false;
+
+    size_t shift = (max_codes - request->codeCnt) * sizeof(state_request->code[0]);
+    size_t state_offset = offsetof(req_t, old_state) - shift;
+    if (request->Head.msgh_size < state_offset)
+        return false;
+
+    uint8_t *base = (uint8_t *) request;
+    mach_msg_type_number_t count = *(mach_msg_type_number_t *) (base + offsetof(req_t, old_stateCnt) - shift);
+    if (count > max_state || state_offset + count * sizeof(natural_t) > request->Head.msgh_size)
+        return false;
+
+    *flavor = *(int *) (base + offsetof(req_t, flavor) - shift);
+    *state = (natural_t *) (base + state_offset);
+    *state_count = count;
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Forward a Mach exception to the resolved forwarding target @a entry.
  *
  * @note This function may be called at crash-time.
  */
-kern_return_t PLCrashMachExceptionForward (task_t task,
-                                           thread_t thread,
-                                           exception_type_t exception_type,
-                                           mach_exception_data_t code,
-                                           mach_msg_type_number_t code_count,
-                                           plcrash_mach_exception_port_set_t *port_state)
+static kern_return_t exception_forward_entry (task_t task,
+                                              thread_t thread,
+                                              exception_type_t exception_type,
+                                              mach_exception_data_t code,
+                                              mach_msg_type_number_t code_count,
+                                              const plcrash_mach_exception_forward_entry_t *entry)
 {
-    exception_behavior_t behavior;
-    thread_state_flavor_t flavor;
-    mach_port_t port;
-    
-    /* Find a matching handler */
-    exception_mask_t fwd_mask = exception_to_mask(exception_type);
-    bool found = false;
-    for (mach_msg_type_number_t i = 0; i < port_state->count; i++) {
-        if (!MACH_PORT_VALID(port_state->ports[i]))
-            continue;
-        
-        if ((port_state->masks[i] & fwd_mask) == 0)
-            continue;
-        
-        found = true;
-        port = port_state->ports[i];
-        behavior = port_state->behaviors[i];
-        flavor = port_state->flavors[i];
-        break;
-    }
-    
-    /* No handler found */
-    if (!found) {
-        return KERN_FAILURE;
-    }
-    
+    mach_port_t port = entry->port;
+    exception_behavior_t behavior = entry->behavior;
+    thread_state_flavor_t flavor = entry->flavor;
+    bool mach_exc_codes = entry->mach_exc_codes;
+
     thread_state_data_t thread_state;
     mach_msg_type_number_t thread_state_count;
     kern_return_t kr;
     
     /* We prefer 64-bit codes; if the user requests 32-bit codes, we need to map them */
     exception_data_type_t code32[code_count];
-    for (mach_msg_type_number_t i = 0; i < code_count; i++) {
-        code32[i] = (uint64_t) code[i];
-    }
-    
-    /* Strip the MACH_EXCEPTION_CODES modifier from the behavior flags */
-    bool mach_exc_codes = false;
-    if (behavior & MACH_EXCEPTION_CODES) {
-        mach_exc_codes = true;
-        behavior &= ~MACH_EXCEPTION_CODES;
+    if (!mach_exc_codes) {
+        for (mach_msg_type_number_t i = 0; i < code_count; i++) {
+            code32[i] = (uint64_t) code[i];
+        }
     }
     
     /*
@@ -653,6 +1036,102 @@ kern_return_t PLCrashMachExceptionForward (task_t task,
     return KERN_FAILURE;
 }
 
+/**
+ * Forward a Mach exception to the given exception to the first matching handler in @a state, if any.
+ *
+ * @param task The task in which the exception occured.
+ * @param thread The thread on which the exception occured. The thread will be suspended when the callback is issued, and may be resumed
+ * by the callback using thread_resume().
+ * @param exception_type Mach exception type.
+ * @param code Mach exception codes.
+ * @param code_count The number of codes provided.
+ * @param port_state The set of exception handlers to which the message should be forwarded.
+ *
+ * @return Returns KERN_SUCCESS if the exception was handled by a registered exception server, or an error
+ * if the exception was not handled, or forwarding failed.
+ *
+ * @par In-Process Operation
+ *
+ * When operating in-process, handling the exception replies internally breaks external debuggers,
+ * as they assume it is safe to leave our thread suspended. This results in the target thread never resuming,
+ * as our thread never wakes up to reply to the message, or to handle future messages.
+ *
+ * The recommended solution is to simply not register a Mach exception handler in the case where a debugger
+ * is already attached.
+ *
+ * @note This function may be called at crash-time. Where the port set is known in advance, the precomputed
+ * PLCrashMachExceptionForwardWithTable() should be preferred.
+ */
+kern_return_t PLCrashMachExceptionForward (task_t task,
+                                           thread_t thread,
+                                           exception_type_t exception_type,
+                                           mach_exception_data_t code,
+                                           mach_msg_type_number_t code_count,
+                                           plcrash_mach_exception_port_set_t *port_state)
+{
+    plcrash_mach_exception_forward_entry_t entry;
+
+    /* Find a matching handler */
+    exception_mask_t fwd_mask = exception_to_mask(exception_type);
+    bool found = false;
+    for (mach_msg_type_number_t i = 0; i < port_state->count; i++) {
+        if (!MACH_PORT_VALID(port_state->ports[i]))
+            continue;
+        
+        if ((port_state->masks[i] & fwd_mask) == 0)
+            continue;
+        
+        found = true;
+        entry.port = port_state->ports[i];
+        entry.behavior = port_state->behaviors[i] & ~MACH_EXCEPTION_CODES;
+        entry.mach_exc_codes = (port_state->behaviors[i] & MACH_EXCEPTION_CODES) != 0;
+        entry.flavor = port_state->flavors[i];
+        break;
+    }
+    
+    /* No handler found */
+    if (!found) {
+        return KERN_FAILURE;
+    }
+
+    return exception_forward_entry(task, thread, exception_type, code, code_count, &entry);
+}
+
+/**
+ * Forward a Mach exception to the handler registered for @a exception_type in the precomputed forwarding
+ * @a table, if any. This is equivalent to PLCrashMachExceptionForward(), but resolves the target handler
+ * with a single table lookup.
+ *
+ * @param task The task in which the exception occured.
+ * @param thread The thread on which the exception occured.
+ * @param exception_type Mach exception type.
+ * @param code Mach exception codes.
+ * @param code_count The number of codes provided.
+ * @param table The forwarding table, as computed by plcrash_mach_exception_forward_table_init() or
+ * PLCrashMachExceptionPortSet::forwardTable.
+ *
+ * @return Returns KERN_SUCCESS if the exception was handled by a registered exception server, or an error
+ * if the exception was not handled, or forwarding failed.
+ *
+ * @note This function may be called at crash-time.
+ */
+kern_return_t PLCrashMachExceptionForwardWithTable (task_t task,
+                                                    thread_t thread,
+                                                    exception_type_t exception_type,
+                                                    mach_exception_data_t code,
+                                                    mach_msg_type_number_t code_count,
+                                                    const plcrash_mach_exception_forward_table_t *table)
+{
+    if (exception_type < 0 || exception_type >= EXC_TYPES_COUNT)
+        return KERN_FAILURE;
+
+    const plcrash_mach_exception_forward_entry_t *entry = &table->entries[exception_type];
+    if (!MACH_PORT_VALID(entry->port))
+        return KERN_FAILURE;
+
+    return exception_forward_entry(task, thread, exception_type, code, code_count, entry);
+}
+
 
 /**
  * Background exception server. Handles incoming exception messages and dispatches
@@ -668,14 +1147,20 @@ static void *exception_server_thread (void *arg) {
     kern_return_t kr;
     mach_msg_return_t mr;
     
-    /* Initialize the received message with a default size */
-    request_size = round_page(sizeof(*request));
+    /* Allocate a receive buffer large enough for any exception message. The buffer is prefaulted and wired, so
+     * that receiving the first exception message does not trigger page faults against a possibly damaged
+     * process. */
+    request_size = PLCRASH_REQUEST_BUFFER_SIZE;
     kr = vm_allocate(mach_task_self(), (vm_address_t *) &request, request_size, VM_FLAGS_ANYWHERE);
     if (kr != KERN_SUCCESS) {
         /* Shouldn't happen ... */
         fprintf(stderr, "Unexpected error in vm_allocate(): %x\n", kr);
         return NULL;
     }
+
+    memset(request, 0, request_size);
+    if (mlock(request, request_size) != 0)
+        PLCF_DEBUG("Could not wire the exception receive buffer: %d", errno);
     
     /* Wait for an exception message */
     while (true) {
@@ -689,14 +1174,17 @@ static void *exception_server_thread (void *arg) {
                       exc_context->port_set,
                       MACH_MSG_TIMEOUT_NONE,
                       MACH_PORT_NULL);
+        uint64_t received_at = mach_absolute_time();
         
         /* Handle recoverable errors */
         if (mr != MACH_MSG_SUCCESS && mr == MACH_RCV_TOO_LARGE) {
-            /* Determine the new size (before dropping the buffer) */
-            request_size = round_page(request->Head.msgh_size);
+            /* Determine the new size (before dropping the buffer). This is not expected, as the buffer is sized for
+             * the largest exception message. */
+            size_t new_size = round_page(request->Head.msgh_size + MAX_TRAILER_SIZE);
             
             /* Drop the old receive buffer */
             vm_deallocate(mach_task_self(), (vm_address_t) request, request_size);
+            request_size = new_size;
             
             /* Re-allocate a larger receive buffer */
             kr = vm_allocate(mach_task_self(), (vm_address_t *) &request, request_size, VM_FLAGS_ANYWHERE);
@@ -736,10 +1224,11 @@ static void *exception_server_thread (void *arg) {
                      * spuriously with the process in an unknown state, in which case we must not call
                      * out to non-async-safe functions */
                     if (exc_context->server_should_stop) {
-                        /* Inform the requesting thread of completion */
+                        /* Inform the requesting thread of completion. Each termination message is consumed by
+                         * exactly one server thread. */
                         pthread_mutex_lock(&exc_context->lock); {
-                            exc_context->server_stop_done = true;
-                            pthread_cond_signal(&exc_context->server_cond);
+                            exc_context->server_thread_count--;
+                            pthread_cond_broadcast(&exc_context->server_cond);
                         } pthread_mutex_unlock(&exc_context->lock);
                         
                         /* Ensure a quick death if we access exc_context after termination  */
@@ -773,21 +1262,105 @@ static void *exception_server_thread (void *arg) {
             mach_exception_data_type_t *code64 = request->code;
 #endif
             
+            /* Locate the thread state supplied with EXCEPTION_STATE_IDENTITY messages */
+            thread_state_flavor_t flavor = THREAD_STATE_NONE;
+            natural_t *state = NULL;
+            mach_msg_type_number_t state_count = 0;
+            if (request->Head.msgh_id == PLCRASH_STATE_IDENTITY_MSGH_ID && !exception_server_request_state(request, &flavor, &state, &state_count)) {
+                PLCF_DEBUG("Malformed thread state in exception message");
+
+                /* Provide a negative reply */
+                mr = exception_server_reply(request, KERN_FAILURE);
+                if (mr != MACH_MSG_SUCCESS)
+                    PLCF_DEBUG("Unexpected failure replying to Mach exception message: 0x%x", mr);
+
+                continue;
+            }
+
+            /*
+             * Messages received on anything other than the primary server port are dispatched to the matching
+             * per-task registration. The primary port is handled without locking, as the state of the current
+             * process is unknown.
+             */
+            struct plcrash_exception_server_registration *reg = NULL;
+            if (request->Head.msgh_local_port != exc_context->server_port) {
+                pthread_mutex_lock(&exc_context->lock); {
+                    for (reg = exc_context->registrations; reg != NULL; reg = reg->next) {
+                        if (reg->port == request->Head.msgh_local_port) {
+                            reg->active++;
+                            break;
+                        }
+                    }
+                } pthread_mutex_unlock(&exc_context->lock);
+
+                /* The registration was removed after the message was dequeued */
+                if (reg == NULL) {
+                    mr = exception_server_reply(request, KERN_FAILURE);
+                    if (mr != MACH_MSG_SUCCESS)
+                        PLCF_DEBUG("Unexpected failure replying to Mach exception message: 0x%x", mr);
+
+                    continue;
+                }
+            }
+
             /* Call our handler. */
+            uint64_t handler_start = mach_absolute_time();
             kern_return_t exc_result;
-            exc_result = exc_context->callback(request->task.name,
-                                               request->thread.name,
-                                               request->exception,
-                                               code64,
-                                               request->codeCnt,
-                                               exc_context->callback_context);
+            if (reg != NULL) {
+                exc_result = reg->callback(request->task.name,
+                                           request->thread.name,
+                                           request->exception,
+                                           code64,
+                                           request->codeCnt,
+                                           reg->context);
+
+                /* Inform any waiting unregistration that the callback has completed */
+                pthread_mutex_lock(&exc_context->lock); {
+                    reg->active--;
+                    pthread_cond_broadcast(&exc_context->server_cond);
+                } pthread_mutex_unlock(&exc_context->lock);
+                reg = NULL;
+            } else if (exc_context->state_callback != NULL) {
+                exc_result = exc_context->state_callback(request->task.name,
+                                                         request->thread.name,
+                                                         request->exception,
+                                                         code64,
+                                                         request->codeCnt,
+                                                         flavor,
+                                                         state,
+                                                         state_count,
+                                                         exc_context->callback_context);
+            } else {
+                exc_result = exc_context->callback(request->task.name,
+                                                   request->thread.name,
+                                                   request->exception,
+                                                   code64,
+                                                   request->codeCnt,
+                                                   exc_context->callback_context);
+            }
             
             /*
-             * Reply to the message.
+             * Reply to the message. A successful EXCEPTION_STATE_IDENTITY reply must return the thread state; failure
+             * replies share the short reply format.
              */
-            mr = exception_server_reply(request, exc_result);
+            if (exc_result == KERN_SUCCESS && state != NULL) {
+                mr = exception_server_reply_state(request, flavor, state, state_count);
+            } else {
+                mr = exception_server_reply(request, exc_result);
+            }
             if (mr != MACH_MSG_SUCCESS)
                 PLCF_DEBUG("Unexpected failure replying to Mach exception message: 0x%x", mr);
+
+            /* Report latency once the exception has been handled */
+            PLCrashMachExceptionLatencyCallback latency_callback = exc_context->latency_callback;
+            if (latency_callback != NULL) {
+                uint64_t handler_end = mach_absolute_time();
+                mach_timebase_info_data_t *tb = &exc_context->timebase;
+
+                uint64_t dispatch_ns = ((handler_start - received_at) * tb->numer) / tb->denom;
+                uint64_t handler_ns = ((handler_end - handler_start) * tb->numer) / tb->denom;
+                latency_callback(dispatch_ns, handler_ns, exc_context->latency_context);
+            }
         }
     }
     
@@ -811,29 +1384,45 @@ static void *exception_server_thread (void *arg) {
     /* Mark the server for termination */
     OSAtomicCompareAndSwap32Barrier(0, 1, (int32_t *) &_serverContext->server_should_stop);
 
-    /* Wake up the waiting server */
-    mach_msg_header_t msg;
-    memset(&msg, 0, sizeof(msg));
-    msg.msgh_bits = MACH_MSGH_BITS(MACH_MSG_TYPE_COPY_SEND, MACH_MSG_TYPE_MAKE_SEND_ONCE);
-    msg.msgh_local_port = MACH_PORT_NULL;
-    msg.msgh_remote_port = _serverContext->notify_port;
-    msg.msgh_size = sizeof(msg);
-    msg.msgh_id = PLCRASH_TERMINATE_MSGH_ID;
+    /* Wake up the waiting server threads; each thread will consume exactly one termination message */
+    uint32_t thread_count;
+    pthread_mutex_lock(&_serverContext->lock); {
+        thread_count = _serverContext->server_thread_count;
+    } pthread_mutex_unlock(&_serverContext->lock);
 
-    mr = mach_msg(&msg, MACH_SEND_MSG, msg.msgh_size, 0, MACH_PORT_NULL, MACH_MSG_TIMEOUT_NONE, MACH_PORT_NULL);
+    for (uint32_t i = 0; i < thread_count; i++) {
+        mach_msg_header_t msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msgh_bits = MACH_MSGH_BITS(MACH_MSG_TYPE_COPY_SEND, MACH_MSG_TYPE_MAKE_SEND_ONCE);
+        msg.msgh_local_port = MACH_PORT_NULL;
+        msg.msgh_remote_port = _serverContext->notify_port;
+        msg.msgh_size = sizeof(msg);
+        msg.msgh_id = PLCRASH_TERMINATE_MSGH_ID;
 
-    if (mr != MACH_MSG_SUCCESS) {
-        NSLog(@"Unexpected error sending termination message to background thread: %d", mr);
-        return;
+        mr = mach_msg(&msg, MACH_SEND_MSG, msg.msgh_size, 0, MACH_PORT_NULL, MACH_MSG_TIMEOUT_NONE, MACH_PORT_NULL);
+
+        if (mr != MACH_MSG_SUCCESS) {
+            NSLog(@"Unexpected error sending termination message to background thread: %d", mr);
+            return;
+        }
     }
 
     /* Wait for completion */
     pthread_mutex_lock(&_serverContext->lock);
-    while (!_serverContext->server_stop_done) {
+    while (_serverContext->server_thread_count > 0) {
         pthread_cond_wait(&_serverContext->server_cond, &_serverContext->lock);
     }
     pthread_mutex_unlock(&_serverContext->lock);
 
+    /* Drop any remaining task registrations */
+    while (_serverContext->registrations != NULL) {
+        struct plcrash_exception_server_registration *reg = _serverContext->registrations;
+        _serverContext->registrations = reg->next;
+
+        mach_port_mod_refs(mach_task_self(), reg->port, MACH_PORT_RIGHT_RECEIVE, -1);
+        free(reg);
+    }
+
     /* Server is now dead, can clean up all resources */
     if (_serverContext->server_port != MACH_PORT_NULL)
         mach_port_deallocate(mach_task_self(), _serverContext->server_port);
@@ -36,8 +36,10 @@
 #import "PLCrashMachExceptionPort.h"
 #import "PLCrashHostInfo.h"
 #import "PLCrashAsync.h"
+#import "PLCrashAsyncThread.h"
 
 #include <sys/mman.h>
+#include <libkern/OSAtomic.h>
 
 @interface PLCrashMachExceptionServerTests : SenTestCase {
     plcrash_mach_exception_port_set_t _task_ports;
@@ -154,6 +156,137 @@ static kern_return_t exception_callback (task_t task,
     STAssertEquals(crash_page[1], (uint8_t)0xFE, @"Crash callback did not run");
 }
 
+/**
+ * Test dispatch of exceptions to a per-task registration serviced by additional server threads.
+ */
+- (void) testTaskRegistration {
+    NSError *error;
+    BOOL didRun = NO;
+
+    PLCrashMachExceptionServer *server = [[[PLCrashMachExceptionServer alloc] initWithCallBack: exception_callback
+                                                                                       context: NULL
+                                                                                         error: &error] autorelease];
+    STAssertNotNil(server, @"Failed to initialize server");
+    STAssertTrue([server addServerThreads: 2 error: &error], @"Failed to spawn server threads: %@", error);
+
+    PLCrashMachExceptionPort *port = [server exceptionPortForTask: mach_task_self()
+                                                             mask: EXC_MASK_BAD_ACCESS
+                                                         callBack: exception_callback
+                                                          context: &didRun
+                                                            error: &error];
+    STAssertNotNil(port, @"Failed to register task: %@", error);
+    STAssertNil([server exceptionPortForTask: mach_task_self() mask: EXC_MASK_BAD_ACCESS callBack: exception_callback context: NULL error: NULL],
+                @"Duplicate task registration should fail");
+
+    STAssertTrue([port registerForTask: mach_task_self()
+                       previousPortSet: NULL
+                                 error: &error], @"Failed to configure handler: %@", error);
+
+    mprotect(crash_page, sizeof(crash_page), 0);
+
+    /* If the test doesn't lock up here, it's working */
+    crash_page[0] = 0xCA;
+
+    STAssertEquals(crash_page[0], (uint8_t)0xCA, @"Page should have been set to test value");
+    STAssertEquals(crash_page[1], (uint8_t)0xFE, @"Crash callback did not run");
+    STAssertTrue(didRun, @"Task registration callback was not executed");
+
+    /* The original task exception ports are restored in -tearDown */
+    [server removeExceptionPortForTask: mach_task_self()];
+}
+
+static kern_return_t state_exception_callback (task_t task,
+                                               thread_t thread,
+                                               exception_type_t exception_type,
+                                               mach_exception_data_t code,
+                                               mach_msg_type_number_t code_count,
+                                               thread_state_flavor_t flavor,
+                                               const natural_t *state,
+                                               mach_msg_type_number_t state_count,
+                                               void *context)
+{
+    mprotect(crash_page, sizeof(crash_page), PROT_READ|PROT_WRITE);
+
+    plcrash_async_thread_state_t thread_state;
+    if (state == NULL) {
+        crash_page[1] = 0xFA;
+    } else if (plcrash_async_thread_state_mach_state_init(&thread_state, thread, flavor, state, state_count) != PLCRASH_ESUCCESS) {
+        crash_page[1] = 0xFB;
+    } else if (plcrash_async_thread_state_get_reg(&thread_state, PLCRASH_REG_SP) == 0) {
+        crash_page[1] = 0xFC;
+    } else {
+        // Success
+        crash_page[1] = 0xFE;
+    }
+
+    return KERN_SUCCESS;
+}
+
+/**
+ * Test that the faulting thread's state is delivered to a server registered with the EXCEPTION_STATE_IDENTITY
+ * behavior, and that the thread is resumed once the exception has been handled.
+ */
+- (void) testStateIdentityServer {
+    NSError *error;
+
+    PLCrashMachExceptionServer *server = [[[PLCrashMachExceptionServer alloc] initWithStateCallBack: state_exception_callback
+                                                                                            context: NULL
+                                                                                              error: &error] autorelease];
+    STAssertNotNil(server, @"Failed to initialize server");
+
+    PLCrashMachExceptionPort *port = [server exceptionPortWithMask: EXC_MASK_BAD_ACCESS error: &error];
+    STAssertNotNil(port, @"Failed to fetch server port: %@", error);
+    STAssertEquals((exception_behavior_t) (port.behavior & ~MACH_EXCEPTION_CODES), (exception_behavior_t) EXCEPTION_STATE_IDENTITY, @"Incorrect behavior");
+
+    STAssertTrue([port registerForTask: mach_task_self()
+                       previousPortSet: NULL
+                                 error: &error], @"Failed to configure handler: %@", error);
+
+    mprotect(crash_page, sizeof(crash_page), 0);
+
+    /* If the test doesn't lock up here, it's working */
+    crash_page[0] = 0xCA;
+
+    STAssertEquals(crash_page[0], (uint8_t)0xCA, @"Page should have been set to test value");
+    STAssertEquals(crash_page[1], (uint8_t)0xFE, @"Crash callback did not receive a valid thread state");
+}
+
+static void latency_callback (uint64_t dispatch_latency_ns, uint64_t handler_duration_ns, void *context) {
+    volatile uint32_t *count = context;
+    OSAtomicIncrement32Barrier((volatile int32_t *) count);
+}
+
+/**
+ * Test that the latency callback is issued once the exception has been handled.
+ */
+- (void) testLatencyCallback {
+    NSError *error;
+    volatile uint32_t count = 0;
+
+    PLCrashMachExceptionServer *server = [[[PLCrashMachExceptionServer alloc] initWithCallBack: exception_callback
+                                                                                       context: NULL
+                                                                                         error: &error] autorelease];
+    STAssertNotNil(server, @"Failed to initialize server");
+    [server setLatencyCallback: latency_callback context: (void *) &count];
+
+    PLCrashMachExceptionPort *port = [server exceptionPortWithMask: EXC_MASK_BAD_ACCESS error: &error];
+    STAssertNotNil(port, @"Failed to fetch server port: %@", error);
+
+    STAssertTrue([port registerForTask: mach_task_self()
+                       previousPortSet: NULL
+                                 error: &error], @"Failed to configure handler: %@", error);
+
+    mprotect(crash_page, sizeof(crash_page), 0);
+    crash_page[0] = 0xCA;
+    STAssertEquals(crash_page[1], (uint8_t)0xFE, @"Crash callback did not run");
+
+    /* The latency callback is issued after the reply is sent, and may race the resumed thread */
+    for (int i = 0; i < 1000 && count == 0; i++)
+        usleep(1000);
+
+    STAssertEquals(count, (uint32_t) 1, @"Latency callback was not issued exactly once");
+}
+
 /**
  * Test inserting/removing the mach exception server from the handler chain.
  */
@@ -238,6 +371,17 @@ static kern_return_t exception_callback (task_t task,
                                                    &port_set);
     STAssertEquals(KERN_SUCCESS, kt, @"Callback did not return KERN_SUCCESS");
     STAssertTrue(didRun, @"Calback was not executed");
+
+    /* Forward via the precomputed table */
+    didRun = false;
+    plcrash_mach_exception_forward_table_t forward_table = portSet.forwardTable;
+    kt = PLCrashMachExceptionForwardWithTable(mach_task_self(), pl_mach_thread_self(), EXC_BAD_ACCESS, codes, 2, &forward_table);
+    STAssertEquals(KERN_SUCCESS, kt, @"Callback did not return KERN_SUCCESS");
+    STAssertTrue(didRun, @"Calback was not executed");
+
+    /* No handler is registered for EXC_BAD_INSTRUCTION */
+    kt = PLCrashMachExceptionForwardWithTable(mach_task_self(), pl_mach_thread_self(), EXC_BAD_INSTRUCTION, codes, 2, &forward_table);
+    STAssertEquals(KERN_FAILURE, kt, @"Forwarding should fail without a matching handler");
 }
 
 /**
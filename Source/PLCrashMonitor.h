@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <mach/mach.h>
+
+@class PLCrashMonitor;
+
+/**
+ * The PLCrashMonitorDelegate protocol is used to notify a monitor's owner of written crash reports.
+ */
+@protocol PLCrashMonitorDelegate <NSObject>
+
+/**
+ * Called after a crash report has been written for the monitored task. The delegate is called on the monitor's
+ * exception server thread, or, if the report was written from a corpse, on the monitor's background report queue.
+ *
+ * @param monitor The monitor that wrote the report.
+ * @param path The path to the written report.
+ */
+- (void) crashMonitor: (PLCrashMonitor *) monitor didWriteReportAtPath: (NSString *) path;
+
+@end
+
+@interface PLCrashMonitor : NSObject {
+@private
+    /** The monitored task. A send right is held for the lifetime of the monitor. */
+    task_t _task;
+
+    /** The application identifier and version written to reports. */
+    NSString *_applicationIdentifier;
+    NSString *_applicationVersion;
+
+    /** The directory to which reports are written. */
+    NSString *_outputDirectory;
+
+    /** The delegate, if any. Not retained. */
+    id<PLCrashMonitorDelegate> _delegate;
+
+    /** The exception server, or nil if the monitor has not been started. */
+    id _server;
+
+    /** The target task's previously registered exception ports, or nil if the monitor has not been started. */
+    id _previousPorts;
+
+    /** If YES, crashed tasks are captured as corpses, and reports are written asynchronously. */
+    BOOL _capturesCorpses;
+
+    /** Serial queue on which corpse reports are written, or NULL if the monitor has not been started. */
+    dispatch_queue_t _reportQueue;
+}
+
+- (id) initWithTask: (task_t) task
+applicationIdentifier: (NSString *) applicationIdentifier
+         appVersion: (NSString *) applicationVersion
+    outputDirectory: (NSString *) outputDirectory;
+
+- (BOOL) startAndReturnError: (NSError **) outError;
+- (void) stop;
+
+/** The monitored task. */
+@property(nonatomic, readonly) task_t task;
+
+/** The directory to which crash reports are written. */
+@property(nonatomic, readonly) NSString *outputDirectory;
+
+/** If YES, and corpses are supported by the host, the crashed task is captured as a corpse and released to the
+ * kernel immediately, with the report written asynchronously from the corpse. Defaults to YES. */
+@property(nonatomic, assign) BOOL capturesCorpses;
+
+/** The delegate to be notified of written reports. The delegate is not retained. */
+@property(nonatomic, assign) id<PLCrashMonitorDelegate> delegate;
+
+@end
@@ -0,0 +1,693 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "CrashReporter.h"
+#import "PLCrashMonitor.h"
+#import "PLCrashReporterNSError.h"
+#import "PLCrashFeatureConfig.h"
+#import "PLCrashHostInfo.h"
+
+#import "PLCrashLogWriter.h"
+#import "PLCrashAsyncImageList.h"
+#import "PLCrashAsyncMachExceptionInfo.h"
+
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS
+#import "PLCrashMachExceptionServer.h"
+#import "PLCrashMachExceptionPort.h"
+#import "PLCrashMachExceptionPortSet.h"
+#endif
+
+#import <fcntl.h>
+#import <inttypes.h>
+#import <mach-o/dyld_images.h>
+
+#define NSDEBUG(msg, args...) {\
+    NSLog(@"[PLCrashMonitor] " msg, ## args); \
+}
+
+/**
+ * @internal
+ *
+ * The exception types monitored by PLCrashMonitor. These match the exceptions monitored by PLCrashReporter's
+ * in-process Mach exception handler.
+ */
+#define PLCRASH_MONITOR_EXCEPTION_MASK (EXC_MASK_BAD_ACCESS | EXC_MASK_BAD_INSTRUCTION | EXC_MASK_ARITHMETIC | \
+                                        EXC_MASK_SOFTWARE | EXC_MASK_BREAKPOINT)
+
+@interface PLCrashMonitor (PrivateMethods)
+- (kern_return_t) handleExceptionForTask: (task_t) task
+                                  thread: (thread_t) thread
+                           exceptionType: (exception_type_t) exception_type
+                                    code: (mach_exception_data_t) code
+                               codeCount: (mach_msg_type_number_t) code_count;
+
+- (BOOL) initializeWriter: (plcrash_log_writer_t *) writer;
+
+- (BOOL) captureCorpseForTask: (task_t) task
+                       thread: (thread_t) thread
+                exceptionType: (exception_type_t) exception_type
+                         code: (mach_exception_data_t) code
+                    codeCount: (mach_msg_type_number_t) code_count;
+
+- (void) writeReportWithWriter: (plcrash_log_writer_t *) writer
+                          task: (task_t) task
+                        thread: (thread_t) thread
+                 exceptionType: (exception_type_t) exception_type
+                          code: (mach_exception_data_t) code
+                     codeCount: (mach_msg_type_number_t) code_count;
+@end
+
+/**
+ * @internal
+ *
+ * Read a NUL-terminated string of at most @a len - 1 bytes from @a address in @a task. The string is read in
+ * page-bounded chunks, as the bytes following the string's terminator may not be mapped.
+ *
+ * @return Returns true on success, or false if the string could not be read.
+ */
+static bool monitor_read_string (task_t task, pl_vm_address_t address, char *buffer, size_t len) {
+    size_t offset = 0;
+
+    while (offset + 1 < len) {
+        pl_vm_address_t cursor = address + offset;
+        size_t chunk = PAGE_SIZE - (cursor & (PAGE_SIZE - 1));
+        if (chunk > len - 1 - offset)
+            chunk = len - 1 - offset;
+
+        if (plcrash_async_task_memcpy(task, cursor, 0, buffer + offset, chunk) != PLCRASH_ESUCCESS)
+            return false;
+
+        void *nul = memchr(buffer + offset, '\0', chunk);
+        if (nul != NULL)
+            return true;
+
+        offset += chunk;
+    }
+
+    buffer[len - 1] = '\0';
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Register all images loaded in @a task with @a list, reading the task's dyld_all_image_infos
+ * out-of-process.
+ *
+ * @return Returns true on success, or false if the task's dyld image info could not be read.
+ */
+static bool monitor_image_list_populate (plcrash_async_image_list_t *list, task_t task) {
+    struct task_dyld_info dyld_info;
+    mach_msg_type_number_t count = TASK_DYLD_INFO_COUNT;
+    kern_return_t kt;
+
+    if ((kt = task_info(task, TASK_DYLD_INFO, (task_info_t) &dyld_info, &count)) != KERN_SUCCESS) {
+        PLCF_DEBUG("Could not fetch TASK_DYLD_INFO: %d", kt);
+        return false;
+    }
+
+    /* Determine the target's pointer size. dyld_all_image_infos begins with two uint32_t fields (version and
+     * infoArrayCount), followed by the infoArray pointer; each dyld_image_info entry is three pointers wide. */
+    size_t ptr_size;
+    if (dyld_info.all_image_info_format == TASK_DYLD_ALL_IMAGE_INFO_64) {
+        ptr_size = sizeof(uint64_t);
+    } else {
+        ptr_size = sizeof(uint32_t);
+    }
+
+    uint32_t header[2];
+    if (plcrash_async_task_memcpy(task, dyld_info.all_image_info_addr, 0, header, sizeof(header)) != PLCRASH_ESUCCESS)
+        return false;
+
+    uint64_t info_array = 0;
+    if (plcrash_async_task_memcpy(task, dyld_info.all_image_info_addr, sizeof(header), &info_array, ptr_size) != PLCRASH_ESUCCESS)
+        return false;
+
+    /* The info array is set to NULL while dyld is modifying it */
+    uint32_t image_count = header[1];
+    if (info_array == 0 || image_count == 0)
+        return false;
+
+    size_t entry_size = ptr_size * 3;
+    uint8_t *entries = malloc(entry_size * image_count);
+    if (entries == NULL)
+        return false;
+
+    if (plcrash_async_task_memcpy(task, (pl_vm_address_t) info_array, 0, entries, entry_size * image_count) != PLCRASH_ESUCCESS) {
+        free(entries);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < image_count; i++) {
+        uint64_t load_address = 0;
+        uint64_t path_address = 0;
+        char path[PATH_MAX];
+
+        memcpy(&load_address, entries + (i * entry_size), ptr_size);
+        memcpy(&path_address, entries + (i * entry_size) + ptr_size, ptr_size);
+        if (load_address == 0 || path_address == 0)
+            continue;
+
+        if (!monitor_read_string(task, (pl_vm_address_t) path_address, path, sizeof(path))) {
+            PLCF_DEBUG("Could not read the path of the image at 0x%" PRIx64, load_address);
+            continue;
+        }
+
+        plcrash_nasync_image_list_append(list, (pl_vm_address_t) load_address, path);
+    }
+
+    free(entries);
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * A pending corpse report.
+ */
+struct monitor_corpse_report {
+    /** The monitor. Not retained; the monitor drains its report queue prior to deallocation. */
+    PLCrashMonitor *monitor;
+
+    /** The report writer, configured for @a corpse. Owned by the report. */
+    plcrash_log_writer_t *writer;
+
+    /** The corpse task. */
+    mach_port_t corpse;
+
+    /** The crashed thread of @a corpse. */
+    thread_t thread;
+
+    /** Mach exception type. */
+    exception_type_t exception_type;
+
+    /** The number of exception codes. */
+    mach_msg_type_number_t code_count;
+
+    /** Mach exception codes. */
+    mach_exception_data_type_t code[];
+};
+
+/**
+ * @internal
+ *
+ * Write and free a pending corpse report. This is executed on the monitor's report queue.
+ */
+static void monitor_corpse_report_write (void *context) {
+    struct monitor_corpse_report *report = context;
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+    [report->monitor writeReportWithWriter: report->writer
+                                      task: report->corpse
+                                    thread: report->thread
+                             exceptionType: report->exception_type
+                                      code: report->code
+                                 codeCount: report->code_count];
+
+    mach_port_deallocate(mach_task_self(), report->thread);
+    mach_port_deallocate(mach_task_self(), report->corpse);
+    free(report->writer);
+    free(report);
+
+    [pool release];
+}
+
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS
+/**
+ * @internal
+ *
+ * Exception server callback. This runs on the monitor's exception server thread, outside of the crashed task, and
+ * is not subject to async-safety constraints.
+ */
+static kern_return_t monitor_exception_callback (task_t task, thread_t thread, exception_type_t exception_type, mach_exception_data_t code, mach_msg_type_number_t code_count, void *context) {
+    PLCrashMonitor *monitor = context;
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+    kern_return_t kr = [monitor handleExceptionForTask: task thread: thread exceptionType: exception_type code: code codeCount: code_count];
+
+    [pool release];
+    return kr;
+}
+#endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
+
+/**
+ * Monitors a separate task for crashes, writing crash reports out-of-process.
+ *
+ * The monitor registers itself as the target task's Mach exception server. When the target crashes, the monitor
+ * suspends the target's threads, then unwinds and symbolicates them from the monitor process. As the report is
+ * not written from within the crashed process, it does not depend on the state of the crashed process' heap or
+ * stack, and can make full use of symbol indexes and other non-async-safe facilities.
+ *
+ * Where supported, the monitor captures the crashed task as a corpse (see task_generate_corpse()) and replies to
+ * the exception immediately; the report is then written from the corpse on a background queue, allowing the crashed
+ * process to terminate without waiting for the report to be written.
+ *
+ * The monitor requires a send right to the target's task port, as may be acquired via task_for_pid(), or sent to the
+ * monitor by the target process itself.
+ *
+ * @note Out-of-process monitoring is only supported on Mac OS X.
+ */
+@implementation PLCrashMonitor
+
+@synthesize task = _task;
+@synthesize outputDirectory = _outputDirectory;
+@synthesize delegate = _delegate;
+@synthesize capturesCorpses = _capturesCorpses;
+
+/**
+ * Initialize a new monitor instance.
+ *
+ * @param task The task to be monitored. The monitor will acquire its own send right to @a task.
+ * @param applicationIdentifier The application identifier to be written to crash reports.
+ * @param applicationVersion The application version to be written to crash reports.
+ * @param outputDirectory The directory to which crash reports will be written.
+ */
+- (id) initWithTask: (task_t) task
+applicationIdentifier: (NSString *) applicationIdentifier
+         appVersion: (NSString *) applicationVersion
+    outputDirectory: (NSString *) outputDirectory
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    kern_return_t kr = mach_port_mod_refs(mach_task_self(), task, MACH_PORT_RIGHT_SEND, 1);
+    if (kr != KERN_SUCCESS) {
+        NSDEBUG(@"Could not retain the target task port: %d", kr);
+        [self release];
+        return nil;
+    }
+
+    _task = task;
+    _applicationIdentifier = [applicationIdentifier copy];
+    _applicationVersion = [applicationVersion copy];
+    _outputDirectory = [outputDirectory copy];
+    _capturesCorpses = YES;
+
+    return self;
+}
+
+- (void) dealloc {
+    [self stop];
+
+    mach_port_deallocate(mach_task_self(), _task);
+
+    [_applicationIdentifier release];
+    [_applicationVersion release];
+    [_outputDirectory release];
+
+    [super dealloc];
+}
+
+/**
+ * Register the monitor as the target task's Mach exception server.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error in the PLCrashReporterErrorDomain indicating why the monitor
+ * could not be started. If no error occurs, this parameter will be left unmodified. You may
+ * specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO if the monitor could not be started.
+ */
+- (BOOL) startAndReturnError: (NSError **) outError {
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS && !TARGET_OS_IPHONE
+    if (_server != nil)
+        return YES;
+
+    if (![[NSFileManager defaultManager] createDirectoryAtPath: _outputDirectory withIntermediateDirectories: YES attributes: nil error: outError])
+        return NO;
+
+    NSError *osError;
+    PLCrashMachExceptionServer *server = [[[PLCrashMachExceptionServer alloc] initWithCallBack: monitor_exception_callback context: self error: &osError] autorelease];
+    if (server == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to instantiate the Mach exception server.", osError);
+        return NO;
+    }
+
+    exception_mask_t exc_mask = PLCRASH_MONITOR_EXCEPTION_MASK;
+#ifdef EXC_MASK_GUARD
+    PLCrashHostInfo *hinfo = [PLCrashHostInfo currentHostInfo];
+    if (hinfo != nil && hinfo.darwinVersion.major >= 13)
+        exc_mask |= EXC_MASK_GUARD;
+#endif
+
+    PLCrashMachExceptionPort *port = [server exceptionPortWithMask: exc_mask error: &osError];
+    if (port == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to instantiate the Mach exception port.", osError);
+        return NO;
+    }
+
+    /* The previous ports must be available to the callback as soon as the target's exceptions are redirected */
+    PLCrashMachExceptionPortSet *previousPorts = [PLCrashMachExceptionPort exceptionPortsForTask: _task mask: exc_mask error: &osError];
+    if (previousPorts == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to fetch the target task's mach exception ports.", osError);
+        return NO;
+    }
+    _previousPorts = [previousPorts retain];
+
+    /* Corpse reports are written serially, in the order the exceptions were received */
+    _reportQueue = dispatch_queue_create("com.plausiblelabs.crashreporter.monitor", DISPATCH_QUEUE_SERIAL);
+
+    if (![port registerForTask: _task previousPortSet: NULL error: &osError]) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to set the target task's mach exception ports.", osError);
+        [_previousPorts release];
+        _previousPorts = nil;
+
+        dispatch_release(_reportQueue);
+        _reportQueue = NULL;
+        return NO;
+    }
+
+    _server = [server retain];
+    return YES;
+#else
+    plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Out-of-process crash monitoring is not supported on this platform.", nil);
+    return NO;
+#endif
+}
+
+/**
+ * Restore the target task's previous Mach exception ports and shut down the monitor's exception server. Any
+ * pending corpse reports will be written prior to returning. This is a no-op if the monitor is not running.
+ */
+- (void) stop {
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS
+    if (_server == nil)
+        return;
+
+    NSError *osError;
+    for (PLCrashMachExceptionPort *port in (PLCrashMachExceptionPortSet *) _previousPorts) {
+        if (![port registerForTask: _task previousPortSet: NULL error: &osError])
+            NSDEBUG(@"Failed to restore the target task's mach exception ports: %@", osError);
+    }
+
+    [_server release];
+    _server = nil;
+
+    [_previousPorts release];
+    _previousPorts = nil;
+
+    /* Wait for any pending corpse reports */
+    dispatch_sync(_reportQueue, ^{});
+    dispatch_release(_reportQueue);
+    _reportQueue = NULL;
+#endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
+}
+
+@end
+
+@implementation PLCrashMonitor (PrivateMethods)
+
+/**
+ * Handle an exception raised by the monitored task.
+ *
+ * @param task The task in which the exception occured.
+ * @param thread The thread on which the exception occured.
+ * @param exception_type Mach exception type.
+ * @param code Mach exception codes.
+ * @param code_count The number of codes provided.
+ *
+ * @return Returns KERN_SUCCESS if a previously registered exception server handled the exception, or KERN_FAILURE
+ * to allow the kernel to continue with its default handling, terminating the task.
+ */
+- (kern_return_t) handleExceptionForTask: (task_t) task
+                                  thread: (thread_t) thread
+                           exceptionType: (exception_type_t) exception_type
+                                    code: (mach_exception_data_t) code
+                               codeCount: (mach_msg_type_number_t) code_count
+{
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS
+    /* Let any other registered server (eg, a debugger) attempt to handle the exception first */
+    if (_previousPorts != nil) {
+        plcrash_mach_exception_forward_table_t forward_table = [(PLCrashMachExceptionPortSet *) _previousPorts forwardTable];
+        if (PLCrashMachExceptionForwardWithTable(task, thread, exception_type, code, code_count, &forward_table) == KERN_SUCCESS)
+            return KERN_SUCCESS;
+    }
+#endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
+
+    /* Prefer capturing a corpse, allowing the kernel to terminate the crashed task while the report is written */
+    if (_capturesCorpses && [self captureCorpseForTask: task thread: thread exceptionType: exception_type code: code codeCount: code_count])
+        return KERN_FAILURE;
+
+    /* Otherwise, write the report while the task remains suspended */
+    plcrash_log_writer_t writer;
+    if ([self initializeWriter: &writer])
+        [self writeReportWithWriter: &writer task: _task thread: thread exceptionType: exception_type code: code codeCount: code_count];
+
+    return KERN_FAILURE;
+}
+
+/**
+ * Initialize @a writer for the monitored task. This must be called while the monitored task is alive, as the
+ * writer's process data is fetched from the task's process.
+ *
+ * @param writer The writer to initialize.
+ *
+ * @return Returns YES on success. On failure, the writer will have been freed.
+ */
+- (BOOL) initializeWriter: (plcrash_log_writer_t *) writer {
+    plcrash_error_t err;
+
+    /* A new writer is configured for each report. Unlike the in-process reporter, the monitor is free to allocate
+     * at crash time. */
+    if ((err = plcrash_log_writer_init(writer, _applicationIdentifier, _applicationVersion, PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, NO)) != PLCRASH_ESUCCESS) {
+        NSDEBUG(@"Failed to initialize the log writer: %d", err);
+        plcrash_log_writer_free(writer);
+        return NO;
+    }
+
+    if ((err = plcrash_log_writer_set_target_task(writer, _task)) != PLCRASH_ESUCCESS) {
+        NSDEBUG(@"Failed to configure the log writer for the target task: %d", err);
+        plcrash_log_writer_free(writer);
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ * Capture @a task as a corpse, and enqueue writing of its crash report on the monitor's report queue.
+ *
+ * The corpse's threads are duplicated from @a task in order; the task is suspended while the corpse is generated,
+ * allowing the crashed thread's position in the original task's thread list to identify its counterpart in
+ * the corpse.
+ *
+ * @param task The task in which the exception occured.
+ * @param thread The thread on which the exception occured.
+ * @param exception_type Mach exception type.
+ * @param code Mach exception codes.
+ * @param code_count The number of codes provided.
+ *
+ * @return Returns YES if the corpse was captured and the report enqueued, or NO if corpses are not supported or
+ * could not be generated, in which case the report should be written directly from @a task.
+ */
+- (BOOL) captureCorpseForTask: (task_t) task
+                       thread: (thread_t) thread
+                exceptionType: (exception_type_t) exception_type
+                         code: (mach_exception_data_t) code
+                    codeCount: (mach_msg_type_number_t) code_count
+{
+#if !TARGET_OS_IPHONE
+    thread_act_array_t threads = NULL;
+    mach_msg_type_number_t thread_count = 0;
+    thread_act_array_t corpse_threads = NULL;
+    mach_msg_type_number_t corpse_thread_count = 0;
+    mach_port_t corpse = MACH_PORT_NULL;
+    thread_t corpse_thread = MACH_PORT_NULL;
+    kern_return_t kr;
+
+    /* Corpses are supported as of Mac OS X 10.12 */
+    PLCrashHostInfo *hinfo = [PLCrashHostInfo currentHostInfo];
+    if (hinfo == nil || hinfo.darwinVersion.major < 16)
+        return NO;
+
+    /* The process data must be fetched before the crashed task is allowed to terminate */
+    plcrash_log_writer_t *writer = malloc(sizeof(*writer));
+    if (writer == NULL || ![self initializeWriter: writer]) {
+        free(writer);
+        return NO;
+    }
+
+    /* Stabilize the thread list while the corpse is generated */
+    if ((kr = task_suspend(task)) != KERN_SUCCESS) {
+        NSDEBUG(@"Could not suspend the target task: %d", kr);
+        goto error;
+    }
+
+    if ((kr = task_threads(task, &threads, &thread_count)) == KERN_SUCCESS) {
+        kr = task_generate_corpse(task, &corpse);
+        if (kr != KERN_SUCCESS)
+            NSDEBUG(@"Could not generate a corpse for the target task: %d", kr);
+    } else {
+        NSDEBUG(@"Could not fetch the target task's threads: %d", kr);
+    }
+
+    task_resume(task);
+    if (kr != KERN_SUCCESS)
+        goto error;
+
+    if ((kr = task_threads(corpse, &corpse_threads, &corpse_thread_count)) != KERN_SUCCESS) {
+        NSDEBUG(@"Could not fetch the corpse's threads: %d", kr);
+        goto error;
+    }
+
+    /* Locate the crashed thread's counterpart, releasing all other thread rights */
+    for (mach_msg_type_number_t i = 0; i < corpse_thread_count; i++) {
+        if (corpse_thread_count == thread_count && threads[i] == thread) {
+            corpse_thread = corpse_threads[i];
+            continue;
+        }
+
+        mach_port_deallocate(mach_task_self(), corpse_threads[i]);
+    }
+    vm_deallocate(mach_task_self(), (vm_address_t) corpse_threads, sizeof(thread_t) * corpse_thread_count);
+
+    if (!MACH_PORT_VALID(corpse_thread)) {
+        NSDEBUG(@"Could not locate the crashed thread in the corpse");
+        goto error;
+    }
+
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++)
+        mach_port_deallocate(mach_task_self(), threads[i]);
+    vm_deallocate(mach_task_self(), (vm_address_t) threads, sizeof(thread_t) * thread_count);
+
+    plcrash_log_writer_set_target_corpse(writer, corpse);
+
+    /* The exception codes reference the server's receive buffer, and must be copied */
+    struct monitor_corpse_report *report = calloc(1, sizeof(*report) + sizeof(report->code[0]) * code_count);
+    report->monitor = self;
+    report->writer = writer;
+    report->corpse = corpse;
+    report->thread = corpse_thread;
+    report->exception_type = exception_type;
+    report->code_count = code_count;
+    memcpy(report->code, code, sizeof(report->code[0]) * code_count);
+
+    dispatch_async_f(_reportQueue, report, monitor_corpse_report_write);
+    return YES;
+
+error:
+    if (threads != NULL) {
+        for (mach_msg_type_number_t i = 0; i < thread_count; i++)
+            mach_port_deallocate(mach_task_self(), threads[i]);
+        vm_deallocate(mach_task_self(), (vm_address_t) threads, sizeof(thread_t) * thread_count);
+    }
+
+    if (MACH_PORT_VALID(corpse))
+        mach_port_deallocate(mach_task_self(), corpse);
+
+    plcrash_log_writer_free(writer);
+    free(writer);
+    return NO;
+#else
+    return NO;
+#endif /* !TARGET_OS_IPHONE */
+}
+
+/**
+ * Write a crash report for the monitored task.
+ *
+ * @param writer A writer initialized via -initializeWriter:. The writer will be freed upon return.
+ * @param task The task from which the report will be written; either the monitored task, or a corpse
+ * generated from it.
+ * @param thread The crashed thread of @a task.
+ * @param exception_type Mach exception type.
+ * @param code Mach exception codes.
+ * @param code_count The number of codes provided.
+ */
+- (void) writeReportWithWriter: (plcrash_log_writer_t *) writer
+                          task: (task_t) task
+                        thread: (thread_t) thread
+                 exceptionType: (exception_type_t) exception_type
+                          code: (mach_exception_data_t) code
+                     codeCount: (mach_msg_type_number_t) code_count
+{
+    plcrash_async_image_list_t image_list;
+    plcrash_log_signal_info_t signal_info;
+    plcrash_log_bsd_signal_info_t bsd_signal_info;
+    plcrash_log_mach_signal_info_t mach_signal_info;
+    plcrash_async_file_t file;
+    plcrash_error_t err;
+    siginfo_t si;
+
+    /* Map the exception to the signal the kernel will deliver */
+    if (!plcrash_async_mach_exception_get_siginfo(exception_type, code, code_count, CPU_TYPE_ANY, &si)) {
+        NSDEBUG(@"Unexpected error mapping Mach exception to a POSIX signal");
+        plcrash_log_writer_free(writer);
+        return;
+    }
+
+    bsd_signal_info.signo = si.si_signo;
+    bsd_signal_info.code = si.si_code;
+    bsd_signal_info.address = si.si_addr;
+    signal_info.bsd_info = &bsd_signal_info;
+
+    mach_signal_info.type = exception_type;
+    mach_signal_info.code = code;
+    mach_signal_info.code_count = code_count;
+    signal_info.mach_info = &mach_signal_info;
+
+    /* Index the target's images; symbol indexes are built up-front, as there is no crash-time cost to avoid */
+    plcrash_nasync_image_list_init(&image_list, task);
+    plcrash_nasync_image_list_enable_shared_cache(&image_list);
+    if (!monitor_image_list_populate(&image_list, task))
+        NSDEBUG(@"Could not read the target task's image list");
+    plcrash_nasync_image_list_enable_symbol_index(&image_list);
+
+    /* Name the report by its UUID */
+    CFUUIDRef uuid = CFUUIDCreateFromUUIDBytes(NULL, *(CFUUIDBytes *) writer->report_info.uuid_bytes);
+    NSString *uuidString = [(NSString *) CFUUIDCreateString(NULL, uuid) autorelease];
+    CFRelease(uuid);
+
+    NSString *path = [_outputDirectory stringByAppendingPathComponent: [uuidString stringByAppendingPathExtension: @"plcrash"]];
+
+    int fd = open([path fileSystemRepresentation], O_RDWR|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0) {
+        NSDEBUG(@"Could not open the crash report output file: %s", strerror(errno));
+        goto cleanup;
+    }
+
+    plcrash_async_file_init(&file, fd, 0);
+    err = plcrash_log_writer_write(writer, thread, &image_list, &file, &signal_info, NULL);
+    plcrash_log_writer_close(writer);
+
+    if (!plcrash_async_file_flush(&file) || !plcrash_async_file_close(&file)) {
+        NSDEBUG(@"Failed to write the crash report to %@", path);
+        goto cleanup;
+    }
+
+    if (err != PLCRASH_ESUCCESS) {
+        NSDEBUG(@"Failed to write the crash report: %d", err);
+        goto cleanup;
+    }
+
+    [_delegate crashMonitor: self didWriteReportAtPath: path];
+
+cleanup:
+    plcrash_nasync_image_list_free(&image_list);
+    plcrash_log_writer_free(writer);
+}
+
+@end
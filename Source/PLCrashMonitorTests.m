@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashMonitor.h"
+#import "PLCrashFeatureConfig.h"
+#import "PLCrashMachExceptionPort.h"
+#import "PLCrashMachExceptionPortSet.h"
+
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS && !TARGET_OS_IPHONE
+
+@interface PLCrashMonitorTests : SenTestCase {
+@private
+    /** Report output directory. */
+    NSString *_outputPath;
+}
+@end
+
+/* Return YES if the two port sets contain the same exception port registrations. */
+static BOOL port_sets_equal (PLCrashMachExceptionPortSet *lhs, PLCrashMachExceptionPortSet *rhs) {
+    plcrash_mach_exception_port_set_t l = [lhs asyncSafeRepresentation];
+    plcrash_mach_exception_port_set_t r = [rhs asyncSafeRepresentation];
+
+    if (l.count != r.count)
+        return NO;
+
+    for (mach_msg_type_number_t i = 0; i < l.count; i++) {
+        if (l.masks[i] != r.masks[i] || l.ports[i] != r.ports[i] || l.behaviors[i] != r.behaviors[i] || l.flavors[i] != r.flavors[i])
+            return NO;
+    }
+
+    return YES;
+}
+
+@implementation PLCrashMonitorTests
+
+- (void) setUp {
+    _outputPath = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _outputPath error: NULL];
+    [_outputPath release];
+}
+
+/**
+ * Verify that starting the monitor registers its exception server for the target task, and that stopping
+ * the monitor restores the task's previous exception ports.
+ */
+- (void) testStartStop {
+    NSError *error;
+    exception_mask_t mask = EXC_MASK_BAD_ACCESS;
+
+    PLCrashMachExceptionPortSet *initial = [PLCrashMachExceptionPort exceptionPortsForTask: mach_task_self() mask: mask error: &error];
+    STAssertNotNil(initial, @"Failed to fetch exception ports: %@", error);
+
+    PLCrashMonitor *monitor = [[[PLCrashMonitor alloc] initWithTask: mach_task_self()
+                                               applicationIdentifier: @"test.id"
+                                                          appVersion: @"1.0"
+                                                     outputDirectory: _outputPath] autorelease];
+    STAssertNotNil(monitor, @"Failed to create monitor");
+    STAssertTrue([monitor startAndReturnError: &error], @"Failed to start monitor: %@", error);
+
+    BOOL isDirectory = NO;
+    STAssertTrue([[NSFileManager defaultManager] fileExistsAtPath: _outputPath isDirectory: &isDirectory], @"Output directory was not created");
+    STAssertTrue(isDirectory, @"Output path is not a directory");
+
+    /* The monitor's server must now be registered */
+    PLCrashMachExceptionPortSet *registered = [PLCrashMachExceptionPort exceptionPortsForTask: mach_task_self() mask: mask error: &error];
+    STAssertNotNil(registered, @"Failed to fetch exception ports: %@", error);
+    STAssertFalse(port_sets_equal(registered, initial), @"Monitor exception port was not registered");
+
+    /* Stopping the monitor must restore the original ports */
+    [monitor stop];
+    PLCrashMachExceptionPortSet *restored = [PLCrashMachExceptionPort exceptionPortsForTask: mach_task_self() mask: mask error: &error];
+    STAssertNotNil(restored, @"Failed to fetch exception ports: %@", error);
+    STAssertTrue(port_sets_equal(restored, initial), @"Exception ports were not restored");
+}
+
+@end
+
+#endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS && !TARGET_OS_IPHONE */
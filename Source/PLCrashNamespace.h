@@ -51,14 +51,34 @@
 #define PLCrashReportBinaryImageInfo        PLNS(PLCrashReportBinaryImageInfo)
 #define PLCrashReportExceptionInfo          PLNS(PLCrashReportExceptionInfo)
 #define PLCrashReportMachineInfo            PLNS(PLCrashReportMachineInfo)
+#define PLCrashReportInstrumentationInfo    PLNS(PLCrashReportInstrumentationInfo)
+#define PLCrashReportTraceEvent             PLNS(PLCrashReportTraceEvent)
+#define PLCrashReportBreadcrumb             PLNS(PLCrashReportBreadcrumb)
+#define PLCrashReportCustomData             PLNS(PLCrashReportCustomData)
+#define PLCrashReportStackMemoryInfo        PLNS(PLCrashReportStackMemoryInfo)
+#define PLCrashReportMemoryRegionInfo       PLNS(PLCrashReportMemoryRegionInfo)
+#define PLCrashReportVMRegionInfo           PLNS(PLCrashReportVMRegionInfo)
 #define PLCrashReportProcessInfo            PLNS(PLCrashReportProcessInfo)
 #define PLCrashReportProcessorInfo          PLNS(PLCrashReportProcessorInfo)
 #define PLCrashReportRegisterInfo           PLNS(PLCrashReportRegisterInfo)
 #define PLCrashReportSignalInfo             PLNS(PLCrashReportSignalInfo)
 #define PLCrashReportStackFrameInfo         PLNS(PLCrashReportStackFrameInfo)
 #define PLCrashReportSymbolInfo             PLNS(PLCrashReportSymbolInfo)
+#define PLCrashReportInlinedFrameInfo       PLNS(PLCrashReportInlinedFrameInfo)
 #define PLCrashReportSystemInfo             PLNS(PLCrashReportSystemInfo)
 #define PLCrashReportTextFormatter          PLNS(PLCrashReportTextFormatter)
+#define PLCrashReportJSONFormatter          PLNS(PLCrashReportJSONFormatter)
+#define PLCrashReportHeader                 PLNS(PLCrashReportHeader)
+#define PLCrashReportSymbolicator           PLNS(PLCrashReportSymbolicator)
+#define PLCrashReportBundle                 PLNS(PLCrashReportBundle)
+#define PLCrashReportStatistics             PLNS(PLCrashReportStatistics)
+#define PLCrashReportQueueIndex             PLNS(PLCrashReportQueueIndex)
+#define PLCrashReportStore                  PLNS(PLCrashReportStore)
+#define PLCrashPendingReportInfo            PLNS(PLCrashPendingReportInfo)
+#define PLCrashMonitor                      PLNS(PLCrashMonitor)
+#define PLCrashResourceEvent                PLNS(PLCrashResourceEvent)
+#define PLCrashLiveReportSession            PLNS(PLCrashLiveReportSession)
+#define PLCrashSymbolicationServer          PLNS(PLCrashSymbolicationServer)
 #define PLCrashReportThreadInfo             PLNS(PLCrashReportThreadInfo)
 #define PLCrashReporter                     PLNS(PLCrashReporter)
 #define PLCrashSignalHandler                PLNS(PLCrashSignalHandler)
@@ -71,8 +91,10 @@
 #define PLCrashMachExceptionPortSet         PLNS(PLCrashMachExceptionPortSet)
 #define PLCrashProcessInfo                  PLNS(PLCrashProcessInfo)
 #define PLCrashReporterConfig               PLNS(PLCrashReporterConfig)
+#define PLMutableCrashReporterConfig        PLNS(PLMutableCrashReporterConfig)
 #define PLCrashUncaughtExceptionHandler     PLNS(PLCrashUncaughtExceptionHandler)
 #define PLCrashMachExceptionForward         PLNS(PLCrashMachExceptionForward)
+#define PLCrashMachExceptionForwardWithTable PLNS(PLCrashMachExceptionForwardWithTable)
 #define PLCrashSignalHandlerForward         PLNS(PLCrashSignalHandlerForward)
 #define plcrash_signal_handler              PLNS(plcrash_signal_handler)
 
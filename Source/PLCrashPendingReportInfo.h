@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PLCrashPendingReportInfo : NSObject {
+@private
+    /** The report identifier. */
+    NSString *_identifier;
+
+    /** The report file size, in bytes. */
+    uint64_t _size;
+
+    /** The time at which the report was written. */
+    NSDate *_date;
+
+    /** YES if a signature was computed for the report. */
+    BOOL _hasSignature;
+
+    /** The report signature. */
+    uint64_t _signature;
+}
+
+- (id) initWithIdentifier: (NSString *) identifier
+                     size: (uint64_t) size
+                     date: (NSDate *) date
+             hasSignature: (BOOL) hasSignature
+                signature: (uint64_t) signature;
+
+/**
+ * The identifier of the pending report, which may be passed to PLCrashReporter::loadPendingCrashReportWithIdentifier:error:
+ * and PLCrashReporter::purgePendingCrashReportWithIdentifier:error:.
+ */
+@property(nonatomic, readonly) NSString *identifier;
+
+/**
+ * The size of the report file, in bytes.
+ */
+@property(nonatomic, readonly) uint64_t size;
+
+/**
+ * The time at which the report file was written.
+ */
+@property(nonatomic, readonly) NSDate *date;
+
+/**
+ * YES if a signature could be computed for the report. A signature is not available for reports that can not be
+ * decoded.
+ */
+@property(nonatomic, readonly) BOOL hasSignature;
+
+/**
+ * The report's deduplication signature, as returned by PLCrashReport::signatureForCrashData:frameCount:signature:error:
+ * using the default frame count. Only valid if PLCrashPendingReportInfo::hasSignature is YES.
+ */
+@property(nonatomic, readonly) uint64_t signature;
+
+@end
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashPendingReportInfo.h"
+
+/**
+ * Summary information for a pending crash report, as returned by PLCrashReporter::pendingCrashReportInfo.
+ *
+ * The summary is read from the pending report index, allowing pending reports to be filtered or prioritized
+ * without loading each report.
+ */
+@implementation PLCrashPendingReportInfo
+
+@synthesize identifier = _identifier;
+@synthesize size = _size;
+@synthesize date = _date;
+@synthesize hasSignature = _hasSignature;
+@synthesize signature = _signature;
+
+/**
+ * Initialize a new instance.
+ *
+ * @param identifier The report identifier.
+ * @param size The report file size, in bytes.
+ * @param date The time at which the report file was written.
+ * @param hasSignature YES if @a signature is valid.
+ * @param signature The report's deduplication signature.
+ */
+- (id) initWithIdentifier: (NSString *) identifier
+                     size: (uint64_t) size
+                     date: (NSDate *) date
+             hasSignature: (BOOL) hasSignature
+                signature: (uint64_t) signature
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _identifier = [identifier copy];
+    _size = size;
+    _date = [date retain];
+    _hasSignature = hasSignature;
+    _signature = signature;
+
+    return self;
+}
+
+- (void) dealloc {
+    [_identifier release];
+    [_date release];
+
+    [super dealloc];
+}
+
+@end
@@ -32,6 +32,13 @@
 #import "PLCrashReportBinaryImageInfo.h"
 #import "PLCrashReportExceptionInfo.h"
 #import "PLCrashReportMachineInfo.h"
+#import "PLCrashReportInstrumentationInfo.h"
+#import "PLCrashReportTraceEvent.h"
+#import "PLCrashReportBreadcrumb.h"
+#import "PLCrashReportCustomData.h"
+#import "PLCrashReportStackMemoryInfo.h"
+#import "PLCrashReportMemoryRegionInfo.h"
+#import "PLCrashReportVMRegionInfo.h"
 #import "PLCrashReportMachExceptionInfo.h"
 #import "PLCrashReportProcessInfo.h"
 #import "PLCrashReportProcessorInfo.h"
@@ -39,6 +46,7 @@
 #import "PLCrashReportSignalInfo.h"
 #import "PLCrashReportStackFrameInfo.h"
 #import "PLCrashReportSymbolInfo.h"
+#import "PLCrashReportInlinedFrameInfo.h"
 #import "PLCrashReportSystemInfo.h"
 #import "PLCrashReportThreadInfo.h"
 
@@ -53,6 +61,45 @@
  * an entirely new crash log format. */
 #define PLCRASH_REPORT_FILE_VERSION 1
 
+/**
+ * @ingroup constants
+ * Crash format version byte identifier for reports that reference symbol names via a per-report string table,
+ * rather than including the name in each symbol record. Reports of this version are only written if the symbol
+ * table has been enabled, and can not be decoded by readers that only support #PLCRASH_REPORT_FILE_VERSION. */
+#define PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE 2
+
+/**
+ * @ingroup constants
+ * Crash format version byte identifier for reports that encode each thread's registers as a packed array of values,
+ * naming the registers via a single per-report register set identifier. Reports of this version are only written if
+ * packed registers have been enabled, may also make use of the symbol table introduced by
+ * #PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE, and can not be decoded by readers that predate this version. */
+#define PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS 3
+
+/**
+ * @ingroup constants
+ * Crash format version byte identifier for reports that may encode a thread's unsymbolicated stack frames as a packed,
+ * delta-encoded array of PC values. Reports of this version are only written if packed frames have been enabled,
+ * may also make use of the encodings introduced by #PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS, and can not be
+ * decoded by readers that predate this version. */
+#define PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES 4
+
+/**
+ * @ingroup constants
+ * Crash format version byte identifier for reports in which a thread whose stack frames are identical to those of
+ * a previously written thread references that thread, rather than including its own frames. Reports of this version
+ * are only written if thread deduplication has been enabled, may also make use of the encodings introduced by
+ * #PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES, and can not be decoded by readers that predate this version. */
+#define PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS 5
+
+/**
+ * @ingroup constants
+ * The default number of crashed thread frames included in a crash log signature.
+ *
+ * @sa PLCrashReport::signatureForCrashData:frameCount:signature:error:
+ */
+#define PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES 5
+
 /**
  * @ingroup types
  * Crash log file header format.
@@ -85,6 +132,9 @@ typedef struct _PLCrashReportDecoder _PLCrashReportDecoder;
     /** Private implementation variables (used to hide the underlying protobuf parser) */
     _PLCrashReportDecoder *_decoder;
 
+    /** Owner of @a _decoder, retained by any lazily materialized values that reference the decoded message. */
+    id _decoderOwner;
+
     /** System info */
     PLCrashReportSystemInfo *_systemInfo;
     
@@ -109,14 +159,79 @@ typedef struct _PLCrashReportDecoder _PLCrashReportDecoder;
     /** Binary images (PLCrashReportBinaryImageInfo instances */
     NSArray *_images;
 
+    /** Binary images sorted by base address, built on first use. */
+    NSArray *_sortedImages;
+
+    /** Base addresses of @a _sortedImages, in the same order. */
+    uint64_t *_sortedImageBases;
+
+    /** The main executable's image, or nil. Only valid if @a _executableImageResolved is YES. */
+    PLCrashReportBinaryImageInfo *_executableImage;
+
+    /** YES if @a _executableImage has been resolved. */
+    BOOL _executableImageResolved;
+
     /** Exception information (may be nil) */
     PLCrashReportExceptionInfo *_exceptionInfo;
 
     /** Report UUID */
     CFUUIDRef _uuid;
+
+    /** If true, @a _threadSuspendDuration is available. */
+    BOOL _hasThreadSuspendDuration;
+
+    /** Thread suspension time, in nanoseconds */
+    uint64_t _threadSuspendDuration;
+
+    /** Report generation instrumentation (may be nil) */
+    PLCrashReportInstrumentationInfo *_instrumentationInfo;
+
+    /** Diagnostic trace events */
+    NSArray *_traceEvents;
+
+    /** Captured thread stack memory */
+    NSArray *_stackMemory;
+
+    /** Captured register memory */
+    NSArray *_registerMemory;
+
+    /** The number of threads omitted to fit the output limit or the thread limit */
+    NSUInteger _elidedThreadCount;
+
+    /** The number of binary images omitted to fit the output limit */
+    NSUInteger _elidedImageCount;
+
+    /** If true, the report's time budget expired and its later sections were written with reduced detail */
+    BOOL _deadlineExpired;
+
+    /** Application breadcrumbs */
+    NSArray *_breadcrumbs;
+
+    /** Application custom data regions */
+    NSArray *_customData;
+
+    /** The referenced image manifest identifier, or nil */
+    NSString *_imageManifestIdentifier;
+
+    /** The images supplied by the referenced image manifest (PLCrashReportBinaryImageInfo instances), or nil */
+    NSArray *_manifestImages;
+
+    /** The summarized VM regions (PLCrashReportVMRegionInfo instances) */
+    NSArray *_vmRegions;
+
+    /** If true, the VM region summary was truncated */
+    BOOL _vmRegionSummaryTruncated;
 }
 
 - (id) initWithData: (NSData *) encodedData error: (NSError **) outError;
+- (id) initWithData: (NSData *) encodedData imageManifest: (NSData *) manifestData error: (NSError **) outError;
+- (id) initWithContentsOfFile: (NSString *) path error: (NSError **) outError;
+
++ (BOOL) signatureForCrashData: (NSData *) encodedData frameCount: (NSUInteger) frameCount signature: (uint64_t *) signature error: (NSError **) outError;
+
++ (BOOL) verifyIntegrityOfCrashData: (NSData *) encodedData verifyChecksum: (BOOL) verifyChecksum error: (NSError **) outError;
+
++ (NSArray *) decodeReportsWithDataArray: (NSArray *) dataArray maxConcurrency: (NSUInteger) maxConcurrency;
 
 - (PLCrashReportBinaryImageInfo *) imageForAddress: (uint64_t) address;
 
@@ -170,7 +285,8 @@ typedef struct _PLCrashReportDecoder _PLCrashReportDecoder;
 @property(nonatomic, readonly) PLCrashReportMachExceptionInfo *machExceptionInfo;
 
 /**
- * Thread information. Returns a list of PLCrashReportThreadInfo instances.
+ * Thread information. Returns a list of PLCrashReportThreadInfo instances. The thread values (and each thread's
+ * stack frames) are materialized on first access.
  */
 @property(nonatomic, readonly) NSArray *threads;
 
@@ -179,6 +295,18 @@ typedef struct _PLCrashReportDecoder _PLCrashReportDecoder;
  */
 @property(nonatomic, readonly) NSArray *images;
 
+/**
+ * Binary image information, sorted in ascending order by base address. Returns a list of
+ * PLCrashReportBinaryImageInfo instances. The sorted list is computed once, on first access.
+ */
+@property(nonatomic, readonly) NSArray *sortedImages;
+
+/**
+ * The binary image of the process' main executable, as identified by the process path, or nil if
+ * process information is unavailable or no matching image was found.
+ */
+@property(nonatomic, readonly) PLCrashReportBinaryImageInfo *executableImage;
+
 /**
  * YES if exception information is available.
  */
@@ -197,4 +325,97 @@ typedef struct _PLCrashReportDecoder _PLCrashReportDecoder;
  */
 @property(nonatomic, readonly) CFUUIDRef uuidRef;
 
+/**
+ * YES if the report records the time for which the process' threads were suspended while it was generated.
+ * Only available in live (user requested) reports.
+ */
+@property(nonatomic, readonly) BOOL hasThreadSuspendDuration;
+
+/**
+ * The time, in nanoseconds, for which the process' threads were suspended while the report was generated. Only
+ * valid if PLCrashReport::hasThreadSuspendDuration is YES.
+ */
+@property(nonatomic, readonly) uint64_t threadSuspendDuration;
+
+/**
+ * YES if report generation instrumentation is available.
+ */
+@property(nonatomic, readonly) BOOL hasInstrumentationInfo;
+
+/**
+ * Report generation instrumentation, recording the time spent in each phase of the report's generation. Only
+ * available if instrumentation was enabled when the report was written; if not available, this will be nil.
+ */
+@property(nonatomic, readonly) PLCrashReportInstrumentationInfo *instrumentationInfo;
+
+/**
+ * The crash reporter's most recently recorded diagnostic trace events, as PLCrashReportTraceEvent instances, oldest
+ * first. If no events were recorded, the array will be empty.
+ */
+@property(nonatomic, readonly) NSArray *traceEvents;
+
+/**
+ * Thread stack memory captured by the crash reporter, as PLCrashReportStackMemoryInfo instances. If stack memory
+ * capture was not enabled, the array will be empty.
+ */
+@property(nonatomic, readonly) NSArray *stackMemory;
+
+/**
+ * Memory surrounding the crashed thread's register values, as PLCrashReportMemoryRegionInfo instances ordered by
+ * address. If register memory capture was not enabled, the array will be empty.
+ */
+@property(nonatomic, readonly) NSArray *registerMemory;
+
+/**
+ * The number of non-crashed threads omitted from the report, either to fit its output limit or to honor the configured
+ * thread limit. Threads are only omitted from reports written with prioritized output or with a thread limit; see
+ * PLCrashReporterConfig::prioritizedOutputEnabled and PLCrashReporterConfig::maxThreadCount.
+ */
+@property(nonatomic, readonly) NSUInteger elidedThreadCount;
+
+/**
+ * The number of binary images omitted from the report to fit its output limit. Images are only omitted from reports
+ * written with prioritized output, after all non-crashed threads have been omitted.
+ */
+@property(nonatomic, readonly) NSUInteger elidedImageCount;
+
+/**
+ * YES if the report's time budget expired while it was being written. Once expired, the remaining non-crashed threads
+ * were written without symbols, unreferenced binary images were omitted, and captured memory was omitted; see
+ * PLCrashReporterConfig::reportTimeBudget.
+ */
+@property(nonatomic, readonly) BOOL deadlineExpired;
+
+/**
+ * The application's most recently recorded breadcrumbs, as PLCrashReportBreadcrumb instances, oldest first. If
+ * breadcrumbs were not enabled, or none were recorded, the array will be empty.
+ */
+@property(nonatomic, readonly) NSArray *breadcrumbs;
+
+/**
+ * The application's registered custom data regions, as PLCrashReportCustomData instances. If no regions were
+ * registered, the array will be empty.
+ */
+@property(nonatomic, readonly) NSArray *customData;
+
+/**
+ * The identifier of the image manifest referenced by the report, or nil if the report includes all of its binary
+ * images. If non-nil, the report's images property only includes the images loaded since the manifest was generated,
+ * unless the manifest was supplied via PLCrashReport::initWithData:imageManifest:error:.
+ */
+@property(nonatomic, readonly) NSString *imageManifestIdentifier;
+
+/**
+ * The crashed process' virtual memory layout, as PLCrashReportVMRegionInfo instances ordered by address. Adjacent
+ * regions with identical attributes are coalesced. If the VM region summary was not enabled, the array will be empty;
+ * see PLCrashReporterConfig::vmRegionSummaryLimit.
+ */
+@property(nonatomic, readonly) NSArray *vmRegions;
+
+/**
+ * YES if region enumeration stopped at the configured region limit or time budget, or if the summary was trimmed to
+ * fit the report's output limit. If so, regions above the last entry of PLCrashReport::vmRegions were omitted.
+ */
+@property(nonatomic, readonly) BOOL vmRegionSummaryTruncated;
+
 @end
@@ -26,20 +26,137 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#import <libkern/OSByteOrder.h>
+#import <libkern/OSAtomic.h>
+#import <dispatch/dispatch.h>
+#import <unistd.h>
+#import <pthread.h>
+
 #import "PLCrashReport.h"
+#import "PLCrashReportMessage.h"
 #import "CrashReporter.h"
 
 #import "crash_report.pb-c.h"
+#import "PLCrashAsyncCompressor.h"
+#import "PLCrashReportSignature.h"
+#import "PLCrashReportIntegrity.h"
+#import "PLCrashAsyncTrace.h"
+#import "PLCrashAsyncProtobufReader.h"
+#import "PLCrashReportUnpacker.h"
+#import "PLCrashLogWriter.h"
+
+/**
+ * @internal
+ *
+ * A single chunk of decoder arena storage. Allocations are carved from the space following the chunk header.
+ */
+struct pl_decoder_arena_chunk {
+    /** The next (previously allocated) chunk, or NULL. */
+    struct pl_decoder_arena_chunk *next;
+
+    /** The total size of this chunk, including the header. */
+    size_t size;
+
+    /** The number of bytes of the chunk in use, including the header. */
+    size_t used;
+};
+
+/**
+ * @internal
+ *
+ * Bump allocator used to decode the report's protobuf-c structures. Individual frees are ignored; all storage is
+ * released at once when the report is deallocated. This avoids allocating (and later freeing) each decoded string
+ * and message individually, along with the associated per-allocation overhead.
+ */
+typedef struct pl_decoder_arena {
+    /** The most recently allocated chunk, or NULL. */
+    struct pl_decoder_arena_chunk *chunks;
+
+    /** Chunks backing protobuf-c's temporary allocations, which are only required while unpacking, or NULL. */
+    struct pl_decoder_arena_chunk *scratch;
+
+    /** The preferred size of newly allocated chunks. */
+    size_t chunk_size;
+} pl_decoder_arena_t;
+
+/** The minimum decoder arena chunk size. */
+#define DECODER_ARENA_MIN_CHUNK_SIZE (16 * 1024)
+
+/** Alignment of decoder arena allocations. */
+#define DECODER_ARENA_ALIGN 16
+
+/** The size of a decoder arena chunk header, rounded up to DECODER_ARENA_ALIGN. */
+#define DECODER_ARENA_HEADER_SIZE ((sizeof(struct pl_decoder_arena_chunk) + DECODER_ARENA_ALIGN - 1) & ~(DECODER_ARENA_ALIGN - 1))
+
+/**
+ * @internal
+ *
+ * Result of decoding an encoded report via pl_decoder_decode().
+ */
+typedef enum {
+    /** The report was decoded successfully. */
+    PL_DECODER_OK = 0,
+
+    /** The compressed report could not be decompressed. */
+    PL_DECODER_ERROR_COMPRESSION,
+
+    /** The report is too short to contain a file header. */
+    PL_DECODER_ERROR_TRUNCATED,
+
+    /** The report's file magic is invalid. */
+    PL_DECODER_ERROR_MAGIC,
+
+    /** The report's file format version is not supported. */
+    PL_DECODER_ERROR_VERSION,
+
+    /** The report's protobuf message could not be unpacked. */
+    PL_DECODER_ERROR_UNPACK
+} pl_decoder_status_t;
 
 struct _PLCrashReportDecoder {
     Plcrash__CrashReport *crashReport;
+
+    /** The report's file format version, as read from its file header. */
+    uint8_t version;
+
+    /** Storage for @a crashReport. */
+    pl_decoder_arena_t arena;
+
+    /** Lock guarding @a stringDeallocator and @a internedStrings. */
+    pthread_mutex_t stringLock;
+
+    /** The contents deallocator of strings created directly over the arena's storage, or NULL. The deallocator
+     * retains the decoder's owner, keeping the arena alive for as long as any such string. */
+    CFAllocatorRef stringDeallocator;
+
+    /** Strings created over the arena, keyed by their NUL-terminated UTF-8 arena bytes, or NULL. Identical strings
+     * within a report share a single instance. */
+    CFMutableDictionaryRef internedStrings;
 };
 
 #define IMAGE_UUID_DIGEST_LEN 16
 
+/**
+ * @internal
+ *
+ * Owns a _PLCrashReportDecoder instance. Lazily materialized values retain the owner, allowing the decoded
+ * message to outlive the PLCrashReport instance from which they were vended.
+ */
+@interface PLCrashReportDecoderOwner : NSObject {
+@private
+    /** The owned decoder state. */
+    _PLCrashReportDecoder *_decoder;
+}
+
+- (id) initWithDecoder: (_PLCrashReportDecoder *) decoder;
+
+/** The owned decoder state. */
+@property(nonatomic, readonly) _PLCrashReportDecoder *decoder;
+
+@end
+
 @interface PLCrashReport (PrivateMethods)
 
-- (Plcrash__CrashReport *) decodeCrashData: (NSData *) data error: (NSError **) outError;
 - (PLCrashReportSystemInfo *) extractSystemInfo: (Plcrash__CrashReport__SystemInfo *) systemInfo error: (NSError **) outError;
 - (PLCrashReportProcessorInfo *) extractProcessorInfo: (Plcrash__CrashReport__Processor *) processorInfo error: (NSError **) outError;
 - (PLCrashReportMachineInfo *) extractMachineInfo: (Plcrash__CrashReport__MachineInfo *) machineInfo error: (NSError **) outError;
@@ -47,14 +164,41 @@ struct _PLCrashReportDecoder {
 - (PLCrashReportProcessInfo *) extractProcessInfo: (Plcrash__CrashReport__ProcessInfo *) processInfo error: (NSError **) outError;
 - (NSArray *) extractThreadInfo: (Plcrash__CrashReport *) crashReport error: (NSError **) outError;
 - (NSArray *) extractImageInfo: (Plcrash__CrashReport *) crashReport error: (NSError **) outError;
+- (NSArray *) extractBinaryImages: (Plcrash__CrashReport__BinaryImage **) binaryImages count: (size_t) count decoder: (_PLCrashReportDecoder *) decoder error: (NSError **) outError;
+- (NSArray *) extractManifestImages: (NSData *) manifestData error: (NSError **) outError;
 - (PLCrashReportExceptionInfo *) extractExceptionInfo: (Plcrash__CrashReport__Exception *) exceptionInfo error: (NSError **) outError;
 - (PLCrashReportSignalInfo *) extractSignalInfo: (Plcrash__CrashReport__Signal *) signalInfo error: (NSError **) outError;
 - (PLCrashReportMachExceptionInfo *) extractMachExceptionInfo: (Plcrash__CrashReport__Signal__MachException *) machExceptionInfo error: (NSError **) outError;
+- (NSArray *) extractTraceEvents: (Plcrash__CrashReport *) crashReport;
+- (NSArray *) extractStackMemory: (Plcrash__CrashReport *) crashReport error: (NSError **) outError;
+- (NSArray *) extractRegisterMemory: (Plcrash__CrashReport *) crashReport;
+- (NSArray *) extractVMRegions: (Plcrash__CrashReport__VMRegionSummary *) summary error: (NSError **) outError;
+- (NSArray *) extractBreadcrumbs: (Plcrash__CrashReport *) crashReport;
+- (NSArray *) extractCustomData: (Plcrash__CrashReport *) crashReport;
 
 @end
 
 
 static void populate_nserror (NSError **error, PLCrashReporterError code, NSString *description);
+static PLCrashReportStackFrameInfo *extract_stack_frame_info (_PLCrashReportDecoder *decoder, Plcrash__CrashReport__Thread__StackFrame *stackFrame, NSError **outError);
+static NSArray *extract_stack_frames (_PLCrashReportDecoder *decoder, Plcrash__CrashReport__Thread__StackFrame **stackFrames, size_t count, NSError **outError);
+static size_t complete_message_length (const uint8_t *data, size_t length);
+static NSArray *extract_packed_registers (Plcrash__CrashReport__RegisterSet registerSet, ProtobufCBinaryData *values, NSError **outError);
+static NSArray *extract_packed_stack_frames (ProtobufCBinaryData *pcs, NSError **outError);
+static void pl_decoder_arena_init (pl_decoder_arena_t *arena, size_t encoded_length);
+static ProtobufCAllocator pl_decoder_arena_allocator (pl_decoder_arena_t *arena);
+static void pl_decoder_arena_free_scratch (pl_decoder_arena_t *arena);
+static void pl_decoder_arena_free (pl_decoder_arena_t *arena);
+static void pl_decoder_chunks_reset (struct pl_decoder_arena_chunk **chunks);
+static void pl_decoder_chunks_free (struct pl_decoder_arena_chunk **chunks);
+static _PLCrashReportDecoder *pl_decoder_alloc (size_t encoded_length);
+static pl_decoder_status_t pl_decoder_decode (_PLCrashReportDecoder *decoder, const void *bytes, size_t length, struct pl_decoder_arena_chunk **scratch_cache);
+static void pl_decoder_free (_PLCrashReportDecoder *decoder);
+static void pl_decoder_strings_init (_PLCrashReportDecoder *decoder, PLCrashReportDecoderOwner *owner);
+static void pl_decoder_strings_free (_PLCrashReportDecoder *decoder);
+static NSString *pl_decoder_copy_string (_PLCrashReportDecoder *decoder, const char *cstring);
+static void populate_decoder_nserror (NSError **error, _PLCrashReportDecoder *decoder, pl_decoder_status_t status);
+static void pl_decoder_batch_apply (size_t count, size_t worker_count, void (^decode)(size_t idx, struct pl_decoder_arena_chunk **scratch_cache));
 
 /**
  * Provides decoding of crash logs generated by the PLCrashReporter framework.
@@ -63,6 +207,34 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
  */
 @implementation PLCrashReport
 
+/**
+ * Initialize with the provided crash log data and the image manifest referenced by the report. The manifest's images
+ * are included in the report's images property. On error, nil will be returned, and an NSError instance will be
+ * provided via @a error, if non-NULL.
+ *
+ * @param encodedData Encoded plcrash crash log.
+ * @param manifestData The encoded image manifest identified by the report's imageManifestIdentifier, as returned by
+ * PLCrashReporter::loadImageManifestWithIdentifier:error:. If the report does not reference a manifest, this value
+ * is ignored.
+ * @param outError If an error occurs, this pointer will contain an NSError object indicating why the crash log could
+ * not be parsed, or why the manifest does not match the report. If no error occurs, this parameter will be left
+ * unmodified. You may specify NULL for this parameter, and no error information will be provided.
+ */
+- (id) initWithData: (NSData *) encodedData imageManifest: (NSData *) manifestData error: (NSError **) outError {
+    if ((self = [self initWithData: encodedData error: outError]) == nil)
+        return nil;
+
+    if (manifestData != nil && _decoder->crashReport->image_manifest != NULL) {
+        _manifestImages = [[self extractManifestImages: manifestData error: outError] retain];
+        if (_manifestImages == nil) {
+            [self release];
+            return nil;
+        }
+    }
+
+    return self;
+}
+
 /**
  * Initialize with the provided crash log data. On error, nil will be returned, and
  * an NSError instance will be provided via @a error, if non-NULL.
@@ -77,21 +249,106 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
  * This method is the designated initializer for the PLCrashReport class.
  */
 - (id) initWithData: (NSData *) encodedData error: (NSError **) outError {
+    /* Allocate the struct and attempt to parse */
+    _PLCrashReportDecoder *decoder = pl_decoder_alloc([encodedData length]);
+    if (decoder == NULL) {
+        populate_nserror(outError, PLCrashReporterErrorUnknown, @"Could not allocate the crash log decoder");
+        [self release];
+        return nil;
+    }
+
+    pl_decoder_status_t status = pl_decoder_decode(decoder, [encodedData bytes], [encodedData length], NULL);
+    if (status != PL_DECODER_OK) {
+        populate_decoder_nserror(outError, decoder, status);
+        pl_decoder_free(decoder);
+        [self release];
+        return nil;
+    }
+
+    return [self initWithDecoder: decoder error: outError];
+}
+
+/**
+ * Decode the provided crash logs concurrently, returning the results in input order. Each result is either the
+ * decoded PLCrashReport instance, or an NSError instance describing why the corresponding crash log could not be
+ * decoded.
+ *
+ * The crash logs are distributed across a pool of at most @a maxConcurrency workers, each of which reuses its own
+ * decoder scratch storage across the crash logs it decodes. This is intended for decoding large numbers of reports,
+ * such as on a symbolication server.
+ *
+ * @param dataArray An array of NSData instances, each containing an encoded plcrash crash log.
+ * @param maxConcurrency The maximum number of crash logs to decode concurrently, or 0 to use the number of active
+ * processors.
+ */
++ (NSArray *) decodeReportsWithDataArray: (NSArray *) dataArray maxConcurrency: (NSUInteger) maxConcurrency {
+    NSUInteger count = [dataArray count];
+    id *results = calloc(MAX(count, (NSUInteger) 1), sizeof(id));
+    if (results == NULL)
+        return nil;
+
+    pl_decoder_batch_apply(count, maxConcurrency, ^(size_t idx, struct pl_decoder_arena_chunk **scratch_cache) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSData *data = [dataArray objectAtIndex: idx];
+        NSError *error = nil;
+
+        _PLCrashReportDecoder *decoder = pl_decoder_alloc([data length]);
+        if (decoder == NULL) {
+            populate_nserror(&error, PLCrashReporterErrorUnknown, @"Could not allocate the crash log decoder");
+            results[idx] = [error retain];
+            [pool drain];
+            return;
+        }
+
+        pl_decoder_status_t status = pl_decoder_decode(decoder, [data bytes], [data length], scratch_cache);
+        if (status != PL_DECODER_OK) {
+            populate_decoder_nserror(&error, decoder, status);
+            pl_decoder_free(decoder);
+            results[idx] = [error retain];
+            [pool drain];
+            return;
+        }
+
+        PLCrashReport *report = [[PLCrashReport alloc] initWithDecoder: decoder error: &error];
+        if (report == nil && error == nil)
+            populate_nserror(&error, PLCrashReporterErrorUnknown, @"An unknown error occured decoding the crash report");
+        results[idx] = (report != nil) ? report : [error retain];
+        [pool drain];
+    });
+
+    NSArray *reports = [NSArray arrayWithObjects: results count: count];
+    for (NSUInteger i = 0; i < count; i++)
+        [results[i] release];
+    free(results);
+
+    return reports;
+}
+
+/**
+ * @internal
+ *
+ * Initialize with an already decoded crash log, taking ownership of @a decoder. On error, nil will be returned,
+ * and an NSError instance will be provided via @a error, if non-NULL.
+ *
+ * @param decoder A decoder that has successfully decoded a crash log via pl_decoder_decode(). The decoder will be
+ * freed once the receiver and any lazily materialized values referencing it have been deallocated, or immediately
+ * on error.
+ * @param outError If an error occurs, this pointer will contain an NSError object indicating why the crash log could
+ * not be parsed.
+ */
+- (id) initWithDecoder: (_PLCrashReportDecoder *) decoder error: (NSError **) outError {
     if ((self = [super init]) == nil) {
         // This shouldn't happen, but we have to fufill our API contract
         populate_nserror(outError, PLCrashReporterErrorUnknown, @"Could not initialize superclass");
+        pl_decoder_free(decoder);
         return nil;
     }
 
+    _decoder = decoder;
+    _decoderOwner = [[PLCrashReportDecoderOwner alloc] initWithDecoder: _decoder];
 
-    /* Allocate the struct and attempt to parse */
-    _decoder = malloc(sizeof(_PLCrashReportDecoder));
-    _decoder->crashReport = [self decodeCrashData: encodedData error: outError];
-
-    /* Check if decoding failed. If so, outError has already been populated. */
-    if (_decoder->crashReport == NULL) {
-        goto error;
-    }
+    /* Symbol names, image paths and other strings are created directly over the arena */
+    pl_decoder_strings_init(_decoder, _decoderOwner);
 
     /* Report info (optional) */
     _uuid = NULL;
@@ -110,6 +367,12 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
             memcpy(&uuid_bytes, _decoder->crashReport->report_info->uuid.data, _decoder->crashReport->report_info->uuid.len);
             _uuid = CFUUIDCreateFromUUIDBytes(NULL, uuid_bytes);
         }
+
+        /* Thread suspension time (optional) */
+        if (_decoder->crashReport->report_info->has_thread_suspend_duration) {
+            _hasThreadSuspendDuration = YES;
+            _threadSuspendDuration = _decoder->crashReport->report_info->thread_suspend_duration;
+        }
     }
 
     /* System info */
@@ -149,13 +412,7 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
             goto error;
     }
 
-    /* Thread info */
-    _threads = [[self extractThreadInfo: _decoder->crashReport error: outError] retain];
-    if (!_threads) _threads = [[NSArray alloc] init];
-
-    /* Image info */
-    _images = [[self extractImageInfo: _decoder->crashReport error: outError] retain];
-    if (!_images) _images = [[NSArray alloc] init];
+    /* Thread and image info are materialized on first access; see -threads and -images. */
 
     /* Exception info, if it is available */
     if (_decoder->crashReport->exception != NULL) {
@@ -164,6 +421,58 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
             goto error;
     }
 
+    /* Instrumentation, if it is available */
+    if (_decoder->crashReport->instrumentation != NULL) {
+        Plcrash__CrashReport__Instrumentation *instrumentation = _decoder->crashReport->instrumentation;
+        _instrumentationInfo = [[PLCrashReportInstrumentationInfo alloc] initWithThreadSuspendTime: instrumentation->thread_suspend_time
+                                                                                         unwindTime: instrumentation->unwind_time
+                                                                              symbolTableLookupTime: instrumentation->symtab_lookup_time
+                                                                                     objcLookupTime: instrumentation->objc_lookup_time
+                                                                                     imageWriteTime: instrumentation->image_write_time
+                                                                                         outputTime: instrumentation->output_time
+                                                                                        outputCount: instrumentation->output_count
+                                                                                  memoryObjectCount: instrumentation->mobject_count
+                                                                                    memoryReadCount: instrumentation->vm_read_count
+                                                                             allocatorHighWaterMark: instrumentation->allocator_high_water_mark
+                                                                                    signalStackSize: instrumentation->signal_stack_size
+                                                                           signalStackHighWaterMark: instrumentation->signal_stack_high_water_mark];
+    }
+
+    /* Diagnostic trace events */
+    _traceEvents = [[self extractTraceEvents: _decoder->crashReport] retain];
+
+    /* Stack memory */
+    _stackMemory = [[self extractStackMemory: _decoder->crashReport error: outError] retain];
+    if (!_stackMemory)
+        goto error;
+
+    /* Register memory */
+    _registerMemory = [[self extractRegisterMemory: _decoder->crashReport] retain];
+
+    /* Application breadcrumbs */
+    _breadcrumbs = [[self extractBreadcrumbs: _decoder->crashReport] retain];
+
+    /* Application custom data */
+    _customData = [[self extractCustomData: _decoder->crashReport] retain];
+
+    /* Image manifest reference (optional) */
+    if (_decoder->crashReport->image_manifest != NULL)
+        _imageManifestIdentifier = [[NSString alloc] initWithFormat: @"%016llx", (unsigned long long) _decoder->crashReport->image_manifest->identifier];
+
+    /* VM region summary (optional) */
+    _vmRegions = [[self extractVMRegions: _decoder->crashReport->vm_region_summary error: outError] retain];
+    if (!_vmRegions)
+        goto error;
+    if (_decoder->crashReport->vm_region_summary != NULL)
+        _vmRegionSummaryTruncated = _decoder->crashReport->vm_region_summary->truncated;
+
+    /* Truncation, if it is available */
+    if (_decoder->crashReport->truncation != NULL) {
+        _elidedThreadCount = _decoder->crashReport->truncation->elided_thread_count;
+        _elidedImageCount = _decoder->crashReport->truncation->elided_image_count;
+        _deadlineExpired = _decoder->crashReport->truncation->has_deadline_expired && _decoder->crashReport->truncation->deadline_expired;
+    }
+
     return self;
 
 error:
@@ -171,6 +480,99 @@ error:
     return nil;
 }
 
+/**
+ * Initialize with the crash log at @a path. The file is memory mapped, rather than read into memory, and the
+ * report's fields are decoded directly from the mapping; this avoids holding a second copy of the encoded report
+ * while processing pending reports. On error, nil will be returned, and an NSError instance will be provided
+ * via @a error, if non-NULL.
+ *
+ * @param path Path to an encoded plcrash crash log.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the crash log could not be read or parsed. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ */
+- (id) initWithContentsOfFile: (NSString *) path error: (NSError **) outError {
+    NSData *data = [[NSData alloc] initWithContentsOfFile: path options: NSDataReadingMappedAlways error: outError];
+    if (data == nil) {
+        [self release];
+        return nil;
+    }
+
+    /* The mapping is only referenced while decoding; all decoded values are copied */
+    self = [self initWithData: data error: outError];
+    [data release];
+
+    return self;
+}
+
+/**
+ * Compute a 64-bit signature for the encoded crash log @a encodedData, suitable for grouping
+ * duplicate reports.
+ *
+ * The signature is derived from the image UUIDs and image-relative offsets of the crashed thread's innermost
+ * @a frameCount frames, and is computed directly from the encoded report, without decoding the full report.
+ *
+ * @param encodedData Encoded plcrash crash log.
+ * @param frameCount The maximum number of crashed thread frames to include in the signature.
+ * @param signature On success, will be set to the computed signature.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the signature could not be computed. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @return Returns YES on success, or NO if the crash log is invalid or does not contain a crashed thread.
+ */
++ (BOOL) signatureForCrashData: (NSData *) encodedData frameCount: (NSUInteger) frameCount signature: (uint64_t *) signature error: (NSError **) outError {
+    plcrash_error_t err = plcrash_nasync_report_signature([encodedData bytes], [encodedData length], (uint32_t) MIN(frameCount, UINT32_MAX), signature);
+    if (err == PLCRASH_ENOTFOUND) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Crash log does not contain a crashed thread",
+                                                                                             @"Crash log signature error message"));
+        return NO;
+    } else if (err != PLCRASH_ESUCCESS) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode invalid crash log",
+                                                                                             @"Crash log signature error message"));
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ * Verify that the encoded crash log @a encodedData was completely written, using the integrity trailer appended to
+ * each report by the writer, without decoding the report. This may be used to discard incomplete reports before
+ * they are decoded or submitted.
+ *
+ * Reports written by releases that predate the integrity trailer do not include one, and will fail verification;
+ * whether such a report is complete can only be determined by decoding it.
+ *
+ * @param encodedData Encoded plcrash crash log.
+ * @param verifyChecksum If YES, the report's checksum is computed and compared to that recorded in its trailer,
+ * requiring a single pass over the report's data. If NO, only the trailer and the report length it records are
+ * verified.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the crash log failed verification. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @return Returns YES if the crash log is intact, or NO if it is incomplete, has been modified, or does not include
+ * an integrity trailer.
+ */
++ (BOOL) verifyIntegrityOfCrashData: (NSData *) encodedData verifyChecksum: (BOOL) verifyChecksum error: (NSError **) outError {
+    plcrash_error_t err = plcrash_nasync_report_verify_integrity([encodedData bytes], [encodedData length], verifyChecksum);
+    if (err == PLCRASH_ENOTFOUND) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Crash log is incomplete or does not include an integrity trailer",
+                                                                                             @"Crash log integrity error message"));
+        return NO;
+    } else if (err != PLCRASH_ESUCCESS) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Crash log does not match its integrity trailer",
+                                                                                             @"Crash log integrity error message"));
+        return NO;
+    }
+
+    return YES;
+}
+
 - (void) dealloc {
     /* Free the data objects */
     [_systemInfo release];
@@ -181,22 +583,118 @@ error:
     [_machExceptionInfo release];
     [_threads release];
     [_images release];
+    [_sortedImages release];
+    free(_sortedImageBases);
+    [_executableImage release];
     [_exceptionInfo release];
+    [_instrumentationInfo release];
+    [_traceEvents release];
+    [_stackMemory release];
+    [_registerMemory release];
+    [_breadcrumbs release];
+    [_customData release];
+    [_imageManifestIdentifier release];
+    [_vmRegions release];
+    [_manifestImages release];
     
     if (_uuid != NULL)
         CFRelease(_uuid);
 
-    /* Free the decoder state */
-    if (_decoder != NULL) {
-        if (_decoder->crashReport != NULL) {
-            protobuf_c_message_free_unpacked((ProtobufCMessage *) _decoder->crashReport, &protobuf_c_system_allocator);
+    /* Release the decoder state; it will be freed once any lazily materialized values referencing it are
+     * also released. The interned strings reference the owner, and must be released first to break the cycle. */
+    if (_decoder != NULL)
+        pl_decoder_strings_free(_decoder);
+    [_decoderOwner release];
+    _decoder = NULL;
+
+    [super dealloc];
+}
+
+/**
+ * Thread information. Returns a list of PLCrashReportThreadInfo instances.
+ *
+ * The thread values are materialized on first access, and each thread's stack frames are materialized on
+ * first access of that thread's PLCrashReportThreadInfo::stackFrames property.
+ */
+- (NSArray *) threads {
+    @synchronized (self) {
+        if (_threads == nil) {
+            _threads = [[self extractThreadInfo: _decoder->crashReport error: NULL] retain];
+            if (!_threads) _threads = [[NSArray alloc] init];
         }
+    }
+
+    return _threads;
+}
 
-        free(_decoder);
-        _decoder = NULL;
+/**
+ * Binary image information. Returns a list of PLCrashReportBinaryImageInfo instances. The image values are
+ * materialized on first access.
+ */
+- (NSArray *) images {
+    @synchronized (self) {
+        if (_images == nil) {
+            _images = [[self extractImageInfo: _decoder->crashReport error: NULL] retain];
+            if (!_images) _images = [[NSArray alloc] init];
+
+            /* Prepend the images supplied by the image manifest */
+            if (_manifestImages != nil) {
+                NSArray *combined = [_manifestImages arrayByAddingObjectsFromArray: _images];
+                [_images release];
+                _images = [combined retain];
+            }
+        }
     }
 
-    [super dealloc];
+    return _images;
+}
+
+// property getter. Builds the sorted image list (and the address index used by -imageForAddress:) on first use.
+- (NSArray *) sortedImages {
+    @synchronized (self) {
+        if (_sortedImages == nil) {
+            NSArray *sorted = [self.images sortedArrayUsingComparator: ^NSComparisonResult (id image1, id image2) {
+                uint64_t addr1 = [image1 imageBaseAddress];
+                uint64_t addr2 = [image2 imageBaseAddress];
+
+                if (addr1 < addr2)
+                    return NSOrderedAscending;
+                else if (addr1 > addr2)
+                    return NSOrderedDescending;
+                else
+                    return NSOrderedSame;
+            }];
+
+            _sortedImageBases = malloc(sizeof(uint64_t) * MAX([sorted count], 1));
+            for (NSUInteger i = 0; i < [sorted count]; i++)
+                _sortedImageBases[i] = [[sorted objectAtIndex: i] imageBaseAddress];
+
+            _sortedImages = [sorted retain];
+        }
+    }
+
+    return _sortedImages;
+}
+
+// property getter. Resolves the executable image on first use.
+- (PLCrashReportBinaryImageInfo *) executableImage {
+    @synchronized (self) {
+        if (!_executableImageResolved) {
+            NSString *processPath = self.hasProcessInfo ? self.processInfo.processPath : nil;
+            if (processPath != nil) {
+                for (PLCrashReportBinaryImageInfo *imageInfo in self.images) {
+                    if ([imageInfo.imageName isEqual: processPath]) {
+                        _executableImage = [imageInfo retain];
+                        break;
+                    }
+                }
+            }
+
+            _executableImageResolved = YES;
+        }
+    }
+
+    return _executableImage;
 }
 
 /**
@@ -206,8 +704,22 @@ error:
  * @param address The address to search for.
  */
 - (PLCrashReportBinaryImageInfo *) imageForAddress: (uint64_t) address {
-    for (PLCrashReportBinaryImageInfo *imageInfo in self.images) {
-        if (imageInfo.imageBaseAddress <= address && address < (imageInfo.imageBaseAddress + imageInfo.imageSize))
+    NSArray *sorted = self.sortedImages;
+
+    /* Find the last image with a base address <= address */
+    NSUInteger lo = 0;
+    NSUInteger hi = [sorted count];
+    while (lo < hi) {
+        NSUInteger mid = lo + (hi - lo) / 2;
+        if (_sortedImageBases[mid] <= address)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo > 0) {
+        PLCrashReportBinaryImageInfo *imageInfo = [sorted objectAtIndex: lo - 1];
+        if (address < (imageInfo.imageBaseAddress + imageInfo.imageSize))
             return imageInfo;
     }
 
@@ -215,6 +727,13 @@ error:
     return nil;
 }
 
+// property getter. Returns YES if instrumentation is available.
+- (BOOL) hasInstrumentationInfo {
+    if (_instrumentationInfo != nil)
+        return YES;
+    return NO;
+}
+
 // property getter. Returns YES if machine information is available.
 - (BOOL) hasMachineInfo {
     if (_machineInfo != nil)
@@ -242,10 +761,22 @@ error:
 @synthesize processInfo = _processInfo;
 @synthesize signalInfo = _signalInfo;
 @synthesize machExceptionInfo = _machExceptionInfo;
-@synthesize threads = _threads;
-@synthesize images = _images;
 @synthesize exceptionInfo = _exceptionInfo;
 @synthesize uuidRef = _uuid;
+@synthesize hasThreadSuspendDuration = _hasThreadSuspendDuration;
+@synthesize threadSuspendDuration = _threadSuspendDuration;
+@synthesize instrumentationInfo = _instrumentationInfo;
+@synthesize traceEvents = _traceEvents;
+@synthesize stackMemory = _stackMemory;
+@synthesize registerMemory = _registerMemory;
+@synthesize elidedThreadCount = _elidedThreadCount;
+@synthesize elidedImageCount = _elidedImageCount;
+@synthesize deadlineExpired = _deadlineExpired;
+@synthesize breadcrumbs = _breadcrumbs;
+@synthesize customData = _customData;
+@synthesize imageManifestIdentifier = _imageManifestIdentifier;
+@synthesize vmRegions = _vmRegions;
+@synthesize vmRegionSummaryTruncated = _vmRegionSummaryTruncated;
 
 @end
 
@@ -254,52 +785,17 @@ error:
  * @internal
  * Private Methods
  */
-@implementation PLCrashReport (PrivateMethods)
-
-/**
- * Decode the crash log message.
- *
- * @warning MEMORY WARNING. The caller is responsible for deallocating th ePlcrash__CrashReport instance
- * returned by this method via protobuf_c_message_free_unpacked().
- */
-- (Plcrash__CrashReport *) decodeCrashData: (NSData *) data error: (NSError **) outError {
-    const struct PLCrashReportFileHeader *header;
-    const void *bytes;
-
-    bytes = [data bytes];
-    header = bytes;
-
-    /* Verify that the crash log is sufficently large */
-    if (sizeof(struct PLCrashReportFileHeader) >= [data length]) {
-        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode truncated crash log",
-                                                                                             @"Crash log decoding error message"));
-        return NULL;
-    }
-
-    /* Check the file magic */
-    if (memcmp(header->magic, PLCRASH_REPORT_FILE_MAGIC, strlen(PLCRASH_REPORT_FILE_MAGIC)) != 0) {
-        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid,NSLocalizedString(@"Could not decode invalid crash log header",
-                                                                                            @"Crash log decoding error message"));
-        return NULL;
-    }
+@implementation PLCrashReport (Message)
 
-    /* Check the version */
-    if(header->version != PLCRASH_REPORT_FILE_VERSION) {
-        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, [NSString stringWithFormat: NSLocalizedString(@"Could not decode unsupported crash report version: %d", 
-                                                                                                                         @"Crash log decoding message"), header->version]);
-        return NULL;
-    }
+// property getter. Returns the decoded message.
+- (const Plcrash__CrashReport *) decodedMessage {
+    return _decoder->crashReport;
+}
 
-    Plcrash__CrashReport *crashReport = plcrash__crash_report__unpack(&protobuf_c_system_allocator, [data length] - sizeof(struct PLCrashReportFileHeader), header->data);
-    if (crashReport == NULL) {
-        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"An unknown error occured decoding the crash report", 
-                                                                                             @"Crash log decoding error message"));
-        return NULL;
-    }
+@end
 
-    return crashReport;
-}
 
+@implementation PLCrashReport (PrivateMethods)
 
 /**
  * Extract system information from the crash log. Returns nil on error.
@@ -476,47 +972,6 @@ error:
                                                            native: processInfo->native] autorelease];
 }
 
-/**
- * Extract symbol information from the crash log. Returns nil on error, or a PLCrashReportSymbolInfo
- * instance on success.
- */
-- (PLCrashReportSymbolInfo *) extractSymbolInfo: (Plcrash__CrashReport__Symbol *) symbol error: (NSError **) outError {
-    if (symbol == NULL) {
-//        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid,
-//                         NSLocalizedString(@"Crash report is missing symbol information",
-//                                           @"Missing symbol info in crash report"));
-        return nil;
-    }
-    
-    NSString *name = [NSString stringWithUTF8String: symbol->name];
-    return [[[PLCrashReportSymbolInfo alloc] initWithSymbolName: name
-                                                   startAddress: symbol->start_address
-                                                     endAddress: symbol->has_end_address ? symbol->end_address : 0] autorelease];
-}
-
-/**
- * Extract stack frame information from the crash log. Returns nil on error, or a PLCrashReportStackFrameInfo
- * instance on success.
- */
-- (PLCrashReportStackFrameInfo *) extractStackFrameInfo: (Plcrash__CrashReport__Thread__StackFrame *) stackFrame error: (NSError **) outError {
-    /* There should be at least one thread */
-    if (stackFrame == NULL) {
-//        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid,
-//                         NSLocalizedString(@"Crash report is missing stack frame information",
-//                                           @"Missing stack frame info in crash report"));
-        return nil;
-    }
-    
-    PLCrashReportSymbolInfo *symbolInfo = nil;
-    if (stackFrame->symbol != NULL) {
-        if ((symbolInfo = [self extractSymbolInfo: stackFrame->symbol error: outError]) == NULL)
-            return NULL;
-    }
-
-    return [[[PLCrashReportStackFrameInfo alloc] initWithInstructionPointer: stackFrame->pc
-                                                                 symbolInfo: symbolInfo] autorelease];
-}
-
 /**
  * Extract thread information from the crash log. Returns nil on error, or an array of PLCrashLogThreadInfo
  * instances on success.
@@ -534,20 +989,48 @@ error:
     NSMutableArray *threadResult = [NSMutableArray arrayWithCapacity: crashReport->n_threads];
     for (size_t thr_idx = 0; thr_idx < crashReport->n_threads; thr_idx++) {
         Plcrash__CrashReport__Thread *thread = crashReport->threads[thr_idx];
-        
-        /* Fetch stack frames for this thread */
-        NSMutableArray *frames = [NSMutableArray arrayWithCapacity: thread->n_frames];
-        for (size_t frame_idx = 0; frame_idx < thread->n_frames; frame_idx++) {
-            Plcrash__CrashReport__Thread__StackFrame *frame = thread->frames[frame_idx];
-            PLCrashReportStackFrameInfo *frameInfo = [self extractStackFrameInfo: frame error: outError];
-            if (frameInfo == nil)
-                return nil;
 
-            [frames addObject: frameInfo];
+        /* The frames of a deduplicated thread are those of the thread it references */
+        Plcrash__CrashReport__Thread *frameSource = thread;
+        if (thread->has_duplicate_of_thread) {
+            frameSource = NULL;
+            for (size_t i = 0; i < crashReport->n_threads; i++) {
+                Plcrash__CrashReport__Thread *candidate = crashReport->threads[i];
+                if (candidate->thread_number == thread->duplicate_of_thread && !candidate->has_duplicate_of_thread) {
+                    frameSource = candidate;
+                    break;
+                }
+            }
+
+            if (frameSource == NULL) {
+                populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Deduplicated thread references a missing thread");
+                return nil;
+            }
         }
 
+        /* Defer materializing the stack frames for this thread until they're accessed. The loader retains the
+         * decoder owner (rather than this report), ensuring that the message remains valid. */
+        PLCrashReportDecoderOwner *owner = _decoderOwner;
+        NSArray *(^frameLoader)(void) = ^NSArray *(void) {
+            @synchronized (owner) {
+                NSArray *frames;
+                if (frameSource->has_frame_pcs)
+                    frames = extract_packed_stack_frames(&frameSource->frame_pcs, NULL);
+                else
+                    frames = extract_stack_frames(owner.decoder, frameSource->frames, frameSource->n_frames, NULL);
+                return frames != nil ? frames : [NSArray array];
+            }
+        };
+
         /* Fetch registers for this thread */
         NSMutableArray *registers = [NSMutableArray arrayWithCapacity: thread->n_registers];
+        if (thread->has_register_values) {
+            NSArray *packed = extract_packed_registers(crashReport->register_set, &thread->register_values, outError);
+            if (packed == nil)
+                return nil;
+            [registers addObjectsFromArray: packed];
+        }
+
         for (size_t reg_idx = 0; reg_idx < thread->n_registers; reg_idx++) {
             Plcrash__CrashReport__Thread__RegisterValue *reg = thread->registers[reg_idx];
             PLCrashReportRegisterInfo *regInfo;
@@ -558,16 +1041,22 @@ error:
                 return nil;
             }
 
-            regInfo = [[[PLCrashReportRegisterInfo alloc] initWithRegisterName: [NSString stringWithUTF8String: reg->name]
+            NSString *regName = pl_decoder_copy_string(_decoder, reg->name);
+            regInfo = [[[PLCrashReportRegisterInfo alloc] initWithRegisterName: regName
                                                               registerValue: reg->value] autorelease];
+            [regName release];
             [registers addObject: regInfo];
         }
 
         /* Create the thread info instance */
+        NSString *threadName = thread->name != NULL ? pl_decoder_copy_string(_decoder, thread->name) : nil;
         PLCrashReportThreadInfo *threadInfo = [[[PLCrashReportThreadInfo alloc] initWithThreadNumber: thread->thread_number
-                                                                                   stackFrames: frames 
-                                                                                       crashed: thread->crashed 
-                                                                                     registers: registers] autorelease];
+                                                                             stackFramesLoader: frameLoader
+                                                                                       crashed: thread->crashed
+                                                                                   alsoCrashed: thread->has_also_crashed && thread->also_crashed
+                                                                                     registers: registers
+                                                                                          name: threadName] autorelease];
+        [threadName release];
         [threadResult addObject: threadInfo];
     }
     
@@ -587,21 +1076,73 @@ error:
         return nil;
     }
 
-    /* Handle all records */
-    NSMutableArray *images = [NSMutableArray arrayWithCapacity: crashReport->n_binary_images];
-    for (size_t i = 0; i < crashReport->n_binary_images; i++) {
-        Plcrash__CrashReport__BinaryImage *image = crashReport->binary_images[i];
-        PLCrashReportBinaryImageInfo *imageInfo;
+    return [self extractBinaryImages: crashReport->binary_images count: crashReport->n_binary_images decoder: _decoder error: outError];
+}
 
-        /* Validate */
-        if (image->name == NULL) {
-            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Missing image name in image record");
-            return nil;
-        }
+/**
+ * Extract the images of the encoded image manifest @a manifestData, omitting any images that the report records as
+ * having been unloaded. Returns nil on error.
+ */
+- (NSArray *) extractManifestImages: (NSData *) manifestData error: (NSError **) outError {
+    Plcrash__CrashReport__ImageManifestReference *reference = _decoder->crashReport->image_manifest;
 
-        /* Extract UUID value */
-        NSData *uuid = nil;
-        if (image->uuid.len == 0) {
+    /* Verify that this is the referenced manifest */
+    if (plcrash_log_writer_image_manifest_identifier([manifestData bytes], [manifestData length]) != reference->identifier) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"The image manifest does not match the manifest referenced by the crash report");
+        return nil;
+    }
+
+    Plcrash__ImageManifest *manifest = plcrash__image_manifest__unpack(NULL, [manifestData length], [manifestData bytes]);
+    if (manifest == NULL) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"An unknown error occured decoding the image manifest");
+        return nil;
+    }
+
+    /* The manifest is not decoded into the report's arena, and its strings must be copied */
+    NSArray *manifestImages = [self extractBinaryImages: manifest->binary_images count: manifest->n_binary_images decoder: NULL error: outError];
+    plcrash__image_manifest__free_unpacked(manifest, NULL);
+    if (manifestImages == nil)
+        return nil;
+
+    /* Drop the images that had been unloaded */
+    NSMutableArray *images = [NSMutableArray arrayWithCapacity: [manifestImages count]];
+    for (PLCrashReportBinaryImageInfo *imageInfo in manifestImages) {
+        BOOL removed = NO;
+        for (size_t i = 0; i < reference->n_removed_images; i++) {
+            if (reference->removed_images[i] == imageInfo.imageBaseAddress) {
+                removed = YES;
+                break;
+            }
+        }
+
+        if (!removed)
+            [images addObject: imageInfo];
+    }
+
+    return images;
+}
+
+/**
+ * Extract the @a count binary image records of @a binaryImages. If the records were decoded into @a decoder's arena,
+ * image names are created directly over the arena; otherwise, @a decoder must be NULL, and the names are copied.
+ * Returns nil on error.
+ */
+- (NSArray *) extractBinaryImages: (Plcrash__CrashReport__BinaryImage **) binaryImages count: (size_t) count decoder: (_PLCrashReportDecoder *) decoder error: (NSError **) outError {
+    /* Handle all records */
+    NSMutableArray *images = [NSMutableArray arrayWithCapacity: count];
+    for (size_t i = 0; i < count; i++) {
+        Plcrash__CrashReport__BinaryImage *image = binaryImages[i];
+        PLCrashReportBinaryImageInfo *imageInfo;
+
+        /* Validate */
+        if (image->name == NULL) {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Missing image name in image record");
+            return nil;
+        }
+
+        /* Extract UUID value */
+        NSData *uuid = nil;
+        if (image->uuid.len == 0) {
             /* No UUID */
             uuid = nil;
         } else {
@@ -617,11 +1158,13 @@ error:
         }
 
 
+        NSString *name = pl_decoder_copy_string(decoder, image->name);
         imageInfo = [[[PLCrashReportBinaryImageInfo alloc] initWithCodeType: codeType
                                                                 baseAddress: image->base_address
                                                                        size: image->size
-                                                                       name: [NSString stringWithUTF8String: image->name]
+                                                                       name: name
                                                                        uuid: uuid] autorelease];
+        [name release];
         [images addObject: imageInfo];
     }
 
@@ -663,17 +1206,11 @@ error:
     NSString *reason = [NSString stringWithUTF8String: exceptionInfo->reason];
     
     /* Fetch stack frames for this thread */
-    NSMutableArray *frames = nil;
+    NSArray *frames = nil;
     if (exceptionInfo->n_frames > 0) {
-        frames = [NSMutableArray arrayWithCapacity: exceptionInfo->n_frames];
-        for (size_t frame_idx = 0; frame_idx < exceptionInfo->n_frames; frame_idx++) {
-            Plcrash__CrashReport__Thread__StackFrame *frame = exceptionInfo->frames[frame_idx];
-            PLCrashReportStackFrameInfo *frameInfo = [self extractStackFrameInfo: frame error: outError];
-            if (frameInfo == nil)
-                return nil;
-            
-            [frames addObject: frameInfo];
-        }
+        frames = extract_stack_frames(_decoder, exceptionInfo->frames, exceptionInfo->n_frames, outError);
+        if (frames == nil)
+            return nil;
     }
 
     if (frames == nil) {
@@ -754,6 +1291,184 @@ error:
     return [[[PLCrashReportMachExceptionInfo alloc] initWithType: machExceptionInfo->type codes: codes] autorelease];
 }
 
+/**
+ * Extract the diagnostic trace events from the crash log. Events with an unknown identifier are returned with a
+ * nil name.
+ */
+- (NSArray *) extractTraceEvents: (Plcrash__CrashReport *) crashReport {
+    NSMutableArray *events = [NSMutableArray arrayWithCapacity: crashReport->n_trace_events];
+
+    for (size_t i = 0; i < crashReport->n_trace_events; i++) {
+        Plcrash__CrashReport__TraceEvent *event = crashReport->trace_events[i];
+
+        NSMutableArray *args = [NSMutableArray arrayWithCapacity: event->n_args];
+        for (size_t j = 0; j < event->n_args; j++)
+            [args addObject: [NSNumber numberWithUnsignedLongLong: event->args[j]]];
+
+        NSString *name = nil;
+        const char *cname = plcrash_async_trace_event_name(event->event);
+        if (cname != NULL)
+            name = [NSString stringWithUTF8String: cname];
+
+        PLCrashReportTraceEvent *info = [[[PLCrashReportTraceEvent alloc] initWithSequenceNumber: event->sequence
+                                                                                  eventIdentifier: event->event
+                                                                                             name: name
+                                                                                        arguments: args] autorelease];
+        [events addObject: info];
+    }
+
+    return events;
+}
+
+/**
+ * Extract captured stack memory from the crash log, expanding any suppressed runs of zero bytes. Returns nil on error.
+ */
+- (NSArray *) extractStackMemory: (Plcrash__CrashReport *) crashReport error: (NSError **) outError {
+    NSMutableArray *regions = [NSMutableArray arrayWithCapacity: crashReport->n_stack_memory];
+
+    for (size_t i = 0; i < crashReport->n_stack_memory; i++) {
+        Plcrash__CrashReport__StackMemory *memory = crashReport->stack_memory[i];
+        if (memory->length > NSUIntegerMax) {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Invalid stack memory length");
+            return nil;
+        }
+
+        /* Unwritten bytes are zero */
+        NSMutableData *data = [NSMutableData dataWithLength: (NSUInteger) memory->length];
+        for (size_t j = 0; j < memory->n_chunks; j++) {
+            Plcrash__CrashReport__StackMemory__Chunk *chunk = memory->chunks[j];
+            if (chunk->offset > memory->length || chunk->data.len > memory->length - chunk->offset) {
+                populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Stack memory chunk exceeds the captured length");
+                return nil;
+            }
+
+            [data replaceBytesInRange: NSMakeRange((NSUInteger) chunk->offset, chunk->data.len) withBytes: chunk->data.data];
+        }
+
+        PLCrashReportStackMemoryInfo *info = [[[PLCrashReportStackMemoryInfo alloc] initWithThreadNumber: memory->thread_number
+                                                                                                  address: memory->address
+                                                                                                     data: data] autorelease];
+        [regions addObject: info];
+    }
+
+    return regions;
+}
+
+/**
+ * Extract captured register memory from the crash log.
+ */
+- (NSArray *) extractRegisterMemory: (Plcrash__CrashReport *) crashReport {
+    NSMutableArray *regions = [NSMutableArray arrayWithCapacity: crashReport->n_register_memory];
+
+    for (size_t i = 0; i < crashReport->n_register_memory; i++) {
+        Plcrash__CrashReport__MemoryRegion *region = crashReport->register_memory[i];
+        NSData *data = [NSData dataWithBytes: region->data.data length: region->data.len];
+
+        PLCrashReportMemoryRegionInfo *info = [[[PLCrashReportMemoryRegionInfo alloc] initWithThreadNumber: region->thread_number
+                                                                                                    address: region->address
+                                                                                                       data: data] autorelease];
+        [regions addObject: info];
+    }
+
+    return regions;
+}
+
+/**
+ * Decode a single varint from @a *cursor, advancing the cursor.
+ *
+ * @return Returns true on success, or false if the varint is malformed or extends beyond @a end.
+ */
+static bool pl_vm_region_read_varint (const uint8_t **cursor, const uint8_t *end, uint64_t *value) {
+    uint64_t result = 0;
+    for (unsigned int shift = 0; shift < 64 && *cursor < end; shift += 7) {
+        uint8_t byte = *(*cursor)++;
+        result |= ((uint64_t) (byte & 0x7F)) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Extract the VM region table from the crash log.
+ */
+- (NSArray *) extractVMRegions: (Plcrash__CrashReport__VMRegionSummary *) summary error: (NSError **) outError {
+    if (summary == NULL)
+        return [NSArray array];
+
+    NSMutableArray *regions = [NSMutableArray arrayWithCapacity: summary->region_count];
+    const uint8_t *cursor = summary->regions.data;
+    const uint8_t *end = cursor + summary->regions.len;
+    uint64_t prev_end = 0;
+
+    for (uint32_t i = 0; i < summary->region_count; i++) {
+        uint64_t delta, size, protection, user_tag, share_mode;
+        if (!pl_vm_region_read_varint(&cursor, end, &delta) ||
+            !pl_vm_region_read_varint(&cursor, end, &size) ||
+            !pl_vm_region_read_varint(&cursor, end, &protection) ||
+            !pl_vm_region_read_varint(&cursor, end, &user_tag) ||
+            !pl_vm_region_read_varint(&cursor, end, &share_mode))
+        {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"VM region table is truncated or malformed");
+            return nil;
+        }
+
+        uint64_t address = prev_end + delta;
+        PLCrashReportVMRegionInfo *info = [[[PLCrashReportVMRegionInfo alloc] initWithAddress: address
+                                                                                          size: size
+                                                                                    protection: (uint32_t) (protection & 0xF)
+                                                                                 maxProtection: (uint32_t) ((protection >> 4) & 0xF)
+                                                                                       userTag: (uint32_t) user_tag
+                                                                                     shareMode: (uint32_t) share_mode] autorelease];
+        [regions addObject: info];
+        prev_end = address + size;
+    }
+
+    return regions;
+}
+
+/**
+ * Extract the application breadcrumbs from the crash log.
+ */
+- (NSArray *) extractBreadcrumbs: (Plcrash__CrashReport *) crashReport {
+    NSMutableArray *breadcrumbs = [NSMutableArray arrayWithCapacity: crashReport->n_breadcrumbs];
+
+    for (size_t i = 0; i < crashReport->n_breadcrumbs; i++) {
+        Plcrash__CrashReport__Breadcrumb *breadcrumb = crashReport->breadcrumbs[i];
+        NSData *data = [NSData dataWithBytes: breadcrumb->data.data length: breadcrumb->data.len];
+
+        PLCrashReportBreadcrumb *info = [[[PLCrashReportBreadcrumb alloc] initWithSequenceNumber: breadcrumb->sequence data: data] autorelease];
+        [breadcrumbs addObject: info];
+    }
+
+    return breadcrumbs;
+}
+
+/**
+ * Extract the application custom data regions from the crash log.
+ */
+- (NSArray *) extractCustomData: (Plcrash__CrashReport *) crashReport {
+    NSMutableArray *regions = [NSMutableArray arrayWithCapacity: crashReport->n_custom_data];
+
+    for (size_t i = 0; i < crashReport->n_custom_data; i++) {
+        Plcrash__CrashReport__CustomData *region = crashReport->custom_data[i];
+        NSString *identifier = [NSString stringWithUTF8String: region->identifier];
+        NSData *data = [NSData dataWithBytes: region->data.data length: region->data.len];
+
+        PLCrashReportCustomData *info = [[[PLCrashReportCustomData alloc] initWithIdentifier: identifier
+                                                                                         data: data
+                                                                                   hasVersion: region->has_version
+                                                                                      version: region->version
+                                                                                         torn: region->has_torn && region->torn] autorelease];
+        [regions addObject: info];
+    }
+
+    return regions;
+}
+
 @end
 
 /**
@@ -781,3 +1496,883 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
     
     *error = [NSError errorWithDomain: PLCrashReporterErrorDomain code: code userInfo: userInfo];
 }
+
+/**
+ * @internal
+ *
+ * Read a base 128 varint from @a data at @a offset, advancing @a offset. Returns false if the varint is
+ * truncated or malformed.
+ */
+static bool read_varint (const uint8_t *data, size_t length, size_t *offset, uint64_t *value) {
+    uint64_t result = 0;
+
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        if (*offset >= length)
+            return false;
+
+        uint8_t byte = data[(*offset)++];
+        result |= ((uint64_t) (byte & 0x7F)) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @internal
+ *
+ * Return the length of the longest prefix of the encoded message @a data that consists solely
+ * of complete fields. This is used to recover the readable portion of a truncated report.
+ *
+ * @param data The encoded message.
+ * @param length The length of @a data.
+ */
+static size_t complete_message_length (const uint8_t *data, size_t length) {
+    size_t offset = 0;
+    size_t complete = 0;
+
+    while (offset < length) {
+        uint64_t key;
+        uint64_t value;
+        uint64_t skip = 0;
+
+        if (!read_varint(data, length, &offset, &key))
+            break;
+
+        /* Determine the number of value bytes following the key */
+        switch (key & 0x7) {
+            case 0: /* varint */
+                if (!read_varint(data, length, &offset, &value))
+                    return complete;
+                break;
+
+            case 1: /* 64-bit */
+                skip = 8;
+                break;
+
+            case 2: /* length-delimited */
+                if (!read_varint(data, length, &offset, &skip))
+                    return complete;
+                break;
+
+            case 5: /* 32-bit */
+                skip = 4;
+                break;
+
+            default:
+                return complete;
+        }
+
+        if (skip > length - offset)
+            return complete;
+
+        offset += skip;
+        complete = offset;
+    }
+
+    return complete;
+}
+
+/**
+ * @internal
+ *
+ * Allocate a new decoder, sizing its arena for a report of @a encoded_length bytes. Returns NULL if allocation fails.
+ */
+static _PLCrashReportDecoder *pl_decoder_alloc (size_t encoded_length) {
+    _PLCrashReportDecoder *decoder = malloc(sizeof(_PLCrashReportDecoder));
+    if (decoder == NULL)
+        return NULL;
+
+    decoder->crashReport = NULL;
+    decoder->version = 0;
+    decoder->stringDeallocator = NULL;
+    decoder->internedStrings = NULL;
+    pthread_mutex_init(&decoder->stringLock, NULL);
+    pl_decoder_arena_init(&decoder->arena, encoded_length);
+
+    return decoder;
+}
+
+/**
+ * @internal
+ *
+ * Decode the crash log in @a bytes into @a decoder's arena. Compressed crash logs are transparently decompressed, and
+ * truncated crash logs are decoded up to the last completely written field.
+ *
+ * @param decoder A newly allocated decoder.
+ * @param bytes The encoded crash log.
+ * @param length The length of @a bytes.
+ * @param scratch_cache If non-NULL, scratch chunks to be reused for protobuf-c's temporary allocations. On return,
+ * the chunks retained for reuse by a subsequent decode are stored in @a scratch_cache, and must eventually be freed
+ * via pl_decoder_chunks_free(). If NULL, the scratch chunks are freed once decoding completes.
+ */
+static pl_decoder_status_t pl_decoder_decode (_PLCrashReportDecoder *decoder, const void *bytes, size_t length, struct pl_decoder_arena_chunk **scratch_cache) {
+    const struct PLCrashReportFileHeader *header;
+    uint8_t *decompressed = NULL;
+    pl_decoder_status_t status = PL_DECODER_OK;
+
+    /* Transparently decompress compressed reports */
+    if (plcrash_async_compressor_is_compressed(bytes, length)) {
+        size_t decoded_length;
+
+        if (plcrash_nasync_compressor_decode(bytes, length, &decompressed, &decoded_length) != PLCRASH_ESUCCESS)
+            return PL_DECODER_ERROR_COMPRESSION;
+
+        bytes = decompressed;
+        length = decoded_length;
+        decoder->arena.chunk_size = MAX(decoder->arena.chunk_size, decoded_length);
+    }
+
+    header = bytes;
+
+    /* Verify that the crash log is sufficently large */
+    if (sizeof(struct PLCrashReportFileHeader) >= length) {
+        status = PL_DECODER_ERROR_TRUNCATED;
+        goto cleanup;
+    }
+
+    /* Check the file magic */
+    if (memcmp(header->magic, PLCRASH_REPORT_FILE_MAGIC, strlen(PLCRASH_REPORT_FILE_MAGIC)) != 0) {
+        status = PL_DECODER_ERROR_MAGIC;
+        goto cleanup;
+    }
+
+    /* Check the version */
+    decoder->version = header->version;
+    if(header->version != PLCRASH_REPORT_FILE_VERSION && header->version != PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE &&
+       header->version != PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS && header->version != PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES &&
+       header->version != PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS) {
+        status = PL_DECODER_ERROR_VERSION;
+        goto cleanup;
+    }
+
+    /* Reuse any cached scratch storage */
+    if (scratch_cache != NULL) {
+        decoder->arena.scratch = *scratch_cache;
+        *scratch_cache = NULL;
+        pl_decoder_chunks_reset(&decoder->arena.scratch);
+    }
+
+    size_t message_length = length - sizeof(struct PLCrashReportFileHeader);
+    ProtobufCAllocator allocator = pl_decoder_arena_allocator(&decoder->arena);
+    Plcrash__CrashReport *crashReport = plcrash_report_unpack(&allocator, message_length, header->data);
+
+    /* If the report was truncated (eg, the process was terminated while a streaming report was being written), attempt
+     * to recover the fields that were completely written. */
+    if (crashReport == NULL) {
+        size_t complete_length = complete_message_length(header->data, message_length);
+        if (complete_length > 0 && complete_length < message_length) {
+            /* Discard any storage left over from the failed attempt */
+            pl_decoder_chunks_free(&decoder->arena.chunks);
+            pl_decoder_chunks_reset(&decoder->arena.scratch);
+            crashReport = plcrash_report_unpack(&allocator, complete_length, header->data);
+        }
+    }
+
+    /* The scanned field records used while unpacking are no longer required */
+    if (scratch_cache != NULL) {
+        *scratch_cache = decoder->arena.scratch;
+        decoder->arena.scratch = NULL;
+    } else {
+        pl_decoder_arena_free_scratch(&decoder->arena);
+    }
+
+    if (crashReport == NULL) {
+        status = PL_DECODER_ERROR_UNPACK;
+        goto cleanup;
+    }
+
+    decoder->crashReport = crashReport;
+
+cleanup:
+    free(decompressed);
+    return status;
+}
+
+/**
+ * @internal
+ *
+ * Free @a decoder, along with the decoded message.
+ */
+static void pl_decoder_free (_PLCrashReportDecoder *decoder) {
+    pl_decoder_strings_free(decoder);
+    pthread_mutex_destroy(&decoder->stringLock);
+
+    /* The decoded message is owned entirely by the arena */
+    pl_decoder_arena_free(&decoder->arena);
+    free(decoder);
+}
+
+/* Retain the string deallocator's owner */
+static const void *pl_decoder_owner_retain (const void *info) {
+    return CFRetain(info);
+}
+
+/* Release the string deallocator's owner */
+static void pl_decoder_owner_release (const void *info) {
+    CFRelease(info);
+}
+
+/* The string deallocator never allocates */
+static void *pl_decoder_string_allocate (CFIndex size, CFOptionFlags hint, void *info) {
+    return NULL;
+}
+
+/* String contents are owned by the arena, and are never individually freed */
+static void pl_decoder_string_deallocate (void *ptr, void *info) {
+}
+
+/* Hash a NUL-terminated interned string key (FNV-1a) */
+static CFHashCode pl_decoder_string_key_hash (const void *value) {
+    CFHashCode hash = (CFHashCode) 2166136261U;
+    for (const uint8_t *p = value; *p != '\0'; p++)
+        hash = (hash ^ *p) * 16777619U;
+    return hash;
+}
+
+/* Compare two NUL-terminated interned string keys */
+static Boolean pl_decoder_string_key_equal (const void *value1, const void *value2) {
+    return strcmp(value1, value2) == 0;
+}
+
+/**
+ * @internal
+ *
+ * Prepare @a decoder to vend strings created directly over its arena, rather than copied from it. Each such string
+ * retains @a owner, ensuring that the arena outlives it.
+ *
+ * If this fails, or once pl_decoder_strings_free() is called, strings are copied.
+ */
+static void pl_decoder_strings_init (_PLCrashReportDecoder *decoder, PLCrashReportDecoderOwner *owner) {
+    CFAllocatorContext context = {
+        .version = 0,
+        .info = owner,
+        .retain = pl_decoder_owner_retain,
+        .release = pl_decoder_owner_release,
+        .copyDescription = NULL,
+        .allocate = pl_decoder_string_allocate,
+        .reallocate = NULL,
+        .deallocate = pl_decoder_string_deallocate,
+        .preferredSize = NULL
+    };
+    CFDictionaryKeyCallBacks keyCallbacks = {
+        .version = 0,
+        .retain = NULL,
+        .release = NULL,
+        .copyDescription = NULL,
+        .equal = pl_decoder_string_key_equal,
+        .hash = pl_decoder_string_key_hash
+    };
+
+    pthread_mutex_lock(&decoder->stringLock);
+    decoder->stringDeallocator = CFAllocatorCreate(kCFAllocatorDefault, &context);
+    decoder->internedStrings = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &keyCallbacks, &kCFTypeDictionaryValueCallBacks);
+    if (decoder->stringDeallocator == NULL || decoder->internedStrings == NULL) {
+        if (decoder->stringDeallocator != NULL)
+            CFRelease(decoder->stringDeallocator);
+        if (decoder->internedStrings != NULL)
+            CFRelease(decoder->internedStrings);
+
+        decoder->stringDeallocator = NULL;
+        decoder->internedStrings = NULL;
+    }
+    pthread_mutex_unlock(&decoder->stringLock);
+}
+
+/**
+ * @internal
+ *
+ * Release @a decoder's interned strings and string deallocator. Strings created over the arena remain valid for as
+ * long as they are retained; strings requested after this call are copied.
+ *
+ * The interned strings retain the decoder's owner, and must be released before the owner can be deallocated.
+ */
+static void pl_decoder_strings_free (_PLCrashReportDecoder *decoder) {
+    pthread_mutex_lock(&decoder->stringLock);
+    if (decoder->internedStrings != NULL) {
+        CFRelease(decoder->internedStrings);
+        decoder->internedStrings = NULL;
+    }
+
+    if (decoder->stringDeallocator != NULL) {
+        CFRelease(decoder->stringDeallocator);
+        decoder->stringDeallocator = NULL;
+    }
+    pthread_mutex_unlock(&decoder->stringLock);
+}
+
+/**
+ * @internal
+ *
+ * Return a retained string for the NUL-terminated UTF-8 @a cstring, or nil if @a cstring is not valid UTF-8.
+ *
+ * If @a cstring is stored within @a decoder's arena, the string is created directly over the arena's bytes, and
+ * identical strings within the report share a single instance. If @a decoder is NULL, or is no longer vending
+ * arena strings, the bytes are copied.
+ *
+ * @param decoder The decoder in whose arena @a cstring is stored, or NULL.
+ * @param cstring The string to return.
+ */
+static NSString *pl_decoder_copy_string (_PLCrashReportDecoder *decoder, const char *cstring) {
+    if (decoder == NULL)
+        return [[NSString alloc] initWithUTF8String: cstring];
+
+    pthread_mutex_lock(&decoder->stringLock);
+    if (decoder->stringDeallocator == NULL) {
+        pthread_mutex_unlock(&decoder->stringLock);
+        return [[NSString alloc] initWithUTF8String: cstring];
+    }
+
+    CFStringRef string = CFDictionaryGetValue(decoder->internedStrings, cstring);
+    if (string != NULL) {
+        CFRetain(string);
+    } else {
+        /* Strings that can't be represented over UTF-8 bytes are transparently copied by CFString, and the no-op
+         * deallocator is immediately invoked */
+        string = CFStringCreateWithBytesNoCopy(kCFAllocatorDefault, (const UInt8 *) cstring, (CFIndex) strlen(cstring), kCFStringEncodingUTF8,
+                                               false, decoder->stringDeallocator);
+        if (string != NULL)
+            CFDictionarySetValue(decoder->internedStrings, cstring, string);
+    }
+    pthread_mutex_unlock(&decoder->stringLock);
+
+    return (NSString *) string;
+}
+
+/**
+ * @internal
+ *
+ * Populate @a error with a description of the pl_decoder_decode() failure @a status.
+ */
+static void populate_decoder_nserror (NSError **error, _PLCrashReportDecoder *decoder, pl_decoder_status_t status) {
+    switch (status) {
+        case PL_DECODER_OK:
+            break;
+
+        case PL_DECODER_ERROR_COMPRESSION:
+            populate_nserror(error, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decompress crash log",
+                                                                                              @"Crash log decoding error message"));
+            break;
+
+        case PL_DECODER_ERROR_TRUNCATED:
+            populate_nserror(error, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode truncated crash log",
+                                                                                              @"Crash log decoding error message"));
+            break;
+
+        case PL_DECODER_ERROR_MAGIC:
+            populate_nserror(error, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode invalid crash log header",
+                                                                                              @"Crash log decoding error message"));
+            break;
+
+        case PL_DECODER_ERROR_VERSION:
+            populate_nserror(error, PLCrashReporterErrorCrashReportInvalid, [NSString stringWithFormat: NSLocalizedString(@"Could not decode unsupported crash report version: %d",
+                                                                                                                           @"Crash log decoding message"), decoder->version]);
+            break;
+
+        case PL_DECODER_ERROR_UNPACK:
+            populate_nserror(error, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"An unknown error occured decoding the crash report",
+                                                                                              @"Crash log decoding error message"));
+            break;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Invoke @a decode for each index in [0, @a count), distributing the indices across a pool of at most @a worker_count
+ * concurrent workers. Each worker passes its own scratch chunk cache to @a decode, allowing the scratch storage to
+ * be reused across all reports decoded by the worker. Returns once all indices have been processed.
+ *
+ * @param count The number of indices.
+ * @param worker_count The maximum number of concurrent workers, or 0 to use the number of active processors.
+ * @param decode The block to invoke for each index.
+ */
+static void pl_decoder_batch_apply (size_t count, size_t worker_count, void (^decode)(size_t idx, struct pl_decoder_arena_chunk **scratch_cache)) {
+    if (worker_count == 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = (ncpu > 0) ? (size_t) ncpu : 1;
+    }
+    worker_count = MIN(worker_count, count);
+
+    /* Workers claim the next unprocessed index, balancing the load across reports of differing sizes */
+    __block volatile int64_t next = 0;
+    dispatch_apply(worker_count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t worker) {
+        struct pl_decoder_arena_chunk *scratch_cache = NULL;
+
+        int64_t idx;
+        while ((idx = OSAtomicIncrement64Barrier(&next) - 1) < (int64_t) count)
+            decode((size_t) idx, &scratch_cache);
+
+        pl_decoder_chunks_free(&scratch_cache);
+    });
+}
+
+/**
+ * @internal
+ *
+ * Decode @a count crash logs concurrently, across a pool of at most @a worker_count workers. Each worker reuses its
+ * own decoder scratch storage across the crash logs it decodes.
+ *
+ * @param reports The encoded crash logs.
+ * @param lengths The length of each entry in @a reports.
+ * @param count The number of crash logs.
+ * @param worker_count The maximum number of concurrent workers, or 0 to use the number of active processors.
+ * @param messages On return, the decoded message for each crash log in input order, or NULL if the crash log could
+ * not be decoded. Each non-NULL message must be freed via plcrash_report_message_free().
+ * @param errors On return, the result of decoding each crash log, in input order. PLCRASH_ENOTSUP is returned for
+ * unsupported report versions, PLCRASH_ENOMEM on allocation failure, and PLCRASH_EINVAL for any other invalid
+ * crash log.
+ *
+ * @return Returns PLCRASH_ESUCCESS if all crash logs were decoded, or PLCRASH_EINVAL if any crash log could not be
+ * decoded.
+ */
+plcrash_error_t plcrash_report_message_decode_batch (const void * const *reports, const size_t *lengths, size_t count, size_t worker_count,
+                                                     plcrash_report_message_t **messages, plcrash_error_t *errors)
+{
+    __block volatile int32_t failed = 0;
+
+    pl_decoder_batch_apply(count, worker_count, ^(size_t idx, struct pl_decoder_arena_chunk **scratch_cache) {
+        messages[idx] = NULL;
+
+        _PLCrashReportDecoder *decoder = pl_decoder_alloc(lengths[idx]);
+        if (decoder == NULL) {
+            errors[idx] = PLCRASH_ENOMEM;
+            OSAtomicIncrement32(&failed);
+            return;
+        }
+
+        pl_decoder_status_t status = pl_decoder_decode(decoder, reports[idx], lengths[idx], scratch_cache);
+        if (status != PL_DECODER_OK) {
+            errors[idx] = (status == PL_DECODER_ERROR_VERSION) ? PLCRASH_ENOTSUP : PLCRASH_EINVAL;
+            pl_decoder_free(decoder);
+            OSAtomicIncrement32(&failed);
+            return;
+        }
+
+        messages[idx] = decoder;
+        errors[idx] = PLCRASH_ESUCCESS;
+    });
+
+    return (failed == 0) ? PLCRASH_ESUCCESS : PLCRASH_EINVAL;
+}
+
+/**
+ * @internal
+ *
+ * Return the crash report message decoded by plcrash_report_message_decode_batch(). The message is owned by
+ * @a message.
+ */
+const Plcrash__CrashReport *plcrash_report_message_crash_report (plcrash_report_message_t *message) {
+    return message->crashReport;
+}
+
+/**
+ * @internal
+ *
+ * Free a message decoded by plcrash_report_message_decode_batch().
+ */
+void plcrash_report_message_free (plcrash_report_message_t *message) {
+    pl_decoder_free(message);
+}
+
+/**
+ * @internal
+ *
+ * Initialize a decoder arena.
+ *
+ * @param arena The arena to initialize.
+ * @param encoded_length The length of the encoded report. The decoded structures are of a similar size, allowing
+ * most reports to be decoded into a single chunk.
+ */
+static void pl_decoder_arena_init (pl_decoder_arena_t *arena, size_t encoded_length) {
+    arena->chunks = NULL;
+    arena->scratch = NULL;
+    arena->chunk_size = MAX(DECODER_ARENA_MIN_CHUNK_SIZE, encoded_length);
+}
+
+/**
+ * @internal
+ *
+ * Allocate @a size bytes from the chunk list @a chunks, allocating a new chunk of at least @a chunk_size bytes
+ * if required.
+ */
+static void *pl_decoder_chunks_alloc (struct pl_decoder_arena_chunk **chunks, size_t chunk_size, size_t size) {
+    struct pl_decoder_arena_chunk *chunk = *chunks;
+    const size_t header_size = DECODER_ARENA_HEADER_SIZE;
+
+    size = (size + DECODER_ARENA_ALIGN - 1) & ~(DECODER_ARENA_ALIGN - 1);
+
+    if (chunk == NULL || chunk->size - chunk->used < size) {
+        struct pl_decoder_arena_chunk *next = malloc(MAX(chunk_size, header_size + size));
+        if (next == NULL)
+            return NULL;
+
+        next->size = MAX(chunk_size, header_size + size);
+        next->used = header_size;
+
+        /* Oversized allocations are given their own chunk, which is placed behind the current chunk so that the current
+         * chunk's remaining space is not abandoned */
+        if (chunk != NULL && size > chunk_size / 4) {
+            next->next = chunk->next;
+            chunk->next = next;
+        } else {
+            next->next = chunk;
+            *chunks = next;
+        }
+
+        chunk = next;
+    }
+
+    void *result = (uint8_t *) chunk + chunk->used;
+    chunk->used += size;
+    return result;
+}
+
+/**
+ * @internal
+ *
+ * Free all chunks in the chunk list @a chunks.
+ */
+static void pl_decoder_chunks_free (struct pl_decoder_arena_chunk **chunks) {
+    struct pl_decoder_arena_chunk *chunk = *chunks;
+    while (chunk != NULL) {
+        struct pl_decoder_arena_chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    *chunks = NULL;
+}
+
+/**
+ * @internal
+ *
+ * Reset the chunk list @a chunks for reuse, freeing all but the largest chunk.
+ */
+static void pl_decoder_chunks_reset (struct pl_decoder_arena_chunk **chunks) {
+    struct pl_decoder_arena_chunk *largest = NULL;
+    struct pl_decoder_arena_chunk *chunk = *chunks;
+    while (chunk != NULL) {
+        struct pl_decoder_arena_chunk *next = chunk->next;
+        if (largest == NULL || chunk->size > largest->size) {
+            free(largest);
+            largest = chunk;
+        } else {
+            free(chunk);
+        }
+        chunk = next;
+    }
+
+    if (largest != NULL) {
+        largest->next = NULL;
+        largest->used = DECODER_ARENA_HEADER_SIZE;
+    }
+
+    *chunks = largest;
+}
+
+/**
+ * @internal
+ *
+ * protobuf-c allocation callback.
+ */
+static void *pl_decoder_arena_alloc (void *allocator_data, size_t size) {
+    pl_decoder_arena_t *arena = allocator_data;
+    return pl_decoder_chunks_alloc(&arena->chunks, arena->chunk_size, size);
+}
+
+/**
+ * @internal
+ *
+ * protobuf-c temporary allocation callback. As protobuf-c never frees temporary allocations, these are allocated
+ * from the arena's scratch chunks, which are released by pl_decoder_arena_free_scratch() once unpacking completes.
+ */
+static void *pl_decoder_arena_tmp_alloc (void *allocator_data, size_t size) {
+    pl_decoder_arena_t *arena = allocator_data;
+    return pl_decoder_chunks_alloc(&arena->scratch, DECODER_ARENA_MIN_CHUNK_SIZE, size);
+}
+
+/**
+ * @internal
+ *
+ * protobuf-c free callback. Arena storage is only released by pl_decoder_arena_free().
+ */
+static void pl_decoder_arena_free_ptr (void *allocator_data, void *pointer) {
+    // no-op
+}
+
+/**
+ * @internal
+ *
+ * Return a protobuf-c allocator backed by @a arena.
+ */
+static ProtobufCAllocator pl_decoder_arena_allocator (pl_decoder_arena_t *arena) {
+    ProtobufCAllocator allocator = {
+        .alloc = pl_decoder_arena_alloc,
+        .free = pl_decoder_arena_free_ptr,
+        .tmp_alloc = pl_decoder_arena_tmp_alloc,
+        .max_alloca = 0,
+        .allocator_data = arena
+    };
+    return allocator;
+}
+
+/**
+ * @internal
+ *
+ * Release the storage backing all temporary allocations made via @a arena.
+ */
+static void pl_decoder_arena_free_scratch (pl_decoder_arena_t *arena) {
+    pl_decoder_chunks_free(&arena->scratch);
+}
+
+/**
+ * @internal
+ *
+ * Release all storage held by @a arena. The arena may be reused for further allocations.
+ */
+static void pl_decoder_arena_free (pl_decoder_arena_t *arena) {
+    pl_decoder_chunks_free(&arena->chunks);
+    pl_decoder_chunks_free(&arena->scratch);
+}
+
+/** Register names of the CrashReport.REGISTER_SET_X86_32 register set, in register number order. */
+static const char *packed_register_names_x86_32[] = {
+    "eip", "ebp", "esp", "eax", "edx", "ecx", "ebx", "esi", "edi", "eflags", "trapno", "cs", "ds", "es", "fs", "gs"
+};
+
+/** Register names of the CrashReport.REGISTER_SET_X86_64 register set, in register number order. */
+static const char *packed_register_names_x86_64[] = {
+    "rip", "rbp", "rsp", "rax", "rbx", "rcx", "rdx", "rdi", "rsi", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15",
+    "rflags", "cs", "fs", "gs"
+};
+
+/** Register names of the CrashReport.REGISTER_SET_ARM register set, in register number order. */
+static const char *packed_register_names_arm[] = {
+    "pc", "r7", "sp", "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r11", "r12", "lr", "cpsr"
+};
+
+/**
+ * @internal
+ *
+ * Return the name of register @a regnum within @a registerSet, or NULL if the register is not defined by the
+ * register set (eg, a set introduced by a newer writer).
+ */
+const char *plcrash_report_message_register_name (Plcrash__CrashReport__RegisterSet registerSet, size_t regnum) {
+#define REGISTER_NAME(table) (regnum < sizeof(table) / sizeof(table[0]) ? table[regnum] : NULL)
+    switch (registerSet) {
+        case PLCRASH__CRASH_REPORT__REGISTER_SET__REGISTER_SET_X86_32:
+            return REGISTER_NAME(packed_register_names_x86_32);
+
+        case PLCRASH__CRASH_REPORT__REGISTER_SET__REGISTER_SET_X86_64:
+            return REGISTER_NAME(packed_register_names_x86_64);
+
+        case PLCRASH__CRASH_REPORT__REGISTER_SET__REGISTER_SET_ARM:
+            return REGISTER_NAME(packed_register_names_arm);
+
+        default:
+            return NULL;
+    }
+#undef REGISTER_NAME
+}
+
+/**
+ * @internal
+ *
+ * Decode a thread's packed register values, naming each register from the static name table of @a registerSet.
+ * Registers that are not defined by the register set are named 'r<number>'. Returns nil on error, or an array of
+ * PLCrashReportRegisterInfo instances on success.
+ */
+static NSArray *extract_packed_registers (Plcrash__CrashReport__RegisterSet registerSet, ProtobufCBinaryData *values, NSError **outError) {
+    /* Values must be whole 64-bit words */
+    if (values->len % sizeof(uint64_t) != 0) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Packed register values are not a multiple of 8 bytes");
+        return nil;
+    }
+
+    size_t count = values->len / sizeof(uint64_t);
+    NSMutableArray *registers = [NSMutableArray arrayWithCapacity: count];
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value;
+        memcpy(&value, values->data + (i * sizeof(uint64_t)), sizeof(value));
+        value = OSSwapLittleToHostInt64(value);
+
+        NSString *name;
+        const char *cname = plcrash_report_message_register_name(registerSet, i);
+        if (cname != NULL)
+            name = [NSString stringWithUTF8String: cname];
+        else
+            name = [NSString stringWithFormat: @"r%zu", i];
+
+        [registers addObject: [[[PLCrashReportRegisterInfo alloc] initWithRegisterName: name registerValue: value] autorelease]];
+    }
+
+    return registers;
+}
+
+/**
+ * @internal
+ *
+ * Extract symbol information from the crash log. Returns nil on error, or a PLCrashReportSymbolInfo
+ * instance on success.
+ */
+static PLCrashReportSymbolInfo *extract_symbol_info (_PLCrashReportDecoder *decoder, Plcrash__CrashReport__Symbol *symbol, NSError **outError) {
+    if (symbol == NULL) {
+        return nil;
+    }
+
+    /* Names are either inline, or resolved from the report's symbol table */
+    NSString *name;
+    if (symbol->name != NULL) {
+        name = pl_decoder_copy_string(decoder, symbol->name);
+    } else if (symbol->has_name_index && symbol->name_index < decoder->crashReport->n_symbol_names) {
+        name = pl_decoder_copy_string(decoder, decoder->crashReport->symbol_names[symbol->name_index]);
+    } else {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Symbol record is missing a valid name");
+        return nil;
+    }
+
+    NSString *sourceFile = nil;
+    if (symbol->source_file != NULL)
+        sourceFile = pl_decoder_copy_string(decoder, symbol->source_file);
+
+    NSMutableArray *inlinedFrames = [NSMutableArray arrayWithCapacity: symbol->n_inlined_frames];
+    for (size_t i = 0; i < symbol->n_inlined_frames; i++) {
+        Plcrash__CrashReport__Symbol__InlinedFrame *inlined = symbol->inlined_frames[i];
+        NSString *inlinedName = inlined->name != NULL ? pl_decoder_copy_string(decoder, inlined->name) : nil;
+        NSString *callFile = inlined->call_file != NULL ? pl_decoder_copy_string(decoder, inlined->call_file) : nil;
+
+        PLCrashReportInlinedFrameInfo *info = [[[PLCrashReportInlinedFrameInfo alloc] initWithSymbolName: inlinedName
+                                                                                                  callFile: callFile
+                                                                                                  callLine: inlined->has_call_line ? inlined->call_line : 0] autorelease];
+        [inlinedName release];
+        [callFile release];
+        [inlinedFrames addObject: info];
+    }
+
+    PLCrashReportSymbolInfo *symbolInfo = [[[PLCrashReportSymbolInfo alloc] initWithSymbolName: name
+                                                                                  startAddress: symbol->start_address
+                                                                                    endAddress: symbol->has_end_address ? symbol->end_address : 0
+                                                                                    sourceFile: sourceFile
+                                                                                    sourceLine: symbol->has_source_line ? symbol->source_line : 0
+                                                                                 inlinedFrames: inlinedFrames] autorelease];
+    [name release];
+    [sourceFile release];
+
+    return symbolInfo;
+}
+
+/**
+ * @internal
+ *
+ * Extract stack frame information from the crash log. Returns nil on error, or a PLCrashReportStackFrameInfo
+ * instance on success.
+ */
+static PLCrashReportStackFrameInfo *extract_stack_frame_info (_PLCrashReportDecoder *decoder, Plcrash__CrashReport__Thread__StackFrame *stackFrame, NSError **outError) {
+    if (stackFrame == NULL) {
+        return nil;
+    }
+
+    PLCrashReportSymbolInfo *symbolInfo = nil;
+    if (stackFrame->symbol != NULL) {
+        if ((symbolInfo = extract_symbol_info(decoder, stackFrame->symbol, outError)) == nil)
+            return nil;
+    }
+
+    /* Repeated frame groups */
+    uint32_t repeatCount = 1;
+    uint32_t repeatLength = 1;
+    if (stackFrame->has_repeat_count && stackFrame->repeat_count > 1) {
+        if (!stackFrame->has_repeat_length || stackFrame->repeat_length == 0) {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Missing repeat length for repeated stack frame");
+            return nil;
+        }
+
+        repeatCount = stackFrame->repeat_count;
+        repeatLength = stackFrame->repeat_length;
+    }
+
+    uint64_t omittedFrameCount = stackFrame->has_omitted_frame_count ? stackFrame->omitted_frame_count : 0;
+
+    return [[[PLCrashReportStackFrameInfo alloc] initWithInstructionPointer: stackFrame->pc
+                                                                 symbolInfo: symbolInfo
+                                                                repeatCount: repeatCount
+                                                               repeatLength: repeatLength
+                                                          omittedFrameCount: omittedFrameCount] autorelease];
+}
+
+/**
+ * @internal
+ *
+ * Decode a thread's packed, delta-encoded frame PCs. Returns nil on error, or an array of PLCrashReportStackFrameInfo
+ * instances on success.
+ */
+static NSArray *extract_packed_stack_frames (ProtobufCBinaryData *pcs, NSError **outError) {
+    NSMutableArray *frames = [NSMutableArray array];
+    plcrash_async_pb_reader_t reader;
+    plcrash_error_t err;
+    uint64_t deltas[64];
+    size_t count;
+    uint64_t pc = 0;
+
+    plcrash_async_pb_reader_init(&reader, pcs->data, pcs->len);
+    while ((err = plcrash_async_pb_reader_next_varints(&reader, deltas, sizeof(deltas) / sizeof(deltas[0]), &count)) == PLCRASH_ESUCCESS) {
+        for (size_t i = 0; i < count; i++) {
+            pc += (uint64_t) plcrash_async_pb_zigzag_decode(deltas[i]);
+            [frames addObject: [[[PLCrashReportStackFrameInfo alloc] initWithInstructionPointer: pc symbolInfo: nil] autorelease]];
+        }
+    }
+
+    if (err != PLCRASH_ENOTFOUND) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Invalid packed frame PC encoding");
+        return nil;
+    }
+
+    return frames;
+}
+
+/**
+ * @internal
+ *
+ * Extract an ordered list of PLCrashReportStackFrameInfo instances from @a stackFrames. Returns nil on error.
+ */
+static NSArray *extract_stack_frames (_PLCrashReportDecoder *decoder, Plcrash__CrashReport__Thread__StackFrame **stackFrames, size_t count, NSError **outError) {
+    NSMutableArray *frames = [NSMutableArray arrayWithCapacity: count];
+    for (size_t frame_idx = 0; frame_idx < count; frame_idx++) {
+        PLCrashReportStackFrameInfo *frameInfo = extract_stack_frame_info(decoder, stackFrames[frame_idx], outError);
+        if (frameInfo == nil)
+            return nil;
+
+        [frames addObject: frameInfo];
+    }
+
+    return frames;
+}
+
+@implementation PLCrashReportDecoderOwner
+
+@synthesize decoder = _decoder;
+
+/**
+ * Initialize a new instance, taking ownership of @a decoder.
+ *
+ * @param decoder The decoder state to be freed when this instance is deallocated.
+ */
+- (id) initWithDecoder: (_PLCrashReportDecoder *) decoder {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _decoder = decoder;
+    return self;
+}
+
+- (void) dealloc {
+    pl_decoder_free(_decoder);
+
+    [super dealloc];
+}
+
+@end
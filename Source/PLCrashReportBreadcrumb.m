@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportBreadcrumb.h"
+
+/**
+ * An application-recorded breadcrumb.
+ *
+ * Breadcrumbs are recorded via PLCrashReporter::recordBreadcrumbBytes:length: to aid in the interpretation of a crash;
+ * the most recently recorded breadcrumbs are included in each report.
+ */
+@implementation PLCrashReportBreadcrumb
+
+@synthesize sequenceNumber = _sequenceNumber;
+@synthesize data = _data;
+
+/**
+ * Initialize a new breadcrumb data object.
+ *
+ * @param sequenceNumber The breadcrumb's sequence number.
+ * @param data The breadcrumb data.
+ */
+- (id) initWithSequenceNumber: (uint64_t) sequenceNumber data: (NSData *) data {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _sequenceNumber = sequenceNumber;
+    _data = [data retain];
+
+    return self;
+}
+
+- (void) dealloc {
+    [_data release];
+    [super dealloc];
+}
+
+@end
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "CrashReporter.h"
+
+#import "PLCrashReportBundle.h"
+#import "PLCrashReporterNSError.h"
+#import "PLCrashReportBundleFile.h"
+
+/**
+ * Packs multiple crash reports into a single compressed file, and provides random access to the reports contained
+ * in such a file.
+ *
+ * Reports that are queued for upload may be bundled and submitted as a single file, rather than individually. Binary
+ * image and symbol name entries shared between the bundled reports are stored only once, and the bundle is compressed
+ * as a whole; any individual report may be extracted without decoding the others. Extracted reports are identical to
+ * the uncompressed originals, and may be decoded via PLCrashReport.
+ */
+@implementation PLCrashReportBundle
+
+/**
+ * Write a new report bundle containing @a reports to @a path, replacing any existing file.
+ *
+ * @param reports An array of NSData instances, each containing an encoded plcrash crash log. Compressed reports are
+ * stored uncompressed.
+ * @param path The path at which the bundle will be written.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the bundle could not be written. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @return Returns YES on success, or NO on failure.
+ */
++ (BOOL) writeBundleWithReports: (NSArray *) reports toFile: (NSString *) path error: (NSError **) outError {
+    NSUInteger count = [reports count];
+    if (count > UINT32_MAX) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Too many reports to bundle", nil);
+        return NO;
+    }
+
+    const void **bytes = calloc(count == 0 ? 1 : count, sizeof(*bytes));
+    size_t *lengths = calloc(count == 0 ? 1 : count, sizeof(*lengths));
+    if (bytes == NULL || lengths == NULL) {
+        free(bytes);
+        free(lengths);
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not allocate report bundle state", nil);
+        return NO;
+    }
+
+    for (NSUInteger i = 0; i < count; i++) {
+        NSData *report = [reports objectAtIndex: i];
+        bytes[i] = [report bytes];
+        lengths[i] = [report length];
+    }
+
+    plcrash_error_t err = plcrash_nasync_report_bundle_write([path fileSystemRepresentation], bytes, lengths, (uint32_t) count);
+    free(bytes);
+    free(lengths);
+
+    if (err == PLCRASH_EINVAL) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not bundle invalid crash log",
+                                                                                                   @"Crash log bundling error message"), nil);
+        return NO;
+    } else if (err != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, [NSString stringWithFormat: @"Could not write report bundle: %s",
+                                                                               plcrash_async_strerror(err)], nil);
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ * Open the report bundle at @a path.
+ *
+ * @param path The path to a report bundle written by PLCrashReportBundle::writeBundleWithReports:toFile:error:.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the bundle could not be opened. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @return Returns the opened bundle, or nil if the bundle could not be opened.
+ */
+- (id) initWithContentsOfFile: (NSString *) path error: (NSError **) outError {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _bundle = malloc(sizeof(*_bundle));
+    if (_bundle == NULL) {
+        [self release];
+        return nil;
+    }
+
+    plcrash_error_t err = plcrash_nasync_report_bundle_open(_bundle, [path fileSystemRepresentation]);
+    if (err != PLCRASH_ESUCCESS) {
+        free(_bundle);
+        _bundle = NULL;
+
+        if (err == PLCRASH_EINVAL) {
+            plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode invalid report bundle",
+                                                                                                       @"Crash log bundling error message"), nil);
+        } else {
+            plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, [NSString stringWithFormat: @"Could not open report bundle: %s",
+                                                                                   plcrash_async_strerror(err)], nil);
+        }
+
+        [self release];
+        return nil;
+    }
+
+    return self;
+}
+
+- (void) dealloc {
+    if (_bundle != NULL) {
+        plcrash_nasync_report_bundle_close(_bundle);
+        free(_bundle);
+    }
+
+    [super dealloc];
+}
+
+- (NSUInteger) reportCount {
+    return _bundle->count;
+}
+
+/**
+ * Extract the report at @a index. Only the requested report is decompressed.
+ *
+ * @param index The index of the report to extract; must be less than PLCrashReportBundle::reportCount.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the report could not be extracted. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @return Returns the encoded report on success, or nil on failure.
+ */
+- (NSData *) reportDataAtIndex: (NSUInteger) index error: (NSError **) outError {
+    uint8_t *report;
+    size_t length;
+
+    if (index >= _bundle->count) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, [NSString stringWithFormat: @"Report index %lu is out of range",
+                                                                       (unsigned long) index], nil);
+        return nil;
+    }
+
+    if (plcrash_nasync_report_bundle_read(_bundle, (uint32_t) index, &report, &length) != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode invalid bundled crash log",
+                                                                                                   @"Crash log bundling error message"), nil);
+        return nil;
+    }
+
+    return [NSData dataWithBytesNoCopy: report length: length freeWhenDone: YES];
+}
+
+@end
@@ -0,0 +1,840 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashReportBundleFile.h"
+#include "PLCrashAsyncCompressor.h"
+#include "PLCrashAsyncProtobufReader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_report_bundle
+ * @{
+ */
+
+/** The size of a report file header (magic and version), as defined by PLCrashReportFileHeader. */
+#define REPORT_FILE_HEADER_SIZE 8
+
+/** The CrashReport.binary_images field number. */
+#define REPORT_BINARY_IMAGES_FIELD 4
+
+/** The CrashReport.symbol_names field number. */
+#define REPORT_SYMBOL_NAMES_FIELD 10
+
+/** The maximum encoded size of a varint. */
+#define MAX_VARINT_SIZE 10
+
+/**
+ * @internal
+ *
+ * A growable byte buffer.
+ */
+typedef struct bundle_buffer {
+    /** The buffer data, or NULL if empty. */
+    uint8_t *data;
+
+    /** The number of bytes used. */
+    size_t length;
+
+    /** The number of bytes allocated. */
+    size_t capacity;
+} bundle_buffer_t;
+
+/**
+ * @internal
+ *
+ * A shared table under construction. Entries are interned by content via an open-addressed hash table.
+ */
+typedef struct bundle_table {
+    /** The encoded entries, as written to the table section. */
+    bundle_buffer_t encoded;
+
+    /** The number of entries. */
+    uint32_t count;
+
+    /** The number of entries allocated in @a offsets and @a hashes. */
+    uint32_t capacity;
+
+    /** The offset of each entry's data within @a encoded. */
+    size_t *offsets;
+
+    /** The hash of each entry's data. */
+    uint32_t *hashes;
+
+    /** Hash slots, each holding an entry index + 1, or 0 if unused. */
+    uint32_t *slots;
+
+    /** The number of hash slots; always a power of two. */
+    uint32_t slot_count;
+} bundle_table_t;
+
+/**
+ * @internal
+ *
+ * Writes compressed sections to a bundle file.
+ */
+typedef struct section_writer {
+    /** The output file descriptor. */
+    int fd;
+
+    /** The current output offset. */
+    uint64_t offset;
+
+    /** The offset at which the current section began. */
+    uint64_t section_start;
+
+    /** The compressor used for the current section. */
+    plcrash_async_compressor_t *compressor;
+} section_writer_t;
+
+/**
+ * @internal
+ *
+ * A memory-mapped file.
+ */
+typedef struct mapped_file {
+    /** The mapped data. */
+    const uint8_t *data;
+
+    /** The size of @a data. */
+    size_t size;
+} mapped_file_t;
+
+/* Append @a len bytes of @a data to @a buffer, growing it as required. */
+static bool buffer_append (bundle_buffer_t *buffer, const void *data, size_t len) {
+    if (buffer->capacity - buffer->length < len) {
+        size_t new_capacity = buffer->capacity == 0 ? 4096 : buffer->capacity * 2;
+        while (new_capacity - buffer->length < len)
+            new_capacity *= 2;
+
+        uint8_t *new_data = realloc(buffer->data, new_capacity);
+        if (new_data == NULL)
+            return false;
+
+        buffer->data = new_data;
+        buffer->capacity = new_capacity;
+    }
+
+    memcpy(buffer->data + buffer->length, data, len);
+    buffer->length += len;
+    return true;
+}
+
+/* Encode @a value as a varint, returning the number of bytes written to @a output. */
+static size_t encode_varint (uint8_t output[MAX_VARINT_SIZE], uint64_t value) {
+    size_t len = 0;
+    while (value >= 0x80) {
+        output[len++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    output[len++] = (uint8_t) value;
+    return len;
+}
+
+/* Encode the key and length prefix of a length-delimited field, returning the number of bytes written to @a output. */
+static size_t encode_field_prefix (uint8_t output[MAX_VARINT_SIZE * 2], uint32_t field_id, uint64_t length) {
+    size_t len = encode_varint(output, ((uint64_t) field_id << 3) | PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED);
+    return len + encode_varint(output + len, length);
+}
+
+/* FNV-1a hash of @a len bytes of @a data. */
+static uint32_t hash_bytes (const uint8_t *data, size_t len) {
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+/* Release all resources held by @a table. */
+static void table_free (bundle_table_t *table) {
+    free(table->encoded.data);
+    free(table->offsets);
+    free(table->hashes);
+    free(table->slots);
+}
+
+/* Rebuild @a table's hash slots with @a slot_count slots. */
+static bool table_rehash (bundle_table_t *table, uint32_t slot_count) {
+    uint32_t *slots = calloc(slot_count, sizeof(*slots));
+    if (slots == NULL)
+        return false;
+
+    for (uint32_t i = 0; i < table->count; i++) {
+        uint32_t slot = table->hashes[i] & (slot_count - 1);
+        while (slots[slot] != 0)
+            slot = (slot + 1) & (slot_count - 1);
+        slots[slot] = i + 1;
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->slot_count = slot_count;
+    return true;
+}
+
+/**
+ * Return the index of the entry matching @a len bytes of @a data in @a table, adding a new entry if no matching
+ * entry exists.
+ */
+static plcrash_error_t table_intern (bundle_table_t *table, const uint8_t *data, uint32_t len, uint32_t *index) {
+    uint32_t hash = hash_bytes(data, len);
+
+    /* Keep the load factor at or below 1/2 */
+    if (table->slot_count == 0 || table->count >= table->slot_count / 2) {
+        if (!table_rehash(table, table->slot_count == 0 ? 256 : table->slot_count * 2))
+            return PLCRASH_ENOMEM;
+    }
+
+    /* Search for an existing entry */
+    uint32_t slot = hash & (table->slot_count - 1);
+    while (table->slots[slot] != 0) {
+        uint32_t candidate = table->slots[slot] - 1;
+        const uint8_t *entry = table->encoded.data + table->offsets[candidate];
+        uint32_t entry_len;
+        memcpy(&entry_len, entry - sizeof(entry_len), sizeof(entry_len));
+
+        if (table->hashes[candidate] == hash && entry_len == len && memcmp(entry, data, len) == 0) {
+            *index = candidate;
+            return PLCRASH_ESUCCESS;
+        }
+
+        slot = (slot + 1) & (table->slot_count - 1);
+    }
+
+    /* Add a new entry */
+    if (table->count == UINT32_MAX - 1)
+        return PLCRASH_ENOMEM;
+
+    if (table->count == table->capacity) {
+        uint32_t new_capacity = table->capacity == 0 ? 128 : table->capacity * 2;
+        size_t *offsets = realloc(table->offsets, new_capacity * sizeof(*offsets));
+        if (offsets == NULL)
+            return PLCRASH_ENOMEM;
+        table->offsets = offsets;
+
+        uint32_t *hashes = realloc(table->hashes, new_capacity * sizeof(*hashes));
+        if (hashes == NULL)
+            return PLCRASH_ENOMEM;
+        table->hashes = hashes;
+
+        table->capacity = new_capacity;
+    }
+
+    if (!buffer_append(&table->encoded, &len, sizeof(len)) || !buffer_append(&table->encoded, data, len))
+        return PLCRASH_ENOMEM;
+
+    table->offsets[table->count] = table->encoded.length - len;
+    table->hashes[table->count] = hash;
+    table->slots[slot] = table->count + 1;
+    *index = table->count++;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/* Append a recipe record of @a type to @a recipe. */
+static bool recipe_append_op (bundle_buffer_t *recipe, plcrash_report_bundle_op_type_t type, uint32_t value) {
+    plcrash_report_bundle_op_t op = { type, value };
+    return buffer_append(recipe, &op, sizeof(op));
+}
+
+/* Append @a len bytes of literal report data to @a recipe. */
+static bool recipe_append_literal (bundle_buffer_t *recipe, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        uint32_t chunk = len > UINT32_MAX ? UINT32_MAX : (uint32_t) len;
+        if (!recipe_append_op(recipe, PLCRASH_REPORT_BUNDLE_OP_LITERAL, chunk) || !buffer_append(recipe, data, chunk))
+            return false;
+
+        data += chunk;
+        len -= chunk;
+    }
+
+    return true;
+}
+
+/**
+ * Build the recipe for the uncompressed report in @a data, interning its binary image and symbol name entries
+ * in @a images and @a strings.
+ *
+ * Fields are only moved to the shared tables if their encoding can be reproduced exactly; any trailing data that
+ * can not be parsed (such as a truncated field) is preserved as a literal.
+ */
+static plcrash_error_t build_recipe (const uint8_t *data, size_t length, bundle_table_t *images, bundle_table_t *strings, bundle_buffer_t *recipe) {
+    plcrash_async_pb_reader_t reader;
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    if ((err = plcrash_async_pb_reader_init_report(&reader, data, length)) != PLCRASH_ESUCCESS)
+        return err;
+
+    const uint8_t *literal = data;
+    while (reader.p < reader.end) {
+        const uint8_t *field_start = reader.p;
+        if (plcrash_async_pb_reader_next(&reader, &field) != PLCRASH_ESUCCESS)
+            break;
+
+        if (field.wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+            continue;
+
+        bundle_table_t *table;
+        plcrash_report_bundle_op_type_t type;
+        if (field.id == REPORT_BINARY_IMAGES_FIELD) {
+            table = images;
+            type = PLCRASH_REPORT_BUNDLE_OP_IMAGE;
+        } else if (field.id == REPORT_SYMBOL_NAMES_FIELD) {
+            table = strings;
+            type = PLCRASH_REPORT_BUNDLE_OP_STRING;
+        } else {
+            continue;
+        }
+
+        /* Verify that the field prefix will be reproduced exactly */
+        uint8_t prefix[MAX_VARINT_SIZE * 2];
+        size_t field_len = plcrash_async_pb_reader_length(&field.data);
+        size_t prefix_len = encode_field_prefix(prefix, field.id, field_len);
+        if (field_len > UINT32_MAX || prefix_len != (size_t) (field.data.p - field_start) || memcmp(prefix, field_start, prefix_len) != 0)
+            continue;
+
+        uint32_t index;
+        if ((err = table_intern(table, field.data.p, (uint32_t) field_len, &index)) != PLCRASH_ESUCCESS)
+            return err;
+
+        if (!recipe_append_literal(recipe, literal, (size_t) (field_start - literal)) || !recipe_append_op(recipe, type, index))
+            return PLCRASH_ENOMEM;
+
+        literal = reader.p;
+    }
+
+    if (!recipe_append_literal(recipe, literal, (size_t) (data + length - literal)))
+        return PLCRASH_ENOMEM;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/* Write @a len bytes of @a data to the writer's file. */
+static bool writer_write (section_writer_t *writer, const void *data, size_t len) {
+    const uint8_t *p = data;
+    while (len > 0) {
+        ssize_t written = write(writer->fd, p, len);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+
+            PLCF_DEBUG("Could not write report bundle: %s", strerror(errno));
+            return false;
+        }
+
+        p += written;
+        len -= (size_t) written;
+        writer->offset += (uint64_t) written;
+    }
+
+    return true;
+}
+
+/* Begin a new compressed section. */
+static bool writer_begin_section (section_writer_t *writer) {
+    uint8_t header[PLCRASH_ASYNC_COMPRESSOR_MAGIC_SIZE + 1];
+    size_t header_len = plcrash_async_compressor_write_header(header);
+
+    plcrash_async_compressor_reset(writer->compressor);
+    writer->section_start = writer->offset;
+    return writer_write(writer, header, header_len);
+}
+
+/* Encode and write the compressor's pending block, if any. */
+static bool writer_flush_block (section_writer_t *writer) {
+    size_t len = plcrash_async_compressor_encode_block(writer->compressor);
+    if (len == 0)
+        return true;
+
+    return writer_write(writer, writer->compressor->output, len);
+}
+
+/* Append @a len bytes of @a data to the current section. */
+static bool writer_append (section_writer_t *writer, const void *data, size_t len) {
+    const uint8_t *p = data;
+    while (len > 0) {
+        size_t consumed = plcrash_async_compressor_buffer(writer->compressor, p, len);
+        p += consumed;
+        len -= consumed;
+
+        if (len > 0 && !writer_flush_block(writer))
+            return false;
+    }
+
+    return true;
+}
+
+/* Complete the current section, returning its location via @a section. */
+static bool writer_end_section (section_writer_t *writer, plcrash_report_bundle_section_t *section) {
+    if (!writer_flush_block(writer))
+        return false;
+
+    section->offset = writer->section_start;
+    section->length = writer->offset - writer->section_start;
+    return true;
+}
+
+/* Write the report sections, shared tables, index, and footer of a bundle to @a fd. */
+static plcrash_error_t write_bundle (int fd, const void * const *reports, const size_t *lengths, uint32_t count) {
+    bundle_table_t images;
+    bundle_table_t strings;
+    bundle_buffer_t recipe;
+    section_writer_t writer;
+    plcrash_report_bundle_footer_t footer;
+    plcrash_report_bundle_section_t *index = NULL;
+    plcrash_error_t err;
+
+    memset(&images, 0, sizeof(images));
+    memset(&strings, 0, sizeof(strings));
+    memset(&recipe, 0, sizeof(recipe));
+    memset(&footer, 0, sizeof(footer));
+
+    writer.fd = fd;
+    writer.offset = 0;
+    writer.section_start = 0;
+    writer.compressor = malloc(sizeof(*writer.compressor));
+    index = calloc(count == 0 ? 1 : count, sizeof(*index));
+    if (writer.compressor == NULL || index == NULL) {
+        err = PLCRASH_ENOMEM;
+        goto cleanup;
+    }
+
+    /* Header */
+    plcrash_report_bundle_header_t header;
+    memcpy(header.magic, PLCRASH_REPORT_BUNDLE_MAGIC, sizeof(header.magic));
+    header.version = PLCRASH_REPORT_BUNDLE_VERSION;
+    if (!writer_write(&writer, &header, sizeof(header))) {
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    /* Report sections */
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *data = reports[i];
+        size_t length = lengths[i];
+        uint8_t *decoded = NULL;
+
+        /* Compressed reports are stored decompressed; the bundle is compressed as a whole */
+        if (plcrash_async_compressor_is_compressed(data, length)) {
+            if ((err = plcrash_nasync_compressor_decode(data, length, &decoded, &length)) != PLCRASH_ESUCCESS)
+                goto cleanup;
+            data = decoded;
+        }
+
+        recipe.length = 0;
+        err = build_recipe(data, length, &images, &strings, &recipe);
+        free(decoded);
+
+        if (err != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("Could not pack report %" PRIu32 ": %d", i, err);
+            goto cleanup;
+        }
+
+        if (!writer_begin_section(&writer) || !writer_append(&writer, recipe.data, recipe.length) || !writer_end_section(&writer, &index[i])) {
+            err = PLCRASH_EINTERNAL;
+            goto cleanup;
+        }
+    }
+
+    /* Shared tables */
+    if (!writer_begin_section(&writer) ||
+        !writer_append(&writer, images.encoded.data, images.encoded.length) ||
+        !writer_append(&writer, strings.encoded.data, strings.encoded.length) ||
+        !writer_end_section(&writer, &footer.tables))
+    {
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    /* Index and footer, aligned for direct access via the file mapping */
+    static const uint8_t padding[sizeof(uint64_t)] = { 0 };
+    if (!writer_write(&writer, padding, (size_t) (-writer.offset & (sizeof(uint64_t) - 1)))) {
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    footer.index_offset = writer.offset;
+    footer.count = count;
+    footer.image_count = images.count;
+    footer.string_count = strings.count;
+    memcpy(footer.magic, PLCRASH_REPORT_BUNDLE_MAGIC, sizeof(footer.magic));
+    footer.version = PLCRASH_REPORT_BUNDLE_VERSION;
+
+    if (!writer_write(&writer, index, count * sizeof(*index)) || !writer_write(&writer, &footer, sizeof(footer))) {
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    table_free(&images);
+    table_free(&strings);
+    free(recipe.data);
+    free(writer.compressor);
+    free(index);
+    return err;
+}
+
+/**
+ * Pack @a count reports into a new report bundle at @a path, replacing any existing file. The bundle is written to a
+ * temporary file, and moved into place once complete. This function is not async-safe.
+ *
+ * Compressed reports are decompressed before being packed; plcrash_nasync_report_bundle_read() will return the
+ * uncompressed report data.
+ *
+ * @param path The path at which the bundle will be written.
+ * @param reports The report data to be packed, including each report's file header.
+ * @param lengths The length of each report in @a reports, in bytes.
+ * @param count The number of reports in @a reports.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if a report is not a valid crash report, or an error
+ * result if the bundle could not be written.
+ */
+plcrash_error_t plcrash_nasync_report_bundle_write (const char *path, const void * const *reports, const size_t *lengths, uint32_t count) {
+    char *tmp_path = NULL;
+    int fd;
+    plcrash_error_t err;
+
+    if (asprintf(&tmp_path, "%s.XXXXXX", path) < 0)
+        return PLCRASH_ENOMEM;
+
+    if ((fd = mkstemp(tmp_path)) < 0) {
+        PLCF_DEBUG("Could not create %s: %s", tmp_path, strerror(errno));
+        free(tmp_path);
+        return PLCRASH_EINTERNAL;
+    }
+
+    err = write_bundle(fd, reports, lengths, count);
+    close(fd);
+
+    if (err == PLCRASH_ESUCCESS && rename(tmp_path, path) != 0) {
+        PLCF_DEBUG("Could not move report bundle into place at %s: %s", path, strerror(errno));
+        err = PLCRASH_EINTERNAL;
+    }
+
+    if (err != PLCRASH_ESUCCESS)
+        unlink(tmp_path);
+
+    free(tmp_path);
+    return err;
+}
+
+/* Map the file at @a path. */
+static plcrash_error_t map_file (const char *path, mapped_file_t *file) {
+    struct stat sb;
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        PLCF_DEBUG("Could not open %s: %s", path, strerror(errno));
+        return PLCRASH_EINTERNAL;
+    }
+
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode) || sb.st_size == 0) {
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    void *mapping = mmap(NULL, (size_t) sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        PLCF_DEBUG("Could not map %s: %s", path, strerror(errno));
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    file->data = mapping;
+    file->size = (size_t) sb.st_size;
+
+cleanup:
+    close(fd);
+    return err;
+}
+
+/* Return true if @a section lies within the bundle's section area, which ends at @a limit. */
+static bool section_valid (const plcrash_report_bundle_section_t *section, uint64_t limit) {
+    return section->offset >= sizeof(plcrash_report_bundle_header_t) && section->offset <= limit &&
+        section->length <= limit - section->offset;
+}
+
+/* Parse the decoded shared table section of @a bundle. */
+static plcrash_error_t parse_tables (plcrash_report_bundle_t *bundle, size_t tables_length) {
+    uint64_t entry_count = (uint64_t) bundle->footer->image_count + bundle->footer->string_count;
+    if (entry_count > tables_length / sizeof(uint32_t))
+        return PLCRASH_EINVAL;
+
+    bundle->entries = calloc(entry_count == 0 ? 1 : (size_t) entry_count, sizeof(*bundle->entries));
+    bundle->entry_lengths = calloc(entry_count == 0 ? 1 : (size_t) entry_count, sizeof(*bundle->entry_lengths));
+    if (bundle->entries == NULL || bundle->entry_lengths == NULL)
+        return PLCRASH_ENOMEM;
+
+    const uint8_t *p = bundle->tables;
+    const uint8_t *end = p + tables_length;
+    for (uint64_t i = 0; i < entry_count; i++) {
+        uint32_t len;
+        if ((size_t) (end - p) < sizeof(len))
+            return PLCRASH_EINVAL;
+        memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+
+        if ((size_t) (end - p) < len)
+            return PLCRASH_EINVAL;
+
+        bundle->entries[i] = p;
+        bundle->entry_lengths[i] = len;
+        p += len;
+    }
+
+    return p == end ? PLCRASH_ESUCCESS : PLCRASH_EINVAL;
+}
+
+/**
+ * Open and validate the report bundle at @a path. This function is not async-safe.
+ *
+ * The bundle's shared tables are decompressed on open; individual reports are decompressed on demand via
+ * plcrash_nasync_report_bundle_read().
+ *
+ * @param bundle The bundle to initialize.
+ * @param path The path to the report bundle.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if the file is not a valid report bundle, or an error
+ * result if the file could not be read.
+ */
+plcrash_error_t plcrash_nasync_report_bundle_open (plcrash_report_bundle_t *bundle, const char *path) {
+    mapped_file_t file;
+    plcrash_error_t err;
+    size_t tables_length;
+
+    if ((err = map_file(path, &file)) != PLCRASH_ESUCCESS)
+        return err;
+
+    memset(bundle, 0, sizeof(*bundle));
+    bundle->mapping = file.data;
+    bundle->mapping_size = file.size;
+
+    /* Validate the header and footer */
+    const plcrash_report_bundle_header_t *header = (const plcrash_report_bundle_header_t *) file.data;
+    const plcrash_report_bundle_footer_t *footer;
+    if (file.size < sizeof(*header) + sizeof(*footer)) {
+        PLCF_DEBUG("Invalid report bundle %s", path);
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    footer = (const plcrash_report_bundle_footer_t *) (file.data + file.size - sizeof(*footer));
+    if (memcmp(header->magic, PLCRASH_REPORT_BUNDLE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PLCRASH_REPORT_BUNDLE_VERSION ||
+        memcmp(footer->magic, PLCRASH_REPORT_BUNDLE_MAGIC, sizeof(footer->magic)) != 0 ||
+        footer->version != PLCRASH_REPORT_BUNDLE_VERSION ||
+        footer->index_offset < sizeof(*header) || footer->index_offset > file.size || (footer->index_offset & (sizeof(uint64_t) - 1)) != 0 ||
+        footer->index_offset + ((uint64_t) footer->count * sizeof(plcrash_report_bundle_section_t)) + sizeof(*footer) != file.size ||
+        !section_valid(&footer->tables, footer->index_offset))
+    {
+        PLCF_DEBUG("Invalid report bundle %s", path);
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    bundle->footer = footer;
+    bundle->index = (const plcrash_report_bundle_section_t *) (file.data + footer->index_offset);
+    bundle->count = footer->count;
+
+    for (uint32_t i = 0; i < bundle->count; i++) {
+        if (!section_valid(&bundle->index[i], footer->index_offset)) {
+            PLCF_DEBUG("Invalid report section %" PRIu32 " in report bundle %s", i, path);
+            err = PLCRASH_EINVAL;
+            goto cleanup;
+        }
+    }
+
+    /* Decode the shared tables */
+    err = plcrash_nasync_compressor_decode(file.data + footer->tables.offset, (size_t) footer->tables.length, &bundle->tables, &tables_length);
+    if (err != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not decode the shared tables of report bundle %s: %d", path, err);
+        goto cleanup;
+    }
+
+    if ((err = parse_tables(bundle, tables_length)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Invalid shared tables in report bundle %s", path);
+        goto cleanup;
+    }
+
+    return PLCRASH_ESUCCESS;
+
+cleanup:
+    plcrash_nasync_report_bundle_close(bundle);
+    return err;
+}
+
+/**
+ * Reconstruct the report at @a index in @a bundle. This function is not async-safe; however, a single bundle may be
+ * read concurrently from multiple threads.
+ *
+ * @param bundle The bundle from which the report will be read.
+ * @param index The index of the report to be read.
+ * @param report On success, will be set to a malloc-allocated buffer containing the report data, including its file
+ * header. The caller is responsible for free()ing this buffer.
+ * @param length On success, will be set to the length of @a report, in bytes.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if @a index is out of range, PLCRASH_EINVAL if
+ * the report's section is malformed, or PLCRASH_ENOMEM if allocation fails.
+ */
+plcrash_error_t plcrash_nasync_report_bundle_read (plcrash_report_bundle_t *bundle, uint32_t index, uint8_t **report, size_t *length) {
+    const plcrash_report_bundle_section_t *section;
+    uint8_t *recipe;
+    size_t recipe_length;
+    uint8_t *output = NULL;
+    plcrash_error_t err;
+
+    if (index >= bundle->count)
+        return PLCRASH_ENOTFOUND;
+
+    section = &bundle->index[index];
+    err = plcrash_nasync_compressor_decode((const uint8_t *) bundle->mapping + section->offset, (size_t) section->length, &recipe, &recipe_length);
+    if (err != PLCRASH_ESUCCESS)
+        return err;
+
+    /* Validate the recipe and compute the report length, then assemble the report */
+    size_t output_length = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        const uint8_t *p = recipe;
+        const uint8_t *end = recipe + recipe_length;
+        size_t offset = 0;
+
+        while (p < end) {
+            plcrash_report_bundle_op_t op;
+            if ((size_t) (end - p) < sizeof(op)) {
+                err = PLCRASH_EINVAL;
+                goto cleanup;
+            }
+            memcpy(&op, p, sizeof(op));
+            p += sizeof(op);
+
+            const uint8_t *data;
+            size_t data_len;
+            uint8_t prefix[MAX_VARINT_SIZE * 2];
+            size_t prefix_len = 0;
+
+            switch (op.type) {
+                case PLCRASH_REPORT_BUNDLE_OP_LITERAL:
+                    if ((size_t) (end - p) < op.value) {
+                        err = PLCRASH_EINVAL;
+                        goto cleanup;
+                    }
+                    data = p;
+                    data_len = op.value;
+                    p += op.value;
+                    break;
+
+                case PLCRASH_REPORT_BUNDLE_OP_IMAGE:
+                case PLCRASH_REPORT_BUNDLE_OP_STRING: {
+                    uint32_t table_count = op.type == PLCRASH_REPORT_BUNDLE_OP_IMAGE ? bundle->footer->image_count : bundle->footer->string_count;
+                    size_t entry = op.type == PLCRASH_REPORT_BUNDLE_OP_IMAGE ? op.value : (size_t) bundle->footer->image_count + op.value;
+                    if (op.value >= table_count) {
+                        err = PLCRASH_EINVAL;
+                        goto cleanup;
+                    }
+
+                    data = bundle->entries[entry];
+                    data_len = bundle->entry_lengths[entry];
+                    prefix_len = encode_field_prefix(prefix, op.type == PLCRASH_REPORT_BUNDLE_OP_IMAGE ? REPORT_BINARY_IMAGES_FIELD : REPORT_SYMBOL_NAMES_FIELD, data_len);
+                    break;
+                }
+
+                default:
+                    err = PLCRASH_EINVAL;
+                    goto cleanup;
+            }
+
+            if (pass == 0) {
+                if (SIZE_MAX - output_length < prefix_len + data_len) {
+                    err = PLCRASH_ENOMEM;
+                    goto cleanup;
+                }
+                output_length += prefix_len + data_len;
+            } else {
+                memcpy(output + offset, prefix, prefix_len);
+                memcpy(output + offset + prefix_len, data, data_len);
+            }
+            offset += prefix_len + data_len;
+        }
+
+        if (pass == 0) {
+            if (output_length < REPORT_FILE_HEADER_SIZE) {
+                err = PLCRASH_EINVAL;
+                goto cleanup;
+            }
+
+            if ((output = malloc(output_length)) == NULL) {
+                err = PLCRASH_ENOMEM;
+                goto cleanup;
+            }
+        }
+    }
+
+    free(recipe);
+    *report = output;
+    *length = output_length;
+    return PLCRASH_ESUCCESS;
+
+cleanup:
+    free(recipe);
+    free(output);
+    return err;
+}
+
+/**
+ * Close a bundle opened via plcrash_nasync_report_bundle_open().
+ *
+ * @param bundle The bundle to close.
+ */
+void plcrash_nasync_report_bundle_close (plcrash_report_bundle_t *bundle) {
+    free(bundle->tables);
+    free(bundle->entries);
+    free(bundle->entry_lengths);
+    munmap((void *) bundle->mapping, bundle->mapping_size);
+
+    bundle->tables = NULL;
+    bundle->entries = NULL;
+    bundle->entry_lengths = NULL;
+}
+
+/**
+ * @}
+ */
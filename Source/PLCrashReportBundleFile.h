@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_REPORT_BUNDLE_FILE_H
+#define PLCRASH_REPORT_BUNDLE_FILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_report_bundle Report Bundles
+ * @ingroup plcrash_internal
+ *
+ * Implements a single-file container for a batch of crash reports, allowing any number of queued reports to be
+ * uploaded at once.
+ *
+ * Reports from a single application largely share the same binary image list and symbol names. When a bundle is
+ * written, each report's top-level CrashReport.binary_images and CrashReport.symbol_names entries are moved into
+ * shared tables, and each distinct entry is stored only once; the remainder of the report is stored as a recipe of
+ * literal byte ranges and table references. The shared tables and each report recipe are compressed as independent
+ * plcrash_async_compressor streams, so that a single report may be reconstructed by decoding only the tables and
+ * that report's section. Reconstructed reports are byte-for-byte identical to their uncompressed originals.
+ *
+ * @par Bundle Format
+ * A bundle consists of a plcrash_report_bundle_header_t, a compressed section for each report, the compressed shared
+ * table section, an index of @a count plcrash_report_bundle_section_t entries locating the report sections, and a
+ * trailing plcrash_report_bundle_footer_t. The index is padded to an 8-byte aligned offset. As the tables and index are written last, each report is streamed to disk
+ * as it is packed. All values are written in host byte order.
+ *
+ * The decompressed table section contains the image table entries, followed by the string table entries; each is
+ * encoded as a uint32_t length followed by the entry's field data. A decompressed report section is a sequence of
+ * plcrash_report_bundle_op_t records. A literal record is followed by its @a value bytes of report data, including
+ * the report's file header; a table record references the table entry at index @a value, and is reconstructed by
+ * re-encoding the entry as a length-delimited field.
+ *
+ * @{
+ */
+
+/** The report bundle file magic. */
+#define PLCRASH_REPORT_BUNDLE_MAGIC "plcrbnd"
+
+/** The report bundle format version. */
+#define PLCRASH_REPORT_BUNDLE_VERSION 1
+
+/** The file extension used for report bundles. */
+#define PLCRASH_REPORT_BUNDLE_EXTENSION "plbundle"
+
+/**
+ * @internal
+ *
+ * The report bundle file header.
+ */
+typedef struct plcrash_report_bundle_header {
+    /** File magic; see PLCRASH_REPORT_BUNDLE_MAGIC. Not NUL terminated. */
+    char magic[7];
+
+    /** File version; see PLCRASH_REPORT_BUNDLE_VERSION. */
+    uint8_t version;
+} plcrash_report_bundle_header_t;
+
+/**
+ * @internal
+ *
+ * The location of a compressed bundle section.
+ */
+typedef struct plcrash_report_bundle_section {
+    /** The section's offset from the start of the bundle. */
+    uint64_t offset;
+
+    /** The section's compressed length, in bytes. */
+    uint64_t length;
+} plcrash_report_bundle_section_t;
+
+/**
+ * @internal
+ *
+ * The report bundle footer, written at the end of the bundle.
+ */
+typedef struct plcrash_report_bundle_footer {
+    /** The shared table section. */
+    plcrash_report_bundle_section_t tables;
+
+    /** The offset of the report index. */
+    uint64_t index_offset;
+
+    /** The number of reports in the bundle. */
+    uint32_t count;
+
+    /** The number of entries in the shared image table. */
+    uint32_t image_count;
+
+    /** The number of entries in the shared string table. */
+    uint32_t string_count;
+
+    /** Reserved; must be zero. */
+    uint32_t reserved;
+
+    /** File magic; see PLCRASH_REPORT_BUNDLE_MAGIC. Not NUL terminated. */
+    char magic[7];
+
+    /** File version; see PLCRASH_REPORT_BUNDLE_VERSION. */
+    uint8_t version;
+} plcrash_report_bundle_footer_t;
+
+/**
+ * @internal
+ *
+ * Report recipe record types.
+ */
+typedef enum {
+    /** Literal report data; the record is followed by @a value bytes of data. */
+    PLCRASH_REPORT_BUNDLE_OP_LITERAL = 0,
+
+    /** A CrashReport.binary_images entry, stored in the shared image table. */
+    PLCRASH_REPORT_BUNDLE_OP_IMAGE = 1,
+
+    /** A CrashReport.symbol_names entry, stored in the shared string table. */
+    PLCRASH_REPORT_BUNDLE_OP_STRING = 2
+} plcrash_report_bundle_op_type_t;
+
+/**
+ * @internal
+ *
+ * A single report recipe record.
+ */
+typedef struct plcrash_report_bundle_op {
+    /** The record type; one of plcrash_report_bundle_op_type_t. */
+    uint32_t type;
+
+    /** The literal length, or the referenced table index. */
+    uint32_t value;
+} plcrash_report_bundle_op_t;
+
+/**
+ * @internal
+ *
+ * A memory-mapped report bundle.
+ */
+typedef struct plcrash_report_bundle {
+    /** The mapped bundle file. */
+    const void *mapping;
+
+    /** The size of @a mapping. */
+    size_t mapping_size;
+
+    /** The bundle footer. */
+    const plcrash_report_bundle_footer_t *footer;
+
+    /** The report index. */
+    const plcrash_report_bundle_section_t *index;
+
+    /** The number of reports in the bundle. */
+    uint32_t count;
+
+    /** The decompressed shared table section. */
+    uint8_t *tables;
+
+    /** Pointers to each table entry's data within @a tables; image entries are followed by string entries. */
+    const uint8_t **entries;
+
+    /** The length of each table entry. */
+    uint32_t *entry_lengths;
+} plcrash_report_bundle_t;
+
+plcrash_error_t plcrash_nasync_report_bundle_write (const char *path, const void * const *reports, const size_t *lengths, uint32_t count);
+
+plcrash_error_t plcrash_nasync_report_bundle_open (plcrash_report_bundle_t *bundle, const char *path);
+plcrash_error_t plcrash_nasync_report_bundle_read (plcrash_report_bundle_t *bundle, uint32_t index, uint8_t **report, size_t *length);
+void plcrash_nasync_report_bundle_close (plcrash_report_bundle_t *bundle);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_REPORT_BUNDLE_FILE_H */
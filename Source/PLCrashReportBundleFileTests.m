@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReportBundleFile.h"
+#import "PLCrashReporter.h"
+#import "PLCrashReport.h"
+#import "PLCrashReportBundle.h"
+
+@interface PLCrashReportBundleFileTests : SenTestCase {
+@private
+    /** Bundle path. */
+    NSString *_path;
+}
+@end
+
+@implementation PLCrashReportBundleFileTests
+
+- (void) setUp {
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _path error: NULL];
+    [_path release];
+}
+
+/* Append a length-delimited protobuf field to @a report */
+static void append_field (NSMutableData *report, uint32_t field_id, const char *value) {
+    uint8_t prefix[2] = { (uint8_t) ((field_id << 3) | 2), (uint8_t) strlen(value) };
+    [report appendBytes: prefix length: sizeof(prefix)];
+    [report appendBytes: value length: strlen(value)];
+}
+
+/* Build a minimal report containing the given image and symbol name entries */
+static NSData *make_report (const char *image, const char *symbol) {
+    NSMutableData *report = [NSMutableData dataWithBytes: "plcrash\1" length: 8];
+    append_field(report, 1, "system info");
+    append_field(report, 4, image);
+    append_field(report, 4, "shared image");
+    append_field(report, 10, symbol);
+    append_field(report, 10, "main");
+    return report;
+}
+
+/**
+ * Write @a reports to the test bundle path via the C API.
+ */
+- (plcrash_error_t) writeReports: (NSArray *) reports {
+    const void *bytes[[reports count]];
+    size_t lengths[[reports count]];
+
+    for (NSUInteger i = 0; i < [reports count]; i++) {
+        bytes[i] = [[reports objectAtIndex: i] bytes];
+        lengths[i] = [[reports objectAtIndex: i] length];
+    }
+
+    return plcrash_nasync_report_bundle_write([_path fileSystemRepresentation], bytes, lengths, (uint32_t) [reports count]);
+}
+
+/**
+ * Verify that bundled reports are reconstructed exactly, in any order, and that shared entries are stored once.
+ */
+- (void) testRoundTrip {
+    NSArray *reports = [NSArray arrayWithObjects: make_report("image a", "-[Foo bar]"), make_report("image b", "-[Foo bar]"), make_report("image a", "-[Foo baz]"), nil];
+    STAssertEquals([self writeReports: reports], PLCRASH_ESUCCESS, @"Failed to write bundle");
+
+    plcrash_report_bundle_t bundle;
+    STAssertEquals(plcrash_nasync_report_bundle_open(&bundle, [_path fileSystemRepresentation]), PLCRASH_ESUCCESS, @"Failed to open bundle");
+    STAssertEquals(bundle.count, (uint32_t) 3, @"Incorrect report count");
+    STAssertEquals(bundle.footer->image_count, (uint32_t) 3, @"Shared images were not deduplicated");
+    STAssertEquals(bundle.footer->string_count, (uint32_t) 3, @"Shared symbol names were not deduplicated");
+
+    for (uint32_t i = 3; i > 0; i--) {
+        uint8_t *report;
+        size_t length;
+
+        STAssertEquals(plcrash_nasync_report_bundle_read(&bundle, i - 1, &report, &length), PLCRASH_ESUCCESS, @"Failed to read report");
+        NSData *data = [NSData dataWithBytesNoCopy: report length: length freeWhenDone: YES];
+        STAssertEqualObjects(data, [reports objectAtIndex: i - 1], @"Report %u was not reconstructed exactly", i - 1);
+    }
+
+    uint8_t *report;
+    size_t length;
+    STAssertEquals(plcrash_nasync_report_bundle_read(&bundle, 3, &report, &length), PLCRASH_ENOTFOUND, @"Read beyond the last report");
+
+    plcrash_nasync_report_bundle_close(&bundle);
+}
+
+/**
+ * Verify that trailing data that can not be parsed, such as a truncated field, is preserved.
+ */
+- (void) testTruncatedReport {
+    NSMutableData *truncated = [[make_report("image a", "main") mutableCopy] autorelease];
+    [truncated appendBytes: "\x22\x7f" "partial" length: 9];
+
+    STAssertEquals([self writeReports: [NSArray arrayWithObject: truncated]], PLCRASH_ESUCCESS, @"Failed to write bundle");
+
+    plcrash_report_bundle_t bundle;
+    uint8_t *report;
+    size_t length;
+    STAssertEquals(plcrash_nasync_report_bundle_open(&bundle, [_path fileSystemRepresentation]), PLCRASH_ESUCCESS, @"Failed to open bundle");
+    STAssertEquals(plcrash_nasync_report_bundle_read(&bundle, 0, &report, &length), PLCRASH_ESUCCESS, @"Failed to read report");
+    STAssertEqualObjects([NSData dataWithBytesNoCopy: report length: length freeWhenDone: YES], truncated, @"Report was not reconstructed exactly");
+    plcrash_nasync_report_bundle_close(&bundle);
+}
+
+/**
+ * Verify that invalid reports and bundles are rejected.
+ */
+- (void) testInvalid {
+    NSData *invalid = [NSData dataWithBytes: "not a report" length: 12];
+    STAssertEquals([self writeReports: [NSArray arrayWithObject: invalid]], PLCRASH_EINVAL, @"Invalid report was bundled");
+    STAssertFalse([[NSFileManager defaultManager] fileExistsAtPath: _path], @"Bundle was written for an invalid report");
+
+    STAssertEquals([self writeReports: [NSArray arrayWithObject: make_report("image", "main")]], PLCRASH_ESUCCESS, @"Failed to write bundle");
+
+    NSMutableData *data = [NSMutableData dataWithContentsOfFile: _path];
+    [data setLength: [data length] - 1];
+    STAssertTrue([data writeToFile: _path atomically: YES], @"Failed to write truncated bundle");
+
+    plcrash_report_bundle_t bundle;
+    STAssertEquals(plcrash_nasync_report_bundle_open(&bundle, [_path fileSystemRepresentation]), PLCRASH_EINVAL, @"Truncated bundle was opened");
+}
+
+/**
+ * Verify that live reports may be bundled and decoded via the public API.
+ */
+- (void) testBundleLiveReports {
+    NSError *error;
+    NSMutableArray *reports = [NSMutableArray array];
+    for (int i = 0; i < 2; i++) {
+        NSData *data = [[PLCrashReporter sharedReporter] generateLiveReportAndReturnError: &error];
+        STAssertNotNil(data, @"Failed to generate live report: %@", error);
+        [reports addObject: data];
+    }
+
+    STAssertTrue([PLCrashReportBundle writeBundleWithReports: reports toFile: _path error: &error], @"Failed to write bundle: %@", error);
+
+    PLCrashReportBundle *bundle = [[[PLCrashReportBundle alloc] initWithContentsOfFile: _path error: &error] autorelease];
+    STAssertNotNil(bundle, @"Failed to open bundle: %@", error);
+    STAssertEquals([bundle reportCount], (NSUInteger) 2, @"Incorrect report count");
+
+    NSData *data = [bundle reportDataAtIndex: 1 error: &error];
+    STAssertNotNil(data, @"Failed to extract report: %@", error);
+
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
+    STAssertNotNil(report, @"Failed to decode bundled report: %@", error);
+    STAssertTrue([report.images count] > 0, @"Bundled report is missing binary images");
+
+    STAssertNil([bundle reportDataAtIndex: 2 error: NULL], @"Extracted a report beyond the last report");
+}
+
+@end
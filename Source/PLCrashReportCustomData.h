@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PLCrashReportCustomData : NSObject {
+@private
+    /** The region identifier. */
+    NSString *_identifier;
+
+    /** The region's contents. */
+    NSData *_data;
+
+    /** YES if the region was registered with a version counter. */
+    BOOL _hasVersion;
+
+    /** The region's version counter value. */
+    uint32_t _version;
+
+    /** YES if the region was modified while it was written. */
+    BOOL _torn;
+}
+
+- (id) initWithIdentifier: (NSString *) identifier
+                     data: (NSData *) data
+               hasVersion: (BOOL) hasVersion
+                  version: (uint32_t) version
+                     torn: (BOOL) torn;
+
+/** The application-assigned region identifier. */
+@property(nonatomic, readonly) NSString *identifier;
+
+/** The region's contents, as read at the time the report was written. */
+@property(nonatomic, readonly) NSData *data;
+
+/** YES if the region was registered with a version counter. If NO, the version and torn properties are undefined. */
+@property(nonatomic, readonly) BOOL hasVersion;
+
+/** The value of the region's version counter prior to the region being written. */
+@property(nonatomic, readonly) uint32_t version;
+
+/** YES if the region was being modified while it was written, in which case its contents may be inconsistent. */
+@property(nonatomic, readonly, getter=isTorn) BOOL torn;
+
+@end
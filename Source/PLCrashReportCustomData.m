@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportCustomData.h"
+
+/**
+ * An application-registered custom data region.
+ *
+ * Custom data regions are registered via
+ * PLCrashReporter::registerCustomDataWithIdentifier:bytes:length:version:handle:error:; the contents of each
+ * registered region are included in each report.
+ */
+@implementation PLCrashReportCustomData
+
+@synthesize identifier = _identifier;
+@synthesize data = _data;
+@synthesize hasVersion = _hasVersion;
+@synthesize version = _version;
+@synthesize torn = _torn;
+
+/**
+ * Initialize a new custom data object.
+ *
+ * @param identifier The region identifier.
+ * @param data The region's contents.
+ * @param hasVersion YES if the region was registered with a version counter.
+ * @param version The region's version counter value.
+ * @param torn YES if the region was modified while it was written.
+ */
+- (id) initWithIdentifier: (NSString *) identifier
+                     data: (NSData *) data
+               hasVersion: (BOOL) hasVersion
+                  version: (uint32_t) version
+                     torn: (BOOL) torn
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _identifier = [identifier retain];
+    _data = [data retain];
+    _hasVersion = hasVersion;
+    _version = version;
+    _torn = torn;
+
+    return self;
+}
+
+- (void) dealloc {
+    [_identifier release];
+    [_data release];
+    [super dealloc];
+}
+
+@end
@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_REPORT_FIELD_IDS_H
+#define PLCRASH_REPORT_FIELD_IDS_H
+
+/*
+ * Protobuf field identifiers and enum values shared by the report writers and the async-safe report readers.
+ * These must match the message definitions in the Resources directory.
+ */
+
+/**
+ * @internal
+ * Protobuf field identifiers, as defined in crash_report.proto.
+ */
+enum {
+    /** CrashReport.system_info */
+    PLCRASH_PROTO_SYSTEM_INFO_ID = 1,
+
+    /** CrashReport.system_info.operating_system */
+    PLCRASH_PROTO_SYSTEM_INFO_OS_ID = 1,
+
+    /** CrashReport.system_info.os_version */
+    PLCRASH_PROTO_SYSTEM_INFO_OS_VERSION_ID = 2,
+
+    /** CrashReport.system_info.architecture */
+    PLCRASH_PROTO_SYSTEM_INFO_ARCHITECTURE_TYPE_ID = 3,
+
+    /** CrashReport.system_info.timestamp */
+    PLCRASH_PROTO_SYSTEM_INFO_TIMESTAMP_ID = 4,
+
+    /** CrashReport.system_info.os_build */
+    PLCRASH_PROTO_SYSTEM_INFO_OS_BUILD_ID = 5,
+
+    /** CrashReport.app_info */
+    PLCRASH_PROTO_APP_INFO_ID = 2,
+    
+    /** CrashReport.app_info.app_identifier */
+    PLCRASH_PROTO_APP_INFO_APP_IDENTIFIER_ID = 1,
+    
+    /** CrashReport.app_info.app_version */
+    PLCRASH_PROTO_APP_INFO_APP_VERSION_ID = 2,
+
+
+    /** CrashReport.symbol.name */
+    PLCRASH_PROTO_SYMBOL_NAME = 1,
+
+    /** CrashReport.symbol.start_address */
+    PLCRASH_PROTO_SYMBOL_START_ADDRESS = 2,
+    
+    /** CrashReport.symbol.end_address */
+    PLCRASH_PROTO_SYMBOL_END_ADDRESS = 3,
+
+    /** CrashReport.symbol.name_index */
+    PLCRASH_PROTO_SYMBOL_NAME_INDEX = 4,
+
+
+    /** CrashReport.threads */
+    PLCRASH_PROTO_THREADS_ID = 3,
+    
+
+    /** CrashReports.thread.thread_number */
+    PLCRASH_PROTO_THREAD_THREAD_NUMBER_ID = 1,
+
+    /** CrashReports.thread.frames */
+    PLCRASH_PROTO_THREAD_FRAMES_ID = 2,
+
+    /** CrashReport.thread.crashed */
+    PLCRASH_PROTO_THREAD_CRASHED_ID = 3,
+
+
+    /** CrashReport.thread.frame.pc */
+    PLCRASH_PROTO_THREAD_FRAME_PC_ID = 3,
+    
+    /** CrashReport.thread.frame.symbol */
+    PLCRASH_PROTO_THREAD_FRAME_SYMBOL_ID = 6,
+
+    /** CrashReport.thread.frame.repeat_count */
+    PLCRASH_PROTO_THREAD_FRAME_REPEAT_COUNT_ID = 7,
+
+    /** CrashReport.thread.frame.repeat_length */
+    PLCRASH_PROTO_THREAD_FRAME_REPEAT_LENGTH_ID = 8,
+
+    /** CrashReport.thread.frame.omitted_frame_count */
+    PLCRASH_PROTO_THREAD_FRAME_OMITTED_FRAME_COUNT_ID = 9,
+
+
+    /** CrashReport.thread.registers */
+    PLCRASH_PROTO_THREAD_REGISTERS_ID = 4,
+
+    /** CrashReport.thread.register.name */
+    PLCRASH_PROTO_THREAD_REGISTER_NAME_ID = 1,
+
+    /** CrashReport.thread.register.name */
+    PLCRASH_PROTO_THREAD_REGISTER_VALUE_ID = 2,
+
+    /** CrashReport.thread.register_values */
+    PLCRASH_PROTO_THREAD_REGISTER_VALUES_ID = 5,
+
+    /** CrashReport.thread.frame_pcs */
+    PLCRASH_PROTO_THREAD_FRAME_PCS_ID = 6,
+
+    /** CrashReport.thread.duplicate_of_thread */
+    PLCRASH_PROTO_THREAD_DUPLICATE_OF_THREAD_ID = 7,
+
+    /** CrashReport.thread.also_crashed */
+    PLCRASH_PROTO_THREAD_ALSO_CRASHED_ID = 8,
+
+    /** CrashReport.thread.name */
+    PLCRASH_PROTO_THREAD_NAME_ID = 9,
+
+
+    /** CrashReport.images */
+    PLCRASH_PROTO_BINARY_IMAGES_ID = 4,
+
+    /** CrashReport.BinaryImage.base_address */
+    PLCRASH_PROTO_BINARY_IMAGE_ADDR_ID = 1,
+
+    /** CrashReport.BinaryImage.size */
+    PLCRASH_PROTO_BINARY_IMAGE_SIZE_ID = 2,
+
+    /** CrashReport.BinaryImage.name */
+    PLCRASH_PROTO_BINARY_IMAGE_NAME_ID = 3,
+    
+    /** CrashReport.BinaryImage.uuid */
+    PLCRASH_PROTO_BINARY_IMAGE_UUID_ID = 4,
+
+    /** CrashReport.BinaryImage.code_type */
+    PLCRASH_PROTO_BINARY_IMAGE_CODE_TYPE_ID = 5,
+
+    
+    /** CrashReport.exception */
+    PLCRASH_PROTO_EXCEPTION_ID = 5,
+
+    /** CrashReport.exception.name */
+    PLCRASH_PROTO_EXCEPTION_NAME_ID = 1,
+    
+    /** CrashReport.exception.reason */
+    PLCRASH_PROTO_EXCEPTION_REASON_ID = 2,
+    
+    /** CrashReports.exception.frames */
+    PLCRASH_PROTO_EXCEPTION_FRAMES_ID = 3,
+
+    /** CrashReports.exception.user_info */
+    PLCRASH_PROTO_EXCEPTION_USER_INFO_ID = 4,
+
+
+    /** CrashReport.exception.user_info.key */
+    PLCRASH_PROTO_EXCEPTION_USERINFO_KEY_ID = 1,
+
+    /** CrashReport.exception.user_info.serialized */
+    PLCRASH_PROTO_EXCEPTION_USERINFO_SERIALIZED_ID = 2,
+
+    /** CrashReport.exception.user_info.archive */
+    PLCRASH_PROTO_EXCEPTION_USERINFO_ARCHIVE_ID = 3,
+
+
+    /** CrashReport.signal */
+    PLCRASH_PROTO_SIGNAL_ID = 6,
+
+    /** CrashReport.signal.name */
+    PLCRASH_PROTO_SIGNAL_NAME_ID = 1,
+
+    /** CrashReport.signal.code */
+    PLCRASH_PROTO_SIGNAL_CODE_ID = 2,
+    
+    /** CrashReport.signal.address */
+    PLCRASH_PROTO_SIGNAL_ADDRESS_ID = 3,
+    
+    /** CrashReport.signal.mach_exception */
+    PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_ID = 4,
+    
+    
+    /** CrashReport.signal.mach_exception.type */
+    PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_TYPE_ID = 1,
+    
+    /** CrashReport.signal.mach_exception.codes */
+    PLCRASH_PROTO_SIGNAL_MACH_EXCEPTION_CODES_ID = 2,
+
+
+    /** CrashReport.process_info */
+    PLCRASH_PROTO_PROCESS_INFO_ID = 7,
+    
+    /** CrashReport.process_info.process_name */
+    PLCRASH_PROTO_PROCESS_INFO_PROCESS_NAME_ID = 1,
+    
+    /** CrashReport.process_info.process_id */
+    PLCRASH_PROTO_PROCESS_INFO_PROCESS_ID_ID = 2,
+    
+    /** CrashReport.process_info.process_path */
+    PLCRASH_PROTO_PROCESS_INFO_PROCESS_PATH_ID = 3,
+    
+    /** CrashReport.process_info.parent_process_name */
+    PLCRASH_PROTO_PROCESS_INFO_PARENT_PROCESS_NAME_ID = 4,
+    
+    /** CrashReport.process_info.parent_process_id */
+    PLCRASH_PROTO_PROCESS_INFO_PARENT_PROCESS_ID_ID = 5,
+    
+    /** CrashReport.process_info.native */
+    PLCRASH_PROTO_PROCESS_INFO_NATIVE_ID = 6,
+    
+    /** CrashReport.process_info.start_time */
+    PLCRASH_PROTO_PROCESS_INFO_START_TIME_ID = 7,
+
+    
+    /** CrashReport.Processor.encoding */
+    PLCRASH_PROTO_PROCESSOR_ENCODING_ID = 1,
+    
+    /** CrashReport.Processor.encoding */
+    PLCRASH_PROTO_PROCESSOR_TYPE_ID = 2,
+    
+    /** CrashReport.Processor.encoding */
+    PLCRASH_PROTO_PROCESSOR_SUBTYPE_ID = 3,
+
+
+    /** CrashReport.machine_info */
+    PLCRASH_PROTO_MACHINE_INFO_ID = 8,
+
+    /** CrashReport.machine_info.model */
+    PLCRASH_PROTO_MACHINE_INFO_MODEL_ID = 1,
+
+    /** CrashReport.machine_info.processor */
+    PLCRASH_PROTO_MACHINE_INFO_PROCESSOR_ID = 2,
+
+    /** CrashReport.machine_info.processor_count */
+    PLCRASH_PROTO_MACHINE_INFO_PROCESSOR_COUNT_ID = 3,
+
+    /** CrashReport.machine_info.logical_processor_count */
+    PLCRASH_PROTO_MACHINE_INFO_LOGICAL_PROCESSOR_COUNT_ID = 4,
+
+
+    /** CrashReport.report_info */
+    PLCRASH_PROTO_REPORT_INFO_ID = 9,
+
+    /** CrashReport.symbol_names */
+    PLCRASH_PROTO_SYMBOL_NAMES_ID = 10,
+
+    /** CrashReport.instrumentation */
+    PLCRASH_PROTO_INSTRUMENTATION_ID = 11,
+
+    /** CrashReport.instrumentation.thread_suspend_time */
+    PLCRASH_PROTO_INSTRUMENTATION_THREAD_SUSPEND_TIME_ID = 1,
+
+    /** CrashReport.instrumentation.unwind_time */
+    PLCRASH_PROTO_INSTRUMENTATION_UNWIND_TIME_ID = 2,
+
+    /** CrashReport.instrumentation.symtab_lookup_time */
+    PLCRASH_PROTO_INSTRUMENTATION_SYMTAB_LOOKUP_TIME_ID = 3,
+
+    /** CrashReport.instrumentation.objc_lookup_time */
+    PLCRASH_PROTO_INSTRUMENTATION_OBJC_LOOKUP_TIME_ID = 4,
+
+    /** CrashReport.instrumentation.image_write_time */
+    PLCRASH_PROTO_INSTRUMENTATION_IMAGE_WRITE_TIME_ID = 5,
+
+    /** CrashReport.instrumentation.output_time */
+    PLCRASH_PROTO_INSTRUMENTATION_OUTPUT_TIME_ID = 6,
+
+    /** CrashReport.instrumentation.output_count */
+    PLCRASH_PROTO_INSTRUMENTATION_OUTPUT_COUNT_ID = 7,
+
+    /** CrashReport.instrumentation.mobject_count */
+    PLCRASH_PROTO_INSTRUMENTATION_MOBJECT_COUNT_ID = 8,
+
+    /** CrashReport.instrumentation.vm_read_count */
+    PLCRASH_PROTO_INSTRUMENTATION_VM_READ_COUNT_ID = 9,
+
+    /** CrashReport.instrumentation.allocator_high_water_mark */
+    PLCRASH_PROTO_INSTRUMENTATION_ALLOCATOR_HIGH_WATER_MARK_ID = 10,
+
+    /** CrashReport.instrumentation.signal_stack_size */
+    PLCRASH_PROTO_INSTRUMENTATION_SIGNAL_STACK_SIZE_ID = 11,
+
+    /** CrashReport.instrumentation.signal_stack_high_water_mark */
+    PLCRASH_PROTO_INSTRUMENTATION_SIGNAL_STACK_HIGH_WATER_MARK_ID = 12,
+
+    /** CrashReport.trace_events */
+    PLCRASH_PROTO_TRACE_EVENTS_ID = 12,
+
+    /** CrashReport.trace_events.sequence */
+    PLCRASH_PROTO_TRACE_EVENT_SEQUENCE_ID = 1,
+
+    /** CrashReport.trace_events.event */
+    PLCRASH_PROTO_TRACE_EVENT_EVENT_ID = 2,
+
+    /** CrashReport.trace_events.args */
+    PLCRASH_PROTO_TRACE_EVENT_ARGS_ID = 3,
+
+    /** CrashReport.register_set */
+    PLCRASH_PROTO_REGISTER_SET_ID = 13,
+
+    /** CrashReport.stack_memory */
+    PLCRASH_PROTO_STACK_MEMORY_ID = 14,
+
+    /** CrashReport.stack_memory.thread_number */
+    PLCRASH_PROTO_STACK_MEMORY_THREAD_NUMBER_ID = 1,
+
+    /** CrashReport.stack_memory.address */
+    PLCRASH_PROTO_STACK_MEMORY_ADDRESS_ID = 2,
+
+    /** CrashReport.stack_memory.length */
+    PLCRASH_PROTO_STACK_MEMORY_LENGTH_ID = 3,
+
+    /** CrashReport.stack_memory.chunks */
+    PLCRASH_PROTO_STACK_MEMORY_CHUNKS_ID = 4,
+
+    /** CrashReport.stack_memory.chunks.offset */
+    PLCRASH_PROTO_STACK_MEMORY_CHUNK_OFFSET_ID = 1,
+
+    /** CrashReport.stack_memory.chunks.data */
+    PLCRASH_PROTO_STACK_MEMORY_CHUNK_DATA_ID = 2,
+
+    /** CrashReport.register_memory */
+    PLCRASH_PROTO_REGISTER_MEMORY_ID = 15,
+
+    /** CrashReport.register_memory.thread_number */
+    PLCRASH_PROTO_REGISTER_MEMORY_THREAD_NUMBER_ID = 1,
+
+    /** CrashReport.register_memory.address */
+    PLCRASH_PROTO_REGISTER_MEMORY_ADDRESS_ID = 2,
+
+    /** CrashReport.register_memory.data */
+    PLCRASH_PROTO_REGISTER_MEMORY_DATA_ID = 3,
+
+    /** CrashReport.truncation */
+    PLCRASH_PROTO_TRUNCATION_ID = 16,
+
+    /** CrashReport.truncation.elided_thread_count */
+    PLCRASH_PROTO_TRUNCATION_ELIDED_THREAD_COUNT_ID = 1,
+
+    /** CrashReport.truncation.elided_image_count */
+    PLCRASH_PROTO_TRUNCATION_ELIDED_IMAGE_COUNT_ID = 2,
+
+    /** CrashReport.truncation.deadline_expired */
+    PLCRASH_PROTO_TRUNCATION_DEADLINE_EXPIRED_ID = 3,
+
+    /** CrashReport.breadcrumbs */
+    PLCRASH_PROTO_BREADCRUMBS_ID = 17,
+
+    /** CrashReport.breadcrumbs.sequence */
+    PLCRASH_PROTO_BREADCRUMB_SEQUENCE_ID = 1,
+
+    /** CrashReport.breadcrumbs.data */
+    PLCRASH_PROTO_BREADCRUMB_DATA_ID = 2,
+
+    /** CrashReport.custom_data */
+    PLCRASH_PROTO_CUSTOM_DATA_ID = 18,
+
+    /** CrashReport.custom_data.identifier */
+    PLCRASH_PROTO_CUSTOM_DATA_IDENTIFIER_ID = 1,
+
+    /** CrashReport.custom_data.data */
+    PLCRASH_PROTO_CUSTOM_DATA_DATA_ID = 2,
+
+    /** CrashReport.custom_data.version */
+    PLCRASH_PROTO_CUSTOM_DATA_VERSION_ID = 3,
+
+    /** CrashReport.custom_data.torn */
+    PLCRASH_PROTO_CUSTOM_DATA_TORN_ID = 4,
+
+    /** CrashReport.image_manifest */
+    PLCRASH_PROTO_IMAGE_MANIFEST_ID = 19,
+
+    /** CrashReport.image_manifest.identifier */
+    PLCRASH_PROTO_IMAGE_MANIFEST_IDENTIFIER_ID = 1,
+
+    /** CrashReport.image_manifest.removed_images */
+    PLCRASH_PROTO_IMAGE_MANIFEST_REMOVED_IMAGES_ID = 2,
+
+    /** CrashReport.vm_region_summary */
+    PLCRASH_PROTO_VM_REGION_SUMMARY_ID = 20,
+
+    /** CrashReport.vm_region_summary.regions */
+    PLCRASH_PROTO_VM_REGION_SUMMARY_REGIONS_ID = 1,
+
+    /** CrashReport.vm_region_summary.region_count */
+    PLCRASH_PROTO_VM_REGION_SUMMARY_REGION_COUNT_ID = 2,
+
+    /** CrashReport.vm_region_summary.truncated */
+    PLCRASH_PROTO_VM_REGION_SUMMARY_TRUNCATED_ID = 3,
+
+    /** CrashReport.integrity */
+    PLCRASH_PROTO_INTEGRITY_ID = 21,
+
+    /** CrashReport.integrity.length */
+    PLCRASH_PROTO_INTEGRITY_LENGTH_ID = 1,
+
+    /** CrashReport.integrity.checksum */
+    PLCRASH_PROTO_INTEGRITY_CHECKSUM_ID = 2,
+    
+    /** CrashReport.report_info.crashed */
+    PLCRASH_PROTO_REPORT_INFO_USER_REQUESTED_ID = 1,
+
+    /** CrashReport.report_info.uuid */
+    PLCRASH_PROTO_REPORT_INFO_UUID_ID = 2,
+
+    /** CrashReport.report_info.thread_suspend_duration */
+    PLCRASH_PROTO_REPORT_INFO_THREAD_SUSPEND_DURATION_ID = 3,
+};
+
+/**
+ * @internal
+ * CrashReport.RegisterSet values.
+ */
+enum {
+    /** 32-bit x86 registers, numbered as per plcrash_x86_regnum_t. */
+    PLCRASH_PROTO_REGISTER_SET_X86_32 = 1,
+
+    /** 64-bit x86 registers, numbered as per plcrash_x86_regnum_t. */
+    PLCRASH_PROTO_REGISTER_SET_X86_64 = 2,
+
+    /** ARM registers, numbered as per plcrash_arm_regnum_t. */
+    PLCRASH_PROTO_REGISTER_SET_ARM = 3,
+};
+
+/**
+ * @internal
+ * Protobuf field identifiers, as defined in profile_report.proto.
+ */
+enum {
+    /** HangReport.duration */
+    PLCRASH_PROTO_HANG_DURATION_ID = 1,
+
+    /** HangReport.threshold */
+    PLCRASH_PROTO_HANG_THRESHOLD_ID = 2,
+
+    /** HangReport.samples */
+    PLCRASH_PROTO_HANG_SAMPLES_ID = 3,
+
+    /** HangReport.binary_images. Must match CrashReport.binary_images, allowing pre-encoded images to be reused. */
+    PLCRASH_PROTO_HANG_BINARY_IMAGES_ID = 4,
+
+    /** HangReport.timestamp */
+    PLCRASH_PROTO_HANG_TIMESTAMP_ID = 5,
+
+    /** HangReport.Sample.pc */
+    PLCRASH_PROTO_HANG_SAMPLE_PC_ID = 1,
+
+    /** HangReport.Sample.offset */
+    PLCRASH_PROTO_HANG_SAMPLE_OFFSET_ID = 2,
+};
+
+/**
+ * @internal
+ * Protobuf field identifiers, as defined in profile_report.proto.
+ */
+enum {
+    /** ProfileReport.interval */
+    PLCRASH_PROTO_PROFILE_INTERVAL_ID = 1,
+
+    /** ProfileReport.sample_count */
+    PLCRASH_PROTO_PROFILE_SAMPLE_COUNT_ID = 2,
+
+    /** ProfileReport.stacks */
+    PLCRASH_PROTO_PROFILE_STACKS_ID = 3,
+
+    /** ProfileReport.binary_images. Must match CrashReport.binary_images, allowing pre-encoded images to be reused. */
+    PLCRASH_PROTO_PROFILE_BINARY_IMAGES_ID = 4,
+
+    /** ProfileReport.dropped_count */
+    PLCRASH_PROTO_PROFILE_DROPPED_COUNT_ID = 5,
+
+    /** ProfileReport.Stack.pc */
+    PLCRASH_PROTO_PROFILE_STACK_PC_ID = 1,
+
+    /** ProfileReport.Stack.count */
+    PLCRASH_PROTO_PROFILE_STACK_COUNT_ID = 2,
+};
+
+/**
+ * @internal
+ * Protobuf field identifiers, as defined in symbolication_service.proto.
+ */
+enum {
+    /** SymbolicationRequest.operation */
+    PLCRASH_PROTO_REQUEST_OPERATION_ID = 1,
+
+    /** SymbolicationRequest.format */
+    PLCRASH_PROTO_REQUEST_FORMAT_ID = 2,
+
+    /** SymbolicationRequest.reports */
+    PLCRASH_PROTO_REQUEST_REPORTS_ID = 3,
+
+    /** SymbolicationResponse.results */
+    PLCRASH_PROTO_RESPONSE_RESULTS_ID = 1,
+
+    /** SymbolicationResponse.error */
+    PLCRASH_PROTO_RESPONSE_ERROR_ID = 2,
+
+    /** SymbolicationResponse.Result.output */
+    PLCRASH_PROTO_RESULT_OUTPUT_ID = 1,
+
+    /** SymbolicationResponse.Result.error */
+    PLCRASH_PROTO_RESULT_ERROR_ID = 2,
+};
+
+/**
+ * @internal
+ * SymbolicationRequest.Operation values.
+ */
+enum {
+    /** Symbolicate each report. */
+    PLCRASH_PROTO_OPERATION_SYMBOLICATE = 0,
+
+    /** Symbolicate and convert each report. */
+    PLCRASH_PROTO_OPERATION_CONVERT = 1,
+};
+
+#endif /* PLCRASH_REPORT_FIELD_IDS_H */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "PLCrashReportSystemInfo.h"
+#import "PLCrashReportApplicationInfo.h"
+
+@interface PLCrashReportHeader : NSObject {
+@private
+    /** System info */
+    PLCrashReportSystemInfo *_systemInfo;
+
+    /** Application info */
+    PLCrashReportApplicationInfo *_applicationInfo;
+
+    /** Report UUID, or NULL if unavailable. */
+    CFUUIDRef _uuid;
+
+    /** YES if the report was requested by the user, rather than generated by a crash. */
+    BOOL _userRequested;
+}
+
+- (id) initWithData: (NSData *) encodedData error: (NSError **) outError;
+- (id) initWithContentsOfFile: (NSString *) path error: (NSError **) outError;
+
+/**
+ * System information.
+ */
+@property(nonatomic, readonly) PLCrashReportSystemInfo *systemInfo;
+
+/**
+ * Application information.
+ */
+@property(nonatomic, readonly) PLCrashReportApplicationInfo *applicationInfo;
+
+/**
+ * The report's client-generated 16-byte UUID. If not available, will be NULL.
+ *
+ * @sa PLCrashReport::uuidRef
+ */
+@property(nonatomic, readonly) CFUUIDRef uuidRef;
+
+/**
+ * YES if the report was generated on request via PLCrashReporter::generateLiveReport, rather than in response
+ * to a crash.
+ */
+@property(nonatomic, readonly, getter=isUserRequested) BOOL userRequested;
+
+@end
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "CrashReporter.h"
+
+#import "PLCrashReportHeader.h"
+#import "PLCrashReporterNSError.h"
+#import "PLCrashAsyncCompressor.h"
+#import "PLCrashAsyncProtobufReader.h"
+#import "PLCrashReportFieldIDs.h"
+
+@interface PLCrashReportHeader (PrivateMethods)
+
+- (BOOL) readReport: (plcrash_async_pb_reader_t *) report error: (NSError **) outError;
+- (BOOL) readReportInfo: (plcrash_async_pb_reader_t) reportInfo error: (NSError **) outError;
+- (PLCrashReportSystemInfo *) readSystemInfo: (plcrash_async_pb_reader_t) systemInfo error: (NSError **) outError;
+- (PLCrashReportApplicationInfo *) readApplicationInfo: (plcrash_async_pb_reader_t) appInfo error: (NSError **) outError;
+
+@end
+
+/**
+ * Return the string value of a length-prefixed @a field, or nil if the field is not a valid UTF-8 string.
+ */
+static NSString *pb_string_value (const plcrash_async_pb_field_t *field) {
+    if (field->wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+        return nil;
+
+    return [[[NSString alloc] initWithBytes: field->data.p
+                                     length: plcrash_async_pb_reader_length(&field->data)
+                                   encoding: NSUTF8StringEncoding] autorelease];
+}
+
+/**
+ * Provides access to a crash report's report, system, and application information, without decoding
+ * the remainder of the report.
+ *
+ * The report's top-level records are read in order, and each record that is not required (including all thread
+ * and binary image records) is skipped by its encoded length without being examined. As PLCrashReporter writes the
+ * header records ahead of all others, reading stops once they have been found, and the cost of reading a report's
+ * header is proportional to the size of the header, rather than the report.
+ *
+ * This is suitable for inspecting large numbers of pending reports, eg, to decide whether a report should be
+ * submitted, without the cost of decoding each report via PLCrashReport.
+ */
+@implementation PLCrashReportHeader
+
+@synthesize systemInfo = _systemInfo;
+@synthesize applicationInfo = _applicationInfo;
+@synthesize uuidRef = _uuid;
+@synthesize userRequested = _userRequested;
+
+/**
+ * Initialize with the provided crash log data. On error, nil will be returned, and
+ * an NSError instance will be provided via @a error, if non-NULL.
+ *
+ * @param encodedData Encoded plcrash crash log.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the crash log could not be parsed. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @note Compressed reports must be decompressed in their entirety before their header may be read.
+ *
+ * @par Designated Initializer
+ * This method is the designated initializer for the PLCrashReportHeader class.
+ */
+- (id) initWithData: (NSData *) encodedData error: (NSError **) outError {
+    if ((self = [super init]) == nil) {
+        // This shouldn't happen, but we have to fufill our API contract
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not initialize superclass", nil);
+        return nil;
+    }
+
+    /* Transparently decompress compressed reports */
+    if (plcrash_async_compressor_is_compressed([encodedData bytes], [encodedData length])) {
+        uint8_t *decoded;
+        size_t decoded_length;
+
+        if (plcrash_nasync_compressor_decode([encodedData bytes], [encodedData length], &decoded, &decoded_length) != PLCRASH_ESUCCESS) {
+            plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decompress crash log",
+                                                                                                       @"Crash log decoding error message"), nil);
+            goto error;
+        }
+
+        encodedData = [NSData dataWithBytesNoCopy: decoded length: decoded_length freeWhenDone: YES];
+    }
+
+    /* Validate the file header */
+    plcrash_async_pb_reader_t report;
+    if (plcrash_async_pb_reader_init_report(&report, [encodedData bytes], [encodedData length]) != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode invalid crash log header",
+                                                                                                   @"Crash log decoding error message"), nil);
+        goto error;
+    }
+
+    const struct PLCrashReportFileHeader *header = [encodedData bytes];
+    if (header->version != PLCRASH_REPORT_FILE_VERSION && header->version != PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE &&
+        header->version != PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS && header->version != PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES &&
+        header->version != PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, [NSString stringWithFormat: NSLocalizedString(@"Could not decode unsupported crash report version: %d",
+                                                                                                                               @"Crash log decoding message"), header->version], nil);
+        goto error;
+    }
+
+    if (![self readReport: &report error: outError])
+        goto error;
+
+    return self;
+
+error:
+    [self release];
+    return nil;
+}
+
+/**
+ * Initialize with the crash log at @a path. The file is memory mapped, and only the pages containing the
+ * report's header are read. On error, nil will be returned, and an NSError instance will be provided
+ * via @a error, if non-NULL.
+ *
+ * @param path Path to an encoded plcrash crash log.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the crash log could not be read or parsed. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ */
+- (id) initWithContentsOfFile: (NSString *) path error: (NSError **) outError {
+    NSData *data = [[NSData alloc] initWithContentsOfFile: path options: NSDataReadingMappedAlways error: outError];
+    if (data == nil) {
+        [self release];
+        return nil;
+    }
+
+    /* All decoded values are copied */
+    self = [self initWithData: data error: outError];
+    [data release];
+
+    return self;
+}
+
+- (void) dealloc {
+    [_systemInfo release];
+    [_applicationInfo release];
+
+    if (_uuid != NULL)
+        CFRelease(_uuid);
+
+    [super dealloc];
+}
+
+@end
+
+
+/**
+ * @internal
+ * Private Methods
+ */
+@implementation PLCrashReportHeader (PrivateMethods)
+
+/**
+ * Read the header records from the top-level @a report message.
+ */
+- (BOOL) readReport: (plcrash_async_pb_reader_t *) report error: (NSError **) outError {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+
+    while (_systemInfo == nil || _applicationInfo == nil) {
+        if ((err = plcrash_async_pb_reader_next(report, &field)) != PLCRASH_ESUCCESS)
+            break;
+
+        /* All header records are messages; anything else is skipped */
+        if (field.wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+            continue;
+
+        switch (field.id) {
+            case PLCRASH_PROTO_REPORT_INFO_ID:
+                if (![self readReportInfo: field.data error: outError])
+                    return NO;
+                break;
+
+            case PLCRASH_PROTO_SYSTEM_INFO_ID:
+                [_systemInfo release];
+                _systemInfo = [[self readSystemInfo: field.data error: outError] retain];
+                if (_systemInfo == nil)
+                    return NO;
+                break;
+
+            case PLCRASH_PROTO_APP_INFO_ID:
+                [_applicationInfo release];
+                _applicationInfo = [[self readApplicationInfo: field.data error: outError] retain];
+                if (_applicationInfo == nil)
+                    return NO;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* Reading may only terminate early once the required records have been found */
+    if (_systemInfo == nil || _applicationInfo == nil) {
+        if (err == PLCRASH_EINVAL) {
+            plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"An unknown error occured decoding the crash report",
+                                                                                                       @"Crash log decoding error message"), nil);
+        } else if (_systemInfo == nil) {
+            plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid,
+                                   NSLocalizedString(@"Crash report is missing System Information section",
+                                                     @"Missing sysinfo in crash report"), nil);
+        } else {
+            plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid,
+                                   NSLocalizedString(@"Crash report is missing Application Information section",
+                                                     @"Missing app info in crash report"), nil);
+        }
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ * Read the report info record.
+ */
+- (BOOL) readReportInfo: (plcrash_async_pb_reader_t) reportInfo error: (NSError **) outError {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&reportInfo, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case PLCRASH_PROTO_REPORT_INFO_USER_REQUESTED_ID:
+                _userRequested = (field.value != 0);
+                break;
+
+            case PLCRASH_PROTO_REPORT_INFO_UUID_ID: {
+                /* Validate the UUID length */
+                if (field.wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED || plcrash_async_pb_reader_length(&field.data) != sizeof(uuid_t)) {
+                    plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, @"Report UUID value is not a standard 16 bytes", nil);
+                    return NO;
+                }
+
+                CFUUIDBytes uuid_bytes;
+                memcpy(&uuid_bytes, field.data.p, sizeof(uuid_bytes));
+
+                if (_uuid != NULL)
+                    CFRelease(_uuid);
+                _uuid = CFUUIDCreateFromUUIDBytes(NULL, uuid_bytes);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    if (err != PLCRASH_ENOTFOUND) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"An unknown error occured decoding the crash report",
+                                                                                                   @"Crash log decoding error message"), nil);
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ * Read the system info record. Returns nil on error.
+ */
+- (PLCrashReportSystemInfo *) readSystemInfo: (plcrash_async_pb_reader_t) systemInfo error: (NSError **) outError {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    PLCrashReportOperatingSystem os = 0;
+    PLCrashReportArchitecture architecture = 0;
+    NSString *osVersion = nil;
+    NSString *osBuild = nil;
+    NSDate *timestamp = nil;
+
+    while ((err = plcrash_async_pb_reader_next(&systemInfo, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case PLCRASH_PROTO_SYSTEM_INFO_OS_ID:
+                os = (PLCrashReportOperatingSystem) field.value;
+                break;
+
+            case PLCRASH_PROTO_SYSTEM_INFO_OS_VERSION_ID:
+                osVersion = pb_string_value(&field);
+                break;
+
+            case PLCRASH_PROTO_SYSTEM_INFO_ARCHITECTURE_TYPE_ID:
+                architecture = (PLCrashReportArchitecture) field.value;
+                break;
+
+            case PLCRASH_PROTO_SYSTEM_INFO_TIMESTAMP_ID:
+                /* Set up the timestamp, if available */
+                if (field.value != 0)
+                    timestamp = [NSDate dateWithTimeIntervalSince1970: (int64_t) field.value];
+                break;
+
+            case PLCRASH_PROTO_SYSTEM_INFO_OS_BUILD_ID:
+                osBuild = pb_string_value(&field);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (err != PLCRASH_ENOTFOUND) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"An unknown error occured decoding the crash report",
+                                                                                                   @"Crash log decoding error message"), nil);
+        return nil;
+    }
+
+    if (osVersion == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid,
+                               NSLocalizedString(@"Crash report is missing System Information OS version field",
+                                                 @"Missing sysinfo operating system in crash report"), nil);
+        return nil;
+    }
+
+    return [[[PLCrashReportSystemInfo alloc] initWithOperatingSystem: os
+                                              operatingSystemVersion: osVersion
+                                                operatingSystemBuild: osBuild
+                                                        architecture: architecture
+                                                           timestamp: timestamp] autorelease];
+}
+
+/**
+ * Read the application info record. Returns nil on error.
+ */
+- (PLCrashReportApplicationInfo *) readApplicationInfo: (plcrash_async_pb_reader_t) appInfo error: (NSError **) outError {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    NSString *identifier = nil;
+    NSString *version = nil;
+
+    while ((err = plcrash_async_pb_reader_next(&appInfo, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case PLCRASH_PROTO_APP_INFO_APP_IDENTIFIER_ID:
+                identifier = pb_string_value(&field);
+                break;
+
+            case PLCRASH_PROTO_APP_INFO_APP_VERSION_ID:
+                version = pb_string_value(&field);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (err != PLCRASH_ENOTFOUND) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"An unknown error occured decoding the crash report",
+                                                                                                   @"Crash log decoding error message"), nil);
+        return nil;
+    }
+
+    /* Identifier available? */
+    if (identifier == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid,
+                               NSLocalizedString(@"Crash report is missing Application Information app identifier field",
+                                                 @"Missing app identifier in crash report"), nil);
+        return nil;
+    }
+
+    /* Version available? */
+    if (version == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid,
+                               NSLocalizedString(@"Crash report is missing Application Information app version field",
+                                                 @"Missing app version in crash report"), nil);
+        return nil;
+    }
+
+    return [[[PLCrashReportApplicationInfo alloc] initWithApplicationIdentifier: identifier
+                                                            applicationVersion: version] autorelease];
+}
+
+@end
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PLCrashReportInlinedFrameInfo : NSObject {
+@private
+    /** The inlined function's name, or nil if unknown. */
+    NSString *_symbolName;
+
+    /** The call site source file path, or nil if unknown. */
+    NSString *_callFile;
+
+    /** The call site source line number, or 0 if unknown. */
+    uint32_t _callLine;
+}
+
+- (id) initWithSymbolName: (NSString *) symbolName
+                 callFile: (NSString *) callFile
+                 callLine: (uint32_t) callLine;
+
+/** The inlined function's name, or nil if unknown. */
+@property(nonatomic, readonly) NSString *symbolName;
+
+/* The source file path of the call site at which the function was inlined.
+ *
+ * If unknown, the path will be nil.
+ */
+@property(nonatomic, readonly) NSString *callFile;
+
+/** The source line number of the call site at which the function was inlined, or 0 if unknown. */
+@property(nonatomic, readonly) uint32_t callLine;
+
+@end
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportInlinedFrameInfo.h"
+
+/**
+ * Crash log inlined function information.
+ *
+ * Describes a single function inlined at a stack frame's address, as found by offline symbolication using DWARF
+ * debugging information.
+ */
+@implementation PLCrashReportInlinedFrameInfo
+
+@synthesize symbolName = _symbolName;
+@synthesize callFile = _callFile;
+@synthesize callLine = _callLine;
+
+/**
+ * Initialize with the provided inlined function info.
+ *
+ * @param symbolName The inlined function's name, if available; otherwise, nil.
+ * @param callFile The source file path of the function's call site, if available; otherwise, nil.
+ * @param callLine The source line number of the function's call site, if available; otherwise, 0.
+ */
+- (id) initWithSymbolName: (NSString *) symbolName
+                 callFile: (NSString *) callFile
+                 callLine: (uint32_t) callLine
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _symbolName = [symbolName retain];
+    _callFile = [callFile retain];
+    _callLine = callFile != nil ? callLine : 0;
+
+    return self;
+}
+
+- (void) dealloc {
+    [_symbolName release];
+    [_callFile release];
+
+    [super dealloc];
+}
+
+@end
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PLCrashReportInstrumentationInfo : NSObject {
+@private
+    /** Time for which the process' threads were suspended, in nanoseconds. */
+    uint64_t _threadSuspendTime;
+
+    /** Time spent unwinding thread stacks, in nanoseconds. */
+    uint64_t _unwindTime;
+
+    /** Time spent performing symbol table lookups, in nanoseconds. */
+    uint64_t _symbolTableLookupTime;
+
+    /** Time spent performing Objective-C metadata lookups, in nanoseconds. */
+    uint64_t _objcLookupTime;
+
+    /** Time spent writing binary image records, in nanoseconds. */
+    uint64_t _imageWriteTime;
+
+    /** Time spent writing buffered output, in nanoseconds. */
+    uint64_t _outputTime;
+
+    /** The number of output writes. */
+    uint64_t _outputCount;
+
+    /** The number of memory objects mapped. */
+    uint64_t _memoryObjectCount;
+
+    /** The number of task memory reads. */
+    uint64_t _memoryReadCount;
+
+    /** The maximum number of bytes in use by the writer's async-safe allocators. */
+    uint64_t _allocatorHighWaterMark;
+
+    /** The size of the alternate signal stack, in bytes, or 0 if unknown. */
+    uint64_t _signalStackSize;
+
+    /** The maximum number of bytes of the alternate signal stack used. */
+    uint64_t _signalStackHighWaterMark;
+}
+
+- (id) initWithThreadSuspendTime: (uint64_t) threadSuspendTime
+                      unwindTime: (uint64_t) unwindTime
+           symbolTableLookupTime: (uint64_t) symbolTableLookupTime
+                  objcLookupTime: (uint64_t) objcLookupTime
+                  imageWriteTime: (uint64_t) imageWriteTime
+                      outputTime: (uint64_t) outputTime
+                     outputCount: (uint64_t) outputCount
+               memoryObjectCount: (uint64_t) memoryObjectCount
+                 memoryReadCount: (uint64_t) memoryReadCount
+          allocatorHighWaterMark: (uint64_t) allocatorHighWaterMark
+                 signalStackSize: (uint64_t) signalStackSize
+        signalStackHighWaterMark: (uint64_t) signalStackHighWaterMark;
+
+/** Time for which the process' threads were suspended, in nanoseconds. */
+@property(nonatomic, readonly) uint64_t threadSuspendTime;
+
+/** Time spent unwinding thread stacks, in nanoseconds. */
+@property(nonatomic, readonly) uint64_t unwindTime;
+
+/** Time spent performing symbol table lookups, in nanoseconds. */
+@property(nonatomic, readonly) uint64_t symbolTableLookupTime;
+
+/** Time spent performing Objective-C metadata lookups, in nanoseconds. */
+@property(nonatomic, readonly) uint64_t objcLookupTime;
+
+/** Time spent writing binary image records, in nanoseconds. */
+@property(nonatomic, readonly) uint64_t imageWriteTime;
+
+/** Time spent writing buffered report output, in nanoseconds. */
+@property(nonatomic, readonly) uint64_t outputTime;
+
+/** The number of writes of buffered report output. */
+@property(nonatomic, readonly) uint64_t outputCount;
+
+/** The number of memory objects mapped while generating the report. */
+@property(nonatomic, readonly) uint64_t memoryObjectCount;
+
+/** The number of task memory reads performed while generating the report. */
+@property(nonatomic, readonly) uint64_t memoryReadCount;
+
+/** The maximum number of bytes in use by the writer's async-safe allocators. */
+@property(nonatomic, readonly) uint64_t allocatorHighWaterMark;
+
+/** The size of the alternate signal stack, in bytes. If no signal stack was installed, this will be 0. */
+@property(nonatomic, readonly) uint64_t signalStackSize;
+
+/**
+ * The maximum number of bytes of the alternate signal stack used since the stack was installed. This is measured
+ * by scanning for unused stack space, and is a close lower bound.
+ */
+@property(nonatomic, readonly) uint64_t signalStackHighWaterMark;
+
+@end
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportInstrumentationInfo.h"
+
+/**
+ * Crash log generation instrumentation.
+ *
+ * Provides the time spent in each phase of a report's generation, and the number of memory objects mapped and
+ * task memory reads performed. Only available if instrumentation was enabled via
+ * PLCrashReporterConfig::instrumentationEnabled when the report was written.
+ */
+@implementation PLCrashReportInstrumentationInfo
+
+@synthesize threadSuspendTime = _threadSuspendTime;
+@synthesize unwindTime = _unwindTime;
+@synthesize symbolTableLookupTime = _symbolTableLookupTime;
+@synthesize objcLookupTime = _objcLookupTime;
+@synthesize imageWriteTime = _imageWriteTime;
+@synthesize outputTime = _outputTime;
+@synthesize outputCount = _outputCount;
+@synthesize memoryObjectCount = _memoryObjectCount;
+@synthesize memoryReadCount = _memoryReadCount;
+@synthesize allocatorHighWaterMark = _allocatorHighWaterMark;
+@synthesize signalStackSize = _signalStackSize;
+@synthesize signalStackHighWaterMark = _signalStackHighWaterMark;
+
+/**
+ * Initialize a new instrumentation info data object. All times are in nanoseconds.
+ *
+ * @param threadSuspendTime Time for which the process' threads were suspended.
+ * @param unwindTime Time spent unwinding thread stacks.
+ * @param symbolTableLookupTime Time spent performing symbol table lookups.
+ * @param objcLookupTime Time spent performing Objective-C metadata lookups.
+ * @param imageWriteTime Time spent writing binary image records.
+ * @param outputTime Time spent writing buffered report output.
+ * @param outputCount The number of writes of buffered report output.
+ * @param memoryObjectCount The number of memory objects mapped.
+ * @param memoryReadCount The number of task memory reads performed.
+ * @param allocatorHighWaterMark The maximum number of bytes in use by the writer's async-safe allocators.
+ * @param signalStackSize The size of the alternate signal stack in bytes, or 0 if no stack was installed.
+ * @param signalStackHighWaterMark The maximum number of bytes of the alternate signal stack used.
+ */
+- (id) initWithThreadSuspendTime: (uint64_t) threadSuspendTime
+                      unwindTime: (uint64_t) unwindTime
+           symbolTableLookupTime: (uint64_t) symbolTableLookupTime
+                  objcLookupTime: (uint64_t) objcLookupTime
+                  imageWriteTime: (uint64_t) imageWriteTime
+                      outputTime: (uint64_t) outputTime
+                     outputCount: (uint64_t) outputCount
+               memoryObjectCount: (uint64_t) memoryObjectCount
+                 memoryReadCount: (uint64_t) memoryReadCount
+          allocatorHighWaterMark: (uint64_t) allocatorHighWaterMark
+                 signalStackSize: (uint64_t) signalStackSize
+        signalStackHighWaterMark: (uint64_t) signalStackHighWaterMark
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _threadSuspendTime = threadSuspendTime;
+    _unwindTime = unwindTime;
+    _symbolTableLookupTime = symbolTableLookupTime;
+    _objcLookupTime = objcLookupTime;
+    _imageWriteTime = imageWriteTime;
+    _outputTime = outputTime;
+    _outputCount = outputCount;
+    _memoryObjectCount = memoryObjectCount;
+    _memoryReadCount = memoryReadCount;
+    _allocatorHighWaterMark = allocatorHighWaterMark;
+    _signalStackSize = signalStackSize;
+    _signalStackHighWaterMark = signalStackHighWaterMark;
+
+    return self;
+}
+
+@end
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "PLCrashReportIntegrity.h"
+#include "PLCrashAsyncCompressor.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_report_integrity
+ * @{
+ */
+
+/**
+ * The fixed header of the encoded CrashReport.integrity message: the field tag of CrashReport.integrity (21, length
+ * delimited), the message length, and the field tag of CrashReport.integrity.length (1, 64-bit). This must match
+ * crash_report.proto and plcrash_writer_write_integrity().
+ */
+static const uint8_t integrity_header[] = { 0xAA, 0x01, 0x12, 0x09 };
+
+/** The field tag of CrashReport.integrity.checksum (2, 64-bit). */
+#define INTEGRITY_CHECKSUM_TAG 0x11
+
+/**
+ * Read a little-endian fixed64 value from @a p.
+ */
+static uint64_t read_fixed64 (const uint8_t *p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--)
+        value = (value << 8) | p[i];
+    return value;
+}
+
+/**
+ * Verify the integrity trailer of the encoded crash report @a data. Compressed reports are transparently
+ * decompressed.
+ *
+ * @param data The encoded crash report, including the crash log file header.
+ * @param length The length of @a data.
+ * @param verify_checksum If true, the checksum of the report is computed and compared to that recorded in the
+ * trailer. Otherwise, only the presence of the trailer and the recorded report length are verified, which is
+ * sufficient to identify a report that was not completely written.
+ *
+ * @return Returns PLCRASH_ESUCCESS if the report is intact, PLCRASH_ENOTFOUND if the report does not end with an
+ * integrity trailer (either because the report was not completely written, or because it was written by a release
+ * that predates the trailer), or PLCRASH_EINVAL if the report does not match its trailer.
+ */
+plcrash_error_t plcrash_nasync_report_verify_integrity (const void *data, size_t length, bool verify_checksum) {
+    /* Decompress the report, if necessary */
+    if (plcrash_async_compressor_is_compressed(data, length)) {
+        uint8_t *decoded;
+        size_t decoded_length;
+        plcrash_error_t err;
+
+        if ((err = plcrash_nasync_compressor_decode(data, length, &decoded, &decoded_length)) != PLCRASH_ESUCCESS)
+            return err;
+
+        err = plcrash_nasync_report_verify_integrity(decoded, decoded_length, verify_checksum);
+        free(decoded);
+        return err;
+    }
+
+    if (length < PLCRASH_REPORT_INTEGRITY_SIZE)
+        return PLCRASH_ENOTFOUND;
+
+    /* Locate the trailer */
+    size_t report_length = length - PLCRASH_REPORT_INTEGRITY_SIZE;
+    const uint8_t *trailer = (const uint8_t *) data + report_length;
+    if (memcmp(trailer, integrity_header, sizeof(integrity_header)) != 0)
+        return PLCRASH_ENOTFOUND;
+
+    if (trailer[sizeof(integrity_header) + 8] != INTEGRITY_CHECKSUM_TAG)
+        return PLCRASH_ENOTFOUND;
+
+    /* Verify the recorded length */
+    if (read_fixed64(trailer + sizeof(integrity_header)) != report_length)
+        return PLCRASH_EINVAL;
+
+    if (!verify_checksum)
+        return PLCRASH_ESUCCESS;
+
+    /* Verify the checksum */
+    plcrash_async_checksum_t checksum;
+    plcrash_async_checksum_init(&checksum);
+    plcrash_async_checksum_update(&checksum, data, report_length);
+
+    if (plcrash_async_checksum_value(&checksum) != read_fixed64(trailer + sizeof(integrity_header) + 9))
+        return PLCRASH_EINVAL;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @}
+ */
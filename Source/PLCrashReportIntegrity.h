@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef PLCRASH_REPORT_INTEGRITY_H
+#define PLCRASH_REPORT_INTEGRITY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_report_integrity Crash Report Integrity
+ * @ingroup plcrash_internal
+ *
+ * Verifies the integrity trailer written at the end of each crash report.
+ *
+ * The trailer is a CrashReport.integrity message recording the length and plcrash_async_checksum_t checksum of all
+ * preceding report bytes. As the message is written last and has a fixed encoding, a completely written report may
+ * be identified by examining only its final bytes, and its contents verified with a single linear pass over the
+ * report; in neither case is the report decoded.
+ *
+ * @{
+ */
+
+/** The encoded size of the CrashReport.integrity message, including its field header. */
+#define PLCRASH_REPORT_INTEGRITY_SIZE 21
+
+plcrash_error_t plcrash_nasync_report_verify_integrity (const void *data, size_t length, bool verify_checksum);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_REPORT_INTEGRITY_H */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReporter.h"
+#import "PLCrashReport.h"
+#import "PLCrashReportIntegrity.h"
+
+@interface PLCrashReportIntegrityTests : SenTestCase {
+@private
+    /** A live report, including its integrity trailer. */
+    NSData *_reportData;
+}
+@end
+
+@implementation PLCrashReportIntegrityTests
+
+- (void) setUp {
+    NSError *error;
+    _reportData = [[[PLCrashReporter sharedReporter] generateLiveReportAndReturnError: &error] retain];
+    STAssertNotNil(_reportData, @"Failed to generate live report: %@", error);
+}
+
+- (void) tearDown {
+    [_reportData release];
+}
+
+/**
+ * Verify that a completely written report passes verification.
+ */
+- (void) testVerifyComplete {
+    NSError *error;
+
+    STAssertTrue([PLCrashReport verifyIntegrityOfCrashData: _reportData verifyChecksum: YES error: &error], @"Verification failed: %@", error);
+    STAssertTrue([PLCrashReport verifyIntegrityOfCrashData: _reportData verifyChecksum: NO error: &error], @"Verification failed: %@", error);
+
+    /* The trailer must not interfere with decoding */
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: _reportData error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode report: %@", error);
+}
+
+/**
+ * Verify that a truncated report is identified without verifying its checksum.
+ */
+- (void) testVerifyTruncated {
+    const void *bytes = [_reportData bytes];
+    size_t length = [_reportData length];
+
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_nasync_report_verify_integrity(bytes, length - 1, false), @"Truncated report was not identified");
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_nasync_report_verify_integrity(bytes, length / 2, false), @"Truncated report was not identified");
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_nasync_report_verify_integrity(bytes, 0, false), @"Empty report was not identified");
+
+    NSData *truncated = [_reportData subdataWithRange: NSMakeRange(0, length - 1)];
+    STAssertFalse([PLCrashReport verifyIntegrityOfCrashData: truncated verifyChecksum: NO error: NULL], @"Truncated report passed verification");
+}
+
+/**
+ * Verify that a modified report fails checksum verification.
+ */
+- (void) testVerifyModified {
+    NSMutableData *modified = [[_reportData mutableCopy] autorelease];
+    uint8_t *bytes = [modified mutableBytes];
+    bytes[[modified length] / 2] ^= 0x01;
+
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_report_verify_integrity(bytes, [modified length], true), @"Modified report passed verification");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_report_verify_integrity(bytes, [modified length], false), @"Trailer-only verification should not examine the report data");
+
+    /* Exchanging two bytes must also be detected */
+    NSMutableData *swapped = [[_reportData mutableCopy] autorelease];
+    bytes = [swapped mutableBytes];
+    for (size_t i = 8; i + 1 < [swapped length]; i++) {
+        if (bytes[i] != bytes[i + 1]) {
+            uint8_t tmp = bytes[i];
+            bytes[i] = bytes[i + 1];
+            bytes[i + 1] = tmp;
+            break;
+        }
+    }
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_report_verify_integrity(bytes, [swapped length], true), @"Reordered report passed verification");
+}
+
+@end
@@ -0,0 +1,614 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "CrashReporter/CrashReporter.h"
+
+#import "PLCrashReportJSONFormatter.h"
+#import "PLCrashReportMessage.h"
+#import "PLCrashReporterNSError.h"
+#import "PLCrashAsyncProtobufReader.h"
+
+#import <unistd.h>
+#import <errno.h>
+#import <inttypes.h>
+#import <libkern/OSByteOrder.h>
+
+/** Size of the JSON output buffer. */
+#define JSON_OUTPUT_BUFFER_SIZE (16 * 1024)
+
+/**
+ * @internal
+ *
+ * JSON output state. Output is accumulated in a fixed-size buffer that is appended to @a data, or written
+ * to @a fd, as it fills.
+ */
+typedef struct pl_json_output {
+    /** Target data, or nil if writing to @a fd. */
+    NSMutableData *data;
+
+    /** Target file descriptor; only used if @a data is nil. */
+    int fd;
+
+    /** The errno value of the first write failure, or 0. Once an error occurs, all further output is discarded. */
+    int error;
+
+    /** If true, a separator must be written before the next value. */
+    bool need_comma;
+
+    /** Number of valid bytes in @a buffer. */
+    size_t length;
+
+    /** Output buffer. */
+    uint8_t buffer[JSON_OUTPUT_BUFFER_SIZE];
+} pl_json_output_t;
+
+static void pl_json_write_report (pl_json_output_t *out, const Plcrash__CrashReport *report);
+static bool pl_json_flush (pl_json_output_t *out);
+
+/**
+ * Formats PLCrashReport data as compact, single line JSON, terminated by a newline, suitable for
+ * newline-delimited JSON (NDJSON) ingestion.
+ *
+ * The JSON is written directly from the report's decoded message, without materializing the report's
+ * Objective-C object graph. Field names are stable; fields that are not available in the report are omitted.
+ * Addresses are written as hexadecimal strings, as their full 64-bit range can not be represented by
+ * all JSON parsers.
+ */
+@implementation PLCrashReportJSONFormatter
+
+// from PLCrashReportFormatter protocol
+- (NSData *) formatReport: (PLCrashReport *) report error: (NSError **) outError {
+    pl_json_output_t *out = malloc(sizeof(*out));
+    out->data = [NSMutableData data];
+    out->fd = -1;
+    out->error = 0;
+    out->need_comma = false;
+    out->length = 0;
+
+    pl_json_write_report(out, report.decodedMessage);
+    pl_json_flush(out);
+
+    NSData *result = out->data;
+    free(out);
+    return result;
+}
+
+/**
+ * Format the provided @a report, writing the JSON directly to the file descriptor @a fd.
+ *
+ * @param report Report to be formatted.
+ * @param fd An open file descriptor to which the formatted report will be written. The descriptor will not be closed.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the report could not be written. If no error occurs, this parameter will be left unmodified.
+ * You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO on failure.
+ */
+- (BOOL) writeReport: (PLCrashReport *) report toFileDescriptor: (int) fd error: (NSError **) outError {
+    pl_json_output_t *out = malloc(sizeof(*out));
+    out->data = nil;
+    out->fd = fd;
+    out->error = 0;
+    out->need_comma = false;
+    out->length = 0;
+
+    pl_json_write_report(out, report.decodedMessage);
+
+    BOOL result = YES;
+    if (!pl_json_flush(out)) {
+        plcrash_populate_posix_error(outError, out->error, @"Failed to write the formatted crash report");
+        result = NO;
+    }
+
+    free(out);
+    return result;
+}
+
+@end
+
+/**
+ * @internal
+ *
+ * Write all buffered bytes to the output.
+ *
+ * @return Returns true on success, or false if an error has occured.
+ */
+static bool pl_json_flush (pl_json_output_t *out) {
+    if (out->data != nil) {
+        [out->data appendBytes: out->buffer length: out->length];
+        out->length = 0;
+        return true;
+    }
+
+    size_t written = 0;
+    while (written < out->length && out->error == 0) {
+        ssize_t ret = write(out->fd, out->buffer + written, out->length - written);
+        if (ret < 0) {
+            if (errno != EINTR)
+                out->error = errno;
+            continue;
+        }
+        written += ret;
+    }
+
+    out->length = 0;
+    return (out->error == 0);
+}
+
+/**
+ * @internal
+ *
+ * Append @a length bytes to the output.
+ */
+static void pl_json_append (pl_json_output_t *out, const void *bytes, size_t length) {
+    const uint8_t *p = bytes;
+
+    while (length > 0 && out->error == 0) {
+        if (out->length == sizeof(out->buffer))
+            pl_json_flush(out);
+
+        size_t count = MIN(length, sizeof(out->buffer) - out->length);
+        memcpy(out->buffer + out->length, p, count);
+        out->length += count;
+        p += count;
+        length -= count;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Append a single character to the output.
+ */
+static inline void pl_json_append_char (pl_json_output_t *out, char c) {
+    if (out->length == sizeof(out->buffer))
+        pl_json_flush(out);
+    out->buffer[out->length++] = c;
+}
+
+/**
+ * @internal
+ *
+ * Write a value separator, if one is required.
+ */
+static void pl_json_separator (pl_json_output_t *out) {
+    if (out->need_comma)
+        pl_json_append_char(out, ',');
+    out->need_comma = true;
+}
+
+/**
+ * @internal
+ *
+ * Append the quoted and escaped form of the UTF-8 @a string.
+ */
+static void pl_json_append_quoted (pl_json_output_t *out, const char *string) {
+    static const char hex[] = "0123456789abcdef";
+
+    pl_json_append_char(out, '"');
+
+    /* Copy runs of characters that do not require escaping in a single append */
+    const char *run = string;
+    for (const char *p = string; *p != '\0'; p++) {
+        unsigned char c = (unsigned char) *p;
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        pl_json_append(out, run, p - run);
+        run = p + 1;
+
+        switch (c) {
+            case '"':  pl_json_append(out, "\\\"", 2); break;
+            case '\\': pl_json_append(out, "\\\\", 2); break;
+            case '\n': pl_json_append(out, "\\n", 2); break;
+            case '\r': pl_json_append(out, "\\r", 2); break;
+            case '\t': pl_json_append(out, "\\t", 2); break;
+            default: {
+                char escape[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+                pl_json_append(out, escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    pl_json_append(out, run, strlen(run));
+
+    pl_json_append_char(out, '"');
+}
+
+/**
+ * @internal
+ *
+ * Write an object key. The key's value must be written immediately afterwards.
+ */
+static void pl_json_key (pl_json_output_t *out, const char *key) {
+    pl_json_separator(out);
+    pl_json_append_quoted(out, key);
+    pl_json_append_char(out, ':');
+    out->need_comma = false;
+}
+
+/** @internal Begin an object, optionally as the value of @a key. */
+static void pl_json_begin_object (pl_json_output_t *out, const char *key) {
+    if (key != NULL)
+        pl_json_key(out, key);
+    else
+        pl_json_separator(out);
+    pl_json_append_char(out, '{');
+    out->need_comma = false;
+}
+
+/** @internal End an object. */
+static void pl_json_end_object (pl_json_output_t *out) {
+    pl_json_append_char(out, '}');
+    out->need_comma = true;
+}
+
+/** @internal Begin an array as the value of @a key. */
+static void pl_json_begin_array (pl_json_output_t *out, const char *key) {
+    pl_json_key(out, key);
+    pl_json_append_char(out, '[');
+    out->need_comma = false;
+}
+
+/** @internal End an array. */
+static void pl_json_end_array (pl_json_output_t *out) {
+    pl_json_append_char(out, ']');
+    out->need_comma = true;
+}
+
+/** @internal Write a string field. Nothing is written if @a value is NULL. */
+static void pl_json_string_field (pl_json_output_t *out, const char *key, const char *value) {
+    if (value == NULL)
+        return;
+    pl_json_key(out, key);
+    pl_json_append_quoted(out, value);
+    out->need_comma = true;
+}
+
+/** @internal Write an unsigned integer field. */
+static void pl_json_uint_field (pl_json_output_t *out, const char *key, uint64_t value) {
+    char buf[24];
+    int len = snprintf(buf, sizeof(buf), "%" PRIu64, value);
+    pl_json_key(out, key);
+    pl_json_append(out, buf, len);
+    out->need_comma = true;
+}
+
+/** @internal Write a signed integer field. */
+static void pl_json_int_field (pl_json_output_t *out, const char *key, int64_t value) {
+    char buf[24];
+    int len = snprintf(buf, sizeof(buf), "%" PRId64, value);
+    pl_json_key(out, key);
+    pl_json_append(out, buf, len);
+    out->need_comma = true;
+}
+
+/** @internal Write a boolean field. */
+static void pl_json_bool_field (pl_json_output_t *out, const char *key, bool value) {
+    pl_json_key(out, key);
+    if (value)
+        pl_json_append(out, "true", 4);
+    else
+        pl_json_append(out, "false", 5);
+    out->need_comma = true;
+}
+
+/** @internal Write an address field as a hexadecimal string. */
+static void pl_json_address_field (pl_json_output_t *out, const char *key, uint64_t value) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "0x%" PRIx64, value);
+    pl_json_string_field(out, key, buf);
+}
+
+/** @internal Write a binary field as a lower-case hexadecimal string. */
+static void pl_json_hex_field (pl_json_output_t *out, const char *key, const ProtobufCBinaryData *value) {
+    static const char hex[] = "0123456789abcdef";
+
+    pl_json_key(out, key);
+    pl_json_append_char(out, '"');
+    for (size_t i = 0; i < value->len; i++) {
+        pl_json_append_char(out, hex[value->data[i] >> 4]);
+        pl_json_append_char(out, hex[value->data[i] & 0xF]);
+    }
+    pl_json_append_char(out, '"');
+    out->need_comma = true;
+}
+
+/**
+ * @internal
+ *
+ * Return the stable name for the given operating system value.
+ */
+static const char *pl_json_os_name (int os) {
+    switch (os) {
+        case PLCrashReportOperatingSystemMacOSX:
+            return "mac_os_x";
+        case PLCrashReportOperatingSystemiPhoneOS:
+            return "ios";
+        case PLCrashReportOperatingSystemiPhoneSimulator:
+            return "ios_simulator";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * @internal
+ *
+ * Write the processor type fields of @a processor.
+ */
+static void pl_json_write_processor (pl_json_output_t *out, const Plcrash__CrashReport__Processor *processor) {
+    if (processor == NULL)
+        return;
+
+    pl_json_uint_field(out, "cpu_type", processor->type);
+    pl_json_uint_field(out, "cpu_subtype", processor->subtype);
+}
+
+/**
+ * @internal
+ *
+ * Write a stack frame list as the value of @a key.
+ */
+static void pl_json_write_frames (pl_json_output_t *out, const Plcrash__CrashReport *report, const char *key,
+                                  Plcrash__CrashReport__Thread__StackFrame **frames, size_t count)
+{
+    pl_json_begin_array(out, key);
+    for (size_t i = 0; i < count; i++) {
+        const Plcrash__CrashReport__Thread__StackFrame *frame = frames[i];
+
+        pl_json_begin_object(out, NULL);
+        pl_json_address_field(out, "pc", frame->pc);
+
+        const Plcrash__CrashReport__Symbol *symbol = frame->symbol;
+        if (symbol != NULL) {
+            const char *name = symbol->name;
+            if (name == NULL && symbol->has_name_index && symbol->name_index < report->n_symbol_names)
+                name = report->symbol_names[symbol->name_index];
+
+            pl_json_string_field(out, "symbol", name);
+            pl_json_address_field(out, "symbol_start", symbol->start_address);
+            if (symbol->has_end_address)
+                pl_json_address_field(out, "symbol_end", symbol->end_address);
+            if (symbol->source_file != NULL && symbol->has_source_line) {
+                pl_json_string_field(out, "source_file", symbol->source_file);
+                pl_json_uint_field(out, "source_line", symbol->source_line);
+            }
+
+            if (symbol->n_inlined_frames > 0) {
+                pl_json_begin_array(out, "inlined");
+                for (size_t i = 0; i < symbol->n_inlined_frames; i++) {
+                    const Plcrash__CrashReport__Symbol__InlinedFrame *inlined = symbol->inlined_frames[i];
+                    pl_json_begin_object(out, NULL);
+                    if (inlined->name != NULL)
+                        pl_json_string_field(out, "symbol", inlined->name);
+                    if (inlined->call_file != NULL && inlined->has_call_line) {
+                        pl_json_string_field(out, "call_file", inlined->call_file);
+                        pl_json_uint_field(out, "call_line", inlined->call_line);
+                    }
+                    pl_json_end_object(out);
+                }
+                pl_json_end_array(out);
+            }
+        }
+
+        if (frame->has_repeat_count && frame->repeat_count > 1 && frame->has_repeat_length) {
+            pl_json_uint_field(out, "repeat_count", frame->repeat_count);
+            pl_json_uint_field(out, "repeat_length", frame->repeat_length);
+        }
+
+        if (frame->has_omitted_frame_count && frame->omitted_frame_count > 0)
+            pl_json_uint_field(out, "omitted_frame_count", frame->omitted_frame_count);
+
+        pl_json_end_object(out);
+    }
+    pl_json_end_array(out);
+}
+
+/**
+ * @internal
+ *
+ * Write the packed, delta-encoded frame PCs @a pcs as a named array of frame objects. Decoding stops at the first
+ * invalid value.
+ */
+static void pl_json_write_packed_frames (pl_json_output_t *out, const char *key, const ProtobufCBinaryData *pcs) {
+    plcrash_async_pb_reader_t reader;
+    uint64_t delta;
+    uint64_t pc = 0;
+
+    pl_json_begin_array(out, key);
+    plcrash_async_pb_reader_init(&reader, pcs->data, pcs->len);
+    while (plcrash_async_pb_reader_next_varint(&reader, &delta) == PLCRASH_ESUCCESS) {
+        pc += (uint64_t) plcrash_async_pb_zigzag_decode(delta);
+
+        pl_json_begin_object(out, NULL);
+        pl_json_address_field(out, "pc", pc);
+        pl_json_end_object(out);
+    }
+    pl_json_end_array(out);
+}
+
+/**
+ * @internal
+ *
+ * Write @a report as a single JSON object, followed by a newline.
+ */
+static void pl_json_write_report (pl_json_output_t *out, const Plcrash__CrashReport *report) {
+    pl_json_begin_object(out, NULL);
+    pl_json_uint_field(out, "version", PLCRASH_REPORT_JSON_VERSION);
+
+    /* Report info */
+    if (report->report_info != NULL) {
+        pl_json_begin_object(out, "report");
+        pl_json_bool_field(out, "user_requested", report->report_info->user_requested);
+        if (report->report_info->has_uuid)
+            pl_json_hex_field(out, "uuid", &report->report_info->uuid);
+        if (report->report_info->has_thread_suspend_duration)
+            pl_json_uint_field(out, "thread_suspend_duration_ns", report->report_info->thread_suspend_duration);
+        pl_json_end_object(out);
+    }
+
+    /* System info */
+    if (report->system_info != NULL) {
+        pl_json_begin_object(out, "system");
+        pl_json_string_field(out, "os", pl_json_os_name(report->system_info->operating_system));
+        pl_json_string_field(out, "os_version", report->system_info->os_version);
+        pl_json_string_field(out, "os_build", report->system_info->os_build);
+        if (report->system_info->timestamp != 0)
+            pl_json_int_field(out, "timestamp", report->system_info->timestamp);
+        pl_json_end_object(out);
+    }
+
+    /* Machine info */
+    if (report->machine_info != NULL) {
+        pl_json_begin_object(out, "machine");
+        pl_json_string_field(out, "model", report->machine_info->model);
+        pl_json_write_processor(out, report->machine_info->processor);
+        pl_json_uint_field(out, "processor_count", report->machine_info->processor_count);
+        pl_json_uint_field(out, "logical_processor_count", report->machine_info->logical_processor_count);
+        pl_json_end_object(out);
+    }
+
+    /* Application info */
+    if (report->application_info != NULL) {
+        pl_json_begin_object(out, "application");
+        pl_json_string_field(out, "identifier", report->application_info->identifier);
+        pl_json_string_field(out, "version", report->application_info->version);
+        pl_json_end_object(out);
+    }
+
+    /* Process info */
+    if (report->process_info != NULL) {
+        const Plcrash__CrashReport__ProcessInfo *processInfo = report->process_info;
+        pl_json_begin_object(out, "process");
+        pl_json_string_field(out, "name", processInfo->process_name);
+        pl_json_uint_field(out, "pid", processInfo->process_id);
+        pl_json_string_field(out, "path", processInfo->process_path);
+        pl_json_string_field(out, "parent_name", processInfo->parent_process_name);
+        pl_json_uint_field(out, "parent_pid", processInfo->parent_process_id);
+        pl_json_bool_field(out, "native", processInfo->native);
+        if (processInfo->has_start_time)
+            pl_json_uint_field(out, "start_time", processInfo->start_time);
+        pl_json_end_object(out);
+    }
+
+    /* Signal info */
+    if (report->signal != NULL) {
+        pl_json_begin_object(out, "signal");
+        pl_json_string_field(out, "name", report->signal->name);
+        pl_json_string_field(out, "code", report->signal->code);
+        pl_json_address_field(out, "address", report->signal->address);
+
+        const Plcrash__CrashReport__Signal__MachException *machException = report->signal->mach_exception;
+        if (machException != NULL) {
+            pl_json_begin_object(out, "mach_exception");
+            pl_json_uint_field(out, "type", machException->type);
+            pl_json_begin_array(out, "codes");
+            for (size_t i = 0; i < machException->n_codes; i++) {
+                char buf[24];
+                snprintf(buf, sizeof(buf), "0x%" PRIx64, machException->codes[i]);
+                pl_json_separator(out);
+                pl_json_append_quoted(out, buf);
+            }
+            pl_json_end_array(out);
+            pl_json_end_object(out);
+        }
+        pl_json_end_object(out);
+    }
+
+    /* Exception info */
+    if (report->exception != NULL) {
+        pl_json_begin_object(out, "exception");
+        pl_json_string_field(out, "name", report->exception->name);
+        pl_json_string_field(out, "reason", report->exception->reason);
+        if (report->exception->n_frames > 0)
+            pl_json_write_frames(out, report, "frames", report->exception->frames, report->exception->n_frames);
+        pl_json_end_object(out);
+    }
+
+    /* Threads */
+    pl_json_begin_array(out, "threads");
+    for (size_t i = 0; i < report->n_threads; i++) {
+        const Plcrash__CrashReport__Thread *thread = report->threads[i];
+
+        pl_json_begin_object(out, NULL);
+        pl_json_uint_field(out, "number", thread->thread_number);
+        pl_json_bool_field(out, "crashed", thread->crashed);
+        if (thread->has_duplicate_of_thread)
+            pl_json_uint_field(out, "duplicate_of", thread->duplicate_of_thread);
+        if (thread->has_also_crashed && thread->also_crashed)
+            pl_json_bool_field(out, "also_crashed", true);
+        else if (thread->has_frame_pcs)
+            pl_json_write_packed_frames(out, "frames", &thread->frame_pcs);
+        else
+            pl_json_write_frames(out, report, "frames", thread->frames, thread->n_frames);
+
+        if (thread->n_registers > 0) {
+            pl_json_begin_object(out, "registers");
+            for (size_t r = 0; r < thread->n_registers; r++) {
+                if (thread->registers[r]->name != NULL)
+                    pl_json_address_field(out, thread->registers[r]->name, thread->registers[r]->value);
+            }
+            pl_json_end_object(out);
+        } else if (thread->has_register_values && thread->register_values.len > 0) {
+            pl_json_begin_object(out, "registers");
+            for (size_t r = 0; r < thread->register_values.len / sizeof(uint64_t); r++) {
+                uint64_t value;
+                memcpy(&value, thread->register_values.data + (r * sizeof(uint64_t)), sizeof(value));
+
+                char buf[24];
+                const char *name = plcrash_report_message_register_name(report->register_set, r);
+                if (name == NULL) {
+                    snprintf(buf, sizeof(buf), "r%zu", r);
+                    name = buf;
+                }
+                pl_json_address_field(out, name, OSSwapLittleToHostInt64(value));
+            }
+            pl_json_end_object(out);
+        }
+        pl_json_end_object(out);
+    }
+    pl_json_end_array(out);
+
+    /* Binary images */
+    pl_json_begin_array(out, "images");
+    for (size_t i = 0; i < report->n_binary_images; i++) {
+        const Plcrash__CrashReport__BinaryImage *image = report->binary_images[i];
+
+        pl_json_begin_object(out, NULL);
+        pl_json_address_field(out, "base", image->base_address);
+        pl_json_uint_field(out, "size", image->size);
+        pl_json_string_field(out, "name", image->name);
+        if (image->has_uuid)
+            pl_json_hex_field(out, "uuid", &image->uuid);
+        pl_json_write_processor(out, image->code_type);
+        pl_json_end_object(out);
+    }
+    pl_json_end_array(out);
+
+    pl_json_end_object(out);
+    pl_json_append_char(out, '\n');
+}
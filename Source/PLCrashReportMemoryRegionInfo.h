@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PLCrashReportMemoryRegionInfo : NSObject {
+@private
+    /** The number of the thread whose register values referenced the memory. */
+    NSInteger _threadNumber;
+
+    /** The address of the first captured byte. */
+    uint64_t _address;
+
+    /** The captured memory. */
+    NSData *_data;
+}
+
+- (id) initWithThreadNumber: (NSInteger) threadNumber address: (uint64_t) address data: (NSData *) data;
+
+/** The number of the thread whose register values referenced the memory; see PLCrashReportThreadInfo::threadNumber. */
+@property(nonatomic, readonly) NSInteger threadNumber;
+
+/** The address of the first captured byte. */
+@property(nonatomic, readonly) uint64_t address;
+
+/** The captured memory, beginning at @a address. */
+@property(nonatomic, readonly) NSData *data;
+
+@end
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReport.h"
+#import "crash_report.pb-c.h"
+#import "PLCrashAsync.h"
+
+/**
+ * @internal
+ *
+ * Provides access to the decoded crash report message backing a PLCrashReport instance. This
+ * allows consumers such as formatters to read the report's fields directly, without materializing
+ * the report's Objective-C object graph.
+ */
+@interface PLCrashReport (Message)
+
+/**
+ * The decoded crash report message. The message is owned by the receiver, and is only valid for
+ * the lifetime of the receiver.
+ */
+@property(nonatomic, readonly) const Plcrash__CrashReport *decodedMessage;
+
+@end
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @internal
+ *
+ * An opaque crash report message decoded by plcrash_report_message_decode_batch(), along with the storage backing
+ * the message.
+ */
+typedef _PLCrashReportDecoder plcrash_report_message_t;
+
+const char *plcrash_report_message_register_name (Plcrash__CrashReport__RegisterSet registerSet, size_t regnum);
+
+plcrash_error_t plcrash_report_message_decode_batch (const void * const *reports, const size_t *lengths, size_t count, size_t worker_count,
+                                                     plcrash_report_message_t **messages, plcrash_error_t *errors);
+const Plcrash__CrashReport *plcrash_report_message_crash_report (plcrash_report_message_t *message);
+void plcrash_report_message_free (plcrash_report_message_t *message);
+
+#ifdef __cplusplus
+}
+#endif
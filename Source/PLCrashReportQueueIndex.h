@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <sys/time.h>
+
+@interface PLCrashReportQueueIndex : NSObject {
+@private
+    /** The directory containing the indexed reports. */
+    NSString *_directory;
+
+    /** The path of the persisted index. */
+    NSString *_path;
+
+    /** The indexed reports (PLCrashPendingReportInfo instances), or nil if the index has not been loaded. */
+    NSMutableArray *_entries;
+
+    /** The modification time of the report directory at the time the index was last validated, or zero if the
+     * index must be validated against the directory on next use. */
+    struct timespec _directoryTimestamp;
+}
+
+- (id) initWithDirectory: (NSString *) directory path: (NSString *) path;
+
+- (NSArray *) entries;
+- (void) removeEntriesWithIdentifiers: (NSArray *) identifiers;
+
+@end
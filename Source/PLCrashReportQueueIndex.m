@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "CrashReporter.h"
+
+#import "PLCrashReportQueueIndex.h"
+#import "PLCrashPendingReportInfo.h"
+
+#import <sys/stat.h>
+
+/** @internal
+ * Index format version. An index with any other version is discarded and rebuilt. */
+#define PLCRASH_QUEUE_INDEX_VERSION 1
+
+/** @internal
+ * Reports whose directory was modified within this many seconds of validation are revalidated on next use, as a
+ * report written within the same timestamp granularity would not otherwise be detected. */
+#define PLCRASH_QUEUE_INDEX_SETTLE_SECONDS 2
+
+/** @internal
+ * Report file extension. Files without this extension, such as partially written reports, are not indexed. */
+static NSString *PLCrashQueueIndexReportExtension = @"plcrash";
+
+/* Index property list keys */
+static NSString *PLCrashQueueIndexVersionKey = @"version";
+static NSString *PLCrashQueueIndexTimestampSecondsKey = @"directoryTimestampSeconds";
+static NSString *PLCrashQueueIndexTimestampNanosecondsKey = @"directoryTimestampNanoseconds";
+static NSString *PLCrashQueueIndexReportsKey = @"reports";
+static NSString *PLCrashQueueIndexIdentifierKey = @"identifier";
+static NSString *PLCrashQueueIndexSizeKey = @"size";
+static NSString *PLCrashQueueIndexDateKey = @"date";
+static NSString *PLCrashQueueIndexSignatureKey = @"signature";
+
+/**
+ * @internal
+ *
+ * Fetch the modification time of @a path. Returns NO if @a path can not be stat'd.
+ */
+static BOOL modification_time (NSString *path, struct timespec *timestamp, struct stat *sb) {
+    struct stat local_sb;
+    if (sb == NULL)
+        sb = &local_sb;
+
+    if (stat([path fileSystemRepresentation], sb) != 0)
+        return NO;
+
+    *timestamp = sb->st_mtimespec;
+    return YES;
+}
+
+@interface PLCrashReportQueueIndex (PrivateMethods)
+
+- (void) load;
+- (void) validate;
+- (void) persistWithDirectoryTimestamp: (const struct timespec *) timestamp;
+
+@end
+
+/**
+ * @internal
+ *
+ * A persistent index of the pending reports in a crash report directory.
+ *
+ * The index records each report's identifier (its file name), size, timestamp, and deduplication signature, and is
+ * persisted as a single small property list, replaced atomically on update. The index is validated against the
+ * report directory's modification time; the directory is only enumerated, and only newly added reports opened, if a
+ * report has been added to or removed from the directory since the index was last written. Pending report queries
+ * thus require a single small read and a single stat() of the report directory.
+ *
+ * All methods are thread-safe.
+ */
+@implementation PLCrashReportQueueIndex
+
+/**
+ * Initialize a new index.
+ *
+ * @param directory The directory containing the indexed reports. Only regular files with a ".plcrash" extension are
+ * indexed.
+ * @param path The path at which the index will be persisted. The path should not be within @a directory.
+ */
+- (id) initWithDirectory: (NSString *) directory path: (NSString *) path {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _directory = [directory copy];
+    _path = [path copy];
+
+    return self;
+}
+
+- (void) dealloc {
+    [_directory release];
+    [_path release];
+    [_entries release];
+
+    [super dealloc];
+}
+
+/**
+ * Return the indexed reports, as PLCrashPendingReportInfo instances, ordered by report date.
+ */
+- (NSArray *) entries {
+    @synchronized (self) {
+        [self load];
+        [self validate];
+        return [[_entries copy] autorelease];
+    }
+}
+
+/**
+ * Remove the reports with the given identifiers from the index. The report files themselves must be removed by the
+ * caller prior to calling this method.
+ *
+ * @param identifiers The identifiers of the removed reports.
+ */
+- (void) removeEntriesWithIdentifiers: (NSArray *) identifiers {
+    if ([identifiers count] == 0)
+        return;
+
+    @synchronized (self) {
+        [self load];
+
+        NSSet *removed = [NSSet setWithArray: identifiers];
+        NSIndexSet *indexes = [_entries indexesOfObjectsPassingTest: ^BOOL (id obj, NSUInteger idx, BOOL *stop) {
+            return [removed containsObject: [obj identifier]];
+        }];
+        [_entries removeObjectsAtIndexes: indexes];
+
+        /* Reports may have been added since the index was validated; the index must be revalidated on next use */
+        [self persistWithDirectoryTimestamp: NULL];
+    }
+}
+
+@end
+
+/**
+ * @internal
+ */
+@implementation PLCrashReportQueueIndex (PrivateMethods)
+
+/**
+ * Load the persisted index, if it has not already been loaded. If the index is missing or invalid, an empty index
+ * requiring validation is loaded.
+ */
+- (void) load {
+    if (_entries != nil)
+        return;
+
+    _entries = [[NSMutableArray alloc] init];
+    _directoryTimestamp.tv_sec = 0;
+    _directoryTimestamp.tv_nsec = 0;
+
+    NSData *data = [NSData dataWithContentsOfFile: _path];
+    if (data == nil)
+        return;
+
+    NSDictionary *plist = [NSPropertyListSerialization propertyListWithData: data options: NSPropertyListImmutable format: NULL error: NULL];
+    if (![plist isKindOfClass: [NSDictionary class]] || [[plist objectForKey: PLCrashQueueIndexVersionKey] integerValue] != PLCRASH_QUEUE_INDEX_VERSION)
+        return;
+
+    NSArray *reports = [plist objectForKey: PLCrashQueueIndexReportsKey];
+    if (![reports isKindOfClass: [NSArray class]])
+        return;
+
+    for (NSDictionary *report in reports) {
+        if (![report isKindOfClass: [NSDictionary class]])
+            continue;
+
+        NSString *identifier = [report objectForKey: PLCrashQueueIndexIdentifierKey];
+        NSNumber *size = [report objectForKey: PLCrashQueueIndexSizeKey];
+        NSNumber *date = [report objectForKey: PLCrashQueueIndexDateKey];
+        NSNumber *signature = [report objectForKey: PLCrashQueueIndexSignatureKey];
+        if (![identifier isKindOfClass: [NSString class]] || ![size isKindOfClass: [NSNumber class]] || ![date isKindOfClass: [NSNumber class]])
+            continue;
+
+        PLCrashPendingReportInfo *info = [[PLCrashPendingReportInfo alloc] initWithIdentifier: identifier
+                                                                                        size: [size unsignedLongLongValue]
+                                                                                        date: [NSDate dateWithTimeIntervalSince1970: [date doubleValue]]
+                                                                                hasSignature: [signature isKindOfClass: [NSNumber class]]
+                                                                                   signature: [signature unsignedLongLongValue]];
+        [_entries addObject: info];
+        [info release];
+    }
+
+    _directoryTimestamp.tv_sec = [[plist objectForKey: PLCrashQueueIndexTimestampSecondsKey] longValue];
+    _directoryTimestamp.tv_nsec = [[plist objectForKey: PLCrashQueueIndexTimestampNanosecondsKey] longValue];
+}
+
+/**
+ * Validate the index against the report directory, indexing any new reports and removing any missing reports.
+ * If the report directory has not been modified since the index was written, this is a single stat().
+ */
+- (void) validate {
+    struct timespec current;
+    if (!modification_time(_directory, &current, NULL)) {
+        /* No report directory; no reports */
+        if ([_entries count] > 0) {
+            [_entries removeAllObjects];
+            [self persistWithDirectoryTimestamp: NULL];
+        }
+        return;
+    }
+
+    if (_directoryTimestamp.tv_sec != 0 && current.tv_sec == _directoryTimestamp.tv_sec && current.tv_nsec == _directoryTimestamp.tv_nsec)
+        return;
+
+    /* Existing entries are retained if the report file is unchanged */
+    NSMutableDictionary *existing = [NSMutableDictionary dictionaryWithCapacity: [_entries count]];
+    for (PLCrashPendingReportInfo *info in _entries)
+        [existing setObject: info forKey: [info identifier]];
+
+    NSArray *files = [[NSFileManager defaultManager] contentsOfDirectoryAtPath: _directory error: NULL];
+    NSMutableArray *entries = [NSMutableArray arrayWithCapacity: [files count]];
+    for (NSString *file in files) {
+        if (![[file pathExtension] isEqualToString: PLCrashQueueIndexReportExtension])
+            continue;
+
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSString *path = [_directory stringByAppendingPathComponent: file];
+        struct timespec mtime;
+        struct stat sb;
+
+        if (!modification_time(path, &mtime, &sb) || !S_ISREG(sb.st_mode)) {
+            [pool drain];
+            continue;
+        }
+
+        NSDate *date = [NSDate dateWithTimeIntervalSince1970: (double) mtime.tv_sec + ((double) mtime.tv_nsec / NSEC_PER_SEC)];
+        PLCrashPendingReportInfo *info = [existing objectForKey: file];
+        if (info == nil || [info size] != (uint64_t) sb.st_size || ![[info date] isEqualToDate: date]) {
+            /* Compute the signature of the new report; the report is mapped, rather than read */
+            NSData *data = [NSData dataWithContentsOfFile: path options: NSDataReadingMappedAlways error: NULL];
+            uint64_t signature = 0;
+            BOOL hasSignature = data != nil && [PLCrashReport signatureForCrashData: data
+                                                                          frameCount: PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES
+                                                                           signature: &signature
+                                                                               error: NULL];
+
+            info = [[[PLCrashPendingReportInfo alloc] initWithIdentifier: file
+                                                                    size: (uint64_t) sb.st_size
+                                                                    date: date
+                                                            hasSignature: hasSignature
+                                                               signature: signature] autorelease];
+        }
+
+        [entries addObject: info];
+        [pool drain];
+    }
+
+    [entries sortUsingComparator: ^NSComparisonResult (id a, id b) {
+        return [[a date] compare: [b date]];
+    }];
+
+    [_entries setArray: entries];
+
+    /* The timestamp was fetched prior to enumerating the directory; any concurrent change will be detected on next
+     * use */
+    [self persistWithDirectoryTimestamp: &current];
+}
+
+/**
+ * Atomically write the index.
+ *
+ * @param timestamp The report directory modification time against which the index was validated, or NULL if the
+ * index must be revalidated on next use.
+ */
+- (void) persistWithDirectoryTimestamp: (const struct timespec *) timestamp {
+    struct timespec current = { 0, 0 };
+    struct timeval now;
+
+    /* A directory modified within the timestamp granularity may be modified again without a visible timestamp
+     * change; such an index must also be revalidated on next use */
+    gettimeofday(&now, NULL);
+    if (timestamp != NULL && now.tv_sec - timestamp->tv_sec >= PLCRASH_QUEUE_INDEX_SETTLE_SECONDS)
+        current = *timestamp;
+    _directoryTimestamp = current;
+
+    NSMutableArray *reports = [NSMutableArray arrayWithCapacity: [_entries count]];
+    for (PLCrashPendingReportInfo *info in _entries) {
+        NSMutableDictionary *report = [NSMutableDictionary dictionaryWithObjectsAndKeys:
+                                       [info identifier], PLCrashQueueIndexIdentifierKey,
+                                       [NSNumber numberWithUnsignedLongLong: [info size]], PLCrashQueueIndexSizeKey,
+                                       [NSNumber numberWithDouble: [[info date] timeIntervalSince1970]], PLCrashQueueIndexDateKey,
+                                       nil];
+        if ([info hasSignature])
+            [report setObject: [NSNumber numberWithUnsignedLongLong: [info signature]] forKey: PLCrashQueueIndexSignatureKey];
+
+        [reports addObject: report];
+    }
+
+    NSDictionary *plist = [NSDictionary dictionaryWithObjectsAndKeys:
+                           [NSNumber numberWithInteger: PLCRASH_QUEUE_INDEX_VERSION], PLCrashQueueIndexVersionKey,
+                           [NSNumber numberWithLong: current.tv_sec], PLCrashQueueIndexTimestampSecondsKey,
+                           [NSNumber numberWithLong: current.tv_nsec], PLCrashQueueIndexTimestampNanosecondsKey,
+                           reports, PLCrashQueueIndexReportsKey,
+                           nil];
+
+    NSError *error = nil;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList: plist format: NSPropertyListBinaryFormat_v1_0 options: 0 error: &error];
+    if (data == nil) {
+        NSLog(@"Could not encode the pending report index: %@", error);
+        return;
+    }
+
+    /* Failure to persist the index is not fatal; the index will be rebuilt on next use */
+    [[NSFileManager defaultManager] createDirectoryAtPath: [_path stringByDeletingLastPathComponent] withIntermediateDirectories: YES attributes: nil error: NULL];
+    if (![data writeToFile: _path options: NSDataWritingAtomic error: &error])
+        NSLog(@"Could not write the pending report index: %@", error);
+}
+
+@end
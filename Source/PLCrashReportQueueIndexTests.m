@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReportQueueIndex.h"
+#import "PLCrashPendingReportInfo.h"
+
+#import <sys/time.h>
+
+@interface PLCrashReportQueueIndexTests : SenTestCase {
+@private
+    /** Report directory. */
+    NSString *_directory;
+
+    /** Index path. */
+    NSString *_indexPath;
+}
+@end
+
+@implementation PLCrashReportQueueIndexTests
+
+- (void) setUp {
+    _directory = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+    _indexPath = [[[_directory stringByAppendingPathComponent: @"queued"] stringByAppendingPathComponent: @"index.plist"] retain];
+    STAssertTrue([[NSFileManager defaultManager] createDirectoryAtPath: [_indexPath stringByDeletingLastPathComponent] withIntermediateDirectories: YES attributes: nil error: NULL], @"Could not create index directory");
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _directory error: NULL];
+    [_directory release];
+    [_indexPath release];
+}
+
+/* Write a report file of @a size bytes */
+- (void) writeReport: (NSString *) name size: (NSUInteger) size {
+    NSData *data = [NSMutableData dataWithLength: size];
+    STAssertTrue([data writeToFile: [_directory stringByAppendingPathComponent: name] atomically: NO], @"Could not write report");
+}
+
+/* Set the report directory's modification time to @a seconds in the past, beyond the index's settle period */
+- (void) ageDirectory: (time_t) seconds {
+    struct timeval times[2];
+    gettimeofday(&times[0], NULL);
+    times[0].tv_sec -= seconds;
+    times[1] = times[0];
+    STAssertEquals(utimes([_directory fileSystemRepresentation], times), 0, @"Could not set directory modification time");
+}
+
+/* Return a new index over the test directory */
+- (PLCrashReportQueueIndex *) index {
+    return [[[PLCrashReportQueueIndex alloc] initWithDirectory: _directory path: _indexPath] autorelease];
+}
+
+/**
+ * Verify that regular report files are indexed, and that directories (such as the index's own directory) and
+ * partially written reports are not.
+ */
+- (void) testIndexReports {
+    [self writeReport: @"a.plcrash" size: 10];
+    [self writeReport: @"b.plcrash" size: 20];
+    [self writeReport: @"c.plcrash.tmp" size: 40];
+    STAssertTrue([[NSFileManager defaultManager] createDirectoryAtPath: [_directory stringByAppendingPathComponent: @"subdir"] withIntermediateDirectories: NO attributes: nil error: NULL], @"Could not create directory");
+
+    NSArray *entries = [[self index] entries];
+    STAssertEquals([entries count], (NSUInteger) 2, @"Incorrect entry count");
+
+    uint64_t total = 0;
+    for (PLCrashPendingReportInfo *info in entries) {
+        STAssertTrue([[info identifier] hasSuffix: @".plcrash"], @"Unexpected identifier %@", [info identifier]);
+        STAssertFalse([info hasSignature], @"Signature computed for an invalid report");
+        total += [info size];
+    }
+    STAssertEquals(total, (uint64_t) 30, @"Incorrect report sizes");
+
+    STAssertTrue([[NSFileManager defaultManager] fileExistsAtPath: _indexPath], @"Index was not persisted");
+}
+
+/**
+ * Verify that a persisted index is used without examining the reports if the directory has not been modified.
+ */
+- (void) testPersistedIndex {
+    [self writeReport: @"a.plcrash" size: 10];
+    [self ageDirectory: 60];
+    STAssertEquals([[[self index] entries] count], (NSUInteger) 1, @"Incorrect entry count");
+
+    /* Rewrite the report in place; the directory itself is not modified */
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingAtPath: [_directory stringByAppendingPathComponent: @"a.plcrash"]];
+    [handle seekToEndOfFile];
+    [handle writeData: [NSMutableData dataWithLength: 5]];
+    [handle closeFile];
+
+    NSArray *entries = [[self index] entries];
+    STAssertEquals([entries count], (NSUInteger) 1, @"Incorrect entry count");
+    STAssertEquals([[entries objectAtIndex: 0] size], (uint64_t) 10, @"Persisted index was not used");
+}
+
+/**
+ * Verify that reports added to or removed from the directory are detected.
+ */
+- (void) testDetectChanges {
+    [self writeReport: @"a.plcrash" size: 10];
+    [self ageDirectory: 120];
+
+    PLCrashReportQueueIndex *index = [self index];
+    STAssertEquals([[index entries] count], (NSUInteger) 1, @"Incorrect entry count");
+
+    [self writeReport: @"b.plcrash" size: 20];
+    [self ageDirectory: 60];
+    STAssertEquals([[index entries] count], (NSUInteger) 2, @"Added report was not detected");
+
+    STAssertTrue([[NSFileManager defaultManager] removeItemAtPath: [_directory stringByAppendingPathComponent: @"a.plcrash"] error: NULL], @"Could not remove report");
+    [self ageDirectory: 30];
+    NSArray *entries = [[self index] entries];
+    STAssertEquals([entries count], (NSUInteger) 1, @"Removed report was not detected");
+    STAssertEqualObjects([[entries objectAtIndex: 0] identifier], @"b.plcrash", @"Incorrect report retained");
+}
+
+/**
+ * Verify that removed entries are dropped from the persisted index.
+ */
+- (void) testRemoveEntries {
+    [self writeReport: @"a.plcrash" size: 10];
+    [self writeReport: @"b.plcrash" size: 20];
+
+    PLCrashReportQueueIndex *index = [self index];
+    STAssertEquals([[index entries] count], (NSUInteger) 2, @"Incorrect entry count");
+
+    STAssertTrue([[NSFileManager defaultManager] removeItemAtPath: [_directory stringByAppendingPathComponent: @"a.plcrash"] error: NULL], @"Could not remove report");
+    [index removeEntriesWithIdentifiers: [NSArray arrayWithObject: @"a.plcrash"]];
+
+    NSArray *entries = [[self index] entries];
+    STAssertEquals([entries count], (NSUInteger) 1, @"Incorrect entry count");
+    STAssertEqualObjects([[entries objectAtIndex: 0] identifier], @"b.plcrash", @"Incorrect report retained");
+}
+
+@end
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashReportSignature.h"
+#include "PLCrashAsyncCompressor.h"
+#include "PLCrashAsyncProtobufReader.h"
+#include "PLCrashReportFieldIDs.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_report_signature
+ * @{
+ */
+
+/** The FNV-1a 64-bit offset basis. */
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+
+/** The FNV-1a 64-bit prime. */
+#define FNV_PRIME 0x100000001b3ULL
+
+/**
+ * A binary image record referenced by the signature.
+ */
+typedef struct signature_image {
+    /** The image base address. */
+    uint64_t base;
+
+    /** The image size. */
+    uint64_t size;
+
+    /** The image UUID or name bytes used to identify the image, or NULL if unavailable. */
+    const uint8_t *ident;
+
+    /** The length of @a ident. */
+    size_t ident_len;
+
+    /** True if @a ident is an image UUID. */
+    bool has_uuid;
+} signature_image_t;
+
+/**
+ * Fold @a len bytes into the FNV-1a hash @a hash.
+ */
+static inline uint64_t fnv1a (uint64_t hash, const void *data, size_t len) {
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Fold @a value into the FNV-1a hash @a hash, in little-endian byte order.
+ */
+static inline uint64_t fnv1a_u64 (uint64_t hash, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (uint8_t) (value >> (i * 8));
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Scan @a thread, returning true and setting @a crashed if the thread record is valid.
+ */
+static bool scan_thread (plcrash_async_pb_reader_t thread, bool *crashed) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    *crashed = false;
+    while ((err = plcrash_async_pb_reader_next(&thread, &field)) == PLCRASH_ESUCCESS) {
+        if (field.id == PLCRASH_PROTO_THREAD_CRASHED_ID && field.wire_type == PLCRASH_PB_WIRE_TYPE_VARINT)
+            *crashed = (field.value != 0);
+    }
+
+    return (err == PLCRASH_ENOTFOUND);
+}
+
+/**
+ * Decode the binary image record @a image into @a result. Returns false if the record is invalid.
+ */
+static bool scan_image (plcrash_async_pb_reader_t image, signature_image_t *result) {
+    plcrash_async_pb_field_t field;
+    const uint8_t *name = NULL;
+    size_t name_len = 0;
+    plcrash_error_t err;
+
+    memset(result, 0, sizeof(*result));
+    while ((err = plcrash_async_pb_reader_next(&image, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case PLCRASH_PROTO_BINARY_IMAGE_ADDR_ID:
+                result->base = field.value;
+                break;
+
+            case PLCRASH_PROTO_BINARY_IMAGE_SIZE_ID:
+                result->size = field.value;
+                break;
+
+            case PLCRASH_PROTO_BINARY_IMAGE_NAME_ID:
+                if (field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED) {
+                    name = field.data.p;
+                    name_len = field.data.end - field.data.p;
+                }
+                break;
+
+            case PLCRASH_PROTO_BINARY_IMAGE_UUID_ID:
+                if (field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED && field.data.end > field.data.p) {
+                    result->ident = field.data.p;
+                    result->ident_len = field.data.end - field.data.p;
+                    result->has_uuid = true;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* Fall back on the image name if no UUID is available */
+    if (!result->has_uuid) {
+        result->ident = name;
+        result->ident_len = name_len;
+    }
+
+    return (err == PLCRASH_ENOTFOUND);
+}
+
+/**
+ * Compute the signature of the unframed report message @a message.
+ */
+static plcrash_error_t compute_signature (plcrash_async_pb_reader_t message, uint32_t frame_count, uint64_t *signature) {
+    signature_image_t *images = NULL;
+    size_t image_count = 0;
+    size_t image_capacity = 0;
+    plcrash_async_pb_reader_t crashed_thread = { NULL, NULL };
+    bool found_crashed = false;
+    plcrash_error_t err = PLCRASH_EINVAL;
+    plcrash_error_t read_err;
+    plcrash_async_pb_field_t field;
+
+    /* Locate the crashed thread, and gather the binary images. All other top-level fields are skipped */
+    while ((read_err = plcrash_async_pb_reader_next(&message, &field)) == PLCRASH_ESUCCESS) {
+        if (field.wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+            continue;
+
+        if (field.id == PLCRASH_PROTO_THREADS_ID && !found_crashed) {
+            bool crashed;
+            if (!scan_thread(field.data, &crashed)) {
+                PLCF_DEBUG("Invalid thread record in crash report");
+                goto cleanup;
+            }
+
+            if (crashed) {
+                crashed_thread = field.data;
+                found_crashed = true;
+            }
+        } else if (field.id == PLCRASH_PROTO_BINARY_IMAGES_ID) {
+            if (image_count == image_capacity) {
+                size_t capacity = image_capacity == 0 ? 64 : image_capacity * 2;
+                signature_image_t *resized = realloc(images, capacity * sizeof(*images));
+                if (resized == NULL) {
+                    err = PLCRASH_ENOMEM;
+                    goto cleanup;
+                }
+
+                images = resized;
+                image_capacity = capacity;
+            }
+
+            if (!scan_image(field.data, &images[image_count])) {
+                PLCF_DEBUG("Invalid binary image record in crash report");
+                goto cleanup;
+            }
+            image_count++;
+        }
+    }
+
+    if (read_err != PLCRASH_ENOTFOUND) {
+        PLCF_DEBUG("Invalid crash report encoding");
+        goto cleanup;
+    }
+
+    if (!found_crashed) {
+        err = PLCRASH_ENOTFOUND;
+        goto cleanup;
+    }
+
+    /* Hash the innermost frames of the crashed thread. Frames are either written as individual frame messages, or
+     * as a single packed array of delta-encoded PCs. */
+    uint64_t hash = FNV_OFFSET_BASIS;
+    uint32_t frames = 0;
+    plcrash_async_pb_reader_t packed_pcs;
+    uint64_t packed_pc = 0;
+
+    plcrash_async_pb_reader_init(&packed_pcs, NULL, 0);
+    while (frames < frame_count) {
+        uint64_t pc = 0;
+        uint64_t delta;
+
+        if (plcrash_async_pb_reader_next_varint(&packed_pcs, &delta) == PLCRASH_ESUCCESS) {
+            /* Fetch the next packed PC */
+            packed_pc += (uint64_t) plcrash_async_pb_zigzag_decode(delta);
+            pc = packed_pc;
+        } else if (plcrash_async_pb_reader_next(&crashed_thread, &field) == PLCRASH_ESUCCESS) {
+            if (field.wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+                continue;
+
+            if (field.id == PLCRASH_PROTO_THREAD_FRAME_PCS_ID) {
+                packed_pcs = field.data;
+                continue;
+            } else if (field.id != PLCRASH_PROTO_THREAD_FRAMES_ID) {
+                continue;
+            }
+
+            /* Fetch the frame's PC */
+            plcrash_async_pb_field_t frame_field;
+            plcrash_async_pb_reader_t frame = field.data;
+            while (plcrash_async_pb_reader_next(&frame, &frame_field) == PLCRASH_ESUCCESS) {
+                if (frame_field.id == PLCRASH_PROTO_THREAD_FRAME_PC_ID && frame_field.wire_type == PLCRASH_PB_WIRE_TYPE_VARINT)
+                    pc = frame_field.value;
+            }
+        } else {
+            break;
+        }
+
+        /* Normalize the PC to its image-relative offset */
+        const signature_image_t *image = NULL;
+        for (size_t i = 0; i < image_count; i++) {
+            if (pc >= images[i].base && pc - images[i].base < images[i].size) {
+                image = &images[i];
+                break;
+            }
+        }
+
+        if (image != NULL && image->ident != NULL) {
+            uint8_t tag = image->has_uuid ? 'U' : 'N';
+            hash = fnv1a(hash, &tag, 1);
+            hash = fnv1a_u64(hash, image->ident_len);
+            hash = fnv1a(hash, image->ident, image->ident_len);
+            hash = fnv1a_u64(hash, pc - image->base);
+        } else {
+            uint8_t tag = 'A';
+            hash = fnv1a(hash, &tag, 1);
+            hash = fnv1a_u64(hash, pc);
+        }
+
+        frames++;
+    }
+
+    *signature = hash;
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    free(images);
+    return err;
+}
+
+/**
+ * Compute the signature of the encoded crash report @a data. Compressed reports are transparently decompressed.
+ *
+ * @param data The encoded crash report, including the crash log file header.
+ * @param length The length of @a data.
+ * @param frame_count The maximum number of crashed thread frames to include in the signature.
+ * @param signature On success, the computed signature.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the report does not contain a crashed
+ * thread, or PLCRASH_EINVAL if the report data is invalid.
+ */
+plcrash_error_t plcrash_nasync_report_signature (const void *data, size_t length, uint32_t frame_count, uint64_t *signature) {
+    /* Decompress the report, if necessary */
+    if (plcrash_async_compressor_is_compressed(data, length)) {
+        uint8_t *decoded;
+        size_t decoded_length;
+        plcrash_error_t err;
+
+        if ((err = plcrash_nasync_compressor_decode(data, length, &decoded, &decoded_length)) != PLCRASH_ESUCCESS)
+            return err;
+
+        err = plcrash_nasync_report_signature(decoded, decoded_length, frame_count, signature);
+        free(decoded);
+        return err;
+    }
+
+    /* Validate the file header */
+    plcrash_async_pb_reader_t message;
+    plcrash_error_t err;
+    if ((err = plcrash_async_pb_reader_init_report(&message, data, length)) != PLCRASH_ESUCCESS)
+        return err;
+
+    return compute_signature(message, frame_count, signature);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_REPORT_SIGNATURE_H
+#define PLCRASH_REPORT_SIGNATURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_report_signature Crash Report Signatures
+ * @ingroup plcrash_internal
+ *
+ * Computes a stable 64-bit signature for an encoded crash report, suitable for grouping duplicate reports.
+ *
+ * The signature is derived from the crashed thread's innermost frames. Each frame is normalized to its
+ * containing image's UUID (or, if the image has no UUID, its name) and the frame's offset within that image,
+ * so reports of the same crash produce the same signature regardless of the image load addresses. Frames
+ * that do not fall within a known image contribute their absolute address.
+ *
+ * The signature is computed directly from the encoded report. Only the thread and binary image records are
+ * examined, and only the crashed thread's frames are decoded; no other part of the report is parsed.
+ *
+ * @{
+ */
+
+plcrash_error_t plcrash_nasync_report_signature (const void *data, size_t length, uint32_t frame_count, uint64_t *signature);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_REPORT_SIGNATURE_H */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReport.h"
+#import "PLCrashReportSignature.h"
+#import "PLCrashLogWriterEncoding.h"
+
+#import <fcntl.h>
+
+@interface PLCrashReportSignatureTests : SenTestCase {
+@private
+    /** Output path. */
+    NSString *_path;
+}
+@end
+
+@implementation PLCrashReportSignatureTests
+
+- (void) setUp {
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _path error: NULL];
+    [_path release];
+}
+
+/* Write a stack frame with the given PC. */
+static size_t write_frame (plcrash_async_file_t *file, uint64_t pc) {
+    return plcrash_writer_pack(file, 3, PLPROTOBUF_C_TYPE_UINT64, &pc);
+}
+
+/* Write a thread with the given frame PCs. */
+static size_t write_thread (plcrash_async_file_t *file, uint32_t number, bool crashed, const uint64_t *pcs, size_t count) {
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, 1, PLPROTOBUF_C_TYPE_UINT32, &number);
+    for (size_t i = 0; i < count; i++) {
+        uint32_t size = (uint32_t) write_frame(NULL, pcs[i]);
+        rv += plcrash_writer_pack(file, 2, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += write_frame(file, pcs[i]);
+    }
+    rv += plcrash_writer_pack(file, 3, PLPROTOBUF_C_TYPE_BOOL, &crashed);
+
+    return rv;
+}
+
+/* Write a binary image. */
+static size_t write_image (plcrash_async_file_t *file, uint64_t base, uint64_t size, const char *name, const char *uuid) {
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, 1, PLPROTOBUF_C_TYPE_UINT64, &base);
+    rv += plcrash_writer_pack(file, 2, PLPROTOBUF_C_TYPE_UINT64, &size);
+    rv += plcrash_writer_pack(file, 3, PLPROTOBUF_C_TYPE_STRING, name);
+
+    PLProtobufCBinaryData binary = { strlen(uuid), (void *) uuid };
+    rv += plcrash_writer_pack(file, 4, PLPROTOBUF_C_TYPE_BYTES, &binary);
+
+    return rv;
+}
+
+/**
+ * Write a minimal report with a crashed thread whose frames are at the given offsets within a single image
+ * loaded at @a base, returning the encoded report.
+ */
+- (NSData *) reportWithImageBase: (uint64_t) base offsets: (const uint64_t *) offsets count: (size_t) count {
+    plcrash_async_file_t file;
+    uint32_t size;
+
+    int fd = open([_path fileSystemRepresentation], O_RDWR|O_CREAT|O_TRUNC, 0644);
+    STAssertTrue(fd >= 0, @"Could not open output file");
+    plcrash_async_file_init(&file, fd, OFF_MAX);
+    plcrash_async_file_write(&file, "plcrash\x01", 8);
+
+    /* A non-crashed thread, which must be ignored */
+    uint64_t idle_pc = base + 0x10;
+    size = (uint32_t) write_thread(NULL, 0, false, &idle_pc, 1);
+    plcrash_writer_pack(&file, 3, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    write_thread(&file, 0, false, &idle_pc, 1);
+
+    /* The crashed thread */
+    uint64_t pcs[count];
+    for (size_t i = 0; i < count; i++)
+        pcs[i] = base + offsets[i];
+
+    size = (uint32_t) write_thread(NULL, 1, true, pcs, count);
+    plcrash_writer_pack(&file, 3, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    write_thread(&file, 1, true, pcs, count);
+
+    /* The image */
+    size = (uint32_t) write_image(NULL, base, 0x10000, "/usr/lib/libtest.dylib", "0123456789abcdef");
+    plcrash_writer_pack(&file, 4, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    write_image(&file, base, 0x10000, "/usr/lib/libtest.dylib", "0123456789abcdef");
+
+    STAssertTrue(plcrash_async_file_flush(&file), @"Flush failed");
+    plcrash_async_file_close(&file);
+
+    return [NSData dataWithContentsOfFile: _path];
+}
+
+/**
+ * Verify that signatures are independent of the image load address, and dependent on the frame offsets.
+ */
+- (void) testSignature {
+    const uint64_t offsets[] = { 0x100, 0x200, 0x300 };
+    const uint64_t otherOffsets[] = { 0x100, 0x204, 0x300 };
+    uint64_t sig, slidSig, otherSig, shortSig;
+
+    NSData *report = [self reportWithImageBase: 0x1000 offsets: offsets count: 3];
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_report_signature([report bytes], [report length], PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES, &sig), @"Failed to compute signature");
+
+    uint64_t objcSig;
+    NSError *error;
+    STAssertTrue([PLCrashReport signatureForCrashData: report frameCount: PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES signature: &objcSig error: &error], @"Failed to compute signature: %@", error);
+    STAssertEquals(sig, objcSig, @"Signatures do not match");
+
+    report = [self reportWithImageBase: 0x8000000 offsets: offsets count: 3];
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_report_signature([report bytes], [report length], PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES, &slidSig), @"Failed to compute signature");
+    STAssertEquals(sig, slidSig, @"Signature should not depend on the image load address");
+
+    /* Only the requested number of frames may be considered */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_report_signature([report bytes], [report length], 1, &shortSig), @"Failed to compute signature");
+    STAssertNotEquals(sig, shortSig, @"Signature should depend on the frame count");
+
+    report = [self reportWithImageBase: 0x1000 offsets: otherOffsets count: 3];
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_report_signature([report bytes], [report length], PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES, &otherSig), @"Failed to compute signature");
+    STAssertNotEquals(sig, otherSig, @"Signature should depend on the frame offsets");
+
+    /* Invalid data must be rejected */
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_report_signature([report bytes], [report length] - 3, PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES, &sig), @"Truncated report should be rejected");
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_report_signature("invalid", 7, PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES, &sig), @"Invalid header should be rejected");
+}
+
+@end
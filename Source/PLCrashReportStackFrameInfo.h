@@ -36,9 +36,23 @@
 
     /** Symbol information, if available. Otherwise, will be nil. */
     PLCrashReportSymbolInfo *_symbolInfo;
+
+    /** Number of times the frame group starting at this frame was repeated, or 1. */
+    uint32_t _repeatCount;
+
+    /** Number of frames in the repeated frame group starting at this frame, or 1. */
+    uint32_t _repeatLength;
+
+    /** Number of frames omitted between the preceding frame and this frame. */
+    uint64_t _omittedFrameCount;
 }
 
 - (id) initWithInstructionPointer: (uint64_t) instructionPointer symbolInfo: (PLCrashReportSymbolInfo *) symbolInfo;
+- (id) initWithInstructionPointer: (uint64_t) instructionPointer
+                       symbolInfo: (PLCrashReportSymbolInfo *) symbolInfo
+                      repeatCount: (uint32_t) repeatCount
+                     repeatLength: (uint32_t) repeatLength
+                omittedFrameCount: (uint64_t) omittedFrameCount;
 
 /**
  * Frame's instruction pointer.
@@ -49,4 +63,23 @@
  * This may be unavailable, and this property will be nil. */
 @property(nonatomic, readonly) PLCrashReportSymbolInfo *symbolInfo;
 
+/**
+ * The number of times the group of PLCrashReportStackFrameInfo::repeatLength frames beginning with this frame
+ * was repeated in succession, as occurs with deep recursion. Only the first instance of the group is included
+ * in the report. If the frame does not begin a repeated group, this value will be 1.
+ */
+@property(nonatomic, readonly) uint32_t repeatCount;
+
+/**
+ * The number of frames in the repeated group beginning with this frame. If the frame does not begin a repeated
+ * group, this value will be 1.
+ */
+@property(nonatomic, readonly) uint32_t repeatLength;
+
+/**
+ * The number of frames that were omitted from the report between the preceding frame and this frame, as the
+ * thread's stack exceeded the maximum number of frames recorded per thread.
+ */
+@property(nonatomic, readonly) uint64_t omittedFrameCount;
+
 @end
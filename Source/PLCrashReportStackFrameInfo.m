@@ -35,6 +35,9 @@
 
 @synthesize instructionPointer = _instructionPointer;
 @synthesize symbolInfo = _symbolInfo;
+@synthesize repeatCount = _repeatCount;
+@synthesize repeatLength = _repeatLength;
+@synthesize omittedFrameCount = _omittedFrameCount;
 
 /**
  * Initialize with the provided frame info.
@@ -43,11 +46,32 @@
  * @param symbolInfo Symbol information for this frame, if available. May be nil.
  */
 - (id) initWithInstructionPointer: (uint64_t) instructionPointer symbolInfo: (PLCrashReportSymbolInfo *) symbolInfo {
+    return [self initWithInstructionPointer: instructionPointer symbolInfo: symbolInfo repeatCount: 1 repeatLength: 1 omittedFrameCount: 0];
+}
+
+/**
+ * Initialize with the provided frame info.
+ *
+ * @param instructionPointer The instruction pointer value for this frame.
+ * @param symbolInfo Symbol information for this frame, if available. May be nil.
+ * @param repeatCount The number of times the frame group beginning with this frame was repeated.
+ * @param repeatLength The number of frames in the repeated frame group.
+ * @param omittedFrameCount The number of frames omitted between the preceding frame and this frame.
+ */
+- (id) initWithInstructionPointer: (uint64_t) instructionPointer
+                       symbolInfo: (PLCrashReportSymbolInfo *) symbolInfo
+                      repeatCount: (uint32_t) repeatCount
+                     repeatLength: (uint32_t) repeatLength
+                omittedFrameCount: (uint64_t) omittedFrameCount
+{
     if ((self = [super init]) == nil)
         return nil;
     
     _instructionPointer = instructionPointer;
     _symbolInfo = [symbolInfo retain];
+    _repeatCount = repeatCount;
+    _repeatLength = repeatLength;
+    _omittedFrameCount = omittedFrameCount;
     
     return self;
 }
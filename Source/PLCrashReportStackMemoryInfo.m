@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportStackMemoryInfo.h"
+
+/**
+ * Stack memory captured from a single thread.
+ *
+ * If stack memory capture is enabled, the writer copies a bounded region of memory above the stack pointer of the
+ * crashed thread (and, optionally, of a limited number of other threads) into the report.
+ */
+@implementation PLCrashReportStackMemoryInfo
+
+@synthesize threadNumber = _threadNumber;
+@synthesize address = _address;
+@synthesize data = _data;
+
+/**
+ * Initialize a new stack memory data object.
+ *
+ * @param threadNumber The number of the thread from which the memory was captured.
+ * @param address The address of the first captured byte.
+ * @param data The captured memory.
+ */
+- (id) initWithThreadNumber: (NSInteger) threadNumber address: (uint64_t) address data: (NSData *) data {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _threadNumber = threadNumber;
+    _address = address;
+    _data = [data retain];
+
+    return self;
+}
+
+- (void) dealloc {
+    [_data release];
+    [super dealloc];
+}
+
+@end
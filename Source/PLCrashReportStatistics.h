@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PLCrashReportStatistics : NSObject {
+@private
+    /** The maximum number of crashed thread frames used to compute report signatures. */
+    NSUInteger _signatureFrameCount;
+
+    /** The number of aggregated reports. */
+    NSUInteger _reportCount;
+
+    /** The total encoded size of the aggregated reports, in bytes. */
+    uint64_t _totalReportBytes;
+
+    /** The smallest encoded report size, in bytes. */
+    uint64_t _minimumReportBytes;
+
+    /** The largest encoded report size, in bytes. */
+    uint64_t _maximumReportBytes;
+
+    /** The total number of threads. */
+    uint64_t _threadCount;
+
+    /** The total number of frames. */
+    uint64_t _frameCount;
+
+    /** The maximum number of frames in any single report. */
+    uint64_t _maximumReportFrameCount;
+
+    /** Report counts by signature. */
+    NSCountedSet *_signatureCounts;
+
+    /** Report counts by OS version. */
+    NSCountedSet *_osVersionCounts;
+
+    /** Report counts by device model. */
+    NSCountedSet *_deviceModelCounts;
+
+    /** Report counts by signal name. */
+    NSCountedSet *_signalCounts;
+}
+
+- (id) init;
+- (id) initWithSignatureFrameCount: (NSUInteger) frameCount;
+
+- (BOOL) addCrashData: (NSData *) encodedData error: (NSError **) outError;
+- (void) mergeStatistics: (PLCrashReportStatistics *) statistics;
+
+/**
+ * The maximum number of crashed thread frames used to compute report signatures.
+ *
+ * @sa PLCrashReport::signatureForCrashData:frameCount:signature:error:
+ */
+@property(nonatomic, readonly) NSUInteger signatureFrameCount;
+
+/**
+ * The number of aggregated reports.
+ */
+@property(nonatomic, readonly) NSUInteger reportCount;
+
+/**
+ * The total encoded size of the aggregated reports, in bytes.
+ */
+@property(nonatomic, readonly) uint64_t totalReportBytes;
+
+/**
+ * The smallest encoded report size, in bytes, or 0 if no reports have been aggregated.
+ */
+@property(nonatomic, readonly) uint64_t minimumReportBytes;
+
+/**
+ * The largest encoded report size, in bytes.
+ */
+@property(nonatomic, readonly) uint64_t maximumReportBytes;
+
+/**
+ * The total number of threads across all aggregated reports.
+ */
+@property(nonatomic, readonly) uint64_t threadCount;
+
+/**
+ * The total number of stack frames across all aggregated reports.
+ */
+@property(nonatomic, readonly) uint64_t frameCount;
+
+/**
+ * The largest total number of stack frames in any single aggregated report.
+ */
+@property(nonatomic, readonly) uint64_t maximumReportFrameCount;
+
+/**
+ * The number of reports with each crash signature, as NSNumber values. Reports without a crashed thread are
+ * not counted.
+ */
+@property(nonatomic, readonly) NSCountedSet *signatureCounts;
+
+/**
+ * The number of reports from each OS version, as NSString values.
+ */
+@property(nonatomic, readonly) NSCountedSet *osVersionCounts;
+
+/**
+ * The number of reports from each device model, as NSString values. Reports without machine information are
+ * not counted.
+ */
+@property(nonatomic, readonly) NSCountedSet *deviceModelCounts;
+
+/**
+ * The number of reports with each signal name, as NSString values.
+ */
+@property(nonatomic, readonly) NSCountedSet *signalCounts;
+
+@end
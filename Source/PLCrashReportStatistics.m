@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportStatistics.h"
+#import "PLCrashReport.h"
+#import "PLCrashReporterNSError.h"
+#import "PLCrashReportSummary.h"
+
+/**
+ * Aggregate statistics across a set of encoded crash reports, such as the most common crash signatures, OS versions,
+ * and device models.
+ *
+ * Reports are summarized directly from their encoded form, without decoding the complete report; see
+ * PLCrashReport::signatureForCrashData:frameCount:signature:error:.
+ *
+ * Instances are not thread-safe. To aggregate reports concurrently, use a separate instance on each thread, and combine
+ * the results with mergeStatistics:.
+ */
+@implementation PLCrashReportStatistics
+
+@synthesize signatureFrameCount = _signatureFrameCount;
+@synthesize reportCount = _reportCount;
+@synthesize totalReportBytes = _totalReportBytes;
+@synthesize minimumReportBytes = _minimumReportBytes;
+@synthesize maximumReportBytes = _maximumReportBytes;
+@synthesize threadCount = _threadCount;
+@synthesize frameCount = _frameCount;
+@synthesize maximumReportFrameCount = _maximumReportFrameCount;
+@synthesize signatureCounts = _signatureCounts;
+@synthesize osVersionCounts = _osVersionCounts;
+@synthesize deviceModelCounts = _deviceModelCounts;
+@synthesize signalCounts = _signalCounts;
+
+/**
+ * Initialize an empty statistics instance, using PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES crashed thread frames to
+ * compute report signatures.
+ */
+- (id) init {
+    return [self initWithSignatureFrameCount: PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES];
+}
+
+/**
+ * Initialize an empty statistics instance.
+ *
+ * @param frameCount The maximum number of crashed thread frames to use when computing report signatures.
+ */
+- (id) initWithSignatureFrameCount: (NSUInteger) frameCount {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _signatureFrameCount = frameCount;
+    _signatureCounts = [[NSCountedSet alloc] init];
+    _osVersionCounts = [[NSCountedSet alloc] init];
+    _deviceModelCounts = [[NSCountedSet alloc] init];
+    _signalCounts = [[NSCountedSet alloc] init];
+
+    return self;
+}
+
+- (void) dealloc {
+    [_signatureCounts release];
+    [_osVersionCounts release];
+    [_deviceModelCounts release];
+    [_signalCounts release];
+
+    [super dealloc];
+}
+
+/* Add the non-empty string @a value to @a set. */
+static void add_summary_string (NSCountedSet *set, const char *value) {
+    if (value[0] == '\0')
+        return;
+
+    NSString *str = [[NSString alloc] initWithUTF8String: value];
+    if (str != nil)
+        [set addObject: str];
+    [str release];
+}
+
+/* Add all objects of @a source to @a dest, preserving their counts. */
+static void merge_counts (NSCountedSet *dest, NSCountedSet *source) {
+    for (id obj in source) {
+        for (NSUInteger i = [source countForObject: obj]; i > 0; i--)
+            [dest addObject: obj];
+    }
+}
+
+/**
+ * Summarize the encoded crash report @a encodedData, and add it to the receiver's statistics.
+ *
+ * @param encodedData The encoded crash report. Compressed reports are supported.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the report could not be summarized. If no error occurs, this parameter will be left
+ * unmodified. You may specify NULL for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO if the report could not be decoded. Reports that could not be decoded are
+ * not included in the receiver's statistics.
+ */
+- (BOOL) addCrashData: (NSData *) encodedData error: (NSError **) outError {
+    plcrash_report_summary_t summary;
+    plcrash_error_t err;
+
+    err = plcrash_nasync_report_summary([encodedData bytes], [encodedData length], (uint32_t) MIN(_signatureFrameCount, UINT32_MAX), &summary);
+    if (err != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode invalid crash log",
+                                                                                                   @"Crash log statistics error message"), nil);
+        return NO;
+    }
+
+    uint64_t length = [encodedData length];
+    if (_reportCount == 0 || length < _minimumReportBytes)
+        _minimumReportBytes = length;
+    if (length > _maximumReportBytes)
+        _maximumReportBytes = length;
+
+    _reportCount++;
+    _totalReportBytes += length;
+    _threadCount += summary.thread_count;
+    _frameCount += summary.frame_count;
+    if (summary.frame_count > _maximumReportFrameCount)
+        _maximumReportFrameCount = summary.frame_count;
+
+    if (summary.has_signature)
+        [_signatureCounts addObject: [NSNumber numberWithUnsignedLongLong: summary.signature]];
+
+    add_summary_string(_osVersionCounts, summary.os_version);
+    add_summary_string(_deviceModelCounts, summary.model);
+    add_summary_string(_signalCounts, summary.signal);
+
+    return YES;
+}
+
+/**
+ * Add the statistics of @a statistics to the receiver.
+ *
+ * @param statistics The statistics to merge. This instance must not be concurrently modified.
+ */
+- (void) mergeStatistics: (PLCrashReportStatistics *) statistics {
+    if (statistics->_reportCount == 0)
+        return;
+
+    if (_reportCount == 0 || statistics->_minimumReportBytes < _minimumReportBytes)
+        _minimumReportBytes = statistics->_minimumReportBytes;
+    if (statistics->_maximumReportBytes > _maximumReportBytes)
+        _maximumReportBytes = statistics->_maximumReportBytes;
+    if (statistics->_maximumReportFrameCount > _maximumReportFrameCount)
+        _maximumReportFrameCount = statistics->_maximumReportFrameCount;
+
+    _reportCount += statistics->_reportCount;
+    _totalReportBytes += statistics->_totalReportBytes;
+    _threadCount += statistics->_threadCount;
+    _frameCount += statistics->_frameCount;
+
+    merge_counts(_signatureCounts, statistics->_signatureCounts);
+    merge_counts(_osVersionCounts, statistics->_osVersionCounts);
+    merge_counts(_deviceModelCounts, statistics->_deviceModelCounts);
+    merge_counts(_signalCounts, statistics->_signalCounts);
+}
+
+@end
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReportStatistics.h"
+#import "PLCrashLogWriterEncoding.h"
+
+@interface PLCrashReportStatisticsTests : SenTestCase @end
+
+@implementation PLCrashReportStatisticsTests
+
+/* Append the message field @a field_id, containing the single string field @a string_id, to @a file. */
+static size_t write_string_message (plcrash_async_file_t *file, uint32_t field_id, uint32_t string_id, const char *value) {
+    uint32_t size = (uint32_t) plcrash_writer_pack(NULL, string_id, PLPROTOBUF_C_TYPE_STRING, value);
+    size_t rv = plcrash_writer_pack(file, field_id, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    return rv + plcrash_writer_pack(file, string_id, PLPROTOBUF_C_TYPE_STRING, value);
+}
+
+/* Write a thread with @a count frames. */
+static size_t write_thread (plcrash_async_file_t *file, bool crashed, size_t count) {
+    size_t rv = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t pc = 0x1000 + i;
+        uint32_t size = (uint32_t) plcrash_writer_pack(NULL, 3, PLPROTOBUF_C_TYPE_UINT64, &pc);
+        rv += plcrash_writer_pack(file, 2, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_pack(file, 3, PLPROTOBUF_C_TYPE_UINT64, &pc);
+    }
+    rv += plcrash_writer_pack(file, 3, PLPROTOBUF_C_TYPE_BOOL, &crashed);
+
+    return rv;
+}
+
+/**
+ * Return a minimal encoded report with the given OS version, device model and signal, containing a crashed thread
+ * and an idle thread with @a frames frames each.
+ */
+static NSData *encode_report (const char *os_version, const char *model, const char *signal, size_t frames) {
+    uint8_t buffer[1024];
+    plcrash_async_file_t file;
+
+    plcrash_async_file_init_buffer(&file, -1, 0, buffer, sizeof(buffer));
+    plcrash_async_file_write(&file, "plcrash\x01", 8);
+
+    write_string_message(&file, 1, 2, os_version);
+    write_string_message(&file, 8, 1, model);
+    write_string_message(&file, 6, 1, signal);
+
+    for (int i = 0; i < 2; i++) {
+        bool crashed = (i == 0);
+        uint32_t size = (uint32_t) write_thread(NULL, crashed, frames);
+        plcrash_writer_pack(&file, 3, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        write_thread(&file, crashed, frames);
+    }
+
+    return [NSData dataWithBytes: buffer length: file.buflen];
+}
+
+/**
+ * Verify aggregation of individual reports, and merging of statistics.
+ */
+- (void) testAggregate {
+    NSData *sigsegv = encode_report("9.3.1", "iPhone8,1", "SIGSEGV", 3);
+    NSData *sigabrt = encode_report("10.0", "iPhone8,1", "SIGABRT", 2);
+    NSError *error;
+
+    PLCrashReportStatistics *first = [[[PLCrashReportStatistics alloc] init] autorelease];
+    STAssertTrue([first addCrashData: sigsegv error: &error], @"Failed to add report: %@", error);
+    STAssertTrue([first addCrashData: sigsegv error: &error], @"Failed to add report: %@", error);
+
+    PLCrashReportStatistics *second = [[[PLCrashReportStatistics alloc] init] autorelease];
+    STAssertTrue([second addCrashData: sigabrt error: &error], @"Failed to add report: %@", error);
+    STAssertFalse([second addCrashData: [NSData dataWithBytes: "plcrash\x01\xff" length: 9] error: &error], @"Added an invalid report");
+
+    [first mergeStatistics: second];
+
+    STAssertEquals(first.reportCount, (NSUInteger) 3, @"Incorrect report count");
+    STAssertEquals(first.totalReportBytes, (uint64_t) ([sigsegv length] * 2 + [sigabrt length]), @"Incorrect total size");
+    STAssertEquals(first.minimumReportBytes, (uint64_t) [sigabrt length], @"Incorrect minimum size");
+    STAssertEquals(first.maximumReportBytes, (uint64_t) [sigsegv length], @"Incorrect maximum size");
+    STAssertEquals(first.threadCount, (uint64_t) 6, @"Incorrect thread count");
+    STAssertEquals(first.frameCount, (uint64_t) 16, @"Incorrect frame count");
+    STAssertEquals(first.maximumReportFrameCount, (uint64_t) 6, @"Incorrect maximum frame count");
+
+    STAssertEquals([first.signatureCounts count], (NSUInteger) 2, @"Incorrect signature count");
+    STAssertEquals([first.osVersionCounts countForObject: @"9.3.1"], (NSUInteger) 2, @"Incorrect OS version count");
+    STAssertEquals([first.osVersionCounts countForObject: @"10.0"], (NSUInteger) 1, @"Incorrect OS version count");
+    STAssertEquals([first.deviceModelCounts countForObject: @"iPhone8,1"], (NSUInteger) 3, @"Incorrect model count");
+    STAssertEquals([first.signalCounts countForObject: @"SIGSEGV"], (NSUInteger) 2, @"Incorrect signal count");
+    STAssertEquals([first.signalCounts countForObject: @"SIGABRT"], (NSUInteger) 1, @"Incorrect signal count");
+}
+
+@end
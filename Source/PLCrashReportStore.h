@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class PLCrashReportQueueIndex;
+
+@interface PLCrashReportStore : NSObject {
+@private
+    /** The directory containing the stored reports. */
+    NSString *_directory;
+
+    /** The index of the stored reports. */
+    PLCrashReportQueueIndex *_index;
+
+    /** The maximum number of retained reports, or 0 if unlimited. */
+    NSUInteger _maxCount;
+
+    /** The maximum total size of the retained reports, in bytes, or 0 if unlimited. */
+    NSUInteger _maxBytes;
+
+    /** The maximum age of a retained report, or 0 if unlimited. */
+    NSTimeInterval _maxAge;
+}
+
+- (id) initWithDirectory: (NSString *) directory
+               indexPath: (NSString *) indexPath
+                maxCount: (NSUInteger) maxCount
+                maxBytes: (NSUInteger) maxBytes
+                  maxAge: (NSTimeInterval) maxAge;
+
+- (NSString *) publishReportAtPath: (NSString *) path error: (NSError **) outError;
+- (NSString *) publishReportData: (NSData *) data error: (NSError **) outError;
+
+- (NSArray *) reports;
+- (NSString *) pathForIdentifier: (NSString *) identifier;
+- (BOOL) removeReportsWithIdentifiers: (NSArray *) identifiers error: (NSError **) outError;
+
+@end
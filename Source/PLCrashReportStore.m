@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "CrashReporter.h"
+
+#import "PLCrashReportStore.h"
+#import "PLCrashReportQueueIndex.h"
+#import "PLCrashPendingReportInfo.h"
+#import "PLCrashReporterNSError.h"
+
+#import <stdio.h>
+#import <errno.h>
+
+/** @internal
+ * Stored report file extension. */
+static NSString *PLCrashReportStoreReportExtension = @"plcrash";
+
+/** @internal
+ * Partially written report file extension. Such files are not indexed, and are renamed into place once complete. */
+static NSString *PLCrashReportStoreTemporaryExtension = @"tmp";
+
+@interface PLCrashReportStore (PrivateMethods)
+
+- (NSString *) newIdentifier;
+- (NSArray *) enforceBudgets;
+
+@end
+
+/**
+ * @internal
+ *
+ * A bounded store of pending crash reports.
+ *
+ * Reports are published into the store by renaming a completed report file into the store directory under a new,
+ * unique identifier; a report is thus either entirely present in the store, or absent. Partially written reports
+ * (with a ".tmp" extension) are never indexed.
+ *
+ * The store is bounded by report count, total size, and age. Budgets are enforced whenever a report is published
+ * and whenever the stored reports are queried: reports older than the maximum age are evicted first, after which,
+ * while the store exceeds its count or size budget, the oldest report duplicating the signature of a newer stored
+ * report is evicted, followed by the oldest remaining report.
+ *
+ * All methods are thread-safe.
+ */
+@implementation PLCrashReportStore
+
+/**
+ * Initialize a new store.
+ *
+ * @param directory The directory containing the stored reports. The directory is created on first publish.
+ * @param indexPath The path at which the store's index will be persisted. The path should not be within @a directory.
+ * @param maxCount The maximum number of retained reports, or 0 if the number of reports should not be limited.
+ * @param maxBytes The maximum total size of the retained reports, in bytes, or 0 if the total size should not be
+ * limited.
+ * @param maxAge The maximum age of a retained report, or 0 if reports should not expire.
+ */
+- (id) initWithDirectory: (NSString *) directory
+               indexPath: (NSString *) indexPath
+                maxCount: (NSUInteger) maxCount
+                maxBytes: (NSUInteger) maxBytes
+                  maxAge: (NSTimeInterval) maxAge
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _directory = [directory copy];
+    _index = [[PLCrashReportQueueIndex alloc] initWithDirectory: directory path: indexPath];
+    _maxCount = maxCount;
+    _maxBytes = maxBytes;
+    _maxAge = maxAge;
+
+    return self;
+}
+
+- (void) dealloc {
+    [_directory release];
+    [_index release];
+
+    [super dealloc];
+}
+
+/**
+ * Atomically move the completed report at @a path into the store, and then enforce the store's budgets. The
+ * report must reside on the same volume as the store.
+ *
+ * @param path The path of the completed report.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the report could not be published. If no error occurs, this parameter will be left
+ * unmodified. You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns the report's identifier, or nil if the report could not be published. The report may be
+ * immediately evicted if it alone exceeds the store's budgets.
+ */
+- (NSString *) publishReportAtPath: (NSString *) path error: (NSError **) outError {
+    if (![[NSFileManager defaultManager] createDirectoryAtPath: _directory withIntermediateDirectories: YES attributes: nil error: outError])
+        return nil;
+
+    NSString *identifier = [[self newIdentifier] autorelease];
+    NSString *target = [_directory stringByAppendingPathComponent: identifier];
+    if (rename([path fileSystemRepresentation], [target fileSystemRepresentation]) != 0) {
+        plcrash_populate_posix_error(outError, errno, @"Could not move the crash report into the pending report store");
+        return nil;
+    }
+
+    [self enforceBudgets];
+    return identifier;
+}
+
+/**
+ * Atomically write @a data to the store as a new report, and then enforce the store's budgets.
+ *
+ * @param data The report data.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the report could not be published. If no error occurs, this parameter will be left
+ * unmodified. You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns the report's identifier, or nil if the report could not be published.
+ */
+- (NSString *) publishReportData: (NSData *) data error: (NSError **) outError {
+    if (![[NSFileManager defaultManager] createDirectoryAtPath: _directory withIntermediateDirectories: YES attributes: nil error: outError])
+        return nil;
+
+    /* The report is written under a temporary name that will not be indexed, and then renamed into place */
+    NSString *identifier = [[self newIdentifier] autorelease];
+    NSString *path = [[_directory stringByAppendingPathComponent: identifier] stringByAppendingPathExtension: PLCrashReportStoreTemporaryExtension];
+    if (![data writeToFile: path options: 0 error: outError]) {
+        [[NSFileManager defaultManager] removeItemAtPath: path error: NULL];
+        return nil;
+    }
+
+    NSString *result = [self publishReportAtPath: path error: outError];
+    if (result == nil)
+        [[NSFileManager defaultManager] removeItemAtPath: path error: NULL];
+
+    return result;
+}
+
+/**
+ * Enforce the store's budgets, and return the retained reports, as PLCrashPendingReportInfo instances ordered by
+ * report date.
+ */
+- (NSArray *) reports {
+    return [self enforceBudgets];
+}
+
+/**
+ * Return the path of the report with @a identifier, or nil if @a identifier is not a valid report identifier. The
+ * report may not exist.
+ *
+ * @param identifier A report identifier, as returned via PLCrashReportStore::reports.
+ */
+- (NSString *) pathForIdentifier: (NSString *) identifier {
+    if ([identifier length] == 0 || ![[identifier lastPathComponent] isEqualToString: identifier])
+        return nil;
+
+    return [_directory stringByAppendingPathComponent: identifier];
+}
+
+/**
+ * Remove the reports with the given identifiers from the store.
+ *
+ * @param identifiers The identifiers of the reports to be removed.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the reports could not be removed. If no error occurs, this parameter will be left
+ * unmodified. You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO if any report could not be removed. Reports preceding the failed report
+ * will have been removed.
+ */
+- (BOOL) removeReportsWithIdentifiers: (NSArray *) identifiers error: (NSError **) outError {
+    NSMutableArray *removed = [NSMutableArray arrayWithCapacity: [identifiers count]];
+    BOOL success = YES;
+
+    for (NSString *identifier in identifiers) {
+        NSString *path = [self pathForIdentifier: identifier];
+        if (path == nil) {
+            plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Invalid pending crash report identifier", nil);
+            success = NO;
+            break;
+        }
+
+        if (![[NSFileManager defaultManager] removeItemAtPath: path error: outError]) {
+            success = NO;
+            break;
+        }
+
+        [removed addObject: identifier];
+    }
+
+    [_index removeEntriesWithIdentifiers: removed];
+    return success;
+}
+
+@end
+
+/**
+ * @internal
+ */
+@implementation PLCrashReportStore (PrivateMethods)
+
+/**
+ * Return a new, unique report identifier. The caller is responsible for releasing the returned string.
+ */
+- (NSString *) newIdentifier {
+    CFUUIDRef uuid = CFUUIDCreate(NULL);
+    NSString *uuidString = (NSString *) CFUUIDCreateString(NULL, uuid);
+    CFRelease(uuid);
+
+    NSString *identifier = [[uuidString stringByAppendingPathExtension: PLCrashReportStoreReportExtension] retain];
+    [uuidString release];
+
+    return identifier;
+}
+
+/**
+ * Evict reports until the store is within its budgets, and return the retained reports.
+ */
+- (NSArray *) enforceBudgets {
+    @synchronized (self) {
+        NSMutableArray *retained = [[[_index entries] mutableCopy] autorelease];
+        NSMutableArray *evicted = [NSMutableArray array];
+
+        /* Expired reports are evicted unconditionally */
+        if (_maxAge > 0) {
+            NSDate *cutoff = [NSDate dateWithTimeIntervalSinceNow: -_maxAge];
+            for (PLCrashPendingReportInfo *info in retained) {
+                if ([[info date] compare: cutoff] == NSOrderedAscending)
+                    [evicted addObject: info];
+            }
+            [retained removeObjectsInArray: evicted];
+        }
+
+        /* Tally the remaining reports */
+        uint64_t totalBytes = 0;
+        NSCountedSet *signatures = [NSCountedSet set];
+        for (PLCrashPendingReportInfo *info in retained) {
+            totalBytes += [info size];
+            if ([info hasSignature])
+                [signatures addObject: [NSNumber numberWithUnsignedLongLong: [info signature]]];
+        }
+
+        /* Evict by priority until the count and size budgets are met. The reports are ordered oldest first, and so
+         * the first report whose signature is shared by another retained report always has a newer duplicate. */
+        while ([retained count] > 0 && ((_maxCount > 0 && [retained count] > _maxCount) || (_maxBytes > 0 && totalBytes > _maxBytes))) {
+            NSUInteger victim = 0;
+            for (NSUInteger i = 0; i < [retained count]; i++) {
+                PLCrashPendingReportInfo *info = [retained objectAtIndex: i];
+                if ([info hasSignature] && [signatures countForObject: [NSNumber numberWithUnsignedLongLong: [info signature]]] > 1) {
+                    victim = i;
+                    break;
+                }
+            }
+
+            PLCrashPendingReportInfo *info = [retained objectAtIndex: victim];
+            totalBytes -= [info size];
+            if ([info hasSignature])
+                [signatures removeObject: [NSNumber numberWithUnsignedLongLong: [info signature]]];
+
+            [evicted addObject: info];
+            [retained removeObjectAtIndex: victim];
+        }
+
+        if ([evicted count] == 0)
+            return retained;
+
+        /* Remove the evicted reports. A report that can not be removed is left in the index, and eviction is retried on
+         * next use. */
+        NSMutableArray *removed = [NSMutableArray arrayWithCapacity: [evicted count]];
+        for (PLCrashPendingReportInfo *info in evicted) {
+            NSError *error = nil;
+            NSString *path = [_directory stringByAppendingPathComponent: [info identifier]];
+            if ([[NSFileManager defaultManager] removeItemAtPath: path error: &error] || ![[NSFileManager defaultManager] fileExistsAtPath: path])
+                [removed addObject: [info identifier]];
+            else
+                NSLog(@"Could not evict pending crash report %@: %@", [info identifier], error);
+        }
+        [_index removeEntriesWithIdentifiers: removed];
+
+        return retained;
+    }
+}
+
+@end
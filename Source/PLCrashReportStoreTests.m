@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReportStore.h"
+#import "PLCrashPendingReportInfo.h"
+
+#import <sys/time.h>
+
+@interface PLCrashReportStoreTests : SenTestCase {
+@private
+    /** Test root directory. */
+    NSString *_root;
+
+    /** Store directory. */
+    NSString *_directory;
+
+    /** Index path. */
+    NSString *_indexPath;
+}
+@end
+
+@implementation PLCrashReportStoreTests
+
+- (void) setUp {
+    _root = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+    _directory = [[_root stringByAppendingPathComponent: @"reports"] retain];
+    _indexPath = [[_root stringByAppendingPathComponent: @"index.plist"] retain];
+    STAssertTrue([[NSFileManager defaultManager] createDirectoryAtPath: _root withIntermediateDirectories: YES attributes: nil error: NULL], @"Could not create test directory");
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _root error: NULL];
+    [_root release];
+    [_directory release];
+    [_indexPath release];
+}
+
+/* Return a new store over the test directory */
+- (PLCrashReportStore *) storeWithMaxCount: (NSUInteger) maxCount maxBytes: (NSUInteger) maxBytes maxAge: (NSTimeInterval) maxAge {
+    return [[[PLCrashReportStore alloc] initWithDirectory: _directory indexPath: _indexPath maxCount: maxCount maxBytes: maxBytes maxAge: maxAge] autorelease];
+}
+
+/* Write a report of @a size bytes, last modified @a age seconds ago, and publish it to @a store */
+- (NSString *) publishToStore: (PLCrashReportStore *) store size: (NSUInteger) size age: (time_t) age {
+    NSString *path = [_root stringByAppendingPathComponent: @"report.tmp"];
+    STAssertTrue([[NSMutableData dataWithLength: size] writeToFile: path atomically: NO], @"Could not write report");
+
+    struct timeval times[2];
+    gettimeofday(&times[0], NULL);
+    times[0].tv_sec -= age;
+    times[1] = times[0];
+    STAssertEquals(utimes([path fileSystemRepresentation], times), 0, @"Could not set report modification time");
+
+    NSError *error = nil;
+    NSString *identifier = [store publishReportAtPath: path error: &error];
+    STAssertNotNil(identifier, @"Could not publish report: %@", error);
+    STAssertFalse([[NSFileManager defaultManager] fileExistsAtPath: path], @"Report was not moved into the store");
+    return identifier;
+}
+
+/**
+ * Verify that published reports are stored and may be removed.
+ */
+- (void) testPublish {
+    PLCrashReportStore *store = [self storeWithMaxCount: 0 maxBytes: 0 maxAge: 0];
+
+    NSError *error = nil;
+    NSString *identifier = [store publishReportData: [NSMutableData dataWithLength: 16] error: &error];
+    STAssertNotNil(identifier, @"Could not publish report: %@", error);
+    STAssertTrue([[NSFileManager defaultManager] fileExistsAtPath: [store pathForIdentifier: identifier]], @"Report was not written");
+
+    NSArray *reports = [store reports];
+    STAssertEquals([reports count], (NSUInteger) 1, @"Incorrect report count");
+    STAssertEqualObjects([[reports objectAtIndex: 0] identifier], identifier, @"Incorrect identifier");
+    STAssertEquals([[reports objectAtIndex: 0] size], (uint64_t) 16, @"Incorrect size");
+
+    STAssertTrue([store removeReportsWithIdentifiers: [NSArray arrayWithObject: identifier] error: &error], @"Could not remove report: %@", error);
+    STAssertEquals([[store reports] count], (NSUInteger) 0, @"Report was not removed");
+
+    STAssertNil([store pathForIdentifier: @"../escape.plcrash"], @"Accepted an invalid identifier");
+}
+
+/**
+ * Verify that the oldest reports are evicted once the count budget is exceeded.
+ */
+- (void) testCountBudget {
+    PLCrashReportStore *store = [self storeWithMaxCount: 2 maxBytes: 0 maxAge: 0];
+    [self publishToStore: store size: 10 age: 30];
+    NSString *second = [self publishToStore: store size: 10 age: 20];
+    NSString *third = [self publishToStore: store size: 10 age: 10];
+
+    NSArray *reports = [store reports];
+    STAssertEquals([reports count], (NSUInteger) 2, @"Incorrect report count");
+    STAssertEqualObjects([[reports objectAtIndex: 0] identifier], second, @"Incorrect report retained");
+    STAssertEqualObjects([[reports objectAtIndex: 1] identifier], third, @"Incorrect report retained");
+}
+
+/**
+ * Verify that the oldest reports are evicted once the size budget is exceeded.
+ */
+- (void) testSizeBudget {
+    PLCrashReportStore *store = [self storeWithMaxCount: 0 maxBytes: 100 maxAge: 0];
+    [self publishToStore: store size: 60 age: 20];
+    NSString *newest = [self publishToStore: store size: 60 age: 10];
+
+    NSArray *reports = [store reports];
+    STAssertEquals([reports count], (NSUInteger) 1, @"Incorrect report count");
+    STAssertEqualObjects([[reports objectAtIndex: 0] identifier], newest, @"Incorrect report retained");
+}
+
+/**
+ * Verify that expired reports are evicted.
+ */
+- (void) testAgeBudget {
+    PLCrashReportStore *store = [self storeWithMaxCount: 0 maxBytes: 0 maxAge: 3600];
+    [self publishToStore: store size: 10 age: 7200];
+    NSString *recent = [self publishToStore: store size: 10 age: 60];
+
+    NSArray *reports = [store reports];
+    STAssertEquals([reports count], (NSUInteger) 1, @"Incorrect report count");
+    STAssertEqualObjects([[reports objectAtIndex: 0] identifier], recent, @"Incorrect report retained");
+}
+
+@end
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashReportSummary.h"
+#include "PLCrashReportSignature.h"
+#include "PLCrashAsyncCompressor.h"
+#include "PLCrashAsyncProtobufReader.h"
+#include "PLCrashReportFieldIDs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_report_summary
+ * @{
+ */
+
+/**
+ * Copy the string field @a field to @a dest, truncating it to PLCRASH_REPORT_SUMMARY_STRING_MAX - 1 bytes.
+ */
+static void copy_string (char dest[PLCRASH_REPORT_SUMMARY_STRING_MAX], const plcrash_async_pb_field_t *field) {
+    if (field->wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+        return;
+
+    size_t len = field->data.end - field->data.p;
+    if (len > PLCRASH_REPORT_SUMMARY_STRING_MAX - 1)
+        len = PLCRASH_REPORT_SUMMARY_STRING_MAX - 1;
+
+    memcpy(dest, field->data.p, len);
+    dest[len] = '\0';
+}
+
+/**
+ * Copy the string field @a field_id of the message @a message to @a dest. Returns false if the message is invalid.
+ */
+static bool scan_string (plcrash_async_pb_reader_t message, uint32_t field_id, char dest[PLCRASH_REPORT_SUMMARY_STRING_MAX]) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&message, &field)) == PLCRASH_ESUCCESS) {
+        if (field.id == field_id)
+            copy_string(dest, &field);
+    }
+
+    return (err == PLCRASH_ENOTFOUND);
+}
+
+/**
+ * Count the frames of @a thread, without decoding them. Frames are either written as individual frame messages, or
+ * as a single packed array of delta-encoded PCs. Returns false if the thread record is invalid.
+ */
+static bool count_frames (plcrash_async_pb_reader_t thread, uint64_t *count) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&thread, &field)) == PLCRASH_ESUCCESS) {
+        if (field.wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+            continue;
+
+        if (field.id == PLCRASH_PROTO_THREAD_FRAMES_ID) {
+            (*count)++;
+        } else if (field.id == PLCRASH_PROTO_THREAD_FRAME_PCS_ID) {
+            /* Each packed varint is terminated by a byte with the high bit clear */
+            for (const uint8_t *p = field.data.p; p < field.data.end; p++) {
+                if ((*p & 0x80) == 0)
+                    (*count)++;
+            }
+        }
+    }
+
+    return (err == PLCRASH_ENOTFOUND);
+}
+
+/**
+ * Summarize the unframed report message @a message.
+ */
+static plcrash_error_t compute_summary (plcrash_async_pb_reader_t message, plcrash_report_summary_t *summary) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&message, &field)) == PLCRASH_ESUCCESS) {
+        if (field.wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+            continue;
+
+        bool valid = true;
+        switch (field.id) {
+            case PLCRASH_PROTO_SYSTEM_INFO_ID:
+                valid = scan_string(field.data, PLCRASH_PROTO_SYSTEM_INFO_OS_VERSION_ID, summary->os_version);
+                break;
+
+            case PLCRASH_PROTO_MACHINE_INFO_ID:
+                valid = scan_string(field.data, PLCRASH_PROTO_MACHINE_INFO_MODEL_ID, summary->model);
+                break;
+
+            case PLCRASH_PROTO_SIGNAL_ID:
+                valid = scan_string(field.data, PLCRASH_PROTO_SIGNAL_NAME_ID, summary->signal);
+                break;
+
+            case PLCRASH_PROTO_THREADS_ID:
+                summary->thread_count++;
+                valid = count_frames(field.data, &summary->frame_count);
+                break;
+
+            default:
+                break;
+        }
+
+        if (!valid) {
+            PLCF_DEBUG("Invalid record %u in crash report", (unsigned int) field.id);
+            return PLCRASH_EINVAL;
+        }
+    }
+
+    if (err != PLCRASH_ENOTFOUND) {
+        PLCF_DEBUG("Invalid crash report encoding");
+        return PLCRASH_EINVAL;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Summarize the encoded crash report @a data. Compressed reports are transparently decompressed.
+ *
+ * @param data The encoded crash report, including the crash log file header.
+ * @param length The length of @a data.
+ * @param frame_count The maximum number of crashed thread frames to include in the report signature.
+ * @param summary On success, the report summary.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if the report data is invalid. A report that does
+ * not contain a crashed thread is summarized without a signature.
+ */
+plcrash_error_t plcrash_nasync_report_summary (const void *data, size_t length, uint32_t frame_count, plcrash_report_summary_t *summary) {
+    /* Decompress the report, if necessary */
+    if (plcrash_async_compressor_is_compressed(data, length)) {
+        uint8_t *decoded;
+        size_t decoded_length;
+        plcrash_error_t err;
+
+        if ((err = plcrash_nasync_compressor_decode(data, length, &decoded, &decoded_length)) != PLCRASH_ESUCCESS)
+            return err;
+
+        err = plcrash_nasync_report_summary(decoded, decoded_length, frame_count, summary);
+        free(decoded);
+        return err;
+    }
+
+    memset(summary, 0, sizeof(*summary));
+
+    /* Validate the file header */
+    plcrash_async_pb_reader_t message;
+    plcrash_error_t err;
+    if ((err = plcrash_async_pb_reader_init_report(&message, data, length)) != PLCRASH_ESUCCESS)
+        return err;
+
+    if ((err = compute_summary(message, summary)) != PLCRASH_ESUCCESS)
+        return err;
+
+    /* Compute the signature; the report's encoding has already been validated */
+    err = plcrash_nasync_report_signature(data, length, frame_count, &summary->signature);
+    if (err == PLCRASH_ESUCCESS) {
+        summary->has_signature = true;
+    } else if (err != PLCRASH_ENOTFOUND) {
+        return err;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @}
+ */
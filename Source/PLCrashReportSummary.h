@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_REPORT_SUMMARY_H
+#define PLCRASH_REPORT_SUMMARY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_report_summary Crash Report Summaries
+ * @ingroup plcrash_internal
+ *
+ * Extracts the values used to aggregate large numbers of crash reports (the OS version, device model,
+ * signal, thread and frame counts, and deduplication signature) directly from an encoded crash report.
+ *
+ * Only the system info, machine info, signal and thread records are examined, and frames are counted without
+ * being decoded; no intermediate report objects are allocated.
+ *
+ * @{
+ */
+
+/** The maximum length of a summary string value, including the terminating NUL. Longer values are truncated. */
+#define PLCRASH_REPORT_SUMMARY_STRING_MAX 64
+
+/**
+ * A crash report summary.
+ */
+typedef struct plcrash_report_summary {
+    /** The OS version, or an empty string if unavailable. */
+    char os_version[PLCRASH_REPORT_SUMMARY_STRING_MAX];
+
+    /** The device model, or an empty string if unavailable. */
+    char model[PLCRASH_REPORT_SUMMARY_STRING_MAX];
+
+    /** The signal name, or an empty string if unavailable. */
+    char signal[PLCRASH_REPORT_SUMMARY_STRING_MAX];
+
+    /** If true, the report contains a crashed thread, and @a signature is valid. */
+    bool has_signature;
+
+    /** The report signature; see plcrash_nasync_report_signature(). */
+    uint64_t signature;
+
+    /** The number of threads in the report. */
+    uint32_t thread_count;
+
+    /** The total number of frames across all of the report's threads. */
+    uint64_t frame_count;
+} plcrash_report_summary_t;
+
+plcrash_error_t plcrash_nasync_report_summary (const void *data, size_t length, uint32_t frame_count, plcrash_report_summary_t *summary);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_REPORT_SUMMARY_H */
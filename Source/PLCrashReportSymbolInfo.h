@@ -27,6 +27,7 @@
  */
 
 #import <Foundation/Foundation.h>
+#import "PLCrashReportInlinedFrameInfo.h"
 
 @interface PLCrashReportSymbolInfo : NSObject {
 @private
@@ -38,12 +39,34 @@
     
     /** The symbol end address, if explicitly defined. Will be 0 if unknown. */
     uint64_t _endAddress;
+
+    /** The source file path, or nil if unknown. */
+    NSString *_sourceFile;
+
+    /** The source line number, or 0 if unknown. */
+    uint32_t _sourceLine;
+
+    /** The functions inlined at the frame's address, innermost first. */
+    NSArray *_inlinedFrames;
 }
 
 - (id) initWithSymbolName: (NSString *) symbolName
              startAddress: (uint64_t) startAddress
                endAddress: (uint64_t) endAddress;
 
+- (id) initWithSymbolName: (NSString *) symbolName
+             startAddress: (uint64_t) startAddress
+               endAddress: (uint64_t) endAddress
+               sourceFile: (NSString *) sourceFile
+               sourceLine: (uint32_t) sourceLine;
+
+- (id) initWithSymbolName: (NSString *) symbolName
+             startAddress: (uint64_t) startAddress
+               endAddress: (uint64_t) endAddress
+               sourceFile: (NSString *) sourceFile
+               sourceLine: (uint32_t) sourceLine
+            inlinedFrames: (NSArray *) inlinedFrames;
+
 /** The symbol name. */
 @property(nonatomic, readonly) NSString *symbolName;
 
@@ -58,4 +81,23 @@
  */
 @property(nonatomic, readonly) uint64_t endAddress;
 
+/* The source file path of the frame's address. This is only available for reports that have been symbolicated
+ * offline using DWARF debugging information.
+ *
+ * If unknown, the path will be nil.
+ */
+@property(nonatomic, readonly) NSString *sourceFile;
+
+/** The source line number of the frame's address, or 0 if unknown. */
+@property(nonatomic, readonly) uint32_t sourceLine;
+
+/* The functions inlined at the frame's address, as PLCrashReportInlinedFrameInfo instances, innermost first. The
+ * first inlined function is positioned at sourceFile and sourceLine; each subsequent function, and finally this
+ * symbol, is positioned at the call site of the preceding inlined function. This is only available for reports that
+ * have been symbolicated offline using DWARF debugging information.
+ *
+ * If the frame's address is not within an inlined function, the array will be empty.
+ */
+@property(nonatomic, readonly) NSArray *inlinedFrames;
+
 @end
@@ -36,6 +36,9 @@
 @synthesize symbolName = _symbolName;
 @synthesize startAddress = _startAddress;
 @synthesize endAddress = _endAddress;
+@synthesize sourceFile = _sourceFile;
+@synthesize sourceLine = _sourceLine;
+@synthesize inlinedFrames = _inlinedFrames;
 
 /**
  * Initialize with the provided symbol info.
@@ -48,6 +51,45 @@
 - (id) initWithSymbolName: (NSString *) symbolName
              startAddress: (uint64_t) startAddress
                endAddress: (uint64_t) endAddress
+{
+    return [self initWithSymbolName: symbolName startAddress: startAddress endAddress: endAddress sourceFile: nil sourceLine: 0];
+}
+
+/**
+ * Initialize with the provided symbol and source position info.
+ *
+ * @param symbolName The symbol name.
+ * @param startAddress The symbol start address.
+ * @param endAddress The symbol end address, if available; otherwise, 0.
+ * @param sourceFile The source file path, if available; otherwise, nil.
+ * @param sourceLine The source line number, if available; otherwise, 0.
+ */
+- (id) initWithSymbolName: (NSString *) symbolName
+             startAddress: (uint64_t) startAddress
+               endAddress: (uint64_t) endAddress
+               sourceFile: (NSString *) sourceFile
+               sourceLine: (uint32_t) sourceLine
+{
+    return [self initWithSymbolName: symbolName startAddress: startAddress endAddress: endAddress sourceFile: sourceFile sourceLine: sourceLine inlinedFrames: nil];
+}
+
+/**
+ * Initialize with the provided symbol, source position and inlined function info.
+ *
+ * @param symbolName The symbol name.
+ * @param startAddress The symbol start address.
+ * @param endAddress The symbol end address, if available; otherwise, 0.
+ * @param sourceFile The source file path, if available; otherwise, nil.
+ * @param sourceLine The source line number, if available; otherwise, 0.
+ * @param inlinedFrames The PLCrashReportInlinedFrameInfo instances describing the functions inlined at the frame's
+ * address, innermost first, or nil if none.
+ */
+- (id) initWithSymbolName: (NSString *) symbolName
+             startAddress: (uint64_t) startAddress
+               endAddress: (uint64_t) endAddress
+               sourceFile: (NSString *) sourceFile
+               sourceLine: (uint32_t) sourceLine
+            inlinedFrames: (NSArray *) inlinedFrames
 {
     if ((self = [super init]) == nil)
         return nil;
@@ -55,12 +97,17 @@
     _symbolName = [symbolName retain];
     _startAddress = startAddress;
     _endAddress = endAddress;
+    _sourceFile = [sourceFile retain];
+    _sourceLine = sourceFile != nil ? sourceLine : 0;
+    _inlinedFrames = inlinedFrames != nil ? [inlinedFrames copy] : [[NSArray alloc] init];
 
     return self;
 }
 
 - (void) dealloc {
     [_symbolName release];
+    [_sourceFile release];
+    [_inlinedFrames release];
 
     [super dealloc];
 }
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <pthread.h>
+
+@interface PLCrashReportSymbolicator : NSObject {
+@private
+    /** Paths searched for Mach-O binaries and dSYMs. */
+    NSArray *_searchPaths;
+
+    /** Directory in which symbol stores are cached. */
+    NSString *_cachePath;
+
+    /** Map of image UUID strings to the binary or dSYM files containing them. Built on first use. */
+    NSMutableDictionary *_binaries;
+
+    /** Map of image UUID strings to opened symbol stores, or NSNull if no symbols are available. */
+    NSMutableDictionary *_stores;
+
+    /** Cache of symbol lookup results by image UUID and offset, shared by all threads. */
+    struct plcrash_symbol_resolution_cache *_resolutionCache;
+
+    /** Held for reading while a report is symbolicated, and for writing while stores are evicted. */
+    pthread_rwlock_t _storeLock;
+    BOOL _storeLockInitialized;
+
+    /** The total mapped size of all opened stores, and the size above which stores are evicted, or 0 if unlimited. */
+    size_t _mappedStoreSize;
+    size_t _mappedStoreLimit;
+
+    /** Incremented for each symbolicated report; used to find the least recently used stores. */
+    volatile int64_t _generation;
+
+    /** If YES, assigned symbol names are demangled. */
+    BOOL _demangleSymbols;
+}
+
+- (id) initWithSearchPaths: (NSArray *) searchPaths cachePath: (NSString *) cachePath;
+- (id) initWithSearchPaths: (NSArray *) searchPaths cachePath: (NSString *) cachePath mappedStoreLimit: (size_t) mappedStoreLimit;
+
+- (NSData *) symbolicateCrashData: (NSData *) data error: (NSError **) outError;
+
+- (NSArray *) indexSearchPaths: (NSError **) outError;
+- (NSArray *) indexSharedCacheAtPath: (NSString *) path error: (NSError **) outError;
+
+/**
+ * The files and directories searched for Mach-O binaries and dSYMs.
+ */
+@property(nonatomic, readonly) NSArray *searchPaths;
+
+/**
+ * The directory in which per-image symbol stores are cached.
+ */
+@property(nonatomic, readonly) NSString *cachePath;
+
+/**
+ * The total size, in bytes, of the symbol stores that may remain mapped once a report has been symbolicated, or 0
+ * if opened stores are never closed.
+ */
+@property(nonatomic, readonly) size_t mappedStoreLimit;
+
+/**
+ * If YES, mangled C++ and Swift symbol names are demangled before being assigned to frames. Demangled names are
+ * cached for the lifetime of the process, and shared with PLCrashReportTextFormatter. Defaults to NO.
+ */
+@property(nonatomic, assign) BOOL demangleSymbols;
+
+@end
@@ -0,0 +1,806 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "CrashReporter.h"
+
+#import "PLCrashReportSymbolicator.h"
+#import "PLCrashReporterNSError.h"
+#import "PLCrashAsyncCompressor.h"
+#import "PLCrashSymbolStore.h"
+#import "PLCrashSymbolResolutionCache.h"
+#import "PLCrashDemangleCache.h"
+#import "PLCrashDyldSharedCache.h"
+#import "PLCrashAsyncProtobufReader.h"
+
+#import "crash_report.pb-c.h"
+
+#import <libkern/OSAtomic.h>
+
+/**
+ * @internal
+ *
+ * Return the lowercase hex representation of @a uuid, matching PLCrashReportBinaryImageInfo::imageUUID.
+ */
+static NSString *uuid_string (const uint8_t uuid[16]) {
+    const char hex[] = "0123456789abcdef";
+    char output[32];
+
+    for (size_t i = 0; i < 16; i++) {
+        output[i * 2 + 0] = hex[uuid[i] >> 4];
+        output[i * 2 + 1] = hex[uuid[i] & 0x0F];
+    }
+
+    return [[[NSString alloc] initWithBytes: output length: sizeof(output) encoding: NSASCIIStringEncoding] autorelease];
+}
+
+/**
+ * @internal
+ *
+ * Parse the hex representation of a UUID, as returned by uuid_string(). Returns NO if @a string is not a valid UUID.
+ */
+static BOOL uuid_bytes (NSString *string, uint8_t uuid[16]) {
+    const char *hex = [string UTF8String];
+    if (hex == NULL || strlen(hex) != 32)
+        return NO;
+
+    for (size_t i = 0; i < 16; i++) {
+        unsigned int byte;
+        if (sscanf(hex + (i * 2), "%2x", &byte) != 1)
+            return NO;
+        uuid[i] = (uint8_t) byte;
+    }
+
+    return YES;
+}
+
+/**
+ * @internal
+ *
+ * An opened symbol store. The store is the first member, so that the plcrash_symbol_store_t pointers held by the
+ * resolution cache may be mapped back to their entry.
+ */
+typedef struct symbolicator_store {
+    /** The mapped store. */
+    plcrash_symbol_store_t store;
+
+    /** The symbolicator generation in which the store was last used. */
+    volatile int64_t last_used;
+} symbolicator_store_t;
+
+/**
+ * @internal
+ *
+ * plcrash_nasync_symbol_store_image_uuids() context used when cataloging the search paths.
+ */
+struct catalog_ctx {
+    /** The UUID to path map. */
+    NSMutableDictionary *binaries;
+
+    /** The path currently being scanned. */
+    NSString *path;
+};
+
+/* Catalog callback; dSYM files are preferred, as they include the local symbols that may be stripped from the binary. */
+static void catalog_image_cb (const uint8_t uuid[16], cpu_type_t cputype, cpu_subtype_t cpusubtype, void *ctx) {
+    struct catalog_ctx *cctx = ctx;
+    NSString *key = uuid_string(uuid);
+    NSString *existing = [cctx->binaries objectForKey: key];
+
+    if (existing == nil || ([existing rangeOfString: @".dSYM/"].location == NSNotFound && [cctx->path rangeOfString: @".dSYM/"].location != NSNotFound))
+        [cctx->binaries setObject: cctx->path forKey: key];
+}
+
+/**
+ * @internal
+ *
+ * plcrash_nasync_dyld_shared_cache_images() context used when indexing a shared cache.
+ */
+struct shared_cache_ctx {
+    /** The cache being indexed. */
+    plcrash_dyld_shared_cache_t *cache;
+
+    /** The symbolicator whose cache directory the stores are written to. */
+    PLCrashReportSymbolicator *symbolicator;
+
+    /** The UUIDs of all images for which a store was written. */
+    NSMutableArray *indexed;
+
+    /** The symbols of the image currently being indexed, and the number allocated. */
+    plcrash_symbol_store_symbol_t *symbols;
+    size_t count;
+    size_t capacity;
+
+    /** The __TEXT address of the image currently being indexed. */
+    uint64_t text_vmaddr;
+};
+
+/* Shared cache symbol callback; rebases each symbol on the image header */
+static void shared_cache_symbol_cb (uint64_t address, const char *name, void *ctx) {
+    struct shared_cache_ctx *sctx = ctx;
+
+    if (address < sctx->text_vmaddr)
+        return;
+
+    if (sctx->count == sctx->capacity) {
+        size_t capacity = sctx->capacity == 0 ? 1024 : sctx->capacity * 2;
+        plcrash_symbol_store_symbol_t *resized = realloc(sctx->symbols, capacity * sizeof(*resized));
+        if (resized == NULL)
+            return;
+
+        sctx->symbols = resized;
+        sctx->capacity = capacity;
+    }
+
+    sctx->symbols[sctx->count].address = address - sctx->text_vmaddr;
+    sctx->symbols[sctx->count].name = name;
+    sctx->count++;
+}
+
+@interface PLCrashReportSymbolicator (PrivateMethods)
+
+- (void) catalogSearchPaths;
+- (NSString *) storePathForUUID: (NSString *) uuid;
+- (void) indexSharedCacheImage: (const plcrash_dyld_shared_cache_image_t *) image context: (struct shared_cache_ctx *) ctx;
+- (BOOL) buildStoreForUUID: (const uint8_t *) uuid path: (NSString *) storePath;
+- (plcrash_symbol_store_t *) storeForUUID: (const uint8_t *) uuid;
+- (BOOL) symbolicateFrame: (Plcrash__CrashReport__Thread__StackFrame *) frame report: (Plcrash__CrashReport *) report returnAddress: (BOOL) returnAddress;
+- (BOOL) expandPackedFrames: (Plcrash__CrashReport__Thread *) thread;
+- (void) evictStores;
+- (char *) copySymbolName: (const char *) name;
+
+@end
+
+/* Shared cache image callback */
+static void shared_cache_image_cb (const plcrash_dyld_shared_cache_image_t *image, void *ctx) {
+    struct shared_cache_ctx *sctx = ctx;
+    [sctx->symbolicator indexSharedCacheImage: image context: sctx];
+}
+
+/**
+ * Symbolicates crash reports after the fact, using the symbol tables of the Mach-O binaries and dSYMs
+ * found in a set of search paths.
+ *
+ * Reports captured using PLCrashReporterSymbolicationStrategyNone contain only frame addresses. For each frame
+ * without a symbol, the containing image is identified by its UUID, and the symbol is resolved via an address-sorted
+ * symbol store built from the image's symbol table. Stores are cached on disk by image UUID and memory-mapped on use,
+ * so each image is indexed only once, across any number of reports and runs. System images, which are not available
+ * as standalone binaries, may be indexed ahead of time from a dyld shared cache via indexSharedCacheAtPath:error:.
+ *
+ * Lookup results are additionally cached in memory by image UUID and offset, so that an address recurring across
+ * the reports of a batch is resolved only once.
+ *
+ * By default, opened stores remain mapped for the lifetime of the symbolicator. A long-lived symbolicator may instead
+ * be given a mapped store limit; once a report has been symbolicated, the least recently used stores are closed
+ * (and their cached lookup results discarded) until the total mapped size is within the limit.
+ *
+ * A single symbolicator may be used concurrently from multiple threads.
+ */
+@implementation PLCrashReportSymbolicator
+
+@synthesize searchPaths = _searchPaths;
+@synthesize cachePath = _cachePath;
+@synthesize mappedStoreLimit = _mappedStoreLimit;
+@synthesize demangleSymbols = _demangleSymbols;
+
+/**
+ * Initialize a new symbolicator. Opened symbol stores remain mapped for the lifetime of the symbolicator.
+ *
+ * @param searchPaths The files and directories to be searched for Mach-O binaries and dSYMs. Directories are
+ * searched recursively. The search paths are only scanned if an image's symbol store is not already cached.
+ * @param cachePath The directory in which per-image symbol stores will be cached. The directory will be created
+ * if it does not exist.
+ */
+- (id) initWithSearchPaths: (NSArray *) searchPaths cachePath: (NSString *) cachePath {
+    return [self initWithSearchPaths: searchPaths cachePath: cachePath mappedStoreLimit: 0];
+}
+
+/**
+ * Initialize a new symbolicator, bounding the total size of the symbol stores that remain mapped between reports.
+ *
+ * @param searchPaths The files and directories to be searched for Mach-O binaries and dSYMs. Directories are
+ * searched recursively. The search paths are only scanned if an image's symbol store is not already cached.
+ * @param cachePath The directory in which per-image symbol stores will be cached. The directory will be created
+ * if it does not exist.
+ * @param mappedStoreLimit The total size, in bytes, of the symbol stores that may remain mapped once a report has
+ * been symbolicated, or 0 if stores should never be closed. The stores required by a single report are always
+ * mapped while it is symbolicated, regardless of the limit.
+ */
+- (id) initWithSearchPaths: (NSArray *) searchPaths cachePath: (NSString *) cachePath mappedStoreLimit: (size_t) mappedStoreLimit {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _searchPaths = [searchPaths copy];
+    _cachePath = [cachePath copy];
+    _stores = [[NSMutableDictionary alloc] init];
+    _mappedStoreLimit = mappedStoreLimit;
+
+    if (pthread_rwlock_init(&_storeLock, NULL) != 0) {
+        [self release];
+        return nil;
+    }
+    _storeLockInitialized = YES;
+
+    _resolutionCache = malloc(sizeof(*_resolutionCache));
+    if (_resolutionCache == NULL || plcrash_symbol_resolution_cache_init(_resolutionCache) != PLCRASH_ESUCCESS) {
+        free(_resolutionCache);
+        _resolutionCache = NULL;
+        [self release];
+        return nil;
+    }
+
+    return self;
+}
+
+- (void) dealloc {
+    if (_resolutionCache != NULL) {
+        plcrash_symbol_resolution_cache_free(_resolutionCache);
+        free(_resolutionCache);
+    }
+
+    if (_storeLockInitialized)
+        pthread_rwlock_destroy(&_storeLock);
+
+    for (id store in [_stores allValues]) {
+        if (store == [NSNull null])
+            continue;
+
+        plcrash_nasync_symbol_store_close([store pointerValue]);
+        free([store pointerValue]);
+    }
+
+    [_searchPaths release];
+    [_cachePath release];
+    [_binaries release];
+    [_stores release];
+
+    [super dealloc];
+}
+
+/**
+ * Symbolicate the encoded crash report @a data, returning a newly encoded report in which every resolvable frame
+ * has been assigned a symbol. Frames that already have symbols, and frames within images for which no symbols are
+ * available, are left unmodified. Compressed reports are decompressed; the returned report is not compressed.
+ *
+ * @param data An encoded plcrash crash log.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the crash log could not be symbolicated. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @return Returns the symbolicated report on success, or nil on failure.
+ */
+- (NSData *) symbolicateCrashData: (NSData *) data error: (NSError **) outError {
+    /* Transparently decompress compressed reports */
+    if (plcrash_async_compressor_is_compressed([data bytes], [data length])) {
+        uint8_t *decoded;
+        size_t decoded_length;
+
+        if (plcrash_nasync_compressor_decode([data bytes], [data length], &decoded, &decoded_length) != PLCRASH_ESUCCESS) {
+            plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decompress crash log",
+                                                                                                       @"Crash log decoding error message"), nil);
+            return nil;
+        }
+
+        data = [NSData dataWithBytesNoCopy: decoded length: decoded_length freeWhenDone: YES];
+    }
+
+    /* Validate the file header */
+    const struct PLCrashReportFileHeader *header = [data bytes];
+    if (sizeof(struct PLCrashReportFileHeader) >= [data length] ||
+        memcmp(header->magic, PLCRASH_REPORT_FILE_MAGIC, strlen(PLCRASH_REPORT_FILE_MAGIC)) != 0 ||
+        (header->version != PLCRASH_REPORT_FILE_VERSION && header->version != PLCRASH_REPORT_FILE_VERSION_SYMBOL_TABLE &&
+         header->version != PLCRASH_REPORT_FILE_VERSION_PACKED_REGISTERS && header->version != PLCRASH_REPORT_FILE_VERSION_PACKED_FRAMES &&
+         header->version != PLCRASH_REPORT_FILE_VERSION_DEDUPLICATED_THREADS))
+    {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode invalid crash log header",
+                                                                                                   @"Crash log decoding error message"), nil);
+        return nil;
+    }
+
+    /* Decode the report. The system allocator is used, so that the symbols added below are released along with the report. */
+    size_t length = [data length] - sizeof(struct PLCrashReportFileHeader);
+    Plcrash__CrashReport *report = plcrash__crash_report__unpack(&protobuf_c_system_allocator, length, header->data);
+    if (report == NULL) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"An unknown error occured decoding the crash report",
+                                                                                                   @"Crash log decoding error message"), nil);
+        return nil;
+    }
+
+    /* Symbolicate all thread and exception frames. Packed frames can not carry symbols, and are expanded to
+     * individual frame messages. Stores are not evicted while any report is being symbolicated; all symbol names are
+     * copied into the report before the lock is released. */
+    BOOL valid = YES;
+    OSAtomicIncrement64(&_generation);
+    pthread_rwlock_rdlock(&_storeLock);
+
+    for (size_t i = 0; i < report->n_threads && valid; i++) {
+        if (!(valid = [self expandPackedFrames: report->threads[i]]))
+            break;
+
+        for (size_t j = 0; j < report->threads[i]->n_frames; j++)
+            [self symbolicateFrame: report->threads[i]->frames[j] report: report returnAddress: j > 0];
+    }
+
+    if (valid && report->exception != NULL) {
+        for (size_t i = 0; i < report->exception->n_frames; i++)
+            [self symbolicateFrame: report->exception->frames[i] report: report returnAddress: i > 0];
+    }
+
+    pthread_rwlock_unlock(&_storeLock);
+
+    if (_mappedStoreLimit > 0 && _mappedStoreSize > _mappedStoreLimit)
+        [self evictStores];
+
+    if (!valid) {
+        protobuf_c_message_free_unpacked((ProtobufCMessage *) report, &protobuf_c_system_allocator);
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, NSLocalizedString(@"Could not decode invalid packed frames",
+                                                                                                   @"Crash log decoding error message"), nil);
+        return nil;
+    }
+
+    /* Re-encode the report, preserving the original file header */
+    size_t packed_size = protobuf_c_message_get_packed_size((ProtobufCMessage *) report);
+    NSMutableData *output = [NSMutableData dataWithLength: sizeof(struct PLCrashReportFileHeader) + packed_size];
+    memcpy([output mutableBytes], header, sizeof(struct PLCrashReportFileHeader));
+    protobuf_c_message_pack((ProtobufCMessage *) report, (uint8_t *) [output mutableBytes] + sizeof(struct PLCrashReportFileHeader));
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) report, &protobuf_c_system_allocator);
+    return output;
+}
+
+/**
+ * Build the symbol store of every image found within the search paths, replacing any existing cached
+ * stores. This may be used to populate the cache ahead of symbolication; later symbolication runs that share
+ * the cache directory will map the prebuilt stores, rather than reading the images' symbol tables.
+ *
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the stores could not be built. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @return Returns the UUIDs of all images for which a store was built, or nil if the cache directory could not be
+ * created. Images for which a store could not be built are logged and skipped.
+ */
+- (NSArray *) indexSearchPaths: (NSError **) outError {
+    NSMutableArray *indexed = [NSMutableArray array];
+    NSError *error;
+
+    if (![[NSFileManager defaultManager] createDirectoryAtPath: _cachePath withIntermediateDirectories: YES attributes: nil error: &error]) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Could not create the symbol store cache directory", error);
+        return nil;
+    }
+
+    @synchronized (self) {
+        if (_binaries == nil)
+            [self catalogSearchPaths];
+
+        for (NSString *key in [[_binaries allKeys] sortedArrayUsingSelector: @selector(compare:)]) {
+            uint8_t uuid[16];
+            if (!uuid_bytes(key, uuid))
+                continue;
+
+            /* Previously opened stores remain mapped; the replacement is picked up by later runs */
+            if ([self buildStoreForUUID: uuid path: [self storePathForUUID: key]])
+                [indexed addObject: key];
+        }
+    }
+
+    return indexed;
+}
+
+/**
+ * Build a symbol store for every image within the dyld shared cache at @a path, replacing any existing cached
+ * stores. The stores include both the images' exported symbols and the local symbols that dyld moved out of the
+ * images when building the cache, allowing system frames to be symbolicated from the same cache directory as
+ * application frames.
+ *
+ * The sub-caches and symbols file of a split cache are expected to reside alongside @a path.
+ *
+ * @param path The path to a dyld shared cache, eg, as found in an iOS DeviceSupport directory.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the stores could not be built. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
+ * @return Returns the UUIDs of all images for which a store was built, or nil if the cache could not be read or the
+ * cache directory could not be created. Images for which a store could not be built are logged and skipped.
+ */
+- (NSArray *) indexSharedCacheAtPath: (NSString *) path error: (NSError **) outError {
+    plcrash_dyld_shared_cache_t *cache;
+    NSError *error;
+    plcrash_error_t err;
+
+    if (![[NSFileManager defaultManager] createDirectoryAtPath: _cachePath withIntermediateDirectories: YES attributes: nil error: &error]) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Could not create the symbol store cache directory", error);
+        return nil;
+    }
+
+    cache = malloc(sizeof(*cache));
+    if ((err = plcrash_nasync_dyld_shared_cache_open(cache, [path fileSystemRepresentation])) != PLCRASH_ESUCCESS) {
+        NSString *desc = [NSString stringWithFormat: @"Could not read the dyld shared cache at %@: %d", path, err];
+        plcrash_populate_error(outError, err == PLCRASH_EINVAL ? PLCrashReporterErrorUnknown : PLCrashReporterErrorOperatingSystem, desc, nil);
+        free(cache);
+        return nil;
+    }
+
+    struct shared_cache_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.cache = cache;
+    ctx.symbolicator = self;
+    ctx.indexed = [NSMutableArray array];
+
+    err = plcrash_nasync_dyld_shared_cache_images(cache, shared_cache_image_cb, &ctx);
+
+    free(ctx.symbols);
+    plcrash_nasync_dyld_shared_cache_close(cache);
+    free(cache);
+
+    if (err != PLCRASH_ESUCCESS) {
+        NSString *desc = [NSString stringWithFormat: @"Could not read the image list of the dyld shared cache at %@: %d", path, err];
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, desc, nil);
+        return nil;
+    }
+
+    return ctx.indexed;
+}
+
+@end
+
+
+/**
+ * @internal
+ * Private Methods
+ */
+@implementation PLCrashReportSymbolicator (PrivateMethods)
+
+/**
+ * Populate the UUID to path map from the search paths. Must be called with the receiver locked.
+ */
+- (void) catalogSearchPaths {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    struct catalog_ctx ctx;
+
+    _binaries = [[NSMutableDictionary alloc] init];
+    ctx.binaries = _binaries;
+
+    for (NSString *searchPath in _searchPaths) {
+        BOOL isDir = NO;
+        if (![fm fileExistsAtPath: searchPath isDirectory: &isDir])
+            continue;
+
+        if (!isDir) {
+            ctx.path = searchPath;
+            plcrash_nasync_symbol_store_image_uuids([searchPath fileSystemRepresentation], catalog_image_cb, &ctx);
+            continue;
+        }
+
+        NSDirectoryEnumerator *files = [fm enumeratorAtPath: searchPath];
+        for (NSString *file in files) {
+            if (![[[files fileAttributes] fileType] isEqualToString: NSFileTypeRegular])
+                continue;
+
+            NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+            ctx.path = [searchPath stringByAppendingPathComponent: file];
+            plcrash_nasync_symbol_store_image_uuids([ctx.path fileSystemRepresentation], catalog_image_cb, &ctx);
+
+            /* The catalog retains the paths it references */
+            [pool drain];
+        }
+    }
+}
+
+/**
+ * Return the cache path of the symbol store for the image with the given UUID string.
+ */
+- (NSString *) storePathForUUID: (NSString *) uuid {
+    return [_cachePath stringByAppendingPathComponent: [uuid stringByAppendingPathExtension: @PLCRASH_SYMBOL_STORE_EXTENSION]];
+}
+
+/**
+ * Write the symbol store for the shared cache @a image, as part of indexSharedCacheAtPath:error:.
+ */
+- (void) indexSharedCacheImage: (const plcrash_dyld_shared_cache_image_t *) image context: (struct shared_cache_ctx *) ctx {
+    if (!image->has_uuid)
+        return;
+
+    ctx->count = 0;
+    ctx->text_vmaddr = image->text_vmaddr;
+    plcrash_nasync_dyld_shared_cache_image_symbols(ctx->cache, image, shared_cache_symbol_cb, ctx);
+
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    NSString *key = uuid_string(image->uuid);
+    NSString *storePath = [self storePathForUUID: key];
+
+    plcrash_error_t err = plcrash_nasync_symbol_store_write([storePath fileSystemRepresentation], image->uuid, ctx->symbols, ctx->count);
+    if (err == PLCRASH_ESUCCESS) {
+        [ctx->indexed addObject: key];
+    } else {
+        NSLog(@"Could not write symbol store for %s (%@): %d", image->path, key, err);
+    }
+
+    [pool drain];
+}
+
+/**
+ * Build the symbol store for @a uuid at @a storePath from the cataloged binary containing the image. Must be called
+ * with the receiver locked, after the search paths have been cataloged.
+ */
+- (BOOL) buildStoreForUUID: (const uint8_t *) uuid path: (NSString *) storePath {
+    NSString *key = uuid_string(uuid);
+    NSString *binary = [_binaries objectForKey: key];
+    if (binary == nil)
+        return NO;
+
+    plcrash_error_t err = plcrash_nasync_symbol_store_build([binary fileSystemRepresentation], uuid, [storePath fileSystemRepresentation]);
+    if (err != PLCRASH_ESUCCESS) {
+        NSLog(@"Could not build symbol store for %@ from %@: %d", key, binary, err);
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ * Return the symbol store for @a uuid, opening the cached store or building a new store as required. Returns NULL
+ * if no symbols are available for the image. Must be called with the receiver locked.
+ */
+- (plcrash_symbol_store_t *) storeForUUID: (const uint8_t *) uuid {
+    NSString *key = uuid_string(uuid);
+
+    id cached = [_stores objectForKey: key];
+    if (cached != nil)
+        return cached == [NSNull null] ? NULL : [cached pointerValue];
+
+    symbolicator_store_t *entry = malloc(sizeof(*entry));
+    plcrash_symbol_store_t *store = &entry->store;
+    NSString *storePath = [self storePathForUUID: key];
+    entry->last_used = _generation;
+
+    /* Try the cache */
+    if (plcrash_nasync_symbol_store_open(store, [storePath fileSystemRepresentation]) == PLCRASH_ESUCCESS) {
+        [_stores setObject: [NSValue valueWithPointer: store] forKey: key];
+        _mappedStoreSize += store->mapping_size;
+        return store;
+    }
+
+    /* Locate the image and build a new store */
+    if (_binaries == nil)
+        [self catalogSearchPaths];
+
+    [[NSFileManager defaultManager] createDirectoryAtPath: _cachePath withIntermediateDirectories: YES attributes: nil error: NULL];
+    if ([self buildStoreForUUID: uuid path: storePath] && plcrash_nasync_symbol_store_open(store, [storePath fileSystemRepresentation]) == PLCRASH_ESUCCESS) {
+        [_stores setObject: [NSValue valueWithPointer: store] forKey: key];
+        _mappedStoreSize += store->mapping_size;
+        return store;
+    }
+
+    /* Cache the negative result */
+    free(entry);
+    [_stores setObject: [NSNull null] forKey: key];
+    return NULL;
+}
+
+/**
+ * Close the least recently used stores until the total mapped size is within the mapped store limit, discarding their
+ * cached lookup results. Waits for all in-progress reports to complete.
+ */
+- (void) evictStores {
+    pthread_rwlock_wrlock(&_storeLock);
+    @synchronized (self) {
+        NSMutableArray *keys = [NSMutableArray arrayWithCapacity: [_stores count]];
+        for (NSString *key in _stores) {
+            if ([_stores objectForKey: key] != [NSNull null])
+                [keys addObject: key];
+        }
+
+        [keys sortUsingComparator: ^NSComparisonResult (id lhs, id rhs) {
+            int64_t lhsUsed = ((symbolicator_store_t *) [[_stores objectForKey: lhs] pointerValue])->last_used;
+            int64_t rhsUsed = ((symbolicator_store_t *) [[_stores objectForKey: rhs] pointerValue])->last_used;
+            return lhsUsed < rhsUsed ? NSOrderedAscending : lhsUsed > rhsUsed ? NSOrderedDescending : NSOrderedSame;
+        }];
+
+        for (NSString *key in keys) {
+            if (_mappedStoreSize <= _mappedStoreLimit)
+                break;
+
+            uint8_t uuid[16];
+            symbolicator_store_t *entry = [[_stores objectForKey: key] pointerValue];
+            if (uuid_bytes(key, uuid))
+                plcrash_symbol_resolution_cache_remove_image(_resolutionCache, uuid);
+
+            _mappedStoreSize -= entry->store.mapping_size;
+            plcrash_nasync_symbol_store_close(&entry->store);
+            free(entry);
+
+            /* The store will be reopened on next use */
+            [_stores removeObjectForKey: key];
+        }
+    }
+    pthread_rwlock_unlock(&_storeLock);
+}
+
+/**
+ * Replace the packed frame PCs of @a thread (if any) with individual frame messages, allocated via malloc(), as
+ * required by protobuf_c_system_allocator. Returns NO if the packed PCs are invalid.
+ */
+- (BOOL) expandPackedFrames: (Plcrash__CrashReport__Thread *) thread {
+    if (!thread->has_frame_pcs)
+        return YES;
+
+    /* Count the frames */
+    plcrash_async_pb_reader_t reader;
+    plcrash_error_t err;
+    uint64_t delta;
+    size_t count = 0;
+
+    plcrash_async_pb_reader_init(&reader, thread->frame_pcs.data, thread->frame_pcs.len);
+    while ((err = plcrash_async_pb_reader_next_varint(&reader, &delta)) == PLCRASH_ESUCCESS)
+        count++;
+
+    if (err != PLCRASH_ENOTFOUND)
+        return NO;
+
+    /* Append the frames; the packed data is released along with the report */
+    Plcrash__CrashReport__Thread__StackFrame **frames = realloc(thread->frames, (thread->n_frames + count) * sizeof(*frames));
+    if (frames == NULL && thread->n_frames + count > 0)
+        return NO;
+    thread->frames = frames;
+
+    uint64_t pc = 0;
+    plcrash_async_pb_reader_init(&reader, thread->frame_pcs.data, thread->frame_pcs.len);
+    while (plcrash_async_pb_reader_next_varint(&reader, &delta) == PLCRASH_ESUCCESS) {
+        pc += (uint64_t) plcrash_async_pb_zigzag_decode(delta);
+
+        Plcrash__CrashReport__Thread__StackFrame *frame = malloc(sizeof(*frame));
+        protobuf_c_message_init(&plcrash__crash_report__thread__stack_frame__descriptor, (ProtobufCMessage *) frame);
+        frame->pc = pc;
+        thread->frames[thread->n_frames++] = frame;
+    }
+
+    thread->has_frame_pcs = 0;
+    return YES;
+}
+
+/**
+ * @internal
+ *
+ * Return a malloc()-allocated copy of the symbol name @a name, demangled via the shared demangle cache if demangling
+ * is enabled and @a name is a mangled C++ or Swift symbol.
+ */
+- (char *) copySymbolName: (const char *) name {
+    plcrash_demangle_cache_t *cache = _demangleSymbols ? plcrash_demangle_cache_shared() : NULL;
+    if (cache != NULL) {
+        char *demangled = plcrash_demangle_cache_copy_demangled(cache, name);
+        if (demangled != NULL)
+            return demangled;
+    }
+
+    return strdup(name);
+}
+
+/**
+ * Assign a symbol to @a frame, if it does not already have one, and symbols are available for the containing image.
+ * If the image's symbol store includes a line table, the symbol's source file and line are also assigned, and if it
+ * includes an inline table, the chain of functions inlined at the frame's address is recorded in the symbol's
+ * inlined frames. Returns YES if a symbol was assigned.
+ *
+ * If @a returnAddress is YES, the frame's PC is the return address of a call, and the preceding instruction (the call
+ * itself) is resolved instead; otherwise, a call at the very end of a function would resolve to the following
+ * function or line.
+ */
+- (BOOL) symbolicateFrame: (Plcrash__CrashReport__Thread__StackFrame *) frame report: (Plcrash__CrashReport *) report returnAddress: (BOOL) returnAddress {
+    if (frame->symbol != NULL)
+        return NO;
+
+    /* Find the containing image */
+    Plcrash__CrashReport__BinaryImage *image = NULL;
+    for (size_t i = 0; i < report->n_binary_images; i++) {
+        Plcrash__CrashReport__BinaryImage *candidate = report->binary_images[i];
+        if (frame->pc >= candidate->base_address && frame->pc - candidate->base_address < candidate->size) {
+            image = candidate;
+            break;
+        }
+    }
+
+    if (image == NULL || !image->has_uuid || image->uuid.len != 16)
+        return NO;
+
+    /* Check the resolution cache. Symbol names and source paths refer to the image's store, which is never closed while
+     * a report is being symbolicated. */
+    uint64_t offset = frame->pc - image->base_address;
+    if (returnAddress && offset > 0)
+        offset--;
+
+    plcrash_symbol_resolution_t res;
+    if (!plcrash_symbol_resolution_cache_lookup(_resolutionCache, image->uuid.data, offset, &res)) {
+        /* Fetch the image's store; stores are never closed while a report is being symbolicated, so lookups may proceed
+         * unlocked */
+        memset(&res, 0, sizeof(res));
+        @synchronized (self) {
+            res.store = [self storeForUUID: image->uuid.data];
+        }
+
+        if (res.store == NULL || plcrash_nasync_symbol_store_lookup(res.store, offset, &res.name, &res.symbol_address) != PLCRASH_ESUCCESS)
+            res.name = NULL;
+
+        if (res.name != NULL) {
+            if (plcrash_nasync_symbol_store_lookup_line(res.store, offset, &res.file, &res.line) != PLCRASH_ESUCCESS)
+                res.file = NULL;
+
+            res.inlined = plcrash_nasync_symbol_store_lookup_inline(res.store, offset);
+        }
+
+        /* A failure to cache the result is harmless; the address will simply be resolved again */
+        plcrash_symbol_resolution_cache_insert(_resolutionCache, image->uuid.data, offset, &res);
+    }
+
+    if (res.name == NULL)
+        return NO;
+
+    /* Mark the store as used; a racing write from another report's generation is harmless */
+    ((symbolicator_store_t *) res.store)->last_used = _generation;
+
+    /* Allocated via malloc(), as required by protobuf_c_system_allocator */
+    Plcrash__CrashReport__Symbol *symbol = malloc(sizeof(*symbol));
+    protobuf_c_message_init(&plcrash__crash_report__symbol__descriptor, (ProtobufCMessage *) symbol);
+    symbol->name = [self copySymbolName: res.name];
+    symbol->start_address = image->base_address + res.symbol_address;
+    if (res.file != NULL) {
+        symbol->source_file = strdup(res.file);
+        symbol->source_line = res.line;
+        symbol->has_source_line = 1;
+    }
+
+    /* Expand the inlined call chain, innermost first */
+    size_t inlined_count = 0;
+    for (const plcrash_symbol_store_inline_entry_t *entry = res.inlined; entry != NULL; entry = plcrash_nasync_symbol_store_inline_parent(res.store, entry))
+        inlined_count++;
+
+    if (inlined_count > 0 && (symbol->inlined_frames = malloc(inlined_count * sizeof(*symbol->inlined_frames))) != NULL) {
+        for (const plcrash_symbol_store_inline_entry_t *entry = res.inlined; entry != NULL; entry = plcrash_nasync_symbol_store_inline_parent(res.store, entry)) {
+            const char *inlined_name = plcrash_nasync_symbol_store_string(res.store, entry->name_offset);
+            const char *call_file = plcrash_nasync_symbol_store_string(res.store, entry->call_file_offset);
+
+            Plcrash__CrashReport__Symbol__InlinedFrame *inlined = malloc(sizeof(*inlined));
+            protobuf_c_message_init(&plcrash__crash_report__symbol__inlined_frame__descriptor, (ProtobufCMessage *) inlined);
+            if (inlined_name != NULL)
+                inlined->name = [self copySymbolName: inlined_name];
+
+            if (call_file != NULL) {
+                inlined->call_file = strdup(call_file);
+                inlined->call_line = entry->call_line;
+                inlined->has_call_line = 1;
+            }
+
+            symbol->inlined_frames[symbol->n_inlined_frames++] = inlined;
+        }
+    }
+
+    frame->symbol = symbol;
+    return YES;
+}
+
+@end
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReportSymbolicator.h"
+#import "PLCrashSymbolStore.h"
+
+#import <dlfcn.h>
+
+@interface PLCrashReportSymbolicatorTests : SenTestCase {
+@private
+    /** Cache directory. */
+    NSString *_cachePath;
+}
+@end
+
+@implementation PLCrashReportSymbolicatorTests
+
+- (void) setUp {
+    _cachePath = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _cachePath error: NULL];
+    [_cachePath release];
+}
+
+/**
+ * Verify that prebuilding the search path indexes writes a valid store for each image.
+ */
+- (void) testIndexSearchPaths {
+    Dl_info info;
+    STAssertTrue(dladdr((void *) [self methodForSelector: _cmd], &info) != 0, @"Could not find test image");
+
+    NSString *binary = [NSString stringWithUTF8String: info.dli_fname];
+    PLCrashReportSymbolicator *symbolicator = [[[PLCrashReportSymbolicator alloc] initWithSearchPaths: [NSArray arrayWithObject: binary]
+                                                                                            cachePath: _cachePath] autorelease];
+
+    NSError *error = nil;
+    NSArray *indexed = [symbolicator indexSearchPaths: &error];
+    STAssertNotNil(indexed, @"Failed to index search paths: %@", error);
+    STAssertTrue([indexed count] > 0, @"No images were indexed");
+
+    for (NSString *uuid in indexed) {
+        NSString *storePath = [_cachePath stringByAppendingPathComponent: [uuid stringByAppendingPathExtension: @PLCRASH_SYMBOL_STORE_EXTENSION]];
+        plcrash_symbol_store_t store;
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_symbol_store_open(&store, [storePath fileSystemRepresentation]), @"Could not open store for %@", uuid);
+        plcrash_nasync_symbol_store_close(&store);
+    }
+}
+
+/**
+ * Verify that invalid report data is rejected.
+ */
+- (void) testInvalidReport {
+    PLCrashReportSymbolicator *symbolicator = [[[PLCrashReportSymbolicator alloc] initWithSearchPaths: [NSArray array] cachePath: _cachePath] autorelease];
+
+    NSError *error = nil;
+    STAssertNil([symbolicator symbolicateCrashData: [NSData dataWithBytes: "plcrash" length: 7] error: &error], @"Invalid report was accepted");
+    STAssertNotNil(error, @"No error was returned");
+}
+
+@end
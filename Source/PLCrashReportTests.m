@@ -29,6 +29,8 @@
 #import "GTMSenTestCase.h"
 #import "PLCrashReport.h"
 #import "PLCrashReporter.h"
+#import "PLCrashReportJSONFormatter.h"
+#import "PLCrashReportHeader.h"
 #import "PLCrashFrameWalker.h"
 #import "PLCrashLogWriter.h"
 #import "PLCrashAsyncImageList.h"
@@ -41,6 +43,41 @@
 
 #import <mach-o/arch.h>
 #import <mach-o/dyld.h>
+#import <mach/mach_time.h>
+#import <malloc/malloc.h>
+
+#import "PLCrashReportTextFormatter.h"
+
+/**
+ * Default number of iterations for each decoding benchmark. This may be overridden via the PLCRASH_BENCHMARK_ITERATIONS
+ * environment variable; the default favors a fast test run.
+ */
+#define BENCHMARK_DEFAULT_ITERATIONS 1
+
+/** Number of threads in the many-threads benchmark report. */
+#define BENCHMARK_MANY_THREADS 100
+
+/** Number of binary images in the many-images benchmark report. */
+#define BENCHMARK_MANY_IMAGES 1000
+
+/** Stack depth of the deep-recursion benchmark report's thread. */
+#define BENCHMARK_DEEP_STACK 400
+
+/* Return the number of nanoseconds elapsed since @a start, a mach_absolute_time() value. */
+static uint64_t benchmark_elapsed_ns (uint64_t start) {
+    uint64_t end = mach_absolute_time();
+
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    return ((end - start) * timebase.numer) / timebase.denom;
+}
+
+/* Return the number of bytes currently allocated from all malloc zones. */
+static size_t benchmark_malloc_in_use (void) {
+    malloc_statistics_t stats;
+    malloc_zone_statistics(NULL, &stats);
+    return stats.size_in_use;
+}
 
 @interface PLCrashReportTests : SenTestCase {
 @private
@@ -147,6 +184,51 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
     PLCrashReport *crashLog = [[[PLCrashReport alloc] initWithData: [NSData dataWithContentsOfMappedFile: _logPath] error: &error] autorelease];
     STAssertNotNil(crashLog, @"Could not decode crash log: %@", error);
 
+    /* Decoding from the mapped file must produce an equivalent report */
+    PLCrashReport *mappedLog = [[[PLCrashReport alloc] initWithContentsOfFile: _logPath error: &error] autorelease];
+    STAssertNotNil(mappedLog, @"Could not decode mapped crash log: %@", error);
+    STAssertEquals([crashLog.threads count], [mappedLog.threads count], @"Thread count does not match");
+    STAssertEquals([crashLog.images count], [mappedLog.images count], @"Image count does not match");
+
+    /* Lazily materialized stack frames must remain available after the report is released */
+    PLCrashReport *lazyLog = [[PLCrashReport alloc] initWithContentsOfFile: _logPath error: &error];
+    STAssertNotNil(lazyLog, @"Could not decode crash log: %@", error);
+    PLCrashReportThreadInfo *lazyThread = [[lazyLog.threads objectAtIndex: 0] retain];
+    [lazyLog release];
+    STAssertEquals([[[crashLog.threads objectAtIndex: 0] stackFrames] count], [lazyThread.stackFrames count], @"Frame count does not match");
+    [lazyThread release];
+
+    /* Image names reference the report's decode buffer, and must also remain valid after the report is released */
+    PLCrashReport *nameLog = [[PLCrashReport alloc] initWithContentsOfFile: _logPath error: &error];
+    STAssertNotNil(nameLog, @"Could not decode crash log: %@", error);
+    PLCrashReportBinaryImageInfo *nameImage = [[nameLog.images objectAtIndex: 0] retain];
+    [nameLog release];
+    STAssertEqualStrings(nameImage.imageName, [[crashLog.images objectAtIndex: 0] imageName], @"Image name does not match");
+    [nameImage release];
+
+    /* The JSON representation must be a single, parseable line */
+    NSData *json = [[[[PLCrashReportJSONFormatter alloc] init] autorelease] formatReport: crashLog error: &error];
+    STAssertNotNil(json, @"Could not format JSON report: %@", error);
+    STAssertEquals((NSUInteger) 1, [[[[[NSString alloc] initWithData: json encoding: NSUTF8StringEncoding] autorelease] componentsSeparatedByString: @"\n"] count] - 1, @"JSON report is not a single line");
+    NSDictionary *jsonReport = [NSJSONSerialization JSONObjectWithData: json options: 0 error: &error];
+    STAssertNotNil(jsonReport, @"Could not parse JSON report: %@", error);
+    STAssertEqualStrings(@"SIGSEGV", [jsonReport valueForKeyPath: @"signal.name"], @"Signal is incorrect");
+    STAssertEquals([crashLog.threads count], [[jsonReport objectForKey: @"threads"] count], @"Thread count does not match");
+    STAssertEquals([crashLog.images count], [[jsonReport objectForKey: @"images"] count], @"Image count does not match");
+
+    /* The header must match the full report, and must not depend on the thread and image records */
+    NSData *reportData = [NSData dataWithContentsOfFile: _logPath];
+    NSData *truncatedData = [reportData subdataWithRange: NSMakeRange(0, [reportData length] / 2)];
+    PLCrashReportHeader *reportHeader = [[[PLCrashReportHeader alloc] initWithData: truncatedData error: &error] autorelease];
+    STAssertNotNil(reportHeader, @"Could not read report header: %@", error);
+    STAssertTrue(CFEqual(crashLog.uuidRef, reportHeader.uuidRef), @"Report UUID does not match");
+    STAssertFalse(reportHeader.userRequested, @"Report incorrectly marked as user-requested");
+    STAssertEqualStrings(crashLog.systemInfo.operatingSystemVersion, reportHeader.systemInfo.operatingSystemVersion, @"OS version does not match");
+    STAssertEqualStrings(crashLog.systemInfo.operatingSystemBuild, reportHeader.systemInfo.operatingSystemBuild, @"OS build does not match");
+    STAssertEqualObjects(crashLog.systemInfo.timestamp, reportHeader.systemInfo.timestamp, @"Timestamp does not match");
+    STAssertEqualStrings(crashLog.applicationInfo.applicationIdentifier, reportHeader.applicationInfo.applicationIdentifier, @"App identifier does not match");
+    STAssertEqualStrings(crashLog.applicationInfo.applicationVersion, reportHeader.applicationInfo.applicationVersion, @"App version does not match");
+
     /* Report info */
     STAssertNotNULL(crashLog.uuidRef, @"No report UUID");
     
@@ -244,6 +326,16 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
         thrNumber++;
     }
     STAssertTrue(crashedFound, @"No crashed thread was found in the crash log");
+    STAssertNil([crashLog imageForAddress: 0], @"Unexpected image found for the NULL address");
+
+    /* Sorted image view */
+    STAssertEquals([crashLog.images count], [crashLog.sortedImages count], @"Sorted image count does not match");
+    for (NSUInteger i = 1; i < [crashLog.sortedImages count]; i++) {
+        STAssertTrue([[crashLog.sortedImages objectAtIndex: i - 1] imageBaseAddress] <= [[crashLog.sortedImages objectAtIndex: i] imageBaseAddress],
+                     @"Images are not sorted by base address");
+    }
+    if (crashLog.executableImage != nil)
+        STAssertEqualObjects(crashLog.processInfo.processPath, crashLog.executableImage.imageName, @"Incorrect executable image");
 
     /* Image info */
     STAssertNotEquals((NSUInteger)0, [crashLog.images count], @"Crash log should contain at least one image");
@@ -258,6 +350,10 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
         
         STAssertNotNil(imageInfo.codeType, @"Image code type is nil");
         STAssertEquals(imageInfo.codeType.typeEncoding, PLCrashReportProcessorTypeEncodingMach, @"Incorrect type encoding");
+
+        /* The image must be found by address lookup */
+        STAssertEquals(imageInfo, [crashLog imageForAddress: imageInfo.imageBaseAddress], @"Image lookup by base address failed");
+        STAssertEquals(imageInfo, [crashLog imageForAddress: imageInfo.imageBaseAddress + imageInfo.imageSize - 1], @"Image lookup by end address failed");
         
         /*
          * Find the in-memory mach header for the image record. We'll compare this against the serialized data.
@@ -275,5 +371,317 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
     }
 }
 
+/**
+ * Verify that a truncated streaming report can be recovered.
+ */
+- (void) testTruncatedStreamingReport {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+    NSError *error = nil;
+
+    /* Initialze faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = method_getImplementation(class_getInstanceMethod([self class], _cmd));
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    /* Open the output file */
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+
+    /* Initialize a streaming writer */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+    plcrash_log_writer_set_streaming(&writer, true, PLCRASH_LOG_WRITER_FLUSH_ALL);
+
+    /* Provide binary image info */
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    uint32_t image_count = _dyld_image_count();
+    for (uint32_t i = 0; i < image_count; i++) {
+        plcrash_nasync_image_list_append(&image_list, (uintptr_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+    }
+
+    /* Write the crash report */
+    struct plcr_live_report_context ctx = {
+        .writer = &writer,
+        .file = &file,
+        .images = &image_list,
+        .info = &info
+    };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_thread_state_current(plcr_live_report_callback, &ctx), @"Writing crash log failed");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    /* Truncate the report within the final binary image message, as if the writer had been terminated */
+    NSData *data = [NSData dataWithContentsOfMappedFile: _logPath];
+    NSData *truncated = [data subdataWithRange: NSMakeRange(0, [data length] - 1)];
+
+    PLCrashReport *crashLog = [[[PLCrashReport alloc] initWithData: truncated error: &error] autorelease];
+    STAssertNotNil(crashLog, @"Could not decode truncated crash log: %@", error);
+
+    /* The signal and crashed thread are written first */
+    STAssertEqualStrings(@"SIGSEGV", crashLog.signalInfo.name, @"Signal is incorrect");
+    STAssertNotEquals((NSUInteger)0, [crashLog.threads count], @"No thread values returned");
+    if ([crashLog.threads count] > 0)
+        STAssertTrue([[crashLog.threads objectAtIndex: 0] crashed], @"Crashed thread was not written first");
+
+    STAssertTrue([crashLog.images count] < image_count, @"The truncated image should have been dropped");
+}
+
+/**
+ * Verify that batch decoding returns reports and errors in input order.
+ */
+- (void) testDecodeReportsWithDataArray {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+
+    /* Initialze faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = method_getImplementation(class_getInstanceMethod([self class], _cmd));
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    /* Write a crash report */
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE, false), @"Initialization failed");
+
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&image_list, (uintptr_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    struct plcr_live_report_context ctx = {
+        .writer = &writer,
+        .file = &file,
+        .images = &image_list,
+        .info = &info
+    };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_thread_state_current(plcr_live_report_callback, &ctx), @"Writing crash log failed");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    /* Decode a batch containing every third entry as an invalid report */
+    NSData *data = [NSData dataWithContentsOfFile: _logPath];
+    NSData *invalid = [NSData dataWithBytes: "invalid" length: 7];
+
+    NSMutableArray *inputs = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 32; i++)
+        [inputs addObject: (i % 3 == 0) ? invalid : data];
+
+    NSArray *results = [PLCrashReport decodeReportsWithDataArray: inputs maxConcurrency: 4];
+    STAssertEquals([inputs count], [results count], @"Incorrect result count");
+
+    for (NSUInteger i = 0; i < [results count]; i++) {
+        id result = [results objectAtIndex: i];
+        if (i % 3 == 0) {
+            STAssertTrue([result isKindOfClass: [NSError class]], @"Invalid report was not returned as an error");
+        } else {
+            STAssertTrue([result isKindOfClass: [PLCrashReport class]], @"Report was not decoded: %@", result);
+            STAssertEqualStrings(@"SIGSEGV", [[result signalInfo] name], @"Signal is incorrect");
+        }
+    }
+
+    /* An empty batch returns an empty array */
+    STAssertEquals((NSUInteger) 0, [[PLCrashReport decodeReportsWithDataArray: [NSArray array] maxConcurrency: 0] count], @"Empty batch returned results");
+}
+
+
+/* Return the number of benchmark iterations to be run */
+- (NSUInteger) benchmarkIterations {
+    const char *value = getenv("PLCRASH_BENCHMARK_ITERATIONS");
+    if (value == NULL || atoi(value) <= 0)
+        return BENCHMARK_DEFAULT_ITERATIONS;
+
+    return (NSUInteger) atoi(value);
+}
+
+/**
+ * Write and return a synthetic crash report of the current process, with @a threadCount additional threads of
+ * @a stackDepth frames each, and at least @a imageCount binary images; the loaded images are repeated as necessary.
+ */
+- (NSData *) benchmarkReportWithThreads: (NSUInteger) threadCount stackDepth: (unsigned int) stackDepth imageCount: (NSUInteger) imageCount {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+    plcrash_test_thread_t *threads = calloc(threadCount, sizeof(plcrash_test_thread_t));
+
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    bsd_info.address = method_getImplementation(class_getInstanceMethod([self class], _cmd));
+    bsd_info.code = SEGV_MAPERR;
+    bsd_info.signo = SIGSEGV;
+    info.mach_info = NULL;
+    info.bsd_info = &bsd_info;
+
+    for (NSUInteger i = 0; i < threadCount; i++)
+        plcrash_test_thread_spawn_depth(&threads[i], stackDepth);
+
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    uint32_t loaded_count = _dyld_image_count();
+    for (NSUInteger i = 0; i < MAX(imageCount, loaded_count); i++)
+        plcrash_nasync_image_list_append(&image_list, (uintptr_t) _dyld_get_image_header(i % loaded_count), _dyld_get_image_name(i % loaded_count));
+
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_TRUNC, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+
+    struct plcr_live_report_context ctx = {
+        .writer = &writer,
+        .file = &file,
+        .images = &image_list,
+        .info = &info
+    };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_thread_state_current(plcr_live_report_callback, &ctx), @"Writing crash log failed");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    for (NSUInteger i = 0; i < threadCount; i++)
+        plcrash_test_thread_stop(&threads[i]);
+    free(threads);
+
+    return [NSData dataWithContentsOfFile: _logPath];
+}
+
+/**
+ * Time decoding, image lookup, and text formatting of @a data over @a iterations iterations, logging each stage's
+ * throughput and the bytes that remain allocated per iteration until the enclosing autorelease pool is drained.
+ */
+- (void) benchmarkReport: (NSData *) data name: (NSString *) name iterations: (NSUInteger) iterations {
+    NSError *error = nil;
+
+    /* Decode */
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    size_t start_bytes = benchmark_malloc_in_use();
+    uint64_t start = mach_absolute_time();
+    PLCrashReport *report = nil;
+    for (NSUInteger i = 0; i < iterations; i++) {
+        report = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
+        STAssertNotNil(report, @"Could not decode %@ report: %@", name, error);
+        if (report == nil) {
+            [pool drain];
+            return;
+        }
+    }
+    uint64_t decode_ns = benchmark_elapsed_ns(start);
+    size_t decode_bytes = benchmark_malloc_in_use() - start_bytes;
+    [report retain];
+    [pool drain];
+    [report autorelease];
+
+    /* Look up the image of every frame */
+    NSMutableArray *addresses = [NSMutableArray array];
+    for (PLCrashReportThreadInfo *thread in report.threads) {
+        for (PLCrashReportStackFrameInfo *frame in thread.stackFrames)
+            [addresses addObject: [NSNumber numberWithUnsignedLongLong: frame.instructionPointer]];
+    }
+
+    NSUInteger lookups = 0;
+    start = mach_absolute_time();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        for (NSNumber *address in addresses) {
+            [report imageForAddress: [address unsignedLongLongValue]];
+            lookups++;
+        }
+    }
+    uint64_t lookup_ns = benchmark_elapsed_ns(start);
+
+    /* Format */
+    PLCrashReportTextFormatter *formatter = [[[PLCrashReportTextFormatter alloc] initWithTextFormat: PLCrashReportTextFormatiOS
+                                                                                     stringEncoding: NSUTF8StringEncoding] autorelease];
+    pool = [[NSAutoreleasePool alloc] init];
+    start_bytes = benchmark_malloc_in_use();
+    start = mach_absolute_time();
+    for (NSUInteger i = 0; i < iterations; i++)
+        STAssertNotNil([formatter formatReport: report error: &error], @"Could not format %@ report: %@", name, error);
+    uint64_t format_ns = benchmark_elapsed_ns(start);
+    size_t format_bytes = benchmark_malloc_in_use() - start_bytes;
+    [pool drain];
+
+    /* Note that malloc statistics are process-wide, and will include any concurrent allocations within the test process */
+    NSLog(@"[benchmark] %@ (%lu bytes, %lu threads, %lu images, %lu iterations): "
+          "decode %.1f reports/sec, %ld bytes/report; "
+          "imageForAddress: %.0f lookups/sec; "
+          "format %.1f reports/sec, %ld bytes/report",
+          name, (unsigned long) [data length], (unsigned long) [report.threads count], (unsigned long) [report.images count], (unsigned long) iterations,
+          (double) iterations * NSEC_PER_SEC / MAX(decode_ns, 1), (long) decode_bytes / (long) iterations,
+          (double) lookups * NSEC_PER_SEC / MAX(lookup_ns, 1),
+          (double) iterations * NSEC_PER_SEC / MAX(format_ns, 1), (long) format_bytes / (long) iterations);
+}
+
+/**
+ * Benchmark decoding, image lookup, and text formatting over a corpus of synthetic reports: a small report, a report
+ * with BENCHMARK_MANY_THREADS threads, a report with BENCHMARK_MANY_IMAGES images, and a report with a
+ * BENCHMARK_DEEP_STACK frame thread. Any *.plcrash reports in the directory named by the PLCRASH_BENCHMARK_CORPUS
+ * environment variable are appended to the corpus.
+ *
+ * Results are logged, rather than asserted, as they are highly dependent on the host; set PLCRASH_BENCHMARK_ITERATIONS
+ * to increase the number of iterations when comparing decoding and formatting throughput across revisions.
+ */
+- (void) testBenchmarkDecodeCorpus {
+    NSUInteger iterations = [self benchmarkIterations];
+    NSMutableArray *names = [NSMutableArray array];
+    NSMutableArray *corpus = [NSMutableArray array];
+
+    [names addObject: @"small"];
+    [corpus addObject: [self benchmarkReportWithThreads: 0 stackDepth: 0 imageCount: 0]];
+
+    [names addObject: @"many-threads"];
+    [corpus addObject: [self benchmarkReportWithThreads: BENCHMARK_MANY_THREADS stackDepth: 0 imageCount: 0]];
+
+    [names addObject: @"many-images"];
+    [corpus addObject: [self benchmarkReportWithThreads: 0 stackDepth: 0 imageCount: BENCHMARK_MANY_IMAGES]];
+
+    [names addObject: @"deep-recursion"];
+    [corpus addObject: [self benchmarkReportWithThreads: 1 stackDepth: BENCHMARK_DEEP_STACK imageCount: 0]];
+
+    const char *corpusPath = getenv("PLCRASH_BENCHMARK_CORPUS");
+    if (corpusPath != NULL) {
+        NSString *dir = [NSString stringWithUTF8String: corpusPath];
+        for (NSString *file in [[NSFileManager defaultManager] contentsOfDirectoryAtPath: dir error: NULL]) {
+            if (![[file pathExtension] isEqualToString: @"plcrash"])
+                continue;
+
+            NSData *data = [NSData dataWithContentsOfFile: [dir stringByAppendingPathComponent: file]];
+            if (data == nil)
+                continue;
+
+            [names addObject: file];
+            [corpus addObject: data];
+        }
+    }
+
+    for (NSUInteger i = 0; i < [corpus count]; i++)
+        [self benchmarkReport: [corpus objectAtIndex: i] name: [names objectAtIndex: i] iterations: iterations];
+}
 
 @end
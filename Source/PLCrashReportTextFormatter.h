@@ -53,10 +53,18 @@ typedef enum {
 
     /** Encoding to use for string output. */
     NSStringEncoding _stringEncoding;
+
+    /** If YES, mangled C++ and Swift symbol names are demangled. */
+    BOOL _demangleSymbols;
 }
 
 + (NSString *) stringValueForCrashReport: (PLCrashReport *) report withTextFormat: (PLCrashReportTextFormat) textFormat;
++ (NSString *) stringValueForCrashReport: (PLCrashReport *) report withTextFormat: (PLCrashReportTextFormat) textFormat demangleSymbols: (BOOL) demangleSymbols;
 
 - (id) initWithTextFormat: (PLCrashReportTextFormat) textFormat stringEncoding: (NSStringEncoding) stringEncoding;
+- (id) initWithTextFormat: (PLCrashReportTextFormat) textFormat stringEncoding: (NSStringEncoding) stringEncoding demangleSymbols: (BOOL) demangleSymbols;
+
+- (BOOL) writeReport: (PLCrashReport *) report toStream: (NSOutputStream *) stream error: (NSError **) outError;
+- (BOOL) writeReport: (PLCrashReport *) report toFileDescriptor: (int) fd error: (NSError **) outError;
 
 @end
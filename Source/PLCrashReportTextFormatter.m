@@ -32,15 +32,180 @@
 #import "CrashReporter/CrashReporter.h"
 
 #import "PLCrashReportTextFormatter.h"
+#import "PLCrashReporterNSError.h"
+#import "PLCrashTextBuffer.h"
+#import "PLCrashDemangleCache.h"
+
+#import <unistd.h>
+#import <errno.h>
+
+/** Size of the PLCrashReportTextOutput encoding buffer. */
+#define TEXT_OUTPUT_BUFFER_SIZE (16 * 1024)
+
+/**
+ * @internal
+ *
+ * Encodes appended text into a fixed-size, reusable byte buffer, writing the buffer to an output stream or
+ * file descriptor as it fills. Implements the NSMutableString appendString: and appendFormat: methods, allowing
+ * the formatter to target either a string or an output.
+ */
+@interface PLCrashReportTextOutput : NSObject {
+@private
+    /** Target stream, or nil if writing to @a _fd. */
+    NSOutputStream *_stream;
+
+    /** Target file descriptor; only used if @a _stream is nil. */
+    int _fd;
+
+    /** Output string encoding. */
+    NSStringEncoding _encoding;
+
+    /** The first error that occured, or nil. Once an error occurs, all further output is discarded. */
+    NSError *_error;
+
+    /** Number of valid bytes in @a _buffer. */
+    NSUInteger _length;
+
+    /** Encoded output buffer. */
+    uint8_t _buffer[TEXT_OUTPUT_BUFFER_SIZE];
+}
+
+- (id) initWithStream: (NSOutputStream *) stream encoding: (NSStringEncoding) encoding;
+- (id) initWithFileDescriptor: (int) fd encoding: (NSStringEncoding) encoding;
+
+- (void) appendString: (NSString *) string;
+- (void) appendFormat: (NSString *) format, ... NS_FORMAT_FUNCTION(1,2);
+- (void) appendUTF8Bytes: (const char *) bytes length: (NSUInteger) length;
+- (BOOL) flush;
+
+/** The first error that occured, or nil. */
+@property(nonatomic, readonly) NSError *error;
+
+@end
 
 @interface PLCrashReportTextFormatter (PrivateAPI)
-NSInteger binaryImageSort(id binary1, id binary2, void *context);
-+ (NSString *) formatStackFrame: (PLCrashReportStackFrameInfo *) frameInfo
-                     frameIndex: (NSUInteger) frameIndex
-                         report: (PLCrashReport *) report
-                           lp64: (BOOL) lp64;
+- (BOOL) writeReport: (PLCrashReport *) report toOutput: (PLCrashReportTextOutput *) output error: (NSError **) outError;
++ (BOOL) formatCrashReport: (PLCrashReport *) report withTextFormat: (PLCrashReportTextFormat) textFormat demangleSymbols: (BOOL) demangleSymbols output: (id) text;
++ (void) appendStackFrame: (PLCrashReportStackFrameInfo *) frameInfo
+               frameIndex: (NSUInteger) frameIndex
+                   report: (PLCrashReport *) report
+                     lp64: (BOOL) lp64
+          demangleSymbols: (BOOL) demangleSymbols
+                 toBuffer: (plcrash_text_buffer_t *) buffer;
 @end
 
+/**
+ * @internal
+ *
+ * Append the UTF-8 encoding of @a string to @a buffer, without allocating any intermediate objects. As with the
+ * "%@" format specifier, a nil @a string is appended as "(null)".
+ */
+static void text_buffer_append_nsstring (plcrash_text_buffer_t *buffer, NSString *string) {
+    if (string == nil) {
+        plcrash_text_buffer_append_string(buffer, "(null)");
+        return;
+    }
+
+    /* Use the string's backing store directly, if available */
+    CFStringRef cfString = (CFStringRef) string;
+    const char *cString = CFStringGetCStringPtr(cfString, kCFStringEncodingUTF8);
+    if (cString != NULL) {
+        plcrash_text_buffer_append_string(buffer, cString);
+        return;
+    }
+
+    /* Otherwise, transcode directly into the buffer */
+    CFIndex length = CFStringGetLength(cfString);
+    CFIndex maxSize = CFStringGetMaximumSizeForEncoding(length, kCFStringEncodingUTF8);
+    char *p = plcrash_text_buffer_reserve(buffer, (size_t) maxSize);
+    if (p == NULL)
+        return;
+
+    CFIndex used = 0;
+    CFStringGetBytes(cfString, CFRangeMake(0, length), kCFStringEncodingUTF8, '?', false, (UInt8 *) p, maxSize, &used);
+    buffer->length += (size_t) used;
+}
+
+static void text_buffer_append_format (plcrash_text_buffer_t *buffer, NSString *format, ...) NS_FORMAT_FUNCTION(2,3);
+
+/**
+ * @internal
+ *
+ * Format and append a string to @a buffer. Used for the report's header lines, which are written once per report;
+ * per-frame, per-register and per-image lines are rendered directly into the buffer.
+ */
+static void text_buffer_append_format (plcrash_text_buffer_t *buffer, NSString *format, ...) {
+    va_list ap;
+    va_start(ap, format);
+    NSString *string = [[NSString alloc] initWithFormat: format arguments: ap];
+    va_end(ap);
+
+    text_buffer_append_nsstring(buffer, string);
+    [string release];
+}
+
+/**
+ * @internal
+ *
+ * Append the last path component of @a path to @a buffer, as per -[NSString lastPathComponent].
+ */
+static void text_buffer_append_last_path_component (plcrash_text_buffer_t *buffer, NSString *path) {
+    size_t start = buffer->length;
+    text_buffer_append_nsstring(buffer, path);
+    if (path != nil)
+        plcrash_text_buffer_trim_to_last_path_component(buffer, start);
+}
+
+/**
+ * @internal
+ *
+ * Append @a value as a "0x"-prefixed hexadecimal address, right-aligned to @a width characters. This is equivalent
+ * to the printf() format "%*#" PRIx64; as with printf(), a zero value is written without a prefix.
+ */
+static void text_buffer_append_aligned_address (plcrash_text_buffer_t *buffer, uint64_t value, size_t width) {
+    size_t start = buffer->length;
+    if (value != 0) {
+        plcrash_text_buffer_append(buffer, "0x", 2);
+        plcrash_text_buffer_append_hex(buffer, value, 0);
+    } else {
+        plcrash_text_buffer_append(buffer, "0", 1);
+    }
+    plcrash_text_buffer_pad(buffer, start, width, false);
+}
+
+/**
+ * @internal
+ *
+ * Move the contents of @a buffer to the output target @a text, resetting the buffer.
+ *
+ * An NSMutableString target is only appended to once the report is complete, so that a single string is created per
+ * report; NSMutableData and PLCrashReportTextOutput targets receive the encoded bytes directly whenever the buffer
+ * is drained.
+ *
+ * @param buffer The buffer to drain.
+ * @param text The output target.
+ * @param complete YES if the report has been completely formatted.
+ */
+static void text_buffer_drain (plcrash_text_buffer_t *buffer, id text, BOOL complete) {
+    if (buffer->failed || buffer->length == 0)
+        return;
+
+    if ([text isKindOfClass: [PLCrashReportTextOutput class]]) {
+        [(PLCrashReportTextOutput *) text appendUTF8Bytes: buffer->data length: buffer->length];
+    } else if ([text isKindOfClass: [NSMutableData class]]) {
+        [(NSMutableData *) text appendBytes: buffer->data length: buffer->length];
+    } else if (complete) {
+        NSString *string = [[NSString alloc] initWithBytes: buffer->data length: buffer->length encoding: NSUTF8StringEncoding];
+        if (string != nil)
+            [(NSMutableString *) text appendString: string];
+        [string release];
+    } else {
+        return;
+    }
+
+    plcrash_text_buffer_reset(buffer);
+}
+
 
 /**
  * Formats PLCrashReport data as human-readable text.
@@ -58,8 +223,47 @@ NSInteger binaryImageSort(id binary1, id binary2, void *context);
  * @return Returns the formatted result on success, or nil if an error occurs.
  */
 + (NSString *) stringValueForCrashReport: (PLCrashReport *) report withTextFormat: (PLCrashReportTextFormat) textFormat {
+    return [self stringValueForCrashReport: report withTextFormat: textFormat demangleSymbols: NO];
+}
+
+/**
+ * Formats the provided @a report as human-readable text in the given @a textFormat, and return
+ * the formatted result as a string.
+ *
+ * @param report The report to format.
+ * @param textFormat The text format to use.
+ * @param demangleSymbols If YES, mangled C++ and Swift symbol names are demangled. Demangled names are cached
+ * for the lifetime of the process, and shared by all formatters.
+ *
+ * @return Returns the formatted result on success, or nil if an error occurs.
+ */
++ (NSString *) stringValueForCrashReport: (PLCrashReport *) report withTextFormat: (PLCrashReportTextFormat) textFormat demangleSymbols: (BOOL) demangleSymbols {
 	NSMutableString* text = [NSMutableString string];
+    if (![self formatCrashReport: report withTextFormat: textFormat demangleSymbols: demangleSymbols output: text])
+        return nil;
+
+    return text;
+}
+
+/**
+ * Formats the provided @a report as human-readable text in the given @a textFormat, appending the
+ * result to @a text.
+ *
+ * Report lines are rendered as UTF-8 into a reusable buffer, rather than formatted as individual strings, and the
+ * buffer is then appended to @a text.
+ *
+ * @param report The report to format.
+ * @param textFormat The text format to use.
+ * @param demangleSymbols If YES, mangled C++ and Swift symbol names are demangled.
+ * @param text The output target. This may be an NSMutableString, an NSMutableData (to which UTF-8 encoded text will
+ * be appended), or a PLCrashReportTextOutput instance.
+ *
+ * @return Returns YES on success, or NO if the formatting buffer could not be allocated.
+ */
++ (BOOL) formatCrashReport: (PLCrashReport *) report withTextFormat: (PLCrashReportTextFormat) textFormat demangleSymbols: (BOOL) demangleSymbols output: (id) text {
 	boolean_t lp64 = true; // quiesce GCC uninitialized value warning
+    plcrash_text_buffer_t buffer;
+    plcrash_text_buffer_init(&buffer);
 
 	/* Header */
 	
@@ -163,9 +367,9 @@ NSInteger binaryImageSort(id binary1, id binary2, void *context);
             [incidentIdentifier autorelease];
         }
     
-        [text appendFormat: @"Incident Identifier: %@\n", incidentIdentifier];
-        [text appendFormat: @"CrashReporter Key:   TODO\n"];
-        [text appendFormat: @"Hardware Model:      %@\n", hardwareModel];
+        text_buffer_append_format(&buffer, @"Incident Identifier: %@\n", incidentIdentifier);
+        plcrash_text_buffer_append_string(&buffer, "CrashReporter Key:   TODO\n");
+        text_buffer_append_format(&buffer, @"Hardware Model:      %@\n", hardwareModel);
     }
     
     /* Application and process info */
@@ -199,15 +403,15 @@ NSInteger binaryImageSort(id binary1, id binary2, void *context);
             parentProcessId = [[NSNumber numberWithUnsignedInteger: report.processInfo.parentProcessID] stringValue];
         }
         
-        [text appendFormat: @"Process:         %@ [%@]\n", processName, processId];
-        [text appendFormat: @"Path:            %@\n", processPath];
-        [text appendFormat: @"Identifier:      %@\n", report.applicationInfo.applicationIdentifier];
-        [text appendFormat: @"Version:         %@\n", report.applicationInfo.applicationVersion];
-        [text appendFormat: @"Code Type:       %@\n", codeType];
-        [text appendFormat: @"Parent Process:  %@ [%@]\n", parentProcessName, parentProcessId];
+        text_buffer_append_format(&buffer, @"Process:         %@ [%@]\n", processName, processId);
+        text_buffer_append_format(&buffer, @"Path:            %@\n", processPath);
+        text_buffer_append_format(&buffer, @"Identifier:      %@\n", report.applicationInfo.applicationIdentifier);
+        text_buffer_append_format(&buffer, @"Version:         %@\n", report.applicationInfo.applicationVersion);
+        text_buffer_append_format(&buffer, @"Code Type:       %@\n", codeType);
+        text_buffer_append_format(&buffer, @"Parent Process:  %@ [%@]\n", parentProcessName, parentProcessId);
     }
     
-    [text appendString: @"\n"];
+    plcrash_text_buffer_append_string(&buffer, "\n");
     
     /* System info */
     {
@@ -215,33 +419,35 @@ NSInteger binaryImageSort(id binary1, id binary2, void *context);
         if (report.systemInfo.operatingSystemBuild != nil)
             osBuild = report.systemInfo.operatingSystemBuild;
         
-        [text appendFormat: @"Date/Time:       %@\n", report.systemInfo.timestamp];
-        [text appendFormat: @"OS Version:      %@ %@ (%@)\n", osName, report.systemInfo.operatingSystemVersion, osBuild];
-        [text appendFormat: @"Report Version:  104\n"];        
+        text_buffer_append_format(&buffer, @"Date/Time:       %@\n", report.systemInfo.timestamp);
+        text_buffer_append_format(&buffer, @"OS Version:      %@ %@ (%@)\n", osName, report.systemInfo.operatingSystemVersion, osBuild);
+        plcrash_text_buffer_append_string(&buffer, "Report Version:  104\n");
     }
 
-    [text appendString: @"\n"];
+    plcrash_text_buffer_append_string(&buffer, "\n");
 
     /* Exception code */
-    [text appendFormat: @"Exception Type:  %@\n", report.signalInfo.name];
-    [text appendFormat: @"Exception Codes: %@ at 0x%" PRIx64 "\n", report.signalInfo.code, report.signalInfo.address];
+    text_buffer_append_format(&buffer, @"Exception Type:  %@\n", report.signalInfo.name);
+    text_buffer_append_format(&buffer, @"Exception Codes: %@ at 0x%" PRIx64 "\n", report.signalInfo.code, report.signalInfo.address);
     
     for (PLCrashReportThreadInfo *thread in report.threads) {
         if (thread.crashed) {
-            [text appendFormat: @"Crashed Thread:  %ld\n", (long) thread.threadNumber];
+            plcrash_text_buffer_append_string(&buffer, "Crashed Thread:  ");
+            plcrash_text_buffer_append_signed(&buffer, thread.threadNumber);
+            plcrash_text_buffer_append_string(&buffer, "\n");
             break;
         }
     }
     
-    [text appendString: @"\n"];
+    plcrash_text_buffer_append_string(&buffer, "\n");
     
     /* Uncaught Exception */
     if (report.hasExceptionInfo) {
-        [text appendFormat: @"Application Specific Information:\n"];
-        [text appendFormat: @"*** Terminating app due to uncaught exception '%@', reason: '%@'\n",
-                report.exceptionInfo.exceptionName, report.exceptionInfo.exceptionReason];
+        plcrash_text_buffer_append_string(&buffer, "Application Specific Information:\n");
+        text_buffer_append_format(&buffer, @"*** Terminating app due to uncaught exception '%@', reason: '%@'\n",
+                report.exceptionInfo.exceptionName, report.exceptionInfo.exceptionReason);
         
-        [text appendString: @"\n"];
+        plcrash_text_buffer_append_string(&buffer, "\n");
     }
 
     /* If an exception stack trace is available, output an Apple-compatible backtrace. */
@@ -249,80 +455,114 @@ NSInteger binaryImageSort(id binary1, id binary2, void *context);
         PLCrashReportExceptionInfo *exception = report.exceptionInfo;
         
         /* Create the header. */
-        [text appendString: @"Last Exception Backtrace:\n"];
+        plcrash_text_buffer_append_string(&buffer, "Last Exception Backtrace:\n");
 
         /* Write out the frames. In raw reports, Apple writes this out as a simple list of PCs. In the minimally
          * post-processed report, Apple writes this out as full frame entries. We use the latter format. */
         for (NSUInteger frame_idx = 0; frame_idx < [exception.stackFrames count]; frame_idx++) {
             PLCrashReportStackFrameInfo *frameInfo = [exception.stackFrames objectAtIndex: frame_idx];
-            [text appendString: [self formatStackFrame: frameInfo frameIndex: frame_idx report: report lp64: lp64]];
+            [self appendStackFrame: frameInfo frameIndex: frame_idx report: report lp64: lp64 demangleSymbols: demangleSymbols toBuffer: &buffer];
         }
-        [text appendString: @"\n"];
+        plcrash_text_buffer_append_string(&buffer, "\n");
     }
 
+    text_buffer_drain(&buffer, text, NO);
+
     /* Threads */
     PLCrashReportThreadInfo *crashed_thread = nil;
     NSInteger maxThreadNum = 0;
     for (PLCrashReportThreadInfo *thread in report.threads) {
+        if (thread.name != nil)
+            text_buffer_append_format(&buffer, @"Thread %ld name:  %@\n", (long) thread.threadNumber, thread.name);
+
+        plcrash_text_buffer_append_string(&buffer, "Thread ");
+        plcrash_text_buffer_append_signed(&buffer, thread.threadNumber);
         if (thread.crashed) {
-            [text appendFormat: @"Thread %ld Crashed:\n", (long) thread.threadNumber];
+            plcrash_text_buffer_append_string(&buffer, " Crashed:\n");
             crashed_thread = thread;
         } else {
-            [text appendFormat: @"Thread %ld:\n", (long) thread.threadNumber];
+            plcrash_text_buffer_append_string(&buffer, ":\n");
         }
-        for (NSUInteger frame_idx = 0; frame_idx < [thread.stackFrames count]; frame_idx++) {
+        NSUInteger repeatEnd = 0;
+        PLCrashReportStackFrameInfo *repeatStart = nil;
+        NSUInteger frameCount = [thread.stackFrames count];
+        for (NSUInteger frame_idx = 0; frame_idx < frameCount; frame_idx++) {
             PLCrashReportStackFrameInfo *frameInfo = [thread.stackFrames objectAtIndex: frame_idx];
-            [text appendString: [self formatStackFrame: frameInfo frameIndex: frame_idx report: report lp64: lp64]];
+            if (frameInfo.omittedFrameCount > 0) {
+                plcrash_text_buffer_append_string(&buffer, "... ");
+                plcrash_text_buffer_append_unsigned(&buffer, frameInfo.omittedFrameCount);
+                plcrash_text_buffer_append_string(&buffer, " frames omitted ...\n");
+            }
+
+            /* Note the start of a repeated frame group */
+            if (frameInfo.repeatCount > 1 && repeatStart == nil) {
+                repeatStart = frameInfo;
+                repeatEnd = frame_idx + frameInfo.repeatLength - 1;
+            }
+
+            [self appendStackFrame: frameInfo frameIndex: frame_idx report: report lp64: lp64 demangleSymbols: demangleSymbols toBuffer: &buffer];
+
+            if (repeatStart != nil && (frame_idx == repeatEnd || frame_idx + 1 == frameCount)) {
+                plcrash_text_buffer_append_string(&buffer, "... previous ");
+                plcrash_text_buffer_append_unsigned(&buffer, repeatStart.repeatLength);
+                plcrash_text_buffer_append_string(&buffer, " frames repeated ");
+                plcrash_text_buffer_append_unsigned(&buffer, repeatStart.repeatCount);
+                plcrash_text_buffer_append_string(&buffer, " times ...\n");
+                repeatStart = nil;
+            }
         }
-        [text appendString: @"\n"];
+        plcrash_text_buffer_append_string(&buffer, "\n");
 
         /* Track the highest thread number */
         maxThreadNum = MAX(maxThreadNum, thread.threadNumber);
+
+        text_buffer_drain(&buffer, text, NO);
     }
 
     /* Registers */
     if (crashed_thread != nil) {
-        [text appendFormat: @"Thread %ld crashed with %@ Thread State:\n", (long) crashed_thread.threadNumber, codeType];
-        
+        text_buffer_append_format(&buffer, @"Thread %ld crashed with %@ Thread State:\n", (long) crashed_thread.threadNumber, codeType);
+
+        /* Apple uses 'ip' rather than 'r12' on ARM */
+        BOOL remapARMRegisters = NO;
+        if (report.machineInfo != nil && report.machineInfo.processorInfo.typeEncoding == PLCrashReportProcessorTypeEncodingMach) {
+            PLCrashReportProcessorInfo *pinfo = report.machineInfo.processorInfo;
+            cpu_type_t arch_type = pinfo.type & ~CPU_ARCH_MASK;
+            remapARMRegisters = (arch_type == CPU_TYPE_ARM);
+        }
+
         int regColumn = 0;
         for (PLCrashReportRegisterInfo *reg in crashed_thread.registers) {
-            NSString *reg_fmt;
-            
-            /* Use 32-bit or 64-bit fixed width format for the register values */
-            if (lp64)
-                reg_fmt = @"%6s: 0x%016" PRIx64 " ";
-            else
-                reg_fmt = @"%6s: 0x%08" PRIx64 " ";
-            
             /* Remap register names to match Apple's crash reports */
             NSString *regName = reg.registerName;
-            if (report.machineInfo != nil && report.machineInfo.processorInfo.typeEncoding == PLCrashReportProcessorTypeEncodingMach) {
-                PLCrashReportProcessorInfo *pinfo = report.machineInfo.processorInfo;
-                cpu_type_t arch_type = pinfo.type & ~CPU_ARCH_MASK;
-
-                /* Apple uses 'ip' rather than 'r12' on ARM */
-                if (arch_type == CPU_TYPE_ARM && [regName isEqual: @"r12"]) {
-                    regName = @"ip";
-                }
-            }
-            [text appendFormat: reg_fmt, [regName UTF8String], reg.registerValue];
+            if (remapARMRegisters && [regName isEqual: @"r12"])
+                regName = @"ip";
+
+            /* Use 32-bit or 64-bit fixed width format for the register values */
+            size_t start = buffer.length;
+            text_buffer_append_nsstring(&buffer, regName);
+            plcrash_text_buffer_pad(&buffer, start, 6, false);
+            plcrash_text_buffer_append_string(&buffer, ": 0x");
+            plcrash_text_buffer_append_hex(&buffer, reg.registerValue, lp64 ? 16 : 8);
+            plcrash_text_buffer_append_string(&buffer, " ");
 
             regColumn++;
             if (regColumn == 4) {
-                [text appendString: @"\n"];
+                plcrash_text_buffer_append_string(&buffer, "\n");
                 regColumn = 0;
             }
         }
         
         if (regColumn != 0)
-            [text appendString: @"\n"];
+            plcrash_text_buffer_append_string(&buffer, "\n");
         
-        [text appendString: @"\n"];
+        plcrash_text_buffer_append_string(&buffer, "\n");
     }
     
     /* Images. The iPhone crash report format sorts these in ascending order, by the base address */
-    [text appendString: @"Binary Images:\n"];
-    for (PLCrashReportBinaryImageInfo *imageInfo in [report.images sortedArrayUsingFunction: binaryImageSort context: nil]) {
+    plcrash_text_buffer_append_string(&buffer, "Binary Images:\n");
+    PLCrashReportBinaryImageInfo *executableImage = report.executableImage;
+    for (PLCrashReportBinaryImageInfo *imageInfo in report.sortedImages) {
         NSString *uuid;
         /* Fetch the UUID if it exists */
         if (imageInfo.hasImageUUID)
@@ -331,40 +571,40 @@ NSInteger binaryImageSort(id binary1, id binary2, void *context);
             uuid = @"???";
         
         /* Determine the architecture string */
-        NSString *archName = @"???";
+        const char *archName = "???";
         if (imageInfo.codeType != nil && imageInfo.codeType.typeEncoding == PLCrashReportProcessorTypeEncodingMach) {
             switch (imageInfo.codeType.type) {
                 case CPU_TYPE_ARM:
                     /* Apple includes subtype for ARM binaries. */
                     switch (imageInfo.codeType.subtype) {
                         case CPU_SUBTYPE_ARM_V6:
-                            archName = @"armv6";
+                            archName = "armv6";
                             break;
 
                         case CPU_SUBTYPE_ARM_V7:
-                            archName = @"armv7";
+                            archName = "armv7";
                             break;
                             
                         case CPU_SUBTYPE_ARM_V7S:
-                            archName = @"armv7s";
+                            archName = "armv7s";
                             break;
 
                         default:
-                            archName = @"arm-unknown";
+                            archName = "arm-unknown";
                             break;
                     }
                     break;
                     
                 case CPU_TYPE_X86:
-                    archName = @"i386";
+                    archName = "i386";
                     break;
                     
                 case CPU_TYPE_X86_64:
-                    archName = @"x86_64";
+                    archName = "x86_64";
                     break;
 
                 case CPU_TYPE_POWERPC:
-                    archName = @"powerpc";
+                    archName = "powerpc";
                     break;
 
                 default:
@@ -374,30 +614,33 @@ NSInteger binaryImageSort(id binary1, id binary2, void *context);
         }
 
         /* Determine if this is the main executable */
-        NSString *binaryDesignator = @" ";
-        if ([imageInfo.imageName isEqual: report.processInfo.processPath])
-            binaryDesignator = @"+";
+        const char *binaryDesignator = " ";
+        if (imageInfo == executableImage)
+            binaryDesignator = "+";
         
         /* base_address - terminating_address [designator]file_name arch <uuid> file_path */
-        NSString *fmt = nil;
-        if (lp64) {
-            fmt = @"%18#" PRIx64 " - %18#" PRIx64 " %@%@ %@  <%@> %@\n";
-        } else {
-            fmt = @"%10#" PRIx64 " - %10#" PRIx64 " %@%@ %@  <%@> %@\n";
-        }
-
-        [text appendFormat: fmt,
-                            imageInfo.imageBaseAddress,
-                            imageInfo.imageBaseAddress + (MAX(1, imageInfo.imageSize) - 1), // The Apple format uses an inclusive range
-                            binaryDesignator,
-                            [imageInfo.imageName lastPathComponent],
-                            archName,
-                            uuid,
-                            imageInfo.imageName];
+        size_t addressWidth = lp64 ? 18 : 10;
+        text_buffer_append_aligned_address(&buffer, imageInfo.imageBaseAddress, addressWidth);
+        plcrash_text_buffer_append_string(&buffer, " - ");
+        // The Apple format uses an inclusive range
+        text_buffer_append_aligned_address(&buffer, imageInfo.imageBaseAddress + (MAX(1, imageInfo.imageSize) - 1), addressWidth);
+        plcrash_text_buffer_append_string(&buffer, " ");
+        plcrash_text_buffer_append_string(&buffer, binaryDesignator);
+        text_buffer_append_last_path_component(&buffer, imageInfo.imageName);
+        plcrash_text_buffer_append_string(&buffer, " ");
+        plcrash_text_buffer_append_string(&buffer, archName);
+        plcrash_text_buffer_append_string(&buffer, "  <");
+        text_buffer_append_nsstring(&buffer, uuid);
+        plcrash_text_buffer_append_string(&buffer, "> ");
+        text_buffer_append_nsstring(&buffer, imageInfo.imageName);
+        plcrash_text_buffer_append_string(&buffer, "\n");
     }
-    
 
-    return text;
+    BOOL success = !buffer.failed;
+    text_buffer_drain(&buffer, text, YES);
+    plcrash_text_buffer_free(&buffer);
+
+    return success;
 }
 
 /**
@@ -407,106 +650,411 @@ NSInteger binaryImageSort(id binary1, id binary2, void *context);
  * @param stringEncoding Encoding to use when writing to the output stream.
  */
 - (id) initWithTextFormat: (PLCrashReportTextFormat) textFormat stringEncoding: (NSStringEncoding) stringEncoding {
+    return [self initWithTextFormat: textFormat stringEncoding: stringEncoding demangleSymbols: NO];
+}
+
+/**
+ * Initialize with the request string encoding and output format, optionally demangling symbol names.
+ *
+ * @param textFormat Format to use for the generated text crash report.
+ * @param stringEncoding Encoding to use when writing to the output stream.
+ * @param demangleSymbols If YES, mangled C++ and Swift symbol names are demangled. Demangled names are cached
+ * for the lifetime of the process, and shared by all formatters, such that a batch of reports demangles each
+ * distinct symbol once.
+ */
+- (id) initWithTextFormat: (PLCrashReportTextFormat) textFormat stringEncoding: (NSStringEncoding) stringEncoding demangleSymbols: (BOOL) demangleSymbols {
     if ((self = [super init]) == nil)
         return nil;
     
     _textFormat = textFormat;
     _stringEncoding = stringEncoding;
+    _demangleSymbols = demangleSymbols;
 
     return self;
 }
 
 // from PLCrashReportFormatter protocol
 - (NSData *) formatReport: (PLCrashReport *) report error: (NSError **) outError {
-    NSString *text = [PLCrashReportTextFormatter stringValueForCrashReport: report withTextFormat: _textFormat];
+    /* UTF-8 output is appended directly from the formatting buffer, without an intermediate string */
+    if (_stringEncoding == NSUTF8StringEncoding) {
+        NSMutableData *data = [NSMutableData data];
+        if (![PLCrashReportTextFormatter formatCrashReport: report withTextFormat: _textFormat demangleSymbols: _demangleSymbols output: data]) {
+            plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not allocate the report formatting buffer", nil);
+            return nil;
+        }
+
+        return data;
+    }
+
+    NSString *text = [PLCrashReportTextFormatter stringValueForCrashReport: report withTextFormat: _textFormat demangleSymbols: _demangleSymbols];
+    if (text == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not allocate the report formatting buffer", nil);
+        return nil;
+    }
+
     return [text dataUsingEncoding: _stringEncoding allowLossyConversion: YES];
 }
+
+/**
+ * Format the provided @a report, writing the encoded text directly to @a stream.
+ *
+ * Unlike formatReport:error:, the formatted report is never held in memory in its entirety; text is encoded
+ * into a small reusable buffer that is written to @a stream as it fills.
+ *
+ * @param report Report to be formatted.
+ * @param stream An open output stream to which the formatted report will be written.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the report could not be written. If no error occurs, this parameter will be left unmodified.
+ * You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO on failure.
+ */
+- (BOOL) writeReport: (PLCrashReport *) report toStream: (NSOutputStream *) stream error: (NSError **) outError {
+    PLCrashReportTextOutput *output = [[[PLCrashReportTextOutput alloc] initWithStream: stream encoding: _stringEncoding] autorelease];
+    return [self writeReport: report toOutput: output error: outError];
+}
+
+/**
+ * Format the provided @a report, writing the encoded text directly to the file descriptor @a fd.
+ *
+ * @param report Report to be formatted.
+ * @param fd An open file descriptor to which the formatted report will be written. The descriptor will not be closed.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the report could not be written. If no error occurs, this parameter will be left unmodified.
+ * You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO on failure.
+ *
+ * @sa writeReport:toStream:error:
+ */
+- (BOOL) writeReport: (PLCrashReport *) report toFileDescriptor: (int) fd error: (NSError **) outError {
+    PLCrashReportTextOutput *output = [[[PLCrashReportTextOutput alloc] initWithFileDescriptor: fd encoding: _stringEncoding] autorelease];
+    return [self writeReport: report toOutput: output error: outError];
+}
 		 
 @end
 
 
+/**
+ * Append the line prefix shared by a stack frame and its inlined functions: the frame index, the containing image's
+ * name, and the instruction pointer. Equivalent to the format "%-4ld%-35S 0x%0*" PRIx64 " ".
+ */
+static void text_buffer_append_frame_prefix (plcrash_text_buffer_t *buffer, NSUInteger frameIndex, NSString *imagePath, uint64_t instructionPointer, BOOL lp64) {
+    size_t start = buffer->length;
+    plcrash_text_buffer_append_unsigned(buffer, frameIndex);
+    plcrash_text_buffer_pad(buffer, start, 4, true);
+
+    start = buffer->length;
+    if (imagePath != nil)
+        text_buffer_append_last_path_component(buffer, imagePath);
+    else
+        plcrash_text_buffer_append_string(buffer, "???");
+    plcrash_text_buffer_pad(buffer, start, 35, true);
+
+    plcrash_text_buffer_append_string(buffer, " 0x");
+    plcrash_text_buffer_append_hex(buffer, instructionPointer, lp64 ? 16 : 8);
+    plcrash_text_buffer_append_string(buffer, " ");
+}
+
+/**
+ * Append @a symbolName, demangled via the shared demangle cache if @a demangle is YES and the name is a mangled C++
+ * or Swift symbol. Returns YES if a demangled name was appended.
+ */
+static BOOL text_buffer_append_symbol_name (plcrash_text_buffer_t *buffer, NSString *symbolName, BOOL demangle) {
+    plcrash_demangle_cache_t *cache = demangle ? plcrash_demangle_cache_shared() : NULL;
+    if (cache != NULL) {
+        char *demangled = plcrash_demangle_cache_copy_demangled(cache, [symbolName UTF8String]);
+        if (demangled != NULL) {
+            plcrash_text_buffer_append_string(buffer, demangled);
+            free(demangled);
+            return YES;
+        }
+    }
+
+    text_buffer_append_nsstring(buffer, symbolName);
+    return NO;
+}
+
+/**
+ * Append a " (file:line)" source position suffix, if @a sourceFile is non-nil and @a sourceLine is non-zero.
+ */
+static void text_buffer_append_source_position (plcrash_text_buffer_t *buffer, NSString *sourceFile, uint32_t sourceLine) {
+    if (sourceFile == nil || sourceLine == 0)
+        return;
+
+    plcrash_text_buffer_append_string(buffer, " (");
+    text_buffer_append_last_path_component(buffer, sourceFile);
+    plcrash_text_buffer_append_string(buffer, ":");
+    plcrash_text_buffer_append_unsigned(buffer, sourceLine);
+    plcrash_text_buffer_append_string(buffer, ")");
+}
+
+
 @implementation PLCrashReportTextFormatter (PrivateMethods)
 
 /**
- * Format a stack frame for display in a thread backtrace.
+ * Format the provided @a report to @a output, and flush the output.
+ */
+- (BOOL) writeReport: (PLCrashReport *) report toOutput: (PLCrashReportTextOutput *) output error: (NSError **) outError {
+    if (![PLCrashReportTextFormatter formatCrashReport: report withTextFormat: _textFormat demangleSymbols: _demangleSymbols output: output]) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not allocate the report formatting buffer", nil);
+        return NO;
+    }
+
+    if (![output flush]) {
+        if (outError != NULL)
+            *outError = output.error;
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ * Format a stack frame for display in a thread backtrace, appending the formatted frame line to @a buffer, preceded
+ * by a line for each function inlined at the frame's address.
  *
  * @param frameInfo The stack frame to format
  * @param frameIndex The frame's index
  * @param report The report from which this frame was acquired.
  * @param lp64 If YES, the report was generated by an LP64 system.
- *
- * @return Returns a formatted frame line.
+ * @param demangleSymbols If YES, mangled symbol names are demangled.
+ * @param buffer The buffer to which the formatted lines will be appended.
  */
-+ (NSString *) formatStackFrame: (PLCrashReportStackFrameInfo *) frameInfo
-                     frameIndex: (NSUInteger) frameIndex
-                         report: (PLCrashReport *) report
-                           lp64: (BOOL) lp64
++ (void) appendStackFrame: (PLCrashReportStackFrameInfo *) frameInfo
+               frameIndex: (NSUInteger) frameIndex
+                   report: (PLCrashReport *) report
+                     lp64: (BOOL) lp64
+          demangleSymbols: (BOOL) demangleSymbols
+                 toBuffer: (plcrash_text_buffer_t *) buffer
 {
     /* Base image address containing instrumention pointer, offset of the IP from that base
-     * address, and the associated image name */
+     * address, and the associated image path */
     uint64_t baseAddress = 0x0;
     uint64_t pcOffset = 0x0;
-    NSString *imageName = @"\?\?\?";
-    NSString *symbolString = nil;
+    NSString *imagePath = nil;
+    uint64_t instructionPointer = frameInfo.instructionPointer;
     
-    PLCrashReportBinaryImageInfo *imageInfo = [report imageForAddress: frameInfo.instructionPointer];
+    PLCrashReportBinaryImageInfo *imageInfo = [report imageForAddress: instructionPointer];
     if (imageInfo != nil) {
-        imageName = [imageInfo.imageName lastPathComponent];
+        imagePath = imageInfo.imageName;
         baseAddress = imageInfo.imageBaseAddress;
-        pcOffset = frameInfo.instructionPointer - imageInfo.imageBaseAddress;
+        pcOffset = instructionPointer - imageInfo.imageBaseAddress;
     }
 
     /* If symbol info is available, the format used in Apple's reports is Sym + OffsetFromSym. Otherwise,
      * the format used is imageBaseAddress + offsetToIP */
-    if (frameInfo.symbolInfo != nil) {
-        NSString *symbolName = frameInfo.symbolInfo.symbolName;
-
-        /* Apple strips the _ symbol prefix in their reports. Only OS X makes use of an
-         * underscore symbol prefix by default. */
-        if ([symbolName rangeOfString: @"_"].location == 0 && [symbolName length] > 1) {
-            switch (report.systemInfo.operatingSystem) {
-                case PLCrashReportOperatingSystemMacOSX:
-                case PLCrashReportOperatingSystemiPhoneOS:
-                case PLCrashReportOperatingSystemiPhoneSimulator:
-                    symbolName = [symbolName substringFromIndex: 1];
-                    break;
+    PLCrashReportSymbolInfo *symbolInfo = frameInfo.symbolInfo;
+    if (symbolInfo == nil) {
+        text_buffer_append_frame_prefix(buffer, frameIndex, imagePath, instructionPointer, lp64);
+        plcrash_text_buffer_append_string(buffer, "0x");
+        plcrash_text_buffer_append_hex(buffer, baseAddress, 0);
+        plcrash_text_buffer_append_string(buffer, " + ");
+        plcrash_text_buffer_append_signed(buffer, (int64_t) pcOffset);
+        plcrash_text_buffer_append_string(buffer, "\n");
+        return;
+    }
 
-                default:
-                    NSLog(@"Symbol prefix rules are unknown for this OS!");
-                    break;
-            }
+    /* Functions inlined at the frame's address are each listed on a line of their own, sharing the frame's
+     * index, as Apple's symbolication tools do. The source position of each is the call site recorded by the
+     * preceding inlined function; the innermost is positioned at the frame's own source position. */
+    NSString *sourceFile = symbolInfo.sourceFile;
+    uint32_t sourceLine = symbolInfo.sourceLine;
+    for (PLCrashReportInlinedFrameInfo *inlined in symbolInfo.inlinedFrames) {
+        text_buffer_append_frame_prefix(buffer, frameIndex, imagePath, instructionPointer, lp64);
+        if (inlined.symbolName != nil)
+            text_buffer_append_symbol_name(buffer, inlined.symbolName, demangleSymbols);
+        else
+            plcrash_text_buffer_append_string(buffer, "???");
+        text_buffer_append_source_position(buffer, sourceFile, sourceLine);
+        plcrash_text_buffer_append_string(buffer, " [inlined]\n");
+
+        sourceFile = inlined.callFile;
+        sourceLine = inlined.callLine;
+    }
+
+    text_buffer_append_frame_prefix(buffer, frameIndex, imagePath, instructionPointer, lp64);
+
+    /* Apple strips the _ symbol prefix in their reports. Only OS X makes use of an
+     * underscore symbol prefix by default. Demangled names have no prefix. */
+    size_t start = buffer->length;
+    BOOL demangled = text_buffer_append_symbol_name(buffer, symbolInfo.symbolName, demangleSymbols);
+    if (!demangled && !buffer->failed && buffer->length - start > 1 && buffer->data[start] == '_') {
+        switch (report.systemInfo.operatingSystem) {
+            case PLCrashReportOperatingSystemMacOSX:
+            case PLCrashReportOperatingSystemiPhoneOS:
+            case PLCrashReportOperatingSystemiPhoneSimulator:
+                memmove(buffer->data + start, buffer->data + start + 1, buffer->length - start - 1);
+                buffer->length--;
+                break;
+
+            default:
+                NSLog(@"Symbol prefix rules are unknown for this OS!");
+                break;
         }
-        
-        
-        uint64_t symOffset = frameInfo.instructionPointer - frameInfo.symbolInfo.startAddress;
-        symbolString = [NSString stringWithFormat: @"%@ + %" PRId64, symbolName, symOffset];
-    } else {
-        symbolString = [NSString stringWithFormat: @"0x%" PRIx64 " + %" PRId64, baseAddress, pcOffset];
     }
 
-    /* Note that width specifiers are ignored for %@, but work for C strings.
-     * UTF-8 is not correctly handled with %s (it depends on the system encoding), but
-     * UTF-16 is supported via %S, so we use it here */
-    return [NSString stringWithFormat: @"%-4ld%-35S 0x%0*" PRIx64 " %@\n",
-            (long) frameIndex,
-            (const uint16_t *)[imageName cStringUsingEncoding: NSUTF16StringEncoding],
-            lp64 ? 16 : 8, frameInfo.instructionPointer,
-            symbolString];
+    plcrash_text_buffer_append_string(buffer, " + ");
+    plcrash_text_buffer_append_signed(buffer, (int64_t) (instructionPointer - symbolInfo.startAddress));
+
+    /* Include the source position, if known, as Apple's symbolication tools do */
+    text_buffer_append_source_position(buffer, sourceFile, sourceLine);
+    plcrash_text_buffer_append_string(buffer, "\n");
 }
 
+@end
+
+@implementation PLCrashReportTextOutput
+
+@synthesize error = _error;
+
 /**
- * Sort PLCrashReportBinaryImageInfo instances by their starting address.
+ * Initialize a new instance that writes to @a stream.
+ *
+ * @param stream An open output stream.
+ * @param encoding The encoding to use for the written text.
  */
-NSInteger binaryImageSort(id binary1, id binary2, void *context) {
-    uint64_t addr1 = [binary1 imageBaseAddress];
-    uint64_t addr2 = [binary2 imageBaseAddress];
-    
-    if (addr1 < addr2)
-        return NSOrderedAscending;
-    else if (addr1 > addr2)
-        return NSOrderedDescending;
-    else
-        return NSOrderedSame;
+- (id) initWithStream: (NSOutputStream *) stream encoding: (NSStringEncoding) encoding {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _stream = [stream retain];
+    _fd = -1;
+    _encoding = encoding;
+
+    return self;
+}
+
+/**
+ * Initialize a new instance that writes to @a fd.
+ *
+ * @param fd An open file descriptor. The descriptor will not be closed.
+ * @param encoding The encoding to use for the written text.
+ */
+- (id) initWithFileDescriptor: (int) fd encoding: (NSStringEncoding) encoding {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _fd = fd;
+    _encoding = encoding;
+
+    return self;
+}
+
+- (void) dealloc {
+    [_stream release];
+    [_error release];
+    [super dealloc];
+}
+
+/**
+ * Encode and append @a string. Characters that can not be represented in the output encoding are lossily converted.
+ */
+- (void) appendString: (NSString *) string {
+    NSRange range = NSMakeRange(0, [string length]);
+
+    while (range.length > 0 && _error == nil) {
+        NSUInteger used = 0;
+        NSRange remaining;
+        BOOL converted = [string getBytes: _buffer + _length
+                                maxLength: sizeof(_buffer) - _length
+                               usedLength: &used
+                                 encoding: _encoding
+                                  options: NSStringEncodingConversionAllowLossy
+                                    range: range
+                           remainingRange: &remaining];
+
+        if (converted && remaining.length < range.length) {
+            _length += used;
+            range = remaining;
+            continue;
+        }
+
+        /* No progress was made. Flush the buffer and retry; if the buffer is already empty, the remaining text can
+         * not be encoded at all, and is dropped. */
+        if (_length == 0)
+            return;
+
+        [self flush];
+    }
+}
+
+/**
+ * Format and append a string.
+ */
+- (void) appendFormat: (NSString *) format, ... {
+    va_list ap;
+    va_start(ap, format);
+    NSString *string = [[NSString alloc] initWithFormat: format arguments: ap];
+    va_end(ap);
+
+    [self appendString: string];
+    [string release];
+}
+
+/**
+ * Append @a length bytes of UTF-8 encoded text. If the output encoding is UTF-8, the bytes are copied directly
+ * into the output buffer; otherwise, they are transcoded as per appendString:.
+ */
+- (void) appendUTF8Bytes: (const char *) bytes length: (NSUInteger) length {
+    if (_encoding != NSUTF8StringEncoding) {
+        NSString *string = [[NSString alloc] initWithBytes: bytes length: length encoding: NSUTF8StringEncoding];
+        if (string != nil)
+            [self appendString: string];
+        [string release];
+        return;
+    }
+
+    while (length > 0 && _error == nil) {
+        if (_length == sizeof(_buffer)) {
+            [self flush];
+            continue;
+        }
+
+        NSUInteger count = MIN(length, sizeof(_buffer) - _length);
+        memcpy(_buffer + _length, bytes, count);
+        _length += count;
+        bytes += count;
+        length -= count;
+    }
+}
+
+/**
+ * Write all buffered bytes to the output.
+ *
+ * @return Returns YES on success, or NO if an error has occured.
+ */
+- (BOOL) flush {
+    NSUInteger written = 0;
+
+    while (written < _length && _error == nil) {
+        if (_stream != nil) {
+            NSInteger ret = [_stream write: _buffer + written maxLength: _length - written];
+            if (ret <= 0) {
+                _error = [_stream streamError];
+                if (_error == nil)
+                    _error = [NSError errorWithDomain: PLCrashReporterErrorDomain code: PLCrashReporterErrorOperatingSystem userInfo: nil];
+                [_error retain];
+                break;
+            }
+            written += ret;
+        } else {
+            ssize_t ret = write(_fd, _buffer + written, _length - written);
+            if (ret < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                NSError *error = nil;
+                plcrash_populate_posix_error(&error, errno, @"Failed to write the formatted crash report");
+                _error = [error retain];
+                break;
+            }
+            written += ret;
+        }
+    }
+
+    _length = 0;
+    return (_error == nil);
 }
 
 @end
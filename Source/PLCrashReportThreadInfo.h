@@ -36,14 +36,23 @@
     /** The thread number. Should be unique within a given crash log. */
     NSInteger _threadNumber;
 
-    /** Ordered list of PLCrashReportStackFrame instances */
+    /** Ordered list of PLCrashReportStackFrame instances, or nil if not yet materialized by @a _stackFramesLoader. */
     NSArray *_stackFrames;
 
+    /** If non-nil, invoked on first access to materialize @a _stackFrames. */
+    NSArray *(^_stackFramesLoader)(void);
+
     /** YES if this thread crashed. */
     BOOL _crashed;
 
+    /** YES if this thread also crashed while the report was being generated. */
+    BOOL _alsoCrashed;
+
     /** List of PLCrashReportRegister instances. Will be empty if _crashed is NO. */
     NSArray *_registers;
+
+    /** The thread's name, or nil if unavailable. */
+    NSString *_name;
 }
 
 - (id) initWithThreadNumber: (NSInteger) threadNumber
@@ -51,6 +60,24 @@
                     crashed: (BOOL) crashed
                   registers: (NSArray *) registers;
 
+- (id) initWithThreadNumber: (NSInteger) threadNumber
+          stackFramesLoader: (NSArray *(^)(void)) stackFramesLoader
+                    crashed: (BOOL) crashed
+                  registers: (NSArray *) registers;
+
+- (id) initWithThreadNumber: (NSInteger) threadNumber
+          stackFramesLoader: (NSArray *(^)(void)) stackFramesLoader
+                    crashed: (BOOL) crashed
+                alsoCrashed: (BOOL) alsoCrashed
+                  registers: (NSArray *) registers;
+
+- (id) initWithThreadNumber: (NSInteger) threadNumber
+          stackFramesLoader: (NSArray *(^)(void)) stackFramesLoader
+                    crashed: (BOOL) crashed
+                alsoCrashed: (BOOL) alsoCrashed
+                  registers: (NSArray *) registers
+                       name: (NSString *) name;
+
 /**
  * Application thread number.
  */
@@ -67,6 +94,12 @@
  */
 @property(nonatomic, readonly) BOOL crashed;
 
+/**
+ * If this thread also crashed while the report was being generated for the crashed thread, set to YES. Such a
+ * thread's backtrace is unwound from its state at the time of its crash, but its registers are not recorded.
+ */
+@property(nonatomic, readonly) BOOL alsoCrashed;
+
 /**
  * State of the general purpose and related registers, as a list of
  * PLCrashReportRegister instances. If this thead did not crash (crashed returns NO),
@@ -74,4 +107,10 @@
  */
 @property(nonatomic, readonly) NSArray *registers;
 
+/**
+ * The thread's name, as recorded when the thread started, or nil if unavailable. Thread names are only
+ * recorded if the crash reporter's thread registry is enabled; see PLCrashReporterConfig::threadRegistryCapacity.
+ */
+@property(nonatomic, readonly) NSString *name;
+
 @end
@@ -54,16 +54,104 @@
     return self;
 }
 
+/**
+ * Initialize the crash log thread information, deferring creation of the thread's stack frames until they
+ * are first accessed.
+ *
+ * @param threadNumber The thread number.
+ * @param stackFramesLoader A block returning the ordered list of PLCrashReportStackFrameInfo instances. The
+ * block will be invoked at most once.
+ * @param crashed YES if this thread crashed.
+ * @param registers The thread's PLCrashReportRegisterInfo instances.
+ */
+- (id) initWithThreadNumber: (NSInteger) threadNumber
+          stackFramesLoader: (NSArray *(^)(void)) stackFramesLoader
+                    crashed: (BOOL) crashed
+                  registers: (NSArray *) registers
+{
+    return [self initWithThreadNumber: threadNumber stackFramesLoader: stackFramesLoader crashed: crashed alsoCrashed: NO registers: registers];
+}
+
+/**
+ * Initialize the crash log thread information, deferring creation of the thread's stack frames until they
+ * are first accessed.
+ *
+ * @param threadNumber The thread number.
+ * @param stackFramesLoader A block returning the ordered list of PLCrashReportStackFrameInfo instances. The
+ * block will be invoked at most once.
+ * @param crashed YES if this thread crashed.
+ * @param alsoCrashed YES if this thread also crashed while the report was being generated.
+ * @param registers The thread's PLCrashReportRegisterInfo instances.
+ */
+- (id) initWithThreadNumber: (NSInteger) threadNumber
+          stackFramesLoader: (NSArray *(^)(void)) stackFramesLoader
+                    crashed: (BOOL) crashed
+                alsoCrashed: (BOOL) alsoCrashed
+                  registers: (NSArray *) registers
+{
+    if ((self = [self initWithThreadNumber: threadNumber stackFrames: nil crashed: crashed registers: registers]) == nil)
+        return nil;
+
+    _stackFramesLoader = [stackFramesLoader copy];
+    _alsoCrashed = alsoCrashed;
+
+    return self;
+}
+
+/**
+ * Initialize the crash log thread information, deferring creation of the thread's stack frames until they
+ * are first accessed.
+ *
+ * @param threadNumber The thread number.
+ * @param stackFramesLoader A block returning the ordered list of PLCrashReportStackFrameInfo instances. The
+ * block will be invoked at most once.
+ * @param crashed YES if this thread crashed.
+ * @param alsoCrashed YES if this thread also crashed while the report was being generated.
+ * @param registers The thread's PLCrashReportRegisterInfo instances.
+ * @param name The thread's name, or nil if unavailable.
+ */
+- (id) initWithThreadNumber: (NSInteger) threadNumber
+          stackFramesLoader: (NSArray *(^)(void)) stackFramesLoader
+                    crashed: (BOOL) crashed
+                alsoCrashed: (BOOL) alsoCrashed
+                  registers: (NSArray *) registers
+                       name: (NSString *) name
+{
+    if ((self = [self initWithThreadNumber: threadNumber stackFramesLoader: stackFramesLoader crashed: crashed alsoCrashed: alsoCrashed registers: registers]) == nil)
+        return nil;
+
+    _name = [name copy];
+
+    return self;
+}
+
 - (void) dealloc {
     [_stackFrames release];
+    [_stackFramesLoader release];
     [_registers release];
+    [_name release];
     [super dealloc];
 }
 
+- (NSArray *) stackFrames {
+    @synchronized (self) {
+        if (_stackFrames == nil && _stackFramesLoader != nil) {
+            _stackFrames = [_stackFramesLoader() retain];
+
+            /* The loader is no longer required; releasing it also releases any state it retains */
+            [_stackFramesLoader release];
+            _stackFramesLoader = nil;
+        }
+    }
+
+    return _stackFrames;
+}
+
 @synthesize threadNumber = _threadNumber;
-@synthesize stackFrames = _stackFrames;
 @synthesize crashed = _crashed;
+@synthesize alsoCrashed = _alsoCrashed;
 @synthesize registers = _registers;
+@synthesize name = _name;
 
 
 @end
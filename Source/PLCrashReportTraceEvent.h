@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PLCrashReportTraceEvent : NSObject {
+@private
+    /** The event's sequence number. */
+    uint64_t _sequenceNumber;
+
+    /** The event identifier. */
+    uint32_t _eventIdentifier;
+
+    /** The event name, or nil if unknown. */
+    NSString *_name;
+
+    /** The event's integer arguments, as NSNumber instances. */
+    NSArray *_arguments;
+}
+
+- (id) initWithSequenceNumber: (uint64_t) sequenceNumber
+              eventIdentifier: (uint32_t) eventIdentifier
+                         name: (NSString *) name
+                    arguments: (NSArray *) arguments;
+
+/** The event's sequence number. Sequence numbers increase monotonically across all recorded events. */
+@property(nonatomic, readonly) uint64_t sequenceNumber;
+
+/** The event identifier. */
+@property(nonatomic, readonly) uint32_t eventIdentifier;
+
+/** The event name. If the event identifier is not known to this version of PLCrashReporter, this will be nil. */
+@property(nonatomic, readonly) NSString *name;
+
+/** The event's integer arguments, as NSNumber instances. The meaning of each argument is specific to the event. */
+@property(nonatomic, readonly) NSArray *arguments;
+
+@end
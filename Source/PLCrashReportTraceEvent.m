@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportTraceEvent.h"
+
+/**
+ * A diagnostic trace event recorded by the crash reporter.
+ *
+ * The crash reporter records compact binary events from its unwinding paths; the most recently recorded events
+ * are included in each report, and may be used to diagnose incomplete or truncated backtraces.
+ */
+@implementation PLCrashReportTraceEvent
+
+@synthesize sequenceNumber = _sequenceNumber;
+@synthesize eventIdentifier = _eventIdentifier;
+@synthesize name = _name;
+@synthesize arguments = _arguments;
+
+/**
+ * Initialize a new trace event data object.
+ *
+ * @param sequenceNumber The event's sequence number.
+ * @param eventIdentifier The event identifier.
+ * @param name The event name, or nil if unknown.
+ * @param arguments The event's integer arguments, as NSNumber instances.
+ */
+- (id) initWithSequenceNumber: (uint64_t) sequenceNumber
+              eventIdentifier: (uint32_t) eventIdentifier
+                         name: (NSString *) name
+                    arguments: (NSArray *) arguments
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _sequenceNumber = sequenceNumber;
+    _eventIdentifier = eventIdentifier;
+    _name = [name retain];
+    _arguments = [arguments retain];
+
+    return self;
+}
+
+- (void) dealloc {
+    [_name release];
+    [_arguments release];
+    [super dealloc];
+}
+
+@end
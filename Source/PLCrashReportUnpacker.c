@@ -0,0 +1,658 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashReportUnpacker.h"
+#include "PLCrashAsyncProtobufReader.h"
+
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_report_unpacker
+ * @{
+ */
+
+/** Return false from the enclosing function if @a expr evaluates to false. */
+#define UNPACK_CHECK(expr) do { if (!(expr)) return false; } while (0)
+
+/** The largest CrashReport field number. */
+#define CRASH_REPORT_MAX_FIELD_ID 19
+
+/**
+ * Allocate @a size bytes from @a allocator.
+ */
+static inline void *unpack_alloc (ProtobufCAllocator *allocator, size_t size) {
+    return allocator->alloc(allocator->allocator_data, size);
+}
+
+/**
+ * Allocate an array of @a count pointers from @a allocator. Returns NULL if @a count is zero.
+ */
+static void **unpack_alloc_array (ProtobufCAllocator *allocator, size_t count) {
+    if (count == 0 || count > SIZE_MAX / sizeof(void *))
+        return NULL;
+
+    return unpack_alloc(allocator, count * sizeof(void *));
+}
+
+/**
+ * Allocate a single block of @a count messages described by @a descriptor, each initialized to its zero default
+ * value. The generic unpacker's per-message default initialization is not required; the defaults of all messages
+ * decoded via this function are zero.
+ */
+static void *unpack_alloc_messages (ProtobufCAllocator *allocator, const ProtobufCMessageDescriptor *descriptor, size_t count) {
+    if (count == 0 || count > SIZE_MAX / descriptor->sizeof_message)
+        return NULL;
+
+    uint8_t *block = unpack_alloc(allocator, count * descriptor->sizeof_message);
+    if (block == NULL)
+        return NULL;
+
+    memset(block, 0, count * descriptor->sizeof_message);
+    for (size_t i = 0; i < count; i++)
+        ((ProtobufCMessage *) (block + (i * descriptor->sizeof_message)))->descriptor = descriptor;
+
+    return block;
+}
+
+/**
+ * Count the occurrences of each field numbered up to @a max_id within @a reader.
+ *
+ * @param reader A reader over the message.
+ * @param counts An array of @a max_id + 1 zero-initialized counts.
+ * @param max_id The largest field number to be counted.
+ */
+static bool unpack_count_fields (plcrash_async_pb_reader_t reader, size_t *counts, uint32_t max_id) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        if (field.id <= max_id)
+            counts[field.id]++;
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/** Decode a uint64 field. */
+static inline bool unpack_uint64 (const plcrash_async_pb_field_t *field, uint64_t *value) {
+    if (field->wire_type != PLCRASH_PB_WIRE_TYPE_VARINT)
+        return false;
+
+    *value = field->value;
+    return true;
+}
+
+/** Decode a uint32 or enum field. As with the generic unpacker, the value is truncated to 32 bits. */
+static inline bool unpack_uint32 (const plcrash_async_pb_field_t *field, uint32_t *value) {
+    if (field->wire_type != PLCRASH_PB_WIRE_TYPE_VARINT)
+        return false;
+
+    *value = (uint32_t) field->value;
+    return true;
+}
+
+/** Decode a bool field. */
+static inline bool unpack_bool (const plcrash_async_pb_field_t *field, protobuf_c_boolean *value) {
+    if (field->wire_type != PLCRASH_PB_WIRE_TYPE_VARINT)
+        return false;
+
+    *value = (field->value != 0);
+    return true;
+}
+
+/** Decode a string field into a NUL-terminated copy allocated from @a allocator. */
+static bool unpack_string (ProtobufCAllocator *allocator, const plcrash_async_pb_field_t *field, char **value) {
+    if (field->wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+        return false;
+
+    size_t len = plcrash_async_pb_reader_length(&field->data);
+    char *str = unpack_alloc(allocator, len + 1);
+    if (str == NULL)
+        return false;
+
+    memcpy(str, field->data.p, len);
+    str[len] = '\0';
+
+    *value = str;
+    return true;
+}
+
+/** Decode a bytes field into a copy allocated from @a allocator. */
+static bool unpack_bytes (ProtobufCAllocator *allocator, const plcrash_async_pb_field_t *field, ProtobufCBinaryData *value) {
+    if (field->wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+        return false;
+
+    size_t len = plcrash_async_pb_reader_length(&field->data);
+    uint8_t *data = unpack_alloc(allocator, len);
+    if (data == NULL && len > 0)
+        return false;
+
+    memcpy(data, field->data.p, len);
+
+    value->data = data;
+    value->len = len;
+    return true;
+}
+
+/** Decode a message field via the generic protobuf-c unpacker. */
+static bool unpack_generic_message (ProtobufCAllocator *allocator, const plcrash_async_pb_field_t *field, const ProtobufCMessageDescriptor *descriptor, void **value) {
+    if (field->wire_type != PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED)
+        return false;
+
+    ProtobufCMessage *message = protobuf_c_message_unpack(descriptor, allocator, plcrash_async_pb_reader_length(&field->data), field->data.p);
+    if (message == NULL)
+        return false;
+
+    *value = message;
+    return true;
+}
+
+/**
+ * Decode a CrashReport.Symbol.InlinedFrame message.
+ */
+static bool unpack_inlined_frame (ProtobufCAllocator *allocator, plcrash_async_pb_reader_t reader, Plcrash__CrashReport__Symbol__InlinedFrame *inlined) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case 1: /* name */
+                UNPACK_CHECK(unpack_string(allocator, &field, &inlined->name));
+                break;
+
+            case 2: /* call_file */
+                UNPACK_CHECK(unpack_string(allocator, &field, &inlined->call_file));
+                break;
+
+            case 3: /* call_line */
+                UNPACK_CHECK(unpack_uint32(&field, &inlined->call_line));
+                inlined->has_call_line = 1;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Decode a CrashReport.Symbol message.
+ */
+static bool unpack_symbol (ProtobufCAllocator *allocator, plcrash_async_pb_reader_t reader, Plcrash__CrashReport__Symbol *symbol) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    /* Size the repeated fields */
+    size_t counts[8] = { 0 };
+    UNPACK_CHECK(unpack_count_fields(reader, counts, 7));
+
+    Plcrash__CrashReport__Symbol__InlinedFrame *inlined_frames = NULL;
+    if (counts[7] > 0) {
+        UNPACK_CHECK((symbol->inlined_frames = (Plcrash__CrashReport__Symbol__InlinedFrame **) unpack_alloc_array(allocator, counts[7])) != NULL);
+        UNPACK_CHECK((inlined_frames = unpack_alloc_messages(allocator, &plcrash__crash_report__symbol__inlined_frame__descriptor, counts[7])) != NULL);
+    }
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case 1: /* name */
+                UNPACK_CHECK(unpack_string(allocator, &field, &symbol->name));
+                break;
+
+            case 2: /* start_address */
+                UNPACK_CHECK(unpack_uint64(&field, &symbol->start_address));
+                break;
+
+            case 3: /* end_address */
+                UNPACK_CHECK(unpack_uint64(&field, &symbol->end_address));
+                symbol->has_end_address = 1;
+                break;
+
+            case 4: /* name_index */
+                UNPACK_CHECK(unpack_uint32(&field, &symbol->name_index));
+                symbol->has_name_index = 1;
+                break;
+
+            case 5: /* source_file */
+                UNPACK_CHECK(unpack_string(allocator, &field, &symbol->source_file));
+                break;
+
+            case 6: /* source_line */
+                UNPACK_CHECK(unpack_uint32(&field, &symbol->source_line));
+                symbol->has_source_line = 1;
+                break;
+
+            case 7: { /* inlined_frames */
+                Plcrash__CrashReport__Symbol__InlinedFrame *inlined = &inlined_frames[symbol->n_inlined_frames];
+                UNPACK_CHECK(field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED);
+                UNPACK_CHECK(unpack_inlined_frame(allocator, field.data, inlined));
+                symbol->inlined_frames[symbol->n_inlined_frames++] = inlined;
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Decode a CrashReport.Thread.StackFrame message.
+ */
+static bool unpack_stack_frame (ProtobufCAllocator *allocator, plcrash_async_pb_reader_t reader, Plcrash__CrashReport__Thread__StackFrame *frame) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case 3: /* pc */
+                UNPACK_CHECK(unpack_uint64(&field, &frame->pc));
+                break;
+
+            case 6: /* symbol */
+                UNPACK_CHECK(field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED);
+                UNPACK_CHECK((frame->symbol = unpack_alloc_messages(allocator, &plcrash__crash_report__symbol__descriptor, 1)) != NULL);
+                UNPACK_CHECK(unpack_symbol(allocator, field.data, frame->symbol));
+                break;
+
+            case 7: /* repeat_count */
+                UNPACK_CHECK(unpack_uint32(&field, &frame->repeat_count));
+                frame->has_repeat_count = 1;
+                break;
+
+            case 8: /* repeat_length */
+                UNPACK_CHECK(unpack_uint32(&field, &frame->repeat_length));
+                frame->has_repeat_length = 1;
+                break;
+
+            case 9: /* omitted_frame_count */
+                UNPACK_CHECK(unpack_uint64(&field, &frame->omitted_frame_count));
+                frame->has_omitted_frame_count = 1;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Decode a CrashReport.Thread.RegisterValue message.
+ */
+static bool unpack_register_value (ProtobufCAllocator *allocator, plcrash_async_pb_reader_t reader, Plcrash__CrashReport__Thread__RegisterValue *reg) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case 1: /* name */
+                UNPACK_CHECK(unpack_string(allocator, &field, &reg->name));
+                break;
+
+            case 2: /* value */
+                UNPACK_CHECK(unpack_uint64(&field, &reg->value));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Decode a CrashReport.Thread message.
+ */
+static bool unpack_thread (ProtobufCAllocator *allocator, plcrash_async_pb_reader_t reader, Plcrash__CrashReport__Thread *thread) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    /* Size the repeated fields */
+    size_t counts[5] = { 0 };
+    UNPACK_CHECK(unpack_count_fields(reader, counts, 4));
+
+    Plcrash__CrashReport__Thread__StackFrame *frames = NULL;
+    if (counts[2] > 0) {
+        UNPACK_CHECK((thread->frames = (Plcrash__CrashReport__Thread__StackFrame **) unpack_alloc_array(allocator, counts[2])) != NULL);
+        UNPACK_CHECK((frames = unpack_alloc_messages(allocator, &plcrash__crash_report__thread__stack_frame__descriptor, counts[2])) != NULL);
+    }
+
+    Plcrash__CrashReport__Thread__RegisterValue *registers = NULL;
+    if (counts[4] > 0) {
+        UNPACK_CHECK((thread->registers = (Plcrash__CrashReport__Thread__RegisterValue **) unpack_alloc_array(allocator, counts[4])) != NULL);
+        UNPACK_CHECK((registers = unpack_alloc_messages(allocator, &plcrash__crash_report__thread__register_value__descriptor, counts[4])) != NULL);
+    }
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case 1: /* thread_number */
+                UNPACK_CHECK(unpack_uint32(&field, &thread->thread_number));
+                break;
+
+            case 2: { /* frames */
+                Plcrash__CrashReport__Thread__StackFrame *frame = &frames[thread->n_frames];
+                UNPACK_CHECK(field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED);
+                UNPACK_CHECK(unpack_stack_frame(allocator, field.data, frame));
+                thread->frames[thread->n_frames++] = frame;
+                break;
+            }
+
+            case 3: /* crashed */
+                UNPACK_CHECK(unpack_bool(&field, &thread->crashed));
+                break;
+
+            case 4: { /* registers */
+                Plcrash__CrashReport__Thread__RegisterValue *reg = &registers[thread->n_registers];
+                UNPACK_CHECK(field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED);
+                UNPACK_CHECK(unpack_register_value(allocator, field.data, reg));
+                thread->registers[thread->n_registers++] = reg;
+                break;
+            }
+
+            case 5: /* register_values */
+                UNPACK_CHECK(unpack_bytes(allocator, &field, &thread->register_values));
+                thread->has_register_values = 1;
+                break;
+
+            case 6: /* frame_pcs */
+                UNPACK_CHECK(unpack_bytes(allocator, &field, &thread->frame_pcs));
+                thread->has_frame_pcs = 1;
+                break;
+
+            case 7: /* duplicate_of_thread */
+                UNPACK_CHECK(unpack_uint32(&field, &thread->duplicate_of_thread));
+                thread->has_duplicate_of_thread = 1;
+                break;
+
+            case 8: /* also_crashed */
+                UNPACK_CHECK(unpack_bool(&field, &thread->also_crashed));
+                thread->has_also_crashed = 1;
+                break;
+
+            case 9: /* name */
+                UNPACK_CHECK(unpack_string(allocator, &field, &thread->name));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Decode a CrashReport.Processor message.
+ */
+static bool unpack_processor (plcrash_async_pb_reader_t reader, Plcrash__CrashReport__Processor *processor) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case 1: { /* encoding */
+                uint32_t encoding;
+                UNPACK_CHECK(unpack_uint32(&field, &encoding));
+                processor->encoding = (Plcrash__CrashReport__Processor__TypeEncoding) encoding;
+                processor->has_encoding = 1;
+                break;
+            }
+
+            case 2: /* type */
+                UNPACK_CHECK(unpack_uint64(&field, &processor->type));
+                break;
+
+            case 3: /* subtype */
+                UNPACK_CHECK(unpack_uint64(&field, &processor->subtype));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Decode a CrashReport.BinaryImage message.
+ */
+static bool unpack_binary_image (ProtobufCAllocator *allocator, plcrash_async_pb_reader_t reader, Plcrash__CrashReport__BinaryImage *image) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case 1: /* base_address */
+                UNPACK_CHECK(unpack_uint64(&field, &image->base_address));
+                break;
+
+            case 2: /* size */
+                UNPACK_CHECK(unpack_uint64(&field, &image->size));
+                break;
+
+            case 3: /* name */
+                UNPACK_CHECK(unpack_string(allocator, &field, &image->name));
+                break;
+
+            case 4: /* uuid */
+                UNPACK_CHECK(unpack_bytes(allocator, &field, &image->uuid));
+                image->has_uuid = 1;
+                break;
+
+            case 5: /* code_type */
+                UNPACK_CHECK(field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED);
+                UNPACK_CHECK((image->code_type = unpack_alloc_messages(allocator, &plcrash__crash_report__processor__descriptor, 1)) != NULL);
+                UNPACK_CHECK(unpack_processor(field.data, image->code_type));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Decode the fields of a CrashReport message into @a report.
+ */
+static bool unpack_crash_report (ProtobufCAllocator *allocator, plcrash_async_pb_reader_t reader, Plcrash__CrashReport *report) {
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    /* Size the repeated fields */
+    size_t counts[CRASH_REPORT_MAX_FIELD_ID + 1] = { 0 };
+    UNPACK_CHECK(unpack_count_fields(reader, counts, CRASH_REPORT_MAX_FIELD_ID));
+
+    Plcrash__CrashReport__Thread *threads = NULL;
+    if (counts[3] > 0) {
+        UNPACK_CHECK((report->threads = (Plcrash__CrashReport__Thread **) unpack_alloc_array(allocator, counts[3])) != NULL);
+        UNPACK_CHECK((threads = unpack_alloc_messages(allocator, &plcrash__crash_report__thread__descriptor, counts[3])) != NULL);
+    }
+
+    Plcrash__CrashReport__BinaryImage *images = NULL;
+    if (counts[4] > 0) {
+        UNPACK_CHECK((report->binary_images = (Plcrash__CrashReport__BinaryImage **) unpack_alloc_array(allocator, counts[4])) != NULL);
+        UNPACK_CHECK((images = unpack_alloc_messages(allocator, &plcrash__crash_report__binary_image__descriptor, counts[4])) != NULL);
+    }
+
+    if (counts[10] > 0)
+        UNPACK_CHECK((report->symbol_names = (char **) unpack_alloc_array(allocator, counts[10])) != NULL);
+
+    if (counts[12] > 0)
+        UNPACK_CHECK((report->trace_events = (Plcrash__CrashReport__TraceEvent **) unpack_alloc_array(allocator, counts[12])) != NULL);
+
+    if (counts[14] > 0)
+        UNPACK_CHECK((report->stack_memory = (Plcrash__CrashReport__StackMemory **) unpack_alloc_array(allocator, counts[14])) != NULL);
+
+    if (counts[15] > 0)
+        UNPACK_CHECK((report->register_memory = (Plcrash__CrashReport__MemoryRegion **) unpack_alloc_array(allocator, counts[15])) != NULL);
+
+    if (counts[17] > 0)
+        UNPACK_CHECK((report->breadcrumbs = (Plcrash__CrashReport__Breadcrumb **) unpack_alloc_array(allocator, counts[17])) != NULL);
+
+    if (counts[18] > 0)
+        UNPACK_CHECK((report->custom_data = (Plcrash__CrashReport__CustomData **) unpack_alloc_array(allocator, counts[18])) != NULL);
+
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        switch (field.id) {
+            case 1: /* system_info */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__system_info__descriptor, (void **) &report->system_info));
+                break;
+
+            case 2: /* application_info */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__application_info__descriptor, (void **) &report->application_info));
+                break;
+
+            case 3: { /* threads */
+                Plcrash__CrashReport__Thread *thread = &threads[report->n_threads];
+                UNPACK_CHECK(field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED);
+                UNPACK_CHECK(unpack_thread(allocator, field.data, thread));
+                report->threads[report->n_threads++] = thread;
+                break;
+            }
+
+            case 4: { /* binary_images */
+                Plcrash__CrashReport__BinaryImage *image = &images[report->n_binary_images];
+                UNPACK_CHECK(field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED);
+                UNPACK_CHECK(unpack_binary_image(allocator, field.data, image));
+                report->binary_images[report->n_binary_images++] = image;
+                break;
+            }
+
+            case 5: /* exception */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__exception__descriptor, (void **) &report->exception));
+                break;
+
+            case 6: /* signal */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__signal__descriptor, (void **) &report->signal));
+                break;
+
+            case 7: /* process_info */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__process_info__descriptor, (void **) &report->process_info));
+                break;
+
+            case 8: /* machine_info */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__machine_info__descriptor, (void **) &report->machine_info));
+                break;
+
+            case 9: /* report_info */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__report_info__descriptor, (void **) &report->report_info));
+                break;
+
+            case 10: /* symbol_names */
+                UNPACK_CHECK(unpack_string(allocator, &field, &report->symbol_names[report->n_symbol_names]));
+                report->n_symbol_names++;
+                break;
+
+            case 11: /* instrumentation */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__instrumentation__descriptor, (void **) &report->instrumentation));
+                break;
+
+            case 12: /* trace_events */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__trace_event__descriptor, (void **) &report->trace_events[report->n_trace_events]));
+                report->n_trace_events++;
+                break;
+
+            case 13: { /* register_set */
+                uint32_t register_set;
+                UNPACK_CHECK(unpack_uint32(&field, &register_set));
+                report->register_set = (Plcrash__CrashReport__RegisterSet) register_set;
+                report->has_register_set = 1;
+                break;
+            }
+
+            case 14: /* stack_memory */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__stack_memory__descriptor, (void **) &report->stack_memory[report->n_stack_memory]));
+                report->n_stack_memory++;
+                break;
+
+            case 15: /* register_memory */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__memory_region__descriptor, (void **) &report->register_memory[report->n_register_memory]));
+                report->n_register_memory++;
+                break;
+
+            case 16: /* truncation */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__truncation__descriptor, (void **) &report->truncation));
+                break;
+
+            case 17: /* breadcrumbs */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__breadcrumb__descriptor, (void **) &report->breadcrumbs[report->n_breadcrumbs]));
+                report->n_breadcrumbs++;
+                break;
+
+            case 18: /* custom_data */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__custom_data__descriptor, (void **) &report->custom_data[report->n_custom_data]));
+                report->n_custom_data++;
+                break;
+
+            case 19: /* image_manifest */
+                UNPACK_CHECK(unpack_generic_message(allocator, &field, &plcrash__crash_report__image_manifest_reference__descriptor, (void **) &report->image_manifest));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return err == PLCRASH_ENOTFOUND;
+}
+
+/**
+ * Decode the encoded CrashReport message @a data.
+ *
+ * @param allocator The allocator from which all decoded values will be allocated. Individual values are not freed on
+ * failure; the allocator's storage should be released in its entirety.
+ * @param len The length of @a data.
+ * @param data The encoded message, excluding the crash log file header.
+ *
+ * @return Returns the decoded message, or NULL if the message could not be decoded.
+ */
+Plcrash__CrashReport *plcrash_report_unpack (ProtobufCAllocator *allocator, size_t len, const uint8_t *data) {
+    plcrash_async_pb_reader_t reader;
+    plcrash_async_pb_reader_init(&reader, data, len);
+
+    Plcrash__CrashReport *report = unpack_alloc_messages(allocator, &plcrash__crash_report__descriptor, 1);
+    if (report == NULL)
+        return NULL;
+
+    if (!unpack_crash_report(allocator, reader, report))
+        return NULL;
+
+    return report;
+}
+
+/**
+ * @}
+ */
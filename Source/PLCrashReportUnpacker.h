@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_REPORT_UNPACKER_H
+#define PLCRASH_REPORT_UNPACKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "crash_report.pb-c.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_report_unpacker Crash Report Unpacker
+ * @ingroup plcrash_internal
+ *
+ * A decoder specialized for the crash_report.proto CrashReport message.
+ *
+ * The generic protobuf-c unpacker resolves each field's descriptor by binary search, records every field in a
+ * scanned member list before parsing it, and populates each message's default values by walking its descriptor.
+ * This decoder instead dispatches each field of the high-volume messages (threads, stack frames, symbols, registers
+ * and binary images) via a switch on the field number, sizes each repeated field exactly with a counting pass over the
+ * message, and allocates the elements of each repeated message field as a single block. The remaining, singular,
+ * messages are decoded via the generic unpacker.
+ *
+ * The resulting message is layout-compatible with the result of plcrash__crash_report__unpack(), with the exception
+ * that unknown fields are skipped rather than preserved. As messages are not individually allocated, the result must
+ * be allocated from an allocator that ignores individual frees, and must not be passed to
+ * protobuf_c_message_free_unpacked().
+ *
+ * @{
+ */
+
+Plcrash__CrashReport *plcrash_report_unpack (ProtobufCAllocator *allocator, size_t len, const uint8_t *data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_REPORT_UNPACKER_H */
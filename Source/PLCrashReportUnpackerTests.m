@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashReporter.h"
+#import "PLCrashReportUnpacker.h"
+#import "PLCrashAsyncCompressor.h"
+#import "PLCrashLogWriter.h"
+
+@interface PLCrashReportUnpackerTests : SenTestCase @end
+
+@implementation PLCrashReportUnpackerTests
+
+/* Fetch the uncompressed message of a live report */
+- (NSData *) liveReportMessage {
+    NSError *error;
+    NSData *reportData = [[PLCrashReporter sharedReporter] generateLiveReportAndReturnError: &error];
+    STAssertNotNil(reportData, @"Failed to generate live report: %@", error);
+
+    if (plcrash_async_compressor_is_compressed([reportData bytes], [reportData length])) {
+        uint8_t *decoded;
+        size_t decoded_length;
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_compressor_decode([reportData bytes], [reportData length], &decoded, &decoded_length), @"Could not decompress report");
+        reportData = [NSData dataWithBytesNoCopy: decoded length: decoded_length freeWhenDone: YES];
+    }
+
+    return [reportData subdataWithRange: NSMakeRange(sizeof(struct PLCrashReportFileHeader), [reportData length] - sizeof(struct PLCrashReportFileHeader))];
+}
+
+/* Return the encoding of @a message */
+static NSData *pack_message (const ProtobufCMessage *message) {
+    NSMutableData *data = [NSMutableData dataWithLength: protobuf_c_message_get_packed_size(message)];
+    protobuf_c_message_pack(message, [data mutableBytes]);
+    return data;
+}
+
+/* Allocations are leaked by the specialized unpacker on free; collect them for release */
+static void *tracking_alloc (void *allocator_data, size_t size) {
+    void *ptr = malloc(size > 0 ? size : 1);
+    [(NSMutableArray *) allocator_data addObject: [NSValue valueWithPointer: ptr]];
+    return ptr;
+}
+
+static void tracking_free (void *allocator_data, void *ptr) {
+    // no-op
+}
+
+static void tracking_release_all (NSMutableArray *allocations) {
+    for (NSValue *value in allocations)
+        free([value pointerValue]);
+    [allocations removeAllObjects];
+}
+
+/**
+ * Verify that the specialized unpacker produces a message equivalent to the generic unpacker.
+ */
+- (void) testUnpackMatchesGenericUnpacker {
+    NSData *message = [self liveReportMessage];
+
+    Plcrash__CrashReport *expected = plcrash__crash_report__unpack(&protobuf_c_system_allocator, [message length], [message bytes]);
+    STAssertNotNULL(expected, @"Generic unpacker failed");
+
+    NSMutableArray *allocations = [NSMutableArray array];
+    ProtobufCAllocator allocator = { .alloc = tracking_alloc, .free = tracking_free, .tmp_alloc = NULL, .max_alloca = 0, .allocator_data = allocations };
+    Plcrash__CrashReport *report = plcrash_report_unpack(&allocator, [message length], [message bytes]);
+    STAssertNotNULL(report, @"Specialized unpacker failed");
+
+    STAssertEquals(expected->n_threads, report->n_threads, @"Incorrect thread count");
+    STAssertEquals(expected->n_binary_images, report->n_binary_images, @"Incorrect image count");
+    STAssertEqualObjects(pack_message(&expected->base), pack_message(&report->base), @"Re-encoded messages do not match");
+
+    protobuf_c_message_free_unpacked(&expected->base, &protobuf_c_system_allocator);
+    tracking_release_all(allocations);
+}
+
+/**
+ * Verify that truncated and invalid messages are rejected.
+ */
+- (void) testUnpackInvalid {
+    NSData *message = [self liveReportMessage];
+    NSMutableArray *allocations = [NSMutableArray array];
+    ProtobufCAllocator allocator = { .alloc = tracking_alloc, .free = tracking_free, .tmp_alloc = NULL, .max_alloca = 0, .allocator_data = allocations };
+
+    STAssertNULL(plcrash_report_unpack(&allocator, [message length] - 1, [message bytes]), @"Truncated message was decoded");
+
+    /* A thread field with a varint wire type */
+    const uint8_t invalid[] = { 0x18, 0x01 };
+    STAssertNULL(plcrash_report_unpack(&allocator, sizeof(invalid), invalid), @"Invalid wire type was decoded");
+
+    tracking_release_all(allocations);
+}
+
+@end
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportVMRegionInfo.h"
+
+/**
+ * A coalesced virtual memory region of the crashed process.
+ *
+ * If the VM region summary is enabled, the writer enumerates the process' address space at crash time, merging
+ * adjacent regions with identical protection, user tag, and share mode into a single region.
+ */
+@implementation PLCrashReportVMRegionInfo
+
+@synthesize address = _address;
+@synthesize size = _size;
+@synthesize protection = _protection;
+@synthesize maxProtection = _maxProtection;
+@synthesize userTag = _userTag;
+@synthesize shareMode = _shareMode;
+
+/**
+ * Initialize a new VM region data object.
+ *
+ * @param address The region's start address.
+ * @param size The region's size, in bytes.
+ * @param protection The region's current protection.
+ * @param maxProtection The region's maximum protection.
+ * @param userTag The region's user tag.
+ * @param shareMode The region's share mode.
+ */
+- (id) initWithAddress: (uint64_t) address
+                  size: (uint64_t) size
+            protection: (uint32_t) protection
+         maxProtection: (uint32_t) maxProtection
+               userTag: (uint32_t) userTag
+             shareMode: (uint32_t) shareMode
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _address = address;
+    _size = size;
+    _protection = protection;
+    _maxProtection = maxProtection;
+    _userTag = userTag;
+    _shareMode = shareMode;
+
+    return self;
+}
+
+@end
@@ -33,6 +33,9 @@
 
 @class PLCrashMachExceptionServer;
 @class PLCrashMachExceptionPortSet;
+@class PLCrashLiveReportSession;
+@class PLCrashReport;
+@class PLCrashReportStore;
 
 /**
  * @ingroup functions
@@ -109,6 +112,12 @@ typedef enum PLExceptionHandling {
     
     /** Previously registered Mach exception ports, if any. */
     PLCrashMachExceptionPortSet *_previousMachPorts;
+
+    /** The resource exception server, or nil if resource event monitoring has not been started. */
+    PLCrashMachExceptionServer *_resourceServer;
+
+    /** Previously registered EXC_RESOURCE exception ports, if any. */
+    PLCrashMachExceptionPortSet *_previousResourcePorts;
 #endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
 
     /** Application identifier */
@@ -119,6 +128,21 @@ typedef enum PLExceptionHandling {
 
     /** Path to the crash reporter internal data directory */
     NSString *_crashReportDirectory;
+
+    /** The active sampling profiler, or NULL if sampling has not been started. */
+    struct plcrash_sampler *_sampler;
+
+    /** The active main thread hang monitor, or NULL if hang monitoring has not been started. */
+    struct plcrash_hang_monitor *_hangMonitor;
+
+    /** The resource event buffer, or NULL if resource event monitoring has not been started. */
+    struct plcrash_resource_events *_resourceEvents;
+
+    /** The breadcrumbs recorded by the previous launch, or nil if breadcrumbs have not been enabled. */
+    NSArray *_previousBreadcrumbs;
+
+    /** The bounded store of pending crash reports. */
+    PLCrashReportStore *_reportStore;
 }
 
 + (PLCrashReporter *) sharedReporter;
@@ -132,16 +156,68 @@ typedef enum PLExceptionHandling {
 
 - (NSData *) generateLiveReportWithThread: (thread_t) thread;
 - (NSData *) generateLiveReportWithThread: (thread_t) thread error: (NSError **) outError;
+- (NSData *) generateLiveReportForThreads: (const thread_t *) threads count: (mach_msg_type_number_t) count error: (NSError **) outError;
 
 - (NSData *) generateLiveReport;
 - (NSData *) generateLiveReportAndReturnError: (NSError **) outError;
 
+- (PLCrashReport *) generateLiveCrashReportWithThread: (thread_t) thread error: (NSError **) outError;
+- (PLCrashReport *) generateLiveCrashReportAndReturnError: (NSError **) outError;
+
+- (PLCrashLiveReportSession *) liveReportSessionAndReturnError: (NSError **) outError;
+
 - (BOOL) purgePendingCrashReports;
 - (BOOL) purgePendingCrashReportsAndReturnError: (NSError **) outError;
 
+- (NSArray *) pendingCrashReportInfo;
+- (NSData *) loadPendingCrashReportWithIdentifier: (NSString *) identifier error: (NSError **) outError;
+- (BOOL) purgePendingCrashReportWithIdentifier: (NSString *) identifier error: (NSError **) outError;
+
 - (BOOL) enableCrashReporterWithExceptionHandling: (PLExceptionHandling)handling;
 - (BOOL) enableCrashReporterWithExceptionHandling: (PLExceptionHandling)handling andReturnError: (NSError **) outError;
+- (BOOL) enableCrashReporterAsynchronouslyWithExceptionHandling: (PLExceptionHandling) handling
+                                                      completion: (void (^)(BOOL enabled, NSError *error)) completion
+                                                           error: (NSError **) outError;
 
 - (void) setCrashCallbacks: (PLCrashReporterCallbacks *) callbacks;
 
+- (BOOL) startSamplingWithInterval: (NSTimeInterval) interval error: (NSError **) outError;
+- (void) stopSampling;
+- (NSData *) generateProfileReportAndReturnError: (NSError **) outError;
+
+- (BOOL) startHangMonitorWithThreshold: (NSTimeInterval) threshold
+                        sampleInterval: (NSTimeInterval) sampleInterval
+                        maximumSamples: (NSUInteger) maximumSamples
+                                 error: (NSError **) outError;
+- (void) stopHangMonitor;
+
+- (BOOL) hasPendingHangReport;
+- (NSData *) loadPendingHangReportAndReturnError: (NSError **) outError;
+- (BOOL) purgePendingHangReportAndReturnError: (NSError **) outError;
+
+- (NSUInteger) suppressedCrashCount;
+- (void) resetSuppressedCrashCount;
+
+- (BOOL) startResourceEventMonitoringWithMaximumRate: (NSUInteger) maximumRate error: (NSError **) outError;
+- (void) stopResourceEventMonitoring;
+- (NSArray *) drainResourceEvents;
+- (NSUInteger) droppedResourceEventCount;
+
+- (BOOL) enableBreadcrumbsWithSize: (NSUInteger) size error: (NSError **) outError;
+- (void) recordBreadcrumbBytes: (const void *) bytes length: (NSUInteger) length;
+- (void) recordBreadcrumb: (NSString *) message;
+- (NSArray *) previousSessionBreadcrumbs;
+
+- (BOOL) registerCustomDataWithIdentifier: (NSString *) identifier
+                                    bytes: (const void *) bytes
+                                   length: (NSUInteger) length
+                                  version: (const volatile uint32_t *) version
+                                   handle: (NSUInteger *) outHandle
+                                    error: (NSError **) outError;
+- (void) unregisterCustomData: (NSUInteger) handle;
+
+- (NSArray *) imageManifestIdentifiers;
+- (NSData *) loadImageManifestWithIdentifier: (NSString *) identifier error: (NSError **) outError;
+- (BOOL) purgeImageManifestWithIdentifier: (NSString *) identifier error: (NSError **) outError;
+
 @end
@@ -37,8 +37,18 @@
 #import "PLCrashFeatureConfig.h"
 
 #import "PLCrashAsync.h"
+#import "PLCrashAsyncCompressor.h"
 #import "PLCrashLogWriter.h"
 #import "PLCrashFrameWalker.h"
+#import "PLCrashSampler.h"
+#import "PLCrashHangMonitor.h"
+#import "PLCrashDuplicateFilter.h"
+#import "PLCrashBreadcrumbRing.h"
+#import "PLCrashCustomData.h"
+#import "PLCrashResourceEvents.h"
+#import "PLCrashResourceEvent.h"
+#import "PLCrashLiveReportSession.h"
+#import "PLCrashReportStore.h"
 
 #import "PLCrashAsyncMachExceptionInfo.h"
 
@@ -49,8 +59,12 @@
 #endif
 
 #import <fcntl.h>
+#import <unistd.h>
+#import <sys/stat.h>
+#import <sys/mman.h>
 #import <dlfcn.h>
 #import <mach-o/dyld.h>
+#import <mach-o/dyld_images.h>
 
 #define NSDEBUG(msg, args...) {\
     NSLog(@"[PLCrashReporter] " msg, ## args); \
@@ -65,9 +79,48 @@ static NSString *PLCRASH_CACHE_DIR = @"com.plausiblelabs.crashreporter.data";
 static NSString *PLCRASH_LIVE_CRASHREPORT = @"live_report.plcrash";
 
 /** @internal
- * Directory containing crash reports queued for sending. */
+ * Hang report file extension, appended to the crash report directory path. The hang report is stored outside of
+ * the crash report directory, as all files within that directory are treated as pending crash reports. */
+static NSString *PLCRASH_HANG_REPORT_EXT = @"hang_report";
+
+/** @internal
+ * Duplicate crash filter table file extension, appended to the crash report directory path. As with the hang report,
+ * the table is stored outside of the crash report directory. */
+static NSString *PLCRASH_DUPLICATE_FILTER_EXT = @"crash_filter";
+
+/** @internal
+ * Breadcrumb ring file extension, appended to the crash report directory path. As with the hang report, the ring is
+ * stored outside of the crash report directory. */
+static NSString *PLCRASH_BREADCRUMBS_EXT = @"breadcrumbs";
+
+/** @internal
+ * Image manifest directory extension, appended to the crash report directory path. As with the hang report, the
+ * manifests are stored outside of the crash report directory. */
+static NSString *PLCRASH_IMAGE_MANIFEST_DIR_EXT = @"image_manifests";
+
+/** @internal
+ * Image manifest file extension. Each manifest is named by its identifier. */
+static NSString *PLCRASH_IMAGE_MANIFEST_EXT = @"plmanifest";
+
+/** @internal
+ * Preallocated crash report file extension, appended to the crash report directory path. The file is stored outside
+ * of the crash report directory, and is moved into the directory once a report has been written to it. */
+static NSString *PLCRASH_PREALLOCATED_REPORT_EXT = @"prealloc_report";
+
+/** @internal
+ * Directory containing crash reports queued for sending. Completed reports are moved from the live crash report path
+ * into this directory, where they are retained subject to the configured pending report budgets. */
 static NSString *PLCRASH_QUEUED_DIR = @"queued_reports";
 
+/** @internal
+ * Pending crash report index file name, within the crash report directory. The index summarizes the pending reports in
+ * PLCRASH_QUEUED_DIR, and is only rebuilt if that directory has been modified. */
+static NSString *PLCRASH_QUEUED_INDEX = @"pending_reports.plist";
+
+/** @internal
+ * Extension of a crash report that is being written. The report is renamed into place once complete. */
+static NSString *PLCRASH_PARTIAL_REPORT_EXT = @"tmp";
+
 /** @internal
  * Maximum number of bytes that will be written to the crash report.
  * Used as a safety measure in case of implementation malfunction.
@@ -77,6 +130,58 @@ static NSString *PLCRASH_QUEUED_DIR = @"queued_reports";
  */
 #define MAX_REPORT_BYTES (64 * 1024)
 
+/** @internal
+ * Magic value identifying a memory mapped crash report file. */
+#define PLCRASH_MAPPED_REPORT_MAGIC "plcrmap"
+
+/**
+ * @internal
+ *
+ * Header at the start of a memory mapped crash report file. The crash report is written immediately after the
+ * header.
+ */
+typedef struct plcrash_mapped_report_header {
+    /** PLCRASH_MAPPED_REPORT_MAGIC, including its NUL terminator. */
+    char magic[8];
+
+    /** The number of bytes of report data following the header, or 0 if no report has been written. This is set only
+     * once the report has been completely written. */
+    uint64_t length;
+} plcrash_mapped_report_header_t;
+
+/** @internal
+ * Number of resource events held between calls to PLCrashReporter::drainResourceEvents. */
+#define PLCRASH_RESOURCE_EVENTS_CAPACITY 64
+
+/** @internal
+ * The number of samples retained by the sampling profiler's ring buffer. */
+#define SAMPLER_CAPACITY 4096
+
+/** @internal
+ * Maximum number of bytes that will be written to a profile report. */
+#define MAX_PROFILE_BYTES (4 * 1024 * 1024)
+
+/** @internal
+ * Size of the output buffer preallocated for crash report writing. A larger buffer
+ * reduces the number of write() system calls that must be issued from the crashed process;
+ * a typical report requires only a few flushes at this size.
+ */
+#define PLCRASH_REPORT_BUFFER_SIZE (16 * 1024)
+
+/**
+ * @internal
+ * Number of worker threads used to unwind suspended threads in parallel when the Mach exception
+ * server is enabled.
+ */
+#define PLCRASH_MACH_CAPTURE_WORKERS 2
+
+/**
+ * @internal
+ * Approximate number of bytes that may be allocated by the background image index builder. Images that remain
+ * unindexed once the limit is reached fall back on unindexed lookups at crash time.
+ */
+#define PLCRASH_IMAGE_INDEX_MEMORY_LIMIT (32 * 1024 * 1024)
+
 /**
  * @internal
  * Fatal signals to be monitored.
@@ -105,10 +210,56 @@ typedef struct signal_handler_ctx {
     /** Path to the output file */
     const char *path;
 
+    /**
+     * Path to which the report is written if no preallocated output file is available. The file is renamed to
+     * @a path once the report is complete, so that a partially written report is never visible at @a path.
+     */
+    const char *tmp_path;
+
+    /**
+     * Path to the preallocated output file, or NULL if the output file should be created at crash time. If non-NULL,
+     * the report is written to @a prealloc_fd, and the file is then renamed to @a path.
+     */
+    const char *prealloc_path;
+
+    /** The open, preallocated output file. Only valid if @a prealloc_path is non-NULL. */
+    int prealloc_fd;
+
+    /**
+     * Shared memory mapping of the preallocated output file, or NULL if the report should be written to the file.
+     * If non-NULL, the report is written directly into the mapping following its plcrash_mapped_report_header_t, and
+     * is moved into place at @a path by the next process to enable the crash reporter.
+     */
+    plcrash_mapped_report_header_t *mapped_report;
+
+    /** Size of the @a mapped_report mapping, in bytes. */
+    size_t mapped_report_size;
+
+    /** Preallocated output buffer, or NULL if the default plcrash_async_file_t buffer should be used. */
+    void *output_buffer;
+
+    /** Size of @a output_buffer, in bytes. */
+    size_t output_buffer_size;
+
+    /** Preallocated report compressor, or NULL if reports should be written uncompressed. */
+    plcrash_async_compressor_t *compressor;
+
+    /** Duplicate crash filter. The filter's table will be NULL if duplicate suppression is disabled. */
+    plcrash_duplicate_filter_t duplicate_filter;
+
+    /** The first thread to reach the signal handler, which is responsible for writing the report, or 0 if none. */
+    volatile int32_t reporting_thread;
+
+    /**
+     * Non-zero once all crash handler state has been prepared. The handlers may be registered before this is set, in
+     * which case all crashes are declined until it is.
+     */
+    volatile int32_t ready;
+
 #if PLCRASH_FEATURE_MACH_EXCEPTIONS
-    /* Previously registered Mach exception ports, if any. Will be left uninitialized if PLCrashReporterSignalHandlerTypeMach
-     * is not enabled. */
-    plcrash_mach_exception_port_set_t port_set;
+    /* Forwarding table for the previously registered Mach exception ports, if any. Will be left uninitialized if
+     * PLCrashReporterSignalHandlerTypeMach is not enabled. */
+    plcrash_mach_exception_forward_table_t forward_table;
 #endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
 } plcrashreporter_handler_ctx_t;
 
@@ -119,6 +270,51 @@ typedef struct signal_handler_ctx {
  */
 static plcrash_async_image_list_t shared_image_list;
 
+/**
+ * @internal
+ *
+ * Shared breadcrumb ring. Uninitialized until breadcrumbs are enabled via
+ * PLCrashReporter::enableBreadcrumbsWithSize:error:.
+ */
+static plcrash_breadcrumb_ring_t shared_breadcrumbs;
+
+/**
+ * @internal
+ *
+ * Shared custom data registry. The zero-initialized registry is empty; regions are added via
+ * PLCrashReporter::registerCustomDataWithIdentifier:bytes:length:version:handle:error:.
+ */
+static plcrash_custom_data_registry_t shared_custom_data;
+
+/**
+ * @internal
+ *
+ * Image manifest generation state. Manifests are generated by a background thread once the crash reporter is enabled,
+ * and again after each image load or unload.
+ */
+static struct {
+    /** Guards all fields other than @a current. */
+    pthread_mutex_t lock;
+
+    /** The directory to which manifests are written, or NULL if manifest generation is disabled. */
+    char *directory;
+
+    /** True if a new manifest should be generated. */
+    bool pending;
+
+    /** True if the worker thread is running. */
+    bool running;
+
+    /**
+     * The current manifest, or NULL. Replaced manifests are never freed, as a report may be in the process of being
+     * written from them; as a new manifest is only generated when the set of loaded images changes, the number of
+     * retired manifests is bounded by the number of image loads and unloads.
+     */
+    plcrash_log_writer_image_manifest_t * volatile current;
+} image_manifest_state = { PTHREAD_MUTEX_INITIALIZER, NULL, false, false, NULL };
+
+static void image_manifest_request_update (void);
+
 
 /**
  * @internal
@@ -149,20 +345,90 @@ static PLCrashReporterCallbacks crashCallbacks = {
  *
  * @return Returns PLCRASH_ESUCCESS on success, or an appropriate error value if the report could not be written.
  */
-static plcrash_error_t plcrash_write_report (plcrashreporter_handler_ctx_t *sigctx, thread_t crashed_thread, plcrash_async_thread_state_t *thread_state, plcrash_log_signal_info_t *siginfo) {
+/**
+ * @internal
+ *
+ * Write a crash report directly into the signal handler context's memory mapped output file. No file I/O is performed,
+ * other than a single msync() of the written report; the report's length is only recorded in the mapping's header
+ * once the report has been completely written.
+ */
+static plcrash_error_t plcrash_write_mapped_report (plcrashreporter_handler_ctx_t *sigctx, thread_t crashed_thread, plcrash_async_thread_state_t *thread_state, plcrash_log_signal_info_t *siginfo) {
+    plcrash_mapped_report_header_t *header = sigctx->mapped_report;
+    plcrash_async_file_memory_t memory;
     plcrash_async_file_t file;
     plcrash_error_t err;
 
-    /* Open the output file */
-    int fd = open(sigctx->path, O_RDWR|O_CREAT|O_TRUNC, 0644);
-    if (fd < 0) {
-        PLCF_DEBUG("Could not open the crashlog output file: %s", strerror(errno));
+    /* Initialize the output context */
+    size_t capacity = MIN(sigctx->mapped_report_size - sizeof(*header), (size_t) MAX_REPORT_BYTES);
+    plcrash_async_file_init_memory(&file, &memory, header + 1, capacity);
+    if (sigctx->compressor != NULL && !plcrash_async_file_set_compressor(&file, sigctx->compressor)) {
+        PLCF_DEBUG("Failed to write the compressed report header");
         return PLCRASH_EINTERNAL;
     }
-    
+
+    /* Write the crash log using the already-initialized writer */
+    err = plcrash_log_writer_write(&sigctx->writer, crashed_thread, &shared_image_list, &file, siginfo, thread_state);
+
+    if (plcrash_log_writer_close(&sigctx->writer) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Failed to close the log writer");
+        return PLCRASH_EINTERNAL;
+    }
+
+    if (!plcrash_async_file_close(&file)) {
+        PLCF_DEBUG("Failed to flush the mapped output file");
+        return PLCRASH_EINTERNAL;
+    }
+
+    /* Publish the report's length only once the report data is complete */
+    OSMemoryBarrier();
+    header->length = memory.length;
+
+    /* The kernel will write back the dirty pages of the shared mapping after the process terminates; this merely
+     * ensures that they reach the disk promptly. */
+    if (msync(header, sizeof(*header) + memory.length, MS_SYNC) != 0)
+        PLCF_DEBUG("Failed to sync the mapped output file: %s", strerror(errno));
+
+    return err;
+}
+
+static plcrash_error_t plcrash_write_report (plcrashreporter_handler_ctx_t *sigctx, thread_t crashed_thread, plcrash_async_thread_state_t *thread_state, plcrash_log_signal_info_t *siginfo) {
+    plcrash_async_file_t file;
+    plcrash_error_t err;
+
+    /* Skip the full report if this crash was recently reported; only its repeat count is recorded. This is
+     * checked first, as a device caught in a crash loop should not pay for a full capture on every launch. */
+    if (sigctx->duplicate_filter.table != NULL) {
+        uint64_t signature = plcrash_async_duplicate_filter_signature(mach_task_self(), thread_state, &shared_image_list);
+        if (plcrash_async_duplicate_filter_check(&sigctx->duplicate_filter, signature, time(NULL))) {
+            PLCF_DEBUG("Suppressing the report of a recently reported crash");
+            return PLCRASH_ESUCCESS;
+        }
+    }
+
+    /* Write directly into the mapped output file, if available */
+    if (sigctx->mapped_report != NULL)
+        return plcrash_write_mapped_report(sigctx, crashed_thread, thread_state, siginfo);
+
+    /* Open the output file, or use the file preallocated when the reporter was enabled */
+    int fd;
+    if (sigctx->prealloc_path != NULL) {
+        fd = sigctx->prealloc_fd;
+    } else {
+        fd = open(sigctx->tmp_path, O_RDWR|O_CREAT|O_TRUNC, 0644);
+        if (fd < 0) {
+            PLCF_DEBUG("Could not open the crashlog output file: %s", strerror(errno));
+            return PLCRASH_EINTERNAL;
+        }
+    }
+
     /* Initialize the output context */
-    plcrash_async_file_init(&file, fd, MAX_REPORT_BYTES);
-    
+    plcrash_async_file_init_buffer(&file, fd, MAX_REPORT_BYTES, sigctx->output_buffer, sigctx->output_buffer_size);
+    if (sigctx->compressor != NULL && !plcrash_async_file_set_compressor(&file, sigctx->compressor)) {
+        PLCF_DEBUG("Failed to write the compressed report header");
+        plcrash_async_file_close(&file);
+        return PLCRASH_EINTERNAL;
+    }
+
     /* Write the crash log using the already-initialized writer */
     err = plcrash_log_writer_write(&sigctx->writer, crashed_thread, &shared_image_list, &file, siginfo, thread_state);
 
@@ -179,12 +445,25 @@ static plcrash_error_t plcrash_write_report (plcrashreporter_handler_ctx_t *sigc
         plcrash_async_file_close(&file);
         return PLCRASH_EINTERNAL;
     }
+
+    /* Trim the preallocated file to the written length */
+    if (sigctx->prealloc_path != NULL) {
+        off_t length = lseek(fd, 0, SEEK_CUR);
+        if (length < 0 || ftruncate(fd, length) != 0)
+            PLCF_DEBUG("Failed to truncate the preallocated output file: %s", strerror(errno));
+    }
     
     if (!plcrash_async_file_close(&file)) {
         PLCF_DEBUG("Failed to close output file");
         return PLCRASH_EINTERNAL;
     }
 
+    /* Move the completed report into place */
+    if (rename(sigctx->prealloc_path != NULL ? sigctx->prealloc_path : sigctx->tmp_path, sigctx->path) != 0) {
+        PLCF_DEBUG("Failed to move the output file into place: %s", strerror(errno));
+        return PLCRASH_EINTERNAL;
+    }
+
     return err;
 }
 
@@ -198,7 +477,26 @@ static bool signal_handler_callback (int signal, siginfo_t *info, ucontext_t *ua
     plcrash_async_thread_state_t thread_state;
     plcrash_log_signal_info_t signal_info;
     plcrash_log_bsd_signal_info_t bsd_signal_info;
-    
+
+    /* Decline the crash if setup has not yet completed; the writer may not yet be initialized */
+    if (!sigctx->ready)
+        return false;
+
+    /* Only the first crashing thread writes a report. A thread that crashes concurrently (as is common with heap
+     * corruption) records its crash state for inclusion in that report, and then waits for the process to be
+     * terminated, rather than competing for the report file and suspending the reporting thread. */
+    thread_t self = pl_mach_thread_self();
+    if (!OSAtomicCompareAndSwap32Barrier(0, (int32_t) self, &sigctx->reporting_thread)) {
+        /* The reporting thread itself has crashed; fall back on the default action */
+        if ((thread_t) sigctx->reporting_thread == self)
+            return false;
+
+        plcrash_async_thread_state_mcontext_init(&thread_state, uap->uc_mcontext);
+        plcrash_log_writer_add_secondary_crash(&sigctx->writer, self, &thread_state);
+        for (;;)
+            pause();
+    }
+
     /* Remove all signal handlers -- if the crash reporting code fails, the default terminate
      * action will occur.
      *
@@ -231,7 +529,7 @@ static bool signal_handler_callback (int signal, siginfo_t *info, ucontext_t *ua
     signal_info.mach_info = NULL;
 
     /* Write the report */
-    if (plcrash_write_report(sigctx, pl_mach_thread_self(), &thread_state, &signal_info) != PLCRASH_ESUCCESS)
+    if (plcrash_write_report(sigctx, self, &thread_state, &signal_info) != PLCRASH_ESUCCESS)
         return false;
 
     /* Call any post-crash callback */
@@ -254,7 +552,9 @@ static plcrash_error_t mach_exception_callback_live_cb (plcrash_async_thread_sta
     return plcrash_write_report(plcr_ctx->sigctx, plcr_ctx->crashed_thread, state, plcr_ctx->siginfo);
 }
 
-static kern_return_t mach_exception_callback (task_t task, thread_t thread, exception_type_t exception_type, mach_exception_data_t code, mach_msg_type_number_t code_count, void *context) {
+static kern_return_t mach_exception_callback (task_t task, thread_t thread, exception_type_t exception_type, mach_exception_data_t code, mach_msg_type_number_t code_count,
+                                               thread_state_flavor_t flavor, const natural_t *state, mach_msg_type_number_t state_count, void *context)
+{
     plcrashreporter_handler_ctx_t *sigctx = context;
     plcrash_log_signal_info_t signal_info;
     plcrash_log_bsd_signal_info_t bsd_signal_info;
@@ -262,7 +562,7 @@ static kern_return_t mach_exception_callback (task_t task, thread_t thread, exce
     plcrash_error_t err;
 
     /* Let any other registered server attempt to handle the exception */
-    if (PLCrashMachExceptionForward(task, thread, exception_type, code, code_count, &sigctx->port_set) == KERN_SUCCESS)
+    if (PLCrashMachExceptionForwardWithTable(task, thread, exception_type, code, code_count, &sigctx->forward_table) == KERN_SUCCESS)
         return KERN_SUCCESS;
     
     /* Set up the BSD signal info */
@@ -284,6 +584,11 @@ static kern_return_t mach_exception_callback (task_t task, thread_t thread, exce
     mach_signal_info.code_count = code_count;
     signal_info.mach_info = &mach_signal_info;
     
+    /* Unwind the crashed thread from the state delivered with the exception, rather than fetching it from the thread */
+    plcrash_async_thread_state_t crashed_state;
+    if (state != NULL && plcrash_async_thread_state_mach_state_init(&crashed_state, thread, flavor, state, state_count) == PLCRASH_ESUCCESS)
+        plcrash_log_writer_set_crashed_thread_state(&sigctx->writer, &crashed_state);
+
     /* Write the report */
     struct mach_exception_callback_live_cb_ctx live_ctx = {
         .sigctx = sigctx,
@@ -320,12 +625,55 @@ static kern_return_t mach_exception_callback (task_t task, thread_t thread, exce
 }
 #endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
 
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS && defined(EXC_MASK_RESOURCE)
+/**
+ * @internal
+ *
+ * Resource event handler context.
+ */
+typedef struct plcrashreporter_resource_ctx {
+    /** The event buffer. */
+    plcrash_resource_events_t *events;
+
+    /** Forwarding table for the previously registered EXC_RESOURCE ports, if any. */
+    plcrash_mach_exception_forward_table_t forward_table;
+} plcrashreporter_resource_ctx_t;
+
+/** @internal Resource event handler context (singleton). */
+static plcrashreporter_resource_ctx_t resource_handler_context;
+
+/**
+ * @internal
+ *
+ * Resource exception callback. Non-fatal exceptions are recorded without a crash report, and the kernel is
+ * replied to immediately.
+ */
+static kern_return_t resource_exception_callback (task_t task, thread_t thread, exception_type_t exception_type, mach_exception_data_t code, mach_msg_type_number_t code_count, void *context) {
+    plcrashreporter_resource_ctx_t *ctx = context;
+
+    /* Let any other registered server attempt to handle the exception */
+    if (PLCrashMachExceptionForwardWithTable(task, thread, exception_type, code, code_count, &ctx->forward_table) == KERN_SUCCESS)
+        return KERN_SUCCESS;
+
+    if (!plcrash_async_resource_event_is_nonfatal(exception_type))
+        return KERN_FAILURE;
+
+    plcrash_async_resource_events_record(ctx->events, thread, exception_type, code, code_count);
+    return KERN_SUCCESS;
+}
+#endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS && EXC_MASK_RESOURCE */
+
+
 /**
  * @internal
  * dyld image add notification callback.
  */
 static void image_add_callback (const struct mach_header *mh, intptr_t vmaddr_slide) {
     Dl_info info;
+
+    /* Skip images that were already registered by image_list_populate() */
+    if (plcrash_nasync_image_list_contains(&shared_image_list, (pl_vm_address_t) mh))
+        return;
     
     /* Look up the image info */
     if (dladdr(mh, &info) == 0) {
@@ -335,120 +683,395 @@ static void image_add_callback (const struct mach_header *mh, intptr_t vmaddr_sl
 
     /* Register the image */
     plcrash_nasync_image_list_append(&shared_image_list, (pl_vm_address_t) mh, info.dli_fname);
+    image_manifest_request_update();
 }
 
-/**
- * @internal
- * dyld image remove notification callback.
- */
-static void image_remove_callback (const struct mach_header *mh, intptr_t vmaddr_slide) {
-    plcrash_nasync_image_list_remove(&shared_image_list, (uintptr_t) mh);
-}
-
-
 /**
  * @internal
  *
- * Uncaught exception handler. Sets the plcrash_log_writer_t's uncaught exception
- * field, and then triggers a SIGTRAP (synchronous exception) to cause a normal
- * exception dump.
+ * Register all currently loaded images with @a list in a single batch, using the task's dyld_all_image_infos
+ * rather than per-image dyld callbacks.
  *
- * XXX: It is possible that another crash may occur between setting the uncaught 
- * exception field, and triggering the signal handler.
+ * @param list The list to populate.
+ *
+ * @return Returns true on success, or false if the dyld image info could not be read. On failure, no images
+ * will have been registered.
  */
-static void uncaught_exception_handler (NSException *exception) {
-    /* Set the uncaught exception */
-    plcrash_log_writer_set_exception(&signal_handler_context.writer, exception);
-
-    /* Synchronously trigger the crash handler */
-    abort();
-}
+static bool image_list_populate (plcrash_async_image_list_t *list) {
+    struct task_dyld_info dyld_info;
+    mach_msg_type_number_t count = TASK_DYLD_INFO_COUNT;
+    kern_return_t kt;
 
+    if ((kt = task_info(mach_task_self(), TASK_DYLD_INFO, (task_info_t) &dyld_info, &count)) != KERN_SUCCESS) {
+        PLCF_DEBUG("Could not fetch TASK_DYLD_INFO: %d", kt);
+        return false;
+    }
 
-@interface PLCrashReporter (PrivateMethods)
+    const struct dyld_all_image_infos *infos = (const struct dyld_all_image_infos *) (uintptr_t) dyld_info.all_image_info_addr;
+    if (infos == NULL)
+        return false;
 
-- (id) initWithBundle: (NSBundle *) bundle configuration: (PLCrashReporterConfig *) configuration;
-- (id) initWithApplicationIdentifier: (NSString *) applicationIdentifier appVersion: (NSString *) applicationVersion configuration: (PLCrashReporterConfig *) configuration;
+    /* The info array is set to NULL while dyld is modifying it; fall back on the dyld callbacks */
+    const struct dyld_image_info *info_array = infos->infoArray;
+    uint32_t image_count = infos->infoArrayCount;
+    if (info_array == NULL || image_count == 0)
+        return false;
 
-- (PLCrashMachExceptionServer *) enableMachExceptionServerWithPreviousPortSet: (PLCrashMachExceptionPortSet **) previousPortSet
-                                                                     callback: (PLCrashMachExceptionHandlerCallback) callback
-                                                                      context: (void *) context
-                                                                        error: (NSError **) outError;
+    pl_vm_address_t *headers = malloc(sizeof(headers[0]) * image_count);
+    const char **names = malloc(sizeof(names[0]) * image_count);
+    if (headers == NULL || names == NULL) {
+        free(headers);
+        free(names);
+        return false;
+    }
 
-- (plcrash_async_symbol_strategy_t) mapToAsyncSymbolicationStrategy: (PLCrashReporterSymbolicationStrategy) strategy;
+    size_t valid = 0;
+    for (uint32_t i = 0; i < image_count; i++) {
+        if (info_array[i].imageLoadAddress == NULL || info_array[i].imageFilePath == NULL)
+            continue;
 
-- (BOOL) populateCrashReportDirectoryAndReturnError: (NSError **) outError;
-- (NSString *) crashReportDirectory;
-- (NSString *) queuedCrashReportDirectory;
-- (NSString *) crashReportPath;
+        headers[valid] = (pl_vm_address_t) info_array[i].imageLoadAddress;
+        names[valid] = info_array[i].imageFilePath;
+        valid++;
+    }
 
-@end
+    plcrash_nasync_image_list_append_batch(list, headers, names, valid);
 
+    free(headers);
+    free(names);
+    return true;
+}
 
 /**
- * Crash Reporter.
+ * @internal
  *
- * A PLCrashReporter instance manages process-wide handling of crashes.
+ * Return the address of the current task's dyld shared cache, as reported by dyld_all_image_infos, or 0 if the
+ * task has no shared cache or the address is unavailable.
  */
-@implementation PLCrashReporter
-
-+ (void) initialize {
-    if (![[self class] isEqual: [PLCrashReporter class]])
-        return;
-
-    /* Enable dyld image monitoring */
-    plcrash_nasync_image_list_init(&shared_image_list, mach_task_self());
-    _dyld_register_func_for_add_image(image_add_callback);
-    _dyld_register_func_for_remove_image(image_remove_callback);
-}
+static pl_vm_address_t shared_cache_base_address (void) {
+    struct task_dyld_info dyld_info;
+    mach_msg_type_number_t count = TASK_DYLD_INFO_COUNT;
 
+    if (task_info(mach_task_self(), TASK_DYLD_INFO, (task_info_t) &dyld_info, &count) != KERN_SUCCESS)
+        return 0;
 
-/* (Deprecated) Crash reporter singleton. */
-static PLCrashReporter *sharedReporter = nil;
+    const struct dyld_all_image_infos *infos = (const struct dyld_all_image_infos *) (uintptr_t) dyld_info.all_image_info_addr;
 
-/**
- * Return the default crash reporter instance. The returned instance will be configured
- * appropriately for release deployment.
- *
- * @deprecated As of PLCrashReporter 1.2, the default reporter instance has been deprecated, and API
- * clients should initialize a crash reporter instance directly.
- */
-+ (PLCrashReporter *) sharedReporter {
-    /* Once we drop 10.5 support, this may be converted to dispatch_once() */
-    static OSSpinLock onceLock = OS_SPINLOCK_INIT;
-    OSSpinLockLock(&onceLock); {
-        if (sharedReporter == nil)
-            sharedReporter = [[PLCrashReporter alloc] initWithBundle: [NSBundle mainBundle] configuration: [PLCrashReporterConfig defaultConfiguration]];
-    } OSSpinLockUnlock(&onceLock);
+    /* sharedCacheBaseAddress was added in version 15 */
+    if (infos == NULL || infos->version < 15 || infos->processDetachedFromSharedRegion)
+        return 0;
 
-    return sharedReporter;
+    return (pl_vm_address_t) infos->sharedCacheBaseAddress;
 }
 
 /**
- * Initialize a new PLCrashReporter instance with a default configuration appropraite
- * for release deployment.
+ * @internal
+ * dyld image remove notification callback.
  */
-- (instancetype) init {
-    return [self initWithConfiguration: [PLCrashReporterConfig defaultConfiguration]];
+static void image_remove_callback (const struct mach_header *mh, intptr_t vmaddr_slide) {
+    plcrash_nasync_image_list_remove(&shared_image_list, (uintptr_t) mh);
+    image_manifest_request_update();
 }
 
 /**
- * Initialize a new PLCrashReporter instance with the given configuration.
+ * @internal
  *
- * @param configuration The configuration to be used by this reporter instance.
+ * Write @a length bytes of @a data to @a path, replacing the file atomically.
+ *
+ * @return Returns true on success, or false on failure.
  */
-- (instancetype) initWithConfiguration: (PLCrashReporterConfig *) configuration {
-    return [self initWithBundle: [NSBundle mainBundle] configuration: configuration];
-}
+static bool image_manifest_write_file (const char *path, const void *data, size_t length) {
+    char tmp_path[PATH_MAX];
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int) sizeof(tmp_path))
+        return false;
 
+    int fd = open(tmp_path, O_RDWR|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0) {
+        PLCF_DEBUG("Could not open the image manifest: %s", strerror(errno));
+        return false;
+    }
 
-/**
- * Returns YES if the application has one or more pending crash reports.
- */
-- (BOOL) hasPendingCrashReports {
-    /* Check for a live crash report file */
-    return [[[NSFileManager defaultManager] contentsOfDirectoryAtPath:[self crashReportDirectory] error:nil] count] > 0;
-}
+    bool written = plcrash_async_writen(fd, data, length) >= 0;
+    if (close(fd) != 0)
+        written = false;
+
+    if (!written || rename(tmp_path, path) != 0) {
+        PLCF_DEBUG("Could not write the image manifest: %s", strerror(errno));
+        unlink(tmp_path);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Generate a manifest of the currently loaded images, persist it if not already written, and publish it to the crash
+ * handler's writer.
+ */
+static void image_manifest_update (void) {
+    plcrash_log_writer_image_manifest_t *manifest;
+    void *data;
+    size_t length;
+
+    /* The manifest must describe all registered images */
+    plcrash_nasync_image_list_load_deferred(&shared_image_list);
+
+    if (plcrash_log_writer_image_manifest_create(&shared_image_list, &manifest, &data, &length) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not generate the image manifest");
+        return;
+    }
+
+    /* Nothing to do if the images are unchanged */
+    plcrash_log_writer_image_manifest_t *current = image_manifest_state.current;
+    if (current != NULL && current->identifier == manifest->identifier) {
+        plcrash_log_writer_image_manifest_free(manifest);
+        free(data);
+        return;
+    }
+
+    /* Persist the manifest, unless an identical manifest was written previously. A report must never reference an
+     * unwritten manifest. */
+    char path[PATH_MAX];
+    bool persisted = snprintf(path, sizeof(path), "%s/%016llx.%s", image_manifest_state.directory, (unsigned long long) manifest->identifier, [PLCRASH_IMAGE_MANIFEST_EXT UTF8String]) < (int) sizeof(path);
+    if (persisted && access(path, F_OK) != 0)
+        persisted = image_manifest_write_file(path, data, length);
+
+    free(data);
+    if (!persisted) {
+        plcrash_log_writer_image_manifest_free(manifest);
+        return;
+    }
+
+    /* Publish the manifest */
+    image_manifest_state.current = manifest;
+    plcrash_log_writer_set_image_manifest(&signal_handler_context.writer, manifest);
+}
+
+/**
+ * @internal
+ *
+ * Background thread entry point; generates manifests until no further update has been requested.
+ */
+static void *image_manifest_worker (void *ctx) {
+    while (true) {
+        pthread_mutex_lock(&image_manifest_state.lock); {
+            if (!image_manifest_state.pending) {
+                image_manifest_state.running = false;
+                pthread_mutex_unlock(&image_manifest_state.lock);
+                return NULL;
+            }
+
+            image_manifest_state.pending = false;
+        } pthread_mutex_unlock(&image_manifest_state.lock);
+
+        image_manifest_update();
+    }
+}
+
+/**
+ * @internal
+ *
+ * Request that a new image manifest be generated by the background worker, starting the worker if it is not
+ * already running. Requests made while a manifest is being generated are coalesced. Has no effect if manifest
+ * generation has not been enabled.
+ */
+static void image_manifest_request_update (void) {
+    pthread_mutex_lock(&image_manifest_state.lock); {
+        if (image_manifest_state.directory == NULL) {
+            pthread_mutex_unlock(&image_manifest_state.lock);
+            return;
+        }
+
+        image_manifest_state.pending = true;
+        if (!image_manifest_state.running) {
+            pthread_attr_t attr;
+            pthread_t thr;
+
+            pthread_attr_init(&attr);
+            pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+            int err = pthread_create(&thr, &attr, image_manifest_worker, NULL);
+            if (err == 0) {
+                image_manifest_state.running = true;
+            } else {
+                PLCF_DEBUG("Could not start the image manifest thread: %s", strerror(err));
+            }
+            pthread_attr_destroy(&attr);
+        }
+    } pthread_mutex_unlock(&image_manifest_state.lock);
+}
+
+
+/**
+ * @internal
+ *
+ * Callback used by -[PLCrashReporter warmCrashPath] to unwind and symbolicate the calling thread.
+ */
+static plcrash_error_t crash_path_warmup_cb (plcrash_async_thread_state_t *state, void *ctx) {
+    plcrashreporter_handler_ctx_t *sigctx = ctx;
+    return plcrash_log_writer_warm_current_thread(&sigctx->writer, &shared_image_list, state);
+}
+
+/**
+ * @internal
+ *
+ * Uncaught exception handler. Sets the plcrash_log_writer_t's uncaught exception
+ * field, and then triggers a SIGTRAP (synchronous exception) to cause a normal
+ * exception dump.
+ *
+ * XXX: It is possible that another crash may occur between setting the uncaught 
+ * exception field, and triggering the signal handler.
+ */
+static void uncaught_exception_handler (NSException *exception) {
+    /* Set the uncaught exception, if the writer has been initialized */
+    if (signal_handler_context.ready)
+        plcrash_log_writer_set_exception(&signal_handler_context.writer, exception);
+
+    /* Synchronously trigger the crash handler */
+    abort();
+}
+
+
+/**
+ * @internal
+ * Aggregation of repeated resource events. Implemented by PLCrashResourceEvent.
+ */
+@interface PLCrashResourceEvent (PLCrashReporterAggregation)
+- (void) addOccurrenceAtDate: (NSDate *) date;
+@end
+
+/**
+ * @internal
+ * Live report session initialization. Implemented by PLCrashLiveReportSession.
+ */
+@interface PLCrashLiveReportSession (PLCrashReporterInitialization)
+- (id) initWithApplicationIdentifier: (NSString *) applicationIdentifier
+                          appVersion: (NSString *) applicationVersion
+                    symbolStrategies: (const plcrash_async_symbol_strategy_t *) symbolStrategies
+                       configuration: (PLCrashReporterConfig *) configuration
+                           imageList: (plcrash_async_image_list_t *) imageList
+                         outputLimit: (off_t) outputLimit
+                               error: (NSError **) outError;
+- (void) setBreadcrumbRing: (plcrash_breadcrumb_ring_t *) ring;
+- (void) setCustomDataRegistry: (plcrash_custom_data_registry_t *) registry;
+- (void) setImageManifest: (plcrash_log_writer_image_manifest_t *) manifest;
+@end
+
+@interface PLCrashReporter (PrivateMethods)
+
+- (id) initWithBundle: (NSBundle *) bundle configuration: (PLCrashReporterConfig *) configuration;
+- (id) initWithApplicationIdentifier: (NSString *) applicationIdentifier appVersion: (NSString *) applicationVersion configuration: (PLCrashReporterConfig *) configuration;
+
+- (PLCrashMachExceptionServer *) enableMachExceptionServerWithPreviousPortSet: (PLCrashMachExceptionPortSet **) previousPortSet
+                                                                     callback: (PLCrashMachExceptionStateHandlerCallback) callback
+                                                                      context: (void *) context
+                                                                        error: (NSError **) outError;
+
+- (plcrash_async_symbol_strategy_t) mapToAsyncSymbolicationStrategy: (PLCrashReporterSymbolicationStrategy) strategy;
+- (void) mapToAsyncImageSymbolicationStrategies: (plcrash_async_symbol_strategy_t *) strategies;
+- (void) configureImageSymbolicationForWriter: (plcrash_log_writer_t *) writer;
+
+- (BOOL) populateCrashReportDirectoryAndReturnError: (NSError **) outError;
+- (NSString *) crashReportDirectory;
+- (NSString *) queuedCrashReportDirectory;
+- (NSString *) crashReportPath;
+- (NSString *) hangReportPath;
+- (NSString *) duplicateFilterPath;
+- (NSString *) breadcrumbsPath;
+- (NSString *) imageManifestDirectory;
+- (NSString *) preallocatedReportPath;
+- (void) preallocateReportFile: (off_t) size;
+- (void) mapPreallocatedReportFile: (size_t) size;
+- (void) recoverMappedReport;
+- (void) collectPendingReports;
+- (BOOL) claimCrashReporterAndReturnError: (NSError **) outError;
+- (BOOL) prepareCrashHandlerAndReturnError: (NSError **) outError;
+- (BOOL) registerSignalHandlersAndReturnError: (NSError **) outError;
+- (BOOL) enableMachExceptionHandlingAndReturnError: (NSError **) outError;
+- (void) registerExceptionHandler: (PLExceptionHandling) handling;
+- (void) warmCrashPath;
+- (void) prefaultCrashPathAndWire: (BOOL) wire;
+
+@end
+
+
+/**
+ * Crash Reporter.
+ *
+ * A PLCrashReporter instance manages process-wide handling of crashes.
+ */
+@implementation PLCrashReporter
+
++ (void) initialize {
+    if (![[self class] isEqual: [PLCrashReporter class]])
+        return;
+
+    /* Enable dyld image monitoring. Registering the add-image callback will synchronously invoke it for every loaded
+     * image; to avoid blocking launch on Mach-O parsing, the images are parsed by a background thread. */
+    plcrash_nasync_image_list_init(&shared_image_list, mach_task_self());
+    plcrash_nasync_image_list_set_deferred(&shared_image_list, true);
+
+    /* Parse the headers of the shared cache's system images from a single mapping of the shared cache */
+    plcrash_nasync_image_list_enable_shared_cache(&shared_image_list);
+
+    /* Register the already-loaded images in a single batch; the add-image callback will skip these images when
+     * invoked for them at registration. */
+    image_list_populate(&shared_image_list);
+    _dyld_register_func_for_add_image(image_add_callback);
+    _dyld_register_func_for_remove_image(image_remove_callback);
+}
+
+
+/* (Deprecated) Crash reporter singleton. */
+static PLCrashReporter *sharedReporter = nil;
+
+/**
+ * Return the default crash reporter instance. The returned instance will be configured
+ * appropriately for release deployment.
+ *
+ * @deprecated As of PLCrashReporter 1.2, the default reporter instance has been deprecated, and API
+ * clients should initialize a crash reporter instance directly.
+ */
++ (PLCrashReporter *) sharedReporter {
+    /* Once we drop 10.5 support, this may be converted to dispatch_once() */
+    static OSSpinLock onceLock = OS_SPINLOCK_INIT;
+    OSSpinLockLock(&onceLock); {
+        if (sharedReporter == nil)
+            sharedReporter = [[PLCrashReporter alloc] initWithBundle: [NSBundle mainBundle] configuration: [PLCrashReporterConfig defaultConfiguration]];
+    } OSSpinLockUnlock(&onceLock);
+
+    return sharedReporter;
+}
+
+/**
+ * Initialize a new PLCrashReporter instance with a default configuration appropraite
+ * for release deployment.
+ */
+- (instancetype) init {
+    return [self initWithConfiguration: [PLCrashReporterConfig defaultConfiguration]];
+}
+
+/**
+ * Initialize a new PLCrashReporter instance with the given configuration.
+ *
+ * @param configuration The configuration to be used by this reporter instance.
+ */
+- (instancetype) initWithConfiguration: (PLCrashReporterConfig *) configuration {
+    return [self initWithBundle: [NSBundle mainBundle] configuration: configuration];
+}
+
+
+/**
+ * Returns YES if the application has one or more pending crash reports.
+ */
+- (BOOL) hasPendingCrashReports {
+    /* Move any completed report into the pending report store */
+    [self collectPendingReports];
+
+    /* Consult the store's index; the store directory is only enumerated if it has been modified */
+    return [[_reportStore reports] count] > 0;
+}
 
 
 /**
@@ -456,7 +1079,8 @@ static PLCrashReporter *sharedReporter = nil;
  * on the data for each crash report.
  *
  * You may use this to submit the report to your own HTTP server, over e-mail, or even parse and
- * introspect the report locally using the PLCrashReport API.
+ * introspect the report locally using the PLCrashReport API. Reports that were not completely written may be
+ * identified without decoding them via PLCrashReport::verifyIntegrityOfCrashData:verifyChecksum:error:.
  *
  * @param block A block to execute on each crash report. If purge is set to YES,
  * the crash report will be deleted after the block completes.
@@ -473,7 +1097,8 @@ static PLCrashReporter *sharedReporter = nil;
  * on the data for each crash report.
  *
  * You may use this to submit the report to your own HTTP server, over e-mail, or even parse and
- * introspect the report locally using the PLCrashReport API.
+ * introspect the report locally using the PLCrashReport API. Reports that were not completely written may be
+ * identified without decoding them via PLCrashReport::verifyIntegrityOfCrashData:verifyChecksum:error:.
  *
  * @param block A block to execute on each crash report. If purge is set to YES,
  * the crash report will be deleted after the block completes.
@@ -486,31 +1111,44 @@ static PLCrashReporter *sharedReporter = nil;
  * @return Returns nil if the crash report data could not be loaded.
  */
 - (void) loadPendingCrashReportData: (void (^)(NSData *data, BOOL *purge)) block andReturnError: (NSError **) outError {
-    NSError *error = nil;
-    NSArray *files = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:[self crashReportDirectory] error:&error];
-    if (error) {
-        *outError = error;
-        return;
-    }
-
-    /* Load the (memory mapped) data */
-    [files enumerateObjectsUsingBlock:^(NSString *filename, NSUInteger index, BOOL *stop) {
-        NSString *file = [[self crashReportDirectory] stringByAppendingPathComponent:filename];
+    [self collectPendingReports];
+
+    /* Load the (memory mapped) data. Each report is mapped, rather than copied into memory, and any objects
+     * autoreleased while processing it are released before the next report is loaded, bounding peak memory use to
+     * that required by a single report. */
+    NSMutableArray *purged = [NSMutableArray array];
+    NSError *loadError = nil;
+    for (PLCrashPendingReportInfo *info in [_reportStore reports]) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSString *file = [_reportStore pathForIdentifier: [info identifier]];
         NSError *err = nil;
-        NSData *contents = [[NSData alloc] initWithContentsOfFile:file options:0 error:&err];
-        if (err) {
-            *stop = YES;
-            *outError = error;
+        NSData *contents = [[NSData alloc] initWithContentsOfFile:file options:NSDataReadingMappedAlways error:&err];
+        if (contents == nil) {
+            loadError = [err retain];
         } else {
             BOOL purge = NO;
             block(contents, &purge);
-            if (purge) [[NSFileManager defaultManager] removeItemAtPath:file error:&err];
-            if (err) {
-                *stop = YES;
-                *outError = error;
-            }
+            [contents release];
+
+            if (purge)
+                [purged addObject: [info identifier]];
         }
-    }];
+        [pool drain];
+
+        if (loadError != nil)
+            break;
+    }
+
+    NSError *purgeError = nil;
+    if (![_reportStore removeReportsWithIdentifiers: purged error: &purgeError] && loadError == nil)
+        loadError = [purgeError retain];
+
+    if (loadError != nil) {
+        if (outError != NULL)
+            *outError = [loadError autorelease];
+        else
+            [loadError release];
+    }
 }
 
 
@@ -530,26 +1168,63 @@ static PLCrashReporter *sharedReporter = nil;
  * @return Returns YES on success, or NO on error.
  */
 - (BOOL) purgePendingCrashReportsAndReturnError: (NSError **) outError {
-    NSError *error = nil;
-    NSArray *reports = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:[self crashReportDirectory] error:&error];
-    if (error) {
-        *outError = error;
-        return NO;
+    [self collectPendingReports];
+
+    NSArray *identifiers = [[_reportStore reports] valueForKey: @"identifier"];
+    return [_reportStore removeReportsWithIdentifiers: identifiers error: outError];
+}
+
+
+/**
+ * Return summary information for each pending crash report, as PLCrashPendingReportInfo instances ordered by the
+ * time at which each report was written.
+ *
+ * The summary is read from a small index of the pending reports, which is only rebuilt if reports have been added
+ * to or removed from the pending report store. This may be used to filter or prioritize pending reports without
+ * loading each report; individual reports may then be loaded via
+ * PLCrashReporter::loadPendingCrashReportWithIdentifier:error:.
+ */
+- (NSArray *) pendingCrashReportInfo {
+    [self collectPendingReports];
+    return [_reportStore reports];
+}
+
+
+/**
+ * Load the pending crash report with the given identifier.
+ *
+ * @param identifier A report identifier, as returned via PLCrashReporter::pendingCrashReportInfo.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the pending crash report could not be
+ * loaded. If no error occurs, this parameter will be left unmodified. You may specify
+ * nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns the (memory mapped) report data, or nil if the report could not be loaded.
+ */
+- (NSData *) loadPendingCrashReportWithIdentifier: (NSString *) identifier error: (NSError **) outError {
+    NSString *file = [_reportStore pathForIdentifier: identifier];
+    if (file == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Invalid pending crash report identifier", nil);
+        return nil;
     }
 
-    __block BOOL wasError = NO;
-    [reports enumerateObjectsUsingBlock:^(NSString *filename, NSUInteger index, BOOL *stop) {
-        NSString *file = [[self crashReportDirectory] stringByAppendingPathComponent:filename];
-        NSError *err = nil;
-        [[NSFileManager defaultManager] removeItemAtPath:file error:&err];
-        if (err) {
-            *outError = err;
-            *stop = YES;
-            wasError = YES;
-        }
-    }];
+    return [NSData dataWithContentsOfFile: file options: NSDataReadingMappedAlways error: outError];
+}
+
 
-    return wasError;
+/**
+ * Purge the pending crash report with the given identifier.
+ *
+ * @param identifier A report identifier, as returned via PLCrashReporter::pendingCrashReportInfo.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the pending crash report could not be
+ * purged. If no error occurs, this parameter will be left unmodified. You may specify
+ * nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO on error.
+ */
+- (BOOL) purgePendingCrashReportWithIdentifier: (NSString *) identifier error: (NSError **) outError {
+    return [_reportStore removeReportsWithIdentifiers: [NSArray arrayWithObject: identifier] error: outError];
 }
 
 
@@ -599,114 +1274,96 @@ static PLCrashReporter *sharedReporter = nil;
  * This restriction may be removed in a future release.
  */
 - (BOOL) enableCrashReporterWithExceptionHandling: (PLExceptionHandling)handling andReturnError: (NSError **) outError {
-    /* Prevent enabling more than one crash reporter, process wide. We can not support multiple chained reporters
-     * due to the use of NSUncaughtExceptionHandler (it doesn't support chaining or assocation of context with the callbacks), as
-     * well as our legacy approach of deregistering any signal handlers upon the first signal. Once PLCrashUncaughtExceptionHandler is
-     * implemented, and we support double-fault handling without resetting the signal handlers, we can support chaining of multiple
-     * crash reporters. */
-    {
-        static BOOL enforceOne = NO;
-        pthread_mutex_t enforceOneLock = PTHREAD_MUTEX_INITIALIZER;
-        pthread_mutex_lock(&enforceOneLock); {
-            if (enforceOne) {
-                pthread_mutex_unlock(&enforceOneLock);
-                plcrash_populate_error(outError, PLCrashReporterErrorResourceBusy, @"A PLCrashReporter instance has already been enabled", nil);
-                return NO;
-            }
-            enforceOne = YES;
-        } pthread_mutex_unlock(&enforceOneLock);
-    }
+    if (![self claimCrashReporterAndReturnError: outError])
+        return NO;
 
-    /* Check for programmer error */
-    if (_enabled)
-        [NSException raise: PLCrashReporterException format: @"The crash reporter has alread been enabled"];
+    /* Prepare all crash handler state prior to registering the handlers */
+    if (![self prepareCrashHandlerAndReturnError: outError])
+        return NO;
+    OSAtomicCompareAndSwap32Barrier(0, 1, &signal_handler_context.ready);
 
-    /* Create the directory tree */
-    if (![self populateCrashReportDirectoryAndReturnError: outError])
+    /* Register the handlers */
+    if (![self registerSignalHandlersAndReturnError: outError])
         return NO;
 
-    /* Set up the signal handler context */
-    signal_handler_context.path = strdup([[self crashReportPath] UTF8String]); // NOTE: would leak if this were not a singleton struct
-    assert(_applicationIdentifier != nil);
-    assert(_applicationVersion != nil);
-    plcrash_log_writer_init(&signal_handler_context.writer, _applicationIdentifier, _applicationVersion, [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy], false);
-    
-    
-    /* Enable the signal handler */
-    switch (_config.signalHandlerType) {
-        case PLCrashReporterSignalHandlerTypeBSD:
-            for (size_t i = 0; i < monitored_signals_count; i++) {
-                if (![[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: monitored_signals[i] callback: &signal_handler_callback context: &signal_handler_context error: outError])
-                    return NO;
-            }
-            break;
+    if (![self enableMachExceptionHandlingAndReturnError: outError])
+        return NO;
 
-#if PLCRASH_FEATURE_MACH_EXCEPTIONS
-        case PLCrashReporterSignalHandlerTypeMach: {
-            /* We still need to use signal handlers to catch SIGABRT in-process. The kernel sends an EXC_CRASH mach exception
-             * to denote SIGABRT termination. In that case, catching the Mach exception in-process leads to process deadlock
-             * in an uninterruptable wait. Thus, we fall back on BSD signal handlers for SIGABRT, and do not register for
-             * EXC_CRASH. */
-            if (![[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: SIGABRT callback: &signal_handler_callback context: &signal_handler_context error: outError])
-                return NO;
-            
-            /* Enable the server. */
-            _machServer = [self enableMachExceptionServerWithPreviousPortSet: &_previousMachPorts
-                                                                    callback: &mach_exception_callback
-                                                                     context: &signal_handler_context
-                                                                       error: outError];
-            if (_machServer == nil)
-                return NO;
-            
-            /* Acquire references to the autoreleased values */
-            [_machServer retain];
-            [_previousMachPorts retain];
-            
-            /*
-             * MEMORY WARNING: To ensure that our instance survives for the lifetime of the callback registration,
-             * we retain it here. This is necessary to ensure that the Mach exception server instance and previous port set
-             * survive for the lifetime of the callback. Since there's currently no support for *deregistering* a crash reporter,
-             * this simply results in the reporter living forever.
-             */
-            [self retain];
-            
-            /*
-             * Save the previous ports. There's a race condition here, in that an exception that is delivered before (or during)
-             * setting the previous port values will see a fully and/or partially configured port set. This could be an issue
-             * when interoperating with managed runtimes, where NULL dereferences may trigger exception handling
-             * in a common runtime case.
-             *
-             * TODO: Investigate use of (async-safe) locking to close the window in which an exception would not be safely forwarded.
-             * This issue also exists (and is noted with a TODO) in PLCrashSignalHandler.
-             */
-            signal_handler_context.port_set = [_previousMachPorts asyncSafeRepresentation];
-            break;
-        }
-#endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
-    }
+    [self registerExceptionHandler: handling];
 
-    /* Set the uncaught exception handler */
-    if (handling == PLExceptionHandlingUncaughtOnly)
-        NSSetUncaughtExceptionHandler(&uncaught_exception_handler);
-    else if (handling == PLExceptionHandlingAll) {
-#if TARGET_OS_MAC && !TARGET_IPHONE_SIMULATOR && !TARGET_OS_IPHONE
-        [[NSExceptionHandler defaultExceptionHandler] setExceptionHandlingMask:
-         [[NSExceptionHandler defaultExceptionHandler] exceptionHandlingMask] |
-         NSHandleUncaughtExceptionMask |
-         NSHandleUncaughtSystemExceptionMask |
-         NSHandleUncaughtRuntimeErrorMask |
-         NSHandleTopLevelExceptionMask | NSHandleOtherExceptionMask];
-        [[NSExceptionHandler defaultExceptionHandler] setDelegate:self];
-#else
-        [NSException raise:PLCrashReporterException format:@"Can only use PLExceptionHandlingAll with OS X builds."];
-#endif
-    }
+    /* Fault in the crash handler's memory, now that the signal stack and any capture workers are in place */
+    if (_config.crashPathWarmup != PLCrashReporterCrashPathWarmupNone)
+        [self prefaultCrashPathAndWire: _config.crashPathWarmup == PLCrashReporterCrashPathWarmupWire];
 
     /* Success */
     _enabled = YES;
     return YES;
 }
 
+/**
+ * Enable the crash reporter, performing only the minimum required work on the calling thread.
+ *
+ * The signal and exception handlers are registered synchronously; all remaining setup, including creation of the
+ * crash report directory, initialization of the report writer, indexing of the loaded images, and startup of any
+ * Mach exception server, is then performed on a background queue. Until that setup completes, a crash will not be
+ * reported, and is handled as if the crash reporter had not been enabled.
+ *
+ * This method must only be invoked once, and may not be combined with
+ * PLCrashReporter::enableCrashReporterWithExceptionHandling:andReturnError:. Further invocations will throw a
+ * PLCrashReporterException.
+ *
+ * @param handling Determines what kinds of @a NSException instances will be handled by the crash reporter.
+ * @param completion A block to be executed on a background queue once setup has completed. If setup failed,
+ * @a enabled will be NO, and @a error will describe the failure; the registered handlers will remain in place, but
+ * crashes will not be reported. May be nil.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error in the PLCrashReporterErrorDomain indicating why the Crash Reporter
+ * could not be enabled. If no error occurs, this parameter will be left unmodified. You may
+ * specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES if the handlers were registered and setup has been scheduled, or NO if the crash reporter
+ * could not be enabled, in which case @a completion will not be executed.
+ */
+- (BOOL) enableCrashReporterAsynchronouslyWithExceptionHandling: (PLExceptionHandling) handling
+                                                      completion: (void (^)(BOOL enabled, NSError *error)) completion
+                                                           error: (NSError **) outError
+{
+    if (![self claimCrashReporterAndReturnError: outError])
+        return NO;
+
+    /* Register the handlers; the signal handler will decline all crashes until the crash handler state has been
+     * prepared */
+    if (![self registerSignalHandlersAndReturnError: outError])
+        return NO;
+
+    [self registerExceptionHandler: handling];
+    _enabled = YES;
+
+    /* The block retains the reporter until setup completes */
+    void (^completionBlock)(BOOL, NSError *) = [[completion copy] autorelease];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSError *error = nil;
+        BOOL enabled = [self prepareCrashHandlerAndReturnError: &error];
+        if (enabled)
+            enabled = [self enableMachExceptionHandlingAndReturnError: &error];
+
+        if (enabled) {
+            OSAtomicCompareAndSwap32Barrier(0, 1, &signal_handler_context.ready);
+
+            /* Fault in the crash handler's memory, now that the signal stack and any capture workers are in place */
+            if (_config.crashPathWarmup != PLCrashReporterCrashPathWarmupNone)
+                [self prefaultCrashPathAndWire: _config.crashPathWarmup == PLCrashReporterCrashPathWarmupWire];
+        }
+
+        if (completionBlock != nil)
+            completionBlock(enabled, enabled ? nil : error);
+        [pool drain];
+    });
+
+    return YES;
+}
+
 /**
  * Generate a live crash report for a given @a thread, without triggering an actual crash condition.
  * This may be used to log current process state without actually crashing. The crash report data will be
@@ -723,23 +1380,14 @@ static PLCrashReporter *sharedReporter = nil;
 }
 
 
-/* State and callback used by -generateLiveReportWithThread */
-struct plcr_live_report_context {
-    plcrash_log_writer_t *writer;
-    plcrash_async_file_t *file;
-    plcrash_log_signal_info_t *info;
-};
-static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *state, void *ctx) {
-    struct plcr_live_report_context *plcr_ctx = ctx;
-    return plcrash_log_writer_write(plcr_ctx->writer, pl_mach_thread_self(), &shared_image_list, plcr_ctx->file, plcr_ctx->info, state);
-}
-
-
 /**
  * Generate a live crash report for a given @a thread, without triggering an actual crash condition.
  * This may be used to log current process state without actually crashing. The crash report data will be
  * returned on success.
  *
+ * Each call creates and discards a new live report session; clients generating reports repeatedly should
+ * prefer reusing a session returned by PLCrashReporter::liveReportSessionAndReturnError:.
+ *
  * @param thread The thread which will be marked as the failing thread in the generated report.
  * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
  * will contain an error object indicating why the crash report could not be generated or loaded. If no
@@ -747,18 +1395,242 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
  * error information will be provided.
  *
  * @return Returns nil if the crash report data could not be loaded.
- *
- * @todo Implement in-memory, rather than requiring writing of the report to disk.
  */
 - (NSData *) generateLiveReportWithThread: (thread_t) thread error: (NSError **) outError {
-    plcrash_log_writer_t writer;
+    PLCrashLiveReportSession *session = [self liveReportSessionAndReturnError: outError];
+    if (session == nil)
+        return nil;
+
+    return [session generateLiveReportWithThread: thread error: outError];
+}
+
+
+/**
+ * Generate a live crash report containing only the given @a threads, without triggering an actual crash condition.
+ * Only the listed threads are suspended and walked, and only the images referenced by their frames (along with the
+ * main executable) are written, allowing targeted diagnostics of a few threads at a cost that does not scale with
+ * the total number of threads in the process.
+ *
+ * @param threads The threads to be written, in order. The first thread will be marked as the failing thread in the
+ * generated report. The current thread may be included.
+ * @param count The number of entries in @a threads. Must be non-zero.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report data could not be generated.
+ *
+ * @sa PLCrashLiveReportSession::generateLiveReportForThreads:count:error:
+ */
+- (NSData *) generateLiveReportForThreads: (const thread_t *) threads count: (mach_msg_type_number_t) count error: (NSError **) outError {
+    PLCrashLiveReportSession *session = [self liveReportSessionAndReturnError: outError];
+    if (session == nil)
+        return nil;
+
+    return [session generateLiveReportForThreads: threads count: count error: outError];
+}
+
+
+/**
+ * Create a reusable live report session. The session's report writer and symbol caches are initialized
+ * once, and its reports are generated in memory, avoiding the per-report setup and temporary file I/O
+ * of PLCrashReporter::generateLiveReportWithThread:error:.
+ *
+ * The session uses the receiver's current application identifier, version, and configuration.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the session could not be created. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the session could not be created.
+ */
+- (PLCrashLiveReportSession *) liveReportSessionAndReturnError: (NSError **) outError {
+    PLCrashLiveReportSession *session;
+    plcrash_async_symbol_strategy_t strategies[PLCRASH_ASYNC_IMAGE_CLASS_COUNT];
+
+    [self mapToAsyncImageSymbolicationStrategies: strategies];
+    session = [[PLCrashLiveReportSession alloc] initWithApplicationIdentifier: _applicationIdentifier
+                                                                    appVersion: _applicationVersion
+                                                              symbolStrategies: strategies
+                                                                 configuration: _config
+                                                                     imageList: &shared_image_list
+                                                                   outputLimit: MAX_REPORT_BYTES
+                                                                         error: outError];
+    if (session != nil && shared_breadcrumbs.header != NULL)
+        [session setBreadcrumbRing: &shared_breadcrumbs];
+    [session setCustomDataRegistry: &shared_custom_data];
+    [session setImageManifest: image_manifest_state.current];
+
+    return [session autorelease];
+}
+
+
+/**
+ * Generate a live crash report, without triggering an actual crash condition. This may be used to log
+ * current process state without actually crashing. The crash report data will be returned on
+ * success.
+ * 
+ * @return Returns nil if the crash report data could not be loaded.
+ */
+- (NSData *) generateLiveReport {
+    return [self generateLiveReportAndReturnError: NULL];
+}
+
+
+/**
+ * Generate a live crash report for the current thread, without triggering an actual crash condition.
+ * This may be used to log current process state without actually crashing. The crash report data will be
+ * returned on success.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the pending crash report could not be
+ * generated or loaded. If no error occurs, this parameter will be left unmodified. You may specify
+ * nil for this parameter, and no error information will be provided.
+ * 
+ * @return Returns nil if the crash report data could not be loaded.
+ */
+- (NSData *) generateLiveReportAndReturnError: (NSError **) outError {
+    return [self generateLiveReportWithThread: pl_mach_thread_self() error: outError];
+}
+
+
+/**
+ * Generate a live crash report for a given @a thread, without triggering an actual crash condition, and return the
+ * decoded report. This may be used for in-process diagnostics that inspect the report directly; the report is
+ * decoded from the in-memory encoding without being compressed, copied, or written to disk.
+ *
+ * @param thread The thread which will be marked as the failing thread in the generated report.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report could not be generated.
+ *
+ * @sa PLCrashLiveReportSession::generateLiveCrashReportWithThread:error:
+ */
+- (PLCrashReport *) generateLiveCrashReportWithThread: (thread_t) thread error: (NSError **) outError {
+    PLCrashLiveReportSession *session = [self liveReportSessionAndReturnError: outError];
+    if (session == nil)
+        return nil;
+
+    return [session generateLiveCrashReportWithThread: thread error: outError];
+}
+
+
+/**
+ * Generate a live crash report for the current thread, without triggering an actual crash condition, and return
+ * the decoded report. See PLCrashReporter::generateLiveCrashReportWithThread:error:.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report could not be generated.
+ */
+- (PLCrashReport *) generateLiveCrashReportAndReturnError: (NSError **) outError {
+    return [self generateLiveCrashReportWithThread: pl_mach_thread_self() error: outError];
+}
+
+
+/**
+ * Start the in-process sampling profiler. A dedicated thread will periodically suspend and sample the call stacks
+ * of all threads in the current process; the aggregated results may be fetched via
+ * PLCrashReporter::generateProfileReportAndReturnError:.
+ *
+ * Threads are unwound using the configured PLCrashReporterConfig::threadCaptureMode; when using
+ * PLCrashReporterThreadCaptureModeFramePointer, only frame pointers are used, minimizing the time that each
+ * thread remains suspended.
+ *
+ * @param interval The interval between samples, in seconds.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the sampler could not be started. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns YES on success, or NO if the sampler could not be started.
+ */
+- (BOOL) startSamplingWithInterval: (NSTimeInterval) interval error: (NSError **) outError {
+    plcrash_error_t err;
+
+    if (_sampler != NULL) {
+        plcrash_populate_error(outError, PLCrashReporterErrorResourceBusy, @"The sampling profiler is already running", nil);
+        return NO;
+    }
+
+    if (interval <= 0 || interval * USEC_PER_SEC > UINT32_MAX) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Invalid sampling interval", nil);
+        return NO;
+    }
+
+    /* Make sure the image list is fully populated before sampling begins */
+    plcrash_nasync_image_list_load_deferred(&shared_image_list);
+
+    plcrash_sampler_t *sampler = malloc(sizeof(*sampler));
+    if (sampler == NULL) {
+        plcrash_populate_posix_error(outError, ENOMEM, @"Could not allocate the sampling profiler");
+        return NO;
+    }
+
+    bool full_unwind = (_config.threadCaptureMode != PLCrashReporterThreadCaptureModeFramePointer);
+    if ((err = plcrash_nasync_sampler_init(sampler, &shared_image_list, SAMPLER_CAPACITY, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, full_unwind)) != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not initialize the sampling profiler", nil);
+        free(sampler);
+        return NO;
+    }
+
+    if ((err = plcrash_nasync_sampler_start(sampler, (uint32_t) (interval * USEC_PER_SEC))) != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Could not start the sampling thread", nil);
+        plcrash_nasync_sampler_free(sampler);
+        free(sampler);
+        return NO;
+    }
+
+    _sampler = sampler;
+    return YES;
+}
+
+/**
+ * Stop the sampling profiler, if running, and discard all recorded samples.
+ */
+- (void) stopSampling {
+    if (_sampler == NULL)
+        return;
+
+    plcrash_nasync_sampler_stop(_sampler);
+    plcrash_nasync_sampler_free(_sampler);
+    free(_sampler);
+    _sampler = NULL;
+}
+
+/**
+ * Generate a profile report from the samples recorded since the sampling profiler was started. The report
+ * is encoded as defined by profile_report.proto, and carries the same binary image records as a crash report,
+ * allowing the sampled PCs to be symbolicated with the same tooling.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the profile report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the profile report could not be generated.
+ */
+- (NSData *) generateProfileReportAndReturnError: (NSError **) outError {
     plcrash_async_file_t file;
     plcrash_error_t err;
 
+    if (_sampler == NULL) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"The sampling profiler is not running", nil);
+        return nil;
+    }
+
     /* Open the output file */
-    NSString *templateStr = [NSTemporaryDirectory() stringByAppendingPathComponent: @"live_crash_report.XXXXXX"];
+    NSString *templateStr = [NSTemporaryDirectory() stringByAppendingPathComponent: @"profile_report.XXXXXX"];
     char *path = strdup([templateStr fileSystemRepresentation]);
-    
+
     int fd = mkstemp(path);
     if (fd < 0) {
         plcrash_populate_posix_error(outError, errno, NSLocalizedString(@"Failed to create temporary path", @"Error opening temporary output path"));
@@ -767,61 +1639,26 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
         return nil;
     }
 
-    /* Initialize the output context */
-    plcrash_log_writer_init(&writer, _applicationIdentifier, _applicationVersion, [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy], true);
-    plcrash_async_file_init(&file, fd, MAX_REPORT_BYTES);
-    
-    /* Mock up a SIGTRAP-based signal info */
-    plcrash_log_bsd_signal_info_t bsd_signal_info;
-    plcrash_log_signal_info_t signal_info;
-    bsd_signal_info.signo = SIGTRAP;
-    bsd_signal_info.code = TRAP_TRACE;
-    bsd_signal_info.address = __builtin_return_address(0);
-
-    signal_info.bsd_info = &bsd_signal_info;
-    signal_info.mach_info = NULL;
-    
-    /* Write the crash log using the already-initialized writer */
-    if (thread == pl_mach_thread_self()) {
-        struct plcr_live_report_context ctx = {
-            .writer = &writer,
-            .file = &file,
-            .info = &signal_info
-        };
-        err = plcrash_async_thread_state_current(plcr_live_report_callback, &ctx);
-    } else {
-        err = plcrash_log_writer_write(&writer, thread, &shared_image_list, &file, &signal_info, NULL);
-    }
-    plcrash_log_writer_close(&writer);
-
-    /* Flush the data */
+    plcrash_async_file_init(&file, fd, MAX_PROFILE_BYTES);
+    err = plcrash_nasync_sampler_write_profile(_sampler, &file);
     plcrash_async_file_flush(&file);
     plcrash_async_file_close(&file);
 
-    /* Check for write failure */
-    NSData *data;
+    NSData *data = nil;
     if (err != PLCRASH_ESUCCESS) {
-        NSLog(@"Write failed with error %s", plcrash_async_strerror(err));
-        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to write the crash report to disk", nil);
-        data = nil;
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to write the profile report to disk", nil);
         goto cleanup;
     }
 
     data = [NSData dataWithContentsOfFile: [NSString stringWithUTF8String: path]];
     if (data == nil) {
-        /* This should only happen if our data is deleted out from under us */
-        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, NSLocalizedString(@"Unable to open live crash report for reading", nil), nil);
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, NSLocalizedString(@"Unable to open profile report for reading", nil), nil);
         goto cleanup;
     }
 
 cleanup:
-    /* Finished -- clean up. */
-    plcrash_log_writer_free(&writer);
-
-    if (unlink(path) != 0) {
-        /* This shouldn't fail, but if it does, there's no use in returning nil */
-        NSLog(@"Failure occured deleting live crash report: %s", strerror(errno));
-    }
+    if (unlink(path) != 0)
+        NSLog(@"Failure occured deleting profile report: %s", strerror(errno));
 
     free(path);
     return data;
@@ -829,33 +1666,559 @@ cleanup:
 
 
 /**
- * Generate a live crash report, without triggering an actual crash condition. This may be used to log
- * current process state without actually crashing. The crash report data will be returned on
- * success.
- * 
- * @return Returns nil if the crash report data could not be loaded.
+ * Start monitoring the main thread for hangs. A watchdog thread periodically verifies that the main dispatch queue
+ * is being serviced; once the main thread has been unresponsive for longer than @a threshold, its call stack is
+ * sampled every @a sampleInterval using only frame pointers. When the main thread recovers, the buffered samples
+ * are written as a single hang report, replacing any previous pending hang report.
+ *
+ * Hang reports are not symbolicated when written; they contain the sampled PCs and the loaded binary images, and
+ * are encoded as the HangReport message defined by profile_report.proto.
+ *
+ * @param threshold The duration for which the main thread must be unresponsive before it is considered hung, in seconds.
+ * @param sampleInterval The interval between samples of the hung main thread, in seconds.
+ * @param maximumSamples The maximum number of samples to record per hang.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the hang monitor could not be started. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns YES on success, or NO if the hang monitor could not be started.
  */
-- (NSData *) generateLiveReport {
-    return [self generateLiveReportAndReturnError: NULL];
+- (BOOL) startHangMonitorWithThreshold: (NSTimeInterval) threshold
+                        sampleInterval: (NSTimeInterval) sampleInterval
+                        maximumSamples: (NSUInteger) maximumSamples
+                                 error: (NSError **) outError
+{
+    plcrash_error_t err;
+
+    if (_hangMonitor != NULL) {
+        plcrash_populate_error(outError, PLCrashReporterErrorResourceBusy, @"The hang monitor is already running", nil);
+        return NO;
+    }
+
+    if (threshold <= 0 || threshold * USEC_PER_SEC > UINT32_MAX ||
+        sampleInterval <= 0 || sampleInterval * USEC_PER_SEC > UINT32_MAX ||
+        maximumSamples == 0)
+    {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Invalid hang monitor configuration", nil);
+        return NO;
+    }
+
+    /* The report is written alongside the crash report directory */
+    if (![self populateCrashReportDirectoryAndReturnError: outError])
+        return NO;
+
+    /* Make sure the image list is fully populated before monitoring begins */
+    plcrash_nasync_image_list_load_deferred(&shared_image_list);
+
+    plcrash_hang_monitor_t *monitor = malloc(sizeof(*monitor));
+    if (monitor == NULL) {
+        plcrash_populate_posix_error(outError, ENOMEM, @"Could not allocate the hang monitor");
+        return NO;
+    }
+
+    thread_t main_thread = pthread_mach_thread_np(pthread_main_thread_np());
+    err = plcrash_nasync_hang_monitor_init(monitor, &shared_image_list, main_thread, [[self hangReportPath] fileSystemRepresentation],
+                                           (uint32_t) (threshold * USEC_PER_SEC), (uint32_t) (sampleInterval * USEC_PER_SEC), maximumSamples);
+    if (err != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Could not initialize the hang monitor", nil);
+        free(monitor);
+        return NO;
+    }
+
+    if ((err = plcrash_nasync_hang_monitor_start(monitor)) != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Could not start the hang monitor thread", nil);
+        plcrash_nasync_hang_monitor_free(monitor);
+        free(monitor);
+        return NO;
+    }
+
+    _hangMonitor = monitor;
+    return YES;
 }
 
+/**
+ * Stop the main thread hang monitor, if running. A hang in progress will not be reported.
+ */
+- (void) stopHangMonitor {
+    if (_hangMonitor == NULL)
+        return;
+
+    plcrash_nasync_hang_monitor_free(_hangMonitor);
+    free(_hangMonitor);
+    _hangMonitor = NULL;
+}
 
 /**
- * Generate a live crash report for the current thread, without triggering an actual crash condition.
- * This may be used to log current process state without actually crashing. The crash report data will be
- * returned on success.
+ * Returns YES if a hang report has been written by the hang monitor, and not yet purged.
+ */
+- (BOOL) hasPendingHangReport {
+    return [[NSFileManager defaultManager] fileExistsAtPath: [self hangReportPath]];
+}
+
+/**
+ * Load the most recent pending hang report.
  *
  * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
- * will contain an error object indicating why the pending crash report could not be
- * generated or loaded. If no error occurs, this parameter will be left unmodified. You may specify
+ * will contain an error object indicating why the pending hang report could not be
+ * loaded. If no error occurs, this parameter will be left unmodified. You may specify
  * nil for this parameter, and no error information will be provided.
- * 
- * @return Returns nil if the crash report data could not be loaded.
+ *
+ * @return Returns nil if the hang report data could not be loaded.
+ */
+- (NSData *) loadPendingHangReportAndReturnError: (NSError **) outError {
+    return [NSData dataWithContentsOfFile: [self hangReportPath] options: NSMappedRead error: outError];
+}
+
+/**
+ * Purge the pending hang report, if any.
+ *
+ * @return Returns YES on success, or NO on error.
+ */
+- (BOOL) purgePendingHangReportAndReturnError: (NSError **) outError {
+    if (![self hasPendingHangReport])
+        return YES;
+
+    return [[NSFileManager defaultManager] removeItemAtPath: [self hangReportPath] error: outError];
+}
+
+/**
+ * Return the identifiers of all persisted image manifests. A manifest is written for each distinct set of loaded
+ * images when PLCrashReporterConfig::imageManifestEnabled is set, and may be referenced by any number of reports via
+ * PLCrashReport::imageManifestIdentifier; each manifest need only be submitted once.
+ */
+- (NSArray *) imageManifestIdentifiers {
+    NSArray *files = [[NSFileManager defaultManager] contentsOfDirectoryAtPath: [self imageManifestDirectory] error: NULL];
+    NSMutableArray *identifiers = [NSMutableArray arrayWithCapacity: [files count]];
+
+    for (NSString *file in files) {
+        if ([[file pathExtension] isEqualToString: PLCRASH_IMAGE_MANIFEST_EXT])
+            [identifiers addObject: [file stringByDeletingPathExtension]];
+    }
+
+    return identifiers;
+}
+
+/**
+ * Load the persisted image manifest with the given @a identifier.
+ *
+ * @param identifier The manifest identifier.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the image manifest could not be
+ * loaded. If no error occurs, this parameter will be left unmodified. You may specify
+ * nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns nil if the image manifest could not be loaded.
+ */
+- (NSData *) loadImageManifestWithIdentifier: (NSString *) identifier error: (NSError **) outError {
+    NSString *file = [identifier stringByAppendingPathExtension: PLCRASH_IMAGE_MANIFEST_EXT];
+    return [NSData dataWithContentsOfFile: [[self imageManifestDirectory] stringByAppendingPathComponent: file] options: NSMappedRead error: outError];
+}
+
+/**
+ * Purge the persisted image manifest with the given @a identifier. If the manifest describes the currently loaded
+ * images, it will not be rewritten until the loaded images change.
+ *
+ * @param identifier The manifest identifier.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the manifest could not be purged.
+ *
+ * @return Returns YES on success, or NO on error.
+ */
+- (BOOL) purgeImageManifestWithIdentifier: (NSString *) identifier error: (NSError **) outError {
+    NSString *file = [identifier stringByAppendingPathExtension: PLCRASH_IMAGE_MANIFEST_EXT];
+    return [[NSFileManager defaultManager] removeItemAtPath: [[self imageManifestDirectory] stringByAppendingPathComponent: file] error: outError];
+}
+
+/**
+ * Returns the number of crashes that were not written as full reports, as they repeated a crash that was reported
+ * within the configured PLCrashReporterConfig::duplicateSuppressionInterval. The count is persisted across launches,
+ * and is only cleared by PLCrashReporter::resetSuppressedCrashCount.
+ */
+- (NSUInteger) suppressedCrashCount {
+    if (![[NSFileManager defaultManager] fileExistsAtPath: [self duplicateFilterPath]])
+        return 0;
+
+    plcrash_duplicate_filter_t filter;
+    if (plcrash_nasync_duplicate_filter_init(&filter, [[self duplicateFilterPath] fileSystemRepresentation], 0) != PLCRASH_ESUCCESS)
+        return 0;
+
+    NSUInteger count = plcrash_nasync_duplicate_filter_repeat_count(&filter);
+    plcrash_nasync_duplicate_filter_free(&filter);
+
+    return count;
+}
+
+/**
+ * Reset the suppressed crash count to zero. This should be called once the count has been submitted along with
+ * the corresponding pending crash report. The signatures of recently reported crashes are retained, and repeats
+ * within the suppression interval will continue to be counted rather than reported.
+ */
+- (void) resetSuppressedCrashCount {
+    if (![[NSFileManager defaultManager] fileExistsAtPath: [self duplicateFilterPath]])
+        return;
+
+    plcrash_duplicate_filter_t filter;
+    if (plcrash_nasync_duplicate_filter_init(&filter, [[self duplicateFilterPath] fileSystemRepresentation], 0) != PLCRASH_ESUCCESS)
+        return;
+
+    plcrash_nasync_duplicate_filter_reset_repeat_counts(&filter);
+    plcrash_nasync_duplicate_filter_free(&filter);
+}
+
+/**
+ * Enable breadcrumb recording. Breadcrumbs are recorded to a fixed-size ring that is memory-mapped from a file
+ * alongside the crash report directory; the most recently recorded breadcrumbs are included in every subsequently
+ * written report.
+ *
+ * As the ring is persisted, the breadcrumbs recorded by the previous launch remain available via
+ * PLCrashReporter::previousSessionBreadcrumbs, even if that launch was terminated without a crash report being
+ * written, eg, by the system watchdog or by jetsam. The ring is then cleared for use by the current launch.
+ *
+ * Breadcrumbs may only be enabled once per process.
+ *
+ * @param size The size of the ring file, in bytes. Each breadcrumb occupies PLCRASH_BREADCRUMB_SLOT_SIZE bytes; if
+ * the size is changed between launches, the previous launch's breadcrumbs are discarded.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why breadcrumbs could not be enabled. If no error occurs, this parameter will be left unmodified.
+ * You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO if breadcrumbs could not be enabled.
+ */
+- (BOOL) enableBreadcrumbsWithSize: (NSUInteger) size error: (NSError **) outError {
+    plcrash_error_t err;
+
+    if (shared_breadcrumbs.header != NULL) {
+        plcrash_populate_error(outError, PLCrashReporterErrorResourceBusy, @"Breadcrumbs have already been enabled", nil);
+        return NO;
+    }
+
+    /* The ring is written alongside the crash report directory */
+    if (![self populateCrashReportDirectoryAndReturnError: outError])
+        return NO;
+
+    plcrash_breadcrumb_ring_t ring;
+    if ((err = plcrash_nasync_breadcrumb_ring_init(&ring, [[self breadcrumbsPath] fileSystemRepresentation], size)) != PLCRASH_ESUCCESS) {
+        if (err == PLCRASH_EINVAL) {
+            plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Invalid breadcrumb ring size", nil);
+        } else {
+            plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Could not map the breadcrumb ring", nil);
+        }
+        return NO;
+    }
+
+    /* Preserve the previous launch's breadcrumbs, and then clear the ring */
+    NSMutableArray *previous = [NSMutableArray array];
+    plcrash_breadcrumb_slot_t slot;
+    uint64_t end;
+    for (uint64_t seq = plcrash_async_breadcrumb_ring_first(&ring, &end); seq <= end; seq++) {
+        if (!plcrash_async_breadcrumb_ring_read(&ring, seq, &slot))
+            continue;
+
+        NSData *data = [NSData dataWithBytes: slot.data length: slot.length];
+        [previous addObject: [[[PLCrashReportBreadcrumb alloc] initWithSequenceNumber: seq data: data] autorelease]];
+    }
+
+    plcrash_nasync_breadcrumb_ring_reset(&ring);
+
+    [_previousBreadcrumbs release];
+    _previousBreadcrumbs = [previous copy];
+
+    /* Publish the ring, and include it in crash-time reports */
+    shared_breadcrumbs = ring;
+    OSMemoryBarrier();
+    if (_enabled)
+        plcrash_log_writer_set_breadcrumbs(&signal_handler_context.writer, &shared_breadcrumbs);
+
+    return YES;
+}
+
+/**
+ * Record a breadcrumb. This method performs no locking or system calls, and may be called from any thread. If
+ * breadcrumbs have not been enabled via PLCrashReporter::enableBreadcrumbsWithSize:error:, the breadcrumb is
+ * discarded.
+ *
+ * @param bytes The breadcrumb data. Breadcrumbs longer than PLCRASH_BREADCRUMB_MAX_LENGTH bytes are truncated.
+ * @param length The length of @a bytes.
+ */
+- (void) recordBreadcrumbBytes: (const void *) bytes length: (NSUInteger) length {
+    plcrash_async_breadcrumb_ring_record(&shared_breadcrumbs, bytes, length);
+}
+
+/**
+ * Record a UTF-8 encoded breadcrumb message. See PLCrashReporter::recordBreadcrumbBytes:length:.
+ *
+ * @param message The breadcrumb message.
+ */
+- (void) recordBreadcrumb: (NSString *) message {
+    const char *utf8 = [message UTF8String];
+    if (utf8 != NULL)
+        plcrash_async_breadcrumb_ring_record(&shared_breadcrumbs, utf8, strlen(utf8));
+}
+
+/**
+ * Register an application-owned memory region whose contents will be included in all subsequently written reports.
+ *
+ * The region is not copied when registered, or when modified; at crash time, its contents are written directly from
+ * @a bytes. Frequently updated application state may therefore be kept in a preallocated region at no additional
+ * cost.
+ *
+ * As the region may be modified while a report is being written, a @a version counter may be provided. The
+ * application must increment the counter to an odd value before modifying the region, and to an even value once the
+ * modification is complete, with appropriate memory barriers; if the counter is odd or changes while the region is
+ * written, the region will be marked as torn (see PLCrashReportCustomData::torn).
+ *
+ * @param identifier The region identifier, at most 63 bytes when UTF-8 encoded.
+ * @param bytes The region's address. The region must remain valid until it has been unregistered via
+ * PLCrashReporter::unregisterCustomData:.
+ * @param length The length of @a bytes.
+ * @param version The region's version counter, or NULL. If non-NULL, the counter must remain valid until the region
+ * has been unregistered.
+ * @param outHandle On success, the handle to be passed to PLCrashReporter::unregisterCustomData:.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the region could not be registered. If no error occurs, this parameter will be left
+ * unmodified. You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO if the region could not be registered.
+ */
+- (BOOL) registerCustomDataWithIdentifier: (NSString *) identifier
+                                    bytes: (const void *) bytes
+                                   length: (NSUInteger) length
+                                  version: (const volatile uint32_t *) version
+                                   handle: (NSUInteger *) outHandle
+                                    error: (NSError **) outError
+{
+    uint32_t handle;
+    plcrash_error_t err = plcrash_nasync_custom_data_register(&shared_custom_data, [identifier UTF8String], bytes, length, version, &handle);
+    if (err == PLCRASH_EINVAL) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Invalid custom data identifier", nil);
+        return NO;
+    } else if (err != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorResourceBusy, @"The maximum number of custom data regions are registered", nil);
+        return NO;
+    }
+
+    *outHandle = handle;
+    return YES;
+}
+
+/**
+ * Unregister a custom data region previously registered via
+ * PLCrashReporter::registerCustomDataWithIdentifier:bytes:length:version:handle:error:. Once unregistered, the region
+ * will not be included in subsequently written reports.
+ *
+ * @param handle The handle returned on registration.
+ */
+- (void) unregisterCustomData: (NSUInteger) handle {
+    plcrash_nasync_custom_data_unregister(&shared_custom_data, (uint32_t) handle);
+}
+
+/**
+ * Return the breadcrumbs recorded by the previous launch, as PLCrashReportBreadcrumb instances, oldest first. These may
+ * be attached to a report of the previous launch's termination. If breadcrumbs have not been enabled via
+ * PLCrashReporter::enableBreadcrumbsWithSize:error:, or none were recorded, the array will be empty.
+ */
+- (NSArray *) previousSessionBreadcrumbs {
+    if (_previousBreadcrumbs == nil)
+        return [NSArray array];
+
+    return _previousBreadcrumbs;
+}
+
+/**
+ * @internal
+ *
+ * Drain callback; aggregates each event into the dictionary supplied as @a context.
+ */
+static void resource_event_aggregate (const plcrash_resource_event_t *event, void *context) {
+    NSMutableDictionary *aggregated = context;
+    const plcrash_sampler_sample_t *sample = plcrash_resource_event_sample(event);
+
+    /* Events are aggregated by exception type, resource type/flavor (the first code), and stack; the remaining
+     * codes describe the observed value, and vary between occurrences. */
+    NSMutableData *key = [NSMutableData data];
+    [key appendBytes: &event->type length: sizeof(event->type)];
+    if (event->code_count > 0)
+        [key appendBytes: &event->codes[0] length: sizeof(event->codes[0])];
+    [key appendBytes: sample->pcs length: sizeof(sample->pcs[0]) * sample->depth];
+
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970: event->timestamp];
+
+    PLCrashResourceEvent *existing = [aggregated objectForKey: key];
+    if (existing != nil) {
+        [existing addOccurrenceAtDate: date];
+        return;
+    }
+
+    NSMutableArray *codes = [NSMutableArray arrayWithCapacity: event->code_count];
+    for (uint32_t i = 0; i < event->code_count; i++)
+        [codes addObject: [NSNumber numberWithLongLong: event->codes[i]]];
+
+    NSMutableArray *frames = [NSMutableArray arrayWithCapacity: sample->depth];
+    for (uint32_t i = 0; i < sample->depth; i++)
+        [frames addObject: [NSNumber numberWithUnsignedLongLong: sample->pcs[i]]];
+
+    PLCrashResourceEvent *result = [[[PLCrashResourceEvent alloc] initWithExceptionType: event->type
+                                                                          exceptionCodes: codes
+                                                                             stackFrames: frames
+                                                                                    date: date] autorelease];
+    [aggregated setObject: result forKey: key];
+}
+
+/**
+ * Start recording non-fatal resource exceptions, such as EXC_RESOURCE CPU and wakeups limit notifications.
+ *
+ * These exceptions do not terminate the process, and may be raised at a high rate. Rather than writing a crash
+ * report, only the offending thread's frame PCs are recorded, using the frame pointer unwinder, into a preallocated
+ * ring buffer; the kernel is then replied to immediately. At most @a maximumRate events are recorded per second;
+ * excess events are counted by PLCrashReporter::droppedResourceEventCount. Recorded events may be fetched with
+ * PLCrashReporter::drainResourceEvents.
+ *
+ * Resource exceptions are received by a dedicated Mach exception server, independent of the configured signal
+ * handler type; EXC_GUARD exceptions are fatal under the default task policy, and continue to be reported as
+ * crashes.
+ *
+ * @param maximumRate The maximum number of events to be recorded per second.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error in the PLCrashReporterErrorDomain indicating why resource monitoring
+ * could not be started. If no error occurs, this parameter will be left unmodified. You may
+ * specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO if resource monitoring could not be started.
+ */
+- (BOOL) startResourceEventMonitoringWithMaximumRate: (NSUInteger) maximumRate error: (NSError **) outError {
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS && defined(EXC_MASK_RESOURCE)
+    if (_resourceEvents != NULL) {
+        plcrash_populate_error(outError, PLCrashReporterErrorResourceBusy, @"Resource event monitoring is already running", nil);
+        return NO;
+    }
+
+    if (maximumRate == 0 || maximumRate > UINT32_MAX) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Invalid resource event rate", nil);
+        return NO;
+    }
+
+    /* Make sure the image list is fully populated before monitoring begins */
+    plcrash_nasync_image_list_load_deferred(&shared_image_list);
+
+    plcrash_resource_events_t *events = malloc(sizeof(*events));
+    if (events == NULL) {
+        plcrash_populate_posix_error(outError, ENOMEM, @"Could not allocate the resource event buffer");
+        return NO;
+    }
+
+    if (plcrash_nasync_resource_events_init(events, &shared_image_list, PLCRASH_RESOURCE_EVENTS_CAPACITY, PLCRASH_RESOURCE_EVENTS_DEFAULT_MAX_DEPTH, (uint32_t) maximumRate) != PLCRASH_ESUCCESS) {
+        plcrash_populate_posix_error(outError, ENOMEM, @"Could not allocate the resource event buffer");
+        free(events);
+        return NO;
+    }
+
+    resource_handler_context.events = events;
+    memset(&resource_handler_context.forward_table, 0, sizeof(resource_handler_context.forward_table));
+
+    NSError *osError;
+    PLCrashMachExceptionServer *server = [[[PLCrashMachExceptionServer alloc] initWithCallBack: resource_exception_callback
+                                                                                       context: &resource_handler_context
+                                                                                         error: &osError] autorelease];
+    if (server == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to instantiate the Mach exception server.", osError);
+        goto failed;
+    }
+
+    PLCrashMachExceptionPort *port = [server exceptionPortWithMask: EXC_MASK_RESOURCE error: &osError];
+    if (port == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to instantiate the Mach exception port.", osError);
+        goto failed;
+    }
+
+    /* The previous ports must be available for forwarding before the exception port is registered */
+    PLCrashMachExceptionPortSet *previousPorts = [PLCrashMachExceptionPort exceptionPortsForTask: mach_task_self() mask: EXC_MASK_RESOURCE error: &osError];
+    if (previousPorts == nil) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to fetch the task's mach exception ports.", osError);
+        goto failed;
+    }
+    resource_handler_context.forward_table = [previousPorts forwardTable];
+    OSMemoryBarrier();
+
+    if (![port registerForTask: mach_task_self() previousPortSet: NULL error: &osError]) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to set the task's mach exception ports.", osError);
+        goto failed;
+    }
+
+    _resourceServer = [server retain];
+    _previousResourcePorts = [previousPorts retain];
+    _resourceEvents = events;
+    return YES;
+
+failed:
+    resource_handler_context.events = NULL;
+    plcrash_nasync_resource_events_free(events);
+    free(events);
+    return NO;
+#else
+    plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Resource exceptions are not supported on this platform.", nil);
+    return NO;
+#endif
+}
+
+/**
+ * Stop recording resource exceptions, and restore any previously registered EXC_RESOURCE exception ports.
+ * Events that have not been drained are discarded.
+ */
+- (void) stopResourceEventMonitoring {
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS && defined(EXC_MASK_RESOURCE)
+    if (_resourceEvents == NULL)
+        return;
+
+    NSError *osError;
+    for (PLCrashMachExceptionPort *port in _previousResourcePorts) {
+        if (![port registerForTask: mach_task_self() previousPortSet: NULL error: &osError])
+            NSDEBUG(@"Failed to restore the task's mach exception ports: %@", osError);
+    }
+
+    /* Releasing the server stops its thread; no further events will be recorded */
+    [_resourceServer release];
+    _resourceServer = nil;
+
+    [_previousResourcePorts release];
+    _previousResourcePorts = nil;
+
+    resource_handler_context.events = NULL;
+    plcrash_nasync_resource_events_free(_resourceEvents);
+    free(_resourceEvents);
+    _resourceEvents = NULL;
+#endif
+}
+
+/**
+ * Return all resource events recorded since the previous call, aggregated by exception type, resource type and
+ * stack. Returns an empty array if resource event monitoring has not been started.
+ *
+ * @return An array of PLCrashResourceEvent instances.
  */
-- (NSData *) generateLiveReportAndReturnError: (NSError **) outError {
-    return [self generateLiveReportWithThread: pl_mach_thread_self() error: outError];
+- (NSArray *) drainResourceEvents {
+    if (_resourceEvents == NULL)
+        return [NSArray array];
+
+    NSMutableDictionary *aggregated = [NSMutableDictionary dictionary];
+    plcrash_nasync_resource_events_drain(_resourceEvents, resource_event_aggregate, aggregated);
+
+    /* Order the events by their first occurrence */
+    return [[aggregated allValues] sortedArrayUsingComparator: ^NSComparisonResult(id lhs, id rhs) {
+        return [[lhs firstDate] compare: [rhs firstDate]];
+    }];
 }
 
+/**
+ * Return the number of resource events that were not recorded due to rate limiting, or that were overwritten
+ * before they could be drained.
+ */
+- (NSUInteger) droppedResourceEventCount {
+    if (_resourceEvents == NULL)
+        return 0;
+
+    return (NSUInteger) plcrash_resource_events_dropped_count(_resourceEvents);
+}
 
 /**
  * Set the callbacks that will be executed by the receiver after a crash has occured and been recorded by PLCrashReporter.
@@ -911,8 +2274,8 @@ cleanup:
     if ((self = [super init]) == nil)
         return nil;
 
-    /* Save the configuration */
-    _config = [configuration retain];
+    /* Save the configuration; a mutable configuration may be modified after it is supplied */
+    _config = [configuration copy];
     _applicationIdentifier = [applicationIdentifier retain];
     _applicationVersion = [applicationVersion retain];
     
@@ -922,6 +2285,12 @@ cleanup:
     NSArray *paths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
     NSString *cacheDir = [paths objectAtIndex: 0];
     _crashReportDirectory = [[[cacheDir stringByAppendingPathComponent: PLCRASH_CACHE_DIR] stringByAppendingPathComponent: appIdPath] retain];
+
+    _reportStore = [[PLCrashReportStore alloc] initWithDirectory: [_crashReportDirectory stringByAppendingPathComponent: PLCRASH_QUEUED_DIR]
+                                                       indexPath: [_crashReportDirectory stringByAppendingPathComponent: PLCRASH_QUEUED_INDEX]
+                                                        maxCount: _config.maxPendingReportCount
+                                                        maxBytes: _config.maxPendingReportBytes
+                                                          maxAge: _config.maxPendingReportAge];
     
     return self;
 }
@@ -966,7 +2335,11 @@ cleanup:
 /**
  * Create, register, and return a Mach exception server.
  *
+ * The server is registered with the EXCEPTION_STATE_IDENTITY behavior, and the crashed thread's state is provided to
+ * @a callback with the exception message.
+ *
  * @param previousPortSet[out] The previously registered Mach exception ports.
+ * @param callback The callback to be issued upon receipt of an exception.
  * @param context The context to be provided to the callback.
  * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
  * will contain an error in the PLCrashReporterErrorDomain indicating why the Crash Reporter
@@ -974,7 +2347,7 @@ cleanup:
  * specify nil for this parameter, and no error information will be provided.
  */
 - (PLCrashMachExceptionServer *) enableMachExceptionServerWithPreviousPortSet: (PLCrashMachExceptionPortSet **) previousPortSet
-                                                                     callback: (PLCrashMachExceptionHandlerCallback) callback
+                                                                     callback: (PLCrashMachExceptionStateHandlerCallback) callback
                                                                       context: (void *) context
                                                                         error: (NSError **) outError
 {
@@ -1011,7 +2384,7 @@ cleanup:
     
     /* Create the server */
     NSError *osError;
-    PLCrashMachExceptionServer *server = [[[PLCrashMachExceptionServer alloc] initWithCallBack: callback context: context error: &osError] autorelease];
+    PLCrashMachExceptionServer *server = [[[PLCrashMachExceptionServer alloc] initWithStateCallBack: callback context: context error: &osError] autorelease];
     if (server == nil) {
         plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to instantiate the Mach exception server.", osError);
         return nil;
@@ -1043,9 +2416,15 @@ cleanup:
     [_previousMachPorts release];
 #endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
 
+    [self stopSampling];
+    [self stopResourceEventMonitoring];
+    [self stopHangMonitor];
+
     [_crashReportDirectory release];
     [_applicationIdentifier release];
     [_applicationVersion release];
+    [_previousBreadcrumbs release];
+    [_reportStore release];
 
     [super dealloc];
 }
@@ -1070,6 +2449,32 @@ cleanup:
     return result;
 }
 
+/**
+ * Map the configured per-image-class symbolication strategies to their plcrash_async_symbol_strategy_t
+ * representations.
+ *
+ * @param strategies An array of PLCRASH_ASYNC_IMAGE_CLASS_COUNT elements, indexed by plcrash_async_image_class_t, to
+ * be populated.
+ */
+- (void) mapToAsyncImageSymbolicationStrategies: (plcrash_async_symbol_strategy_t *) strategies {
+    strategies[PLCRASH_ASYNC_IMAGE_CLASS_MAIN_EXECUTABLE] = [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy];
+    strategies[PLCRASH_ASYNC_IMAGE_CLASS_APPLICATION] = [self mapToAsyncSymbolicationStrategy: _config.applicationImageSymbolicationStrategy];
+    strategies[PLCRASH_ASYNC_IMAGE_CLASS_SYSTEM] = [self mapToAsyncSymbolicationStrategy: _config.systemImageSymbolicationStrategy];
+}
+
+/**
+ * Apply the configured per-image-class symbolication strategies to @a writer.
+ *
+ * @param writer The writer to configure.
+ */
+- (void) configureImageSymbolicationForWriter: (plcrash_log_writer_t *) writer {
+    plcrash_async_symbol_strategy_t strategies[PLCRASH_ASYNC_IMAGE_CLASS_COUNT];
+
+    [self mapToAsyncImageSymbolicationStrategies: strategies];
+    for (size_t i = 0; i < PLCRASH_ASYNC_IMAGE_CLASS_COUNT; i++)
+        plcrash_log_writer_set_image_symbol_strategy(writer, (plcrash_async_image_class_t) i, strategies[i]);
+}
+
 /**
  * Validate (and create if necessary) the crash reporter directory structure.
  */
@@ -1119,6 +2524,517 @@ cleanup:
     return [[self crashReportDirectory] stringByAppendingPathComponent: PLCRASH_LIVE_CRASHREPORT];
 }
 
+/**
+ * Return the path to the most recent hang report (which may not yet, or ever, exist).
+ */
+- (NSString *) hangReportPath {
+    return [[self crashReportDirectory] stringByAppendingPathExtension: PLCRASH_HANG_REPORT_EXT];
+}
+
+/**
+ * Return the path to the persisted duplicate crash filter table (which may not yet, or ever, exist).
+ */
+- (NSString *) duplicateFilterPath {
+    return [[self crashReportDirectory] stringByAppendingPathExtension: PLCRASH_DUPLICATE_FILTER_EXT];
+}
+
+/**
+ * Return the path to the image manifest directory (which may not yet, or ever, exist).
+ */
+- (NSString *) imageManifestDirectory {
+    return [[self crashReportDirectory] stringByAppendingPathExtension: PLCRASH_IMAGE_MANIFEST_DIR_EXT];
+}
+
+/**
+ * Return the path to the persisted breadcrumb ring (which may not yet, or ever, exist).
+ */
+- (NSString *) breadcrumbsPath {
+    return [[self crashReportDirectory] stringByAppendingPathExtension: PLCRASH_BREADCRUMBS_EXT];
+}
+
+/**
+ * Return the path to the preallocated crash report file (which may not yet, or ever, exist).
+ */
+- (NSString *) preallocatedReportPath {
+    return [[self crashReportDirectory] stringByAppendingPathExtension: PLCRASH_PREALLOCATED_REPORT_EXT];
+}
+
+/**
+ * Create the preallocated crash report file, allocating @a size bytes of storage, and configure the signal handler
+ * context to write the crash report to it. Storage allocation is an optimization; if it is not supported by the
+ * filesystem, the open file is still used.
+ *
+ * @param size The number of bytes of storage to allocate.
+ */
+- (void) preallocateReportFile: (off_t) size {
+    const char *path = [[self preallocatedReportPath] fileSystemRepresentation];
+    int fd = open(path, O_RDWR|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0) {
+        NSLog(@"Could not create the preallocated crash report file; the report file will be created at crash time: %s", strerror(errno));
+        return;
+    }
+
+#ifdef F_PREALLOCATE
+    /* Prefer contiguous storage, falling back on any available storage */
+    fstore_t store = {
+        .fst_flags = F_ALLOCATECONTIG|F_ALLOCATEALL,
+        .fst_posmode = F_PEOFPOSMODE,
+        .fst_offset = 0,
+        .fst_length = size
+    };
+    if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+        store.fst_flags = F_ALLOCATEALL;
+        if (fcntl(fd, F_PREALLOCATE, &store) == -1)
+            NSDEBUG(@"Could not preallocate crash report storage: %s", strerror(errno));
+    }
+#endif
+
+    signal_handler_context.prealloc_fd = fd;
+    signal_handler_context.prealloc_path = strdup(path); // NOTE: would leak if this were not a singleton struct
+}
+
+/**
+ * Map the preallocated crash report file into memory, and configure the signal handler context to write the crash
+ * report directly into the mapping. If the file can not be mapped, the report will be written to the file.
+ *
+ * @param size The size of the mapping, in bytes.
+ */
+- (void) mapPreallocatedReportFile: (size_t) size {
+    int fd = signal_handler_context.prealloc_fd;
+
+    if (size <= sizeof(plcrash_mapped_report_header_t)) {
+        NSLog(@"The preallocated crash report file is too small to be mapped; the report will be written to the file");
+        return;
+    }
+
+    /* The file must be extended to cover the mapping; the preallocated storage is not reflected in its length */
+    if (ftruncate(fd, (off_t) size) != 0) {
+        NSLog(@"Could not size the mapped crash report file; the report will be written to the file: %s", strerror(errno));
+        return;
+    }
+
+    void *mapping = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        NSLog(@"Could not map the crash report file; the report will be written to the file: %s", strerror(errno));
+        ftruncate(fd, 0);
+        return;
+    }
+
+    plcrash_mapped_report_header_t *header = mapping;
+    memcpy(header->magic, PLCRASH_MAPPED_REPORT_MAGIC, sizeof(header->magic));
+    header->length = 0;
+
+    signal_handler_context.mapped_report_size = size;
+    signal_handler_context.mapped_report = header;
+}
+
+/**
+ * Claim the process-wide crash reporter registration.
+ *
+ * @param outError A pointer to an NSError object variable. If the registration has already been claimed by another
+ * instance, this will contain a PLCrashReporterErrorResourceBusy error.
+ *
+ * @return Returns YES on success, or NO if another reporter has already been enabled.
+ */
+- (BOOL) claimCrashReporterAndReturnError: (NSError **) outError {
+    /* Prevent enabling more than one crash reporter, process wide. We can not support multiple chained reporters
+     * due to the use of NSUncaughtExceptionHandler (it doesn't support chaining or assocation of context with the callbacks), as
+     * well as our legacy approach of deregistering any signal handlers upon the first signal. Once PLCrashUncaughtExceptionHandler is
+     * implemented, and we support double-fault handling without resetting the signal handlers, we can support chaining of multiple
+     * crash reporters. */
+    {
+        static BOOL enforceOne = NO;
+        pthread_mutex_t enforceOneLock = PTHREAD_MUTEX_INITIALIZER;
+        pthread_mutex_lock(&enforceOneLock); {
+            if (enforceOne) {
+                pthread_mutex_unlock(&enforceOneLock);
+                plcrash_populate_error(outError, PLCrashReporterErrorResourceBusy, @"A PLCrashReporter instance has already been enabled", nil);
+                return NO;
+            }
+            enforceOne = YES;
+        } pthread_mutex_unlock(&enforceOneLock);
+    }
+
+    /* Check for programmer error */
+    if (_enabled)
+        [NSException raise: PLCrashReporterException format: @"The crash reporter has alread been enabled"];
+
+    return YES;
+}
+
+/**
+ * Create the crash report directory, and prepare all state required by the crash handler: the report writer,
+ * preallocated output, image indexes, and image manifest. If crash path warm-up is enabled, a report is then written
+ * and discarded.
+ *
+ * @warning This must complete prior to the signal handler context being marked ready.
+ */
+- (BOOL) prepareCrashHandlerAndReturnError: (NSError **) outError {
+    /* Create the directory tree */
+    if (![self populateCrashReportDirectoryAndReturnError: outError])
+        return NO;
+
+    /* Move any report written by a previous process into the pending report store, prior to the live report path
+     * being reused */
+    [self collectPendingReports];
+
+    /* Set up the signal handler context. Any partially written report left by a previous process is discarded. */
+    signal_handler_context.path = strdup([[self crashReportPath] UTF8String]); // NOTE: would leak if this were not a singleton struct
+    signal_handler_context.tmp_path = strdup([[[self crashReportPath] stringByAppendingPathExtension: PLCRASH_PARTIAL_REPORT_EXT] UTF8String]); // NOTE: would leak if this were not a singleton struct
+    unlink(signal_handler_context.tmp_path);
+    assert(_applicationIdentifier != nil);
+    assert(_applicationVersion != nil);
+    plcrash_log_writer_init(&signal_handler_context.writer, _applicationIdentifier, _applicationVersion, [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy], false);
+    [self configureImageSymbolicationForWriter: &signal_handler_context.writer];
+    if (shared_breadcrumbs.header != NULL)
+        plcrash_log_writer_set_breadcrumbs(&signal_handler_context.writer, &shared_breadcrumbs);
+    plcrash_log_writer_set_custom_data(&signal_handler_context.writer, &shared_custom_data);
+    plcrash_log_writer_set_image_manifest(&signal_handler_context.writer, image_manifest_state.current);
+
+    /* Stream the report, so that a partial report is recoverable if we're terminated while writing the report */
+    uint32_t flush_points = PLCRASH_LOG_WRITER_FLUSH_HEADER|PLCRASH_LOG_WRITER_FLUSH_CRASHED_THREAD;
+    if (_config.checkpointSyncEnabled)
+        flush_points |= PLCRASH_LOG_WRITER_FLUSH_SYNC;
+    plcrash_log_writer_set_streaming(&signal_handler_context.writer, true, flush_points);
+    plcrash_log_writer_set_fast_capture(&signal_handler_context.writer, _config.threadCaptureMode == PLCrashReporterThreadCaptureModeFramePointer);
+    if (_config.reportFormat >= PLCrashReporterReportFormatSymbolTable) {
+        if (plcrash_log_writer_enable_symbol_table(&signal_handler_context.writer) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not allocate the crash report symbol table; symbol names will be written inline");
+    }
+    if (_config.reportFormat >= PLCrashReporterReportFormatPackedRegisters)
+        plcrash_log_writer_enable_packed_registers(&signal_handler_context.writer);
+    if (_config.reportFormat >= PLCrashReporterReportFormatPackedFrames)
+        plcrash_log_writer_enable_packed_frames(&signal_handler_context.writer);
+    if (_config.reportFormat >= PLCrashReporterReportFormatDeduplicatedThreads) {
+        if (plcrash_log_writer_enable_thread_deduplication(&signal_handler_context.writer) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not allocate the crash report stack table; all threads will be written in full");
+    }
+    if (_config.instrumentationEnabled)
+        plcrash_log_writer_enable_instrumentation(&signal_handler_context.writer);
+    if (_config.stackMemoryCaptureSize > 0) {
+        if (plcrash_log_writer_enable_stack_memory(&signal_handler_context.writer, _config.stackMemoryCaptureSize, (uint32_t) _config.stackMemoryThreadCount) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not allocate the stack memory capture buffer; stack memory will not be captured");
+    }
+    if (_config.registerMemoryCaptureSize > 0) {
+        if (plcrash_log_writer_enable_register_memory(&signal_handler_context.writer, _config.registerMemoryCaptureSize) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not allocate the register memory capture buffer; register memory will not be captured");
+    }
+    if (_config.vmRegionSummaryLimit > 0) {
+        uint32_t limit = (uint32_t) MIN(_config.vmRegionSummaryLimit, UINT32_MAX);
+        if (plcrash_log_writer_enable_vm_region_summary(&signal_handler_context.writer, limit, PLCRASH_LOG_WRITER_VM_REGION_SUMMARY_DEFAULT_BUDGET_NS) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not allocate the VM region table; the VM region summary will not be written");
+    }
+    if (_config.threadRegistryCapacity > 0) {
+        plcrash_async_thread_registry_t *registry;
+        uint32_t capacity = (uint32_t) MIN(_config.threadRegistryCapacity, UINT32_MAX);
+        if (plcrash_nasync_thread_registry_install(capacity, &registry) != PLCRASH_ESUCCESS || plcrash_log_writer_set_thread_registry(&signal_handler_context.writer, registry) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not install the thread registry; threads will be enumerated at crash time");
+    }
+    if (plcrash_log_writer_enable_symbol_pc_cache(&signal_handler_context.writer, PLCRASH_LOG_WRITER_SYMBOL_PC_CACHE_DEFAULT_COUNT) != PLCRASH_ESUCCESS)
+        NSLog(@"Could not allocate the symbol result cache; repeated frames will be symbolicated individually");
+    if (plcrash_log_writer_enable_region_map(&signal_handler_context.writer) != PLCRASH_ESUCCESS)
+        NSLog(@"Could not allocate the region map; invalid stack pointers will be read from the kernel");
+    plcrash_log_writer_enable_length_backpatching(&signal_handler_context.writer);
+    plcrash_log_writer_set_prioritized_output(&signal_handler_context.writer, _config.prioritizedOutputEnabled);
+    plcrash_log_writer_set_max_threads(&signal_handler_context.writer, (uint32_t) MIN(_config.maxThreadCount, UINT32_MAX));
+    if (_config.maxThreadFrameCount > 0)
+        plcrash_log_writer_set_max_thread_frames(&signal_handler_context.writer, (uint32_t) MIN(_config.maxThreadFrameCount, UINT32_MAX));
+    if (!_config.fullImageListEnabled) {
+        if (plcrash_log_writer_enable_referenced_images(&signal_handler_context.writer) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not allocate the referenced image set; all images will be written");
+    }
+    if (_config.reportTimeBudget > 0) {
+        if (plcrash_log_writer_set_deadline(&signal_handler_context.writer, (uint64_t) (_config.reportTimeBudget * NSEC_PER_SEC)) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not fully configure the report time budget; all images may be written once it expires");
+    }
+
+    /* Preallocate the report output buffer; allocation is not permitted at crash time. If this fails, we fall back
+     * on the (much smaller) default plcrash_async_file_t buffer. */
+    signal_handler_context.output_buffer = malloc(PLCRASH_REPORT_BUFFER_SIZE); // NOTE: would leak if this were not a singleton struct
+    signal_handler_context.output_buffer_size = signal_handler_context.output_buffer != NULL ? PLCRASH_REPORT_BUFFER_SIZE : 0;
+
+    /* Open and preallocate the output file, so that the crash handler need not create the file or allocate its
+     * storage. If this fails, the file is created at crash time. */
+    signal_handler_context.prealloc_path = NULL;
+    signal_handler_context.mapped_report = NULL;
+    if (_config.reportPreallocationSize > 0) {
+        [self preallocateReportFile: (off_t) MIN(_config.reportPreallocationSize, (NSUInteger) INT64_MAX)];
+        if (_config.mappedReportOutputEnabled && signal_handler_context.prealloc_path != NULL)
+            [self mapPreallocatedReportFile: _config.reportPreallocationSize];
+    }
+
+    /* Likewise, preallocate all compression state. If this fails, reports are written uncompressed. */
+    signal_handler_context.compressor = NULL;
+    if (_config.reportCompression == PLCrashReporterReportCompressionLZ4) {
+        signal_handler_context.compressor = malloc(sizeof(plcrash_async_compressor_t)); // NOTE: would leak if this were not a singleton struct
+        if (signal_handler_context.compressor == NULL)
+            NSLog(@"Could not allocate the crash report compressor; reports will be written uncompressed");
+    }
+
+    /* Load the persisted duplicate crash signatures */
+    if (_config.duplicateSuppressionInterval > 0) {
+        const char *filterPath = [[self duplicateFilterPath] fileSystemRepresentation];
+        if (plcrash_nasync_duplicate_filter_init(&signal_handler_context.duplicate_filter, filterPath, (int64_t) _config.duplicateSuppressionInterval) != PLCRASH_ESUCCESS)
+            NSLog(@"Could not load the duplicate crash filter; all crashes will be fully reported");
+    }
+
+    /* If enabled, build the indexes enabled below on a background thread, in image priority order, rather than blocking
+     * startup on indexing every loaded image. The crash path uses each index as soon as it has been published. */
+    if (_config.backgroundImageIndexingEnabled)
+        plcrash_nasync_image_list_set_background_indexing(&shared_image_list, true, PLCRASH_IMAGE_INDEX_MEMORY_LIMIT);
+
+    /* Index the symbol tables now, rather than performing a linear symbol table search at crash time */
+    PLCrashReporterSymbolicationStrategy anyStrategy = _config.symbolicationStrategy | _config.applicationImageSymbolicationStrategy | _config.systemImageSymbolicationStrategy;
+    if (anyStrategy & PLCrashReporterSymbolicationStrategySymbolTable)
+        plcrash_nasync_image_list_enable_symbol_index(&shared_image_list);
+
+    /* Likewise, index the Objective-C methods rather than parsing all class data at crash time. The shared cache's
+     * Objective-C optimization data must be applied first, allowing the system images' direct selector method lists
+     * to be indexed. */
+    if (anyStrategy & PLCrashReporterSymbolicationStrategyObjC) {
+        pl_vm_address_t cache_base = shared_cache_base_address();
+        if (cache_base != 0) {
+            plcrash_error_t err = plcrash_nasync_image_list_enable_objc_shared_cache(&shared_image_list, cache_base);
+            if (err != PLCRASH_ESUCCESS && err != PLCRASH_ENOTSUP)
+                PLCF_DEBUG("Could not read the shared cache's Objective-C optimization data: %d", err);
+        }
+
+        plcrash_nasync_image_list_enable_objc_index(&shared_image_list);
+    }
+
+    /* Index the images' DWARF FDEs, rather than walking __eh_frame linearly when compact unwind data does not
+     * reference a FDE */
+    plcrash_nasync_image_list_enable_fde_index(&shared_image_list);
+
+    /* Copy and validate each image's compact unwind first-level index, rather than searching the target's index at
+     * crash time */
+    plcrash_nasync_image_list_enable_cfe_index(&shared_image_list);
+
+    /* Pre-encode the binary images, allowing the binary image section to be written without re-reading each image */
+    plcrash_nasync_image_list_enable_image_encoding(&shared_image_list, plcrash_log_writer_encode_binary_image);
+
+    /* Release each subsequently parsed image's mappings once its indexes and encoding have been built */
+    if (_config.compactImageListEnabled)
+        plcrash_nasync_image_list_set_compact(&shared_image_list, true);
+
+    /* Generate the launch-time image manifest in the background; subsequent image loads and unloads will generate
+     * updated manifests. */
+    if (_config.imageManifestEnabled) {
+        NSError *manifestError = nil;
+        if ([[NSFileManager defaultManager] createDirectoryAtPath: [self imageManifestDirectory] withIntermediateDirectories: YES attributes: nil error: &manifestError]) {
+            pthread_mutex_lock(&image_manifest_state.lock); {
+                image_manifest_state.directory = strdup([[self imageManifestDirectory] fileSystemRepresentation]); // NOTE: would leak if this were not a singleton struct
+            } pthread_mutex_unlock(&image_manifest_state.lock);
+
+            image_manifest_request_update();
+        } else {
+            NSLog(@"Could not create the image manifest directory; all images will be written to each report: %@", manifestError);
+        }
+    }
+
+    /* Walk the calling thread prior to the crash handler being marked ready, as it would otherwise share the writer */
+    if (_config.crashPathWarmup != PLCrashReporterCrashPathWarmupNone)
+        [self warmCrashPath];
+
+    return YES;
+}
+
+/**
+ * Configure the alternate signal stack and register the configured BSD signal handlers. If Mach exception handling
+ * is configured, only the SIGABRT handler is registered; see PLCrashReporter::enableMachExceptionHandlingAndReturnError:.
+ */
+- (BOOL) registerSignalHandlersAndReturnError: (NSError **) outError {
+    /* Configure the alternate signal stack; this must precede the first handler registration */
+    [[PLCrashSignalHandler sharedHandler] setSignalStackSize: _config.signalStackSize];
+
+    /* Enable the signal handler */
+    switch (_config.signalHandlerType) {
+        case PLCrashReporterSignalHandlerTypeBSD:
+            for (size_t i = 0; i < monitored_signals_count; i++) {
+                if (![[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: monitored_signals[i] callback: &signal_handler_callback context: &signal_handler_context error: outError])
+                    return NO;
+            }
+            break;
+
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS
+        case PLCrashReporterSignalHandlerTypeMach:
+            /* We still need to use signal handlers to catch SIGABRT in-process. The kernel sends an EXC_CRASH mach exception
+             * to denote SIGABRT termination. In that case, catching the Mach exception in-process leads to process deadlock
+             * in an uninterruptable wait. Thus, we fall back on BSD signal handlers for SIGABRT, and do not register for
+             * EXC_CRASH. */
+            if (![[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: SIGABRT callback: &signal_handler_callback context: &signal_handler_context error: outError])
+                return NO;
+            break;
+#endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
+    }
+
+    return YES;
+}
+
+/**
+ * If Mach exception handling is configured, start the Mach exception server. Otherwise, this is a no-op.
+ *
+ * @warning The crash handler state must have been prepared via PLCrashReporter::prepareCrashHandlerAndReturnError:.
+ */
+- (BOOL) enableMachExceptionHandlingAndReturnError: (NSError **) outError {
+#if PLCRASH_FEATURE_MACH_EXCEPTIONS
+    if (_config.signalHandlerType != PLCrashReporterSignalHandlerTypeMach)
+        return YES;
+
+    /* Enable the server. */
+    _machServer = [self enableMachExceptionServerWithPreviousPortSet: &_previousMachPorts
+                                                            callback: &mach_exception_callback
+                                                             context: &signal_handler_context
+                                                               error: outError];
+    if (_machServer == nil)
+        return NO;
+
+    /* Unwind the suspended threads in parallel. This is an optimization; on failure, threads will be unwound serially. */
+    plcrash_error_t err = plcrash_log_writer_enable_parallel_capture(&signal_handler_context.writer, PLCRASH_MACH_CAPTURE_WORKERS);
+    if (err != PLCRASH_ESUCCESS)
+        NSDEBUG(@"Could not start the parallel capture workers: %d", err);
+    
+    /* Acquire references to the autoreleased values */
+    [_machServer retain];
+    [_previousMachPorts retain];
+    
+    /*
+     * MEMORY WARNING: To ensure that our instance survives for the lifetime of the callback registration,
+     * we retain it here. This is necessary to ensure that the Mach exception server instance and previous port set
+     * survive for the lifetime of the callback. Since there's currently no support for *deregistering* a crash reporter,
+     * this simply results in the reporter living forever.
+     */
+    [self retain];
+    
+    /*
+     * Save the previous ports. There's a race condition here, in that an exception that is delivered before (or during)
+     * setting the previous port values will see a fully and/or partially configured port set. This could be an issue
+     * when interoperating with managed runtimes, where NULL dereferences may trigger exception handling
+     * in a common runtime case.
+     *
+     * TODO: Investigate use of (async-safe) locking to close the window in which an exception would not be safely forwarded.
+     * This issue also exists (and is noted with a TODO) in PLCrashSignalHandler.
+     */
+    signal_handler_context.forward_table = [_previousMachPorts forwardTable];
+#endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
+
+    return YES;
+}
+
+/**
+ * Register the uncaught exception handler, as configured by @a handling.
+ */
+- (void) registerExceptionHandler: (PLExceptionHandling) handling {
+    /* Set the uncaught exception handler */
+    if (handling == PLExceptionHandlingUncaughtOnly)
+        NSSetUncaughtExceptionHandler(&uncaught_exception_handler);
+    else if (handling == PLExceptionHandlingAll) {
+#if TARGET_OS_MAC && !TARGET_IPHONE_SIMULATOR && !TARGET_OS_IPHONE
+        [[NSExceptionHandler defaultExceptionHandler] setExceptionHandlingMask:
+         [[NSExceptionHandler defaultExceptionHandler] exceptionHandlingMask] |
+         NSHandleUncaughtExceptionMask |
+         NSHandleUncaughtSystemExceptionMask |
+         NSHandleUncaughtRuntimeErrorMask |
+         NSHandleTopLevelExceptionMask | NSHandleOtherExceptionMask];
+        [[NSExceptionHandler defaultExceptionHandler] setDelegate:self];
+#else
+        [NSException raise:PLCrashReporterException format:@"Can only use PLExceptionHandlingAll with OS X builds."];
+#endif
+    }
+}
+
+/**
+ * If a report was written to the mapped crash report file by a previous process, move it into the pending report
+ * store.
+ */
+- (void) recoverMappedReport {
+    NSString *path = [self preallocatedReportPath];
+    NSData *data = [NSData dataWithContentsOfFile: path options: NSDataReadingMappedIfSafe error: NULL];
+    if (data == nil || [data length] < sizeof(plcrash_mapped_report_header_t))
+        return;
+
+    /* Verify that this is a mapped report file containing a completed report */
+    plcrash_mapped_report_header_t header;
+    memcpy(&header, [data bytes], sizeof(header));
+    if (memcmp(header.magic, PLCRASH_MAPPED_REPORT_MAGIC, sizeof(header.magic)) != 0 || header.length == 0)
+        return;
+
+    if (header.length > [data length] - sizeof(header)) {
+        NSLog(@"Discarding truncated mapped crash report");
+        [[NSFileManager defaultManager] removeItemAtPath: path error: NULL];
+        return;
+    }
+
+    NSData *report = [data subdataWithRange: NSMakeRange(sizeof(header), (NSUInteger) header.length)];
+    NSError *error = nil;
+    if ([_reportStore publishReportData: report error: &error] == nil) {
+        NSLog(@"Could not move the mapped crash report into place: %@", error);
+        return;
+    }
+
+    [[NSFileManager defaultManager] removeItemAtPath: path error: NULL];
+}
+
+/**
+ * Move any completed report written by this or a previous process into the pending report store, where it can not be
+ * overwritten by a later crash, and where the configured pending report budgets are enforced.
+ */
+- (void) collectPendingReports {
+    [self recoverMappedReport];
+
+    NSString *path = [self crashReportPath];
+    struct stat sb;
+    if (stat([path fileSystemRepresentation], &sb) != 0)
+        return;
+
+    NSError *error = nil;
+    if ([_reportStore publishReportAtPath: path error: &error] == nil)
+        NSLog(@"Could not move the crash report into the pending report store: %@", error);
+}
+
+/**
+ * Unwind the calling thread and look up the symbols of its frames using the signal handler's writer and preallocated
+ * buffers, discarding the result. This faults in the unwinder and symbolication code, along with the image, unwind,
+ * and symbol data that they read, so that a crash handler running under memory pressure is less likely to stall on
+ * page-ins. No report is written, and no other threads are suspended.
+ *
+ * @warning This must be called prior to the crash handlers being marked ready, as they would otherwise share the
+ * writer.
+ */
+- (void) warmCrashPath {
+    plcrash_error_t err = plcrash_async_thread_state_current(crash_path_warmup_cb, &signal_handler_context);
+    if (err != PLCRASH_ESUCCESS)
+        NSDEBUG(@"Failed to warm the crash path: %s", plcrash_async_strerror(err));
+}
+
+/**
+ * Fault in the alternate signal stack and all buffers preallocated for the crash handler, and optionally wire
+ * them into memory.
+ *
+ * @param wire If YES, the memory is additionally wired via mlock(). Memory that can not be wired is still faulted in.
+ */
+- (void) prefaultCrashPathAndWire: (BOOL) wire {
+    BOOL wired = YES;
+
+    if (!plcrash_signal_handler_prefault_stack(wire))
+        wired = NO;
+
+    if (plcrash_log_writer_prefault(&signal_handler_context.writer, wire) != PLCRASH_ESUCCESS)
+        wired = NO;
+
+    if (signal_handler_context.output_buffer != NULL && plcrash_nasync_prefault(signal_handler_context.output_buffer, signal_handler_context.output_buffer_size, wire) != PLCRASH_ESUCCESS)
+        wired = NO;
+
+    if (signal_handler_context.compressor != NULL && plcrash_nasync_prefault(signal_handler_context.compressor, sizeof(*signal_handler_context.compressor), wire) != PLCRASH_ESUCCESS)
+        wired = NO;
+
+    if (signal_handler_context.mapped_report != NULL && plcrash_nasync_prefault(signal_handler_context.mapped_report, signal_handler_context.mapped_report_size, wire) != PLCRASH_ESUCCESS)
+        wired = NO;
+
+    if (wire && !wired)
+        NSLog(@"Could not wire all crash handler memory; the remaining memory has been faulted in");
+}
+
 
 #if TARGET_OS_MAC && !TARGET_OS_IPHONE && !TARGET_IPHONE_SIMULATOR
 /**
@@ -1132,16 +3048,23 @@ cleanup:
     CFRelease(UUIDObject);
     NSString *filename = [[NSString alloc] initWithFormat:@"%@.plcrash", UUID];
     [UUID release];
-    context.path = strdup([[[self crashReportDirectory] stringByAppendingPathComponent: filename] UTF8String]);
+    NSString *path = [[self queuedCrashReportDirectory] stringByAppendingPathComponent: filename];
+    context.path = strdup([path UTF8String]);
+    context.tmp_path = strdup([[path stringByAppendingPathExtension: PLCRASH_PARTIAL_REPORT_EXT] UTF8String]);
     [filename release];
 
     plcrash_log_writer_init(&context.writer, _applicationIdentifier, _applicationVersion, [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy], false);
+    [self configureImageSymbolicationForWriter: &context.writer];
+    if (shared_breadcrumbs.header != NULL)
+        plcrash_log_writer_set_breadcrumbs(&context.writer, &shared_breadcrumbs);
+    plcrash_log_writer_set_custom_data(&context.writer, &shared_custom_data);
+    plcrash_log_writer_set_image_manifest(&context.writer, image_manifest_state.current);
     plcrash_log_writer_set_exception(&context.writer, exception);
 
     plcrash_async_file_t file;
 
-    /* Open the output file */
-    int fd = open(context.path, O_RDWR|O_CREAT|O_TRUNC, 0644);
+    /* Open the output file; the report is moved into the pending report store once complete */
+    int fd = open(context.tmp_path, O_RDWR|O_CREAT|O_TRUNC, 0644);
     if (fd < 0) {
         PLCF_DEBUG("Could not open the crashlog output file: %s", strerror(errno));
         return YES;
@@ -1150,13 +3073,17 @@ cleanup:
     /* Initialize the output context */
     plcrash_async_file_init(&file, fd, MAX_REPORT_BYTES);
 
+    /* Ensure that all images have been loaded */
+    plcrash_nasync_image_list_load_deferred(&shared_image_list);
+
     /* Write the crash log using the already-initialized writer */
     plcrash_log_writer_write(&context.writer, mach_thread_self(), &shared_image_list, &file, nil, nil);
     plcrash_log_writer_close(&context.writer);
 
     /* Finished */
-    plcrash_async_file_flush(&file);
-    plcrash_async_file_close(&file);
+    bool flushed = plcrash_async_file_flush(&file);
+    if (plcrash_async_file_close(&file) && flushed && rename(context.tmp_path, context.path) != 0)
+        PLCF_DEBUG("Failed to move the output file into place: %s", strerror(errno));
 
     return YES;
 }
@@ -139,13 +139,216 @@ typedef NS_OPTIONS(NSUInteger, PLCrashReporterSymbolicationStrategy) {
     PLCrashReporterSymbolicationStrategyAll = (PLCrashReporterSymbolicationStrategySymbolTable|PLCrashReporterSymbolicationStrategyObjC)
 };
 
-@interface PLCrashReporterConfig : NSObject {
-@private
+/**
+ * @ingroup enums
+ * Supported modes for capturing the stacks of non-crashed threads.
+ */
+typedef NS_ENUM(NSUInteger, PLCrashReporterThreadCaptureMode) {
+    /**
+     * Unwind all threads using all available unwind data (compact unwind, DWARF, and frame pointers), symbolicating
+     * each frame according to the configured symbolication strategy.
+     */
+    PLCrashReporterThreadCaptureModeFull = 0,
+
+    /**
+     * Unwind non-crashed threads using only frame pointers, recording frame PCs without symbolication. This is
+     * considerably faster than full unwinding, but frames of functions that do not maintain a frame pointer will
+     * be omitted or misattributed. The crashed thread is always unwound and symbolicated as per
+     * PLCrashReporterThreadCaptureModeFull.
+     *
+     * This mode is intended for frequent all-thread captures, such as for hang diagnostics, in which exact stacks
+     * for non-crashed threads are less important than capture latency.
+     */
+    PLCrashReporterThreadCaptureModeFramePointer = 1
+};
+
+/**
+ * @ingroup enums
+ * Supported crash report encodings.
+ */
+typedef NS_ENUM(NSUInteger, PLCrashReporterReportFormat) {
+    /**
+     * The version 1 report format, in which each symbol record includes the symbol's name. This format is supported
+     * by all releases of PLCrashReporter.
+     */
+    PLCrashReporterReportFormatV1 = 0,
+
+    /**
+     * The version 2 report format, in which each unique symbol name is written once to a per-report string table,
+     * and referenced by index. This substantially reduces the size of symbolicated reports, but the reports can not be
+     * decoded by releases of PLCrashReporter that predate this format.
+     */
+    PLCrashReporterReportFormatSymbolTable = 1,
+
+    /**
+     * The version 3 report format. In addition to the symbol table of PLCrashReporterReportFormatSymbolTable, each
+     * thread's registers are written as a packed array of values, and register names are derived from a single
+     * per-report register set identifier, rather than being written for every register of every thread. The reports
+     * can not be decoded by releases of PLCrashReporter that predate this format.
+     */
+    PLCrashReporterReportFormatPackedRegisters = 2,
+
+    /**
+     * The version 4 report format. In addition to the encodings of PLCrashReporterReportFormatPackedRegisters, the
+     * stack frames of threads written without symbols are encoded as a single packed, delta-encoded array of PC
+     * values, rather than as individual frame records. This substantially reduces the size of unsymbolicated reports,
+     * but the reports can not be decoded by releases of PLCrashReporter that predate this format.
+     */
+    PLCrashReporterReportFormatPackedFrames = 3,
+
+    /**
+     * The version 5 report format. In addition to the encodings of PLCrashReporterReportFormatPackedFrames, a thread
+     * whose stack frames are identical to those of a previously written thread (as is common for idle worker
+     * threads) references that thread, rather than including a copy of its frames. The frames are restored when the
+     * report is decoded, but the reports can not be decoded by releases of PLCrashReporter that predate this format.
+     */
+    PLCrashReporterReportFormatDeduplicatedThreads = 4,
+
+    /**
+     * The most compact report format supported by this release, currently
+     * PLCrashReporterReportFormatDeduplicatedThreads. Symbol names are written once to a string table, registers and
+     * unsymbolicated frames are packed, only the binary images referenced by the report are written, and duplicate
+     * thread stacks are written by reference.
+     *
+     * A later release may map this value to a newer format; use an explicit format if the reports must be decoded
+     * by a specific earlier release.
+     */
+    PLCrashReporterReportFormatCompact = PLCrashReporterReportFormatDeduplicatedThreads
+};
+
+/**
+ * @ingroup enums
+ * Supported crash report compression modes.
+ */
+typedef NS_ENUM(NSUInteger, PLCrashReporterReportCompression) {
+    /** Reports are written uncompressed. */
+    PLCrashReporterReportCompressionNone = 0,
+
+    /**
+     * Reports are compressed as they are written, using an async-safe block compressor whose state is allocated
+     * when the crash reporter is enabled. Compressed reports are transparently decompressed by PLCrashReport, but can
+     * not be decoded by releases of PLCrashReporter that predate this option.
+     */
+    PLCrashReporterReportCompressionLZ4 = 1
+};
+
+/**
+ * @ingroup enums
+ * Supported crash handling path preparation modes. See PLCrashReporterConfig::crashPathWarmup.
+ */
+typedef NS_ENUM(NSUInteger, PLCrashReporterCrashPathWarmup) {
+    /** The crash handling path is not prepared; its memory is faulted in on first use. */
+    PLCrashReporterCrashPathWarmupNone = 0,
+
+    /**
+     * When the crash reporter is enabled, the signal stack and all preallocated crash handling buffers are faulted in,
+     * and the current thread is unwound and symbolicated, faulting in the unwinder and symbolication code and the
+     * data they read. No report is written, and no other threads are suspended.
+     */
+    PLCrashReporterCrashPathWarmupPrefault = 1,
+
+    /**
+     * As with PLCrashReporterCrashPathWarmupPrefault, with the signal stack and preallocated buffers additionally
+     * wired into memory via mlock(). Wiring is subject to the process' RLIMIT_MEMLOCK limit; if a buffer can not be
+     * wired, it is merely faulted in.
+     */
+    PLCrashReporterCrashPathWarmupWire = 2
+};
+
+@interface PLCrashReporterConfig : NSObject <NSCopying, NSMutableCopying> {
+@protected
     /** The configured signal handler type. */
     PLCrashReporterSignalHandlerType _signalHandlerType;
     
     /** The configured symbolication strategy. */
     PLCrashReporterSymbolicationStrategy _symbolicationStrategy;
+
+    /** The configured thread capture mode. */
+    PLCrashReporterThreadCaptureMode _threadCaptureMode;
+
+    /** The configured report format. */
+    PLCrashReporterReportFormat _reportFormat;
+
+    /** The configured report compression. */
+    PLCrashReporterReportCompression _reportCompression;
+
+    /** The configured duplicate crash suppression interval. */
+    NSTimeInterval _duplicateSuppressionInterval;
+
+    /** If YES, report generation instrumentation is enabled. */
+    BOOL _instrumentationEnabled;
+
+    /** The configured alternate signal stack size, in bytes, or 0 to use the default size. */
+    NSUInteger _signalStackSize;
+
+    /** The number of stack memory bytes captured per thread, or 0 if disabled. */
+    NSUInteger _stackMemoryCaptureSize;
+
+    /** The number of additional threads for which stack memory is captured. */
+    NSUInteger _stackMemoryThreadCount;
+
+    /** The total number of register memory bytes captured, or 0 if disabled. */
+    NSUInteger _registerMemoryCaptureSize;
+
+    /** If YES, report sections are prioritized to fit the output limit. */
+    BOOL _prioritizedOutputEnabled;
+
+    /** If YES, all loaded binary images are written to each report. */
+    BOOL _fullImageListEnabled;
+
+    /** The configured symbolication strategy for non-system images other than the main executable. */
+    PLCrashReporterSymbolicationStrategy _applicationImageSymbolicationStrategy;
+
+    /** The configured symbolication strategy for system images. */
+    PLCrashReporterSymbolicationStrategy _systemImageSymbolicationStrategy;
+
+    /** The maximum number of threads written to each report, or 0 if unlimited. */
+    NSUInteger _maxThreadCount;
+
+    /** The maximum number of frames written per thread, or 0 to use the default limit. */
+    NSUInteger _maxThreadFrameCount;
+
+    /** The number of bytes of crash report storage preallocated when the reporter is enabled, or 0 if disabled. */
+    NSUInteger _reportPreallocationSize;
+
+    /** If YES, crash reports are written into a memory mapping of the preallocated report file. */
+    BOOL _mappedReportOutputEnabled;
+
+    /** If YES, the crash report is synchronized to storage at each streaming checkpoint. */
+    BOOL _checkpointSyncEnabled;
+
+    /** The preparation applied to the crash handling path when the reporter is enabled. */
+    PLCrashReporterCrashPathWarmup _crashPathWarmup;
+
+    /** The time budget for writing a crash report, in seconds, or 0 if unlimited. */
+    NSTimeInterval _reportTimeBudget;
+
+    /** If YES, live reports are symbolicated on a helper thread while their threads are unwound. */
+    BOOL _symbolicationPipelineEnabled;
+
+    /** If YES, binary image mappings are released once parsed, and re-mapped on demand at crash time. */
+    BOOL _compactImageListEnabled;
+
+    /** If YES, binary image indexes are built by a background thread rather than when each image is loaded. */
+    BOOL _backgroundImageIndexingEnabled;
+
+    /** If YES, binary image manifests are written, and reports reference the current manifest rather than listing all images. */
+    BOOL _imageManifestEnabled;
+
+    /** The maximum number of pending crash reports retained, or 0 if unlimited. */
+    NSUInteger _maxPendingReportCount;
+
+    /** The maximum total size of the pending crash reports retained, in bytes, or 0 if unlimited. */
+    NSUInteger _maxPendingReportBytes;
+
+    /** The maximum age of a retained pending crash report, in seconds, or 0 if unlimited. */
+    NSTimeInterval _maxPendingReportAge;
+
+    /** The maximum number of coalesced VM regions summarized in each report, or 0 if disabled. */
+    NSUInteger _vmRegionSummaryLimit;
+
+    /** The capacity of the thread registry, or 0 if disabled. */
+    NSUInteger _threadRegistryCapacity;
 }
 
 + (instancetype) defaultConfiguration;
@@ -157,9 +360,330 @@ typedef NS_OPTIONS(NSUInteger, PLCrashReporterSymbolicationStrategy) {
 /** The configured signal handler type. */
 @property(nonatomic, readonly) PLCrashReporterSignalHandlerType signalHandlerType;
 
-/** The configured symbolication strategy. */
+/**
+ * The configured symbolication strategy. This strategy is applied to the main executable; unless otherwise
+ * configured, it is also applied to all other images.
+ */
 @property(nonatomic, readonly) PLCrashReporterSymbolicationStrategy symbolicationStrategy;
 
+/**
+ * The symbolication strategy applied to images other than the main executable that are not system images, such as
+ * frameworks embedded within the application.
+ */
+@property(nonatomic, readonly) PLCrashReporterSymbolicationStrategy applicationImageSymbolicationStrategy;
+
+/**
+ * The symbolication strategy applied to system images, including all images within the dyld shared cache.
+ *
+ * System images account for most of the frames in a typical report, and therefore for most of the time spent
+ * symbolicating at crash time, but their symbols are generally redacted on iOS and are better resolved server-side.
+ * Setting this to PLCrashReporterSymbolicationStrategyNone limits crash-time symbolication to the application's own
+ * images.
+ */
+@property(nonatomic, readonly) PLCrashReporterSymbolicationStrategy systemImageSymbolicationStrategy;
+
+/** The configured thread capture mode. */
+@property(nonatomic, readonly) PLCrashReporterThreadCaptureMode threadCaptureMode;
+
+/** The configured report format. */
+@property(nonatomic, readonly) PLCrashReporterReportFormat reportFormat;
+
+/** The configured report compression. */
+@property(nonatomic, readonly) PLCrashReporterReportCompression reportCompression;
+
+/**
+ * The interval, in seconds, within which repeats of a previously reported crash will not be written as a full
+ * report. If 0, duplicate crash suppression is disabled.
+ *
+ * When enabled, the crash reporter persists the signatures of recent crashes. A crash whose crashed thread stack
+ * matches a crash that was fully reported within this interval only increments that crash's suppressed repeat
+ * count, which is available via PLCrashReporter::suppressedCrashCount. This avoids repeatedly capturing
+ * full reports from a device that is caught in a crash loop.
+ */
+@property(nonatomic, readonly) NSTimeInterval duplicateSuppressionInterval;
+
+/**
+ * If YES, each report records the time spent in each phase of its generation (thread suspension, unwinding,
+ * symbolication, and output), along with the number of memory objects mapped and task memory reads performed.
+ * The measurements are available via PLCrashReport::instrumentationInfo.
+ */
+@property(nonatomic, readonly) BOOL instrumentationEnabled;
+
+/**
+ * The size, in bytes, of the alternate signal stack on which crash reports are written by the BSD signal handler. If
+ * 0, a default of 64KiB is used. The stack is preceded by a guard page.
+ *
+ * Deep stacks and DWARF-based unwinding increase the stack space required to write a report. When instrumentation
+ * is enabled, reports record the stack's measured high-water mark via PLCrashReportInstrumentationInfo, which may be
+ * used to tune this value.
+ *
+ * The stack is allocated when the first crash reporter is enabled; the size configured by later crash reporter
+ * instances is ignored.
+ */
+@property(nonatomic, readonly) NSUInteger signalStackSize;
+
+/**
+ * The maximum number of bytes of stack memory, beginning at the stack pointer, to be captured from the crashed thread.
+ * If 0, stack memory is not captured. Runs of zero bytes are omitted from the report, and the captured memory is
+ * further limited such that it does not exhaust the crash report's maximum size.
+ *
+ * The captured memory is available via PLCrashReport::stackMemory. Stack memory may contain sensitive user data.
+ */
+@property(nonatomic, readonly) NSUInteger stackMemoryCaptureSize;
+
+/**
+ * The maximum number of threads, other than the crashed thread, for which stack memory is captured. Additional threads
+ * are only captured when they remain suspended for the duration of report generation, as is the case for crash
+ * reports; live reports capture only the crashed thread.
+ */
+@property(nonatomic, readonly) NSUInteger stackMemoryThreadCount;
+
+/**
+ * The maximum total number of bytes of memory to be captured around the crashed thread's register values. If 0,
+ * register memory is not captured.
+ *
+ * A small window of memory is captured around each register value that points into readable memory, such as the
+ * receiver of a crashed objc_msgSend(). Overlapping windows are merged. The captured memory is available via
+ * PLCrashReport::registerMemory, and may contain sensitive user data.
+ */
+@property(nonatomic, readonly) NSUInteger registerMemoryCaptureSize;
+
+/**
+ * If YES, report sections are written in order of importance, and lower-priority sections are omitted as required to
+ * fit the report within its maximum size. The crashed thread, exception, and the binary images referenced by the
+ * crashed thread are written first, followed by the remaining threads and then the remaining images. Threads are
+ * omitted before any image.
+ *
+ * The number of omitted threads and images is available via PLCrashReport::elidedThreadCount and
+ * PLCrashReport::elidedImageCount.
+ */
+@property(nonatomic, readonly) BOOL prioritizedOutputEnabled;
+
+/**
+ * If YES, every loaded binary image is written to each report. If NO, the default, only the images referenced by the
+ * report's thread and exception backtraces are written, along with the main executable. This is sufficient to
+ * symbolicate the report, and considerably reduces both the time spent writing a report and its size, as a process
+ * commonly has several hundred images loaded.
+ */
+@property(nonatomic, readonly) BOOL fullImageListEnabled;
+
+/**
+ * The maximum number of threads to be written to each report. If 0, the default, all threads are written.
+ *
+ * The crashed thread and the main thread are always written, regardless of this limit; the remaining threads are
+ * written in task order until the limit is reached. Threads beyond the limit are not unwound or symbolicated, and
+ * their number is available via PLCrashReport::elidedThreadCount. This bounds the cost of writing a report from a
+ * process that runs a large number of (generally idle) threads.
+ */
+@property(nonatomic, readonly) NSUInteger maxThreadCount;
+
+/**
+ * The maximum number of frames to be written for each thread. If 0, the default limit of 512 frames is used.
+ *
+ * If a thread's stack exceeds this depth, its innermost and outermost frames are written, and the frames between
+ * them are omitted. Values outside of the range 2 to 512 are clamped to that range.
+ */
+@property(nonatomic, readonly) NSUInteger maxThreadFrameCount;
+
+/**
+ * The number of bytes of storage to be preallocated for the crash report when the crash reporter is enabled. If
+ * 0, the default, the crash report file is created by the crash handler.
+ *
+ * If non-zero, the crash report file is created, and the given number of bytes preallocated, when the crash reporter
+ * is enabled. The crash handler then writes the report into the already-open file, avoiding the cost of creating
+ * the file and allocating its storage on a full or contended filesystem, and moves the completed report into place
+ * with a single rename. A value of 65536 accommodates the default maximum report size.
+ */
+@property(nonatomic, readonly) NSUInteger reportPreallocationSize;
+
+/**
+ * If YES, the preallocated crash report file is mapped into memory when the crash reporter is enabled, and the
+ * crash handler writes the report directly into the mapping rather than issuing a write for each flush of its output
+ * buffer. The completed report's length is recorded in a header at the start of the mapping, and the report is moved
+ * into the crash report directory the next time pending reports are queried or the crash reporter is enabled.
+ *
+ * This option has no effect unless PLCrashReporterConfig::reportPreallocationSize is non-zero; the mapping is sized to
+ * the preallocated storage, and a report that does not fit within it is not written.
+ */
+@property(nonatomic, readonly) BOOL mappedReportOutputEnabled;
+
+/**
+ * If YES, the crash report file is synchronized to the storage device via fsync() once the report's termination
+ * messages have been written, and again once the crashed thread has been written. If NO, the default, the report is
+ * only flushed to the kernel at these checkpoints, which is sufficient for the report to survive the termination of the
+ * process, but not a kernel panic or loss of power.
+ *
+ * Reports are written with the signal and exception information first, followed by the crashed thread, so that a
+ * report cut short by a watchdog still describes the crash. Synchronizing adds the latency of two storage writes to
+ * the crash handler.
+ */
+@property(nonatomic, readonly) BOOL checkpointSyncEnabled;
+
+/**
+ * The preparation applied to the crash handling path when the crash reporter is enabled. If
+ * PLCrashReporterCrashPathWarmupNone, the default, the crash handler's memory is faulted in on first use, at crash
+ * time.
+ *
+ * Under memory pressure, the first crash may otherwise incur a page fault on each first access to the crash reporter's
+ * code, the signal stack, and its preallocated buffers.
+ */
+@property(nonatomic, readonly) PLCrashReporterCrashPathWarmup crashPathWarmup;
+
+/**
+ * The time budget for writing a crash report, in seconds. If 0, the default, report writing is not time limited.
+ *
+ * Once the budget has expired, the crashed thread is still written in full, but the remaining threads are written
+ * using frame pointer unwinding without symbols, only the binary images referenced by the written frames are
+ * written, and captured memory is omitted. Such reports are marked via PLCrashReport::deadlineExpired.
+ *
+ * This bounds the time spent in the crash handler, eg, when the process may be terminated by a watchdog.
+ */
+@property(nonatomic, readonly) NSTimeInterval reportTimeBudget;
+
+/**
+ * If YES, each live report session starts a helper thread that symbolicates each thread's frames while the session
+ * unwinds the remaining threads, hiding the cost of symbolication behind unwinding on multi-core devices. Defaults to
+ * NO.
+ *
+ * Reports written at crash time are unaffected.
+ */
+@property(nonatomic, readonly) BOOL symbolicationPipelineEnabled;
+
+/**
+ * If YES, the load command and section mappings of each binary image are released once the image has been parsed,
+ * and are re-mapped on demand at crash time. Defaults to NO.
+ *
+ * This reduces the steady-state memory footprint of the binary image list, eg, in memory-constrained app extensions,
+ * at the cost of additional work when writing a report. The setting applies to images parsed after the crash reporter
+ * is enabled.
+ */
+@property(nonatomic, readonly) BOOL compactImageListEnabled;
+
+/**
+ * If YES, the symbol, Objective-C, and unwind indexes of each binary image are built by a low priority background
+ * thread, in image priority order, rather than synchronously when the crash reporter is enabled and as each image is
+ * loaded. Defaults to NO.
+ *
+ * This reduces the launch-time cost of enabling the crash reporter. Until an image's indexes have been built, a report
+ * falls back on the image's unindexed data.
+ */
+@property(nonatomic, readonly) BOOL backgroundImageIndexingEnabled;
+
+/**
+ * If YES, a manifest of the loaded binary images is written by a background thread once the crash reporter is enabled,
+ * and again after images are loaded or unloaded. Each report references the current manifest by identifier, and
+ * includes only the images loaded since it was written. Defaults to NO.
+ *
+ * Manifests are identified by a hash of their contents, and are written once per distinct set of loaded images; a
+ * report's images may be restored by supplying its manifest to PLCrashReport::initWithData:imageManifest:error:. See
+ * PLCrashReporter::imageManifestIdentifiers.
+ */
+@property(nonatomic, readonly) BOOL imageManifestEnabled;
+
+/**
+ * The maximum number of pending crash reports retained. If 0, the number of pending reports is not limited. Defaults
+ * to 32.
+ *
+ * Each report is moved into the pending report store once written, so that a later crash can not overwrite it. When
+ * the store exceeds this or any other pending report budget, reports are evicted: reports that duplicate the
+ * signature of a newer pending report are evicted first, oldest first, followed by the oldest remaining reports.
+ * See PLCrashReporterConfig::maxPendingReportBytes and PLCrashReporterConfig::maxPendingReportAge.
+ */
+@property(nonatomic, readonly) NSUInteger maxPendingReportCount;
+
+/**
+ * The maximum total size of the pending crash reports retained, in bytes. If 0, the default, the total size is not
+ * limited. Reports are evicted as described by PLCrashReporterConfig::maxPendingReportCount.
+ */
+@property(nonatomic, readonly) NSUInteger maxPendingReportBytes;
+
+/**
+ * The maximum age of a retained pending crash report, in seconds. If 0, the default, reports are retained until
+ * purged or evicted under another budget. Reports written longer ago are evicted the next time pending reports are
+ * queried.
+ */
+@property(nonatomic, readonly) NSTimeInterval maxPendingReportAge;
+
+/**
+ * The maximum number of virtual memory regions to be summarized in each report. If 0, the default, no VM region
+ * summary is written.
+ *
+ * If non-zero, the target task's address space is enumerated at crash time, and adjacent regions with identical
+ * protection, user tag, and share mode are coalesced. Enumeration stops once this many coalesced regions have been
+ * recorded, or once a fixed time budget has been spent, and the summary is marked as truncated. The summary is
+ * available via PLCrashReport::vmRegions, and is primarily useful in diagnosing memory-related crashes.
+ */
+@property(nonatomic, readonly) NSUInteger vmRegionSummaryLimit;
+
+/**
+ * The maximum number of threads recorded by the thread registry. If 0, the default, no thread registry is
+ * maintained.
+ *
+ * If non-zero, a process-wide registry of the process' threads is maintained via pthread introspection hooks, recording
+ * each thread's Mach thread port, stack range, and name as it starts. At crash time, the registry is consulted in place
+ * of enumerating the task's threads and locating each thread's stack, and the recorded thread names are included in the
+ * report. If more threads are running than the registry can record, or the crashed thread was not created via
+ * pthreads, the task's threads are enumerated instead.
+ *
+ * The registry is installed for the lifetime of the process, and is shared by all crash reporter instances; the
+ * capacity of the first reporter to be enabled with a thread registry applies.
+ */
+@property(nonatomic, readonly) NSUInteger threadRegistryCapacity;
+
+
+@end
+
+/**
+ * A mutable crash reporter configuration.
+ *
+ * Each option of PLCrashReporterConfig may be set individually, starting from the default configuration:
+ *
+ * @code
+ * PLMutableCrashReporterConfig *config = [PLMutableCrashReporterConfig defaultConfiguration];
+ * config.signalHandlerType = PLCrashReporterSignalHandlerTypeMach;
+ * config.maxThreadCount = 64;
+ * PLCrashReporter *reporter = [[[PLCrashReporter alloc] initWithConfiguration: config] autorelease];
+ * @endcode
+ *
+ * Setting the symbolicationStrategy also sets the applicationImageSymbolicationStrategy and
+ * systemImageSymbolicationStrategy; either may then be set to override the strategy for its image class.
+ *
+ * A PLCrashReporter instance copies its configuration when initialized; later modifications have no effect on
+ * existing reporters.
+ */
+@interface PLMutableCrashReporterConfig : PLCrashReporterConfig
+
+@property(nonatomic, readwrite) PLCrashReporterSignalHandlerType signalHandlerType;
+@property(nonatomic, readwrite) PLCrashReporterSymbolicationStrategy symbolicationStrategy;
+@property(nonatomic, readwrite) PLCrashReporterSymbolicationStrategy applicationImageSymbolicationStrategy;
+@property(nonatomic, readwrite) PLCrashReporterSymbolicationStrategy systemImageSymbolicationStrategy;
+@property(nonatomic, readwrite) PLCrashReporterThreadCaptureMode threadCaptureMode;
+@property(nonatomic, readwrite) PLCrashReporterReportFormat reportFormat;
+@property(nonatomic, readwrite) PLCrashReporterReportCompression reportCompression;
+@property(nonatomic, readwrite) NSTimeInterval duplicateSuppressionInterval;
+@property(nonatomic, readwrite) BOOL instrumentationEnabled;
+@property(nonatomic, readwrite) NSUInteger signalStackSize;
+@property(nonatomic, readwrite) NSUInteger stackMemoryCaptureSize;
+@property(nonatomic, readwrite) NSUInteger stackMemoryThreadCount;
+@property(nonatomic, readwrite) NSUInteger registerMemoryCaptureSize;
+@property(nonatomic, readwrite) BOOL prioritizedOutputEnabled;
+@property(nonatomic, readwrite) BOOL fullImageListEnabled;
+@property(nonatomic, readwrite) NSUInteger maxThreadCount;
+@property(nonatomic, readwrite) NSUInteger maxThreadFrameCount;
+@property(nonatomic, readwrite) NSUInteger reportPreallocationSize;
+@property(nonatomic, readwrite) BOOL mappedReportOutputEnabled;
+@property(nonatomic, readwrite) BOOL checkpointSyncEnabled;
+@property(nonatomic, readwrite) PLCrashReporterCrashPathWarmup crashPathWarmup;
+@property(nonatomic, readwrite) NSTimeInterval reportTimeBudget;
+@property(nonatomic, readwrite) BOOL symbolicationPipelineEnabled;
+@property(nonatomic, readwrite) BOOL compactImageListEnabled;
+@property(nonatomic, readwrite) BOOL backgroundImageIndexingEnabled;
+@property(nonatomic, readwrite) BOOL imageManifestEnabled;
+@property(nonatomic, readwrite) NSUInteger maxPendingReportCount;
+@property(nonatomic, readwrite) NSUInteger maxPendingReportBytes;
+@property(nonatomic, readwrite) NSTimeInterval maxPendingReportAge;
+@property(nonatomic, readwrite) NSUInteger vmRegionSummaryLimit;
+@property(nonatomic, readwrite) NSUInteger threadRegistryCapacity;
 
 @end
 
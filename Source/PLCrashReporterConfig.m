@@ -37,6 +37,35 @@
 
 @synthesize signalHandlerType = _signalHandlerType;
 @synthesize symbolicationStrategy = _symbolicationStrategy;
+@synthesize applicationImageSymbolicationStrategy = _applicationImageSymbolicationStrategy;
+@synthesize systemImageSymbolicationStrategy = _systemImageSymbolicationStrategy;
+@synthesize threadCaptureMode = _threadCaptureMode;
+@synthesize reportFormat = _reportFormat;
+@synthesize reportCompression = _reportCompression;
+@synthesize duplicateSuppressionInterval = _duplicateSuppressionInterval;
+@synthesize instrumentationEnabled = _instrumentationEnabled;
+@synthesize signalStackSize = _signalStackSize;
+@synthesize stackMemoryCaptureSize = _stackMemoryCaptureSize;
+@synthesize stackMemoryThreadCount = _stackMemoryThreadCount;
+@synthesize registerMemoryCaptureSize = _registerMemoryCaptureSize;
+@synthesize prioritizedOutputEnabled = _prioritizedOutputEnabled;
+@synthesize fullImageListEnabled = _fullImageListEnabled;
+@synthesize maxThreadCount = _maxThreadCount;
+@synthesize maxThreadFrameCount = _maxThreadFrameCount;
+@synthesize reportPreallocationSize = _reportPreallocationSize;
+@synthesize mappedReportOutputEnabled = _mappedReportOutputEnabled;
+@synthesize checkpointSyncEnabled = _checkpointSyncEnabled;
+@synthesize crashPathWarmup = _crashPathWarmup;
+@synthesize reportTimeBudget = _reportTimeBudget;
+@synthesize symbolicationPipelineEnabled = _symbolicationPipelineEnabled;
+@synthesize compactImageListEnabled = _compactImageListEnabled;
+@synthesize backgroundImageIndexingEnabled = _backgroundImageIndexingEnabled;
+@synthesize imageManifestEnabled = _imageManifestEnabled;
+@synthesize maxPendingReportCount = _maxPendingReportCount;
+@synthesize maxPendingReportBytes = _maxPendingReportBytes;
+@synthesize maxPendingReportAge = _maxPendingReportAge;
+@synthesize vmRegionSummaryLimit = _vmRegionSummaryLimit;
+@synthesize threadRegistryCapacity = _threadRegistryCapacity;
 
 /**
  * Return the default local configuration.
@@ -54,10 +83,12 @@
 }
 
 /**
- * Initialize a new PLCrashReporterConfig instance.
+ * Initialize a new PLCrashReporterConfig instance. All other options are set to their defaults; see
+ * PLMutableCrashReporterConfig to configure them.
  *
  * @param signalHandlerType The requested signal handler type.
- * @param symbolicationStrategy A local symbolication strategy.
+ * @param symbolicationStrategy A local symbolication strategy. This strategy is also applied to application and
+ * system images.
  */
 - (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
                      symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
@@ -67,8 +98,263 @@
 
     _signalHandlerType = signalHandlerType;
     _symbolicationStrategy = symbolicationStrategy;
+    _applicationImageSymbolicationStrategy = symbolicationStrategy;
+    _systemImageSymbolicationStrategy = symbolicationStrategy;
+    _threadCaptureMode = PLCrashReporterThreadCaptureModeFull;
+    _reportFormat = PLCrashReporterReportFormatV1;
+    _reportCompression = PLCrashReporterReportCompressionNone;
+    _duplicateSuppressionInterval = 0;
+    _instrumentationEnabled = NO;
+    _signalStackSize = 0;
+    _stackMemoryCaptureSize = 0;
+    _stackMemoryThreadCount = 0;
+    _registerMemoryCaptureSize = 0;
+    _prioritizedOutputEnabled = NO;
+    _fullImageListEnabled = NO;
+    _maxThreadCount = 0;
+    _maxThreadFrameCount = 0;
+    _reportPreallocationSize = 0;
+    _mappedReportOutputEnabled = NO;
+    _checkpointSyncEnabled = NO;
+    _crashPathWarmup = PLCrashReporterCrashPathWarmupNone;
+    _reportTimeBudget = 0;
+    _symbolicationPipelineEnabled = NO;
+    _compactImageListEnabled = NO;
+    _backgroundImageIndexingEnabled = NO;
+    _imageManifestEnabled = NO;
+    _maxPendingReportCount = 32;
+    _maxPendingReportBytes = 0;
+    _maxPendingReportAge = 0;
+    _vmRegionSummaryLimit = 0;
+    _threadRegistryCapacity = 0;
 
     return self;
 }
 
+/**
+ * @internal
+ *
+ * Return a new instance of @a cls with this instance's configuration.
+ */
+- (id) copyWithClass: (Class) cls zone: (NSZone *) zone {
+    PLCrashReporterConfig *copy = [[cls allocWithZone: zone] init];
+    if (copy == nil)
+        return nil;
+
+    copy->_signalHandlerType = _signalHandlerType;
+    copy->_symbolicationStrategy = _symbolicationStrategy;
+    copy->_applicationImageSymbolicationStrategy = _applicationImageSymbolicationStrategy;
+    copy->_systemImageSymbolicationStrategy = _systemImageSymbolicationStrategy;
+    copy->_threadCaptureMode = _threadCaptureMode;
+    copy->_reportFormat = _reportFormat;
+    copy->_reportCompression = _reportCompression;
+    copy->_duplicateSuppressionInterval = _duplicateSuppressionInterval;
+    copy->_instrumentationEnabled = _instrumentationEnabled;
+    copy->_signalStackSize = _signalStackSize;
+    copy->_stackMemoryCaptureSize = _stackMemoryCaptureSize;
+    copy->_stackMemoryThreadCount = _stackMemoryThreadCount;
+    copy->_registerMemoryCaptureSize = _registerMemoryCaptureSize;
+    copy->_prioritizedOutputEnabled = _prioritizedOutputEnabled;
+    copy->_fullImageListEnabled = _fullImageListEnabled;
+    copy->_maxThreadCount = _maxThreadCount;
+    copy->_maxThreadFrameCount = _maxThreadFrameCount;
+    copy->_reportPreallocationSize = _reportPreallocationSize;
+    copy->_mappedReportOutputEnabled = _mappedReportOutputEnabled;
+    copy->_checkpointSyncEnabled = _checkpointSyncEnabled;
+    copy->_crashPathWarmup = _crashPathWarmup;
+    copy->_reportTimeBudget = _reportTimeBudget;
+    copy->_symbolicationPipelineEnabled = _symbolicationPipelineEnabled;
+    copy->_compactImageListEnabled = _compactImageListEnabled;
+    copy->_backgroundImageIndexingEnabled = _backgroundImageIndexingEnabled;
+    copy->_imageManifestEnabled = _imageManifestEnabled;
+    copy->_maxPendingReportCount = _maxPendingReportCount;
+    copy->_maxPendingReportBytes = _maxPendingReportBytes;
+    copy->_maxPendingReportAge = _maxPendingReportAge;
+    copy->_vmRegionSummaryLimit = _vmRegionSummaryLimit;
+    copy->_threadRegistryCapacity = _threadRegistryCapacity;
+
+    return copy;
+}
+
+// from NSCopying protocol
+- (id) copyWithZone: (NSZone *) zone {
+    /* Immutable instances may be shared */
+    if ([self class] == [PLCrashReporterConfig class])
+        return [self retain];
+
+    return [self copyWithClass: [PLCrashReporterConfig class] zone: zone];
+}
+
+// from NSMutableCopying protocol
+- (id) mutableCopyWithZone: (NSZone *) zone {
+    return [self copyWithClass: [PLMutableCrashReporterConfig class] zone: zone];
+}
+
+@end
+
+/**
+ * Mutable Crash Reporter Configuration.
+ *
+ * Supports configuring each option of a PLCrashReporter configuration individually.
+ */
+@implementation PLMutableCrashReporterConfig
+
+@dynamic signalHandlerType;
+@dynamic symbolicationStrategy;
+@dynamic applicationImageSymbolicationStrategy;
+@dynamic systemImageSymbolicationStrategy;
+@dynamic threadCaptureMode;
+@dynamic reportFormat;
+@dynamic reportCompression;
+@dynamic duplicateSuppressionInterval;
+@dynamic instrumentationEnabled;
+@dynamic signalStackSize;
+@dynamic stackMemoryCaptureSize;
+@dynamic stackMemoryThreadCount;
+@dynamic registerMemoryCaptureSize;
+@dynamic prioritizedOutputEnabled;
+@dynamic fullImageListEnabled;
+@dynamic maxThreadCount;
+@dynamic maxThreadFrameCount;
+@dynamic reportPreallocationSize;
+@dynamic mappedReportOutputEnabled;
+@dynamic checkpointSyncEnabled;
+@dynamic crashPathWarmup;
+@dynamic reportTimeBudget;
+@dynamic symbolicationPipelineEnabled;
+@dynamic compactImageListEnabled;
+@dynamic backgroundImageIndexingEnabled;
+@dynamic imageManifestEnabled;
+@dynamic maxPendingReportCount;
+@dynamic maxPendingReportBytes;
+@dynamic maxPendingReportAge;
+@dynamic vmRegionSummaryLimit;
+@dynamic threadRegistryCapacity;
+
+- (void) setSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType {
+    _signalHandlerType = signalHandlerType;
+}
+
+- (void) setSymbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy {
+    _symbolicationStrategy = symbolicationStrategy;
+    _applicationImageSymbolicationStrategy = symbolicationStrategy;
+    _systemImageSymbolicationStrategy = symbolicationStrategy;
+}
+
+- (void) setApplicationImageSymbolicationStrategy: (PLCrashReporterSymbolicationStrategy) applicationImageSymbolicationStrategy {
+    _applicationImageSymbolicationStrategy = applicationImageSymbolicationStrategy;
+}
+
+- (void) setSystemImageSymbolicationStrategy: (PLCrashReporterSymbolicationStrategy) systemImageSymbolicationStrategy {
+    _systemImageSymbolicationStrategy = systemImageSymbolicationStrategy;
+}
+
+- (void) setThreadCaptureMode: (PLCrashReporterThreadCaptureMode) threadCaptureMode {
+    _threadCaptureMode = threadCaptureMode;
+}
+
+- (void) setReportFormat: (PLCrashReporterReportFormat) reportFormat {
+    _reportFormat = reportFormat;
+}
+
+- (void) setReportCompression: (PLCrashReporterReportCompression) reportCompression {
+    _reportCompression = reportCompression;
+}
+
+- (void) setDuplicateSuppressionInterval: (NSTimeInterval) duplicateSuppressionInterval {
+    _duplicateSuppressionInterval = duplicateSuppressionInterval;
+}
+
+- (void) setInstrumentationEnabled: (BOOL) instrumentationEnabled {
+    _instrumentationEnabled = instrumentationEnabled;
+}
+
+- (void) setSignalStackSize: (NSUInteger) signalStackSize {
+    _signalStackSize = signalStackSize;
+}
+
+- (void) setStackMemoryCaptureSize: (NSUInteger) stackMemoryCaptureSize {
+    _stackMemoryCaptureSize = stackMemoryCaptureSize;
+}
+
+- (void) setStackMemoryThreadCount: (NSUInteger) stackMemoryThreadCount {
+    _stackMemoryThreadCount = stackMemoryThreadCount;
+}
+
+- (void) setRegisterMemoryCaptureSize: (NSUInteger) registerMemoryCaptureSize {
+    _registerMemoryCaptureSize = registerMemoryCaptureSize;
+}
+
+- (void) setPrioritizedOutputEnabled: (BOOL) prioritizedOutputEnabled {
+    _prioritizedOutputEnabled = prioritizedOutputEnabled;
+}
+
+- (void) setFullImageListEnabled: (BOOL) fullImageListEnabled {
+    _fullImageListEnabled = fullImageListEnabled;
+}
+
+- (void) setMaxThreadCount: (NSUInteger) maxThreadCount {
+    _maxThreadCount = maxThreadCount;
+}
+
+- (void) setMaxThreadFrameCount: (NSUInteger) maxThreadFrameCount {
+    _maxThreadFrameCount = maxThreadFrameCount;
+}
+
+- (void) setReportPreallocationSize: (NSUInteger) reportPreallocationSize {
+    _reportPreallocationSize = reportPreallocationSize;
+}
+
+- (void) setMappedReportOutputEnabled: (BOOL) mappedReportOutputEnabled {
+    _mappedReportOutputEnabled = mappedReportOutputEnabled;
+}
+
+- (void) setCheckpointSyncEnabled: (BOOL) checkpointSyncEnabled {
+    _checkpointSyncEnabled = checkpointSyncEnabled;
+}
+
+- (void) setCrashPathWarmup: (PLCrashReporterCrashPathWarmup) crashPathWarmup {
+    _crashPathWarmup = crashPathWarmup;
+}
+
+- (void) setReportTimeBudget: (NSTimeInterval) reportTimeBudget {
+    _reportTimeBudget = reportTimeBudget;
+}
+
+- (void) setSymbolicationPipelineEnabled: (BOOL) symbolicationPipelineEnabled {
+    _symbolicationPipelineEnabled = symbolicationPipelineEnabled;
+}
+
+- (void) setCompactImageListEnabled: (BOOL) compactImageListEnabled {
+    _compactImageListEnabled = compactImageListEnabled;
+}
+
+- (void) setBackgroundImageIndexingEnabled: (BOOL) backgroundImageIndexingEnabled {
+    _backgroundImageIndexingEnabled = backgroundImageIndexingEnabled;
+}
+
+- (void) setImageManifestEnabled: (BOOL) imageManifestEnabled {
+    _imageManifestEnabled = imageManifestEnabled;
+}
+
+- (void) setMaxPendingReportCount: (NSUInteger) maxPendingReportCount {
+    _maxPendingReportCount = maxPendingReportCount;
+}
+
+- (void) setMaxPendingReportBytes: (NSUInteger) maxPendingReportBytes {
+    _maxPendingReportBytes = maxPendingReportBytes;
+}
+
+- (void) setMaxPendingReportAge: (NSTimeInterval) maxPendingReportAge {
+    _maxPendingReportAge = maxPendingReportAge;
+}
+
+- (void) setVmRegionSummaryLimit: (NSUInteger) vmRegionSummaryLimit {
+    _vmRegionSummaryLimit = vmRegionSummaryLimit;
+}
+
+- (void) setThreadRegistryCapacity: (NSUInteger) threadRegistryCapacity {
+    _threadRegistryCapacity = threadRegistryCapacity;
+}
+
 @end
@@ -30,6 +30,7 @@
 
 #import "PLCrashReport.h"
 #import "PLCrashReporter.h"
+#import "PLCrashLiveReportSession.h"
 #import "PLCrashFrameWalker.h"
 #import "PLCrashTestThread.h"
 
@@ -67,6 +68,38 @@
     STAssertEqualStrings([[report signalInfo] code], @"TRAP_TRACE", @"Incorrect signal code");
 }
 
+/**
+ * Test generation of a 'live' crash report for a subset of threads, including the current thread.
+ */
+- (void) testGenerateLiveReportForThreads {
+    NSError *error;
+    NSData *reportData;
+    plcrash_test_thread_t thr;
+
+    /* Spawn a thread and generate a report for it and the current thread */
+    plcrash_test_thread_spawn(&thr);
+    thread_t threads[] = { pthread_mach_thread_np(thr.thread), pl_mach_thread_self() };
+    reportData = [[PLCrashReporter sharedReporter] generateLiveReportForThreads: threads
+                                                                          count: sizeof(threads) / sizeof(threads[0])
+                                                                          error: &error];
+    plcrash_test_thread_stop(&thr);
+    STAssertNotNil(reportData, @"Failed to generate live report: %@", error);
+
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: reportData error: &error] autorelease];
+    STAssertNotNil(report, @"Could not parse generated live report: %@", error);
+
+    /* Only the requested threads are written, with the first marked as crashed */
+    STAssertEquals([[report threads] count], (NSUInteger) 2, @"Incorrect thread count");
+    if ([[report threads] count] == 2) {
+        STAssertTrue([[[report threads] objectAtIndex: 0] crashed], @"The first requested thread was not marked as crashed");
+        STAssertFalse([[[report threads] objectAtIndex: 1] crashed], @"The second requested thread was marked as crashed");
+        STAssertTrue([[[[report threads] objectAtIndex: 1] stackFrames] count] > 0, @"The current thread was not walked");
+    }
+
+    /* An empty thread list is rejected */
+    STAssertNil([[PLCrashReporter sharedReporter] generateLiveReportForThreads: threads count: 0 error: NULL], @"Generated a report without threads");
+}
+
 /**
  * Test generation of a 'live' crash report.
  */
@@ -80,6 +113,42 @@
 
     STAssertEqualStrings([[report signalInfo] name], @"SIGTRAP", @"Incorrect signal name");
     STAssertEqualStrings([[report signalInfo] code], @"TRAP_TRACE", @"Incorrect signal code");
+
+    /* Live reports resume the suspended threads before encoding, and record the suspension time */
+    STAssertTrue(report.hasThreadSuspendDuration, @"Missing thread suspend duration");
+}
+
+/**
+ * Test generation of a decoded 'live' crash report.
+ */
+- (void) testGenerateLiveCrashReport {
+    NSError *error;
+    PLCrashReport *report = [[PLCrashReporter sharedReporter] generateLiveCrashReportAndReturnError: &error];
+    STAssertNotNil(report, @"Failed to generate live report: %@", error);
+
+    STAssertEqualStrings([[report signalInfo] name], @"SIGTRAP", @"Incorrect signal name");
+    STAssertEqualStrings([[report signalInfo] code], @"TRAP_TRACE", @"Incorrect signal code");
+    STAssertTrue([[report threads] count] > 0, @"No threads were decoded");
+}
+
+/**
+ * Test generation of multiple live reports from a single reusable session.
+ */
+- (void) testLiveReportSession {
+    NSError *error;
+    PLCrashLiveReportSession *session = [[PLCrashReporter sharedReporter] liveReportSessionAndReturnError: &error];
+    STAssertNotNil(session, @"Failed to create live report session: %@", error);
+
+    for (int i = 0; i < 2; i++) {
+        NSData *reportData = [session generateLiveReportAndReturnError: &error];
+        STAssertNotNil(reportData, @"Failed to generate live report: %@", error);
+
+        PLCrashReport *report = [[[PLCrashReport alloc] initWithData: reportData error: &error] autorelease];
+        STAssertNotNil(report, @"Could not parse geneated live report: %@", error);
+
+        STAssertEqualStrings([[report signalInfo] name], @"SIGTRAP", @"Incorrect signal name");
+        STAssertEqualStrings([[report signalInfo] code], @"TRAP_TRACE", @"Incorrect signal code");
+    }
 }
 
 @end
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <mach/mach.h>
+
+@interface PLCrashResourceEvent : NSObject {
+@private
+    /** The Mach exception type. */
+    exception_type_t _exceptionType;
+
+    /** The Mach exception codes of the first occurrence. */
+    NSArray *_exceptionCodes;
+
+    /** The offending thread's frame PCs. */
+    NSArray *_stackFrames;
+
+    /** The number of occurrences. */
+    NSUInteger _count;
+
+    /** The time of the first occurrence. */
+    NSDate *_firstDate;
+
+    /** The time of the most recent occurrence. */
+    NSDate *_lastDate;
+}
+
+- (id) initWithExceptionType: (exception_type_t) exceptionType
+              exceptionCodes: (NSArray *) exceptionCodes
+                 stackFrames: (NSArray *) stackFrames
+                        date: (NSDate *) date;
+
+/**
+ * The Mach exception type (eg, EXC_RESOURCE).
+ */
+@property(nonatomic, readonly) exception_type_t exceptionType;
+
+/**
+ * The Mach exception codes of the first occurrence, as NSNumber values. For EXC_RESOURCE, the first code encodes
+ * the resource type and flavor, and the second the observed value.
+ */
+@property(nonatomic, readonly) NSArray *exceptionCodes;
+
+/**
+ * The PC values of the offending thread's frames, innermost first, as NSNumber values. The frames are unwound
+ * using frame pointers alone, and are not symbolicated. May be empty if the thread could not be unwound.
+ */
+@property(nonatomic, readonly) NSArray *stackFrames;
+
+/**
+ * The number of occurrences of this event, with the same exception type, resource type and stack, that were
+ * aggregated into this instance.
+ */
+@property(nonatomic, readonly) NSUInteger count;
+
+/**
+ * The time of the first aggregated occurrence.
+ */
+@property(nonatomic, readonly) NSDate *firstDate;
+
+/**
+ * The time of the most recent aggregated occurrence.
+ */
+@property(nonatomic, readonly) NSDate *lastDate;
+
+@end
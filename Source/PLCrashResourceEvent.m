@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashResourceEvent.h"
+
+/**
+ * A non-fatal resource event, such as an EXC_RESOURCE CPU or wakeups limit notification, as recorded by
+ * PLCrashReporter::startResourceEventMonitoringWithMaximumRate:error:. Repeated events with an identical exception type,
+ * resource type, and stack are aggregated into a single instance.
+ */
+@implementation PLCrashResourceEvent
+
+@synthesize exceptionType = _exceptionType;
+@synthesize exceptionCodes = _exceptionCodes;
+@synthesize stackFrames = _stackFrames;
+@synthesize count = _count;
+@synthesize firstDate = _firstDate;
+@synthesize lastDate = _lastDate;
+
+/**
+ * Initialize with a single occurrence.
+ *
+ * @param exceptionType The Mach exception type.
+ * @param exceptionCodes The Mach exception codes, as NSNumber values.
+ * @param stackFrames The offending thread's frame PCs, as NSNumber values.
+ * @param date The time of the occurrence.
+ */
+- (id) initWithExceptionType: (exception_type_t) exceptionType
+              exceptionCodes: (NSArray *) exceptionCodes
+                 stackFrames: (NSArray *) stackFrames
+                        date: (NSDate *) date
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _exceptionType = exceptionType;
+    _exceptionCodes = [exceptionCodes retain];
+    _stackFrames = [stackFrames retain];
+    _count = 1;
+    _firstDate = [date retain];
+    _lastDate = [date retain];
+
+    return self;
+}
+
+- (void) dealloc {
+    [_exceptionCodes release];
+    [_stackFrames release];
+    [_firstDate release];
+    [_lastDate release];
+
+    [super dealloc];
+}
+
+@end
+
+/**
+ * @internal
+ * Aggregation of repeated events, used by PLCrashReporter.
+ */
+@implementation PLCrashResourceEvent (PLCrashReporterAggregation)
+
+/**
+ * Record an additional occurrence of this event.
+ *
+ * @param date The time of the occurrence.
+ */
+- (void) addOccurrenceAtDate: (NSDate *) date {
+    _count++;
+
+    if ([date compare: _lastDate] == NSOrderedDescending) {
+        [_lastDate release];
+        _lastDate = [date retain];
+    }
+}
+
+@end
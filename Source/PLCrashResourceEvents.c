@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashResourceEvents.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <libkern/OSAtomic.h>
+
+/**
+ * @ingroup plcrash_resource_events
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * Return the ring buffer slot for the event with @a index.
+ */
+static plcrash_resource_event_t *plcrash_resource_events_slot (plcrash_resource_events_t *events, int64_t index) {
+    return (plcrash_resource_event_t *) (events->_slots + ((size_t) (index % (int64_t) events->capacity) * events->_slot_size));
+}
+
+/**
+ * Return the stack sample recorded for @a event.
+ *
+ * @param event A recorded event.
+ */
+const plcrash_sampler_sample_t *plcrash_resource_event_sample (const plcrash_resource_event_t *event) {
+    return (const plcrash_sampler_sample_t *) ((const uint8_t *) event + sizeof(*event));
+}
+
+/**
+ * Initialize a resource event ring buffer.
+ *
+ * @param events The buffer to initialize.
+ * @param image_list The image list to be used when unwinding the offending threads.
+ * @param capacity The number of events that may be held by the buffer. If the buffer is not drained before
+ * @a capacity additional events are recorded, the oldest events are overwritten.
+ * @param max_depth The maximum number of frames recorded per event.
+ * @param max_rate The maximum number of events recorded per second.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the ring buffer could not be allocated.
+ *
+ * @warning This function is not async-safe.
+ */
+plcrash_error_t plcrash_nasync_resource_events_init (plcrash_resource_events_t *events, plcrash_async_image_list_t *image_list, size_t capacity, uint32_t max_depth, uint32_t max_rate) {
+    PLCF_ASSERT(capacity > 0);
+    PLCF_ASSERT(max_depth > 0);
+
+    memset(events, 0, sizeof(*events));
+    events->image_list = image_list;
+    events->capacity = capacity;
+    events->max_depth = max_depth;
+    events->max_rate = max_rate;
+
+    events->_slot_size = sizeof(plcrash_resource_event_t) + plcrash_sampler_sample_size(max_depth);
+
+    events->_slots = calloc(capacity, events->_slot_size);
+    if (events->_slots == NULL)
+        return PLCRASH_ENOMEM;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Free all resources associated with @a events.
+ *
+ * @warning This function is not async-safe, and must not be called while an event may be recorded.
+ */
+void plcrash_nasync_resource_events_free (plcrash_resource_events_t *events) {
+    if (events->_slots != NULL) {
+        free(events->_slots);
+        events->_slots = NULL;
+    }
+}
+
+/**
+ * Return true if exceptions of @a type are non-fatal notifications that should be recorded via
+ * plcrash_async_resource_events_record(), rather than as a crash.
+ *
+ * EXC_GUARD is not included; under the default task policy, guard violations terminate the process, and are
+ * reported as crashes.
+ *
+ * @param type The Mach exception type.
+ */
+bool plcrash_async_resource_event_is_nonfatal (exception_type_t type) {
+#ifdef EXC_RESOURCE
+    if (type == EXC_RESOURCE)
+        return true;
+#endif
+
+    return false;
+}
+
+/**
+ * Record an event for the exception raised on @a thread. The thread is suspended only for the duration of a frame
+ * pointer unwind; no memory is allocated.
+ *
+ * If more than plcrash_resource_events_t::max_rate events have been recorded within the current second, the event
+ * is counted as dropped and the thread is not unwound.
+ *
+ * @param events The buffer in which the event will be recorded.
+ * @param thread The thread on which the exception was raised. This must not be the calling thread.
+ * @param type The Mach exception type.
+ * @param codes The Mach exception codes.
+ * @param code_count The number of codes in @a codes.
+ *
+ * @return Returns true if the event was recorded, or false if it was dropped.
+ *
+ * @warning This function must not be called concurrently with itself. It is async-safe, and may be called from a
+ * Mach exception server thread.
+ */
+bool plcrash_async_resource_events_record (plcrash_resource_events_t *events, thread_t thread, exception_type_t type, mach_exception_data_t codes, mach_msg_type_number_t code_count) {
+    int64_t now = (int64_t) time(NULL);
+
+    /* Apply the rate limit */
+    if (now != events->_window_start) {
+        events->_window_start = now;
+        events->_window_count = 0;
+    }
+
+    if (events->_window_count >= events->max_rate) {
+        OSAtomicIncrement64Barrier(&events->_dropped_count);
+        return false;
+    }
+    events->_window_count++;
+
+    /* Mark the slot as being written; concurrent readers will discard it until the write completes */
+    int64_t index = events->_event_count;
+    plcrash_resource_event_t *event = plcrash_resource_events_slot(events, index);
+
+    event->seq = (index * 2) + 1;
+    OSMemoryBarrier();
+
+    event->timestamp = now;
+    event->type = type;
+    event->code_count = 0;
+    for (mach_msg_type_number_t i = 0; i < code_count && i < PLCRASH_RESOURCE_EVENT_CODE_COUNT; i++)
+        event->codes[event->code_count++] = codes[i];
+
+    plcrash_sampler_sample_t *sample = (plcrash_sampler_sample_t *) plcrash_resource_event_sample(event);
+    if (!plcrash_sampler_sample_thread(events->image_list, thread, events->max_depth, false, sample)) {
+        /* Record the event without a stack, rather than losing it */
+        sample->depth = 0;
+    }
+
+    /* Publish the event */
+    OSMemoryBarrier();
+    event->seq = (index * 2) + 2;
+    OSAtomicIncrement64Barrier(&events->_event_count);
+
+    return true;
+}
+
+/**
+ * Return the number of events that were dropped due to rate limiting, or that were overwritten before they
+ * could be drained.
+ */
+int64_t plcrash_resource_events_dropped_count (plcrash_resource_events_t *events) {
+    OSMemoryBarrier();
+    return events->_dropped_count;
+}
+
+/**
+ * Drain all events recorded since the previous call, passing each to @a callback in the order in which
+ * they were recorded.
+ *
+ * @param events The buffer to drain.
+ * @param callback The callback to be invoked for each event.
+ * @param context Context to be passed to @a callback.
+ *
+ * @return Returns the number of events passed to @a callback.
+ *
+ * @warning This function is not async-safe, and must not be called concurrently with itself. It may be called
+ * concurrently with plcrash_async_resource_events_record().
+ */
+size_t plcrash_nasync_resource_events_drain (plcrash_resource_events_t *events, plcrash_resource_events_drain_fn callback, void *context) {
+    size_t drained = 0;
+
+    plcrash_resource_event_t *copy = malloc(events->_slot_size);
+    if (copy == NULL)
+        return 0;
+
+    OSMemoryBarrier();
+    int64_t end = events->_event_count;
+    int64_t start = events->_drain_index;
+
+    /* Events that have already been overwritten are counted as dropped */
+    if (end - start > (int64_t) events->capacity) {
+        int64_t overwritten = (end - start) - (int64_t) events->capacity;
+        OSAtomicAdd64Barrier(overwritten, &events->_dropped_count);
+        start += overwritten;
+    }
+
+    for (int64_t index = start; index < end; index++) {
+        plcrash_resource_event_t *event = plcrash_resource_events_slot(events, index);
+        int64_t seq = (index * 2) + 2;
+
+        if (event->seq != seq)
+            continue;
+
+        OSMemoryBarrier();
+        memcpy(copy, event, events->_slot_size);
+        OSMemoryBarrier();
+
+        /* Discard events that were overwritten while being copied */
+        if (event->seq != seq) {
+            OSAtomicIncrement64Barrier(&events->_dropped_count);
+            continue;
+        }
+
+        callback(copy, context);
+        drained++;
+    }
+
+    events->_drain_index = end;
+    free(copy);
+
+    return drained;
+}
+
+/**
+ * @}
+ */
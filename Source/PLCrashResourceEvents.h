@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_RESOURCE_EVENTS_H
+#define PLCRASH_RESOURCE_EVENTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <mach/mach.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncImageList.h"
+#include "PLCrashSampler.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_resource_events Resource Event Recording
+ * @ingroup plcrash_internal
+ *
+ * Records non-fatal Mach exceptions (such as EXC_RESOURCE CPU and wakeup limit notifications) without writing a
+ * full crash report. The exception server thread captures only the offending thread's PCs, using the frame pointer
+ * unwinder, into a preallocated and rate-limited ring buffer, and replies to the kernel immediately. Recorded events
+ * are drained and aggregated later, outside of the exception server thread.
+ *
+ * @{
+ */
+
+/** The default maximum number of frames recorded per event. */
+#define PLCRASH_RESOURCE_EVENTS_DEFAULT_MAX_DEPTH 32
+
+/** The number of exception codes recorded per event. */
+#define PLCRASH_RESOURCE_EVENT_CODE_COUNT 2
+
+/**
+ * @internal
+ *
+ * A single recorded event. The event's stack sample immediately follows the header in the ring buffer; see
+ * plcrash_resource_event_sample().
+ */
+typedef struct plcrash_resource_event {
+    /**
+     * The slot's sequence value. This is odd while the slot is being written, and is otherwise set to twice the
+     * event's index plus two. Readers must verify that the value is unchanged after copying the slot.
+     */
+    volatile int64_t seq;
+
+    /** The time at which the event was recorded, in seconds since the epoch. */
+    int64_t timestamp;
+
+    /** The Mach exception type. */
+    exception_type_t type;
+
+    /** The number of valid values in @a codes. */
+    uint32_t code_count;
+
+    /** The Mach exception codes. */
+    int64_t codes[PLCRASH_RESOURCE_EVENT_CODE_COUNT];
+} plcrash_resource_event_t;
+
+/**
+ * @internal
+ *
+ * Resource event ring buffer.
+ */
+typedef struct plcrash_resource_events {
+    /** The image list used to unwind the offending threads. */
+    plcrash_async_image_list_t *image_list;
+
+    /** The number of events that may be held by the ring buffer. */
+    size_t capacity;
+
+    /** The maximum number of frames recorded per event. */
+    uint32_t max_depth;
+
+    /** The maximum number of events recorded per second. Events in excess of this rate are counted, but not recorded. */
+    uint32_t max_rate;
+
+    /** Size of a single ring buffer slot, in bytes. */
+    size_t _slot_size;
+
+    /** The ring buffer storage; @a capacity slots of @a _slot_size bytes. */
+    uint8_t *_slots;
+
+    /** The total number of events written. Only modified by the recording thread. */
+    volatile int64_t _event_count;
+
+    /** The index of the next event to be drained. Only modified by the draining thread. */
+    int64_t _drain_index;
+
+    /** The number of events dropped due to rate limiting, or a failure to unwind the offending thread. */
+    volatile int64_t _dropped_count;
+
+    /** The start of the current rate limiting window, in seconds since the epoch. */
+    int64_t _window_start;
+
+    /** The number of events recorded in the current rate limiting window. */
+    uint32_t _window_count;
+} plcrash_resource_events_t;
+
+/**
+ * @internal
+ *
+ * Event callback used by plcrash_nasync_resource_events_drain().
+ *
+ * @param event The event. The event's stack sample may be fetched with plcrash_resource_event_sample().
+ * @param context The context supplied to plcrash_nasync_resource_events_drain().
+ */
+typedef void (*plcrash_resource_events_drain_fn) (const plcrash_resource_event_t *event, void *context);
+
+plcrash_error_t plcrash_nasync_resource_events_init (plcrash_resource_events_t *events, plcrash_async_image_list_t *image_list, size_t capacity, uint32_t max_depth, uint32_t max_rate);
+void plcrash_nasync_resource_events_free (plcrash_resource_events_t *events);
+
+bool plcrash_async_resource_events_record (plcrash_resource_events_t *events, thread_t thread, exception_type_t type, mach_exception_data_t codes, mach_msg_type_number_t code_count);
+size_t plcrash_nasync_resource_events_drain (plcrash_resource_events_t *events, plcrash_resource_events_drain_fn callback, void *context);
+int64_t plcrash_resource_events_dropped_count (plcrash_resource_events_t *events);
+
+const plcrash_sampler_sample_t *plcrash_resource_event_sample (const plcrash_resource_event_t *event);
+
+bool plcrash_async_resource_event_is_nonfatal (exception_type_t type);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_RESOURCE_EVENTS_H */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashResourceEvents.h"
+#import "PLCrashTestThread.h"
+
+#import <mach-o/dyld.h>
+
+@interface PLCrashResourceEventsTests : SenTestCase {
+@private
+    /** The image list used for unwinding. */
+    plcrash_async_image_list_t _image_list;
+
+    /** The thread for which events will be recorded. */
+    plcrash_test_thread_t _thr_args;
+}
+@end
+
+/* Drain callback; counts events and verifies their content. */
+static void count_event (const plcrash_resource_event_t *event, void *context) {
+    NSUInteger *count = context;
+
+    if (event->type == EXC_BAD_ACCESS && event->code_count == 2 && event->codes[0] == 1 && event->codes[1] == 2 &&
+        plcrash_resource_event_sample(event)->depth > 0)
+    {
+        (*count)++;
+    }
+}
+
+@implementation PLCrashResourceEventsTests
+
+- (void) setUp {
+    plcrash_nasync_image_list_init(&_image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&_image_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    plcrash_test_thread_spawn(&_thr_args);
+}
+
+- (void) tearDown {
+    plcrash_test_thread_stop(&_thr_args);
+    plcrash_nasync_image_list_free(&_image_list);
+}
+
+/**
+ * Verify that events are recorded with the offending thread's stack, drained exactly once, and rate limited.
+ */
+- (void) testRecordAndDrain {
+    plcrash_resource_events_t events;
+    mach_exception_data_type_t codes[] = { 1, 2 };
+    thread_t thread = pthread_mach_thread_np(_thr_args.thread);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_resource_events_init(&events, &_image_list, 8, PLCRASH_RESOURCE_EVENTS_DEFAULT_MAX_DEPTH, 3), @"Failed to initialize the event buffer");
+
+    /* Only the first three events within the (one second) window may be recorded. This will spuriously fail if
+     * the window rolls over between recordings; three calls should complete well within a second. */
+    NSUInteger recorded = 0;
+    for (int i = 0; i < 5; i++) {
+        if (plcrash_async_resource_events_record(&events, thread, EXC_BAD_ACCESS, codes, 2))
+            recorded++;
+    }
+    STAssertTrue(recorded >= 3, @"Expected at least three events to be recorded");
+    STAssertEquals((int64_t) (5 - recorded), plcrash_resource_events_dropped_count(&events), @"Dropped events were not counted");
+
+    NSUInteger count = 0;
+    STAssertEquals((size_t) recorded, plcrash_nasync_resource_events_drain(&events, count_event, &count), @"Incorrect drain count");
+    STAssertEquals(recorded, count, @"Drained events did not match the recorded events");
+
+    /* A second drain must not return the same events */
+    count = 0;
+    STAssertEquals((size_t) 0, plcrash_nasync_resource_events_drain(&events, count_event, &count), @"Events were drained twice");
+
+    plcrash_nasync_resource_events_free(&events);
+}
+
+/**
+ * Verify that non-fatal exception types are classified correctly.
+ */
+- (void) testNonFatalClassification {
+#ifdef EXC_RESOURCE
+    STAssertTrue(plcrash_async_resource_event_is_nonfatal(EXC_RESOURCE), @"EXC_RESOURCE should be non-fatal");
+#endif
+#ifdef EXC_GUARD
+    STAssertFalse(plcrash_async_resource_event_is_nonfatal(EXC_GUARD), @"EXC_GUARD should be reported as a crash");
+#endif
+    STAssertFalse(plcrash_async_resource_event_is_nonfatal(EXC_BAD_ACCESS), @"EXC_BAD_ACCESS should be reported as a crash");
+}
+
+@end
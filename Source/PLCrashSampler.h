@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_SAMPLER_H
+#define PLCRASH_SAMPLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <mach/mach.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncImageList.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_sampler Sampling Profiler
+ * @ingroup plcrash_internal
+ *
+ * Implements an in-process sampling profiler. A dedicated thread periodically suspends each of the task's threads,
+ * unwinds its stack via plframe_cursor_t, and records the frame PCs in a preallocated ring buffer. The aggregated
+ * call stack counts may be written as a profile report, as defined by profile_report.proto.
+ *
+ * Repeated samples of a thread are captured incrementally: the thread's previous walk is retained, and unwinding
+ * stops at the first frame whose PC and stack pointer both match a frame of the previous walk. The frames beyond
+ * the matching frame are assumed to be unchanged, and are copied from the previous walk; only the frames that
+ * changed since the previous sample are unwound.
+ *
+ * @{
+ */
+
+/** The default maximum number of frames recorded per sample. */
+#define PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH 128
+
+/** The number of threads for which the sampler retains the previous walk. Additional threads are sampled in full. */
+#define PLCRASH_SAMPLER_HISTORY_SIZE 64
+
+/**
+ * @internal
+ *
+ * A single recorded stack sample. The sample's PC values immediately follow the header in the ring buffer.
+ */
+typedef struct plcrash_sampler_sample {
+    /**
+     * The slot's sequence value. This is odd while the slot is being written, and is otherwise set to twice the
+     * sample's index plus two. Readers must verify that the value is unchanged after copying the slot.
+     */
+    volatile int64_t seq;
+
+    /** The number of valid PC values. */
+    uint32_t depth;
+
+    /** The number of outermost frames that were copied from the thread's previous walk, rather than unwound. */
+    uint32_t shared_depth;
+
+    /** The frame PC values, innermost frame first. */
+    uint64_t pcs[];
+} plcrash_sampler_sample_t;
+
+/**
+ * @internal
+ *
+ * The most recent walk of a sampled thread, against which the thread's next sample is compared. The walk is
+ * double-buffered; the next walk is recorded in the inactive bank while the current bank is compared against.
+ */
+typedef struct plcrash_sampler_history {
+    /** The sampled thread, or MACH_PORT_NULL if the entry is unused. */
+    thread_t thread;
+
+    /** The sampling pass in which the entry was last used. Only used by plcrash_sampler_t. */
+    uint64_t pass;
+
+    /** The maximum number of frames held by each bank. */
+    uint32_t max_depth;
+
+    /** The number of frames in the current bank, or 0 if no previous walk is available. */
+    uint32_t depth;
+
+    /** The index of the current bank. */
+    uint32_t bank;
+
+    /** The frame PC values of each bank, innermost frame first. */
+    uint64_t *pcs[2];
+
+    /** The frame stack pointers of each bank, innermost frame first, or 0 where unavailable. */
+    uint64_t *sps[2];
+
+    /** The frame pointers of each bank, innermost frame first, or 0 where unavailable. */
+    uint64_t *fps[2];
+} plcrash_sampler_history_t;
+
+/**
+ * @internal
+ *
+ * Sampling profiler state.
+ */
+typedef struct plcrash_sampler {
+    /** The image list used to unwind sampled threads. */
+    plcrash_async_image_list_t *image_list;
+
+    /** The number of samples that may be held by the ring buffer. */
+    size_t capacity;
+
+    /** The maximum number of frames recorded per sample. */
+    uint32_t max_depth;
+
+    /** If true, threads are unwound using all available unwind data, rather than frame pointers alone. */
+    bool full_unwind;
+
+    /** The sampling interval, in microseconds. */
+    uint32_t interval_usec;
+
+    /** Size of a single ring buffer slot, in bytes. */
+    size_t _slot_size;
+
+    /** The previous walk of up to PLCRASH_SAMPLER_HISTORY_SIZE sampled threads. */
+    plcrash_sampler_history_t *_history;
+
+    /** The number of sampling passes performed. Only modified by the sampling thread. */
+    uint64_t _pass;
+
+    /** The ring buffer storage; @a capacity slots of @a _slot_size bytes. */
+    uint8_t *_slots;
+
+    /** The total number of samples written. Only modified by the sampling thread. */
+    volatile int64_t _sample_count;
+
+    /** The number of samples dropped due to a failure to suspend or unwind a thread. */
+    volatile int64_t _failed_count;
+
+    /** If true, the sampling thread should continue running. */
+    volatile bool _running;
+
+    /** If true, @a _thread is valid. */
+    bool _thread_started;
+
+    /** The sampling thread. */
+    pthread_t _thread;
+} plcrash_sampler_t;
+
+plcrash_error_t plcrash_nasync_sampler_init (plcrash_sampler_t *sampler, plcrash_async_image_list_t *image_list, size_t capacity, uint32_t max_depth, bool full_unwind);
+plcrash_error_t plcrash_nasync_sampler_start (plcrash_sampler_t *sampler, uint32_t interval_usec);
+void plcrash_nasync_sampler_stop (plcrash_sampler_t *sampler);
+void plcrash_nasync_sampler_free (plcrash_sampler_t *sampler);
+
+size_t plcrash_sampler_sample_size (uint32_t max_depth);
+plcrash_error_t plcrash_nasync_sampler_history_init (plcrash_sampler_history_t *history, uint32_t max_depth);
+void plcrash_nasync_sampler_history_free (plcrash_sampler_history_t *history);
+bool plcrash_sampler_sample_thread (plcrash_async_image_list_t *image_list, thread_t thread, uint32_t max_depth, bool full_unwind, plcrash_sampler_sample_t *sample);
+bool plcrash_sampler_sample_thread_incremental (plcrash_async_image_list_t *image_list, thread_t thread, uint32_t max_depth, bool full_unwind,
+                                                plcrash_sampler_history_t *history, plcrash_sampler_sample_t *sample);
+void plcrash_sampler_sample_threads (plcrash_sampler_t *sampler);
+int64_t plcrash_sampler_sample_count (plcrash_sampler_t *sampler);
+
+plcrash_error_t plcrash_nasync_sampler_write_profile (plcrash_sampler_t *sampler, plcrash_async_file_t *file);
+void plcrash_nasync_sampler_write_images (plcrash_async_image_list_t *image_list, plcrash_async_file_t *file);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_SAMPLER_H */
@@ -0,0 +1,668 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashSampler.h"
+#import "PLCrashFrameWalker.h"
+#import "PLCrashLogWriter.h"
+#import "PLCrashLogWriterEncoding.h"
+#import "PLCrashReportFieldIDs.h"
+
+#import <stdlib.h>
+#import <string.h>
+#import <unistd.h>
+#import <libkern/OSAtomic.h>
+
+/**
+ * @ingroup plcrash_sampler
+ * @{
+ */
+
+/** The number of frames unwound per plframe_cursor_walk() call when capturing a sample. */
+#define PLCRASH_SAMPLER_WALK_BATCH 64
+
+/**
+ * The number of frames unwound per plframe_cursor_walk() call when capturing a sample incrementally. This is kept
+ * small, as frames unwound beyond the first frame that matches the previous walk are discarded.
+ */
+#define PLCRASH_SAMPLER_INCREMENTAL_WALK_BATCH 8
+
+static void *plcrash_sampler_thread (void *arg);
+
+/**
+ * Return the number of bytes required to hold a single plcrash_sampler_sample_t of up to @a max_depth
+ * frames. The returned size is rounded up to preserve the natural alignment of the sample's sequence value
+ * when samples are stored contiguously.
+ *
+ * @param max_depth The maximum number of frames to be recorded in the sample.
+ */
+size_t plcrash_sampler_sample_size (uint32_t max_depth) {
+    size_t size = sizeof(plcrash_sampler_sample_t) + (sizeof(uint64_t) * max_depth);
+    return (size + sizeof(int64_t) - 1) & ~(sizeof(int64_t) - 1);
+}
+
+/**
+ * Initialize an empty thread history, for use with plcrash_sampler_sample_thread_incremental().
+ *
+ * @param history The history to initialize.
+ * @param max_depth The maximum number of frames to be recorded per sample.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the history's storage can not be allocated.
+ *
+ * @warning This function is not async-safe.
+ */
+plcrash_error_t plcrash_nasync_sampler_history_init (plcrash_sampler_history_t *history, uint32_t max_depth) {
+    memset(history, 0, sizeof(*history));
+
+    uint64_t *frames = calloc((size_t) max_depth * 6, sizeof(uint64_t));
+    if (frames == NULL)
+        return PLCRASH_ENOMEM;
+
+    history->max_depth = max_depth;
+    history->pcs[0] = frames;
+    history->pcs[1] = frames + max_depth;
+    history->sps[0] = frames + (max_depth * 2);
+    history->sps[1] = frames + (max_depth * 3);
+    history->fps[0] = frames + (max_depth * 4);
+    history->fps[1] = frames + (max_depth * 5);
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Free all resources associated with @a history.
+ *
+ * @param history The history to free.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_sampler_history_free (plcrash_sampler_history_t *history) {
+    free(history->pcs[0]);
+    memset(history, 0, sizeof(*history));
+}
+
+/**
+ * Initialize a new sampler. The sampler will not record any samples until started via plcrash_nasync_sampler_start(),
+ * or until plcrash_sampler_sample_threads() is called directly.
+ *
+ * @param sampler The sampler to initialize.
+ * @param image_list The image list to be used when unwinding sampled threads. This list must remain valid for
+ * the lifetime of the sampler.
+ * @param capacity The number of samples to be retained by the ring buffer; once full, the oldest samples are
+ * overwritten.
+ * @param max_depth The maximum number of frames to record per sample. The remaining frames of deeper stacks are
+ * discarded.
+ * @param full_unwind If true, threads are unwound with all available unwind data. Otherwise, only frame pointers are
+ * used, which is considerably less expensive.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the ring buffer can not be allocated.
+ *
+ * @warning This function is not async-safe.
+ */
+plcrash_error_t plcrash_nasync_sampler_init (plcrash_sampler_t *sampler, plcrash_async_image_list_t *image_list, size_t capacity, uint32_t max_depth, bool full_unwind) {
+    PLCF_ASSERT(capacity > 0);
+    PLCF_ASSERT(max_depth > 0);
+
+    memset(sampler, 0, sizeof(*sampler));
+    sampler->image_list = image_list;
+    sampler->capacity = capacity;
+    sampler->max_depth = max_depth;
+    sampler->full_unwind = full_unwind;
+
+    sampler->_slot_size = plcrash_sampler_sample_size(max_depth);
+
+    sampler->_slots = calloc(capacity, sampler->_slot_size);
+    sampler->_history = calloc(PLCRASH_SAMPLER_HISTORY_SIZE, sizeof(sampler->_history[0]));
+    if (sampler->_slots == NULL || sampler->_history == NULL) {
+        plcrash_nasync_sampler_free(sampler);
+        return PLCRASH_ENOMEM;
+    }
+
+    for (size_t i = 0; i < PLCRASH_SAMPLER_HISTORY_SIZE; i++) {
+        if (plcrash_nasync_sampler_history_init(&sampler->_history[i], max_depth) != PLCRASH_ESUCCESS) {
+            plcrash_nasync_sampler_free(sampler);
+            return PLCRASH_ENOMEM;
+        }
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Start the sampling thread.
+ *
+ * @param sampler The sampler to start.
+ * @param interval_usec The interval between samples, in microseconds.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if the sampler is already running, or
+ * PLCRASH_EINTERNAL if the thread could not be created.
+ *
+ * @warning This function is not async-safe, and must not be called concurrently with plcrash_nasync_sampler_stop().
+ */
+plcrash_error_t plcrash_nasync_sampler_start (plcrash_sampler_t *sampler, uint32_t interval_usec) {
+    if (sampler->_thread_started)
+        return PLCRASH_EINVAL;
+
+    sampler->interval_usec = interval_usec;
+    sampler->_running = true;
+    OSMemoryBarrier();
+
+    int err = pthread_create(&sampler->_thread, NULL, plcrash_sampler_thread, sampler);
+    if (err != 0) {
+        PLCF_DEBUG("Could not start the sampler thread: %s", strerror(err));
+        sampler->_running = false;
+        return PLCRASH_EINTERNAL;
+    }
+
+    sampler->_thread_started = true;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Stop the sampling thread, waiting for any in-progress sample to complete. Samples already recorded are retained.
+ *
+ * @param sampler The sampler to stop.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_sampler_stop (plcrash_sampler_t *sampler) {
+    if (!sampler->_thread_started)
+        return;
+
+    sampler->_running = false;
+    OSMemoryBarrier();
+
+    pthread_join(sampler->_thread, NULL);
+    sampler->_thread_started = false;
+}
+
+/**
+ * Stop the sampler, if running, and free all associated resources.
+ *
+ * @param sampler The sampler to free.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_sampler_free (plcrash_sampler_t *sampler) {
+    plcrash_nasync_sampler_stop(sampler);
+
+    if (sampler->_slots != NULL) {
+        free(sampler->_slots);
+        sampler->_slots = NULL;
+    }
+
+    if (sampler->_history != NULL) {
+        for (size_t i = 0; i < PLCRASH_SAMPLER_HISTORY_SIZE; i++)
+            plcrash_nasync_sampler_history_free(&sampler->_history[i]);
+
+        free(sampler->_history);
+        sampler->_history = NULL;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Return the ring buffer slot for the sample with @a index.
+ */
+static plcrash_sampler_sample_t *plcrash_sampler_slot (plcrash_sampler_t *sampler, int64_t index) {
+    return (plcrash_sampler_sample_t *) (sampler->_slots + ((size_t) (index % (int64_t) sampler->capacity) * sampler->_slot_size));
+}
+
+/**
+ * @internal
+ *
+ * Read the return address from the frame record at @a fp; this is the PC of the frame's caller.
+ *
+ * @param fp The frame pointer.
+ * @param[out] ra On success, the return address.
+ *
+ * @return Returns true on success, or false if the frame record could not be read.
+ */
+static bool plcrash_sampler_read_return_address (uint64_t fp, uint64_t *ra) {
+    /* The frame record holds the saved frame pointer, followed by the return address */
+    uintptr_t record[2];
+    if (plcrash_async_task_memcpy(mach_task_self(), (pl_vm_address_t) fp, 0, record, sizeof(record)) != PLCRASH_ESUCCESS)
+        return false;
+
+    *ra = record[1];
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Unwind the suspended @a thread into @a sample. If @a history is non-NULL, unwinding stops at the first frame
+ * matching a frame of the thread's previous walk, the remaining frames are copied from the previous walk, and
+ * the new walk is recorded in @a history.
+ *
+ * @return Returns true if at least one frame was recorded.
+ */
+static bool plcrash_sampler_capture (plcrash_async_image_list_t *image_list, thread_t thread, uint32_t max_depth, bool full_unwind,
+                                     plcrash_sampler_history_t *history, plcrash_sampler_sample_t *sample)
+{
+    plframe_cursor_t cursor;
+    plframe_error_t ferr;
+
+    sample->depth = 0;
+    sample->shared_depth = 0;
+
+    if ((ferr = plframe_cursor_thread_init(&cursor, mach_task_self(), thread, image_list)) != PLFRAME_ESUCCESS) {
+        plframe_cursor_free(&cursor);
+        if (history != NULL)
+            history->depth = 0;
+        return false;
+    }
+
+    /* The previous walk is read from the current bank, and the new walk recorded in the inactive bank */
+    const uint64_t *prev_pcs = NULL;
+    const uint64_t *prev_sps = NULL;
+    const uint64_t *prev_fps = NULL;
+    uint64_t *next_sps = NULL;
+    uint64_t *next_fps = NULL;
+    uint32_t prev_depth = 0;
+    uint32_t prev_idx = 0;
+    if (history != NULL) {
+        PLCF_ASSERT(history->max_depth >= max_depth);
+        prev_pcs = history->pcs[history->bank];
+        prev_sps = history->sps[history->bank];
+        prev_fps = history->fps[history->bank];
+        prev_depth = history->depth;
+        next_sps = history->sps[history->bank ^ 1];
+        next_fps = history->fps[history->bank ^ 1];
+    }
+
+    /* Walk the stack in batches; the cursor resumes where each batch left off. */
+    uint32_t flags = full_unwind ? 0 : PLFRAME_WALK_FRAME_PTR_ONLY;
+    size_t batch = (prev_depth > 0) ? PLCRASH_SAMPLER_INCREMENTAL_WALK_BATCH : PLCRASH_SAMPLER_WALK_BATCH;
+    plcrash_greg_t pcs[PLCRASH_SAMPLER_WALK_BATCH];
+    plcrash_greg_t sps[PLCRASH_SAMPLER_WALK_BATCH];
+    plcrash_greg_t fps[PLCRASH_SAMPLER_WALK_BATCH];
+    bool matched = false;
+    do {
+        size_t count;
+        size_t max = MIN((size_t) (max_depth - sample->depth), batch);
+
+        ferr = plframe_cursor_walk(&cursor, pcs, history != NULL ? sps : NULL, history != NULL ? fps : NULL, max, &count, flags);
+        for (size_t i = 0; i < count && !matched; i++) {
+            uint32_t depth = sample->depth++;
+            sample->pcs[depth] = pcs[i];
+            if (history == NULL)
+                continue;
+
+            next_sps[depth] = sps[i];
+            next_fps[depth] = fps[i];
+            if (sps[i] == 0 || fps[i] == 0)
+                continue;
+
+            /* The stack grows down; skip the previous walk's frames that lie below this frame */
+            while (prev_idx < prev_depth && prev_sps[prev_idx] < sps[i])
+                prev_idx++;
+
+            /* An unchanged PC and stack pointer do not imply unchanged callers; the thread may have returned and
+             * re-entered the same function from a different caller. The frame's callers are only assumed to be
+             * unchanged if its frame pointer is also unchanged, and its frame record still returns to the caller
+             * recorded by the previous walk. */
+            if (prev_idx + 1 < prev_depth && prev_sps[prev_idx] == sps[i] && prev_pcs[prev_idx] == pcs[i] && prev_fps[prev_idx] == fps[i]) {
+                uint64_t ra;
+                if (plcrash_sampler_read_return_address(fps[i], &ra) && ra == prev_pcs[prev_idx + 1])
+                    matched = true;
+            }
+        }
+    } while (!matched && ferr == PLFRAME_ESUCCESS && sample->depth < max_depth);
+
+    plframe_cursor_free(&cursor);
+
+    if (history == NULL)
+        return sample->depth > 0;
+
+    /* Copy the shared callers from the previous walk */
+    if (matched) {
+        uint32_t shared = MIN(prev_depth - (prev_idx + 1), max_depth - sample->depth);
+        memcpy(&sample->pcs[sample->depth], &prev_pcs[prev_idx + 1], sizeof(uint64_t) * shared);
+        memcpy(&next_sps[sample->depth], &prev_sps[prev_idx + 1], sizeof(uint64_t) * shared);
+        memcpy(&next_fps[sample->depth], &prev_fps[prev_idx + 1], sizeof(uint64_t) * shared);
+        sample->depth += shared;
+        sample->shared_depth = shared;
+    }
+
+    /* Make the new walk current */
+    history->bank ^= 1;
+    memcpy(history->pcs[history->bank], sample->pcs, sizeof(uint64_t) * sample->depth);
+    history->depth = sample->depth;
+
+    return sample->depth > 0;
+}
+
+/**
+ * Suspend @a thread, record a single sample of its call stack in @a sample, and resume the thread.
+ *
+ * No memory is allocated while the thread is suspended, ensuring that a thread suspended while holding the
+ * allocator lock can not deadlock the caller.
+ *
+ * @param image_list The image list to be used when unwinding @a thread.
+ * @param thread The thread to sample. This must not be the calling thread.
+ * @param max_depth The maximum number of frames to record.
+ * @param full_unwind If true, the thread is unwound with all available unwind data. Otherwise, only frame
+ * pointers are used.
+ * @param sample The sample to be populated. This must provide storage for at least @a max_depth frames; see
+ * plcrash_sampler_sample_size().
+ *
+ * @return Returns true if the thread was suspended and at least one frame was recorded.
+ */
+bool plcrash_sampler_sample_thread (plcrash_async_image_list_t *image_list, thread_t thread, uint32_t max_depth, bool full_unwind, plcrash_sampler_sample_t *sample) {
+    return plcrash_sampler_sample_thread_incremental(image_list, thread, max_depth, full_unwind, NULL, sample);
+}
+
+/**
+ * Suspend @a thread, record a single sample of its call stack in @a sample, and resume the thread, unwinding only
+ * the frames that changed since the walk recorded in @a history.
+ *
+ * Unwinding stops at the first frame whose PC, stack pointer, and frame pointer all match a frame of the previous
+ * walk, and whose frame record returns to the caller recorded by the previous walk; that frame's remaining callers
+ * are assumed to be unchanged, and are copied from the previous walk. The number of copied frames
+ * is recorded in plcrash_sampler_sample_t::shared_depth. The new walk then replaces the previous walk in @a history.
+ *
+ * @param image_list The image list to be used when unwinding @a thread.
+ * @param thread The thread to sample. This must not be the calling thread.
+ * @param max_depth The maximum number of frames to record. Must not exceed the history's maximum depth.
+ * @param full_unwind If true, the thread is unwound with all available unwind data. Otherwise, only frame
+ * pointers are used.
+ * @param history The thread's previous walk, as initialized by plcrash_nasync_sampler_history_init() and populated by
+ * prior calls to this function for the same thread, or NULL to unwind the full stack.
+ * @param sample The sample to be populated. This must provide storage for at least @a max_depth frames; see
+ * plcrash_sampler_sample_size().
+ *
+ * @return Returns true if the thread was suspended and at least one frame was recorded.
+ */
+bool plcrash_sampler_sample_thread_incremental (plcrash_async_image_list_t *image_list, thread_t thread, uint32_t max_depth, bool full_unwind,
+                                                plcrash_sampler_history_t *history, plcrash_sampler_sample_t *sample)
+{
+    if (thread_suspend(thread) != KERN_SUCCESS)
+        return false;
+
+    bool captured = plcrash_sampler_capture(image_list, thread, max_depth, full_unwind, history, sample);
+    thread_resume(thread);
+
+    return captured;
+}
+
+/**
+ * @internal
+ *
+ * Return the history entry for @a thread, reclaiming the least recently used entry not yet used in the current pass
+ * if @a thread has no entry. Returns NULL if all entries have been used in the current pass.
+ */
+static plcrash_sampler_history_t *plcrash_sampler_history_lookup (plcrash_sampler_t *sampler, thread_t thread) {
+    plcrash_sampler_history_t *oldest = NULL;
+
+    for (size_t i = 0; i < PLCRASH_SAMPLER_HISTORY_SIZE; i++) {
+        plcrash_sampler_history_t *history = &sampler->_history[i];
+        if (history->thread == thread) {
+            history->pass = sampler->_pass;
+            return history;
+        }
+
+        if (history->pass != sampler->_pass && (oldest == NULL || history->pass < oldest->pass))
+            oldest = history;
+    }
+
+    if (oldest != NULL) {
+        oldest->thread = thread;
+        oldest->pass = sampler->_pass;
+        oldest->depth = 0;
+    }
+
+    return oldest;
+}
+
+/**
+ * Record a single sample of every thread in the current task, other than the calling thread.
+ *
+ * Each thread is suspended only for the duration of its unwind; see plcrash_sampler_sample_thread().
+ *
+ * @param sampler The sampler in which the samples will be recorded.
+ *
+ * @warning This function must not be called concurrently with itself, or with the sampling thread.
+ */
+void plcrash_sampler_sample_threads (plcrash_sampler_t *sampler) {
+    thread_act_array_t threads;
+    mach_msg_type_number_t thread_count;
+    thread_t self = pl_mach_thread_self();
+    kern_return_t kr;
+
+    if ((kr = task_threads(mach_task_self(), &threads, &thread_count)) != KERN_SUCCESS) {
+        PLCF_DEBUG("Fetching thread list failed: %d", kr);
+        return;
+    }
+
+    sampler->_pass++;
+
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+        thread_t thread = threads[i];
+        if (thread == self)
+            continue;
+
+        /* Mark the slot as being written; concurrent readers will discard it until the write completes */
+        int64_t index = sampler->_sample_count;
+        plcrash_sampler_sample_t *sample = plcrash_sampler_slot(sampler, index);
+
+        sample->seq = (index * 2) + 1;
+        OSMemoryBarrier();
+
+        plcrash_sampler_history_t *history = plcrash_sampler_history_lookup(sampler, thread);
+        if (!plcrash_sampler_sample_thread_incremental(sampler->image_list, thread, sampler->max_depth, sampler->full_unwind, history, sample)) {
+            OSAtomicIncrement64(&sampler->_failed_count);
+            continue;
+        }
+
+        /* Publish the sample */
+        OSMemoryBarrier();
+        sample->seq = (index * 2) + 2;
+        OSAtomicIncrement64Barrier(&sampler->_sample_count);
+    }
+
+    /* Clean up the thread array */
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++)
+        mach_port_deallocate(mach_task_self(), threads[i]);
+    vm_deallocate(mach_task_self(), (vm_address_t) threads, sizeof(thread_t) * thread_count);
+}
+
+/**
+ * Return the total number of samples recorded by @a sampler, including samples that have since been overwritten.
+ *
+ * @param sampler The sampler to query.
+ */
+int64_t plcrash_sampler_sample_count (plcrash_sampler_t *sampler) {
+    OSMemoryBarrier();
+    return sampler->_sample_count;
+}
+
+/**
+ * @internal
+ *
+ * Sampling thread entry point.
+ */
+static void *plcrash_sampler_thread (void *arg) {
+    plcrash_sampler_t *sampler = arg;
+
+    while (sampler->_running) {
+        plcrash_sampler_sample_threads(sampler);
+        usleep(sampler->interval_usec);
+    }
+
+    return NULL;
+}
+
+/**
+ * @internal
+ * qsort() comparison function used to group identical samples.
+ */
+static int plcrash_sampler_sample_compare (const void *a, const void *b) {
+    const plcrash_sampler_sample_t *lhs = *(const plcrash_sampler_sample_t * const *) a;
+    const plcrash_sampler_sample_t *rhs = *(const plcrash_sampler_sample_t * const *) b;
+
+    if (lhs->depth != rhs->depth)
+        return lhs->depth < rhs->depth ? -1 : 1;
+
+    for (uint32_t i = 0; i < lhs->depth; i++) {
+        if (lhs->pcs[i] != rhs->pcs[i])
+            return lhs->pcs[i] < rhs->pcs[i] ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @internal
+ *
+ * Write a ProfileReport.Stack message.
+ *
+ * @param file Output file, or NULL to compute the message size.
+ * @param sample The stack.
+ * @param count The number of times the stack was sampled.
+ */
+static size_t plcrash_sampler_write_stack (plcrash_async_file_t *file, const plcrash_sampler_sample_t *sample, uint64_t count) {
+    size_t rv = 0;
+
+    for (uint32_t i = 0; i < sample->depth; i++)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROFILE_STACK_PC_ID, PLPROTOBUF_C_TYPE_UINT64, &sample->pcs[i]);
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROFILE_STACK_COUNT_ID, PLPROTOBUF_C_TYPE_UINT64, &count);
+
+    return rv;
+}
+
+/**
+ * Write the samples currently held by @a sampler to @a file as a ProfileReport message, aggregating identical
+ * call stacks, followed by the binary images of the sampler's image list. The sampler may be running.
+ *
+ * @param sampler The sampler to export.
+ * @param file The output file.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the samples could not be copied.
+ *
+ * @warning This function is not async-safe.
+ */
+plcrash_error_t plcrash_nasync_sampler_write_profile (plcrash_sampler_t *sampler, plcrash_async_file_t *file) {
+    uint8_t *copies;
+    plcrash_sampler_sample_t **sorted;
+    size_t valid = 0;
+
+    /* Copy out all complete samples; any slot modified during the copy is discarded */
+    copies = malloc(sampler->capacity * sampler->_slot_size);
+    sorted = malloc(sampler->capacity * sizeof(sorted[0]));
+    if (copies == NULL || sorted == NULL) {
+        free(copies);
+        free(sorted);
+        return PLCRASH_ENOMEM;
+    }
+
+    int64_t count = plcrash_sampler_sample_count(sampler);
+    int64_t start = count > (int64_t) sampler->capacity ? count - (int64_t) sampler->capacity : 0;
+    for (int64_t i = start; i < count; i++) {
+        plcrash_sampler_sample_t *slot = plcrash_sampler_slot(sampler, i);
+        plcrash_sampler_sample_t *copy = (plcrash_sampler_sample_t *) (copies + (valid * sampler->_slot_size));
+        int64_t expected = (i * 2) + 2;
+
+        if (slot->seq != expected)
+            continue;
+        OSMemoryBarrier();
+
+        memcpy(copy, slot, sampler->_slot_size);
+
+        OSMemoryBarrier();
+        if (slot->seq != expected || copy->depth > sampler->max_depth)
+            continue;
+
+        sorted[valid++] = copy;
+    }
+
+    /* Group identical stacks */
+    qsort(sorted, valid, sizeof(sorted[0]), plcrash_sampler_sample_compare);
+
+    /* Header fields */
+    uint64_t interval = sampler->interval_usec;
+    uint64_t sample_count = valid;
+    uint64_t dropped_count = (uint64_t) (count - (int64_t) valid) + (uint64_t) sampler->_failed_count;
+    plcrash_writer_pack(file, PLCRASH_PROTO_PROFILE_INTERVAL_ID, PLPROTOBUF_C_TYPE_UINT64, &interval);
+    plcrash_writer_pack(file, PLCRASH_PROTO_PROFILE_SAMPLE_COUNT_ID, PLPROTOBUF_C_TYPE_UINT64, &sample_count);
+    plcrash_writer_pack(file, PLCRASH_PROTO_PROFILE_DROPPED_COUNT_ID, PLPROTOBUF_C_TYPE_UINT64, &dropped_count);
+
+    /* Aggregated stacks */
+    for (size_t i = 0; i < valid;) {
+        size_t run = 1;
+        while (i + run < valid && plcrash_sampler_sample_compare(&sorted[i], &sorted[i + run]) == 0)
+            run++;
+
+        uint32_t size = (uint32_t) plcrash_sampler_write_stack(NULL, sorted[i], run);
+        plcrash_writer_pack(file, PLCRASH_PROTO_PROFILE_STACKS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_sampler_write_stack(file, sorted[i], run);
+
+        i += run;
+    }
+
+    free(copies);
+    free(sorted);
+
+    /* Binary images */
+    plcrash_nasync_sampler_write_images(sampler->image_list, file);
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Write a binary image record for every image in @a image_list to @a file, using the pre-encoded messages
+ * where available. The records are written with the CrashReport.binary_images field number, which is shared
+ * by all report messages defined in profile_report.proto.
+ *
+ * @param image_list The image list to be written.
+ * @param file The output file.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_sampler_write_images (plcrash_async_image_list_t *image_list, plcrash_async_file_t *file) {
+    plcrash_async_image_list_set_reading(image_list, true);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
+        void *encoded = image->_encoded;
+        if (encoded != NULL) {
+            plcrash_async_file_write(file, encoded, image->_encoded_length);
+            continue;
+        }
+
+        void *data;
+        size_t length;
+        if (plcrash_log_writer_encode_binary_image(&image->macho_image, &data, &length) == PLCRASH_ESUCCESS) {
+            plcrash_async_file_write(file, data, length);
+            free(data);
+        }
+    }
+    plcrash_async_image_list_set_reading(image_list, false);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashSampler.h"
+#import "PLCrashTestThread.h"
+
+#import <mach-o/dyld.h>
+#import <fcntl.h>
+
+@interface PLCrashSamplerTests : SenTestCase {
+@private
+    /** The image list used for unwinding. */
+    plcrash_async_image_list_t _image_list;
+
+    /** A thread that will be sampled. */
+    plcrash_test_thread_t _thr_args;
+}
+@end
+
+@implementation PLCrashSamplerTests
+
+- (void) setUp {
+    plcrash_nasync_image_list_init(&_image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&_image_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    plcrash_test_thread_spawn(&_thr_args);
+}
+
+- (void) tearDown {
+    plcrash_test_thread_stop(&_thr_args);
+    plcrash_nasync_image_list_free(&_image_list);
+}
+
+/**
+ * Test direct sampling, including overwriting of the oldest samples once the ring buffer is full.
+ */
+- (void) testSampleThreads {
+    plcrash_sampler_t sampler;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_sampler_init(&sampler, &_image_list, 4, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, false), @"Failed to initialize sampler");
+
+    /* At least the test thread must be sampled */
+    plcrash_sampler_sample_threads(&sampler);
+    int64_t count = plcrash_sampler_sample_count(&sampler);
+    STAssertTrue(count > 0, @"No samples were recorded");
+
+    /* Sampling beyond the ring buffer's capacity must succeed */
+    for (int i = 0; i < 4; i++)
+        plcrash_sampler_sample_threads(&sampler);
+    STAssertTrue(plcrash_sampler_sample_count(&sampler) >= count * 5, @"Samples were not recorded");
+
+    plcrash_nasync_sampler_free(&sampler);
+}
+
+/**
+ * Test that an incremental sample of an unchanged stack reuses the previous walk, and matches a full sample.
+ */
+- (void) testSampleThreadIncremental {
+    plcrash_sampler_history_t history;
+    thread_t thread = pthread_mach_thread_np(_thr_args.thread);
+    size_t size = plcrash_sampler_sample_size(PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH);
+    plcrash_sampler_sample_t *full = calloc(1, size);
+    plcrash_sampler_sample_t *sample = calloc(1, size);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_sampler_history_init(&history, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH), @"Failed to initialize history");
+
+    /* The first sample has no previous walk */
+    STAssertTrue(plcrash_sampler_sample_thread_incremental(&_image_list, thread, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, false, &history, sample), @"Failed to sample thread");
+    STAssertEquals(sample->shared_depth, (uint32_t) 0, @"Frames were shared without a previous walk");
+
+    /* The test thread is blocked; its callers must be copied from the previous walk */
+    STAssertTrue(plcrash_sampler_sample_thread_incremental(&_image_list, thread, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, false, &history, sample), @"Failed to sample thread");
+    STAssertTrue(sample->depth == 1 || sample->shared_depth > 0, @"No frames were shared with the previous walk");
+
+    STAssertTrue(plcrash_sampler_sample_thread(&_image_list, thread, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, false, full), @"Failed to sample thread");
+    STAssertEquals(sample->depth, full->depth, @"Incremental sample depth does not match a full sample");
+    STAssertTrue(memcmp(sample->pcs, full->pcs, sizeof(uint64_t) * full->depth) == 0, @"Incremental sample does not match a full sample");
+
+    plcrash_nasync_sampler_history_free(&history);
+    free(full);
+    free(sample);
+}
+
+/**
+ * Test that the callers recorded by the previous walk are not reused when they have changed beneath a frame with an
+ * unchanged PC and stack pointer.
+ */
+- (void) testSampleThreadIncrementalChangedCallers {
+    plcrash_sampler_history_t history;
+    thread_t thread = pthread_mach_thread_np(_thr_args.thread);
+    size_t size = plcrash_sampler_sample_size(PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH);
+    plcrash_sampler_sample_t *full = calloc(1, size);
+    plcrash_sampler_sample_t *sample = calloc(1, size);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_sampler_history_init(&history, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH), @"Failed to initialize history");
+    STAssertTrue(plcrash_sampler_sample_thread_incremental(&_image_list, thread, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, false, &history, sample), @"Failed to sample thread");
+
+    /* Replace the callers recorded by the previous walk, leaving the innermost frame's PC, stack pointer, and frame
+     * pointer unchanged; this is the state observed when the thread re-enters the same function from a different
+     * caller between samples. */
+    for (uint32_t i = 1; i < history.depth; i++)
+        history.pcs[history.bank][i] = 0xBAD00000 + i;
+
+    /* The changed callers must be unwound, rather than copied from the previous walk */
+    STAssertTrue(plcrash_sampler_sample_thread_incremental(&_image_list, thread, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, false, &history, sample), @"Failed to sample thread");
+    STAssertEquals(sample->shared_depth, (uint32_t) 0, @"Frames were shared with a previous walk whose callers changed");
+
+    STAssertTrue(plcrash_sampler_sample_thread(&_image_list, thread, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, false, full), @"Failed to sample thread");
+    STAssertEquals(sample->depth, full->depth, @"Incremental sample depth does not match a full sample");
+    STAssertTrue(memcmp(sample->pcs, full->pcs, sizeof(uint64_t) * full->depth) == 0, @"Incremental sample does not match a full sample");
+
+    plcrash_nasync_sampler_history_free(&history);
+    free(full);
+    free(sample);
+}
+
+/**
+ * Test running the sampling thread, and writing the resulting profile.
+ */
+- (void) testWriteProfile {
+    plcrash_sampler_t sampler;
+    plcrash_async_file_t file;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_sampler_init(&sampler, &_image_list, 256, PLCRASH_SAMPLER_DEFAULT_MAX_DEPTH, true), @"Failed to initialize sampler");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_sampler_start(&sampler, 1000), @"Failed to start sampler");
+
+    /* Wait for at least one sample */
+    for (int i = 0; i < 1000 && plcrash_sampler_sample_count(&sampler) == 0; i++)
+        usleep(1000);
+
+    plcrash_nasync_sampler_stop(&sampler);
+    STAssertTrue(plcrash_sampler_sample_count(&sampler) > 0, @"No samples were recorded");
+
+    /* Write the profile */
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]];
+    int fd = open([path fileSystemRepresentation], O_RDWR|O_CREAT|O_EXCL, 0644);
+    STAssertTrue(fd >= 0, @"Could not open output file");
+
+    plcrash_async_file_init(&file, fd, 0);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_sampler_write_profile(&sampler, &file), @"Failed to write profile");
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    NSData *data = [NSData dataWithContentsOfFile: path];
+    STAssertTrue([data length] > 0, @"No profile data was written");
+
+    [[NSFileManager defaultManager] removeItemAtPath: path error: NULL];
+    plcrash_nasync_sampler_free(&sampler);
+}
+
+@end
@@ -33,6 +33,13 @@ PLCR_C_BEGIN_DECLS
 
 typedef struct PLCrashSignalHandlerCallback PLCrashSignalHandlerCallback;
 
+/**
+ * @internal
+ * The default size of the alternate signal stack, in bytes. The stack must be large enough to generate a crash
+ * report, including DWARF CFA evaluation.
+ */
+#define PLCRASH_SIGNAL_HANDLER_DEFAULT_STACK_SIZE (64 * 1024)
+
 /**
  * @internal
  * Signal handler callback function
@@ -52,10 +59,17 @@ void plcrash_signal_handler (int signo, siginfo_t *info, void *uapVoid);
 
 bool PLCrashSignalHandlerForward (PLCrashSignalHandlerCallback *next, int signal, siginfo_t *info, ucontext_t *uap);
 
+size_t plcrash_signal_handler_stack_size (void);
+size_t plcrash_signal_handler_stack_high_water_mark (void);
+bool plcrash_signal_handler_prefault_stack (bool wire);
+
 @interface PLCrashSignalHandler : NSObject {
 @private
-    /** Signal stack */
+    /** Signal stack. Allocated when the first signal handler is registered. */
     stack_t _sigstk;
+
+    /** The requested signal stack size, in bytes. */
+    size_t _signalStackSize;
 }
 
 
@@ -63,6 +77,8 @@ bool PLCrashSignalHandlerForward (PLCrashSignalHandlerCallback *next, int signal
 
 + (void) resetHandlers;
 
+- (void) setSignalStackSize: (size_t) size;
+
 - (BOOL) registerHandlerForSignal: (int) signo
                          callback: (PLCrashSignalHandlerCallbackFunc) callback
                           context: (void *) context
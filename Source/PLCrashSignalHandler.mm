@@ -32,12 +32,11 @@
 #import "PLCrashFrameWalker.h"
 #import "PLCrashReporterNSError.h"
 
-#import "PLCrashAsyncLinkedList.hpp"
-
 #import <signal.h>
 #import <unistd.h>
-
-using namespace plcrash::async;
+#import <mach/mach.h>
+#import <libkern/OSAtomic.h>
+#import <pthread.h>
 
 /**
  * @internal
@@ -77,116 +76,158 @@ struct PLCrashSignalHandlerCallback {
  * global signal handler.
  */
 struct plcrash_signal_handler_action {
-    /** Signal type. */
-    int signo;
+    /** If true, our handler has been registered for the signal, and @a action holds the action it replaced. */
+    bool registered;
     
     /** Signal handler action. */
     struct sigaction action;
 };
 
+/**
+ * @internal
+ *
+ * An immutable snapshot of the registered callbacks and previous signal actions, as dispatched by
+ * plcrash_signal_handler(). Registration builds and atomically publishes a new table; a published table is
+ * never modified or deallocated, allowing a signal to be dispatched without list traversal or reference counting.
+ */
+struct plcrash_signal_dispatch_table {
+    /** The originally registered signal handlers, indexed by signal number. */
+    plcrash_signal_handler_action previous_actions[NSIG];
+
+    /** The number of registered callbacks, excluding the trailing pass-through and terminator entries. */
+    size_t count;
+
+    /** The registered callbacks in dispatch order, followed by the pass-through to the previous actions, and a
+     * terminating entry with a NULL callback. The array is allocated with space for all entries. */
+    plcrash_signal_user_callback callbacks[2];
+};
+
 /**
  * Signal handler context that must be global for async-safe
  * access.
  */
 static struct {
     /** @internal
-     * Registered callbacks. */
-    async_list<plcrash_signal_user_callback> callbacks;
-    
+     * The current dispatch table, or NULL if no handlers have been registered. This value should only be
+     * replaced with registration_lock held. Superseded tables are never deallocated, as a signal may still be
+     * dispatching through them; registration occurs only a handful of times per process. */
+    plcrash_signal_dispatch_table * volatile dispatch;
+
+    /** @internal
+     * The usable base (lowest) address of the installed alternate signal stack, or NULL if no stack has been installed. */
+    volatile uint8_t *stack_base;
+
     /** @internal
-     * Originaly registered signal handlers. This list should only be mutated in
-     * -[PLCrashSignalHandler registerHandlerWithSignal:error:] with the appropriate locks held. */
-    async_list<plcrash_signal_handler_action> previous_actions;
+     * The usable size of the installed alternate signal stack, in bytes. */
+    size_t stack_size;
 } shared_handler_context;
 
+/** The lock used to serialize registration, and any replacement of the shared dispatch table. */
+static pthread_mutex_t registration_lock = PTHREAD_MUTEX_INITIALIZER;
+
 /*
- * Finds and executes the first matching signal handler in the shared previous_actions list; this is used
- * to support executing process-wide POSIX signal handlers that were previously registered before being replaced by
- * PLCrashSignalHandler::registerHandlerForSignal:.
+ * Executes the previously registered signal handler for signo, if any, as found in the dispatch table provided as
+ * 'context'; this is used to support executing process-wide POSIX signal handlers that were previously registered
+ * before being replaced by PLCrashSignalHandler::registerHandlerForSignal:.
  */
 static bool previous_action_callback (int signo, siginfo_t *info, ucontext_t *uap, void *context, PLCrashSignalHandlerCallback *next) {
-    bool handled = false;
+    const plcrash_signal_dispatch_table *table = (const plcrash_signal_dispatch_table *) context;
 
     /* Let any additional handler execute */
     if (PLCrashSignalHandlerForward(next, signo, info, uap))
         return true;
 
-    shared_handler_context.previous_actions.set_reading(true); {
-        /* Find the first matching handler */
-        async_list<plcrash_signal_handler_action>::node *next = NULL;
-        while ((next = shared_handler_context.previous_actions.next(next)) != NULL) {
-            /* Skip non-matching entries */
-            if (next->value().signo != signo)
-                continue;
-
-            /* Found a match */
-            // TODO - Should we handle the other flags, eg, SA_RESETHAND, SA_ONSTACK? */
-            if (next->value().action.sa_flags & SA_SIGINFO) {
-                next->value().action.sa_sigaction(signo, info, (void *) uap);
-                handled = true;
-            } else {
-                switch ((uintptr_t) (next->value().action.sa_handler)) {
-                    case ((uintptr_t) SIG_IGN):
-                        /* Ignored */
-                        handled = true;
-                        break;
-                        
-                    case ((uintptr_t) SIG_DFL):
-                        /* Default handler should be run, be we have no mechanism to pass through to
-                         * the default handler; mark the signal as unhandled. */
-                        handled = false;
-                        break;
-                        
-                    default:
-                        /* Handler registered, execute it */
-                        next->value().action.sa_handler(signo);
-                        handled = true;
-                        break;
-                }
-            }
-            
-            /* Handler was found; iteration done */
-            break;
-        }
-    } shared_handler_context.previous_actions.set_reading(false);
+    if (signo <= 0 || signo >= NSIG || !table->previous_actions[signo].registered)
+        return false;
 
-    return handled;
+    // TODO - Should we handle the other flags, eg, SA_RESETHAND, SA_ONSTACK? */
+    const struct sigaction *action = &table->previous_actions[signo].action;
+    if (action->sa_flags & SA_SIGINFO) {
+        action->sa_sigaction(signo, info, (void *) uap);
+        return true;
+    }
+
+    switch ((uintptr_t) (action->sa_handler)) {
+        case ((uintptr_t) SIG_IGN):
+            /* Ignored */
+            return true;
+
+        case ((uintptr_t) SIG_DFL):
+            /* Default handler should be run, be we have no mechanism to pass through to
+             * the default handler; mark the signal as unhandled. */
+            return false;
+
+        default:
+            /* Handler registered, execute it */
+            action->sa_handler(signo);
+            return true;
+    }
 }
 
 /*
- * Recursively iterates the actual callbacks registered in our shared_handler_context. To begin iteration,
- * provide a value of NULL for 'context'.
+ * Iterates the callbacks of a dispatch table, beginning with the entry provided as 'context'. The final entry
+ * of the table is marked by a NULL callback.
  */
 static bool internal_callback_iterator (int signo, siginfo_t *info, ucontext_t *uap, void *context) {
-    /* Call the next handler in the chain. If this is the last handler in the chain, pass it the original signal
-     * handlers. */
-    bool handled = false;
-    shared_handler_context.callbacks.set_reading(true); {
-        async_list<plcrash_signal_user_callback>::node *prev = (async_list<plcrash_signal_user_callback>::node *) context;
-        async_list<plcrash_signal_user_callback>::node *current = shared_handler_context.callbacks.next(prev);
-
-        /* Check for end-of-list */
-        if (current == NULL) {
-            shared_handler_context.callbacks.set_reading(false);
-            return false;
-        }
-        
-        /* Check if any additional handlers are registered. If so, provide the next handler as the forwarding target. */
-        if (shared_handler_context.callbacks.next(current) != NULL) {
-            PLCrashSignalHandlerCallback next_handler = {
-                .callback = internal_callback_iterator,
-                .context = current
-            };
-            handled = current->value().callback(signo, info, uap, current->value().context, &next_handler);
-        } else {
-            /* Otherwise, we've hit the final handler in the list. */
-            handled = current->value().callback(signo, info, uap, current->value().context, NULL);
-        }
-    } shared_handler_context.callbacks.set_reading(false);
+    const plcrash_signal_user_callback *current = (const plcrash_signal_user_callback *) context;
+
+    /* Check for end-of-table */
+    if (current->callback == NULL)
+        return false;
+
+    /* Check if any additional handlers are registered. If so, provide the next handler as the forwarding target. */
+    const plcrash_signal_user_callback *next = current + 1;
+    if (next->callback != NULL) {
+        PLCrashSignalHandlerCallback next_handler = {
+            .callback = internal_callback_iterator,
+            .context = (void *) next
+        };
+        return current->callback(signo, info, uap, current->context, &next_handler);
+    }
 
-    return handled;
+    /* Otherwise, we've hit the final handler in the table. */
+    return current->callback(signo, info, uap, current->context, NULL);
 };
 
+/*
+ * Allocate a copy of the dispatch table 'source' (or an empty table, if NULL), with 'prepend' unpopulated callback
+ * entries preceding the copied callbacks. Returns NULL if the table could not be allocated. The table must be
+ * published via dispatch_table_publish(). This must be called with registration_lock held.
+ */
+static plcrash_signal_dispatch_table *dispatch_table_copy (const plcrash_signal_dispatch_table *source, size_t prepend) {
+    size_t count = prepend + (source != NULL ? source->count : 0);
+
+    /* The structure's callback array has space for the pass-through and terminator entries */
+    plcrash_signal_dispatch_table *table;
+    table = (plcrash_signal_dispatch_table *) calloc(1, sizeof(*table) + (sizeof(table->callbacks[0]) * count));
+    if (table == NULL)
+        return NULL;
+
+    table->count = count;
+    if (source != NULL) {
+        memcpy(table->previous_actions, source->previous_actions, sizeof(table->previous_actions));
+        memcpy(&table->callbacks[prepend], source->callbacks, sizeof(source->callbacks[0]) * source->count);
+    }
+
+    return table;
+}
+
+/*
+ * Terminate and atomically publish the dispatch table 'table', replacing the current table. This must be called
+ * with registration_lock held.
+ */
+static void dispatch_table_publish (plcrash_signal_dispatch_table *table) {
+    /* Add the pass-through sigaction callback as the last element in the callback table. */
+    table->callbacks[table->count].callback = previous_action_callback;
+    table->callbacks[table->count].context = table;
+    table->callbacks[table->count + 1].callback = NULL;
+    table->callbacks[table->count + 1].context = NULL;
+
+    /* The table must be fully populated before it is visible to the signal handler */
+    OSMemoryBarrier();
+    shared_handler_context.dispatch = table;
+}
+
 /** 
  * @internal
  *
@@ -201,7 +242,8 @@ void plcrash_signal_handler (int signo, siginfo_t *info, void *uapVoid) {
     /* Start iteration; we currently re-raise the signal if not handled by callbacks; this should be revisited
      * in the future, as the signal may not be raised on the expected thread.
      */
-    if (!internal_callback_iterator(signo, info, (ucontext_t *) uapVoid, NULL))
+    plcrash_signal_dispatch_table *table = shared_handler_context.dispatch;
+    if (table == NULL || !internal_callback_iterator(signo, info, (ucontext_t *) uapVoid, &table->callbacks[0]))
         raise(signo);
 }
 
@@ -226,6 +268,62 @@ bool PLCrashSignalHandlerForward (PLCrashSignalHandlerCallback *next, int sig, s
     return next->callback(sig, info, uap, next->context);
 }
 
+/**
+ * Return the size of the installed alternate signal stack in bytes, or 0 if no stack has been installed.
+ *
+ * @note This function is async-safe.
+ */
+size_t plcrash_signal_handler_stack_size (void) {
+    if (shared_handler_context.stack_base == NULL)
+        return 0;
+
+    return shared_handler_context.stack_size;
+}
+
+/**
+ * Return the maximum number of bytes of the alternate signal stack that have been used since the stack was installed,
+ * or 0 if no stack has been installed.
+ *
+ * The stack is allocated zero-filled; the high-water mark is found by scanning upwards from the stack's lowest address
+ * for the first non-zero word. Zero-valued data written at the very deepest point of use will not be counted, and the
+ * value is thus a close lower bound.
+ *
+ * @note This function is async-safe.
+ */
+size_t plcrash_signal_handler_stack_high_water_mark (void) {
+    volatile uint8_t *base = shared_handler_context.stack_base;
+    if (base == NULL)
+        return 0;
+
+    size_t size = shared_handler_context.stack_size;
+    const volatile uintptr_t *word = (const volatile uintptr_t *) base;
+    size_t count = size / sizeof(*word);
+
+    for (size_t i = 0; i < count; i++) {
+        if (word[i] != 0)
+            return size - (i * sizeof(*word));
+    }
+
+    return 0;
+}
+
+/**
+ * Fault in the installed alternate signal stack, and optionally wire it into memory, such that the crash handler
+ * does not incur a page fault on each first use of a stack page. The stack's zero-filled contents are not modified,
+ * and do not affect plcrash_signal_handler_stack_high_water_mark().
+ *
+ * @param wire If true, the stack is additionally wired via mlock().
+ *
+ * @return Returns true on success, or false if no stack has been installed or the stack could not be wired.
+ */
+bool plcrash_signal_handler_prefault_stack (bool wire) {
+    volatile uint8_t *base = shared_handler_context.stack_base;
+    if (base == NULL)
+        return false;
+
+    return plcrash_nasync_prefault((const void *) base, shared_handler_context.stack_size, wire) == PLCRASH_ESUCCESS;
+}
+
 /***
  * @internal
  *
@@ -261,19 +359,11 @@ static PLCrashSignalHandler *sharedHandler;
  * and should be avoided in production code.
  */
 + (void) resetHandlers {
-    /* Reset all saved signal handlers */
-    shared_handler_context.previous_actions.set_reading(true); {
-        async_list<plcrash_signal_handler_action>::node *next = NULL;
-        while ((next = shared_handler_context.previous_actions.next(next)) != NULL)
-            shared_handler_context.previous_actions.nasync_remove_node(next);
-    } shared_handler_context.previous_actions.set_reading(false);
-
-    /* Reset all callbacks */
-    shared_handler_context.callbacks.set_reading(true); {
-        async_list<plcrash_signal_user_callback>::node *next = NULL;
-        while ((next = shared_handler_context.callbacks.next(next)) != NULL)
-            shared_handler_context.callbacks.nasync_remove_node(next);
-    } shared_handler_context.callbacks.set_reading(false);
+    /* Reset all saved signal handlers and callbacks */
+    pthread_mutex_lock(&registration_lock); {
+        OSMemoryBarrier();
+        shared_handler_context.dispatch = NULL;
+    } pthread_mutex_unlock(&registration_lock);
 }
 
 /**
@@ -285,27 +375,73 @@ static PLCrashSignalHandler *sharedHandler;
     if ((self = [super init]) == nil)
         return nil;
     
-    /* Set up an alternate signal stack for crash dumps. Only 64k is reserved, and the
-     * crash dump path must be sparing in its use of stack space. */
-    _sigstk.ss_size = MAX(MINSIGSTKSZ, 64 * 1024);
-    _sigstk.ss_sp = malloc(_sigstk.ss_size);
+    /* The alternate signal stack is allocated on first registration, allowing the size to be configured */
+    _signalStackSize = PLCRASH_SIGNAL_HANDLER_DEFAULT_STACK_SIZE;
+    _sigstk.ss_sp = NULL;
+    _sigstk.ss_size = 0;
     _sigstk.ss_flags = 0;
 
-    /* (Unlikely) malloc failure */
-    if (_sigstk.ss_sp == NULL) {
-        [self release];
-        return nil;
+    return self;
+}
+
+/**
+ * Set the size of the alternate signal stack on which crash reports are written. The crash dump path must be sparing
+ * in its use of stack space; the measured usage is available via plcrash_signal_handler_stack_high_water_mark(), and
+ * is recorded in instrumented reports.
+ *
+ * @param size The stack size in bytes, or 0 to use PLCRASH_SIGNAL_HANDLER_DEFAULT_STACK_SIZE. The size will be
+ * rounded up to at least MINSIGSTKSZ, and to a multiple of the page size.
+ *
+ * @warning The stack is installed when the first signal handler is registered; once installed, the size may not be
+ * changed, and this method will have no effect.
+ */
+- (void) setSignalStackSize: (size_t) size {
+    if (size == 0)
+        size = PLCRASH_SIGNAL_HANDLER_DEFAULT_STACK_SIZE;
+
+    _signalStackSize = size;
+}
+
+/**
+ * Allocate the alternate signal stack. The stack is preceded by an inaccessible guard page, such that an overflow
+ * of the stack will fault rather than silently corrupt adjacent memory.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the stack could not be allocated.
+ */
+- (BOOL) allocateSignalStackAndReturnError: (NSError **) outError {
+    vm_size_t stack_size = round_page(MAX(MINSIGSTKSZ, _signalStackSize));
+    vm_address_t addr;
+    kern_return_t kr;
+
+    /* The zero-filled allocation doubles as stack 'paint'; see plcrash_signal_handler_stack_high_water_mark() */
+    kr = vm_allocate(mach_task_self(), &addr, stack_size + PAGE_SIZE, VM_FLAGS_ANYWHERE);
+    if (kr != KERN_SUCCESS) {
+        plcrash_populate_mach_error(outError, kr, @"Could not allocate the alternative signal stack");
+        return NO;
     }
 
-    return self;
+    /* The stack grows down; protect the lowest page */
+    kr = vm_protect(mach_task_self(), addr, PAGE_SIZE, false, VM_PROT_NONE);
+    if (kr != KERN_SUCCESS) {
+        vm_deallocate(mach_task_self(), addr, stack_size + PAGE_SIZE);
+        plcrash_populate_mach_error(outError, kr, @"Could not protect the alternative signal stack guard page");
+        return NO;
+    }
+
+    _sigstk.ss_sp = (void *) (addr + PAGE_SIZE);
+    _sigstk.ss_size = stack_size;
+    _sigstk.ss_flags = 0;
+
+    return YES;
 }
 
 /**
  * Register a signal handler for the given @a signo, if not yet registered. If a handler has already been registered,
  * no changes will be made to the existing handler.
  *
- * We register only one signal handler for any given signal number; All instances share the same async-safe/thread-safe
- * ordered list of callbacks.
+ * We register only one signal handler for any given signal number; All instances share the same immutable, atomically
+ * replaced dispatch table of callbacks.
  *
  * @param signo The signal number for which a handler should be registered.
  * @param outError A pointer to an NSError object variable. If an error occurs, this
@@ -313,8 +449,12 @@ static PLCrashSignalHandler *sharedHandler;
  * registered. If no error occurs, this parameter will be left unmodified.
  */
 - (BOOL) registerHandlerWithSignal: (int) signo error: (NSError **) outError {
-    static pthread_mutex_t registerHandlers = PTHREAD_MUTEX_INITIALIZER;
-    pthread_mutex_lock(&registerHandlers); {
+    if (signo <= 0 || signo >= NSIG) {
+        plcrash_populate_posix_error(outError, EINVAL, @"Invalid signal number");
+        return NO;
+    }
+
+    pthread_mutex_lock(&registration_lock); {
         static BOOL singleShotInitialization = NO;
 
         /* Perform operations that only need to be done once per process.
@@ -327,40 +467,41 @@ static PLCrashSignalHandler *sharedHandler;
              * For now, this supports the legacy behavior of registering a signal stack on the thread on
              * which the signal handlers are enabled.
              */
+            if (_sigstk.ss_sp == NULL && ![self allocateSignalStackAndReturnError: outError]) {
+                pthread_mutex_unlock(&registration_lock);
+                return NO;
+            }
+
             if (sigaltstack(&_sigstk, 0) < 0) {
                 /* This should only fail if we supply invalid arguments to sigaltstack() */
                 plcrash_populate_posix_error(outError, errno, @"Could not initialize alternative signal stack");
+                pthread_mutex_unlock(&registration_lock);
                 return NO;
             }
-            
-            /*
-             * Add the pass-through sigaction callback as the last element in the callback list.
-             */
-            plcrash_signal_user_callback sa = {
-                .callback = previous_action_callback,
-                .context = NULL
-            };
-            shared_handler_context.callbacks.nasync_append(sa);
+
+            /* Make the stack available for usage measurement */
+            shared_handler_context.stack_size = _sigstk.ss_size;
+            OSMemoryBarrier();
+            shared_handler_context.stack_base = (volatile uint8_t *) _sigstk.ss_sp;
         }
         
         /* Check whether the signal already has a registered handler. */
-        BOOL isRegistered = NO;
-        shared_handler_context.previous_actions.set_reading(true); {
-            /* Find the first matching handler */
-            async_list<plcrash_signal_handler_action>::node *next = NULL;
-            while ((next = shared_handler_context.previous_actions.next(next)) != NULL) {
-                if (next->value().signo == signo) {
-                    isRegistered = YES;
-                    break;
-                }
-            }
-        } shared_handler_context.previous_actions.set_reading(false);
+        plcrash_signal_dispatch_table *current = shared_handler_context.dispatch;
+        BOOL isRegistered = (current != NULL && current->previous_actions[signo].registered);
 
         /* Register handler for the requested signal */
         if (!isRegistered) {
             struct sigaction sa;
             struct sigaction sa_prev;
             
+            /* Allocate the updated dispatch table prior to modifying the signal's action */
+            plcrash_signal_dispatch_table *table = dispatch_table_copy(current, 0);
+            if (table == NULL) {
+                plcrash_populate_posix_error(outError, ENOMEM, @"Could not allocate the signal dispatch table");
+                pthread_mutex_unlock(&registration_lock);
+                return NO;
+            }
+
             /* Configure action */
             memset(&sa, 0, sizeof(sa));
             sa.sa_flags = SA_SIGINFO|SA_ONSTACK;
@@ -370,7 +511,9 @@ static PLCrashSignalHandler *sharedHandler;
             /* Set new sigaction */
             if (sigaction(signo, &sa, &sa_prev) != 0) {
                 int err = errno;
+                free(table);
                 plcrash_populate_posix_error(outError, err, @"Failed to register signal handler");
+                pthread_mutex_unlock(&registration_lock);
                 return NO;
             }
             
@@ -381,13 +524,11 @@ static PLCrashSignalHandler *sharedHandler;
              * TODO - Investigate use of async-safe locking to avoid this condition. See also:
              * The PLCrashReporter class's enabling of Mach exceptions.
              */
-            plcrash_signal_handler_action act = {
-                .signo = signo,
-                .action = sa_prev
-            };
-            shared_handler_context.previous_actions.nasync_append(act);
+            table->previous_actions[signo].registered = true;
+            table->previous_actions[signo].action = sa_prev;
+            dispatch_table_publish(table);
         }
-    } pthread_mutex_unlock(&registerHandlers);
+    } pthread_mutex_unlock(&registration_lock);
     
     return YES;
 }
@@ -417,12 +558,19 @@ static PLCrashSignalHandler *sharedHandler;
     if (![self registerHandlerWithSignal: signo error: outError])
         return NO;
     
-    /* Add the new callback to the shared state list. */
-    plcrash_signal_user_callback reg = {
-        .callback = callback,
-        .context = context
-    };
-    shared_handler_context.callbacks.nasync_prepend(reg);
+    /* Prepend the new callback to a copy of the shared dispatch table, and publish the copy. */
+    pthread_mutex_lock(&registration_lock); {
+        plcrash_signal_dispatch_table *table = dispatch_table_copy(shared_handler_context.dispatch, 1);
+        if (table == NULL) {
+            plcrash_populate_posix_error(outError, ENOMEM, @"Could not allocate the signal dispatch table");
+            pthread_mutex_unlock(&registration_lock);
+            return NO;
+        }
+
+        table->callbacks[0].callback = callback;
+        table->callbacks[0].context = context;
+        dispatch_table_publish(table);
+    } pthread_mutex_unlock(&registration_lock);
     
     return YES;
 }
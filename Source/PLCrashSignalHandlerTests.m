@@ -71,6 +71,31 @@ static bool crash_callback (int signal, siginfo_t *siginfo, ucontext_t *uap, voi
     STAssertNotEquals(action.sa_handler, SIG_DFL, @"Action not registered for SIGBUS");
 }
 
+/**
+ * Verify that registration installs a signal stack, and that its usage may be measured.
+ */
+- (void) testSignalStack {
+    NSError *error;
+
+    STAssertTrue([[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: SIGBUS
+                                                                       callback: &crash_callback
+                                                                        context: NULL
+                                                                          error: &error], @"Could not register signal handler: %@", error);
+
+    size_t size = plcrash_signal_handler_stack_size();
+    STAssertTrue(size >= PLCRASH_SIGNAL_HANDLER_DEFAULT_STACK_SIZE, @"Signal stack is smaller than the default size");
+    STAssertEquals(size % PAGE_SIZE, (size_t) 0, @"Signal stack size is not page-aligned");
+    STAssertTrue(plcrash_signal_handler_stack_high_water_mark() <= size, @"High-water mark exceeds the stack size");
+
+    /* The stack is only installed once; later size changes must not take effect */
+    [[PLCrashSignalHandler sharedHandler] setSignalStackSize: size * 2];
+    STAssertTrue([[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: SIGBUS
+                                                                       callback: &crash_callback
+                                                                        context: NULL
+                                                                          error: &error], @"Could not register signal handler: %@", error);
+    STAssertEquals(plcrash_signal_handler_stack_size(), size, @"Signal stack was reallocated");
+}
+
 static void sa_action_cb (int signo, siginfo_t *info, void *uapVoid) {
     /* Note that we ran */
     crash_page[1] = 0xFB;
@@ -146,5 +171,63 @@ static void sa_handler_cb (int signo) {
     STAssertEquals(crash_page[1], (uint8_t)0xF0, @"Signal handler did not run");
 }
 
+static bool dispatch_order_cb (int signal, siginfo_t *siginfo, ucontext_t *uap, void *context, PLCrashSignalHandlerCallback *next) {
+    /* Record our position in the dispatch order */
+    uint8_t *position = (uint8_t *) context;
+    *position = ++crash_page[2];
+
+    return PLCrashSignalHandlerForward(next, signal, siginfo, uap);
+}
+
+/**
+ * Verify that callbacks are dispatched in reverse registration order, and that each signal is passed through to
+ * its own previously registered handler.
+ */
+- (void) testCallbackDispatchOrder {
+    NSError *error;
+    uint8_t earlier = 0;
+    uint8_t later = 0;
+    crash_page[1] = 0;
+    crash_page[2] = 0;
+
+    /* Register a standard POSIX handler for SIGBUS only */
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sa_handler_cb;
+    sigemptyset(&sa.sa_mask);
+    STAssertEquals(0, sigaction(SIGBUS, &sa, NULL), @"Failed to set signal handler: %s", strerror(errno));
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = SIG_IGN;
+    sigemptyset(&sa.sa_mask);
+    STAssertEquals(0, sigaction(SIGUSR2, &sa, NULL), @"Failed to set signal handler: %s", strerror(errno));
+
+    /* Register our callbacks */
+    STAssertTrue([[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: SIGBUS
+                                                                       callback: &dispatch_order_cb
+                                                                        context: &earlier
+                                                                          error: &error], @"Could not register signal handler: %@", error);
+    STAssertTrue([[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: SIGUSR2
+                                                                       callback: &dispatch_order_cb
+                                                                        context: &later
+                                                                          error: &error], @"Could not register signal handler: %@", error);
+
+    /* The most recently registered callback runs first, followed by the signal's original handler */
+    siginfo_t si;
+    ucontext_t uc;
+    plcrash_signal_handler(SIGBUS, &si, &uc);
+
+    STAssertEquals(later, (uint8_t) 1, @"The most recently registered callback did not run first");
+    STAssertEquals(earlier, (uint8_t) 2, @"The earlier callback did not run second");
+    STAssertEquals(crash_page[1], (uint8_t)0xF0, @"Signal handler did not run");
+
+    /* SIGUSR2's original action (ignored) must not invoke the SIGBUS handler */
+    crash_page[1] = 0;
+    plcrash_signal_handler(SIGUSR2, &si, &uc);
+    STAssertEquals(crash_page[1], (uint8_t) 0, @"The wrong original handler was run");
+
+    /* Restore the default action */
+    signal(SIGUSR2, SIG_DFL);
+}
 
 @end
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashSymbolResolutionCache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_symbol_resolution_cache
+ * @{
+ */
+
+/** The initial number of slots allocated for a shard. */
+#define INITIAL_CAPACITY 256
+
+/**
+ * Return the hash of (@a uuid, @a offset), using the 64-bit FNV-1a hash, followed by a final mixing step so that
+ * both the low bits (used to select a slot) and high bits (used to select a shard) are well distributed.
+ */
+static uint64_t resolution_hash (const uint8_t uuid[16], uint64_t offset) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < 16; i++) {
+        hash ^= uuid[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+        hash ^= (uint8_t) (offset >> (i * 8));
+        hash *= 0x100000001b3ULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * Return the shard for @a hash.
+ */
+static inline plcrash_symbol_resolution_shard_t *resolution_shard (plcrash_symbol_resolution_cache_t *cache, uint64_t hash) {
+    return &cache->shards[(hash >> 58) & (PLCRASH_SYMBOL_RESOLUTION_CACHE_SHARDS - 1)];
+}
+
+/**
+ * Return the slot of @a shard containing (@a uuid, @a offset), or the empty slot at which it would be inserted.
+ * The shard must be locked, and must have a non-zero capacity.
+ */
+static plcrash_symbol_resolution_entry_t *resolution_slot (plcrash_symbol_resolution_shard_t *shard, uint64_t hash, const uint8_t uuid[16], uint64_t offset) {
+    size_t mask = shard->capacity - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        plcrash_symbol_resolution_entry_t *entry = &shard->entries[i];
+        if (!entry->used)
+            return entry;
+
+        if (entry->offset == offset && memcmp(entry->uuid, uuid, sizeof(entry->uuid)) == 0)
+            return entry;
+    }
+}
+
+/**
+ * Double the capacity of @a shard, which must be locked.
+ */
+static plcrash_error_t resolution_grow (plcrash_symbol_resolution_shard_t *shard) {
+    size_t capacity = shard->capacity == 0 ? INITIAL_CAPACITY : shard->capacity * 2;
+    plcrash_symbol_resolution_entry_t *entries = calloc(capacity, sizeof(*entries));
+    if (entries == NULL)
+        return PLCRASH_ENOMEM;
+
+    plcrash_symbol_resolution_shard_t resized = *shard;
+    resized.entries = entries;
+    resized.capacity = capacity;
+
+    for (size_t i = 0; i < shard->capacity; i++) {
+        plcrash_symbol_resolution_entry_t *entry = &shard->entries[i];
+        if (!entry->used)
+            continue;
+
+        *resolution_slot(&resized, resolution_hash(entry->uuid, entry->offset), entry->uuid, entry->offset) = *entry;
+    }
+
+    free(shard->entries);
+    shard->entries = entries;
+    shard->capacity = capacity;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Initialize an empty cache.
+ *
+ * @param cache The cache to initialize.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINTERNAL if the shard locks could not be initialized.
+ */
+plcrash_error_t plcrash_symbol_resolution_cache_init (plcrash_symbol_resolution_cache_t *cache) {
+    memset(cache, 0, sizeof(*cache));
+
+    for (size_t i = 0; i < PLCRASH_SYMBOL_RESOLUTION_CACHE_SHARDS; i++) {
+        if (pthread_mutex_init(&cache->shards[i].lock, NULL) != 0) {
+            while (i-- > 0)
+                pthread_mutex_destroy(&cache->shards[i].lock);
+            return PLCRASH_EINTERNAL;
+        }
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Look up the cached resolution of @a offset within the image identified by @a uuid. This may be called concurrently
+ * from any thread.
+ *
+ * @param cache The cache.
+ * @param uuid The image UUID.
+ * @param offset The image-relative address.
+ * @param[out] resolution If the address is cached, its resolution. The resolution's name is NULL if the address was
+ * cached as unresolvable.
+ *
+ * @return Returns true if a resolution (or failure to resolve) was cached for the address.
+ */
+bool plcrash_symbol_resolution_cache_lookup (plcrash_symbol_resolution_cache_t *cache, const uint8_t uuid[16], uint64_t offset,
+                                             plcrash_symbol_resolution_t *resolution)
+{
+    uint64_t hash = resolution_hash(uuid, offset);
+    plcrash_symbol_resolution_shard_t *shard = resolution_shard(cache, hash);
+    bool found = false;
+
+    pthread_mutex_lock(&shard->lock);
+    if (shard->capacity > 0) {
+        plcrash_symbol_resolution_entry_t *entry = resolution_slot(shard, hash, uuid, offset);
+        if (entry->used) {
+            *resolution = entry->resolution;
+            found = true;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    return found;
+}
+
+/**
+ * Cache the resolution of @a offset within the image identified by @a uuid, replacing any existing entry. This may be
+ * called concurrently from any thread.
+ *
+ * @param cache The cache.
+ * @param uuid The image UUID.
+ * @param offset The image-relative address.
+ * @param resolution The address's resolution. If the resolution's name is NULL, the address is cached as
+ * unresolvable, and all other fields are ignored; if its file is NULL, its line is ignored.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the entry could not be allocated.
+ */
+plcrash_error_t plcrash_symbol_resolution_cache_insert (plcrash_symbol_resolution_cache_t *cache, const uint8_t uuid[16], uint64_t offset,
+                                                        const plcrash_symbol_resolution_t *resolution)
+{
+    uint64_t hash = resolution_hash(uuid, offset);
+    plcrash_symbol_resolution_shard_t *shard = resolution_shard(cache, hash);
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+
+    pthread_mutex_lock(&shard->lock);
+
+    /* Keep the load factor at or below one half */
+    if ((shard->count + 1) * 2 > shard->capacity && (err = resolution_grow(shard)) != PLCRASH_ESUCCESS) {
+        pthread_mutex_unlock(&shard->lock);
+        return err;
+    }
+
+    plcrash_symbol_resolution_entry_t *entry = resolution_slot(shard, hash, uuid, offset);
+    if (!entry->used) {
+        memcpy(entry->uuid, uuid, sizeof(entry->uuid));
+        entry->offset = offset;
+        entry->used = true;
+        shard->count++;
+    }
+
+    memset(&entry->resolution, 0, sizeof(entry->resolution));
+    if (resolution->name != NULL) {
+        entry->resolution = *resolution;
+        if (resolution->file == NULL)
+            entry->resolution.line = 0;
+    }
+
+    pthread_mutex_unlock(&shard->lock);
+    return err;
+}
+
+/**
+ * Remove all cached resolutions of addresses within the image identified by @a uuid. This must be called before the
+ * image's symbol store is closed, and may be called concurrently from any thread.
+ *
+ * @param cache The cache.
+ * @param uuid The image UUID.
+ */
+void plcrash_symbol_resolution_cache_remove_image (plcrash_symbol_resolution_cache_t *cache, const uint8_t uuid[16]) {
+    for (size_t i = 0; i < PLCRASH_SYMBOL_RESOLUTION_CACHE_SHARDS; i++) {
+        plcrash_symbol_resolution_shard_t *shard = &cache->shards[i];
+
+        pthread_mutex_lock(&shard->lock);
+        if (shard->count == 0) {
+            pthread_mutex_unlock(&shard->lock);
+            continue;
+        }
+
+        /* Rebuild the shard from the remaining entries; removing entries in place would break the probe sequences
+         * of those that follow them. If the new table can't be allocated, the shard is emptied instead. */
+        plcrash_symbol_resolution_shard_t rebuilt = *shard;
+        rebuilt.entries = calloc(shard->capacity, sizeof(*rebuilt.entries));
+        rebuilt.count = 0;
+
+        for (size_t j = 0; rebuilt.entries != NULL && j < shard->capacity; j++) {
+            plcrash_symbol_resolution_entry_t *entry = &shard->entries[j];
+            if (!entry->used || memcmp(entry->uuid, uuid, sizeof(entry->uuid)) == 0)
+                continue;
+
+            *resolution_slot(&rebuilt, resolution_hash(entry->uuid, entry->offset), entry->uuid, entry->offset) = *entry;
+            rebuilt.count++;
+        }
+
+        free(shard->entries);
+        shard->entries = rebuilt.entries;
+        shard->capacity = rebuilt.entries != NULL ? rebuilt.capacity : 0;
+        shard->count = rebuilt.count;
+
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+/**
+ * Free all resources associated with @a cache.
+ */
+void plcrash_symbol_resolution_cache_free (plcrash_symbol_resolution_cache_t *cache) {
+    for (size_t i = 0; i < PLCRASH_SYMBOL_RESOLUTION_CACHE_SHARDS; i++) {
+        pthread_mutex_destroy(&cache->shards[i].lock);
+        free(cache->shards[i].entries);
+    }
+}
+
+/**
+ * @}
+ */
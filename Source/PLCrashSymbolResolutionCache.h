@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_SYMBOL_RESOLUTION_CACHE_H
+#define PLCRASH_SYMBOL_RESOLUTION_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_symbol_resolution_cache Symbol Resolution Cache
+ * @ingroup plcrash_internal
+ *
+ * A concurrent cache of symbol lookup results keyed by image UUID and image-relative offset, used to resolve each
+ * distinct address once across a batch of reports from the same build.
+ *
+ * The cache is divided into independently locked shards, selected by the key's hash, so that concurrent lookups of
+ * different addresses rarely contend for the same lock. Both resolved and unresolvable addresses are cached.
+ *
+ * @{
+ */
+
+/** The number of independently locked shards. Must be a power of two. */
+#define PLCRASH_SYMBOL_RESOLUTION_CACHE_SHARDS 16
+
+/**
+ * The resolution of a single address. All pointers reference data owned by the caller (generally, a mapped symbol
+ * store), which is not copied, and must remain valid for the lifetime of the cache.
+ */
+typedef struct plcrash_symbol_resolution {
+    /** The symbol name, or NULL if the address could not be resolved. */
+    const char *name;
+
+    /** The image-relative symbol start address. Undefined if @a name is NULL. */
+    uint64_t symbol_address;
+
+    /** The source file path, or NULL if unknown. */
+    const char *file;
+
+    /** The source line number. Undefined if @a file is NULL. */
+    uint32_t line;
+
+    /** The symbol store from which the address was resolved, or NULL. */
+    struct plcrash_symbol_store *store;
+
+    /** The innermost inlined subroutine range of @a store containing the address, or NULL if none. */
+    const struct plcrash_symbol_store_inline_entry *inlined;
+} plcrash_symbol_resolution_t;
+
+/**
+ * A cached resolution.
+ */
+typedef struct plcrash_symbol_resolution_entry {
+    /** The image UUID. */
+    uint8_t uuid[16];
+
+    /** The image-relative address. */
+    uint64_t offset;
+
+    /** The cached resolution. */
+    plcrash_symbol_resolution_t resolution;
+
+    /** True if this slot is occupied. */
+    bool used;
+} plcrash_symbol_resolution_entry_t;
+
+/**
+ * A single independently locked cache shard.
+ */
+typedef struct plcrash_symbol_resolution_shard {
+    /** Lock guarding all shard state. */
+    pthread_mutex_t lock;
+
+    /** Open-addressed entry table, or NULL if empty. */
+    plcrash_symbol_resolution_entry_t *entries;
+
+    /** The number of slots in @a entries; always zero or a power of two. */
+    size_t capacity;
+
+    /** The number of occupied slots. */
+    size_t count;
+} plcrash_symbol_resolution_shard_t;
+
+/**
+ * A sharded symbol resolution cache.
+ */
+typedef struct plcrash_symbol_resolution_cache {
+    /** The cache shards. */
+    plcrash_symbol_resolution_shard_t shards[PLCRASH_SYMBOL_RESOLUTION_CACHE_SHARDS];
+} plcrash_symbol_resolution_cache_t;
+
+plcrash_error_t plcrash_symbol_resolution_cache_init (plcrash_symbol_resolution_cache_t *cache);
+
+bool plcrash_symbol_resolution_cache_lookup (plcrash_symbol_resolution_cache_t *cache, const uint8_t uuid[16], uint64_t offset,
+                                             plcrash_symbol_resolution_t *resolution);
+
+plcrash_error_t plcrash_symbol_resolution_cache_insert (plcrash_symbol_resolution_cache_t *cache, const uint8_t uuid[16], uint64_t offset,
+                                                        const plcrash_symbol_resolution_t *resolution);
+
+void plcrash_symbol_resolution_cache_remove_image (plcrash_symbol_resolution_cache_t *cache, const uint8_t uuid[16]);
+
+void plcrash_symbol_resolution_cache_free (plcrash_symbol_resolution_cache_t *cache);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_SYMBOL_RESOLUTION_CACHE_H */
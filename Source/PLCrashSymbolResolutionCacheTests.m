@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashSymbolResolutionCache.h"
+
+#import <libkern/OSAtomic.h>
+
+@interface PLCrashSymbolResolutionCacheTests : SenTestCase {
+@private
+    /** The cache under test. */
+    plcrash_symbol_resolution_cache_t _cache;
+}
+@end
+
+@implementation PLCrashSymbolResolutionCacheTests
+
+- (void) setUp {
+    STAssertEquals(plcrash_symbol_resolution_cache_init(&_cache), PLCRASH_ESUCCESS, @"Failed to initialize cache");
+}
+
+- (void) tearDown {
+    plcrash_symbol_resolution_cache_free(&_cache);
+}
+
+/**
+ * Test caching of resolved and unresolvable addresses.
+ */
+- (void) testLookup {
+    const uint8_t uuid[16] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10 };
+    const uint8_t otherUUID[16] = { 0xFF };
+    const char *symbol = "-[Example method]";
+    const char *source = "/src/Example.m";
+    plcrash_symbol_resolution_t resolved = { symbol, 0xF0, source, 42, NULL, NULL };
+    plcrash_symbol_resolution_t unresolved = { NULL, 0, source, 42, NULL, NULL };
+    plcrash_symbol_resolution_t result;
+
+    STAssertFalse(plcrash_symbol_resolution_cache_lookup(&_cache, uuid, 0x100, &result), @"Empty cache returned an entry");
+
+    STAssertEquals(plcrash_symbol_resolution_cache_insert(&_cache, uuid, 0x100, &resolved), PLCRASH_ESUCCESS, @"Insert failed");
+    STAssertEquals(plcrash_symbol_resolution_cache_insert(&_cache, uuid, 0x200, &unresolved), PLCRASH_ESUCCESS, @"Insert failed");
+
+    STAssertTrue(plcrash_symbol_resolution_cache_lookup(&_cache, uuid, 0x100, &result), @"Missing resolved entry");
+    STAssertEquals(result.name, symbol, @"Incorrect symbol name");
+    STAssertEquals(result.symbol_address, (uint64_t) 0xF0, @"Incorrect symbol address");
+    STAssertEquals(result.file, source, @"Incorrect source file");
+    STAssertEquals(result.line, (uint32_t) 42, @"Incorrect source line");
+
+    STAssertTrue(plcrash_symbol_resolution_cache_lookup(&_cache, uuid, 0x200, &result), @"Missing unresolvable entry");
+    STAssertNULL(result.name, @"Unresolvable entry returned a symbol name");
+    STAssertNULL(result.file, @"Unresolvable entry returned a source file");
+
+    STAssertFalse(plcrash_symbol_resolution_cache_lookup(&_cache, otherUUID, 0x100, &result), @"Entry matched a different image");
+}
+
+/**
+ * Test removal of all entries for a single image.
+ */
+- (void) testRemoveImage {
+    const uint8_t uuid[16] = { 0x01 };
+    const uint8_t otherUUID[16] = { 0x02 };
+    plcrash_symbol_resolution_t resolved = { "symbol", 0x10, NULL, 0, NULL, NULL };
+    plcrash_symbol_resolution_t result;
+
+    for (uint64_t offset = 0; offset < 1000; offset++) {
+        STAssertEquals(plcrash_symbol_resolution_cache_insert(&_cache, uuid, offset, &resolved), PLCRASH_ESUCCESS, @"Insert failed");
+        STAssertEquals(plcrash_symbol_resolution_cache_insert(&_cache, otherUUID, offset, &resolved), PLCRASH_ESUCCESS, @"Insert failed");
+    }
+
+    plcrash_symbol_resolution_cache_remove_image(&_cache, uuid);
+
+    for (uint64_t offset = 0; offset < 1000; offset++) {
+        STAssertFalse(plcrash_symbol_resolution_cache_lookup(&_cache, uuid, offset, &result), @"Removed entry was returned");
+        STAssertTrue(plcrash_symbol_resolution_cache_lookup(&_cache, otherUUID, offset, &result), @"Retained entry was lost");
+    }
+}
+
+/**
+ * Test concurrent insertion and lookup across enough entries to require every shard to grow.
+ */
+- (void) testConcurrentAccess {
+    const size_t count = 50000;
+    plcrash_symbol_resolution_cache_t *cache = &_cache;
+    __block volatile int32_t mismatches = 0;
+
+    dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t worker) {
+        uint8_t uuid[16] = { (uint8_t) (worker % 2) };
+
+        for (uint64_t offset = 0; offset < count; offset++) {
+            plcrash_symbol_resolution_t resolution = { "symbol", offset * 2, NULL, 0, NULL, NULL };
+
+            if (!plcrash_symbol_resolution_cache_lookup(cache, uuid, offset, &resolution)) {
+                plcrash_symbol_resolution_cache_insert(cache, uuid, offset, &resolution);
+            } else if (resolution.symbol_address != offset * 2) {
+                OSAtomicIncrement32(&mismatches);
+            }
+        }
+    });
+
+    STAssertEquals((int32_t) mismatches, (int32_t) 0, @"Lookups returned incorrect entries");
+
+    size_t total = 0;
+    for (size_t i = 0; i < PLCRASH_SYMBOL_RESOLUTION_CACHE_SHARDS; i++)
+        total += _cache.shards[i].count;
+    STAssertEquals(total, count * 2, @"Incorrect number of cached entries");
+}
+
+@end
@@ -0,0 +1,1517 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashSymbolStore.h"
+#include "PLCrashAsyncMachOImage.h"
+#include "PLCrashDwarfLineTable.h"
+#include "PLCrashDwarfInlineTable.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <mach-o/loader.h>
+#include <mach-o/fat.h>
+#include <libkern/OSByteOrder.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_symbol_store
+ * @{
+ */
+
+/** The maximum number of architectures accepted in a fat binary header. */
+#define MAX_FAT_ARCH_COUNT 64
+
+/**
+ * @internal
+ *
+ * The file offset and size of a Mach-O section, relative to the start of its slice.
+ */
+typedef struct macho_section_range {
+    /** The section's file offset. */
+    uint64_t offset;
+
+    /** The section's size, in bytes, or 0 if the section is not present. */
+    uint64_t size;
+} macho_section_range_t;
+
+/**
+ * @internal
+ *
+ * The layout of a single Mach-O slice, as required to build a symbol store.
+ */
+typedef struct macho_slice {
+    /** The slice's data, within the mapped file. */
+    const uint8_t *data;
+
+    /** The slice's size, in bytes. */
+    uint64_t size;
+
+    /** The slice's CPU type. */
+    cpu_type_t cputype;
+
+    /** The slice's CPU subtype. */
+    cpu_subtype_t cpusubtype;
+
+    /** The image UUID, if @a has_uuid is true. */
+    uint8_t uuid[16];
+
+    /** True if the slice defines an LC_UUID command. */
+    bool has_uuid;
+
+    /** The total size of the Mach-O header and load commands. */
+    uint64_t header_size;
+
+    /** The __TEXT segment's vmaddr, if @a has_text is true. */
+    uint64_t text_vmaddr;
+
+    /** True if the slice defines a __TEXT segment. */
+    bool has_text;
+
+    /** The __LINKEDIT segment's vmaddr, file offset and file size, if @a has_linkedit is true. */
+    uint64_t linkedit_vmaddr;
+    uint64_t linkedit_fileoff;
+    uint64_t linkedit_filesize;
+
+    /** True if the slice defines a __LINKEDIT segment. */
+    bool has_linkedit;
+
+    /** True if the slice is in non-native byte order. */
+    bool swapped;
+
+    /** The __DWARF sections used to build the line table. */
+    macho_section_range_t debug_line;
+    macho_section_range_t debug_line_str;
+    macho_section_range_t debug_str;
+
+    /** The additional __DWARF sections used to build the inline table. */
+    macho_section_range_t debug_info;
+    macho_section_range_t debug_abbrev;
+    macho_section_range_t debug_ranges;
+    macho_section_range_t debug_rnglists;
+    macho_section_range_t debug_str_offsets;
+    macho_section_range_t debug_addr;
+} macho_slice_t;
+
+/**
+ * Prototype of the per-slice callback used by for_each_slice(). Return false to stop iteration.
+ */
+typedef bool (*macho_slice_cb)(const macho_slice_t *slice, void *ctx);
+
+/**
+ * A read-only mapping of a file.
+ */
+typedef struct mapped_file {
+    const uint8_t *data;
+    size_t size;
+} mapped_file_t;
+
+/**
+ * Map the file at @a path.
+ */
+static plcrash_error_t map_file (const char *path, mapped_file_t *file) {
+    struct stat sb;
+    plcrash_error_t err = PLCRASH_ESUCCESS;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        PLCF_DEBUG("Could not open %s: %s", path, strerror(errno));
+        return PLCRASH_EINTERNAL;
+    }
+
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode) || sb.st_size == 0) {
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    void *mapping = mmap(NULL, (size_t) sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        PLCF_DEBUG("Could not map %s: %s", path, strerror(errno));
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    file->data = mapping;
+    file->size = (size_t) sb.st_size;
+
+cleanup:
+    close(fd);
+    return err;
+}
+
+/**
+ * Release a mapping returned by map_file().
+ */
+static void unmap_file (mapped_file_t *file) {
+    munmap((void *) file->data, file->size);
+}
+
+/**
+ * Parse the thin Mach-O image at @a data, populating @a slice. Returns false if @a data is not a valid
+ * Mach-O image.
+ */
+static bool parse_slice (const uint8_t *data, uint64_t size, macho_slice_t *slice) {
+    uint32_t magic;
+    bool swap;
+    bool m64;
+
+    memset(slice, 0, sizeof(*slice));
+    slice->data = data;
+    slice->size = size;
+
+    if (size < sizeof(struct mach_header))
+        return false;
+
+    memcpy(&magic, data, sizeof(magic));
+    switch (magic) {
+        case MH_MAGIC:    swap = false; m64 = false; break;
+        case MH_CIGAM:    swap = true;  m64 = false; break;
+        case MH_MAGIC_64: swap = false; m64 = true;  break;
+        case MH_CIGAM_64: swap = true;  m64 = true;  break;
+        default:
+            return false;
+    }
+
+#define SWAP32(v) (swap ? OSSwapInt32(v) : (v))
+#define SWAP64(v) (swap ? OSSwapInt64(v) : (v))
+
+    struct mach_header header;
+    memcpy(&header, data, sizeof(header));
+
+    uint64_t header_size = m64 ? sizeof(struct mach_header_64) : sizeof(struct mach_header);
+    uint32_t ncmds = SWAP32(header.ncmds);
+    uint64_t sizeofcmds = SWAP32(header.sizeofcmds);
+
+    if (header_size + sizeofcmds > size)
+        return false;
+
+    slice->swapped = swap;
+    slice->cputype = (cpu_type_t) SWAP32((uint32_t) header.cputype);
+    slice->cpusubtype = (cpu_subtype_t) SWAP32((uint32_t) header.cpusubtype);
+    slice->header_size = header_size + sizeofcmds;
+
+    /* Walk the load commands */
+    const uint8_t *cmd = data + header_size;
+    const uint8_t *cmds_end = cmd + sizeofcmds;
+    for (uint32_t i = 0; i < ncmds; i++) {
+        struct load_command lc;
+        if ((size_t) (cmds_end - cmd) < sizeof(lc))
+            return false;
+
+        memcpy(&lc, cmd, sizeof(lc));
+        uint32_t cmdsize = SWAP32(lc.cmdsize);
+        if (cmdsize < sizeof(lc) || cmdsize > (size_t) (cmds_end - cmd))
+            return false;
+
+        uint32_t type = SWAP32(lc.cmd);
+        if (type == LC_UUID && cmdsize >= sizeof(struct uuid_command)) {
+            struct uuid_command uc;
+            memcpy(&uc, cmd, sizeof(uc));
+            memcpy(slice->uuid, uc.uuid, sizeof(slice->uuid));
+            slice->has_uuid = true;
+        } else if (type == LC_SEGMENT || type == LC_SEGMENT_64) {
+            char segname[16];
+            uint64_t vmaddr, fileoff, filesize;
+            uint32_t nsects;
+            size_t seg_size, sect_size;
+
+            if (type == LC_SEGMENT_64) {
+                struct segment_command_64 seg;
+                if (cmdsize < sizeof(seg))
+                    return false;
+                memcpy(&seg, cmd, sizeof(seg));
+                memcpy(segname, seg.segname, sizeof(segname));
+                vmaddr = SWAP64(seg.vmaddr);
+                fileoff = SWAP64(seg.fileoff);
+                filesize = SWAP64(seg.filesize);
+                nsects = SWAP32(seg.nsects);
+                seg_size = sizeof(seg);
+                sect_size = sizeof(struct section_64);
+            } else {
+                struct segment_command seg;
+                if (cmdsize < sizeof(seg))
+                    return false;
+                memcpy(&seg, cmd, sizeof(seg));
+                memcpy(segname, seg.segname, sizeof(segname));
+                vmaddr = SWAP32(seg.vmaddr);
+                fileoff = SWAP32(seg.fileoff);
+                filesize = SWAP32(seg.filesize);
+                nsects = SWAP32(seg.nsects);
+                seg_size = sizeof(seg);
+                sect_size = sizeof(struct section);
+            }
+
+            if (strncmp(segname, SEG_TEXT, sizeof(segname)) == 0) {
+                slice->text_vmaddr = vmaddr;
+                slice->has_text = true;
+            } else if (strncmp(segname, SEG_LINKEDIT, sizeof(segname)) == 0) {
+                slice->linkedit_vmaddr = vmaddr;
+                slice->linkedit_fileoff = fileoff;
+                slice->linkedit_filesize = filesize;
+                slice->has_linkedit = true;
+            } else if (strncmp(segname, "__DWARF", sizeof(segname)) == 0 && nsects <= (cmdsize - seg_size) / sect_size) {
+                /* Record the debug sections required to build the line and inline tables */
+                for (uint32_t j = 0; j < nsects; j++) {
+                    const uint8_t *sect_data = cmd + seg_size + (j * sect_size);
+                    char sectname[16];
+                    macho_section_range_t range;
+
+                    if (type == LC_SEGMENT_64) {
+                        struct section_64 sect;
+                        memcpy(&sect, sect_data, sizeof(sect));
+                        memcpy(sectname, sect.sectname, sizeof(sectname));
+                        range.offset = SWAP32(sect.offset);
+                        range.size = SWAP64(sect.size);
+                    } else {
+                        struct section sect;
+                        memcpy(&sect, sect_data, sizeof(sect));
+                        memcpy(sectname, sect.sectname, sizeof(sectname));
+                        range.offset = SWAP32(sect.offset);
+                        range.size = SWAP32(sect.size);
+                    }
+
+                    if (range.offset > size || range.size > size - range.offset)
+                        continue;
+
+                    if (strncmp(sectname, "__debug_line", sizeof(sectname)) == 0)
+                        slice->debug_line = range;
+                    else if (strncmp(sectname, "__debug_line_str", sizeof(sectname)) == 0)
+                        slice->debug_line_str = range;
+                    else if (strncmp(sectname, "__debug_str", sizeof(sectname)) == 0)
+                        slice->debug_str = range;
+                    else if (strncmp(sectname, "__debug_info", sizeof(sectname)) == 0)
+                        slice->debug_info = range;
+                    else if (strncmp(sectname, "__debug_abbrev", sizeof(sectname)) == 0)
+                        slice->debug_abbrev = range;
+                    else if (strncmp(sectname, "__debug_ranges", sizeof(sectname)) == 0)
+                        slice->debug_ranges = range;
+                    else if (strncmp(sectname, "__debug_rnglists", sizeof(sectname)) == 0)
+                        slice->debug_rnglists = range;
+                    else if (strncmp(sectname, "__debug_str_offs", sizeof(sectname)) == 0)
+                        slice->debug_str_offsets = range;
+                    else if (strncmp(sectname, "__debug_addr", sizeof(sectname)) == 0)
+                        slice->debug_addr = range;
+                }
+            }
+        }
+
+        cmd += cmdsize;
+    }
+
+#undef SWAP32
+#undef SWAP64
+
+    return true;
+}
+
+/**
+ * Call @a callback for each valid Mach-O slice within @a file, which may be either a thin or a fat binary.
+ */
+static void for_each_slice (const mapped_file_t *file, macho_slice_cb callback, void *ctx) {
+    macho_slice_t slice;
+    struct fat_header fh;
+
+    if (file->size < sizeof(fh))
+        return;
+
+    memcpy(&fh, file->data, sizeof(fh));
+    uint32_t magic = OSSwapBigToHostInt32(fh.magic);
+    if (magic != FAT_MAGIC && magic != FAT_MAGIC_64) {
+        if (parse_slice(file->data, file->size, &slice))
+            callback(&slice, ctx);
+        return;
+    }
+
+    uint32_t nfat_arch = OSSwapBigToHostInt32(fh.nfat_arch);
+    size_t arch_size = (magic == FAT_MAGIC_64) ? sizeof(struct fat_arch_64) : sizeof(struct fat_arch);
+    if (nfat_arch > MAX_FAT_ARCH_COUNT || sizeof(fh) + (nfat_arch * arch_size) > file->size)
+        return;
+
+    for (uint32_t i = 0; i < nfat_arch; i++) {
+        const uint8_t *arch_data = file->data + sizeof(fh) + (i * arch_size);
+        uint64_t offset, size;
+
+        if (magic == FAT_MAGIC_64) {
+            struct fat_arch_64 arch;
+            memcpy(&arch, arch_data, sizeof(arch));
+            offset = OSSwapBigToHostInt64(arch.offset);
+            size = OSSwapBigToHostInt64(arch.size);
+        } else {
+            struct fat_arch arch;
+            memcpy(&arch, arch_data, sizeof(arch));
+            offset = OSSwapBigToHostInt32(arch.offset);
+            size = OSSwapBigToHostInt32(arch.size);
+        }
+
+        if (offset > file->size || size > file->size - offset)
+            continue;
+
+        if (parse_slice(file->data + offset, size, &slice) && !callback(&slice, ctx))
+            return;
+    }
+}
+
+/**
+ * @internal
+ *
+ * for_each_slice() context used by plcrash_nasync_symbol_store_image_uuids().
+ */
+struct image_uuids_ctx {
+    plcrash_symbol_store_image_cb callback;
+    void *ctx;
+    bool found;
+};
+
+static bool image_uuids_cb (const macho_slice_t *slice, void *ctx) {
+    struct image_uuids_ctx *uctx = ctx;
+    if (slice->has_uuid) {
+        uctx->callback(slice->uuid, slice->cputype, slice->cpusubtype, uctx->ctx);
+        uctx->found = true;
+    }
+    return true;
+}
+
+/**
+ * Report the UUID of each Mach-O image contained in the file at @a path via @a callback. Both thin and fat binaries
+ * are supported; images without an LC_UUID command are ignored.
+ *
+ * @param path The Mach-O binary or dSYM DWARF file to be read.
+ * @param callback The callback to be called for each image.
+ * @param ctx The context value to be passed to @a callback.
+ *
+ * @return Returns PLCRASH_ESUCCESS if at least one image was found, PLCRASH_ENOTFOUND if the file is not a Mach-O
+ * file, or contains no identifiable images, or an error result if the file could not be read.
+ */
+plcrash_error_t plcrash_nasync_symbol_store_image_uuids (const char *path, plcrash_symbol_store_image_cb callback, void *ctx) {
+    mapped_file_t file;
+    plcrash_error_t err;
+
+    if ((err = map_file(path, &file)) != PLCRASH_ESUCCESS)
+        return err == PLCRASH_EINVAL ? PLCRASH_ENOTFOUND : err;
+
+    struct image_uuids_ctx uctx = { callback, ctx, false };
+    for_each_slice(&file, image_uuids_cb, &uctx);
+    unmap_file(&file);
+
+    return uctx.found ? PLCRASH_ESUCCESS : PLCRASH_ENOTFOUND;
+}
+
+/**
+ * @internal
+ *
+ * for_each_slice() context used to locate a slice by UUID.
+ */
+struct find_slice_ctx {
+    const uint8_t *uuid;
+    macho_slice_t slice;
+    bool found;
+};
+
+static bool find_slice_cb (const macho_slice_t *slice, void *ctx) {
+    struct find_slice_ctx *fctx = ctx;
+    if (slice->has_uuid && memcmp(slice->uuid, fctx->uuid, sizeof(slice->uuid)) == 0) {
+        fctx->slice = *slice;
+        fctx->found = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Write @a len bytes from @a data to @a fd, retrying on short writes. Returns false on failure.
+ */
+static bool write_fully (int fd, const void *data, size_t len) {
+    const uint8_t *p = data;
+    while (len > 0) {
+        ssize_t written = write(fd, p, len);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        p += written;
+        len -= (size_t) written;
+    }
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * A growable store string table.
+ */
+typedef struct string_table {
+    char *data;
+    size_t size;
+    size_t capacity;
+} string_table_t;
+
+/**
+ * Append the @a len bytes at @a str, which must include the NUL terminator, to @a table, returning the string's offset
+ * via @a offset.
+ */
+static plcrash_error_t string_table_append (string_table_t *table, const char *str, size_t len, uint32_t *offset) {
+    if (table->size + len > UINT32_MAX)
+        return PLCRASH_EINVAL;
+
+    if (table->size + len > table->capacity) {
+        size_t capacity = table->capacity == 0 ? 64 * 1024 : table->capacity * 2;
+        while (capacity < table->size + len)
+            capacity *= 2;
+
+        char *resized = realloc(table->data, capacity);
+        if (resized == NULL)
+            return PLCRASH_ENOMEM;
+
+        table->data = resized;
+        table->capacity = capacity;
+    }
+
+    memcpy(table->data + table->size, str, len);
+    *offset = (uint32_t) table->size;
+    table->size += len;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * A set of distinct strings appended to a string table, used to share the storage of repeated source paths and
+ * names.
+ */
+typedef struct string_interner {
+    /** The store string table. */
+    string_table_t *strings;
+
+    /** Open-addressed table of (string table offset + 1) of each distinct string, keyed by string. */
+    uint32_t *slots;
+    size_t count;
+    size_t capacity;
+} string_interner_t;
+
+/**
+ * Return the FNV-1a hash of @a str.
+ */
+static uint64_t string_hash (const char *str) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char *p = str; *p != '\0'; p++) {
+        hash ^= (uint8_t) *p;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * Return the string table offset of @a str, appending it to the string table if it has not yet been interned.
+ */
+static plcrash_error_t string_interner_intern (string_interner_t *interner, const char *str, uint32_t *offset) {
+    plcrash_error_t err;
+
+    /* Keep the load factor at or below one half */
+    if ((interner->count + 1) * 2 > interner->capacity) {
+        size_t capacity = interner->capacity == 0 ? 256 : interner->capacity * 2;
+        uint32_t *slots = calloc(capacity, sizeof(*slots));
+        if (slots == NULL)
+            return PLCRASH_ENOMEM;
+
+        for (size_t i = 0; i < interner->capacity; i++) {
+            if (interner->slots[i] == 0)
+                continue;
+
+            size_t slot = (size_t) string_hash(interner->strings->data + interner->slots[i] - 1) & (capacity - 1);
+            while (slots[slot] != 0)
+                slot = (slot + 1) & (capacity - 1);
+            slots[slot] = interner->slots[i];
+        }
+
+        free(interner->slots);
+        interner->slots = slots;
+        interner->capacity = capacity;
+    }
+
+    size_t slot = (size_t) string_hash(str) & (interner->capacity - 1);
+    while (interner->slots[slot] != 0) {
+        if (strcmp(interner->strings->data + interner->slots[slot] - 1, str) == 0) {
+            *offset = interner->slots[slot] - 1;
+            return PLCRASH_ESUCCESS;
+        }
+        slot = (slot + 1) & (interner->capacity - 1);
+    }
+
+    if ((err = string_table_append(interner->strings, str, strlen(str) + 1, offset)) != PLCRASH_ESUCCESS)
+        return err;
+
+    if (*offset == UINT32_MAX)
+        return PLCRASH_EINVAL;
+
+    interner->slots[slot] = *offset + 1;
+    interner->count++;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Intern the path formed by joining @a directory, which may be NULL, and @a file.
+ */
+static plcrash_error_t string_interner_intern_path (string_interner_t *interner, const char *directory, const char *file, uint32_t *offset) {
+    char *path = NULL;
+    plcrash_error_t err;
+
+    if (directory == NULL || directory[0] == '\0')
+        return string_interner_intern(interner, file, offset);
+
+    if (asprintf(&path, "%s/%s", directory, file) < 0)
+        return PLCRASH_ENOMEM;
+
+    err = string_interner_intern(interner, path, offset);
+    free(path);
+    return err;
+}
+
+/**
+ * Free the interner's lookup table. The string table is not modified.
+ */
+static void string_interner_free (string_interner_t *interner) {
+    free(interner->slots);
+}
+
+/**
+ * @internal
+ *
+ * A line table row pending sorting, along with its position in the line programs.
+ */
+typedef struct line_row {
+    plcrash_symbol_store_line_entry_t entry;
+    uint64_t order;
+} line_row_t;
+
+/**
+ * @internal
+ *
+ * plcrash_nasync_dwarf_line_table_parse() context used to build a store's line table.
+ */
+typedef struct line_builder {
+    /** The image's __TEXT vmaddr, used to rebase row addresses. */
+    uint64_t text_vmaddr;
+
+    /** The store string interner. */
+    string_interner_t *interner;
+
+    /** The pending rows. */
+    line_row_t *rows;
+    size_t count;
+    size_t capacity;
+
+    /** The most recently resolved directory and file name, and their path's string table offset. */
+    const char *last_directory;
+    const char *last_file;
+    uint32_t last_offset;
+
+    /** The first error encountered, if any. */
+    plcrash_error_t err;
+} line_builder_t;
+
+static bool line_builder_row_cb (const plcrash_dwarf_line_row_t *row, void *ctx) {
+    line_builder_t *builder = ctx;
+    plcrash_symbol_store_line_entry_t entry;
+
+    /* Rows of dead-stripped code are left at (or relative to) address zero */
+    if (row->address < builder->text_vmaddr)
+        return true;
+
+    entry.address = row->address - builder->text_vmaddr;
+    entry.file_offset = 0;
+    entry.line = 0;
+
+    /* Resolve the row's source path; consecutive rows generally share the same file */
+    if (!row->end_sequence && row->file != NULL && row->line != 0) {
+        if (row->directory != builder->last_directory || row->file != builder->last_file || builder->last_file == NULL) {
+            builder->err = string_interner_intern_path(builder->interner, row->directory, row->file, &builder->last_offset);
+            if (builder->err != PLCRASH_ESUCCESS)
+                return false;
+
+            builder->last_directory = row->directory;
+            builder->last_file = row->file;
+        }
+
+        entry.file_offset = builder->last_offset;
+        entry.line = row->line;
+    }
+
+    if (builder->count == builder->capacity) {
+        size_t capacity = builder->capacity == 0 ? 64 * 1024 : builder->capacity * 2;
+        line_row_t *rows = realloc(builder->rows, capacity * sizeof(*rows));
+        if (rows == NULL) {
+            builder->err = PLCRASH_ENOMEM;
+            return false;
+        }
+
+        builder->rows = rows;
+        builder->capacity = capacity;
+    }
+
+    builder->rows[builder->count].entry = entry;
+    builder->rows[builder->count].order = builder->count;
+    builder->count++;
+    return true;
+}
+
+/**
+ * Order rows by address. Rows sharing an address are ordered with rows lacking a source position first, followed
+ * by the remaining rows in line program order, so that the last row at each address is the one to be retained.
+ */
+static int line_row_compare (const void *a, const void *b) {
+    const line_row_t *ra = a;
+    const line_row_t *rb = b;
+
+    if (ra->entry.address != rb->entry.address)
+        return ra->entry.address < rb->entry.address ? -1 : 1;
+
+    if ((ra->entry.line == 0) != (rb->entry.line == 0))
+        return ra->entry.line == 0 ? -1 : 1;
+
+    if (ra->order != rb->order)
+        return ra->order < rb->order ? -1 : 1;
+
+    return 0;
+}
+
+/**
+ * Populate @a sections with the line table sections of @a slice.
+ */
+static void slice_line_sections (const macho_slice_t *slice, plcrash_dwarf_line_sections_t *sections) {
+    memset(sections, 0, sizeof(*sections));
+    if (slice->debug_line.size > 0) {
+        sections->debug_line = slice->data + slice->debug_line.offset;
+        sections->debug_line_size = slice->debug_line.size;
+    }
+    if (slice->debug_line_str.size > 0) {
+        sections->debug_line_str = slice->data + slice->debug_line_str.offset;
+        sections->debug_line_str_size = slice->debug_line_str.size;
+    }
+    if (slice->debug_str.size > 0) {
+        sections->debug_str = slice->data + slice->debug_str.offset;
+        sections->debug_str_size = slice->debug_str.size;
+    }
+}
+
+/**
+ * Decode the line table of @a slice, interning source paths via @a interner. On success, the sorted entries are
+ * returned via @a entries, which must be freed by the caller, and their count via @a count.
+ */
+static plcrash_error_t build_line_table (const macho_slice_t *slice, string_interner_t *interner,
+                                         plcrash_symbol_store_line_entry_t **entries, uint32_t *count)
+{
+    plcrash_dwarf_line_sections_t sections;
+    line_builder_t builder;
+    plcrash_error_t err;
+
+    *entries = NULL;
+    *count = 0;
+
+    /* DWARF data is only read in native byte order */
+    if (slice->debug_line.size == 0 || slice->swapped)
+        return PLCRASH_ESUCCESS;
+
+    slice_line_sections(slice, &sections);
+
+    memset(&builder, 0, sizeof(builder));
+    builder.text_vmaddr = slice->text_vmaddr;
+    builder.interner = interner;
+    builder.err = PLCRASH_ESUCCESS;
+
+    /* A malformed section is not fatal; any rows decoded prior to the error are retained */
+    if ((err = plcrash_nasync_dwarf_line_table_parse(&sections, line_builder_row_cb, &builder)) != PLCRASH_ESUCCESS)
+        PLCF_DEBUG("Could not fully parse the __debug_line section: %d", err);
+
+    if ((err = builder.err) != PLCRASH_ESUCCESS)
+        goto cleanup;
+
+    qsort(builder.rows, builder.count, sizeof(*builder.rows), line_row_compare);
+
+    /* Compact the rows in place, keeping the last row at each address, and dropping rows that do not change the
+     * source position of their predecessor. */
+    plcrash_symbol_store_line_entry_t *table = (plcrash_symbol_store_line_entry_t *) builder.rows;
+    size_t n = 0;
+    for (size_t i = 0; i < builder.count; i++) {
+        plcrash_symbol_store_line_entry_t entry = builder.rows[i].entry;
+        if (i + 1 < builder.count && builder.rows[i + 1].entry.address == entry.address)
+            continue;
+
+        if (n > 0 && table[n - 1].line == entry.line && (entry.line == 0 || table[n - 1].file_offset == entry.file_offset))
+            continue;
+
+        /* Entries are smaller than rows, so the write never reaches a row that has yet to be read */
+        table[n++] = entry;
+    }
+
+    if (n > UINT32_MAX) {
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    *entries = table;
+    *count = (uint32_t) n;
+    builder.rows = NULL;
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    free(builder.rows);
+    return err;
+}
+
+/**
+ * @internal
+ *
+ * An inline entry pending sorting, along with its nesting depth.
+ */
+typedef struct inline_range {
+    plcrash_symbol_store_inline_entry_t entry;
+    uint32_t depth;
+} inline_range_t;
+
+/**
+ * @internal
+ *
+ * plcrash_nasync_dwarf_inline_table_parse() context used to build a store's inline table.
+ */
+typedef struct inline_builder {
+    /** The image's __TEXT vmaddr, used to rebase range addresses. */
+    uint64_t text_vmaddr;
+
+    /** The store string interner. */
+    string_interner_t *interner;
+
+    /** The pending ranges. */
+    inline_range_t *ranges;
+    size_t count;
+    size_t capacity;
+
+    /** The first error encountered, if any. */
+    plcrash_error_t err;
+} inline_builder_t;
+
+static bool inline_builder_range_cb (const plcrash_dwarf_inline_range_t *range, void *ctx) {
+    inline_builder_t *builder = ctx;
+    inline_range_t pending;
+
+    /* Ranges of dead-stripped code are left at (or relative to) address zero */
+    if (range->low < builder->text_vmaddr)
+        return true;
+
+    pending.entry.low = range->low - builder->text_vmaddr;
+    pending.entry.high = range->high - builder->text_vmaddr;
+    pending.entry.name_offset = PLCRASH_SYMBOL_STORE_INLINE_NONE;
+    pending.entry.call_file_offset = PLCRASH_SYMBOL_STORE_INLINE_NONE;
+    pending.entry.call_line = range->call_line;
+    pending.entry.parent = PLCRASH_SYMBOL_STORE_INLINE_NONE;
+    pending.depth = range->depth;
+
+    if (range->name != NULL && (builder->err = string_interner_intern(builder->interner, range->name, &pending.entry.name_offset)) != PLCRASH_ESUCCESS)
+        return false;
+
+    if (range->call_file != NULL &&
+        (builder->err = string_interner_intern_path(builder->interner, range->call_directory, range->call_file, &pending.entry.call_file_offset)) != PLCRASH_ESUCCESS)
+    {
+        return false;
+    }
+
+    if (builder->count == builder->capacity) {
+        size_t capacity = builder->capacity == 0 ? 16 * 1024 : builder->capacity * 2;
+        inline_range_t *ranges = realloc(builder->ranges, capacity * sizeof(*ranges));
+        if (ranges == NULL) {
+            builder->err = PLCRASH_ENOMEM;
+            return false;
+        }
+
+        builder->ranges = ranges;
+        builder->capacity = capacity;
+    }
+
+    builder->ranges[builder->count++] = pending;
+    return true;
+}
+
+/**
+ * Order ranges by start address, with enclosing ranges first: outer subroutines before inner ones, and longer ranges
+ * before shorter ones.
+ */
+static int inline_range_compare (const void *a, const void *b) {
+    const inline_range_t *ra = a;
+    const inline_range_t *rb = b;
+
+    if (ra->entry.low != rb->entry.low)
+        return ra->entry.low < rb->entry.low ? -1 : 1;
+
+    if (ra->depth != rb->depth)
+        return ra->depth < rb->depth ? -1 : 1;
+
+    if (ra->entry.high != rb->entry.high)
+        return ra->entry.high > rb->entry.high ? -1 : 1;
+
+    return 0;
+}
+
+/**
+ * Decode the inlined subroutines of @a slice, interning names and call site paths via @a interner. On success, the
+ * sorted and linked entries are returned via @a entries, which must be freed by the caller, and their count via
+ * @a count.
+ */
+static plcrash_error_t build_inline_table (const macho_slice_t *slice, string_interner_t *interner,
+                                           plcrash_symbol_store_inline_entry_t **entries, uint32_t *count)
+{
+    plcrash_dwarf_inline_sections_t sections;
+    inline_builder_t builder;
+    uint32_t *stack = NULL;
+    plcrash_error_t err;
+
+    *entries = NULL;
+    *count = 0;
+
+    /* DWARF data is only read in native byte order */
+    if (slice->debug_info.size == 0 || slice->debug_abbrev.size == 0 || slice->swapped)
+        return PLCRASH_ESUCCESS;
+
+    memset(&sections, 0, sizeof(sections));
+    slice_line_sections(slice, &sections.line);
+
+#define SLICE_SECTION(name) if (slice->name.size > 0) { \
+    sections.name = slice->data + slice->name.offset; \
+    sections.name ## _size = slice->name.size; \
+}
+    SLICE_SECTION(debug_info);
+    SLICE_SECTION(debug_abbrev);
+    SLICE_SECTION(debug_ranges);
+    SLICE_SECTION(debug_rnglists);
+    SLICE_SECTION(debug_str_offsets);
+    SLICE_SECTION(debug_addr);
+#undef SLICE_SECTION
+
+    memset(&builder, 0, sizeof(builder));
+    builder.text_vmaddr = slice->text_vmaddr;
+    builder.interner = interner;
+    builder.err = PLCRASH_ESUCCESS;
+
+    /* A malformed section is not fatal; any ranges decoded prior to the error are retained */
+    if ((err = plcrash_nasync_dwarf_inline_table_parse(&sections, inline_builder_range_cb, &builder)) != PLCRASH_ESUCCESS)
+        PLCF_DEBUG("Could not fully parse the __debug_info section: %d", err);
+
+    if ((err = builder.err) != PLCRASH_ESUCCESS)
+        goto cleanup;
+
+    if (builder.count >= PLCRASH_SYMBOL_STORE_INLINE_NONE) {
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    qsort(builder.ranges, builder.count, sizeof(*builder.ranges), inline_range_compare);
+
+    /*
+     * Link each range to the innermost preceding range that encloses it. The stack holds the chain of open ranges
+     * enclosing the current start address; any that end at or before it, or that are not shallower than it, are
+     * closed.
+     */
+    if ((stack = malloc((builder.count > 0 ? builder.count : 1) * sizeof(*stack))) == NULL) {
+        err = PLCRASH_ENOMEM;
+        goto cleanup;
+    }
+
+    size_t depth = 0;
+    for (size_t i = 0; i < builder.count; i++) {
+        inline_range_t *range = &builder.ranges[i];
+        while (depth > 0) {
+            const inline_range_t *top = &builder.ranges[stack[depth - 1]];
+            if (top->entry.high > range->entry.low && top->depth < range->depth)
+                break;
+            depth--;
+        }
+
+        range->entry.parent = depth > 0 ? stack[depth - 1] : PLCRASH_SYMBOL_STORE_INLINE_NONE;
+        stack[depth++] = (uint32_t) i;
+    }
+
+    /* Compact the ranges in place; entries are smaller than ranges, so the write never reaches a range that has yet
+     * to be read */
+    plcrash_symbol_store_inline_entry_t *table = (plcrash_symbol_store_inline_entry_t *) builder.ranges;
+    for (size_t i = 0; i < builder.count; i++) {
+        plcrash_symbol_store_inline_entry_t entry = builder.ranges[i].entry;
+        table[i] = entry;
+    }
+
+    *entries = table;
+    *count = (uint32_t) builder.count;
+    builder.ranges = NULL;
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    free(stack);
+    free(builder.ranges);
+    return err;
+}
+
+/**
+ * Write a store consisting of the given symbol entries, line entries, inline entries and string table to @a fd.
+ */
+static plcrash_error_t write_store_file (int fd, const uint8_t uuid[16],
+                                         const plcrash_symbol_store_entry_t *entries, uint32_t count,
+                                         const plcrash_symbol_store_line_entry_t *line_entries, uint32_t line_count,
+                                         const plcrash_symbol_store_inline_entry_t *inline_entries, uint32_t inline_count,
+                                         const string_table_t *strings)
+{
+    plcrash_symbol_store_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PLCRASH_SYMBOL_STORE_MAGIC, sizeof(header.magic));
+    header.version = PLCRASH_SYMBOL_STORE_VERSION;
+    memcpy(header.uuid, uuid, sizeof(header.uuid));
+    header.count = count;
+    header.string_table_size = (uint32_t) strings->size;
+    header.line_count = line_count;
+    header.inline_count = inline_count;
+
+    if (!write_fully(fd, &header, sizeof(header)) ||
+        !write_fully(fd, entries, sizeof(*entries) * count) ||
+        !write_fully(fd, line_entries, sizeof(*line_entries) * line_count) ||
+        !write_fully(fd, inline_entries, sizeof(*inline_entries) * inline_count) ||
+        !write_fully(fd, strings->data, strings->size))
+    {
+        PLCF_DEBUG("Could not write symbol store: %s", strerror(errno));
+        return PLCRASH_EINTERNAL;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Prototype of the function used by write_store_atomically() to write a store's contents to @a fd.
+ */
+typedef plcrash_error_t (*store_writer_fn)(int fd, void *ctx);
+
+/**
+ * Write a store to @a store_path via @a writer. The store is written to a temporary file and then renamed into
+ * place, so concurrent builders of the same store are safe, and readers will never observe a partially written
+ * store.
+ */
+static plcrash_error_t write_store_atomically (const char *store_path, store_writer_fn writer, void *ctx) {
+    char *tmp_path = NULL;
+    int fd = -1;
+    plcrash_error_t err;
+
+    if (asprintf(&tmp_path, "%s.XXXXXX", store_path) < 0)
+        return PLCRASH_ENOMEM;
+
+    if ((fd = mkstemp(tmp_path)) < 0) {
+        PLCF_DEBUG("Could not create %s: %s", tmp_path, strerror(errno));
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    if ((err = writer(fd, ctx)) != PLCRASH_ESUCCESS) {
+        unlink(tmp_path);
+        goto cleanup;
+    }
+
+    if (rename(tmp_path, store_path) != 0) {
+        PLCF_DEBUG("Could not move symbol store into place at %s: %s", store_path, strerror(errno));
+        unlink(tmp_path);
+        err = PLCRASH_EINTERNAL;
+        goto cleanup;
+    }
+
+    err = PLCRASH_ESUCCESS;
+
+cleanup:
+    if (fd >= 0)
+        close(fd);
+
+    free(tmp_path);
+    return err;
+}
+
+/**
+ * @internal
+ *
+ * Context for write_store().
+ */
+struct write_store_ctx {
+    /** The image to be written. */
+    plcrash_async_macho_t *image;
+
+    /** The slice containing the image. */
+    const macho_slice_t *slice;
+
+    /** The image UUID. */
+    const uint8_t *uuid;
+};
+
+/**
+ * Write the symbol index, line table and inline table of the image described by the write_store_ctx @a ctx to @a fd.
+ */
+static plcrash_error_t write_store (int fd, void *ctx) {
+    struct write_store_ctx *wctx = ctx;
+    plcrash_async_macho_t *image = wctx->image;
+    const macho_slice_t *slice = wctx->slice;
+    const uint8_t *uuid = wctx->uuid;
+    plcrash_async_macho_symtab_reader_t reader;
+    plcrash_symbol_store_entry_t *entries = NULL;
+    plcrash_symbol_store_line_entry_t *line_entries = NULL;
+    uint32_t line_count = 0;
+    plcrash_symbol_store_inline_entry_t *inline_entries = NULL;
+    uint32_t inline_count = 0;
+    string_table_t strings = { NULL, 0, 0 };
+    string_interner_t interner = { &strings, NULL, 0, 0 };
+    plcrash_error_t err;
+
+    if ((err = plcrash_nasync_macho_build_symbol_index(image)) != PLCRASH_ESUCCESS)
+        return err;
+
+    if ((err = plcrash_async_macho_symtab_reader_init(&reader, image)) != PLCRASH_ESUCCESS)
+        return err;
+
+    const plcrash_async_macho_symbol_index_t *index = image->symbol_index;
+    if ((entries = calloc(index->count > 0 ? index->count : 1, sizeof(*entries))) == NULL) {
+        err = PLCRASH_ENOMEM;
+        goto cleanup;
+    }
+
+    /* Resolve the entries' names, and rebase their addresses on the image header */
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < index->count; i++) {
+        const char *name = plcrash_async_macho_symtab_reader_symbol_name(&reader, index->entries[i].n_strx);
+        if (name == NULL || index->entries[i].n_value < image->text_vmaddr)
+            continue;
+
+        if ((err = string_table_append(&strings, name, strlen(name) + 1, &entries[count].name_offset)) != PLCRASH_ESUCCESS)
+            goto cleanup;
+
+        entries[count].address = index->entries[i].n_value - image->text_vmaddr;
+        entries[count].reserved = 0;
+        count++;
+    }
+
+    /* Build the line and inline tables, if debug information is available */
+    if ((err = build_line_table(slice, &interner, &line_entries, &line_count)) != PLCRASH_ESUCCESS)
+        goto cleanup;
+
+    if ((err = build_inline_table(slice, &interner, &inline_entries, &inline_count)) != PLCRASH_ESUCCESS)
+        goto cleanup;
+
+    /* Write the store */
+    err = write_store_file(fd, uuid, entries, count, line_entries, line_count, inline_entries, inline_count, &strings);
+
+cleanup:
+    free(entries);
+    free(line_entries);
+    free(inline_entries);
+    free(strings.data);
+    string_interner_free(&interner);
+    plcrash_async_macho_symtab_reader_free(&reader);
+    return err;
+}
+
+/**
+ * Build a symbol store for the image identified by @a uuid within the Mach-O binary or dSYM DWARF file at
+ * @a binary_path, writing the store to @a store_path. The store is written to a temporary file and then renamed
+ * into place, so concurrent builders of the same store are safe, and readers will never observe a partially
+ * written store.
+ *
+ * @param binary_path The Mach-O binary or dSYM DWARF file containing the image.
+ * @param uuid The UUID of the image to be indexed.
+ * @param store_path The path at which the store will be written.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if no image matching @a uuid was found, or an
+ * error result on failure.
+ */
+plcrash_error_t plcrash_nasync_symbol_store_build (const char *binary_path, const uint8_t uuid[16], const char *store_path) {
+    mapped_file_t file;
+    plcrash_async_macho_t image;
+    bool image_initialized = false;
+    void *layout = MAP_FAILED;
+    size_t layout_size = 0;
+    plcrash_error_t err;
+
+    if ((err = map_file(binary_path, &file)) != PLCRASH_ESUCCESS)
+        return err == PLCRASH_EINVAL ? PLCRASH_ENOTFOUND : err;
+
+    /* Locate the image */
+    struct find_slice_ctx fctx = { uuid };
+    fctx.found = false;
+    for_each_slice(&file, find_slice_cb, &fctx);
+
+    const macho_slice_t *slice = &fctx.slice;
+    if (!fctx.found) {
+        err = PLCRASH_ENOTFOUND;
+        goto cleanup;
+    }
+
+    /* Verify that the image's header and symbol tables may be laid out as they would be by dyld */
+    if (!slice->has_text || !slice->has_linkedit || slice->linkedit_vmaddr < slice->text_vmaddr ||
+        slice->linkedit_vmaddr - slice->text_vmaddr < slice->header_size ||
+        slice->linkedit_fileoff > slice->size || slice->linkedit_filesize > slice->size - slice->linkedit_fileoff ||
+        slice->linkedit_vmaddr - slice->text_vmaddr > SIZE_MAX - slice->linkedit_filesize)
+    {
+        PLCF_DEBUG("Image in %s has an unsupported segment layout", binary_path);
+        err = PLCRASH_EINVAL;
+        goto cleanup;
+    }
+
+    /*
+     * Lay out the header and __LINKEDIT segment at their expected offsets. The region between them is reserved,
+     * but never touched; the symtab reader only references __LINKEDIT.
+     */
+    uint64_t linkedit_offset = slice->linkedit_vmaddr - slice->text_vmaddr;
+    layout_size = (size_t) (linkedit_offset + slice->linkedit_filesize);
+    layout = mmap(NULL, layout_size, PROT_READ|PROT_WRITE, MAP_ANON|MAP_PRIVATE, -1, 0);
+    if (layout == MAP_FAILED) {
+        PLCF_DEBUG("Could not reserve %zu bytes for image layout: %s", layout_size, strerror(errno));
+        err = PLCRASH_ENOMEM;
+        goto cleanup;
+    }
+
+    memcpy(layout, slice->data, (size_t) slice->header_size);
+    memcpy((uint8_t *) layout + linkedit_offset, slice->data + slice->linkedit_fileoff, (size_t) slice->linkedit_filesize);
+
+    if ((err = plcrash_nasync_macho_init(&image, mach_task_self(), binary_path, (pl_vm_address_t) layout)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Could not parse image in %s: %d", binary_path, err);
+        goto cleanup;
+    }
+    image_initialized = true;
+
+    /* Write the store */
+    struct write_store_ctx wctx = { &image, slice, uuid };
+    err = write_store_atomically(store_path, write_store, &wctx);
+
+cleanup:
+    if (image_initialized)
+        plcrash_nasync_macho_free(&image);
+
+    if (layout != MAP_FAILED)
+        munmap(layout, layout_size);
+
+    unmap_file(&file);
+    return err;
+}
+
+/**
+ * @internal
+ *
+ * Context for write_symbols_store().
+ */
+struct write_symbols_ctx {
+    /** The image UUID. */
+    const uint8_t *uuid;
+
+    /** The symbols to be written. */
+    const plcrash_symbol_store_symbol_t *symbols;
+    size_t count;
+};
+
+/**
+ * Order two symbols by address, and then by their original position, so that sorting is stable.
+ */
+static int symbol_compare (const void *a, const void *b) {
+    const plcrash_symbol_store_symbol_t * const *lhs = a;
+    const plcrash_symbol_store_symbol_t * const *rhs = b;
+
+    if ((*lhs)->address < (*rhs)->address)
+        return -1;
+    else if ((*lhs)->address > (*rhs)->address)
+        return 1;
+
+    return (*lhs < *rhs) ? -1 : (*lhs > *rhs);
+}
+
+/**
+ * Write the symbol-only store described by the write_symbols_ctx @a ctx to @a fd.
+ */
+static plcrash_error_t write_symbols_store (int fd, void *ctx) {
+    struct write_symbols_ctx *wctx = ctx;
+    const plcrash_symbol_store_symbol_t **sorted = NULL;
+    plcrash_symbol_store_entry_t *entries = NULL;
+    string_table_t strings = { NULL, 0, 0 };
+    plcrash_error_t err;
+
+    if (wctx->count > UINT32_MAX)
+        return PLCRASH_EINVAL;
+
+    size_t alloc_count = wctx->count > 0 ? wctx->count : 1;
+    if ((sorted = malloc(alloc_count * sizeof(*sorted))) == NULL || (entries = calloc(alloc_count, sizeof(*entries))) == NULL) {
+        err = PLCRASH_ENOMEM;
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < wctx->count; i++)
+        sorted[i] = &wctx->symbols[i];
+    qsort(sorted, wctx->count, sizeof(*sorted), symbol_compare);
+
+    /* Keep the first symbol defined at each address */
+    uint32_t count = 0;
+    for (size_t i = 0; i < wctx->count; i++) {
+        if (count > 0 && entries[count - 1].address == sorted[i]->address)
+            continue;
+
+        if ((err = string_table_append(&strings, sorted[i]->name, strlen(sorted[i]->name) + 1, &entries[count].name_offset)) != PLCRASH_ESUCCESS)
+            goto cleanup;
+
+        entries[count].address = sorted[i]->address;
+        entries[count].reserved = 0;
+        count++;
+    }
+
+    err = write_store_file(fd, wctx->uuid, entries, count, NULL, 0, NULL, 0, &strings);
+
+cleanup:
+    free(sorted);
+    free(entries);
+    free(strings.data);
+    return err;
+}
+
+/**
+ * Write a symbol store containing the given @a symbols for the image identified by @a uuid to @a store_path. This
+ * is used to index images that are not available as standalone Mach-O files, such as those within a dyld shared
+ * cache; the resulting store contains no line or inline tables.
+ *
+ * As with plcrash_nasync_symbol_store_build(), the store is written to a temporary file and then renamed into place.
+ *
+ * @param store_path The path at which the store will be written.
+ * @param uuid The UUID of the indexed image.
+ * @param symbols The image's symbols, in any order. If multiple symbols share an address, the first is used.
+ * @param count The number of elements in @a symbols.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or an error result on failure.
+ */
+plcrash_error_t plcrash_nasync_symbol_store_write (const char *store_path, const uint8_t uuid[16], const plcrash_symbol_store_symbol_t *symbols, size_t count) {
+    struct write_symbols_ctx wctx = { uuid, symbols, count };
+    return write_store_atomically(store_path, write_symbols_store, &wctx);
+}
+
+/**
+ * Open and validate the symbol store at @a path.
+ *
+ * @param store The store to initialize.
+ * @param path The path to the symbol store.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if the file is not a valid symbol store, or an error result
+ * if the file could not be read.
+ */
+plcrash_error_t plcrash_nasync_symbol_store_open (plcrash_symbol_store_t *store, const char *path) {
+    mapped_file_t file;
+    plcrash_error_t err;
+
+    if ((err = map_file(path, &file)) != PLCRASH_ESUCCESS)
+        return err;
+
+    /* Validate the header and table sizes */
+    const plcrash_symbol_store_header_t *header = (const plcrash_symbol_store_header_t *) file.data;
+    if (file.size < sizeof(*header) ||
+        memcmp(header->magic, PLCRASH_SYMBOL_STORE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PLCRASH_SYMBOL_STORE_VERSION ||
+        (uint64_t) file.size != sizeof(*header) + ((uint64_t) header->count * sizeof(plcrash_symbol_store_entry_t)) +
+            ((uint64_t) header->line_count * sizeof(plcrash_symbol_store_line_entry_t)) +
+            ((uint64_t) header->inline_count * sizeof(plcrash_symbol_store_inline_entry_t)) + header->string_table_size ||
+        (header->string_table_size > 0 && file.data[file.size - 1] != '\0'))
+    {
+        PLCF_DEBUG("Invalid symbol store %s", path);
+        unmap_file(&file);
+        return PLCRASH_EINVAL;
+    }
+
+    store->mapping = file.data;
+    store->mapping_size = file.size;
+    store->header = header;
+    store->entries = (const plcrash_symbol_store_entry_t *) (file.data + sizeof(*header));
+    store->line_entries = (const plcrash_symbol_store_line_entry_t *) (store->entries + header->count);
+    store->inline_entries = (const plcrash_symbol_store_inline_entry_t *) (store->line_entries + header->line_count);
+    store->string_table = (const char *) (store->inline_entries + header->inline_count);
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Find the symbol containing @a address. As symbol sizes are not recorded, the nearest preceding symbol is
+ * returned.
+ *
+ * @param store The store to search.
+ * @param address The address to look up, relative to the image's Mach-O header.
+ * @param name On success, the symbol's name. The name references the store's mapping, and is valid until the store
+ * is closed.
+ * @param symbol_address On success, the symbol's start address, relative to the image's Mach-O header.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOTFOUND if no symbol precedes @a address.
+ *
+ * @note This function may be called concurrently from multiple threads.
+ */
+plcrash_error_t plcrash_nasync_symbol_store_lookup (plcrash_symbol_store_t *store, uint64_t address, const char **name, uint64_t *symbol_address) {
+    uint32_t count = store->header->count;
+    if (count == 0 || address < store->entries[0].address)
+        return PLCRASH_ENOTFOUND;
+
+    /* Find the last entry with an address <= the target address */
+    uint32_t low = 0;
+    uint32_t high = count - 1;
+    while (low < high) {
+        uint32_t mid = low + ((high - low + 1) / 2);
+        if (store->entries[mid].address <= address)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    const plcrash_symbol_store_entry_t *entry = &store->entries[low];
+    if (entry->name_offset >= store->header->string_table_size)
+        return PLCRASH_ENOTFOUND;
+
+    *name = store->string_table + entry->name_offset;
+    *symbol_address = entry->address;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Find the source file and line of @a address.
+ *
+ * @param store The store to search.
+ * @param address The address to look up, relative to the image's Mach-O header.
+ * @param file On success, the source file path. The path references the store's mapping, and is valid until the
+ * store is closed.
+ * @param line On success, the source line number.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOTFOUND if the store has no line table, or the line table
+ * defines no source position for @a address.
+ *
+ * @note This function may be called concurrently from multiple threads.
+ */
+plcrash_error_t plcrash_nasync_symbol_store_lookup_line (plcrash_symbol_store_t *store, uint64_t address, const char **file, uint32_t *line) {
+    uint32_t count = store->header->line_count;
+    if (count == 0 || address < store->line_entries[0].address)
+        return PLCRASH_ENOTFOUND;
+
+    /* Find the last entry with an address <= the target address */
+    uint32_t low = 0;
+    uint32_t high = count - 1;
+    while (low < high) {
+        uint32_t mid = low + ((high - low + 1) / 2);
+        if (store->line_entries[mid].address <= address)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    const plcrash_symbol_store_line_entry_t *entry = &store->line_entries[low];
+    if (entry->line == 0 || entry->file_offset >= store->header->string_table_size)
+        return PLCRASH_ENOTFOUND;
+
+    *file = store->string_table + entry->file_offset;
+    *line = entry->line;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Find the innermost inlined subroutine range containing @a address. The enclosing inlined subroutines may be
+ * enumerated via plcrash_nasync_symbol_store_inline_parent().
+ *
+ * @param store The store to search.
+ * @param address The address to look up, relative to the image's Mach-O header.
+ *
+ * @return Returns the innermost entry, which references the store's mapping and is valid until the store is closed,
+ * or NULL if @a address is not within an inlined subroutine.
+ *
+ * @note This function may be called concurrently from multiple threads.
+ */
+const plcrash_symbol_store_inline_entry_t *plcrash_nasync_symbol_store_lookup_inline (plcrash_symbol_store_t *store, uint64_t address) {
+    uint32_t count = store->header->inline_count;
+    if (count == 0 || address < store->inline_entries[0].low)
+        return NULL;
+
+    /* Find the last entry with a start address <= the target address */
+    uint32_t low = 0;
+    uint32_t high = count - 1;
+    while (low < high) {
+        uint32_t mid = low + ((high - low + 1) / 2);
+        if (store->inline_entries[mid].low <= address)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    /* The innermost containing range is either this entry, or one of the entries enclosing it */
+    const plcrash_symbol_store_inline_entry_t *entry = &store->inline_entries[low];
+    while (entry != NULL && (address < entry->low || address >= entry->high))
+        entry = plcrash_nasync_symbol_store_inline_parent(store, entry);
+
+    return entry;
+}
+
+/**
+ * Return the entry enclosing @a entry, or NULL if @a entry is not enclosed by another inlined subroutine.
+ *
+ * @param store The store containing @a entry.
+ * @param entry An entry returned by plcrash_nasync_symbol_store_lookup_inline() or
+ * plcrash_nasync_symbol_store_inline_parent().
+ *
+ * @note This function may be called concurrently from multiple threads.
+ */
+const plcrash_symbol_store_inline_entry_t *plcrash_nasync_symbol_store_inline_parent (plcrash_symbol_store_t *store, const plcrash_symbol_store_inline_entry_t *entry) {
+    /* Parents always precede their children; this also guarantees that a walk of a malformed store terminates */
+    if (entry->parent >= (uint32_t) (entry - store->inline_entries))
+        return NULL;
+
+    return &store->inline_entries[entry->parent];
+}
+
+/**
+ * Return the NUL-terminated string at @a offset within the store's string table, or NULL if @a offset is
+ * PLCRASH_SYMBOL_STORE_INLINE_NONE or otherwise out of range.
+ *
+ * @param store The store.
+ * @param offset The string table offset.
+ */
+const char *plcrash_nasync_symbol_store_string (plcrash_symbol_store_t *store, uint32_t offset) {
+    if (offset >= store->header->string_table_size)
+        return NULL;
+
+    return store->string_table + offset;
+}
+
+/**
+ * Close a store opened via plcrash_nasync_symbol_store_open().
+ *
+ * @param store The store to close.
+ */
+void plcrash_nasync_symbol_store_close (plcrash_symbol_store_t *store) {
+    munmap((void *) store->mapping, store->mapping_size);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_SYMBOL_STORE_H
+#define PLCRASH_SYMBOL_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <mach/machine.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_symbol_store Offline Symbol Stores
+ * @ingroup plcrash_internal
+ *
+ * Implements an on-disk, address-sorted symbol index for a single Mach-O image, used to symbolicate reports
+ * after the fact.
+ *
+ * A store is built from a Mach-O binary or dSYM on disk by laying out the image's header and __LINKEDIT segment
+ * as they would be mapped by dyld, and then indexing the symbol table via plcrash_nasync_macho_build_symbol_index().
+ * The resulting store is a flat file that is memory-mapped for lookups; it requires no parsing on open, and may be
+ * shared by any number of threads. Stores for images that are not available as standalone files, such as the system
+ * libraries within a dyld shared cache, may also be written directly from a list of symbols via
+ * plcrash_nasync_symbol_store_write().
+ *
+ * If the image's DWARF debug information is available (eg, when building from a dSYM), the store also includes
+ * the image's line table, decoded from __debug_line via plcrash_nasync_dwarf_line_table_parse(), so that the
+ * source file and line of an address may be resolved with a single binary search. The address ranges of the image's
+ * inlined subroutines are likewise decoded from __debug_info via plcrash_nasync_dwarf_inline_table_parse(), and
+ * stored as a flattened interval tree: a list of ranges sorted by start address, each linked to the innermost range
+ * that encloses it. The inlined call chain of an address is found with a single binary search, followed by a walk of
+ * the enclosing ranges.
+ *
+ * @par Store Format
+ * A store consists of a plcrash_symbol_store_header_t, followed by the header's @a count plcrash_symbol_store_entry_t
+ * entries, sorted by address, followed by the header's @a line_count plcrash_symbol_store_line_entry_t entries,
+ * sorted by address, followed by the header's @a inline_count plcrash_symbol_store_inline_entry_t entries, sorted by
+ * start address, followed by the string table of NUL-terminated symbol names and source file paths. All values
+ * are written in host byte order. Stores are named by the indexed image's UUID, and an incompatible change to the format must
+ * increment PLCRASH_SYMBOL_STORE_VERSION; stores with an unknown version are rejected and rebuilt.
+ *
+ * @{
+ */
+
+/** The symbol store file magic. */
+#define PLCRASH_SYMBOL_STORE_MAGIC "plcrsym"
+
+/** The symbol store format version. */
+#define PLCRASH_SYMBOL_STORE_VERSION 3
+
+/** The file extension used for symbol stores. */
+#define PLCRASH_SYMBOL_STORE_EXTENSION "plsym"
+
+/**
+ * @internal
+ *
+ * A single symbol store entry. Entries are sorted by address, and each address is unique.
+ */
+typedef struct plcrash_symbol_store_entry {
+    /** The symbol's address, relative to the image's Mach-O header. */
+    uint64_t address;
+
+    /** The offset of the symbol's NUL-terminated name within the store's string table. */
+    uint32_t name_offset;
+
+    /** Reserved; must be zero. */
+    uint32_t reserved;
+} plcrash_symbol_store_entry_t;
+
+/**
+ * @internal
+ *
+ * A single line table entry. Entries are sorted by address, and each address is unique. Each entry defines the
+ * source position of all addresses up to the address of the next entry; an entry with a line of 0 marks a range
+ * of addresses with no source position.
+ */
+typedef struct plcrash_symbol_store_line_entry {
+    /** The entry's start address, relative to the image's Mach-O header. */
+    uint64_t address;
+
+    /** The offset of the NUL-terminated source file path within the store's string table. Undefined if @a line is 0. */
+    uint32_t file_offset;
+
+    /** The source line number, or 0 if the address range has no source position. */
+    uint32_t line;
+} plcrash_symbol_store_line_entry_t;
+
+/** The string table offset and parent index used to mark an undefined value in a plcrash_symbol_store_inline_entry_t. */
+#define PLCRASH_SYMBOL_STORE_INLINE_NONE UINT32_MAX
+
+/**
+ * @internal
+ *
+ * A single address range of an inlined subroutine. Entries are sorted by start address, with enclosing ranges
+ * ordered before the ranges they enclose, and each entry references the innermost entry enclosing it; the entries
+ * form a flattened interval tree, in which the parent of an entry always precedes it.
+ */
+typedef struct plcrash_symbol_store_inline_entry {
+    /** The range's start address, relative to the image's Mach-O header. */
+    uint64_t low;
+
+    /** The range's end address (exclusive), relative to the image's Mach-O header. */
+    uint64_t high;
+
+    /** The offset of the inlined function's NUL-terminated name within the store's string table, or
+     * PLCRASH_SYMBOL_STORE_INLINE_NONE if unknown. */
+    uint32_t name_offset;
+
+    /** The offset of the NUL-terminated call site source file path within the store's string table, or
+     * PLCRASH_SYMBOL_STORE_INLINE_NONE if unknown. */
+    uint32_t call_file_offset;
+
+    /** The call site source line, or 0 if unknown. */
+    uint32_t call_line;
+
+    /** The index of the innermost enclosing entry, or PLCRASH_SYMBOL_STORE_INLINE_NONE if the range is not enclosed by
+     * another inlined subroutine. */
+    uint32_t parent;
+} plcrash_symbol_store_inline_entry_t;
+
+/**
+ * @internal
+ *
+ * The symbol store file header. The header is followed by @a count symbol entries, @a line_count line entries,
+ * @a inline_count inline entries, and then the string table.
+ */
+typedef struct plcrash_symbol_store_header {
+    /** File magic; see PLCRASH_SYMBOL_STORE_MAGIC. Not NUL terminated. */
+    char magic[7];
+
+    /** File version; see PLCRASH_SYMBOL_STORE_VERSION. */
+    uint8_t version;
+
+    /** The UUID of the indexed image. */
+    uint8_t uuid[16];
+
+    /** The number of symbol entries. */
+    uint32_t count;
+
+    /** The size of the string table, in bytes. */
+    uint32_t string_table_size;
+
+    /** The number of line table entries. */
+    uint32_t line_count;
+
+    /** The number of inline entries. */
+    uint32_t inline_count;
+} plcrash_symbol_store_header_t;
+
+/**
+ * @internal
+ *
+ * A memory-mapped symbol store.
+ */
+typedef struct plcrash_symbol_store {
+    /** The mapped store file. */
+    const void *mapping;
+
+    /** The size of @a mapping. */
+    size_t mapping_size;
+
+    /** The store header. */
+    const plcrash_symbol_store_header_t *header;
+
+    /** The symbol entries. */
+    const plcrash_symbol_store_entry_t *entries;
+
+    /** The line table entries. */
+    const plcrash_symbol_store_line_entry_t *line_entries;
+
+    /** The inline entries. */
+    const plcrash_symbol_store_inline_entry_t *inline_entries;
+
+    /** The string table. */
+    const char *string_table;
+} plcrash_symbol_store_t;
+
+/**
+ * @internal
+ *
+ * A symbol to be written via plcrash_nasync_symbol_store_write().
+ */
+typedef struct plcrash_symbol_store_symbol {
+    /** The symbol's address, relative to the image's Mach-O header. */
+    uint64_t address;
+
+    /** The symbol's NUL-terminated name. */
+    const char *name;
+} plcrash_symbol_store_symbol_t;
+
+/**
+ * Prototype of a callback function used to report the images contained within a Mach-O file.
+ *
+ * @param uuid The image's UUID.
+ * @param cputype The image's CPU type.
+ * @param cpusubtype The image's CPU subtype.
+ * @param ctx The API client's supplied context value.
+ */
+typedef void (*plcrash_symbol_store_image_cb)(const uint8_t uuid[16], cpu_type_t cputype, cpu_subtype_t cpusubtype, void *ctx);
+
+plcrash_error_t plcrash_nasync_symbol_store_image_uuids (const char *path, plcrash_symbol_store_image_cb callback, void *ctx);
+plcrash_error_t plcrash_nasync_symbol_store_build (const char *binary_path, const uint8_t uuid[16], const char *store_path);
+plcrash_error_t plcrash_nasync_symbol_store_write (const char *store_path, const uint8_t uuid[16], const plcrash_symbol_store_symbol_t *symbols, size_t count);
+
+plcrash_error_t plcrash_nasync_symbol_store_open (plcrash_symbol_store_t *store, const char *path);
+plcrash_error_t plcrash_nasync_symbol_store_lookup (plcrash_symbol_store_t *store, uint64_t address, const char **name, uint64_t *symbol_address);
+plcrash_error_t plcrash_nasync_symbol_store_lookup_line (plcrash_symbol_store_t *store, uint64_t address, const char **file, uint32_t *line);
+const plcrash_symbol_store_inline_entry_t *plcrash_nasync_symbol_store_lookup_inline (plcrash_symbol_store_t *store, uint64_t address);
+const plcrash_symbol_store_inline_entry_t *plcrash_nasync_symbol_store_inline_parent (plcrash_symbol_store_t *store, const plcrash_symbol_store_inline_entry_t *entry);
+const char *plcrash_nasync_symbol_store_string (plcrash_symbol_store_t *store, uint32_t offset);
+void plcrash_nasync_symbol_store_close (plcrash_symbol_store_t *store);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_SYMBOL_STORE_H */
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashSymbolStore.h"
+
+#import <dlfcn.h>
+#import <mach-o/loader.h>
+
+@interface PLCrashSymbolStoreTests : SenTestCase {
+@private
+    /** Store path. */
+    NSString *_path;
+}
+@end
+
+/* A known symbol to be resolved via the symbol store */
+void plcrash_symbol_store_test_function (void);
+void plcrash_symbol_store_test_function (void) {
+    __asm__ volatile ("");
+}
+
+@implementation PLCrashSymbolStoreTests
+
+- (void) setUp {
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _path error: NULL];
+    [_path release];
+}
+
+/* Fetch the LC_UUID of the loaded image at @a header */
+static BOOL loaded_image_uuid (const struct mach_header *header, uint8_t uuid[16]) {
+    const uint8_t *cmd = (const uint8_t *) header + (header->magic == MH_MAGIC_64 ? sizeof(struct mach_header_64) : sizeof(struct mach_header));
+    for (uint32_t i = 0; i < header->ncmds; i++) {
+        const struct load_command *lc = (const struct load_command *) cmd;
+        if (lc->cmd == LC_UUID) {
+            memcpy(uuid, ((const struct uuid_command *) lc)->uuid, 16);
+            return YES;
+        }
+        cmd += lc->cmdsize;
+    }
+
+    return NO;
+}
+
+/**
+ * Verify that a store built from this test bundle's binary resolves a known symbol.
+ */
+- (void) testBuildAndLookup {
+    Dl_info info;
+    uint8_t uuid[16];
+
+    STAssertTrue(dladdr((void *) &plcrash_symbol_store_test_function, &info) != 0, @"Could not find test function image");
+    STAssertTrue(loaded_image_uuid(info.dli_fbase, uuid), @"Could not find test image UUID");
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_symbol_store_build(info.dli_fname, uuid, [_path fileSystemRepresentation]), @"Failed to build symbol store");
+
+    plcrash_symbol_store_t store;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_symbol_store_open(&store, [_path fileSystemRepresentation]), @"Failed to open symbol store");
+    STAssertTrue(memcmp(store.header->uuid, uuid, sizeof(uuid)) == 0, @"Incorrect store UUID");
+
+    /* Look up an address within the function */
+    uint64_t offset = (uintptr_t) &plcrash_symbol_store_test_function - (uintptr_t) info.dli_fbase;
+    const char *name;
+    uint64_t symbol_address;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_symbol_store_lookup(&store, offset, &name, &symbol_address), @"Symbol lookup failed");
+    STAssertEqualCStrings(name, "_plcrash_symbol_store_test_function", @"Incorrect symbol name");
+    STAssertEquals(offset, symbol_address, @"Incorrect symbol address");
+
+    plcrash_nasync_symbol_store_close(&store);
+}
+
+/**
+ * Verify that a store written from a symbol list is sorted, and keeps the first symbol defined at each address.
+ */
+- (void) testWriteSymbols {
+    uint8_t uuid[16] = { 0xA, 0xB, 0xC };
+    plcrash_symbol_store_symbol_t symbols[] = {
+        { 0x200, "_second" },
+        { 0x100, "_first" },
+        { 0x200, "_second_alias" },
+    };
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_symbol_store_write([_path fileSystemRepresentation], uuid, symbols, 3), @"Failed to write symbol store");
+
+    plcrash_symbol_store_t store;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_symbol_store_open(&store, [_path fileSystemRepresentation]), @"Failed to open symbol store");
+    STAssertTrue(memcmp(store.header->uuid, uuid, sizeof(uuid)) == 0, @"Incorrect store UUID");
+    STAssertEquals(store.header->count, (uint32_t) 2, @"Duplicate address was not coalesced");
+
+    const char *name;
+    uint64_t symbol_address;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_symbol_store_lookup(&store, 0x180, &name, &symbol_address), @"Symbol lookup failed");
+    STAssertEqualCStrings(name, "_first", @"Incorrect symbol name");
+    STAssertEquals(symbol_address, (uint64_t) 0x100, @"Incorrect symbol address");
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_symbol_store_lookup(&store, 0x200, &name, &symbol_address), @"Symbol lookup failed");
+    STAssertEqualCStrings(name, "_second", @"Incorrect symbol name");
+
+    plcrash_nasync_symbol_store_close(&store);
+}
+
+/**
+ * Verify that an invalid store is rejected.
+ */
+- (void) testInvalidStore {
+    [[NSData dataWithBytes: "plcrsym" length: 7] writeToFile: _path atomically: NO];
+
+    plcrash_symbol_store_t store;
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_symbol_store_open(&store, [_path fileSystemRepresentation]), @"Truncated store was accepted");
+}
+
+/**
+ * Verify that non-Mach-O files are ignored when scanning for images.
+ */
+- (void) testImageUUIDsNotMachO {
+    [[NSData dataWithBytes: "not a binary" length: 12] writeToFile: _path atomically: NO];
+    STAssertEquals(PLCRASH_ENOTFOUND, plcrash_nasync_symbol_store_image_uuids([_path fileSystemRepresentation], NULL, NULL), @"Non-Mach-O file was accepted");
+}
+
+@end
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <pthread.h>
+
+#import "PLCrashReportSymbolicator.h"
+
+@interface PLCrashSymbolicationServer : NSObject {
+@private
+    /** The symbolicator shared by all workers. */
+    PLCrashReportSymbolicator *_symbolicator;
+
+    /** The path of the server's Unix domain socket. */
+    NSString *_socketPath;
+
+    /** The number of worker threads. */
+    NSUInteger _workerCount;
+
+    /** The listening socket, or -1 if the server is not running. */
+    int _listenSocket;
+
+    /** Pipe used to wake the accept and worker threads when the server is stopped. */
+    int _wakePipe[2];
+
+    /** The accept thread and worker threads. */
+    pthread_t _acceptThread;
+    pthread_t *_workers;
+
+    /** Guards @a _pending and @a _running, and is signaled when either changes. */
+    pthread_mutex_t _lock;
+    pthread_cond_t _cond;
+
+    /** Accepted connections awaiting a worker, as NSNumber file descriptors. */
+    NSMutableArray *_pending;
+
+    /** YES while the server is running. */
+    BOOL _running;
+}
+
+- (id) initWithSymbolicator: (PLCrashReportSymbolicator *) symbolicator socketPath: (NSString *) socketPath workerCount: (NSUInteger) workerCount;
+
+- (BOOL) startAndReturnError: (NSError **) outError;
+- (void) stop;
+
+/** The symbolicator used to process requests. */
+@property(nonatomic, readonly) PLCrashReportSymbolicator *symbolicator;
+
+/** The path of the server's Unix domain socket. */
+@property(nonatomic, readonly) NSString *socketPath;
+
+/** The number of connections that may be served concurrently. */
+@property(nonatomic, readonly) NSUInteger workerCount;
+
+@end
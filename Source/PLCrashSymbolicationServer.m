@@ -0,0 +1,568 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashSymbolicationServer.h"
+
+#import "CrashReporter.h"
+#import "PLCrashReporterNSError.h"
+#import "PLCrashAsync.h"
+#import "PLCrashAsyncProtobufReader.h"
+#import "PLCrashLogWriterEncoding.h"
+#import "PLCrashReportFieldIDs.h"
+
+#import <sys/socket.h>
+#import <sys/stat.h>
+#import <sys/un.h>
+#import <poll.h>
+#import <errno.h>
+#import <unistd.h>
+
+/** The maximum accepted request size, in bytes. The connection is closed if a larger request is received. */
+#define PLCRASH_SYMBOLICATION_SERVER_MAX_REQUEST (256 * 1024 * 1024)
+
+/** The size of each response's output buffer, in bytes. */
+#define PLCRASH_SYMBOLICATION_SERVER_BUFFER_SIZE (64 * 1024)
+
+/** The listen() backlog. */
+#define PLCRASH_SYMBOLICATION_SERVER_BACKLOG 128
+
+/**
+ * @internal
+ *
+ * The result of processing a single report, as written to a SymbolicationResponse.Result.
+ */
+typedef struct server_result {
+    /** The output data, or a zero-length value if the report could not be processed. */
+    PLProtobufCBinaryData output;
+
+    /** The failure description, or NULL if the report was processed successfully. */
+    const char *error;
+
+    /** The encoded size of the result message. */
+    uint32_t size;
+} server_result_t;
+
+/**
+ * Wait until @a fd is readable. Returns NO if @a wake_fd became readable first, indicating that the server is stopping.
+ */
+static BOOL server_wait_readable (int fd, int wake_fd) {
+    struct pollfd fds[2] = {
+        { fd, POLLIN, 0 },
+        { wake_fd, POLLIN, 0 }
+    };
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            return NO;
+        }
+
+        return (fds[1].revents == 0);
+    }
+}
+
+/**
+ * Read exactly @a len bytes from @a fd into @a buffer. Returns NO on end of file, error, or if the server is stopping.
+ */
+static BOOL server_read_fully (int fd, int wake_fd, void *buffer, size_t len) {
+    uint8_t *p = buffer;
+
+    while (len > 0) {
+        if (!server_wait_readable(fd, wake_fd))
+            return NO;
+
+        ssize_t nread = read(fd, p, len);
+        if (nread < 0 && errno == EINTR)
+            continue;
+        else if (nread <= 0)
+            return NO;
+
+        p += nread;
+        len -= (size_t) nread;
+    }
+
+    return YES;
+}
+
+/**
+ * Read a varint message length prefix from @a fd. Returns NO on end of file, error, if the prefix is invalid, or if
+ * the server is stopping.
+ */
+static BOOL server_read_length (int fd, int wake_fd, uint64_t *length) {
+    *length = 0;
+
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!server_read_fully(fd, wake_fd, &byte, 1))
+            return NO;
+
+        *length |= (uint64_t) (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return YES;
+    }
+
+    return NO;
+}
+
+/**
+ * Write a SymbolicationResponse containing @a results, or the request-level failure @a error, to @a fd, preceded by
+ * its varint length prefix. Returns NO if the response could not be written.
+ */
+static BOOL server_write_response (int fd, server_result_t *results, size_t count, const char *error) {
+    char buffer[PLCRASH_SYMBOLICATION_SERVER_BUFFER_SIZE];
+    plcrash_async_file_t file;
+    size_t size = 0;
+
+    /* Size the response */
+    for (size_t i = 0; i < count; i++) {
+        server_result_t *result = &results[i];
+        if (result->error != NULL) {
+            result->size = (uint32_t) plcrash_writer_pack_size(PLCRASH_PROTO_RESULT_ERROR_ID, PLPROTOBUF_C_TYPE_STRING, result->error);
+        } else {
+            result->size = (uint32_t) plcrash_writer_pack_size(PLCRASH_PROTO_RESULT_OUTPUT_ID, PLPROTOBUF_C_TYPE_BYTES, &result->output);
+        }
+
+        size += plcrash_writer_pack_size(PLCRASH_PROTO_RESPONSE_RESULTS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &result->size) + result->size;
+    }
+
+    if (error != NULL)
+        size += plcrash_writer_pack_size(PLCRASH_PROTO_RESPONSE_ERROR_ID, PLPROTOBUF_C_TYPE_STRING, error);
+
+    /* Write the length prefix */
+    uint8_t prefix[10];
+    size_t prefix_len = 0;
+    uint64_t remaining = size;
+    do {
+        prefix[prefix_len++] = (uint8_t) ((remaining & 0x7F) | (remaining > 0x7F ? 0x80 : 0));
+        remaining >>= 7;
+    } while (remaining != 0);
+
+    plcrash_async_file_init_buffer(&file, fd, 0, buffer, sizeof(buffer));
+    plcrash_async_file_write(&file, prefix, prefix_len);
+
+    /* Write the response */
+    for (size_t i = 0; i < count; i++) {
+        server_result_t *result = &results[i];
+        plcrash_writer_pack(&file, PLCRASH_PROTO_RESPONSE_RESULTS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &result->size);
+
+        if (result->error != NULL) {
+            plcrash_writer_pack(&file, PLCRASH_PROTO_RESULT_ERROR_ID, PLPROTOBUF_C_TYPE_STRING, result->error);
+        } else {
+            plcrash_writer_pack(&file, PLCRASH_PROTO_RESULT_OUTPUT_ID, PLPROTOBUF_C_TYPE_BYTES, &result->output);
+        }
+    }
+
+    if (error != NULL)
+        plcrash_writer_pack(&file, PLCRASH_PROTO_RESPONSE_ERROR_ID, PLPROTOBUF_C_TYPE_STRING, error);
+
+    return plcrash_async_file_flush(&file);
+}
+
+@interface PLCrashSymbolicationServer (PrivateMethods)
+
+- (void) runAcceptLoop;
+- (void) runWorker;
+- (BOOL) serveRequestOnSocket: (int) fd;
+- (NSData *) processReport: (NSData *) data formatter: (id<PLCrashReportFormatter>) formatter error: (NSError **) outError;
+
+@end
+
+/* Accept thread entry point */
+static void *server_accept_thread (void *ctx) {
+    [(PLCrashSymbolicationServer *) ctx runAcceptLoop];
+    return NULL;
+}
+
+/* Worker thread entry point */
+static void *server_worker_thread (void *ctx) {
+    [(PLCrashSymbolicationServer *) ctx runWorker];
+    return NULL;
+}
+
+/**
+ * A long-running symbolication server, which symbolicates (and optionally converts) batches of crash reports received
+ * over a Unix domain socket, using a single shared PLCrashReportSymbolicator.
+ *
+ * Keeping the symbolicator live across requests keeps its symbol stores mapped and its lookup results cached, so that
+ * the cost of opening and indexing symbol files is paid once, rather than for every batch. When the symbolicator is
+ * configured with a mapped store limit, the least recently used stores are closed as new stores are opened.
+ *
+ * Requests and responses are the varint length-prefixed SymbolicationRequest and SymbolicationResponse messages defined
+ * in symbolication_service.proto. Connections are served by a fixed pool of worker threads; each worker serves a single
+ * connection at a time, answering its requests in order until the client closes it, and further connections wait for
+ * a free worker.
+ */
+@implementation PLCrashSymbolicationServer
+
+@synthesize symbolicator = _symbolicator;
+@synthesize socketPath = _socketPath;
+@synthesize workerCount = _workerCount;
+
+/**
+ * Initialize a new server. The server must be started via startAndReturnError:.
+ *
+ * @param symbolicator The symbolicator used to process all requests.
+ * @param socketPath The path at which the server's Unix domain socket will be created. Any existing socket at this path
+ * will be replaced.
+ * @param workerCount The number of worker threads, and therefore the number of connections that may be served
+ * concurrently. Must be at least 1.
+ */
+- (id) initWithSymbolicator: (PLCrashReportSymbolicator *) symbolicator socketPath: (NSString *) socketPath workerCount: (NSUInteger) workerCount {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _symbolicator = [symbolicator retain];
+    _socketPath = [socketPath copy];
+    _workerCount = workerCount > 0 ? workerCount : 1;
+    _listenSocket = -1;
+    _wakePipe[0] = -1;
+    _wakePipe[1] = -1;
+    _pending = [[NSMutableArray alloc] init];
+
+    pthread_mutex_init(&_lock, NULL);
+    pthread_cond_init(&_cond, NULL);
+
+    return self;
+}
+
+- (void) dealloc {
+    [self stop];
+
+    pthread_mutex_destroy(&_lock);
+    pthread_cond_destroy(&_cond);
+
+    [_symbolicator release];
+    [_socketPath release];
+    [_pending release];
+
+    [super dealloc];
+}
+
+/**
+ * Create the server's socket, and start accepting connections.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error in the PLCrashReporterErrorDomain indicating why the server
+ * could not be started. If no error occurs, this parameter will be left unmodified. You may
+ * specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns YES on success, or NO if the server could not be started.
+ */
+- (BOOL) startAndReturnError: (NSError **) outError {
+    struct sockaddr_un addr;
+    struct stat sb;
+    NSString *desc;
+
+    if (_listenSocket >= 0)
+        return YES;
+
+    const char *path = [_socketPath fileSystemRepresentation];
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"The server socket path is too long.", nil);
+        return NO;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strlcpy(addr.sun_path, path, sizeof(addr.sun_path));
+
+    /* Replace any stale socket left by a previous server */
+    if (lstat(path, &sb) == 0 && S_ISSOCK(sb.st_mode))
+        unlink(path);
+
+    if ((_listenSocket = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+        desc = @"Could not create the server socket.";
+        goto error;
+    }
+
+    if (bind(_listenSocket, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+        desc = @"Could not bind the server socket.";
+        goto error;
+    }
+
+    if (listen(_listenSocket, PLCRASH_SYMBOLICATION_SERVER_BACKLOG) != 0) {
+        desc = @"Could not listen on the server socket.";
+        goto error;
+    }
+
+    if (pipe(_wakePipe) != 0) {
+        desc = @"Could not create the server wake pipe.";
+        _wakePipe[0] = _wakePipe[1] = -1;
+        goto error;
+    }
+
+    /* Start the workers, followed by the accept thread */
+    int err;
+    _running = YES;
+    _workers = calloc(_workerCount, sizeof(*_workers));
+    for (NSUInteger i = 0; i < _workerCount; i++) {
+        if ((err = pthread_create(&_workers[i], NULL, server_worker_thread, self)) != 0) {
+            errno = err;
+            _workerCount = i;
+            desc = @"Could not start the server's worker threads.";
+            goto error;
+        }
+    }
+
+    if ((err = pthread_create(&_acceptThread, NULL, server_accept_thread, self)) != 0) {
+        errno = err;
+        desc = @"Could not start the server's accept thread.";
+        goto error;
+    }
+
+    return YES;
+
+error:
+    {
+        NSError *osError = [NSError errorWithDomain: NSPOSIXErrorDomain code: errno userInfo: nil];
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, desc, osError);
+    }
+
+    /* Stop any started workers; the accept thread was not started */
+    pthread_mutex_lock(&_lock);
+    _running = NO;
+    pthread_cond_broadcast(&_cond);
+    pthread_mutex_unlock(&_lock);
+
+    for (NSUInteger i = 0; _workers != NULL && i < _workerCount; i++)
+        pthread_join(_workers[i], NULL);
+
+    free(_workers);
+    _workers = NULL;
+
+    if (_wakePipe[0] >= 0) {
+        close(_wakePipe[0]);
+        close(_wakePipe[1]);
+        _wakePipe[0] = _wakePipe[1] = -1;
+    }
+
+    if (_listenSocket >= 0) {
+        close(_listenSocket);
+        _listenSocket = -1;
+    }
+
+    return NO;
+}
+
+/**
+ * Stop the server, closing all connections and removing its socket. Requests in progress are abandoned without a
+ * response. This method blocks until all worker threads have exited.
+ */
+- (void) stop {
+    if (_listenSocket < 0)
+        return;
+
+    pthread_mutex_lock(&_lock);
+    _running = NO;
+    pthread_cond_broadcast(&_cond);
+    pthread_mutex_unlock(&_lock);
+
+    /* The wake pipe is never drained, and wakes all threads blocked on a socket */
+    char wake = 0;
+    while (write(_wakePipe[1], &wake, 1) < 0 && errno == EINTR);
+
+    pthread_join(_acceptThread, NULL);
+    for (NSUInteger i = 0; i < _workerCount; i++)
+        pthread_join(_workers[i], NULL);
+
+    free(_workers);
+    _workers = NULL;
+
+    for (NSNumber *fd in _pending)
+        close([fd intValue]);
+    [_pending removeAllObjects];
+
+    close(_listenSocket);
+    close(_wakePipe[0]);
+    close(_wakePipe[1]);
+    _listenSocket = -1;
+    _wakePipe[0] = _wakePipe[1] = -1;
+
+    unlink([_socketPath fileSystemRepresentation]);
+}
+
+@end
+
+
+/**
+ * @internal
+ * Private Methods
+ */
+@implementation PLCrashSymbolicationServer (PrivateMethods)
+
+/**
+ * Accept connections, queueing each for the next free worker, until the server is stopped.
+ */
+- (void) runAcceptLoop {
+    while (server_wait_readable(_listenSocket, _wakePipe[0])) {
+        int fd = accept(_listenSocket, NULL, NULL);
+        if (fd < 0) {
+            if (errno != EINTR && errno != ECONNABORTED)
+                NSLog(@"Could not accept symbolication connection: %s", strerror(errno));
+            continue;
+        }
+
+#ifdef SO_NOSIGPIPE
+        /* Report writes to closed connections as errors, rather than terminating the server */
+        int nosigpipe = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &nosigpipe, sizeof(nosigpipe));
+#endif
+
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        pthread_mutex_lock(&_lock);
+        [_pending addObject: [NSNumber numberWithInt: fd]];
+        pthread_cond_signal(&_cond);
+        pthread_mutex_unlock(&_lock);
+        [pool drain];
+    }
+}
+
+/**
+ * Serve queued connections until the server is stopped.
+ */
+- (void) runWorker {
+    for (;;) {
+        pthread_mutex_lock(&_lock);
+        while (_running && [_pending count] == 0)
+            pthread_cond_wait(&_cond, &_lock);
+
+        if (!_running) {
+            pthread_mutex_unlock(&_lock);
+            break;
+        }
+
+        int fd = [[_pending objectAtIndex: 0] intValue];
+        [_pending removeObjectAtIndex: 0];
+        pthread_mutex_unlock(&_lock);
+
+        while ([self serveRequestOnSocket: fd]);
+        close(fd);
+    }
+}
+
+/**
+ * Read, process and answer a single request on @a fd. Returns NO if the connection should be closed.
+ */
+- (BOOL) serveRequestOnSocket: (int) fd {
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    server_result_t *results = NULL;
+    BOOL ok = NO;
+    uint64_t length;
+
+    if (!server_read_length(fd, _wakePipe[0], &length))
+        goto cleanup;
+
+    /* An oversized request can't be skipped without reading it; reject it and close the connection */
+    if (length > PLCRASH_SYMBOLICATION_SERVER_MAX_REQUEST) {
+        server_write_response(fd, NULL, 0, "Request exceeds the maximum request size");
+        goto cleanup;
+    }
+
+    NSMutableData *request = [NSMutableData dataWithLength: (NSUInteger) length];
+    if (!server_read_fully(fd, _wakePipe[0], [request mutableBytes], (size_t) length))
+        goto cleanup;
+
+    /* Decode the request. Reports reference the request buffer, which outlives them. */
+    uint64_t operation = PLCRASH_PROTO_OPERATION_SYMBOLICATE;
+    NSString *format = @"ios";
+    NSMutableArray *reports = [NSMutableArray array];
+
+    plcrash_async_pb_reader_t reader;
+    plcrash_async_pb_field_t field;
+    plcrash_error_t err;
+
+    plcrash_async_pb_reader_init(&reader, [request bytes], [request length]);
+    while ((err = plcrash_async_pb_reader_next(&reader, &field)) == PLCRASH_ESUCCESS) {
+        if (field.id == PLCRASH_PROTO_REQUEST_OPERATION_ID && field.wire_type == PLCRASH_PB_WIRE_TYPE_VARINT) {
+            operation = field.value;
+        } else if (field.id == PLCRASH_PROTO_REQUEST_FORMAT_ID && field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED) {
+            format = [[[NSString alloc] initWithBytes: field.data.p length: plcrash_async_pb_reader_length(&field.data) encoding: NSUTF8StringEncoding] autorelease];
+        } else if (field.id == PLCRASH_PROTO_REQUEST_REPORTS_ID && field.wire_type == PLCRASH_PB_WIRE_TYPE_LENGTH_PREFIXED) {
+            [reports addObject: [NSData dataWithBytesNoCopy: (void *) field.data.p length: plcrash_async_pb_reader_length(&field.data) freeWhenDone: NO]];
+        }
+    }
+
+    if (err != PLCRASH_ENOTFOUND) {
+        ok = server_write_response(fd, NULL, 0, "Could not decode the request");
+        goto cleanup;
+    }
+
+    /* Select the output formatter, if any */
+    id<PLCrashReportFormatter> formatter = nil;
+    if (operation == PLCRASH_PROTO_OPERATION_CONVERT) {
+        if ([format caseInsensitiveCompare: @"ios"] == NSOrderedSame || [format caseInsensitiveCompare: @"iphone"] == NSOrderedSame) {
+            formatter = [[[PLCrashReportTextFormatter alloc] initWithTextFormat: PLCrashReportTextFormatiOS stringEncoding: NSUTF8StringEncoding] autorelease];
+        } else if ([format caseInsensitiveCompare: @"ndjson"] == NSOrderedSame) {
+            formatter = [[[PLCrashReportJSONFormatter alloc] init] autorelease];
+        } else {
+            ok = server_write_response(fd, NULL, 0, "Unsupported output format");
+            goto cleanup;
+        }
+    } else if (operation != PLCRASH_PROTO_OPERATION_SYMBOLICATE) {
+        ok = server_write_response(fd, NULL, 0, "Unsupported operation");
+        goto cleanup;
+    }
+
+    /* Process the reports; the outputs are retained by the request's autorelease pool until the response is written */
+    results = calloc([reports count] > 0 ? [reports count] : 1, sizeof(*results));
+    for (NSUInteger i = 0; i < [reports count]; i++) {
+        NSError *error = nil;
+        NSData *output = [self processReport: [reports objectAtIndex: i] formatter: formatter error: &error];
+
+        if (output != nil) {
+            results[i].output.data = (void *) [output bytes];
+            results[i].output.len = [output length];
+        } else {
+            NSString *desc = [error localizedDescription];
+            results[i].error = desc != nil ? [desc UTF8String] : "Unknown error";
+        }
+    }
+
+    ok = server_write_response(fd, results, [reports count], NULL);
+
+cleanup:
+    free(results);
+    [pool drain];
+    return ok;
+}
+
+/**
+ * Symbolicate the report @a data, converting the result via @a formatter if it is non-nil.
+ */
+- (NSData *) processReport: (NSData *) data formatter: (id<PLCrashReportFormatter>) formatter error: (NSError **) outError {
+    NSData *symbolicated = [_symbolicator symbolicateCrashData: data error: outError];
+    if (symbolicated == nil || formatter == nil)
+        return symbolicated;
+
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: symbolicated error: outError] autorelease];
+    if (report == nil)
+        return nil;
+
+    return [formatter formatReport: report error: outError];
+}
+
+@end
@@ -28,6 +28,8 @@
 
 #include "PLCrashSysctl.h"
 #include <errno.h>
+#include <pthread.h>
+#include <TargetConditionals.h>
 
 /**
  * @internal
@@ -121,6 +123,46 @@ bool plcrash_sysctl_int (const char *name, int *result) {
     return true;
 }
 
+/** Process-wide host info, populated once by plcrash_sysctl_host_info_populate(). */
+static plcrash_sysctl_host_info_t host_info;
+
+/** Guards population of @a host_info. */
+static pthread_once_t host_info_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Populate the process-wide host info.
+ */
+static void plcrash_sysctl_host_info_populate (void) {
+#if TARGET_OS_IPHONE
+    /* On iOS, we want hw.machine (e.g. hw.machine = iPad2,1; hw.model = K93AP) */
+    host_info.model = plcrash_sysctl_string("hw.machine");
+#else
+    /* On Mac OS X, we want hw.model (e.g. hw.machine = x86_64; hw.model = Macmini5,3) */
+    host_info.model = plcrash_sysctl_string("hw.model");
+#endif
+
+    host_info.os_release = plcrash_sysctl_string("kern.osrelease");
+
+    host_info.has_cpu_type = plcrash_sysctl_int("hw.cputype", &host_info.cpu_type);
+    host_info.has_cpu_subtype = plcrash_sysctl_int("hw.cpusubtype", &host_info.cpu_subtype);
+    host_info.has_physical_cpu_count = plcrash_sysctl_int("hw.physicalcpu_max", &host_info.physical_cpu_count);
+    host_info.has_logical_cpu_count = plcrash_sysctl_int("hw.logicalcpu_max", &host_info.logical_cpu_count);
+    host_info.has_proc_native = plcrash_sysctl_int("sysctl.proc_native", &host_info.proc_native);
+}
+
+/**
+ * Return the process-wide host and machine information. The values are fetched on first use, and are
+ * immutable thereafter; none of the cached values may change for the lifetime of the process.
+ *
+ * The returned data must not be modified or freed.
+ *
+ * @warning This function is not async-safe on first use.
+ */
+const plcrash_sysctl_host_info_t *plcrash_sysctl_host_info (void) {
+    pthread_once(&host_info_once, plcrash_sysctl_host_info_populate);
+    return &host_info;
+}
+
 /**
  * @}
  */
@@ -46,9 +46,54 @@ extern "C" {
  * @{
  */
 
+/**
+ * @internal
+ *
+ * Immutable host and machine information, fetched once per process. See plcrash_sysctl_host_info().
+ */
+typedef struct plcrash_sysctl_host_info {
+    /** The host model (hw.machine on iOS, hw.model on Mac OS X), or NULL if unavailable. */
+    const char *model;
+
+    /** The Darwin kernel release (kern.osrelease), or NULL if unavailable. */
+    const char *os_release;
+
+    /** If true, @a cpu_type is valid. */
+    bool has_cpu_type;
+
+    /** The host CPU type (hw.cputype). */
+    int cpu_type;
+
+    /** If true, @a cpu_subtype is valid. */
+    bool has_cpu_subtype;
+
+    /** The host CPU subtype (hw.cpusubtype). */
+    int cpu_subtype;
+
+    /** If true, @a physical_cpu_count is valid. */
+    bool has_physical_cpu_count;
+
+    /** The maximum number of physical cores (hw.physicalcpu_max). */
+    int physical_cpu_count;
+
+    /** If true, @a logical_cpu_count is valid. */
+    bool has_logical_cpu_count;
+
+    /** The maximum number of logical cores (hw.logicalcpu_max). */
+    int logical_cpu_count;
+
+    /** If true, @a proc_native is valid. */
+    bool has_proc_native;
+
+    /** Zero if the current process is running under emulation (sysctl.proc_native). */
+    int proc_native;
+} plcrash_sysctl_host_info_t;
+
 char *plcrash_sysctl_string (const char *name);
 bool plcrash_sysctl_int (const char *name, int *result);
 
+const plcrash_sysctl_host_info_t *plcrash_sysctl_host_info (void);
+
 /**
  * @}
  */
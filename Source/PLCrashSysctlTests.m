@@ -53,5 +53,17 @@
     STAssertEquals(result, (int)[[NSProcessInfo processInfo] processorCount], @"Incorrect count");
 }
 
+/* Test that the cached host info is populated, and is shared across calls */
+- (void) testHostInfo {
+    const plcrash_sysctl_host_info_t *info = plcrash_sysctl_host_info();
+    STAssertNotNULL(info, @"Failed to fetch host info");
+    STAssertEquals(info, plcrash_sysctl_host_info(), @"Host info was not cached");
+
+    STAssertNotNULL(info->os_release, @"Missing OS release");
+    STAssertNotNULL(info->model, @"Missing model");
+
+    STAssertTrue(info->has_logical_cpu_count, @"Missing logical CPU count");
+    STAssertEquals(info->logical_cpu_count, (int)[[NSProcessInfo processInfo] processorCount], @"Incorrect count");
+}
 
 @end
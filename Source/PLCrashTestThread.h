@@ -53,10 +53,14 @@ typedef struct plcrash_test_thread {
     
     /** Thread signaling (used to inform waiting callee that thread is active) */
     pthread_cond_t cond;
+
+    /** Number of additional stack frames to be pushed by the thread prior to waiting. */
+    unsigned int stack_depth;
 } plcrash_test_thread_t;
 
 
 void plcrash_test_thread_spawn (plcrash_test_thread_t *thread);
+void plcrash_test_thread_spawn_depth (plcrash_test_thread_t *thread, unsigned int stack_depth);
 void plcrash_test_thread_stop (plcrash_test_thread_t *thread);
 
 /**
@@ -37,10 +37,8 @@
  * @{
  */
 
-/* Thread entry point; simply waits to be asked to exit. */
-static void *test_thread_entry (void *arg) {
-    plcrash_test_thread_t *args = arg;
-    
+/* Wait to be asked to exit; informs our caller that we're active prior to waiting. */
+static void test_thread_wait (plcrash_test_thread_t *args) {
     /* Acquire the lock and inform our caller that we're active */
     pthread_mutex_lock(&args->lock);
     pthread_cond_signal(&args->cond);
@@ -48,14 +46,40 @@ static void *test_thread_entry (void *arg) {
     /* Wait for a shut down request, and then drop the acquired lock immediately */
     pthread_cond_wait(&args->cond, &args->lock);
     pthread_mutex_unlock(&args->lock);
-    
+}
+
+/* Recurse @a depth times prior to waiting. The non-tail call and return value are used to prevent the
+ * compiler from collapsing the recursion. */
+static unsigned int __attribute__((noinline)) test_thread_recurse (plcrash_test_thread_t *args, volatile unsigned int depth) {
+    if (depth == 0) {
+        test_thread_wait(args);
+        return 0;
+    }
+
+    return test_thread_recurse(args, depth - 1) + 1;
+}
+
+/* Thread entry point; simply waits to be asked to exit. */
+static void *test_thread_entry (void *arg) {
+    plcrash_test_thread_t *args = arg;
+
+    test_thread_recurse(args, args->stack_depth);
     return NULL;
 }
 
 
 /** Spawn a test thread that may be used as an iterable stack. (For testing only!) */
 void plcrash_test_thread_spawn (plcrash_test_thread_t *args) {
+    plcrash_test_thread_spawn_depth(args, 0);
+}
+
+/**
+ * Spawn a test thread that will push at least @a stack_depth additional frames prior to waiting, providing
+ * a deeper iterable stack. (For testing only!)
+ */
+void plcrash_test_thread_spawn_depth (plcrash_test_thread_t *args, unsigned int stack_depth) {
     /* Initialize the args */
+    args->stack_depth = stack_depth;
     pthread_mutex_init(&args->lock, NULL);
     pthread_cond_init(&args->cond, NULL);
     
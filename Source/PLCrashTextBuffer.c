@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashTextBuffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_text_buffer
+ * @{
+ */
+
+/** The initial allocation size of a text buffer, in bytes. */
+#define PLCRASH_TEXT_BUFFER_INITIAL_CAPACITY (16 * 1024)
+
+/** Lowercase hexadecimal digits. */
+static const char hex_digits[] = "0123456789abcdef";
+
+/**
+ * Initialize an empty text buffer. No storage is allocated until text is first appended.
+ *
+ * @param buffer The buffer to initialize.
+ */
+void plcrash_text_buffer_init (plcrash_text_buffer_t *buffer) {
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+    buffer->failed = false;
+}
+
+/**
+ * Ensure that at least @a length bytes may be written at the end of @a buffer, returning a pointer to the first
+ * writable byte. The caller is responsible for advancing the buffer's length by the number of bytes written.
+ *
+ * @param buffer The buffer.
+ * @param length The number of bytes required.
+ *
+ * @return Returns a pointer to the writable bytes, or NULL if the buffer could not be grown. On failure, the buffer's
+ * @a failed flag is set.
+ */
+char *plcrash_text_buffer_reserve (plcrash_text_buffer_t *buffer, size_t length) {
+    if (buffer->failed)
+        return NULL;
+
+    if (buffer->capacity - buffer->length >= length)
+        return buffer->data + buffer->length;
+
+    size_t capacity = buffer->capacity > 0 ? buffer->capacity : PLCRASH_TEXT_BUFFER_INITIAL_CAPACITY;
+    while (capacity - buffer->length < length) {
+        if (capacity > SIZE_MAX / 2) {
+            buffer->failed = true;
+            return NULL;
+        }
+        capacity *= 2;
+    }
+
+    char *data = realloc(buffer->data, capacity);
+    if (data == NULL) {
+        buffer->failed = true;
+        return NULL;
+    }
+
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return buffer->data + buffer->length;
+}
+
+/**
+ * Append @a length bytes of @a text to @a buffer.
+ *
+ * @param buffer The buffer.
+ * @param text The text to append.
+ * @param length The number of bytes to append.
+ */
+void plcrash_text_buffer_append (plcrash_text_buffer_t *buffer, const char *text, size_t length) {
+    char *p = plcrash_text_buffer_reserve(buffer, length);
+    if (p == NULL)
+        return;
+
+    memcpy(p, text, length);
+    buffer->length += length;
+}
+
+/**
+ * Append the NUL-terminated @a string to @a buffer.
+ *
+ * @param buffer The buffer.
+ * @param string The string to append.
+ */
+void plcrash_text_buffer_append_string (plcrash_text_buffer_t *buffer, const char *string) {
+    plcrash_text_buffer_append(buffer, string, strlen(string));
+}
+
+/**
+ * Append @a count copies of the character @a c to @a buffer.
+ *
+ * @param buffer The buffer.
+ * @param c The character to append.
+ * @param count The number of copies to append.
+ */
+void plcrash_text_buffer_append_repeated (plcrash_text_buffer_t *buffer, char c, size_t count) {
+    char *p = plcrash_text_buffer_reserve(buffer, count);
+    if (p == NULL)
+        return;
+
+    memset(p, c, count);
+    buffer->length += count;
+}
+
+/**
+ * Append @a value in lowercase hexadecimal, without a prefix, zero-padded to at least @a min_digits digits. This is
+ * equivalent to the printf() format "%0*" PRIx64.
+ *
+ * @param buffer The buffer.
+ * @param value The value to append.
+ * @param min_digits The minimum number of digits; values greater than 16 are treated as 16.
+ */
+void plcrash_text_buffer_append_hex (plcrash_text_buffer_t *buffer, uint64_t value, unsigned int min_digits) {
+    char digits[16];
+    unsigned int count = 0;
+
+    /* Render the digits from least to most significant */
+    do {
+        digits[sizeof(digits) - ++count] = hex_digits[value & 0xF];
+        value >>= 4;
+    } while (value != 0);
+
+    while (count < min_digits && count < sizeof(digits))
+        digits[sizeof(digits) - ++count] = '0';
+
+    plcrash_text_buffer_append(buffer, digits + sizeof(digits) - count, count);
+}
+
+/**
+ * Append the decimal representation of @a value. This is equivalent to the printf() format "%" PRIu64.
+ *
+ * @param buffer The buffer.
+ * @param value The value to append.
+ */
+void plcrash_text_buffer_append_unsigned (plcrash_text_buffer_t *buffer, uint64_t value) {
+    char digits[20];
+    unsigned int count = 0;
+
+    do {
+        digits[sizeof(digits) - ++count] = (char) ('0' + (value % 10));
+        value /= 10;
+    } while (value != 0);
+
+    plcrash_text_buffer_append(buffer, digits + sizeof(digits) - count, count);
+}
+
+/**
+ * Append the decimal representation of @a value. This is equivalent to the printf() format "%" PRId64.
+ *
+ * @param buffer The buffer.
+ * @param value The value to append.
+ */
+void plcrash_text_buffer_append_signed (plcrash_text_buffer_t *buffer, int64_t value) {
+    if (value < 0) {
+        plcrash_text_buffer_append(buffer, "-", 1);
+
+        /* Negate in unsigned arithmetic; -INT64_MIN is not representable as an int64_t */
+        plcrash_text_buffer_append_unsigned(buffer, (uint64_t) 0 - (uint64_t) value);
+    } else {
+        plcrash_text_buffer_append_unsigned(buffer, (uint64_t) value);
+    }
+}
+
+/**
+ * Pad the text appended to @a buffer since the byte offset @a start with spaces, to a width of @a width characters.
+ * Text already at least @a width characters wide is left unmodified.
+ *
+ * Width is measured in UTF-16 code units, matching the padding applied to "%S" arguments by the NSString formatting
+ * methods; characters outside the Basic Multilingual Plane count as two.
+ *
+ * @param buffer The buffer.
+ * @param start The byte offset of the first character of the text to be padded.
+ * @param width The minimum width of the padded text.
+ * @param left_align If true, the padding is appended after the text. Otherwise, the padding is inserted before it.
+ */
+void plcrash_text_buffer_pad (plcrash_text_buffer_t *buffer, size_t start, size_t width, bool left_align) {
+    if (buffer->failed || start > buffer->length)
+        return;
+
+    /* Count UTF-16 code units; continuation bytes are skipped, and four-byte sequences encode a surrogate pair */
+    size_t units = 0;
+    for (size_t i = start; i < buffer->length; i++) {
+        uint8_t byte = (uint8_t) buffer->data[i];
+        if ((byte & 0xC0) == 0x80)
+            continue;
+
+        units += (byte >= 0xF0) ? 2 : 1;
+    }
+
+    if (units >= width)
+        return;
+
+    size_t padding = width - units;
+    if (left_align) {
+        plcrash_text_buffer_append_repeated(buffer, ' ', padding);
+        return;
+    }
+
+    size_t text_length = buffer->length - start;
+    if (plcrash_text_buffer_reserve(buffer, padding) == NULL)
+        return;
+
+    memmove(buffer->data + start + padding, buffer->data + start, text_length);
+    memset(buffer->data + start, ' ', padding);
+    buffer->length += padding;
+}
+
+/**
+ * Remove all but the last path component from the path appended to @a buffer since the byte offset @a start,
+ * following the rules of -[NSString lastPathComponent]: trailing slashes are ignored, and a path consisting only of
+ * slashes is reduced to "/".
+ *
+ * @param buffer The buffer.
+ * @param start The byte offset of the first character of the path.
+ */
+void plcrash_text_buffer_trim_to_last_path_component (plcrash_text_buffer_t *buffer, size_t start) {
+    if (buffer->failed || start > buffer->length)
+        return;
+
+    /* Drop trailing slashes, retaining a lone root slash */
+    size_t end = buffer->length;
+    while (end - start > 1 && buffer->data[end - 1] == '/')
+        end--;
+
+    size_t component = end;
+    while (component > start && buffer->data[component - 1] != '/')
+        component--;
+
+    if (component == end) {
+        /* The path is empty, or consists only of a root slash */
+        buffer->length = end;
+        return;
+    }
+
+    memmove(buffer->data + start, buffer->data + component, end - component);
+    buffer->length = start + (end - component);
+}
+
+/**
+ * Discard the contents of @a buffer, retaining its storage for reuse.
+ *
+ * @param buffer The buffer.
+ */
+void plcrash_text_buffer_reset (plcrash_text_buffer_t *buffer) {
+    buffer->length = 0;
+    buffer->failed = false;
+}
+
+/**
+ * Free all storage associated with @a buffer. The buffer may be reused after being reinitialized.
+ *
+ * @param buffer The buffer.
+ */
+void plcrash_text_buffer_free (plcrash_text_buffer_t *buffer) {
+    free(buffer->data);
+    plcrash_text_buffer_init(buffer);
+}
+
+/**
+ * @}
+ */
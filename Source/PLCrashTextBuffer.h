@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_TEXT_BUFFER_H
+#define PLCRASH_TEXT_BUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @internal
+ * @defgroup plcrash_text_buffer Text Buffer
+ * @ingroup plcrash_internal
+ *
+ * A growable UTF-8 text buffer, with allocation-free integer and padding routines, used to render the
+ * per-frame, per-register and per-image lines of text crash reports without allocating an object per line.
+ *
+ * The buffer is not async-safe.
+ *
+ * @{
+ */
+
+/**
+ * A growable UTF-8 text buffer.
+ */
+typedef struct plcrash_text_buffer {
+    /** The buffer contents, or NULL if no storage has been allocated. Not NUL-terminated. */
+    char *data;
+
+    /** The number of valid bytes in @a data. */
+    size_t length;
+
+    /** The allocated size of @a data. */
+    size_t capacity;
+
+    /** True if an allocation has failed. Once set, all further appends are discarded. */
+    bool failed;
+} plcrash_text_buffer_t;
+
+void plcrash_text_buffer_init (plcrash_text_buffer_t *buffer);
+
+char *plcrash_text_buffer_reserve (plcrash_text_buffer_t *buffer, size_t length);
+
+void plcrash_text_buffer_append (plcrash_text_buffer_t *buffer, const char *text, size_t length);
+void plcrash_text_buffer_append_string (plcrash_text_buffer_t *buffer, const char *string);
+void plcrash_text_buffer_append_repeated (plcrash_text_buffer_t *buffer, char c, size_t count);
+
+void plcrash_text_buffer_append_hex (plcrash_text_buffer_t *buffer, uint64_t value, unsigned int min_digits);
+void plcrash_text_buffer_append_unsigned (plcrash_text_buffer_t *buffer, uint64_t value);
+void plcrash_text_buffer_append_signed (plcrash_text_buffer_t *buffer, int64_t value);
+
+void plcrash_text_buffer_pad (plcrash_text_buffer_t *buffer, size_t start, size_t width, bool left_align);
+void plcrash_text_buffer_trim_to_last_path_component (plcrash_text_buffer_t *buffer, size_t start);
+
+void plcrash_text_buffer_reset (plcrash_text_buffer_t *buffer);
+void plcrash_text_buffer_free (plcrash_text_buffer_t *buffer);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_TEXT_BUFFER_H */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 PLCrashReporter contributors
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "GTMSenTestCase.h"
+
+#import "PLCrashTextBuffer.h"
+
+@interface PLCrashTextBufferTests : SenTestCase {
+@private
+    /** The buffer under test. */
+    plcrash_text_buffer_t _buffer;
+}
+@end
+
+@implementation PLCrashTextBufferTests
+
+- (void) setUp {
+    plcrash_text_buffer_init(&_buffer);
+}
+
+- (void) tearDown {
+    plcrash_text_buffer_free(&_buffer);
+}
+
+/* Return the buffer contents as a string, and reset the buffer */
+- (NSString *) takeString {
+    NSString *result = [[[NSString alloc] initWithBytes: _buffer.data length: _buffer.length encoding: NSUTF8StringEncoding] autorelease];
+    plcrash_text_buffer_reset(&_buffer);
+    return result;
+}
+
+/**
+ * Verify that integer formatting matches the equivalent printf() formats.
+ */
+- (void) testIntegers {
+    const uint64_t values[] = { 0, 1, 0xF, 0x10, 0xDEADBEEF, 0x100000000ULL, INT64_MAX, UINT64_MAX };
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        for (unsigned int digits = 0; digits <= 16; digits++) {
+            plcrash_text_buffer_append_hex(&_buffer, values[i], digits);
+            NSString *expected = [NSString stringWithFormat: @"%0*" PRIx64, digits, values[i]];
+            STAssertEqualObjects([self takeString], expected, @"Incorrect hex formatting");
+        }
+
+        plcrash_text_buffer_append_unsigned(&_buffer, values[i]);
+        STAssertEqualObjects([self takeString], ([NSString stringWithFormat: @"%" PRIu64, values[i]]), @"Incorrect unsigned formatting");
+
+        plcrash_text_buffer_append_signed(&_buffer, (int64_t) values[i]);
+        STAssertEqualObjects([self takeString], ([NSString stringWithFormat: @"%" PRId64, (int64_t) values[i]]), @"Incorrect signed formatting");
+    }
+
+    plcrash_text_buffer_append_signed(&_buffer, INT64_MIN);
+    STAssertEqualObjects([self takeString], @"-9223372036854775808", @"Incorrect INT64_MIN formatting");
+}
+
+/**
+ * Verify padding, which is measured in UTF-16 code units.
+ */
+- (void) testPad {
+    plcrash_text_buffer_append_string(&_buffer, "ab");
+    size_t start = _buffer.length;
+    plcrash_text_buffer_append_string(&_buffer, "xyz");
+    plcrash_text_buffer_pad(&_buffer, start, 6, false);
+    STAssertEqualObjects([self takeString], @"ab   xyz", @"Incorrect right alignment");
+
+    plcrash_text_buffer_append_string(&_buffer, "xyz");
+    plcrash_text_buffer_pad(&_buffer, 0, 6, true);
+    STAssertEqualObjects([self takeString], @"xyz   ", @"Incorrect left alignment");
+
+    plcrash_text_buffer_append_string(&_buffer, "toolong");
+    plcrash_text_buffer_pad(&_buffer, 0, 3, false);
+    STAssertEqualObjects([self takeString], @"toolong", @"Text wider than the pad width should be unmodified");
+
+    /* U+00E9 is a single UTF-16 unit; U+1F600 is a surrogate pair */
+    plcrash_text_buffer_append_string(&_buffer, "\xC3\xA9\xF0\x9F\x98\x80");
+    plcrash_text_buffer_pad(&_buffer, 0, 5, true);
+    STAssertEquals(_buffer.length, (size_t) 8, @"Incorrect UTF-16 width");
+    plcrash_text_buffer_reset(&_buffer);
+}
+
+/**
+ * Verify last path component extraction against -[NSString lastPathComponent].
+ */
+- (void) testLastPathComponent {
+    NSArray *paths = [NSArray arrayWithObjects: @"/usr/lib/libSystem.B.dylib", @"Example", @"/a/b/", @"/", @"///", @"", nil];
+
+    for (NSString *path in paths) {
+        plcrash_text_buffer_append_string(&_buffer, "prefix ");
+        plcrash_text_buffer_append_string(&_buffer, [path UTF8String]);
+        plcrash_text_buffer_trim_to_last_path_component(&_buffer, strlen("prefix "));
+
+        NSString *expected = [@"prefix " stringByAppendingString: [path lastPathComponent]];
+        STAssertEqualObjects([self takeString], expected, @"Incorrect last path component of '%@'", path);
+    }
+}
+
+/**
+ * Verify that the buffer grows to accommodate appended text.
+ */
+- (void) testGrowth {
+    for (size_t i = 0; i < 100000; i++)
+        plcrash_text_buffer_append(&_buffer, "0123456789", 10);
+
+    STAssertFalse(_buffer.failed, @"Buffer growth failed");
+    STAssertEquals(_buffer.length, (size_t) 1000000, @"Incorrect buffer length");
+    STAssertEquals(memcmp(_buffer.data + 999990, "0123456789", 10), 0, @"Incorrect buffer contents");
+}
+
+@end
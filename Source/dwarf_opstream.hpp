@@ -70,6 +70,8 @@ class dwarf_opstream {
     
     /** Byte order for the byte stream */
     const plcrash_async_byteorder_t *_byteorder;
+
+    inline bool read_leb128_local (uint64_t *result, uint8_t *last_byte);
     
 public:
     plcrash_error_t init (plcrash_async_mobject_t *mobj,
@@ -155,6 +157,55 @@ inline bool dwarf_opstream::read_uintmax64 (uint8_t data_size, uint64_t *result)
     return true;
 }
     
+/**
+ * @internal
+ *
+ * Maximum encoded size of a LEB128 value that may be decoded into 64 bits. Any LEB128 value
+ * that would require additional bytes is rejected by the slow path.
+ */
+#define DWARF_OPSTREAM_LEB128_MAX_SIZE 10
+
+/**
+ * @internal
+ *
+ * Attempt to decode a LEB128 value directly from the locally mapped stream. This path is only taken
+ * when at least DWARF_OPSTREAM_LEB128_MAX_SIZE bytes remain in the mapped range, allowing a single bounds
+ * check to cover the entire value; callers must fall back to the mobject-based decoding otherwise.
+ *
+ * On success, the stream position is advanced past the decoded value.
+ *
+ * @param result The destination to which the raw (unsigned) result will be written.
+ * @param last_byte On success, the final encoded byte; used by SLEB128 callers to perform sign extension.
+ *
+ * @return Returns true if the value was decoded, or false if the fast path is not applicable. The stream
+ * position will not be modified if false is returned.
+ */
+inline bool dwarf_opstream::read_leb128_local (uint64_t *result, uint8_t *last_byte) {
+    if (_p < _instr || (uint8_t *)_instr_max - (uint8_t *)_p < DWARF_OPSTREAM_LEB128_MAX_SIZE)
+        return false;
+
+    uint8_t *p = (uint8_t *) _p;
+    uint64_t value = 0;
+    unsigned int shift = 0;
+
+    for (size_t i = 0; i < DWARF_OPSTREAM_LEB128_MAX_SIZE; i++) {
+        uint8_t byte = p[i];
+        value |= ((uint64_t) (byte & 0x7f)) << shift;
+        shift += 7;
+
+        /* Check for terminating bit */
+        if ((byte & 0x80) == 0) {
+            *result = value;
+            *last_byte = byte;
+            _p = p + i + 1;
+            return true;
+        }
+    }
+
+    /* Value exceeds 64 bits; let the slow path report the failure */
+    return false;
+}
+
 /**
  * Read a ULEB128 value from the stream, verifying that the read will not overrun
  * the mapped range and advancing the stream position past the read value.
@@ -167,6 +218,11 @@ inline bool dwarf_opstream::read_uleb128 (uint64_t *result) {
     plcrash_error_t err;
     pl_vm_off_t offset = ((uint8_t *)_p - (uint8_t *)_instr);
     pl_vm_size_t lebsize;
+    uint8_t last_byte;
+
+    /* Try the bulk bounds-checked path first */
+    if (read_leb128_local(result, &last_byte))
+        return true;
 
     if ((err = plcrash_async_dwarf_read_uleb128(_mobj, _start, offset, result, &lebsize)) != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Read of ULEB128 value failed with %u", err);
@@ -193,6 +249,20 @@ inline bool dwarf_opstream::read_sleb128 (int64_t *result) {
     plcrash_error_t err;
     pl_vm_off_t offset = ((uint8_t *)_p - (uint8_t *)_instr);
     pl_vm_size_t lebsize;
+    uint8_t *start = (uint8_t *) _p;
+    uint64_t value;
+    uint8_t last_byte;
+
+    /* Try the bulk bounds-checked path first */
+    if (read_leb128_local(&value, &last_byte)) {
+        /* Sign bit is 2nd high order bit of the final byte */
+        unsigned int shift = (unsigned int) ((uint8_t *)_p - start) * 7;
+        if (shift < 64 && (last_byte & 0x40))
+            value |= -(1ULL << shift);
+
+        *result = (int64_t) value;
+        return true;
+    }
     
     if ((err = plcrash_async_dwarf_read_sleb128(_mobj, _start, offset, result, &lebsize)) != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Read of ULEB128 value failed with %u", err);
@@ -133,6 +133,35 @@ using namespace plcrash::async;
     plcrash_async_mobject_free(&mobj);
 }
 
+/**
+ * Test LEB128 reads that are eligible for the bulk bounds-checked decoding path, verifying
+ * that the results match the byte-at-a-time decoding used near the end of the stream.
+ */
+- (void) testReadLEB128FastPath {
+    plcrash_async_mobject_t mobj;
+    uint8_t opcodes[] = { 0xE5, 0x8E, 0x26, 0x7F, 0x80, 0x7F, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 };
+    
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_mobject_init(&mobj, mach_task_self(), (pl_vm_address_t)&opcodes, sizeof(opcodes), true), @"Failed to initialize mobj");
+    
+    dwarf_opstream stream;
+    STAssertEquals(PLCRASH_ESUCCESS, stream.init(&mobj, plcrash_async_byteorder_big_endian(), (pl_vm_address_t)&opcodes, 0, sizeof(opcodes)), @"Failed to initialize opcode stream");
+    
+    uint64_t uval;
+    STAssertTrue(stream.read_uleb128(&uval), @"Failed to read");
+    STAssertEquals(uval, (uint64_t)624485, @"Incorrect value read");
+    STAssertEquals(stream.get_position(), (uintptr_t)3, @"Incorrect position");
+
+    int64_t sval;
+    STAssertTrue(stream.read_sleb128(&sval), @"Failed to read");
+    STAssertEquals(sval, (int64_t)-1, @"Incorrect value read");
+
+    STAssertTrue(stream.read_sleb128(&sval), @"Failed to read");
+    STAssertEquals(sval, (int64_t)-128, @"Incorrect value read");
+    STAssertEquals(stream.get_position(), (uintptr_t)6, @"Incorrect position");
+
+    plcrash_async_mobject_free(&mobj);
+}
+
 /**
  * Test pointer read from an opcode stream.
  */
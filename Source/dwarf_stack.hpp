@@ -49,8 +49,17 @@ namespace plcrash { namespace async {
 template <typename T, size_t S> class dwarf_stack {
     T mem[S];
     T *sp = mem;
+
+    /** The highest stack position reached. */
+    T *high = mem;
+
+    /** If true, a push was refused due to the stack being full. */
+    bool did_overflow = false;
     
 public:
+    /** The stack's fixed capacity. */
+    static const size_t capacity = S;
+
     inline bool push (T value);
     inline bool peek (T *value);
     inline bool pop (T *value);
@@ -60,6 +69,9 @@ public:
     inline bool dup (void);
     inline bool swap (void);
     inline bool rotate (void);
+
+    inline size_t max_depth (void) const;
+    inline bool overflowed (void) const;
 };
 
 /**
@@ -70,11 +82,16 @@ public:
  */
 template <typename T, size_t S> inline bool dwarf_stack<T,S>::push (T value) {
     /* Refuse to exceed the allocated stack size */
-    if (sp == &mem[S])
+    if (sp == &mem[S]) {
+        did_overflow = true;
         return false;
+    }
     
     *sp = value;
     sp++;
+
+    if (sp > high)
+        high = sp;
     
     return true;
 }
@@ -131,8 +148,10 @@ template <typename T, size_t S> inline bool dwarf_stack<T,S>::drop (void) {
  */
 template <class T, size_t S> inline bool dwarf_stack<T,S>::dup (void) {
     /* Refuse to exceed the allocated stack size */
-    if (sp == &mem[S])
+    if (sp == &mem[S]) {
+        did_overflow = true;
         return false;
+    }
 
     /* Peek and push the current value */
     T val;
@@ -221,6 +240,20 @@ template <typename T, size_t S> inline bool dwarf_stack<T,S>::rotate (void) {
     return true;
 }
 
+/**
+ * Return the maximum depth reached by the stack over its lifetime.
+ */
+template <typename T, size_t S> inline size_t dwarf_stack<T,S>::max_depth (void) const {
+    return high - mem;
+}
+
+/**
+ * Return true if a push or dup operation was ever refused due to the stack having reached its capacity.
+ */
+template <typename T, size_t S> inline bool dwarf_stack<T,S>::overflowed (void) const {
+    return did_overflow;
+}
+
 }}
 
 /**
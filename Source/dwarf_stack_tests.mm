@@ -63,6 +63,23 @@ using namespace plcrash::async;
     STAssertEquals(1, v, @"Incorrect value popped");
 }
 
+/** Test maximum depth and overflow tracking. */
+- (void) testDepthTracking {
+    int v;
+
+    STAssertEquals((size_t)0, _stack.max_depth(), @"Incorrect initial depth");
+
+    assert_push(1);
+    assert_push(2);
+    assert_pop(&v);
+    STAssertEquals((size_t)2, _stack.max_depth(), @"Incorrect maximum depth");
+    STAssertFalse(_stack.overflowed(), @"Stack should not be marked as overflowed");
+
+    while (_stack.push(1));
+    STAssertEquals(_stack.capacity, _stack.max_depth(), @"Incorrect maximum depth");
+    STAssertTrue(_stack.overflowed(), @"Stack should be marked as overflowed");
+}
+
 /** Test peek */
 - (void) testPeek {
     int v;
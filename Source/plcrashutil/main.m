@@ -32,6 +32,30 @@
 #import <stdlib.h>
 #import <stdio.h>
 #import <getopt.h>
+#import <fcntl.h>
+#import <unistd.h>
+#import <sys/time.h>
+#import <libkern/OSAtomic.h>
+#import <inttypes.h>
+#import <signal.h>
+#import <pthread.h>
+#import <errno.h>
+#import <mach/mach.h>
+
+/* The default number of rows buffered per exported column before it is written out. */
+#define EXPORT_DEFAULT_CHUNK_ROWS 65536
+
+/* The number of reports decoded concurrently per export batch. */
+#define EXPORT_BATCH_REPORTS 512
+
+/* The size of the pipe command's stdin read-ahead buffer. */
+#define PIPE_READ_BUFFER_SIZE (1024 * 1024)
+
+/* The default number of reports read ahead of the pipe command's workers, per worker. */
+#define PIPE_DEFAULT_QUEUE_DEPTH_PER_WORKER 4
+
+/* The maximum size of a single report accepted by the pipe command. */
+#define PIPE_MAX_REPORT_SIZE (256 * 1024 * 1024)
 
 /*
  * Print command line usage.
@@ -43,7 +67,88 @@ void print_usage () {
                     "      Covert a plcrash file to the given format.\n\n"
                     "      Supported formats:\n"
                     "        ios - Standard Apple iOS-compatible text crash log\n"
-                    "        iphone - Synonym for 'iOS'.\n");
+                    "        iphone - Synonym for 'iOS'.\n"
+                    "        ndjson - Compact single-line JSON, suitable for newline-delimited JSON ingestion.\n\n"
+                    "  batch --format=<format> --output=<directory> [--list=<file>] [<file or directory> ...]\n"
+                    "      Concurrently convert all plcrash files in the given files and directories,\n"
+                    "      writing each converted report to the output directory. If --list is\n"
+                    "      supplied, input paths are also read from the given file, one per line;\n"
+                    "      specify '-' to read the list from stdin.\n\n"
+                    "  pipe --format=<format> [--workers=<count>] [--queue=<count>]\n"
+                    "      Convert a stream of plcrash reports read from stdin, writing the converted reports\n"
+                    "      to stdout in input order. Each input and output record is prefixed with its length,\n"
+                    "      encoded as a protobuf varint; a report that can not be converted is written as an\n"
+                    "      empty record. Reports are converted by the given number of workers (default: one\n"
+                    "      per CPU), with at most the given number of reports read ahead of the output\n"
+                    "      (default: %d per worker).\n\n"
+                    "  signature [--frames=<count>] <file or directory> ...\n"
+                    "      Print a 64-bit deduplication signature for each plcrash file, derived from the\n"
+                    "      crashed thread's innermost frames (default: %d).\n\n"
+                    "  export --output=<directory> [--chunk=<rows>] <file or directory> ...\n"
+                    "      Export all plcrash files in the given files and directories to a column-per-file\n"
+                    "      layout, with reports, threads, frames and images tables joined by report_id and\n"
+                    "      image_index. Column data is flushed in chunks of the given number of rows\n"
+                    "      (default: %d). The layout is described by schema.json in the output directory.\n\n"
+                    "  stats [--top=<count>] [--frames=<count>] <file or directory> ...\n"
+                    "      Concurrently summarize all plcrash files in the given files and directories, printing\n"
+                    "      report size and frame count totals, and the most common crash signatures, OS versions,\n"
+                    "      device models and signals (default: top 10).\n\n"
+                    "  symbolicate --symbols=<path> --output=<directory> [--cache=<directory>] [--format=<format>]\n"
+                    "              <file or directory> ...\n"
+                    "      Concurrently symbolicate all plcrash files in the given files and directories\n"
+                    "      using the Mach-O binaries and dSYMs found at the given symbol paths, which may\n"
+                    "      be repeated. Symbol indexes are cached by image UUID in the cache directory\n"
+                    "      (default: ~/Library/Caches/plcrashutil). The output format may be any convert\n"
+                    "      format, or 'plcrash' to write symbolicated plcrash files (default: plcrash).\n\n"
+                    "  index [--cache=<directory>] <binary, dSYM or directory> ...\n"
+                    "      Build symbol indexes for every Mach-O image found at the given paths, replacing\n"
+                    "      any cached indexes. Later symbolicate runs using the same cache directory map\n"
+                    "      the prebuilt indexes directly.\n\n"
+                    "  index-shared-cache [--cache=<directory>] <dyld shared cache> ...\n"
+                    "      Build symbol indexes for every system image within the given dyld shared caches,\n"
+                    "      including the cache's local symbols. Split caches are read from the sub-cache\n"
+                    "      and .symbols files alongside the main cache file. Later symbolicate runs using\n"
+                    "      the same cache directory resolve system frames from these indexes.\n\n"
+                    "  serve --socket=<path> [--symbols=<path>] [--cache=<directory>] [--memory-budget=<MB>]\n"
+                    "        [--workers=<count>]\n"
+                    "      Serve symbolication and conversion requests on a Unix domain socket until\n"
+                    "      interrupted, keeping symbol indexes mapped between requests. Requests and\n"
+                    "      responses are the length-prefixed messages defined in symbolication_service.proto.\n"
+                    "      Mapped indexes are closed least recently used first once they exceed the memory\n"
+                    "      budget (default: unlimited). Connections are served by the given number of\n"
+                    "      workers (default: one per CPU).\n\n"
+                    "  monitor --pid=<pid> --output=<directory> [--identifier=<id>] [--version=<version>]\n"
+                    "      Monitor a running process for crashes, writing plcrash reports for the process\n"
+                    "      to the output directory from outside of the crashed process. Requires access\n"
+                    "      to the target's task port. Runs until the target process exits.\n\n"
+                    "  trace <file or directory> ...\n"
+                    "      Print the crash reporter's diagnostic trace events recorded in each plcrash file.\n\n"
+                    "  bundle --output=<file> <file or directory> ...\n"
+                    "      Pack all plcrash files in the given files and directories into a single compressed\n"
+                    "      report bundle, sharing binary image and symbol name entries between reports.\n\n"
+                    "  unbundle [--output=<directory>] [--report=<index>] <bundle>\n"
+                    "      Extract the reports in a report bundle to the output directory, or only the report\n"
+                    "      at the given index. If no output directory is supplied, the bundled reports are listed.\n",
+                    PIPE_DEFAULT_QUEUE_DEPTH_PER_WORKER, PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES, EXPORT_DEFAULT_CHUNK_ROWS);
+}
+
+/*
+ * Return a formatter for the given format name, or nil if the format is unsupported. The returned formatter
+ * implements -writeReport:toFileDescriptor:error:. If non-NULL, @a extension will be set to the path extension
+ * to be used for formatted output files.
+ */
+static id formatter_for_name (const char *format, NSString **extension) {
+    if (strcasecmp(format, "iphone") == 0 || strcasecmp(format, "ios") == 0) {
+        if (extension != NULL)
+            *extension = @"crash";
+        return [[[PLCrashReportTextFormatter alloc] initWithTextFormat: PLCrashReportTextFormatiOS stringEncoding: NSUTF8StringEncoding] autorelease];
+    } else if (strcasecmp(format, "ndjson") == 0) {
+        if (extension != NULL)
+            *extension = @"json";
+        return [[[PLCrashReportJSONFormatter alloc] init] autorelease];
+    }
+
+    return nil;
 }
 
 /*
@@ -52,7 +157,6 @@ void print_usage () {
 int convert_command (int argc, char *argv[]) {
     const char *format = "iphone";
     const char *input_file;
-    FILE *output = stdout;
 
     /* options descriptor */
     static struct option longopts[] = {
@@ -84,11 +188,9 @@ int convert_command (int argc, char *argv[]) {
         input_file = argv[0];
     }
     
-    /* Verify that the format is supported. Only one is actually supported currently */
-    PLCrashReportTextFormat textFormat;
-    if (strcasecmp(format, "iphone") == 0 || strcasecmp(format, "ios")) {
-        textFormat = PLCrashReportTextFormatiOS;
-    } else {
+    /* Verify that the format is supported */
+    id formatter = formatter_for_name(format, NULL);
+    if (formatter == nil) {
         fprintf(stderr, "Unsupported format requested\n");
         print_usage();
         return 1;
@@ -111,8 +213,1899 @@ int convert_command (int argc, char *argv[]) {
     }
 
     /* Format the report */
-    NSString* report = [PLCrashReportTextFormatter stringValueForCrashReport: crashLog withTextFormat: textFormat];
-    fprintf(output, "%s", [report UTF8String]);     
+    if (![formatter writeReport: crashLog toFileDescriptor: STDOUT_FILENO error: &error]) {
+        fprintf(stderr, "Could not write formatted crash log: %s\n", [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Append the input report paths found at @a path to @a inputs. If @a path is a directory, all
+ * *.plcrash files within it (and its subdirectories) are appended.
+ */
+static void add_batch_input (NSMutableArray *inputs, NSString *path) {
+    BOOL isDir = NO;
+    if (![[NSFileManager defaultManager] fileExistsAtPath: path isDirectory: &isDir]) {
+        fprintf(stderr, "Input path does not exist: %s\n", [path fileSystemRepresentation]);
+        return;
+    }
+
+    if (!isDir) {
+        [inputs addObject: path];
+        return;
+    }
+
+    NSDirectoryEnumerator *files = [[NSFileManager defaultManager] enumeratorAtPath: path];
+    for (NSString *file in files) {
+        if ([[file pathExtension] isEqualToString: @"plcrash"])
+            [inputs addObject: [path stringByAppendingPathComponent: file]];
+    }
+}
+
+/*
+ * Run a concurrent batch conversion.
+ */
+int batch_command (int argc, char *argv[]) {
+    const char *format = "iphone";
+    const char *output_dir = NULL;
+    const char *list_file = NULL;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "format",     required_argument,      NULL,          'f' },
+        { "output",     required_argument,      NULL,          'o' },
+        { "list",       required_argument,      NULL,          'l' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "f:o:l:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'f':
+                format = optarg;
+                break;
+            case 'o':
+                output_dir = optarg;
+                break;
+            case 'l':
+                list_file = optarg;
+                break;
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    NSString *extension;
+    id formatter = formatter_for_name(format, &extension);
+    if (formatter == nil) {
+        fprintf(stderr, "Unsupported format requested\n");
+        print_usage();
+        return 1;
+    }
+
+    if (output_dir == NULL) {
+        fprintf(stderr, "No output directory supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    NSString *outputPath = [NSString stringWithUTF8String: output_dir];
+    NSError *error;
+    if (![[NSFileManager defaultManager] createDirectoryAtPath: outputPath withIntermediateDirectories: YES attributes: nil error: &error]) {
+        fprintf(stderr, "Could not create output directory: %s\n", [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    /* Gather the input paths */
+    NSMutableArray *inputs = [NSMutableArray array];
+    for (int i = 0; i < argc; i++)
+        add_batch_input(inputs, [NSString stringWithUTF8String: argv[i]]);
+
+    if (list_file != NULL) {
+        FILE *list = strcmp(list_file, "-") == 0 ? stdin : fopen(list_file, "r");
+        if (list == NULL) {
+            fprintf(stderr, "Could not open input list %s: %s\n", list_file, strerror(errno));
+            return 1;
+        }
+
+        char *line = NULL;
+        size_t linecap = 0;
+        ssize_t linelen;
+        while ((linelen = getline(&line, &linecap, list)) > 0) {
+            while (linelen > 0 && (line[linelen - 1] == '\n' || line[linelen - 1] == '\r'))
+                line[--linelen] = '\0';
+            if (linelen > 0)
+                add_batch_input(inputs, [NSString stringWithUTF8String: line]);
+        }
+
+        free(line);
+        if (list != stdin)
+            fclose(list);
+    }
+
+    if ([inputs count] == 0) {
+        fprintf(stderr, "No input files supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    /* Convert the reports concurrently */
+    __block volatile int32_t failed = 0;
+    __block volatile int64_t bytesRead = 0;
+    __block volatile int64_t bytesWritten = 0;
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    dispatch_apply([inputs count], dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t idx) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSString *input = [inputs objectAtIndex: idx];
+        NSError *convertError = nil;
+
+        PLCrashReport *report = [[[PLCrashReport alloc] initWithContentsOfFile: input error: &convertError] autorelease];
+        if (report == nil) {
+            fprintf(stderr, "Could not decode %s: %s\n", [input fileSystemRepresentation], [[convertError localizedDescription] UTF8String]);
+            OSAtomicIncrement32(&failed);
+            [pool drain];
+            return;
+        }
+
+        NSString *name = [[[input lastPathComponent] stringByDeletingPathExtension] stringByAppendingPathExtension: extension];
+        NSString *output = [outputPath stringByAppendingPathComponent: name];
+        int fd = open([output fileSystemRepresentation], O_WRONLY|O_CREAT|O_TRUNC, 0644);
+        if (fd < 0) {
+            fprintf(stderr, "Could not open output file %s: %s\n", [output fileSystemRepresentation], strerror(errno));
+            OSAtomicIncrement32(&failed);
+            [pool drain];
+            return;
+        }
+
+        if (![formatter writeReport: report toFileDescriptor: fd error: &convertError]) {
+            fprintf(stderr, "Could not write %s: %s\n", [output fileSystemRepresentation], [[convertError localizedDescription] UTF8String]);
+            OSAtomicIncrement32(&failed);
+        } else {
+            NSDictionary *inputAttrs = [[NSFileManager defaultManager] attributesOfItemAtPath: input error: NULL];
+            OSAtomicAdd64((int64_t) [inputAttrs fileSize], &bytesRead);
+
+            off_t outputSize = lseek(fd, 0, SEEK_CUR);
+            if (outputSize > 0)
+                OSAtomicAdd64(outputSize, &bytesWritten);
+        }
+
+        close(fd);
+        [pool drain];
+    });
+
+    /* Report throughput */
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+    if (elapsed <= 0)
+        elapsed = 1e-6;
+
+    NSUInteger converted = [inputs count] - failed;
+    fprintf(stderr, "Converted %lu of %lu reports in %.3f seconds (%.1f reports/sec, %.2f MB/sec in, %.2f MB/sec out) using %ld CPUs\n",
+            (unsigned long) converted, (unsigned long) [inputs count], elapsed, converted / elapsed,
+            bytesRead / elapsed / (1024.0 * 1024.0), bytesWritten / elapsed / (1024.0 * 1024.0),
+            (long) [[NSProcessInfo processInfo] activeProcessorCount]);
+
+    return failed == 0 ? 0 : 1;
+}
+
+/*
+ * Buffered reader over the pipe command's input stream.
+ */
+typedef struct pipe_reader {
+    /** The input file descriptor. */
+    int fd;
+
+    /** The read-ahead buffer, of PIPE_READ_BUFFER_SIZE bytes. */
+    uint8_t *buffer;
+
+    /** The range of unconsumed bytes within @a buffer. */
+    size_t start;
+    size_t end;
+} pipe_reader_t;
+
+/*
+ * Refill the reader's buffer, preserving any unconsumed bytes. Returns NO on end of file or error.
+ */
+static BOOL pipe_reader_fill (pipe_reader_t *reader) {
+    if (reader->start > 0) {
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+
+    ssize_t n;
+    do {
+        n = read(reader->fd, reader->buffer + reader->end, PIPE_READ_BUFFER_SIZE - reader->end);
+    } while (n < 0 && errno == EINTR);
+
+    if (n <= 0)
+        return NO;
+
+    reader->end += (size_t) n;
+    return YES;
+}
+
+/*
+ * Read the next record's varint length prefix. Returns 1 on success, 0 at a clean end of input, or -1 if the
+ * input is truncated or the prefix is invalid.
+ */
+static int pipe_reader_next_length (pipe_reader_t *reader, uint64_t *length) {
+    *length = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        if (reader->start == reader->end && !pipe_reader_fill(reader))
+            return shift == 0 ? 0 : -1;
+
+        uint8_t byte = reader->buffer[reader->start++];
+        *length |= (uint64_t) (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return 1;
+    }
+
+    return -1;
+}
+
+/*
+ * Read a record of @a length bytes. Buffered bytes are copied, and the remainder is read directly into the record.
+ * Returns nil if the input is truncated.
+ */
+static NSData *pipe_reader_read (pipe_reader_t *reader, size_t length) {
+    NSMutableData *data = [NSMutableData dataWithLength: length];
+    uint8_t *bytes = [data mutableBytes];
+
+    size_t buffered = MIN(length, reader->end - reader->start);
+    memcpy(bytes, reader->buffer + reader->start, buffered);
+    reader->start += buffered;
+
+    for (size_t offset = buffered; offset < length; ) {
+        ssize_t n = read(reader->fd, bytes + offset, length - offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return nil;
+        offset += (size_t) n;
+    }
+
+    return data;
+}
+
+/*
+ * Write @a data to @a fd as a varint length-prefixed record. Returns NO if the record could not be written.
+ */
+static BOOL pipe_write_record (int fd, NSData *data) {
+    uint8_t prefix[10];
+    size_t prefix_len = 0;
+    uint64_t remaining = [data length];
+    do {
+        prefix[prefix_len++] = (uint8_t) ((remaining & 0x7F) | (remaining > 0x7F ? 0x80 : 0));
+        remaining >>= 7;
+    } while (remaining != 0);
+
+    const uint8_t *parts[] = { prefix, [data bytes] };
+    size_t lengths[] = { prefix_len, [data length] };
+    for (size_t i = 0; i < 2; i++) {
+        for (size_t offset = 0; offset < lengths[i]; ) {
+            ssize_t n = write(fd, parts[i] + offset, lengths[i] - offset);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return NO;
+            offset += (size_t) n;
+        }
+    }
+
+    return YES;
+}
+
+/*
+ * Convert a stream of length-prefixed reports from stdin to stdout.
+ */
+int pipe_command (int argc, char *argv[]) {
+    const char *format = "iphone";
+    long workers = [[NSProcessInfo processInfo] activeProcessorCount];
+    long queue_depth = 0;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "format",     required_argument,      NULL,          'f' },
+        { "workers",    required_argument,      NULL,          'w' },
+        { "queue",      required_argument,      NULL,          'q' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "f:w:q:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'f':
+                format = optarg;
+                break;
+            case 'w': {
+                char *end;
+                workers = strtol(optarg, &end, 10);
+                if (*end != '\0' || workers <= 0) {
+                    fprintf(stderr, "Invalid worker count: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            }
+            case 'q': {
+                char *end;
+                queue_depth = strtol(optarg, &end, 10);
+                if (*end != '\0' || queue_depth <= 0) {
+                    fprintf(stderr, "Invalid queue depth: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            }
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+
+    id formatter = formatter_for_name(format, NULL);
+    if (formatter == nil) {
+        fprintf(stderr, "Unsupported format requested\n");
+        print_usage();
+        return 1;
+    }
+
+    if (queue_depth == 0)
+        queue_depth = workers * PIPE_DEFAULT_QUEUE_DEPTH_PER_WORKER;
+
+    pipe_reader_t reader = { STDIN_FILENO, malloc(PIPE_READ_BUFFER_SIZE), 0, 0 };
+    if (reader.buffer == NULL) {
+        fprintf(stderr, "Could not allocate the input buffer\n");
+        return 1;
+    }
+
+    /*
+     * Each report is converted on one of the worker queues, in turn. Converted reports are written by the output
+     * queue in input order; a queue slot is released once a report has been written, bounding the number of reports
+     * held in memory to the queue depth.
+     */
+    dispatch_semaphore_t slots = dispatch_semaphore_create(queue_depth);
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t outputQueue = dispatch_queue_create("plcrashutil.pipe.output", DISPATCH_QUEUE_SERIAL);
+    NSMutableArray *workerQueues = [NSMutableArray arrayWithCapacity: workers];
+    for (long i = 0; i < workers; i++)
+        [workerQueues addObject: [NSValue valueWithPointer: dispatch_queue_create("plcrashutil.pipe.worker", DISPATCH_QUEUE_SERIAL)]];
+
+    NSMutableDictionary *pending = [NSMutableDictionary dictionary];
+    __block uint64_t nextOutput = 0;
+    __block volatile int32_t failed = 0;
+    __block volatile int32_t writeFailed = 0;
+    uint64_t count = 0;
+    int status;
+
+    while (true) {
+        NSAutoreleasePool *loopPool = [[NSAutoreleasePool alloc] init];
+        uint64_t length;
+        if ((status = pipe_reader_next_length(&reader, &length)) <= 0) {
+            [loopPool drain];
+            break;
+        }
+
+        if (length > PIPE_MAX_REPORT_SIZE) {
+            fprintf(stderr, "Report %" PRIu64 " exceeds the maximum report size\n", count);
+            status = -1;
+            [loopPool drain];
+            break;
+        }
+
+        dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+        NSData *input = pipe_reader_read(&reader, (size_t) length);
+        if (input == nil) {
+            dispatch_semaphore_signal(slots);
+            status = -1;
+            [loopPool drain];
+            break;
+        }
+
+        uint64_t sequence = count++;
+        dispatch_queue_t workerQueue = [[workerQueues objectAtIndex: sequence % workers] pointerValue];
+        dispatch_group_async(group, workerQueue, ^{
+            NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+            NSError *convertError = nil;
+            NSData *output = nil;
+
+            PLCrashReport *report = [[[PLCrashReport alloc] initWithData: input error: &convertError] autorelease];
+            if (report != nil)
+                output = [formatter formatReport: report error: &convertError];
+
+            if (output == nil) {
+                fprintf(stderr, "Could not convert report %" PRIu64 ": %s\n", sequence, [[convertError localizedDescription] UTF8String]);
+                OSAtomicIncrement32(&failed);
+                output = [NSData data];
+            }
+
+            /* Write this and any following reports that are ready, in order */
+            [output retain];
+            dispatch_group_async(group, outputQueue, ^{
+                [pending setObject: output forKey: [NSNumber numberWithUnsignedLongLong: sequence]];
+                [output release];
+
+                NSNumber *key;
+                NSData *ready;
+                while ((ready = [pending objectForKey: (key = [NSNumber numberWithUnsignedLongLong: nextOutput])]) != nil) {
+                    if (!writeFailed && !pipe_write_record(STDOUT_FILENO, ready)) {
+                        fprintf(stderr, "Could not write converted report: %s\n", strerror(errno));
+                        writeFailed = 1;
+                    }
+
+                    [pending removeObjectForKey: key];
+                    nextOutput++;
+                    dispatch_semaphore_signal(slots);
+                }
+            });
+
+            [pool drain];
+        });
+
+        [loopPool drain];
+    }
+
+    if (status < 0)
+        fprintf(stderr, "Truncated or invalid input following report %" PRIu64 "\n", count);
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    for (NSValue *queue in workerQueues)
+        dispatch_release([queue pointerValue]);
+    dispatch_release(outputQueue);
+    dispatch_release(group);
+    dispatch_release(slots);
+    free(reader.buffer);
+
+    fprintf(stderr, "Converted %" PRIu64 " of %" PRIu64 " reports\n", count - failed, count);
+    return (status < 0 || failed != 0 || writeFailed) ? 1 : 0;
+}
+
+/*
+ * Print report signatures.
+ */
+int signature_command (int argc, char *argv[]) {
+    unsigned long frames = PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "frames",     required_argument,      NULL,          'n' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "n:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'n': {
+                char *end;
+                frames = strtoul(optarg, &end, 10);
+                if (*end != '\0' || frames == 0) {
+                    fprintf(stderr, "Invalid frame count: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            }
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    NSMutableArray *inputs = [NSMutableArray array];
+    for (int i = 0; i < argc; i++)
+        add_batch_input(inputs, [NSString stringWithUTF8String: argv[i]]);
+
+    if ([inputs count] == 0) {
+        fprintf(stderr, "No input files supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    int ret = 0;
+    for (NSString *input in inputs) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSError *error;
+        uint64_t signature;
+
+        NSData *data = [NSData dataWithContentsOfFile: input options: NSDataReadingMappedAlways error: &error];
+        if (data == nil) {
+            fprintf(stderr, "Could not read %s: %s\n", [input fileSystemRepresentation], [[error localizedDescription] UTF8String]);
+            ret = 1;
+        } else if (![PLCrashReport signatureForCrashData: data frameCount: frames signature: &signature error: &error]) {
+            fprintf(stderr, "Could not compute signature for %s: %s\n", [input fileSystemRepresentation], [[error localizedDescription] UTF8String]);
+            ret = 1;
+        } else {
+            printf("%016" PRIx64 " %s\n", signature, [input fileSystemRepresentation]);
+        }
+
+        [pool drain];
+    }
+
+    return ret;
+}
+
+/*
+ * Print the @a limit most common entries of @a counts, with their share of @a total.
+ */
+static void print_top_counts (const char *title, NSCountedSet *counts, NSUInteger total, NSUInteger limit) {
+    NSArray *keys = [[counts allObjects] sortedArrayUsingComparator: ^NSComparisonResult (id lhs, id rhs) {
+        NSUInteger lhsCount = [counts countForObject: lhs];
+        NSUInteger rhsCount = [counts countForObject: rhs];
+        if (lhsCount != rhsCount)
+            return lhsCount > rhsCount ? NSOrderedAscending : NSOrderedDescending;
+        return [[lhs description] compare: [rhs description]];
+    }];
+
+    printf("\n%s (%lu distinct)\n", title, (unsigned long) [keys count]);
+    for (NSUInteger i = 0; i < [keys count] && i < limit; i++) {
+        id key = [keys objectAtIndex: i];
+        NSUInteger count = [counts countForObject: key];
+
+        const char *name;
+        if ([key isKindOfClass: [NSNumber class]]) {
+            name = [[NSString stringWithFormat: @"%016llx", [key unsignedLongLongValue]] UTF8String];
+        } else {
+            name = [key UTF8String];
+        }
+
+        printf("  %10lu  %5.1f%%  %s\n", (unsigned long) count, total > 0 ? count * 100.0 / total : 0.0, name);
+    }
+}
+
+/*
+ * Exported column value types.
+ */
+typedef enum {
+    /* Unsigned 8-bit integer. */
+    ExportColumnUInt8,
+
+    /* Unsigned 32-bit integer. */
+    ExportColumnUInt32,
+
+    /* Signed 64-bit integer. */
+    ExportColumnInt64,
+
+    /* Unsigned 64-bit integer. */
+    ExportColumnUInt64,
+
+    /* UTF-8 string. Written as a data file of the concatenated string bytes, and an offsets file of the uint64
+     * end offset of each row's value within the data file. */
+    ExportColumnString
+} ExportColumnType;
+
+/*
+ * A single exported column. Values are stored as fixed-width values in host (little-endian) byte order, one file
+ * per column; values are buffered and appended to the column's file(s) in chunks.
+ */
+@interface ExportColumn : NSObject {
+@private
+    /* Column name */
+    NSString *_name;
+
+    /* Column type */
+    ExportColumnType _type;
+
+    /* Buffered fixed-width values, or string end offsets */
+    NSMutableData *_values;
+
+    /* Buffered string bytes */
+    NSMutableData *_strings;
+
+    /* Total number of string bytes written */
+    uint64_t _stringLength;
+
+    /* Value (or offset) and string data file descriptors */
+    int _valuesFD;
+    int _stringsFD;
+}
+
+- (id) initWithName: (NSString *) name type: (ExportColumnType) type directory: (NSString *) directory error: (NSError **) outError;
+- (void) appendValue: (uint64_t) value;
+- (void) appendString: (NSString *) value;
+- (BOOL) flush: (NSError **) outError;
+
+@property(nonatomic, readonly) NSString *name;
+@property(nonatomic, readonly) ExportColumnType type;
+
+@end
+
+@implementation ExportColumn
+
+@synthesize name = _name;
+@synthesize type = _type;
+
+/* Open @a path for writing, returning the file descriptor, or -1 on error. */
+static int export_open (NSString *path, NSError **outError) {
+    int fd = open([path fileSystemRepresentation], O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0 && outError != NULL)
+        *outError = [NSError errorWithDomain: NSPOSIXErrorDomain code: errno userInfo: nil];
+    return fd;
+}
+
+/* Write all of @a data to @a fd, returning NO on error. */
+static BOOL export_write (int fd, NSData *data, NSError **outError) {
+    const uint8_t *p = [data bytes];
+    size_t remaining = [data length];
+
+    while (remaining > 0) {
+        ssize_t written = write(fd, p, remaining);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (outError != NULL)
+                *outError = [NSError errorWithDomain: NSPOSIXErrorDomain code: errno userInfo: nil];
+            return NO;
+        }
+
+        p += written;
+        remaining -= written;
+    }
+
+    return YES;
+}
+
+- (id) initWithName: (NSString *) name type: (ExportColumnType) type directory: (NSString *) directory error: (NSError **) outError {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _name = [name copy];
+    _type = type;
+    _values = [[NSMutableData alloc] init];
+    _valuesFD = -1;
+    _stringsFD = -1;
+
+    if (type == ExportColumnString) {
+        _strings = [[NSMutableData alloc] init];
+        _valuesFD = export_open([directory stringByAppendingPathComponent: [name stringByAppendingPathExtension: @"offsets"]], outError);
+        _stringsFD = export_open([directory stringByAppendingPathComponent: [name stringByAppendingPathExtension: @"data"]], outError);
+        if (_valuesFD < 0 || _stringsFD < 0) {
+            [self release];
+            return nil;
+        }
+    } else {
+        _valuesFD = export_open([directory stringByAppendingPathComponent: [name stringByAppendingPathExtension: @"col"]], outError);
+        if (_valuesFD < 0) {
+            [self release];
+            return nil;
+        }
+    }
+
+    return self;
+}
+
+- (void) dealloc {
+    if (_valuesFD >= 0)
+        close(_valuesFD);
+    if (_stringsFD >= 0)
+        close(_stringsFD);
+
+    [_name release];
+    [_values release];
+    [_strings release];
+
+    [super dealloc];
+}
+
+/*
+ * Append a fixed-width value. The value is truncated to the column's width.
+ */
+- (void) appendValue: (uint64_t) value {
+    switch (_type) {
+        case ExportColumnUInt8: {
+            uint8_t v = (uint8_t) value;
+            [_values appendBytes: &v length: sizeof(v)];
+            break;
+        }
+        case ExportColumnUInt32: {
+            uint32_t v = (uint32_t) value;
+            [_values appendBytes: &v length: sizeof(v)];
+            break;
+        }
+        case ExportColumnInt64:
+        case ExportColumnUInt64:
+            [_values appendBytes: &value length: sizeof(value)];
+            break;
+        case ExportColumnString:
+            [NSException raise: NSInvalidArgumentException format: @"Column %@ is a string column", _name];
+            break;
+    }
+}
+
+/*
+ * Append a string value. A nil value is appended as an empty string.
+ */
+- (void) appendString: (NSString *) value {
+    const char *utf8 = value != nil ? [value UTF8String] : "";
+    size_t len = strlen(utf8);
+
+    [_strings appendBytes: utf8 length: len];
+    _stringLength += len;
+    [_values appendBytes: &_stringLength length: sizeof(_stringLength)];
+}
+
+/*
+ * Write all buffered values to the column's file(s).
+ */
+- (BOOL) flush: (NSError **) outError {
+    if (!export_write(_valuesFD, _values, outError))
+        return NO;
+    [_values setLength: 0];
+
+    if (_strings != nil) {
+        if (!export_write(_stringsFD, _strings, outError))
+            return NO;
+        [_strings setLength: 0];
+    }
+
+    return YES;
+}
+
+@end
+
+/*
+ * An exported table: a set of columns of equal length, written to a directory.
+ */
+@interface ExportTable : NSObject {
+@private
+    /* Table name */
+    NSString *_name;
+
+    /* Columns, keyed by name */
+    NSMutableDictionary *_columns;
+
+    /* Column names, in definition order */
+    NSMutableArray *_columnNames;
+
+    /* Table directory */
+    NSString *_directory;
+
+    /* Total number of rows */
+    uint64_t _rowCount;
+
+    /* Number of rows buffered since the last flush */
+    NSUInteger _bufferedRows;
+}
+
+- (id) initWithName: (NSString *) name directory: (NSString *) directory error: (NSError **) outError;
+- (BOOL) addColumn: (NSString *) name type: (ExportColumnType) type error: (NSError **) outError;
+- (ExportColumn *) column: (NSString *) name;
+- (BOOL) endRow: (NSUInteger) chunkRows error: (NSError **) outError;
+- (BOOL) flush: (NSError **) outError;
+- (NSDictionary *) schema;
+
+@end
+
+@implementation ExportTable
+
+- (id) initWithName: (NSString *) name directory: (NSString *) directory error: (NSError **) outError {
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _name = [name copy];
+    _columns = [[NSMutableDictionary alloc] init];
+    _columnNames = [[NSMutableArray alloc] init];
+    _directory = [[directory stringByAppendingPathComponent: name] retain];
+
+    if (![[NSFileManager defaultManager] createDirectoryAtPath: _directory withIntermediateDirectories: YES attributes: nil error: outError]) {
+        [self release];
+        return nil;
+    }
+
+    return self;
+}
+
+- (void) dealloc {
+    [_name release];
+    [_columns release];
+    [_columnNames release];
+    [_directory release];
+
+    [super dealloc];
+}
+
+- (BOOL) addColumn: (NSString *) name type: (ExportColumnType) type error: (NSError **) outError {
+    ExportColumn *column = [[[ExportColumn alloc] initWithName: name type: type directory: _directory error: outError] autorelease];
+    if (column == nil)
+        return NO;
+
+    [_columns setObject: column forKey: name];
+    [_columnNames addObject: name];
+    return YES;
+}
+
+- (ExportColumn *) column: (NSString *) name {
+    return [_columns objectForKey: name];
+}
+
+/*
+ * Complete the current row, flushing all columns once @a chunkRows rows have been buffered.
+ */
+- (BOOL) endRow: (NSUInteger) chunkRows error: (NSError **) outError {
+    _rowCount++;
+    if (++_bufferedRows < chunkRows)
+        return YES;
+
+    return [self flush: outError];
+}
+
+- (BOOL) flush: (NSError **) outError {
+    for (NSString *name in _columnNames) {
+        if (![[_columns objectForKey: name] flush: outError])
+            return NO;
+    }
+
+    _bufferedRows = 0;
+    return YES;
+}
+
+/*
+ * Return the table's schema description.
+ */
+- (NSDictionary *) schema {
+    static NSString *typeNames[] = {
+        [ExportColumnUInt8] = @"uint8",
+        [ExportColumnUInt32] = @"uint32",
+        [ExportColumnInt64] = @"int64",
+        [ExportColumnUInt64] = @"uint64",
+        [ExportColumnString] = @"string"
+    };
+
+    NSMutableArray *columns = [NSMutableArray arrayWithCapacity: [_columnNames count]];
+    for (NSString *name in _columnNames) {
+        ExportColumn *column = [_columns objectForKey: name];
+        [columns addObject: [NSDictionary dictionaryWithObjectsAndKeys: name, @"name", typeNames[column.type], @"type", nil]];
+    }
+
+    return [NSDictionary dictionaryWithObjectsAndKeys:
+            [NSNumber numberWithUnsignedLongLong: _rowCount], @"rows",
+            columns, @"columns",
+            nil];
+}
+
+@end
+
+/*
+ * Create a table with the given column definitions, terminated by a nil name.
+ */
+static ExportTable *export_table (NSString *directory, NSString *name, NSError **outError, ...) {
+    ExportTable *table = [[[ExportTable alloc] initWithName: name directory: directory error: outError] autorelease];
+    if (table == nil)
+        return nil;
+
+    va_list ap;
+    va_start(ap, outError);
+
+    NSString *column;
+    while ((column = va_arg(ap, NSString *)) != nil) {
+        ExportColumnType type = va_arg(ap, ExportColumnType);
+        if (![table addColumn: column type: type error: outError]) {
+            va_end(ap);
+            return nil;
+        }
+    }
+
+    va_end(ap);
+    return table;
+}
+
+/*
+ * Export a batch of reports in a columnar layout.
+ */
+int export_command (int argc, char *argv[]) {
+    const char *output_dir = NULL;
+    unsigned long chunkRows = EXPORT_DEFAULT_CHUNK_ROWS;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "output",     required_argument,      NULL,          'o' },
+        { "chunk",      required_argument,      NULL,          'c' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "o:c:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'o':
+                output_dir = optarg;
+                break;
+            case 'c': {
+                char *end;
+                chunkRows = strtoul(optarg, &end, 10);
+                if (*end != '\0' || chunkRows == 0) {
+                    fprintf(stderr, "Invalid chunk size: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            }
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    if (output_dir == NULL) {
+        fprintf(stderr, "No output directory supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    NSMutableArray *inputs = [NSMutableArray array];
+    for (int i = 0; i < argc; i++)
+        add_batch_input(inputs, [NSString stringWithUTF8String: argv[i]]);
+
+    if ([inputs count] == 0) {
+        fprintf(stderr, "No input files supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    /* Create the tables */
+    NSString *outputPath = [NSString stringWithUTF8String: output_dir];
+    NSError *error = nil;
+
+    ExportTable *reports = export_table(outputPath, @"reports", &error,
+                                        @"report_id",           ExportColumnUInt64,
+                                        @"path",                ExportColumnString,
+                                        @"uuid",                ExportColumnString,
+                                        @"timestamp",           ExportColumnInt64,
+                                        @"os_version",          ExportColumnString,
+                                        @"os_build",            ExportColumnString,
+                                        @"model",               ExportColumnString,
+                                        @"app_identifier",      ExportColumnString,
+                                        @"app_version",         ExportColumnString,
+                                        @"signal_name",         ExportColumnString,
+                                        @"signal_code",         ExportColumnString,
+                                        @"signal_address",      ExportColumnUInt64,
+                                        @"exception_name",      ExportColumnString,
+                                        @"exception_reason",    ExportColumnString,
+                                        nil);
+    ExportTable *threads = reports == nil ? nil : export_table(outputPath, @"threads", &error,
+                                        @"report_id",           ExportColumnUInt64,
+                                        @"thread_number",       ExportColumnUInt32,
+                                        @"crashed",             ExportColumnUInt8,
+                                        @"frame_count",         ExportColumnUInt32,
+                                        nil);
+    ExportTable *frames = threads == nil ? nil : export_table(outputPath, @"frames", &error,
+                                        @"report_id",           ExportColumnUInt64,
+                                        @"thread_number",       ExportColumnUInt32,
+                                        @"frame_index",         ExportColumnUInt32,
+                                        @"pc",                  ExportColumnUInt64,
+                                        @"image_index",         ExportColumnInt64,
+                                        @"symbol",              ExportColumnString,
+                                        nil);
+    ExportTable *images = frames == nil ? nil : export_table(outputPath, @"images", &error,
+                                        @"report_id",           ExportColumnUInt64,
+                                        @"image_index",         ExportColumnUInt32,
+                                        @"base_address",        ExportColumnUInt64,
+                                        @"size",                ExportColumnUInt64,
+                                        @"name",                ExportColumnString,
+                                        @"uuid",                ExportColumnString,
+                                        nil);
+    if (images == nil) {
+        fprintf(stderr, "Could not create output tables: %s\n", [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    /* Decode the reports concurrently, in batches, appending each batch's rows in input order */
+    int failed = 0;
+    uint64_t exported = 0;
+    BOOL writeFailed = NO;
+
+    for (NSUInteger batchStart = 0; batchStart < [inputs count] && !writeFailed; batchStart += EXPORT_BATCH_REPORTS) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSRange range = NSMakeRange(batchStart, MIN((NSUInteger) EXPORT_BATCH_REPORTS, [inputs count] - batchStart));
+        NSArray *paths = [inputs subarrayWithRange: range];
+
+        NSMutableArray *dataArray = [NSMutableArray arrayWithCapacity: [paths count]];
+        for (NSString *path in paths) {
+            NSData *data = [NSData dataWithContentsOfFile: path options: NSDataReadingMappedAlways error: &error];
+            [dataArray addObject: data != nil ? data : [NSData data]];
+        }
+
+        NSArray *decoded = [PLCrashReport decodeReportsWithDataArray: dataArray maxConcurrency: 0];
+        for (NSUInteger i = 0; i < [decoded count] && !writeFailed; i++) {
+            NSString *path = [paths objectAtIndex: i];
+            id result = [decoded objectAtIndex: i];
+            if (![result isKindOfClass: [PLCrashReport class]]) {
+                fprintf(stderr, "Could not decode %s: %s\n", [path fileSystemRepresentation], [[result localizedDescription] UTF8String]);
+                failed++;
+                continue;
+            }
+
+            PLCrashReport *report = result;
+            uint64_t reportId = batchStart + i;
+
+            /* Report row */
+            NSString *uuid = nil;
+            if (report.uuidRef != NULL)
+                uuid = [(NSString *) CFUUIDCreateString(NULL, report.uuidRef) autorelease];
+
+            [[reports column: @"report_id"] appendValue: reportId];
+            [[reports column: @"path"] appendString: path];
+            [[reports column: @"uuid"] appendString: uuid];
+            [[reports column: @"timestamp"] appendValue: (uint64_t) (int64_t) [report.systemInfo.timestamp timeIntervalSince1970]];
+            [[reports column: @"os_version"] appendString: report.systemInfo.operatingSystemVersion];
+            [[reports column: @"os_build"] appendString: report.systemInfo.operatingSystemBuild];
+            [[reports column: @"model"] appendString: report.hasMachineInfo ? report.machineInfo.modelName : nil];
+            [[reports column: @"app_identifier"] appendString: report.applicationInfo.applicationIdentifier];
+            [[reports column: @"app_version"] appendString: report.applicationInfo.applicationVersion];
+            [[reports column: @"signal_name"] appendString: report.signalInfo.name];
+            [[reports column: @"signal_code"] appendString: report.signalInfo.code];
+            [[reports column: @"signal_address"] appendValue: report.signalInfo.address];
+            [[reports column: @"exception_name"] appendString: report.hasExceptionInfo ? report.exceptionInfo.exceptionName : nil];
+            [[reports column: @"exception_reason"] appendString: report.hasExceptionInfo ? report.exceptionInfo.exceptionReason : nil];
+            writeFailed |= ![reports endRow: chunkRows error: &error];
+
+            /* Image rows; frames refer to their containing image by index */
+            NSMutableDictionary *imageIndexes = [NSMutableDictionary dictionaryWithCapacity: [report.images count]];
+            NSUInteger imageIndex = 0;
+            for (PLCrashReportBinaryImageInfo *image in report.images) {
+                [imageIndexes setObject: [NSNumber numberWithUnsignedInteger: imageIndex] forKey: [NSValue valueWithNonretainedObject: image]];
+
+                [[images column: @"report_id"] appendValue: reportId];
+                [[images column: @"image_index"] appendValue: imageIndex];
+                [[images column: @"base_address"] appendValue: image.imageBaseAddress];
+                [[images column: @"size"] appendValue: image.imageSize];
+                [[images column: @"name"] appendString: image.imageName];
+                [[images column: @"uuid"] appendString: image.hasImageUUID ? image.imageUUID : nil];
+                writeFailed |= ![images endRow: chunkRows error: &error];
+                imageIndex++;
+            }
+
+            /* Thread and frame rows */
+            for (PLCrashReportThreadInfo *thread in report.threads) {
+                [[threads column: @"report_id"] appendValue: reportId];
+                [[threads column: @"thread_number"] appendValue: (uint64_t) thread.threadNumber];
+                [[threads column: @"crashed"] appendValue: thread.crashed];
+                [[threads column: @"frame_count"] appendValue: [thread.stackFrames count]];
+                writeFailed |= ![threads endRow: chunkRows error: &error];
+
+                uint32_t frameIndex = 0;
+                for (PLCrashReportStackFrameInfo *frame in thread.stackFrames) {
+                    PLCrashReportBinaryImageInfo *image = [report imageForAddress: frame.instructionPointer];
+                    NSNumber *index = image != nil ? [imageIndexes objectForKey: [NSValue valueWithNonretainedObject: image]] : nil;
+
+                    [[frames column: @"report_id"] appendValue: reportId];
+                    [[frames column: @"thread_number"] appendValue: (uint64_t) thread.threadNumber];
+                    [[frames column: @"frame_index"] appendValue: frameIndex++];
+                    [[frames column: @"pc"] appendValue: frame.instructionPointer];
+                    [[frames column: @"image_index"] appendValue: index != nil ? [index unsignedLongLongValue] : (uint64_t) -1];
+                    [[frames column: @"symbol"] appendString: frame.symbolInfo.symbolName];
+                    writeFailed |= ![frames endRow: chunkRows error: &error];
+                }
+            }
+
+            exported++;
+        }
+
+        [error retain];
+        [pool drain];
+        [error autorelease];
+    }
+
+    /* Write out the remaining rows and the schema */
+    NSArray *tables = [NSArray arrayWithObjects: reports, threads, frames, images, nil];
+    NSArray *tableNames = [NSArray arrayWithObjects: @"reports", @"threads", @"frames", @"images", nil];
+    NSMutableDictionary *schema = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < [tables count] && !writeFailed; i++) {
+        ExportTable *table = [tables objectAtIndex: i];
+        writeFailed |= ![table flush: &error];
+        [schema setObject: [table schema] forKey: [tableNames objectAtIndex: i]];
+    }
+
+    if (!writeFailed) {
+        NSData *schemaData = [NSJSONSerialization dataWithJSONObject: [NSDictionary dictionaryWithObject: schema forKey: @"tables"]
+                                                             options: NSJSONWritingPrettyPrinted
+                                                               error: &error];
+        writeFailed = schemaData == nil || ![schemaData writeToFile: [outputPath stringByAppendingPathComponent: @"schema.json"] options: NSDataWritingAtomic error: &error];
+    }
+
+    if (writeFailed) {
+        fprintf(stderr, "Could not write export tables: %s\n", [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+    if (elapsed <= 0)
+        elapsed = 1e-6;
+
+    fprintf(stderr, "Exported %llu of %lu reports in %.3f seconds (%.1f reports/sec)\n",
+            (unsigned long long) exported, (unsigned long) [inputs count], elapsed, exported / elapsed);
+
+    return failed == 0 ? 0 : 1;
+}
+
+/*
+ * Print aggregate statistics for a set of reports.
+ */
+int stats_command (int argc, char *argv[]) {
+    unsigned long top = 10;
+    unsigned long frames = PLCRASH_REPORT_SIGNATURE_DEFAULT_FRAMES;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "top",        required_argument,      NULL,          't' },
+        { "frames",     required_argument,      NULL,          'n' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "t:n:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 't':
+            case 'n': {
+                char *end;
+                unsigned long value = strtoul(optarg, &end, 10);
+                if (*end != '\0' || value == 0) {
+                    fprintf(stderr, "Invalid count: %s\n", optarg);
+                    return 1;
+                }
+
+                if (ch == 't')
+                    top = value;
+                else
+                    frames = value;
+                break;
+            }
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    NSMutableArray *inputs = [NSMutableArray array];
+    for (int i = 0; i < argc; i++)
+        add_batch_input(inputs, [NSString stringWithUTF8String: argv[i]]);
+
+    if ([inputs count] == 0) {
+        fprintf(stderr, "No input files supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    /* Summarize the reports concurrently. Each worker aggregates into its own statistics instance, claiming inputs
+     * from a shared index; the per-worker results are merged once all workers have finished. */
+    size_t workerCount = MAX(1, MIN((size_t) [[NSProcessInfo processInfo] activeProcessorCount], [inputs count]));
+    NSMutableArray *workerStats = [NSMutableArray arrayWithCapacity: workerCount];
+    for (size_t i = 0; i < workerCount; i++)
+        [workerStats addObject: [[[PLCrashReportStatistics alloc] initWithSignatureFrameCount: frames] autorelease]];
+
+    __block volatile int64_t nextInput = 0;
+    __block volatile int32_t failed = 0;
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    dispatch_apply(workerCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t worker) {
+        PLCrashReportStatistics *stats = [workerStats objectAtIndex: worker];
+        int64_t idx;
+
+        while ((idx = OSAtomicIncrement64Barrier(&nextInput) - 1) < (int64_t) [inputs count]) {
+            NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+            NSString *input = [inputs objectAtIndex: (NSUInteger) idx];
+            NSError *error;
+
+            NSData *data = [NSData dataWithContentsOfFile: input options: NSDataReadingMappedAlways error: &error];
+            if (data == nil || ![stats addCrashData: data error: &error]) {
+                fprintf(stderr, "Could not summarize %s: %s\n", [input fileSystemRepresentation], [[error localizedDescription] UTF8String]);
+                OSAtomicIncrement32(&failed);
+            }
+
+            [pool drain];
+        }
+    });
+
+    PLCrashReportStatistics *stats = [[[PLCrashReportStatistics alloc] initWithSignatureFrameCount: frames] autorelease];
+    for (PLCrashReportStatistics *worker in workerStats)
+        [stats mergeStatistics: worker];
+
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+    if (elapsed <= 0)
+        elapsed = 1e-6;
+
+    /* Print the summary table */
+    NSUInteger reports = stats.reportCount;
+    printf("Reports:           %lu\n", (unsigned long) reports);
+    if (reports > 0) {
+        printf("Report size:       %.1f KB average, %.1f KB min, %.1f KB max, %.1f MB total\n",
+               stats.totalReportBytes / (double) reports / 1024.0, stats.minimumReportBytes / 1024.0,
+               stats.maximumReportBytes / 1024.0, stats.totalReportBytes / (1024.0 * 1024.0));
+        printf("Threads/report:    %.1f average\n", stats.threadCount / (double) reports);
+        printf("Frames/thread:     %.1f average\n", stats.threadCount > 0 ? stats.frameCount / (double) stats.threadCount : 0.0);
+        printf("Frames/report:     %.1f average, %llu max\n", stats.frameCount / (double) reports, (unsigned long long) stats.maximumReportFrameCount);
+
+        print_top_counts("Top crash signatures", stats.signatureCounts, reports, top);
+        print_top_counts("Top OS versions", stats.osVersionCounts, reports, top);
+        print_top_counts("Top device models", stats.deviceModelCounts, reports, top);
+        print_top_counts("Top signals", stats.signalCounts, reports, top);
+    }
+
+    fprintf(stderr, "Summarized %lu of %lu reports in %.3f seconds (%.1f reports/sec) using %lu workers\n",
+            (unsigned long) reports, (unsigned long) [inputs count], elapsed, reports / elapsed, (unsigned long) workerCount);
+
+    return failed == 0 ? 0 : 1;
+}
+
+/*
+ * Print the diagnostic trace events recorded in each report.
+ */
+int trace_command (int argc, char *argv[]) {
+    NSMutableArray *inputs = [NSMutableArray array];
+    for (int i = 0; i < argc; i++)
+        add_batch_input(inputs, [NSString stringWithUTF8String: argv[i]]);
+
+    if ([inputs count] == 0) {
+        fprintf(stderr, "No input files supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    int ret = 0;
+    for (NSString *input in inputs) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSError *error;
+
+        PLCrashReport *report = [[[PLCrashReport alloc] initWithContentsOfFile: input error: &error] autorelease];
+        if (report == nil) {
+            fprintf(stderr, "Could not decode %s: %s\n", [input fileSystemRepresentation], [[error localizedDescription] UTF8String]);
+            ret = 1;
+            [pool drain];
+            continue;
+        }
+
+        printf("%s: %lu events\n", [input fileSystemRepresentation], (unsigned long) [report.traceEvents count]);
+        for (PLCrashReportTraceEvent *event in report.traceEvents) {
+            if (event.name != nil)
+                printf("  %" PRIu64 " %s", event.sequenceNumber, [event.name UTF8String]);
+            else
+                printf("  %" PRIu64 " unknown(%" PRIu32 ")", event.sequenceNumber, event.eventIdentifier);
+
+            for (NSNumber *arg in event.arguments)
+                printf(" 0x%" PRIx64, (uint64_t) [arg unsignedLongLongValue]);
+            printf("\n");
+        }
+
+        [pool drain];
+    }
+
+    return ret;
+}
+
+/*
+ * Pack reports into a report bundle.
+ */
+int bundle_command (int argc, char *argv[]) {
+    const char *output_file = NULL;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "output",     required_argument,      NULL,          'o' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "o:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'o':
+                output_file = optarg;
+                break;
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    if (output_file == NULL) {
+        fprintf(stderr, "No output file supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    NSMutableArray *inputs = [NSMutableArray array];
+    for (int i = 0; i < argc; i++)
+        add_batch_input(inputs, [NSString stringWithUTF8String: argv[i]]);
+
+    if ([inputs count] == 0) {
+        fprintf(stderr, "No input files supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    /* Reports are mapped, rather than read into memory */
+    NSMutableArray *reports = [NSMutableArray arrayWithCapacity: [inputs count]];
+    unsigned long long inputBytes = 0;
+    for (NSString *input in inputs) {
+        NSError *error;
+        NSData *data = [NSData dataWithContentsOfFile: input options: NSDataReadingMappedAlways error: &error];
+        if (data == nil) {
+            fprintf(stderr, "Could not read %s: %s\n", [input fileSystemRepresentation], [[error localizedDescription] UTF8String]);
+            return 1;
+        }
+
+        [reports addObject: data];
+        inputBytes += [data length];
+    }
+
+    NSError *error;
+    NSString *outputPath = [NSString stringWithUTF8String: output_file];
+    if (![PLCrashReportBundle writeBundleWithReports: reports toFile: outputPath error: &error]) {
+        fprintf(stderr, "Could not write %s: %s\n", output_file, [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath: outputPath error: NULL];
+    fprintf(stderr, "Bundled %lu reports (%llu bytes) into %s (%llu bytes)\n", (unsigned long) [reports count], inputBytes,
+            output_file, [attributes fileSize]);
+
+    return 0;
+}
+
+/*
+ * List or extract the reports in a report bundle.
+ */
+int unbundle_command (int argc, char *argv[]) {
+    const char *output_dir = NULL;
+    long report_index = -1;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "output",     required_argument,      NULL,          'o' },
+        { "report",     required_argument,      NULL,          'r' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "o:r:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'o':
+                output_dir = optarg;
+                break;
+            case 'r': {
+                char *end;
+                report_index = strtol(optarg, &end, 10);
+                if (*end != '\0' || report_index < 0) {
+                    fprintf(stderr, "Invalid report index: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            }
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    if (argc != 1) {
+        fprintf(stderr, "A single bundle file is required\n");
+        print_usage();
+        return 1;
+    }
+
+    NSError *error;
+    PLCrashReportBundle *bundle = [[[PLCrashReportBundle alloc] initWithContentsOfFile: [NSString stringWithUTF8String: argv[0]] error: &error] autorelease];
+    if (bundle == nil) {
+        fprintf(stderr, "Could not open %s: %s\n", argv[0], [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    NSUInteger first = 0;
+    NSUInteger count = [bundle reportCount];
+    if (report_index >= 0) {
+        if ((unsigned long) report_index >= count) {
+            fprintf(stderr, "Report index %ld is out of range; %s contains %lu reports\n", report_index, argv[0], (unsigned long) count);
+            return 1;
+        }
+
+        first = (NSUInteger) report_index;
+        count = first + 1;
+    }
+
+    NSString *outputPath = output_dir != NULL ? [NSString stringWithUTF8String: output_dir] : nil;
+    if (outputPath != nil && ![[NSFileManager defaultManager] createDirectoryAtPath: outputPath withIntermediateDirectories: YES attributes: nil error: &error]) {
+        fprintf(stderr, "Could not create output directory %s: %s\n", output_dir, [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    int ret = 0;
+    for (NSUInteger i = first; i < count; i++) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+        NSData *data = [bundle reportDataAtIndex: i error: &error];
+        if (data == nil) {
+            fprintf(stderr, "Could not extract report %lu: %s\n", (unsigned long) i, [[error localizedDescription] UTF8String]);
+            ret = 1;
+        } else if (outputPath == nil) {
+            printf("%lu: %lu bytes\n", (unsigned long) i, (unsigned long) [data length]);
+        } else {
+            NSString *file = [outputPath stringByAppendingPathComponent: [NSString stringWithFormat: @"%lu.plcrash", (unsigned long) i]];
+            if (![data writeToFile: file options: NSDataWritingAtomic error: &error]) {
+                fprintf(stderr, "Could not write %s: %s\n", [file fileSystemRepresentation], [[error localizedDescription] UTF8String]);
+                ret = 1;
+            } else {
+                printf("%s\n", [file fileSystemRepresentation]);
+            }
+        }
+
+        [pool drain];
+    }
+
+    return ret;
+}
+
+/*
+ * Return the symbol index cache directory; if @a cache_dir is NULL, the default user cache directory is returned.
+ */
+static NSString *symbol_cache_path (const char *cache_dir) {
+    if (cache_dir != NULL)
+        return [NSString stringWithUTF8String: cache_dir];
+
+    NSArray *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
+    NSString *cacheRoot = [caches count] > 0 ? [caches objectAtIndex: 0] : NSTemporaryDirectory();
+    return [cacheRoot stringByAppendingPathComponent: @"plcrashutil"];
+}
+
+/*
+ * Run a concurrent offline symbolication.
+ */
+int symbolicate_command (int argc, char *argv[]) {
+    const char *format = "plcrash";
+    const char *output_dir = NULL;
+    const char *cache_dir = NULL;
+    NSMutableArray *symbolPaths = [NSMutableArray array];
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "symbols",    required_argument,      NULL,          's' },
+        { "output",     required_argument,      NULL,          'o' },
+        { "cache",      required_argument,      NULL,          'c' },
+        { "format",     required_argument,      NULL,          'f' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "s:o:c:f:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 's':
+                [symbolPaths addObject: [NSString stringWithUTF8String: optarg]];
+                break;
+            case 'o':
+                output_dir = optarg;
+                break;
+            case 'c':
+                cache_dir = optarg;
+                break;
+            case 'f':
+                format = optarg;
+                break;
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    /* A nil formatter writes the symbolicated plcrash data directly */
+    NSString *extension = @"plcrash";
+    id formatter = nil;
+    if (strcasecmp(format, "plcrash") != 0 && (formatter = formatter_for_name(format, &extension)) == nil) {
+        fprintf(stderr, "Unsupported format requested\n");
+        print_usage();
+        return 1;
+    }
+
+    if (output_dir == NULL || [symbolPaths count] == 0) {
+        fprintf(stderr, "No %s supplied\n", output_dir == NULL ? "output directory" : "symbol path");
+        print_usage();
+        return 1;
+    }
+
+    NSString *cachePath = symbol_cache_path(cache_dir);
+
+    NSString *outputPath = [NSString stringWithUTF8String: output_dir];
+    NSError *error;
+    if (![[NSFileManager defaultManager] createDirectoryAtPath: outputPath withIntermediateDirectories: YES attributes: nil error: &error]) {
+        fprintf(stderr, "Could not create output directory: %s\n", [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    NSMutableArray *inputs = [NSMutableArray array];
+    for (int i = 0; i < argc; i++)
+        add_batch_input(inputs, [NSString stringWithUTF8String: argv[i]]);
+
+    if ([inputs count] == 0) {
+        fprintf(stderr, "No input files supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    /* Symbolicate the reports concurrently; symbol stores are shared by all workers */
+    PLCrashReportSymbolicator *symbolicator = [[[PLCrashReportSymbolicator alloc] initWithSearchPaths: symbolPaths cachePath: cachePath] autorelease];
+    __block volatile int32_t failed = 0;
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    dispatch_apply([inputs count], dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t idx) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSString *input = [inputs objectAtIndex: idx];
+        NSString *name = [[[input lastPathComponent] stringByDeletingPathExtension] stringByAppendingPathExtension: extension];
+        NSString *output = [outputPath stringByAppendingPathComponent: name];
+        NSError *symError = nil;
+        BOOL success = NO;
+
+        NSData *data = [NSData dataWithContentsOfFile: input options: NSDataReadingMappedAlways error: &symError];
+        NSData *symbolicated = data != nil ? [symbolicator symbolicateCrashData: data error: &symError] : nil;
+
+        if (symbolicated == nil) {
+            fprintf(stderr, "Could not symbolicate %s: %s\n", [input fileSystemRepresentation], [[symError localizedDescription] UTF8String]);
+        } else if (formatter == nil) {
+            success = [symbolicated writeToFile: output options: NSDataWritingAtomic error: &symError];
+        } else {
+            PLCrashReport *report = [[[PLCrashReport alloc] initWithData: symbolicated error: &symError] autorelease];
+            int fd = report != nil ? open([output fileSystemRepresentation], O_WRONLY|O_CREAT|O_TRUNC, 0644) : -1;
+            if (fd >= 0) {
+                success = [formatter writeReport: report toFileDescriptor: fd error: &symError];
+                close(fd);
+            } else if (report != nil) {
+                symError = [NSError errorWithDomain: NSPOSIXErrorDomain code: errno userInfo: nil];
+            }
+        }
+
+        if (symbolicated != nil && !success)
+            fprintf(stderr, "Could not write %s: %s\n", [output fileSystemRepresentation], [[symError localizedDescription] UTF8String]);
+
+        if (!success)
+            OSAtomicIncrement32(&failed);
+
+        [pool drain];
+    });
+
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+
+    fprintf(stderr, "Symbolicated %lu of %lu reports in %.3f seconds\n",
+            (unsigned long) ([inputs count] - failed), (unsigned long) [inputs count], elapsed);
+
+    return failed == 0 ? 0 : 1;
+}
+
+/*
+ * Prebuild symbol indexes.
+ */
+int index_command (int argc, char *argv[]) {
+    const char *cache_dir = NULL;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "cache",      required_argument,      NULL,          'c' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "c:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'c':
+                cache_dir = optarg;
+                break;
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    if (argc < 1) {
+        fprintf(stderr, "No symbol paths supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    NSMutableArray *symbolPaths = [NSMutableArray array];
+    for (int i = 0; i < argc; i++)
+        [symbolPaths addObject: [NSString stringWithUTF8String: argv[i]]];
+
+    NSString *cachePath = symbol_cache_path(cache_dir);
+    PLCrashReportSymbolicator *symbolicator = [[[PLCrashReportSymbolicator alloc] initWithSearchPaths: symbolPaths cachePath: cachePath] autorelease];
+
+    NSError *error;
+    NSArray *indexed = [symbolicator indexSearchPaths: &error];
+    if (indexed == nil) {
+        fprintf(stderr, "Could not build symbol indexes: %s\n", [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    for (NSString *uuid in indexed)
+        printf("%s\n", [uuid UTF8String]);
+
+    fprintf(stderr, "Indexed %lu images in %s\n", (unsigned long) [indexed count], [cachePath fileSystemRepresentation]);
+    return [indexed count] > 0 ? 0 : 1;
+}
+
+/*
+ * Build symbol indexes from dyld shared caches.
+ */
+int index_shared_cache_command (int argc, char *argv[]) {
+    const char *cache_dir = NULL;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "cache",      required_argument,      NULL,          'c' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "c:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'c':
+                cache_dir = optarg;
+                break;
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+    argc -= optind;
+    argv += optind;
+
+    if (argc < 1) {
+        fprintf(stderr, "No shared cache paths supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    NSString *cachePath = symbol_cache_path(cache_dir);
+    PLCrashReportSymbolicator *symbolicator = [[[PLCrashReportSymbolicator alloc] initWithSearchPaths: [NSArray array] cachePath: cachePath] autorelease];
+    NSUInteger total = 0;
+    int ret = 0;
+
+    for (int i = 0; i < argc; i++) {
+        NSError *error;
+        NSArray *indexed = [symbolicator indexSharedCacheAtPath: [NSString stringWithUTF8String: argv[i]] error: &error];
+        if (indexed == nil) {
+            fprintf(stderr, "Could not index %s: %s\n", argv[i], [[error localizedDescription] UTF8String]);
+            ret = 1;
+            continue;
+        }
+
+        for (NSString *uuid in indexed)
+            printf("%s\n", [uuid UTF8String]);
+
+        total += [indexed count];
+    }
+
+    fprintf(stderr, "Indexed %lu images in %s\n", (unsigned long) total, [cachePath fileSystemRepresentation]);
+    return ret;
+}
+
+/*
+ * Serve symbolication requests over a Unix domain socket until interrupted.
+ */
+int serve_command (int argc, char *argv[]) {
+    const char *socket_path = NULL;
+    const char *cache_dir = NULL;
+    unsigned long memory_budget = 0;
+    long workers = [[NSProcessInfo processInfo] activeProcessorCount];
+    NSMutableArray *symbolPaths = [NSMutableArray array];
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "socket",         required_argument,      NULL,          'S' },
+        { "symbols",        required_argument,      NULL,          's' },
+        { "cache",          required_argument,      NULL,          'c' },
+        { "memory-budget",  required_argument,      NULL,          'm' },
+        { "workers",        required_argument,      NULL,          'w' },
+        { NULL,             0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "S:s:c:m:w:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'S':
+                socket_path = optarg;
+                break;
+            case 's':
+                [symbolPaths addObject: [NSString stringWithUTF8String: optarg]];
+                break;
+            case 'c':
+                cache_dir = optarg;
+                break;
+            case 'm': {
+                char *end;
+                memory_budget = strtoul(optarg, &end, 10);
+                if (*end != '\0') {
+                    fprintf(stderr, "Invalid memory budget: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            }
+            case 'w': {
+                char *end;
+                workers = strtol(optarg, &end, 10);
+                if (*end != '\0' || workers <= 0) {
+                    fprintf(stderr, "Invalid worker count: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            }
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+
+    if (socket_path == NULL) {
+        fprintf(stderr, "No socket path supplied\n");
+        print_usage();
+        return 1;
+    }
+
+    /* Stores are shared by all connections, and evicted least recently used first once the budget is exceeded */
+    NSString *cachePath = symbol_cache_path(cache_dir);
+    PLCrashReportSymbolicator *symbolicator = [[[PLCrashReportSymbolicator alloc] initWithSearchPaths: symbolPaths
+                                                                                           cachePath: cachePath
+                                                                                    mappedStoreLimit: (size_t) memory_budget * 1024 * 1024] autorelease];
+    PLCrashSymbolicationServer *server = [[[PLCrashSymbolicationServer alloc] initWithSymbolicator: symbolicator
+                                                                                       socketPath: [NSString stringWithUTF8String: socket_path]
+                                                                                      workerCount: (NSUInteger) workers] autorelease];
+
+    /* Block the termination signals before the server's threads are started, so that only sigwait() receives them */
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    NSError *error;
+    if (![server startAndReturnError: &error]) {
+        fprintf(stderr, "Could not serve on %s: %s\n", socket_path, [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    fprintf(stderr, "Serving symbolication requests on %s with %ld workers\n", socket_path, workers);
+
+    int sig;
+    sigwait(&signals, &sig);
+
+    [server stop];
+    return 0;
+}
+
+/*
+ * Monitor delegate; prints the path of each written report.
+ */
+@interface MonitorReportPrinter : NSObject <PLCrashMonitorDelegate>
+@end
+
+@implementation MonitorReportPrinter
+
+- (void) crashMonitor: (PLCrashMonitor *) monitor didWriteReportAtPath: (NSString *) path {
+    printf("%s\n", [path fileSystemRepresentation]);
+    fflush(stdout);
+}
+
+@end
+
+/*
+ * Monitor a process for crashes.
+ */
+int monitor_command (int argc, char *argv[]) {
+    const char *output_dir = NULL;
+    const char *identifier = NULL;
+    const char *version = NULL;
+    pid_t pid = 0;
+
+    /* options descriptor */
+    static struct option longopts[] = {
+        { "pid",        required_argument,      NULL,          'p' },
+        { "output",     required_argument,      NULL,          'o' },
+        { "identifier", required_argument,      NULL,          'i' },
+        { "version",    required_argument,      NULL,          'v' },
+        { NULL,         0,                      NULL,           0 }
+    };
+
+    /* Read the options */
+    int ch;
+    while ((ch = getopt_long(argc, argv, "p:o:i:v:", longopts, NULL)) != -1) {
+        switch (ch) {
+            case 'p':
+                pid = (pid_t) strtol(optarg, NULL, 10);
+                break;
+            case 'o':
+                output_dir = optarg;
+                break;
+            case 'i':
+                identifier = optarg;
+                break;
+            case 'v':
+                version = optarg;
+                break;
+            default:
+                print_usage();
+                return 1;
+        }
+    }
+
+    if (pid <= 0 || output_dir == NULL) {
+        fprintf(stderr, "A process ID and output directory are required\n");
+        print_usage();
+        return 1;
+    }
+
+    task_t task;
+    kern_return_t kr = task_for_pid(mach_task_self(), pid, &task);
+    if (kr != KERN_SUCCESS) {
+        fprintf(stderr, "Could not acquire the task port for pid %d: %s\n", (int) pid, mach_error_string(kr));
+        return 1;
+    }
+
+    NSString *appIdentifier = identifier != NULL ? [NSString stringWithUTF8String: identifier] : [NSString stringWithFormat: @"%d", (int) pid];
+    NSString *appVersion = version != NULL ? [NSString stringWithUTF8String: version] : @"";
+
+    PLCrashMonitor *monitor = [[[PLCrashMonitor alloc] initWithTask: task
+                                               applicationIdentifier: appIdentifier
+                                                          appVersion: appVersion
+                                                     outputDirectory: [NSString stringWithUTF8String: output_dir]] autorelease];
+    mach_port_deallocate(mach_task_self(), task);
+    if (monitor == nil) {
+        fprintf(stderr, "Could not create a monitor for pid %d\n", (int) pid);
+        return 1;
+    }
+
+    MonitorReportPrinter *printer = [[[MonitorReportPrinter alloc] init] autorelease];
+    [monitor setDelegate: printer];
+
+    NSError *error;
+    if (![monitor startAndReturnError: &error]) {
+        fprintf(stderr, "Could not monitor pid %d: %s\n", (int) pid, [[error localizedDescription] UTF8String]);
+        return 1;
+    }
+
+    /* Reports are written while the crashed target is held in its exception handler, so the target exits only
+     * once any report has been written. */
+    while (kill(pid, 0) == 0 || errno == EPERM)
+        sleep(1);
+
+    [monitor stop];
     return 0;
 }
 
@@ -128,6 +2121,32 @@ int main (int argc, char *argv[]) {
     /* Convert command */
     if (strcmp(argv[1], "convert") == 0) {
         ret = convert_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "batch") == 0) {
+        ret = batch_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "pipe") == 0) {
+        ret = pipe_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "signature") == 0) {
+        ret = signature_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "export") == 0) {
+        ret = export_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "stats") == 0) {
+        ret = stats_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "symbolicate") == 0) {
+        ret = symbolicate_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "index") == 0) {
+        ret = index_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "index-shared-cache") == 0) {
+        ret = index_shared_cache_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "serve") == 0) {
+        ret = serve_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "monitor") == 0) {
+        ret = monitor_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "trace") == 0) {
+        ret = trace_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "bundle") == 0) {
+        ret = bundle_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "unbundle") == 0) {
+        ret = unbundle_command(argc - 2, argv + 2);
     } else {
         print_usage();
         ret = 1;